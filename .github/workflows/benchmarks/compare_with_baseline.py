@@ -19,6 +19,10 @@ import os
 import sys
 import yaml
 
+# Number of baseline standard deviations a result may exceed the baseline by
+# before it is reported as a regression, if the baseline has a 'stddev_ms'.
+DEFAULT_NUM_STDDEVS = 3.0
+
 
 def load_results_data(results_json_file):
   """Loads and parses the results JSON file."""
@@ -132,11 +136,18 @@ def compare_metrics(
     try:
       baseline_value_ms = float(baseline_info["baseline_ms"])
       threshold_percentage = float(baseline_info["threshold"])
-    except ValueError:
+      # Optional noise model: the standard deviation observed when the
+      # baseline was measured, and how many of them a result may deviate
+      # before it counts as a regression.
+      stddev_ms = float(baseline_info.get("stddev_ms", 0.0))
+      num_stddevs = float(
+          baseline_info.get("num_stddevs", DEFAULT_NUM_STDDEVS)
+      )
+    except (ValueError, TypeError):
       summary_messages.append(
           f"::warning title=Invalid Baseline Value::Metric '{metric_name}' in"
-          f" baseline for '{config_id}' has non-numeric 'baseline_ms' or"
-          " 'threshold'. Skipping."
+          f" baseline for '{config_id}' has non-numeric 'baseline_ms',"
+          " 'threshold', 'stddev_ms' or 'num_stddevs'. Skipping."
       )
       continue
 
@@ -177,11 +188,17 @@ def compare_metrics(
         f"  Allowed Threshold: {threshold_percentage*100:.1f}%"
     )
 
-    # Higher value is worse for time-based metrics
-    allowed_upper_bound = baseline_value_ms * (1.0 + threshold_percentage)
+    # Higher value is worse for time-based metrics. A result has to exceed
+    # both the relative threshold and the noise band of the baseline, so that
+    # noisy metrics do not flake while stable ones are still gated tightly by
+    # the relative threshold.
+    allowed_upper_bound = max(
+        baseline_value_ms * (1.0 + threshold_percentage),
+        baseline_value_ms + num_stddevs * stddev_ms,
+    )
     summary_messages.append(
-        "  Allowed Upper Bound (Baseline * (1 + Threshold)):"
-        f" {allowed_upper_bound:.3f} ms"
+        "  Allowed Upper Bound (max(Baseline * (1 + Threshold), Baseline +"
+        f" {num_stddevs:g} * StdDev)): {allowed_upper_bound:.3f} ms"
     )
 
     if actual_value_ms > allowed_upper_bound:
@@ -33,6 +33,10 @@ struct ProfileOptions {
   // Whether to initialize the buffers with random data or leave them
   // uninitialized.
   bool should_init_buffers;
+  // Whether to flush the device caches before the measured run, so that the
+  // inputs are read from memory as they would be in a real model instead of
+  // from the caches warmed up by the warmup run.
+  bool should_flush_caches;
 };
 
 struct ProfileResult {
@@ -452,7 +452,12 @@ XLA_CPU_BENCHMARK(BM_Conv2D<F32>)
     ->Args({32, 64, 64, 32, 3, 3, 64})
     ->Args({32, 256, 256, 4, 3, 3, 16})
     ->Args({32, 64, 64, 4, 3, 3, 16})
-    ->Args({32, 32, 32, 96, 3, 3, 96});
+    ->Args({32, 32, 32, 96, 3, 3, 96})
+    // Small batch 3x3 convolutions, e.g. from ResNet and MobileNet models.
+    ->Args({1, 56, 56, 64, 3, 3, 64})
+    ->Args({1, 28, 28, 128, 3, 3, 128})
+    ->Args({1, 14, 14, 256, 3, 3, 256})
+    ->Args({4, 56, 56, 64, 3, 3, 64});
 
 // -------------------------------------------------------------------------- //
 // Grouped convolution
@@ -460,7 +465,14 @@ XLA_CPU_BENCHMARK(BM_Conv2D<F32>)
 
 XLA_CPU_BENCHMARK(BM_GroupedConv2D)
     ->MeasureProcessCPUTime()
-    ->Args({1, 45, 45, 1024, 5, 5, 1024, 1024});
+    ->Args({1, 45, 45, 1024, 5, 5, 1024, 1024})
+    // Depthwise convolutions from MobileNet models.
+    ->Args({1, 112, 112, 32, 3, 3, 32, 32})
+    ->Args({1, 56, 56, 128, 3, 3, 128, 128})
+    ->Args({1, 14, 14, 512, 3, 3, 512, 512})
+    ->Args({1, 7, 7, 1024, 3, 3, 1024, 1024})
+    // Depthwise convolution with a depth multiplier of 2.
+    ->Args({1, 56, 56, 64, 3, 3, 128, 64});
 
 // -------------------------------------------------------------------------- //
 // 1D and 2D strided convolutions
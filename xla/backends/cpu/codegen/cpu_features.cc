@@ -186,6 +186,11 @@ static bool ShouldEnableAArch64CpuFeature(absl::string_view feature,
       if (feature == "sve2") return false;
       [[fallthrough]];
 
+    case CPUFeature::AARCH64_SVE2:
+      // SME (ARMv9) matrix extensions come after SVE2.
+      if (absl::StartsWith(feature, "sme")) return false;
+      [[fallthrough]];
+
     default:
       // Leave all other features enabled.
       return true;
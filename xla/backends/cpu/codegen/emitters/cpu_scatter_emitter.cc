@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "xla/backends/cpu/codegen/emitters/cpu_scatter_emitter.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <memory>
 #include <numeric>
@@ -180,6 +181,12 @@ SmallVector<Value> EmitScatterComputation(
   return {atomic_rmw->getResult(0)};
 }
 
+// Minimum number of update elements scattered by a single work group.
+static constexpr int64_t kMinUpdateElementsPerThread = 32 * 1024;
+
+// Maximum number of work groups for a parallel scatter.
+static constexpr int64_t kMaxNumThreads = 64;
+
 CpuScatterFusion::CpuScatterFusion(const BufferAssignment& buffer_assignment,
                                    const HloFusionInstruction* fusion)
     : buffer_assignment_(buffer_assignment), fusion_(fusion) {
@@ -188,7 +195,6 @@ CpuScatterFusion::CpuScatterFusion(const BufferAssignment& buffer_assignment,
   auto update_shape = scatter->scatter_updates().front()->shape();
   auto output_shape = scatter->scatter_operands().front()->shape();
 
-  num_threads_ = 1;
   SmallVector<int64_t, 2> slice_shape(update_shape.dimensions().begin() + 1,
                                       update_shape.dimensions().end());
   int64_t num_elements = Product(slice_shape);
@@ -198,6 +204,20 @@ CpuScatterFusion::CpuScatterFusion(const BufferAssignment& buffer_assignment,
       max_vectorized_bytes /
       ShapeUtil::ByteSizeOfPrimitiveType(output_shape.element_type());
   vector_size_ = std::gcd(max_vectorized_elements, num_elements);
+
+  // Updates are partitioned between work groups by the update index, and
+  // different work groups might write to the same output element. We can run
+  // scatter in parallel if indices are unique (there are no conflicting
+  // writes), or if it has a single operand (conflicting writes are resolved
+  // with atomic read-modify-write operations). Scatters with multiple operands
+  // must update all of them at once and are emitted as a serial loop.
+  num_threads_ = 1;
+  int64_t num_updates = update_shape.dimensions(0);
+  if (scatter->unique_indices() || scatter->scatter_operand_count() == 1) {
+    num_threads_ = std::clamp(
+        num_updates * num_elements / kMinUpdateElementsPerThread, int64_t{1},
+        std::min(kMaxNumThreads, num_updates));
+  }
   if (VLOG_IS_ON(5)) {
     llvm::errs() << "\nvector_size_: " << vector_size_ << "\n\n";
     llvm::errs() << "\num_threads_: " << num_threads_ << "\n\n";
@@ -340,7 +340,7 @@ llvm::Error IrCompiler::RunIrPasses(llvm::Module& module,
   auto target_library_info_impl =
       std::make_unique<llvm::TargetLibraryInfoImpl>(target_triple);
   target_library_info_impl->addVectorizableFunctions(
-      PolynomialApproximationsVectorization());
+      PolynomialApproximationsVectorization(options_.fast_math_flags));
   codegen::MathFunctionLib math_lib;
   target_library_info_impl->addVectorizableFunctions(math_lib.Vectorizations());
 
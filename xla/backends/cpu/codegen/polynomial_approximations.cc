@@ -412,6 +412,93 @@ llvm::Value* GenerateVF32Log(llvm::IRBuilderBase* b, llvm::Value* input,
                                    result_finite_or_nan));
 }
 
+// Computes sin(x) (or cos(x) if `is_cos` is true) using the same polynomial
+// approximations as Cephes and Eigen3 on the reduced argument.
+//
+// We reexpress x as x = q * pi/2 + r, where q = round(x * 2/pi) and r is in
+// [-pi/4, pi/4], and pick the sin or cos polynomial of r (and its sign) based
+// on the quadrant q. Because cos(x) = sin(x + pi/2), cos uses the quadrant
+// q + 1 with the same r.
+//
+// The reduction computes x - q * pi/2 with pi/2 split into three parts
+// (Cody-Waite), which keeps the result within a few ulp for |x| up to ~10^4.
+// Accuracy degrades for larger arguments, which is why these approximations
+// are used only when approximate math functions are allowed.
+llvm::Value* GenerateVF32SinCos(llvm::IRBuilderBase* b, llvm::Value* input,
+                                int32_t vector_width, bool is_cos) {
+  VectorIrBuilder vb(F32, vector_width, b, is_cos ? "cos_f32" : "sin_f32");
+
+  const llvm::APFloat half = GetIeeeF32(0.5);
+  const llvm::APFloat one = GetIeeeF32(1.0);
+  const llvm::APFloat two_over_pi = GetIeeeF32(0.636619772367581343);
+
+  // pi/2 split into three parts, so that q * pio2_1 and q * pio2_2 are exact.
+  const llvm::APFloat pio2_1 = GetIeeeF32(1.5703125);
+  const llvm::APFloat pio2_2 = GetIeeeF32(4.837512969970703125e-4);
+  const llvm::APFloat pio2_3 = GetIeeeF32(7.54978995489188216e-8);
+
+  const llvm::APFloat cephes_sin_p0 = GetIeeeF32(-1.9515295891E-4);
+  const llvm::APFloat cephes_sin_p1 = GetIeeeF32(8.3321608736E-3);
+  const llvm::APFloat cephes_sin_p2 = GetIeeeF32(-1.6666654611E-1);
+
+  const llvm::APFloat cephes_cos_p0 = GetIeeeF32(2.443315711809948E-5);
+  const llvm::APFloat cephes_cos_p1 = GetIeeeF32(-1.388731625493765E-3);
+  const llvm::APFloat cephes_cos_p2 = GetIeeeF32(4.166664568298827E-2);
+  const llvm::APFloat cephes_cos_p3 = GetIeeeF32(-0.5);
+
+  // q = round(x * 2/pi).
+  llvm::Value* q = vb.Floor(vb.MulAdd(input, two_over_pi, half));
+
+  // r = x - q * pi/2.
+  llvm::Value* r = vb.Sub(input, vb.Mul(pio2_1, q));
+  r = vb.Sub(r, vb.Mul(pio2_2, q));
+  r = vb.Sub(r, vb.Mul(pio2_3, q));
+
+  llvm::Value* r2 = vb.Mul(r, r);
+
+  // sin(r) = r + r^3 * P(r^2).
+  llvm::Value* sin_r = vb.MulAdd(r2, cephes_sin_p0, cephes_sin_p1);
+  sin_r = vb.MulAdd(sin_r, r2, cephes_sin_p2);
+  sin_r = vb.MulAdd(sin_r, vb.Mul(r2, r), r);
+
+  // cos(r) = 1 - r^2 / 2 + r^4 * Q(r^2).
+  llvm::Value* cos_r = vb.MulAdd(r2, cephes_cos_p0, cephes_cos_p1);
+  cos_r = vb.MulAdd(cos_r, r2, cephes_cos_p2);
+  cos_r = vb.MulAdd(cos_r, r2, cephes_cos_p3);
+  cos_r = vb.MulAdd(cos_r, r2, one);
+
+  // Quadrant as an integer. For inf and nan inputs `r` is nan and the result
+  // is nan regardless of the quadrant, so we only need the conversion to not
+  // produce poison.
+  llvm::Type* i32_vector_type =
+      llvm::VectorType::get(b->getInt32Ty(), vector_width, false);
+  llvm::Value* q_i32 = b->CreateFreeze(b->CreateFPToSI(q, i32_vector_type));
+  if (is_cos) {
+    q_i32 = b->CreateAdd(q_i32, b->CreateVectorSplat(vector_width,
+                                                     b->getInt32(1)));
+  }
+
+  auto test_bit = [&](int32_t bit) {
+    llvm::Value* mask = b->CreateVectorSplat(vector_width, b->getInt32(bit));
+    return b->CreateICmpNE(b->CreateAnd(q_i32, mask),
+                           llvm::Constant::getNullValue(i32_vector_type));
+  };
+
+  // Odd quadrants use the cos polynomial, quadrants 2 and 3 flip the sign.
+  llvm::Value* result = b->CreateSelect(test_bit(1), cos_r, sin_r);
+  return b->CreateSelect(test_bit(2), b->CreateFNeg(result), result);
+}
+
+llvm::Value* GenerateVF32Sin(llvm::IRBuilderBase* b, llvm::Value* input,
+                             int32_t vector_width) {
+  return GenerateVF32SinCos(b, input, vector_width, /*is_cos=*/false);
+}
+
+llvm::Value* GenerateVF32Cos(llvm::IRBuilderBase* b, llvm::Value* input,
+                             int32_t vector_width) {
+  return GenerateVF32SinCos(b, input, vector_width, /*is_cos=*/true);
+}
+
 // Generates an IR for computing output value via upcasting to F32:
 //   output = cast<F16>(generator(cast<F32>(input)))
 template <Generator generator>
@@ -544,9 +631,56 @@ std::vector<llvm::VecDesc> LogVectorization() {
   };
 }
 
+//===----------------------------------------------------------------------===//
+// Sin and Cos
+//===----------------------------------------------------------------------===//
+
+static constexpr absl::string_view kSinV4F32Sym = "__xla_cpu_SinV4F32";
+static constexpr absl::string_view kSinV8F32Sym = "__xla_cpu_SinV8F32";
+static constexpr absl::string_view kSinV16F32Sym = "__xla_cpu_SinV16F32";
+
+static constexpr absl::string_view kCosV4F32Sym = "__xla_cpu_CosV4F32";
+static constexpr absl::string_view kCosV8F32Sym = "__xla_cpu_CosV8F32";
+static constexpr absl::string_view kCosV16F32Sym = "__xla_cpu_CosV16F32";
+
+std::vector<llvm::VecDesc> SinCosVectorization() {
+  return {
+      {"sinf", kSinV4F32Sym, llvm::ElementCount::getFixed(4), false,
+       GetVfabiPrefix(4), std::nullopt},
+      {"llvm.sin.f32", kSinV4F32Sym, llvm::ElementCount::getFixed(4), false,
+       GetVfabiPrefix(4), std::nullopt},
+
+      {"sinf", kSinV8F32Sym, llvm::ElementCount::getFixed(8), false,
+       GetVfabiPrefix(8), std::nullopt},
+      {"llvm.sin.f32", kSinV8F32Sym, llvm::ElementCount::getFixed(8), false,
+       GetVfabiPrefix(8), std::nullopt},
+
+      {"sinf", kSinV16F32Sym, llvm::ElementCount::getFixed(16), false,
+       GetVfabiPrefix(16), std::nullopt},
+      {"llvm.sin.f32", kSinV16F32Sym, llvm::ElementCount::getFixed(16), false,
+       GetVfabiPrefix(16), std::nullopt},
+
+      {"cosf", kCosV4F32Sym, llvm::ElementCount::getFixed(4), false,
+       GetVfabiPrefix(4), std::nullopt},
+      {"llvm.cos.f32", kCosV4F32Sym, llvm::ElementCount::getFixed(4), false,
+       GetVfabiPrefix(4), std::nullopt},
+
+      {"cosf", kCosV8F32Sym, llvm::ElementCount::getFixed(8), false,
+       GetVfabiPrefix(8), std::nullopt},
+      {"llvm.cos.f32", kCosV8F32Sym, llvm::ElementCount::getFixed(8), false,
+       GetVfabiPrefix(8), std::nullopt},
+
+      {"cosf", kCosV16F32Sym, llvm::ElementCount::getFixed(16), false,
+       GetVfabiPrefix(16), std::nullopt},
+      {"llvm.cos.f32", kCosV16F32Sym, llvm::ElementCount::getFixed(16), false,
+       GetVfabiPrefix(16), std::nullopt},
+  };
+}
+
 }  // namespace
 
-std::vector<llvm::VecDesc> PolynomialApproximationsVectorization() {
+std::vector<llvm::VecDesc> PolynomialApproximationsVectorization(
+    llvm::FastMathFlags fast_math_flags) {
   auto exp = ExpVectorization();
   auto log = LogVectorization();
   auto tanh = TanhVectorization();
@@ -555,6 +689,11 @@ std::vector<llvm::VecDesc> PolynomialApproximationsVectorization() {
   vec_descs.insert(vec_descs.end(), exp.begin(), exp.end());
   vec_descs.insert(vec_descs.end(), log.begin(), log.end());
   vec_descs.insert(vec_descs.end(), tanh.begin(), tanh.end());
+
+  if (fast_math_flags.approxFunc()) {
+    auto sincos = SinCosVectorization();
+    vec_descs.insert(vec_descs.end(), sincos.begin(), sincos.end());
+  }
   return vec_descs;
 }
 
@@ -618,6 +757,29 @@ void RewriteToPolynomialApproximations(llvm::Module* module,
                 /*vector_width=*/8);
   rewrite_calls(kLogV16F16Sym, UpcastF16ToF32<GenerateVF32Log>,
                 /*vector_width=*/16);
+
+  //===----------------------------------------------------------------===//
+  // Sin and Cos
+  //===----------------------------------------------------------------===//
+
+  // Sin and cos approximations lose accuracy for large arguments, and we use
+  // them only if approximate math functions are allowed, otherwise these calls
+  // are resolved to `libm`.
+  if (!fast_math_flags.approxFunc()) {
+    return;
+  }
+
+  rewrite_calls("sinf", GenerateVF32Sin, /*vector_width=*/1);
+  rewrite_calls("llvm.sin.f32", GenerateVF32Sin, /*vector_width=*/1);
+  rewrite_calls(kSinV4F32Sym, GenerateVF32Sin, /*vector_width=*/4);
+  rewrite_calls(kSinV8F32Sym, GenerateVF32Sin, /*vector_width=*/8);
+  rewrite_calls(kSinV16F32Sym, GenerateVF32Sin, /*vector_width=*/16);
+
+  rewrite_calls("cosf", GenerateVF32Cos, /*vector_width=*/1);
+  rewrite_calls("llvm.cos.f32", GenerateVF32Cos, /*vector_width=*/1);
+  rewrite_calls(kCosV4F32Sym, GenerateVF32Cos, /*vector_width=*/4);
+  rewrite_calls(kCosV8F32Sym, GenerateVF32Cos, /*vector_width=*/8);
+  rewrite_calls(kCosV16F32Sym, GenerateVF32Cos, /*vector_width=*/16);
 }
 
 }  // namespace xla::cpu
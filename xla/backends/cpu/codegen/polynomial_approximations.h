@@ -45,7 +45,11 @@ namespace xla::cpu {
 // vectorized polynomial approximations. This enables LLVM vectorization passes
 // to vectorize scalar math functions to custom function calls, that we later
 // rewrite into LLVM IR, so we don't have any function calls in compiled code.
-std::vector<llvm::VecDesc> PolynomialApproximationsVectorization();
+//
+// Approximations that are not accurate for the whole input range (sin, cos)
+// are included only if `fast_math_flags` allow approximate functions.
+std::vector<llvm::VecDesc> PolynomialApproximationsVectorization(
+    llvm::FastMathFlags fast_math_flags);
 
 // Rewrites supported math functions into LLVM IR polynomial approximations.
 //
@@ -37,8 +37,11 @@ TargetMachineFeatures::TargetMachineFeatures(
   // Calling virtual methods in the constructor is discouraged, so we don't
   // call `get_target_feature_string` here.
   if (target_machine_) {
-    has_avx512bf16_ = absl::StrContains(
-        target_machine_->getTargetFeatureString().str(), "+avx512bf16");
+    std::string features = target_machine_->getTargetFeatureString().str();
+    has_avx512bf16_ = absl::StrContains(features, "+avx512bf16");
+    has_amx_bf16_ = absl::StrContains(features, "+amx-bf16");
+    has_amx_int8_ = absl::StrContains(features, "+amx-int8");
+    has_sme_ = absl::StrContains(features, "+sme");
   }
 }
 
@@ -70,6 +70,9 @@ class TargetMachineFeatures {
   virtual std::string get_target_feature_string() const;
 
   virtual bool has_avx512bf16() const { return has_avx512bf16_; }
+  virtual bool has_amx_bf16() const { return has_amx_bf16_; }
+  virtual bool has_amx_int8() const { return has_amx_int8_; }
+  virtual bool has_sme() const { return has_sme_; }
 
  private:
   llvm::TargetTransformInfo* GetTargetTransformInfoFor(
@@ -83,6 +86,9 @@ class TargetMachineFeatures {
 
   // Store availability of popular features here for efficient checks.
   bool has_avx512bf16_ = false;
+  bool has_amx_bf16_ = false;
+  bool has_amx_int8_ = false;
+  bool has_sme_ = false;
 };
 
 }  // namespace xla::cpu
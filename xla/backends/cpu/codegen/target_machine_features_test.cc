@@ -63,5 +63,38 @@ INSTANTIATE_TEST_SUITE_P(Avx512Bf16Suite, Avx512Bf16Test,
                          ::testing::ValuesIn(GetAvx512Bf16TestSpecs()),
                          Avx512Bf16Test::Name);
 
+struct AmxTestSpec {
+  std::string cpu_name;
+  std::string features;
+  bool has_amx;
+};
+
+class AmxTest : public TargetMachineTestBase,
+                public ::testing::WithParamInterface<AmxTestSpec> {
+ public:
+  static std::string Name(const ::testing::TestParamInfo<AmxTestSpec>& info) {
+    return info.param.cpu_name;
+  }
+};
+
+TEST_P(AmxTest, CheckAvailability) {
+  AmxTestSpec spec = GetParam();
+  const char* triple_string = "x86_64-unknown-linux-gnu";
+  std::unique_ptr<TargetMachineFeatures> features =
+      CreateTargetMachineFeatures(triple_string, spec.cpu_name, spec.features);
+  EXPECT_EQ(features->has_amx_bf16(), spec.has_amx);
+  EXPECT_EQ(features->has_amx_int8(), spec.has_amx);
+  EXPECT_FALSE(features->has_sme());
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    AmxSuite, AmxTest,
+    ::testing::ValuesIn(std::vector<AmxTestSpec>{
+        AmxTestSpec{"cooperlake", "+avx512vnni,+avx512bf16", false},
+        AmxTestSpec{"sapphirerapids",
+                    "+avx512vnni,+avx512bf16,+amx-bf16,+amx-int8,+amx-tile",
+                    true}}),
+    AmxTest::Name);
+
 }  // namespace
 }  // namespace xla::cpu
@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "xla/backends/cpu/collectives/gloo_collectives.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <exception>
 #include <memory>
@@ -28,6 +29,7 @@ limitations under the License.
 #include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_join.h"
+#include "absl/strings/string_view.h"
 #include "absl/types/span.h"
 #include "gloo/context.h"
 #include "gloo/rendezvous/context.h"
@@ -39,58 +41,82 @@ limitations under the License.
 #include "xla/core/collectives/clique_key.h"
 #include "xla/core/collectives/communicator.h"
 #include "xla/service/global_device_id.h"
+#include "xla/tsl/platform/statusor.h"
 #include "xla/xla_data.pb.h"
 
 namespace xla::cpu {
 
 GlooCollectives::GlooCollectives(
     std::unique_ptr<gloo::rendezvous::Store> store,
-    std::shared_ptr<gloo::transport::Device> device)
-    : store_(std::move(store)), device_(std::move(device)) {}
+    std::shared_ptr<gloo::transport::Device> device, size_t num_channels)
+    : store_(std::move(store)),
+      device_(std::move(device)),
+      num_channels_(std::max<size_t>(num_channels, 1)) {}
 
 GlooCollectives::~GlooCollectives() = default;
 
-absl::StatusOr<std::vector<std::unique_ptr<Communicator>>>
-GlooCollectives::CreateCommunicators(const CliqueKey& clique_key,
-                                     const std::optional<CliqueIds>& clique_ids,
-                                     absl::Span<const DeviceRank> ranks,
-                                     const Config& config) {
-  std::vector<std::unique_ptr<Communicator>> communicators;
-  for (auto& device_rank : ranks) {
-    size_t rank = device_rank.rank.value();
-
-    auto gloo_context = std::make_shared<gloo::rendezvous::Context>(
-        rank, clique_key.num_devices());
+absl::StatusOr<std::shared_ptr<gloo::Context>> GlooCollectives::ConnectContext(
+    absl::string_view prefix, size_t rank, size_t num_ranks) {
+  auto gloo_context =
+      std::make_shared<gloo::rendezvous::Context>(rank, num_ranks);
 
 #ifdef GLOO_SHARED_STORE
-    auto store_pointer = std::shared_ptr<gloo::rendezvous::Store>(
-        store_.get(), [](gloo::rendezvous::Store*) {});
+  auto store_pointer = std::shared_ptr<gloo::rendezvous::Store>(
+      store_.get(), [](gloo::rendezvous::Store*) {});
 #else
-    auto& store_pointer = *store_;
+  auto& store_pointer = *store_;
 #endif  // GLOO_SHARED_STORE
 
-    auto prefix_store = std::make_shared<gloo::rendezvous::PrefixStore>(
-        absl::StrCat("gloo/",
-                     absl::StrJoin(clique_key.devices(), ",",
-                                   [](std::string* out, GlobalDeviceId id) {
-                                     absl::StrAppend(out, id.value());
-                                   })),
-        store_pointer);
+  auto prefix_store = std::make_shared<gloo::rendezvous::PrefixStore>(
+      std::string(prefix), store_pointer);
 
-    try {
+  try {
 #ifdef GLOO_SHARED_STORE
-      auto prefix_store_pointer = prefix_store;
+    auto prefix_store_pointer = prefix_store;
 #else
-      auto& prefix_store_pointer = *prefix_store;
+    auto& prefix_store_pointer = *prefix_store;
 #endif  // GLOO_SHARED_STORE
-      gloo_context->connectFullMesh(prefix_store_pointer, device_);
-    } catch (std::exception& e) {
-      return absl::UnknownError(
-          absl::StrCat("Gloo context initialization failed: ", e.what()));
+    gloo_context->connectFullMesh(prefix_store_pointer, device_);
+  } catch (std::exception& e) {
+    return absl::UnknownError(
+        absl::StrCat("Gloo context initialization failed: ", e.what()));
+  }
+  return gloo_context;
+}
+
+absl::StatusOr<std::vector<std::unique_ptr<Communicator>>>
+GlooCollectives::CreateCommunicators(const CliqueKey& clique_key,
+                                     const std::optional<CliqueIds>& clique_ids,
+                                     absl::Span<const DeviceRank> ranks,
+                                     const Config& config) {
+  std::string prefix = absl::StrCat(
+      "gloo/", absl::StrJoin(clique_key.devices(), ",",
+                             [](std::string* out, GlobalDeviceId id) {
+                               absl::StrAppend(out, id.value());
+                             }));
+
+  std::vector<std::unique_ptr<Communicator>> communicators;
+  for (auto& device_rank : ranks) {
+    size_t rank = device_rank.rank.value();
+
+    TF_ASSIGN_OR_RETURN(
+        std::shared_ptr<gloo::Context> gloo_context,
+        ConnectContext(prefix, rank, clique_key.num_devices()));
+
+    // Every additional channel is a separate full mesh of connections, and
+    // large all-reduce operations are striped over all of them.
+    std::vector<std::shared_ptr<gloo::Context>> channel_contexts;
+    for (size_t channel = 1; channel < num_channels_; ++channel) {
+      TF_ASSIGN_OR_RETURN(
+          std::shared_ptr<gloo::Context> channel_context,
+          ConnectContext(absl::StrCat(prefix, "/channel", channel), rank,
+                         clique_key.num_devices()));
+      channel_contexts.push_back(std::move(channel_context));
     }
 
     communicators.push_back(std::make_unique<GlooCommunicator>(
-        std::move(gloo_context), rank, clique_key.num_devices()));
+        std::move(gloo_context), rank, clique_key.num_devices(),
+        std::move(channel_contexts)));
   }
 
   return communicators;
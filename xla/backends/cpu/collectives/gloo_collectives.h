@@ -16,12 +16,14 @@ limitations under the License.
 #ifndef XLA_BACKENDS_CPU_COLLECTIVES_GLOO_COLLECTIVES_H_
 #define XLA_BACKENDS_CPU_COLLECTIVES_GLOO_COLLECTIVES_H_
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <optional>
 #include <vector>
 
 #include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
 #include "absl/types/span.h"
 #include "gloo/context.h"
 #include "gloo/rendezvous/store.h"
@@ -36,8 +38,13 @@ namespace xla::cpu {
 
 class GlooCollectives : public CpuCollectives {
  public:
+  // If `num_channels` is larger than one, every communicator opens that many
+  // independent sets of connections to its peers, and stripes large
+  // all-reduce operations across them to saturate fast network links that a
+  // single TCP connection can't fill.
   GlooCollectives(std::unique_ptr<gloo::rendezvous::Store> store,
-                  std::shared_ptr<gloo::transport::Device> device);
+                  std::shared_ptr<gloo::transport::Device> device,
+                  size_t num_channels = 1);
   ~GlooCollectives() override;
 
   absl::StatusOr<std::vector<std::unique_ptr<Communicator>>>
@@ -47,8 +54,14 @@ class GlooCollectives : public CpuCollectives {
                       const Config& config) final;
 
  private:
+  // Creates a Gloo context for `rank` and connects it to all other ranks using
+  // keys under `prefix` in the rendezvous store.
+  absl::StatusOr<std::shared_ptr<gloo::Context>> ConnectContext(
+      absl::string_view prefix, size_t rank, size_t num_ranks);
+
   std::unique_ptr<gloo::rendezvous::Store> store_;
   std::shared_ptr<gloo::transport::Device> device_;
+  size_t num_channels_;
 };
 
 }  // namespace xla::cpu
@@ -66,14 +66,16 @@ constexpr absl::Duration kTimeout = absl::Seconds(5);
 
 absl::StatusOr<std::unique_ptr<Communicator>> GetCommunicator(
     size_t kNumParticipants, absl::Span<GlobalDeviceId const> global_devices,
-    const std::shared_ptr<xla::KeyValueStoreInterface>& kv_store, int rank) {
+    const std::shared_ptr<xla::KeyValueStoreInterface>& kv_store, int rank,
+    size_t num_channels = 1) {
   auto collectives = std::make_shared<cpu::GlooCollectives>(
       std::make_unique<cpu::GlooKeyValueStore>(kv_store),
 #if defined(__linux__)
-      gloo::transport::tcp::CreateDevice(gloo::transport::tcp::attr()));
+      gloo::transport::tcp::CreateDevice(gloo::transport::tcp::attr()),
 #elif defined(__APPLE__)
-      gloo::transport::uv::CreateDevice(gloo::transport::uv::attr()));
+      gloo::transport::uv::CreateDevice(gloo::transport::uv::attr()),
 #endif  // defined(__linux__)
+      num_channels);
 
   CpuCliqueKey clique_key(global_devices);
   CpuCollectives::DeviceRank device_rank(nullptr, RankId(rank));
@@ -103,17 +105,20 @@ static se::DeviceMemoryBase AsDeviceMemory(const std::vector<T>& data) {
 absl::StatusOr<std::vector<uint8_t>> AllReduce(
     const std::shared_ptr<xla::KeyValueStoreInterface>& kv_store,
     const std::vector<uint8_t>& input_buffer,
-    std::vector<GlobalDeviceId> global_devices, int rank) {
-  std::vector<uint8_t> output_buffer(kBufferSize);
+    std::vector<GlobalDeviceId> global_devices, int rank,
+    size_t num_channels = 1) {
+  std::vector<uint8_t> output_buffer(input_buffer.size());
   RendezvousKey rendezvous_key = MakeRendezvousKey(global_devices);
   TF_ASSIGN_OR_RETURN(
       auto communicator,
-      GetCommunicator(kNumParticipants, global_devices, kv_store, rank));
+      GetCommunicator(kNumParticipants, global_devices, kv_store, rank,
+                      num_channels));
 
   CpuCollectives::Executor executor(rendezvous_key, kTimeout);
   auto event = communicator->AllReduce(
       AsDeviceMemory(input_buffer), AsDeviceMemory(output_buffer),
-      xla::PrimitiveType::U8, kBufferSize, xla::ReductionKind::SUM, executor);
+      xla::PrimitiveType::U8, input_buffer.size(), xla::ReductionKind::SUM,
+      executor);
 
   tsl::BlockUntilReady(event);
 
@@ -124,7 +129,38 @@ absl::StatusOr<std::vector<uint8_t>> AllReduce(
   return output_buffer;
 }
 
-TEST(GlooCollectives, AllReduce) {
+absl::StatusOr<std::vector<uint8_t>> CollectivePermute(
+    const std::shared_ptr<xla::KeyValueStoreInterface>& kv_store,
+    const std::vector<uint8_t>& input_buffer,
+    std::vector<GlobalDeviceId> global_devices, int rank,
+    size_t num_channels) {
+  std::vector<uint8_t> output_buffer(input_buffer.size());
+  RendezvousKey rendezvous_key = MakeRendezvousKey(global_devices);
+  TF_ASSIGN_OR_RETURN(
+      auto communicator,
+      GetCommunicator(kNumParticipants, global_devices, kv_store, rank,
+                      num_channels));
+
+  // Every rank sends its buffer to the next rank in a ring.
+  RankId source_rank((rank + kNumParticipants - 1) % kNumParticipants);
+  RankId target_rank((rank + 1) % kNumParticipants);
+
+  CpuCollectives::Executor executor(rendezvous_key, kTimeout);
+  auto event = communicator->CollectivePermute(
+      AsDeviceMemory(input_buffer), AsDeviceMemory(output_buffer),
+      xla::PrimitiveType::U8, input_buffer.size(), source_rank, {target_rank},
+      executor);
+
+  tsl::BlockUntilReady(event);
+
+  if (event.IsError()) {
+    return event.GetError();
+  }
+
+  return output_buffer;
+}
+
+void RunAllReduce(size_t buffer_size, size_t num_channels) {
   std::vector<GlobalDeviceId> global_devices;
   global_devices.reserve(kNumParticipants);
   for (int rank = 0; rank < kNumParticipants; ++rank) {
@@ -142,12 +178,12 @@ TEST(GlooCollectives, AllReduce) {
     tsl::thread::ThreadPool thread_pool(
         tsl::Env::Default(), "AllReduceParticipants", kNumParticipants);
     for (int rank = 0; rank < kNumParticipants; ++rank) {
-      thread_pool.Schedule(
-          [rank, &output_buffers, &kv_store, &global_devices]() {
-            std::vector<uint8_t> input_buffer(kBufferSize, rank + 1);
-            output_buffers[rank] =
-                AllReduce(kv_store, input_buffer, global_devices, rank);
-          });
+      thread_pool.Schedule([rank, buffer_size, num_channels, &output_buffers,
+                            &kv_store, &global_devices]() {
+        std::vector<uint8_t> input_buffer(buffer_size, rank + 1);
+        output_buffers[rank] = AllReduce(kv_store, input_buffer,
+                                         global_devices, rank, num_channels);
+      });
     }
   }
   // thread_pool is now out of scope, so all threads have joined.
@@ -162,5 +198,51 @@ TEST(GlooCollectives, AllReduce) {
                 Each(Eq(kNumParticipants * (kNumParticipants + 1) / 2)));
   }
 }
+
+TEST(GlooCollectives, AllReduce) {
+  RunAllReduce(kBufferSize, /*num_channels=*/1);
+}
+
+TEST(GlooCollectives, StripedAllReduce) {
+  // Large enough to be split over channels, and not a multiple of the number
+  // of channels to exercise the uneven last chunk.
+  RunAllReduce(/*buffer_size=*/4 * 1024 * 1024 + 1, /*num_channels=*/3);
+}
+
+TEST(GlooCollectives, StripedCollectivePermute) {
+  // Large enough to be split over channels.
+  constexpr size_t kStripedBufferSize = 4 * 1024 * 1024 + 1;
+
+  std::vector<GlobalDeviceId> global_devices;
+  global_devices.reserve(kNumParticipants);
+  for (int rank = 0; rank < kNumParticipants; ++rank) {
+    global_devices.push_back(GlobalDeviceId(rank));
+  }
+
+  auto kv_store = std::make_shared<xla::InMemoryKeyValueStore>();
+  std::vector<absl::StatusOr<std::vector<uint8_t>>> output_buffers(
+      kNumParticipants);
+
+  {
+    tsl::thread::ThreadPool thread_pool(
+        tsl::Env::Default(), "CollectivePermuteParticipants", kNumParticipants);
+    for (int rank = 0; rank < kNumParticipants; ++rank) {
+      thread_pool.Schedule([rank, &output_buffers, &kv_store,
+                            &global_devices]() {
+        std::vector<uint8_t> input_buffer(kStripedBufferSize, rank + 1);
+        output_buffers[rank] =
+            CollectivePermute(kv_store, input_buffer, global_devices, rank,
+                              /*num_channels=*/3);
+      });
+    }
+  }
+
+  for (int rank = 0; rank < kNumParticipants; ++rank) {
+    TF_ASSERT_OK(output_buffers[rank].status());
+    int source_rank = (rank + kNumParticipants - 1) % kNumParticipants;
+    EXPECT_THAT(output_buffers[rank].value(), Each(Eq(source_rank + 1)));
+  }
+}
+
 }  // namespace
 }  // namespace xla::cpu
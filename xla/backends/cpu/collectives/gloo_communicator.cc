@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "xla/backends/cpu/collectives/gloo_communicator.h"
 
+#include <algorithm>
 #include <complex>
 #include <cstddef>
 #include <cstdint>
@@ -29,6 +30,7 @@ limitations under the License.
 #include "absl/log/log.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
+#include "absl/synchronization/blocking_counter.h"
 #include "absl/time/clock.h"
 #include "absl/time/time.h"
 #include "absl/types/span.h"
@@ -48,19 +50,35 @@ limitations under the License.
 #include "xla/status_macros.h"
 #include "xla/stream_executor/device_memory.h"
 #include "xla/tsl/concurrency/async_value_ref.h"
+#include "xla/tsl/platform/env.h"
 #include "xla/tsl/platform/errors.h"
 #include "xla/tsl/platform/statusor.h"
+#include "xla/tsl/platform/threadpool.h"
 #include "xla/types.h"
+#include "xla/util.h"
 #include "xla/xla_data.pb.h"
 
 namespace xla::cpu {
 
-GlooCommunicator::GlooCommunicator(std::shared_ptr<gloo::Context> context,
-                                   size_t rank, size_t num_ranks)
-    : context_(std::move(context)), rank_(rank), num_ranks_(num_ranks) {}
+GlooCommunicator::GlooCommunicator(
+    std::shared_ptr<gloo::Context> context, size_t rank, size_t num_ranks,
+    std::vector<std::shared_ptr<gloo::Context>> channel_contexts)
+    : context_(std::move(context)),
+      rank_(rank),
+      num_ranks_(num_ranks),
+      channel_contexts_(std::move(channel_contexts)) {
+  if (!channel_contexts_.empty()) {
+    channel_thread_pool_ = std::make_unique<tsl::thread::ThreadPool>(
+        tsl::Env::Default(), "gloo-channels", channel_contexts_.size());
+  }
+}
 
 GlooCommunicator::~GlooCommunicator() = default;
 
+// Transfers smaller than this are not striped over channels, as they are
+// latency bound and splitting them only adds synchronization cost.
+static constexpr size_t kMinStripedTransferBytes = 1024 * 1024;
+
 template <typename T>
 static absl::Status SetAllReduceOptions(ReductionKind reduction_kind,
                                         se::DeviceMemoryBase input_buffer,
@@ -103,13 +121,13 @@ static absl::Status SetAllReduceOptions(ReductionKind reduction_kind,
   return absl::OkStatus();
 }
 
-tsl::AsyncValueRef<GlooCommunicator::Event> GlooCommunicator::AllReduce(
-    se::DeviceMemoryBase send_buffer, se::DeviceMemoryBase recv_buffer,
-    PrimitiveType dtype, size_t count, ReductionKind reduction_kind,
-    const Executor& executor) {
-  TF_ASSIGN_OR_RETURN(auto cpu_executor, CpuCollectives::TryCast(&executor));
-
-  gloo::AllreduceOptions options(context_);
+static absl::Status GlooAllReduce(std::shared_ptr<gloo::Context> context,
+                                  se::DeviceMemoryBase send_buffer,
+                                  se::DeviceMemoryBase recv_buffer,
+                                  PrimitiveType dtype, size_t count,
+                                  ReductionKind reduction_kind,
+                                  absl::Duration timeout) {
+  gloo::AllreduceOptions options(std::move(context));
   // TODO(phawkins): how to do tags?
   // options.setTag(tag);
   switch (dtype) {
@@ -174,7 +192,7 @@ tsl::AsyncValueRef<GlooCommunicator::Event> GlooCommunicator::AllReduce(
       return absl::InvalidArgumentError("Unknown datatype in allreduce");
   }
   options.setAlgorithm(gloo::AllreduceOptions::Algorithm::RING);
-  options.setTimeout(absl::ToChronoMilliseconds(cpu_executor->timeout()));
+  options.setTimeout(absl::ToChronoMilliseconds(timeout));
 
   try {
     gloo::allreduce(options);
@@ -182,6 +200,54 @@ tsl::AsyncValueRef<GlooCommunicator::Event> GlooCommunicator::AllReduce(
     return absl::UnknownError(
         absl::StrCat("Gloo all-reduce failed: ", e.what()));
   }
+  return absl::OkStatus();
+}
+
+tsl::AsyncValueRef<GlooCommunicator::Event> GlooCommunicator::AllReduce(
+    se::DeviceMemoryBase send_buffer, se::DeviceMemoryBase recv_buffer,
+    PrimitiveType dtype, size_t count, ReductionKind reduction_kind,
+    const Executor& executor) {
+  TF_ASSIGN_OR_RETURN(auto cpu_executor, CpuCollectives::TryCast(&executor));
+
+  size_t element_bytes = primitive_util::ByteWidth(dtype);
+  size_t num_channels = 1 + channel_contexts_.size();
+  if (num_channels == 1 || count * element_bytes < kMinStripedTransferBytes) {
+    TF_RETURN_IF_ERROR(GlooAllReduce(context_, send_buffer, recv_buffer, dtype,
+                                     count, reduction_kind,
+                                     cpu_executor->timeout()));
+    return OkEvent();
+  }
+
+  // Every rank splits the buffer in the same way, so all ranks reduce the
+  // same chunk on the same channel.
+  size_t chunk_count = CeilOfRatio(count, num_channels);
+  std::vector<absl::Status> statuses(num_channels);
+  auto run_chunk = [&](size_t channel) {
+    size_t offset = std::min(channel * chunk_count, count);
+    size_t chunk_elements = std::min(chunk_count, count - offset);
+    if (chunk_elements == 0) return;
+    size_t offset_bytes = offset * element_bytes;
+    size_t chunk_bytes = chunk_elements * element_bytes;
+    statuses[channel] = GlooAllReduce(
+        channel == 0 ? context_ : channel_contexts_[channel - 1],
+        send_buffer.GetByteSlice(offset_bytes, chunk_bytes),
+        recv_buffer.GetByteSlice(offset_bytes, chunk_bytes), dtype,
+        chunk_elements, reduction_kind, cpu_executor->timeout());
+  };
+
+  absl::BlockingCounter counter(num_channels - 1);
+  for (size_t channel = 1; channel < num_channels; ++channel) {
+    channel_thread_pool_->Schedule([&, channel] {
+      run_chunk(channel);
+      counter.DecrementCount();
+    });
+  }
+  run_chunk(0);
+  counter.Wait();
+
+  for (const absl::Status& status : statuses) {
+    TF_RETURN_IF_ERROR(status);
+  }
   return OkEvent();
 }
 
@@ -197,37 +263,63 @@ tsl::AsyncValueRef<GlooCommunicator::Event> GlooCommunicator::CollectivePermute(
   TF_ASSIGN_OR_RETURN(auto cpu_executor, CpuCollectives::TryCast(&executor));
   size_t num_bytes = count * primitive_util::ByteWidth(dtype);
 
+  // Large transfers are split into chunks that are sent concurrently over all
+  // channels. Send and receive use the same split, so every chunk is matched
+  // on the same channel by the peer.
+  size_t num_channels = num_bytes < kMinStripedTransferBytes
+                            ? 1
+                            : 1 + channel_contexts_.size();
+  size_t chunk_bytes = CeilOfRatio(num_bytes, num_channels);
+
   try {
-    std::unique_ptr<gloo::transport::UnboundBuffer> in;
-    std::unique_ptr<gloo::transport::UnboundBuffer> out;
-    for (RankId target : target_ranks) {
-      if (target != context_->rank) {
-        VLOG(1) << "send from " << context_->rank << " to " << target.value();
-        if (!in) {
-          in = context_->createUnboundBuffer(send_buffer.opaque(), num_bytes);
+    std::vector<std::unique_ptr<gloo::transport::UnboundBuffer>> ins;
+    std::vector<std::unique_ptr<gloo::transport::UnboundBuffer>> outs;
+    for (size_t channel = 0; channel < num_channels; ++channel) {
+      size_t offset = std::min(channel * chunk_bytes, num_bytes);
+      size_t size = std::min(chunk_bytes, num_bytes - offset);
+      if (channel > 0 && size == 0) break;
+
+      gloo::Context& context =
+          channel == 0 ? *context_ : *channel_contexts_[channel - 1];
+
+      std::unique_ptr<gloo::transport::UnboundBuffer> in;
+      for (RankId target : target_ranks) {
+        if (target != context_->rank) {
+          VLOG(1) << "send from " << context_->rank << " to "
+                  << target.value() << " on channel " << channel;
+          if (!in) {
+            in = context.createUnboundBuffer(
+                static_cast<char*>(send_buffer.opaque()) + offset, size);
+          }
+          in->send(target.value(), slot);
         }
-        in->send(target.value(), slot);
       }
-    }
-    if (source_rank) {
-      if (*source_rank == context_->rank) {
-        std::memcpy(recv_buffer.opaque(), send_buffer.opaque(), num_bytes);
-      } else {
+      if (in) ins.push_back(std::move(in));
+
+      if (source_rank && *source_rank != context_->rank) {
         VLOG(1) << "recv at " << context_->rank << " from "
-                << source_rank->value();
-        out = context_->createUnboundBuffer(recv_buffer.opaque(), num_bytes);
+                << source_rank->value() << " on channel " << channel;
+        std::unique_ptr<gloo::transport::UnboundBuffer> out =
+            context.createUnboundBuffer(
+                static_cast<char*>(recv_buffer.opaque()) + offset, size);
         out->recv(source_rank->value(), slot);
+        outs.push_back(std::move(out));
       }
-    } else {
+    }
+
+    if (!source_rank) {
       std::memset(recv_buffer.opaque(), 0, num_bytes);
+    } else if (*source_rank == context_->rank) {
+      std::memcpy(recv_buffer.opaque(), send_buffer.opaque(), num_bytes);
     }
+
     VLOG(1) << "wait for send at " << context_->rank;
     auto deadline = absl::ToChronoTime(absl::Now() + cpu_executor->timeout());
-    if (in) {
+    for (auto& in : ins) {
       in->waitSend(deadline);
     }
     VLOG(1) << "wait for recv at " << context_->rank;
-    if (out) {
+    for (auto& out : outs) {
       out->waitRecv(deadline);
     }
     VLOG(1) << "done waiting at " << context_->rank;
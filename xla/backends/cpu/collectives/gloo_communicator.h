@@ -20,6 +20,7 @@ limitations under the License.
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include "absl/container/inlined_vector.h"
 #include "absl/status/status.h"
@@ -32,6 +33,7 @@ limitations under the License.
 #include "xla/service/collective_ops_utils.h"
 #include "xla/stream_executor/device_memory.h"
 #include "xla/tsl/concurrency/async_value_ref.h"
+#include "xla/tsl/platform/threadpool.h"
 #include "xla/util.h"
 #include "xla/xla_data.pb.h"
 
@@ -40,8 +42,12 @@ namespace xla::cpu {
 // XLA communicator implemented using Gloo communication library.
 class GlooCommunicator : public Communicator {
  public:
-  GlooCommunicator(std::shared_ptr<gloo::Context> context, size_t rank,
-                   size_t num_ranks);
+  // Large all-reduce operations are split into chunks that run concurrently on
+  // `context` and each of the `channel_contexts`, so that they transfer data
+  // over multiple connections to every peer.
+  GlooCommunicator(
+      std::shared_ptr<gloo::Context> context, size_t rank, size_t num_ranks,
+      std::vector<std::shared_ptr<gloo::Context>> channel_contexts = {});
   ~GlooCommunicator() override;
 
   tsl::AsyncValueRef<Event> AllReduce(se::DeviceMemoryBase send_buffer,
@@ -99,6 +105,11 @@ class GlooCommunicator : public Communicator {
   std::shared_ptr<gloo::Context> context_;
   size_t rank_;
   size_t num_ranks_;
+
+  // Additional contexts used for striping large all-reduce operations, and a
+  // thread pool running the chunks assigned to them.
+  std::vector<std::shared_ptr<gloo::Context>> channel_contexts_;
+  std::unique_ptr<tsl::thread::ThreadPool> channel_thread_pool_;
 };
 
 }  // namespace xla::cpu
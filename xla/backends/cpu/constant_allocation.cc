@@ -135,4 +135,16 @@ absl::StatusOr<std::vector<ConstantAllocation>> CreateConstantAllocations(
   return constants;
 }
 
+absl::StatusOr<ConstantAllocation> CreateOwnedConstantAllocation(
+    BufferAllocation::Index index, Literal literal) {
+  TF_ASSIGN_OR_RETURN(ConstantAllocation constant,
+                      LiteralToConstantAllocation(index, literal));
+  // Sub-byte constants are already packed into storage owned by the
+  // allocation, other constants are views of the literal data.
+  if (std::holds_alternative<absl::Span<const uint8_t>>(constant.data)) {
+    constant.data = std::make_unique<Literal>(std::move(literal));
+  }
+  return constant;
+}
+
 }  // namespace xla::cpu
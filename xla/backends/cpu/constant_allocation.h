@@ -43,6 +43,10 @@ struct ConstantAllocation {
 absl::StatusOr<std::vector<ConstantAllocation>> CreateConstantAllocations(
     const BufferAssignment& assignment);
 
+// Creates a constant allocation that owns the data of `literal`.
+absl::StatusOr<ConstantAllocation> CreateOwnedConstantAllocation(
+    BufferAllocation::Index index, Literal literal);
+
 }  // namespace xla::cpu
 
 #endif  // XLA_BACKENDS_CPU_CONSTANT_ALLOCATION_H_
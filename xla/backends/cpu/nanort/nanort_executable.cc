@@ -32,6 +32,7 @@ limitations under the License.
 #include "xla/backends/cpu/runtime/function_library.h"
 #include "xla/backends/cpu/runtime/thread_pool_task_runner.h"
 #include "xla/backends/cpu/runtime/thunk.h"
+#include "xla/backends/cpu/runtime/thunk_executor.h"
 #include "xla/executable_run_options.h"
 #include "xla/ffi/execution_context.h"
 #include "xla/hlo/ir/hlo_module.h"
@@ -289,7 +290,19 @@ NanoRtExecutable::NanoRtExecutable(
       allocation_sizes_(std::move(allocation_sizes)),
       argument_to_allocation_index_(std::move(argument_to_allocation_index)),
       result_to_allocation_index_(std::move(result_to_allocation_index)),
-      temp_allocation_index_(temp_allocation_index) {}
+      temp_allocation_index_(temp_allocation_index),
+      initial_buffers_(allocation_sizes_.size()) {
+  auto* cpu_executable = tsl::down_cast<cpu::CpuExecutable*>(executable_.get());
+  for (const auto& constant : cpu_executable->constants()) {
+    // Constants are re-indexed by the buffer allocation index at CpuExecutable
+    // construction time, and `executable->constants()` actually returns the
+    // vector of buffer allocations, and only allocations corresponding to
+    // constants have a valid index.
+    if (constant.index >= 0) {
+      initial_buffers_[constant.index] = constant.AsDeviceMemoryBase();
+    }
+  }
+}
 
 static se::DeviceMemoryBase ToDeviceMemory(
     const NanoRtExecutable::Argument& argument) {
@@ -310,6 +323,17 @@ static se::DeviceMemoryBase ToDeviceMemory(
                               temp.size());
 }
 
+// Without a task runner there is no concurrency to extract from the dataflow
+// graph, so we run the thunk sequence in order in the caller thread and skip
+// the executor's scheduling overheads.
+static tsl::AsyncValueRef<NanoRtExecutable::ExecuteEvent> ExecuteThunks(
+    ThunkExecutor& thunks, const Thunk::ExecuteParams& params) {
+  if (params.task_runner == nullptr) {
+    return thunks.ExecuteSequential(params);
+  }
+  return thunks.Execute(params);
+}
+
 tsl::AsyncValueRef<NanoRtExecutable::ExecuteEvent> NanoRtExecutable::Execute(
     absl::Span<const Argument> arguments, absl::Span<const Result> results,
     PreallocatedTemp temp, const ExecuteOptions& options) {
@@ -334,7 +358,8 @@ tsl::AsyncValueRef<NanoRtExecutable::ExecuteEvent> NanoRtExecutable::Execute(
   }
 
   // Prepare buffer allocations for arguments, results, and temp.
-  cpu::BufferAllocations::Buffers buffers(allocation_sizes_.size());
+  cpu::BufferAllocations::Buffers buffers(initial_buffers_.begin(),
+                                          initial_buffers_.end());
 
   for (size_t i = 0; i < num_arguments; ++i) {
     size_t idx = argument_to_allocation_index_[i];
@@ -366,16 +391,6 @@ tsl::AsyncValueRef<NanoRtExecutable::ExecuteEvent> NanoRtExecutable::Execute(
     }
   }
 
-  for (const auto& constant : executable->constants()) {
-    // Constants are re-indexed by the buffer allocation index at CpuExecutable
-    // construction time, and `executable->constants()` actually returns the
-    // vector of buffer allocations, and only allocations corresponding to
-    // constants have a valid index.
-    if (constant.index >= 0) {
-      buffers[constant.index] = constant.AsDeviceMemoryBase();
-    }
-  }
-
   struct ExecutionContext {
     ExecutionContext(cpu::BufferAllocations::Buffers buffers,
                      FunctionLibrary* function_library,
@@ -413,7 +428,7 @@ tsl::AsyncValueRef<NanoRtExecutable::ExecuteEvent> NanoRtExecutable::Execute(
         std::move(buffers), executable->function_library(), options);
 
     auto execute_event =
-        executable->thunks().Execute(execution_context->execute_params);
+        ExecuteThunks(executable->thunks(), execution_context->execute_params);
 
     execute_event.AndThen(
         [execution_context = std::move(execution_context)] {});
@@ -425,7 +440,7 @@ tsl::AsyncValueRef<NanoRtExecutable::ExecuteEvent> NanoRtExecutable::Execute(
         executable->function_library(), &allocations,
         /*xfeed=*/nullptr, options.intra_op_thread_pool(),
         options.task_runner()};
-    return executable->thunks().Execute(execute_params);
+    return ExecuteThunks(executable->thunks(), execute_params);
   }
 }
 
@@ -33,6 +33,7 @@ limitations under the License.
 #include "xla/runtime/device_id.h"
 #include "xla/service/computation_placer.h"
 #include "xla/service/executable.h"
+#include "xla/stream_executor/device_memory.h"
 #include "xla/tsl/concurrency/async_value_ref.h"
 #include "xla/tsl/concurrency/chain.h"
 #include "tsl/platform/mem.h"
@@ -199,6 +200,10 @@ class NanoRtExecutable {
 
   // Index of the temp allocation.
   std::optional<size_t> temp_allocation_index_;
+
+  // Buffers for all allocations with constants resolved at construction time,
+  // so that execution only has to fill in arguments, results and temp.
+  std::vector<se::DeviceMemoryBase> initial_buffers_;
 };
 
 template <typename T>
@@ -49,6 +49,8 @@ static absl::StatusOr<dnnl::graph::logical_tensor::data_type> OneDnnDatatype(
   switch (type) {
     case F32:
       return dnnl::graph::logical_tensor::data_type::f32;
+    case BF16:
+      return dnnl::graph::logical_tensor::data_type::bf16;
     default:
       return InvalidArgument("Unsupported oneDNN data type: %s",
                              primitive_util::LowercasePrimitiveTypeName(type));
@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "xla/backends/cpu/onednn_fusion.h"
 
+#include "xla/backends/cpu/codegen/target_machine_features.h"
 #include "xla/backends/cpu/runtime/dot_lib.h"
 #include "xla/shape.h"
 #include "xla/xla_data.pb.h"
@@ -23,10 +24,19 @@ namespace xla::cpu {
 
 absl::StatusOr<bool> IsOneDnnDotSupported(
     const DotDimensionNumbers& dot_dimensions, const Shape& lhs_shape,
-    const Shape& rhs_shape, const Shape& out_shape) {
+    const Shape& rhs_shape, const Shape& out_shape,
+    const TargetMachineFeatures* cpu_features) {
   // TODO(penporn): Support other element types.
-  if (lhs_shape.element_type() != F32 || rhs_shape.element_type() != F32 ||
-      out_shape.element_type() != F32) {
+  PrimitiveType dtype = lhs_shape.element_type();
+  if ((dtype != F32 && dtype != BF16) || rhs_shape.element_type() != dtype ||
+      out_shape.element_type() != dtype) {
+    return false;
+  }
+
+  // oneDNN lowers BF16 matmuls to AMX tiles or AVX512_BF16 dot products, and
+  // without them it would be slower than F32.
+  if (dtype == BF16 && cpu_features != nullptr &&
+      !cpu_features->has_amx_bf16() && !cpu_features->has_avx512bf16()) {
     return false;
   }
 
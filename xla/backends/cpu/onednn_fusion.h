@@ -21,6 +21,7 @@ limitations under the License.
 #include "oneapi/dnnl/dnnl_graph.hpp"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
+#include "xla/backends/cpu/codegen/target_machine_features.h"
 #include "xla/shape.h"
 #include "xla/xla_data.pb.h"
 
@@ -38,10 +39,12 @@ struct OneDnnFusion {
 };
 
 // Returns true if the dot operation is supported by oneDNN. Returns an error
-// if the dot operation shape is invalid.
+// if the dot operation shape is invalid. BF16 dots are supported only if the
+// CPU has AMX or AVX512_BF16 instructions, which oneDNN dispatches to.
 absl::StatusOr<bool> IsOneDnnDotSupported(
     const DotDimensionNumbers& dot_dimensions, const Shape& lhs_shape,
-    const Shape& rhs_shape, const Shape& out_shape);
+    const Shape& rhs_shape, const Shape& out_shape,
+    const TargetMachineFeatures* cpu_features = nullptr);
 
 }  // namespace xla::cpu
 
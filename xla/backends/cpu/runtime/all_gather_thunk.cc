@@ -75,8 +75,9 @@ tsl::AsyncValueRef<AllGatherThunk::ExecuteEvent> AllGatherThunk::Execute(
 
   return ExecuteWithCommunicator(
       params.collective_params,
-      [&](const RendezvousKey& key,
-          Communicator& comm) -> tsl::AsyncValueRef<Communicator::Event> {
+      [this, data = std::move(data)](const RendezvousKey& key,
+                                     Communicator& comm)
+          -> tsl::AsyncValueRef<Communicator::Event> {
         CpuCollectives::Executor executor(key, DefaultCollectiveTimeout());
 
         tsl::CountDownAsyncValueRef<Communicator::Event> state(
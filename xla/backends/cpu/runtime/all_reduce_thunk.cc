@@ -101,7 +101,8 @@ tsl::AsyncValueRef<AllReduceThunk::ExecuteEvent> AllReduceThunk::Execute(
 
   return ExecuteWithCommunicator(
       params.collective_params,
-      [&, data = std::move(data)](const RendezvousKey& key, Communicator& comm)
+      [this, data = std::move(data)](const RendezvousKey& key,
+                                     Communicator& comm)
           -> tsl::AsyncValueRef<Communicator::Event> {
         tsl::CountDownAsyncValueRef<Communicator::Event> state(
             data.source.size());
@@ -129,7 +129,9 @@ CollectivePermuteThunk::Execute(const ExecuteParams& params) {
 
   return ExecuteWithCommunicator(
       params.collective_params,
-      [&](const RendezvousKey& key, Communicator& comm) {
+      [this, data = std::move(data), source_replica_id,
+       copy_to = std::move(copy_to)](const RendezvousKey& key,
+                                     Communicator& comm) {
         CpuCollectives::Executor executor(key, DefaultCollectiveTimeout());
         tsl::CountDownAsyncValueRef<Communicator::Event> state(
             data.source.size());
@@ -26,12 +26,16 @@ limitations under the License.
 #include <vector>
 
 #include "absl/algorithm/container.h"
+#include "absl/base/const_init.h"
+#include "absl/base/optimization.h"
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/inlined_vector.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_join.h"
 #include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/time/time.h"
 #include "absl/types/span.h"
 #include "xla/backends/cpu/collectives/cpu_clique_key.h"
@@ -51,8 +55,10 @@ limitations under the License.
 #include "xla/status_macros.h"
 #include "xla/stream_executor/device_memory.h"
 #include "xla/tsl/concurrency/async_value_ref.h"
+#include "xla/tsl/platform/env.h"
 #include "xla/tsl/platform/logging.h"
 #include "xla/tsl/platform/statusor.h"
+#include "xla/tsl/platform/threadpool.h"
 #include "xla/util.h"
 #include "xla/xla_data.pb.h"
 
@@ -191,6 +197,29 @@ absl::StatusOr<int32_t> CollectiveThunk::RankInGlobalDevices(
   return std::distance(key.global_devices.begin(), it);
 }
 
+// Returns a single thread that runs asynchronous collective operations of the
+// given device. Collective thunks of a device are ordered by the communicator
+// resource, so one thread per device is sufficient, and a separate thread for
+// every device guarantees that all participants of a collective operation
+// running in the same process make progress at the same time.
+static tsl::thread::ThreadPool* GetAsyncCollectivesThread(
+    GlobalDeviceId device) {
+  static absl::Mutex mu(absl::kConstInit);
+  static auto* threads =
+      new absl::flat_hash_map<GlobalDeviceId,
+                              std::unique_ptr<tsl::thread::ThreadPool>>();
+
+  absl::MutexLock lock(&mu);
+  std::unique_ptr<tsl::thread::ThreadPool>& thread = (*threads)[device];
+  if (thread == nullptr) {
+    thread = std::make_unique<tsl::thread::ThreadPool>(
+        tsl::Env::Default(),
+        absl::StrCat("xla-cpu-collectives-", device.value()),
+        /*num_threads=*/1);
+  }
+  return thread.get();
+}
+
 tsl::AsyncValueRef<CollectiveThunk::ExecuteEvent>
 CollectiveThunk::ExecuteWithCommunicator(
     const Thunk::CollectiveExecuteParams* params, Callback callback) {
@@ -215,7 +244,28 @@ CollectiveThunk::ExecuteWithCommunicator(
       Communicator * communicator,
       AcquireCommunicator(collectives, clique_key, RankId(rank)));
 
-  return callback(key, *communicator);
+  if (!op_params_.is_async) {
+    return callback(key, *communicator);
+  }
+
+  // Run the collective operation on a thread dedicated to the device, so that
+  // the thunk executor worker can continue with independent thunks, and
+  // forward the completion of the operation to the returned execute event.
+  auto event = tsl::MakeConstructedAsyncValueRef<ExecuteEvent>();
+  GetAsyncCollectivesThread(params->global_device_id)
+      ->Schedule([event, key = std::move(key), communicator,
+                  callback = std::move(callback)]() mutable {
+        tsl::AsyncValueRef<Communicator::Event> done =
+            callback(key, *communicator);
+        done.AndThen([event, done]() mutable {
+          if (ABSL_PREDICT_FALSE(done.IsError())) {
+            event.SetError(done.GetError());
+          } else {
+            event.SetStateConcrete();
+          }
+        });
+      });
+  return event;
 }
 
 const BufferAllocation::Slice& CollectiveThunk::source_buffer(
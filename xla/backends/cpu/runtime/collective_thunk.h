@@ -64,6 +64,11 @@ class CollectiveThunk : public Thunk {
     bool has_channel_id;
     std::optional<bool> use_global_device_ids;
     std::vector<ReplicaGroup> group;
+
+    // If true, the collective operation runs on a thread dedicated to the
+    // device, and the thunk execute event completes when the communicator
+    // finishes, instead of blocking the thunk executor worker.
+    bool is_async = false;
   };
 
   // Source and destination buffers for the collective operation.
@@ -20,7 +20,9 @@ limitations under the License.
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "xla/backends/cpu/runtime/work_queue.h"
 #include "xla/tsl/concurrency/async_value_ref.h"
@@ -416,6 +418,308 @@ void EigenGenericConv2D(
   }
 }
 
+// Runs `task(i)` for all `i` in [0, num_tasks) on `device`. With a thread pool
+// device the tasks run concurrently, and `count_down` is counted down by
+// `count` once all of them are done; if `count_down` is not set, the caller
+// blocks until then.
+template <typename EigenDevice, typename Task>
+void RunConvolutionTasks(const EigenDevice& device, Eigen::Index num_tasks,
+                         Task task,
+                         tsl::CountDownAsyncValueRef<tsl::Chain> count_down,
+                         Eigen::Index count) {
+  if constexpr (std::is_same_v<EigenDevice, Eigen::ThreadPoolDevice>) {
+    Eigen::Index num_workers = std::clamp<Eigen::Index>(
+        device.numThreads(), 1, std::max<Eigen::Index>(num_tasks, 1));
+    auto done = Worker::Parallelize(device.getPool(), num_workers, num_tasks,
+                                    std::move(task));
+    if (count_down) {
+      done.AndThen([count_down, count]() mutable {
+        count_down.CountDown(count);
+      });
+    } else {
+      tsl::BlockUntilReady(done);
+    }
+  } else {
+    for (Eigen::Index i = 0; i < num_tasks; ++i) {
+      task(i);
+    }
+  }
+}
+
+inline bool CanUseDirectDepthwiseConv(
+    Eigen::Index input_channels, Eigen::Index kernel_channels,
+    Eigen::Index lhs_x_dilation, Eigen::Index lhs_y_dilation,
+    Eigen::Index feature_group_count) {
+  return feature_group_count > 1 && feature_group_count == input_channels &&
+         kernel_channels == 1 && lhs_x_dilation == 1 && lhs_y_dilation == 1;
+}
+
+// Depthwise convolution, i.e. a grouped convolution with one input channel per
+// group. The generic algorithm runs one Eigen contraction per channel, which
+// is slow for the typical depthwise shapes with many channels and small
+// kernels. Instead, each task computes one output row (a single batch and x
+// index) directly, with the channels in the innermost loop.
+template <typename EigenDevice, typename ScalarType>
+void DirectDepthwiseConv2D(
+    const EigenDevice& device, ScalarType* out, ScalarType* lhs,
+    ScalarType* rhs, Eigen::Index input_batch, Eigen::Index input_x,
+    Eigen::Index input_y, Eigen::Index input_channels, Eigen::Index kernel_x,
+    Eigen::Index kernel_y, Eigen::Index kernel_filters, Eigen::Index output_x,
+    Eigen::Index output_y, Eigen::Index x_stride, Eigen::Index y_stride,
+    Eigen::Index padding_x_before, Eigen::Index padding_y_before,
+    Eigen::Index rhs_x_dilation, Eigen::Index rhs_y_dilation,
+    Eigen::Index feature_group_count,
+    tsl::CountDownAsyncValueRef<tsl::Chain> count_down) {
+  // Filters of each input channel, i.e. the depth multiplier.
+  const Eigen::Index multiplier = kernel_filters / input_channels;
+
+  auto convolve_row = [=](Eigen::Index row) {
+    const Eigen::Index batch = row / output_x;
+    const Eigen::Index ox = row % output_x;
+
+    // Accumulate in float, so that half precision convolutions do not lose
+    // precision in the sums.
+    std::vector<float> acc(output_y * kernel_filters, 0.0f);
+    for (Eigen::Index kx = 0; kx < kernel_x; ++kx) {
+      const Eigen::Index ix = ox * x_stride - padding_x_before +
+                              kx * rhs_x_dilation;
+      if (ix < 0 || ix >= input_x) continue;
+      const ScalarType* in_row =
+          lhs + (batch * input_x + ix) * input_y * input_channels;
+
+      for (Eigen::Index oy = 0; oy < output_y; ++oy) {
+        float* acc_pixel = acc.data() + oy * kernel_filters;
+        for (Eigen::Index ky = 0; ky < kernel_y; ++ky) {
+          const Eigen::Index iy = oy * y_stride - padding_y_before +
+                                  ky * rhs_y_dilation;
+          if (iy < 0 || iy >= input_y) continue;
+          const ScalarType* in_pixel = in_row + iy * input_channels;
+          const ScalarType* weights =
+              rhs + (kx * kernel_y + ky) * kernel_filters;
+
+          if (multiplier == 1) {
+            for (Eigen::Index c = 0; c < input_channels; ++c) {
+              acc_pixel[c] += static_cast<float>(in_pixel[c]) *
+                              static_cast<float>(weights[c]);
+            }
+          } else {
+            for (Eigen::Index c = 0; c < input_channels; ++c) {
+              const float in = static_cast<float>(in_pixel[c]);
+              for (Eigen::Index m = 0; m < multiplier; ++m) {
+                acc_pixel[c * multiplier + m] +=
+                    in * static_cast<float>(weights[c * multiplier + m]);
+              }
+            }
+          }
+        }
+      }
+    }
+
+    ScalarType* out_row = out + row * output_y * kernel_filters;
+    for (Eigen::Index i = 0; i < output_y * kernel_filters; ++i) {
+      out_row[i] = static_cast<ScalarType>(acc[i]);
+    }
+  };
+
+  RunConvolutionTasks(device, input_batch * output_x, std::move(convolve_row),
+                      std::move(count_down), feature_group_count);
+}
+
+// Winograd convolutions F(2x2, 3x3) compute each 2x2 output tile from a 4x4
+// input tile with 16 multiplications per channel pair instead of 36. They are
+// only used for f32, where the transforms do not lose precision noticeably,
+// with enough channels for the 16 matrix multiplications per block of tiles
+// to dominate the input and output transforms, and with enough tiles to
+// amortize the kernel transform.
+inline constexpr Eigen::Index kWinogradMinChannels = 16;
+inline constexpr Eigen::Index kWinogradMinTiles = 32;
+
+// Bounds of the number of output tiles transformed and multiplied together by
+// each task. Smaller blocks are only used to give work to all threads.
+inline constexpr Eigen::Index kWinogradMinTileBlock = 8;
+inline constexpr Eigen::Index kWinogradMaxTileBlock = 64;
+
+inline bool CanUseWinogradConv(
+    Eigen::Index input_batch, Eigen::Index input_channels,
+    Eigen::Index kernel_x, Eigen::Index kernel_y, Eigen::Index kernel_filters,
+    Eigen::Index output_x, Eigen::Index output_y, Eigen::Index x_stride,
+    Eigen::Index y_stride, Eigen::Index lhs_x_dilation,
+    Eigen::Index lhs_y_dilation, Eigen::Index rhs_x_dilation,
+    Eigen::Index rhs_y_dilation, Eigen::Index feature_group_count) {
+  const Eigen::Index num_tiles =
+      input_batch * Eigen::numext::div_ceil<Eigen::Index>(output_x, 2) *
+      Eigen::numext::div_ceil<Eigen::Index>(output_y, 2);
+  return kernel_x == 3 && kernel_y == 3 && x_stride == 1 && y_stride == 1 &&
+         lhs_x_dilation == 1 && lhs_y_dilation == 1 && rhs_x_dilation == 1 &&
+         rhs_y_dilation == 1 && feature_group_count == 1 &&
+         input_channels >= kWinogradMinChannels &&
+         kernel_filters >= kWinogradMinChannels &&
+         num_tiles >= kWinogradMinTiles;
+}
+
+// Winograd convolution F(2x2, 3x3) for 3x3 kernels with unit strides:
+//
+//   output tile = A^T [(G g G^T) . (B^T d B)] A
+//
+// where g is a 3x3 kernel, d is a 4x4 input tile and `.` is the element-wise
+// product, which becomes a sum over the input channels. The kernel is
+// transformed once per call. Each task then transforms a block of input tiles,
+// computes the 16 [tiles, channels] x [channels, filters] products and
+// transforms the results back into the output.
+template <typename EigenDevice>
+void WinogradConv2D(const EigenDevice& device, float* out, float* lhs,
+                    float* rhs, Eigen::Index input_batch, Eigen::Index input_x,
+                    Eigen::Index input_y, Eigen::Index input_channels,
+                    Eigen::Index kernel_filters, Eigen::Index output_x,
+                    Eigen::Index output_y, Eigen::Index padding_x_before,
+                    Eigen::Index padding_y_before,
+                    tsl::CountDownAsyncValueRef<tsl::Chain> count_down) {
+  using Matrix =
+      Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+  using Vector = Eigen::Map<Eigen::ArrayXf>;
+  using ConstVector = Eigen::Map<const Eigen::ArrayXf>;
+  const Eigen::Index channels = input_channels;
+  const Eigen::Index filters = kernel_filters;
+
+  // Transformed kernel U = G g G^T, stored as 16 [channels, filters] matrices.
+  // All transforms operate on whole vectors of channels or filters, so that
+  // they vectorize.
+  auto u = std::make_shared<std::vector<float>>(16 * channels * filters);
+  for (Eigen::Index c = 0; c < channels; ++c) {
+    auto g = [&](int i, int j) {
+      return ConstVector(rhs + ((i * 3 + j) * channels + c) * filters,
+                         filters);
+    };
+    auto u_at = [&](int i, int j) {
+      return Vector(u->data() + ((i * 4 + j) * channels + c) * filters,
+                    filters);
+    };
+    for (int j = 0; j < 3; ++j) {
+      // Column j of G g, stored in the first three columns of U's rows.
+      u_at(0, j) = g(0, j);
+      u_at(1, j) = 0.5f * (g(0, j) + g(1, j) + g(2, j));
+      u_at(2, j) = 0.5f * (g(0, j) - g(1, j) + g(2, j));
+      u_at(3, j) = g(2, j);
+    }
+    for (int i = 0; i < 4; ++i) {
+      // Row i of (G g) G^T, computed in place from the back.
+      u_at(i, 3) = u_at(i, 2);
+      u_at(i, 2) = 0.5f * (u_at(i, 0) - u_at(i, 1) + u_at(i, 3));
+      u_at(i, 1) = u_at(i, 2) + u_at(i, 1);
+    }
+  }
+
+  const Eigen::Index tiles_x =
+      Eigen::numext::div_ceil<Eigen::Index>(output_x, 2);
+  const Eigen::Index tiles_y =
+      Eigen::numext::div_ceil<Eigen::Index>(output_y, 2);
+  const Eigen::Index num_tiles = input_batch * tiles_x * tiles_y;
+  const Eigen::Index tile_block = std::clamp<Eigen::Index>(
+      Eigen::numext::div_ceil<Eigen::Index>(num_tiles, device.numThreads()),
+      kWinogradMinTileBlock, kWinogradMaxTileBlock);
+  const Eigen::Index num_blocks =
+      Eigen::numext::div_ceil(num_tiles, tile_block);
+
+  auto convolve_block = [=](Eigen::Index block) {
+    const Eigen::Index tile_begin = block * tile_block;
+    const Eigen::Index tiles = std::min(tile_block, num_tiles - tile_begin);
+
+    // Transformed input V = B^T d B as 16 [tiles, channels] matrices, and the
+    // products M as 16 [tiles, filters] matrices.
+    std::vector<float> v(16 * tiles * channels);
+    std::vector<float> m(16 * tiles * filters);
+    // B^T d for a single tile.
+    Eigen::ArrayXXf bd(channels, 16);
+
+    Eigen::ArrayXf zeros = Eigen::ArrayXf::Zero(channels);
+    for (Eigen::Index t = 0; t < tiles; ++t) {
+      const Eigen::Index tile = tile_begin + t;
+      const Eigen::Index batch = tile / (tiles_x * tiles_y);
+      const Eigen::Index tx = tile / tiles_y % tiles_x;
+      const Eigen::Index ty = tile % tiles_y;
+
+      // Input tile, with zeros outside of the input.
+      auto d = [&](int i, int j) {
+        const Eigen::Index ix = 2 * tx - padding_x_before + i;
+        const Eigen::Index iy = 2 * ty - padding_y_before + j;
+        const float* data =
+            ix < 0 || ix >= input_x || iy < 0 || iy >= input_y
+                ? zeros.data()
+                : lhs + ((batch * input_x + ix) * input_y + iy) * channels;
+        return ConstVector(data, channels);
+      };
+      auto v_at = [&](int i, int j) {
+        return Vector(v.data() + ((i * 4 + j) * tiles + t) * channels,
+                      channels);
+      };
+
+      // B^T = [[1, 0, -1, 0], [0, 1, 1, 0], [0, -1, 1, 0], [0, 1, 0, -1]].
+      for (int j = 0; j < 4; ++j) {
+        bd.col(0 * 4 + j) = d(0, j) - d(2, j);
+        bd.col(1 * 4 + j) = d(1, j) + d(2, j);
+        bd.col(2 * 4 + j) = d(2, j) - d(1, j);
+        bd.col(3 * 4 + j) = d(1, j) - d(3, j);
+      }
+      for (int i = 0; i < 4; ++i) {
+        v_at(i, 0) = bd.col(i * 4 + 0) - bd.col(i * 4 + 2);
+        v_at(i, 1) = bd.col(i * 4 + 1) + bd.col(i * 4 + 2);
+        v_at(i, 2) = bd.col(i * 4 + 2) - bd.col(i * 4 + 1);
+        v_at(i, 3) = bd.col(i * 4 + 1) - bd.col(i * 4 + 3);
+      }
+    }
+
+    for (int p = 0; p < 16; ++p) {
+      Eigen::Map<const Matrix> v_p(v.data() + p * tiles * channels, tiles,
+                                   channels);
+      Eigen::Map<const Matrix> u_p(u->data() + p * channels * filters,
+                                   channels, filters);
+      Eigen::Map<Matrix> m_p(m.data() + p * tiles * filters, tiles, filters);
+      m_p.noalias() = v_p * u_p;
+    }
+
+    // A^T M for a single tile.
+    Eigen::ArrayXXf am(filters, 8);
+    for (Eigen::Index t = 0; t < tiles; ++t) {
+      const Eigen::Index tile = tile_begin + t;
+      const Eigen::Index batch = tile / (tiles_x * tiles_y);
+      const Eigen::Index tx = tile / tiles_y % tiles_x;
+      const Eigen::Index ty = tile % tiles_y;
+
+      auto m_at = [&](int i, int j) {
+        return ConstVector(m.data() + ((i * 4 + j) * tiles + t) * filters,
+                           filters);
+      };
+
+      // A^T = [[1, 1, 1, 0], [0, 1, -1, -1]].
+      for (int j = 0; j < 4; ++j) {
+        am.col(j) = m_at(0, j) + m_at(1, j) + m_at(2, j);
+        am.col(4 + j) = m_at(1, j) - m_at(2, j) - m_at(3, j);
+      }
+      for (int i = 0; i < 2; ++i) {
+        const Eigen::Index ox = 2 * tx + i;
+        if (ox >= output_x) continue;
+        for (int j = 0; j < 2; ++j) {
+          const Eigen::Index oy = 2 * ty + j;
+          if (oy >= output_y) continue;
+          Vector out_pixel(
+              out + ((batch * output_x + ox) * output_y + oy) * filters,
+              filters);
+          if (j == 0) {
+            out_pixel = am.col(i * 4 + 0) + am.col(i * 4 + 1) +
+                        am.col(i * 4 + 2);
+          } else {
+            out_pixel = am.col(i * 4 + 1) - am.col(i * 4 + 2) -
+                        am.col(i * 4 + 3);
+          }
+        }
+      }
+    }
+  };
+
+  RunConvolutionTasks(device, num_blocks, std::move(convolve_block),
+                      std::move(count_down), /*count=*/1);
+}
+
 // TODO(ezhulenev): Make internal implementation a private static method of
 // ConvolutionThunk (for consistency with DotThunk). Today we keep it as a
 // free function to use it in the legacy XLA CPU runtime.
@@ -449,6 +753,32 @@ void EigenConv2D(const EigenDevice& device, ScalarType* out, ScalarType* lhs,
     }
   }
 
+  if (CanUseDirectDepthwiseConv(input_channels, kernel_channels,
+                                lhs_x_dilation, lhs_y_dilation,
+                                feature_group_count)) {
+    DirectDepthwiseConv2D(device, out, lhs, rhs, input_batch, input_x, input_y,
+                          input_channels, kernel_x, kernel_y, kernel_filters,
+                          output_x, output_y, x_stride, y_stride,
+                          padding_x_before, padding_y_before, rhs_x_dilation,
+                          rhs_y_dilation, feature_group_count,
+                          std::move(count_down));
+    return;
+  }
+
+  if constexpr (std::is_same_v<ScalarType, float>) {
+    if (CanUseWinogradConv(input_batch, input_channels, kernel_x, kernel_y,
+                           kernel_filters, output_x, output_y, x_stride,
+                           y_stride, lhs_x_dilation, lhs_y_dilation,
+                           rhs_x_dilation, rhs_y_dilation,
+                           feature_group_count)) {
+      WinogradConv2D(device, out, lhs, rhs, input_batch, input_x, input_y,
+                     input_channels, kernel_filters, output_x, output_y,
+                     padding_x_before, padding_y_before,
+                     std::move(count_down));
+      return;
+    }
+  }
+
   if (feature_group_count == 1) {
     EigenGenericConv2D</*is_grouped=*/false>(
         device, out, lhs, rhs, input_batch, input_x, input_y, input_channels,
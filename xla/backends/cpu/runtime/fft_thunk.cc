@@ -14,6 +14,11 @@ limitations under the License.
 ==============================================================================*/
 #include "xla/backends/cpu/runtime/fft_thunk.h"
 
+#define EIGEN_USE_THREADS
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 
@@ -21,13 +26,14 @@ limitations under the License.
 #include "absl/memory/memory.h"
 #include "absl/status/statusor.h"
 #include "absl/types/span.h"
+#include "unsupported/Eigen/CXX11/Tensor"
 #include "xla/backends/cpu/runtime/thunk.h"
 #include "xla/layout_util.h"
 #include "xla/runtime/buffer_use.h"
 #include "xla/service/buffer_assignment.h"
 #include "xla/service/cpu/runtime_fft.h"
-#include "xla/service/cpu/runtime_single_threaded_fft.h"
 #include "xla/shape.h"
+#include "xla/shape_util.h"
 #include "xla/status_macros.h"
 #include "xla/stream_executor/device_memory.h"
 #include "xla/tsl/concurrency/async_value_ref.h"
@@ -36,6 +42,44 @@ limitations under the License.
 
 namespace xla::cpu {
 
+// Minimum number of output elements computed by a single task when we run
+// batched FFTs in parallel.
+static constexpr int64_t kMinParallelTaskSize = 16 * 1024;
+
+// Returns the number of leading batch dimensions of the FFT operand.
+static int64_t NumBatchDimensions(const Shape& output_shape,
+                                  absl::Span<const int64_t> fft_length) {
+  return output_shape.dimensions().size() - fft_length.size();
+}
+
+// Flattens operand batch dimensions into a single dimension.
+static absl::InlinedVector<int64_t, 4> FlattenOperandShape(
+    const Shape& input_shape, const Shape& output_shape,
+    absl::Span<const int64_t> fft_length) {
+  const int fft_rank = fft_length.size();
+
+  absl::InlinedVector<int64_t, 4> operand_shape_flat(fft_rank + 1);
+  int64_t input_batch = 1;
+  int64_t input_batch_length = NumBatchDimensions(output_shape, fft_length);
+  for (int i = 0; i < input_batch_length; i++) {
+    input_batch *= input_shape.dimensions(i);
+  }
+  operand_shape_flat[0] = input_batch;
+  for (int i = 0; i < fft_rank; ++i) {
+    operand_shape_flat[i + 1] = input_shape.dimensions(i + input_batch_length);
+  }
+  return operand_shape_flat;
+}
+
+// Returns the distance in bytes between consecutive batch elements.
+static int64_t BatchStride(const Shape& shape, int64_t num_batch_dimensions) {
+  int64_t stride = ShapeUtil::ByteSizeOfPrimitiveType(shape.element_type());
+  for (int64_t i = num_batch_dimensions; i < shape.dimensions().size(); ++i) {
+    stride *= shape.dimensions(i);
+  }
+  return stride;
+}
+
 FftThunk::FftThunk(Info thunk_info, bool is_multi_thread_eigen,
                    int32_t fft_type, absl::Span<const int64_t> fft_length,
                    BufferAllocation::Slice input_buffer,
@@ -51,7 +95,13 @@ FftThunk::FftThunk(Info thunk_info, bool is_multi_thread_eigen,
       input_buffer_(input_buffer),
       output_buffer_(output_buffer),
       input_shape_(input_shape),
-      output_shape_(output_shape) {}
+      output_shape_(output_shape),
+      operand_shape_flat_(
+          FlattenOperandShape(input_shape, output_shape, fft_length)),
+      input_batch_stride_(BatchStride(
+          input_shape, NumBatchDimensions(output_shape, fft_length))),
+      output_batch_stride_(BatchStride(
+          output_shape, NumBatchDimensions(output_shape, fft_length))) {}
 
 absl::StatusOr<std::unique_ptr<FftThunk>> FftThunk::Create(
     Info thunk_info, bool is_multi_thread_eigen, int32_t fft_type,
@@ -76,34 +126,71 @@ tsl::AsyncValueRef<Thunk::ExecuteEvent> FftThunk::Execute(
       params.buffer_allocations->GetDeviceAddress(output_buffer_));
 
   const int fft_rank = fft_length_.size();
+  const int64_t batch_size = operand_shape_flat_[0];
 
-  // Flatten operand batches.
-  absl::InlinedVector<int64_t, 4> operand_shape_flat(fft_rank + 1);
-  int64_t input_batch = 1;
-  int64_t input_batch_length = output_shape_.dimensions().size() - fft_rank;
-  for (int i = 0; i < input_batch_length; i++) {
-    input_batch *= input_shape_.dimensions(i);
+  // Computes FFT for the batch elements in the [start, end) range.
+  auto fft = [this, fft_rank, input_data, output_data](
+                 const Eigen::ThreadPoolDevice* device, int64_t start,
+                 int64_t end) {
+    absl::InlinedVector<int64_t, 4> operand_shape = operand_shape_flat_;
+    operand_shape[0] = end - start;
+
+    std::byte* input = reinterpret_cast<std::byte*>(input_data.opaque());
+    std::byte* output = reinterpret_cast<std::byte*>(output_data.opaque());
+
+    __xla_cpu_runtime_DuccFft(device, output + start * output_batch_stride_,
+                              input + start * input_batch_stride_, fft_type_,
+                              is_double_precision_, fft_rank,
+                              operand_shape.data(), fft_length_.data());
+  };
+
+  if (!is_multi_thread_eigen_) {
+    fft(/*device=*/nullptr, 0, batch_size);
+    return OkExecuteEvent();
   }
-  operand_shape_flat[0] = input_batch;
-  for (int i = 0; i < fft_rank; ++i) {
-    operand_shape_flat[i + 1] = input_shape_.dimensions(i + input_batch_length);
+
+  // Split batch elements between parallel tasks, and make sure that each task
+  // has enough work to amortize the scheduling overheads.
+  const Eigen::ThreadPoolDevice* device = params.intra_op_threadpool;
+
+  int64_t num_tasks = 1;
+  if (device != nullptr) {
+    int64_t output_size = batch_size * output_batch_stride_ /
+                          ShapeUtil::ByteSizeOfPrimitiveType(
+                              output_shape_.element_type());
+    num_tasks = std::min({static_cast<int64_t>(device->numThreads()),
+                          batch_size, output_size / kMinParallelTaskSize});
+  }
+
+  // For a single task we rely on DUCC to parallelize a large FFT internally.
+  if (num_tasks <= 1) {
+    fft(device, 0, batch_size);
+    return OkExecuteEvent();
   }
 
-  // Args have been computed, make the call.
-  if (is_multi_thread_eigen_) {
-    __xla_cpu_runtime_DuccFft(params.intra_op_threadpool,
-                              reinterpret_cast<float*>(output_data.opaque()),
-                              reinterpret_cast<float*>(input_data.opaque()),
-                              fft_type_, is_double_precision_, fft_rank,
-                              operand_shape_flat.data(), fft_length_.data());
-  } else {
-    __xla_cpu_runtime_DuccSingleThreadedFft(
-        nullptr, reinterpret_cast<float*>(output_data.opaque()),
-        reinterpret_cast<float*>(input_data.opaque()), fft_type_,
-        is_double_precision_, fft_rank, operand_shape_flat.data(),
-        fft_length_.data());
+  // Use intra-op thread pool to compute FFT for batch elements in parallel.
+  auto event = tsl::MakeConstructedAsyncValueRef<ExecuteEvent>();
+  auto counter = std::make_shared<std::atomic<int64_t>>(num_tasks);
+
+  auto execute = [event, counter, fft, batch_size,
+                  num_tasks](int64_t task_index) {
+    fft(/*device=*/nullptr, task_index * batch_size / num_tasks,
+        (task_index + 1) * batch_size / num_tasks);
+
+    if (counter->load() == 1 || counter->fetch_sub(1) == 1) {
+      event.SetStateConcrete();
+    }
+  };
+
+  // Launch parallel FFT tasks in the intra-op thread pool.
+  for (int64_t i = 1; i < num_tasks; ++i) {
+    device->getPool()->Schedule([i, execute] { execute(i); });
   }
-  return OkExecuteEvent();
+
+  // Execute the first FFT task in the caller thread.
+  execute(0);
+
+  return event;
 }
 
 Thunk::BufferUses FftThunk::buffer_uses() const {
@@ -20,6 +20,7 @@ limitations under the License.
 #include <memory>
 #include <vector>
 
+#include "absl/container/inlined_vector.h"
 #include "absl/status/statusor.h"
 #include "absl/types/span.h"
 #include "xla/backends/cpu/runtime/thunk.h"
@@ -74,6 +75,14 @@ class FftThunk final : public Thunk {
 
   const Shape input_shape_;
   const Shape output_shape_;
+
+  // FFT operand shape with all batch dimensions flattened into the first one,
+  // and the distance in bytes between consecutive batch elements in the input
+  // and output buffers. Computed once at construction time, as they depend
+  // only on the thunk shapes.
+  absl::InlinedVector<int64_t, 4> operand_shape_flat_;
+  int64_t input_batch_stride_;
+  int64_t output_batch_stride_;
 };
 
 }  // namespace xla::cpu
@@ -0,0 +1,232 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/cpu/runtime/gather_thunk.h"
+
+#define EIGEN_USE_THREADS
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "absl/base/optimization.h"
+#include "absl/base/prefetch.h"
+#include "absl/log/log.h"
+#include "absl/memory/memory.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_format.h"
+#include "unsupported/Eigen/CXX11/Tensor"
+#include "xla/backends/cpu/runtime/thunk.h"
+#include "xla/layout_util.h"
+#include "xla/primitive_util.h"
+#include "xla/service/buffer_assignment.h"
+#include "xla/shape.h"
+#include "xla/shape_util.h"
+#include "xla/stream_executor/device_memory.h"
+#include "xla/tsl/concurrency/async_value_ref.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/util.h"
+#include "xla/xla_data.pb.h"
+
+namespace xla::cpu {
+
+// Minimum number of output bytes copied by a single task when we gather rows
+// in parallel.
+static constexpr int64_t kMinParallelTaskBytes = 256 * 1024;
+
+// Rows are gathered from random locations of the operand, so we prefetch the
+// rows a few indices ahead of the one being copied.
+static constexpr int64_t kPrefetchDistance = 8;
+
+absl::StatusOr<std::unique_ptr<GatherThunk>> GatherThunk::Create(
+    Info info, BufferAllocation::Slice operand_buffer, Shape operand_shape,
+    BufferAllocation::Slice indices_buffer, Shape indices_shape,
+    BufferAllocation::Slice output_buffer, Shape output_shape) {
+  if (operand_shape.dimensions().empty()) {
+    return InvalidArgument("Gather operand must have at least one dimension");
+  }
+  if (primitive_util::IsSubByteNonPredType(operand_shape.element_type())) {
+    return InvalidArgument("Gather of sub-byte types is not supported: %s",
+                           ShapeUtil::HumanString(operand_shape));
+  }
+  if (operand_shape.element_type() != output_shape.element_type()) {
+    return InvalidArgument(
+        "Gather operand and output must have the same element type: %s vs %s",
+        ShapeUtil::HumanString(operand_shape),
+        ShapeUtil::HumanString(output_shape));
+  }
+  PrimitiveType index_type = indices_shape.element_type();
+  if (index_type != S32 && index_type != S64 && index_type != U32 &&
+      index_type != U64) {
+    return InvalidArgument("Unsupported gather index type: %s",
+                           primitive_util::LowercasePrimitiveTypeName(
+                               index_type));
+  }
+  for (const Shape* shape : {&operand_shape, &indices_shape, &output_shape}) {
+    if (!LayoutUtil::IsMonotonicWithDim0Major(shape->layout())) {
+      return InvalidArgument("Gather shapes must be row-major: %s",
+                             ShapeUtil::HumanStringWithLayout(*shape));
+    }
+  }
+  int64_t row_elements =
+      ShapeUtil::ElementsIn(operand_shape) / operand_shape.dimensions(0);
+  if (operand_shape.dimensions(0) == 0 ||
+      ShapeUtil::ElementsIn(output_shape) !=
+          ShapeUtil::ElementsIn(indices_shape) * row_elements) {
+    return InvalidArgument(
+        "Gather output %s must have a row of operand %s per index of %s",
+        ShapeUtil::HumanString(output_shape),
+        ShapeUtil::HumanString(operand_shape),
+        ShapeUtil::HumanString(indices_shape));
+  }
+
+  return absl::WrapUnique(new GatherThunk(
+      std::move(info), operand_buffer, std::move(operand_shape),
+      indices_buffer, std::move(indices_shape), output_buffer,
+      std::move(output_shape)));
+}
+
+GatherThunk::GatherThunk(Info info, BufferAllocation::Slice operand_buffer,
+                         Shape operand_shape,
+                         BufferAllocation::Slice indices_buffer,
+                         Shape indices_shape,
+                         BufferAllocation::Slice output_buffer,
+                         Shape output_shape)
+    : Thunk(Kind::kGather, std::move(info)),
+      operand_buffer_(operand_buffer),
+      operand_shape_(std::move(operand_shape)),
+      indices_buffer_(indices_buffer),
+      indices_shape_(std::move(indices_shape)),
+      output_buffer_(output_buffer),
+      output_shape_(std::move(output_shape)),
+      num_rows_(operand_shape_.dimensions(0)),
+      row_bytes_(ShapeUtil::ByteSizeOf(operand_shape_) / num_rows_),
+      num_indices_(ShapeUtil::ElementsIn(indices_shape_)) {}
+
+template <typename IndexType>
+void GatherThunk::GatherRows(const char* operand, const IndexType* indices,
+                             char* output, int64_t start, int64_t end) const {
+  // Out of bounds indices are clamped like the start indices of any gather.
+  auto row = [&](int64_t i) -> const char* {
+    int64_t index;
+    if constexpr (std::is_signed_v<IndexType>) {
+      index = std::clamp<int64_t>(indices[i], 0, num_rows_ - 1);
+    } else {
+      index = std::min<uint64_t>(indices[i], num_rows_ - 1);
+    }
+    return operand + index * row_bytes_;
+  };
+
+  for (int64_t i = start; i < std::min(start + kPrefetchDistance, end); ++i) {
+    absl::PrefetchToLocalCache(row(i));
+  }
+  for (int64_t i = start; i < end; ++i) {
+    if (i + kPrefetchDistance < end) {
+      absl::PrefetchToLocalCache(row(i + kPrefetchDistance));
+    }
+    std::memcpy(output + i * row_bytes_, row(i), row_bytes_);
+  }
+}
+
+tsl::AsyncValueRef<Thunk::ExecuteEvent> GatherThunk::Execute(
+    const ExecuteParams& params) {
+  TF_ASSIGN_OR_RETURN(
+      se::DeviceMemoryBase operand,
+      params.buffer_allocations->GetDeviceAddress(operand_buffer_));
+  TF_ASSIGN_OR_RETURN(
+      se::DeviceMemoryBase indices,
+      params.buffer_allocations->GetDeviceAddress(indices_buffer_));
+  TF_ASSIGN_OR_RETURN(
+      se::DeviceMemoryBase output,
+      params.buffer_allocations->GetDeviceAddress(output_buffer_));
+
+  VLOG(3) << absl::StreamFormat("Gather %d rows of %d bytes", num_indices_,
+                                row_bytes_);
+  VLOG(3) << absl::StreamFormat("  operand: %s (%p)",
+                                operand_buffer_.ToString(), operand.opaque());
+  VLOG(3) << absl::StreamFormat("  indices: %s (%p)",
+                                indices_buffer_.ToString(), indices.opaque());
+  VLOG(3) << absl::StreamFormat("  output: %s (%p)", output_buffer_.ToString(),
+                                output.opaque());
+
+  // Gathers the rows selected by the indices in the [start, end) range.
+  auto gather = [this, operand = static_cast<const char*>(operand.opaque()),
+                 indices = indices.opaque(),
+                 output = static_cast<char*>(output.opaque())](int64_t start,
+                                                               int64_t end) {
+    switch (indices_shape_.element_type()) {
+      case S32:
+        return GatherRows(operand, static_cast<const int32_t*>(indices),
+                          output, start, end);
+      case S64:
+        return GatherRows(operand, static_cast<const int64_t*>(indices),
+                          output, start, end);
+      case U32:
+        return GatherRows(operand, static_cast<const uint32_t*>(indices),
+                          output, start, end);
+      case U64:
+        return GatherRows(operand, static_cast<const uint64_t*>(indices),
+                          output, start, end);
+      default:
+        LOG(FATAL) << "Unsupported gather index type";
+    }
+  };
+
+  // Split indices between parallel tasks, and make sure that each task has
+  // enough work to amortize the scheduling overheads.
+  const Eigen::ThreadPoolDevice* device = params.intra_op_threadpool;
+
+  int64_t num_tasks = 1;
+  if (device != nullptr) {
+    num_tasks = std::min({static_cast<int64_t>(device->numThreads()),
+                          num_indices_,
+                          num_indices_ * row_bytes_ / kMinParallelTaskBytes});
+  }
+
+  if (ABSL_PREDICT_TRUE(num_tasks <= 1)) {
+    gather(0, num_indices_);
+    return OkExecuteEvent();
+  }
+
+  // Use intra-op thread pool to gather rows in parallel.
+  auto event = tsl::MakeConstructedAsyncValueRef<ExecuteEvent>();
+  auto counter = std::make_shared<std::atomic<int64_t>>(num_tasks);
+
+  auto execute = [event, counter, gather, num_tasks,
+                  num_indices = num_indices_](int64_t task_index) {
+    gather(task_index * num_indices / num_tasks,
+           (task_index + 1) * num_indices / num_tasks);
+
+    if (counter->load() == 1 || counter->fetch_sub(1) == 1) {
+      event.SetStateConcrete();
+    }
+  };
+
+  // Launch parallel gather tasks in the intra-op thread pool.
+  for (int64_t i = 1; i < num_tasks; ++i) {
+    device->getPool()->Schedule([i, execute] { execute(i); });
+  }
+
+  // Execute the first gather task in the caller thread.
+  execute(0);
+
+  return event;
+}
+
+}  // namespace xla::cpu
@@ -0,0 +1,91 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_BACKENDS_CPU_RUNTIME_GATHER_THUNK_H_
+#define XLA_BACKENDS_CPU_RUNTIME_GATHER_THUNK_H_
+
+#include <cstdint>
+#include <memory>
+
+#include "absl/status/statusor.h"
+#include "xla/backends/cpu/runtime/thunk.h"
+#include "xla/runtime/buffer_use.h"
+#include "xla/service/buffer_assignment.h"
+#include "xla/shape.h"
+#include "xla/tsl/concurrency/async_value_ref.h"
+
+namespace xla::cpu {
+
+// Gathers whole rows of a row-major operand, e.g. for embedding lookups:
+//
+//   output[i, ...] = operand[clamp(indices[i], 0, num_rows - 1), ...]
+//
+// where `i` iterates over all indices in row-major order. This is the gather
+// with collapsed_slice_dims={0}, start_index_map={0} and full slices of all
+// other operand dimensions. Rows are copied with memcpy, in parallel on the
+// intra-op thread pool when there are enough of them.
+class GatherThunk final : public Thunk {
+ public:
+  static absl::StatusOr<std::unique_ptr<GatherThunk>> Create(
+      Info info, BufferAllocation::Slice operand_buffer, Shape operand_shape,
+      BufferAllocation::Slice indices_buffer, Shape indices_shape,
+      BufferAllocation::Slice output_buffer, Shape output_shape);
+
+  tsl::AsyncValueRef<ExecuteEvent> Execute(const ExecuteParams& params) final;
+
+  BufferUses buffer_uses() const final {
+    return {BufferUse::Read(operand_buffer_), BufferUse::Read(indices_buffer_),
+            BufferUse::Write(output_buffer_)};
+  }
+
+  const BufferAllocation::Slice& operand_buffer() const {
+    return operand_buffer_;
+  }
+  const Shape& operand_shape() const { return operand_shape_; }
+  const BufferAllocation::Slice& indices_buffer() const {
+    return indices_buffer_;
+  }
+  const Shape& indices_shape() const { return indices_shape_; }
+  const BufferAllocation::Slice& output_buffer() const {
+    return output_buffer_;
+  }
+  const Shape& output_shape() const { return output_shape_; }
+
+ private:
+  GatherThunk(Info info, BufferAllocation::Slice operand_buffer,
+              Shape operand_shape, BufferAllocation::Slice indices_buffer,
+              Shape indices_shape, BufferAllocation::Slice output_buffer,
+              Shape output_shape);
+
+  // Copies the rows selected by the indices in the [start, end) range.
+  template <typename IndexType>
+  void GatherRows(const char* operand, const IndexType* indices, char* output,
+                  int64_t start, int64_t end) const;
+
+  BufferAllocation::Slice operand_buffer_;
+  Shape operand_shape_;
+  BufferAllocation::Slice indices_buffer_;
+  Shape indices_shape_;
+  BufferAllocation::Slice output_buffer_;
+  Shape output_shape_;
+
+  int64_t num_rows_;
+  int64_t row_bytes_;
+  int64_t num_indices_;
+};
+
+}  // namespace xla::cpu
+
+#endif  // XLA_BACKENDS_CPU_RUNTIME_GATHER_THUNK_H_
@@ -0,0 +1,164 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/cpu/runtime/gather_thunk.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#include "absl/status/status.h"
+#include "xla/backends/cpu/runtime/buffer_allocations.h"
+#include "xla/backends/cpu/runtime/thunk.h"
+#include "xla/backends/cpu/runtime/thunk_testlib.h"
+#include "xla/literal.h"
+#include "xla/literal_util.h"
+#include "xla/service/buffer_assignment.h"
+#include "xla/shape.h"
+#include "xla/shape_util.h"
+#include "xla/tsl/concurrency/async_value_ref.h"
+#include "xla/tsl/platform/env.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/tsl/platform/test.h"
+#include "xla/tsl/platform/threadpool.h"
+#include "xla/xla_data.pb.h"
+
+#define EIGEN_USE_THREADS
+#include "unsupported/Eigen/CXX11/Tensor"
+
+namespace xla::cpu {
+namespace {
+
+TEST(GatherThunkTest, GatherRows) {
+  auto operand = LiteralUtil::CreateR2<float>({{1, 2}, {3, 4}, {5, 6}});
+  auto indices = LiteralUtil::CreateR1<int32_t>({2, 0, 2, 1});
+  auto output = LiteralUtil::CreateR2<float>({{0, 0}, {0, 0}, {0, 0}, {0, 0}});
+
+  BufferAllocations allocations =
+      CreateBufferAllocations(operand, indices, output);
+
+  auto [operand_alloc, indices_alloc, output_alloc] =
+      CreateBufferAllocation(operand, indices, output);
+  auto [operand_slice, indices_slice, output_slice] =
+      CreateBufferAllocationSlice(operand_alloc, indices_alloc, output_alloc);
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto thunk, GatherThunk::Create({"gather"}, operand_slice,
+                                      operand.shape(), indices_slice,
+                                      indices.shape(), output_slice,
+                                      output.shape()));
+
+  Thunk::ExecuteParams params;
+  params.buffer_allocations = &allocations;
+
+  auto execute_event = thunk->Execute(params);
+  tsl::BlockUntilReady(execute_event);
+  ASSERT_FALSE(execute_event.IsError());
+
+  EXPECT_EQ(output, LiteralUtil::CreateR2<float>(
+                        {{5, 6}, {1, 2}, {5, 6}, {3, 4}}));
+}
+
+TEST(GatherThunkTest, ClampOutOfBoundsIndices) {
+  auto operand = LiteralUtil::CreateR2<float>({{1, 2}, {3, 4}, {5, 6}});
+  auto indices = LiteralUtil::CreateR2<int64_t>({{-1, 7}, {1, 3}});
+  auto output = LiteralUtil::CreateR3<float>(
+      {{{0, 0}, {0, 0}}, {{0, 0}, {0, 0}}});
+
+  BufferAllocations allocations =
+      CreateBufferAllocations(operand, indices, output);
+
+  auto [operand_alloc, indices_alloc, output_alloc] =
+      CreateBufferAllocation(operand, indices, output);
+  auto [operand_slice, indices_slice, output_slice] =
+      CreateBufferAllocationSlice(operand_alloc, indices_alloc, output_alloc);
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto thunk, GatherThunk::Create({"gather"}, operand_slice,
+                                      operand.shape(), indices_slice,
+                                      indices.shape(), output_slice,
+                                      output.shape()));
+
+  Thunk::ExecuteParams params;
+  params.buffer_allocations = &allocations;
+
+  auto execute_event = thunk->Execute(params);
+  tsl::BlockUntilReady(execute_event);
+  ASSERT_FALSE(execute_event.IsError());
+
+  EXPECT_EQ(output, LiteralUtil::CreateR3<float>(
+                        {{{1, 2}, {5, 6}}, {{3, 4}, {5, 6}}}));
+}
+
+TEST(GatherThunkTest, ParallelGatherRows) {
+  int64_t num_rows = 256;
+  int64_t row_size = 1024;
+  int64_t num_indices = 1024;
+
+  Literal operand(ShapeUtil::MakeShape(F32, {num_rows, row_size}));
+  for (int64_t i = 0; i < num_rows * row_size; ++i) {
+    operand.data<float>()[i] = i;
+  }
+  Literal indices(ShapeUtil::MakeShape(U32, {num_indices}));
+  for (int64_t i = 0; i < num_indices; ++i) {
+    indices.data<uint32_t>()[i] = (i * 7) % (num_rows + 16);
+  }
+  Literal output(ShapeUtil::MakeShape(F32, {num_indices, row_size}));
+
+  BufferAllocations allocations =
+      CreateBufferAllocations(operand, indices, output);
+
+  auto [operand_alloc, indices_alloc, output_alloc] =
+      CreateBufferAllocation(operand, indices, output);
+  auto [operand_slice, indices_slice, output_slice] =
+      CreateBufferAllocationSlice(operand_alloc, indices_alloc, output_alloc);
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto thunk, GatherThunk::Create({"gather"}, operand_slice,
+                                      operand.shape(), indices_slice,
+                                      indices.shape(), output_slice,
+                                      output.shape()));
+
+  tsl::thread::ThreadPool threads(tsl::Env::Default(), "test", 8);
+  Eigen::ThreadPoolDevice device(threads.AsEigenThreadPool(),
+                                 threads.NumThreads());
+
+  Thunk::ExecuteParams params;
+  params.buffer_allocations = &allocations;
+  params.intra_op_threadpool = &device;
+
+  auto execute_event = thunk->Execute(params);
+  tsl::BlockUntilReady(execute_event);
+  ASSERT_FALSE(execute_event.IsError());
+
+  for (int64_t i = 0; i < num_indices; ++i) {
+    int64_t row = std::min<int64_t>((i * 7) % (num_rows + 16), num_rows - 1);
+    for (int64_t j = 0; j < row_size; ++j) {
+      ASSERT_EQ(output.Get<float>({i, j}), row * row_size + j);
+    }
+  }
+}
+
+TEST(GatherThunkTest, RejectMismatchedOutputShape) {
+  BufferAllocation alloc(/*index=*/0, /*size=*/1024, /*color=*/0);
+  BufferAllocation::Slice slice(&alloc, /*offset=*/0, /*size=*/1024);
+
+  auto thunk = GatherThunk::Create(
+      {"gather"}, slice, ShapeUtil::MakeShape(F32, {8, 4}), slice,
+      ShapeUtil::MakeShape(S32, {3}), slice, ShapeUtil::MakeShape(F32, {3, 8}));
+  EXPECT_EQ(thunk.status().code(), absl::StatusCode::kInvalidArgument);
+}
+
+}  // namespace
+}  // namespace xla::cpu
@@ -191,9 +191,10 @@ tsl::AsyncValueRef<LaunchEvent> Kernel::Launch(
                : tsl::MakeErrorAsyncValueRef(std::move(launched));
   }
 
-  // Do not create more workers than the number of threads in the thread pool.
+  // Do not create more workers than the number of threads the device may use
+  // in the thread pool.
   size_t num_workers =
-      std::min<size_t>(std::min<size_t>(num_tasks, device->numThreadsInPool()),
+      std::min<size_t>(std::min<size_t>(num_tasks, device->numThreads()),
                        std::numeric_limits<uint16_t>::max());
 
   if (ABSL_PREDICT_TRUE(num_workgroups.y == 1 && num_workgroups.z == 1)) {
@@ -59,7 +59,7 @@ tsl::AsyncValueRef<tsl::Chain> ParallelLoopRunner::ResetDoneEvent() {
 }
 
 size_t ParallelLoopRunner::num_threads() const {
-  return device_.load()->numThreadsInPool();
+  return device_.load()->numThreads();
 }
 
 bool ParallelLoopRunner::is_in_runner() const {
@@ -229,7 +229,9 @@ class ParallelLoopRunner {
   const Eigen::ThreadPoolDevice* device() const { return device_; }
   void set_device(const Eigen::ThreadPoolDevice* device) { device_ = device; }
 
-  // Returns the number of threads in the underlying thread pool.
+  // Returns the number of threads the runner may use in the underlying thread
+  // pool. It is smaller than the size of the pool if the device has a smaller
+  // thread budget.
   size_t num_threads() const;
 
   // Returns true if the current thread belongs to the underlying thread pool.
@@ -87,7 +87,8 @@ ReduceScatterThunk::Execute(const ExecuteParams& params) {
 
   return ExecuteWithCommunicator(
       params.collective_params,
-      [&](const RendezvousKey& key, Communicator& comm) {
+      [this, data = std::move(data)](const RendezvousKey& key,
+                                     Communicator& comm) {
         CpuCollectives::Executor executor(key, DefaultCollectiveTimeout());
 
         tsl::CountDownAsyncValueRef<Communicator::Event> state(
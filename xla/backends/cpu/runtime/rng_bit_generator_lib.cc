@@ -0,0 +1,132 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/cpu/runtime/rng_bit_generator_lib.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#include "absl/log/log.h"
+#include "absl/numeric/int128.h"
+
+namespace xla::cpu {
+namespace {
+
+// Constants specified by the Philox algorithm.
+constexpr uint32_t kPhiloxW32A = 0x9E3779B9;
+constexpr uint32_t kPhiloxW32B = 0xBB67AE85;
+constexpr uint32_t kPhiloxM4x32A = 0xD2511F53;
+constexpr uint32_t kPhiloxM4x32B = 0xCD9E8D57;
+
+constexpr int kNumRounds = 10;
+
+// The number of counters processed together. The loops over the counters of a
+// block have no dependencies between iterations, and are vectorized by the
+// compiler to whatever the target supports (e.g. AVX-512 or NEON).
+constexpr int64_t kBlockSize = 16;
+
+// Computes Philox4x32-10 for the counters `counter + [0, kBlockSize)` and
+// writes the four 32-bit outputs of the j-th counter to `words[4 * j]` and the
+// three words following it.
+void PhiloxBlock(uint32_t key0, uint32_t key1, absl::uint128 counter,
+                 uint32_t words[4 * kBlockSize]) {
+  const uint64_t counter_low = absl::Uint128Low64(counter);
+  const uint64_t counter_high = absl::Uint128High64(counter);
+
+  uint32_t x0[kBlockSize], x1[kBlockSize], x2[kBlockSize], x3[kBlockSize];
+  for (int64_t j = 0; j < kBlockSize; ++j) {
+    uint64_t low = counter_low + j;
+    uint64_t high = counter_high + (low < counter_low ? 1 : 0);
+    x0[j] = static_cast<uint32_t>(low);
+    x1[j] = static_cast<uint32_t>(low >> 32);
+    x2[j] = static_cast<uint32_t>(high);
+    x3[j] = static_cast<uint32_t>(high >> 32);
+  }
+
+  for (int round = 0; round < kNumRounds; ++round) {
+    for (int64_t j = 0; j < kBlockSize; ++j) {
+      uint64_t product0 = static_cast<uint64_t>(x0[j]) * kPhiloxM4x32A;
+      uint64_t product1 = static_cast<uint64_t>(x2[j]) * kPhiloxM4x32B;
+      uint32_t y0 = static_cast<uint32_t>(product1 >> 32) ^ x1[j] ^ key0;
+      uint32_t y2 = static_cast<uint32_t>(product0 >> 32) ^ x3[j] ^ key1;
+      x0[j] = y0;
+      x1[j] = static_cast<uint32_t>(product1);
+      x2[j] = y2;
+      x3[j] = static_cast<uint32_t>(product0);
+    }
+    key0 += kPhiloxW32A;
+    key1 += kPhiloxW32B;
+  }
+
+  for (int64_t j = 0; j < kBlockSize; ++j) {
+    words[4 * j + 0] = x0[j];
+    words[4 * j + 1] = x1[j];
+    words[4 * j + 2] = x2[j];
+    words[4 * j + 3] = x3[j];
+  }
+}
+
+template <typename T>
+absl::uint128 FillPhiloxBits(uint32_t key0, uint32_t key1,
+                             absl::uint128 counter, int64_t num_elements,
+                             T* data) {
+  constexpr int64_t kWordsPerElement = sizeof(T) == 8 ? 2 : 1;
+  constexpr int64_t kElementsPerBlock = 4 * kBlockSize / kWordsPerElement;
+
+  uint32_t words[4 * kBlockSize];
+  for (int64_t i = 0; i < num_elements; i += kElementsPerBlock) {
+    PhiloxBlock(key0, key1, counter + i * kWordsPerElement / 4, words);
+    int64_t n = std::min(kElementsPerBlock, num_elements - i);
+    for (int64_t e = 0; e < n; ++e) {
+      if constexpr (kWordsPerElement == 2) {
+        data[i + e] = static_cast<uint64_t>(words[2 * e]) |
+                      static_cast<uint64_t>(words[2 * e + 1]) << 32;
+      } else {
+        data[i + e] = static_cast<T>(words[e]);
+      }
+    }
+  }
+
+  // Philox outputs are generated in units of 128 bits.
+  int64_t num_words = num_elements * kWordsPerElement;
+  return counter + (num_words + 3) / 4;
+}
+
+}  // namespace
+
+absl::uint128 FillPhiloxBits(uint64_t key, absl::uint128 counter,
+                             int64_t bit_width, int64_t num_elements,
+                             void* data) {
+  uint32_t key0 = static_cast<uint32_t>(key);
+  uint32_t key1 = static_cast<uint32_t>(key >> 32);
+  switch (bit_width) {
+    case 8:
+      return FillPhiloxBits(key0, key1, counter, num_elements,
+                            static_cast<uint8_t*>(data));
+    case 16:
+      return FillPhiloxBits(key0, key1, counter, num_elements,
+                            static_cast<uint16_t*>(data));
+    case 32:
+      return FillPhiloxBits(key0, key1, counter, num_elements,
+                            static_cast<uint32_t*>(data));
+    case 64:
+      return FillPhiloxBits(key0, key1, counter, num_elements,
+                            static_cast<uint64_t*>(data));
+    default:
+      LOG(FATAL) << "Unsupported Philox bit width: " << bit_width;
+  }
+}
+
+}  // namespace xla::cpu
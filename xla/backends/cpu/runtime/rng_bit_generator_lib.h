@@ -0,0 +1,40 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_BACKENDS_CPU_RUNTIME_RNG_BIT_GENERATOR_LIB_H_
+#define XLA_BACKENDS_CPU_RUNTIME_RNG_BIT_GENERATOR_LIB_H_
+
+#include <cstdint>
+
+#include "absl/numeric/int128.h"
+
+namespace xla::cpu {
+
+// Fills `data` with `num_elements` random values of `bit_width` bits (8, 16,
+// 32 or 64) generated by Philox4x32-10 with the given `key` from consecutive
+// 128-bit counters starting at `counter`, and returns the counter following
+// the last one used.
+//
+// The generated bits are exactly the ones of PhiloxBitGenerator in
+// xla/hlo/builder/lib/prng.h: 32-bit values are the 32-bit Philox outputs in
+// order, 64-bit values combine two consecutive outputs (low bits first), and
+// narrower values are truncated 32-bit outputs.
+absl::uint128 FillPhiloxBits(uint64_t key, absl::uint128 counter,
+                             int64_t bit_width, int64_t num_elements,
+                             void* data);
+
+}  // namespace xla::cpu
+
+#endif  // XLA_BACKENDS_CPU_RUNTIME_RNG_BIT_GENERATOR_LIB_H_
@@ -0,0 +1,91 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/cpu/runtime/rng_bit_generator_lib.h"
+
+#include <cstdint>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/numeric/int128.h"
+
+namespace xla::cpu {
+namespace {
+
+using ::testing::ElementsAre;
+
+// Known answers of Philox4x32-10 from the Random123 library.
+TEST(RngBitGeneratorLibTest, PhiloxKnownAnswers) {
+  std::vector<uint32_t> data(4);
+
+  FillPhiloxBits(0, 0, 32, data.size(), data.data());
+  EXPECT_THAT(data,
+              ElementsAre(0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8));
+
+  FillPhiloxBits(~uint64_t{0}, absl::Uint128Max(), 32, data.size(),
+                 data.data());
+  EXPECT_THAT(data,
+              ElementsAre(0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd));
+
+  FillPhiloxBits(0x299f31d0a4093822,
+                 absl::MakeUint128(0x0370734413198a2e, 0x85a308d3243f6a88), 32,
+                 data.size(), data.data());
+  EXPECT_THAT(data,
+              ElementsAre(0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1));
+}
+
+TEST(RngBitGeneratorLibTest, ReturnsNextCounter) {
+  std::vector<uint32_t> data(37);
+  EXPECT_EQ(FillPhiloxBits(1, 5, 32, data.size(), data.data()), 15);
+
+  std::vector<uint64_t> data64(37);
+  EXPECT_EQ(FillPhiloxBits(1, 5, 64, data64.size(), data64.data()), 24);
+
+  // The counter carries into its high 64 bits.
+  EXPECT_EQ(FillPhiloxBits(1, ~uint64_t{0}, 32, 1, data.data()),
+            absl::MakeUint128(1, 0));
+}
+
+TEST(RngBitGeneratorLibTest, CombinesOutputsOfConsecutiveCounters) {
+  std::vector<uint32_t> data32(100);
+  absl::uint128 counter = absl::MakeUint128(3, ~uint64_t{0} - 10);
+  FillPhiloxBits(42, counter, 32, data32.size(), data32.data());
+
+  std::vector<uint64_t> data64(50);
+  FillPhiloxBits(42, counter, 64, data64.size(), data64.data());
+  std::vector<uint16_t> data16(100);
+  FillPhiloxBits(42, counter, 16, data16.size(), data16.data());
+  std::vector<uint8_t> data8(100);
+  FillPhiloxBits(42, counter, 8, data8.size(), data8.data());
+
+  for (int i = 0; i < 50; ++i) {
+    EXPECT_EQ(data64[i], data32[2 * i] | uint64_t{data32[2 * i + 1]} << 32);
+  }
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(data16[i], static_cast<uint16_t>(data32[i]));
+    EXPECT_EQ(data8[i], static_cast<uint8_t>(data32[i]));
+  }
+
+  // Generating fewer values is a prefix of the same stream.
+  std::vector<uint32_t> prefix(7);
+  FillPhiloxBits(42, counter, 32, prefix.size(), prefix.data());
+  for (int i = 0; i < prefix.size(); ++i) {
+    EXPECT_EQ(prefix[i], data32[i]);
+  }
+}
+
+}  // namespace
+}  // namespace xla::cpu
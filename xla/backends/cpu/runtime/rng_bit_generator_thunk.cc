@@ -0,0 +1,212 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/cpu/runtime/rng_bit_generator_thunk.h"
+
+#define EIGEN_USE_THREADS
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "absl/base/optimization.h"
+#include "absl/log/log.h"
+#include "absl/memory/memory.h"
+#include "absl/numeric/int128.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_format.h"
+#include "unsupported/Eigen/CXX11/Tensor"
+#include "xla/backends/cpu/runtime/rng_bit_generator_lib.h"
+#include "xla/backends/cpu/runtime/thunk.h"
+#include "xla/layout_util.h"
+#include "xla/primitive_util.h"
+#include "xla/service/buffer_assignment.h"
+#include "xla/shape.h"
+#include "xla/shape_util.h"
+#include "xla/stream_executor/device_memory.h"
+#include "xla/tsl/concurrency/async_value_ref.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/util.h"
+#include "xla/xla_data.pb.h"
+
+namespace xla::cpu {
+
+// Minimum number of output elements generated by a single task when we
+// generate random bits in parallel.
+static constexpr int64_t kMinParallelTaskSize = 64 * 1024;
+
+// Philox generates random bits in units of 128 bits, which are 4 output
+// elements of up to 32 bits or 2 output elements of 64 bits. Parallel tasks
+// start at multiples of 4 elements, i.e. at whole Philox counters.
+static constexpr int64_t kElementsPerCounter = 4;
+
+bool RngBitGeneratorThunk::IsSupported(RandomAlgorithm algorithm,
+                                       const Shape& state_shape,
+                                       const Shape& output_shape) {
+  if (algorithm != RandomAlgorithm::RNG_PHILOX &&
+      algorithm != RandomAlgorithm::RNG_DEFAULT) {
+    return false;
+  }
+  // RngBitGeneratorExpander uses the first element of the state as the key,
+  // and the next two elements (or the second and the first one) as the
+  // counter. Larger states are not updated consistently by the expander.
+  if (!state_shape.IsArray() || state_shape.dimensions().size() != 1 ||
+      primitive_util::BitWidth(state_shape.element_type()) != 64 ||
+      state_shape.dimensions(0) < 2 || state_shape.dimensions(0) > 3) {
+    return false;
+  }
+  if (!output_shape.IsArray() ||
+      !primitive_util::IsArrayType(output_shape.element_type()) ||
+      primitive_util::IsComplexType(output_shape.element_type()) ||
+      output_shape.element_type() == PRED) {
+    return false;
+  }
+  int bit_width = primitive_util::BitWidth(output_shape.element_type());
+  if (bit_width != 8 && bit_width != 16 && bit_width != 32 &&
+      bit_width != 64) {
+    return false;
+  }
+  // Random bits are generated in the logical order of the output elements.
+  return !output_shape.has_layout() ||
+         LayoutUtil::IsMonotonicWithDim0Major(output_shape.layout());
+}
+
+RngBitGeneratorThunk::RngBitGeneratorThunk(
+    Info info, RandomAlgorithm algorithm, BufferAllocation::Slice state_buffer,
+    Shape state_shape, BufferAllocation::Slice output_state_buffer,
+    BufferAllocation::Slice output_buffer, Shape output_shape)
+    : Thunk(Kind::kRngBitGenerator, std::move(info)),
+      algorithm_(algorithm),
+      state_buffer_(state_buffer),
+      state_shape_(std::move(state_shape)),
+      output_state_buffer_(output_state_buffer),
+      output_buffer_(output_buffer),
+      output_shape_(std::move(output_shape)) {}
+
+absl::StatusOr<std::unique_ptr<RngBitGeneratorThunk>>
+RngBitGeneratorThunk::Create(Info info, RandomAlgorithm algorithm,
+                             BufferAllocation::Slice state_buffer,
+                             Shape state_shape,
+                             BufferAllocation::Slice output_state_buffer,
+                             BufferAllocation::Slice output_buffer,
+                             Shape output_shape) {
+  if (!IsSupported(algorithm, state_shape, output_shape)) {
+    return Unimplemented(
+        "Unsupported RngBitGenerator with algorithm %s, state shape %s and "
+        "output shape %s",
+        RandomAlgorithm_Name(algorithm),
+        ShapeUtil::HumanStringWithLayout(state_shape),
+        ShapeUtil::HumanStringWithLayout(output_shape));
+  }
+  return absl::WrapUnique(new RngBitGeneratorThunk(
+      std::move(info), algorithm, state_buffer, std::move(state_shape),
+      output_state_buffer, output_buffer, std::move(output_shape)));
+}
+
+tsl::AsyncValueRef<Thunk::ExecuteEvent> RngBitGeneratorThunk::Execute(
+    const ExecuteParams& params) {
+  TF_ASSIGN_OR_RETURN(
+      se::DeviceMemoryBase state,
+      params.buffer_allocations->GetDeviceAddress(state_buffer_));
+  TF_ASSIGN_OR_RETURN(
+      se::DeviceMemoryBase output_state,
+      params.buffer_allocations->GetDeviceAddress(output_state_buffer_));
+  TF_ASSIGN_OR_RETURN(
+      se::DeviceMemoryBase output,
+      params.buffer_allocations->GetDeviceAddress(output_buffer_));
+
+  VLOG(3) << absl::StreamFormat("Rng bit generator: %s",
+                                RandomAlgorithm_Name(algorithm_));
+  VLOG(3) << absl::StreamFormat("  state: %s (%p)", state_buffer_.ToString(),
+                                state.opaque());
+  VLOG(3) << absl::StreamFormat("  output: %s (%p)", output_buffer_.ToString(),
+                                output.opaque());
+
+  // Read the whole state before writing the updated one, as the two buffers
+  // might alias.
+  const int64_t state_size = state_shape_.dimensions(0);
+  const uint64_t* state_data = static_cast<const uint64_t*>(state.opaque());
+  const uint64_t key = state_data[0];
+  const absl::uint128 counter =
+      state_size >= 3 ? absl::MakeUint128(state_data[2], state_data[1])
+                      : absl::MakeUint128(state_data[0], state_data[1]);
+
+  const int64_t bit_width =
+      primitive_util::BitWidth(output_shape_.element_type());
+  const int64_t num_elements = ShapeUtil::ElementsIn(output_shape_);
+  const int64_t words_per_element = bit_width == 64 ? 2 : 1;
+  const absl::uint128 next_counter =
+      counter + CeilOfRatio<int64_t>(num_elements * words_per_element, 4);
+
+  uint64_t* output_state_data = static_cast<uint64_t*>(output_state.opaque());
+  output_state_data[0] = key;
+  output_state_data[1] = absl::Uint128Low64(next_counter);
+  if (state_size >= 3) {
+    output_state_data[2] = absl::Uint128High64(next_counter);
+  }
+
+  // Generates random bits for the output elements in the [start, end) range.
+  auto fill = [=](int64_t start, int64_t end) {
+    FillPhiloxBits(key, counter + start * words_per_element / 4, bit_width,
+                   end - start,
+                   static_cast<char*>(output.opaque()) + start * bit_width / 8);
+  };
+
+  // Split output elements between parallel tasks, and make sure that each task
+  // has enough work to amortize the scheduling overheads.
+  const Eigen::ThreadPoolDevice* device = params.intra_op_threadpool;
+  const int64_t num_counters = CeilOfRatio(num_elements, kElementsPerCounter);
+
+  int64_t num_tasks = 1;
+  if (device != nullptr) {
+    num_tasks = std::min(static_cast<int64_t>(device->numThreads()),
+                         num_elements / kMinParallelTaskSize);
+  }
+
+  if (ABSL_PREDICT_TRUE(num_tasks <= 1)) {
+    fill(0, num_elements);
+    return OkExecuteEvent();
+  }
+
+  // Use intra-op thread pool to generate random bits in parallel.
+  auto event = tsl::MakeConstructedAsyncValueRef<ExecuteEvent>();
+  auto pending = std::make_shared<std::atomic<int64_t>>(num_tasks);
+
+  auto execute = [event, pending, fill, num_tasks, num_counters,
+                  num_elements](int64_t task_index) {
+    int64_t start = task_index * num_counters / num_tasks;
+    int64_t end = (task_index + 1) * num_counters / num_tasks;
+    fill(start * kElementsPerCounter,
+         std::min(end * kElementsPerCounter, num_elements));
+
+    if (pending->load() == 1 || pending->fetch_sub(1) == 1) {
+      event.SetStateConcrete();
+    }
+  };
+
+  // Launch parallel tasks in the intra-op thread pool.
+  for (int64_t i = 1; i < num_tasks; ++i) {
+    device->getPool()->Schedule([i, execute] { execute(i); });
+  }
+
+  // Execute the first task in the caller thread.
+  execute(0);
+
+  return event;
+}
+
+}  // namespace xla::cpu
@@ -0,0 +1,85 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_BACKENDS_CPU_RUNTIME_RNG_BIT_GENERATOR_THUNK_H_
+#define XLA_BACKENDS_CPU_RUNTIME_RNG_BIT_GENERATOR_THUNK_H_
+
+#include <memory>
+
+#include "absl/status/statusor.h"
+#include "xla/backends/cpu/runtime/thunk.h"
+#include "xla/runtime/buffer_use.h"
+#include "xla/service/buffer_assignment.h"
+#include "xla/shape.h"
+#include "xla/tsl/concurrency/async_value_ref.h"
+#include "xla/xla_data.pb.h"
+
+namespace xla::cpu {
+
+// Generates random bits for an RngBitGenerator with the Philox algorithm,
+// bit-exactly like the HLO computation RngBitGeneratorExpander replaces it with
+// but without materializing the intermediate Philox state arrays.
+class RngBitGeneratorThunk final : public Thunk {
+ public:
+  // Returns true if an RngBitGenerator with the given algorithm, state shape
+  // and output shape can be executed by this thunk. RNG_DEFAULT is Philox on
+  // XLA:CPU.
+  static bool IsSupported(RandomAlgorithm algorithm, const Shape& state_shape,
+                          const Shape& output_shape);
+
+  static absl::StatusOr<std::unique_ptr<RngBitGeneratorThunk>> Create(
+      Info info, RandomAlgorithm algorithm,
+      BufferAllocation::Slice state_buffer, Shape state_shape,
+      BufferAllocation::Slice output_state_buffer,
+      BufferAllocation::Slice output_buffer, Shape output_shape);
+
+  tsl::AsyncValueRef<ExecuteEvent> Execute(const ExecuteParams& params) final;
+
+  BufferUses buffer_uses() const final {
+    return {BufferUse::Read(state_buffer_),
+            BufferUse::Write(output_state_buffer_),
+            BufferUse::Write(output_buffer_)};
+  }
+
+  RandomAlgorithm algorithm() const { return algorithm_; }
+
+  const BufferAllocation::Slice& state_buffer() const { return state_buffer_; }
+  const Shape& state_shape() const { return state_shape_; }
+  const BufferAllocation::Slice& output_state_buffer() const {
+    return output_state_buffer_;
+  }
+  const BufferAllocation::Slice& output_buffer() const {
+    return output_buffer_;
+  }
+  const Shape& output_shape() const { return output_shape_; }
+
+ private:
+  RngBitGeneratorThunk(Info info, RandomAlgorithm algorithm,
+                       BufferAllocation::Slice state_buffer, Shape state_shape,
+                       BufferAllocation::Slice output_state_buffer,
+                       BufferAllocation::Slice output_buffer,
+                       Shape output_shape);
+
+  RandomAlgorithm algorithm_;
+  BufferAllocation::Slice state_buffer_;
+  Shape state_shape_;
+  BufferAllocation::Slice output_state_buffer_;
+  BufferAllocation::Slice output_buffer_;
+  Shape output_shape_;
+};
+
+}  // namespace xla::cpu
+
+#endif  // XLA_BACKENDS_CPU_RUNTIME_RNG_BIT_GENERATOR_THUNK_H_
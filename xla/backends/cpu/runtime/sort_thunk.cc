@@ -15,8 +15,11 @@ limitations under the License.
 
 #include "xla/backends/cpu/runtime/sort_thunk.h"
 
+#define EIGEN_USE_THREADS
+
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
@@ -32,6 +35,7 @@ limitations under the License.
 
 #include "absl/algorithm/container.h"
 #include "absl/base/attributes.h"
+#include "absl/base/casts.h"
 #include "absl/base/call_once.h"
 #include "absl/base/dynamic_annotations.h"
 #include "absl/base/optimization.h"
@@ -42,6 +46,7 @@ limitations under the License.
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_join.h"
 #include "absl/types/span.h"
+#include "unsupported/Eigen/CXX11/Tensor"
 #include "xla/backends/cpu/runtime/function_library.h"
 #include "xla/backends/cpu/runtime/thunk.h"
 #include "xla/layout_util.h"
@@ -631,10 +636,112 @@ static SortDims GetSortDims(const Shape& shape, int64_t dimension) {
                   num_iterations};
 }
 
+// Minimum size of a contiguous 1D array that we sort with a radix sort instead
+// of a comparison based sort.
+static constexpr int64_t kMinRadixSortSize = 1024;
+
+// Minimum number of elements sorted by a single task when we sort in parallel.
+static constexpr int64_t kMinParallelSortTaskSize = 64 * 1024;
+
+// Unsigned integer type of the radix sort key for values of type `NativeT`.
+template <typename NativeT>
+using RadixKey = std::conditional_t<sizeof(NativeT) == 4, uint32_t, uint64_t>;
+
+// Returns true if we can sort values of type `NativeT` with a radix sort. Radix
+// sort orders floating point values by their bit patterns, which
+// distinguishes -0.0 from +0.0 and therefore is not a valid stable sort.
+template <typename NativeT>
+static constexpr bool IsRadixSortable(bool is_stable) {
+  if constexpr (sizeof(NativeT) != 4 && sizeof(NativeT) != 8) {
+    return false;
+  } else if constexpr (std::is_integral_v<NativeT>) {
+    return true;
+  } else if constexpr (std::is_floating_point_v<NativeT>) {
+    return !is_stable;
+  } else {
+    return false;
+  }
+}
+
+// Maps `value` to an unsigned integer key that has the same order as `value`.
+template <typename NativeT>
+static RadixKey<NativeT> ToRadixKey(NativeT value) {
+  using Key = RadixKey<NativeT>;
+  static constexpr Key kSignBit = Key{1} << (sizeof(Key) * 8 - 1);
+
+  Key bits = absl::bit_cast<Key>(value);
+  if constexpr (std::is_floating_point_v<NativeT>) {
+    // Flip all bits of negative values and only the sign bit of positive ones.
+    return (bits & kSignBit) ? ~bits : (bits | kSignBit);
+  } else if constexpr (std::is_signed_v<NativeT>) {
+    return bits ^ kSignBit;
+  } else {
+    return bits;
+  }
+}
+
+// Sorts a contiguous array with a least significant digit radix sort, that
+// does a counting pass and a scatter pass for each byte of the key, and skips
+// the bytes that are the same for all keys. LSD radix sort is stable.
+template <typename NativeT>
+static void RadixSort1DArrInplace(NativeT* begin, int64_t size,
+                                  SortThunk::SortDirection direction) {
+  using Key = RadixKey<NativeT>;
+
+  // For descending sort we invert the keys, which keeps equal values in their
+  // original order.
+  Key key_mask = direction == SortThunk::SortDirection::kDescending
+                     ? ~Key{0}
+                     : Key{0};
+
+  std::vector<NativeT> scratch(size);
+  NativeT* src = begin;
+  NativeT* dst = scratch.data();
+
+  for (size_t shift = 0; shift < sizeof(Key) * 8; shift += 8) {
+    auto digit = [&](NativeT value) {
+      return static_cast<size_t>(((ToRadixKey(value) ^ key_mask) >> shift) &
+                                 0xFF);
+    };
+
+    std::array<int64_t, 256> offsets = {};
+    for (int64_t i = 0; i < size; ++i) {
+      ++offsets[digit(src[i])];
+    }
+
+    // All keys have the same digit, and this pass would be a no-op.
+    if (absl::c_linear_search(offsets, size)) {
+      continue;
+    }
+
+    int64_t offset = 0;
+    for (int64_t& count : offsets) {
+      offset += std::exchange(count, offset);
+    }
+
+    for (int64_t i = 0; i < size; ++i) {
+      dst[offsets[digit(src[i])]++] = src[i];
+    }
+    std::swap(src, dst);
+  }
+
+  if (src != begin) {
+    std::copy(src, src + size, begin);
+  }
+}
+
 template <class Iterator, class NativeT>
 static void Sort1DArrInplace(int64_t sort_dims_size, int64_t offset,
                              Iterator begin, bool is_stable,
                              SortThunk::SortDirection direction) {
+  if constexpr (std::is_pointer_v<Iterator>) {
+    if (IsRadixSortable<NativeT>(is_stable) &&
+        sort_dims_size >= kMinRadixSortSize) {
+      RadixSort1DArrInplace<NativeT>(begin, sort_dims_size, direction);
+      return;
+    }
+  }
+
   if (direction == SortThunk::SortDirection::kAscending) {
     if (is_stable) {
       std::stable_sort(begin, begin + sort_dims_size, std::less<NativeT>());
@@ -672,6 +779,52 @@ static void Sort1DArrInplace(const SortDims& sort_dims, int64_t offset,
   }
 }
 
+// Sorts a contiguous array of `size` elements by splitting it in halves that
+// are sorted concurrently in the intra-op thread pool and merged when both of
+// them are ready. Recursion stops at `num_tasks == 1`, and `on_done` is called
+// by the task that completes the last merge.
+template <typename NativeT>
+static void ParallelSort1DArrInplace(const Eigen::ThreadPoolDevice* device,
+                                     NativeT* begin, int64_t size,
+                                     int64_t num_tasks, bool is_stable,
+                                     SortThunk::SortDirection direction,
+                                     std::function<void()> on_done) {
+  if (num_tasks <= 1) {
+    Sort1DArrInplace<NativeT*, NativeT>(size, /*offset=*/0, begin, is_stable,
+                                        direction);
+    on_done();
+    return;
+  }
+
+  int64_t lhs_size = size / 2;
+  int64_t lhs_num_tasks = num_tasks / 2;
+
+  // `std::inplace_merge` is stable, so merging stable sorted halves gives a
+  // stable sort of the whole array.
+  auto pending = std::make_shared<std::atomic<int32_t>>(2);
+  auto merge = [=, on_done = std::move(on_done)] {
+    if (pending->fetch_sub(1) != 1) {
+      return;
+    }
+    if (direction == SortThunk::SortDirection::kAscending) {
+      std::inplace_merge(begin, begin + lhs_size, begin + size,
+                         std::less<NativeT>());
+    } else {
+      std::inplace_merge(begin, begin + lhs_size, begin + size,
+                         std::greater<NativeT>());
+    }
+    on_done();
+  };
+
+  device->getPool()->Schedule([=] {
+    ParallelSort1DArrInplace<NativeT>(device, begin, lhs_size, lhs_num_tasks,
+                                      is_stable, direction, merge);
+  });
+  ParallelSort1DArrInplace<NativeT>(device, begin + lhs_size, size - lhs_size,
+                                    num_tasks - lhs_num_tasks, is_stable,
+                                    direction, merge);
+}
+
 // Sorts `n` buffers in place.
 template <size_t n>
 static void SortInplace(const SortDims& sort_dims, int64_t offset,
@@ -739,17 +892,15 @@ static void DSortInplace(const SortDims& sort_dims, int64_t offset,
   }
 }
 
-// Sorts `data` of the given `shape` along the `dimension` inplace.
-static absl::Status SortInplace(
-    absl::Span<se::DeviceMemoryBase> data, absl::Span<const Shape> shapes,
-    int64_t dimension, bool is_stable, SortThunk::LessThan* less_than,
-    std::optional<SortThunk::SortDirection> direction) {
-  // All inputs have the same dimensions and layout, so we can use the first
-  // shape to get the sort dimensions.
-  SortDims sort_dims = GetSortDims(shapes[0], dimension);
-
-  // Iterate over all the 1-dimensional slices of the buffers and sort them.
-  for (int64_t i = 0; i < sort_dims.num_iterations; ++i) {
+// Sorts 1-dimensional slices of `data` in the [start, end) iteration range
+// inplace. Slices are independent and can be sorted concurrently.
+static void SortInplace(const SortDims& sort_dims, int64_t start, int64_t end,
+                        absl::Span<se::DeviceMemoryBase> data,
+                        absl::Span<const Shape> shapes, bool is_stable,
+                        SortThunk::LessThan* less_than,
+                        std::optional<SortThunk::SortDirection> direction) {
+  // Iterate over the 1-dimensional slices of the buffers and sort them.
+  for (int64_t i = start; i < end; ++i) {
     int64_t inner_idx = i % sort_dims.inner_dim_size;
     int64_t offset = inner_idx + (i - inner_idx) * sort_dims.sort_dim_size;
 
@@ -841,8 +992,41 @@ static absl::Status SortInplace(
         break;
     }
   }
+}
 
-  return absl::OkStatus();
+// Sorts a single contiguous 1D array in parallel if it has a builtin
+// comparator for its element type. Returns an empty async value if the array
+// must be sorted with the generic sort function.
+static tsl::AsyncValueRef<SortThunk::ExecuteEvent> ParallelSort1DArrInplace(
+    const Eigen::ThreadPoolDevice* device, const SortDims& sort_dims,
+    se::DeviceMemoryBase data, PrimitiveType type, bool is_stable,
+    SortThunk::SortDirection direction) {
+  int64_t num_tasks =
+      std::min<int64_t>(device->numThreads(),
+                        sort_dims.sort_dim_size / kMinParallelSortTaskSize);
+
+  tsl::AsyncValueRef<SortThunk::ExecuteEvent> event;
+  if (num_tasks <= 1) {
+    return event;
+  }
+
+  primitive_util::ArrayTypeSwitch(
+      [&](auto cst_type) {
+        if constexpr ((primitive_util::IsFloatingPointType(cst_type) ||
+                       primitive_util::IsIntegralType(cst_type)) &&
+                      primitive_util::BitWidth(cst_type) >= 8) {
+          using NativeT =
+              typename primitive_util::PrimitiveTypeToNative<cst_type>::type;
+          event = tsl::MakeConstructedAsyncValueRef<SortThunk::ExecuteEvent>();
+          ParallelSort1DArrInplace<NativeT>(
+              device, reinterpret_cast<NativeT*>(data.opaque()),
+              sort_dims.sort_dim_size, num_tasks, is_stable, direction,
+              [event] { event.SetStateConcrete(); });
+        }
+      },
+      type);
+
+  return event;
 }
 
 tsl::AsyncValueRef<SortThunk::ExecuteEvent> SortThunk::Execute(
@@ -901,10 +1085,76 @@ tsl::AsyncValueRef<SortThunk::ExecuteEvent> SortThunk::Execute(
   TF_RETURN_IF_ERROR(less_than_.status());
   LessThan* less_than = &less_than_.value();
 
-  TF_RETURN_IF_ERROR(SortInplace(absl::MakeSpan(data), shapes, dimension_,
-                                 is_stable_, less_than, direction_));
+  // All inputs have the same dimensions and layout, so we can use the first
+  // shape to get the sort dimensions.
+  SortDims sort_dims = GetSortDims(shapes[0], dimension_);
+
+  const Eigen::ThreadPoolDevice* device = params.intra_op_threadpool;
+
+  // Sort a single large array with a builtin comparator using parallel merge
+  // sort, as we don't have any independent slices to sort concurrently.
+  if (device != nullptr && sort_dims.num_iterations == 1 &&
+      data.size() == 1 && direction_.has_value()) {
+    auto event =
+        ParallelSort1DArrInplace(device, sort_dims, data[0],
+                                 shapes[0].element_type(), is_stable_,
+                                 *direction_);
+    if (event) {
+      return event;
+    }
+  }
+
+  // Split independent 1-dimensional slices between parallel tasks, and make
+  // sure that each task has enough work to amortize the scheduling overheads.
+  int64_t num_tasks = 1;
+  if (device != nullptr) {
+    int64_t num_elements = sort_dims.num_iterations * sort_dims.sort_dim_size;
+    num_tasks = std::min({static_cast<int64_t>(device->numThreads()),
+                          sort_dims.num_iterations,
+                          num_elements / kMinParallelSortTaskSize});
+  }
+
+  if (ABSL_PREDICT_TRUE(num_tasks <= 1)) {
+    SortInplace(sort_dims, 0, sort_dims.num_iterations, absl::MakeSpan(data),
+                shapes, is_stable_, less_than, direction_);
+    return OkExecuteEvent();
+  }
+
+  // Use intra-op thread pool to sort slices in parallel.
+  struct SortArgs {
+    absl::InlinedVector<se::DeviceMemoryBase, 8> data;
+    absl::InlinedVector<Shape, 8> shapes;
+  };
+
+  auto event = tsl::MakeConstructedAsyncValueRef<ExecuteEvent>();
+  auto counter = std::make_shared<std::atomic<int64_t>>(num_tasks);
+  auto args = std::make_shared<SortArgs>(
+      SortArgs{std::move(data), std::move(shapes)});
+
+  // Sorts a range of 1-dimensional slices for a single task.
+  auto execute = [event, counter, args, sort_dims, num_tasks, less_than,
+                  is_stable = is_stable_,
+                  direction = direction_](int64_t task_index) {
+    int64_t start = task_index * sort_dims.num_iterations / num_tasks;
+    int64_t end = (task_index + 1) * sort_dims.num_iterations / num_tasks;
+
+    SortInplace(sort_dims, start, end, absl::MakeSpan(args->data),
+                args->shapes, is_stable, less_than, direction);
+
+    if (counter->load() == 1 || counter->fetch_sub(1) == 1) {
+      event.SetStateConcrete();
+    }
+  };
+
+  // Launch parallel sort tasks in the intra-op thread pool.
+  for (int64_t i = 1; i < num_tasks; ++i) {
+    device->getPool()->Schedule([i, execute] { execute(i); });
+  }
+
+  // Execute the first sort task in the caller thread.
+  execute(0);
 
-  return OkExecuteEvent();
+  return event;
 }
 
 SortThunk::BufferUses SortThunk::buffer_uses() const {
@@ -21,6 +21,7 @@ limitations under the License.
 #include <optional>
 #include <vector>
 
+#include "absl/algorithm/container.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/span.h"
@@ -36,12 +37,17 @@ limitations under the License.
 #include "xla/shape.h"
 #include "xla/shape_util.h"
 #include "xla/tsl/concurrency/async_value_ref.h"
+#include "xla/tsl/platform/env.h"
 #include "xla/tsl/platform/logging.h"
 #include "xla/tsl/platform/statusor.h"
 #include "xla/tsl/platform/test.h"
 #include "xla/tsl/platform/test_benchmark.h"
+#include "xla/tsl/platform/threadpool.h"
 #include "xla/xla_data.pb.h"
 
+#define EIGEN_USE_THREADS
+#include "unsupported/Eigen/CXX11/Tensor"
+
 namespace xla::cpu {
 namespace {
 
@@ -101,6 +107,128 @@ TEST_P(SortThunkTest, DescendingSortPlainArray) {
                              data.data<float>().end(), std::greater<float>()));
 }
 
+TEST_P(SortThunkTest, RadixSortPlainArray) {
+  bool is_stable = GetParam();
+
+  // Mix positive and negative values to check the order of the radix keys.
+  std::vector<int32_t> values(10000);
+  for (int32_t i = 0; i < values.size(); ++i) {
+    values[i] = static_cast<int32_t>(static_cast<uint32_t>(i) * 2654435761u);
+  }
+  auto data = LiteralUtil::CreateR1<int32_t>(values);
+
+  BufferAllocations allocations = CreateBufferAllocations(data);
+  BufferAllocation alloc = CreateBufferAllocation(0, data);
+  BufferAllocation::Slice slice = CreateBufferAllocationSlice(alloc);
+
+  auto fake_less_than = [](const void** data) { return false; };
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto thunk, SortThunk::Create({"sort"}, {{slice, data.shape()}},
+                                    /*dimension=*/0, is_stable, fake_less_than,
+                                    SortThunk::SortDirection::kAscending));
+
+  Thunk::ExecuteParams params;
+  params.buffer_allocations = &allocations;
+
+  auto execute_event = thunk->Execute(params);
+  tsl::BlockUntilReady(execute_event);
+  ASSERT_FALSE(execute_event.IsError());
+
+  absl::c_sort(values);
+  EXPECT_EQ(data, LiteralUtil::CreateR1<int32_t>(values));
+}
+
+TEST_P(SortThunkTest, ParallelSortPlainArray) {
+  bool is_stable = GetParam();
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto data, LiteralUtil::CreateRandomLiteral<F32>(
+                     ShapeUtil::MakeShape(F32, {1 << 20}), 1.0f, 0.1f));
+
+  BufferAllocations allocations = CreateBufferAllocations(data);
+  BufferAllocation alloc = CreateBufferAllocation(0, data);
+  BufferAllocation::Slice slice = CreateBufferAllocationSlice(alloc);
+
+  auto fake_less_than = [](const void** data) { return false; };
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto thunk, SortThunk::Create({"sort"}, {{slice, data.shape()}},
+                                    /*dimension=*/0, is_stable, fake_less_than,
+                                    SortThunk::SortDirection::kDescending));
+
+  tsl::thread::ThreadPool threads(tsl::Env::Default(), "test", 8);
+  Eigen::ThreadPoolDevice device(threads.AsEigenThreadPool(),
+                                 threads.NumThreads());
+
+  Thunk::ExecuteParams params;
+  params.buffer_allocations = &allocations;
+  params.intra_op_threadpool = &device;
+
+  auto execute_event = thunk->Execute(params);
+  tsl::BlockUntilReady(execute_event);
+  ASSERT_FALSE(execute_event.IsError());
+
+  EXPECT_TRUE(std::is_sorted(data.data<float>().begin(),
+                             data.data<float>().end(), std::greater<float>()));
+}
+
+TEST_P(SortThunkTest, ParallelSort2D) {
+  bool is_stable = GetParam();
+
+  int64_t num_rows = 64;
+  int64_t row_size = 4096;
+
+  TF_ASSERT_OK_AND_ASSIGN(auto data,
+                          LiteralUtil::CreateRandomLiteral<F32>(
+                              ShapeUtil::MakeShape(F32, {num_rows, row_size}),
+                              1.0f, 0.1f));
+  Literal indices(ShapeUtil::MakeShape(S32, {num_rows, row_size}));
+  for (int64_t i = 0; i < num_rows * row_size; ++i) {
+    indices.data<int32_t>()[i] = i;
+  }
+
+  Literal expected_data = data.Clone();
+
+  BufferAllocations allocations = CreateBufferAllocations(data, indices);
+
+  auto [alloc0, alloc1] = CreateBufferAllocation(data, indices);
+  auto [slice0, slice1] = CreateBufferAllocationSlice(alloc0, alloc1);
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto thunk,
+      SortThunk::Create({"sort"},
+                        {{slice0, data.shape()}, {slice1, indices.shape()}},
+                        /*dimension=*/1, is_stable, LessThan,
+                        SortThunk::SortDirection::kAscending));
+
+  tsl::thread::ThreadPool threads(tsl::Env::Default(), "test", 8);
+  Eigen::ThreadPoolDevice device(threads.AsEigenThreadPool(),
+                                 threads.NumThreads());
+
+  Thunk::ExecuteParams params;
+  params.buffer_allocations = &allocations;
+  params.intra_op_threadpool = &device;
+
+  auto execute_event = thunk->Execute(params);
+  tsl::BlockUntilReady(execute_event);
+  ASSERT_FALSE(execute_event.IsError());
+
+  // Check that every row is sorted and indices point to the original values.
+  absl::Span<const float> sorted = data.data<float>();
+  absl::Span<const float> original = expected_data.data<float>();
+  for (int64_t row = 0; row < num_rows; ++row) {
+    absl::Span<const float> sorted_row =
+        sorted.subspan(row * row_size, row_size);
+    EXPECT_TRUE(absl::c_is_sorted(sorted_row));
+    for (int64_t col = 0; col < row_size; ++col) {
+      int32_t index = indices.data<int32_t>()[row * row_size + col];
+      EXPECT_EQ(index / row_size, row);
+      EXPECT_EQ(sorted_row[col], original[index]);
+    }
+  }
+}
+
 TEST_P(SortThunkTest, Sort1D) {
   bool is_stable = GetParam();
 
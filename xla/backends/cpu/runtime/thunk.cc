@@ -56,6 +56,8 @@ absl::string_view Thunk::KindToString(Kind kind) {
       return "dot";
     case Kind::kFft:
       return "fft";
+    case Kind::kGather:
+      return "gather";
     case Kind::kInfeed:
       return "infeed";
     case Kind::kKernel:
@@ -66,6 +68,8 @@ absl::string_view Thunk::KindToString(Kind kind) {
       return "partition-id";
     case Kind::kReplicaId:
       return "replica-id";
+    case Kind::kRngBitGenerator:
+      return "rng-bit-generator";
     case Kind::kRngGetAndUpdateState:
       return "rng-get-and-update-state";
     case Kind::kSort:
@@ -72,11 +72,13 @@ class Thunk {
     kCustomCall,
     kDot,
     kFft,
+    kGather,
     kInfeed,
     kKernel,
     kOutfeed,
     kPartitionId,
     kReplicaId,
+    kRngBitGenerator,
     kRngGetAndUpdateState,
     kSort,
     kTopK,
@@ -21,15 +21,19 @@ limitations under the License.
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <deque>
 #include <iterator>
 #include <memory>
+#include <optional>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 #include "absl/algorithm/container.h"
 #include "absl/base/attributes.h"
 #include "absl/base/optimization.h"
+#include "absl/container/fixed_array.h"
 #include "absl/container/inlined_vector.h"
 #include "absl/log/check.h"
 #include "absl/status/status.h"
@@ -40,11 +44,13 @@ limitations under the License.
 #include "absl/synchronization/mutex.h"
 #include "absl/types/span.h"
 #include "xla/backends/cpu/runtime/thunk.h"
+#include "xla/backends/cpu/runtime/thunk_metrics.h"
 #include "xla/runtime/buffer_use.h"
 #include "xla/runtime/execution_graph.h"
 #include "xla/runtime/resource_use.h"
 #include "xla/tsl/concurrency/async_value_ref.h"
 #include "xla/tsl/platform/env.h"
+#include "xla/tsl/platform/errors.h"
 #include "xla/tsl/platform/logging.h"
 #include "xla/tsl/platform/statusor.h"
 #include "tsl/platform/numbers.h"
@@ -201,6 +207,21 @@ absl::StatusOr<ThunkExecutor> ThunkExecutor::Create(
                        options);
 }
 
+absl::StatusOr<ThunkExecutor> ThunkExecutor::Create(
+    ThunkSequence thunk_sequence, const ThunkExecutor::Options& options,
+    absl::Span<const int64_t> thunk_costs) {
+  // Construct an execution graph for the given thunk sequence.
+  TF_ASSIGN_OR_RETURN(ExecutionGraph execution_graph,
+                      ExecutionGraph::Create<ThunkOperation>(
+                          CreateThunkOperations(thunk_sequence)));
+
+  // Replace graph-shape based priorities with critical path priorities.
+  TF_RETURN_IF_ERROR(execution_graph.UpdatePrioritiesFromCosts(thunk_costs));
+
+  return ThunkExecutor(std::move(thunk_sequence), std::move(execution_graph),
+                       options);
+}
+
 ThunkExecutor::ExecuteState::Node::Node(const NodeDef& node_def)
     : counter(node_def.in_edges.size()), out_edges(node_def.out_edges) {}
 
@@ -220,10 +241,33 @@ ThunkExecutor::ExecuteState::ExecuteState(ThunkExecutor* executor,
 
 // Executes given `thunk` and adds tracing annotation to record the execution
 // start and end events for profiling.
+// Executes `thunk` and records its wall-clock execution time in thunk metrics.
+static tsl::AsyncValueRef<Thunk::ExecuteEvent> SampledExecute(
+    Thunk& thunk, const Thunk::ExecuteParams& params) {
+  uint64_t start_us = tsl::Env::Default()->NowMicros();
+  auto execute_event = thunk.Execute(params);
+
+  if (ABSL_PREDICT_TRUE(execute_event.IsAvailable())) {
+    RecordThunkExecutionTime(thunk,
+                             tsl::Env::Default()->NowMicros() - start_us);
+  } else {
+    execute_event.AndThen([&thunk, start_us] {
+      RecordThunkExecutionTime(thunk,
+                               tsl::Env::Default()->NowMicros() - start_us);
+    });
+  }
+
+  return execute_event;
+}
+
 tsl::AsyncValueRef<Thunk::ExecuteEvent> ThunkExecutor::TracedExecute(
     Thunk& thunk, const Thunk::ExecuteParams& params) {
-  // If profiler is not active avoid overheads of calling AndThen below.
+  // If profiler is not active avoid overheads of calling AndThen below. Every
+  // N-th execution might still be timed if thunk sampling is enabled.
   if (ABSL_PREDICT_TRUE(!tsl::profiler::TraceMe::Active())) {
+    if (ABSL_PREDICT_FALSE(ShouldSampleThunkExecution())) {
+      return SampledExecute(thunk, params);
+    }
     return thunk.Execute(params);
   }
 
@@ -287,6 +331,11 @@ tsl::AsyncValueRef<ThunkExecutor::ExecuteEvent> ThunkExecutor::Execute(
       execute(PriorityReadyQueue(execution_graph_.nodes_defs(),
                                  execution_graph_.source()));
       break;
+    case Options::ReadyQueueType::kWorkStealing:
+      // One deque for every session worker plus one for the caller thread.
+      execute(WorkStealingReadyQueue(params.session.max_workers() + 1,
+                                     execution_graph_.source()));
+      break;
   }
 
   // If execution already completed (all kernels executed in the caller thread),
@@ -436,7 +485,11 @@ void ThunkExecutor::Execute(ExecuteState* state,
                             const Thunk::ExecuteParams& params,
                             ReadyQueue ready_queue,
                             Thunk::ExecuteSession::Lock lock) {
-  DCHECK(!ready_queue.Empty()) << "Ready queue must not be empty";
+  // Work stealing ready queue can be drained by other workers before the task
+  // that received it starts running.
+  if constexpr (!std::is_same_v<ReadyQueue, WorkStealingReadyQueue>) {
+    DCHECK(!ready_queue.Empty()) << "Ready queue must not be empty";
+  }
 
   tsl::profiler::TraceMe trace("ThunkExecutor::Execute");
   bool has_runner = state->runner != nullptr;
@@ -800,4 +853,165 @@ ThunkExecutor::PriorityReadyQueue::CreateEmptyReadyQueue() const {
   return PriorityReadyQueue(nodes_defs_, {});
 }
 
+// Per-worker deques of ready nodes. Each deque has a separate mutex, and the
+// owner is the only worker that touches the back of the deque, so under normal
+// operation the lock is uncontended and stealing workers contend only with
+// each other on the front of the deque.
+class ThunkExecutor::WorkStealingReadyQueue::WorkerDeques {
+ public:
+  explicit WorkerDeques(size_t num_workers) : deques_(num_workers) {}
+
+  size_t num_workers() const { return deques_.size(); }
+
+  void PushBack(size_t worker, NodeId id) {
+    Deque& deque = deques_[worker];
+    absl::MutexLock lock(&deque.mu);
+    deque.nodes.push_back(id);
+    deque.size.store(deque.nodes.size(), std::memory_order_relaxed);
+  }
+
+  std::optional<NodeId> PopBack(size_t worker) {
+    Deque& deque = deques_[worker];
+    if (deque.size.load(std::memory_order_relaxed) == 0) return std::nullopt;
+
+    absl::MutexLock lock(&deque.mu);
+    if (deque.nodes.empty()) return std::nullopt;
+    NodeId id = deque.nodes.back();
+    deque.nodes.pop_back();
+    deque.size.store(deque.nodes.size(), std::memory_order_relaxed);
+    return id;
+  }
+
+  // Steals the oldest node from the front of `worker` deque.
+  std::optional<NodeId> PopFront(size_t worker) {
+    Deque& deque = deques_[worker];
+    if (deque.size.load(std::memory_order_relaxed) == 0) return std::nullopt;
+
+    absl::MutexLock lock(&deque.mu);
+    if (deque.nodes.empty()) return std::nullopt;
+    NodeId id = deque.nodes.front();
+    deque.nodes.pop_front();
+    deque.size.store(deque.nodes.size(), std::memory_order_relaxed);
+    return id;
+  }
+
+  // Moves the oldest half of `from` deque to the back of `to` deque.
+  void MoveHalf(size_t from, size_t to) {
+    absl::InlinedVector<NodeId, 8> moved;
+    {
+      Deque& deque = deques_[from];
+      absl::MutexLock lock(&deque.mu);
+      size_t num_moved = deque.nodes.size() / 2;
+      moved.assign(deque.nodes.begin(), deque.nodes.begin() + num_moved);
+      deque.nodes.erase(deque.nodes.begin(), deque.nodes.begin() + num_moved);
+      deque.size.store(deque.nodes.size(), std::memory_order_relaxed);
+    }
+    Deque& deque = deques_[to];
+    absl::MutexLock lock(&deque.mu);
+    deque.nodes.insert(deque.nodes.end(), moved.begin(), moved.end());
+    deque.size.store(deque.nodes.size(), std::memory_order_relaxed);
+  }
+
+  size_t Size(size_t worker) const {
+    return deques_[worker].size.load(std::memory_order_relaxed);
+  }
+
+  // Picks a worker that will receive work offloaded by `worker`. We pick
+  // neighbours in round-robin order to spread the work across all workers.
+  size_t NextWorker(size_t worker) {
+    size_t n = num_workers();
+    if (n == 1) return worker;
+    size_t offset = next_worker_.fetch_add(1, std::memory_order_relaxed);
+    return (worker + 1 + offset % (n - 1)) % n;
+  }
+
+ private:
+  struct alignas(kAtomicAlignment) Deque {
+    absl::Mutex mu;
+    std::deque<NodeId> nodes ABSL_GUARDED_BY(mu);
+
+    // A copy of `nodes.size()` that allows to skip empty deques without
+    // acquiring the lock.
+    std::atomic<size_t> size{0};
+  };
+
+  absl::FixedArray<Deque> deques_;
+  alignas(kAtomicAlignment) std::atomic<size_t> next_worker_{0};
+};
+
+ThunkExecutor::WorkStealingReadyQueue::WorkStealingReadyQueue(
+    size_t num_workers, absl::Span<const NodeId> ready_nodes)
+    : WorkStealingReadyQueue(
+          std::make_shared<WorkerDeques>(std::max<size_t>(1, num_workers)),
+          /*worker=*/0) {
+  for (NodeId id : ready_nodes) {
+    deques_->PushBack(worker_, id);
+  }
+}
+
+ThunkExecutor::WorkStealingReadyQueue::WorkStealingReadyQueue(
+    std::shared_ptr<WorkerDeques> deques, size_t worker)
+    : deques_(std::move(deques)), worker_(worker) {
+  DCHECK_LT(worker_, deques_->num_workers()) << "Worker id is out of bounds";
+}
+
+void ThunkExecutor::WorkStealingReadyQueue::Push(NodeId id) {
+  deques_->PushBack(worker_, id);
+}
+
+std::optional<ThunkExecutor::NodeId>
+ThunkExecutor::WorkStealingReadyQueue::TryPop() {
+  if (std::optional<NodeId> id = deques_->PopBack(worker_)) {
+    return id;
+  }
+
+  // Steal from the closest neighbours first: `PopHalf` offloads work to the
+  // neighbouring deques, so nodes there are likely to share inputs with the
+  // nodes that we have just executed.
+  size_t n = deques_->num_workers();
+  for (size_t i = 1; i < n; ++i) {
+    if (std::optional<NodeId> id = deques_->PopFront((worker_ + i) % n)) {
+      return id;
+    }
+  }
+
+  return std::nullopt;
+}
+
+ThunkExecutor::NodeId ThunkExecutor::WorkStealingReadyQueue::Pop() {
+  if (!next_.has_value()) {
+    next_ = TryPop();
+  }
+  DCHECK(next_.has_value()) << "Queue must not be empty";
+  NodeId id = *next_;
+  next_.reset();
+  return id;
+}
+
+ThunkExecutor::WorkStealingReadyQueue
+ThunkExecutor::WorkStealingReadyQueue::PopHalf() {
+  DCHECK_GT(Size(), 0) << "Queue must not be empty";
+  size_t worker = deques_->NextWorker(worker_);
+  if (worker != worker_) {
+    deques_->MoveHalf(worker_, worker);
+  }
+  return WorkStealingReadyQueue(deques_, worker);
+}
+
+size_t ThunkExecutor::WorkStealingReadyQueue::Size() const {
+  return deques_->Size(worker_) + next_.has_value();
+}
+
+bool ThunkExecutor::WorkStealingReadyQueue::Empty() {
+  if (!next_.has_value()) {
+    next_ = TryPop();
+  }
+  return !next_.has_value();
+}
+
+ThunkExecutor::WorkStealingReadyQueue
+ThunkExecutor::WorkStealingReadyQueue::CreateEmptyReadyQueue() const {
+  return WorkStealingReadyQueue(deques_, worker_);
+}
+
 }  // namespace xla::cpu
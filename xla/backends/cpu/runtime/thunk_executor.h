@@ -19,7 +19,9 @@ limitations under the License.
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <new>
+#include <optional>
 #include <queue>
 #include <string>
 #include <type_traits>
@@ -53,7 +55,7 @@ class ThunkExecutor {
   ThunkExecutor& operator=(ThunkExecutor&&) = default;
 
   struct Options {
-    enum class ReadyQueueType { kFifo, kLifo, kPriority };
+    enum class ReadyQueueType { kFifo, kLifo, kPriority, kWorkStealing };
 
     // If all thunks in a sequence use buffers of size less than or equal to the
     // given threshold, we mark execution as sequential, as concurrency
@@ -79,6 +81,15 @@ class ThunkExecutor {
     return Create(std::move(thunk_sequence), Options());
   }
 
+  // Creates a thunk executor that prioritizes thunks on the longest remaining
+  // critical path computed from per-thunk costs (indexed by the thunk position
+  // in the sequence). Costs can come from a static cost model or from timings
+  // measured by a profiling run (see ExecutionGraph::UpdatePrioritiesFromCosts
+  // for details). Priorities affect only executors with a priority ready queue.
+  static absl::StatusOr<ThunkExecutor> Create(
+      ThunkSequence thunk_sequence, const Options& options,
+      absl::Span<const int64_t> thunk_costs);
+
   // Executes the thunk sequence using the prepared dataflow graph. Executor
   // uses runner to execute ready tasks concurrently. If runner is not provided,
   // executes all tasks in the caller thread.
@@ -87,6 +98,14 @@ class ThunkExecutor {
   // If any of the thunks failed, the event will be in error state.
   tsl::AsyncValueRef<ExecuteEvent> Execute(const Thunk::ExecuteParams& params);
 
+  // Executes thunks sequentially in the caller thread starting from the first
+  // thunk in the sequence, bypassing the dataflow graph even if the executor
+  // was not marked sequential. Thunk sequence order is always a valid
+  // execution order, so this is safe for callers that have no use for
+  // concurrency (i.e. when executing without a task runner).
+  tsl::AsyncValueRef<ExecuteEvent> ExecuteSequential(
+      const Thunk::ExecuteParams& params);
+
   const ThunkSequence& thunk_sequence() const { return thunk_sequence_; }
 
   BufferUses buffer_uses() const { return thunk_sequence_.buffer_uses(); }
@@ -171,6 +190,54 @@ class ThunkExecutor {
     InlinedPriorityQueue queue_;
   };
 
+  // A ready queue backed by per-worker deques shared between all workers
+  // participating in the execution. Each ready queue owns one of the deques:
+  // it pushes and pops nodes at the back of its own deque (LIFO order keeps
+  // freshly produced buffers hot in cache), and when it runs out of work it
+  // steals the oldest nodes from the front of other workers' deques, starting
+  // from its closest neighbours. Because idle workers steal instead of
+  // exiting, the executor has to offload much less work to the task runner.
+  //
+  // Unlike other ready queues, `Empty()` is not a pure observer: it tries to
+  // steal a node from other workers, so that a subsequent `Pop()` always
+  // succeeds even if other workers concurrently drain the shared deques.
+  class WorkStealingReadyQueue {
+   public:
+    class WorkerDeques;
+
+    WorkStealingReadyQueue(size_t num_workers,
+                           absl::Span<const NodeId> ready_nodes);
+
+    void Push(NodeId id);
+
+    NodeId Pop();
+    WorkStealingReadyQueue PopHalf();
+
+    size_t Size() const;
+    bool Empty();
+
+    WorkStealingReadyQueue CreateEmptyReadyQueue() const;
+
+    size_t worker() const { return worker_; }
+
+   private:
+    WorkStealingReadyQueue(std::shared_ptr<WorkerDeques> deques,
+                           size_t worker);
+
+    // Pops a node from this worker deque, or steals it from other workers.
+    std::optional<NodeId> TryPop();
+
+    // Worker deques are shared with all ready queues constructed via
+    // `PopHalf()` and `CreateEmptyReadyQueue()`, and can outlive the execute
+    // state, because a worker might check for more work after the last sink
+    // node completed the execution.
+    std::shared_ptr<WorkerDeques> deques_;
+    size_t worker_;
+
+    // A node that was stolen by `Empty()` and will be returned by `Pop()`.
+    std::optional<NodeId> next_;
+  };
+
  private:
   // Align all atomic counters to a cache line boundary to avoid false
   // sharing between multiple worker threads.
@@ -235,11 +302,6 @@ class ThunkExecutor {
   static tsl::AsyncValueRef<ExecuteEvent> TracedExecute(
       Thunk& thunk, const Thunk::ExecuteParams& params);
 
-  // Executes thunks sequentially starting from the first thunk in the
-  // sequence.
-  tsl::AsyncValueRef<ExecuteEvent> ExecuteSequential(
-      const Thunk::ExecuteParams& params);
-
   // Resumes sequential thunk execution starting from the given index.
   using ThunkIterator = typename ThunkSequence::iterator;
   void ResumeExecuteSequential(ThunkIterator it,
@@ -30,11 +30,13 @@ limitations under the License.
 
 #include "absl/algorithm/container.h"
 #include "absl/status/status.h"
+#include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
 #include "absl/types/span.h"
 #include "xla/backends/cpu/runtime/buffer_allocations.h"
 #include "xla/backends/cpu/runtime/thread_pool_task_runner.h"
 #include "xla/backends/cpu/runtime/thunk.h"
+#include "xla/backends/cpu/runtime/thunk_metrics.h"
 #include "xla/backends/cpu/runtime/thunk_testlib.h"
 #include "xla/literal.h"
 #include "xla/literal_util.h"
@@ -46,6 +48,7 @@ limitations under the License.
 #include "xla/tsl/platform/env.h"
 #include "xla/tsl/platform/errors.h"
 #include "xla/tsl/platform/logging.h"
+#include "xla/tsl/platform/status_matchers.h"
 #include "xla/tsl/platform/statusor.h"
 #include "xla/tsl/platform/test.h"
 #include "xla/tsl/platform/test_benchmark.h"
@@ -59,6 +62,8 @@ namespace xla::cpu {
 namespace {
 
 using ::testing::ElementsAre;
+using ::tsl::testing::IsOkAndHolds;
+using ::tsl::testing::StatusIs;
 
 // We use a global static variable to simulate a shared resource. We check that
 // thunk executor correctly orders access to this resource by running the test
@@ -273,6 +278,8 @@ AddI32Thunk::ResourceUses AddI32Thunk::resource_uses() const {
   }
 }
 
+using ReadyQueueType = ThunkExecutor::Options::ReadyQueueType;
+
 static ThunkExecutor::Options OptionsForTest() {
   return ThunkExecutor::Options{/*execute_sequential_buffer_threshold=*/0,
                                 /*execute_sequential_num_thunks_threshold=*/0};
@@ -453,6 +460,60 @@ TEST(ThunkExecutorTest, PriorityReadyQueueTest) {
   EXPECT_EQ(half2.Pop(), 1);
 }
 
+TEST(ThunkExecutorTest, WorkStealingReadyQueueTest) {
+  ThunkExecutor::WorkStealingReadyQueue queue(/*num_workers=*/2, {});
+
+  // Check basic queue properties.
+  EXPECT_TRUE(queue.Empty());
+  EXPECT_EQ(queue.Size(), 0);
+
+  queue.Push(1);
+  queue.Push(2);
+  queue.Push(3);
+
+  ASSERT_EQ(queue.Size(), 3);
+
+  // Owner worker pops nodes in LIFO order.
+  EXPECT_EQ(queue.Pop(), 3);
+  EXPECT_EQ(queue.Pop(), 2);
+  EXPECT_EQ(queue.Pop(), 1);
+
+  EXPECT_TRUE(queue.Empty());
+  EXPECT_EQ(queue.Size(), 0);
+
+  // Prepare queue for PopHalf test case.
+  queue.Push(1);
+  queue.Push(2);
+  queue.Push(3);
+  queue.Push(4);
+
+  // Pop half of the queue: oldest nodes are moved to the neighbouring worker.
+  ThunkExecutor::WorkStealingReadyQueue half0 = queue.PopHalf();
+  EXPECT_EQ(queue.worker(), 0);
+  EXPECT_EQ(half0.worker(), 1);
+  ASSERT_EQ(half0.Size(), 2);
+  ASSERT_EQ(queue.Size(), 2);
+
+  EXPECT_EQ(half0.Pop(), 2);
+  EXPECT_EQ(half0.Pop(), 1);
+
+  // Once its own deque is empty, the worker steals the oldest node from its
+  // neighbour.
+  EXPECT_FALSE(half0.Empty());
+  EXPECT_EQ(half0.Pop(), 3);
+  EXPECT_EQ(queue.Pop(), 4);
+
+  EXPECT_TRUE(queue.Empty());
+  EXPECT_TRUE(half0.Empty());
+
+  // Empty ready queue shares deques with the original one.
+  ThunkExecutor::WorkStealingReadyQueue empty = queue.CreateEmptyReadyQueue();
+  queue.Push(5);
+  EXPECT_FALSE(empty.Empty());
+  EXPECT_EQ(empty.Pop(), 5);
+  EXPECT_TRUE(queue.Empty());
+}
+
 TEST(ThunkExecutorTest, Execute) {
   BufferAllocation alloc(/*index=*/0, /*size=*/80, /*color=*/0);
 
@@ -500,6 +561,88 @@ TEST(ThunkExecutorTest, Execute) {
                                                   2, 2, 2, 2, 2}));  // slice1
 }
 
+TEST(ThunkExecutorTest, SampleThunkExecutionTimes) {
+  BufferAllocation alloc(/*index=*/0, /*size=*/80, /*color=*/0);
+  BufferAllocation::Slice slice(&alloc, /*offset=*/0, /*size=*/40);
+
+  ThunkSequence sequence;
+  sequence.push_back(AddI32Thunk::Create("sampled", {slice}, {slice}));
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      ThunkExecutor executor,
+      ThunkExecutor::Create(std::move(sequence), OptionsForTest()));
+
+  auto data = LiteralUtil::CreateFull({20}, int32_t{1});
+  BufferAllocations allocations = CreateBufferAllocations(data);
+  Thunk::ExecuteParams params = {nullptr, &allocations};
+
+  auto num_samples = [] {
+    return GetThunkExecutionTimeHistogram(Thunk::Kind::kKernel, "sampled")
+        .num();
+  };
+  double initial_num_samples = num_samples();
+
+  // Sampling is disabled by default.
+  tsl::BlockUntilReady(executor.Execute(params));
+  EXPECT_EQ(num_samples(), initial_num_samples);
+
+  // Time every second thunk execution.
+  SetThunkSamplingPeriod(2);
+  for (int i = 0; i < 4; ++i) {
+    tsl::BlockUntilReady(executor.Execute(params));
+  }
+  SetThunkSamplingPeriod(0);
+
+  EXPECT_EQ(num_samples(), initial_num_samples + 2);
+}
+
+TEST(ThunkExecutorTest, ExecuteWithCriticalPathPriorities) {
+  BufferAllocation alloc(/*index=*/0, /*size=*/80, /*color=*/0);
+
+  BufferAllocation::Slice slice0(&alloc, /*offset=*/0, /*size=*/40);
+  BufferAllocation::Slice slice1(&alloc, /*offset=*/40, /*size=*/40);
+  BufferAllocation::Slice slice2(&alloc, /*offset=*/20, /*size=*/40);
+
+  ThunkExecutor::Options options = OptionsForTest();
+  options.ready_queue_type = ReadyQueueType::kPriority;
+
+  // Returns the order of thunk execution for the given thunk costs.
+  auto execution_order = [&](std::vector<int64_t> costs)
+      -> absl::StatusOr<std::vector<std::string>> {
+    std::vector<std::string> trace;
+
+    ThunkSequence sequence;
+    sequence.push_back(AddI32Thunk::Create("a", {slice0}, {slice0}, &trace));
+    sequence.push_back(AddI32Thunk::Create("b", {slice1}, {slice1}, &trace));
+    sequence.push_back(AddI32Thunk::Create("c", {slice2}, {slice2}, &trace));
+
+    TF_ASSIGN_OR_RETURN(
+        ThunkExecutor executor,
+        ThunkExecutor::Create(std::move(sequence), options, costs));
+
+    auto data = LiteralUtil::CreateFull({20}, int32_t{1});
+    BufferAllocations allocations = CreateBufferAllocations(data);
+    Thunk::ExecuteParams params = {nullptr, &allocations};
+
+    auto execute_event = executor.Execute(params);
+    tsl::BlockUntilReady(execute_event);
+    if (execute_event.IsError()) {
+      return execute_event.GetError();
+    }
+    return trace;
+  };
+
+  // Expensive thunk on the critical path executes first.
+  EXPECT_THAT(execution_order({100, 1, 1}),
+              IsOkAndHolds(ElementsAre("a", "b", "c")));
+  EXPECT_THAT(execution_order({1, 100, 1}),
+              IsOkAndHolds(ElementsAre("b", "a", "c")));
+
+  // Number of costs must match the number of thunks.
+  EXPECT_THAT(execution_order({1, 1}),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
 //===----------------------------------------------------------------------===//
 // ThunkExecutor resource isolation testing
 //===----------------------------------------------------------------------===//
@@ -687,11 +830,12 @@ GenerateThunkSequence(size_t num_elements, size_t num_thunks,
 // and optionally uses a thread pool to execute thunk executor tasks.
 class ThunkExecutorStressTest
     : public testing::TestWithParam<
-          std::tuple<int32_t, bool, bool, SharedResourceUse, bool, bool>> {
+          std::tuple<int32_t, bool, bool, SharedResourceUse, bool,
+                                ReadyQueueType>> {
  public:
   void SetUp() override {
     auto& [num_thunks, use_task_runner, use_device, shared_resource_use,
-           inject_errors, use_priority_ready_queue] = GetParam();
+           inject_errors, ready_queue_type] = GetParam();
 
     use_task_runner_ = use_task_runner;
     use_device_ = use_device;
@@ -727,17 +871,15 @@ class ThunkExecutorStressTest
 
 TEST_P(ThunkExecutorStressTest, Execute) {
   auto [num_thunks, use_task_runner, use_device, shared_resource_use,
-        inject_errors, use_priority_ready_queue] = GetParam();
+        inject_errors, ready_queue_type] = GetParam();
 
   TF_ASSERT_OK_AND_ASSIGN(
       std::unique_ptr<GeneratedThunkSequence> g,
       GenerateThunkSequence(/*num_elements=*/1024, num_thunks,
                             shared_resource_use, inject_errors));
 
-  ThunkExecutor::Options executor_options = {
-      /*execute_sequential_buffer_threshold=*/0,
-      /*use_priority_ready_queue=*/use_priority_ready_queue,
-  };
+  ThunkExecutor::Options executor_options = OptionsForTest();
+  executor_options.ready_queue_type = ready_queue_type;
 
   TF_ASSERT_OK_AND_ASSIGN(
       ThunkExecutor executor,
@@ -795,7 +937,10 @@ INSTANTIATE_TEST_SUITE_P(
                         SharedResourceUse{kAllResource, kComm},
                         SharedResourceUse{kRandomResource, kComm}),
         /*inject_errors=*/testing::Bool(),
-        /*use_priority_ready_queue=*/testing::Bool()));
+        /*ready_queue_type=*/
+        testing::Values(ReadyQueueType::kFifo, ReadyQueueType::kLifo,
+                        ReadyQueueType::kPriority,
+                        ReadyQueueType::kWorkStealing)));
 
 //===----------------------------------------------------------------------===//
 // Performance benchmarks below
@@ -960,6 +1105,59 @@ static void BM_AsyncThunkExecutor(benchmark::State& state) {
   }
 }
 
+// Benchmarks thunk executor on a wide DAG of small independent thunks, which
+// stresses scheduling overheads, with a given number of threads and ready
+// queue type.
+static void BM_WideDagThunkExecutor(benchmark::State& state) {
+  const size_t num_threads = state.range(0);
+  const auto ready_queue_type = static_cast<ReadyQueueType>(state.range(1));
+  const size_t num_thunks = 4096;
+
+  tsl::thread::ThreadPool thread_pool(tsl::Env::Default(), "thunk-executor",
+                                      num_threads);
+  Eigen::ThreadPoolDevice device(thread_pool.AsEigenThreadPool(),
+                                 thread_pool.NumThreads());
+
+  // With a large number of elements random slices rarely overlap, and most of
+  // the thunks are independent.
+  auto g = GenerateThunkSequence(/*num_elements=*/1 << 20, num_thunks,
+                                 /*shared_resource_use=*/{kNoResource},
+                                 /*inject_errors=*/false);
+
+  ThunkExecutor::Options options = OptionsForTest();
+  options.ready_queue_type = ready_queue_type;
+  auto e = ThunkExecutor::Create(std::move((*g)->sequence), options);
+
+  BufferAllocations allocations =
+      CreateBufferAllocations(absl::MakeSpan((*g)->literals));
+  ThreadPoolTaskRunner task_runner(thread_pool.AsEigenThreadPool());
+
+  Thunk::ExecuteParams params = {nullptr, &allocations, nullptr, &device,
+                                 &task_runner};
+  params.session = Thunk::ExecuteSession(num_threads,
+                                         Thunk::ExecuteSession::kSplitThreshold);
+
+  for (auto _ : state) {
+    auto execute_event = e->Execute(params);
+    tsl::BlockUntilReady(execute_event);
+    CHECK(execute_event.IsConcrete());
+  }
+}
+
+static void WideDagThunkExecutorArgs(benchmark::internal::Benchmark* b) {
+  for (ReadyQueueType type :
+       {ReadyQueueType::kFifo, ReadyQueueType::kWorkStealing}) {
+    for (int64_t num_threads = 1; num_threads <= 128; num_threads *= 2) {
+      b->ArgPair(num_threads, static_cast<int64_t>(type));
+    }
+  }
+}
+
+BENCHMARK(BM_WideDagThunkExecutor)
+    ->MeasureProcessCPUTime()
+    ->UseRealTime()
+    ->Apply(WideDagThunkExecutorArgs);
+
 #define BENCHMARK_THUNK_EXECUTOR(name) \
   BENCHMARK(name)                      \
       ->MeasureProcessCPUTime()        \
@@ -0,0 +1,82 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/cpu/runtime/thunk_metrics.h"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include "absl/log/log.h"
+#include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+#include "xla/backends/cpu/runtime/thunk.h"
+#include "xla/tsl/lib/monitoring/sampler.h"
+#include "xla/tsl/protobuf/histogram.pb.h"
+#include "xla/tsl/util/env_var.h"
+
+namespace xla::cpu {
+namespace {
+
+auto* thunk_execution_time_usecs = tsl::monitoring::Sampler<2>::New(
+    {"/xla/cpu/thunk_execution_time_usecs",
+     "Sampled wall-clock time of XLA:CPU thunk executions in microseconds.",
+     "kind", "op_name"},
+    // These exponential buckets cover the following range:
+    // Minimum: 1 us
+    // Maximum: 1 us * 2 ^ 31 == ~36 minutes
+    {tsl::monitoring::Buckets::Exponential(1, 2, 32)});
+
+uint64_t ReadSamplingPeriodFromEnv() {
+  int64_t period = 0;
+  absl::Status status =
+      tsl::ReadInt64FromEnvVar("XLA_CPU_THUNK_SAMPLING_PERIOD", 0, &period);
+  if (!status.ok() || period < 0) {
+    LOG(WARNING) << "Ignoring invalid XLA_CPU_THUNK_SAMPLING_PERIOD: "
+                 << status;
+    return 0;
+  }
+  return period;
+}
+
+}  // namespace
+
+namespace internal {
+std::atomic<uint64_t> thunk_sampling_period = ReadSamplingPeriodFromEnv();
+}  // namespace internal
+
+void SetThunkSamplingPeriod(uint64_t period) {
+  internal::thunk_sampling_period.store(period, std::memory_order_relaxed);
+}
+
+uint64_t GetThunkSamplingPeriod() {
+  return internal::thunk_sampling_period.load(std::memory_order_relaxed);
+}
+
+void RecordThunkExecutionTime(const Thunk& thunk, uint64_t time_usecs) {
+  thunk_execution_time_usecs
+      ->GetCell(std::string(Thunk::KindToString(thunk.kind())),
+                thunk.info().op_name)
+      ->Add(time_usecs);
+}
+
+tensorflow::HistogramProto GetThunkExecutionTimeHistogram(
+    Thunk::Kind kind, absl::string_view op_name) {
+  return thunk_execution_time_usecs
+      ->GetCell(std::string(Thunk::KindToString(kind)), std::string(op_name))
+      ->value();
+}
+
+}  // namespace xla::cpu
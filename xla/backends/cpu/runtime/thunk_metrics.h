@@ -0,0 +1,66 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_BACKENDS_CPU_RUNTIME_THUNK_METRICS_H_
+#define XLA_BACKENDS_CPU_RUNTIME_THUNK_METRICS_H_
+
+#include <atomic>
+#include <cstdint>
+
+#include "absl/base/optimization.h"
+#include "absl/strings/string_view.h"
+#include "xla/backends/cpu/runtime/thunk.h"
+#include "xla/tsl/protobuf/histogram.pb.h"
+
+namespace xla::cpu {
+
+// Sampled thunk execution latencies exported as a monitoring histogram
+// (`/xla/cpu/thunk_execution_time_usecs`) labelled by thunk kind and op name.
+//
+// Sampling is cheap enough to leave on in production: when disabled it costs
+// a single relaxed atomic load per thunk execution, and when enabled only every
+// N-th thunk execution on each thread is timed. The sampling period can be set
+// with `SetThunkSamplingPeriod` or the `XLA_CPU_THUNK_SAMPLING_PERIOD`
+// environment variable. A period of 0 disables sampling (default).
+
+void SetThunkSamplingPeriod(uint64_t period);
+uint64_t GetThunkSamplingPeriod();
+
+namespace internal {
+extern std::atomic<uint64_t> thunk_sampling_period;
+}  // namespace internal
+
+// Returns true if the current thunk execution on this thread should be timed.
+inline bool ShouldSampleThunkExecution() {
+  uint64_t period =
+      internal::thunk_sampling_period.load(std::memory_order_relaxed);
+  if (ABSL_PREDICT_TRUE(period == 0)) {
+    return false;
+  }
+  thread_local uint64_t num_executions = 0;
+  return ++num_executions % period == 0;
+}
+
+// Records a sampled execution time of the `thunk`.
+void RecordThunkExecutionTime(const Thunk& thunk, uint64_t time_usecs);
+
+// Returns the histogram of sampled execution times for the given thunk kind
+// and op name.
+tensorflow::HistogramProto GetThunkExecutionTimeHistogram(
+    Thunk::Kind kind, absl::string_view op_name);
+
+}  // namespace xla::cpu
+
+#endif  // XLA_BACKENDS_CPU_RUNTIME_THUNK_METRICS_H_
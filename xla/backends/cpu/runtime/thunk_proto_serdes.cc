@@ -46,11 +46,13 @@ limitations under the License.
 #include "xla/backends/cpu/runtime/custom_call_thunk.h"
 #include "xla/backends/cpu/runtime/dot_thunk.h"
 #include "xla/backends/cpu/runtime/fft_thunk.h"
+#include "xla/backends/cpu/runtime/gather_thunk.h"
 #include "xla/backends/cpu/runtime/infeed_thunk.h"
 #include "xla/backends/cpu/runtime/kernel_thunk.h"
 #include "xla/backends/cpu/runtime/logical_id_thunk.h"
 #include "xla/backends/cpu/runtime/outfeed_thunk.h"
 #include "xla/backends/cpu/runtime/reduce_scatter_thunk.h"
+#include "xla/backends/cpu/runtime/rng_bit_generator_thunk.h"
 #include "xla/backends/cpu/runtime/rng_state_thunk.h"
 #include "xla/backends/cpu/runtime/serdes_base.h"
 #include "xla/backends/cpu/runtime/sort_thunk.h"
@@ -143,12 +145,16 @@ static absl::StatusOr<Thunk::Kind> ProtoThunkToThunkKind(
       return Thunk::Kind::kDot;
     case ThunkProto::ImplCase::kFftThunk:
       return Thunk::Kind::kFft;
+    case ThunkProto::ImplCase::kGatherThunk:
+      return Thunk::Kind::kGather;
     case ThunkProto::ImplCase::kInfeedThunk:
       return Thunk::Kind::kInfeed;
     case ThunkProto::ImplCase::kKernelThunk:
       return Thunk::Kind::kKernel;
     case ThunkProto::ImplCase::kOutfeedThunk:
       return Thunk::Kind::kOutfeed;
+    case ThunkProto::ImplCase::kRngBitGeneratorThunk:
+      return Thunk::Kind::kRngBitGenerator;
     case ThunkProto::ImplCase::kRngGetAndUpdateStateThunk:
       return Thunk::Kind::kRngGetAndUpdateState;
     case ThunkProto::ImplCase::kSortThunk:
@@ -228,6 +234,7 @@ static absl::StatusOr<CollectiveThunk::OpParams> OpParamsFromProto(
     }
     op_params.group.push_back(group);
   }
+  op_params.is_async = proto.is_async();
   return op_params;
 }
 
@@ -334,6 +341,7 @@ static absl::StatusOr<OpParamsProto> ToProto(
       replica_group->add_replica_ids(device);
     }
   }
+  proto.set_is_async(op_params.is_async);
   return proto;
 }
 
@@ -780,6 +788,22 @@ static absl::Status ToProto(const XnnConvolutionThunk& thunk,
   return absl::OkStatus();
 }
 
+static absl::Status ToProto(const GatherThunk& thunk, ThunkProto& proto) {
+  GatherThunkProto* gather_thunk_proto = proto.mutable_gather_thunk();
+
+  TF_RETURN_IF_ERROR(SerializeSliceShapeIntoProto(
+      thunk.operand_buffer(), thunk.operand_shape(),
+      gather_thunk_proto->mutable_operand_buffer_shape()));
+  TF_RETURN_IF_ERROR(SerializeSliceShapeIntoProto(
+      thunk.indices_buffer(), thunk.indices_shape(),
+      gather_thunk_proto->mutable_indices_buffer_shape()));
+  TF_RETURN_IF_ERROR(SerializeSliceShapeIntoProto(
+      thunk.output_buffer(), thunk.output_shape(),
+      gather_thunk_proto->mutable_output_buffer_shape()));
+
+  return absl::OkStatus();
+}
+
 static absl::Status ToProto(const FftThunk& thunk, ThunkProto& proto) {
   FftThunkProto* fft_thunk_proto = proto.mutable_fft_thunk();
 
@@ -799,6 +823,26 @@ static absl::Status ToProto(const FftThunk& thunk, ThunkProto& proto) {
   return absl::OkStatus();
 }
 
+static absl::Status ToProto(const RngBitGeneratorThunk& thunk,
+                            ThunkProto& proto) {
+  RngBitGeneratorThunkProto* rng_bit_generator_thunk_proto =
+      proto.mutable_rng_bit_generator_thunk();
+
+  rng_bit_generator_thunk_proto->set_algorithm(thunk.algorithm());
+
+  TF_RETURN_IF_ERROR(SerializeSliceShapeIntoProto(
+      thunk.state_buffer(), thunk.state_shape(),
+      rng_bit_generator_thunk_proto->mutable_state_buffer_shape()));
+  TF_ASSIGN_OR_RETURN(
+      *rng_bit_generator_thunk_proto->mutable_output_state_buffer(),
+      thunk.output_state_buffer().ToProto());
+  TF_RETURN_IF_ERROR(SerializeSliceShapeIntoProto(
+      thunk.output_buffer(), thunk.output_shape(),
+      rng_bit_generator_thunk_proto->mutable_output_buffer_shape()));
+
+  return absl::OkStatus();
+}
+
 static absl::Status ToProto(const RngGetAndUpdateStateThunk& thunk,
                             ThunkProto& proto) {
   RngGetAndUpdateStateThunkProto* rng_get_and_update_state_thunk_proto =
@@ -899,6 +943,14 @@ absl::StatusOr<ThunkProto> ThunkSerDesProtobuf::ToProto(
       TF_RETURN_IF_ERROR(
           ::xla::cpu::ToProto(tsl::down_cast<const FftThunk&>(thunk), proto));
       break;
+    case Thunk::Kind::kGather:
+      TF_RETURN_IF_ERROR(::xla::cpu::ToProto(
+          tsl::down_cast<const GatherThunk&>(thunk), proto));
+      break;
+    case Thunk::Kind::kRngBitGenerator:
+      TF_RETURN_IF_ERROR(::xla::cpu::ToProto(
+          tsl::down_cast<const RngBitGeneratorThunk&>(thunk), proto));
+      break;
     case Thunk::Kind::kRngGetAndUpdateState:
       TF_RETURN_IF_ERROR(::xla::cpu::ToProto(
           tsl::down_cast<const RngGetAndUpdateStateThunk&>(thunk), proto));
@@ -1250,6 +1302,33 @@ static absl::StatusOr<std::unique_ptr<DotThunk>> DotThunkFromProto(
                           std::move(out_buffer), out_shape);
 }
 
+static absl::StatusOr<std::unique_ptr<GatherThunk>> GatherThunkFromProto(
+    const ThunkProto& proto,
+    const std::vector<BufferAllocation>& buffer_allocations) {
+  TF_ASSIGN_OR_RETURN(Thunk::Info info, ThunkInfoFromProto(proto.info()));
+
+  TF_ASSIGN_OR_RETURN(
+      auto operand_slice_shape,
+      DeserializeSliceShapeFromProto(
+          proto.gather_thunk().operand_buffer_shape(), buffer_allocations));
+  TF_ASSIGN_OR_RETURN(
+      auto indices_slice_shape,
+      DeserializeSliceShapeFromProto(
+          proto.gather_thunk().indices_buffer_shape(), buffer_allocations));
+  TF_ASSIGN_OR_RETURN(
+      auto output_slice_shape,
+      DeserializeSliceShapeFromProto(proto.gather_thunk().output_buffer_shape(),
+                                     buffer_allocations));
+
+  const auto& [operand_buffer, operand_shape] = operand_slice_shape;
+  const auto& [indices_buffer, indices_shape] = indices_slice_shape;
+  const auto& [output_buffer, output_shape] = output_slice_shape;
+
+  return GatherThunk::Create(std::move(info), operand_buffer, operand_shape,
+                             indices_buffer, indices_shape, output_buffer,
+                             output_shape);
+}
+
 static absl::StatusOr<std::unique_ptr<FftThunk>> FftThunkFromProto(
     const ThunkProto& proto,
     const std::vector<BufferAllocation>& buffer_allocations) {
@@ -1409,6 +1488,38 @@ static absl::StatusOr<std::unique_ptr<OutfeedThunk>> OutfeedThunkFromProto(
                               outfeed_resources);
 }
 
+static absl::StatusOr<std::unique_ptr<RngBitGeneratorThunk>>
+RngBitGeneratorThunkFromProto(
+    const ThunkProto& proto,
+    const std::vector<BufferAllocation>& buffer_allocations) {
+  TF_ASSIGN_OR_RETURN(Thunk::Info info, ThunkInfoFromProto(proto.info()));
+
+  const RngBitGeneratorThunkProto& rng_bit_generator_thunk_proto =
+      proto.rng_bit_generator_thunk();
+  TF_ASSIGN_OR_RETURN(
+      auto state_slice_shape,
+      DeserializeSliceShapeFromProto(
+          rng_bit_generator_thunk_proto.state_buffer_shape(),
+          buffer_allocations));
+  TF_ASSIGN_OR_RETURN(
+      BufferAllocation::Slice output_state_buffer,
+      BufferAllocation::Slice::FromProto(
+          rng_bit_generator_thunk_proto.output_state_buffer(),
+          buffer_allocations));
+  TF_ASSIGN_OR_RETURN(
+      auto output_slice_shape,
+      DeserializeSliceShapeFromProto(
+          rng_bit_generator_thunk_proto.output_buffer_shape(),
+          buffer_allocations));
+
+  const auto& [state_buffer, state_shape] = state_slice_shape;
+  const auto& [output_buffer, output_shape] = output_slice_shape;
+
+  return RngBitGeneratorThunk::Create(
+      std::move(info), rng_bit_generator_thunk_proto.algorithm(), state_buffer,
+      state_shape, output_state_buffer, output_buffer, output_shape);
+}
+
 static absl::StatusOr<std::unique_ptr<RngGetAndUpdateStateThunk>>
 RngGetAndUpdateStateThunkFromProto(
     const ThunkProto& proto,
@@ -1674,12 +1785,16 @@ absl::StatusOr<std::unique_ptr<Thunk>> ThunkSerDesProtobuf::FromProto(
       return DotThunkFromProto(proto, *buffer_allocations_);
     case Thunk::Kind::kFft:
       return FftThunkFromProto(proto, *buffer_allocations_);
+    case Thunk::Kind::kGather:
+      return GatherThunkFromProto(proto, *buffer_allocations_);
     case Thunk::Kind::kInfeed:
       return InfeedThunkFromProto(proto, *buffer_allocations_);
     case Thunk::Kind::kKernel:
       return KernelThunkFromProto(proto, *buffer_allocations_);
     case Thunk::Kind::kOutfeed:
       return OutfeedThunkFromProto(proto, *buffer_allocations_);
+    case Thunk::Kind::kRngBitGenerator:
+      return RngBitGeneratorThunkFromProto(proto, *buffer_allocations_);
     case Thunk::Kind::kRngGetAndUpdateState:
       return RngGetAndUpdateStateThunkFromProto(proto, *buffer_allocations_);
     case Thunk::Kind::kSort:
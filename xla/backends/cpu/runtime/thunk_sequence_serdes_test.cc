@@ -44,11 +44,13 @@ limitations under the License.
 #include "xla/backends/cpu/runtime/custom_call_thunk.h"
 #include "xla/backends/cpu/runtime/dot_thunk.h"
 #include "xla/backends/cpu/runtime/fft_thunk.h"
+#include "xla/backends/cpu/runtime/gather_thunk.h"
 #include "xla/backends/cpu/runtime/infeed_thunk.h"
 #include "xla/backends/cpu/runtime/kernel_thunk.h"
 #include "xla/backends/cpu/runtime/logical_id_thunk.h"
 #include "xla/backends/cpu/runtime/outfeed_thunk.h"
 #include "xla/backends/cpu/runtime/reduce_scatter_thunk.h"
+#include "xla/backends/cpu/runtime/rng_bit_generator_thunk.h"
 #include "xla/backends/cpu/runtime/rng_state_thunk.h"
 #include "xla/backends/cpu/runtime/serdes_base.h"
 #include "xla/backends/cpu/runtime/sort_thunk.h"
@@ -171,11 +173,14 @@ class ThunkSequenceSerdesTest : public ::testing::Test {
     TF_ASSIGN_OR_RETURN(thunk_sequence.emplace_back(), CreateCustomCallThunk());
     TF_ASSIGN_OR_RETURN(thunk_sequence.emplace_back(), CreateDotThunk());
     TF_ASSIGN_OR_RETURN(thunk_sequence.emplace_back(), CreateFftThunk());
+    TF_ASSIGN_OR_RETURN(thunk_sequence.emplace_back(), CreateGatherThunk());
     TF_ASSIGN_OR_RETURN(thunk_sequence.emplace_back(), CreateInfeedThunk());
     TF_ASSIGN_OR_RETURN(thunk_sequence.emplace_back(), CreateOutfeedThunk());
     TF_ASSIGN_OR_RETURN(thunk_sequence.emplace_back(),
                         CreatePartitionIdThunk());
     TF_ASSIGN_OR_RETURN(thunk_sequence.emplace_back(), CreateReplicaIdThunk());
+    TF_ASSIGN_OR_RETURN(thunk_sequence.emplace_back(),
+                        CreateRngBitGeneratorThunk());
     TF_ASSIGN_OR_RETURN(thunk_sequence.emplace_back(),
                         CreateRngGetAndUpdateStateThunk());
     TF_ASSIGN_OR_RETURN(thunk_sequence.emplace_back(), CreateTopKThunk());
@@ -489,6 +494,25 @@ class ThunkSequenceSerdesTest : public ::testing::Test {
         /*output_shape=*/literals_[buffer_allocations_.size() - 1].shape());
   }
 
+  absl::StatusOr<std::unique_ptr<Thunk>> CreateGatherThunk() {
+    TF_RETURN_IF_ERROR(AddBufferAllocations(3));
+
+    return GatherThunk::Create(
+        Thunk::Info(),
+        /*operand_buffer=*/
+        CreateBufferAllocationSlice(
+            buffer_allocations_[buffer_allocations_.size() - 3]),
+        /*operand_shape=*/literals_[buffer_allocations_.size() - 3].shape(),
+        /*indices_buffer=*/
+        CreateBufferAllocationSlice(
+            buffer_allocations_[buffer_allocations_.size() - 2]),
+        /*indices_shape=*/ShapeUtil::MakeShape(S32, {2}),
+        /*output_buffer=*/
+        CreateBufferAllocationSlice(
+            buffer_allocations_[buffer_allocations_.size() - 1]),
+        /*output_shape=*/literals_[buffer_allocations_.size() - 1].shape());
+  }
+
   absl::StatusOr<std::unique_ptr<Thunk>> CreateInfeedThunk() {
     TF_RETURN_IF_ERROR(AddBufferAllocations(2));
 
@@ -545,6 +569,23 @@ class ThunkSequenceSerdesTest : public ::testing::Test {
             buffer_allocations_[buffer_allocations_.size() - 1]));
   }
 
+  absl::StatusOr<std::unique_ptr<Thunk>> CreateRngBitGeneratorThunk() {
+    TF_RETURN_IF_ERROR(AddBufferAllocations(3));
+    return RngBitGeneratorThunk::Create(
+        Thunk::Info(), RandomAlgorithm::RNG_PHILOX,
+        /*state_buffer=*/
+        CreateBufferAllocationSlice(
+            buffer_allocations_[buffer_allocations_.size() - 3]),
+        /*state_shape=*/ShapeUtil::MakeShape(U64, {3}),
+        /*output_state_buffer=*/
+        CreateBufferAllocationSlice(
+            buffer_allocations_[buffer_allocations_.size() - 2]),
+        /*output_buffer=*/
+        CreateBufferAllocationSlice(
+            buffer_allocations_[buffer_allocations_.size() - 1]),
+        /*output_shape=*/literals_[buffer_allocations_.size() - 1].shape());
+  }
+
   absl::StatusOr<std::unique_ptr<Thunk>> CreateRngGetAndUpdateStateThunk() {
     TF_RETURN_IF_ERROR(AddBufferAllocations(1));
     return RngGetAndUpdateStateThunk::Create(
@@ -820,6 +861,7 @@ class ThunkSequenceSerdesTest : public ::testing::Test {
         op_params_1.has_channel_id != op_params_2.has_channel_id ||
         op_params_1.use_global_device_ids !=
             op_params_2.use_global_device_ids ||
+        op_params_1.is_async != op_params_2.is_async ||
         !are_replica_groups_equal) {
       return false;
     }
@@ -984,6 +1026,19 @@ class ThunkSequenceSerdesTest : public ::testing::Test {
            thunk_1.fft_type() == thunk_2.fft_type();
   }
 
+  bool VerifyGatherThunkEquality(const GatherThunk& thunk_1,
+                                 const GatherThunk& thunk_2) {
+    return VerifySliceShapeEquality(
+               thunk_1.operand_buffer(), thunk_1.operand_shape(),
+               thunk_2.operand_buffer(), thunk_2.operand_shape()) &&
+           VerifySliceShapeEquality(
+               thunk_1.indices_buffer(), thunk_1.indices_shape(),
+               thunk_2.indices_buffer(), thunk_2.indices_shape()) &&
+           VerifySliceShapeEquality(
+               thunk_1.output_buffer(), thunk_1.output_shape(),
+               thunk_2.output_buffer(), thunk_2.output_shape());
+  }
+
   bool VerifyInfeedThunkEquality(const InfeedThunk& thunk_1,
                                  const InfeedThunk& thunk_2) {
     InfeedThunk::InfeedResources infeed_resources_1 =
@@ -1042,6 +1097,22 @@ class ThunkSequenceSerdesTest : public ::testing::Test {
                                thunk_2.logical_id_buffer());
   }
 
+  bool VerifyRngBitGeneratorThunkEquality(
+      const RngBitGeneratorThunk& thunk_1,
+      const RngBitGeneratorThunk& thunk_2) {
+    return thunk_1.algorithm() == thunk_2.algorithm() &&
+           VerifySliceShapeEquality(thunk_1.state_buffer(),
+                                    thunk_1.state_shape(),
+                                    thunk_2.state_buffer(),
+                                    thunk_2.state_shape()) &&
+           VerifySliceEquality(thunk_1.output_state_buffer(),
+                               thunk_2.output_state_buffer()) &&
+           VerifySliceShapeEquality(thunk_1.output_buffer(),
+                                    thunk_1.output_shape(),
+                                    thunk_2.output_buffer(),
+                                    thunk_2.output_shape());
+  }
+
   bool VerifyRngGetAndUpdateStateThunkEquality(
       const RngGetAndUpdateStateThunk& thunk_1,
       const RngGetAndUpdateStateThunk& thunk_2) {
@@ -1348,6 +1419,10 @@ class ThunkSequenceSerdesTest : public ::testing::Test {
       case Thunk::Kind::kFft:
         return VerifyFftThunkEquality(tsl::down_cast<const FftThunk&>(thunk_1),
                                       tsl::down_cast<const FftThunk&>(thunk_2));
+      case Thunk::Kind::kGather:
+        return VerifyGatherThunkEquality(
+            tsl::down_cast<const GatherThunk&>(thunk_1),
+            tsl::down_cast<const GatherThunk&>(thunk_2));
       case Thunk::Kind::kInfeed:
         return VerifyInfeedThunkEquality(
             tsl::down_cast<const InfeedThunk&>(thunk_1),
@@ -1372,6 +1447,10 @@ class ThunkSequenceSerdesTest : public ::testing::Test {
             static_cast<const ReplicaIdThunk&>(
                 tsl::down_cast<const internal::LogicalIdThunk<
                     internal::LogicalIdKind::kReplicaId>&>(thunk_2)));
+      case Thunk::Kind::kRngBitGenerator:
+        return VerifyRngBitGeneratorThunkEquality(
+            tsl::down_cast<const RngBitGeneratorThunk&>(thunk_1),
+            tsl::down_cast<const RngBitGeneratorThunk&>(thunk_2));
       case Thunk::Kind::kRngGetAndUpdateState:
         return VerifyRngGetAndUpdateStateThunkEquality(
             tsl::down_cast<const RngGetAndUpdateStateThunk&>(thunk_1),
@@ -15,12 +15,18 @@ limitations under the License.
 
 #include "xla/backends/cpu/runtime/topk_thunk.h"
 
+#define EIGEN_USE_THREADS
+
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <memory>
 #include <utility>
 
+#include "absl/base/optimization.h"
 #include "absl/memory/memory.h"
 #include "absl/status/statusor.h"
+#include "unsupported/Eigen/CXX11/Tensor"
 #include "xla/backends/cpu/runtime/thunk.h"
 #include "xla/service/buffer_assignment.h"
 #include "xla/service/cpu/runtime_topk.h"
@@ -30,6 +36,10 @@ limitations under the License.
 
 namespace xla::cpu {
 
+// Minimum number of input elements processed by a single task when we compute
+// top-k for batch rows in parallel.
+static constexpr int64_t kMinParallelTaskSize = 64 * 1024;
+
 TopKThunk::TopKThunk(Info info, BufferAllocation::Slice values,
                      BufferAllocation::Slice output,
                      BufferAllocation::Slice indices, int64_t batch_size,
@@ -62,11 +72,55 @@ tsl::AsyncValueRef<Thunk::ExecuteEvent> TopKThunk::Execute(
       se::DeviceMemoryBase indices,
       params.buffer_allocations->GetDeviceAddress(indices_buffer_));
 
-  __xla_cpu_runtime_TopKF32(batch_size_, input_size_, k_,
-                            reinterpret_cast<const float*>(values.opaque()),
-                            reinterpret_cast<float*>(output.opaque()),
-                            reinterpret_cast<int32_t*>(indices.opaque()));
-  return OkExecuteEvent();
+  // Computes top-k elements for the rows in the [start, end) range.
+  auto top_k = [=, input_size = input_size_, k = k_](int64_t start,
+                                                     int64_t end) {
+    __xla_cpu_runtime_TopKF32(
+        end - start, input_size, k,
+        reinterpret_cast<const float*>(values.opaque()) + start * input_size,
+        reinterpret_cast<float*>(output.opaque()) + start * k,
+        reinterpret_cast<int32_t*>(indices.opaque()) + start * k);
+  };
+
+  // Split batch rows between parallel tasks, and make sure that each task has
+  // enough work to amortize the scheduling overheads.
+  const Eigen::ThreadPoolDevice* device = params.intra_op_threadpool;
+
+  int64_t num_tasks = 1;
+  if (device != nullptr) {
+    num_tasks = std::min({static_cast<int64_t>(device->numThreads()),
+                          batch_size_,
+                          batch_size_ * input_size_ / kMinParallelTaskSize});
+  }
+
+  if (ABSL_PREDICT_TRUE(num_tasks <= 1)) {
+    top_k(0, batch_size_);
+    return OkExecuteEvent();
+  }
+
+  // Use intra-op thread pool to compute top-k for batch rows in parallel.
+  auto event = tsl::MakeConstructedAsyncValueRef<ExecuteEvent>();
+  auto counter = std::make_shared<std::atomic<int64_t>>(num_tasks);
+
+  auto execute = [event, counter, top_k, num_tasks,
+                  batch_size = batch_size_](int64_t task_index) {
+    top_k(task_index * batch_size / num_tasks,
+          (task_index + 1) * batch_size / num_tasks);
+
+    if (counter->load() == 1 || counter->fetch_sub(1) == 1) {
+      event.SetStateConcrete();
+    }
+  };
+
+  // Launch parallel top-k tasks in the intra-op thread pool.
+  for (int64_t i = 1; i < num_tasks; ++i) {
+    device->getPool()->Schedule([i, execute] { execute(i); });
+  }
+
+  // Execute the first top-k task in the caller thread.
+  execute(0);
+
+  return event;
 }
 
 }  // namespace xla::cpu
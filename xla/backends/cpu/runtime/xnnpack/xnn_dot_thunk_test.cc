@@ -104,6 +104,50 @@ TEST_P(XnnDotThunkTest, SimpleDot) {
   EXPECT_EQ(out, LiteralUtil::CreateR2<float>({{8.0, 5.0}, {20.0, 13.0}}));
 }
 
+TEST(XnnDotThunkCaptureTest, CapturedRhsChanges) {
+  auto lhs = LiteralUtil::CreateR2<float>({{1.0, 2.0}, {3.0, 4.0}});
+  auto rhs0 = LiteralUtil::CreateR2<float>({{4.0, 3.0}, {2.0, 1.0}});
+  auto rhs1 = LiteralUtil::CreateR2<float>({{1.0, 0.0}, {0.0, 1.0}});
+  auto out = LiteralUtil::CreateR2<float>({{0.0, 0.0}, {0.0, 0.0}});
+
+  auto [lhs_alloc, rhs_alloc, out_alloc] =
+      CreateBufferAllocation(lhs, rhs0, out);
+  auto [lhs_slice, rhs_slice, out_slice] =
+      CreateBufferAllocationSlice(lhs_alloc, rhs_alloc, out_alloc);
+
+  Shape shape = ShapeUtil::MakeShape(F32, {2, 2});
+
+  DotDimensionNumbers dot_dimensions;
+  dot_dimensions.add_lhs_contracting_dimensions(1);
+  dot_dimensions.add_rhs_contracting_dimensions(0);
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto thunk, XnnDotThunk::Create(XnnDotThunk::Options{false}, {"dot"},
+                                      dot_dimensions, lhs_slice, shape,
+                                      rhs_slice, shape, out_slice, shape,
+                                      /*capture_rhs=*/true));
+
+  // Alternate between two rhs buffers: the first one is packed into the shared
+  // weights cache, the second one is packed privately by the runtime.
+  BufferAllocations allocations0 = CreateBufferAllocations(lhs, rhs0, out);
+  BufferAllocations allocations1 = CreateBufferAllocations(lhs, rhs1, out);
+
+  for (int i = 0; i < 4; ++i) {
+    bool first = i % 2 == 0;
+
+    Thunk::ExecuteParams params;
+    params.buffer_allocations = first ? &allocations0 : &allocations1;
+
+    auto execute_event = thunk->Execute(params);
+    tsl::BlockUntilReady(execute_event);
+    ASSERT_FALSE(execute_event.IsError()) << execute_event.GetError();
+
+    EXPECT_EQ(out, first ? LiteralUtil::CreateR2<float>({{8.0, 5.0},
+                                                          {20.0, 13.0}})
+                         : lhs);
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P(XnnDot, XnnDotThunkTest,
                          ::testing::Combine(::testing::ValuesIn({F32, BF16}),
                                             ::testing::Bool(),
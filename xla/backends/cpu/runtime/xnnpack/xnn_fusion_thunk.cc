@@ -18,12 +18,14 @@ limitations under the License.
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <ostream>
 #include <utility>
 #include <vector>
 
 #include "xnnpack.h"
 #include "absl/algorithm/container.h"
+#include "absl/base/thread_annotations.h"
 #include "absl/container/inlined_vector.h"
 #include "absl/functional/bind_front.h"
 #include "absl/functional/function_ref.h"
@@ -33,6 +35,7 @@ limitations under the License.
 #include "absl/status/statusor.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/types/span.h"
 #include "pthreadpool.h"
 #include "xla/backends/cpu/runtime/parallel_loop_runner.h"
@@ -203,6 +206,30 @@ void XnnFusionThunk::XnnRuntime::Destroy() {
   }
 }
 
+// XNNPACK weights cache shared by all runtimes of the fusion operation.
+//
+// Packing of the captured arguments happens when the runtime is created, and
+// without a shared cache every pooled runtime (one per concurrent execution)
+// and every runtime rebuilt after the captured arguments changed repacks the
+// same weights. The cache is populated by the first runtime that captures
+// arguments, and finalized right after that, so that packed weights never move
+// while other runtimes use them. Runtimes that capture different arguments
+// buffers pack weights privately.
+struct XnnFusionThunk::XnnWeightsCache {
+  ~XnnWeightsCache() {
+    if (weights_cache != nullptr) {
+      XNN_LOG_IF_ERROR(xnn_delete_weights_cache(weights_cache));
+    }
+  }
+
+  absl::Mutex mu;
+  xnn_weights_cache_t weights_cache ABSL_GUARDED_BY(mu) = nullptr;
+
+  // Arguments buffers captured by the runtime that populated the cache.
+  std::optional<std::vector<se::DeviceMemoryBase>> captured_arguments
+      ABSL_GUARDED_BY(mu);
+};
+
 absl::StatusOr<XnnFusionThunk::XnnRuntime> XnnFusionThunk::CreateXnnRuntime(
     const Eigen::ThreadPoolDevice* device,
     absl::Span<const se::DeviceMemoryBase> arguments_buffers) {
@@ -241,11 +268,7 @@ absl::StatusOr<XnnFusionThunk::XnnRuntime> XnnFusionThunk::CreateXnnRuntime(
         capturing_builder_(arguments_, results_, arguments_buffers));
   }
 
-  XNN_RETURN_IF_ERROR(
-      xnn_create_runtime_v4(runtime.subgraph, nullptr, runtime.workspace,
-                            runtime.threadpool, 0, &runtime.runtime));
-
-  XNN_RETURN_IF_ERROR(xnn_reshape_runtime(runtime.runtime));
+  TF_RETURN_IF_ERROR(InstantiateXnnRuntime(runtime));
 
   return {std::move(runtime)};
 }
@@ -276,12 +299,52 @@ absl::Status XnnFusionThunk::UpdateXnnRuntime(
 
   TF_ASSIGN_OR_RETURN(runtime.subgraph, capturing_builder_(arguments_, results_,
                                                            arguments_buffers));
-  XNN_RETURN_IF_ERROR(
-      xnn_create_runtime_v4(runtime.subgraph, nullptr, runtime.workspace,
-                            runtime.threadpool, 0, &runtime.runtime));
+  return InstantiateXnnRuntime(runtime);
+}
 
-  XNN_RETURN_IF_ERROR(xnn_reshape_runtime(runtime.runtime));
+absl::Status XnnFusionThunk::InstantiateXnnRuntime(XnnRuntime& runtime) {
+  auto create_runtime = [&](xnn_weights_cache_t weights_cache) {
+    return xnn_create_runtime_v4(runtime.subgraph, weights_cache,
+                                 runtime.workspace, runtime.threadpool, 0,
+                                 &runtime.runtime);
+  };
+
+  // Subgraphs that do not capture arguments have no static weights to pack.
+  if (captured_arguments_ids_.empty()) {
+    XNN_RETURN_IF_ERROR(create_runtime(nullptr));
+    XNN_RETURN_IF_ERROR(xnn_reshape_runtime(runtime.runtime));
+    return absl::OkStatus();
+  }
+
+  absl::MutexLock lock(&weights_cache_->mu);
+
+  if (!weights_cache_->captured_arguments.has_value()) {
+    // Pack captured arguments into the weights cache and finalize it, so that
+    // other runtimes can find packed weights in it.
+    VLOG(3) << absl::StreamFormat("Populate XNN weights cache for `%s`",
+                                  info().op_name);
+    if (weights_cache_->weights_cache == nullptr) {
+      XNN_RETURN_IF_ERROR(
+          xnn_create_weights_cache(&weights_cache_->weights_cache));
+    }
+    XNN_RETURN_IF_ERROR(create_runtime(weights_cache_->weights_cache));
+    XNN_RETURN_IF_ERROR(xnn_finalize_weights_cache(
+        weights_cache_->weights_cache,
+        xnn_weights_cache_finalization_kind_soft));
+    weights_cache_->captured_arguments = runtime.captured_arguments;
+
+  } else if (*weights_cache_->captured_arguments ==
+             runtime.captured_arguments) {
+    // All weights are already packed, and runtime creation is a cache lookup.
+    VLOG(3) << absl::StreamFormat("Reuse XNN weights cache for `%s`",
+                                  info().op_name);
+    XNN_RETURN_IF_ERROR(create_runtime(weights_cache_->weights_cache));
+
+  } else {
+    XNN_RETURN_IF_ERROR(create_runtime(nullptr));
+  }
 
+  XNN_RETURN_IF_ERROR(xnn_reshape_runtime(runtime.runtime));
   return absl::OkStatus();
 }
 
@@ -327,6 +390,7 @@ XnnFusionThunk::XnnFusionThunk(XnnFusionKind kind, Options options, Info info,
       arguments_(std::move(arguments)),
       results_(std::move(results)),
       builder_(std::move(builder)),
+      weights_cache_(std::make_unique<XnnWeightsCache>()),
       xnn_runtime_pool_(
           absl::bind_front(&XnnFusionThunk::CreateXnnRuntime, this)) {}
 
@@ -343,6 +407,7 @@ XnnFusionThunk::XnnFusionThunk(XnnFusionKind kind, Options options, Info info,
       capturing_builder_(std::move(capturing_builder)),
       captured_arguments_ids_(captured_arguments_ids.begin(),
                               captured_arguments_ids.end()),
+      weights_cache_(std::make_unique<XnnWeightsCache>()),
       xnn_runtime_pool_(
           absl::bind_front(&XnnFusionThunk::CreateXnnRuntime, this)) {}
 
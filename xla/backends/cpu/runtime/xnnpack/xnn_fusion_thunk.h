@@ -133,6 +133,9 @@ class XnnFusionThunk : public Thunk {
   // XNNPACK runtime instantiated for the fusion operation.
   struct XnnRuntime;
 
+  // XNNPACK weights cache shared by all runtimes of the fusion operation.
+  struct XnnWeightsCache;
+
   // Creates XnnRuntime for the fusion operation using one of the builders.
   absl::StatusOr<XnnRuntime> CreateXnnRuntime(
       const Eigen::ThreadPoolDevice* device,
@@ -144,6 +147,11 @@ class XnnFusionThunk : public Thunk {
       XnnRuntime& runtime,
       absl::Span<const se::DeviceMemoryBase> arguments_buffers);
 
+  // Instantiates XNNPACK runtime for the subgraph owned by `runtime`. Runtimes
+  // that capture the same arguments buffers share packed weights via the
+  // weights cache, so only the first of them pays the packing cost.
+  absl::Status InstantiateXnnRuntime(XnnRuntime& runtime);
+
   // Returns the list of captured arguments buffers.
   std::vector<se::DeviceMemoryBase> CaptureArguments(
       absl::Span<const se::DeviceMemoryBase> arguments_buffers);
@@ -165,6 +173,10 @@ class XnnFusionThunk : public Thunk {
   // Indices of arguments that are captured by XNNPACK subgraph by value.
   std::vector<int64_t> captured_arguments_ids_;
 
+  // Packed weights of the captured arguments. Declared before the runtime pool,
+  // because runtimes reference packed weights owned by the cache.
+  std::unique_ptr<XnnWeightsCache> weights_cache_;
+
   // XLA:CPU executable can be called concurrently from multiple threads,
   // and we need to keep a pool of XNNPACK runtimes to avoid data races.
   using XnnRuntimePool = ObjectPool<XnnRuntime, const Eigen::ThreadPoolDevice*,
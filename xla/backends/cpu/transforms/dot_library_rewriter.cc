@@ -20,6 +20,7 @@ limitations under the License.
 #include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -56,57 +57,53 @@ class DotLibraryRewriteVisitor : public DfsHloRewriteVisitor {
   // Groups possible `Dot` with elementwise instructions into a `Fusion` op
   // with kind `kCustom`.
   absl::Status HandleDot(HloInstruction* instr) override {
-    // Replace the dot with a fusion node if any library supports it.
-    for (std::unique_ptr<LibraryMatcher>& lib : libs_) {
-      TF_ASSIGN_OR_RETURN(bool op_supported, lib->IsOpSupported(instr));
-      if (op_supported) {
-        Shape fusion_shape = instr->shape();
-        PrimitiveType out_dtype = fusion_shape.element_type();
-        PrimitiveType lib_out_dtype = lib->LibraryOpOutputType(instr);
-        std::unique_ptr<HloInstruction> convert;
-        HloInstruction* fusion_root = instr;
-
-        // Add a convert node if the library op does not support the original
-        // output type.
-        bool convert_output = lib_out_dtype != out_dtype;
-        if (convert_output) {
-          instr->mutable_shape()->set_element_type(lib_out_dtype);
-          fusion_root = instr->parent()->AddInstruction(
-              HloInstruction::CreateConvert(fusion_shape, instr));
-        }
-
-        // Create a fusion with `dot` as root if we don't need output
-        // conversion. Otherwise, the fusion will have `convert` as root.
-        auto fusion = HloInstruction::CreateFusion(
-            fusion_shape, HloInstruction::FusionKind::kCustom, fusion_root,
-            absl::StrCat(lib->fusion_prefix(), "dot_"));
-
-        if (convert_output) {
-          // Convert is the root. Fuse the dot into the fusion too.
-          fusion->FuseInstruction(instr);
-
-          // `ReplaceWithNewInstruction` checks that the instruction to replace
-          // has a matching shape with the original instruction, so we set the
-          // dtype back to original.
-          instr->mutable_shape()->set_element_type(out_dtype);
-
-          // Remove the first `convert` we created in the parent computation
-          // of the fusion op.
-          TF_RETURN_IF_ERROR(instr->parent()->RemoveInstruction(fusion_root));
-        }
-
-        BackendConfig backend_config;
-        FusionBackendConfig* fusion_config =
-            backend_config.mutable_fusion_config();
-        fusion_config->set_kind(std::string(lib->fusion_kind()));
-        TF_RETURN_IF_ERROR(fusion->set_backend_config(backend_config));
-
-        return ReplaceWithNewInstruction(instr, std::move(fusion));
-      }
+    TF_ASSIGN_OR_RETURN(LibraryMatcher * lib, SelectLibrary(instr));
+    // Do nothing if no library supports or is selected for this Dot.
+    if (lib == nullptr) {
+      return absl::OkStatus();
     }
 
-    // Do nothing if no libraries support this Dot.
-    return absl::OkStatus();
+    Shape fusion_shape = instr->shape();
+    PrimitiveType out_dtype = fusion_shape.element_type();
+    PrimitiveType lib_out_dtype = lib->LibraryOpOutputType(instr);
+    std::unique_ptr<HloInstruction> convert;
+    HloInstruction* fusion_root = instr;
+
+    // Add a convert node if the library op does not support the original
+    // output type.
+    bool convert_output = lib_out_dtype != out_dtype;
+    if (convert_output) {
+      instr->mutable_shape()->set_element_type(lib_out_dtype);
+      fusion_root = instr->parent()->AddInstruction(
+          HloInstruction::CreateConvert(fusion_shape, instr));
+    }
+
+    // Create a fusion with `dot` as root if we don't need output
+    // conversion. Otherwise, the fusion will have `convert` as root.
+    auto fusion = HloInstruction::CreateFusion(
+        fusion_shape, HloInstruction::FusionKind::kCustom, fusion_root,
+        absl::StrCat(lib->fusion_prefix(), "dot_"));
+
+    if (convert_output) {
+      // Convert is the root. Fuse the dot into the fusion too.
+      fusion->FuseInstruction(instr);
+
+      // `ReplaceWithNewInstruction` checks that the instruction to replace
+      // has a matching shape with the original instruction, so we set the
+      // dtype back to original.
+      instr->mutable_shape()->set_element_type(out_dtype);
+
+      // Remove the first `convert` we created in the parent computation
+      // of the fusion op.
+      TF_RETURN_IF_ERROR(instr->parent()->RemoveInstruction(fusion_root));
+    }
+
+    BackendConfig backend_config;
+    FusionBackendConfig* fusion_config = backend_config.mutable_fusion_config();
+    fusion_config->set_kind(std::string(lib->fusion_kind()));
+    TF_RETURN_IF_ERROR(fusion->set_backend_config(backend_config));
+
+    return ReplaceWithNewInstruction(instr, std::move(fusion));
   }
 
   absl::Status DefaultAction(HloInstruction* instr) override {
@@ -116,9 +113,57 @@ class DotLibraryRewriteVisitor : public DfsHloRewriteVisitor {
   }
 
  private:
+  // Returns the library to run `dot` with, or nullptr to keep it on the
+  // default path.
+  absl::StatusOr<LibraryMatcher*> SelectLibrary(const HloInstruction* dot) {
+    std::vector<LibraryMatcher*> supported;
+    for (std::unique_ptr<LibraryMatcher>& lib : libs_) {
+      TF_ASSIGN_OR_RETURN(bool op_supported, lib->IsOpSupported(dot));
+      if (op_supported) {
+        supported.push_back(lib.get());
+      }
+    }
+    if (supported.empty() || !options_.select_library) {
+      return supported.empty() ? nullptr : supported.front();
+    }
+
+    // The choice only depends on the shapes and the dimension numbers, so
+    // select once for all dots that share them.
+    std::string key = absl::StrCat(
+        dot->shape().ToString(/*print_layout=*/true), " ",
+        dot->operand(0)->shape().ToString(/*print_layout=*/true), " ",
+        dot->operand(1)->shape().ToString(/*print_layout=*/true), " ",
+        DotDimensionNumbersToString(dot->dot_dimension_numbers()));
+    auto it = selected_kinds_.find(key);
+    if (it == selected_kinds_.end()) {
+      std::vector<absl::string_view> kinds;
+      for (LibraryMatcher* lib : supported) {
+        kinds.push_back(lib->fusion_kind());
+      }
+      TF_ASSIGN_OR_RETURN(std::string kind,
+                          options_.select_library(dot, kinds));
+      it = selected_kinds_.emplace(std::move(key), std::move(kind)).first;
+    }
+    if (it->second.empty()) {
+      return nullptr;
+    }
+    for (LibraryMatcher* lib : supported) {
+      if (lib->fusion_kind() == it->second) {
+        return lib;
+      }
+    }
+    return absl::InvalidArgumentError(absl::StrCat("Selected library ",
+                                                   it->second,
+                                                   " does not support ",
+                                                   dot->ToString()));
+  }
+
   std::vector<std::unique_ptr<LibraryMatcher>> libs_;
   const TargetMachineFeatures* target_machine_features_;
   const DotLibraryRewriterOptions options_;
+  // Fusion kinds selected by `options_.select_library`, keyed by the shapes
+  // and dimension numbers of the dots.
+  absl::flat_hash_map<std::string, std::string> selected_kinds_;
 };
 
 absl::StatusOr<bool> DotLibraryRewriter::Run(
@@ -16,18 +16,33 @@ limitations under the License.
 #ifndef XLA_BACKENDS_CPU_TRANSFORMS_DOT_LIBRARY_REWRITER_H_
 #define XLA_BACKENDS_CPU_TRANSFORMS_DOT_LIBRARY_REWRITER_H_
 
+#include <functional>
+#include <string>
+
 #include "absl/container/flat_hash_set.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "xla/backends/cpu/codegen/target_machine_features.h"
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/pass/hlo_pass_interface.h"
 
 namespace xla::cpu {
 
+// Picks the library for a dot among the fusion kinds of the libraries that
+// support it, e.g. from measurements of the CPU autotuner backends. Returns the
+// chosen fusion kind, or an empty string to keep the dot on the default Eigen
+// path.
+using DotLibrarySelector = std::function<absl::StatusOr<std::string>(
+    const HloInstruction* dot, absl::Span<const absl::string_view> kinds)>;
+
 struct DotLibraryRewriterOptions {
   bool use_onednn = false;
   bool use_xnnpack = false;
+  // If set, decides which of the supporting libraries runs each dot. Dots with
+  // the same shapes and dimension numbers are only decided once per run.
+  // Otherwise, the first supporting library is used.
+  DotLibrarySelector select_library = nullptr;
 };
 
 // Rewrites suitable Dot operations into XNNPACK fusions.
@@ -21,9 +21,11 @@ limitations under the License.
 
 #include <gtest/gtest.h>
 #include "absl/log/log.h"
+#include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_replace.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "xla/backends/cpu/codegen/target_machine_features.h"
 #include "xla/backends/cpu/codegen/target_machine_test_base.h"
 #include "xla/hlo/ir/hlo_casting_utils.h"
@@ -145,5 +147,43 @@ INSTANTIATE_TEST_SUITE_P(CpuDotLibraryTestSuite, CpuDotLibraryTest,
                          ::testing::ValuesIn(GetXnnDotRewriteTestSpecs()),
                          CpuDotLibraryTest::Name);
 
+using DotLibrarySelectorTest = TargetMachineTestBase;
+
+TEST_F(DotLibrarySelectorTest, SelectsOncePerShape) {
+  const absl::string_view hlo_text = R"(
+    HloModule matmul
+
+    ENTRY %main {
+      %input = f32[64,64]{1,0} parameter(0)
+      %weight = f32[64,1024]{1,0} parameter(1)
+      %dot0 = f32[64,1024]{1,0} dot(%input, %weight),
+              lhs_contracting_dims={1}, rhs_contracting_dims={0}
+      %dot1 = f32[64,1024]{1,0} dot(%input, %weight),
+              lhs_contracting_dims={1}, rhs_contracting_dims={0}
+      ROOT %add = f32[64,1024]{1,0} add(%dot0, %dot1)
+    })";
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(hlo_text));
+  std::unique_ptr<TargetMachineFeatures> features =
+      CreateTargetMachineFeatures(
+          /*triple_string=*/"x86_64-unknown-linux-gnu", "znver3",
+          "+avx,+avx2");
+
+  int num_selections = 0;
+  DotLibraryRewriterOptions options;
+  options.use_xnnpack = true;
+  options.select_library = [&](const HloInstruction* dot,
+                               absl::Span<const absl::string_view> kinds)
+      -> absl::StatusOr<std::string> {
+    ++num_selections;
+    EXPECT_EQ(kinds.size(), 1);
+    // Keep the dots on the default path.
+    return std::string();
+  };
+  DotLibraryRewriter rewriter(features.get(), options);
+  EXPECT_FALSE(rewriter.Run(module.get()).value());
+  EXPECT_EQ(num_selections, 1);
+}
+
 }  // namespace
 }  // namespace xla::cpu
@@ -0,0 +1,50 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/cpu/transforms/onednn_matcher.h"
+
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_opcode.h"
+
+#if XLA_ONEDNN_USE_GRAPH_API
+#include "xla/backends/cpu/onednn_fusion.h"
+#endif  // XLA_ONEDNN_USE_GRAPH_API
+
+namespace xla::cpu {
+
+absl::StatusOr<bool> OneDnnMatcher::IsOpSupported(const HloInstruction* instr) {
+#if XLA_ONEDNN_USE_GRAPH_API
+  if (instr->opcode() != HloOpcode::kDot) {
+    return false;
+  }
+  return IsOneDnnDotSupported(
+      instr->dot_dimension_numbers(), instr->operand(0)->shape(),
+      instr->operand(1)->shape(), instr->shape(), target_machine_features_);
+#else
+  return false;
+#endif  // XLA_ONEDNN_USE_GRAPH_API
+}
+
+absl::string_view OneDnnMatcher::fusion_kind() const {
+#if XLA_ONEDNN_USE_GRAPH_API
+  return kOneDnnFusionKind;
+#else
+  return "";
+#endif  // XLA_ONEDNN_USE_GRAPH_API
+}
+
+}  // namespace xla::cpu
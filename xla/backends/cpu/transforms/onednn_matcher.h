@@ -16,7 +16,10 @@ limitations under the License.
 #ifndef XLA_BACKENDS_CPU_TRANSFORMS_ONEDNN_MATCHER_H_
 #define XLA_BACKENDS_CPU_TRANSFORMS_ONEDNN_MATCHER_H_
 
+#include <string>
+
 #include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
 #include "xla/backends/cpu/codegen/target_machine_features.h"
 #include "xla/backends/cpu/transforms/library_matcher.h"
 #include "xla/hlo/ir/hlo_instruction.h"
@@ -29,10 +32,15 @@ class OneDnnMatcher : public LibraryMatcher {
       : LibraryMatcher(target_machine_features) {}
   ~OneDnnMatcher() override = default;
 
-  // Returns true if the HLO instruction is supported by the library.
-  absl::StatusOr<bool> IsOpSupported(const HloInstruction* instr) override {
-    return false;
-  }
+  // Returns true if the HLO instruction is supported by the library. Always
+  // false if XLA is built without oneDNN Graph API.
+  absl::StatusOr<bool> IsOpSupported(const HloInstruction* instr) override;
+
+  // Returns a prefix string for the fusion op's name.
+  std::string fusion_prefix() const override { return "onednn_"; }
+
+  // Returns a string for FusionBackendConfig's fusion kind.
+  absl::string_view fusion_kind() const override;
 };
 
 }  // namespace xla::cpu
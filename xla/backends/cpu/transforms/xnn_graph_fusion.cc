@@ -18,12 +18,15 @@ limitations under the License.
 #include <cstdint>
 #include <string>
 
+#include "absl/algorithm/container.h"
 #include "absl/log/check.h"
+#include "absl/status/statusor.h"
 #include "xla/backends/cpu/xnn_fusion.h"
 #include "xla/hlo/ir/hlo_casting_utils.h"
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_instructions.h"
 #include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/layout_util.h"
 #include "xla/service/cpu/backend_config.pb.h"
 #include "xla/service/instruction_fusion.h"
 #include "xla/tsl/platform/status.h"
@@ -80,7 +83,35 @@ bool XnnGraphFusion::IsOpSupported(const HloInstruction* instr) const {
     }
   }
 
-  return false;
+  // XNNPACK tensors are dense row-major arrays, so ops that move data between
+  // dimensions need the default layout on their result and operands.
+  auto has_default_layout = [](const HloInstruction* hlo) {
+    return !hlo->shape().has_layout() ||
+           LayoutUtil::IsMonotonicWithDim0Major(hlo->shape().layout());
+  };
+  if (!has_default_layout(instr) ||
+      !absl::c_all_of(instr->operands(), has_default_layout)) {
+    return false;
+  }
+
+  switch (instr->opcode()) {
+    case HloOpcode::kDot: {
+      absl::StatusOr<bool> is_supported = IsXnnDotSupported(
+          instr->dot_dimension_numbers(), instr->operand(0)->shape(),
+          instr->operand(1)->shape(), instr->shape());
+      return is_supported.ok() && *is_supported;
+    }
+    case HloOpcode::kTranspose:
+    case HloOpcode::kReshape:
+      return true;
+    case HloOpcode::kConcatenate:
+      // XNNPACK has concatenate ops for up to four inputs.
+      return instr->operand_count() >= 2 && instr->operand_count() <= 4;
+    case HloOpcode::kReduce:
+      return IsXnnReduceSupported(instr);
+    default:
+      return false;
+  }
 }
 
 bool XnnGraphFusion::IsXnnGraphFusion(const HloInstruction* instr) const {
@@ -85,5 +85,85 @@ ENTRY entry {
   ASSERT_FALSE(changed);
 }
 
+TEST_F(XnnGraphFusionTest, FusionWithDotAndReduce) {
+  std::string hlo_string = R"(
+HloModule FusionDemonstration
+
+add {
+  a = f32[] parameter(0)
+  b = f32[] parameter(1)
+  ROOT r = f32[] add(a, b)
+}
+
+ENTRY entry {
+   %input = f32[16,64] parameter(0)
+   %weight = f32[64,32] parameter(1)
+   %bias = f32[16,32] parameter(2)
+   %dot = f32[16,32] dot(%input, %weight),
+          lhs_contracting_dims={1}, rhs_contracting_dims={0}
+   %add = f32[16,32] add(%dot, %bias)
+   %transpose = f32[32,16] transpose(%add), dimensions={1,0}
+   %zero = f32[] constant(0)
+   ROOT %reduce = f32[32] reduce(%transpose, %zero), dimensions={1},
+                  to_apply=add
+}
+)";
+
+  TF_ASSERT_OK_AND_ASSIGN(auto module,
+                          ParseAndReturnVerifiedModule(hlo_string));
+  TF_ASSERT_OK_AND_ASSIGN(bool changed, XnnGraphFusion().Run(module.get()));
+  ASSERT_TRUE(changed);
+  // All instructions end up in a single fusion of the three parameters.
+  HloInstruction* root = module->entry_computation()->root_instruction();
+  EXPECT_THAT(root, op::Fusion());
+  EXPECT_EQ(root->operand_count(), 3);
+  EXPECT_EQ(module->entry_computation()->instruction_count(), 4);
+}
+
+TEST_F(XnnGraphFusionTest, FusionWithConcatenate) {
+  std::string hlo_string = R"(
+HloModule FusionDemonstration
+
+ENTRY entry {
+   %param.0 = f32[2,2] parameter(0)
+   %param.1 = f32[2,3] parameter(1)
+   %concat = f32[2,5] concatenate(%param.0, %param.1), dimensions={1}
+   ROOT %result = f32[10] reshape(%concat)
+}
+)";
+
+  TF_ASSERT_OK_AND_ASSIGN(auto module,
+                          ParseAndReturnVerifiedModule(hlo_string));
+  TF_ASSERT_OK_AND_ASSIGN(bool changed, XnnGraphFusion().Run(module.get()));
+  ASSERT_TRUE(changed);
+  HloInstruction* root = module->entry_computation()->root_instruction();
+  EXPECT_THAT(root, op::Fusion());
+  EXPECT_EQ(module->entry_computation()->instruction_count(), 3);
+}
+
+TEST_F(XnnGraphFusionTest, NoFusionOfUnsupportedReduce) {
+  std::string hlo_string = R"(
+HloModule FusionDemonstration
+
+max {
+  a = f32[] parameter(0)
+  b = f32[] parameter(1)
+  ROOT r = f32[] maximum(a, b)
+}
+
+ENTRY entry {
+   %param.0 = f32[16,32] parameter(0)
+   %init = f32[] constant(-inf)
+   ROOT %reduce = f32[16] reduce(%param.0, %init), dimensions={1},
+                  to_apply=max
+}
+)";
+
+  TF_ASSERT_OK_AND_ASSIGN(auto module,
+                          ParseAndReturnVerifiedModule(hlo_string));
+  TF_ASSERT_OK_AND_ASSIGN(bool changed, XnnGraphFusion().Run(module.get()));
+  EXPECT_FALSE(changed);
+}
+
 }  // namespace
 }  // namespace xla::cpu
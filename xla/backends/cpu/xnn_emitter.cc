@@ -229,6 +229,99 @@ static absl::StatusOr<uint32_t> DefineBatchMatMul(xnn_subgraph_t subgraph,
   return out;
 }
 
+static absl::StatusOr<uint32_t> DefineTranspose(xnn_subgraph_t subgraph,
+                                                TensorIdMap& tensor_ids,
+                                                const HloInstruction* instr) {
+  VLOG(3) << absl::StreamFormat("Define tensor value for transpose op: %s",
+                                instr->ToString());
+
+  TF_ASSIGN_OR_RETURN(auto in, FindTensorValue(tensor_ids, instr->operand(0)));
+  TF_ASSIGN_OR_RETURN(auto out, DefineTensorValue(subgraph, instr));
+
+  std::vector<size_t> perm(instr->dimensions().begin(),
+                           instr->dimensions().end());
+  XNN_RETURN_IF_ERROR(xnn_define_static_transpose(
+      subgraph, perm.size(), perm.data(), in, out, /*flags=*/0));
+
+  return out;
+}
+
+static absl::StatusOr<uint32_t> DefineReshape(xnn_subgraph_t subgraph,
+                                              TensorIdMap& tensor_ids,
+                                              const HloInstruction* instr) {
+  VLOG(3) << absl::StreamFormat("Define tensor value for reshape op: %s",
+                                instr->ToString());
+
+  TF_ASSIGN_OR_RETURN(auto in, FindTensorValue(tensor_ids, instr->operand(0)));
+  TF_ASSIGN_OR_RETURN(auto out, DefineTensorValue(subgraph, instr));
+
+  auto dims = XnnDimensions(instr->shape());
+  XNN_RETURN_IF_ERROR(xnn_define_static_reshape(
+      subgraph, dims.size(), dims.data(), in, out, /*flags=*/0));
+
+  return out;
+}
+
+static absl::StatusOr<uint32_t> DefineConcatenate(xnn_subgraph_t subgraph,
+                                                  TensorIdMap& tensor_ids,
+                                                  const HloInstruction* instr) {
+  VLOG(3) << absl::StreamFormat("Define tensor value for concatenate op: %s",
+                                instr->ToString());
+
+  std::vector<uint32_t> ins;
+  for (const HloInstruction* operand : instr->operands()) {
+    TF_ASSIGN_OR_RETURN(uint32_t in, FindTensorValue(tensor_ids, operand));
+    ins.push_back(in);
+  }
+  TF_ASSIGN_OR_RETURN(auto out, DefineTensorValue(subgraph, instr));
+
+  int64_t axis = instr->concatenate_dimension();
+  switch (ins.size()) {
+    case 2:
+      XNN_RETURN_IF_ERROR(xnn_define_concatenate2(subgraph, axis, ins[0],
+                                                  ins[1], out, /*flags=*/0));
+      break;
+    case 3:
+      XNN_RETURN_IF_ERROR(xnn_define_concatenate3(
+          subgraph, axis, ins[0], ins[1], ins[2], out, /*flags=*/0));
+      break;
+    case 4:
+      XNN_RETURN_IF_ERROR(xnn_define_concatenate4(
+          subgraph, axis, ins[0], ins[1], ins[2], ins[3], out, /*flags=*/0));
+      break;
+    default:
+      return InvalidArgument("Unsupported XNNPACK concatenate op: %s",
+                             instr->ToString());
+  }
+
+  return out;
+}
+
+static absl::StatusOr<uint32_t> DefineReduce(xnn_subgraph_t subgraph,
+                                             TensorIdMap& tensor_ids,
+                                             const HloInstruction* instr) {
+  VLOG(3) << absl::StreamFormat("Define tensor value for reduce op: %s",
+                                instr->ToString());
+
+  // XNNPACK reductions do not take an init value, so only sums starting from
+  // zero are supported (see IsXnnReduceSupported).
+  if (!IsXnnReduceSupported(instr)) {
+    return InvalidArgument("Unsupported XNNPACK reduce op: %s",
+                           instr->ToString());
+  }
+
+  TF_ASSIGN_OR_RETURN(auto in, FindTensorValue(tensor_ids, instr->operand(0)));
+  TF_ASSIGN_OR_RETURN(auto out, DefineTensorValue(subgraph, instr));
+
+  std::vector<int64_t> axes(instr->dimensions().begin(),
+                            instr->dimensions().end());
+  XNN_RETURN_IF_ERROR(xnn_define_static_reduce(subgraph, xnn_reduce_sum,
+                                               axes.size(), axes.data(), in,
+                                               out, /*flags=*/0));
+
+  return out;
+}
+
 //===----------------------------------------------------------------------===//
 // Emit XNNPACK subgraph for the given HLO computation.
 //===----------------------------------------------------------------------===//
@@ -260,24 +353,46 @@ static absl::StatusOr<xnn_subgraph_t> EmitXnnSubgraph(
                             DefineConstant(subgraph, literals, instr));
       } break;
 
-      case HloOpcode::kConvert: {
+      case HloOpcode::kDot: {
         TF_ASSIGN_OR_RETURN(tensor_ids[instr],
-                            DefineUnaryOp(subgraph, tensor_ids, instr));
+                            DefineBatchMatMul(subgraph, tensor_ids, instr));
       } break;
 
-      case HloOpcode::kAdd:
-      case HloOpcode::kSubtract:
-      case HloOpcode::kMultiply: {
+      case HloOpcode::kTranspose: {
         TF_ASSIGN_OR_RETURN(tensor_ids[instr],
-                            DefineBinaryOp(subgraph, tensor_ids, instr));
+                            DefineTranspose(subgraph, tensor_ids, instr));
       } break;
 
-      case HloOpcode::kDot: {
+      case HloOpcode::kReshape: {
         TF_ASSIGN_OR_RETURN(tensor_ids[instr],
-                            DefineBatchMatMul(subgraph, tensor_ids, instr));
+                            DefineReshape(subgraph, tensor_ids, instr));
+      } break;
+
+      case HloOpcode::kConcatenate: {
+        TF_ASSIGN_OR_RETURN(tensor_ids[instr],
+                            DefineConcatenate(subgraph, tensor_ids, instr));
+      } break;
+
+      case HloOpcode::kReduce: {
+        TF_ASSIGN_OR_RETURN(tensor_ids[instr],
+                            DefineReduce(subgraph, tensor_ids, instr));
       } break;
 
       default: {
+        // Elementwise ops with a corresponding XNNPACK unary or binary
+        // operator.
+        if (instr->IsElementwise() && instr->operand_count() == 1 &&
+            XnnUnaryOperator(instr->opcode()).ok()) {
+          TF_ASSIGN_OR_RETURN(tensor_ids[instr],
+                              DefineUnaryOp(subgraph, tensor_ids, instr));
+          break;
+        }
+        if (instr->IsElementwise() && instr->operand_count() == 2 &&
+            XnnBinaryOperator(instr->opcode()).ok()) {
+          TF_ASSIGN_OR_RETURN(tensor_ids[instr],
+                              DefineBinaryOp(subgraph, tensor_ids, instr));
+          break;
+        }
         XNN_LOG_IF_ERROR(xnn_delete_subgraph(subgraph));
         return InvalidArgument("Unsupported XNNPACK fusion instruction: %s",
                                instr->ToString());
@@ -28,6 +28,7 @@ limitations under the License.
 #include "xla/hlo/ir/hlo_computation.h"
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/literal.h"
 #include "xla/primitive_util.h"
 #include "xla/shape.h"
 #include "xla/shape_util.h"
@@ -135,6 +136,22 @@ absl::StatusOr<bool> IsXnnDotSupported(
          !dot_canonical_dims.rhs_column_major;
 }
 
+bool IsXnnReduceSupported(const HloInstruction* reduce) {
+  if (reduce->opcode() != HloOpcode::kReduce || reduce->operand_count() != 2 ||
+      !reduce->shape().IsArray()) {
+    return false;
+  }
+  const HloInstruction* init = reduce->operand(1);
+  if (!init->IsConstant() || !init->literal().IsAll(0)) {
+    return false;
+  }
+  const HloInstruction* root = reduce->to_apply()->root_instruction();
+  return root->opcode() == HloOpcode::kAdd &&
+         root->operand(0)->opcode() == HloOpcode::kParameter &&
+         root->operand(1)->opcode() == HloOpcode::kParameter &&
+         root->operand(0) != root->operand(1);
+}
+
 absl::StatusOr<xnn_datatype> XnnDatatype(const PrimitiveType& type) {
   switch (type) {
     case BF16:
@@ -42,6 +42,11 @@ absl::StatusOr<bool> IsXnnDotSupported(
     const Shape& rhs_shape, const Shape& out_shape,
     const TargetMachineFeatures* cpu_features = nullptr);
 
+// Returns true if the reduce operation is supported by XNNPACK. XNNPACK
+// reductions do not take an init value, so only single-operand sums starting
+// from a zero constant are supported.
+bool IsXnnReduceSupported(const HloInstruction* reduce);
+
 absl::StatusOr<xnn_datatype> XnnDatatype(const PrimitiveType& type);
 absl::StatusOr<xnn_unary_operator> XnnUnaryOperator(const HloOpcode& opcode);
 absl::StatusOr<xnn_binary_operator> XnnBinaryOperator(const HloOpcode& opcode);
@@ -58,7 +58,7 @@ class CudnnBackend : public GpuCodegenBackend {
  public:
   explicit CudnnBackend(const Compiler::TargetConfig* target_config,
                         const DebugOptions* debug_options, Compiler* compiler)
-      : GpuCodegenBackend("Cublas", target_config, debug_options, compiler) {}
+      : GpuCodegenBackend("Cudnn", target_config, debug_options, compiler) {}
 
   absl::StatusOr<std::vector<std::unique_ptr<BackendConfig>>>
   GetSupportedConfigs(
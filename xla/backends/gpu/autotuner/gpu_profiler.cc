@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "xla/backends/gpu/autotuner/gpu_profiler.h"
 
+#include <cstdint>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -22,6 +23,7 @@ limitations under the License.
 #include "absl/log/check.h"
 #include "absl/log/log.h"
 #include "absl/memory/memory.h"
+#include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/time/time.h"
 #include "absl/types/span.h"
@@ -109,6 +111,10 @@ absl::StatusOr<ProfileResult> GpuProfiler::ProfileInternal(
     TF_RETURN_IF_ERROR(stream_->BlockHostUntilDone());
   }
 
+  if (options_.should_flush_caches) {
+    TF_RETURN_IF_ERROR(FlushL2Cache());
+  }
+
   ExecutionProfile profile;
   profile.set_warmup_run_executed(true);
   std::vector<ExecutionInput> execution_inputs =
@@ -121,6 +127,22 @@ absl::StatusOr<ProfileResult> GpuProfiler::ProfileInternal(
   return ProfileResult{absl::Nanoseconds(profile.compute_time_ns())};
 }
 
+absl::Status GpuProfiler::FlushL2Cache() {
+  int64_t l2_cache_size =
+      stream_executor_->GetDeviceDescription().l2_cache_size();
+  if (l2_cache_size <= 0) {
+    return absl::OkStatus();
+  }
+  if (l2_flush_buffer_.is_null()) {
+    TF_ASSIGN_OR_RETURN(l2_flush_buffer_,
+                        allocator_->Allocate(stream_executor_->device_ordinal(),
+                                             l2_cache_size));
+  }
+  TF_RETURN_IF_ERROR(
+      stream_->MemZero(l2_flush_buffer_.ptr(), l2_flush_buffer_->size()));
+  return stream_->BlockHostUntilDone();
+}
+
 absl::StatusOr<ExecutionOutput> GpuProfiler::Execute(
     Executable* executable, std::vector<ExecutionInput> inputs,
     ExecutionProfile* profile) {
@@ -21,6 +21,7 @@ limitations under the License.
 #include <vector>
 
 #include "absl/log/log.h"
+#include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "xla/backends/autotuner/profiler.h"
 #include "xla/service/executable.h"
@@ -59,10 +60,16 @@ class GpuProfiler : public Profiler {
   absl::StatusOr<ProfileResult> ProfileInternal(Executable* executable,
                                                 RedzoneBuffers& buffers);
 
+  // Evicts the inputs of the next run from the L2 cache by overwriting a
+  // scratch buffer of the size of the cache.
+  absl::Status FlushL2Cache();
+
   stream_executor::StreamExecutor* stream_executor_;
   std::unique_ptr<stream_executor::DeviceMemoryAllocator> allocator_;
   std::unique_ptr<stream_executor::Stream> stream_;
   ProfileOptions options_;
+  // Lazily allocated scratch buffer used by FlushL2Cache.
+  stream_executor::OwningDeviceMemory l2_flush_buffer_;
 };
 
 }  // namespace gpu
@@ -0,0 +1,137 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/gpu/autotuner/native_emitter.h"
+
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "xla/backends/autotuner/codegen_backend.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/service/compiler.h"
+#include "xla/service/gpu/backend_configs.pb.h"
+#include "xla/service/gpu/hlo_fusion_analysis.h"
+#include "xla/service/gpu/reduction_utils.h"
+#include "xla/stream_executor/stream_executor.h"
+#include "xla/tsl/platform/statusor.h"
+
+namespace xla {
+namespace gpu {
+
+namespace {
+
+// Candidate values for the tunable emitter parameters. Vector sizes are
+// upper bounds, the emitters still pick smaller ones if the shapes require it.
+constexpr int64_t kMaxVectorSizes[] = {1, 2, 4};
+constexpr int64_t kRowReductionElementsPerThread[] = {8, 16, 32, 64};
+
+bool IsRowReduction(const HloFusionAnalysis& analysis) {
+  if (analysis.GetEmitterFusionKind() !=
+      HloFusionAnalysis::EmitterFusionKind::kReduction) {
+    return false;
+  }
+  const HloInstruction* hero = analysis.FindHeroReduction();
+  return hero != nullptr &&
+         GetReductionKindAndContiguousComponents(*hero).is_row_reduction;
+}
+
+}  // namespace
+
+absl::StatusOr<std::vector<std::unique_ptr<BackendConfig>>>
+NativeEmitterBackend::GetSupportedConfigs(
+    const HloInstruction& instr,
+    stream_executor::StreamExecutor* stream_executor) {
+  if (!IsSupported(instr)) {
+    return absl::InvalidArgumentError(
+        "NativeEmitterBackend does not support this instruction.");
+  }
+  HloFusionAnalysis analysis =
+      HloFusionAnalysis::Create(instr, target_config().device_description);
+
+  std::vector<int64_t> elements_per_thread = {0};
+  if (IsRowReduction(analysis)) {
+    elements_per_thread.assign(std::begin(kRowReductionElementsPerThread),
+                               std::end(kRowReductionElementsPerThread));
+  }
+
+  std::vector<std::unique_ptr<BackendConfig>> configs;
+  for (int64_t max_vector_size : kMaxVectorSizes) {
+    for (int64_t elements : elements_per_thread) {
+      auto config = std::make_unique<NativeEmitterBackendConfig>();
+      config->set_max_vector_size(max_vector_size);
+      if (elements > 0) {
+        config->set_row_reduction_elements_per_thread(elements);
+      }
+      configs.push_back(std::move(config));
+    }
+  }
+  return configs;
+}
+
+absl::StatusOr<std::unique_ptr<BackendConfig>>
+NativeEmitterBackend::GetDefaultConfig(const HloInstruction& instr) {
+  if (!IsSupported(instr)) {
+    return absl::InvalidArgumentError(
+        "NativeEmitterBackend does not support this instruction.");
+  }
+  // An empty config keeps the emitters' heuristics.
+  return std::make_unique<NativeEmitterBackendConfig>();
+}
+
+absl::Status NativeEmitterBackend::ApplyConfig(HloInstruction& instr,
+                                               const BackendConfig& config) {
+  if (!IsSupported(instr)) {
+    return absl::InvalidArgumentError(
+        "NativeEmitterBackend does not support this instruction.");
+  }
+  if (config.GetDescriptor() != NativeEmitterBackendConfig::GetDescriptor()) {
+    return absl::InvalidArgumentError(
+        "Invalid backend config type for NativeEmitterBackend.");
+  }
+  TF_ASSIGN_OR_RETURN(GpuBackendConfig gpu_config,
+                      instr.backend_config<GpuBackendConfig>());
+  *gpu_config.mutable_fusion_backend_config()
+       ->mutable_native_emitter_backend_config() =
+      static_cast<const NativeEmitterBackendConfig&>(config);
+  return instr.set_backend_config(gpu_config);
+}
+
+absl::StatusOr<std::unique_ptr<HloModule>> NativeEmitterBackend::RunHloPasses(
+    std::unique_ptr<HloModule> hlo_module,
+    const Compiler::CompileOptions& options) {
+  // The fusion is already formed, only the emitter parameters are tuned.
+  return hlo_module;
+}
+
+bool NativeEmitterBackend::IsSupported(const HloInstruction& instr) {
+  if (instr.opcode() != HloOpcode::kFusion) {
+    return false;
+  }
+  HloFusionAnalysis::EmitterFusionKind kind =
+      HloFusionAnalysis::Create(instr, target_config().device_description)
+          .GetEmitterFusionKind();
+  return kind == HloFusionAnalysis::EmitterFusionKind::kReduction ||
+         kind == HloFusionAnalysis::EmitterFusionKind::kTranspose;
+}
+
+}  // namespace gpu
+}  // namespace xla
@@ -0,0 +1,68 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_BACKENDS_GPU_AUTOTUNER_NATIVE_EMITTER_H_
+#define XLA_BACKENDS_GPU_AUTOTUNER_NATIVE_EMITTER_H_
+
+#include <memory>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "xla/backends/gpu/autotuner/gpu_codegen_backend.h"
+#include "xla/backends/autotuner/codegen_backend.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/service/compiler.h"
+#include "xla/xla.pb.h"
+
+namespace xla {
+
+namespace gpu {
+
+// Autotuning backend for fusions that are code generated by the native
+// reduction and transpose emitters. The tunable parameters are passed to the
+// emitters through `NativeEmitterBackendConfig` in the fusion backend config;
+// unset fields fall back to the emitters' heuristics.
+class NativeEmitterBackend : public GpuCodegenBackend {
+ public:
+  explicit NativeEmitterBackend(const Compiler::TargetConfig* target_config,
+                                const DebugOptions* debug_options,
+                                Compiler* compiler)
+      : GpuCodegenBackend("NativeEmitter", target_config, debug_options,
+                          compiler) {}
+
+  absl::StatusOr<std::vector<std::unique_ptr<BackendConfig>>>
+  GetSupportedConfigs(
+      const HloInstruction& instr,
+      stream_executor::StreamExecutor* stream_executor) override;
+  absl::StatusOr<std::unique_ptr<BackendConfig>> GetDefaultConfig(
+      const HloInstruction& instr) override;
+
+  absl::Status ApplyConfig(HloInstruction& instr,
+                           const BackendConfig& config) override;
+
+ private:
+  absl::StatusOr<std::unique_ptr<HloModule>> RunHloPasses(
+      std::unique_ptr<HloModule> hlo_module,
+      const Compiler::CompileOptions& options) override;
+
+  bool IsSupported(const HloInstruction& instr);
+};
+
+}  // namespace gpu
+}  // namespace xla
+
+#endif  // XLA_BACKENDS_GPU_AUTOTUNER_NATIVE_EMITTER_H_
@@ -0,0 +1,166 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/gpu/autotuner/native_emitter.h"
+
+#include <memory>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "xla/backends/autotuner/codegen_backend.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/testlib/hlo_hardware_independent_test_base.h"
+#include "xla/service/compiler.h"
+#include "xla/service/executable.h"
+#include "xla/service/gpu/backend_configs.pb.h"
+#include "xla/service/gpu/gpu_device_info_for_tests.h"
+#include "xla/service/gpu/nvptx_compiler.h"
+#include "xla/stream_executor/device_description.pb.h"
+#include "xla/tsl/platform/status_matchers.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/tsl/util/proto/proto_matchers.h"
+#include "xla/xla.pb.h"
+
+namespace xla {
+namespace gpu {
+namespace {
+
+using ::tsl::proto_testing::EqualsProto;
+using ::tsl::testing::IsOk;
+using ::tsl::testing::StatusIs;
+
+const char kRowReductionHlo[] = R"(
+  HloModule module
+
+  add {
+    p0 = f32[] parameter(0)
+    p1 = f32[] parameter(1)
+    ROOT add = f32[] add(p0, p1)
+  }
+
+  computation {
+    p0 = f32[1024,4096]{1,0} parameter(0)
+    c0 = f32[] constant(0)
+    ROOT reduce = f32[1024]{0} reduce(p0, c0), dimensions={1}, to_apply=add
+  }
+
+  ENTRY main {
+    p0 = f32[1024,4096]{1,0} parameter(0)
+    ROOT fusion = f32[1024]{0} fusion(p0), kind=kInput, calls=computation
+  })";
+
+const char kTransposeHlo[] = R"(
+  HloModule module
+
+  computation {
+    p0 = f32[1024,2048]{1,0} parameter(0)
+    ROOT transpose = f32[2048,1024]{1,0} transpose(p0), dimensions={1,0}
+  }
+
+  ENTRY main {
+    p0 = f32[1024,2048]{1,0} parameter(0)
+    ROOT fusion = f32[2048,1024]{1,0} fusion(p0), kind=kInput,
+        calls=computation
+  })";
+
+class NativeEmitterBackendTest : public HloHardwareIndependentTestBase {
+ protected:
+  NativeEmitterBackendTest()
+      : target_config_([]() {
+          se::GpuTargetConfigProto target_config_proto;
+          *target_config_proto.mutable_gpu_device_info() =
+              TestGpuDeviceInfo().CudaOrRocmDeviceInfo().ToGpuProto();
+          return Compiler::TargetConfig(target_config_proto);
+        }()),
+        backend_(&target_config_, &debug_options_, &compiler_) {}
+
+  DebugOptions debug_options_;
+  NVPTXCompiler compiler_;
+  Compiler::TargetConfig target_config_;
+  NativeEmitterBackend backend_;
+};
+
+TEST_F(NativeEmitterBackendTest, GetSupportedConfigsForRowReduction) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(kRowReductionHlo));
+
+  absl::StatusOr<std::vector<std::unique_ptr<BackendConfig>>> configs =
+      backend_.GetSupportedConfigs(
+          *(module->entry_computation()->root_instruction()), nullptr);
+  EXPECT_THAT(configs, IsOk());
+  // 3 vector sizes x 4 elements per thread.
+  EXPECT_EQ(configs.value().size(), 12);
+}
+
+TEST_F(NativeEmitterBackendTest, GetSupportedConfigsForTranspose) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(kTransposeHlo));
+
+  absl::StatusOr<std::vector<std::unique_ptr<BackendConfig>>> configs =
+      backend_.GetSupportedConfigs(
+          *(module->entry_computation()->root_instruction()), nullptr);
+  EXPECT_THAT(configs, IsOk());
+  EXPECT_EQ(configs.value().size(), 3);
+}
+
+TEST_F(NativeEmitterBackendTest, GetSupportedConfigsForUnsupportedInstruction) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(kRowReductionHlo));
+  HloInstruction* unsupported_instr = module->entry_computation()
+                                          ->root_instruction()
+                                          ->called_computations()[0]
+                                          ->root_instruction();
+  absl::StatusOr<std::vector<std::unique_ptr<BackendConfig>>> configs =
+      backend_.GetSupportedConfigs(*unsupported_instr, nullptr);
+  EXPECT_THAT(configs, StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST_F(NativeEmitterBackendTest, ApplyConfig) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(kRowReductionHlo));
+  HloInstruction* fusion = module->entry_computation()->root_instruction();
+  NativeEmitterBackendConfig config;
+  config.set_max_vector_size(2);
+  config.set_row_reduction_elements_per_thread(32);
+
+  EXPECT_THAT(backend_.ApplyConfig(*fusion, config), IsOk());
+  TF_ASSERT_OK_AND_ASSIGN(GpuBackendConfig gpu_config,
+                          fusion->backend_config<GpuBackendConfig>());
+  EXPECT_THAT(
+      gpu_config.fusion_backend_config().native_emitter_backend_config(),
+      EqualsProto(config));
+}
+
+TEST_F(NativeEmitterBackendTest, Compile) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(kRowReductionHlo));
+  HloInstruction* fusion = module->entry_computation()->root_instruction();
+  TF_ASSERT_OK_AND_ASSIGN(
+      std::vector<std::unique_ptr<BackendConfig>> configs,
+      backend_.GetSupportedConfigs(*fusion, nullptr));
+  for (const std::unique_ptr<BackendConfig>& config : configs) {
+    absl::StatusOr<std::unique_ptr<Executable>> executable =
+        backend_.Compile(*fusion, *config);
+    EXPECT_THAT(executable, IsOk());
+  }
+}
+
+}  // namespace
+}  // namespace gpu
+}  // namespace xla
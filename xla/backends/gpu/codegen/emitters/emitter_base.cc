@@ -300,7 +300,7 @@ absl::StatusOr<FusionEmissionResult> EmitterBase::Emit(
             }
 
             return KernelReuseCache::Entry{kernel_name, launch_dims,
-                                           std::nullopt,
+                                           cluster_dimensions(),
                                            /*shmem_bytes=*/0};
           });
   TF_ASSIGN_OR_RETURN(const KernelReuseCache::Entry* entry, status_or_entry);
@@ -17,6 +17,7 @@ limitations under the License.
 
 #include <functional>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -46,6 +47,7 @@ limitations under the License.
 #include "xla/service/gpu/hlo_fusion_analysis.h"
 #include "xla/service/gpu/ir_emitter_context.h"
 #include "xla/stream_executor/device_description.h"
+#include "xla/stream_executor/launch_dim.h"
 
 namespace xla {
 namespace gpu {
@@ -97,6 +99,12 @@ class EmitterBase : public KernelFusionInterface {
       mlir::func::FuncOp entry_function,
       const HloFusionInstruction& fusion) const = 0;
 
+  // Returns the thread block cluster the kernel has to be launched with, if
+  // any.
+  virtual std::optional<se::ClusterDim> cluster_dimensions() const {
+    return std::nullopt;
+  }
+
   // Evaluates the epilogue of the fusion. Returns the results for each epilogue
   // root.
   absl::flat_hash_map<const HloInstruction*, mlir::ValueRange> EmitEpilogue(
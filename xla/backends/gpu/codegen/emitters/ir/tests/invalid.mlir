@@ -239,3 +239,23 @@ func.func @reduce_init_type_mismatch(%in: tensor<16x8x4xf32>, %init: i32)
     : (tensor<16x8x4xf32>, i32) -> tensor<16x4xf32>
   func.return %sum : tensor<16x4xf32>
 }
+
+// -----
+
+func.func @bulk_load_unaligned_rows(%input: tensor<64x128xf32>, %offset: index)
+    -> tensor<32x33xf32> {
+  // expected-error @+1 {{rows must be 16-byte aligned}}
+  %tile = xla_gpu.bulk_load_to_shared %input[%offset]
+    row_size 32 row_stride 128 dest_row_stride 33
+    : tensor<64x128xf32> -> tensor<32x33xf32>
+  func.return %tile : tensor<32x33xf32>
+}
+
+// -----
+
+func.func @cluster_gather_wrong_results(%sum: f32) -> f32 {
+  // expected-error @+1 {{expected 2 results, got 1}}
+  %all = xla_gpu.cluster_gather(%sum) cluster_size 2 threads_per_block 128
+    : f32 -> f32
+  func.return %all : f32
+}
@@ -110,3 +110,28 @@ func.func @shuffler(%a: f32, %b: i32) -> (f32, i32) {
 // CHECK:        xla_gpu.shuffle_reduce(%[[IN1]], %[[IN2]]) to 4
 // CHECK-SAME:    combiner=@do_nothing {xla.range = [0 : index, 42 : index]}
 // CHECK-SAME:    : f32, i32
+
+// -----
+
+func.func @bulk_load_to_shared(%input: tensor<64x128xf32>, %offset: index)
+    -> tensor<32x36xf32> {
+  %tile = xla_gpu.bulk_load_to_shared %input[%offset]
+    row_size 32 row_stride 128 dest_row_stride 36
+    : tensor<64x128xf32> -> tensor<32x36xf32>
+  return %tile : tensor<32x36xf32>
+}
+// CHECK-LABEL: @bulk_load_to_shared
+// CHECK: xla_gpu.bulk_load_to_shared %{{.*}}[%{{.*}}] row_size 32
+// CHECK-SAME: row_stride 128 dest_row_stride 36
+// CHECK-SAME: : tensor<64x128xf32> -> tensor<32x36xf32>
+
+// -----
+
+func.func @cluster_gather(%sum: f32, %count: i32) -> (f32, i32) {
+  %all:4 = xla_gpu.cluster_gather(%sum, %count) cluster_size 2
+    threads_per_block 1024 : f32, i32 -> f32, i32, f32, i32
+  return %all#2, %all#3 : f32, i32
+}
+// CHECK-LABEL: @cluster_gather
+// CHECK: xla_gpu.cluster_gather(%{{.*}}, %{{.*}}) cluster_size 2
+// CHECK-SAME: threads_per_block 1024 : f32, i32 -> f32, i32, f32, i32
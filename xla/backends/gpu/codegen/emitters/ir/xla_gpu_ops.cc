@@ -81,6 +81,62 @@ void AllocateSharedOp::getAsmResultNames(
   setNameFn(getResult(), "shmem");
 }
 
+//===----------------------------------------------------------------------===//
+// BulkLoadToSharedOp
+//===----------------------------------------------------------------------===//
+
+void BulkLoadToSharedOp::getAsmResultNames(
+    llvm::function_ref<void(mlir::Value, mlir::StringRef)> setNameFn) {
+  setNameFn(getResult(), "shmem");
+}
+
+LogicalResult BulkLoadToSharedOp::verify() {
+  Type element_type = getSource().getType().getElementType();
+  if (element_type != getResult().getType().getElementType()) {
+    return emitOpError() << "source and result element types must match";
+  }
+  if (!element_type.isIntOrFloat() ||
+      element_type.getIntOrFloatBitWidth() % 8 != 0) {
+    return emitOpError() << "element type must be a byte-sized int or float";
+  }
+  if (getRowSize() <= 0 || getRowSize() > getDestRowStride()) {
+    return emitOpError() << "row_size must be in [1, dest_row_stride]";
+  }
+  if (getResult().getType().getNumElements() % getDestRowStride() != 0) {
+    return emitOpError()
+           << "result size must be a multiple of dest_row_stride";
+  }
+  int64_t element_bytes = element_type.getIntOrFloatBitWidth() / 8;
+  for (int64_t size : {getRowSize(), getRowStride(), getDestRowStride()}) {
+    if (size * element_bytes % 16 != 0) {
+      return emitOpError() << "rows must be 16-byte aligned";
+    }
+  }
+  return success();
+}
+
+//===----------------------------------------------------------------------===//
+// ClusterGatherOp
+//===----------------------------------------------------------------------===//
+
+LogicalResult ClusterGatherOp::verify() {
+  if (getClusterSize() < 1 || getThreadsPerBlock() < 1) {
+    return emitOpError()
+           << "cluster_size and threads_per_block must be positive";
+  }
+  if (getNumResults() != getNumOperands() * getClusterSize()) {
+    return emitOpError() << "expected " << getNumOperands() * getClusterSize()
+                         << " results, got " << getNumResults();
+  }
+  for (auto [index, type] : llvm::enumerate(getResultTypes())) {
+    if (type != getOperand(index % getNumOperands()).getType()) {
+      return emitOpError() << "result " << index
+                           << " does not match the type of its operand";
+    }
+  }
+  return success();
+}
+
 //===----------------------------------------------------------------------===//
 // MaterializeOp
 //===----------------------------------------------------------------------===//
@@ -0,0 +1,407 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "xla/backends/gpu/codegen/emitters/normalization.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "absl/algorithm/container.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/log/check.h"
+#include "absl/log/log.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_format.h"
+#include "absl/types/span.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/Dialect/Tensor/IR/Tensor.h"
+#include "mlir/IR/AffineExpr.h"
+#include "mlir/IR/AffineMap.h"
+#include "mlir/IR/ImplicitLocOpBuilder.h"
+#include "mlir/IR/MLIRContext.h"
+#include "mlir/IR/TypeRange.h"
+#include "mlir/IR/Value.h"
+#include "mlir/IR/ValueRange.h"
+#include "xla/backends/gpu/codegen/emitters/ir/xla_gpu_ops.h"
+#include "xla/backends/gpu/codegen/emitters/reduction_base.h"
+#include "xla/codegen/emitters/computation_partitioner.h"
+#include "xla/codegen/emitters/elemental_hlo_to_mlir.h"
+#include "xla/codegen/emitters/type_util.h"
+#include "xla/hlo/analysis/indexing_analysis.h"
+#include "xla/hlo/analysis/indexing_map.h"
+#include "xla/hlo/ir/hlo_computation.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_instructions.h"
+#include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/service/gpu/hlo_fusion_analysis.h"
+#include "xla/service/gpu/launch_dimensions.h"
+#include "xla/shape.h"
+#include "xla/shape_util.h"
+#include "xla/stream_executor/launch_dim.h"
+#include "xla/util.h"
+
+namespace xla {
+namespace gpu {
+namespace {
+
+using emitters::PartitionedComputations;
+using llvm::SmallVector;
+using mlir::AffineMap;
+using mlir::ImplicitLocOpBuilder;
+using mlir::MLIRContext;
+using mlir::Value;
+using mlir::ValueRange;
+
+using HloValueMap =
+    absl::flat_hash_map<const HloInstruction*, SmallVector<Value>>;
+
+// The maximum number of threads that work on one row. Longer rows are split
+// into several chunks per thread.
+constexpr int64_t kMaxThreadsPerRow = 512;
+
+int64_t Arity(const HloInstruction* reduction) {
+  return reduction->operand_count() / 2;
+}
+
+}  // namespace
+
+NormalizationFusion::NormalizationFusion(const HloFusionAnalysis& analysis)
+    : analysis_(analysis) {
+  const HloComputation* computation =
+      analysis.fusion_root(0).instruction().parent();
+
+  // The number of reduction passes that have to complete before an
+  // instruction can be evaluated.
+  absl::flat_hash_map<const HloInstruction*, int64_t> passes_before;
+  for (const HloInstruction* instr : computation->MakeInstructionPostOrder()) {
+    int64_t passes = 0;
+    for (const HloInstruction* operand : instr->operands()) {
+      int64_t operand_passes = passes_before[operand];
+      if (operand->opcode() == HloOpcode::kReduce) {
+        ++operand_passes;
+      }
+      passes = std::max(passes, operand_passes);
+    }
+    passes_before[instr] = passes;
+    if (instr->opcode() == HloOpcode::kReduce) {
+      if (static_cast<int64_t>(passes_.size()) <= passes) {
+        passes_.resize(passes + 1);
+      }
+      passes_[passes].push_back(instr);
+    }
+  }
+  CHECK(!passes_.empty()) << "Normalization fusions must contain a reduction";
+
+  const Shape& row_shape = passes_.front().front()->operand(0)->shape();
+  int64_t row_size = row_shape.dimensions().back();
+  int64_t num_rows = ShapeUtil::ElementsIn(row_shape) / row_size;
+  for (const auto& root : analysis.fusion_roots()) {
+    if (ShapeUtil::ElementsIn(root.shape()) == num_rows) {
+      row_roots_.push_back(&root.instruction());
+    } else {
+      CHECK_EQ(ShapeUtil::ElementsIn(root.shape()), num_rows * row_size);
+      element_roots_.push_back(&root.instruction());
+    }
+  }
+
+  vector_size_ =
+      GetVectorSizeForMlir(analysis, /*minor_dim=*/row_size, WarpSize());
+  input_shape_ = {num_rows, row_size / vector_size_, vector_size_};
+  num_threads_ =
+      std::min(kMaxThreadsPerRow, RoundUpTo(input_shape_[1], WarpSize()));
+
+  VLOG(3) << absl::StreamFormat(
+      "NormalizationFusion: %d rows of %d elements, %d passes, num_threads = "
+      "%d, vector_size = %d",
+      num_rows, row_size, passes_.size(), num_threads_, vector_size_);
+}
+
+LaunchDimensions NormalizationFusion::launch_dimensions() const {
+  return {se::BlockDim(/*x=*/input_shape_[0], /*y=*/1, /*z=*/1),
+          se::ThreadDim(/*x=*/num_threads_, /*y=*/1, /*z=*/1)};
+}
+
+IndexingMap NormalizationFusion::GetRowIndexing(MLIRContext* ctx) const {
+  auto thread_id = mlir::getAffineDimExpr(0, ctx);
+  auto block_id = mlir::getAffineDimExpr(3, ctx);
+  auto chunk = mlir::getAffineSymbolExpr(0, ctx);
+  auto vector_index = mlir::getAffineSymbolExpr(1, ctx);
+  auto vector = chunk * num_threads_ + thread_id;
+
+  IndexingMap map{
+      AffineMap::get(6, 2, {block_id, vector, vector_index}, ctx),
+      DimVarsFromGPUGrid({num_threads_, 1, 1, input_shape_[0], 1, 1}),
+      RangeVarsFromTensorSizes(
+          {CeilOfRatio(input_shape_[1], num_threads_), vector_size_}),
+      /*rt_vars=*/{}};
+  map.AddConstraint(vector, {0, input_shape_[1] - 1});
+  return map;
+}
+
+std::optional<IndexingMap> NormalizationFusion::ComputeThreadIdToOutputIndexing(
+    int64_t root_index, MLIRContext* ctx) const {
+  const auto& root = analysis_.fusion_root(root_index);
+  if (!absl::c_linear_search(element_roots_, &root.instruction())) {
+    return std::nullopt;
+  }
+  auto map =
+      GetRowIndexing(ctx) * GetBitcastMap(input_shape_, root.shape(), ctx);
+  map.Simplify();
+  return map;
+}
+
+std::optional<IndexingMap> NormalizationFusion::ComputeThreadIdToInputIndexing(
+    int64_t root_index, int64_t hero_operand_index, MLIRContext* ctx) const {
+  return std::nullopt;
+}
+
+std::vector<emitters::EpilogueSpecification> NormalizationFusion::GetEpilogues(
+    const HloFusionInstruction& fusion, MLIRContext* mlir_context) const {
+  std::vector<emitters::EpilogueSpecification> epilogues;
+  std::vector<const HloInstruction*> heroes;
+  auto add_epilogue =
+      [&](absl::Span<const HloInstruction* const> roots,
+          absl::Span<const int64_t> index_ranges) {
+        emitters::EpilogueSpecification& epilogue = epilogues.emplace_back();
+        epilogue.heroes = heroes;
+        epilogue.index_ranges.assign(index_ranges.begin(), index_ranges.end());
+        for (const HloInstruction* root : roots) {
+          if (absl::c_linear_search(epilogue.roots, root)) continue;
+          epilogue.roots.push_back(root);
+          epilogue.root_indexing.push_back(
+              GetBitcastMap(index_ranges, root->shape(), mlir_context));
+        }
+      };
+
+  // The reductions of a pass read their inputs from an epilogue of the
+  // reductions of the previous passes.
+  for (const auto& reductions : passes_) {
+    if (!heroes.empty()) {
+      std::vector<const HloInstruction*> inputs;
+      for (const HloInstruction* reduction : reductions) {
+        for (int64_t i = 0; i < Arity(reduction); ++i) {
+          inputs.push_back(reduction->operand(i));
+        }
+      }
+      add_epilogue(inputs, input_shape_);
+    }
+    heroes.insert(heroes.end(), reductions.begin(), reductions.end());
+  }
+
+  add_epilogue(element_roots_, input_shape_);
+  if (!row_roots_.empty()) {
+    add_epilogue(row_roots_, {input_shape_[0]});
+  }
+  return epilogues;
+}
+
+absl::Status NormalizationFusion::EmitEntryFunction(
+    const PartitionedComputations& computations,
+    const emitters::CallTargetProvider& call_targets,
+    mlir::func::FuncOp entry_function,
+    const HloFusionInstruction& fusion) const {
+  ImplicitLocOpBuilder b(entry_function.getLoc(), entry_function);
+  b.setInsertionPointToStart(entry_function.addEntryBlock());
+  MLIRContext* ctx = b.getContext();
+  const auto& computation = computations.FindPartitionedComputation(
+      fusion.fused_instructions_computation());
+  auto thread_and_block_ids = EmitThreadAndBlockIds(b);
+  Value thread_id = thread_and_block_ids[0];
+  Value block_id = thread_and_block_ids[3];
+  IndexingMap row_indexing = GetRowIndexing(ctx);
+
+  auto get_reducer = [&](const HloInstruction* reduction) {
+    return call_targets(
+        reduction->called_computations()[0]->root_instruction());
+  };
+
+  // (thread ID) -> (warp ID) map for the first lane of each warp.
+  auto thread_x = mlir::getAffineDimExpr(0, ctx);
+  IndexingMap warp_indexing{
+      AffineMap::get(1, 0, thread_x.floorDiv(WarpSize())),
+      DimVarsFromTensorSizes({num_threads_}), /*range_vars=*/{},
+      /*rt_vars=*/{}};
+  warp_indexing.AddConstraint(thread_x % WarpSize(), {0, 0});
+  // ()[warp ID] -> (warp ID) map for combining the results of the warps.
+  IndexingMap warps_loop{
+      AffineMap::get(0, 1, mlir::getAffineSymbolExpr(0, ctx)),
+      /*dimensions=*/{}, RangeVarsFromTensorSizes({NumWarps()}),
+      /*rt_vars=*/{}};
+
+  // The reduced values of the current row, available in all threads.
+  HloValueMap reduced;
+  for (auto [pass, reductions] : llvm::enumerate(passes_)) {
+    SmallVector<Value> inits;
+    absl::flat_hash_map<const HloInstruction*, int64_t> starts;
+    for (const HloInstruction* reduction : reductions) {
+      starts[reduction] = inits.size();
+      llvm::append_range(
+          inits, ProvideParameterRange(computation, reduction, Arity(reduction),
+                                       Arity(reduction), {}, call_targets,
+                                       entry_function, b));
+    }
+
+    // Reduce the elements of the row that are assigned to each thread.
+    auto body = [&, pass = pass, &reductions = reductions](
+                    ImplicitLocOpBuilder& nested_b, ValueRange symbol_values,
+                    ValueRange map_results,
+                    ValueRange iter_args) -> SmallVector<Value> {
+      absl::flat_hash_map<const HloInstruction*, ValueRange> inputs;
+      if (pass > 0) {
+        inputs = EmitEpilogue(pass - 1, computations, entry_function, reduced,
+                              map_results, nested_b);
+      }
+      SmallVector<Value> results = iter_args;
+      for (const HloInstruction* reduction : reductions) {
+        int64_t start = starts[reduction];
+        SmallVector<Value> args = iter_args.slice(start, Arity(reduction));
+        if (pass == 0) {
+          auto indices = emitters::ApplyIndexing(
+              GetBitcastMap(input_shape_, reduction->operand(0)->shape(), ctx),
+              map_results, {}, nested_b);
+          llvm::append_range(
+              args, ProvideParameterRange(computation, reduction, 0,
+                                          Arity(reduction), indices,
+                                          call_targets, entry_function,
+                                          nested_b));
+        } else {
+          for (int64_t i = 0; i < Arity(reduction); ++i) {
+            llvm::append_range(args, inputs.at(reduction->operand(i)));
+          }
+        }
+        absl::c_copy(
+            nested_b.create<PureCallOp>(get_reducer(reduction), args)
+                .getResults(),
+            results.begin() + start);
+      }
+      return results;
+    };
+    ValueRange per_thread = emitters::EmitXlaLoopOp(
+        b, thread_and_block_ids, inits, row_indexing, body);
+
+    // Reduce within each warp, and write the result of the first lane of each
+    // warp to shared memory.
+    Value is_first_lane =
+        emitters::CheckConstraints(warp_indexing, thread_id, {}, b);
+    auto warp_id = emitters::ApplyIndexing(warp_indexing, thread_id, {}, b);
+    SmallVector<Value> tiles;
+    for (const HloInstruction* reduction : reductions) {
+      int64_t start = starts[reduction];
+      auto warp_results =
+          b.create<ShuffleReduceOp>(get_reducer(reduction),
+                                    per_thread.slice(start, Arity(reduction)),
+                                    WarpSize() / 2)
+              .getResults();
+      for (auto [i, value] : llvm::enumerate(warp_results)) {
+        auto tile_shape = ShapeUtil::MakeShapeWithDescendingLayout(
+            reduction->operand(i)->shape().element_type(), {NumWarps()});
+        Value tile = b.create<AllocateSharedOp>(
+            emitters::TensorShapeToMlirType(tile_shape, b));
+        tiles.push_back(
+            b.create<PredicatedInsertOp>(is_first_lane, value, tile, warp_id));
+      }
+    }
+    auto synced_tiles =
+        b.create<SyncThreadsOp>(mlir::TypeRange(tiles), tiles).getResults();
+
+    // Every thread combines the results of all warps, so the reduced values
+    // are uniform across the block.
+    ValueRange block_results = emitters::EmitLoopNest(
+        b, {}, inits, warps_loop,
+        [&](ValueRange iter_args, ValueRange dim_values,
+            ValueRange symbol_values) -> SmallVector<Value> {
+          SmallVector<Value> results = iter_args;
+          for (const HloInstruction* reduction : reductions) {
+            int64_t start = starts[reduction];
+            SmallVector<Value> args = iter_args.slice(start, Arity(reduction));
+            for (int64_t i = 0; i < Arity(reduction); ++i) {
+              args.push_back(b.create<mlir::tensor::ExtractOp>(
+                  synced_tiles[start + i], symbol_values));
+            }
+            absl::c_copy(
+                b.create<PureCallOp>(get_reducer(reduction), args).getResults(),
+                results.begin() + start);
+          }
+          return results;
+        });
+    for (const HloInstruction* reduction : reductions) {
+      reduced[reduction] = llvm::to_vector(
+          block_results.slice(starts[reduction], Arity(reduction)));
+    }
+  }
+
+  absl::flat_hash_map<const HloInstruction*, int64_t> output_indices;
+  for (auto [index, root] : llvm::enumerate(analysis_.fusion_roots())) {
+    output_indices[&root.instruction()] = index;
+  }
+  SmallVector<Value> outputs = llvm::to_vector(
+      entry_function.getArguments().drop_front(
+          fusion.fused_parameters().size()));
+
+  // Write the elementwise outputs.
+  int64_t element_epilogue_index = passes_.size() - 1;
+  const auto& element_epilogue =
+      computations.epilogues()[element_epilogue_index];
+  if (!element_epilogue.roots.empty()) {
+    auto body = [&](ImplicitLocOpBuilder& nested_b, ValueRange symbol_values,
+                    ValueRange map_results,
+                    ValueRange iter_args) -> SmallVector<Value> {
+      auto values = EmitEpilogue(element_epilogue_index, computations,
+                                 entry_function, reduced, map_results,
+                                 nested_b);
+      SmallVector<Value> results = iter_args;
+      for (auto [root, indexing] : llvm::zip(element_epilogue.roots,
+                                             element_epilogue.root_indexing)) {
+        auto indices =
+            emitters::ApplyIndexing(indexing, map_results, {}, nested_b);
+        Value& output = results[output_indices.at(root)];
+        output = nested_b.create<mlir::tensor::InsertOp>(
+            values.at(root).front(), output, indices);
+      }
+      return results;
+    };
+    outputs = llvm::to_vector(emitters::EmitXlaLoopOp(
+        b, thread_and_block_ids, outputs, row_indexing, body));
+  }
+
+  // The first thread of the block writes the outputs with one element per row.
+  if (!row_roots_.empty()) {
+    int64_t row_epilogue_index = element_epilogue_index + 1;
+    const auto& row_epilogue = computations.epilogues()[row_epilogue_index];
+    auto values = EmitEpilogue(row_epilogue_index, computations,
+                               entry_function, reduced, block_id, b);
+    Value is_first_thread = b.create<mlir::arith::CmpIOp>(
+        mlir::arith::CmpIPredicate::eq, thread_id,
+        b.create<mlir::arith::ConstantIndexOp>(0));
+    for (auto [root, indexing] :
+         llvm::zip(row_epilogue.roots, row_epilogue.root_indexing)) {
+      auto indices = emitters::ApplyIndexing(indexing, block_id, {}, b);
+      Value& output = outputs[output_indices.at(root)];
+      output = b.create<PredicatedInsertOp>(is_first_thread,
+                                            values.at(root).front(), output,
+                                            indices);
+    }
+  }
+
+  b.create<mlir::func::ReturnOp>(outputs);
+  return absl::OkStatus();
+}
+
+}  // namespace gpu
+}  // namespace xla
@@ -0,0 +1,102 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef XLA_BACKENDS_GPU_CODEGEN_EMITTERS_NORMALIZATION_H_
+#define XLA_BACKENDS_GPU_CODEGEN_EMITTERS_NORMALIZATION_H_
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "absl/container/inlined_vector.h"
+#include "absl/status/status.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/IR/MLIRContext.h"
+#include "xla/backends/gpu/codegen/emitters/emitter_base.h"
+#include "xla/codegen/emitters/computation_partitioner.h"
+#include "xla/hlo/analysis/indexing_map.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_instructions.h"
+#include "xla/service/gpu/hlo_fusion_analysis.h"
+#include "xla/service/gpu/ir_emission_utils.h"
+#include "xla/service/gpu/launch_dimensions.h"
+
+namespace xla {
+namespace gpu {
+
+// Normalization fusion, e.g. RMSNorm or LayerNorm. The fusion computes
+// elementwise outputs of shape [..., n] from the inputs and from reductions
+// over the minor dimension of size n, such as the mean and the variance of
+// each row. Such fusions are created by NormalizationFusionRewriter.
+//
+// Each row is processed by one block. The reductions are grouped into passes:
+// the reductions of a pass only depend on the reductions of earlier passes,
+// e.g. the variance of LayerNorm depends on the mean. For each pass, the block
+// reads the row, reduces it and shares the reduced values with all of its
+// threads through shared memory. After the last pass, the block reads the row
+// once more and writes the outputs. The later passes mostly hit the row in the
+// cache, since the block touched it just before.
+class NormalizationFusion : public EmitterBase {
+ public:
+  explicit NormalizationFusion(const HloFusionAnalysis& analysis);
+
+  LaunchDimensions launch_dimensions() const override;
+
+  std::optional<IndexingMap> ComputeThreadIdToOutputIndexing(
+      int64_t root_index, mlir::MLIRContext* ctx) const override;
+
+  std::optional<IndexingMap> ComputeThreadIdToInputIndexing(
+      int64_t root_index, int64_t hero_operand_index,
+      mlir::MLIRContext* ctx) const override;
+
+ protected:
+  absl::Status EmitEntryFunction(
+      const emitters::PartitionedComputations& computations,
+      const emitters::CallTargetProvider& call_targets,
+      mlir::func::FuncOp entry_function,
+      const HloFusionInstruction& fusion) const override;
+
+  std::vector<emitters::EpilogueSpecification> GetEpilogues(
+      const HloFusionInstruction& fusion,
+      mlir::MLIRContext* mlir_context) const override;
+
+ private:
+  // Returns the (thread ID, block ID)[chunk, vector index] -> (row, vector,
+  // vector index) map of the elements of a row that are read by each thread.
+  IndexingMap GetRowIndexing(mlir::MLIRContext* ctx) const;
+
+  int64_t WarpSize() const {
+    return ::xla::gpu::WarpSize(analysis_.device_info());
+  }
+  int64_t NumWarps() const { return num_threads_ / WarpSize(); }
+
+  const HloFusionAnalysis& analysis_;
+
+  // The reductions of each pass.
+  std::vector<std::vector<const HloInstruction*>> passes_;
+  // The roots with one element per element of the input rows.
+  std::vector<const HloInstruction*> element_roots_;
+  // The roots with one element per row, e.g. the mean.
+  std::vector<const HloInstruction*> row_roots_;
+
+  // The rows in the projected shape [rows, n / vector size, vector size].
+  absl::InlinedVector<int64_t, 3> input_shape_;
+  int64_t num_threads_;
+  int64_t vector_size_;
+};
+
+}  // namespace gpu
+}  // namespace xla
+
+#endif  // XLA_BACKENDS_GPU_CODEGEN_EMITTERS_NORMALIZATION_H_
@@ -60,6 +60,7 @@ limitations under the License.
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_instructions.h"
 #include "xla/hlo/utils/hlo_traversal.h"
+#include "xla/service/gpu/backend_configs.pb.h"
 #include "xla/service/gpu/hlo_fusion_analysis.h"
 #include "xla/service/gpu/ir_emission_utils.h"
 #include "xla/service/gpu/launch_dimensions.h"
@@ -154,6 +155,12 @@ struct ReductionFusion::EmitterState {
     return ShuffleReduce(reductions, per_thread_values, owner.WarpSize() / 2);
   }
 
+  // Combines the values of each thread with the ones of the threads with the
+  // same ID in the other blocks of the cluster, in the order of the block
+  // ranks.
+  HloValueMap ClusterReduce(absl::Span<const HloInstruction* const> reductions,
+                            const HloValueMap& values);
+
   mlir::ValueRange FusionOutputs() {
     return entry_function.getArguments().drop_front(
         fusion.fused_parameters().size());
@@ -330,6 +337,36 @@ HloValueMap ReductionFusion::EmitterState::ShuffleReduce(
   return results;
 }
 
+HloValueMap ReductionFusion::EmitterState::ClusterReduce(
+    absl::Span<const HloInstruction* const> reductions,
+    const HloValueMap& values) {
+  SmallVector<Value> operands;
+  for (auto* hero : reductions) {
+    operands.append(values.at(hero).begin(), values.at(hero).end());
+  }
+  auto gathered = builder
+                      .create<ClusterGatherOp>(operands, owner.cluster_size_,
+                                               Product(owner.num_threads_))
+                      .getResults();
+  HloValueMap results;
+  int64_t offset = 0;
+  for (auto* hero : reductions) {
+    int64_t arity = values.at(hero).size();
+    auto accumulator =
+        llvm::to_vector_of<Value>(gathered.slice(offset, arity));
+    for (int64_t rank = 1; rank < owner.cluster_size_; ++rank) {
+      SmallVector<Value> args = accumulator;
+      llvm::append_range(
+          args, gathered.slice(rank * operands.size() + offset, arity));
+      accumulator = llvm::to_vector_of<Value>(
+          builder.create<PureCallOp>(GetReducer(hero), args).getResults());
+    }
+    results[hero] = std::move(accumulator);
+    offset += arity;
+  }
+  return results;
+}
+
 mlir::ValueRange ReductionFusion::EmitterState::ReduceViaSharedMemory(
     int group_id, const PerThreadOutputs& per_thread, const HloValueMap& inits,
     std::optional<int> padding, int max_dist) {
@@ -371,6 +408,9 @@ mlir::ValueRange ReductionFusion::EmitterState::ReduceViaSharedMemory(
           }
         }
         auto reduced = ShuffleReduce(reductions, reduce_args, max_dist);
+        if (owner.cluster_size_ > 1) {
+          reduced = ClusterReduce(reductions, reduced);
+        }
         return owner.EvaluateEpilogue(reduced, outputs, *this, group_id,
                                       symbol_values);
       });
@@ -449,6 +489,13 @@ LaunchDimensions ReductionFusion::launch_dimensions() const {
                         /*y=*/1, /*z=*/1)};
 }
 
+std::optional<se::ClusterDim> ReductionFusion::cluster_dimensions() const {
+  if (cluster_size_ == 1) {
+    return std::nullopt;
+  }
+  return se::ClusterDim(/*x=*/cluster_size_, /*y=*/1, /*z=*/1);
+}
+
 std::vector<emitters::EpilogueSpecification> ReductionFusion::GetEpilogues(
     const HloFusionInstruction& fusion, MLIRContext* mlir_context) const {
   std::vector<emitters::EpilogueSpecification> epilogues;
@@ -791,7 +838,14 @@ RowReductionFusion::RowReductionFusion(const HloFusionAnalysis& analysis)
     : ReductionFusion(analysis) {
   CHECK(reduction_dimensions_.is_row_reduction);
   Vector3 shape = reduction_dimensions_.dimensions;
-  int64_t kMinorReducedElementsPerThread = 8;
+  // The autotuner may override the number of elements per thread, the loop
+  // below doubles it before its first use.
+  int64_t elements_per_thread = analysis.fusion_backend_config()
+                                    .native_emitter_backend_config()
+                                    .row_reduction_elements_per_thread();
+  int64_t kMinorReducedElementsPerThread =
+      elements_per_thread > 0 ? std::max<int64_t>(elements_per_thread / 2, 1)
+                              : 8;
 
   do {
     kMinorReducedElementsPerThread *= 2;
@@ -851,14 +905,30 @@ RowReductionFusion::RowReductionFusion(const HloFusionAnalysis& analysis)
            ((Product(num_blocks_) * Product(num_threads_)) >
             std::numeric_limits<uint32_t>::max()));
 
+  // Rows that are too long for a single block are reduced by a cluster of
+  // blocks, each of which handles a contiguous part of the row.
+  cluster_size_ =
+      RowReductionClusterSize(reduction_dimensions_, analysis.device_info());
+  if (cluster_size_ > 1) {
+    int vector_size = GetVectorSizeForMlir(analysis, /*minor_dim=*/shape.back(),
+                                           MinThreadsXRowReduction());
+    num_threads_ = {1, MinThreadsXRowReduction()};
+    input_shape_ = {shape[0], shape[1], shape[2] / vector_size, vector_size};
+    int64_t minor_reduced_tile_size =
+        CeilOfRatio(input_shape_[2], num_threads_[1] * cluster_size_);
+    tile_sizes_per_thread_ = {shape[0], minor_reduced_tile_size, vector_size};
+    tile_sizes_per_block_ = {1, minor_reduced_tile_size * num_threads_[1]};
+    num_blocks_ = {input_shape_[1], cluster_size_};
+  }
+
   VLOG(3) << absl::StrFormat(
       "RowReductionFusion::RowReductionFusion selected parameters: num_threads "
       "= [%s], tile_sizes_per_thread = [%s], tile_sizes_per_block = [%s], "
-      "num_blocks = [%s]",
+      "num_blocks = [%s], cluster_size = %d",
       absl::StrJoin(num_threads_, ","),
       absl::StrJoin(tile_sizes_per_thread_, ","),
       absl::StrJoin(tile_sizes_per_block_, ","),
-      absl::StrJoin(num_blocks_, ","));
+      absl::StrJoin(num_blocks_, ","), cluster_size_);
 }
 
 IndexingMap RowReductionFusion::ComputeReductionInputIndexing(
@@ -895,6 +965,10 @@ IndexingMap RowReductionFusion::ComputeReductionOutputIndexing(
   IndexingMap projected_index =
       GetIndexingMap(block_id[0] * tile_sizes_per_block_[0] + thread_id[0]);
   projected_index.AddConstraint(thread_id[1], {0, 0});
+  if (cluster_size_ > 1) {
+    // Only the first block of the cluster writes the result.
+    projected_index.AddConstraint(block_id[1], {0, 0});
+  }
   return projected_index;
 }
 
@@ -41,6 +41,7 @@ limitations under the License.
 #include "xla/service/gpu/launch_dimensions.h"
 #include "xla/service/gpu/reduction_utils.h"
 #include "xla/shape.h"
+#include "xla/stream_executor/launch_dim.h"
 
 namespace xla {
 namespace gpu {
@@ -125,6 +126,8 @@ class ReductionFusion : public EmitterBase {
     return ::xla::gpu::WarpSize(analysis_.device_info());
   }
 
+  std::optional<se::ClusterDim> cluster_dimensions() const override;
+
   // The reduction heroes for each reduction group.
   std::vector<std::vector<const HloInstruction*>> reduction_heroes_;
   // The roots that have reduction heroes for each reduction group.
@@ -142,6 +145,11 @@ class ReductionFusion : public EmitterBase {
   absl::InlinedVector<int64_t, 4> num_threads_;
   absl::InlinedVector<int64_t, 4> num_blocks_;
   int64_t vector_size_ = 1;
+  // The number of blocks in a thread block cluster that reduce one row
+  // together. If greater than 1, the blocks of a cluster combine their partial
+  // results through distributed shared memory and the first block writes the
+  // output.
+  int64_t cluster_size_ = 1;
 
   ReductionDimensions reduction_dimensions_;
   ReductionGroups groups_;
@@ -35,6 +35,7 @@ limitations under the License.
 #include "xla/hlo/utils/hlo_query.h"
 #include "xla/hlo/utils/hlo_traversal.h"
 #include "xla/primitive_util.h"
+#include "xla/service/gpu/backend_configs.pb.h"
 #include "xla/service/gpu/gpu_fusible.h"
 #include "xla/service/gpu/hlo_fusion_analysis.h"
 #include "xla/service/gpu/ir_emission_utils.h"
@@ -48,7 +49,9 @@ limitations under the License.
 namespace xla {
 namespace gpu {
 
-int GetVectorSizeForMlir(const HloFusionAnalysis& analysis, int64_t minor_dim,
+namespace {
+
+int GetDefaultVectorSize(const HloFusionAnalysis& analysis, int64_t minor_dim,
                          int num_threads) {
   // If the minor dimension is not divisible by 2, we can't currently vectorize.
   if (minor_dim % 2 != 0) {
@@ -83,6 +86,22 @@ int GetVectorSizeForMlir(const HloFusionAnalysis& analysis, int64_t minor_dim,
   return minor_dim % 4 == 0 ? 4 : 2;
 }
 
+}  // namespace
+
+int GetVectorSizeForMlir(const HloFusionAnalysis& analysis, int64_t minor_dim,
+                         int num_threads) {
+  int vector_size = GetDefaultVectorSize(analysis, minor_dim, num_threads);
+  // The autotuner may restrict the vector size. Halving keeps the minor
+  // dimension divisible by the vector size.
+  int64_t max_vector_size = analysis.fusion_backend_config()
+                                .native_emitter_backend_config()
+                                .max_vector_size();
+  while (max_vector_size > 0 && vector_size > max_vector_size) {
+    vector_size /= 2;
+  }
+  return vector_size;
+}
+
 ReductionGroups GroupDisjointReductions(const HloFusionAnalysis& analysis) {
   const int num_fusion_outputs = analysis.fusion_root_count();
 
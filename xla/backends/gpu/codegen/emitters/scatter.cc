@@ -58,15 +58,18 @@ limitations under the License.
 #include "xla/hlo/ir/hlo_casting_utils.h"
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_instructions.h"
+#include "xla/hlo/ir/hlo_module.h"
 #include "xla/primitive_util.h"
 #include "xla/service/gpu/gpu_fusible.h"
 #include "xla/service/gpu/hlo_fusion_analysis.h"
 #include "xla/service/gpu/ir_emission_utils.h"
 #include "xla/service/gpu/launch_dimensions.h"
 #include "xla/service/scatter_simplifier.h"
+#include "xla/service/scatter_utils.h"
 #include "xla/shape.h"
 #include "xla/stream_executor/device_description.h"
 #include "xla/util.h"
+#include "xla/xla.pb.h"
 #include "xla/xla_data.pb.h"
 
 namespace xla {
@@ -222,8 +225,9 @@ class EmitterHelper {
   EmitterHelper(const ScatterDescription& description,
                 const PartitionedComputations* computations,
                 const CallTargetProvider* call_targets, FuncOp entry_function,
-                const HloFusionInstruction& fusion)
+                const HloFusionInstruction& fusion, bool use_atomics)
       : description_(&description),
+        use_atomics_(use_atomics),
         entry_function_(entry_function),
         call_targets_(call_targets),
         root_computation_(&computations->FindPartitionedComputation(
@@ -270,6 +274,8 @@ class EmitterHelper {
                    ValueRange indices) const;
 
   const ScatterDescription* description_;
+  // If false, every output element is written by a single thread.
+  bool use_atomics_;
   FuncOp entry_function_;
   const emitters::CallTargetProvider* call_targets_;
   const emitters::PartitionedComputation* root_computation_;
@@ -299,7 +305,7 @@ Value EmitterHelper::EmitScatterComputation(ImplicitLocOpBuilder& b,
                                             Value update_elem,
                                             Value output_tensor) const {
   FuncOp reducer = GetReducer();
-  if (description_->scatter->unique_indices()) {
+  if (!use_atomics_) {
     auto operand_elem = GetOperandElement(b, indices);
     auto reduced_val = emitters::InlineBlock(b, reducer.getBody().front(),
                                              {operand_elem, update_elem})[0];
@@ -448,7 +454,7 @@ absl::Status ScatterFusion::EmitEntryFunction(
     const CallTargetProvider& call_targets, FuncOp entry_function,
     const HloFusionInstruction& fusion) const {
   EmitterHelper helper(description_, &computations, &call_targets,
-                       entry_function, fusion);
+                       entry_function, fusion, RequiresAtomicWrites());
 
   // Prepare the entry function.
   ImplicitLocOpBuilder b(entry_function.getLoc(), entry_function);
@@ -548,11 +554,13 @@ absl::Status ScatterWithDistributedUpdates::EmitEntryFunctionImpl(
 ScatterWithDistributedIndices::ScatterWithDistributedIndices(
     const HloFusionAnalysis& analysis, const ScatterDescription& description,
     int64_t vector_size, int64_t num_warps_per_slice,
-    int64_t num_indices_per_warp, int64_t indices_vector_size)
+    int64_t num_indices_per_warp, int64_t indices_vector_size,
+    bool deterministic)
     : ScatterFusion(analysis, description, vector_size),
       num_warps_per_slice_(num_warps_per_slice),
       num_indices_per_warp_(num_indices_per_warp),
-      indices_vector_size_(indices_vector_size) {
+      indices_vector_size_(indices_vector_size),
+      deterministic_(deterministic) {
   num_warps_ = kNumWarpsPerBlock;
   num_blocks_ = CeilOfRatio(description.num_slices * num_warps_per_slice_,
                             num_indices_per_warp_ * num_warps_);
@@ -637,6 +645,50 @@ void ScatterWithDistributedIndices::ComputeIndexing(
   }
 }
 
+IndexingMap ScatterWithDistributedIndices::ComputeSliceIndexing(
+    MLIRContext* ctx) const {
+  auto thread_x = getAffineDimExpr(
+      KernelFusionInterface::kIndexingMapThreadIdxDims[0], ctx);
+  auto block_x =
+      getAffineDimExpr(KernelFusionInterface::kIndexingMapBlockIdxDims[0], ctx);
+  auto warp_id = thread_x.floorDiv(warp_size_);
+  auto warp_id_in_slice =
+      (block_x * num_warps_ + warp_id) % num_warps_per_slice_;
+  auto lane_id = thread_x % warp_size_;
+  auto index_id = getAffineDimExpr(6, ctx);
+  auto update_dim_loop = getAffineSymbolExpr(0, ctx);
+  auto vector_id = getAffineSymbolExpr(1, ctx);
+  auto num_elements_per_slice = Product(description_.slice_shape);
+
+  auto linear_slice_index =
+      warp_id_in_slice * warp_size_ * vector_size_ +
+      update_dim_loop * vector_size_ * warp_size_ * num_warps_per_slice_ +
+      lane_id * vector_size_ + vector_id;
+
+  SmallVector<AffineExpr, 4> slice_indexing = {index_id};
+  slice_indexing.append(
+      DelinearizeInBoundsIndex(linear_slice_index, description_.slice_shape));
+
+  auto dim_vars =
+      DimVarsFromGPUGrid({num_warps_ * warp_size_, 1, 1, num_blocks_, 1, 1});
+  dim_vars.push_back(
+      IndexingMap::Variable{{0, description_.num_slices - 1}, "index_id"});
+  IndexingMap slice_map{
+      AffineMap::get(7, 2, slice_indexing, ctx),
+      dim_vars,
+      {IndexingMap::Variable{
+           {0, CeilOfRatio(num_elements_per_slice,
+                           num_warps_per_slice_ * warp_size_ * vector_size_) -
+                   1},
+           "update_loop"},
+       IndexingMap::Variable{{0, vector_size_ - 1}, "vector_id"}},
+      /*rt_vars=*/{},
+      {std::make_pair(linear_slice_index,
+                      Interval{0, num_elements_per_slice - 1})}};
+  slice_map.Simplify();
+  return slice_map;
+}
+
 Value ScatterWithDistributedIndices::InitializeAccumulator(
     ImplicitLocOpBuilder& b) const {
   auto elem_type = emitters::PrimitiveTypeToMlirType(description_.elem_type, b);
@@ -662,7 +714,7 @@ absl::Status ScatterWithDistributedIndices::EmitEntryFunctionImpl(
                  << "num_indices_per_warp: " << num_indices_per_warp_ << "\n"
                  << "indices_vector_size: " << indices_vector_size_ << "\n";
   }
-  if (num_indices_per_warp_ == 1) {
+  if (num_indices_per_warp_ == 1 && !deterministic_) {
     EmitNaiveImplementation(b, description_, helper, updates_map, indices_map,
                             thread_and_block_ids, output_tensor);
     return absl::OkStatus();
@@ -686,8 +738,32 @@ absl::Status ScatterWithDistributedIndices::EmitEntryFunctionImpl(
   // [index_changed, is_inbounds, index_0,  ..., accumulator].
   Value is_inbounds_init = b.create<arith::ConstantIntOp>(0, b.getI1Type());
   Value slice_id_init = b.create<arith::ConstantIndexOp>(0);
-  std::vector<Value> indices_init(description_.index_vector_length,
+  SmallVector<Value> indices_init(description_.index_vector_length,
                                   b.create<arith::ConstantIndexOp>(-1));
+  Value warp_start;
+  if (deterministic_) {
+    // Start with the offsets of the last index of the previous warp, so that
+    // the updates continuing its run are skipped: they are accumulated by the
+    // previous warp.
+    Value zero = b.create<arith::ConstantIndexOp>(0);
+    warp_start = emitters::ApplyIndexing(thread_id_to_update_id_map,
+                                         thread_and_block_ids, {zero, zero}, b)
+                     .front();
+    Value has_previous_index = b.create<arith::AndIOp>(
+        b.create<arith::CmpIOp>(arith::CmpIPredicate::sgt, warp_start, zero),
+        b.create<arith::CmpIOp>(
+            arith::CmpIPredicate::slt, warp_start,
+            b.create<arith::ConstantIndexOp>(description_.num_slices)));
+    ValueRange previous_offsets = EmitUpdateIf(
+        b, has_previous_index, indices_init,
+        [&](ImplicitLocOpBuilder& if_b) -> SmallVector<Value> {
+          SmallVector<Value, 4> offsets = helper.ExtractOffsets(
+              if_b, if_b.create<arith::SubIOp>(
+                        warp_start, if_b.create<arith::ConstantIndexOp>(1)));
+          return SmallVector<Value>(offsets.begin(), offsets.end());
+        });
+    indices_init.assign(previous_offsets.begin(), previous_offsets.end());
+  }
   Value accumulator_init = InitializeAccumulator(b);
   SmallVector<Value> inits =
       Pack({slice_id_init, indices_init, is_inbounds_init, accumulator_init,
@@ -695,6 +771,32 @@ absl::Status ScatterWithDistributedIndices::EmitEntryFunctionImpl(
 
   int64_t output_rank = description_.output_shape.size();
 
+  // Emits a loop that combines the accumulator with the update elements of the
+  // slice `index_id`, which is the last dimension of `indexing`.
+  auto emit_combine_accumulator = [&](ImplicitLocOpBuilder& nested_b,
+                                      Value index_id,
+                                      const IndexingMap& indexing,
+                                      Value acc) -> ValueRange {
+    return EmitXlaLoopOp(
+        nested_b, Pack({thread_and_block_ids, index_id}), {acc}, indexing,
+        [&](ImplicitLocOpBuilder& update_loop_b, ValueRange accumulator_indices,
+            ValueRange slice_indices,
+            ValueRange inner_iter_args) -> SmallVector<Value> {
+          Value acc_arg = inner_iter_args.front();
+          auto update_elem =
+              helper.GetUpdateElement(update_loop_b, slice_indices);
+          auto acc_ind_opfold = mlir::getAsOpFoldResult(accumulator_indices);
+          Value accumulator_elem =
+              update_loop_b.create<vector::ExtractOp>(acc_arg, acc_ind_opfold);
+          auto reduced_val = emitters::InlineBlock(
+              update_loop_b, helper.GetReducer().getBody().front(),
+              {accumulator_elem, update_elem})[0];
+          return update_loop_b
+              .create<vector::InsertOp>(reduced_val, acc_arg, acc_ind_opfold)
+              ->getResults();
+        });
+  };
+
   auto loop_over_indices_fn =
       [&](ImplicitLocOpBuilder& nested_b, ValueRange ivs,
           ValueRange thread_id_to_index_id_value,
@@ -775,26 +877,8 @@ absl::Status ScatterWithDistributedIndices::EmitEntryFunctionImpl(
     auto emit_combine_accumulator_fn = [&](OpBuilder& else_b,
                                            Location else_loc) -> void {
       ImplicitLocOpBuilder implicit_else_b(else_loc, else_b);
-      auto else_results = EmitXlaLoopOp(
-          implicit_else_b, Pack({thread_and_block_ids, iter_slice_id}),
-          {iter_acc}, slice_indexing,
-          [&](ImplicitLocOpBuilder& update_loop_b,
-              ValueRange accumulator_indices, ValueRange slice_indices,
-              ValueRange inner_iter_args) -> SmallVector<Value> {
-            Value acc_arg = inner_iter_args.front();
-            auto update_elem =
-                helper.GetUpdateElement(update_loop_b, slice_indices);
-            auto acc_ind_opfold = mlir::getAsOpFoldResult(accumulator_indices);
-            Value accumulator_elem = update_loop_b.create<vector::ExtractOp>(
-                acc_arg, acc_ind_opfold);
-            auto reduced_val = emitters::InlineBlock(
-                update_loop_b, helper.GetReducer().getBody().front(),
-                {accumulator_elem, update_elem})[0];
-            return update_loop_b
-                .create<vector::InsertOp>(reduced_val, acc_arg, acc_ind_opfold)
-                ->getResults();
-          });
-      implicit_else_b.create<scf::YieldOp>(else_results);
+      implicit_else_b.create<scf::YieldOp>(emit_combine_accumulator(
+          implicit_else_b, iter_slice_id, slice_indexing, iter_acc));
     };
     auto updated_accumulator =
         EmitUpdateIf(nested_b, new_is_inbounds, {iter_acc},
@@ -825,6 +909,53 @@ absl::Status ScatterWithDistributedIndices::EmitEntryFunctionImpl(
   Value result_is_inbounds = loop_over_indices_results_unpacked[2].front();
   Value result_acc = loop_over_indices_results_unpacked[3].front();
   Value result_output = loop_over_indices_results_unpacked[4].front();
+  if (deterministic_) {
+    // The last run of the warp may continue past its range of indices, where
+    // the next warps skip it. Keep accumulating until the offsets change.
+    ValueRange last_offsets = loop_over_indices_results_unpacked[1];
+    IndexingMap tail_slice_indexing = ComputeSliceIndexing(mlir_context);
+    Value num_slices =
+        b.create<arith::ConstantIndexOp>(description_.num_slices);
+    Value false_value = b.create<arith::ConstantIntOp>(0, b.getI1Type());
+    Value true_value = b.create<arith::ConstantIntOp>(1, b.getI1Type());
+    Value tail_start = b.create<arith::AddIOp>(
+        warp_start, b.create<arith::ConstantIndexOp>(num_indices_per_warp_));
+    auto tail_loop = b.create<scf::WhileOp>(
+        mlir::TypeRange{tail_start.getType(), result_acc.getType()},
+        ValueRange{tail_start, result_acc},
+        [&](OpBuilder& before_b, Location before_loc, ValueRange args) {
+          ImplicitLocOpBuilder cond_b(before_loc, before_b);
+          Value index_id = args.front();
+          Value in_range = cond_b.create<arith::AndIOp>(
+              result_is_inbounds,
+              cond_b.create<arith::CmpIOp>(arith::CmpIPredicate::ult, index_id,
+                                           num_slices));
+          Value same_offsets =
+              EmitUpdateIf(
+                  cond_b, in_range, {false_value},
+                  [&](ImplicitLocOpBuilder& if_b) -> SmallVector<Value> {
+                    Value offsets_changed = EmitInequalityCheck(
+                        if_b, last_offsets,
+                        helper.ExtractOffsets(if_b, index_id));
+                    return {if_b.create<arith::XOrIOp>(offsets_changed,
+                                                       true_value)};
+                  })
+                  .front();
+          cond_b.create<scf::ConditionOp>(same_offsets, args);
+        },
+        [&](OpBuilder& after_b, Location after_loc, ValueRange args) {
+          ImplicitLocOpBuilder body_b(after_loc, after_b);
+          Value index_id = args.front();
+          Value acc = emit_combine_accumulator(body_b, index_id,
+                                               tail_slice_indexing, args.back())
+                          .front();
+          body_b.create<scf::YieldOp>(ValueRange{
+              body_b.create<arith::AddIOp>(
+                  index_id, body_b.create<arith::ConstantIndexOp>(1)),
+              acc});
+        });
+    result_acc = tail_loop.getResult(1);
+  }
   result_output = helper.WriteAccumulatorToOutput(
       b, result_is_inbounds, thread_and_block_ids, result_slice_id,
       slice_indexing, result_offsets, result_acc, result_output);
@@ -897,11 +1028,22 @@ std::unique_ptr<ScatterFusion> CreateScatterFusion(
   int64_t max_active_warps =
       kNumWarpsPerBlock * analysis.device_info().core_count();
 
+  // If run-to-run determinism is required, sorted scatters with disjoint
+  // update windows are emitted without atomics, regardless of their size.
+  const DebugOptions& debug_options =
+      description.scatter->GetModule()->config().debug_options();
+  bool deterministic =
+      (debug_options.xla_gpu_deterministic_ops() ||
+       debug_options.xla_gpu_exclude_nondeterministic_ops()) &&
+      !description.scatter->unique_indices() &&
+      IsSortedScatterWithDisjointWindows(description.scatter);
+
   // If indices are sorted and not unique, we can use the distributed indices
   // implementation to accumulate the updates before writing them to the output
   // tensor.
   if (description.scatter->indices_are_sorted() &&
-      !description.scatter->unique_indices() && num_slices > max_active_warps) {
+      !description.scatter->unique_indices() &&
+      (deterministic || num_slices > max_active_warps)) {
     int64_t num_indices_per_warp = 1;
     int64_t indices_vector_size = 1;
     int64_t num_warps_per_slice = 1;
@@ -931,7 +1073,7 @@ std::unique_ptr<ScatterFusion> CreateScatterFusion(
     }
     return std::make_unique<ScatterWithDistributedIndices>(
         analysis, description, vector_size, num_warps_per_slice,
-        num_indices_per_warp, indices_vector_size);
+        num_indices_per_warp, indices_vector_size, deterministic);
   }
   // Otherwise, we distribute the linearized updates tensor.
   vector_size =
@@ -101,6 +101,12 @@ class ScatterFusion : public EmitterBase {
       const HloFusionInstruction& fusion,
       mlir::MLIRContext* mlir_context) const final;
 
+  // Returns true if several threads may update the same output element, so
+  // that the updates have to be combined with atomics.
+  virtual bool RequiresAtomicWrites() const {
+    return !description_.scatter->unique_indices();
+  }
+
   const HloFusionAnalysis& analysis_;
   ScatterDescription description_;
 
@@ -182,6 +188,14 @@ class ScatterWithDistributedUpdates : public ScatterFusion {
 }
 %final_out = WriteAccumulatorToOutput(%updated_accumulator, %updated_out);
 */
+// In the deterministic mode, every run of equal indices is owned by the warp
+// in whose range of indices it starts. A warp skips the indices at the start
+// of its range that continue the run of the previous warp, and after its range
+// keeps accumulating while the indices are equal to those of its last run.
+// Every output element is then written by exactly one thread, in the order of
+// the updates, so the writes do not need atomics and the result does not
+// depend on the scheduling of the warps. This requires the update windows of
+// different indices to be disjoint, see IsSortedScatterWithDisjointWindows.
 class ScatterWithDistributedIndices : public ScatterFusion {
  public:
   explicit ScatterWithDistributedIndices(const HloFusionAnalysis& analysis,
@@ -189,12 +203,17 @@ class ScatterWithDistributedIndices : public ScatterFusion {
                                          int64_t vector_size,
                                          int64_t num_warps_per_slice,
                                          int64_t num_indices_per_warp,
-                                         int64_t indices_vector_size);
+                                         int64_t indices_vector_size,
+                                         bool deterministic = false);
 
  protected:
   void ComputeIndexing(mlir::MLIRContext* ctx, IndexingMap* updates_map,
                        IndexingMap* indices_map) const override;
 
+  bool RequiresAtomicWrites() const override {
+    return !deterministic_ && ScatterFusion::RequiresAtomicWrites();
+  }
+
   absl::Status EmitEntryFunctionImpl(mlir::ImplicitLocOpBuilder& b,
                                      const EmitterHelper& helper,
                                      const IndexingMap& updates_map,
@@ -206,6 +225,11 @@ class ScatterWithDistributedIndices : public ScatterFusion {
   // Creates a 2D vector to store the accumulated updates in each thread.
   mlir::Value InitializeAccumulator(mlir::ImplicitLocOpBuilder& b) const;
 
+  // Computes the indexing of the updates of the slice with the given index,
+  // which is passed as the last dimension rather than computed from the
+  // thread and block ids. Used to continue a run past the range of a warp.
+  IndexingMap ComputeSliceIndexing(mlir::MLIRContext* ctx) const;
+
   // The number of warps that process a single slice of the update.
   int64_t num_warps_per_slice_;
   // The number of indices that every warp iterates over. This is a useful
@@ -213,6 +237,8 @@ class ScatterWithDistributedIndices : public ScatterFusion {
   int64_t num_indices_per_warp_;
   // Vector size for the indices operand.
   int64_t indices_vector_size_;
+  // Whether every run of equal indices is reduced by a single warp, see above.
+  bool deterministic_;
 };
 
 std::unique_ptr<ScatterFusion> CreateScatterFusion(
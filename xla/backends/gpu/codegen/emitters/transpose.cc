@@ -20,6 +20,7 @@ limitations under the License.
 #include <memory>
 #include <optional>
 #include <utility>
+#include <variant>
 #include <vector>
 
 #include "absl/algorithm/container.h"
@@ -65,13 +66,16 @@ limitations under the License.
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_instructions.h"
 #include "xla/hlo/utils/hlo_traversal.h"
+#include "xla/layout_util.h"
 #include "xla/permutation_util.h"
 #include "xla/primitive_util.h"
+#include "xla/service/gpu/backend_configs.pb.h"
 #include "xla/service/gpu/hlo_fusion_analysis.h"
 #include "xla/service/gpu/ir_emission_utils.h"
 #include "xla/service/gpu/launch_dimensions.h"
 #include "xla/shape.h"
 #include "xla/shape_util.h"
+#include "xla/stream_executor/device_description.h"
 #include "xla/util.h"
 #include "xla/xla_data.pb.h"
 
@@ -101,6 +105,8 @@ namespace mv = ::mlir::vector;
 constexpr int kNumRows = 4;
 constexpr int kNumThreadsPerBlock = 128;
 constexpr int kMaxVectorizedBytes = 4;
+// Alignment of the sources, destinations and sizes of bulk copies.
+constexpr int kBulkCopyAlignmentBytes = 16;
 
 // Reads the 2D vector tile <vector_size x vector_size> from the shared memory
 // at the given indices.
@@ -204,8 +210,16 @@ TransposeFusion::TransposeFusion(const HloFusionAnalysis& analysis)
     // the input dimensions are divisible by the vector size. Vectorizing loads
     // for large data types does not help (there's already enough parallelism).
     const auto& device = analysis_.device_info();
-    for (int vec_size = kMaxVectorizedBytes / max_element_bytes; vec_size > 1;
-         vec_size /= 2) {
+    int max_vec_size = kMaxVectorizedBytes / max_element_bytes;
+    // The autotuner may restrict the vector size further.
+    if (int64_t configured_max_vec_size =
+            analysis_.fusion_backend_config()
+                .native_emitter_backend_config()
+                .max_vector_size();
+        configured_max_vec_size > 0) {
+      max_vec_size = std::min<int64_t>(max_vec_size, configured_max_vec_size);
+    }
+    for (int vec_size = max_vec_size; vec_size > 1; vec_size /= 2) {
       int elems_per_thread = vec_size * vec_size;
       bool enough_work = Product(block_counts_) * kNumThreadsPerBlock >=
                          elems_per_thread * device.core_count() *
@@ -220,6 +234,7 @@ TransposeFusion::TransposeFusion(const HloFusionAnalysis& analysis)
       }
     }
   }
+  use_bulk_loads_ = CanUseBulkLoads();
 }
 
 std::optional<IndexingMap> TransposeFusion::ComputeThreadIdToOutputIndexing(
@@ -298,6 +313,34 @@ TransposeFusion::WriteResult TransposeFusion::EmitWriteToShMemMlir(
     ++shmem_tensor_size.back();
   }
   int num_inputs = fusion.fused_instructions_computation()->num_parameters();
+  Value bulk_load_offset;
+  if (use_bulk_loads_) {
+    // The tiles are copied from the parameters in input orientation. The
+    // parameters have the default layout, so the tile origin is the row-major
+    // linear index of the block's first element in `input_shape_`.
+    auto block_ids = DelinearizeInBoundsIndex(
+        getAffineDimExpr(KernelFusionInterface::kIndexingMapBlockIdxDims[0],
+                         ctx),
+        block_counts_);
+    AffineExpr offset = getAffineConstantExpr(0, ctx);
+    int64_t stride = 1;
+    for (int64_t i = input_shape_.size() - 1; i >= 0; --i) {
+      offset = offset + block_ids[i] * block_sizes_[i] * stride;
+      stride *= input_shape_[i];
+    }
+    std::vector<int64_t> dim_var_sizes(6, 1);
+    dim_var_sizes[KernelFusionInterface::kIndexingMapThreadIdxDims[0]] =
+        kNumThreadsPerBlock;
+    dim_var_sizes[KernelFusionInterface::kIndexingMapBlockIdxDims[0]] =
+        Product(block_counts_);
+    IndexingMap offset_indexing{mlir::AffineMap::get(6, 0, offset),
+                                DimVarsFromGPUGrid(dim_var_sizes),
+                                /*range_vars=*/{},
+                                /*rt_vars=*/{}};
+    bulk_load_offset = ApplyIndexing(offset_indexing, thread_and_block_ids,
+                                     /*symbols=*/{}, builder)
+                           .front();
+  }
   SmallVector<Value> callee_operands(
       entry_function.getArguments().take_front(num_inputs));
   auto tids_and_bids = EmitThreadAndBlockIds(builder);
@@ -327,6 +370,25 @@ TransposeFusion::WriteResult TransposeFusion::EmitWriteToShMemMlir(
   for (auto* transpose : shmem_transposes_) {
     auto elem_type = emitters::PrimitiveTypeToMlirType(
         transpose->shape().element_type(), builder);
+    if (use_bulk_loads_) {
+      // Pad the rows by 16 bytes rather than by one element, so that they
+      // stay aligned for the bulk copies. This leaves 4-way bank conflicts for
+      // 32-bit types on the transposed read, which is still far from being
+      // the bottleneck.
+      auto bulk_shmem_size = block_sizes_;
+      bulk_shmem_size.back() +=
+          kBulkCopyAlignmentBytes /
+          primitive_util::ByteWidth(transpose->shape().element_type());
+      int64_t row_stride = Product(
+          absl::MakeConstSpan(input_shape_).subspan(permutation_.back() + 1));
+      shmem_tensors.push_back(builder.create<BulkLoadToSharedOp>(
+          RankedTensorType::get(bulk_shmem_size, elem_type),
+          entry_function.getArgument(transpose->operand(0)->parameter_number()),
+          bulk_load_offset, builder.getI64IntegerAttr(block_size_),
+          builder.getI64IntegerAttr(row_stride),
+          builder.getI64IntegerAttr(bulk_shmem_size.back())));
+      continue;
+    }
     auto shmem = builder.create<AllocateSharedOp>(
         RankedTensorType::get(shmem_tensor_size, elem_type));
     auto indexed_vector =
@@ -413,8 +475,10 @@ void TransposeFusion::EmitReadFromShMemMlir(
   auto* mlir_context = builder.getContext();
   auto output_indexing = *ComputeThreadIdToOutputIndexing(
       shmem_transpose_root_indices_[0], mlir_context);
+  // Bulk loads leave the tiles in input orientation, so they have to be read
+  // with the indexing that is otherwise used to write them.
   auto shmem_read_indexing =
-      GetSharedMemoryIndexing(/*read=*/true, mlir_context);
+      GetSharedMemoryIndexing(/*read=*/!use_bulk_loads_, mlir_context);
   auto result_tensors = emitters::EmitXlaLoopOp(
       builder, thread_and_block_ids, written.updated_outputs, output_indexing,
       [&](ImplicitLocOpBuilder& nested_b, ValueRange symbol_values,
@@ -542,6 +606,48 @@ bool TransposeFusion::MostMinorDimensionUnchanged() const {
   return permutation_.back() == permutation_.size() - 1;
 }
 
+bool TransposeFusion::CanUseBulkLoads() const {
+  const auto& device = analysis_.device_info();
+  if (!std::holds_alternative<se::CudaComputeCapability>(
+          device.gpu_compute_capability()) ||
+      !device.cuda_compute_capability().IsAtLeastHopper()) {
+    return false;
+  }
+  // Each row of a tile is copied from the most minor input dimension, so that
+  // dimension has to be one of the transposed ones.
+  if (MostMinorDimensionUnchanged()) {
+    return false;
+  }
+  // Only whole tiles are copied.
+  for (auto [size, block_size] : llvm::zip(input_shape_, block_sizes_)) {
+    if (size % block_size != 0) {
+      return false;
+    }
+  }
+  int64_t row_stride = Product(
+      absl::MakeConstSpan(input_shape_).subspan(permutation_.back() + 1));
+  int64_t shmem_usage = 0;
+  for (const HloInstruction* transpose : shmem_transposes_) {
+    const HloInstruction* operand = transpose->operand(0);
+    PrimitiveType element_type = operand->shape().element_type();
+    if (operand->opcode() != HloOpcode::kParameter ||
+        !LayoutUtil::IsMonotonicWithDim0Major(operand->shape().layout()) ||
+        !(primitive_util::IsIntegralType(element_type) ||
+          primitive_util::IsFloatingPointType(element_type)) ||
+        primitive_util::BitWidth(element_type) < 8) {
+      return false;
+    }
+    int64_t element_bytes = primitive_util::ByteWidth(element_type);
+    if ((block_size_ * element_bytes) % kBulkCopyAlignmentBytes != 0 ||
+        (row_stride * element_bytes) % kBulkCopyAlignmentBytes != 0) {
+      return false;
+    }
+    shmem_usage +=
+        block_size_ * (block_size_ * element_bytes + kBulkCopyAlignmentBytes);
+  }
+  return shmem_usage <= device.shared_memory_per_block();
+}
+
 std::vector<int64_t> GetBlockCounts(absl::Span<const int64_t> shape,
                                     absl::Span<const int64_t> tile) {
   std::vector<int64_t> block_counts;
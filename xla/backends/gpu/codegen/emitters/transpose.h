@@ -107,6 +107,9 @@ class TransposeFusion : public EmitterBase {
   llvm::SmallVector<mlir::AffineExpr, 4> GetThreadOffsets(
       bool read, mlir::MLIRContext* ctx) const;
   bool MostMinorDimensionUnchanged() const;
+  // Returns true if the shared memory tiles can be filled with bulk copies
+  // (TMA) straight from the parameters, instead of through registers.
+  bool CanUseBulkLoads() const;
 
   TransposeDescription transpose_;
   absl::InlinedVector<int64_t, 3> permutation_;
@@ -123,6 +126,7 @@ class TransposeFusion : public EmitterBase {
   std::vector<int> shmem_transpose_root_indices_;
   std::vector<const HloInstruction*> side_output_roots_;
   std::vector<int> side_output_root_indices_;
+  bool use_bulk_loads_ = false;
 };
 
 // Packed transpose is a more advanced version of the transpose emitter.
@@ -27,6 +27,7 @@ limitations under the License.
 #include "xla/backends/gpu/codegen/emitters/in_place_dynamic_update_slice.h"
 #include "xla/backends/gpu/codegen/emitters/input_slices.h"
 #include "xla/backends/gpu/codegen/emitters/loop.h"
+#include "xla/backends/gpu/codegen/emitters/normalization.h"
 #include "xla/backends/gpu/codegen/emitters/reduction.h"
 #include "xla/backends/gpu/codegen/emitters/scatter.h"
 #include "xla/backends/gpu/codegen/emitters/transpose.h"
@@ -142,6 +143,8 @@ std::unique_ptr<FusionInterface> GetFusionEmitter(
     case HloFusionAnalysis::EmitterFusionKind::kConcatenate: {
       return std::make_unique<ConcatenateFusion>(analysis);
     }
+    case HloFusionAnalysis::EmitterFusionKind::kNormalization:
+      return std::make_unique<NormalizationFusion>(analysis);
     case HloFusionAnalysis::EmitterFusionKind::kTriton:
       return std::make_unique<TritonFusion>(analysis);
     case HloFusionAnalysis::EmitterFusionKind::kCuDnn:
@@ -0,0 +1,186 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/gpu/codegen/triton/attention_pattern.h"
+
+#include <cstdint>
+
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/service/instruction_fusion.h"
+#include "xla/xla_data.pb.h"
+
+namespace xla::gpu {
+namespace {
+
+const HloInstruction* SkipConverts(const HloInstruction* instr) {
+  while (instr->opcode() == HloOpcode::kConvert) {
+    instr = instr->operand(0);
+  }
+  return instr;
+}
+
+const HloInstruction* SkipBroadcastsAndConverts(const HloInstruction* instr) {
+  while (instr->opcode() == HloOpcode::kConvert ||
+         instr->opcode() == HloOpcode::kBroadcast) {
+    instr = instr->operand(0);
+  }
+  return instr;
+}
+
+bool IsScalarConstant(const HloInstruction* instr) {
+  instr = SkipBroadcastsAndConverts(instr);
+  return instr->opcode() == HloOpcode::kConstant &&
+         instr->shape().dimensions_size() == 0;
+}
+
+// Returns true if `instr` is a single-input reduction of the minor-most
+// dimension of its input, with a `reducer` binary op as computation.
+bool IsMinorDimReduction(const HloInstruction* instr, HloOpcode reducer) {
+  if (instr->opcode() != HloOpcode::kReduce || instr->operand_count() != 2) {
+    return false;
+  }
+  int64_t rank = instr->operand(0)->shape().dimensions_size();
+  if (instr->dimensions().size() != 1 || instr->dimensions(0) != rank - 1) {
+    return false;
+  }
+  const HloInstruction* root = instr->to_apply()->root_instruction();
+  return root->opcode() == reducer &&
+         root->operand(0)->opcode() == HloOpcode::kParameter &&
+         root->operand(1)->opcode() == HloOpcode::kParameter;
+}
+
+// Returns true if `instr` broadcasts the result of a minor-most `reducer`
+// reduction of `input` back to the shape of `input`.
+bool IsBroadcastedReductionOf(const HloInstruction* instr,
+                              const HloInstruction* input, HloOpcode reducer) {
+  if (instr->opcode() != HloOpcode::kBroadcast) {
+    return false;
+  }
+  const HloInstruction* reduce = SkipConverts(instr->operand(0));
+  return IsMinorDimReduction(reduce, reducer) &&
+         SkipConverts(reduce->operand(0)) == SkipConverts(input);
+}
+
+// Returns true if `instr` is an iota, optionally shifted by a scalar constant.
+bool IsShiftedIota(const HloInstruction* instr) {
+  instr = SkipBroadcastsAndConverts(instr);
+  if (instr->opcode() == HloOpcode::kAdd ||
+      instr->opcode() == HloOpcode::kSubtract) {
+    if (IsScalarConstant(instr->operand(1))) {
+      return IsShiftedIota(instr->operand(0));
+    }
+    if (IsScalarConstant(instr->operand(0))) {
+      return IsShiftedIota(instr->operand(1));
+    }
+    return false;
+  }
+  return instr->opcode() == HloOpcode::kIota;
+}
+
+// Returns true if `predicate` compares two iotas, e.g. the row and column
+// indices of the scores.
+bool IsCausalMaskPredicate(const HloInstruction* predicate) {
+  predicate = SkipBroadcastsAndConverts(predicate);
+  return predicate->opcode() == HloOpcode::kCompare &&
+         IsShiftedIota(predicate->operand(0)) &&
+         IsShiftedIota(predicate->operand(1));
+}
+
+// Records the kind of mask applied by `predicate` in `pattern`.
+void MatchMaskPredicate(const HloInstruction* predicate,
+                        AttentionPattern& pattern) {
+  predicate = SkipBroadcastsAndConverts(predicate);
+  if (predicate->opcode() == HloOpcode::kAnd) {
+    MatchMaskPredicate(predicate->operand(0), pattern);
+    MatchMaskPredicate(predicate->operand(1), pattern);
+    return;
+  }
+  if (IsCausalMaskPredicate(predicate)) {
+    pattern.causal_mask = true;
+  } else {
+    pattern.padding_mask = true;
+  }
+}
+
+}  // namespace
+
+AttentionMatchingDecision MatchAttentionPattern(
+    const HloInstruction& output_dot) {
+  if (output_dot.opcode() != HloOpcode::kDot) {
+    return FusionDecision::Forbid("the output is not a dot");
+  }
+
+  // softmax(x) = exp(x - max(x)) / sum(exp(x - max(x))).
+  const HloInstruction* probs = SkipConverts(output_dot.operand(0));
+  if (probs->opcode() != HloOpcode::kDivide) {
+    return FusionDecision::Forbid("the lhs of the output dot is not a softmax");
+  }
+  const HloInstruction* exp = SkipConverts(probs->operand(0));
+  if (exp->opcode() != HloOpcode::kExp ||
+      !IsBroadcastedReductionOf(probs->operand(1), exp, HloOpcode::kAdd)) {
+    return FusionDecision::Forbid(
+        "the softmax does not divide by the sum of exponentials");
+  }
+  const HloInstruction* shifted = SkipConverts(exp->operand(0));
+  if (shifted->opcode() != HloOpcode::kSubtract ||
+      !IsBroadcastedReductionOf(shifted->operand(1), shifted->operand(0),
+                                HloOpcode::kMaximum)) {
+    return FusionDecision::Forbid(
+        "the softmax does not subtract the maximum of the scores");
+  }
+
+  const DotDimensionNumbers& dims = output_dot.dot_dimension_numbers();
+  int64_t probs_rank = probs->shape().dimensions_size();
+  if (dims.lhs_contracting_dimensions_size() != 1 ||
+      dims.lhs_contracting_dimensions(0) != probs_rank - 1) {
+    return FusionDecision::Forbid(
+        "the output dot does not contract the softmax dimension");
+  }
+
+  // Peel off the scale and the masks between the softmax and the scores dot.
+  AttentionPattern pattern;
+  pattern.output_dot = &output_dot;
+  const HloInstruction* scores = SkipConverts(shifted->operand(0));
+  while (scores->opcode() != HloOpcode::kDot) {
+    if (scores->opcode() == HloOpcode::kMultiply && pattern.scale == nullptr &&
+        (IsScalarConstant(scores->operand(0)) ||
+         IsScalarConstant(scores->operand(1)))) {
+      pattern.scale = scores;
+      scores = SkipConverts(
+          scores->operand(IsScalarConstant(scores->operand(1)) ? 0 : 1));
+    } else if (scores->opcode() == HloOpcode::kSelect &&
+               IsScalarConstant(scores->operand(2))) {
+      MatchMaskPredicate(scores->operand(0), pattern);
+      scores = SkipConverts(scores->operand(1));
+    } else if (scores->opcode() == HloOpcode::kAdd &&
+               !pattern.padding_mask) {
+      // An additive bias. The bias is usually a broadcasted parameter, the
+      // scores are the other operand.
+      pattern.padding_mask = true;
+      const HloInstruction* lhs = SkipConverts(scores->operand(0));
+      bool lhs_is_bias = lhs->opcode() == HloOpcode::kBroadcast ||
+                         lhs->opcode() == HloOpcode::kParameter;
+      scores = lhs_is_bias ? SkipConverts(scores->operand(1)) : lhs;
+    } else {
+      return FusionDecision::Forbid(
+          "the softmax input is not a scaled and masked dot");
+    }
+  }
+  pattern.scores_dot = scores;
+  return pattern;
+}
+
+}  // namespace xla::gpu
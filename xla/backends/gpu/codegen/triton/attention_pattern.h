@@ -0,0 +1,59 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_BACKENDS_GPU_CODEGEN_TRITON_ATTENTION_PATTERN_H_
+#define XLA_BACKENDS_GPU_CODEGEN_TRITON_ATTENTION_PATTERN_H_
+
+#include <variant>
+
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/service/instruction_fusion.h"
+
+namespace xla::gpu {
+
+// A dot -> softmax -> dot chain, i.e. softmax(mask(scale * Q·K^T))·V.
+struct AttentionPattern {
+  // The dot computing the attention scores, Q·K^T.
+  const HloInstruction* scores_dot = nullptr;
+  // The dot multiplying the softmax output with V.
+  const HloInstruction* output_dot = nullptr;
+  // The multiply scaling the scores, if any.
+  const HloInstruction* scale = nullptr;
+  // Whether the scores are masked with a predicate comparing iotas, i.e. a
+  // causal mask.
+  bool causal_mask = false;
+  // Whether the scores are masked with any other predicate or with an additive
+  // bias, e.g. a padding mask.
+  bool padding_mask = false;
+};
+
+using AttentionMatchingDecision =
+    std::variant<FusionDecision, AttentionPattern>;
+
+// Matches the attention pattern ending in `output_dot`. The softmax must
+// reduce the minor-most dimension of the scores, which must be the contracting
+// dimension of the output dot. Converts between the parts of the pattern are
+// allowed. Returns the matched pattern, or a FusionDecision explaining why the
+// pattern did not match.
+//
+// This is the matching part of flash-attention style Triton fusions, which
+// compute the chain with an online softmax without writing the scores to
+// memory.
+AttentionMatchingDecision MatchAttentionPattern(
+    const HloInstruction& output_dot);
+
+}  // namespace xla::gpu
+
+#endif  // XLA_BACKENDS_GPU_CODEGEN_TRITON_ATTENTION_PATTERN_H_
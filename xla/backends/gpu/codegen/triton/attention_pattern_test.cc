@@ -0,0 +1,181 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/gpu/codegen/triton/attention_pattern.h"
+
+#include <memory>
+#include <string>
+#include <variant>
+
+#include <gtest/gtest.h>
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_replace.h"
+#include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_computation.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/testlib/hlo_hardware_independent_test_base.h"
+#include "xla/service/instruction_fusion.h"
+#include "xla/tsl/platform/statusor.h"
+
+namespace xla::gpu {
+namespace {
+
+using AttentionPatternTest = HloHardwareIndependentTestBase;
+
+// `$scores` must define `masked` from the unscaled scores `s`.
+constexpr absl::string_view kHloTemplate = R"(
+HloModule m
+
+max {
+  a = f32[] parameter(0)
+  b = f32[] parameter(1)
+  ROOT r = f32[] maximum(a, b)
+}
+
+add {
+  a = f32[] parameter(0)
+  b = f32[] parameter(1)
+  ROOT r = f32[] add(a, b)
+}
+
+ENTRY e {
+  q = f32[2,16,8] parameter(0)
+  k = f32[2,16,8] parameter(1)
+  v = f32[2,16,8] parameter(2)
+  s = f32[2,16,16] dot(q, k), lhs_batch_dims={0}, rhs_batch_dims={0},
+      lhs_contracting_dims={2}, rhs_contracting_dims={2}
+  c = f32[] constant(0.125)
+  cb = f32[2,16,16] broadcast(c), dimensions={}
+  $scores
+  ninf = f32[] constant(-inf)
+  m = f32[2,16] reduce(masked, ninf), dimensions={2}, to_apply=max
+  mb = f32[2,16,16] broadcast(m), dimensions={0,1}
+  sub = f32[2,16,16] subtract(masked, mb)
+  ex = f32[2,16,16] exponential(sub)
+  zero = f32[] constant(0)
+  sum = f32[2,16] reduce(ex, zero), dimensions={2}, to_apply=add
+  sb = f32[2,16,16] broadcast(sum), dimensions={0,1}
+  p = f32[2,16,16] divide(ex, sb)
+  ROOT o = f32[2,16,8] dot(p, v), lhs_batch_dims={0}, rhs_batch_dims={0},
+      lhs_contracting_dims={2}, rhs_contracting_dims={1}
+})";
+
+constexpr absl::string_view kCausalMask = R"(
+  row = s32[16,16] iota(), iota_dimension=0
+  col = s32[16,16] iota(), iota_dimension=1
+  causal = pred[16,16] compare(row, col), direction=GE
+  causal_b = pred[2,16,16] broadcast(causal), dimensions={1,2}
+)";
+
+std::string AttentionHlo(absl::string_view scores) {
+  return absl::StrReplaceAll(kHloTemplate, {{"$scores", scores}});
+}
+
+TEST_F(AttentionPatternTest, MatchesScaledAttention) {
+  TF_ASSERT_OK_AND_ASSIGN(
+      std::unique_ptr<HloModule> module,
+      ParseAndReturnVerifiedModule(
+          AttentionHlo("masked = f32[2,16,16] multiply(s, cb)")));
+  const HloComputation* entry = module->entry_computation();
+
+  AttentionMatchingDecision decision =
+      MatchAttentionPattern(*entry->root_instruction());
+  const auto* pattern = std::get_if<AttentionPattern>(&decision);
+  ASSERT_NE(pattern, nullptr);
+  EXPECT_EQ(pattern->scores_dot, entry->GetInstructionWithName("s"));
+  EXPECT_EQ(pattern->output_dot, entry->root_instruction());
+  EXPECT_EQ(pattern->scale, entry->GetInstructionWithName("masked"));
+  EXPECT_FALSE(pattern->causal_mask);
+  EXPECT_FALSE(pattern->padding_mask);
+}
+
+TEST_F(AttentionPatternTest, MatchesCausalMask) {
+  TF_ASSERT_OK_AND_ASSIGN(
+      std::unique_ptr<HloModule> module,
+      ParseAndReturnVerifiedModule(AttentionHlo(absl::StrCat(kCausalMask, R"(
+  scaled = f32[2,16,16] multiply(s, cb)
+  neg = f32[] constant(-1e30)
+  neg_b = f32[2,16,16] broadcast(neg), dimensions={}
+  masked = f32[2,16,16] select(causal_b, scaled, neg_b)
+)"))));
+
+  AttentionMatchingDecision decision =
+      MatchAttentionPattern(*module->entry_computation()->root_instruction());
+  const auto* pattern = std::get_if<AttentionPattern>(&decision);
+  ASSERT_NE(pattern, nullptr);
+  EXPECT_TRUE(pattern->causal_mask);
+  EXPECT_FALSE(pattern->padding_mask);
+}
+
+TEST_F(AttentionPatternTest, MatchesCausalAndPaddingMasks) {
+  TF_ASSERT_OK_AND_ASSIGN(
+      std::unique_ptr<HloModule> module,
+      ParseAndReturnVerifiedModule(AttentionHlo(absl::StrCat(kCausalMask, R"(
+  valid = pred[2,16,16] parameter(3)
+  mask = pred[2,16,16] and(causal_b, valid)
+  neg = f32[] constant(-1e30)
+  neg_b = f32[2,16,16] broadcast(neg), dimensions={}
+  selected = f32[2,16,16] select(mask, s, neg_b)
+  masked = f32[2,16,16] multiply(selected, cb)
+)"))));
+
+  AttentionMatchingDecision decision =
+      MatchAttentionPattern(*module->entry_computation()->root_instruction());
+  const auto* pattern = std::get_if<AttentionPattern>(&decision);
+  ASSERT_NE(pattern, nullptr);
+  EXPECT_TRUE(pattern->causal_mask);
+  EXPECT_TRUE(pattern->padding_mask);
+}
+
+TEST_F(AttentionPatternTest, MatchesAdditiveBias) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(AttentionHlo(R"(
+  scaled = f32[2,16,16] multiply(s, cb)
+  bias = f32[2,16] parameter(3)
+  bias_b = f32[2,16,16] broadcast(bias), dimensions={0,2}
+  masked = f32[2,16,16] add(bias_b, scaled)
+)")));
+  const HloComputation* entry = module->entry_computation();
+
+  AttentionMatchingDecision decision =
+      MatchAttentionPattern(*entry->root_instruction());
+  const auto* pattern = std::get_if<AttentionPattern>(&decision);
+  ASSERT_NE(pattern, nullptr);
+  EXPECT_EQ(pattern->scores_dot, entry->GetInstructionWithName("s"));
+  EXPECT_FALSE(pattern->causal_mask);
+  EXPECT_TRUE(pattern->padding_mask);
+}
+
+TEST_F(AttentionPatternTest, DoesNotMatchDotWithoutSoftmax) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(R"(
+HloModule m
+
+ENTRY e {
+  p = f32[2,16,16] parameter(0)
+  v = f32[2,16,8] parameter(1)
+  ROOT o = f32[2,16,8] dot(p, v), lhs_batch_dims={0}, rhs_batch_dims={0},
+      lhs_contracting_dims={2}, rhs_contracting_dims={1}
+})"));
+
+  AttentionMatchingDecision decision =
+      MatchAttentionPattern(*module->entry_computation()->root_instruction());
+  ASSERT_TRUE(std::holds_alternative<FusionDecision>(decision));
+  EXPECT_FALSE(std::get<FusionDecision>(decision).CanFuse());
+}
+
+}  // namespace
+}  // namespace xla::gpu
@@ -1672,6 +1672,9 @@ absl::StatusOr<mlir::OwningOpRef<mlir::ModuleOp>> CreateTritonModule(
       ir_type = b.getI16Type();
     } else if (type == S4) {
       ir_type = b.getI4Type();
+    } else if (type == F8E8M0FNU) {
+      // Block scales are passed as their raw exponent bits.
+      ir_type = b.getI8Type();
     } else {
       TF_ASSIGN_OR_RETURN(ir_type, TritonType(b, type));
     }
@@ -1605,6 +1605,42 @@ ENTRY e {
       kHloText, ErrorSpec{/*aabs=*/1e-4, /*arel=*/1e-6}));
 }
 
+TEST_F(TritonGemmTest, PagedGatherIsSupportedInRhs) {
+  // Rows of the RHS are read from pages of a cache selected by a block table,
+  // as in attention over a paged KV cache. The block size of the gathered
+  // dimension divides the page size.
+  constexpr absl::string_view kHloText = R"(
+HloModule m
+
+triton_gemm {
+  q = f32[64,128] parameter(0)
+  cache = f32[32,16,128] parameter(1)
+  block_table = s32[8] parameter(2)
+  gather = f32[8,16,128] gather(cache, block_table),
+    offset_dims={1,2}, collapsed_slice_dims={0}, start_index_map={0},
+    index_vector_dim=1, slice_sizes={1,16,128}
+  k = f32[128,128] bitcast(gather)
+  ROOT dot = f32[64,128] dot(q, k),
+    lhs_contracting_dims={1}, rhs_contracting_dims={1}
+}
+
+ENTRY e {
+  q = f32[64,128] parameter(0)
+  cache = f32[32,16,128] parameter(1)
+  block_table = s32[8] constant({5, 0, 31, 2, 7, 7, 1, 30})
+  ROOT fusion = f32[64,128] fusion(q, cache, block_table),
+       kind=kCustom, calls=triton_gemm,
+       backend_config={
+         "fusion_backend_config":{
+           "kind":"__triton_gemm","triton_gemm_config":{
+             "block_m":"32","block_n":"16","block_k":"32","split_k":"1",
+             "num_stages":"1","num_warps":"4","num_ctas":"1"}}}
+})";
+
+  EXPECT_TRUE(RunAndCompareNoHloPasses(
+      kHloText, ErrorSpec{/*aabs=*/1e-4, /*arel=*/1e-6}));
+}
+
 TEST_F(TritonGemmTest, MultiplePathsToSameOperandWorks) {
   constexpr absl::string_view kHloText = R"(
 triton_computation {
@@ -372,6 +372,60 @@ TEST_F(TritonTest, FuseSubchannelDequantizationFusedWithSmallBlockKSize) {
       kHloText, ErrorSpec{/*aabs=*/1e-3, /*arel=*/1e-3}));
 }
 
+TEST_F(TritonTest, FuseMxfp8DequantizationFused) {
+  if (!std::holds_alternative<stream_executor::CudaComputeCapability>(
+          GpuComputeComp()) ||
+      !GetCudaComputeCapability().IsAtLeastHopper()) {
+    GTEST_SKIP() << "F8E4M3FN is only supported on Hopper and newer.";
+  }
+  // MXFP8 weights: every 32 consecutive elements of the contracting dimension
+  // share an E8M0 scale, i.e. a power of two.
+  // param -> convert -> broadcast -> bitcast -> multiply -> dot.
+  constexpr absl::string_view kHloText = R"(
+    HloModule FuseMxfp8DequantizationFused
+
+    fusion {
+      w.f8 = f8e4m3fn[256,128] parameter(0)
+      w.bf16 = bf16[256,128] convert(w.f8)
+
+      s.e8m0 = f8e8m0fnu[256,4] parameter(1)
+      s.bf16 = bf16[256,4] convert(s.e8m0)
+      s.broadcast = bf16[256,4,32] broadcast(s.bf16), dimensions={0,1}
+      s.bitcast = bf16[256,128] bitcast(s.broadcast)
+      w = bf16[256,128] multiply(w.bf16, s.bitcast)
+
+      a = bf16[64,128] parameter(2)
+      ROOT dot = f32[256,64] dot(w, a),
+          lhs_contracting_dims={1}, rhs_contracting_dims={1}
+    }
+
+    ENTRY main {
+      w.f8 = f8e4m3fn[256,128] parameter(0)
+      s.e8m0 = f8e8m0fnu[256,4] parameter(1)
+      a.bf16 = bf16[64,128] parameter(2)
+      ROOT fusion = f32[256,64] fusion(w.f8, s.e8m0, a.bf16),
+        kind=kCustom,
+        calls=fusion,
+        backend_config={
+          "fusion_backend_config":{
+            "kind":"__triton_gemm",
+            "triton_gemm_config":{
+              "block_m":64,
+              "block_n":64,
+              "block_k":32,
+              "split_k":1,
+              "num_stages":1,
+              "num_warps":4,
+              "num_ctas":1
+            }
+          }
+        }
+    }
+  )";
+  EXPECT_TRUE(RunAndCompareNoHloPasses(
+      kHloText, ErrorSpec{/*aabs=*/1e-3, /*arel=*/1e-3}));
+}
+
 TEST_F(TritonTest, FuseBroadcastInPrologue) {
   constexpr absl::string_view kHloText = R"(
     HloModule FuseBroadcastInPrologue
@@ -157,6 +157,10 @@ absl::StatusOr<Type> TritonType(EmitterLocOpBuilder& b, PrimitiveType t) {
       return b.getType<mlir::Float8E5M2Type>();
     case F8E4M3FN:
       return b.getType<mlir::Float8E4M3FNType>();
+    case F8E8M0FNU:
+      // Block scales are loaded as their raw exponent bits, see
+      // EmitE8M0ToFloat.
+      return b.getI8Type();
     default:
       return absl::UnimplementedError(
           absl::StrCat("This type is not supported yet: ",
@@ -292,6 +296,36 @@ Value Minimum(EmitterLocOpBuilder b, const se::DeviceDescription& device_info,
       values[0], values[1]);
 }
 
+// Converts F8E8M0FNU values (e.g. MX block scales), which are loaded as their
+// raw bits, to `dst_element_ty`. An E8M0 value is 2^(bits - 127), so its bits
+// are the biased exponent of the equal F32, except for 2^-127, which is an
+// F32 subnormal, and for the NaN encoding 0xFF.
+Value EmitE8M0ToFloat(EmitterLocOpBuilder b, Value bits, Type dst_element_ty) {
+  Type i32_ty = b.getI32Type();
+  Type f32_ty = b.getF32Type();
+  auto shaped_ty = mlir::dyn_cast<ShapedType>(bits.getType());
+  auto constant = [&](int32_t value) -> Value {
+    if (shaped_ty) {
+      return CreateConst(b, b.getI32Type(), value, shaped_ty.getShape());
+    }
+    return CreateConst(b, b.getI32Type(), value);
+  };
+  if (shaped_ty) {
+    i32_ty = shaped_ty.clone(i32_ty);
+    f32_ty = shaped_ty.clone(f32_ty);
+  }
+  Value exponent = b.create<ma::ExtUIOp>(i32_ty, bits);
+  Value f32_bits = b.create<ma::ShLIOp>(exponent, constant(23));
+  f32_bits = b.create<ma::SelectOp>(
+      b.create<ma::CmpIOp>(ma::CmpIPredicate::eq, exponent, constant(0)),
+      constant(0x00400000), f32_bits);
+  f32_bits = b.create<ma::SelectOp>(
+      b.create<ma::CmpIOp>(ma::CmpIPredicate::eq, exponent, constant(0xFF)),
+      constant(0x7FC00000), f32_bits);
+  return triton::Cast(b, b.create<ma::BitcastOp>(f32_ty, f32_bits),
+                      dst_element_ty);
+}
+
 Value Splat(EmitterLocOpBuilder b, Value value, ArrayRef<int64_t> shape) {
   auto type = mlir::RankedTensorType::get(shape, value.getType());
   return b.create<mt::SplatOp>(type, value);
@@ -330,6 +364,9 @@ absl::StatusOr<Value> EmitElementwise(EmitterLocOpBuilder b,
     case HloOpcode::kConvert: {
       TF_ASSIGN_OR_RETURN(Type dst_ty,
                           TritonType(b, hlo.shape().element_type()));
+      if (hlo.operand(0)->shape().element_type() == F8E8M0FNU) {
+        return EmitE8M0ToFloat(b, inputs[0], dst_ty);
+      }
       return triton::Cast(b, inputs[0], dst_ty);
     }
     case HloOpcode::kAdd:
@@ -548,13 +585,15 @@ absl::StatusOr<Value> EmitScope(
       TF_ASSIGN_OR_RETURN(result, EmitElementwise(b, libdevice_path,
                                                   device_info, *hlo, operands));
     } else if (hlo->opcode() == HloOpcode::kConcatenate ||
-               hlo->opcode() == HloOpcode::kDynamicSlice) {
+               hlo->opcode() == HloOpcode::kDynamicSlice ||
+               hlo->opcode() == HloOpcode::kGather) {
       // Parameter loads and their concatenations are handled outside EmitScope.
       TF_RET_CHECK(values.contains(hlo)) << hlo->ToString();
       continue;
     } else if (hlo->opcode() == HloOpcode::kParameter) {
       if (hlo->users()[0]->opcode() == HloOpcode::kConcatenate ||
-          hlo->users()[0]->opcode() == HloOpcode::kDynamicSlice) {
+          hlo->users()[0]->opcode() == HloOpcode::kDynamicSlice ||
+          hlo->users()[0]->opcode() == HloOpcode::kGather) {
         continue;
       }
       TF_RET_CHECK(values.contains(hlo)) << hlo->ToString();
@@ -1223,6 +1262,14 @@ class MatMulEmitterHelper {
       TF_RETURN_IF_ERROR(
           AddDynamicSliceDimToTensorParams(b, hlo, side, properties, pid_offset,
                                            specs.back(), bases, tensor_params));
+    } else if (hlo->opcode() == HloOpcode::kGather &&
+               (side.scope == TritonFusionAnalysis::Scope::LHS ||
+                side.scope == TritonFusionAnalysis::Scope::RHS) &&
+               properties.index ==
+                   GetNonContractingDimIdxForOperandScope(side.scope)) {
+      TF_RETURN_IF_ERROR(AddGatherDimToTensorParams(b, hlo, properties,
+                                                    pid_offset, specs.back(),
+                                                    bases, tensor_params));
     } else {
       TF_RETURN_IF_ERROR(AddStandaloneDimToTensorParams(
           b, side, properties, pid_offset, specs.front(), bases, tensor_params,
@@ -1341,6 +1388,67 @@ class MatMulEmitterHelper {
     return absl::OkStatus();
   }
 
+  // Gathers index whole slices along the majormost dimension (e.g. pages of a
+  // paged KV cache selected by a block table), which are all part of the
+  // non-contracting dim. Every tile of that dim has to lie within one gathered
+  // slice so that it can be loaded with a single block pointer into the
+  // slice selected by the index of the tile.
+  absl::Status AddGatherDimToTensorParams(
+      EmitterLocOpBuilder b, const HloInstruction* hlo,
+      const DimProperties& properties, const Value pid_offset,
+      const TensorIterationSpec::DimIterationSpec* spec,
+      const ValueRange& bases, TensorParams& tensor_params) {
+    TF_RET_CHECK(spec->size() == 1);
+    const TensorIterationSpec::IterationSpecFragment only_fragment_of_nc_dim =
+        spec->at(0);
+    if (properties.split_value > 1) {
+      return UncompilableMatmul("Split gathered dimension is not supported.");
+    }
+
+    // How many "rows" (non-contracting dim values) are there in one gathered
+    // slice?
+    int64_t rows_per_slice = 1;
+    for (int i = 0; i < hlo->shape().dimensions().size() - 1; ++i) {
+      rows_per_slice *= hlo->shape().dimensions_minor(i);
+    }
+    rows_per_slice = rows_per_slice / only_fragment_of_nc_dim.stride;
+    if (rows_per_slice % properties.block_size != 0) {
+      return UncompilableMatmul(absl::StrCat(
+          "Gathered slice is not a multiple of the block size. block_size: ",
+          properties.block_size, " vs rows per gathered slice: ",
+          rows_per_slice));
+    }
+    Value rows_per_slice_val = Cst32(b, rows_per_slice);
+
+    // gather operands are (input, indices), so the index of the slice the
+    // tile lies in is at position pid_offset / rows_per_slice of bases[1].
+    Value index_ptr_val = AddPtr(
+        b, bases[1], b.create<ma::DivSIOp>(pid_offset, rows_per_slice_val));
+    Value index_val =
+        b.create<mt::LoadOp>(index_ptr_val, mt::CacheModifier::NONE,
+                             mt::EvictionPolicy::NORMAL,
+                             /*isVolatile=*/false);
+    index_val = triton::Cast(b, index_val, b.getI32Type());
+    index_val = b.create<ma::MaxSIOp>(index_val, Cst32(b, 0));
+    index_val = b.create<ma::MinSIOp>(
+        index_val, Cst32(b, hlo->operand(0)->shape().dimensions(0) - 1));
+
+    Value slice_offset_val_i32 =
+        b.create<ma::MulIOp>(index_val, rows_per_slice_val);
+    tensor_params.tensor_offsets.push_back(b.create<ma::AddIOp>(
+        slice_offset_val_i32,
+        b.create<ma::RemSIOp>(pid_offset, rows_per_slice_val)));
+
+    // Loads must not cross into the neighboring slices of the input.
+    Value slice_offset_val_i64 =
+        b.create<ma::ExtSIOp>(b.getI64Type(), slice_offset_val_i32);
+    tensor_params.bounds.push_back(
+        b.create<ma::AddIOp>(slice_offset_val_i64, Cst64(b, rows_per_slice)));
+
+    tensor_params.block_offsets.push_back(Cst32(b, 0));
+    return absl::OkStatus();
+  }
+
   absl::Status AddConcatDimToTensorParams(
       EmitterLocOpBuilder b, const HloInstruction* hlo, const Side& side,
       const DimProperties& properties, const ConcatParams& concat_params,
@@ -1481,9 +1589,10 @@ absl::StatusOr<SmallVector<Value>> GetArguments(mlir::FunctionOpInterface fn,
   if (input.opcode() == HloOpcode::kParameter) {
     return {{fn.getArgument(input.parameter_number())}};
   } else if (input.opcode() == HloOpcode::kConcatenate ||
-             input.opcode() == HloOpcode::kDynamicSlice) {
-    // As defined in GemmFusion, all inputs of concatenate and dynamic slice are
-    // parameters.
+             input.opcode() == HloOpcode::kDynamicSlice ||
+             input.opcode() == HloOpcode::kGather) {
+    // As defined in GemmFusion, all inputs of concatenate, dynamic slice and
+    // gather are parameters.
     SmallVector<Value> result;
     for (const HloInstruction* operand : input.operands()) {
       TF_RET_CHECK(operand->opcode() == HloOpcode::kParameter);
@@ -1504,7 +1613,8 @@ ConstHloInstructionSet ScopeInputs(const TritonFusionAnalysis& analysis,
   for (const HloInstruction* parameter : analysis.ScopeParameters(scope)) {
     if (absl::c_any_of(parameter->users(), [](const HloInstruction* user) {
           return user->opcode() == HloOpcode::kConcatenate ||
-                 user->opcode() == HloOpcode::kDynamicSlice;
+                 user->opcode() == HloOpcode::kDynamicSlice ||
+                 user->opcode() == HloOpcode::kGather;
         })) {
       // Concatenation is always the only user of its parameters by
       // construction.
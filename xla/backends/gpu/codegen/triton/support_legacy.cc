@@ -31,6 +31,7 @@ limitations under the License.
 #include "xla/primitive_util.h"
 #include "xla/service/gpu/backend_configs.pb.h"
 #include "xla/service/overload.h"
+#include "xla/shape.h"
 #include "xla/stream_executor/device_description.h"
 #include "xla/xla_data.pb.h"
 #include "tsl/platform/tensor_float_32_utils.h"
@@ -128,6 +129,15 @@ CodegenDecision IsInstructionSupportsDataTypes(
     switch (instr.opcode()) {
       case HloOpcode::kConvert:
         if (operand_type == S4) continue;
+        // Block scales of MX formats are only supported as inputs of converts
+        // to types that are used for the dequantization.
+        if (operand_type == F8E8M0FNU &&
+            std::holds_alternative<se::CudaComputeCapability>(gpu_version) &&
+            primitive_util::IsFloatingPointType(
+                instr.shape().element_type()) &&
+            !primitive_util::IsF8Type(instr.shape().element_type())) {
+          continue;
+        }
         [[fallthrough]];
       default:
         if (!IsTritonSupportedDataType(operand_type, gpu_version)) {
@@ -374,6 +384,61 @@ CodegenDecision IsTritonSupportedDynamicSlice(
   return CodegenDecision::Allow();
 }
 
+CodegenDecision IsTritonSupportedGather(const HloGatherInstruction& instr) {
+  const HloInstruction* input = instr.operand(0);
+  const HloInstruction* indices = instr.operand(1);
+  switch (indices->shape().element_type()) {
+    case S8:
+    case S16:
+    case S32:
+      break;  // supported
+    default:
+      return CodegenDecision::Forbid(
+          "Gather is only supported with S8, S16, or S32 indices.");
+  }
+
+  // The indices have to be a vector of row numbers, optionally with a
+  // trailing index vector dimension of size 1.
+  const GatherDimensionNumbers& dnums = instr.gather_dimension_numbers();
+  const Shape& indices_shape = indices->shape();
+  const int64_t index_vector_dim = dnums.index_vector_dim();
+  const bool has_index_vector_dim =
+      index_vector_dim < indices_shape.dimensions().size();
+  if (indices_shape.dimensions().size() != (has_index_vector_dim ? 2 : 1) ||
+      (has_index_vector_dim &&
+       (index_vector_dim != 1 || indices_shape.dimensions(1) != 1))) {
+    return CodegenDecision::Forbid("Unsupported gather indices shape.");
+  }
+
+  // Every index selects one whole slice along dimension 0 of the input, and
+  // the gathered slices are stacked along dimension 0 of the output, so apart
+  // from the size of dimension 0 the output has the same shape as the input.
+  const int64_t rank = input->shape().dimensions().size();
+  if (dnums.start_index_map().size() != 1 || dnums.start_index_map(0) != 0 ||
+      dnums.collapsed_slice_dims().size() != 1 ||
+      dnums.collapsed_slice_dims(0) != 0 ||
+      !dnums.operand_batching_dims().empty() ||
+      dnums.offset_dims().size() != rank - 1 ||
+      instr.shape().dimensions().size() != rank) {
+    return CodegenDecision::Forbid("Unsupported gather dimension numbers.");
+  }
+  for (int64_t i = 1; i < rank; ++i) {
+    if (dnums.offset_dims(i - 1) != i ||
+        instr.gather_slice_sizes()[i] != input->shape().dimensions(i)) {
+      return CodegenDecision::Forbid("Gather of partial slices.");
+    }
+  }
+
+  // Like with dynamic slices, only the major-most dimension can be indexed
+  // without introducing non-contiguous strides under tiling.
+  if (input->shape().layout().minor_to_major().back() != 0 ||
+      instr.shape().layout().minor_to_major().back() != 0) {
+    return CodegenDecision::Forbid(
+        "Unsupported gather on non-major-most dimension.");
+  }
+  return CodegenDecision::Allow();
+}
+
 CodegenDecision IsTritonSupportedInstruction(
     const HloInstruction& instr, const se::GpuComputeCapability& gpu_version) {
   if (instr.IsElementwise()) {
@@ -399,6 +464,9 @@ CodegenDecision IsTritonSupportedInstruction(
       return IsTritonSupportedDynamicSlice(
           *Cast<HloDynamicSliceInstruction>(&instr));
     }
+    case HloOpcode::kGather: {
+      return IsTritonSupportedGather(*Cast<HloGatherInstruction>(&instr));
+    }
     case HloOpcode::kBitcast:
     case HloOpcode::kTranspose:
     case HloOpcode::kSlice:
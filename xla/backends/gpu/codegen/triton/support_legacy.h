@@ -103,6 +103,11 @@ CodegenDecision IsTritonSupportedInstruction(
 CodegenDecision IsTritonSupportedDynamicSlice(
     const HloDynamicSliceInstruction& instr);
 
+// Checks gather against the requirements of the legacy Triton emitters. Only
+// gathers of whole slices along the major-most dimension of the operand, as
+// used to read pages of a paged KV cache through a block table, are supported.
+CodegenDecision IsTritonSupportedGather(const HloGatherInstruction& instr);
+
 }  // namespace legacy_triton
 }  // namespace gpu
 }  // namespace xla
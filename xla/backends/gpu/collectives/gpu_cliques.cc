@@ -580,6 +580,9 @@ absl::StatusOr<std::shared_ptr<LockableGpuClique::Lock>> AcquireGpuClique(
   config.blocking_communicators = true;
   config.async_execution = false;
 
+  // Acquired cliques are ordered from the largest to the smallest, so we split
+  // from the largest acquired superset clique. All participants of the parent
+  // clique pick the same parent, because they see the same acquired cliques.
   if (enable_nccl_comm_splitting) {
     for (auto& [acquired_clique_key, acquired_clique] : acquired_cliques) {
       if (clique_key.IsSubsetOf(acquired_clique_key)) {
@@ -591,6 +594,11 @@ absl::StatusOr<std::shared_ptr<LockableGpuClique::Lock>> AcquireGpuClique(
   }
 
   // If we can't split any of the acquired cliques, create a new one.
+  VLOG(3) << "Create GPU clique " << clique_key.ToString() << " rank #" << rank
+          << " from a new clique id; "
+          << (enable_nccl_comm_splitting
+                  ? "no acquired clique is a superset of the clique"
+                  : "communicator splitting is disabled");
   return InitializeGpuClique(collectives, device, run_id, clique_key,
                              clique_id_callback, num_local_participants, rank,
                              config);
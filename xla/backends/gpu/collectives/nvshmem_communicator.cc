@@ -14,21 +14,26 @@ limitations under the License.
 
 #include <cstddef>
 #include <cstdint>
+#include <optional>
 #include <string>
 
 #include "absl/status/status.h"
+#include "absl/container/inlined_vector.h"
 #include "absl/strings/str_format.h"
+#include "absl/types/span.h"
 #include "third_party/gpus/cuda/include/cuda_bf16.h"
 #include "third_party/gpus/cuda/include/cuda_fp16.h"
 #include "third_party/nvshmem/nvshmemx.h"
 #include "xla/backends/gpu/collectives/gpu_collectives.h"
 #include "xla/backends/gpu/collectives/nvshmem_collectives.h"
+#include "xla/core/collectives/rank_id.h"
 #include "xla/primitive_util.h"
 #include "xla/service/collective_ops_utils.h"
 #include "xla/stream_executor/device_memory.h"
 #include "xla/stream_executor/gpu/gpu_stream.h"
 #include "xla/stream_executor/stream.h"
 #include "xla/tsl/concurrency/async_value_ref.h"
+#include "xla/tsl/platform/errors.h"
 #include "xla/tsl/platform/logging.h"
 #include "xla/tsl/platform/statusor.h"
 #include "xla/util.h"
@@ -283,6 +288,101 @@ tsl::AsyncValueRef<NvshmemCommunicator::Event> NvshmemCommunicator::AllReduce(
   return OkEvent();
 }
 
+// Enqueues a put of `bytes` from the local `source_ptr` to `dest_ptr` on the
+// rank `peer` of the node team. `dest_ptr` must be a symmetric address.
+static absl::Status PutToPeer(void* dest_ptr, const void* source_ptr,
+                              size_t bytes, RankId peer, se::Stream* stream) {
+  int32_t pe = nvshmem_team_translate_pe(NVSHMEMX_TEAM_NODE, peer.value(),
+                                         NVSHMEM_TEAM_WORLD);
+  if (pe < 0) {
+    return absl::InvalidArgumentError(
+        absl::StrFormat("Invalid NVSHMEM peer rank %d", peer.value()));
+  }
+  nvshmemx_putmem_on_stream(dest_ptr, source_ptr, bytes, pe,
+                            se::gpu::AsGpuStreamValue(stream));
+  return absl::OkStatus();
+}
+
+// Waits for completion of all puts issued on the `stream`, and synchronizes
+// with all ranks of the node team, so that all puts targeting the current rank
+// are visible after the barrier.
+static absl::Status QuietAndBarrier(se::Stream* stream) {
+  auto gpu_stream = se::gpu::AsGpuStreamValue(stream);
+  nvshmemx_quiet_on_stream(gpu_stream);
+  if (nvshmemx_barrier_on_stream(NVSHMEMX_TEAM_NODE, gpu_stream) != 0) {
+    return absl::InternalError("Nvshmem team barrier failed.");
+  }
+  return absl::OkStatus();
+}
+
+tsl::AsyncValueRef<NvshmemCommunicator::Event> NvshmemCommunicator::AllToAll(
+    absl::InlinedVector<se::DeviceMemoryBase, 4> send_buffers,
+    absl::InlinedVector<se::DeviceMemoryBase, 4> recv_buffers,
+    PrimitiveType dtype, size_t count, const Executor& executor) {
+  if (aborted_) {
+    return absl::FailedPreconditionError("NvshmemCommunicator aborted");
+  }
+  if (!collectives_->IsInitialized()) {
+    return FailedPrecondition("NvshmemCollectives not initialized.");
+  }
+  if (send_buffers.size() != recv_buffers.size()) {
+    return InvalidArgument(
+        "Number of send buffers must match number of recv buffers: %d != %d",
+        send_buffers.size(), recv_buffers.size());
+  }
+
+  TF_ASSIGN_OR_RETURN(se::Stream * stream, ToStream(executor));
+  TF_ASSIGN_OR_RETURN(size_t rank, CurrentRank());
+
+  size_t bytes = count * primitive_util::ByteWidth(dtype);
+  VLOG(3) << absl::StreamFormat(
+      "Launch NVSHMEM AllToAll operation on device #%d; dtype=%s; count=%d; "
+      "comm=node; stream=%p",
+      rank, primitive_util::LowercasePrimitiveTypeName(dtype), count, stream);
+
+  // Rank `i` receives our `i`-th send buffer into its `rank`-th recv buffer.
+  for (size_t i = 0; i < send_buffers.size(); ++i) {
+    TF_RETURN_IF_ERROR(PutToPeer(recv_buffers[rank].opaque(),
+                                 send_buffers[i].opaque(), bytes, RankId(i),
+                                 stream));
+  }
+  TF_RETURN_IF_ERROR(QuietAndBarrier(stream));
+  return OkEvent();
+}
+
+tsl::AsyncValueRef<NvshmemCommunicator::Event>
+NvshmemCommunicator::CollectivePermute(
+    se::DeviceMemoryBase send_buffer, se::DeviceMemoryBase recv_buffer,
+    PrimitiveType dtype, size_t count, std::optional<RankId> source_rank,
+    absl::Span<const RankId> target_ranks, const Executor& executor) {
+  if (aborted_) {
+    return absl::FailedPreconditionError("NvshmemCommunicator aborted");
+  }
+  if (!collectives_->IsInitialized()) {
+    return FailedPrecondition("NvshmemCollectives not initialized.");
+  }
+
+  TF_ASSIGN_OR_RETURN(se::Stream * stream, ToStream(executor));
+
+  size_t bytes = count * primitive_util::ByteWidth(dtype);
+  VLOG(3) << absl::StreamFormat(
+      "Launch NVSHMEM CollectivePermute operation on device #%d; "
+      "send_buffer=%p; recv_buffer=%p; dtype=%s; count=%d; "
+      "num_targets=%d; comm=node; stream=%p",
+      nvshmem_team_my_pe(NVSHMEMX_TEAM_NODE), send_buffer.opaque(),
+      recv_buffer.opaque(), primitive_util::LowercasePrimitiveTypeName(dtype),
+      count, target_ranks.size(), stream);
+
+  // Data is pushed by the senders, so `source_rank` is not needed here. All
+  // ranks join the barrier, which makes data from the source rank visible.
+  for (RankId target_rank : target_ranks) {
+    TF_RETURN_IF_ERROR(PutToPeer(recv_buffer.opaque(), send_buffer.opaque(),
+                                 bytes, target_rank, stream));
+  }
+  TF_RETURN_IF_ERROR(QuietAndBarrier(stream));
+  return OkEvent();
+}
+
 std::string NvshmemCommunicator::ToString() const {
   return absl::StrFormat("NvshmemCommunicator(nvshmem_team_t=%d)",
                          NVSHMEMX_TEAM_NODE);
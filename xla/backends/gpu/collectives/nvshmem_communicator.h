@@ -83,20 +83,18 @@ class NvshmemCommunicator : public Communicator {
     return absl::UnimplementedError("Not implemented.");
   };
 
+  // AllToAll and CollectivePermute are implemented with one-sided puts into
+  // the receive buffers of peers, and require receive buffers to be allocated
+  // from the NVSHMEM symmetric heap (at the same address on all ranks).
   tsl::AsyncValueRef<Event> AllToAll(
       absl::InlinedVector<se::DeviceMemoryBase, 4> send_buffers,
       absl::InlinedVector<se::DeviceMemoryBase, 4> recv_buffers,
-      PrimitiveType dtype, size_t count, const Executor& executor) final {
-    return absl::UnimplementedError("Not implemented.");
-  };
+      PrimitiveType dtype, size_t count, const Executor& executor) final;
 
   tsl::AsyncValueRef<Event> CollectivePermute(
       se::DeviceMemoryBase send_buffer, se::DeviceMemoryBase recv_buffer,
       PrimitiveType dtype, size_t count, std::optional<RankId> source_rank,
-      absl::Span<const RankId> target_ranks, const Executor& executor) final {
-    return absl::UnimplementedError("Not implemented.");
-  };
-  ;
+      absl::Span<const RankId> target_ranks, const Executor& executor) final;
 
   tsl::AsyncValueRef<Event> Send(se::DeviceMemoryBase send_buffer,
                                  PrimitiveType dtype, size_t count, RankId peer,
@@ -55,7 +55,12 @@ struct OrPredTag {
   static constexpr ReductionKind kReductionKind = ReductionKind::MAX;
 };
 
-template <typename T>
+// Inputs up to this size always use the one-shot strategy. For larger inputs
+// the one-shot kernel is bound by reading `num_ranks` full buffers from peers,
+// and the two-shot kernel is faster despite the extra synchronization round.
+constexpr int64_t kMaxOneShotStrategySizeBytes = 128 * 1024;  // 128 KB
+
+template <typename T, AllReduceStrategy kAllReduceStrategy>
 absl::Status LaunchTypedKernel(
     se::Stream* stream, const LaunchDimensions& launch_dimensions,
     absl::Span<const se::DeviceMemoryBase> remote_input_buffers,
@@ -67,8 +72,8 @@ absl::Status LaunchTypedKernel(
   TF_ASSIGN_OR_RETURN(
       auto kernel,
       (se::gpu::GpuKernelRegistry::GetGlobalRegistry()
-           .LoadKernel<
-               se::gpu::AllReduceKernel<ElementType, T::kReductionKind>>(
+           .LoadKernel<se::gpu::AllReduceKernel<
+               ElementType, T::kReductionKind, kAllReduceStrategy>>(
                stream->parent())));
 
   std::array<ElementType*, stream_executor::gpu::kMaxNumAllReduceInputPtrs>
@@ -94,6 +99,16 @@ absl::Status LaunchTypedKernel(
 }
 }  // namespace
 
+AllReduceStrategy GetAllReduceStrategy(int64_t input_size_bytes,
+                                       int64_t num_ranks) {
+  // With two ranks both strategies read the same amount of data from the peer,
+  // and one-shot needs fewer synchronization rounds.
+  if (num_ranks <= 2 || input_size_bytes <= kMaxOneShotStrategySizeBytes) {
+    return AllReduceStrategy::kOneShot;
+  }
+  return AllReduceStrategy::kTwoShot;
+}
+
 bool IsAllReduceKernelSupported(int64_t num_inputs, int64_t num_elements,
                                 PrimitiveType element_type,
                                 ReductionKind reduction_kind) {
@@ -124,6 +139,7 @@ bool IsAllReduceKernelSupported(int64_t num_inputs, int64_t num_elements,
 absl::Status RunAllReduceKernel(
     se::Stream* stream, const LaunchDimensions& launch_dimensions,
     PrimitiveType element_type, ReductionKind reduction_kind,
+    AllReduceStrategy strategy,
     absl::Span<const se::DeviceMemoryBase> remote_input_buffers,
     se::DeviceMemoryBase local_input_buffer, se::DeviceMemoryBase output_buffer,
     RankId rank, int64_t num_ranks, int64_t num_elements,
@@ -148,9 +164,16 @@ absl::Status RunAllReduceKernel(
   auto launch_kernel = [&](auto type) -> absl::Status {
     using T = decltype(type);
 
-    return LaunchTypedKernel<T>(stream, launch_dimensions, remote_input_buffers,
-                                local_input_buffer, output_buffer, rank.value(),
-                                num_ranks, num_elements, signal_flags_buffers);
+    if (strategy == AllReduceStrategy::kTwoShot) {
+      return LaunchTypedKernel<T, AllReduceStrategy::kTwoShot>(
+          stream, launch_dimensions, remote_input_buffers, local_input_buffer,
+          output_buffer, rank.value(), num_ranks, num_elements,
+          signal_flags_buffers);
+    }
+    return LaunchTypedKernel<T, AllReduceStrategy::kOneShot>(
+        stream, launch_dimensions, remote_input_buffers, local_input_buffer,
+        output_buffer, rank.value(), num_ranks, num_elements,
+        signal_flags_buffers);
   };
 
   if (element_type == F32 && reduction_kind == ReductionKind::SUM) {
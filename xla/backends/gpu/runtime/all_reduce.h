@@ -24,6 +24,7 @@ limitations under the License.
 #include "xla/service/collective_ops_utils.h"
 #include "xla/service/gpu/launch_dimensions.h"
 #include "xla/stream_executor/device_memory.h"
+#include "xla/stream_executor/gpu/all_reduce_kernel.h"
 #include "xla/stream_executor/stream.h"
 #include "xla/types.h"  // IWYU pragma: keep
 #include "xla/xla_data.pb.h"
@@ -36,6 +37,13 @@ bool IsAllReduceKernelSupported(int64_t num_inputs, int64_t num_elements,
                                 PrimitiveType element_type,
                                 ReductionKind reduction_kind);
 
+using AllReduceStrategy = ::stream_executor::gpu::AllReduceStrategy;
+
+// Returns the all-reduce kernel strategy with the lowest expected latency for
+// the given input size and number of participating ranks.
+AllReduceStrategy GetAllReduceStrategy(int64_t input_size_bytes,
+                                       int64_t num_ranks);
+
 // Performs element-wise addition of all input buffers and stores the result in
 // the output buffer.
 // The kernel is intended to be used for all-reduce operations in environment
@@ -46,6 +54,10 @@ bool IsAllReduceKernelSupported(int64_t num_inputs, int64_t num_elements,
 // The kernel copies data from local input buffer to remote input buffer of the
 // current rank at the start of the kernel.
 //
+// With the two-shot strategy, the remote input buffer of each rank is also
+// used to store the reduced slice owned by that rank, which is then gathered
+// by all other ranks.
+//
 // The kernel performs synchronization across devices at the start and the end
 // of the kernel. The synchronization happens between blocks with the same id.
 //
@@ -57,6 +69,7 @@ bool IsAllReduceKernelSupported(int64_t num_inputs, int64_t num_elements,
 //    the output buffer.
 //  - output_buffer: The buffer to store the result.
 //  - rank: Identifier of the device.
+//  - strategy: The algorithm used by the kernel.
 //  - num_ranks: The number of devices participating in the operation.
 //  - num_elements: The number of elements in each buffer.
 //  - signal_flags_buffers: A list of buffers with signal flags that are used to
@@ -67,6 +80,7 @@ absl::Status RunAllReduceKernel(
     const LaunchDimensions& launch_dimensions,                    //
     PrimitiveType element_type,                                   //
     ReductionKind reduction_kind,                                 //
+    AllReduceStrategy strategy,                                   //
     absl::Span<const se::DeviceMemoryBase> remote_input_buffers,  //
     se::DeviceMemoryBase local_input_buffer,                      //
     se::DeviceMemoryBase output_buffer,                           //
@@ -59,7 +59,8 @@ class AllReduceKernelTest : public ::testing::Test {
   template <typename T>
   static absl::StatusOr<std::vector<Array<T>>> RunKernel(
       const std::vector<se::StreamExecutor*>& executors,
-      const std::vector<Array<T>>& input_data, ReductionKind reduction_kind) {
+      const std::vector<Array<T>>& input_data, ReductionKind reduction_kind,
+      AllReduceStrategy strategy = AllReduceStrategy::kOneShot) {
     constexpr LaunchDimensions kLaunchDimensions{
         /*block_x_count=*/8,
         /*thread_x_count_per_block=*/512};
@@ -115,7 +116,8 @@ class AllReduceKernelTest : public ::testing::Test {
       TF_RETURN_IF_ERROR(RunAllReduceKernel(
           streams[i].get(), kLaunchDimensions,
           primitive_util::NativeToPrimitiveType<T>(),
-          /*reduction_kind=*/reduction_kind, remote_input_buffers_span,
+          /*reduction_kind=*/reduction_kind, strategy,
+          remote_input_buffers_span,
           // Memory is aliased for both input and output (similar to what nccl
           // would do).
           /*local_input_buffer=*/local_input_buffers[i].memory(),
@@ -177,6 +179,53 @@ TEST_F(AllReduceKernelTest, KernelTestAddF32) {
   }
 }
 
+TEST_F(AllReduceKernelTest, KernelTestAddF32TwoShot) {
+  constexpr int64_t kNumRanks = 2;
+  // Not a multiple of the number of ranks times the vector size, so that the
+  // last slice is partial.
+  constexpr int64_t kNumElements = 128004;
+
+  std::vector<se::StreamExecutor*> executors = {GetGpuExecutor(0),
+                                                GetGpuExecutor(1)};
+
+  if (!executors[0]->CanEnablePeerAccessTo(executors[1])) {
+    GTEST_SKIP() << "Test requires direct peer memory access between devices.";
+  }
+
+  Array<float> expected_output({kNumElements});
+  std::vector<Array<float>> inputs;
+
+  for (int i = 0; i < kNumRanks; ++i) {
+    Array<float> input_data({kNumElements});
+    input_data.FillRandom(0.0f, 10.0f, /*seed=*/i);
+
+    expected_output.Each([&](absl::Span<const int64_t> indices, float* val) {
+      *val += input_data(indices);
+    });
+
+    inputs.push_back(std::move(input_data));
+  }
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto results, RunKernel<float>(executors, inputs, ReductionKind::SUM,
+                                     AllReduceStrategy::kTwoShot));
+
+  for (int i = 0; i < kNumRanks; ++i) {
+    EXPECT_EQ(results[i], expected_output);
+  }
+}
+
+TEST(AllReduceStrategyTest, SelectsStrategyBySizeAndNumRanks) {
+  EXPECT_EQ(GetAllReduceStrategy(/*input_size_bytes=*/1024, /*num_ranks=*/8),
+            AllReduceStrategy::kOneShot);
+  EXPECT_EQ(GetAllReduceStrategy(/*input_size_bytes=*/1024 * 1024,
+                                 /*num_ranks=*/2),
+            AllReduceStrategy::kOneShot);
+  EXPECT_EQ(GetAllReduceStrategy(/*input_size_bytes=*/1024 * 1024,
+                                 /*num_ranks=*/8),
+            AllReduceStrategy::kTwoShot);
+}
+
 TEST_F(AllReduceKernelTest, KernelTestAddBF16) {
   constexpr int64_t kNumRanks = 2;
   constexpr int64_t kNumElements = 128000;
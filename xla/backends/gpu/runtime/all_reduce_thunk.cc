@@ -49,7 +49,9 @@ namespace xla {
 namespace gpu {
 namespace {
 
-constexpr int64_t kMaxOneShotAllReduceSizeBytes = 256 * 1024;  // 256 KB
+// All-reduce kernels are only used for inputs up to this size. Larger inputs
+// are bandwidth bound, and NCCL launch overheads don't matter for them.
+constexpr int64_t kMaxAllReduceKernelSizeBytes = 1024 * 1024;  // 1 MB
 
 absl::Status CheckImplementableInst(const HloInstruction* inst,
                                     Thunk::Kind reduction_op) {
@@ -170,8 +172,8 @@ absl::StatusOr<bool> AllReduceStartThunk::ShouldUseOneShotAllReduceKernel(
   int64_t input_size_bytes =
       num_elements * ShapeUtil::ByteSizeOfPrimitiveType(element_type);
 
-  // One-shot all-reduce is only beneficial for small inputs.
-  if (input_size_bytes > kMaxOneShotAllReduceSizeBytes) {
+  // All-reduce kernels are only beneficial for small inputs.
+  if (input_size_bytes > kMaxAllReduceKernelSizeBytes) {
     return false;
   }
 
@@ -202,14 +202,19 @@ absl::Status CollectiveKernelThunk::ExecuteOnStream(
         << "Stream not found in per_stream_state_";
     state = it->second.get();
   }
-  VLOG(3) << "Performing one-shot all-reduce from device ordinal: "
-          << device_ordinal << " for clique " << clique_key.ToString();
+  const AllReduceStrategy strategy = GetAllReduceStrategy(
+      buffer_.source_buffer.size(), clique_key.num_devices());
+  VLOG(3) << "Performing "
+          << (strategy == AllReduceStrategy::kOneShot ? "one-shot" : "two-shot")
+          << " all-reduce from device ordinal: " << device_ordinal
+          << " for clique " << clique_key.ToString();
   // TODO(b/407736956): Change this to emitted kernel.
   return RunAllReduceKernel(
       /*stream=*/stream,
       /*launch_dimensions=*/kLaunchDimensions,
       /*element_type=*/element_type,
       /*reduction_kind=*/reduction_kind_,
+      /*strategy=*/strategy,
       /*remote_input_buffers=*/state->remote_buffer_ptrs,
       /*local_input_buffer=*/source_buffer,
       /*output_buffer=*/destination_buffer,
@@ -280,18 +280,23 @@ CommandBufferCmdExecutor::CommandBufferCmdExecutor(
   // Buffer allocations referenced by commands in this sequence.
   absl::btree_set<BufferAllocation::Index> allocs_indices;
 
-  for (const std::unique_ptr<CommandBufferCmd>& cmd : commands_) {
-    absl::btree_set<BufferAllocation::Index> cmd_allocs_indices;
-
-    for (const BufferUse& buffer : cmd->buffers()) {
+  for (CommandId id = 0; id < commands_.size(); ++id) {
+    for (const BufferUse& buffer : commands_[id]->buffers()) {
       buffers_.insert(buffer);
       allocs_indices.insert(buffer.slice().index());
-      cmd_allocs_indices.insert(buffer.slice().index());
-    }
 
-    // Record buffer allocations indices referenced by the `cmd`.
-    cmd_allocs_indices_.emplace_back(cmd_allocs_indices.begin(),
-                                     cmd_allocs_indices.end());
+      // Record that command `id` references buffer allocation. Commands are
+      // visited in order, so we only have to check the last recorded id to
+      // skip duplicates.
+      BufferAllocation::Index index = buffer.slice().index();
+      if (alloc_cmds_ids_.size() <= index) {
+        alloc_cmds_ids_.resize(index + 1);
+      }
+      std::vector<CommandId>& cmds_ids = alloc_cmds_ids_[index];
+      if (cmds_ids.empty() || cmds_ids.back() != id) {
+        cmds_ids.push_back(id);
+      }
+    }
   }
 
   // Record all buffer allocations indices referenced by all commands in this
@@ -429,42 +434,9 @@ absl::Status CommandBufferCmdExecutor::RecordUpdate(
   // Keep a state associated with commands in the sequence in the state manager.
   CommandBufferCmd::StateManager& state = record_params.state;
 
-  // Check if command `id` has to be updated based on the buffer allocations
-  // that changed since the last call to `Record`. We keep intersection vector
-  // outside of a lambda to avoid repeated heap allocations on every call.
-  std::vector<BufferAllocation::Index> alloc_intersection;
-  auto skip_command_update = [&](CommandId id) {
-    // If we don't know what allocations changed since the last call to
-    // `Record` we must always update the command.
-    if (!record_params.updated_allocs) {
-      return false;
-    }
+  std::vector<CommandId> update_cmds_ids = CommandsToUpdate(record_params);
 
-    // We always update commands that require initialization, even if buffer
-    // allocations didn't change.
-    CommandBufferCmd* command = commands_[id].get();
-    if (command->requires_initialization() && record_params.is_initialization) {
-      return false;
-    }
-
-    DCHECK(absl::c_is_sorted(*record_params.updated_allocs))
-        << "Updated allocs must be sorted: "
-        << absl::StrJoin(*record_params.updated_allocs, ", ");
-
-    DCHECK(absl::c_is_sorted(cmd_allocs_indices_[id]))
-        << "Command allocs must be sorted: "
-        << absl::StrJoin(cmd_allocs_indices_[id], ", ");
-
-    alloc_intersection.clear();
-    absl::c_set_intersection(cmd_allocs_indices_[id],
-                             *record_params.updated_allocs,
-                             std::back_inserter(alloc_intersection));
-    return alloc_intersection.empty();
-  };
-
-  size_t num_skipped_command_updates = 0;
-
-  for (CommandId id = 0; id < commands_.size(); ++id) {
+  for (CommandId id : update_cmds_ids) {
     CommandBufferCmd* command = commands_[id].get();
 
     std::optional<tsl::profiler::ScopedAnnotation> annotation =
@@ -476,12 +448,6 @@ absl::Status CommandBufferCmdExecutor::RecordUpdate(
       continue;
     }
 
-    // Skip updating command if it doesn't use any of the updated allocations.
-    if (skip_command_update(id)) {
-      ++num_skipped_command_updates;
-      continue;
-    }
-
     // Update existing commands in the command buffer.
     auto* record_state = state.GetOrNull<RecordState>(command, command_buffer);
     DCHECK(record_state) << "Record state must be not null for "
@@ -494,6 +460,9 @@ absl::Status CommandBufferCmdExecutor::RecordUpdate(
                         command_buffer));
   }
 
+  size_t num_skipped_command_updates =
+      commands_.size() - update_cmds_ids.size();
+
   uint64_t end_micros = tsl::Env::Default()->NowMicros();
   VLOG(1) << "Updated " << commands_.size() << " commands in "
           << (end_micros - start_micros) << " μs (skipped "
@@ -502,6 +471,46 @@ absl::Status CommandBufferCmdExecutor::RecordUpdate(
   return absl::OkStatus();
 }
 
+std::vector<CommandBufferCmdExecutor::CommandId>
+CommandBufferCmdExecutor::CommandsToUpdate(
+    const RecordParams& record_params) const {
+  std::vector<CommandId> cmds_ids;
+
+  // If we don't know what allocations changed since the last call to `Record`
+  // we must always update all commands.
+  if (!record_params.updated_allocs) {
+    cmds_ids.resize(commands_.size());
+    absl::c_iota(cmds_ids, 0);
+    return cmds_ids;
+  }
+
+  DCHECK(absl::c_is_sorted(*record_params.updated_allocs))
+      << "Updated allocs must be sorted: "
+      << absl::StrJoin(*record_params.updated_allocs, ", ");
+
+  // Collect commands that reference any of the updated allocations.
+  for (BufferAllocation::Index index : *record_params.updated_allocs) {
+    if (index < alloc_cmds_ids_.size()) {
+      absl::c_copy(alloc_cmds_ids_[index], std::back_inserter(cmds_ids));
+    }
+  }
+
+  // We always update commands that require initialization, even if buffer
+  // allocations didn't change.
+  if (record_params.is_initialization) {
+    for (CommandId id = 0; id < commands_.size(); ++id) {
+      if (commands_[id]->requires_initialization()) {
+        cmds_ids.push_back(id);
+      }
+    }
+  }
+
+  absl::c_sort(cmds_ids);
+  cmds_ids.erase(std::unique(cmds_ids.begin(), cmds_ids.end()),
+                 cmds_ids.end());
+  return cmds_ids;
+}
+
 absl::Status CommandBufferCmdExecutor::CheckCommandBufferState(
     se::CommandBuffer* command_buffer,
     se::CommandBuffer::State expected_state) const {
@@ -1257,7 +1266,7 @@ absl::StatusOr<const se::CommandBuffer::Command*> CublasLtCmd::Record(
     se::CommandBuffer* command_buffer) {
   // This call is required to make sure matmul plan is already created and
   // cached before recording the command buffer.
-  TF_RETURN_IF_ERROR(GetCachedMatmulPlan(execute_params).status());
+  TF_RETURN_IF_ERROR(GetCachedMatmulPlan(execute_params.stream).status());
 
   VLOG(5) << "CublasLtCmd:";
   VLOG(5) << "  a_buffer: " << a_.ToString();
@@ -1432,38 +1441,27 @@ CustomCallCmd::RecordLegacyCustomCall(
     const Thunk::ExecuteParams& execute_params,
     const RecordParams& record_params, RecordAction record_action,
     se::CommandBuffer* command_buffer) {
-  std::vector<void*> buffers;
-  buffers.reserve(operands_.size() + results_.size());
-
   VLOG(5) << "CustomCallCmd: target_name=" << target_name_;
-  TF_RETURN_IF_ERROR(
-      GetBuffers(execute_params, operands_, buffers, "  Operand "));
-  TF_RETURN_IF_ERROR(
-      GetBuffers(execute_params, results_, buffers, "  Result "));
 
-  TF_ASSIGN_OR_RETURN(
-      auto nested_cmd,
-      se::TraceCommandBufferFactory::Create(
-          execute_params.stream->parent(),
-          execute_params.command_buffer_trace_stream, [&](se::Stream* stream) {
-            XlaCustomCallStatus custom_call_status;
-            call_target_(stream, buffers.data(), opaque_.data(), opaque_.size(),
-                         &custom_call_status);
-            auto message = CustomCallStatusGetMessage(&custom_call_status);
-            if (message) {
-              return absl::InternalError(
-                  absl::StrCat("CustomCall failed: ", *message));
-            }
-            return absl::OkStatus();
-          }));
-
-  return Handle(
-      std::move(record_action),
-      [&](absl::Span<const se::CommandBuffer::Command* const> dependencies) {
-        return command_buffer->CreateNestedCommand(*nested_cmd, dependencies);
-      },
-      [&](const se::CommandBuffer::Command* command) {
-        return command_buffer->UpdateNestedCommand(command, *nested_cmd);
+  return RecordTracedCommand(
+      execute_params, record_params, std::move(record_action), command_buffer,
+      [&](se::Stream* stream) -> absl::Status {
+        std::vector<void*> buffers;
+        buffers.reserve(operands_.size() + results_.size());
+        TF_RETURN_IF_ERROR(
+            GetBuffers(execute_params, operands_, buffers, "  Operand "));
+        TF_RETURN_IF_ERROR(
+            GetBuffers(execute_params, results_, buffers, "  Result "));
+
+        XlaCustomCallStatus custom_call_status;
+        call_target_(stream, buffers.data(), opaque_.data(), opaque_.size(),
+                     &custom_call_status);
+        auto message = CustomCallStatusGetMessage(&custom_call_status);
+        if (message) {
+          return absl::InternalError(
+              absl::StrCat("CustomCall failed: ", *message));
+        }
+        return absl::OkStatus();
       });
 }
 
@@ -1472,77 +1470,46 @@ CustomCallCmd::RecordXlaFfiCall(const Thunk::ExecuteParams& execute_params,
                                 const RecordParams& record_params,
                                 RecordAction record_action,
                                 se::CommandBuffer* command_buffer) {
-  // TODO(ezhulenev): This is not the most optimal approach, as we'll be doing
-  // a lot of extra allocation on every call. We have to keep attributes
-  // separate from arguments, as they do not change after thunk is
-  // constructed.
-  ffi::CallFrameBuilder builder(operands_.size(), results_.size());
-
   VLOG(5) << "CustomCallCmd: target_name=" << target_name_;
 
-  absl::InlinedVector<se::DeviceMemoryBase, 4> arguments;
-  arguments.reserve(operands_.size());
-
-  for (int i = 0; i < operands_.size(); ++i) {
-    const std::optional<Slice>& slice = operands_[i];
-    if (!slice.has_value()) {
-      arguments.push_back(se::DeviceMemoryBase{});
-      continue;
-    }
-
-    se::DeviceMemoryBase buffer =
-        execute_params.buffer_allocations->GetDeviceAddress(slice->slice);
-    VLOG(5) << "  Operand " << i << ": " << slice->slice << " ("
-            << buffer.opaque() << ")";
-    arguments.push_back(buffer);
-  }
-
-  absl::InlinedVector<se::DeviceMemoryBase, 4> results;
-  results.reserve(results_.size());
-
-  for (int i = 0; i < results_.size(); ++i) {
-    const std::optional<Slice>& slice = results_[i];
+  auto device_address =
+      [&](const std::optional<Slice>& slice) -> se::DeviceMemoryBase {
     if (!slice.has_value()) {
-      results.push_back(se::DeviceMemoryBase{});
-      continue;
+      return se::DeviceMemoryBase{};
     }
+    return execute_params.buffer_allocations->GetDeviceAddress(slice->slice);
+  };
 
-    se::DeviceMemoryBase buffer =
-        execute_params.buffer_allocations->GetDeviceAddress(slice->slice);
-    VLOG(5) << "  Result " << i << ": " << slice->slice << " ("
-            << buffer.opaque() << ")";
-    results.push_back(buffer);
-  }
-
-  // Borrow the FFI call frame from the object pool and update with the actual
-  // device memory addresses.
-  TF_ASSIGN_OR_RETURN(auto call_frame, call_frames_->GetOrCreate());
-  TF_RETURN_IF_ERROR(call_frame->UpdateWithBuffers(arguments, results));
-
-  RunId run_id = execute_params.collective_params->run_id;
+  return RecordTracedCommand(
+      execute_params, record_params, std::move(record_action), command_buffer,
+      [&](se::Stream* stream) -> absl::Status {
+        absl::InlinedVector<se::DeviceMemoryBase, 4> arguments;
+        arguments.reserve(operands_.size());
+        for (int i = 0; i < operands_.size(); ++i) {
+          arguments.push_back(device_address(operands_[i]));
+          VLOG(5) << "  Operand " << i << ": " << arguments.back().opaque();
+        }
 
-  TF_ASSIGN_OR_RETURN(
-      auto nested_cmd,
-      se::TraceCommandBufferFactory::Create(
-          execute_params.stream->parent(),
-          execute_params.command_buffer_trace_stream, [&](se::Stream* stream) {
-            ffi::CallOptions options = {
-                run_id, execute_params.buffer_allocations->device_ordinal(),
-                ffi::CallOptions::GpuOptions{
-                    stream,
-                    execute_params.buffer_allocations->memory_allocator()},
-                /*called_computation=*/nullptr,  // TODO(b/342285364)
-                execute_params.ffi_execution_context};
-            return ffi::Call(handler_, *call_frame, options);
-          }));
+        absl::InlinedVector<se::DeviceMemoryBase, 4> results;
+        results.reserve(results_.size());
+        for (int i = 0; i < results_.size(); ++i) {
+          results.push_back(device_address(results_[i]));
+          VLOG(5) << "  Result " << i << ": " << results.back().opaque();
+        }
 
-  return Handle(
-      std::move(record_action),
-      [&](absl::Span<const se::CommandBuffer::Command* const> dependencies) {
-        return command_buffer->CreateNestedCommand(*nested_cmd, dependencies);
-      },
-      [&](const se::CommandBuffer::Command* command) {
-        return command_buffer->UpdateNestedCommand(command, *nested_cmd);
+        // Borrow the FFI call frame from the object pool and update with the
+        // actual device memory addresses.
+        TF_ASSIGN_OR_RETURN(auto call_frame, call_frames_->GetOrCreate());
+        TF_RETURN_IF_ERROR(call_frame->UpdateWithBuffers(arguments, results));
+
+        ffi::CallOptions options = {
+            execute_params.collective_params->run_id,
+            execute_params.buffer_allocations->device_ordinal(),
+            ffi::CallOptions::GpuOptions{
+                stream, execute_params.buffer_allocations->memory_allocator()},
+            /*called_computation=*/nullptr,  // TODO(b/342285364)
+            execute_params.ffi_execution_context};
+        return ffi::Call(handler_, *call_frame, options);
       });
 }
 
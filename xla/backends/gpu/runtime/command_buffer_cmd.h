@@ -430,6 +430,12 @@ class CommandBufferCmdExecutor {
   // Returns true if command is not a dependency of any other commands.
   bool IsSink(CommandId id) const;
 
+  // Returns ids of commands that have to be updated (sorted by the command id)
+  // based on the buffer allocations that changed since the last call to
+  // `Record`.
+  std::vector<CommandId> CommandsToUpdate(
+      const RecordParams& record_params) const;
+
   // Returns dependencies of the command with the given id.
   std::vector<const se::CommandBuffer::Command*> Dependencies(
       const RecordParams& record_params, se::CommandBuffer* command_buffer,
@@ -449,9 +455,11 @@ class CommandBufferCmdExecutor {
   // sequence (sorted by the buffer allocation index).
   std::vector<BufferAllocation::Index> allocs_indices_;
 
-  // A mapping from command id to unique buffer allocations indices referenced
-  // by the command (sorted by the buffer allocation index).
-  std::vector<std::vector<BufferAllocation::Index>> cmd_allocs_indices_;
+  // A mapping from buffer allocation index to ids of commands that reference
+  // it (sorted by the command id). We use it to find commands that have to be
+  // updated when buffer allocations change, without visiting all commands in
+  // the sequence.
+  std::vector<std::vector<CommandId>> alloc_cmds_ids_;
 };
 
 //===----------------------------------------------------------------------===//
@@ -809,7 +817,10 @@ class CuDnnCmd : public TracedCommandBufferCmd {
 // CustomCallCmd
 //===----------------------------------------------------------------------===//
 
-class CustomCallCmd : public CommandBufferCmd {
+// Custom calls are recorded by tracing the stream activities of the handler.
+// Traced command buffers are cached by buffer addresses, so handlers are not
+// called again when a command buffer is updated with the same buffers.
+class CustomCallCmd : public TracedCommandBufferCmd {
  public:
   using Slice = CustomCallThunk::Slice;
   using CustomCallTarget = CustomCallThunk::CustomCallTarget;
@@ -822,8 +833,8 @@ class CustomCallCmd : public CommandBufferCmd {
                 std::vector<std::optional<Slice>> operands,
                 std::vector<std::optional<Slice>> results,
                 absl::string_view opaque)
-      : CommandBufferCmd(CommandBufferCmdType::kCustomCallCmd,
-                         execution_stream_id),
+      : TracedCommandBufferCmd(CommandBufferCmdType::kCustomCallCmd,
+                               execution_stream_id),
         target_name_(std::move(target_name)),
         call_target_(std::move(call_target)),
         opaque_(opaque),
@@ -836,8 +847,8 @@ class CustomCallCmd : public CommandBufferCmd {
                 std::vector<std::optional<Slice>> results,
                 ffi::CallFrame call_frame,
                 const HloComputation* called_computation)
-      : CommandBufferCmd(CommandBufferCmdType::kCustomCallCmd,
-                         execution_stream_id),
+      : TracedCommandBufferCmd(CommandBufferCmdType::kCustomCallCmd,
+                               execution_stream_id),
         target_name_(std::move(target_name)),
         handler_(handler),
         call_frame_(std::move(call_frame)),
@@ -18,6 +18,7 @@ limitations under the License.
 #include <array>
 #include <cstdint>
 #include <utility>
+#include <variant>
 #include <vector>
 
 #include "absl/functional/function_ref.h"
@@ -228,6 +229,34 @@ TEST(CommandBufferCmdTest, WriteConflictBarrier) {
   // TODO(ezhulenev): Check that executor correctly infer dependencies.
 }
 
+// A command buffer cmd that doesn't record anything into the command buffer,
+// and counts how many times it was asked to update a previously recorded
+// command.
+class UpdateCountingCmd : public CommandBufferCmd {
+ public:
+  UpdateCountingCmd(ExecutionStreamId execution_stream_id,
+                    BufferUseVector buffer_usage, int64_t* num_updates)
+      : CommandBufferCmd(CommandBufferCmdType::kUnknownCmd,
+                         execution_stream_id),
+        buffer_usage_(buffer_usage),
+        num_updates_(num_updates) {}
+
+  absl::StatusOr<const se::CommandBuffer::Command*> Record(
+      const Thunk::ExecuteParams&, const RecordParams&,
+      RecordAction record_action, se::CommandBuffer*) override {
+    if (std::holds_alternative<RecordUpdate>(record_action)) {
+      ++*num_updates_;
+    }
+    return nullptr;
+  }
+
+  BufferUseVector buffers() const override { return buffer_usage_; }
+
+ private:
+  BufferUseVector buffer_usage_;
+  int64_t* num_updates_;
+};
+
 TEST(CommandBufferCmdTest, MemcpyCmd) {
   se::StreamExecutor* stream_executor = GpuExecutor();
 
@@ -284,6 +313,70 @@ TEST(CommandBufferCmdTest, MemcpyCmd) {
   ASSERT_EQ(dst, std::vector<int32_t>(4, 42));
 }
 
+TEST(CommandBufferCmdTest, RecordUpdateSkipsUnchangedCommands) {
+  se::StreamExecutor* stream_executor = GpuExecutor();
+  auto stream = stream_executor->CreateStream().value();
+
+  BufferAllocation alloc0(/*index=*/0, /*size=*/1024, /*color=*/0);
+  BufferAllocation alloc1(/*index=*/1, /*size=*/1024, /*color=*/0);
+  BufferAllocation alloc2(/*index=*/2, /*size=*/1024, /*color=*/0);
+
+  BufferAllocation::Slice slice0(&alloc0, 0, 1024);
+  BufferAllocation::Slice slice1(&alloc1, 0, 1024);
+  BufferAllocation::Slice slice2(&alloc2, 0, 1024);
+
+  std::array<int64_t, 3> num_updates = {0, 0, 0};
+
+  CommandBufferCmdSequence commands;
+  commands.Emplace<UpdateCountingCmd>(
+      s0, BufferUseVector{{slice0, MemoryAccess::kRead}}, &num_updates[0]);
+  commands.Emplace<UpdateCountingCmd>(
+      s0, BufferUseVector{{slice1, MemoryAccess::kWrite}}, &num_updates[1]);
+  commands.Emplace<UpdateCountingCmd>(
+      s0,
+      BufferUseVector{{slice0, MemoryAccess::kRead},
+                      {slice2, MemoryAccess::kWrite}},
+      &num_updates[2]);
+  TF_ASSERT_OK_AND_ASSIGN(
+      CommandBufferCmdExecutor executor,
+      CommandBufferCmdExecutor::Create(std::move(commands), serialize));
+
+  se::DeviceMemoryBase mem(reinterpret_cast<void*>(0x01234567));
+  se::StreamExecutorMemoryAllocator allocator(stream_executor);
+  BufferAllocations allocations({mem, mem, mem}, 0, &allocator);
+
+  ServiceExecutableRunOptions run_options;
+  Thunk::ExecuteParams params = Thunk::ExecuteParams::Create(
+      run_options, allocations, stream.get(), stream.get(), nullptr, nullptr);
+
+  CommandBufferCmd::StateManager state;
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto command_buffer,
+      stream_executor->CreateCommandBuffer(se::CommandBuffer::Mode::kPrimary));
+
+  CommandBufferCmd::RecordParams create_params = {state};
+  TF_ASSERT_OK(executor.Record(params, create_params, command_buffer.get()));
+  EXPECT_EQ(num_updates, (std::array<int64_t, 3>{0, 0, 0}));
+
+  // Only commands that reference updated allocations must be updated.
+  CommandBufferCmd::RecordParams update0_params = {
+      state, std::vector<BufferAllocation::Index>{0}};
+  TF_ASSERT_OK(executor.Record(params, update0_params, command_buffer.get()));
+  EXPECT_EQ(num_updates, (std::array<int64_t, 3>{1, 0, 1}));
+
+  CommandBufferCmd::RecordParams update2_params = {
+      state, std::vector<BufferAllocation::Index>{2}};
+  TF_ASSERT_OK(executor.Record(params, update2_params, command_buffer.get()));
+  EXPECT_EQ(num_updates, (std::array<int64_t, 3>{1, 0, 2}));
+
+  // If updated allocations are unknown, all commands must be updated.
+  CommandBufferCmd::RecordParams update_all_params = {state};
+  TF_ASSERT_OK(
+      executor.Record(params, update_all_params, command_buffer.get()));
+  EXPECT_EQ(num_updates, (std::array<int64_t, 3>{2, 1, 3}));
+}
+
 TEST(CommandBufferCmdTest, LaunchCmd) {
   se::StreamExecutor* stream_executor = GpuExecutor();
 
@@ -558,4 +651,56 @@ static void BM_GetOrTraceCommandBuffer(benchmark::State& state) {
 
 BENCHMARK(BM_GetOrTraceCommandBuffer);
 
+// Measures the cost of updating a command buffer when a single buffer
+// allocation changes, as a function of the command sequence length.
+static void BM_RecordUpdate(benchmark::State& state) {
+  se::StreamExecutor* stream_executor = GpuExecutor();
+
+  TF_ASSERT_OK_AND_ASSIGN(auto stream, stream_executor->CreateStream());
+
+  int64_t num_commands = state.range(0);
+
+  // Every command references its own buffer allocation.
+  std::vector<BufferAllocation> allocs;
+  allocs.reserve(num_commands);
+  std::vector<int64_t> num_updates(num_commands, 0);
+
+  CommandBufferCmdSequence commands;
+  for (int64_t i = 0; i < num_commands; ++i) {
+    allocs.emplace_back(/*index=*/i, /*size=*/1024, /*color=*/0);
+    BufferAllocation::Slice slice(&allocs.back(), 0, 1024);
+    commands.Emplace<UpdateCountingCmd>(
+        s0, BufferUseVector{{slice, MemoryAccess::kWrite}}, &num_updates[i]);
+  }
+  TF_ASSERT_OK_AND_ASSIGN(
+      CommandBufferCmdExecutor executor,
+      CommandBufferCmdExecutor::Create(std::move(commands), serialize));
+
+  std::vector<se::DeviceMemoryBase> mems(
+      num_commands, se::DeviceMemoryBase(reinterpret_cast<void*>(0x01234567)));
+  se::StreamExecutorMemoryAllocator allocator(stream_executor);
+  BufferAllocations allocations(mems, 0, &allocator);
+
+  ServiceExecutableRunOptions run_options;
+  Thunk::ExecuteParams params = Thunk::ExecuteParams::Create(
+      run_options, allocations, stream.get(), stream.get(), nullptr, nullptr);
+
+  CommandBufferCmd::StateManager cmd_state;
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto command_buffer,
+      stream_executor->CreateCommandBuffer(se::CommandBuffer::Mode::kPrimary));
+
+  CommandBufferCmd::RecordParams create_params = {cmd_state};
+  TF_CHECK_OK(executor.Record(params, create_params, command_buffer.get()));
+
+  CommandBufferCmd::RecordParams update_params = {
+      cmd_state, std::vector<BufferAllocation::Index>{0}};
+  for (auto s : state) {
+    TF_CHECK_OK(executor.Record(params, update_params, command_buffer.get()));
+  }
+}
+
+BENCHMARK(BM_RecordUpdate)->RangeMultiplier(4)->Range(16, 4096);
+
 }  // namespace xla::gpu
@@ -107,6 +107,26 @@ absl::StatusOr<std::unique_ptr<se::Event>> CopyThunk::AsyncEvents::Extract(
   return absl::InternalError("Async copy event was not found!");
 }
 
+absl::StatusOr<std::unique_ptr<se::Event>> CopyThunk::AsyncEvents::Acquire(
+    se::StreamExecutor* executor) {
+  {
+    absl::MutexLock lock(&mutex_);
+    auto it = free_events_.find(executor);
+    if (it != free_events_.end() && !it->second.empty()) {
+      std::unique_ptr<se::Event> event = std::move(it->second.back());
+      it->second.pop_back();
+      return event;
+    }
+  }
+  return executor->CreateEvent();
+}
+
+void CopyThunk::AsyncEvents::Release(se::StreamExecutor* executor,
+                                     std::unique_ptr<se::Event> event) {
+  absl::MutexLock lock(&mutex_);
+  free_events_[executor].push_back(std::move(event));
+}
+
 absl::StatusOr<ThunkProto> CopyThunk::ToProto() const {
   TF_ASSIGN_OR_RETURN(ThunkProto proto, Thunk::ToProto());
   CopyThunkProto* copy_thunk_proto = proto.mutable_copy_thunk();
@@ -162,7 +182,7 @@ absl::Status DeviceToHostCopyThunk::ExecuteOnStream(
   }
   VLOG(2) << "Memcpy D2H from the other stream";
   se::StreamExecutor* executor = params.stream->parent();
-  TF_ASSIGN_OR_RETURN(auto event, executor->CreateEvent());
+  TF_ASSIGN_OR_RETURN(auto event, async_events_->Acquire(executor));
   // Record memcpy operation completion.
   TF_RETURN_IF_ERROR(stream->RecordEvent(event.get()));
   VLOG(3) << "Emplace events: " << event.get()
@@ -232,7 +252,7 @@ absl::Status HostToDeviceCopyThunk::ExecuteOnStream(
   }
   VLOG(2) << "Memcpy H2D from the other stream";
   se::StreamExecutor* executor = params.stream->parent();
-  TF_ASSIGN_OR_RETURN(auto event, executor->CreateEvent());
+  TF_ASSIGN_OR_RETURN(auto event, async_events_->Acquire(executor));
   // Record memcpy operation completion.
   TF_RETURN_IF_ERROR(stream->RecordEvent(event.get()));
   VLOG(3) << "Emplace events: " << event.get()
@@ -290,7 +310,9 @@ absl::Status CopyDoneThunk::ExecuteOnStream(const ExecuteParams& params) {
   se::StreamExecutor* executor = params.stream->parent();
   TF_ASSIGN_OR_RETURN(std::unique_ptr<se::Event> event,
                       async_events_->Extract(executor, copy_start_instr_));
-  return params.stream->WaitFor(event.get());
+  TF_RETURN_IF_ERROR(params.stream->WaitFor(event.get()));
+  async_events_->Release(executor, std::move(event));
+  return absl::OkStatus();
 }
 
 //===----------------------------------------------------------------------===//
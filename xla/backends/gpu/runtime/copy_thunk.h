@@ -83,11 +83,26 @@ class CopyThunk : public Thunk {
     absl::StatusOr<std::unique_ptr<se::Event>> Extract(
         se::StreamExecutor* executor, const HloInstruction* instr);
 
+    // Returns a completion event for `executor`, reusing an event released by
+    // a previous execution if there is one, so that steady-state executions
+    // do not create events.
+    absl::StatusOr<std::unique_ptr<se::Event>> Acquire(
+        se::StreamExecutor* executor);
+
+    // Returns `event` to the free events of `executor`. The event can be
+    // recorded again as soon as all waits for it have been enqueued, since a
+    // wait captures the state of the event when it is enqueued.
+    void Release(se::StreamExecutor* executor,
+                 std::unique_ptr<se::Event> event);
+
    private:
     using Key = std::pair<se::StreamExecutor*, const HloInstruction*>;
     absl::Mutex mutex_;
     absl::flat_hash_map<Key, std::unique_ptr<se::Event>> events_
         ABSL_GUARDED_BY(mutex_);
+    absl::flat_hash_map<se::StreamExecutor*,
+                        std::vector<std::unique_ptr<se::Event>>>
+        free_events_ ABSL_GUARDED_BY(mutex_);
   };
   CopyThunk(ThunkInfo thunk_info, const BufferAllocation::Slice& source_buffer,
             const BufferAllocation::Slice& destination_buffer,
@@ -21,10 +21,11 @@ limitations under the License.
 
 #include "absl/container/node_hash_map.h"
 #include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
 #include "absl/synchronization/mutex.h"
 #include "xla/backends/gpu/runtime/thunk.h"
 #include "xla/service/buffer_assignment.h"
-#include "xla/service/gpu/autotuning/autotuner_util.h"
 #include "xla/service/gpu/buffer_allocations.h"
 #include "xla/service/gpu/matmul_utils.h"
 #include "xla/service/gpu/stream_executor_util.h"
@@ -43,7 +44,7 @@ CublasLtMatmulThunk::CublasLtMatmulThunk(const CublasLtMatmulThunk& rhs)
       gemm_config_(rhs.gemm_config_),
       epilogue_(rhs.epilogue_),
       algorithm_idx_(rhs.algorithm_idx_),
-      canonical_hlo_(rhs.canonical_hlo_),
+      plan_cache_key_(rhs.plan_cache_key_),
       a_(rhs.a_),
       b_(rhs.b_),
       c_(rhs.c_),
@@ -85,17 +86,17 @@ CublasLtMatmulThunk::CublasLtMatmulThunk(
       d_scale_(d_scale),
       d_amax_(d_amax),
       workspace_(workspace) {
-  // The tests creating CublasLtMatmulThunk directly might not provide the
-  // pointer to the actual instruction, in this case Matmul plans are not
-  // cached.
-  if (instr != nullptr) {
-    canonical_hlo_ = xla::gpu::AutotuneCacheKey("unused", *instr).GetHlo();
-  }
+  // The plan and its algorithm only depend on the GEMM config, the epilogue,
+  // the algorithm index and the workspace size, so all thunks that agree on
+  // them share a plan, whichever instruction they were emitted for.
+  plan_cache_key_ = absl::StrCat(
+      gemm_config_.ToProto().SerializeAsString(), "|",
+      static_cast<int>(epilogue_), "|", algorithm_idx_, "|", max_workspace());
 }
 
 absl::Status CublasLtMatmulThunk::ExecuteOnStreamInternal(
     se::Stream* stream, const ExecuteParams& params) {
-  TF_ASSIGN_OR_RETURN(auto* plan, GetCachedMatmulPlan(params));
+  TF_ASSIGN_OR_RETURN(auto* plan, GetCachedMatmulPlan(params.stream));
 
   VLOG(3) << "Running cublas_lt matmul thunk";
   const BufferAllocations& allocs = *params.buffer_allocations;
@@ -134,18 +135,14 @@ absl::Status CublasLtMatmulThunk::ExecuteOnStreamInternal(
 }
 
 absl::StatusOr<se::gpu::BlasLt::MatmulPlan*>
-CublasLtMatmulThunk::GetCachedMatmulPlan(const ExecuteParams& params) {
-  auto* blas_lt = se::gpu::BlasLt::Get(params.stream);
+CublasLtMatmulThunk::GetCachedMatmulPlan(se::Stream* stream) {
+  auto* blas_lt = se::gpu::BlasLt::Get(stream);
   auto create = [&]() -> absl::StatusOr<se::gpu::BlasLt::MatmulPlanPtr> {
-    VLOG(2) << this << ": Adding new MatmulPlan for stream: " << params.stream
-            << " instr: " << canonical_hlo_;
+    VLOG(2) << this << ": Adding new MatmulPlan for stream: " << stream
+            << " instr: " << profile_annotation();
 
     TF_ASSIGN_OR_RETURN(auto plan,
                         blas_lt->GetMatmulPlan(gemm_config_, epilogue_));
-    // if workspace buffer is not provided, consider onlt the algorithms which
-    // do not require a scratch space
-    int64_t max_workspace =
-        workspace_.has_value() ? workspace_.value().size() : 0;
 
     // If autotuning is disabled, there is no point on retrieving all
     // algorithms, it's enough to get the default one only.
@@ -153,18 +150,23 @@ CublasLtMatmulThunk::GetCachedMatmulPlan(const ExecuteParams& params) {
         algorithm_idx_ == 0 ? 1 : GemmConfig::kNumAlgorithms;
     TF_ASSIGN_OR_RETURN(
         auto algorithms,
-        plan->GetAlgorithms(params.stream, num_algorithms, max_workspace));
+        plan->GetAlgorithms(stream, num_algorithms, max_workspace()));
 
     TF_RETURN_IF_ERROR(plan->SetAlgorithm(algorithms[algorithm_idx_]));
     return std::move(plan);
   };
-  return blas_lt->GetOrCreateMatmulPlan(canonical_hlo_, create);
+  return blas_lt->GetOrCreateMatmulPlan(plan_cache_key_, create);
 }
 
 absl::Status CublasLtMatmulThunk::Initialize(const InitializeParams& params) {
   if (!params.executor->AsBlas()) {
     return absl::InternalError("Failed to initialize BLASLT support");
   }
+  // Resolve the plan and the autotuned algorithm when the executable is
+  // loaded, so that the first execution doesn't pay for it.
+  if (params.stream != nullptr) {
+    TF_RETURN_IF_ERROR(GetCachedMatmulPlan(params.stream).status());
+  }
   return absl::OkStatus();
 }
 
@@ -18,9 +18,11 @@ limitations under the License.
 
 #include <cstdint>
 #include <optional>
+#include <string>
 
 #include "absl/base/thread_annotations.h"
 #include "absl/status/status.h"
+#include "absl/status/statusor.h"
 #include "xla/backends/gpu/runtime/thunk.h"
 #include "xla/service/buffer_assignment.h"
 #include "xla/service/gpu/matmul_utils.h"
@@ -58,14 +60,22 @@ class CublasLtMatmulThunk : public Thunk {
 
   absl::Status ExecuteOnStreamInternal(se::Stream* stream,
                                        const ExecuteParams& params);
+  // Returns the plan of this thunk from the matmul plan cache of the stream's
+  // BlasLt, which is shared by all thunks and executables on the device.
   absl::StatusOr<se::gpu::BlasLt::MatmulPlan*> GetCachedMatmulPlan(
-      const ExecuteParams& params);
+      se::Stream* stream);
+
+  // If the workspace buffer is not provided, only the algorithms which do not
+  // require a scratch space are considered.
+  int64_t max_workspace() const {
+    return workspace_.has_value() ? workspace_->size() : 0;
+  }
 
  protected:
   GemmConfig gemm_config_;
   se::gpu::BlasLt::Epilogue epilogue_;
   int64_t algorithm_idx_;
-  std::string canonical_hlo_;
+  std::string plan_cache_key_;
   BufferAllocation::Slice a_;
   BufferAllocation::Slice b_;
   BufferAllocation::Slice c_;
@@ -287,6 +287,44 @@ XLA_TEST_F(GpuBlasLtMatmulThunkTest, SharedMatmulPlansUnit) {
   EXPECT_EQ(blas_lt->GetMatmulPlanCacheSize(), 2);
 }
 
+XLA_TEST_F(GpuBlasLtMatmulThunkTest, InitializeCreatesSharedMatmulPlan) {
+  auto* exec = default_exec();
+  auto* blas_lt = exec->AsBlas()->GetBlasLt();
+  EXPECT_NE(blas_lt, nullptr);
+  blas_lt->ClearMatmulPlanCache();
+
+  TF_ASSERT_OK_AND_ASSIGN(auto module,
+                          ParseAndReturnVerifiedModule(hlo_single_plan));
+  TF_ASSERT_OK_AND_ASSIGN(
+      bool changed,
+      RunHloPass(
+          GemmRewriter(gpu_comp(exec),
+                       /*toolkit_version=*/se::SemanticVersion{12, 4, 0}),
+          module.get()));
+  ASSERT_TRUE(changed);
+
+  GpuBlasLtThunkBuilder builder(exec, gpu_comp(exec));
+  std::vector<std::unique_ptr<CublasLtMatmulThunk>> gemm_thunks;
+  for (auto* instr : module->entry_computation()->instructions()) {
+    if (IsCublasLtMatmul(*instr)) {
+      TF_ASSERT_OK_AND_ASSIGN(auto thunk, builder.CreateThunk(instr));
+      gemm_thunks.push_back(std::move(thunk));
+    }
+  }
+  ASSERT_EQ(gemm_thunks.size(), 3);
+  auto allocs = builder.buffer_allocations();
+
+  TF_ASSERT_OK_AND_ASSIGN(auto stream, exec->CreateStream());
+  Thunk::ExecutableSource source = {/*text=*/"", /*binary=*/{}};
+  for (auto& thunk : gemm_thunks) {
+    TF_ASSERT_OK(
+        thunk->Initialize({exec, source, allocs.get(), stream.get(), nullptr}));
+  }
+  // The plan is created when the thunks are initialized, before they execute,
+  // and shared by the three equivalent dots.
+  EXPECT_EQ(blas_lt->GetMatmulPlanCacheSize(), 1);
+}
+
 // Same as above but instead of creating thunks manually, we use XLA runtime
 XLA_TEST_F(GpuBlasLtMatmulThunkTest, SharedMatmulPlansFunctional) {
   auto* exec = default_exec();
@@ -15,9 +15,14 @@ limitations under the License.
 
 #include "xla/backends/gpu/runtime/host_memory_pool.h"
 
+#include <cstdint>
 #include <memory>
 #include <utility>
+#include <vector>
 
+#include "absl/base/const_init.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/log/log.h"
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -26,6 +31,7 @@ limitations under the License.
 #include "xla/primitive_util.h"
 #include "xla/stream_executor/memory_allocation.h"
 #include "xla/stream_executor/stream_executor.h"
+#include "xla/tsl/platform/errors.h"
 #include "xla/tsl/platform/statusor.h"
 
 namespace xla {
@@ -82,5 +88,135 @@ HostMemoryPool::HostMemoryPool(std::unique_ptr<se::MemoryAllocation> allocation,
                     i * primitive_util::ByteWidth(type_));
   }
 }
+
+//===----------------------------------------------------------------------===//
+// HostMemoryAllocator
+//===----------------------------------------------------------------------===//
+
+// An allocation that returns its memory block to the allocator on destruction.
+class HostMemoryAllocator::Allocation : public se::MemoryAllocation {
+ public:
+  Allocation(HostMemoryAllocator* allocator, int size_class, uint64_t size,
+             std::unique_ptr<se::MemoryAllocation> block)
+      : allocator_(allocator),
+        size_class_(size_class),
+        size_(size),
+        block_(std::move(block)) {}
+
+  ~Allocation() override {
+    if (size_class_ >= 0) {
+      allocator_->Release(size_class_, std::move(block_));
+    }
+  }
+
+  void* opaque() const override { return block_->opaque(); }
+  uint64_t size() const override { return size_; }
+
+ private:
+  HostMemoryAllocator* allocator_;
+  int size_class_;
+  uint64_t size_;
+  std::unique_ptr<se::MemoryAllocation> block_;
+};
+
+HostMemoryAllocator::HostMemoryAllocator(se::StreamExecutor* executor,
+                                         uint64_t max_cached_bytes)
+    : executor_(executor),
+      max_cached_bytes_(max_cached_bytes),
+      free_blocks_(SizeClass(kMaxSizeClassBytes) + 1) {}
+
+HostMemoryAllocator* HostMemoryAllocator::Get(se::StreamExecutor* executor) {
+  static absl::Mutex mutex(absl::kConstInit);
+  static auto* allocators = new absl::flat_hash_map<
+      se::StreamExecutor*, std::unique_ptr<HostMemoryAllocator>>();
+
+  absl::MutexLock lock(&mutex);
+  std::unique_ptr<HostMemoryAllocator>& allocator = (*allocators)[executor];
+  if (allocator == nullptr) {
+    allocator = std::make_unique<HostMemoryAllocator>(executor);
+  }
+  return allocator.get();
+}
+
+int HostMemoryAllocator::SizeClass(uint64_t size) {
+  if (size > kMaxSizeClassBytes) {
+    return -1;
+  }
+  int size_class = 0;
+  while (SizeClassBytes(size_class) < size) {
+    ++size_class;
+  }
+  return size_class;
+}
+
+uint64_t HostMemoryAllocator::SizeClassBytes(int size_class) {
+  return kMinSizeClassBytes << size_class;
+}
+
+absl::StatusOr<std::unique_ptr<se::MemoryAllocation>>
+HostMemoryAllocator::Allocate(uint64_t size) {
+  int size_class = SizeClass(size);
+
+  if (size_class >= 0) {
+    absl::MutexLock lock(&mutex_);
+    std::vector<std::unique_ptr<se::MemoryAllocation>>& free_blocks =
+        free_blocks_[size_class];
+    if (!free_blocks.empty()) {
+      std::unique_ptr<se::MemoryAllocation> block =
+          std::move(free_blocks.back());
+      free_blocks.pop_back();
+      cached_bytes_ -= SizeClassBytes(size_class);
+      return std::make_unique<Allocation>(this, size_class, size,
+                                          std::move(block));
+    }
+  }
+
+  // Pin a new block of memory without holding the lock.
+  uint64_t block_size = size_class >= 0 ? SizeClassBytes(size_class) : size;
+  VLOG(3) << "Allocate pinned host memory block of " << block_size
+          << " bytes for executor " << executor_->device_ordinal();
+  TF_ASSIGN_OR_RETURN(std::unique_ptr<se::MemoryAllocation> block,
+                      executor_->HostMemoryAllocate(block_size));
+  return std::make_unique<Allocation>(this, size_class, size,
+                                      std::move(block));
+}
+
+absl::Status HostMemoryAllocator::Reserve(uint64_t size, int64_t count) {
+  int size_class = SizeClass(size);
+  if (size_class < 0) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("Can't reserve pinned host memory blocks of ", size,
+                     " bytes, the largest size class is ", kMaxSizeClassBytes,
+                     " bytes"));
+  }
+  for (int64_t i = 0; i < count; ++i) {
+    TF_ASSIGN_OR_RETURN(
+        std::unique_ptr<se::MemoryAllocation> block,
+        executor_->HostMemoryAllocate(SizeClassBytes(size_class)));
+    Release(size_class, std::move(block));
+  }
+  return absl::OkStatus();
+}
+
+uint64_t HostMemoryAllocator::cached_bytes() const {
+  absl::MutexLock lock(&mutex_);
+  return cached_bytes_;
+}
+
+void HostMemoryAllocator::Release(int size_class,
+                                  std::unique_ptr<se::MemoryAllocation> block) {
+  {
+    absl::MutexLock lock(&mutex_);
+    uint64_t block_size = SizeClassBytes(size_class);
+    if (cached_bytes_ + block_size <= max_cached_bytes_) {
+      cached_bytes_ += block_size;
+      free_blocks_[size_class].push_back(std::move(block));
+      return;
+    }
+  }
+  // Unpin memory that doesn't fit into the cache without holding the lock.
+  block.reset();
+}
+
 }  // namespace gpu
 }  // namespace xla
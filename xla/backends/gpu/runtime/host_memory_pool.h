@@ -19,8 +19,12 @@ limitations under the License.
 #include <cstdint>
 #include <memory>
 #include <queue>
+#include <vector>
 
+#include "absl/base/thread_annotations.h"
 #include "absl/log/check.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
 #include "absl/synchronization/mutex.h"
 #include "xla/primitive_util.h"
 #include "xla/stream_executor/memory_allocation.h"
@@ -98,6 +102,64 @@ class HostMemoryPool {
   std::queue<void*> free_list_ ABSL_GUARDED_BY(mutex_);
 };
 
+// HostMemoryAllocator is a caching allocator of page-locked host memory with
+// power-of-two size classes, used for staging host-device transfers. Pinning
+// host memory is expensive, so freed blocks are kept in per size class free
+// lists and reused by later allocations, up to `max_cached_bytes` of cached
+// memory. Requests larger than the largest size class are not cached.
+//
+// New blocks are allocated from the StreamExecutor without holding the
+// allocator lock, so concurrent allocations are not blocked by pinning memory
+// for a cache miss. StreamExecutor allocates pinned host memory on the NUMA
+// node of the device, so cached blocks are NUMA-local to the device.
+//
+// The allocator must outlive all allocations it returned.
+class HostMemoryAllocator {
+ public:
+  static constexpr uint64_t kMinSizeClassBytes = 4 * 1024;
+  static constexpr uint64_t kMaxSizeClassBytes = 256 * 1024 * 1024;
+  static constexpr uint64_t kDefaultMaxCachedBytes = 1024 * 1024 * 1024;
+
+  explicit HostMemoryAllocator(
+      se::StreamExecutor* executor,
+      uint64_t max_cached_bytes = kDefaultMaxCachedBytes);
+
+  HostMemoryAllocator(const HostMemoryAllocator&) = delete;
+  HostMemoryAllocator& operator=(const HostMemoryAllocator&) = delete;
+
+  // Returns the allocator shared by all transfers to and from `executor`.
+  static HostMemoryAllocator* Get(se::StreamExecutor* executor);
+
+  // Allocates at least `size` bytes of pinned host memory. Memory is returned
+  // to the allocator when the allocation is destroyed.
+  absl::StatusOr<std::unique_ptr<se::MemoryAllocation>> Allocate(
+      uint64_t size);
+
+  // Pre-allocates `count` blocks of the size class of `size` bytes, so that
+  // later allocations don't pin memory on the critical path.
+  absl::Status Reserve(uint64_t size, int64_t count);
+
+  // Returns the number of bytes in free blocks.
+  uint64_t cached_bytes() const;
+
+ private:
+  class Allocation;
+
+  // Returns the size class index for `size`, or -1 if it's not cached.
+  static int SizeClass(uint64_t size);
+  static uint64_t SizeClassBytes(int size_class);
+
+  void Release(int size_class, std::unique_ptr<se::MemoryAllocation> block);
+
+  se::StreamExecutor* executor_;
+  const uint64_t max_cached_bytes_;
+
+  mutable absl::Mutex mutex_;
+  uint64_t cached_bytes_ ABSL_GUARDED_BY(mutex_) = 0;
+  std::vector<std::vector<std::unique_ptr<se::MemoryAllocation>>> free_blocks_
+      ABSL_GUARDED_BY(mutex_);
+};
+
 }  // namespace gpu
 }  // namespace xla
 
@@ -0,0 +1,98 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/gpu/runtime/host_memory_pool.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/statusor.h"
+#include "xla/stream_executor/memory_allocation.h"
+#include "xla/stream_executor/mock_stream_executor.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/tsl/platform/test.h"
+
+namespace xla::gpu {
+namespace {
+
+using ::testing::_;
+using ::testing::Invoke;
+
+class FakeMemoryAllocation : public se::MemoryAllocation {
+ public:
+  explicit FakeMemoryAllocation(uint64_t size) : data_(size) {}
+  void* opaque() const override { return const_cast<char*>(data_.data()); }
+  uint64_t size() const override { return data_.size(); }
+
+ private:
+  std::vector<char> data_;
+};
+
+absl::StatusOr<std::unique_ptr<se::MemoryAllocation>> FakeHostMemoryAllocate(
+    uint64_t size) {
+  return std::make_unique<FakeMemoryAllocation>(size);
+}
+
+TEST(HostMemoryAllocatorTest, ReusesFreedBlocksOfTheSameSizeClass) {
+  se::MockStreamExecutor executor;
+  EXPECT_CALL(executor, HostMemoryAllocate(8 * 1024))
+      .Times(1)
+      .WillOnce(Invoke(FakeHostMemoryAllocate));
+
+  HostMemoryAllocator allocator(&executor);
+  void* opaque = nullptr;
+  {
+    TF_ASSERT_OK_AND_ASSIGN(auto allocation, allocator.Allocate(5000));
+    EXPECT_EQ(allocation->size(), 5000);
+    opaque = allocation->opaque();
+  }
+  EXPECT_EQ(allocator.cached_bytes(), 8 * 1024);
+
+  TF_ASSERT_OK_AND_ASSIGN(auto allocation, allocator.Allocate(6000));
+  EXPECT_EQ(allocation->opaque(), opaque);
+  EXPECT_EQ(allocator.cached_bytes(), 0);
+}
+
+TEST(HostMemoryAllocatorTest, DoesNotCacheMoreThanLimit) {
+  se::MockStreamExecutor executor;
+  EXPECT_CALL(executor, HostMemoryAllocate(_))
+      .WillRepeatedly(Invoke(FakeHostMemoryAllocate));
+
+  HostMemoryAllocator allocator(&executor, /*max_cached_bytes=*/4 * 1024);
+  {
+    TF_ASSERT_OK_AND_ASSIGN(auto a, allocator.Allocate(100));
+    TF_ASSERT_OK_AND_ASSIGN(auto b, allocator.Allocate(100));
+  }
+  EXPECT_EQ(allocator.cached_bytes(), 4 * 1024);
+}
+
+TEST(HostMemoryAllocatorTest, ReserveFillsCache) {
+  se::MockStreamExecutor executor;
+  EXPECT_CALL(executor, HostMemoryAllocate(_))
+      .WillRepeatedly(Invoke(FakeHostMemoryAllocate));
+
+  HostMemoryAllocator allocator(&executor);
+  TF_ASSERT_OK(allocator.Reserve(/*size=*/16 * 1024, /*count=*/2));
+  EXPECT_EQ(allocator.cached_bytes(), 32 * 1024);
+
+  EXPECT_FALSE(
+      allocator.Reserve(HostMemoryAllocator::kMaxSizeClassBytes + 1, 1).ok());
+}
+
+}  // namespace
+}  // namespace xla::gpu
@@ -0,0 +1,118 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/gpu/runtime/kernel_thunk_batching.h"
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "xla/backends/gpu/runtime/command_buffer_cmd.h"
+#include "xla/backends/gpu/runtime/command_buffer_cmd_emitter.h"
+#include "xla/backends/gpu/runtime/command_buffer_thunk.h"
+#include "xla/backends/gpu/runtime/kernel_thunk.h"
+#include "xla/backends/gpu/runtime/sequential_thunk.h"
+#include "xla/backends/gpu/runtime/thunk.h"
+#include "xla/stream_executor/launch_dim.h"
+#include "xla/tsl/platform/errors.h"
+#include "xla/tsl/platform/logging.h"
+#include "xla/tsl/platform/statusor.h"
+
+namespace xla::gpu {
+
+static bool IsSmallKernelThunk(const Thunk& thunk,
+                               const KernelThunkBatchingOptions& options) {
+  if (thunk.kind() != Thunk::kKernel) return false;
+  const auto& kernel = static_cast<const KernelThunk&>(thunk);
+
+  // Kernel launch commands do not support thread block clusters and TMA
+  // descriptors, keep such kernels as individual launches.
+  if (kernel.cluster_dim().has_value() &&
+      *kernel.cluster_dim() != se::ClusterDim()) {
+    return false;
+  }
+  if (kernel.tma_metadata().has_value() &&
+      !kernel.tma_metadata()->arg_index_to_tma_info.empty()) {
+    return false;
+  }
+
+  int64_t num_blocks = kernel.launch_dimensions().num_blocks();
+  return num_blocks <= options.max_num_blocks;
+}
+
+static absl::StatusOr<std::unique_ptr<Thunk>> CreateBatchThunk(
+    ThunkSequence batch, const KernelThunkBatchingOptions& options) {
+  TF_ASSIGN_OR_RETURN(
+      CommandBufferCmdExecutor cmd_executor,
+      ConvertToCommands(batch,
+                        ConvertToCommandsOptions{options.synchronization_mode}));
+
+  Thunk::ThunkInfo thunk_info;
+  thunk_info.profile_annotation =
+      absl::StrCat("kernel_batch:", batch.front()->profile_annotation());
+  thunk_info.execution_stream_id = batch.front()->execution_stream_id();
+
+  return std::make_unique<CommandBufferThunk>(
+      std::move(cmd_executor), thunk_info,
+      std::make_unique<SequentialThunk>(thunk_info, std::move(batch)),
+      options.enable_command_buffers_during_profiling);
+}
+
+absl::StatusOr<ThunkSequence> BatchSmallKernelThunks(
+    ThunkSequence thunks, const KernelThunkBatchingOptions& options) {
+  ThunkSequence result;
+  ThunkSequence batch;
+  int64_t num_batches = 0;
+
+  // Moves pending small kernel thunks to the result, as a single command
+  // buffer thunk if there are enough of them.
+  auto flush_batch = [&]() -> absl::Status {
+    if (static_cast<int64_t>(batch.size()) >= options.min_batch_size) {
+      TF_ASSIGN_OR_RETURN(std::unique_ptr<Thunk> batch_thunk,
+                          CreateBatchThunk(std::move(batch), options));
+      result.push_back(std::move(batch_thunk));
+      ++num_batches;
+    } else {
+      for (std::unique_ptr<Thunk>& thunk : batch) {
+        result.push_back(std::move(thunk));
+      }
+    }
+    batch.clear();
+    return absl::OkStatus();
+  };
+
+  for (std::unique_ptr<Thunk>& thunk : thunks) {
+    if (!IsSmallKernelThunk(*thunk, options)) {
+      TF_RETURN_IF_ERROR(flush_batch());
+      result.push_back(std::move(thunk));
+      continue;
+    }
+    if (!batch.empty() &&
+        batch.front()->execution_stream_id() != thunk->execution_stream_id()) {
+      TF_RETURN_IF_ERROR(flush_batch());
+    }
+    batch.push_back(std::move(thunk));
+  }
+  TF_RETURN_IF_ERROR(flush_batch());
+
+  VLOG(3) << "Batched small kernel thunks into " << num_batches
+          << " command buffer thunks";
+  return result;
+}
+
+}  // namespace xla::gpu
@@ -0,0 +1,56 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_BACKENDS_GPU_RUNTIME_KERNEL_THUNK_BATCHING_H_
+#define XLA_BACKENDS_GPU_RUNTIME_KERNEL_THUNK_BATCHING_H_
+
+#include <cstdint>
+
+#include "absl/status/statusor.h"
+#include "xla/backends/gpu/runtime/command_buffer_cmd.h"
+#include "xla/backends/gpu/runtime/thunk.h"
+
+namespace xla::gpu {
+
+struct KernelThunkBatchingOptions {
+  // Minimum number of consecutive small kernel thunks that are batched
+  // together. Shorter runs are left untouched.
+  int64_t min_batch_size = 2;
+
+  // Kernel thunks launching at most this many thread blocks are considered
+  // small, i.e. their execution time is dominated by the launch overhead.
+  int64_t max_num_blocks = 1;
+
+  // Synchronization mode of the command buffers created for batched kernels.
+  // In automatic mode independent kernels of a batch run concurrently.
+  CommandBufferCmdExecutor::SynchronizationMode synchronization_mode =
+      CommandBufferCmdExecutor::SynchronizationMode::kSerialize;
+
+  bool enable_command_buffers_during_profiling = false;
+};
+
+// Replaces runs of consecutive small `KernelThunk`s launched on the same
+// execution stream with `CommandBufferThunk`s, so that each run is submitted
+// to the device with a single command buffer launch instead of a kernel launch
+// per thunk. This works on the emitted thunk sequence, and covers kernels that
+// were not merged by horizontal fusion at the HLO level.
+//
+// Nested thunk sequences (while loops, conditionals, etc.) are not modified.
+absl::StatusOr<ThunkSequence> BatchSmallKernelThunks(
+    ThunkSequence thunks, const KernelThunkBatchingOptions& options);
+
+}  // namespace xla::gpu
+
+#endif  // XLA_BACKENDS_GPU_RUNTIME_KERNEL_THUNK_BATCHING_H_
@@ -0,0 +1,91 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/gpu/runtime/kernel_thunk_batching.h"
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include <gtest/gtest.h>
+#include "xla/backends/gpu/runtime/command_buffer_thunk.h"
+#include "xla/backends/gpu/runtime/kernel_thunk.h"
+#include "xla/backends/gpu/runtime/thunk.h"
+#include "xla/service/gpu/launch_dimensions.h"
+#include "xla/stream_executor/launch_dim.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/tsl/platform/test.h"
+
+namespace xla::gpu {
+namespace {
+
+using Kind = Thunk::Kind;
+
+std::unique_ptr<Thunk> MakeKernelThunk(
+    uint64_t num_blocks,
+    ExecutionStreamId stream_id = Thunk::kDefaultExecutionStreamId) {
+  Thunk::ThunkInfo thunk_info;
+  thunk_info.execution_stream_id = stream_id;
+  return std::make_unique<KernelThunk>(
+      thunk_info, /*kernel_name=*/"kernel", /*kernel_arguments=*/{},
+      LaunchDimensions(num_blocks, /*thread_x_count_per_block=*/128),
+      /*cluster_dim=*/se::ClusterDim(), /*shmem_bytes=*/0,
+      /*tma_metadata=*/std::nullopt);
+}
+
+TEST(KernelThunkBatchingTest, BatchesConsecutiveSmallKernels) {
+  ThunkSequence thunks;
+  thunks.push_back(MakeKernelThunk(/*num_blocks=*/1));
+  thunks.push_back(MakeKernelThunk(/*num_blocks=*/2));
+  thunks.push_back(MakeKernelThunk(/*num_blocks=*/1000));
+  thunks.push_back(MakeKernelThunk(/*num_blocks=*/1));
+  thunks.push_back(MakeKernelThunk(/*num_blocks=*/1));
+  thunks.push_back(MakeKernelThunk(/*num_blocks=*/1));
+
+  KernelThunkBatchingOptions options;
+  options.max_num_blocks = 4;
+  TF_ASSERT_OK_AND_ASSIGN(ThunkSequence batched,
+                          BatchSmallKernelThunks(std::move(thunks), options));
+
+  ASSERT_EQ(batched.size(), 3);
+  EXPECT_EQ(batched[0]->kind(), Kind::kCommandBuffer);
+  EXPECT_EQ(batched[1]->kind(), Kind::kKernel);
+  EXPECT_EQ(batched[2]->kind(), Kind::kCommandBuffer);
+
+  auto* batch = static_cast<CommandBufferThunk*>(batched[2].get());
+  ASSERT_NE(batch->thunks(), nullptr);
+  EXPECT_EQ(batch->thunks()->thunks().size(), 3);
+}
+
+TEST(KernelThunkBatchingTest, KeepsShortRunsAndStreamBoundaries) {
+  ThunkSequence thunks;
+  thunks.push_back(MakeKernelThunk(/*num_blocks=*/1, ExecutionStreamId(0)));
+  thunks.push_back(MakeKernelThunk(/*num_blocks=*/1, ExecutionStreamId(1)));
+  thunks.push_back(MakeKernelThunk(/*num_blocks=*/1, ExecutionStreamId(1)));
+
+  KernelThunkBatchingOptions options;
+  options.min_batch_size = 2;
+  TF_ASSERT_OK_AND_ASSIGN(ThunkSequence batched,
+                          BatchSmallKernelThunks(std::move(thunks), options));
+
+  ASSERT_EQ(batched.size(), 2);
+  EXPECT_EQ(batched[0]->kind(), Kind::kKernel);
+  EXPECT_EQ(batched[1]->kind(), Kind::kCommandBuffer);
+  EXPECT_EQ(batched[1]->execution_stream_id(), ExecutionStreamId(1));
+}
+
+}  // namespace
+}  // namespace xla::gpu
@@ -16,12 +16,14 @@ limitations under the License.
 #include "xla/backends/gpu/runtime/outfeed_thunk.h"
 
 #include <cstdint>
+#include <cstring>
 #include <memory>
 #include <utility>
 #include <vector>
 
 #include "absl/log/log.h"
 #include "absl/status/status.h"
+#include "xla/backends/gpu/runtime/host_memory_pool.h"
 #include "xla/backends/gpu/runtime/thunk.h"
 #include "xla/service/buffer_assignment.h"
 #include "xla/service/gpu/buffer_allocations.h"
@@ -32,9 +34,11 @@ limitations under the License.
 #include "xla/shape_util.h"
 #include "xla/status_macros.h"
 #include "xla/stream_executor/device_memory.h"
+#include "xla/stream_executor/memory_allocation.h"
 #include "xla/stream_executor/stream_executor.h"
 #include "xla/util.h"
 #include "tsl/platform/errors.h"
+#include "tsl/platform/statusor.h"
 
 namespace xla {
 namespace gpu {
@@ -67,6 +71,14 @@ absl::Status OutfeedThunk::ExecuteOnStream(const ExecuteParams& params) {
       << "Mismatch between number of outfeed inputs (" << source_slices_.size()
       << ") and outputs (" << leaf_count << ")";
 
+  // Device data is copied into pinned staging buffers, and then copied to the
+  // outfeed destinations by the host callbacks. Staging buffers must be kept
+  // alive until all transfers complete.
+  HostMemoryAllocator* host_memory_allocator =
+      HostMemoryAllocator::Get(stream.parent());
+  std::vector<std::unique_ptr<se::MemoryAllocation>> staging;
+  staging.reserve(leaf_count);
+
   auto output_leaf_it = output_buffers->leaf_begin();
   for (int64_t index = 0; index < leaf_count; ++index) {
     // Assert that the shapes are compatible.
@@ -105,9 +117,16 @@ absl::Status OutfeedThunk::ExecuteOnStream(const ExecuteParams& params) {
 
     // TODO(b/111309141): Run this on a separate stream so it doesn't block
     // the GPU from doing work during the transfer.
-    TF_RETURN_IF_ERROR(stream.Memcpy(buffer->destination()->untyped_data(),
-                                     data_address, buffer->length()));
-    TF_RETURN_IF_ERROR(stream.DoHostCallback([&buffer]() { buffer->Done(); }));
+    TF_ASSIGN_OR_RETURN(std::unique_ptr<se::MemoryAllocation> pinned,
+                        host_memory_allocator->Allocate(buffer->length()));
+    TF_RETURN_IF_ERROR(
+        stream.Memcpy(pinned->opaque(), data_address, buffer->length()));
+    TF_RETURN_IF_ERROR(stream.DoHostCallback([&buffer, src = pinned.get()]() {
+      std::memcpy(buffer->destination()->untyped_data(), src->opaque(),
+                  buffer->length());
+      buffer->Done();
+    }));
+    staging.push_back(std::move(pinned));
   }
 
   absl::Status block_status = stream.BlockHostUntilDone();
@@ -38,6 +38,7 @@ limitations under the License.
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/service/buffer_assignment.h"
 #include "xla/stream_executor/device_memory.h"
+#include "xla/stream_executor/stream.h"
 #include "xla/tsl/platform/errors.h"
 #include "xla/tsl/platform/statusor.h"
 #include "tsl/profiler/lib/traceme.h"
@@ -126,6 +127,25 @@ absl::Status WhileThunk::ExecuteOnStream(const ExecuteParams& params) {
   int64_t& iter = loop.counter;
   absl::Cleanup cleanup = [&] { RunningLoops().pop_front(); };
 
+  // Keep the persisting window for the duration of the loop only, so that it
+  // doesn't affect the caching of the kernels that follow.
+  bool l2_persisting = false;
+  if (l2_persisting_buffer_.has_value()) {
+    se::DeviceMemoryBase window =
+        params.buffer_allocations->GetDeviceAddress(*l2_persisting_buffer_);
+    absl::Status set = stream.SetL2PersistingWindow(window);
+    l2_persisting = set.ok();
+    VLOG_IF(3, !set.ok()) << "Not persisting loop buffer in L2: " << set;
+  }
+  absl::Cleanup reset_l2_persisting = [&] {
+    if (l2_persisting) {
+      absl::Status reset =
+          stream.SetL2PersistingWindow(se::DeviceMemoryBase());
+      LOG_IF(WARNING, !reset.ok())
+          << "Failed to reset the L2 persisting window: " << reset;
+    }
+  };
+
   if (trip_count_.has_value()) {
     VLOG(2) << "Executing WhileThunk for " << *trip_count_ << " iterations";
     for (iter = 0; iter < trip_count_; ++iter) {
@@ -216,6 +236,11 @@ absl::StatusOr<ThunkProto> WhileThunk::ToProto() const {
   if (trip_count_.has_value()) {
     while_proto->set_trip_count(*trip_count_);
   }
+
+  if (l2_persisting_buffer_.has_value()) {
+    TF_ASSIGN_OR_RETURN(*while_proto->mutable_l2_persisting_buffer(),
+                        l2_persisting_buffer_->ToProto());
+  }
   return proto;
 }
 
@@ -239,10 +264,18 @@ absl::StatusOr<std::unique_ptr<WhileThunk>> WhileThunk::FromProto(
   if (thunk_proto.has_trip_count()) {
     trip_count = thunk_proto.trip_count();
   }
-  return std::make_unique<WhileThunk>(
+  auto thunk = std::make_unique<WhileThunk>(
       std::move(thunk_info), /*loop=*/nullptr, condition_result_buffer_index,
       std::move(condition_thunk_sequence), std::move(body_thunk_sequence),
       trip_count);
+  if (thunk_proto.has_l2_persisting_buffer()) {
+    TF_ASSIGN_OR_RETURN(BufferAllocation::Slice l2_persisting_buffer,
+                        BufferAllocation::Slice::FromProto(
+                            thunk_proto.l2_persisting_buffer(),
+                            buffer_allocations));
+    thunk->set_l2_persisting_buffer(l2_persisting_buffer);
+  }
+  return thunk;
 }
 
 }  // namespace gpu
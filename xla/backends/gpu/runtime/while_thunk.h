@@ -82,6 +82,16 @@ class WhileThunk : public Thunk {
 
   std::optional<int64_t> trip_count() const { return trip_count_; }
 
+  // Sets a buffer that is read by every loop iteration, e.g. loop-invariant
+  // weights, whose accesses should persist in the L2 cache while the loop runs.
+  void set_l2_persisting_buffer(const BufferAllocation::Slice& slice) {
+    l2_persisting_buffer_ = slice;
+  }
+
+  const std::optional<BufferAllocation::Slice>& l2_persisting_buffer() const {
+    return l2_persisting_buffer_;
+  }
+
   // Returns the current loop iteration if the caller is inside a while loop(s).
   //
   // Implementation relies on thread local storage, be careful when call it from
@@ -116,6 +126,7 @@ class WhileThunk : public Thunk {
   std::unique_ptr<SequentialThunk> condition_thunk_sequence_;
   std::unique_ptr<SequentialThunk> body_thunk_sequence_;
   std::optional<int64_t> trip_count_;
+  std::optional<BufferAllocation::Slice> l2_persisting_buffer_;
 
   // Host memory pool for transfering predicate value from device to host.
   absl::Mutex mutex_;
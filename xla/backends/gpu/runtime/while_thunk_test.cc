@@ -349,6 +349,11 @@ TEST(WhileThunkTest, FromProto) {
             }
           }
           trip_count: 10
+          l2_persisting_buffer {
+            buffer_allocation_index: 0
+            offset: 0
+            size: 512
+          }
         }
       )pb",
       &proto));
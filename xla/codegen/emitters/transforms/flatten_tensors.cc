@@ -255,6 +255,32 @@ struct RewriteAllocateShared : OpRewritePattern<gpu::AllocateSharedOp> {
   }
 };
 
+struct RewriteBulkLoadToShared : OpRewritePattern<gpu::BulkLoadToSharedOp> {
+  using OpRewritePattern::OpRewritePattern;
+
+  LogicalResult matchAndRewrite(gpu::BulkLoadToSharedOp op,
+                                PatternRewriter& rewriter) const override {
+    auto tensor_type = op.getResult().getType();
+    if (HasOnlyFlatTensorsFlatVectorsOrScalars(
+            {tensor_type, op.getSource().getType()})) {
+      return rewriter.notifyMatchFailure(op, "nothing to flatten");
+    }
+    // The offset and the strides are linear, so only the types change.
+    Location loc = op.getLoc();
+    Value new_op = rewriter.create<gpu::BulkLoadToSharedOp>(
+        loc, GetFlattenedType(tensor_type), Flatten(op.getSource(), rewriter),
+        op.getOffset(), op.getRowSizeAttr(), op.getRowStrideAttr(),
+        op.getDestRowStrideAttr());
+    if (!IsScalarOrFlat(tensor_type)) {
+      new_op = rewriter.create<UnrealizedConversionCastOp>(loc, tensor_type,
+                                                           new_op)
+                   .getResult(0);
+    }
+    rewriter.replaceOp(op, new_op);
+    return mlir::success();
+  }
+};
+
 struct RewriteCpuLoad : OpRewritePattern<cpu::LoadOp> {
   using OpRewritePattern::OpRewritePattern;
 
@@ -735,6 +761,7 @@ class FlattenTensorsPass
     patterns.add<
         RewriteAllocateShared,
         RewriteAtomicRMW,
+        RewriteBulkLoadToShared,
         RewriteConstant,
         RewriteFor,
         RewriteFunctionSignatures,
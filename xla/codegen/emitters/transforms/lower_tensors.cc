@@ -728,6 +728,259 @@ struct RewriteSyncThreads : OpRewritePattern<gpu::SyncThreadsOp> {
   }
 };
 
+// Lowers bulk_load_to_shared to one cp.async.bulk per row. The copies are
+// issued by the first warp and complete on an mbarrier that all threads wait
+// on, so the loads bypass the registers entirely.
+ml::InlineAsmOp EmitInlineAsm(mlir::ImplicitLocOpBuilder& b, Type result_ty,
+                              ValueRange operands, llvm::StringRef asm_string,
+                              llvm::StringRef constraints) {
+  auto asm_dialect =
+      ml::AsmDialectAttr::get(b.getContext(), ml::AsmDialect::AD_ATT);
+  return b.create<ml::InlineAsmOp>(result_ty, operands, asm_string, constraints,
+                                   /*has_side_effects=*/true,
+                                   /*is_align_stack=*/true,
+                                   ml::TailCallKind::None, asm_dialect,
+                                   /*operand_attrs=*/mlir::ArrayAttr());
+}
+
+class RewriteBulkLoadToShared
+    : public OpRewritePattern<gpu::BulkLoadToSharedOp> {
+ public:
+  RewriteBulkLoadToShared(mlir::MLIRContext* context,
+                          const DeviceSpec& device_spec)
+      : OpRewritePattern<gpu::BulkLoadToSharedOp>(context),
+        device_spec_(device_spec) {}
+
+  LogicalResult matchAndRewrite(
+      gpu::BulkLoadToSharedOp op,
+      mlir::PatternRewriter& rewriter) const override {
+    if (!device_spec_.IsNvidiaGpu() ||
+        !device_spec_.gpu().cuda_compute_capability().IsAtLeastHopper()) {
+      return rewriter.notifyMatchFailure(
+          op, "bulk copies are only supported on Hopper and newer");
+    }
+    constexpr int kGPUSharedMemoryAddrSpace = 3;
+    constexpr int kWarpSize = 32;
+    auto module = op->getParentOfType<mlir::ModuleOp>();
+    auto tile_ty = op.getResult().getType();
+    mlir::ImplicitLocOpBuilder b(op.getLoc(), rewriter);
+
+    auto tile_global =
+        CreateGlobalOp(mlir::Attribute{}, "shared_", tile_ty, module,
+                       /*is_constant=*/false, kGPUSharedMemoryAddrSpace, b);
+    // cp.async.bulk requires 16 byte aligned destinations.
+    tile_global.setAlignmentAttr(b.getI64IntegerAttr(128));
+    auto barrier_global = CreateGlobalOp(
+        mlir::Attribute{}, "mbarrier_",
+        mlir::RankedTensorType::get({1}, b.getI64Type()), module,
+        /*is_constant=*/false, kGPUSharedMemoryAddrSpace, b);
+    barrier_global.setAlignmentAttr(b.getI64IntegerAttr(8));
+    b.setInsertionPoint(op);
+
+    Type i32 = b.getI32Type();
+    Value tile = b.create<ml::AddressOfOp>(tile_global);
+    Value barrier = b.create<ml::PtrToIntOp>(
+        i32, b.create<ml::AddressOfOp>(barrier_global));
+
+    auto source =
+        mlir::cast<TypedValue<mlir::RankedTensorType>>(op.getSource());
+    mlir::LLVMTypeConverter converter(b.getContext());
+    Type llvm_element_type = converter.convertType(tile_ty.getElementType());
+    int64_t element_bytes = tile_ty.getElementTypeBitWidth() / 8;
+    int64_t row_size = op.getRowSize();
+    int64_t num_rows = tile_ty.getNumElements() / op.getDestRowStride();
+    auto void_ty = ml::LLVMVoidType::get(b.getContext());
+
+    // Thread 0 initializes the barrier and arms it with the number of bytes
+    // that the copies will deliver.
+    Value thread_id = b.create<mlir::gpu::ThreadIdOp>(mlir::gpu::Dimension::x);
+    Value c0 = b.create<arith::ConstantIndexOp>(0);
+    b.create<scf::IfOp>(
+        b.create<arith::CmpIOp>(arith::CmpIPredicate::eq, thread_id, c0),
+        [&](OpBuilder& then_builder, Location loc) {
+          mlir::ImplicitLocOpBuilder then_b(loc, then_builder);
+          Value total_bytes = then_b.create<arith::ConstantIntOp>(
+              num_rows * row_size * element_bytes, i32);
+          EmitInlineAsm(then_b, void_ty, {barrier},
+                        "mbarrier.init.shared::cta.b64 [$0], 1;", "r");
+          EmitInlineAsm(then_b, void_ty, {},
+                        "fence.mbarrier_init.release.cluster;", "");
+          EmitInlineAsm(
+              then_b, void_ty, {barrier, total_bytes},
+              "mbarrier.arrive.expect_tx.shared::cta.b64 _, [$0], $1;", "r,r");
+          then_b.create<scf::YieldOp>();
+        });
+    b.create<mlir::gpu::BarrierOp>();
+
+    // The first warp issues one copy per row.
+    Value warp_size = b.create<arith::ConstantIndexOp>(kWarpSize);
+    b.create<scf::IfOp>(
+        b.create<arith::CmpIOp>(arith::CmpIPredicate::ult, thread_id,
+                                warp_size),
+        [&](OpBuilder& then_builder, Location loc) {
+          mlir::ImplicitLocOpBuilder then_b(loc, then_builder);
+          then_b.create<scf::ForOp>(
+              thread_id, then_b.create<arith::ConstantIndexOp>(num_rows),
+              warp_size, mlir::ValueRange{},
+              [&](OpBuilder& for_builder, Location for_loc, Value row,
+                  ValueRange) {
+                mlir::ImplicitLocOpBuilder for_b(for_loc, for_builder);
+                Value src_index = for_b.create<arith::AddIOp>(
+                    op.getOffset(),
+                    for_b.create<arith::MulIOp>(
+                        row, for_b.create<arith::ConstantIndexOp>(
+                                 op.getRowStride())));
+                Value src = CreateGep(source,
+                                      GetLinearIndex({src_index}, for_b),
+                                      for_b);
+                Value dst_index = for_b.create<arith::MulIOp>(
+                    row, for_b.create<arith::ConstantIndexOp>(
+                             op.getDestRowStride()));
+                Value dst = for_b.create<ml::GEPOp>(
+                    tile.getType(), llvm_element_type, tile,
+                    GetLinearIndex({dst_index}, for_b));
+                Value row_bytes = for_b.create<arith::ConstantIntOp>(
+                    row_size * element_bytes, i32);
+                EmitInlineAsm(for_b, void_ty,
+                              {for_b.create<ml::PtrToIntOp>(i32, dst), src,
+                               row_bytes, barrier},
+                              "cp.async.bulk.shared::cluster.global.mbarrier::"
+                              "complete_tx::bytes [$0], [$1], $2, [$3];",
+                              "r,l,r,r");
+                for_b.create<scf::YieldOp>();
+              });
+          then_b.create<scf::YieldOp>();
+        });
+
+    // All threads wait for the copies to land.
+    b.create<scf::WhileOp>(
+        TypeRange{}, ValueRange{},
+        [&](OpBuilder& before_builder, Location loc, ValueRange) {
+          mlir::ImplicitLocOpBuilder before_b(loc, before_builder);
+          Value done = EmitInlineAsm(before_b, i32, {barrier},
+                                     "{ .reg .pred p; "
+                                     "mbarrier.try_wait.parity.shared::cta.b64 "
+                                     "p, [$1], 0; selp.u32 $0, 1, 0, p; }",
+                                     "=r,r")
+                           .getRes();
+          before_b.create<scf::ConditionOp>(
+              before_b.create<arith::CmpIOp>(
+                  arith::CmpIPredicate::eq, done,
+                  before_b.create<arith::ConstantIntOp>(0, i32)),
+              ValueRange{});
+        },
+        [&](OpBuilder& after_builder, Location loc, ValueRange) {
+          after_builder.create<scf::YieldOp>(loc);
+        });
+
+    rewriter.replaceOpWithNewOp<UnrealizedConversionCastOp>(
+        op, tile_ty,
+        b.create<ml::AddrSpaceCastOp>(ml::LLVMPointerType::get(op.getContext()),
+                                      tile)
+            .getResult());
+    return success();
+  }
+
+ private:
+  const DeviceSpec& device_spec_;
+};
+
+// Exchanges values between the blocks of a cluster through distributed shared
+// memory: every thread stages its values in shared memory and, after a cluster
+// barrier, reads the ones of the same thread in the other blocks at the
+// addresses mapped by `mapa`.
+class RewriteClusterGather : public OpRewritePattern<gpu::ClusterGatherOp> {
+ public:
+  RewriteClusterGather(mlir::MLIRContext* context,
+                       const DeviceSpec& device_spec)
+      : OpRewritePattern<gpu::ClusterGatherOp>(context),
+        device_spec_(device_spec) {}
+
+  LogicalResult matchAndRewrite(
+      gpu::ClusterGatherOp op, mlir::PatternRewriter& rewriter) const override {
+    if (!device_spec_.IsNvidiaGpu() ||
+        !device_spec_.gpu().cuda_compute_capability().IsAtLeastHopper()) {
+      return rewriter.notifyMatchFailure(
+          op, "thread block clusters are only supported on Hopper and newer");
+    }
+    constexpr int kGPUSharedMemoryAddrSpace = 3;
+    auto module = op->getParentOfType<mlir::ModuleOp>();
+    mlir::ImplicitLocOpBuilder b(op.getLoc(), rewriter);
+
+    llvm::SmallVector<ml::GlobalOp> globals;
+    for (Value operand : op.getOperands()) {
+      globals.push_back(CreateGlobalOp(
+          mlir::Attribute{}, "cluster_shared_",
+          mlir::RankedTensorType::get({op.getThreadsPerBlock()},
+                                      operand.getType()),
+          module, /*is_constant=*/false, kGPUSharedMemoryAddrSpace, b));
+    }
+    b.setInsertionPoint(op);
+
+    mlir::LLVMTypeConverter converter(b.getContext());
+    Type i32 = b.getI32Type();
+    Type i64 = b.getI64Type();
+    auto ptr_ty = ml::LLVMPointerType::get(b.getContext());
+    auto void_ty = ml::LLVMVoidType::get(b.getContext());
+    auto cluster_barrier = [&]() {
+      EmitInlineAsm(b, void_ty, {},
+                    "barrier.cluster.arrive.release.aligned;\n"
+                    "barrier.cluster.wait.acquire.aligned;",
+                    "");
+    };
+
+    Value thread_id = b.create<mlir::gpu::ThreadIdOp>(mlir::gpu::Dimension::x);
+    Value linear_index = GetLinearIndex({thread_id}, b);
+    llvm::SmallVector<Value> slots;
+    llvm::SmallVector<Type> llvm_types;
+    for (auto [operand, global] : llvm::zip(op.getOperands(), globals)) {
+      Value shared = b.create<ml::AddressOfOp>(global);
+      Type llvm_type = converter.convertType(operand.getType());
+      Value slot = b.create<ml::GEPOp>(shared.getType(), llvm_type, shared,
+                                       linear_index);
+      Value value =
+          operand.getType().isIntOrFloat()
+              ? b.create<arith::BitcastOp>(llvm_type, operand).getResult()
+              : b.create<UnrealizedConversionCastOp>(llvm_type, operand)
+                    .getResult(0);
+      b.create<ml::StoreOp>(value, slot);
+      slots.push_back(b.create<ml::PtrToIntOp>(
+          i64, b.create<ml::AddrSpaceCastOp>(ptr_ty, slot)));
+      llvm_types.push_back(llvm_type);
+    }
+    cluster_barrier();
+
+    llvm::SmallVector<Value> results;
+    for (int64_t rank = 0; rank < op.getClusterSize(); ++rank) {
+      Value rank_value = b.create<arith::ConstantIntOp>(rank, i32);
+      for (auto [operand, slot, llvm_type] :
+           llvm::zip(op.getOperands(), slots, llvm_types)) {
+        Value remote = EmitInlineAsm(b, i64, {slot, rank_value},
+                                     "mapa.u64 $0, $1, $2;", "=l,l,r")
+                           .getRes();
+        Value loaded = b.create<ml::LoadOp>(
+            llvm_type, b.create<ml::IntToPtrOp>(ptr_ty, remote));
+        results.push_back(
+            operand.getType().isIntOrFloat()
+                ? b.create<arith::BitcastOp>(operand.getType(), loaded)
+                      .getResult()
+                : b.create<UnrealizedConversionCastOp>(operand.getType(),
+                                                       loaded)
+                      .getResult(0));
+      }
+    }
+    // The shared memory of a block must stay alive until all other blocks
+    // have read from it.
+    cluster_barrier();
+
+    rewriter.replaceOp(op, results);
+    return success();
+  }
+
+ private:
+  const DeviceSpec& device_spec_;
+};
+
 // TODO(jreiffers): Generalize this to support index switches with some used
 // results and upstream it as a canonicalization pattern.
 struct RemoveUnusedIndexSwitchResults : OpRewritePattern<scf::IndexSwitchOp> {
@@ -833,14 +1086,28 @@ class RewriteAtomicRMW : public OpRewritePattern<AtomicRMWOp> {
       std::optional<std::pair<mlir::Value, ml::AtomicBinOp>>
           modifier_parameters,
       mlir::PatternRewriter& rewriter) const {
-    if (device_spec_.IsCpu()) {
-      return failure();  // Unimplemented.
-    }
-
     Value modifier_arg = modifier_parameters->first;
     Type element_type = modifier_arg.getType();
     ml::AtomicBinOp atomic_bin_op = modifier_parameters->second;
 
+    // On CPU we emit LLVM atomic instructions only for 32- and 64-bit integer
+    // and floating point additions, and let LLVM lower them to native atomic
+    // instructions (or compare-and-swap loops if the target doesn't have
+    // them). All other computations are lowered to compare-and-swap loops.
+    if (device_spec_.IsCpu()) {
+      bool is_supported_width = element_type.isIntOrFloat() &&
+                                (element_type.getIntOrFloatBitWidth() == 32 ||
+                                 element_type.getIntOrFloatBitWidth() == 64);
+      bool is_supported_op =
+          (atomic_bin_op == ml::AtomicBinOp::add &&
+           element_type.isInteger()) ||
+          (atomic_bin_op == ml::AtomicBinOp::fadd &&
+           (element_type.isF32() || element_type.isF64()));
+      if (!is_supported_width || !is_supported_op) {
+        return failure();
+      }
+    }
+
     Location loc = op.getLoc();
     auto sync_scope = determinateScope();
     mlir::ImplicitLocOpBuilder b(loc, rewriter);
@@ -866,6 +1133,13 @@ class RewriteAtomicRMW : public OpRewritePattern<AtomicRMWOp> {
         return success();
       }
       case ml::AtomicBinOp::fadd: {
+        if (device_spec_.IsCpu()) {
+          rewriter.create<ml::AtomicRMWOp>(loc, atomic_bin_op, addr,
+                                           modifier_arg,
+                                           ml::AtomicOrdering::monotonic,
+                                           sync_scope);
+          return success();
+        }
         // TODO(b/336367154): Introduce an atomic_rmw op with the binOp attr.
         return device_spec_.IsAmdGpu()
                    ? emitAMDAtomicFAdd(
@@ -1283,7 +1557,8 @@ class LowerTensorsPass : public impl::LowerTensorsPassBase<LowerTensorsPass> {
     MLIRContext* mlir_context = &getContext();
     mlir::RewritePatternSet tensor_patterns(mlir_context);
 
-    tensor_patterns.add<RewriteAtomicRMW>(mlir_context, device_spec_);
+    tensor_patterns.add<RewriteAtomicRMW, RewriteBulkLoadToShared,
+                        RewriteClusterGather>(mlir_context, device_spec_);
     tensor_patterns
         .add<RewriteAllocateShared, RewriteNonScalarConstants,
              RewriteSyncThreads, RewriteTensorExtract, RewriteTransferRead,
@@ -1318,9 +1593,10 @@ class LowerTensorsPass : public impl::LowerTensorsPassBase<LowerTensorsPass> {
       }
       if (addr.getDefiningOp<ml::AddrSpaceCastOp>() ||
           addr.getDefiningOp<ml::AddressOfOp>() ||
-          addr.getDefiningOp<ml::AllocaOp>()) {
-        // Shared memory, global constant or temporary - no need to annotate
-        // anything.
+          addr.getDefiningOp<ml::AllocaOp>() ||
+          addr.getDefiningOp<ml::IntToPtrOp>()) {
+        // Shared memory (possibly of another block in the cluster), global
+        // constant or temporary - no need to annotate anything.
         return;
       }
       if (auto base = mlir::dyn_cast<mlir::BlockArgument>(addr)) {
@@ -1033,3 +1033,42 @@ func.func @transfer_write_f4(%arg0: tensor<43xf4E2M1FN> {xla.slice_index = 1},
 // CHECK-LABEL: @transfer_write_f4
 // CHECK: %[[PTR:.*]] = llvm.getelementptr inbounds %arg0[5] : (!llvm.ptr) -> !llvm.ptr, i8
 // CHECK: %[[OUT:.*]] = builtin.unrealized_conversion_cast %{{.*}} : vector<2xf4E2M1FN> to vector<2xi4>
+
+// -----
+
+func.func @bulk_load_to_shared(%arg0: tensor<8192xf32>, %offset: index)
+    -> f32 {
+  %c1 = arith.constant 1 : index
+  %shmem = xla_gpu.bulk_load_to_shared %arg0[%offset] row_size 32
+    row_stride 128 dest_row_stride 36 : tensor<8192xf32> -> tensor<1152xf32>
+  %v = tensor.extract %shmem[%c1] : tensor<1152xf32>
+  return %v : f32
+}
+// CHECK-HOPPER: llvm.mlir.global private @mbarrier_0() {addr_space = 3 : i32, alignment = 8 : i64}
+// CHECK-HOPPER: llvm.mlir.global private @shared_0() {addr_space = 3 : i32, alignment = 128 : i64}
+// CHECK-HOPPER-LABEL: @bulk_load_to_shared
+// CHECK-HOPPER: mbarrier.init.shared::cta.b64
+// CHECK-HOPPER: mbarrier.arrive.expect_tx.shared::cta.b64 _, [$0], $1;
+// CHECK-HOPPER: gpu.barrier
+// CHECK-HOPPER: scf.for
+// CHECK-HOPPER: cp.async.bulk.shared::cluster.global.mbarrier::complete_tx::bytes
+// CHECK-HOPPER: scf.while
+// CHECK-HOPPER: mbarrier.try_wait.parity.shared::cta.b64
+// CHECK-HOPPER: %[[SHMEM:.*]] = llvm.addrspacecast
+// CHECK-HOPPER: llvm.getelementptr inbounds %[[SHMEM]][1]
+
+// -----
+
+func.func @cluster_gather(%arg0: f32) -> f32 {
+  %all:2 = xla_gpu.cluster_gather(%arg0) cluster_size 2 threads_per_block 128
+    : f32 -> f32, f32
+  %sum = arith.addf %all#0, %all#1 : f32
+  return %sum : f32
+}
+// CHECK-HOPPER: llvm.mlir.global private @cluster_shared_0()
+// CHECK-HOPPER-SAME: {addr_space = 3 : i32} : !llvm.array<128 x f32>
+// CHECK-HOPPER-LABEL: @cluster_gather
+// CHECK-HOPPER: llvm.store
+// CHECK-HOPPER: barrier.cluster.arrive.release.aligned
+// CHECK-HOPPER-COUNT-2: mapa.u64
+// CHECK-HOPPER: barrier.cluster.arrive.release.aligned
@@ -15,3 +15,53 @@ func.func @load_non_gep_from_args(%arg0: !llvm.ptr) -> !llvm.ptr {
 // CHECK-NEXT:    %1 = llvm.load %0 : !llvm.ptr -> !llvm.ptr
 // CHECK-NEXT:    %2 = llvm.load %1 : !llvm.ptr -> !llvm.ptr
 // CHECK-NEXT:    return %2 : !llvm.ptr
+
+// -----
+
+func.func @direct_atomic_rmw_fadd_f32(%in: tensor<8xf32>, %i: index)
+    -> (tensor<8xf32>) {
+  %c2 = arith.constant 2.0 : f32
+  %ret = xla.atomic_rmw %in[%i] : tensor<8xf32> {
+    ^bb0(%current : f32):
+      %add = arith.addf %current, %c2 : f32
+      xla.yield %add : f32
+  }
+  return %ret : tensor<8xf32>
+}
+// CHECK-LABEL: @direct_atomic_rmw_fadd_f32
+// CHECK: %[[C2:.*]] = arith.constant 2
+// CHECK: %[[ADDR:.*]] = llvm.getelementptr
+// CHECK: llvm.atomicrmw fadd %[[ADDR]], %[[C2]] monotonic
+
+// -----
+
+func.func @direct_atomic_rmw_addi(%in: tensor<8xi32>, %i: index)
+    -> (tensor<8xi32>) {
+  %c2 = arith.constant 2 : i32
+  %ret = xla.atomic_rmw %in[%i] : tensor<8xi32> {
+    ^bb0(%current : i32):
+      %add = arith.addi %current, %c2 : i32
+      xla.yield %add : i32
+  }
+  return %ret : tensor<8xi32>
+}
+// CHECK-LABEL: @direct_atomic_rmw_addi
+// CHECK: %[[C2:.*]] = arith.constant 2
+// CHECK: %[[ADDR:.*]] = llvm.getelementptr
+// CHECK: llvm.atomicrmw add %[[ADDR]], %[[C2]] monotonic
+
+// -----
+
+func.func @atomic_rmw_maxsi_cas(%in: tensor<8xi32>, %i: index)
+    -> (tensor<8xi32>) {
+  %c2 = arith.constant 2 : i32
+  %ret = xla.atomic_rmw %in[%i] : tensor<8xi32> {
+    ^bb0(%current : i32):
+      %max = arith.maxsi %current, %c2 : i32
+      xla.yield %max : i32
+  }
+  return %ret : tensor<8xi32>
+}
+// CHECK-LABEL: @atomic_rmw_maxsi_cas
+// CHECK-NOT: llvm.atomicrmw
+// CHECK: llvm.cmpxchg
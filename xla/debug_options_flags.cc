@@ -69,7 +69,10 @@ DebugOptions DefaultDebugOptionsIgnoringFlags() {
   opts.set_xla_llvm_disable_expensive_passes(false);
   opts.set_xla_backend_optimization_level(3);
   opts.set_xla_gpu_autotune_level(4);
+  opts.set_xla_gpu_autotune_check_winner_only(false);
   opts.set_xla_gpu_autotune_max_solutions(0);
+  opts.set_xla_gpu_autotune_num_profiling_devices(1);
+  opts.set_xla_gpu_autotune_gemm_fusion_m_buckets(false);
   opts.set_xla_cpu_multi_thread_eigen(true);
   opts.set_xla_gpu_cuda_data_dir("./cuda_sdk_lib");
   opts.set_xla_gpu_generate_debug_info(false);
@@ -88,6 +91,8 @@ DebugOptions DefaultDebugOptionsIgnoringFlags() {
   opts.set_xla_dump_fusion_visualization(false);
   opts.set_xla_dump_include_timestamp(false);
   opts.set_xla_dump_max_hlo_modules(-1);
+  opts.set_xla_dump_async_threads(0);
+  opts.set_xla_dump_async_max_pending_modules(16);
   opts.set_xla_dump_module_metadata(false);
   opts.set_xla_dump_hlo_as_long_text(true);
   opts.set_xla_dump_large_constants(false);
@@ -106,7 +111,11 @@ DebugOptions DefaultDebugOptionsIgnoringFlags() {
       DebugOptions::XNN_GRAPH_FUSION_MODE_DISABLED);
   opts.set_xla_cpu_parallel_codegen_split_count(32);
   opts.set_xla_cpu_copy_insertion_use_region_analysis(false);
+  opts.set_xla_cpu_enable_async_collectives(false);
   opts.set_xla_cpu_enable_concurrency_optimized_scheduler(true);
+  opts.set_xla_cpu_enable_critical_path_scheduling(false);
+  opts.set_xla_cpu_persistent_cache_dir("");
+  opts.set_xla_cpu_enable_temp_buffer_arena(false);
   opts.set_xla_cpu_prefer_vector_width(256);
   opts.set_xla_cpu_max_isa(DefaultMaxIsa());
   opts.set_xla_cpu_generate_unique_c_style_kernel_entry_points(false);
@@ -131,6 +140,7 @@ DebugOptions DefaultDebugOptionsIgnoringFlags() {
   opts.add_xla_gpu_enable_command_buffer(DebugOptions::CUSTOM_CALL);
   opts.add_xla_gpu_enable_command_buffer(DebugOptions::CUDNN);
   opts.set_xla_gpu_graph_min_graph_size(5);
+  opts.set_xla_gpu_kernel_launch_batch_min_size(0);
   opts.set_xla_gpu_graph_enable_concurrent_region(false);
   opts.set_xla_cmd_buffer_trace_cache_size(16);
 
@@ -145,6 +155,9 @@ DebugOptions DefaultDebugOptionsIgnoringFlags() {
   opts.set_xla_force_host_platform_device_count(1);
   opts.set_xla_gpu_all_reduce_combine_threshold_bytes(
       kDefaultAllReduceCombineThreshold);
+  opts.set_xla_gpu_all_reduce_blueconnect_min_size_bytes(1024 * 1024);
+  opts.set_xla_gpu_experimental_all_reduce_compression_min_size_bytes(0);
+  opts.set_xla_gpu_experimental_scheduler_num_devices_per_host(0);
   opts.set_xla_gpu_all_gather_combine_threshold_bytes(
       kDefaultAllGatherCombineThreshold);
   opts.set_xla_gpu_reduce_scatter_combine_threshold_bytes(
@@ -165,6 +178,7 @@ DebugOptions DefaultDebugOptionsIgnoringFlags() {
 
   opts.set_xla_gpu_enable_custom_fusions(false);
   opts.set_xla_gpu_enable_dynamic_slice_fusion(false);
+  opts.set_xla_gpu_dynamic_slice_fusion_runtime_offsets(false);
   opts.set_xla_gpu_nccl_termination_timeout_seconds(-1);
   opts.set_xla_gpu_enable_shared_constants(true);
   opts.set_xla_gpu_enable_nccl_user_buffers(false);
@@ -192,6 +206,9 @@ DebugOptions DefaultDebugOptionsIgnoringFlags() {
   sol_estimator_defaults->emplace(kSolChunkSizeBytes, "-1");
   sol_estimator_defaults->emplace(kSolGpusPerNode, "-1");
   opts.set_xla_gpu_pgle_profile_file_or_directory_path("");
+  opts.set_xla_gpu_experimental_fusion_profile_path("");
+  opts.set_xla_gpu_experimental_enable_fusion_runtime_memo(false);
+  opts.set_xla_gpu_experimental_lhs_rematerialization_headroom_percent(0);
   opts.set_xla_gpu_memory_limit_slop_factor(95);
   opts.set_xla_gpu_enable_highest_priority_async_stream(true);
 
@@ -221,6 +238,7 @@ DebugOptions DefaultDebugOptionsIgnoringFlags() {
   // Moving reduce-scatter out of while loops can increase memory footprint, so
   // turning it off by default.
   opts.set_xla_gpu_enable_while_loop_reduce_scatter_code_motion(false);
+  opts.set_xla_gpu_while_loop_all_gather_code_motion_memory_limit_bytes(0);
 
   opts.set_xla_gpu_collective_inflation_factor(1);
   opts.set_xla_llvm_force_inline_before_split(true);
@@ -237,6 +255,7 @@ DebugOptions DefaultDebugOptionsIgnoringFlags() {
   opts.set_xla_gpu_enable_split_k_autotuning(true);
 
   opts.set_xla_gpu_enable_reduction_epilogue_fusion(true);
+  opts.set_xla_gpu_accumulate_bf16_reductions_in_f32(false);
   opts.set_xla_gpu_cublas_fallback(true);
   opts.set_xla_gpu_cudnn_gemm_fusion_level(0);
   opts.set_xla_gpu_enable_while_loop_double_buffering(false);
@@ -246,6 +265,7 @@ DebugOptions DefaultDebugOptionsIgnoringFlags() {
   opts.set_xla_gpu_fail_ptx_compilation_on_register_spilling(false);
   opts.set_xla_gpu_llvm_verification_level(0);
   opts.set_xla_gpu_target_config_filename("");
+  opts.set_xla_gpu_sm_budget(0);
   opts.set_xla_gpu_enable_cub_radix_sort(true);
   opts.set_xla_gpu_enable_cudnn_layer_norm(false);
   opts.set_xla_gpu_threshold_for_windowed_einsum_mib(100000);
@@ -253,9 +273,12 @@ DebugOptions DefaultDebugOptionsIgnoringFlags() {
 
   opts.set_xla_gpu_enable_triton_hopper(false);
   opts.set_xla_gpu_experimental_enable_dynamic_dot_search_space(true);
+  opts.set_xla_gpu_experimental_autotune_cost_model_top_k(0);
   opts.set_xla_gpu_experimental_enable_fusion_block_level_rewriter(false);
 
   opts.set_xla_gpu_enable_llvm_module_compilation_parallelism(false);
+  opts.set_xla_gpu_llvm_module_compilation_splits_per_thread(1);
+  opts.set_xla_gpu_llvm_module_compilation_auto_split_min_instructions(0);
   opts.set_xla_gpu_enable_libnvptxcompiler(
       stream_executor::IsLibNvPtxCompilerSupported());
   opts.set_xla_gpu_libnvjitlink_mode(DebugOptions::LIB_NV_JIT_LINK_MODE_AUTO);
@@ -263,6 +286,7 @@ DebugOptions DefaultDebugOptionsIgnoringFlags() {
   opts.set_xla_gpu_nccl_collective_max_nchannels(0);
   opts.set_xla_gpu_nccl_p2p_max_nchannels(0);
   opts.set_xla_gpu_multi_streamed_windowed_einsum(true);
+  opts.set_xla_gpu_num_concurrent_fusion_streams(0);
 
   opts.set_xla_gpu_experimental_stream_annotation(true);
   // Minimum combined size of matrices in matrix multiplication to
@@ -280,6 +304,11 @@ DebugOptions DefaultDebugOptionsIgnoringFlags() {
   opts.set_xla_gpu_require_complete_aot_autotune_results(false);
 
   opts.set_xla_gpu_enable_host_memory_offloading(false);
+  opts.set_xla_gpu_host_memory_offload_bandwidth(0);
+  opts.set_xla_gpu_experimental_compute_aware_rematerialization(false);
+  opts.set_xla_gpu_experimental_l2_persist_loop_invariants(false);
+  opts.set_xla_gpu_experimental_host_offload_streaming_chunks(0);
+  opts.set_xla_gpu_experimental_alltoall_windowed_einsum_min_split_bytes(0);
 
   opts.set_xla_gpu_nccl_terminate_on_error(false);
 
@@ -303,6 +332,7 @@ DebugOptions DefaultDebugOptionsIgnoringFlags() {
 
   opts.set_xla_gpu_executable_warn_stuck_timeout_seconds(10);
   opts.set_xla_gpu_executable_terminate_timeout_seconds(30);
+  opts.set_xla_gpu_executable_thunk_device_time_sampling_period(0);
 
   opts.set_xla_gpu_first_collective_call_warn_stuck_timeout_seconds(20);
   opts.set_xla_gpu_first_collective_call_terminate_timeout_seconds(40);
@@ -314,6 +344,7 @@ DebugOptions DefaultDebugOptionsIgnoringFlags() {
   // are load-bearing.
   opts.set_xla_ignore_channel_id(false);
   opts.set_xla_gpu_dot_merger_threshold_mb(32);
+  opts.set_xla_gpu_dot_merger_batch_independent_dots(false);
   opts.set_xla_enable_fast_math(false);
   opts.set_xla_gpu_experimental_parallel_collective_overlap_limit(1);
   opts.set_xla_pjrt_allow_auto_layout_in_hlo(false);
@@ -326,6 +357,8 @@ DebugOptions DefaultDebugOptionsIgnoringFlags() {
   opts.set_xla_unsupported_crash_on_hlo_pass_fix_max_iterations(false);
   opts.set_xla_hlo_pass_fix_detect_cycles(false);
   opts.set_xla_gpu_experimental_enable_sync_collective_combining(false);
+  opts.set_xla_gpu_experimental_adaptive_combine_threshold(false);
+  opts.set_xla_gpu_experimental_enable_normalization_fusion(false);
   opts.set_xla_unsupported_crash_on_hlo_pass_silent_hlo_change(false);
   opts.set_xla_unsupported_crash_on_hlo_pass_noop_change(false);
   opts.set_xla_gpu_experimental_enable_split_k_rewrite(false);
@@ -1004,6 +1037,12 @@ void MakeDebugOptionsFlags(std::vector<tsl::Flag>* flag_list,
           &DebugOptions::set_xla_cpu_copy_insertion_use_region_analysis),
       debug_options->xla_cpu_copy_insertion_use_region_analysis(),
       "Use region based analysis in copy insertion pass."));
+  flag_list->push_back(tsl::Flag(
+      "xla_cpu_enable_async_collectives",
+      bool_setter_for(&DebugOptions::set_xla_cpu_enable_async_collectives),
+      debug_options->xla_cpu_enable_async_collectives(),
+      "Run XLA:CPU collective operations asynchronously on a dedicated "
+      "per-device thread, so that they overlap with independent compute."));
   flag_list->push_back(tsl::Flag(
       "xla_cpu_enable_concurrency_optimized_scheduler",
       bool_setter_for(
@@ -1011,6 +1050,25 @@ void MakeDebugOptionsFlags(std::vector<tsl::Flag>* flag_list,
       debug_options->xla_cpu_enable_concurrency_optimized_scheduler(),
       "Use HLO module scheduler that is optimized for extracting concurrency "
       "from an HLO module by trading off extra memory pressure."));
+  flag_list->push_back(tsl::Flag(
+      "xla_cpu_enable_critical_path_scheduling",
+      bool_setter_for(
+          &DebugOptions::set_xla_cpu_enable_critical_path_scheduling),
+      debug_options->xla_cpu_enable_critical_path_scheduling(),
+      "Prioritize thunks on the critical path of the thunk DAG at run time, "
+      "using per-thunk costs estimated by the HLO cost analysis."));
+  flag_list->push_back(tsl::Flag(
+      "xla_cpu_enable_temp_buffer_arena",
+      bool_setter_for(&DebugOptions::set_xla_cpu_enable_temp_buffer_arena),
+      debug_options->xla_cpu_enable_temp_buffer_arena(),
+      "Pack XLA:CPU temporary buffers into an arena that is reused across "
+      "executions instead of allocating them on every run."));
+  flag_list->push_back(tsl::Flag(
+      "xla_cpu_persistent_cache_dir",
+      string_setter_for(&DebugOptions::set_xla_cpu_persistent_cache_dir),
+      debug_options->xla_cpu_persistent_cache_dir(),
+      "If non-empty, XLA:CPU caches compiled executables in the given "
+      "directory and reuses them for identical HLO modules."));
   flag_list->push_back(tsl::Flag(
       "xla_cpu_prefer_vector_width",
       int32_setter_for(&DebugOptions::set_xla_cpu_prefer_vector_width),
@@ -1049,12 +1107,33 @@ void MakeDebugOptionsFlags(std::vector<tsl::Flag>* flag_list,
       "in the list) solution is numerically CORRECT. Otherwise, the autotuner "
       "might discard many other correct solutions based on the failed "
       "BufferComparator test."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_autotune_check_winner_only",
+      bool_setter_for(&DebugOptions::set_xla_gpu_autotune_check_winner_only),
+      debug_options->xla_gpu_autotune_check_winner_only(),
+      "With xla_gpu_autotune_level >= 4, only check the reference and the "
+      "fastest GEMM solutions for correctness and out-of-bounds writes, "
+      "falling back to the next fastest solution if the check fails."));
   flag_list->push_back(tsl::Flag(
       "xla_gpu_autotune_max_solutions",
       int64_setter_for(&DebugOptions::set_xla_gpu_autotune_max_solutions),
       debug_options->xla_gpu_autotune_max_solutions(),
       "Maximal number of GEMM solutions to consider for autotuning: 0 means "
       "consider all solutions returned by the GEMM library."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_autotune_num_profiling_devices",
+      int32_setter_for(
+          &DebugOptions::set_xla_gpu_autotune_num_profiling_devices),
+      debug_options->xla_gpu_autotune_num_profiling_devices(),
+      "Number of local devices of the same model used to profile GEMM fusion "
+      "autotuning candidates in parallel: 0 means all such local devices."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_autotune_gemm_fusion_m_buckets",
+      bool_setter_for(
+          &DebugOptions::set_xla_gpu_autotune_gemm_fusion_m_buckets),
+      debug_options->xla_gpu_autotune_gemm_fusion_m_buckets(),
+      "Share GEMM fusion autotuning results between fusions that only differ "
+      "in their M dimension, within power of two buckets of M."));
   flag_list->push_back(tsl::Flag(
       "xla_gpu_autotune_gemm_rtol",
       float_setter_for(&DebugOptions::set_xla_gpu_autotune_gemm_rtol),
@@ -1221,6 +1300,20 @@ void MakeDebugOptionsFlags(std::vector<tsl::Flag>* flag_list,
                 bool_setter_for(&DebugOptions::set_xla_dump_compress_protos),
                 debug_options->xla_dump_compress_protos(),
                 "Gzip-compress protos dumped by --xla_dump_hlo_as_proto."));
+  flag_list->push_back(
+      tsl::Flag("xla_dump_async_threads",
+                int32_setter_for(&DebugOptions::set_xla_dump_async_threads),
+                debug_options->xla_dump_async_threads(),
+                "Number of background threads writing the HLO dumps between "
+                "and during passes, which only snapshot the module on the "
+                "compile thread. Set to 0 to dump synchronously."));
+  flag_list->push_back(tsl::Flag(
+      "xla_dump_async_max_pending_modules",
+      int32_setter_for(&DebugOptions::set_xla_dump_async_max_pending_modules),
+      debug_options->xla_dump_async_max_pending_modules(),
+      "Max number of module snapshots waiting for --xla_dump_async_threads. "
+      "Compilation waits for a dump to finish when there are that many. Set "
+      "to <= 0 for unbounded."));
   flag_list->push_back(tsl::Flag(
       "xla_hlo_graph_addresses",
       bool_setter_for(&DebugOptions::set_xla_hlo_graph_addresses),
@@ -1313,6 +1406,26 @@ void MakeDebugOptionsFlags(std::vector<tsl::Flag>* flag_list,
       "number of threads depends on the "
       "--xla_gpu_force_compilation_parallelism flag and the thread pool "
       "supplied to GpuCompiler."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_llvm_module_compilation_splits_per_thread",
+      int32_setter_for(
+          &DebugOptions::
+              set_xla_gpu_llvm_module_compilation_splits_per_thread),
+      debug_options->xla_gpu_llvm_module_compilation_splits_per_thread(),
+      "Number of LLVM modules per compilation thread for parallel LLVM "
+      "module compilation. Values larger than 1 overlap LLVM code generation "
+      "and PTX compilation of different modules and balance work between "
+      "threads."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_llvm_module_compilation_auto_split_min_instructions",
+      int64_setter_for(
+          &DebugOptions::
+              set_xla_gpu_llvm_module_compilation_auto_split_min_instructions),
+      debug_options
+          ->xla_gpu_llvm_module_compilation_auto_split_min_instructions(),
+      "If positive, split LLVM modules with at least this many instructions "
+      "for parallel compilation when the compiler has several threads, even "
+      "if --xla_gpu_enable_llvm_module_compilation_parallelism is off."));
 
   flag_list->push_back(
       tsl::Flag("xla_gpu_deterministic_ops",
@@ -1342,7 +1455,9 @@ void MakeDebugOptionsFlags(std::vector<tsl::Flag>* flag_list,
       "`WHILE_LOOP_UNROLLING_DOUBLE_BUFFER` unrolls the loop by factor of 2, "
       "`WHILE_LOOP_UNROLLING_FULL_UNROLL` will unroll the entire loop "
       "`WHILE_LOOP_UNROLLING_AUTO_UNROLL` unrolls by a factor of 2, if there is"
-      " any collective present within a while loop."));
+      " any collective present within a while loop, "
+      "`WHILE_LOOP_UNROLLING_COST_MODEL` fully unrolls small launch bound "
+      "loops and double buffers other loops with collectives."));
   flag_list->push_back(tsl::Flag(
       "xla_gpu_all_reduce_combine_threshold_bytes",
       int64_setter_for(
@@ -1400,6 +1515,31 @@ void MakeDebugOptionsFlags(std::vector<tsl::Flag>* flag_list,
       "ReduceScatter-AllReduce-AllGather sequence, with the initial "
       "ReduceScatter being performed over all of the devices in the same host. "
       "Set to < 1 to disable all-reduce decomposition."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_all_reduce_blueconnect_min_size_bytes",
+      int64_setter_for(
+          &DebugOptions::set_xla_gpu_all_reduce_blueconnect_min_size_bytes),
+      debug_options->xla_gpu_all_reduce_blueconnect_min_size_bytes(),
+      "Minimum size in bytes of all-reduces decomposed by the BlueConnect "
+      "pass. Smaller all-reduces are left as a single collective."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_experimental_all_reduce_compression_min_size_bytes",
+      int64_setter_for(
+          &DebugOptions::
+              set_xla_gpu_experimental_all_reduce_compression_min_size_bytes),
+      debug_options
+          ->xla_gpu_experimental_all_reduce_compression_min_size_bytes(),
+      "If positive, f32 sum all-reduces of at least this many bytes exchange "
+      "data in bf16 over the wire and accumulate in f32. Disabled if <= 0."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_experimental_scheduler_num_devices_per_host",
+      int32_setter_for(
+          &DebugOptions::
+              set_xla_gpu_experimental_scheduler_num_devices_per_host),
+      debug_options->xla_gpu_experimental_scheduler_num_devices_per_host(),
+      "Number of devices per host used by the latency hiding scheduler to "
+      "track collectives across hosts separately from collectives within a "
+      "host. Disabled if <= 0."));
   flag_list->push_back(tsl::Flag(
       "xla_gpu_enable_while_loop_reduce_scatter_code_motion",
       bool_setter_for(
@@ -1407,6 +1547,16 @@ void MakeDebugOptionsFlags(std::vector<tsl::Flag>* flag_list,
               set_xla_gpu_enable_while_loop_reduce_scatter_code_motion),
       debug_options->xla_gpu_enable_while_loop_reduce_scatter_code_motion(),
       "Enable hoisting of reduce-scatter outside while loops."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_while_loop_all_gather_code_motion_memory_limit_bytes",
+      int64_setter_for(
+          &DebugOptions::
+              set_xla_gpu_while_loop_all_gather_code_motion_memory_limit_bytes),
+      debug_options
+          ->xla_gpu_while_loop_all_gather_code_motion_memory_limit_bytes(),
+      "Hoist all-gathers of loop invariant values out of while loops, as long "
+      "as the gathered values of a loop take at most this many bytes. "
+      "Disabled if <= 0."));
   flag_list->push_back(tsl::Flag(
       "xla_gpu_collective_inflation_factor",
       int32_setter_for(&DebugOptions::set_xla_gpu_collective_inflation_factor),
@@ -1492,6 +1642,14 @@ void MakeDebugOptionsFlags(std::vector<tsl::Flag>* flag_list,
       debug_options->xla_gpu_graph_min_graph_size(),
       "Capture a region as a function to be launched as cuda graph if the "
       "number of moved instructions reaches this threshold."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_kernel_launch_batch_min_size",
+      int32_setter_for(
+          &DebugOptions::set_xla_gpu_kernel_launch_batch_min_size),
+      debug_options->xla_gpu_kernel_launch_batch_min_size(),
+      "Batch runs of at least this many consecutive small kernel launches "
+      "into a single command buffer launch. Values smaller than 2 disable "
+      "kernel launch batching."));
   flag_list->push_back(
       tsl::Flag("xla_gpu_graph_enable_concurrent_region",
                 bool_setter_for(
@@ -1548,6 +1706,14 @@ void MakeDebugOptionsFlags(std::vector<tsl::Flag>* flag_list,
       bool_setter_for(&DebugOptions::set_xla_gpu_enable_dynamic_slice_fusion),
       debug_options->xla_gpu_enable_dynamic_slice_fusion(),
       "Whether to enable XLA address computation fusion"));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_dynamic_slice_fusion_runtime_offsets",
+      bool_setter_for(
+          &DebugOptions::set_xla_gpu_dynamic_slice_fusion_runtime_offsets),
+      debug_options->xla_gpu_dynamic_slice_fusion_runtime_offsets(),
+      "Allows XLA address computation fusion to write library call results "
+      "into dynamic-update-slices with offsets computed at run time. The "
+      "offsets are copied to the host before the call."));
   flag_list->push_back(tsl::Flag(
       "xla_gpu_nccl_termination_timeout_seconds",
       int64_setter_for(
@@ -1672,6 +1838,32 @@ void MakeDebugOptionsFlags(std::vector<tsl::Flag>* flag_list,
           &DebugOptions::set_xla_gpu_pgle_profile_file_or_directory_path),
       debug_options->xla_gpu_pgle_profile_file_or_directory_path(),
       "Directory or file for PGLE profiles in XLA:GPU"));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_experimental_fusion_profile_path",
+      string_setter_for(
+          &DebugOptions::set_xla_gpu_experimental_fusion_profile_path),
+      debug_options->xla_gpu_experimental_fusion_profile_path(),
+      "File with measured fusion runtimes keyed by fusion fingerprint, which "
+      "priority fusion uses instead of the analytical estimates."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_experimental_enable_fusion_runtime_memo",
+      bool_setter_for(
+          &DebugOptions::set_xla_gpu_experimental_enable_fusion_runtime_memo),
+      debug_options->xla_gpu_experimental_enable_fusion_runtime_memo(),
+      "Share performance model estimates in priority fusion between "
+      "structurally identical instructions, within a module and across "
+      "compilations in the same process."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_experimental_lhs_rematerialization_headroom_percent",
+      int32_setter_for(
+          &DebugOptions::
+              set_xla_gpu_experimental_lhs_rematerialization_headroom_percent),
+      debug_options
+          ->xla_gpu_experimental_lhs_rematerialization_headroom_percent(),
+      "Percentage by which the latency hiding scheduler may exceed the "
+      "scheduler memory limit. HLO rematerialization still enforces the "
+      "original limit after scheduling, trading recomputation of producers for "
+      "compute-communication overlap. 0 disables this."));
   flag_list->push_back(tsl::Flag(
       "xla_gpu_memory_limit_slop_factor",
       int32_setter_for(&DebugOptions::set_xla_gpu_memory_limit_slop_factor),
@@ -1887,6 +2079,14 @@ void MakeDebugOptionsFlags(std::vector<tsl::Flag>* flag_list,
           &DebugOptions::set_xla_gpu_enable_reduction_epilogue_fusion),
       debug_options->xla_gpu_enable_reduction_epilogue_fusion(),
       "Enable fusion for reduction epilogues"));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_accumulate_bf16_reductions_in_f32",
+      bool_setter_for(
+          &DebugOptions::set_xla_gpu_accumulate_bf16_reductions_in_f32),
+      debug_options->xla_gpu_accumulate_bf16_reductions_in_f32(),
+      "Accumulate bf16 reductions with arithmetic reducers (add, multiply, "
+      "subtract) in f32 registers, even on GPUs with native bf16 arithmetic. "
+      "The inputs are still read as bf16."));
   flag_list->push_back(tsl::Flag("xla_gpu_enable_nccl_clique_optimization",
                                  noop_flag_setter<bool>, false,
                                  "[Deprecated, do not use]."));
@@ -1944,6 +2144,12 @@ void MakeDebugOptionsFlags(std::vector<tsl::Flag>* flag_list,
       "Filename for GPU TargetConfig. Triggers devicless compilation: attached "
       "device is "
       "ignored, and the proto is queried instead"));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_sm_budget",
+      int64_setter_for(&DebugOptions::set_xla_gpu_sm_budget),
+      debug_options->xla_gpu_sm_budget(),
+      "If positive, the number of SMs the compiler assumes it has, for sharing "
+      "the device with other processes, e.g. through MPS. 0 means all SMs."));
   flag_list->push_back(tsl::Flag(
       "xla_gpu_enable_cub_radix_sort",
       bool_setter_for(&DebugOptions::set_xla_gpu_enable_cub_radix_sort),
@@ -1983,6 +2189,14 @@ void MakeDebugOptionsFlags(std::vector<tsl::Flag>* flag_list,
       "Enable dynamically generating and pruning the autotuning search space "
       "for Triton dot fusions, based on the properties of the problem and "
       "hardware (shapes, instructions, GPU limits, etc.)."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_experimental_autotune_cost_model_top_k",
+      int32_setter_for(
+          &DebugOptions::set_xla_gpu_experimental_autotune_cost_model_top_k),
+      debug_options->xla_gpu_experimental_autotune_cost_model_top_k(),
+      "If positive, only autotune this many Triton dot fusion configs of the "
+      "dynamic search space, picked by ranking them with the analytical dot "
+      "fusion cost model."));
   flag_list->push_back(tsl::Flag(
       "xla_gpu_experimental_enable_fusion_block_level_rewriter",
       bool_setter_for(
@@ -2037,6 +2251,14 @@ void MakeDebugOptionsFlags(std::vector<tsl::Flag>* flag_list,
           &DebugOptions::set_xla_gpu_multi_streamed_windowed_einsum),
       debug_options->xla_gpu_multi_streamed_windowed_einsum(),
       "Whether to run windowed einsum using multiple compute streams."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_num_concurrent_fusion_streams",
+      int32_setter_for(
+          &DebugOptions::set_xla_gpu_num_concurrent_fusion_streams),
+      debug_options->xla_gpu_num_concurrent_fusion_streams(),
+      "Number of compute streams used to run independent fusions "
+      "concurrently, both eagerly and inside command buffers. Values smaller "
+      "than 2 disable concurrent fusion execution."));
   flag_list->push_back(tsl::Flag(
       "xla_gpu_gemm_rewrite_size_threshold",
       int64_setter_for(&DebugOptions::set_xla_gpu_gemm_rewrite_size_threshold),
@@ -2066,6 +2288,37 @@ void MakeDebugOptionsFlags(std::vector<tsl::Flag>* flag_list,
       bool_setter_for(&DebugOptions::set_xla_gpu_enable_host_memory_offloading),
       debug_options->xla_gpu_enable_host_memory_offloading(),
       "Whether to trigger host memory offloading on a device."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_host_memory_offload_bandwidth",
+      int64_setter_for(
+          &DebugOptions::set_xla_gpu_host_memory_offload_bandwidth),
+      debug_options->xla_gpu_host_memory_offload_bandwidth(),
+      "Bandwidth in bytes per second between device and host memory used to "
+      "decide which buffers to offload to host memory. If 0, the bandwidth is "
+      "estimated from the device."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_experimental_compute_aware_rematerialization",
+      bool_setter_for(
+          &DebugOptions::
+              set_xla_gpu_experimental_compute_aware_rematerialization),
+      debug_options->xla_gpu_experimental_compute_aware_rematerialization(),
+      "Whether rematerialization prefers recomputing the instructions which "
+      "are cheapest to recompute over the ones freeing the most memory."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_experimental_l2_persist_loop_invariants",
+      bool_setter_for(
+          &DebugOptions::set_xla_gpu_experimental_l2_persist_loop_invariants),
+      debug_options->xla_gpu_experimental_l2_persist_loop_invariants(),
+      "Whether to keep the largest loop-invariant operand of a while loop in "
+      "the persisting part of the L2 cache while the loop runs."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_experimental_host_offload_streaming_chunks",
+      int64_setter_for(
+          &DebugOptions::
+              set_xla_gpu_experimental_host_offload_streaming_chunks),
+      debug_options->xla_gpu_experimental_host_offload_streaming_chunks(),
+      "If at least 2, elementwise updates of host offloaded tensors are "
+      "streamed through device memory in at least this many chunks."));
   flag_list->push_back(tsl::Flag(
       "xla_gpu_nccl_terminate_on_error",
       bool_setter_for(&DebugOptions::set_xla_gpu_nccl_terminate_on_error),
@@ -2090,6 +2343,14 @@ void MakeDebugOptionsFlags(std::vector<tsl::Flag>* flag_list,
                 "reused in further compilations; not yet cached kernels are "
                 "compiled as usual and get appended to the cache file whenever "
                 "possible."));
+  flag_list->push_back(
+      tsl::Flag("xla_gpu_kernel_cache_dir",
+                string_setter_for(&DebugOptions::set_xla_gpu_kernel_cache_dir),
+                debug_options->xla_gpu_kernel_cache_dir(),
+                "Path to a directory to cache compiled kernels, one file per "
+                "kernel, keyed by the kernel fingerprint and the target "
+                "device. The directory can be shared by concurrent "
+                "compilations in different processes."));
   flag_list->push_back(tsl::Flag(
       "xla_gpu_per_fusion_autotune_cache_dir",
       string_setter_for(
@@ -2159,6 +2420,14 @@ void MakeDebugOptionsFlags(std::vector<tsl::Flag>* flag_list,
           &DebugOptions::set_xla_gpu_executable_warn_stuck_timeout_seconds),
       debug_options->xla_gpu_executable_warn_stuck_timeout_seconds(),
       "Set timeout for Rendezvous stuck warning"));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_executable_thunk_device_time_sampling_period",
+      int32_setter_for(
+          &DebugOptions::
+              set_xla_gpu_executable_thunk_device_time_sampling_period),
+      debug_options->xla_gpu_executable_thunk_device_time_sampling_period(),
+      "If positive, records device time of top-level thunks for every N-th "
+      "execution of a GPU executable into a monitoring histogram."));
   flag_list->push_back(tsl::Flag(
       "xla_gpu_executable_terminate_timeout",
       int32_setter_for(
@@ -2198,6 +2467,13 @@ void MakeDebugOptionsFlags(std::vector<tsl::Flag>* flag_list,
       int32_setter_for(&DebugOptions::set_xla_gpu_dot_merger_threshold_mb),
       debug_options->xla_gpu_dot_merger_threshold_mb(),
       "Dot merger pass threshold to be set in MB."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_dot_merger_batch_independent_dots",
+      bool_setter_for(
+          &DebugOptions::set_xla_gpu_dot_merger_batch_independent_dots),
+      debug_options->xla_gpu_dot_merger_batch_independent_dots(),
+      "Lets the dot merger pass stack independent small dots with identical "
+      "shapes into one batched dot."));
   flag_list->push_back(
       tsl::Flag("xla_enable_fast_math",
                 bool_setter_for(&DebugOptions::set_xla_enable_fast_math),
@@ -2277,6 +2553,16 @@ void MakeDebugOptionsFlags(std::vector<tsl::Flag>* flag_list,
       "Enable windowed einsum rewrite for all-to-all+gemm pattern, "
       "This optimization slices the all-to-all into smaller all-to-alls."
       "It is an experimental feature."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_experimental_alltoall_windowed_einsum_min_split_bytes",
+      int64_setter_for(
+          &DebugOptions::
+              set_xla_gpu_experimental_alltoall_windowed_einsum_min_split_bytes),
+      debug_options
+          ->xla_gpu_experimental_alltoall_windowed_einsum_min_split_bytes(),
+      "Minimum size in bytes of the all-to-alls the all-to-all windowed "
+      "einsum rewrite splits an all-to-all into. 0 splits into as many "
+      "all-to-alls as there are devices in a replica group."));
   flag_list->push_back(tsl::Flag(
       "xla_gpu_experimental_pack_dot_operands_along_k_dimension",
       bool_setter_for(
@@ -2304,6 +2590,23 @@ void MakeDebugOptionsFlags(std::vector<tsl::Flag>* flag_list,
               set_xla_gpu_experimental_enable_sync_collective_combining),
       debug_options->xla_gpu_experimental_enable_sync_collective_combining(),
       "Enable sync collective combining."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_experimental_adaptive_combine_threshold",
+      bool_setter_for(
+          &DebugOptions::set_xla_gpu_experimental_adaptive_combine_threshold),
+      debug_options->xla_gpu_experimental_adaptive_combine_threshold(),
+      "If no combine threshold is set, pick the all-gather, all-reduce and "
+      "reduce-scatter combine thresholds with the SoL collective cost model: "
+      "the size from which combining collectives saves less than 10% of their "
+      "runtime."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_experimental_enable_normalization_fusion",
+      bool_setter_for(
+          &DebugOptions::set_xla_gpu_experimental_enable_normalization_fusion),
+      debug_options->xla_gpu_experimental_enable_normalization_fusion(),
+      "Fuse row normalizations (e.g. RMSNorm and LayerNorm) that are not "
+      "handled by cuDNN or Triton into a single kernel emitted by the native "
+      "normalization emitter."));
   flag_list->push_back(tsl::Flag(
       "xla_gpu_experimental_collective_cse_distance_threshold",
       int64_setter_for(
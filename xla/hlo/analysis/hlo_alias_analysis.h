@@ -45,6 +45,13 @@ class HloAliasAnalysis {
       const HloModule* module,
       const HloDataflowAnalysis::CanShareBuffer& can_share_buffer = nullptr);
 
+  // Updates the underlying dataflow analysis incrementally (see
+  // HloDataflowAnalysis::UpdateAfterInstructionReplacement) and recomputes the
+  // buffers from it. Invalidates all references to HloBuffers.
+  absl::Status UpdateAfterInstructionReplacement(
+      absl::Span<HloInstruction* const> changed_instructions,
+      absl::Span<HloInstruction* const> removed_instructions = {});
+
   std::string ToString() const;
 
   // Return the buffer containing the given value.
@@ -104,6 +111,9 @@ class HloAliasAnalysis {
  protected:
   explicit HloAliasAnalysis(const HloModule* module);
 
+  // (Re)computes the buffers and live out buffers from the dataflow analysis.
+  void ComputeBuffers();
+
   // Verify various invariants of the alias analysis.
   absl::Status Verify() const;
 
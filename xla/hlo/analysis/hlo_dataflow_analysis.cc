@@ -109,7 +109,6 @@ HloDataflowAnalysis::HloDataflowAnalysis(
       execution_threads_(std::move(execution_threads)),
       ssa_form_(ssa_form),
       bitcast_defines_value_(bitcast_defines_value),
-      call_graph_(CallGraph::Build(&module)),
       can_share_buffer_(can_share_buffer),
       forwards_value_(forwards_value) {}
 
@@ -1311,7 +1310,96 @@ bool HloDataflowAnalysis::UpdateInstructionValueSet(
   return changed;
 }
 
+void HloDataflowAnalysis::ForEachDataflowSuccessor(
+    HloInstruction* instruction,
+    absl::FunctionRef<void(HloInstruction*)> fn) const {
+  for (HloInstruction* user : instruction->users()) {
+    fn(user);
+
+    // If user sequentially calls a computation, then the respective
+    // parameter(s) of the computation need to be updated.
+    if (user->opcode() == HloOpcode::kConditional) {
+      // If operand 0 is the use of instruction, then no parameters need to be
+      // updated, since that is the branch_index of the conditional.
+      // If operand n+1 is the use of instruction, then the branch_computation
+      // n's parameter need to be updated.
+      //
+      // Note that the same instruction can be used in multiple branches'
+      // operands.
+      for (int j = 0; j < user->branch_count(); ++j) {
+        if (user->operand(j + 1) == instruction) {
+          fn(user->branch_computation(j)->parameter_instruction(0));
+        }
+      }
+    } else if (user->opcode() == HloOpcode::kAsyncUpdate ||
+               user->opcode() == HloOpcode::kAsyncDone) {
+      if (HloInstruction::IsThreadIncluded(user->async_execution_thread(),
+                                           execution_threads_)) {
+        // For async update and async done, we cannot distinguish which
+        // parameter needs to be updated so visit all of them.
+        for (int64_t parameter_number = 0;
+             parameter_number <
+             user->async_wrapped_computation()->num_parameters();
+             ++parameter_number) {
+          fn(user->async_wrapped_computation()->parameter_instruction(
+              parameter_number));
+        }
+      }
+    } else {
+      for (HloComputation* called_computation : user->called_computations()) {
+        if (!HloInstruction::IsThreadIncluded(
+                called_computation->execution_thread(), execution_threads_)) {
+          continue;
+        }
+        const CallGraphNode& call_graph_node =
+            call_graph_->GetNode(called_computation);
+        if (call_graph_node.context() == CallContext::kControlFlow) {
+          for (int64_t operand_number : user->OperandIndices(instruction)) {
+            fn(called_computation->parameter_instruction(operand_number));
+          }
+        }
+      }
+    }
+  }
+
+  // If instruction is a root instruction, then propagate out to any calling
+  // instruction and across any while backedge.
+  if (instruction == instruction->parent()->root_instruction()) {
+    const CallGraphNode& call_graph_node =
+        call_graph_->GetNode(instruction->parent());
+    for (const CallSite& callsite : call_graph_node.caller_callsites()) {
+      if (callsite.instruction()->opcode() == HloOpcode::kWhile) {
+        // Add the while itself, and the body and condition parameters.
+        fn(callsite.instruction());
+        fn(callsite.instruction()->while_body()->parameter_instruction(0));
+        fn(callsite.instruction()->while_condition()->parameter_instruction(0));
+      } else if (call_graph_node.context() == CallContext::kControlFlow ||
+                 callsite.instruction()->opcode() ==
+                     HloOpcode::kConditional) {
+        fn(callsite.instruction());
+      }
+    }
+  }
+}
+
 void HloDataflowAnalysis::Propagate() {
+  std::vector<HloInstruction*> instructions;
+  auto comps = module_.MakeComputationPostOrder();
+  for (HloComputation* computation : comps) {
+    if (!HloInstruction::IsThreadIncluded(computation->execution_thread(),
+                                          execution_threads_)) {
+      continue;
+    }
+    for (HloInstruction* instruction :
+         computation->MakeInstructionPostOrder()) {
+      instructions.push_back(instruction);
+    }
+  }
+  PropagateFrom(instructions);
+}
+
+void HloDataflowAnalysis::PropagateFrom(
+    absl::Span<HloInstruction* const> instructions) {
   using Work = std::pair<int64_t, HloInstruction*>;
   // Avoid duplicating work by preferring work items early in the post order
   // schedule. Intuitively, we start from entry parameters and propagate buffers
@@ -1328,16 +1416,8 @@ void HloDataflowAnalysis::Propagate() {
     }
   };
 
-  auto comps = module_.MakeComputationPostOrder();
-  for (HloComputation* computation : comps) {
-    if (!HloInstruction::IsThreadIncluded(computation->execution_thread(),
-                                          execution_threads_)) {
-      continue;
-    }
-    for (HloInstruction* instruction :
-         computation->MakeInstructionPostOrder()) {
-      add_to_worklist(instruction);
-    }
+  for (HloInstruction* instruction : instructions) {
+    add_to_worklist(instruction);
   }
   VLOG(1) << "SSA_FORM_: " << ssa_form_;
 
@@ -1359,81 +1439,9 @@ void HloDataflowAnalysis::Propagate() {
     VLOG(4) << "New value set for " << instruction->name() << ": "
             << GetInstructionValueSet(instruction);
 
-    // Instruction value was updated. Add users to work list if we haven't
-    // already.
-    for (HloInstruction* user : instruction->users()) {
-      add_to_worklist(user);
-
-      // If user sequentially calls a computation, then the respective
-      // parameter(s) of the computation need to be updated.
-      if (user->opcode() == HloOpcode::kConditional) {
-        // If operand 0 is the use of instruction, then no parameters need to be
-        // updated, since that is the branch_index of the conditional.
-        // If operand n+1 is the use of instruction, then the branch_computation
-        // n's parameter need to be updated.
-        //
-        // Note that the same instruction can be used in multiple branches'
-        // operands.
-        for (int j = 0; j < user->branch_count(); ++j) {
-          if (user->operand(j + 1) == instruction) {
-            add_to_worklist(
-                user->branch_computation(j)->parameter_instruction(0));
-          }
-        }
-      } else if (user->opcode() == HloOpcode::kAsyncUpdate ||
-                 user->opcode() == HloOpcode::kAsyncDone) {
-        if (HloInstruction::IsThreadIncluded(user->async_execution_thread(),
-                                             execution_threads_)) {
-          // For async update and async done, we cannot distinguish which
-          // parameter needs to be updated so add all to the worklist.
-          for (int64_t parameter_number = 0;
-               parameter_number <
-               user->async_wrapped_computation()->num_parameters();
-               ++parameter_number) {
-            add_to_worklist(
-                user->async_wrapped_computation()->parameter_instruction(
-                    parameter_number));
-          }
-        }
-      } else {
-        for (HloComputation* called_computation : user->called_computations()) {
-          if (!HloInstruction::IsThreadIncluded(
-                  called_computation->execution_thread(), execution_threads_)) {
-            continue;
-          }
-          const CallGraphNode& call_graph_node =
-              call_graph_->GetNode(called_computation);
-          if (call_graph_node.context() == CallContext::kControlFlow) {
-            for (int64_t operand_number : user->OperandIndices(instruction)) {
-              add_to_worklist(
-                  called_computation->parameter_instruction(operand_number));
-            }
-          }
-        }
-      }
-    }
-
-    // If instruction is a root instruction, then propagate out to any calling
-    // instruction and across any while backedge.
-    if (instruction == instruction->parent()->root_instruction()) {
-      const CallGraphNode& call_graph_node =
-          call_graph_->GetNode(instruction->parent());
-      for (const CallSite& callsite : call_graph_node.caller_callsites()) {
-        if (callsite.instruction()->opcode() == HloOpcode::kWhile) {
-          // Add the while itself, and the body and condition parameters.
-          add_to_worklist(callsite.instruction());
-          add_to_worklist(
-              callsite.instruction()->while_body()->parameter_instruction(0));
-          add_to_worklist(
-              callsite.instruction()->while_condition()->parameter_instruction(
-                  0));
-        } else if (call_graph_node.context() == CallContext::kControlFlow ||
-                   callsite.instruction()->opcode() ==
-                       HloOpcode::kConditional) {
-          add_to_worklist(callsite.instruction());
-        }
-      }
-    }
+    // Instruction value was updated. Add users and cross-computation dataflow
+    // successors to work list if we haven't already.
+    ForEachDataflowSuccessor(instruction, add_to_worklist);
   }
 }
 
@@ -1460,202 +1468,209 @@ absl::Status HloDataflowAnalysis::InitializeInstructionValueSets() {
     const CallGraphNode& call_graph_node = call_graph_->GetNode(computation);
     for (HloInstruction* instruction :
          computation->MakeInstructionPostOrder()) {
-      // Create an empty shape tree.
-      value_sets_.insert({instruction, std::make_unique<InstructionValueSet>(
-                                           &instruction->shape())});
-
-      // For each sub-shape of the instruction shape, add a new HloValue to its
-      // HloValueSet. should_define may be provided to define a subset of
-      // values.
-      auto define_all_values =
-          [this, &instruction](
-              absl::FunctionRef<bool(const ShapeIndex&)> should_define =
-                  [](const ShapeIndex&) { return true; }) {
-            for (auto& pair : GetInstructionValueSet(instruction)) {
-              const ShapeIndex& index = pair.first;
-
-              bool defines_value;
-              if (forwards_value_ != nullptr &&
-                  forwards_value_(instruction, index).has_value()) {
-                defines_value = false;
-              } else {
-                defines_value = should_define(index);
-              }
-
-              if (defines_value) {
-                HloValue* value =
-                    NewHloValue(instruction, index, /*is_phi=*/false);
-                GetValueSet(instruction, index).AddValue(value);
-              }
-            }
-          };
+      TF_RETURN_IF_ERROR(
+          InitializeInstructionValueSet(instruction, call_graph_node));
+    }
+  }
 
-      // Add a new HloValue to the HloValueSet corresponding to the given index
-      // of the instruction shape.
-      auto define_value_at = [this, &instruction](const ShapeIndex& index) {
-        HloValue* value = NewHloValue(instruction, index, /*is_phi=*/false);
-        GetValueSet(instruction, index).AddValue(value);
-      };
+  return absl::OkStatus();
+}
 
-      switch (instruction->opcode()) {
-        case HloOpcode::kBitcast:
-          if (bitcast_defines_value_) {
-            define_all_values();
+absl::Status HloDataflowAnalysis::InitializeInstructionValueSet(
+    HloInstruction* instruction, const CallGraphNode& call_graph_node) {
+  // Create an empty shape tree.
+  value_sets_.insert({instruction, std::make_unique<InstructionValueSet>(
+                                       &instruction->shape())});
+
+  // For each sub-shape of the instruction shape, add a new HloValue to its
+  // HloValueSet. should_define may be provided to define a subset of
+  // values.
+  auto define_all_values =
+      [this, &instruction](
+          absl::FunctionRef<bool(const ShapeIndex&)> should_define =
+              [](const ShapeIndex&) { return true; }) {
+        for (auto& pair : GetInstructionValueSet(instruction)) {
+          const ShapeIndex& index = pair.first;
+
+          bool defines_value;
+          if (forwards_value_ != nullptr &&
+              forwards_value_(instruction, index).has_value()) {
+            defines_value = false;
+          } else {
+            defines_value = should_define(index);
           }
-          break;
-        case HloOpcode::kAddDependency:
-        case HloOpcode::kWhile:
-        case HloOpcode::kCall:
-        case HloOpcode::kConditional:
-        case HloOpcode::kGetTupleElement:
-        case HloOpcode::kDomain:
-        case HloOpcode::kOptimizationBarrier:
-          // These instructions define no values. The values in their output
-          // flow from their operands or from cross computation dataflow.
-          break;
-        case HloOpcode::kParameter:
-          if (call_graph_node.context() == CallContext::kBoth) {
-            // We do not support a subcomputation that is called from both a
-            // parallel and sequential context. In this case, the parameter
-            // would both define a value and propagate a value from its
-            // caller. This limitation is not really a problem because the call
-            // graph is typically flattened.
-            return Unimplemented(
-                "Computation %s is called in both a parallel (eg, kMap) and "
-                "sequential (eg, kCall) context",
-                computation->name());
-          }
-          if (call_graph_node.caller_callsites().empty() ||
-              call_graph_node.context() == CallContext::kEmbedded) {
-            // Parameters of computations called in a parallel context (eg, map
-            // and reduce) as well as parameters of dead computations define all
-            // values in their output. Otherwise the values of the parameter
-            // come from the caller (eg, operands to the kCall instruction).
-            define_all_values();
+
+          if (defines_value) {
+            HloValue* value = NewHloValue(instruction, index, /*is_phi=*/false);
+            GetValueSet(instruction, index).AddValue(value);
           }
-          break;
-        case HloOpcode::kCopy:
-        case HloOpcode::kTuple:
-          // These instructions only define their top-level values. Any other
-          // values flow from their operands.
-          define_value_at(/*index=*/{});
-          break;
-        case HloOpcode::kAsyncStart: {
-          // AsyncStart produces a tuple of {{aliased operands}, {destination},
-          // contexts}. It defines all of the tuple-shaped values and the
-          // contexts.
-          // If the thread is excluded, then we don't track the contained
-          // dataflow, and define the destination values too.
-          bool thread_included = HloInstruction::IsThreadIncluded(
-              instruction->async_execution_thread(), execution_threads_);
-          define_all_values([&](const ShapeIndex& index) {
-            return ShapeUtil::GetSubshape(instruction->shape(), index)
-                       .IsTuple() ||
-                   (!thread_included && index.front() == 1) ||
-                   (index.front() > 1);
-          });
-          break;
         }
-        case HloOpcode::kAsyncUpdate:
-          // AsyncUpdate produces a tuple of {{aliased operands}, {destination},
-          // contexts} where all of the array-typed values alias with the
-          // operand. So, only tuple-shaped values are defined by AsyncUpdate.
-          define_all_values([&](const ShapeIndex& index) {
-            return ShapeUtil::GetSubshape(instruction->shape(), index)
-                .IsTuple();
-          });
-          break;
-        case HloOpcode::kAsyncDone:
-          // AsyncDone's output aliases its output. It defines all remaining
-          // tuple-shaped values.
-          define_all_values([&](const ShapeIndex& index) {
-            return ShapeUtil::GetSubshape(instruction->shape(), index)
-                .IsTuple();
-          });
-          break;
-        case HloOpcode::kCopyStart:
-          // CopyStart produces a tuple of {destination buffer, aliased operand,
-          // U32 context}.
-          define_value_at(/*index=*/{});
-          define_value_at(/*index=*/{0});
-          define_value_at(/*index=*/{2});
-          break;
-        case HloOpcode::kCopyDone:
-          // CopyDone consumes a tuple produced by CopyStart and produces an
-          // element. Its output aliases its input tuple element {0}.
-          break;
-        case HloOpcode::kAllGatherStart:
-          // AllGatherStart produces a tuple of
-          // {aliased operands, destination buffers}. If there is more than
-          // one operand, then both aliased operands and destination buffers
-          // will be tuples themselves. all-gather-start will define all tuples
-          // and all tuple leaves (arrays) in tuple sub-index 1 (destination
-          // buffers).
-          define_all_values([&](const ShapeIndex& index) {
-            return ShapeUtil::GetSubshape(instruction->shape(), index)
-                       .IsTuple() ||
-                   index.front() == 1;
-          });
-          break;
-        case HloOpcode::kAllGatherDone:
-          // AllGatherDone's output aliases its input tuple element {1}.
-          if (instruction->shape().IsTuple()) {
-            define_value_at(/*index=*/{});
-          }
-          break;
-        case HloOpcode::kAllReduceDone:
-          // AllReduceDone's output aliases its input.
-          break;
-        case HloOpcode::kCollectivePermuteStart:
-          // CollectivePermuteStart produces a tuple of {{aliased operand(s)},
-          // {destination buffer(s)}, contexts}, where the context data are
-          // optional.
-          define_value_at(/*index=*/{});
-          define_value_at(/*index=*/{1});
-          for (int i = 2; i < instruction->shape().tuple_shapes().size(); ++i) {
-            define_value_at(/*index=*/{i});
-          }
+      };
 
-          if (Cast<HloCollectivePermuteInstruction>(instruction)->inplace()) {
-            CHECK_EQ(instruction->operand_count(), 4);
-            if (instruction->operand(1)->shape().IsTuple()) {
-              for (int i = 0; i < ShapeUtil::TupleElementCount(
-                                      instruction->operand(1)->shape());
-                   ++i) {
-                define_value_at(/*index=*/{1, i});
-              }
-            }
-          } else if (instruction->operand_count() > 1) {
-            for (int i = 0; i < instruction->operand_count(); ++i) {
-              define_value_at(/*index=*/{1, i});
-            }
-          }
-          break;
-        case HloOpcode::kCollectivePermuteDone:
-          // CollectivePermuteDone's output aliases its input tuple element {1}.
-          if (instruction->shape().IsTuple()) {
-            define_value_at(/*index=*/{});
-          }
-          break;
-        case HloOpcode::kRecvDone:
-          // RecvDone produces a two-element tuple. Element zero aliases its
-          // input tuple element {0}; element one is a token.
-          define_value_at(/*index=*/{});
-          define_value_at(/*index=*/{1});
-          break;
-        case HloOpcode::kSend:
-          // Send produces a tuple of {aliased operand, U32 context, token},
-          // therefore only defines the top-level tuple and the tuple elements
-          // at {1} and {2}.
-          define_value_at(/*index=*/{});
-          define_value_at(/*index=*/{1});
-          define_value_at(/*index=*/{2});
-          break;
-        default:
-          define_all_values();
-          break;
+  // Add a new HloValue to the HloValueSet corresponding to the given index
+  // of the instruction shape.
+  auto define_value_at = [this, &instruction](const ShapeIndex& index) {
+    HloValue* value = NewHloValue(instruction, index, /*is_phi=*/false);
+    GetValueSet(instruction, index).AddValue(value);
+  };
+
+  switch (instruction->opcode()) {
+    case HloOpcode::kBitcast:
+      if (bitcast_defines_value_) {
+        define_all_values();
       }
+      break;
+    case HloOpcode::kAddDependency:
+    case HloOpcode::kWhile:
+    case HloOpcode::kCall:
+    case HloOpcode::kConditional:
+    case HloOpcode::kGetTupleElement:
+    case HloOpcode::kDomain:
+    case HloOpcode::kOptimizationBarrier:
+      // These instructions define no values. The values in their output
+      // flow from their operands or from cross computation dataflow.
+      break;
+    case HloOpcode::kParameter:
+      if (call_graph_node.context() == CallContext::kBoth) {
+        // We do not support a subcomputation that is called from both a
+        // parallel and sequential context. In this case, the parameter
+        // would both define a value and propagate a value from its
+        // caller. This limitation is not really a problem because the call
+        // graph is typically flattened.
+        return Unimplemented(
+            "Computation %s is called in both a parallel (eg, kMap) and "
+            "sequential (eg, kCall) context",
+            instruction->parent()->name());
+      }
+      if (call_graph_node.caller_callsites().empty() ||
+          call_graph_node.context() == CallContext::kEmbedded) {
+        // Parameters of computations called in a parallel context (eg, map
+        // and reduce) as well as parameters of dead computations define all
+        // values in their output. Otherwise the values of the parameter
+        // come from the caller (eg, operands to the kCall instruction).
+        define_all_values();
+      }
+      break;
+    case HloOpcode::kCopy:
+    case HloOpcode::kTuple:
+      // These instructions only define their top-level values. Any other
+      // values flow from their operands.
+      define_value_at(/*index=*/{});
+      break;
+    case HloOpcode::kAsyncStart: {
+      // AsyncStart produces a tuple of {{aliased operands}, {destination},
+      // contexts}. It defines all of the tuple-shaped values and the
+      // contexts.
+      // If the thread is excluded, then we don't track the contained
+      // dataflow, and define the destination values too.
+      bool thread_included = HloInstruction::IsThreadIncluded(
+          instruction->async_execution_thread(), execution_threads_);
+      define_all_values([&](const ShapeIndex& index) {
+        return ShapeUtil::GetSubshape(instruction->shape(), index)
+                   .IsTuple() ||
+               (!thread_included && index.front() == 1) ||
+               (index.front() > 1);
+      });
+      break;
     }
+    case HloOpcode::kAsyncUpdate:
+      // AsyncUpdate produces a tuple of {{aliased operands}, {destination},
+      // contexts} where all of the array-typed values alias with the
+      // operand. So, only tuple-shaped values are defined by AsyncUpdate.
+      define_all_values([&](const ShapeIndex& index) {
+        return ShapeUtil::GetSubshape(instruction->shape(), index)
+            .IsTuple();
+      });
+      break;
+    case HloOpcode::kAsyncDone:
+      // AsyncDone's output aliases its output. It defines all remaining
+      // tuple-shaped values.
+      define_all_values([&](const ShapeIndex& index) {
+        return ShapeUtil::GetSubshape(instruction->shape(), index)
+            .IsTuple();
+      });
+      break;
+    case HloOpcode::kCopyStart:
+      // CopyStart produces a tuple of {destination buffer, aliased operand,
+      // U32 context}.
+      define_value_at(/*index=*/{});
+      define_value_at(/*index=*/{0});
+      define_value_at(/*index=*/{2});
+      break;
+    case HloOpcode::kCopyDone:
+      // CopyDone consumes a tuple produced by CopyStart and produces an
+      // element. Its output aliases its input tuple element {0}.
+      break;
+    case HloOpcode::kAllGatherStart:
+      // AllGatherStart produces a tuple of
+      // {aliased operands, destination buffers}. If there is more than
+      // one operand, then both aliased operands and destination buffers
+      // will be tuples themselves. all-gather-start will define all tuples
+      // and all tuple leaves (arrays) in tuple sub-index 1 (destination
+      // buffers).
+      define_all_values([&](const ShapeIndex& index) {
+        return ShapeUtil::GetSubshape(instruction->shape(), index)
+                   .IsTuple() ||
+               index.front() == 1;
+      });
+      break;
+    case HloOpcode::kAllGatherDone:
+      // AllGatherDone's output aliases its input tuple element {1}.
+      if (instruction->shape().IsTuple()) {
+        define_value_at(/*index=*/{});
+      }
+      break;
+    case HloOpcode::kAllReduceDone:
+      // AllReduceDone's output aliases its input.
+      break;
+    case HloOpcode::kCollectivePermuteStart:
+      // CollectivePermuteStart produces a tuple of {{aliased operand(s)},
+      // {destination buffer(s)}, contexts}, where the context data are
+      // optional.
+      define_value_at(/*index=*/{});
+      define_value_at(/*index=*/{1});
+      for (int i = 2; i < instruction->shape().tuple_shapes().size(); ++i) {
+        define_value_at(/*index=*/{i});
+      }
+
+      if (Cast<HloCollectivePermuteInstruction>(instruction)->inplace()) {
+        CHECK_EQ(instruction->operand_count(), 4);
+        if (instruction->operand(1)->shape().IsTuple()) {
+          for (int i = 0; i < ShapeUtil::TupleElementCount(
+                                  instruction->operand(1)->shape());
+               ++i) {
+            define_value_at(/*index=*/{1, i});
+          }
+        }
+      } else if (instruction->operand_count() > 1) {
+        for (int i = 0; i < instruction->operand_count(); ++i) {
+          define_value_at(/*index=*/{1, i});
+        }
+      }
+      break;
+    case HloOpcode::kCollectivePermuteDone:
+      // CollectivePermuteDone's output aliases its input tuple element {1}.
+      if (instruction->shape().IsTuple()) {
+        define_value_at(/*index=*/{});
+      }
+      break;
+    case HloOpcode::kRecvDone:
+      // RecvDone produces a two-element tuple. Element zero aliases its
+      // input tuple element {0}; element one is a token.
+      define_value_at(/*index=*/{});
+      define_value_at(/*index=*/{1});
+      break;
+    case HloOpcode::kSend:
+      // Send produces a tuple of {aliased operand, U32 context, token},
+      // therefore only defines the top-level tuple and the tuple elements
+      // at {1} and {2}.
+      define_value_at(/*index=*/{});
+      define_value_at(/*index=*/{1});
+      define_value_at(/*index=*/{2});
+      break;
+    default:
+      define_all_values();
+      break;
   }
 
   return absl::OkStatus();
@@ -1704,39 +1719,37 @@ void HloDataflowAnalysis::OptimizePhiValues() {
   }
 }
 
-/* static */
-absl::StatusOr<std::unique_ptr<HloDataflowAnalysis>> HloDataflowAnalysis::Run(
-    const HloModule& module, bool ssa_form, bool bitcast_defines_value,
-    const CanShareBuffer& can_share_buffer, const ForwardsValue& forwards_value,
-    absl::flat_hash_set<absl::string_view> execution_threads) {
-  VLOG(1) << "HloDataflowAnalysis::Run on module " << module.name();
-  XLA_VLOG_LINES(2, module.ToString());
-
-  auto dataflow_analysis = absl::WrapUnique(new HloDataflowAnalysis(
-      module, ssa_form, bitcast_defines_value, can_share_buffer, forwards_value,
-      execution_threads));
+absl::Status HloDataflowAnalysis::ComputeFromScratch() {
+  call_graph_ = CallGraph::Build(&module_);
+  values_.clear();
+  value_sets_.clear();
+  value_ids_to_delete_.clear();
+  phi_graph_ = PhiGraph();
 
-  TF_RETURN_IF_ERROR(dataflow_analysis->InitializeInstructionValueSets());
-  dataflow_analysis->Propagate();
-  dataflow_analysis->OptimizePhiValues();
+  TF_RETURN_IF_ERROR(InitializeInstructionValueSets());
+  Propagate();
+  OptimizePhiValues();
 
   // Delete all values marked for deletion.
-  dataflow_analysis->DeleteMarkedValues();
+  DeleteMarkedValues();
 
+  UpdateValuePositions();
+  return absl::OkStatus();
+}
+
+void HloDataflowAnalysis::UpdateValuePositions() {
   // Gather and set all non-definition positions of all values. Value deletion
   // is rare, so just use a vector indexed by Value::Id rather than a map from
   // Value::Id to positions. There should be very few holes in the vector, and
   // lookup is faster.
-  std::vector<std::vector<HloPosition>> value_positions(
-      dataflow_analysis->next_value_id_);
-  for (const HloComputation* computation : module.computations()) {
+  std::vector<std::vector<HloPosition>> value_positions(next_value_id_);
+  for (const HloComputation* computation : module_.computations()) {
     if (!HloInstruction::IsThreadIncluded(computation->execution_thread(),
-                                          execution_threads)) {
+                                          execution_threads_)) {
       continue;
     }
     for (HloInstruction* instruction : computation->instructions()) {
-      for (const auto& pair :
-           dataflow_analysis->GetInstructionValueSet(instruction)) {
+      for (const auto& pair : GetInstructionValueSet(instruction)) {
         const ShapeIndex& index = pair.first;
         const HloValueSet& value_set = pair.second;
         for (const HloValue* value : value_set.values()) {
@@ -1748,18 +1761,134 @@ absl::StatusOr<std::unique_ptr<HloDataflowAnalysis>> HloDataflowAnalysis::Run(
       }
     }
   }
-  for (auto& pair : dataflow_analysis->values_) {
+  for (auto& pair : values_) {
     HloValue::Id value_id = pair.first;
     HloValue& value = *pair.second;
-    value.SetPositions(value_positions[value_id]);
+    value.ResetPositions(value_positions[value_id]);
   }
 
   // Construct vector of values.
-  dataflow_analysis->values_vector_.reserve(dataflow_analysis->values_.size());
-  for (const auto& pair : dataflow_analysis->values_) {
-    dataflow_analysis->values_vector_.push_back(pair.second.get());
+  values_vector_.clear();
+  values_vector_.reserve(values_.size());
+  for (const auto& pair : values_) {
+    values_vector_.push_back(pair.second.get());
   }
-  absl::c_sort(dataflow_analysis->values_vector_, HloValue::IdLessThan);
+  absl::c_sort(values_vector_, HloValue::IdLessThan);
+}
+
+absl::Status HloDataflowAnalysis::UpdateAfterInstructionReplacement(
+    absl::Span<HloInstruction* const> changed_instructions,
+    absl::Span<HloInstruction* const> removed_instructions) {
+  VLOG(1) << "HloDataflowAnalysis::UpdateAfterInstructionReplacement on module "
+          << module_.name();
+
+  // New or removed callsites change the call graph, which is cheaper to handle
+  // by recomputing the analysis.
+  auto changes_call_graph = [this](const HloInstruction* instruction) {
+    return !instruction->called_computations().empty() &&
+           !value_sets_.contains(instruction);
+  };
+  if (absl::c_any_of(changed_instructions, changes_call_graph) ||
+      absl::c_any_of(removed_instructions, [](const HloInstruction* removed) {
+        return !removed->called_computations().empty();
+      })) {
+    VLOG(1) << "Call graph changed, recomputing dataflow from scratch";
+    return ComputeFromScratch();
+  }
+
+  // Collect all instructions whose value sets may depend on the changed
+  // instructions, in a deterministic order.
+  std::vector<HloInstruction*> affected;
+  absl::flat_hash_set<HloInstruction*> visited;
+  std::vector<HloInstruction*> stack;
+  for (HloInstruction* instruction : changed_instructions) {
+    if (HloInstruction::IsThreadIncluded(
+            instruction->parent()->execution_thread(), execution_threads_)) {
+      stack.push_back(instruction);
+    }
+  }
+  while (!stack.empty()) {
+    HloInstruction* instruction = stack.back();
+    stack.pop_back();
+    if (!visited.insert(instruction).second) {
+      continue;
+    }
+    // Phi values are owned by the phi graph and can't be patched in place.
+    if (ssa_form_ && MayDefinePhiValue(instruction)) {
+      VLOG(1) << "Change reaches " << instruction->name()
+              << ", recomputing dataflow from scratch";
+      return ComputeFromScratch();
+    }
+    affected.push_back(instruction);
+    ForEachDataflowSuccessor(instruction, [&](HloInstruction* successor) {
+      stack.push_back(successor);
+    });
+  }
+  VLOG(2) << "Updating value sets of " << affected.size() << " instructions";
+
+  // Drops the value set of the instruction and the values defined by it. Only
+  // affected instructions can observe these values.
+  auto reset_value_set = [this](const HloInstruction* instruction) {
+    auto it = value_sets_.find(instruction);
+    if (it == value_sets_.end()) {
+      return;
+    }
+    for (const auto& [index, value_set] : *it->second) {
+      for (const HloValue* value : value_set.values()) {
+        if (value->defining_instruction() == instruction) {
+          MarkValueForDeletion(value->id());
+        }
+      }
+    }
+    value_sets_.erase(it);
+  };
+
+  for (const HloInstruction* instruction : removed_instructions) {
+    reset_value_set(instruction);
+  }
+  for (HloInstruction* instruction : affected) {
+    reset_value_set(instruction);
+    TF_RETURN_IF_ERROR(InitializeInstructionValueSet(
+        instruction, call_graph_->GetNode(instruction->parent())));
+  }
+
+  PropagateFrom(affected);
+  DeleteMarkedValues();
+  UpdateValuePositions();
+
+  TF_DCHECK_OK(Verify());
+  return absl::OkStatus();
+}
+
+bool HloDataflowAnalysis::MayDefinePhiValue(
+    const HloInstruction* instruction) const {
+  switch (instruction->opcode()) {
+    case HloOpcode::kWhile:
+    case HloOpcode::kConditional:
+      return true;
+    case HloOpcode::kParameter: {
+      const CallGraphNode& node = call_graph_->GetNode(instruction->parent());
+      return !node.caller_callsites().empty() &&
+             node.context() != CallContext::kEmbedded;
+    }
+    default:
+      return false;
+  }
+}
+
+/* static */
+absl::StatusOr<std::unique_ptr<HloDataflowAnalysis>> HloDataflowAnalysis::Run(
+    const HloModule& module, bool ssa_form, bool bitcast_defines_value,
+    const CanShareBuffer& can_share_buffer, const ForwardsValue& forwards_value,
+    absl::flat_hash_set<absl::string_view> execution_threads) {
+  VLOG(1) << "HloDataflowAnalysis::Run on module " << module.name();
+  XLA_VLOG_LINES(2, module.ToString());
+
+  auto dataflow_analysis = absl::WrapUnique(new HloDataflowAnalysis(
+      module, ssa_form, bitcast_defines_value, can_share_buffer, forwards_value,
+      execution_threads));
+
+  TF_RETURN_IF_ERROR(dataflow_analysis->ComputeFromScratch());
 
   TF_DCHECK_OK(dataflow_analysis->Verify());
 
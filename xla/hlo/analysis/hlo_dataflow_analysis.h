@@ -31,6 +31,7 @@ limitations under the License.
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
+#include "absl/functional/function_ref.h"
 #include "absl/hash/hash.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -239,6 +240,22 @@ class HloDataflowAnalysis {
   static std::vector<std::pair<HloOperandIndex, ShapeIndex>>
   GetInPlaceInputOutputPairs(const HloInstruction* instruction);
 
+  // Updates the analysis in place after the module was changed instead of
+  // recomputing it from scratch. `changed_instructions` are the instructions
+  // added to the module or whose operands were replaced, and
+  // `removed_instructions` are the instructions removed from the module. The
+  // removed instructions must have no users and must not be deleted yet, e.g.
+  // they may be pending deletion in their HloComputation.
+  //
+  // Only value sets of instructions reachable in the dataflow graph from the
+  // changed instructions are recomputed, and HloValues defined by those
+  // instructions are replaced with new ones. If the change adds or removes
+  // callsites, or in SSA form reaches an instruction that may define a phi
+  // value, the analysis is recomputed from scratch.
+  absl::Status UpdateAfterInstructionReplacement(
+      absl::Span<HloInstruction* const> changed_instructions,
+      absl::Span<HloInstruction* const> removed_instructions = {});
+
   // Verifies various invariants of the dataflow analysis.
   absl::Status Verify() const;
 
@@ -268,6 +285,12 @@ class HloDataflowAnalysis {
   HloValue* NewHloValue(HloInstruction* instruction, const ShapeIndex& index,
                         bool is_phi);
 
+  // Computes the analysis for the whole module, dropping any previous state.
+  absl::Status ComputeFromScratch();
+
+  // Returns true if the instruction may define a phi value in SSA form.
+  bool MayDefinePhiValue(const HloInstruction* instruction) const;
+
   // Marks the HloValue with the given ID for deletion.
   void MarkValueForDeletion(HloValue::Id value_id);
 
@@ -280,6 +303,10 @@ class HloDataflowAnalysis {
   // then propagated throughout the HLO graph by calling Propagate.
   absl::Status InitializeInstructionValueSets();
 
+  // Constructs and initializes the InstructionValueSet of a single instruction.
+  absl::Status InitializeInstructionValueSet(
+      HloInstruction* instruction, const CallGraphNode& call_graph_node);
+
   // Updates the value set of the given instruction based on the values flowing
   // into the instruction (operands and cross-computation dataflow).
   bool UpdateInstructionValueSet(HloInstruction* instruction);
@@ -328,6 +355,21 @@ class HloDataflowAnalysis {
   // instructions.
   void Propagate();
 
+  // Same as above, but only starts the propagation from the given
+  // instructions.
+  void PropagateFrom(absl::Span<HloInstruction* const> instructions);
+
+  // Calls `fn` for every instruction whose value set is computed from the
+  // value set of `instruction`: its users, parameters of computations called
+  // by the users, and callers of the computation if `instruction` is a root.
+  void ForEachDataflowSuccessor(
+      HloInstruction* instruction,
+      absl::FunctionRef<void(HloInstruction*)> fn) const;
+
+  // Sets the non-definition positions of all values and rebuilds
+  // values_vector_ from the current value sets.
+  void UpdateValuePositions();
+
   // Returns the result of the SSA Phi function applied to the given inputs at
   // the given instruction.
   bool Phi(HloInstruction* instruction,
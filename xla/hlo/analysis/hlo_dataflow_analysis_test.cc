@@ -24,6 +24,7 @@ limitations under the License.
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include "absl/algorithm/container.h"
 #include "absl/log/check.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
@@ -1016,6 +1017,120 @@ TEST_P(HloDataflowAnalysisTest, TupleCopy) {
       analysis.GetValueDefinedAt(copy, /*index=*/{}).live_out_of_module());
 }
 
+// Expects both analyses to have the same value sets at every position of the
+// module. Values are compared by their defining positions.
+void ExpectEquivalentAnalyses(const HloModule& module,
+                              const HloDataflowAnalysis& expected,
+                              const HloDataflowAnalysis& actual) {
+  EXPECT_EQ(expected.values().size(), actual.values().size());
+  auto defining_positions = [](const HloValueSet& value_set) {
+    std::vector<std::string> positions;
+    for (const HloValue* value : value_set.values()) {
+      positions.push_back(value->defining_position().ToString());
+    }
+    absl::c_sort(positions);
+    return positions;
+  };
+  for (const HloComputation* computation : module.computations()) {
+    for (const HloInstruction* instruction : computation->instructions()) {
+      for (const auto& [index, value_set] :
+           expected.GetInstructionValueSet(instruction)) {
+        EXPECT_EQ(defining_positions(value_set),
+                  defining_positions(actual.GetValueSet(instruction, index)))
+            << instruction->name() << index;
+      }
+    }
+  }
+  for (const HloValue* value : expected.values()) {
+    EXPECT_EQ(value->positions().size(),
+              actual
+                  .GetValueDefinedAt(value->defining_instruction(),
+                                     value->defining_index())
+                  .positions()
+                  .size())
+        << value->ToShortString();
+  }
+}
+
+TEST_P(HloDataflowAnalysisTest, UpdateAfterInstructionReplacement) {
+  const char* hlo_text = R"(
+    HloModule m
+
+    ENTRY entry {
+      p0 = f32[] parameter(0)
+      p1 = f32[] parameter(1)
+      add = f32[] add(p0, p1)
+      tuple = (f32[], f32[]) tuple(add, p1)
+      gte = f32[] get-tuple-element(tuple), index=0
+      ROOT root = (f32[], (f32[], f32[])) tuple(gte, tuple)
+    }
+  )";
+  TF_ASSERT_OK_AND_ASSIGN(module_, ParseAndReturnVerifiedModule(hlo_text));
+  bool ssa_form = GetParam();
+  RunAnalysis(ssa_form);
+  std::unique_ptr<HloDataflowAnalysis> analysis = std::move(analysis_);
+
+  HloComputation* entry = module_->entry_computation();
+  HloInstruction* add = FindInstruction(module_.get(), "add");
+  HloInstruction* negate = entry->AddInstruction(HloInstruction::CreateUnary(
+      add->shape(), HloOpcode::kNegate, add->mutable_operand(0)));
+  TF_ASSERT_OK(add->ReplaceAllUsesWith(negate));
+  TF_ASSERT_OK(entry->RemoveInstruction(add));
+
+  TF_ASSERT_OK(analysis->UpdateAfterInstructionReplacement({negate}, {add}));
+  TF_ASSERT_OK(analysis->Verify());
+  EXPECT_TRUE(analysis->ValueIsDefinedAt(negate));
+  EXPECT_THAT(analysis->GetValueSet(FindInstruction(module_.get(), "gte"))
+                  .values(),
+              UnorderedElementsAre(&analysis->GetValueDefinedAt(negate)));
+
+  const HloDataflowAnalysis& expected = RunAnalysis(
+      ssa_form, /*bitcast_defines_value=*/false, /*run_dce=*/false);
+  ExpectEquivalentAnalyses(*module_, expected, *analysis);
+}
+
+TEST_P(HloDataflowAnalysisTest, UpdateAfterInstructionReplacementInWhile) {
+  const char* hlo_text = R"(
+    HloModule m
+
+    body {
+      p = (f32[], f32[]) parameter(0)
+      gte0 = f32[] get-tuple-element(p), index=0
+      gte1 = f32[] get-tuple-element(p), index=1
+      add = f32[] add(gte0, gte1)
+      ROOT tuple = (f32[], f32[]) tuple(add, gte1)
+    }
+
+    cond {
+      p = (f32[], f32[]) parameter(0)
+      ROOT c = pred[] constant(false)
+    }
+
+    ENTRY entry {
+      p0 = f32[] parameter(0)
+      init = (f32[], f32[]) tuple(p0, p0)
+      ROOT while = (f32[], f32[]) while(init), condition=cond, body=body
+    }
+  )";
+  TF_ASSERT_OK_AND_ASSIGN(module_, ParseAndReturnVerifiedModule(hlo_text));
+  bool ssa_form = GetParam();
+  RunAnalysis(ssa_form);
+  std::unique_ptr<HloDataflowAnalysis> analysis = std::move(analysis_);
+
+  // Forward the loop invariant value instead of the sum.
+  HloInstruction* add = FindInstruction(module_.get(), "add");
+  HloInstruction* tuple = FindInstruction(module_.get(), "tuple");
+  TF_ASSERT_OK(tuple->ReplaceOperandWith(0, add->mutable_operand(1)));
+  TF_ASSERT_OK(add->parent()->RemoveInstruction(add));
+
+  TF_ASSERT_OK(analysis->UpdateAfterInstructionReplacement({tuple}, {add}));
+  TF_ASSERT_OK(analysis->Verify());
+
+  const HloDataflowAnalysis& expected = RunAnalysis(
+      ssa_form, /*bitcast_defines_value=*/false, /*run_dce=*/false);
+  ExpectEquivalentAnalyses(*module_, expected, *analysis);
+}
+
 TEST_P(HloDataflowAnalysisTest, OptimizationBarrier) {
   // Test that an optimization barrier is a nop.
   auto builder = HloComputation::Builder(TestName());
@@ -16,6 +16,9 @@ limitations under the License.
 #ifndef XLA_HLO_ANALYSIS_HLO_REACHABILITY_H_
 #define XLA_HLO_ANALYSIS_HLO_REACHABILITY_H_
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -143,44 +146,63 @@ class HloReachabilityMap {
  private:
   // A dynamically sized bit-set implementation specialized for this use case
   // providing fast bitwise OR (not available in tsl::gtl::BitMap).
+  //
+  // Words are only stored up to the highest word that has been set, the
+  // missing words are all zeros. When the map is built in post order, the
+  // bit-set of an instruction only holds bits up to its own index, which
+  // halves the memory and the time to compute the unions.
   class BitSet {
    public:
     BitSet() = default;
-    explicit BitSet(size_t size)
-        : size_(size), vector_((size + kBits - 1) / kBits, 0) {}
+    explicit BitSet(size_t size) : size_(size) {}
 
     // Returns the bit at the given index.
     bool Get(Index index) const {
       DCHECK(index >= 0 && index < size_);
-      return vector_[index / kBits] & (1ull << (index % kBits));
+      size_t word = index / kBits;
+      return word < vector_.size() &&
+             (vector_[word] & (1ull << (index % kBits)));
     }
 
     // Sets the bit at the given index.
     void Set(Index index) {
       DCHECK(index >= 0 && index < size_);
-      vector_[index / kBits] |= 1ull << (index % kBits);
+      size_t word = index / kBits;
+      if (word >= vector_.size()) {
+        vector_.resize(word + 1, 0);
+      }
+      vector_[word] |= 1ull << (index % kBits);
     }
 
     // Sets this bit-set to union of this bit-set and `other`.
     void operator|=(const BitSet& other) {
       if (this == &other) return;
       DCHECK(size_ == other.size_);
+      if (other.vector_.size() > vector_.size()) {
+        vector_.resize(other.vector_.size(), 0);
+      }
 
       // Ease the work of the auto-vectorizer.
       const Word* a = vector_.data();
       const Word* b = other.vector_.data();
       Word* __restrict out = vector_.data();
-      size_t num_words = vector_.size();
+      size_t num_words = other.vector_.size();
       for (size_t i = 0; i < num_words; ++i) {
         out[i] = a[i] | b[i];
       }
     }
 
     // Sets the bitvector to all zeros.
-    void SetToZero() { absl::c_fill(vector_, 0); }
+    void SetToZero() { vector_.clear(); }
 
     bool operator==(const BitSet& other) const {
-      return vector_ == other.vector_;
+      const std::vector<Word>& shorter =
+          vector_.size() < other.vector_.size() ? vector_ : other.vector_;
+      const std::vector<Word>& longer =
+          vector_.size() < other.vector_.size() ? other.vector_ : vector_;
+      return std::equal(shorter.begin(), shorter.end(), longer.begin()) &&
+             std::all_of(longer.begin() + shorter.size(), longer.end(),
+                         [](Word word) { return word == 0; });
     }
     bool operator!=(const BitSet& other) const { return !(*this == other); }
 
@@ -188,7 +210,7 @@ class HloReachabilityMap {
     using Word = uint64_t;
     static constexpr size_t kBits = 64;
 
-    size_t size_;  // Number of bits in the set.
+    size_t size_ = 0;  // Number of bits in the set.
     std::vector<Word> vector_;
   };
 
@@ -17,6 +17,7 @@ limitations under the License.
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "absl/random/random.h"
 #include "absl/strings/string_view.h"
@@ -94,6 +95,38 @@ TEST_F(HloReachabilityTest, Reachability) {
   EXPECT_FALSE(reachability.SetReachabilityToUnion({b, c}, d));
 }
 
+TEST_F(HloReachabilityTest, ReachabilityAcrossWords) {
+  // The bit-sets only store words up to the highest bit set, so check edges
+  // towards instructions that are far apart in either direction.
+  auto builder = HloComputation::Builder(TestName());
+  std::vector<const HloInstruction*> instructions;
+  for (int i = 0; i < 200; ++i) {
+    instructions.push_back(builder.AddInstruction(
+        HloInstruction::CreateConstant(LiteralUtil::CreateR0<float>(0.0f))));
+  }
+  auto module = CreateNewVerifiedModule();
+  module->AddEntryComputation(builder.Build());
+  const HloInstruction* first = instructions.front();
+  const HloInstruction* middle = instructions[100];
+  const HloInstruction* last = instructions.back();
+
+  HloReachabilityMap reachability(instructions);
+  EXPECT_TRUE(reachability.SetReachabilityToUnion({last}, first));
+  EXPECT_TRUE(reachability.IsReachable(last, first));
+  EXPECT_FALSE(reachability.IsReachable(first, last));
+  EXPECT_FALSE(reachability.SetReachabilityToUnion({last}, first));
+
+  EXPECT_TRUE(reachability.SetReachabilityToUnion({first}, middle));
+  EXPECT_TRUE(reachability.IsReachable(last, middle));
+  EXPECT_TRUE(reachability.IsReachable(first, middle));
+  EXPECT_FALSE(reachability.IsReachable(middle, first));
+
+  // Shrinking the reachability set of `middle` is a change as well.
+  EXPECT_TRUE(reachability.SetReachabilityToUnion({}, middle));
+  EXPECT_FALSE(reachability.IsReachable(last, middle));
+  EXPECT_TRUE(reachability.IsReachable(middle, middle));
+}
+
 TEST_F(HloReachabilityTest, NonTrivialReachability) {
   // Test reachability of a non-trivial computation:
   //
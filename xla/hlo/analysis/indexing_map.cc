@@ -16,6 +16,7 @@ limitations under the License.
 #include "xla/hlo/analysis/indexing_map.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cstdint>
 #include <limits>
@@ -28,12 +29,16 @@ limitations under the License.
 #include <utility>
 #include <vector>
 
+#include "absl/algorithm/container.h"
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
 #include "absl/log/check.h"
 #include "absl/log/log.h"
 #include "absl/numeric/int128.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/types/span.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/DenseSet.h"
@@ -1356,7 +1361,22 @@ bool IndexingMap::Simplify(SimplifyPointDimensions simplify_point_dimensions) {
   if (IsUndefined() || IsKnownEmpty()) {
     return false;
   }
+  IndexingMapCache* cache = IndexingMapCache::Get(GetMLIRContext());
+  if (cache == nullptr) {
+    return SimplifyUncached(simplify_point_dimensions);
+  }
+  if (auto cached = cache->GetSimplified(*this, simplify_point_dimensions)) {
+    *this = std::move(cached->first);
+    return cached->second;
+  }
+  IndexingMap original = *this;
+  bool changed = SimplifyUncached(simplify_point_dimensions);
+  cache->AddSimplified(original, simplify_point_dimensions, *this, changed);
+  return changed;
+}
 
+bool IndexingMap::SimplifyUncached(
+    SimplifyPointDimensions simplify_point_dimensions) {
   // Simplify constraints to shrink the lower/upper bounds of dims and symbols.
   bool constraints_were_simplified = false;
 
@@ -1812,11 +1832,10 @@ bool IndexingMap::MergeModConstraints() {
   return did_simplify;
 }
 
-IndexingMap ComposeIndexingMaps(const IndexingMap& first,
-                                const IndexingMap& second) {
-  if (second.IsUndefined() || first.IsUndefined()) {
-    return IndexingMap::GetUndefined();
-  }
+namespace {
+
+IndexingMap ComposeIndexingMapsUncached(const IndexingMap& first,
+                                        const IndexingMap& second) {
   MLIRContext* mlir_context = first.GetMLIRContext();
   AffineMap producer_affine_map = second.GetAffineMap();
   AffineMap composed_map = producer_affine_map.compose(first.GetAffineMap());
@@ -1896,6 +1915,25 @@ IndexingMap ComposeIndexingMaps(const IndexingMap& first,
   return composed_indexing_map;
 }
 
+}  // namespace
+
+IndexingMap ComposeIndexingMaps(const IndexingMap& first,
+                                const IndexingMap& second) {
+  if (second.IsUndefined() || first.IsUndefined()) {
+    return IndexingMap::GetUndefined();
+  }
+  IndexingMapCache* cache = IndexingMapCache::Get(first.GetMLIRContext());
+  if (cache == nullptr) {
+    return ComposeIndexingMapsUncached(first, second);
+  }
+  if (std::optional<IndexingMap> cached = cache->GetComposed(first, second)) {
+    return *std::move(cached);
+  }
+  IndexingMap composed = ComposeIndexingMapsUncached(first, second);
+  cache->AddComposed(first, second, composed);
+  return composed;
+}
+
 bool IndexingMap::RescaleSymbols() {
   MergeModConstraints();
 
@@ -2062,4 +2100,131 @@ IndexingMap ConvertRangeVariablesToDimensions(
                      std::move(range_vars), map.GetRTVars(), constraints};
 }
 
+namespace {
+
+// Each map of the cache is cleared when it reaches this size, so that the
+// memory used by a long-lived cache stays bounded.
+constexpr int64_t kMaxCachedIndexingMaps = 1 << 16;
+
+struct IndexingMapCacheRegistry {
+  absl::Mutex mu;
+  absl::flat_hash_map<MLIRContext*, IndexingMapCache*> caches
+      ABSL_GUARDED_BY(mu);
+  // Lets lookups skip the mutex when no cache is registered at all.
+  std::atomic<int64_t> num_caches{0};
+};
+
+IndexingMapCacheRegistry& GetIndexingMapCacheRegistry() {
+  static auto* registry = new IndexingMapCacheRegistry();
+  return *registry;
+}
+
+bool HaveSameVariableNames(const IndexingMap& lhs, const IndexingMap& rhs) {
+  auto same_names = [](absl::Span<const IndexingMap::Variable> lhs,
+                       absl::Span<const IndexingMap::Variable> rhs) {
+    return absl::c_equal(lhs, rhs,
+                         [](const IndexingMap::Variable& a,
+                            const IndexingMap::Variable& b) {
+                           return a.name == b.name;
+                         });
+  };
+  return same_names(lhs.GetDimVars(), rhs.GetDimVars()) &&
+         same_names(lhs.GetRangeVars(), rhs.GetRangeVars()) &&
+         same_names(lhs.GetRTVars(), rhs.GetRTVars());
+}
+
+bool IdenticalIndexingMaps(const IndexingMap& lhs, const IndexingMap& rhs) {
+  return lhs == rhs && lhs.IsKnownEmpty() == rhs.IsKnownEmpty() &&
+         HaveSameVariableNames(lhs, rhs);
+}
+
+}  // namespace
+
+IndexingMapCache::IndexingMapCache(MLIRContext* mlir_context)
+    : mlir_context_(mlir_context) {
+  IndexingMapCacheRegistry& registry = GetIndexingMapCacheRegistry();
+  absl::MutexLock lock(&registry.mu);
+  CHECK(registry.caches.emplace(mlir_context, this).second)
+      << "An IndexingMapCache is already registered for this MLIRContext.";
+  registry.num_caches.fetch_add(1, std::memory_order_release);
+}
+
+IndexingMapCache::~IndexingMapCache() {
+  IndexingMapCacheRegistry& registry = GetIndexingMapCacheRegistry();
+  absl::MutexLock lock(&registry.mu);
+  registry.caches.erase(mlir_context_);
+  registry.num_caches.fetch_sub(1, std::memory_order_release);
+  VLOG(2) << "IndexingMapCache: " << hits() << " hits, " << misses()
+          << " misses.";
+}
+
+IndexingMapCache* IndexingMapCache::Get(MLIRContext* mlir_context) {
+  IndexingMapCacheRegistry& registry = GetIndexingMapCacheRegistry();
+  if (registry.num_caches.load(std::memory_order_acquire) == 0) {
+    return nullptr;
+  }
+  absl::MutexLock lock(&registry.mu);
+  auto it = registry.caches.find(mlir_context);
+  return it == registry.caches.end() ? nullptr : it->second;
+}
+
+bool IndexingMapCache::KeyEq::operator()(const SimplifyKey& lhs,
+                                         const SimplifyKey& rhs) const {
+  return lhs.second == rhs.second &&
+         IdenticalIndexingMaps(lhs.first, rhs.first);
+}
+
+bool IndexingMapCache::KeyEq::operator()(const ComposeKey& lhs,
+                                         const ComposeKey& rhs) const {
+  return IdenticalIndexingMaps(lhs.first, rhs.first) &&
+         IdenticalIndexingMaps(lhs.second, rhs.second);
+}
+
+std::optional<std::pair<IndexingMap, bool>> IndexingMapCache::GetSimplified(
+    const IndexingMap& map,
+    IndexingMap::SimplifyPointDimensions simplify_point_dimensions) {
+  absl::MutexLock lock(&mu_);
+  auto it = simplified_.find(SimplifyKey(map, simplify_point_dimensions));
+  if (it == simplified_.end()) {
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    return std::nullopt;
+  }
+  hits_.fetch_add(1, std::memory_order_relaxed);
+  return it->second;
+}
+
+void IndexingMapCache::AddSimplified(
+    const IndexingMap& map,
+    IndexingMap::SimplifyPointDimensions simplify_point_dimensions,
+    const IndexingMap& simplified, bool changed) {
+  absl::MutexLock lock(&mu_);
+  if (simplified_.size() >= kMaxCachedIndexingMaps) {
+    simplified_.clear();
+  }
+  simplified_.try_emplace(SimplifyKey(map, simplify_point_dimensions),
+                          simplified, changed);
+}
+
+std::optional<IndexingMap> IndexingMapCache::GetComposed(
+    const IndexingMap& first, const IndexingMap& second) {
+  absl::MutexLock lock(&mu_);
+  auto it = composed_.find(ComposeKey(first, second));
+  if (it == composed_.end()) {
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    return std::nullopt;
+  }
+  hits_.fetch_add(1, std::memory_order_relaxed);
+  return it->second;
+}
+
+void IndexingMapCache::AddComposed(const IndexingMap& first,
+                                   const IndexingMap& second,
+                                   const IndexingMap& composed) {
+  absl::MutexLock lock(&mu_);
+  if (composed_.size() >= kMaxCachedIndexingMaps) {
+    composed_.clear();
+  }
+  composed_.try_emplace(ComposeKey(first, second), composed);
+}
+
 }  // namespace xla
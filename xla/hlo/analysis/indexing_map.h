@@ -17,6 +17,7 @@ limitations under the License.
 #define XLA_HLO_ANALYSIS_INDEXING_MAP_H_
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <optional>
@@ -25,7 +26,11 @@ limitations under the License.
 #include <utility>
 #include <vector>
 
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/hash/hash.h"
 #include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/types/span.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/Hashing.h"
@@ -269,7 +274,8 @@ class IndexingMap {
   // If kPreserve, then point dimensions will not be simplified to constants.
   enum class SimplifyPointDimensions { kPreserve, kReplace };
 
-  // Returns true if the map was simplified.
+  // Returns true if the map was simplified. Uses the IndexingMapCache of the
+  // map's MLIRContext if there is one.
   bool Simplify(SimplifyPointDimensions simplify_point_dimensions =
                     SimplifyPointDimensions::kReplace);
 
@@ -403,6 +409,9 @@ class IndexingMap {
   // Does not change the number of symbols, dimensions or results.
   void ResetToKnownEmpty();
 
+  // Simplify without looking up or populating the IndexingMapCache.
+  bool SimplifyUncached(SimplifyPointDimensions simplify_point_dimensions);
+
   // Verify if all intervals for DimVars, RangeVars and RTVars are feasible.
   bool VerifyVariableIntervals();
 
@@ -456,7 +465,8 @@ inline size_t hash_value(const IndexingMap::Variable& dim_var) {
   return llvm::hash_combine(dim_var.bounds);
 }
 
-// Composes affine maps, i.e. second ∘ first.
+// Composes affine maps, i.e. second ∘ first. Uses the IndexingMapCache of the
+// maps' MLIRContext if there is one.
 IndexingMap ComposeIndexingMaps(const IndexingMap& first,
                                 const IndexingMap& second);
 
@@ -477,6 +487,69 @@ H AbslHashValue(H h, const IndexingMap& indexing_map) {
   return h;
 }
 
+// Memoizes IndexingMap::Simplify and ComposeIndexingMaps for the maps of one
+// MLIRContext. Fusion passes compute the indexing of the same producers and
+// consumers many times; while a cache is registered for their context, maps
+// that were already simplified or composed are not computed again.
+//
+// The cache is registered for `mlir_context` from its construction to its
+// destruction, so it must be destroyed before the context. At most one cache
+// can be registered per context. Thread safe.
+class IndexingMapCache {
+ public:
+  explicit IndexingMapCache(mlir::MLIRContext* mlir_context);
+  ~IndexingMapCache();
+
+  IndexingMapCache(const IndexingMapCache&) = delete;
+  IndexingMapCache& operator=(const IndexingMapCache&) = delete;
+
+  // Returns the cache registered for `mlir_context`, or nullptr if there is
+  // none.
+  static IndexingMapCache* Get(mlir::MLIRContext* mlir_context);
+
+  // Returns the simplified `map` and whether it differs from `map`, if it is
+  // cached.
+  std::optional<std::pair<IndexingMap, bool>> GetSimplified(
+      const IndexingMap& map,
+      IndexingMap::SimplifyPointDimensions simplify_point_dimensions);
+  void AddSimplified(
+      const IndexingMap& map,
+      IndexingMap::SimplifyPointDimensions simplify_point_dimensions,
+      const IndexingMap& simplified, bool changed);
+
+  // Returns ComposeIndexingMaps(first, second), if it is cached.
+  std::optional<IndexingMap> GetComposed(const IndexingMap& first,
+                                         const IndexingMap& second);
+  void AddComposed(const IndexingMap& first, const IndexingMap& second,
+                   const IndexingMap& composed);
+
+  int64_t hits() const { return hits_.load(std::memory_order_relaxed); }
+  int64_t misses() const { return misses_.load(std::memory_order_relaxed); }
+
+ private:
+  using SimplifyKey =
+      std::pair<IndexingMap, IndexingMap::SimplifyPointDimensions>;
+  using ComposeKey = std::pair<IndexingMap, IndexingMap>;
+
+  // IndexingMap::operator== ignores the names of the variables, which the
+  // cached results have to preserve.
+  struct KeyEq {
+    bool operator()(const SimplifyKey& lhs, const SimplifyKey& rhs) const;
+    bool operator()(const ComposeKey& lhs, const ComposeKey& rhs) const;
+  };
+
+  mlir::MLIRContext* mlir_context_;
+  std::atomic<int64_t> hits_{0};
+  std::atomic<int64_t> misses_{0};
+
+  absl::Mutex mu_;
+  absl::flat_hash_map<SimplifyKey, std::pair<IndexingMap, bool>,
+                      absl::Hash<SimplifyKey>, KeyEq>
+      simplified_ ABSL_GUARDED_BY(mu_);
+  absl::flat_hash_map<ComposeKey, IndexingMap, absl::Hash<ComposeKey>, KeyEq>
+      composed_ ABSL_GUARDED_BY(mu_);
+};
+
 std::vector<IndexingMap::Variable> DimVarsFromTensorSizes(
     absl::Span<const int64_t> tensor_sizes);
 
@@ -616,6 +616,63 @@ TEST_F(IndexingMapTest, ConstraintIntervalSimplification_Sum) {
                         )"));
 }
 
+TEST_F(IndexingMapTest, SimplifyUsesCache) {
+  IndexingMapCache cache(&mlir_context_);
+  constexpr absl::string_view kMap = R"(
+    (d0) -> (d0),
+    domain:
+    d0 in [0, 99],
+    d0 mod 8 + 5 in [50, 54]
+  )";
+  auto indexing_map = Parse(kMap);
+  EXPECT_TRUE(indexing_map.Simplify());
+  EXPECT_EQ(cache.misses(), 1);
+  EXPECT_EQ(cache.hits(), 0);
+
+  auto cached_indexing_map = Parse(kMap);
+  EXPECT_TRUE(cached_indexing_map.Simplify());
+  EXPECT_EQ(cache.misses(), 1);
+  EXPECT_EQ(cache.hits(), 1);
+  EXPECT_EQ(cached_indexing_map, indexing_map);
+  EXPECT_THAT(ToString(cached_indexing_map), MatchIndexingString(R"(
+                          (d0) -> (d0),
+                          domain:
+                          d0 in [0, 99],
+                          d0 mod 8 in [45, 49]
+                        )"));
+
+  // The simplified map is cached too, and is not simplified any further.
+  EXPECT_FALSE(cached_indexing_map.Simplify());
+  EXPECT_FALSE(cached_indexing_map.Simplify());
+  EXPECT_EQ(cache.misses(), 2);
+  EXPECT_EQ(cache.hits(), 2);
+}
+
+TEST_F(IndexingMapTest, ComposeUsesCache) {
+  IndexingMap producer = Parse(R"(
+     (d0, d1)[s0, s1] -> (d1, d0, s1, s0),
+     domain:
+     d0 in [0, 3],
+     d1 in [0, 3],
+     s0 in [0, 1],
+     s1 in [0, 1]
+  )");
+  IndexingMap consumer = Parse(R"(
+     (d0)[s0] -> (d0, s0),
+     domain:
+     d0 in [0, 3],
+     s0 in [0, 3]
+  )");
+  IndexingMap uncached = ComposeIndexingMaps(consumer, producer);
+
+  IndexingMapCache cache(&mlir_context_);
+  EXPECT_EQ(IndexingMapCache::Get(&mlir_context_), &cache);
+  EXPECT_EQ(ComposeIndexingMaps(consumer, producer), uncached);
+  EXPECT_EQ(ComposeIndexingMaps(consumer, producer), uncached);
+  EXPECT_EQ(cache.misses(), 1);
+  EXPECT_EQ(cache.hits(), 1);
+}
+
 TEST_F(IndexingMapTest,
        ConstraintIntervalSimplification_Sum_IndependentOfSymbol) {
   auto indexing_map = Parse(R"(
@@ -969,6 +969,14 @@ absl::StatusOr<Literal> HloEvaluator::Evaluate(
     }
   }
 
+  if (computation_handler_) {
+    TF_ASSIGN_OR_RETURN(std::optional<Literal> result,
+                        computation_handler_(computation, args));
+    if (result.has_value()) {
+      return *std::move(result);
+    }
+  }
+
   // Reset evaluation state with the argument literals.
   ScopedEvaluateState evaluate_state(&state_, args);
 
@@ -4920,6 +4928,22 @@ std::unique_ptr<Array2D<uint8_t>> HloEvaluator::MatmulArray2D(
       lhs, rhs, __xla_cpu_runtime_EigenSingleThreadedMatMulU8);
 }
 
+void HloEvaluator::BatchMatmul(const float* lhs, const float* rhs, float* out,
+                               int64_t batch_size, int64_t m, int64_t n,
+                               int64_t k, bool transpose_lhs,
+                               bool transpose_rhs) {
+  // The runtime kernel works on column-major matrices, so it computes the
+  // transposed result `rhs^T x lhs^T` of the row-major matrices.
+  for (int64_t i = 0; i < batch_size; ++i) {
+    __xla_cpu_runtime_EigenSingleThreadedMatMulF32(
+        /*run_options_ptr=*/nullptr, out + i * m * n,
+        const_cast<float*>(rhs + i * k * n),
+        const_cast<float*>(lhs + i * m * k), n, m, k,
+        /*transpose_lhs=*/transpose_rhs,
+        /*transpose_rhs=*/transpose_lhs);
+  }
+}
+
 /* static */ std::unique_ptr<Array2D<float>> Array2DF8E5M2ToF32(
     const Array2D<tsl::float8_e5m2>& input) {
   auto result = std::make_unique<Array2D<float>>(input.height(), input.width());
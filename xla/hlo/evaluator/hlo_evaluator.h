@@ -83,6 +83,7 @@ class HloEvaluator : public ConstDfsHloVisitorWithDefault {
       int64_t max_loop_iterations) {
     auto result = std::make_unique<HloEvaluator>(max_loop_iterations);
     result->set_custom_call_handler(custom_call_handler_);
+    result->set_computation_handler(computation_handler_);
     return result;
   }
 
@@ -216,6 +217,22 @@ class HloEvaluator : public ConstDfsHloVisitorWithDefault {
     custom_call_handler_ = std::move(handler);
   }
 
+  // Handles evaluation of a whole computation, e.g. by compiling it with a
+  // real backend. Returns std::nullopt if the computation should be evaluated
+  // by the evaluator itself, e.g. because it is too small to be worth it.
+  using ComputationHandler =
+      std::function<absl::StatusOr<std::optional<Literal>>(
+          const HloComputation& computation,
+          absl::Span<const Literal* const> args)>;
+
+  // Sets a handler that is offered every computation evaluated by this
+  // evaluator and its embedded evaluators, including called computations such
+  // as while bodies, before falling back to evaluating it instruction by
+  // instruction.
+  void set_computation_handler(ComputationHandler handler) {
+    computation_handler_ = std::move(handler);
+  }
+
   // Callback for each multiply-accumulate in each dot or convolution operation.
   using TraceMACHandler = std::function<void(
       int64_t result_index, int64_t lhs_index, int64_t rhs_index)>;
@@ -250,6 +267,14 @@ class HloEvaluator : public ConstDfsHloVisitorWithDefault {
   static std::unique_ptr<Array2D<uint8_t>> MatmulArray2D(
       const Array2D<uint8_t>& lhs, const Array2D<uint8_t>& rhs);
 
+  // Computes `batch_size` matrix multiplies of row-major matrices with the
+  // Eigen kernel of the CPU runtime. `lhs` holds [m, k] matrices, or [k, m]
+  // ones if `transpose_lhs`, and `rhs` holds [k, n] matrices, or [n, k] ones
+  // if `transpose_rhs`. `out` holds the [m, n] results.
+  static void BatchMatmul(const float* lhs, const float* rhs, float* out,
+                          int64_t batch_size, int64_t m, int64_t n, int64_t k,
+                          bool transpose_lhs, bool transpose_rhs);
+
  protected:
   // Evaluates the given instruction, and stores the evaluation result in the
   // evaluation state.
@@ -589,6 +614,9 @@ class HloEvaluator : public ConstDfsHloVisitorWithDefault {
   // Optional handler for custom_call ops.
   CustomCallHandler custom_call_handler_;
 
+  // Optional handler for whole computations.
+  ComputationHandler computation_handler_;
+
   // Optional handler for tracing MAC operations (eg in dot and convolution).
   TraceMACHandler trace_mac_handler_;
 
@@ -5016,6 +5016,51 @@ TEST_F(HloEvaluatorTest, ZeroSizedIotaWithHugeDimension) {
   EXPECT_THAT(actual_literal.data<float>(), ::testing::IsEmpty());
 }
 
+TEST_F(HloEvaluatorTest, IotaWithNonDefaultLayout) {
+  const absl::string_view hlo_text = R"(
+  HloModule test
+  ENTRY t {
+    ROOT i = s32[3,2,4]{0,2,1} iota(), iota_dimension=2
+  })";
+  TF_ASSERT_OK_AND_ASSIGN(m_, ParseAndReturnVerifiedModule(hlo_text));
+  TF_ASSERT_OK_AND_ASSIGN(
+      Literal actual_literal,
+      HloEvaluator().Evaluate(*m_->entry_computation(), {}));
+  ShapeUtil::ForEachIndexNoStatus(
+      actual_literal.shape(), [&](absl::Span<const int64_t> index) {
+        EXPECT_EQ(actual_literal.Get<int32_t>(index), index[2]);
+        return true;
+      });
+}
+
+TEST_F(HloEvaluatorTest, ComputationHandler) {
+  const absl::string_view hlo_text = R"(
+  HloModule test
+  ENTRY t {
+    p0 = s32[] parameter(0)
+    ROOT neg = s32[] negate(p0)
+  })";
+  TF_ASSERT_OK_AND_ASSIGN(m_, ParseAndReturnVerifiedModule(hlo_text));
+  Literal arg = LiteralUtil::CreateR0<int32_t>(3);
+
+  HloEvaluator evaluator;
+  evaluator.set_computation_handler(
+      [](const HloComputation& computation,
+         absl::Span<const Literal* const> args)
+          -> absl::StatusOr<std::optional<Literal>> {
+        if (args[0]->Get<int32_t>({}) == 3) {
+          return LiteralUtil::CreateR0<int32_t>(42);
+        }
+        return std::nullopt;
+      });
+  TF_ASSERT_OK_AND_ASSIGN(Literal handled, evaluator.Evaluate(*m_, {&arg}));
+  EXPECT_EQ(handled, LiteralUtil::CreateR0<int32_t>(42));
+
+  arg = LiteralUtil::CreateR0<int32_t>(5);
+  TF_ASSERT_OK_AND_ASSIGN(Literal evaluated, evaluator.Evaluate(*m_, {&arg}));
+  EXPECT_EQ(evaluated, LiteralUtil::CreateR0<int32_t>(-5));
+}
+
 TEST_F(HloEvaluatorTest, CopyStartCopyDone) {
   const absl::string_view hlo_text = R"(
   HloModule test
@@ -5212,6 +5257,37 @@ TEST_F(HloEvaluatorTest, DotUpcast) {
   EXPECT_TRUE(LiteralTestUtil::Equal(expected, result));
 }
 
+TEST_F(HloEvaluatorTest, BatchedTransposedDotFastPath) {
+  const absl::string_view hlo_text = R"(
+  HloModule test
+  ENTRY BatchedTransposedDot {
+    l = f32[3,5,4] parameter(0)
+    r = f32[3,6,5] parameter(1)
+    ROOT result = f32[3,4,6] dot(l, r), lhs_batch_dims={0},
+                                        lhs_contracting_dims={1},
+                                        rhs_batch_dims={0},
+                                        rhs_contracting_dims={2}
+  }
+  )";
+  TF_ASSERT_OK_AND_ASSIGN(auto lhs_literal,
+                          LiteralUtil::CreateRandomLiteral<F32>(
+                              ShapeUtil::MakeShape(F32, {3, 5, 4}), 0.0, 1.0));
+  TF_ASSERT_OK_AND_ASSIGN(auto rhs_literal,
+                          LiteralUtil::CreateRandomLiteral<F32>(
+                              ShapeUtil::MakeShape(F32, {3, 6, 5}), 0.0, 1.0));
+  TF_ASSERT_OK_AND_ASSIGN(m_, ParseAndReturnVerifiedModule(hlo_text));
+  TF_ASSERT_OK_AND_ASSIGN(Literal expected,
+                          Evaluate({&lhs_literal, &rhs_literal}));
+
+  HloEvaluator fast_evaluator;
+  fast_evaluator.set_use_fast_path(true);
+  TF_ASSERT_OK_AND_ASSIGN(
+      Literal result, fast_evaluator.Evaluate(*m_->entry_computation(),
+                                              {&lhs_literal, &rhs_literal}));
+
+  EXPECT_TRUE(LiteralTestUtil::Near(expected, result, ErrorSpec(1e-5)));
+}
+
 TEST_F(HloEvaluatorTest, SortC64) {
   const absl::string_view hlo_text = R"(
   HloModule m
@@ -1119,16 +1119,29 @@ class HloEvaluatorTypedVisitor : public ConstDfsHloVisitorWithDefault {
 
     auto is_default_layout = [](const HloInstruction* op) {
       return !op->shape().has_layout() ||
-             LayoutUtil::Equal(op->shape().layout(),
-                               LayoutUtil::GetDefaultLayoutForR2());
+             LayoutUtil::IsMonotonicWithDim0Major(op->shape().layout());
+    };
+    auto is_leading_batch = [](absl::Span<const int64_t> batch_dimensions) {
+      for (int64_t i = 0; i < batch_dimensions.size(); ++i) {
+        if (batch_dimensions[i] != i) {
+          return false;
+        }
+      }
+      return true;
     };
 
-    // The fast path is for a simple rank 2 dot with default layout operands.
-    if (lhs_rank != 2 || rhs_rank != 2 || lhs_contracting_dimension != 1 ||
-        rhs_contracting_dimension != 0 || !is_default_layout(lhs) ||
-        !is_default_layout(rhs) || !is_default_layout(dot)) {
+    // The fast path is for a (batched) matrix multiply with default layouts,
+    // where the batch dimensions lead and either operand may be transposed.
+    const int64_t batch_rank = dnums.lhs_batch_dimensions_size();
+    if (lhs_rank != batch_rank + 2 || rhs_rank != batch_rank + 2 ||
+        !is_leading_batch(dnums.lhs_batch_dimensions()) ||
+        !is_leading_batch(dnums.rhs_batch_dimensions()) ||
+        !is_default_layout(lhs) || !is_default_layout(rhs) ||
+        !is_default_layout(dot)) {
       return HandleDotSlowPath(dot);
     }
+    const bool transpose_lhs = lhs_contracting_dimension == batch_rank;
+    const bool transpose_rhs = rhs_contracting_dimension == batch_rank + 1;
 
     const PrimitiveType native_ty =
         primitive_util::NativeToPrimitiveType<NativeT>();
@@ -1136,18 +1149,18 @@ class HloEvaluatorTypedVisitor : public ConstDfsHloVisitorWithDefault {
         parent_->GetEvaluatedLiteralFor(lhs).Convert(native_ty).value();
     Literal rhs_literal =
         parent_->GetEvaluatedLiteralFor(rhs).Convert(native_ty).value();
-    const int64_t contracted_dimension_size =
-        lhs->shape().dimensions(lhs_contracting_dimension);
-    Array2D<NativeT> lhs_array(lhs->shape().dimensions(0),
-                               contracted_dimension_size);
-    lhs_array.SetValues(lhs_literal.data<NativeT>());
-    Array2D<NativeT> rhs_array(contracted_dimension_size,
-                               rhs->shape().dimensions(1));
-    rhs_array.SetValues(rhs_literal.data<NativeT>());
-    std::unique_ptr<Array2D<NativeT>> result_array =
-        HloEvaluator::MatmulArray2D(lhs_array, rhs_array);
+    const int64_t batch_size =
+        Product(lhs->shape().dimensions().first(batch_rank));
+    const int64_t m = lhs->shape().dimensions(
+        transpose_lhs ? batch_rank + 1 : batch_rank);
+    const int64_t n = rhs->shape().dimensions(
+        transpose_rhs ? batch_rank : batch_rank + 1);
+    const int64_t k = lhs->shape().dimensions(lhs_contracting_dimension);
     Literal result(ShapeUtil::MakeShape(native_ty, dot->shape().dimensions()));
-    result.PopulateR2FromArray2D(*result_array);
+    HloEvaluator::BatchMatmul(lhs_literal.data<NativeT>().data(),
+                              rhs_literal.data<NativeT>().data(),
+                              result.data<NativeT>().data(), batch_size, m, n,
+                              k, transpose_lhs, transpose_rhs);
     parent_->SetEvaluatedLiteralFor(
         dot, std::move(result).Convert(dot->shape().element_type()).value());
     return absl::OkStatus();
@@ -1566,11 +1579,26 @@ class HloEvaluatorTypedVisitor : public ConstDfsHloVisitorWithDefault {
                   std::is_floating_point_v<ElementwiseT>) {
       auto iota_shape = GetShapeWithLayout(iota->shape());
       Literal result(iota_shape);
-      ShapeUtil::ForEachIndexNoStatus(
-          iota_shape, [&](absl::Span<const int64_t> idx) {
-            result.Set(idx, static_cast<ReturnT>(idx[iota->iota_dimension()]));
-            return true;
-          });
+      if (ShapeUtil::ElementsIn(iota_shape) > 0) {
+        // Iotas are often large (e.g. masks and position tables being
+        // constant folded), so populate them in parallel in physical order.
+        // The value at a linear index only depends on the iota dimension's
+        // stride in the layout.
+        const int64_t iota_dim = iota->iota_dimension();
+        const int64_t iota_dim_size = iota_shape.dimensions(iota_dim);
+        int64_t iota_dim_stride = 1;
+        for (int64_t dim : iota_shape.layout().minor_to_major()) {
+          if (dim == iota_dim) {
+            break;
+          }
+          iota_dim_stride *= iota_shape.dimensions(dim);
+        }
+        TF_RETURN_IF_ERROR(result.PopulateLinearParallel<ReturnT>(
+            [&](int64_t linear_index, int /*thread_id*/) {
+              return static_cast<ReturnT>(
+                  (linear_index / iota_dim_stride) % iota_dim_size);
+            }));
+      }
       parent_->SetEvaluatedLiteralFor(iota, std::move(result));
       return absl::OkStatus();
     }
@@ -68,6 +68,7 @@ limitations under the License.
 #include "xla/hlo/ir/hlo_instructions.h"
 #include "xla/hlo/ir/hlo_module.h"
 #include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/hlo/ir/hlo_print_options.h"
 #include "xla/hlo/ir/hlo_schedule.h"
 #include "xla/hlo/ir/hlo_sharding.h"
 #include "xla/hlo/transforms/simplifiers/hlo_constant_splitter.h"
@@ -91,6 +92,7 @@ limitations under the License.
 #include "xla/util.h"
 #include "xla/xla_data.pb.h"
 #include "tsl/platform/errors.h"
+#include "tsl/platform/fingerprint.h"
 #include "tsl/platform/statusor.h"
 
 namespace xla {
@@ -1751,6 +1753,91 @@ std::unique_ptr<StrategyGroup> CreateReshapeStrategies(
   return strategy_group;
 }
 
+namespace {
+
+// Returns a fingerprint of `ins` which ignores the parameter numbers and tuple
+// indices of parameters, which differ between otherwise identical layers.
+uint64_t StructuralFingerprint(const HloInstruction* ins) {
+  if (ins->opcode() == HloOpcode::kParameter ||
+      (ins->opcode() == HloOpcode::kGetTupleElement &&
+       ins->operand(0)->opcode() == HloOpcode::kParameter)) {
+    return tsl::Fingerprint64(
+        absl::StrCat("parameter ", ins->shape().ToString(true)));
+  }
+  return tsl::Fingerprint64(ins->ToString(HloPrintOptions::Fingerprint()));
+}
+
+// Ties the strategies of the instructions of structurally identical layers,
+// e.g. the repeated blocks of a transformer, to the strategies of the first
+// such layer, so that the number of decision variables of the solver scales
+// with the number of unique blocks rather than with the number of
+// instructions. Two nodes are tied if their instructions and the operands of
+// their instructions up to `depth` levels have the same fingerprints, and if
+// they have the same strategies. Returns the number of tied nodes.
+int64_t TieStructurallyIdenticalNodes(
+    const std::vector<HloInstruction*>& instructions,
+    const StrategyGroups& strategy_groups, int64_t depth,
+    AutoShardingSolverRequest& request) {
+  absl::flat_hash_map<const HloInstruction*, uint64_t> fingerprints;
+  for (const HloInstruction* ins : instructions) {
+    fingerprints[ins] = StructuralFingerprint(ins);
+  }
+  for (int64_t level = 0; level < depth; ++level) {
+    absl::flat_hash_map<const HloInstruction*, uint64_t> next_fingerprints =
+        fingerprints;
+    for (const HloInstruction* ins : instructions) {
+      uint64_t& fingerprint = next_fingerprints[ins];
+      for (const HloInstruction* operand : ins->operands()) {
+        auto it = fingerprints.find(operand);
+        fingerprint = tsl::FingerprintCat64(
+            fingerprint, it == fingerprints.end() ? 0 : it->second);
+      }
+    }
+    fingerprints = std::move(next_fingerprints);
+  }
+
+  auto same_strategies = [&](NodeIdx a, NodeIdx b) {
+    const auto& a_strategies = strategy_groups[a]->GetStrategies();
+    const auto& b_strategies = strategy_groups[b]->GetStrategies();
+    if (a_strategies.size() != b_strategies.size() ||
+        request.s_len(a) != request.s_len(b)) {
+      return false;
+    }
+    for (NodeStrategyIdx i = 0; i < a_strategies.size(); ++i) {
+      if (a_strategies[i].output_sharding != b_strategies[i].output_sharding) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  auto s_follow = request.mutable_s_follow();
+  absl::flat_hash_map<std::pair<uint64_t, int64_t>, NodeIdx> representatives;
+  int64_t num_tied = 0;
+  for (NodeIdx node_idx = 0; node_idx < request.num_nodes(); ++node_idx) {
+    if (s_follow->at(node_idx) >= 0) continue;
+    const StrategyGroup* strategy_group = strategy_groups[node_idx];
+    const HloInstruction* ins = instructions.at(strategy_group->instruction_id);
+    auto [it, inserted] = representatives.try_emplace(
+        {fingerprints.at(ins), strategy_group->tuple_element_idx.value_or(-1)},
+        node_idx);
+    if (inserted || !same_strategies(it->second, node_idx)) continue;
+    s_follow->Set(node_idx, it->second);
+    ++num_tied;
+  }
+
+  // Nodes following a tied node now follow its representative.
+  for (NodeIdx node_idx = 0; node_idx < request.num_nodes(); ++node_idx) {
+    if (s_follow->at(node_idx) < 0) continue;
+    while (s_follow->at(s_follow->at(node_idx)) >= 0) {
+      s_follow->Set(node_idx, s_follow->at(s_follow->at(node_idx)));
+    }
+  }
+  return num_tied;
+}
+
+}  // namespace
+
 absl::StatusOr<AutoShardingSolverOutput>
 CreateAutoShardingSolverRequestAndCallSolver(
     const HloModule& hlo_module, const HloLiveRange& hlo_live_range,
@@ -1996,8 +2083,40 @@ CreateAutoShardingSolverRequestAndCallSolver(
     *request.add_edge_intervals() = std::move(interval);
   }
 
+  // Structurally identical layers are solved once, then the solution is
+  // optionally refined by solving the untied problem starting from it.
+  std::optional<AutoShardingSolverRequest> untied_request;
+  if (option.structural_tie_depth > 0) {
+    if (option.structural_refinement_timeout_in_seconds > 0) {
+      untied_request = request;
+    }
+    int64_t num_tied = TieStructurallyIdenticalNodes(
+        instructions, strategy_groups, option.structural_tie_depth, request);
+    LOG(INFO) << "Tied " << num_tied << " of " << request.num_nodes()
+              << " nodes to structurally identical nodes";
+  }
+
   const auto converted_problem = ConvertToProblem(request);
-  return FormulateAndSolveMIPFromProblem(converted_problem, GetParams(request));
+  TF_ASSIGN_OR_RETURN(
+      AutoShardingSolverOutput output,
+      FormulateAndSolveMIPFromProblem(converted_problem, GetParams(request)));
+  if (!untied_request.has_value()) {
+    return output;
+  }
+
+  AutoShardingSolverParams refinement_params = GetParams(*untied_request);
+  refinement_params.s_hint = output.s_val;
+  refinement_params.solver_timeout =
+      absl::Seconds(option.structural_refinement_timeout_in_seconds);
+  absl::StatusOr<AutoShardingSolverOutput> refined_output =
+      FormulateAndSolveMIPFromProblem(ConvertToProblem(*untied_request),
+                                      refinement_params);
+  if (!refined_output.ok() || refined_output->cost >= output.cost) {
+    VLOG(1) << "Refinement did not improve the solution of the tied problem: "
+            << refined_output.status();
+    return output;
+  }
+  return *std::move(refined_output);
 }
 
 void CheckHloSharding(
@@ -3655,6 +3774,13 @@ absl::StatusOr<bool> AutoShardingImplementation::RunAutoSharding(
 
   std::unique_ptr<CallGraph> call_graph = CallGraph::Build(module);
 
+  spmd::ProfilingResult prof_result;
+  if (!option_.collective_perf_table_path.empty()) {
+    TF_ASSIGN_OR_RETURN(prof_result,
+                        spmd::ProfilingResult::FromCollectivePerfTableFile(
+                            option_.collective_perf_table_path));
+  }
+
   HloCostAnalysis::Options hlo_cost_analysis_options{
       .shape_size = [](const Shape& shape) {
         return spmd::ByteSizeOfShape(shape);
@@ -3685,8 +3811,6 @@ absl::StatusOr<bool> AutoShardingImplementation::RunAutoSharding(
       device_mesh.SetValues(option_.device_mesh_ids);
     }
 
-    // TODO (zhuohan): Include the prof result as an option.
-    spmd::ProfilingResult prof_result;
     spmd::ClusterEnvironment cluster_env(
         original_device_mesh, device_mesh, option_.device_mesh_alpha,
         option_.device_mesh_beta, prof_result, option_);
@@ -109,6 +109,8 @@ std::string AutoShardingOption::ToString() const {
                                absl::StrJoin(device_mesh_alpha, ","), "]"));
   lines.push_back(absl::StrCat("device_mesh_beta: [",
                                absl::StrJoin(device_mesh_beta, ","), "]"));
+  lines.push_back(absl::StrCat("collective_perf_table_path: ",
+                               collective_perf_table_path));
 
   lines.push_back(
       absl::StrCat("try_multiple_mesh_shapes: ", try_multiple_mesh_shapes));
@@ -122,6 +124,12 @@ std::string AutoShardingOption::ToString() const {
   lines.push_back(absl::StrCat("allow_alias_to_follower_conversion: ",
                                allow_alias_to_follower_conversion));
 
+  lines.push_back(
+      absl::StrCat("structural_tie_depth: ", structural_tie_depth));
+
+  lines.push_back(absl::StrCat("structural_refinement_timeout_in_seconds: ",
+                               structural_refinement_timeout_in_seconds));
+
   lines.push_back(
       absl::StrCat("small_tensor_byte_size: ", small_tensor_byte_size));
 
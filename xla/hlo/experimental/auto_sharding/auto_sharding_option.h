@@ -154,6 +154,13 @@ struct AutoShardingOption {
   std::vector<double> device_mesh_alpha;
   std::vector<double> device_mesh_beta;
 
+  // If not empty, the path to a perf table of collectives, e.g. one generated
+  // by xla/tools/collective_perf_table_gen, whose measured costs in seconds
+  // replace the alpha-beta model above. Collectives missing from the table
+  // still use the alpha-beta model, so device_mesh_alpha and device_mesh_beta
+  // should then be given in seconds and seconds per byte.
+  std::string collective_perf_table_path;
+
   // Explore other mesh shapes with the same number of devices as the provided
   // one for a potentially better auto-sharding solution.
   bool try_multiple_mesh_shapes = false;
@@ -174,6 +181,18 @@ struct AutoShardingOption {
   // smaller Mixed ILP).
   bool allow_alias_to_follower_conversion = true;
 
+  // If greater than zero, instructions that are identical together with their
+  // operands up to this many levels, e.g. the instructions of the repeated
+  // layers of a model, are forced to share the same strategies. This makes the
+  // solve time scale with the number of unique layers rather than with the
+  // number of instructions, at the expense of the solution quality.
+  int64_t structural_tie_depth = 0;
+
+  // If greater than zero and instructions are tied by structural_tie_depth,
+  // the solution is refined by solving the untied problem starting from the
+  // tied solution for at most this many seconds.
+  int64_t structural_refinement_timeout_in_seconds = 0;
+
   // If greater than zero, tensors with size smaller than or equal to this limit
   // will always be replicated if they don't have a different user-specified
   // sharding.
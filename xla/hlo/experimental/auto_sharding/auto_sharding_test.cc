@@ -2897,6 +2897,44 @@ ENTRY %entry {
   EXPECT_TRUE(changed);
 }
 
+TEST_F(AutoShardingTest, StructuralTiesShareShardingsOfIdenticalLayers) {
+  constexpr absl::string_view kHloString = R"(
+HloModule module
+
+ENTRY %entry {
+  %x = f32[128,256]{1,0} parameter(0)
+  %w0 = f32[256,256]{1,0} parameter(1)
+  %w1 = f32[256,256]{1,0} parameter(2)
+  %w2 = f32[256,256]{1,0} parameter(3)
+  %dot.0 = f32[128,256]{1,0} dot(%x, %w0), lhs_contracting_dims={1}, rhs_contracting_dims={0}
+  %tanh.0 = f32[128,256]{1,0} tanh(%dot.0)
+  %dot.1 = f32[128,256]{1,0} dot(%tanh.0, %w1), lhs_contracting_dims={1}, rhs_contracting_dims={0}
+  %tanh.1 = f32[128,256]{1,0} tanh(%dot.1)
+  %dot.2 = f32[128,256]{1,0} dot(%tanh.1, %w2), lhs_contracting_dims={1}, rhs_contracting_dims={0}
+  ROOT %tanh.2 = f32[128,256]{1,0} tanh(%dot.2)
+}
+)";
+
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<VerifiedHloModule> module,
+                          ParseAndReturnVerifiedModule(kHloString));
+  AutoShardingOption option;
+  option.enable = true;
+  option.device_mesh_shape = {2, 2};
+  option.device_mesh_ids = {0, 1, 2, 3};
+  option.device_mesh_alpha = {1.0, 1.0};
+  option.device_mesh_beta = {0.01, 1.0};
+  option.structural_tie_depth = 2;
+  TF_ASSERT_OK_AND_ASSIGN(bool changed, AutoSharding(option).Run(module.get()));
+  VLOG(10) << module->ToString();
+  EXPECT_TRUE(changed);
+  const HloInstruction* dot1 = FindInstruction(module.get(), "dot.1");
+  const HloInstruction* dot2 = FindInstruction(module.get(), "dot.2");
+  ASSERT_NE(dot1, nullptr);
+  ASSERT_NE(dot2, nullptr);
+  ASSERT_TRUE(dot1->has_sharding());
+  EXPECT_EQ(dot1->sharding(), dot2->sharding());
+}
+
 TEST_F(AutoShardingTest, BufferDonorConfigPreservation) {
   constexpr absl::string_view kHloString = R"(
 HloModule Module, buffer_donor={ (0, {0}), (0, {1}) }
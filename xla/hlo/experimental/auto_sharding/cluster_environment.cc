@@ -44,8 +44,10 @@ double ClusterEnvironment::AllGatherCost(double num_bytes, int mesh_dim) const {
   }
 
   if (prof_result_.Enabled()) {
-    return prof_result_.EstimateAllGatherCost(cached_replica_groups_[mesh_dim],
-                                              num_bytes / 4, "float32");
+    if (std::optional<double> cost = prof_result_.EstimateAllGatherCost(
+            cached_replica_groups_[mesh_dim], num_bytes / 4, "float32")) {
+      return *cost;
+    }
   }
 
   int64_t num_devices = device_mesh_.dim(mesh_dim);
@@ -62,9 +64,11 @@ double ClusterEnvironment::AllReduceCost(double num_bytes, int32_t mesh_dim,
     return auto_sharding_option_.all_reduce_cost;
   }
 
-  if (prof_result_.Enabled()) {
-    return prof_result_.EstimateAllReduceCost(cached_replica_groups_[mesh_dim],
-                                              num_bytes / 4, "float32");
+  if (prof_result_.Enabled() && mesh_dim_another == -1) {
+    if (std::optional<double> cost = prof_result_.EstimateAllReduceCost(
+            cached_replica_groups_[mesh_dim], num_bytes / 4, "float32")) {
+      return *cost;
+    }
   }
   double alpha, beta;
   int64_t num_devices;
@@ -91,8 +95,10 @@ double ClusterEnvironment::ReduceScatterCost(double num_bytes,
   }
 
   if (prof_result_.Enabled()) {
-    return prof_result_.EstimateReduceScatterCost(
-        cached_replica_groups_[mesh_dim], num_bytes / 4, "float32");
+    if (std::optional<double> cost = prof_result_.EstimateReduceScatterCost(
+            cached_replica_groups_[mesh_dim], num_bytes / 4, "float32")) {
+      return *cost;
+    }
   }
 
   int64_t num_devices = device_mesh_.dim(mesh_dim);
@@ -119,8 +125,10 @@ double ClusterEnvironment::AllToAllCost(double num_bytes, int mesh_dim) const {
   }
 
   if (prof_result_.Enabled()) {
-    return prof_result_.EstimateAllToAllCost(cached_replica_groups_[mesh_dim],
-                                             num_bytes / 4, "float32");
+    if (std::optional<double> cost = prof_result_.EstimateAllToAllCost(
+            cached_replica_groups_[mesh_dim], num_bytes / 4, "float32")) {
+      return *cost;
+    }
   }
 
   int64_t num_devices = device_mesh_.dim(mesh_dim);
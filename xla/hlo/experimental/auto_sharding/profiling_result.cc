@@ -0,0 +1,131 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/hlo/experimental/auto_sharding/profiling_result.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/algorithm/container.h"
+#include "absl/log/log.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "xla/hlo/ir/collective_device_list.h"
+#include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/service/gpu/model/hlo_op_profile.pb.h"
+#include "xla/shape.h"
+#include "xla/shape_util.h"
+#include "xla/tsl/platform/env.h"
+#include "xla/tsl/platform/errors.h"
+#include "xla/tsl/platform/statusor.h"
+
+namespace xla {
+namespace spmd {
+
+// ClusterEnvironment queries the costs of collectives of f32 elements.
+constexpr absl::string_view kDtype = "float32";
+constexpr int64_t kBytesPerElement = 4;
+
+void ProfilingResult::AddCost(
+    const std::vector<std::vector<int64_t>>& replica_groups, int64_t size,
+    double cost, const std::string& dtype, StableMap<Key, Value>& cost_dict) {
+  for (std::string group :
+       {Group2Str(replica_groups), GroupPattern2Str(replica_groups)}) {
+    Value& cost_list = cost_dict[Key(std::move(group), dtype)];
+    auto it = absl::c_lower_bound(
+        cost_list, size,
+        [](const std::pair<int64_t, double>& point, int64_t other_size) {
+          return point.first < other_size;
+        });
+    if (it != cost_list.end() && it->first == size) {
+      // Keep the fastest measurement of a size, e.g. of the same groups
+      // measured on several meshes.
+      it->second = std::min(it->second, cost);
+    } else {
+      cost_list.insert(it, {size, cost});
+    }
+  }
+}
+
+absl::StatusOr<ProfilingResult> ProfilingResult::FromCollectivePerfTable(
+    const gpu::DeviceHloInstructionProfiles& perf_table) {
+  ProfilingResult result;
+  const std::string dtype(kDtype);
+  for (const auto& [device, profiles] : perf_table.entries()) {
+    for (const gpu::HloInstructionProfile& profile : profiles.entries()) {
+      const HloInstructionProto& instr = profile.instruction();
+      TF_ASSIGN_OR_RETURN(HloOpcode opcode, StringToHloOpcode(instr.opcode()));
+      StableMap<Key, Value>* cost_dict;
+      switch (opcode) {
+        case HloOpcode::kAllReduce:
+          cost_dict = &result.all_reduce_cost_dict_;
+          break;
+        case HloOpcode::kAllGather:
+          cost_dict = &result.all_gather_cost_dict_;
+          break;
+        case HloOpcode::kReduceScatter:
+          cost_dict = &result.reduce_scatter_cost_dict_;
+          break;
+        case HloOpcode::kAllToAll:
+          cost_dict = &result.all_to_all_cost_dict_;
+          break;
+        default:
+          VLOG(1) << "Skipping the profile of " << instr.opcode();
+          continue;
+      }
+      if (profile.network_throughput_bytes_per_sec() <= 0) {
+        continue;
+      }
+
+      std::vector<std::vector<int64_t>> replica_groups;
+      for (const ReplicaGroup& group :
+           CollectiveDeviceList::FromProto(instr).replica_groups()) {
+        replica_groups.emplace_back(group.replica_ids().begin(),
+                                    group.replica_ids().end());
+      }
+      if (replica_groups.empty() || replica_groups.front().empty()) {
+        continue;
+      }
+
+      // The throughput is measured over the size of the output of the
+      // collective, except for reduce-scatter, whose input is measured.
+      TF_ASSIGN_OR_RETURN(Shape shape, Shape::FromProto(instr.shape()));
+      int64_t num_bytes = ShapeUtil::ByteSizeOf(shape);
+      if (opcode == HloOpcode::kReduceScatter) {
+        num_bytes *= replica_groups.front().size();
+      }
+      double cost = static_cast<double>(num_bytes) /
+                    profile.network_throughput_bytes_per_sec();
+      AddCost(replica_groups, num_bytes / kBytesPerElement, cost, dtype,
+              *cost_dict);
+      result.enabled_ = true;
+    }
+  }
+  return result;
+}
+
+absl::StatusOr<ProfilingResult> ProfilingResult::FromCollectivePerfTableFile(
+    absl::string_view path) {
+  gpu::DeviceHloInstructionProfiles perf_table;
+  TF_RETURN_IF_ERROR(tsl::ReadTextOrBinaryProto(
+      tsl::Env::Default(), std::string(path), &perf_table));
+  return FromCollectivePerfTable(perf_table);
+}
+
+}  // namespace spmd
+}  // namespace xla
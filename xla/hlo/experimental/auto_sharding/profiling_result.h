@@ -16,12 +16,19 @@ limitations under the License.
 #ifndef XLA_HLO_EXPERIMENTAL_AUTO_SHARDING_PROFILING_RESULT_H_
 #define XLA_HLO_EXPERIMENTAL_AUTO_SHARDING_PROFILING_RESULT_H_
 
+#include <algorithm>
 #include <cstdint>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
+#include "absl/strings/string_view.h"
 #include "xla/hlo/experimental/auto_sharding/auto_sharding_strategy.h"
+#include "xla/service/gpu/model/hlo_op_profile.pb.h"
 
 namespace xla {
 namespace spmd {
@@ -29,62 +36,78 @@ namespace spmd {
 // Store the profiling results of communication and computation.
 class ProfilingResult {
  public:
-  // TODO (zhuohan): loading the profiling result.
-  ProfilingResult() {
-    if (all_reduce_cost_dict_.empty()) {
-      enabled_ = false;
-    } else {
-      enabled_ = true;
-    }
-  }
+  ProfilingResult() = default;
+
+  // Creates the profiling result from a perf table of collectives produced by
+  // xla/tools/collective_perf_table_gen, in which every entry is the measured
+  // throughput of a collective over some replica groups. Collectives over
+  // replica groups missing from the table are estimated from the entries over
+  // groups of the same pattern, e.g. the groups along the same mesh dimension
+  // of a mesh of another size.
+  static absl::StatusOr<ProfilingResult> FromCollectivePerfTable(
+      const gpu::DeviceHloInstructionProfiles& perf_table);
+
+  // Like above, but reads the perf table from a text or binary proto file.
+  static absl::StatusOr<ProfilingResult> FromCollectivePerfTableFile(
+      absl::string_view path);
 
   bool Enabled() const { return enabled_; }
 
-  double EstimateAllGatherCost(
+  // The estimates below return the cost in seconds of a collective over
+  // `replica_groups` moving `size` elements, or std::nullopt if there is no
+  // profile for such collectives.
+  std::optional<double> EstimateAllGatherCost(
       const std::vector<std::vector<int64_t>>& replica_groups, int64_t size,
       const std::string& dtype) const {
     if (all_gather_cost_dict_.empty()) {
       // Use all-reduce to approximate all-gather.
-      return EstimateAllReduceCost(replica_groups, size, dtype) / 2;
+      std::optional<double> cost =
+          EstimateAllReduceCost(replica_groups, size, dtype);
+      return cost.has_value() ? std::make_optional(*cost / 2) : std::nullopt;
     }
 
     return EstimateInternal(replica_groups, size, dtype,
-                            all_gather_cost_dict_) -
-           EstimateInternal(replica_groups, 0, dtype, all_gather_cost_dict_);
+                            all_gather_cost_dict_);
   }
 
-  double EstimateAllReduceCost(
+  std::optional<double> EstimateAllReduceCost(
       const std::vector<std::vector<int64_t>>& replica_groups, int64_t size,
       const std::string& dtype) const {
     return EstimateInternal(replica_groups, size, dtype,
-                            all_reduce_cost_dict_) -
-           EstimateInternal(replica_groups, 0, dtype, all_reduce_cost_dict_);
+                            all_reduce_cost_dict_);
   }
 
-  double EstimateReduceScatterCost(
+  std::optional<double> EstimateReduceScatterCost(
       const std::vector<std::vector<int64_t>>& replica_groups, int64_t size,
       const std::string& dtype) const {
     if (reduce_scatter_cost_dict_.empty()) {
       // Use all-reduce to approximate reduce-scatter.
-      return EstimateAllReduceCost(replica_groups, size, dtype) / 2;
+      std::optional<double> cost =
+          EstimateAllReduceCost(replica_groups, size, dtype);
+      return cost.has_value() ? std::make_optional(*cost / 2) : std::nullopt;
     }
 
     return EstimateInternal(replica_groups, size, dtype,
-                            reduce_scatter_cost_dict_) -
-           EstimateInternal(replica_groups, 0, dtype,
                             reduce_scatter_cost_dict_);
   }
 
-  double EstimateAllToAllCost(
+  std::optional<double> EstimateAllToAllCost(
       const std::vector<std::vector<int64_t>>& replica_groups, int64_t size,
       const std::string& dtype) const {
+    if (!all_to_all_cost_dict_.empty()) {
+      return EstimateInternal(replica_groups, size, dtype,
+                              all_to_all_cost_dict_);
+    }
+
     // A penalty factor to make the theoretical cost match the
     // empirical cost on v100 + nvlink.
     int64_t num_devices = replica_groups.front().size();
     double penalty_factor = static_cast<double>(num_devices) / 2.0;
     // Use all-gather to approximate all-to-all.
-    return EstimateAllGatherCost(replica_groups, size / num_devices, dtype) *
-           penalty_factor;
+    std::optional<double> cost =
+        EstimateAllGatherCost(replica_groups, size / num_devices, dtype);
+    return cost.has_value() ? std::make_optional(*cost * penalty_factor)
+                            : std::nullopt;
   }
 
   std::string ToString() {
@@ -101,14 +124,25 @@ class ProfilingResult {
   // vector<pair<size, time>>
   using Value = std::vector<std::pair<int64_t, double>>;
 
+  // Records that a collective over `replica_groups` moves `size` elements in
+  // `cost` seconds, both under the key of the groups and under the key of
+  // their pattern.
+  static void AddCost(const std::vector<std::vector<int64_t>>& replica_groups,
+                      int64_t size, double cost, const std::string& dtype,
+                      StableMap<Key, Value>& cost_dict);
+
   // Estimate the cost by linear interpolation between the two closest points.
-  double EstimateInternal(
+  std::optional<double> EstimateInternal(
       const std::vector<std::vector<int64_t>>& replica_groups, int64_t size,
       const std::string& dtype, const StableMap<Key, Value>& cost_dict) const {
-    Key key(Group2Str(replica_groups), dtype);
-    Value cost_list = cost_dict.at(key);
-
-    CHECK(!cost_list.empty());
+    auto it = cost_dict.find(Key(Group2Str(replica_groups), dtype));
+    if (it == cost_dict.end()) {
+      it = cost_dict.find(Key(GroupPattern2Str(replica_groups), dtype));
+    }
+    if (it == cost_dict.end() || it->second.size() < 2) {
+      return std::nullopt;
+    }
+    const Value& cost_list = it->second;
 
     size_t i;
     if (size > cost_list.back().first) {
@@ -128,14 +162,14 @@ class ProfilingResult {
     int64_t right_size = cost_list[i + 1].first;
     double right_cost = cost_list[i + 1].second;
 
-    return 1.0 * (size - left_size) / (right_size - left_size) *
-               (right_cost - left_cost) +
-           left_cost;
+    return std::max(0.0, 1.0 * (size - left_size) / (right_size - left_size) *
+                                 (right_cost - left_cost) +
+                             left_cost);
   }
 
   // Make a string key of a replica_groups.
-  std::string Group2Str(
-      const std::vector<std::vector<int64_t>>& replica_groups) const {
+  static std::string Group2Str(
+      const std::vector<std::vector<int64_t>>& replica_groups) {
     std::string str("(");
     for (const auto& group : replica_groups) {
       absl::StrAppend(&str, "(", absl::StrJoin(group, ","), ")");
@@ -145,10 +179,25 @@ class ProfilingResult {
     return str;
   }
 
-  bool enabled_;
+  // Make a string key of the pattern of replica_groups, i.e. the offsets of
+  // the devices of a group from its first device, which are the same for all
+  // the groups along a mesh dimension.
+  static std::string GroupPattern2Str(
+      const std::vector<std::vector<int64_t>>& replica_groups) {
+    const std::vector<int64_t>& group = replica_groups.front();
+    std::vector<int64_t> offsets;
+    offsets.reserve(group.size());
+    for (int64_t device : group) {
+      offsets.push_back(device - group.front());
+    }
+    return absl::StrCat("pattern(", absl::StrJoin(offsets, ","), ")");
+  }
+
+  bool enabled_ = false;
   StableMap<Key, Value> all_reduce_cost_dict_;
   StableMap<Key, Value> all_gather_cost_dict_;
   StableMap<Key, Value> reduce_scatter_cost_dict_;
+  StableMap<Key, Value> all_to_all_cost_dict_;
 };
 
 }  // namespace spmd
@@ -0,0 +1,104 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/hlo/experimental/auto_sharding/profiling_result.h"
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "absl/strings/string_view.h"
+#include "xla/service/gpu/model/hlo_op_profile.pb.h"
+#include "xla/service/hlo.pb.h"
+#include "xla/shape_util.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/xla_data.pb.h"
+
+namespace xla {
+namespace spmd {
+namespace {
+
+// Adds a profile of `opcode` over `replica_groups` producing `num_elements`
+// f32 elements at `bytes_per_sec`.
+void AddProfile(gpu::DeviceHloInstructionProfiles& perf_table,
+                absl::string_view opcode,
+                const std::vector<std::vector<int64_t>>& replica_groups,
+                int64_t num_elements, int64_t bytes_per_sec) {
+  gpu::HloInstructionProfile* profile =
+      (*perf_table.mutable_entries())["sm_90"].add_entries();
+  HloInstructionProto* instr = profile->mutable_instruction();
+  instr->set_opcode(opcode);
+  *instr->mutable_shape() =
+      ShapeUtil::MakeShape(F32, {num_elements}).ToProto();
+  for (const std::vector<int64_t>& group : replica_groups) {
+    instr->add_replica_groups()->mutable_replica_ids()->Add(group.begin(),
+                                                             group.end());
+  }
+  profile->set_network_throughput_bytes_per_sec(bytes_per_sec);
+}
+
+TEST(ProfilingResultTest, InterpolatesMeasuredCosts) {
+  gpu::DeviceHloInstructionProfiles perf_table;
+  // 4 KB take 1 us and 4 MB take 100 us.
+  AddProfile(perf_table, "all-reduce", {{0, 1}, {2, 3}}, 1024, 4096000000);
+  AddProfile(perf_table, "all-reduce", {{0, 1}, {2, 3}}, 1024 * 1024,
+             41943040000);
+  TF_ASSERT_OK_AND_ASSIGN(ProfilingResult result,
+                          ProfilingResult::FromCollectivePerfTable(perf_table));
+  ASSERT_TRUE(result.Enabled());
+
+  std::optional<double> cost =
+      result.EstimateAllReduceCost({{0, 1}, {2, 3}}, 1024, "float32");
+  ASSERT_TRUE(cost.has_value());
+  EXPECT_DOUBLE_EQ(*cost, 1e-6);
+  cost = result.EstimateAllReduceCost({{0, 1}, {2, 3}}, 1024 * 1024 / 2,
+                                      "float32");
+  ASSERT_TRUE(cost.has_value());
+  EXPECT_NEAR(*cost, 50.45e-6, 1e-8);
+}
+
+TEST(ProfilingResultTest, FallsBackToGroupsOfTheSamePattern) {
+  gpu::DeviceHloInstructionProfiles perf_table;
+  AddProfile(perf_table, "all-gather", {{0, 2}, {1, 3}}, 1024, 4096000000);
+  AddProfile(perf_table, "all-gather", {{0, 2}, {1, 3}}, 2048, 4096000000);
+  TF_ASSERT_OK_AND_ASSIGN(ProfilingResult result,
+                          ProfilingResult::FromCollectivePerfTable(perf_table));
+
+  // The groups along the minor dimension of a 4x2 mesh have the same pattern
+  // as the profiled groups of a 2x2 mesh.
+  std::optional<double> cost = result.EstimateAllGatherCost(
+      {{0, 2}, {1, 3}, {4, 6}, {5, 7}}, 1024, "float32");
+  ASSERT_TRUE(cost.has_value());
+  EXPECT_DOUBLE_EQ(*cost, 1e-6);
+  EXPECT_FALSE(
+      result.EstimateAllGatherCost({{0, 1}, {2, 3}}, 1024, "float32")
+          .has_value());
+  EXPECT_FALSE(
+      result.EstimateAllReduceCost({{0, 2}, {1, 3}}, 1024, "float32")
+          .has_value());
+}
+
+TEST(ProfilingResultTest, IsDisabledWithoutCollectives) {
+  gpu::DeviceHloInstructionProfiles perf_table;
+  AddProfile(perf_table, "add", {}, 1024, 4096000000);
+  TF_ASSERT_OK_AND_ASSIGN(ProfilingResult result,
+                          ProfilingResult::FromCollectivePerfTable(perf_table));
+  EXPECT_FALSE(result.Enabled());
+}
+
+}  // namespace
+}  // namespace spmd
+}  // namespace xla
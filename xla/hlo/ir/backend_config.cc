@@ -83,7 +83,7 @@ absl::Status BackendConfigWrapper::GetProto(
 
 BackendConfigWrapper& BackendConfigWrapper::operator=(
     BackendConfigWrapper&& other) {
-  std::unique_ptr<tsl::protobuf::Message> temp_proto;
+  std::shared_ptr<const tsl::protobuf::Message> temp_proto;
   std::string temp_string;
 
   // Do not hold two mutexes at the same time to avoid deadlocks.
@@ -101,12 +101,12 @@ BackendConfigWrapper& BackendConfigWrapper::operator=(
 }
 
 bool BackendConfigWrapper::operator==(const BackendConfigWrapper& other) const {
-  tsl::protobuf::Message* this_proto = nullptr;
+  std::shared_ptr<const tsl::protobuf::Message> this_proto;
 
   // Do not hold two mutexes at the same time to avoid deadlocks.
   {
     absl::MutexLock this_lock{&mutex_};
-    this_proto = proto_.get();
+    this_proto = proto_;
   }
 
   const std::string* other_raw_string = nullptr;
@@ -57,6 +57,10 @@ std::unique_ptr<tsl::protobuf::Message> CloneBackendConfigProto(
 //
 // All accesses are protected via a mutex because instances of this class are
 // accessed concurrently during auto tuning.
+//
+// As the proto is never modified once set, copies of a wrapper share it rather
+// than cloning it, which makes cloning instructions, computations and modules
+// cheaper.
 class BackendConfigWrapper {
  public:
   BackendConfigWrapper() = default;
@@ -66,7 +70,7 @@ class BackendConfigWrapper {
       : proto_(CloneBackendConfigProto(&proto)) {}
   BackendConfigWrapper(const BackendConfigWrapper& other) {
     absl::MutexLock other_lock{&other.mutex_};
-    proto_ = CloneBackendConfigProto(other.proto_.get());
+    proto_ = other.proto_;
     raw_string_ = other.raw_string_;
   }
 
@@ -108,7 +112,7 @@ class BackendConfigWrapper {
   // Unfortunately, all members have to be mutable, since either of them can be
   // the cached one.
   mutable absl::Mutex mutex_;
-  mutable std::unique_ptr<tsl::protobuf::Message> proto_
+  mutable std::shared_ptr<const tsl::protobuf::Message> proto_
       ABSL_GUARDED_BY(mutex_);
   mutable std::string raw_string_ ABSL_GUARDED_BY(mutex_);
 };
@@ -114,5 +114,27 @@ TEST(BackendConfigWrapperTest, ComparisonDoesNotDeadlock) {
   });
 }
 
+TEST(BackendConfigWrapperTest, CopyOutlivesReassignedSource) {
+  gpu::GpuBackendConfig proto;
+  TF_ASSERT_OK(BackendConfigWrapper(std::string{kRawString}).GetProto(&proto));
+  BackendConfigWrapper source(proto);
+  BackendConfigWrapper copy(source);
+  source = BackendConfigWrapper();
+
+  gpu::GpuBackendConfig copied_proto;
+  TF_EXPECT_OK(copy.GetProto(&copied_proto));
+  EXPECT_EQ(copied_proto.SerializeAsString(), proto.SerializeAsString());
+  EXPECT_EQ(copy.GetRawString(), kRawString);
+}
+
+TEST(BackendConfigWrapperTest, ConcurrentCopies) {
+  gpu::GpuBackendConfig proto;
+  TF_ASSERT_OK(BackendConfigWrapper(std::string{kRawString}).GetProto(&proto));
+  RunThreaded(proto, [](BackendConfigWrapper& source) {
+    BackendConfigWrapper copy(source);
+    EXPECT_EQ(copy.GetRawString(), kRawString);
+  });
+}
+
 }  // namespace
 }  // namespace xla
@@ -16,6 +16,7 @@ limitations under the License.
 #include "xla/hlo/ir/hlo_computation.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <iterator>
@@ -41,8 +42,10 @@ limitations under the License.
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_join.h"
 #include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/types/span.h"
 #include "xla/hlo/ir/dfs_hlo_visitor.h"
+#include "xla/hlo/ir/highway_hash_printer.h"
 #include "xla/hlo/ir/hlo_casting_utils.h"
 #include "xla/hlo/ir/hlo_clone_context.h"
 #include "xla/hlo/ir/hlo_input_output_alias_config.h"
@@ -292,6 +295,10 @@ static void DecrementCount(
 }
 
 void HloComputation::AddCallee(HloInstruction* caller, HloComputation* callee) {
+  // Callees may be shared with computations that are transformed concurrently
+  // by a computation-local pass, so serialize the caller bookkeeping.
+  absl::MutexLockMaybe lock(parent() != nullptr ? &parent()->mutation_mutex()
+                                                : nullptr);
   IncrementCount(callee_computations_, callee);
   IncrementCount(callee->caller_computations_, this);
 
@@ -319,6 +326,8 @@ void HloComputation::RemoveCallee(HloInstruction* caller,
                                   HloComputation* callee) {
   CHECK(caller);
   CHECK(callee);
+  absl::MutexLockMaybe lock(parent() != nullptr ? &parent()->mutation_mutex()
+                                                : nullptr);
   DecrementCount(callee_computations_, callee);
   DecrementCount(callee->caller_computations_, this);
 
@@ -366,6 +375,7 @@ HloInstruction* HloComputation::AddInstructionInternal(
     instruction->UniquifyId(parent());
   }
   instruction->set_parent(this);
+  ClearCachedFingerprint();
   HloInstruction* pinst = instruction.release();  // Take ownership
   HloInstructionInfo info;
   info.opcode_ = pinst->opcode();
@@ -709,6 +719,7 @@ absl::Status HloComputation::RemoveInstructionImpl(HloInstruction* instruction,
       << "instruction " << instruction->name()
       << " has control successors and cannot be removed";
 
+  ClearCachedFingerprint();
   HloInstructionInfo* info = &instructions_[instruction->index_in_parent_];
   DCHECK_EQ(info->inst(), instruction);
   to_be_deleted_.push_back(info->inst());  // Takes ownership
@@ -723,7 +734,7 @@ absl::Status HloComputation::RemoveInstructionImpl(HloInstruction* instruction,
   // waiting for the instruction to be deleted in Cleanup(). This greatly
   // reduces the peak heap memory during constant folding.
   if (auto constant = DynCast<HloConstantInstruction>(to_be_deleted_.back())) {
-    *constant->mutable_literal() = Literal();
+    constant->SetLiteral(Literal());
   }
   // TODO(jeff): should we set info->opcode to something?
   info->inst_ =
@@ -812,6 +823,7 @@ void HloComputation::set_root_instruction(HloInstruction* new_root_instruction,
   root_instruction_->MarkAsNonRoot();
   new_root_instruction->MarkAsRoot();
   root_instruction_ = new_root_instruction;
+  ClearCachedFingerprint();
 }
 
 void HloComputation::ComputeInstructionPostOrder(
@@ -1205,6 +1217,18 @@ absl::Cord HloComputation::ToCord(
   return std::move(printer).ToCord();
 }
 
+uint64_t HloComputation::fingerprint() const {
+  uint64_t fingerprint = cached_fingerprint_.load(std::memory_order_relaxed);
+  if (fingerprint == 0) {
+    HighwayHashPrinter printer;
+    Print(&printer, HloPrintOptions::ModuleFingerprint(),
+          MakeInstructionPostOrder());
+    fingerprint = printer.ToFingerprint();
+    cached_fingerprint_.store(fingerprint, std::memory_order_relaxed);
+  }
+  return fingerprint;
+}
+
 HloComputationProto HloComputation::ToProto() const {
   HloComputationProto proto;
   CHECK(unique_id_ != -1)
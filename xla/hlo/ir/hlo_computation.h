@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef XLA_HLO_IR_HLO_COMPUTATION_H_
 #define XLA_HLO_IR_HLO_COMPUTATION_H_
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -352,6 +353,7 @@ class HloComputation {
   // UniqufyName().
   void SetAndSanitizeName(absl::string_view name) {
     name_ = NameUniquer::GetSanitizedName(name);
+    ClearCachedFingerprint();
   }
 
   // Use the given NameUniquer to select a unique name for the computation based
@@ -398,6 +400,21 @@ class HloComputation {
       const HloPrintOptions& options,
       absl::Span<const HloInstruction* const> instruction_order) const;
 
+  // Returns a fingerprint of the computation printed in post order with
+  // HloPrintOptions::ModuleFingerprint(). It is computed on the first call and
+  // cached until the computation is mutated.
+  uint64_t fingerprint() const;
+
+  // Drops the cached fingerprint(). The HloComputation and HloInstruction
+  // methods that add or remove instructions, or change their operands, shape,
+  // sharding, frontend attributes, backend config, control dependencies or
+  // called computations do this themselves. Other in-place changes of
+  // instruction attributes must call it, unless they are made by a pass of an
+  // HloPassPipeline, which clears all fingerprints after a changing pass.
+  void ClearCachedFingerprint() {
+    cached_fingerprint_.store(0, std::memory_order_relaxed);
+  }
+
   // Returns a serialized representation of this computation.
   HloComputationProto ToProto() const;
 
@@ -1051,6 +1068,9 @@ class HloComputation {
 
   std::string name_;
 
+  // The cached fingerprint(), or 0 if it has to be recomputed.
+  mutable std::atomic<uint64_t> cached_fingerprint_ = 0;
+
   // Callers and callees of this computation.
   // * These include all computations that have a caller/callee relationship
   //   with this computation, even those that may not belong to a module. For
@@ -46,6 +46,7 @@ limitations under the License.
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_join.h"
 #include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/types/span.h"
 #include "xla/comparison_util.h"
 #include "xla/hlo/ir/backend_config.h"
@@ -219,6 +220,7 @@ void HloInstruction::AppendComputation(HloComputation* computation) {
   mutable_rare()->called_computations.push_back(computation);
   if (parent()) {
     parent()->AddCallee(this, computation);
+    parent()->ClearCachedFingerprint();
   }
 }
 
@@ -238,6 +240,7 @@ void HloInstruction::set_called_computation(int index,
     if (computation) {
       parent()->AddCallee(this, computation);
     }
+    parent()->ClearCachedFingerprint();
   }
 }
 
@@ -267,6 +270,7 @@ void HloInstruction::ClearCalledComputations() {
       }
     }
     mutable_rare()->called_computations.clear();
+    ClearParentFingerprint();
   }
 }
 
@@ -1358,7 +1362,7 @@ absl::StatusOr<std::unique_ptr<HloInstruction>> HloInstruction::CreateFromProto(
 
   TF_RET_CHECK(!proto.name().empty());
   instruction->SetAndSanitizeName(proto.name());
-  *instruction->metadata_ = proto.metadata();
+  instruction->set_metadata(proto.metadata());
   instruction->backend_config_ = BackendConfigWrapper(proto.backend_config());
 
   TF_RET_CHECK(proto.id() >= 0)
@@ -2241,7 +2245,7 @@ HloInstruction::CreateBroadcastSequence(
   if (ShapeUtil::IsScalar(operand->shape())) {
     auto broadcast =
         HloInstruction::CreateBroadcast(broadcast_shape, operand, {});
-    broadcast->set_metadata(operand->metadata());
+    broadcast->CopyMetadataFrom(operand);
     if (operand->has_sharding()) {
       broadcast->copy_sharding(operand);
     }
@@ -2268,7 +2272,7 @@ HloInstruction::CreateBroadcastSequence(
       ShapeUtil::MakeShape(operand->shape().element_type(),
                            reshaped_dimensions),
       operand));
-  reshaped_operand->set_metadata(operand->metadata());
+  reshaped_operand->CopyMetadataFrom(operand);
   if (operand->has_sharding()) {
     reshaped_operand->copy_sharding(operand);
   }
@@ -2277,7 +2281,7 @@ HloInstruction::CreateBroadcastSequence(
   // Broadcast 'reshape' up to the larger size.
   auto broadcast = HloInstruction::CreateBroadcast(
       broadcast_shape, reshaped_operand, broadcast_dimensions);
-  broadcast->set_metadata(operand->metadata());
+  broadcast->CopyMetadataFrom(operand);
   if (operand->has_sharding()) {
     broadcast->copy_sharding(operand);
   }
@@ -2346,6 +2350,12 @@ HloInstruction::CreateDynamicReshape(
                                                 fusion_computation, prefix);
 }
 
+void HloInstruction::ClearParentFingerprint() {
+  if (parent_ != nullptr) {
+    parent_->ClearCachedFingerprint();
+  }
+}
+
 void HloInstruction::set_single_sharding(const HloSharding& sharding) {
   CHECK(!sharding.IsTuple()) << sharding;
   if (shape().IsTuple()) {
@@ -2366,7 +2376,7 @@ void HloInstruction::SetupDerivedInstruction(
   } else if (!ShapeUtil::CompatibleKind(shape_, derived_instruction->shape())) {
     derived_instruction->clear_sharding();
   }
-  derived_instruction->set_metadata(*metadata_);
+  derived_instruction->CopyMetadataFrom(this);
   if (has_rare()) {
     derived_instruction->set_result_accuracy(result_accuracy());
     derived_instruction->set_frontend_attributes(frontend_attributes());
@@ -2962,6 +2972,7 @@ absl::Status HloInstruction::AddControlDependencyTo(
     TF_RET_CHECK(!absl::c_linear_search(
         instruction->rare()->control_predecessors, this));
     instruction->mutable_rare()->control_predecessors.push_back(this);
+    ClearParentFingerprint();
   }
   return absl::OkStatus();
 }
@@ -2969,6 +2980,7 @@ absl::Status HloInstruction::AddControlDependencyTo(
 absl::Status HloInstruction::RemoveControlDependencyTo(
     HloInstruction* instruction) {
   TF_RET_CHECK(instruction->parent() == parent());
+  ClearParentFingerprint();
   if (has_rare()) {
     TF_RETURN_IF_ERROR(EraseElementFromVector(
         &mutable_rare()->control_successors, instruction));
@@ -2993,6 +3005,7 @@ absl::Status HloInstruction::DropAllControlDeps() {
     Rare* r = mutable_rare();
     r->control_successors.clear();
     r->control_predecessors.clear();
+    ClearParentFingerprint();
   }
   return absl::OkStatus();
 }
@@ -3106,6 +3119,7 @@ void HloInstruction::AppendOperand(HloInstruction* operand) {
   }
   operands_.push_back(operand);
   operand->AddUser(this);
+  ClearParentFingerprint();
 }
 
 void HloInstruction::AppendOperands(
@@ -3137,6 +3151,7 @@ void HloInstruction::RemoveOperandsAtAscendingIndices(
   }
   CHECK_EQ(removed_count, ascending_indices.size());
   operands_.resize(operands_.size() - removed_count);
+  ClearParentFingerprint();
 }
 
 bool HloInstruction::HasConstantOperand() const {
@@ -3325,6 +3340,7 @@ absl::Status HloInstruction::ReplaceUseWithDifferentShape(
   std::replace(user->operands_.begin(), user->operands_.end(), this,
                new_producer);
   new_producer->AddUser(user);
+  user->ClearParentFingerprint();
   // Custom fusions may not be able to handle deduplicated operands.
   if (user->opcode() == HloOpcode::kFusion) {
     TF_RETURN_IF_ERROR(
@@ -3358,6 +3374,7 @@ absl::Status HloInstruction::ReplaceUseWithDifferentShape(
       << " to be equal to " << ToString();
   user->operands_[operand_number] = new_producer;
   new_producer->AddUser(user);
+  user->ClearParentFingerprint();
   return absl::OkStatus();
 }
 
@@ -3381,6 +3398,7 @@ absl::Status HloInstruction::ReplaceOperandWithDifferentShape(
   }
 
   operands_[operand_num] = new_operand;
+  ClearParentFingerprint();
 
   VLOG(3) << "Replacing operand " << operand_num << " of " << name() << " with "
           << new_operand->name() << ", was " << old_operand->name();
@@ -4362,7 +4380,9 @@ HloInstructionProto HloInstruction::ToProto() const {
     proto.add_control_predecessor_ids(control->unique_id_64_bits());
   }
 
-  *proto.mutable_metadata() = *metadata_;
+  if (metadata_ != nullptr) {
+    *proto.mutable_metadata() = *metadata_;
+  }
   proto.set_backend_config(backend_config_.GetRawString());
   if (opcode() != HloOpcode::kFusion) {
     for (const HloComputation* computation : called_computations()) {
@@ -5497,6 +5517,7 @@ void HloInstruction::UniquifyName(NameUniquer* name_uniquer) {
 }
 
 void HloInstruction::UniquifyName(HloModule* module) {
+  absl::MutexLock lock(&module->mutation_mutex());
   UniquifyName(&module->instruction_name_uniquer());
 }
 
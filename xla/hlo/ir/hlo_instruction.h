@@ -1207,7 +1207,10 @@ class HloInstruction {
   const Shape& shape() const;
 
   // Returns the (mutable) result shape of this instruction.
-  Shape* mutable_shape() { return &shape_; }
+  Shape* mutable_shape() {
+    ClearParentFingerprint();
+    return &shape_;
+  }
 
   // Returns the ith operand to this instruction.
   const HloInstruction* operand(int64_t i) const;
@@ -1663,6 +1666,7 @@ class HloInstruction {
   }
   void set_sharding(std::shared_ptr<const HloSharding> sharding) {
     sharding_ = std::move(sharding);
+    ClearParentFingerprint();
   }
   // Copies the sharding of another instruction, this is more efficient than
   // set_sharding(hlo->sharding()) because it avoids a deep copy and shares the
@@ -1677,7 +1681,10 @@ class HloInstruction {
     set_single_sharding(HloSharding::AssignDevice(device));
   }
   // Remove any sharding from this operator.
-  void clear_sharding() { sharding_ = nullptr; }
+  void clear_sharding() {
+    sharding_ = nullptr;
+    ClearParentFingerprint();
+  }
   // Return true if this operator has a sharding assigned.
   bool has_sharding() const { return sharding_ != nullptr; }
   // Checks whether the instruction has compatible sharding with the other
@@ -1859,10 +1866,14 @@ class HloInstruction {
 
   bool has_backend_config() const { return !backend_config_.empty(); }
 
-  void clear_backend_config() { backend_config_ = BackendConfigWrapper(); }
+  void clear_backend_config() {
+    backend_config_ = BackendConfigWrapper();
+    ClearParentFingerprint();
+  }
 
   void CopyBackendConfigFrom(const HloInstruction* other) {
     backend_config_ = BackendConfigWrapper(other->backend_config_);
+    ClearParentFingerprint();
   }
 
   // Replaces the frontend attributes with the provided argument.
@@ -1871,6 +1882,7 @@ class HloInstruction {
       return;
     }
     mutable_rare()->frontend_attributes = std::move(frontend_attributes);
+    ClearParentFingerprint();
   }
 
   // Adds attributes only if they not already present in the HloInstruction.
@@ -1879,6 +1891,7 @@ class HloInstruction {
     if (!frontend_attributes.map().empty()) {
       mutable_rare()->frontend_attributes.mutable_map()->insert(
           frontend_attributes.map().begin(), frontend_attributes.map().end());
+      ClearParentFingerprint();
     }
   }
 
@@ -1888,16 +1901,19 @@ class HloInstruction {
                               const std::string& value) {
     auto it =
         mutable_rare()->frontend_attributes.mutable_map()->insert({key, value});
+    ClearParentFingerprint();
     return it.second;
   }
 
   size_t erase_frontend_attribute(const std::string& key) {
+    ClearParentFingerprint();
     return mutable_rare()->frontend_attributes.mutable_map()->erase(key);
   }
 
   // Adds or overrides a single attribute in the HloInstruction.
   void set_frontend_attribute(absl::string_view key, absl::string_view value) {
     (*mutable_rare()->frontend_attributes.mutable_map())[key] = value;
+    ClearParentFingerprint();
   }
 
   bool has_frontend_attributes() const {
@@ -1997,6 +2013,7 @@ class HloInstruction {
 
   absl::Status set_backend_config(const tsl::protobuf::Message& proto) {
     backend_config_ = BackendConfigWrapper(proto);
+    ClearParentFingerprint();
     return absl::OkStatus();
   }
 
@@ -2007,6 +2024,7 @@ class HloInstruction {
   }
   void set_raw_backend_config_string(std::string config_str) {
     backend_config_ = BackendConfigWrapper(std::move(config_str));
+    ClearParentFingerprint();
   }
 
   bool is_default_config() const { return is_default_config_; }
@@ -2031,26 +2049,42 @@ class HloInstruction {
 
   // Sets the debug metadata for this instruction, excluding creation_pass_id,
   // which should never be copied anywhere.
-  void set_metadata(const OpMetadata& metadata) { *metadata_ = metadata; }
+  void set_metadata(const OpMetadata& metadata) {
+    if (&metadata == &OpMetadata::default_instance()) {
+      metadata_ = nullptr;
+    } else if (&metadata != metadata_.get()) {
+      metadata_ = std::make_shared<OpMetadata>(metadata);
+    }
+  }
+
+  // Makes this instruction share the debug metadata of `other`. Unlike
+  // set_metadata(other->metadata()) this does not copy the metadata, which
+  // keeps the many instructions derived from the same op cheap in very large
+  // modules.
+  void CopyMetadataFrom(const HloInstruction* other) {
+    metadata_ = other->metadata_;
+  }
 
   void set_size_of_generated_code_in_bytes(int64_t code_size_in_bytes) {
-    metadata_->set_size_of_generated_code_in_bytes(code_size_in_bytes);
+    mutable_metadata()->set_size_of_generated_code_in_bytes(code_size_in_bytes);
   }
   void set_size_of_memory_working_set_in_bytes(
       int64_t working_set_size_in_bytes) {
-    metadata_->set_size_of_memory_working_set_in_bytes(
+    mutable_metadata()->set_size_of_memory_working_set_in_bytes(
         working_set_size_in_bytes);
   }
   void set_metadata_op_name(const std::string& name) {
-    metadata_->set_op_name(name);
+    mutable_metadata()->set_op_name(name);
   }
   void set_metadata_deduplicated_name(std::string deduplicated_name) {
-    metadata_->set_deduplicated_name(std::move(deduplicated_name));
+    mutable_metadata()->set_deduplicated_name(std::move(deduplicated_name));
   }
   void set_metadata_scheduling_name(absl::string_view name) {
-    metadata_->set_scheduling_name(std::string(name));
+    mutable_metadata()->set_scheduling_name(std::string(name));
+  }
+  const OpMetadata& metadata() const {
+    return metadata_ == nullptr ? OpMetadata::default_instance() : *metadata_;
   }
-  const OpMetadata& metadata() const { return *metadata_; }
 
   // Get the computation containing this instruction.
   const HloComputation* parent() const { return parent_; }
@@ -2459,6 +2493,10 @@ class HloInstruction {
   // Set the computation containing this instruction.
   void set_parent(HloComputation* computation) { parent_ = computation; }
 
+  // Drops the cached fingerprint of the computation containing this
+  // instruction, if any. Called by the mutators of this instruction.
+  void ClearParentFingerprint();
+
   // Implementation for non-common logic of PrintExtraAttributes.
   virtual void PrintExtraAttributesImpl(AttributePrinter& printer,
                                         const HloPrintOptions& options) const {}
@@ -2562,6 +2600,17 @@ class HloInstruction {
     return rare_.get();
   }
 
+  // Lazily allocates the metadata, and copies it first if it is shared with
+  // other instructions.
+  OpMetadata* mutable_metadata() {
+    if (metadata_ == nullptr) {
+      metadata_ = std::make_shared<OpMetadata>();
+    } else if (metadata_.use_count() > 1) {
+      metadata_ = std::make_shared<OpMetadata>(*metadata_);
+    }
+    return metadata_.get();
+  }
+
   // Users holds the list of users of an HloInstruction, plus it provides a fast
   // way for checking for presence of a potential user.
   class Users {
@@ -2657,9 +2706,10 @@ class HloInstruction {
   // graph.
   std::shared_ptr<OriginalValue> original_value_ = nullptr;
 
-  // Metadata for debugging.  Allocate it on heap, so that it does not increase
-  // the memory footprint of HloInstruction.
-  std::unique_ptr<OpMetadata> metadata_ = std::make_unique<OpMetadata>();
+  // Metadata for debugging. Allocated lazily on the heap, so that it does not
+  // increase the memory footprint of instructions without metadata, and shared
+  // copy-on-write between instructions derived from each other.
+  std::shared_ptr<OpMetadata> metadata_;
 };
 
 // Explicit instantiations in hlo_instruction.cc.
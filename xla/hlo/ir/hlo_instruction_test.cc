@@ -23,10 +23,12 @@ limitations under the License.
 #include <gtest/gtest.h>
 #include "absl/algorithm/container.h"
 #include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_casting_utils.h"
 #include "xla/hlo/ir/hlo_instructions.h"
 #include "xla/hlo/ir/hlo_opcode.h"
 #include "xla/hlo/testlib/hlo_hardware_independent_test_base.h"
 #include "xla/hlo/transforms/simplifiers/hlo_dce.h"
+#include "xla/literal_util.h"
 #include "xla/service/hlo.pb.h"
 #include "xla/shape.h"
 #include "xla/shape_util.h"
@@ -50,6 +52,36 @@ TEST_F(HloInstructionTest, SetFrontendAttribute) {
   EXPECT_EQ(instr.get_frontend_attribute("key1").value(), "value2");
 }
 
+TEST_F(HloInstructionTest, SetConstantLiteralDoesNotTouchSharedLiteral) {
+  auto original = HloInstruction::CreateConstant(
+      LiteralUtil::CreateR1<int32_t>({1, 2, 3}));
+  std::unique_ptr<HloInstruction> clone = original->Clone();
+  auto* cloned_constant = Cast<HloConstantInstruction>(clone.get());
+  // Clones share the literal until one of them is modified.
+  EXPECT_EQ(&original->literal(), &cloned_constant->literal());
+
+  cloned_constant->SetLiteral(LiteralUtil::CreateR1<int32_t>({4, 5, 6}));
+  EXPECT_EQ(original->literal(), LiteralUtil::CreateR1<int32_t>({1, 2, 3}));
+  EXPECT_EQ(cloned_constant->literal(),
+            LiteralUtil::CreateR1<int32_t>({4, 5, 6}));
+}
+
+TEST_F(HloInstructionTest, ClonesShareMetadataUntilModified) {
+  auto original = HloInstruction::CreateParameter(
+      0, ShapeUtil::MakeShape(F32, {4}), "p");
+  EXPECT_EQ(&original->metadata(), &OpMetadata::default_instance());
+
+  OpMetadata metadata;
+  metadata.set_op_name("op");
+  original->set_metadata(metadata);
+  std::unique_ptr<HloInstruction> clone = original->Clone();
+  EXPECT_EQ(&original->metadata(), &clone->metadata());
+
+  clone->set_metadata_op_name("other_op");
+  EXPECT_EQ(original->metadata().op_name(), "op");
+  EXPECT_EQ(clone->metadata().op_name(), "other_op");
+}
+
 TEST_F(HloInstructionTest, AddFrontendAttribute) {
   HloConstantInstruction instr(ShapeUtil::MakeShape(U32, {3, 2}));
   EXPECT_TRUE(instr.add_frontend_attribute("key1", "value1"));
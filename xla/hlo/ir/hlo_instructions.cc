@@ -1763,8 +1763,7 @@ void HloConstantInstruction::RelayoutConstant(const Layout& new_layout,
             new_layout,
             ShapeUtil::GetSubshape(literal().shape(), shape_index).layout())) {
       // Only relayout literals if that's really necessary.
-      Literal new_literal = literal_->Relayout(new_layout, shape_index);
-      *mutable_literal() = std::move(new_literal);
+      SetLiteral(literal_->Relayout(new_layout, shape_index));
     }
     *mutable_array_subshape->mutable_layout() = new_layout;
   }
@@ -1312,6 +1312,11 @@ class HloConstantInstruction : public HloInstruction {
     }
     return literal_.get();
   }
+  // Replaces the literal associated with this instruction. Unlike writing
+  // through mutable_literal(), this never clones the shared instance.
+  void SetLiteral(Literal literal) {
+    literal_ = std::make_shared<Literal>(std::move(literal));
+  }
   // Returns whether there is literal associated with this instruction.
   bool HasLiteral() const { return static_cast<bool>(literal_); }
   // Returns a serialized representation of this instruction.
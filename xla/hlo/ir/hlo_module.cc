@@ -30,16 +30,16 @@ limitations under the License.
 #include "absl/algorithm/container.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
+#include "absl/functional/function_ref.h"
 #include "absl/status/status.h"
+#include "absl/status/statusor.h"
 #include "absl/strings/cord.h"
 #include "absl/strings/escaping.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
 #include "absl/types/span.h"
-#include "highwayhash/arch_specific.h"
-#include "highwayhash/hh_types.h"
-#include "highwayhash/highwayhash.h"
+#include "xla/hlo/ir/highway_hash_printer.h"
 #include "xla/hlo/ir/hlo_clone_context.h"
 #include "xla/hlo/ir/hlo_computation.h"
 #include "xla/hlo/ir/hlo_input_output_alias_config.h"
@@ -65,6 +65,7 @@ limitations under the License.
 #include "xla/tsl/platform/logging.h"
 #include "xla/tsl/platform/status.h"
 #include "xla/tsl/platform/statusor.h"
+#include "xla/tsl/platform/threadpool.h"
 #include "xla/util.h"
 #include "xla/xla.pb.h"
 #include "xla/xla_data.pb.h"
@@ -377,7 +378,8 @@ void HloModule::ReplaceComputations(
   computations_ = std::move(new_computations);
 }
 
-void HloModule::Print(Printer* printer, const HloPrintOptions& options) const {
+void HloModule::PrintHeader(Printer* printer,
+                            const HloPrintOptions& options) const {
   printer->Append("HloModule ");
   if (options.print_ids()) {
     // When print_ids() is false, exclude module's name because it includes and
@@ -439,6 +441,10 @@ void HloModule::Print(Printer* printer, const HloPrintOptions& options) const {
     AppendCat(printer, ", frontend_attributes=",
               FrontendAttributesToString(frontend_attributes_));
   }
+}
+
+void HloModule::Print(Printer* printer, const HloPrintOptions& options) const {
+  PrintHeader(printer, options);
   printer->Append("\n\n");
   // We use a DFS postorder traversal to ensure that computations are printed
   // more consistently run to run. Even thet non-dfs postorder is deterministic,
@@ -493,52 +499,22 @@ absl::Cord HloModule::ToCord(const HloPrintOptions& options) const {
   return std::move(printer).ToCord();
 }
 
-namespace {
-// Generated using openssl rand.
-static constexpr highwayhash::HHKey kDefaultKey = {
-    0x9e0433b546e065d2ull,
-    0x0e7ecad49e703760ull,
-    0x83d29f20dae229b0ull,
-    0x40c1ce3ff9d19a42ull,
-};
-
-// HighwayHashPrinter is a Printer that computes the fingerprint of the added
-// data using a HighwayHash hasher.
-class HighwayHashPrinter : public Printer {
- public:
-  HighwayHashPrinter() : hasher_(kDefaultKey) {}
-
-  void Append(const absl::AlphaNum& a) override {
-    hasher_.Append(a.data(), a.size());
-  }
-
-  void AppendInt64List(absl::Span<const int64_t> list,
-                       bool _ /*leading_comma*/) override {
-    // Instead of separators, prefix with the length. This is fine since
-    // there's no way for the caller to distinguish between the two.
-    const uint64_t num = list.size();
-    hasher_.Append(reinterpret_cast<const char*>(&num), sizeof(num));
-    hasher_.Append(reinterpret_cast<const char*>(list.data()),
-                   list.size() * sizeof(list[0]));
-  }
-
-  uint64_t ToFingerprint() {
-    highwayhash::HHResult64 result;
-    hasher_.Finalize(&result);
-    return result;
-  }
-
- private:
-  highwayhash::HighwayHashCatT<HH_TARGET_PREFERRED> hasher_;
-};
-}  // namespace
-
 uint64_t HloModule::ToFingerprint(const HloPrintOptions& options) const {
   HighwayHashPrinter printer;
   Print(&printer, options);
   return printer.ToFingerprint();
 }
 
+uint64_t HloModule::ToCachedFingerprint() const {
+  HighwayHashPrinter printer;
+  PrintHeader(&printer, HloPrintOptions::ModuleFingerprint());
+  for (const HloComputation* computation : MakeComputationSorted()) {
+    printer.Append(computation == entry_computation() ? "\nENTRY " : "\n");
+    printer.Append(computation->fingerprint());
+  }
+  return printer.ToFingerprint();
+}
+
 HloModuleProto HloModule::ToProto() const {
   HloModuleProto proto;
   proto.set_id(unique_id_);
@@ -649,11 +625,117 @@ absl::Status HloModule::CheckUniqueNamesAndIdsForComputationsAndInstructions()
   return absl::OkStatus();
 }
 
+namespace {
+
+// Creates the computations of `proto` on `thread_pool` and passes them to
+// `add_computation`, which adds them to `computation_map`.
+//
+// Creating a computation only reads the computations it calls, so it proceeds
+// in waves of the computations whose callees have all been created. Creating a
+// caller also updates its callees, e.g. their caller bookkeeping or execution
+// thread, so computations reaching a computation that is also reached by
+// another one of the same wave are created sequentially after the wave.
+absl::Status CreateComputationsInParallel(
+    const HloModuleProto& proto, bool prohibit_empty_literal,
+    const absl::flat_hash_map<int64_t, HloComputation*>& computation_map,
+    absl::FunctionRef<absl::Status(const HloComputationProto&,
+                                   std::unique_ptr<HloComputation>)>
+        add_computation,
+    tsl::thread::ThreadPool* thread_pool) {
+  absl::flat_hash_map<int64_t, absl::flat_hash_set<int64_t>> callee_ids;
+  for (const HloComputationProto& computation_proto : proto.computations()) {
+    absl::flat_hash_set<int64_t>& ids = callee_ids[computation_proto.id()];
+    for (const HloInstructionProto& instruction :
+         computation_proto.instructions()) {
+      ids.insert(instruction.called_computation_ids().begin(),
+                 instruction.called_computation_ids().end());
+    }
+  }
+  // Returns the computations transitively called by `id`.
+  auto reachable_ids = [&](int64_t id) {
+    absl::flat_hash_set<int64_t> reachable;
+    std::vector<int64_t> worklist = {id};
+    while (!worklist.empty()) {
+      auto it = callee_ids.find(worklist.back());
+      worklist.pop_back();
+      if (it == callee_ids.end()) {
+        continue;
+      }
+      for (int64_t callee_id : it->second) {
+        if (reachable.insert(callee_id).second) {
+          worklist.push_back(callee_id);
+        }
+      }
+    }
+    return reachable;
+  };
+
+  std::vector<const HloComputationProto*> pending;
+  for (const HloComputationProto& computation_proto : proto.computations()) {
+    pending.push_back(&computation_proto);
+  }
+  while (!pending.empty()) {
+    std::vector<const HloComputationProto*> parallel;
+    std::vector<const HloComputationProto*> sequential;
+    std::vector<const HloComputationProto*> blocked;
+    absl::flat_hash_set<int64_t> claimed_ids;
+    for (const HloComputationProto* computation_proto : pending) {
+      if (!absl::c_all_of(callee_ids[computation_proto->id()],
+                          [&](int64_t id) {
+                            return computation_map.contains(id);
+                          })) {
+        blocked.push_back(computation_proto);
+        continue;
+      }
+      absl::flat_hash_set<int64_t> reachable =
+          reachable_ids(computation_proto->id());
+      if (absl::c_none_of(reachable, [&](int64_t id) {
+            return claimed_ids.contains(id);
+          })) {
+        claimed_ids.insert(reachable.begin(), reachable.end());
+        parallel.push_back(computation_proto);
+      } else {
+        sequential.push_back(computation_proto);
+      }
+    }
+    TF_RET_CHECK(!parallel.empty())
+        << "Computations call computations that are not in the module";
+
+    std::vector<absl::StatusOr<std::unique_ptr<HloComputation>>> created(
+        parallel.size());
+    thread_pool->ParallelFor(
+        parallel.size(), /*cost_per_unit=*/1 << 20,
+        [&](int64_t begin, int64_t end) {
+          for (int64_t i = begin; i < end; ++i) {
+            created[i] = HloComputation::CreateFromProto(
+                *parallel[i], computation_map, prohibit_empty_literal);
+          }
+        });
+    for (int64_t i = 0; i < parallel.size(); ++i) {
+      TF_RETURN_IF_ERROR(created[i].status());
+      TF_RETURN_IF_ERROR(add_computation(*parallel[i], *std::move(created[i])));
+    }
+    for (const HloComputationProto* computation_proto : sequential) {
+      TF_ASSIGN_OR_RETURN(
+          std::unique_ptr<HloComputation> computation,
+          HloComputation::CreateFromProto(*computation_proto, computation_map,
+                                          prohibit_empty_literal));
+      TF_RETURN_IF_ERROR(
+          add_computation(*computation_proto, std::move(computation)));
+    }
+    pending = std::move(blocked);
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace
+
 /* static */
 absl::StatusOr<std::unique_ptr<HloModule>> HloModule::CreateFromProto(
     const HloModuleProto& proto, const HloModuleConfig& module_config,
     bool prohibit_empty_literal,
-    std::unique_ptr<CompilationEnvironments> comp_envs) {
+    std::unique_ptr<CompilationEnvironments> comp_envs,
+    tsl::thread::ThreadPool* thread_pool) {
   VLOG(2) << "CreateFromProto()";
   XLA_VLOG_LINES(3, proto.DebugString());
 
@@ -689,11 +771,9 @@ absl::StatusOr<std::unique_ptr<HloModule>> HloModule::CreateFromProto(
   absl::flat_hash_map<HloComputation*, int64_t> to_proto_id;
   std::vector<std::unique_ptr<HloComputation>> computations;
   HloComputation* entry = nullptr;
-  for (const HloComputationProto& computation_proto : proto.computations()) {
-    TF_ASSIGN_OR_RETURN(
-        std::unique_ptr<HloComputation> computation,
-        HloComputation::CreateFromProto(computation_proto, computation_map,
-                                        prohibit_empty_literal));
+  auto add_computation =
+      [&](const HloComputationProto& computation_proto,
+          std::unique_ptr<HloComputation> computation) -> absl::Status {
     CHECK_NE(computation.get(), nullptr);
     int64_t computation_id = computation_proto.id();
     TF_RET_CHECK(computation_id != -1);
@@ -704,6 +784,21 @@ absl::StatusOr<std::unique_ptr<HloModule>> HloModule::CreateFromProto(
       entry = computation.get();
     }
     computations.push_back(std::move(computation));
+    return absl::OkStatus();
+  };
+  if (thread_pool == nullptr || thread_pool->NumThreads() <= 1) {
+    for (const HloComputationProto& computation_proto : proto.computations()) {
+      TF_ASSIGN_OR_RETURN(
+          std::unique_ptr<HloComputation> computation,
+          HloComputation::CreateFromProto(computation_proto, computation_map,
+                                          prohibit_empty_literal));
+      TF_RETURN_IF_ERROR(
+          add_computation(computation_proto, std::move(computation)));
+    }
+  } else {
+    TF_RETURN_IF_ERROR(CreateComputationsInParallel(
+        proto, prohibit_empty_literal, computation_map, add_computation,
+        thread_pool));
   }
   TF_RET_CHECK(entry != nullptr);
 
@@ -1138,31 +1233,8 @@ std::vector<HloComputation*> HloModule::MakeComputationPostOrder(
 
 namespace {
 
-class FingerprintMap {
- public:
-  void Reserve(int capacity) { fingerprint_map_.reserve(capacity); }
-
-  uint64_t GetFingerprint(const HloComputation* computation) {
-    auto result = fingerprint_map_.try_emplace(computation, 0);
-    if (result.second) {
-      HighwayHashPrinter printer;
-      computation->Print(&printer, print_options_,
-                         computation->MakeInstructionPostOrder());
-      result.first->second = printer.ToFingerprint();
-    }
-    return result.first->second;
-  }
-
- private:
-  HloPrintOptions print_options_ = HloPrintOptions::ModuleFingerprint();
-  absl::flat_hash_map<const HloComputation*, uint64_t> fingerprint_map_;
-};
-
 void SortComputationsByContent(std::vector<HloComputation*>* computations) {
-  FingerprintMap fingerprint_map;
-  fingerprint_map.Reserve(computations->size());
-  auto cmp = [&fingerprint_map](const HloComputation* a,
-                                const HloComputation* b) {
+  auto cmp = [](const HloComputation* a, const HloComputation* b) {
     if (a->instruction_count() != b->instruction_count()) {
       return a->instruction_count() < b->instruction_count();
     }
@@ -1172,8 +1244,7 @@ void SortComputationsByContent(std::vector<HloComputation*>* computations) {
       return false;
     }
 
-    return fingerprint_map.GetFingerprint(a) <
-           fingerprint_map.GetFingerprint(b);
+    return a->fingerprint() < b->fingerprint();
   };
   absl::c_sort(*computations, cmp);
 }
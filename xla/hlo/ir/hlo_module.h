@@ -55,6 +55,7 @@ limitations under the License.
 #include "xla/status_macros.h"
 #include "xla/tsl/lib/gtl/iterator_range.h"
 #include "xla/tsl/platform/logging.h"
+#include "xla/tsl/platform/threadpool.h"
 #include "xla/xla.pb.h"
 
 namespace xla {
@@ -429,12 +430,20 @@ class HloModule {
   // Returns a stable fingerprint of the module using the given print options.
   uint64_t ToFingerprint(const HloPrintOptions& options) const;
 
-  // Convert an HloModule to or from a proto.
+  // Returns a fingerprint of the module built from the cached
+  // HloComputation::fingerprint() of its computations, so it only prints the
+  // computations mutated since the last call. Unlike ToFingerprint(), it does
+  // not depend on the schedule of the module, other than whether it has one.
+  uint64_t ToCachedFingerprint() const;
+
+  // Convert an HloModule to or from a proto. If `thread_pool` is given, the
+  // computations of the module are created from the proto concurrently.
   HloModuleProto ToProto() const;
   static absl::StatusOr<std::unique_ptr<HloModule>> CreateFromProto(
       const HloModuleProto& proto, const HloModuleConfig& module_config,
       bool prohibit_empty_literal = true,
-      std::unique_ptr<CompilationEnvironments> comp_envs = nullptr);
+      std::unique_ptr<CompilationEnvironments> comp_envs = nullptr,
+      tsl::thread::ThreadPool* thread_pool = nullptr);
 
   // Convert an HloModule to or from a proto that includes module configuration
   HloModuleProtoWithConfig ToProtoWithConfig() const;
@@ -476,11 +485,18 @@ class HloModule {
 
   // Assign a new unique dense id for an instruction
   int64_t NewUniqueInstructionId() {
+    absl::MutexLock lock(&mutation_mutex_);
     int64_t result = next_unique_id_;
     next_unique_id_++;
     return result;
   }
 
+  // Returns the mutex which serializes updates of module-level state
+  // (instruction name and id uniquing, caller bookkeeping of computations)
+  // made through instructions and computations of this module. It allows
+  // computation-local passes to run concurrently on different computations.
+  absl::Mutex& mutation_mutex() const { return mutation_mutex_; }
+
   // input_output_alias_config indicates the list of aliased buffers that are
   // expected from the module.
   HloInputOutputAliasConfig& input_output_alias_config() {
@@ -710,6 +726,10 @@ class HloModule {
  private:
   friend class HloComputation;
 
+  // Prints the first line of Print(), i.e. the module name and the
+  // module-level attributes.
+  void PrintHeader(Printer* printer, const HloPrintOptions& options) const;
+
   HloComputation* AddComputationInternal(
       std::unique_ptr<HloComputation> computation, bool is_entry,
       bool uniquify_identifiers, bool preserve_entry_layouts);
@@ -730,6 +750,9 @@ class HloModule {
   mutable std::mt19937_64 rng_{42};
   mutable absl::Mutex rng_mutex_;
 
+  // See mutation_mutex().
+  mutable absl::Mutex mutation_mutex_;
+
   // Unique name generator for computation and instruction names, which are
   // unique per module.
   NameUniquer computation_name_uniquer_{/*separator=*/"."};
@@ -30,7 +30,39 @@ limitations under the License.
 #include "xla/util.h"
 #include "tsl/platform/protobuf.h"
 
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
 namespace xla {
+namespace {
+
+// Resource usage of the whole process. Passes are attributed the difference
+// between the usage at their start and at their end.
+struct ProcessResourceUsage {
+  int64_t cpu_time_usec = 0;
+  int64_t peak_rss_bytes = 0;
+};
+
+ProcessResourceUsage GetProcessResourceUsage() {
+  ProcessResourceUsage usage;
+#ifndef _WIN32
+  struct rusage ru;
+  if (getrusage(RUSAGE_SELF, &ru) == 0) {
+    usage.cpu_time_usec =
+        (ru.ru_utime.tv_sec + ru.ru_stime.tv_sec) * 1000000 +
+        ru.ru_utime.tv_usec + ru.ru_stime.tv_usec;
+#ifdef __APPLE__
+    usage.peak_rss_bytes = ru.ru_maxrss;  // Already in bytes.
+#else
+    usage.peak_rss_bytes = ru.ru_maxrss * 1024;
+#endif
+  }
+#endif
+  return usage;
+}
+
+}  // namespace
 
 absl::StatusOr<HloPassMetadata*>
 HloModuleMetadata::GetCurrentHloPassMetadata() {
@@ -56,6 +88,11 @@ void HloModuleMetadata::RecordPassStart() {
   HloPassMetadata* pass_metadata = module_metadata_.add_pass_metadata();
   pass_metadata->set_pass_id(next_pass_id_++);
   pass_metadata->set_start_timestamp_usec(env_->NowMicros());
+  // While the pass is running the resource usage fields hold the usage at its
+  // start; RecordPassEnd replaces them with the deltas.
+  ProcessResourceUsage usage = GetProcessResourceUsage();
+  pass_metadata->set_cpu_time_usec(usage.cpu_time_usec);
+  pass_metadata->set_peak_rss_delta_bytes(usage.peak_rss_bytes);
   running_passes_.push_back(pass_metadata);
 }
 
@@ -63,6 +100,11 @@ absl::Status HloModuleMetadata::RecordPassEnd() {
   TF_ASSIGN_OR_RETURN(HloPassMetadata * pass_metadata,
                       GetCurrentHloPassMetadata());
   pass_metadata->set_end_timestamp_usec(env_->NowMicros());
+  ProcessResourceUsage usage = GetProcessResourceUsage();
+  pass_metadata->set_cpu_time_usec(usage.cpu_time_usec -
+                                   pass_metadata->cpu_time_usec());
+  pass_metadata->set_peak_rss_delta_bytes(
+      usage.peak_rss_bytes - pass_metadata->peak_rss_delta_bytes());
   running_passes_.pop_back();
   return absl::OkStatus();
 }
@@ -47,8 +47,9 @@ class HloModuleMetadata {
   // matched by a later call to RecordPassEnd.
   void RecordPassStart();
 
-  // Marks the currently running pass as finished. Returns NotFound if metadata
-  // for the currently running pass cannot be found.
+  // Marks the currently running pass as finished and records the wall time,
+  // CPU time and peak RSS growth of the process while it ran. Returns NotFound
+  // if metadata for the currently running pass cannot be found.
   absl::Status RecordPassEnd();
 
   const std::optional<HloModuleMetadataProto>& prepartitioning_metadata()
@@ -112,6 +113,18 @@ class HloModuleMetadata {
           pass_metadata->set_module_id(module_id);
         });
   }
+  absl::Status set_current_pass_instruction_count_before(int64_t count) {
+    return MutateCurrentHloPassMetadata(
+        [&count](HloPassMetadata* pass_metadata) {
+          pass_metadata->set_instruction_count_before(count);
+        });
+  }
+  absl::Status set_current_pass_instruction_count_after(int64_t count) {
+    return MutateCurrentHloPassMetadata(
+        [&count](HloPassMetadata* pass_metadata) {
+          pass_metadata->set_instruction_count_after(count);
+        });
+  }
   absl::Status add_current_pass_module_group_module_id(int64_t module_id) {
     return MutateCurrentHloPassMetadata(
         [&module_id](HloPassMetadata* pass_metadata) {
@@ -33,6 +33,7 @@ limitations under the License.
 #include "absl/base/optimization.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/container/inlined_vector.h"
+#include "absl/hash/hash.h"
 #include "absl/functional/function_ref.h"
 #include "absl/log/check.h"
 #include "absl/status/status.h"
@@ -43,6 +44,7 @@ limitations under the License.
 #include "xla/hlo/ir/hlo_op_metadata.h"
 #include "xla/overflow_util.h"
 #include "xla/printer.h"
+#include "xla/protobuf_util.h"
 #include "xla/shape.h"
 #include "xla/shape_tree.h"
 #include "xla/shape_util.h"
@@ -1190,4 +1192,42 @@ std::ostream& operator<<(std::ostream& out, const HloSharding& sharding) {
   return out;
 }
 
+namespace {
+
+bool HaveSameMetadata(const HloSharding& lhs, const HloSharding& rhs) {
+  if (!absl::c_equal(lhs.metadata(), rhs.metadata(),
+                     [](const OpMetadata& a, const OpMetadata& b) {
+                       return protobuf_util::HaveSameSerialization(a, b);
+                     })) {
+    return false;
+  }
+  if (lhs.IsTuple()) {
+    for (int64_t i = 0; i < lhs.tuple_elements().size(); ++i) {
+      if (!HaveSameMetadata(lhs.tuple_elements()[i],
+                            rhs.tuple_elements()[i])) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+size_t HloShardingInterner::Hash::operator()(
+    const std::shared_ptr<const HloSharding>& sharding) const {
+  return absl::HashOf(*sharding);
+}
+
+bool HloShardingInterner::Eq::operator()(
+    const std::shared_ptr<const HloSharding>& lhs,
+    const std::shared_ptr<const HloSharding>& rhs) const {
+  return lhs == rhs || (*lhs == *rhs && HaveSameMetadata(*lhs, *rhs));
+}
+
+std::shared_ptr<const HloSharding> HloShardingInterner::Intern(
+    std::shared_ptr<const HloSharding> sharding) {
+  return *shardings_.insert(std::move(sharding)).first;
+}
+
 }  // namespace xla
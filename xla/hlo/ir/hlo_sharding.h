@@ -19,6 +19,7 @@ limitations under the License.
 #ifndef XLA_HLO_IR_HLO_SHARDING_H_
 #define XLA_HLO_IR_HLO_SHARDING_H_
 
+#include <cstddef>
 #include <cstdint>
 #include <map>
 #include <memory>
@@ -30,6 +31,7 @@ limitations under the License.
 #include <vector>
 
 #include "absl/algorithm/container.h"
+#include "absl/container/flat_hash_set.h"
 #include "absl/functional/function_ref.h"
 #include "absl/log/check.h"
 #include "absl/types/span.h"
@@ -406,6 +408,9 @@ class HloSharding {
                            bool overwrite) const;
 
   bool operator==(const HloSharding& other) const {
+    if (this == &other) {
+      return true;
+    }
     return replicated_ == other.replicated_ && maximal_ == other.maximal_ &&
            manual_ == other.manual_ && unknown_ == other.unknown_ &&
            tile_assignment_ == other.tile_assignment_ &&
@@ -422,7 +427,7 @@ class HloSharding {
       return H::combine(std::move(h), sharding.tuple_elements_);
     }
     return H::combine(std::move(h), sharding.replicated_, sharding.manual_,
-                      sharding.unknown_, sharding.tile_assignment_.array(),
+                      sharding.unknown_, sharding.tile_assignment_,
                       sharding.replicate_on_last_tile_dim_,
                       sharding.shard_group_.ToString());
   }
@@ -721,6 +726,31 @@ class HloSharding {
 
 std::ostream& operator<<(std::ostream& out, const HloSharding& sharding);
 
+// Hash-conses shardings, so that the equal shardings of many instructions, e.g.
+// the ones inferred by sharding propagation, share the same storage. Unlike
+// HloSharding::operator==, shardings are only interned together if their
+// metadata are equal too.
+class HloShardingInterner {
+ public:
+  // Returns the interned sharding equal to `sharding`, which becomes the
+  // interned one if there is none yet.
+  std::shared_ptr<const HloSharding> Intern(
+      std::shared_ptr<const HloSharding> sharding);
+
+  int64_t size() const { return shardings_.size(); }
+
+ private:
+  struct Hash {
+    size_t operator()(const std::shared_ptr<const HloSharding>& sharding) const;
+  };
+  struct Eq {
+    bool operator()(const std::shared_ptr<const HloSharding>& lhs,
+                    const std::shared_ptr<const HloSharding>& rhs) const;
+  };
+
+  absl::flat_hash_set<std::shared_ptr<const HloSharding>, Hash, Eq> shardings_;
+};
+
 }  // namespace xla
 
 #endif  // XLA_HLO_IR_HLO_SHARDING_H_
@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "xla/hlo/ir/tile_assignment.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
 #include <memory>
@@ -429,12 +430,56 @@ TileAssignment& TileAssignment::operator=(TileAssignment&& other) {
 }
 
 bool TileAssignment::operator==(const TileAssignment& other) const {
+  if (this == &other) {
+    return true;
+  }
   if (iota_ && other.iota_) {
     return *iota_ == *other.iota_;
   }
+  if (dimensions() != other.dimensions()) {
+    return false;
+  }
+  // Copies of a tile assignment share the storage of its array.
+  const Array<int64_t>* materialized_array = MaybeMaterializedArray();
+  if (materialized_array != nullptr &&
+      materialized_array == other.MaybeMaterializedArray()) {
+    return true;
+  }
   return array() == other.array();
 }
 
+absl::InlinedVector<int64_t, TileAssignment::kNumHashedDevices>
+TileAssignment::HashedDevices() const {
+  const int64_t num_devices = num_elements();
+  const int64_t num_hashed_devices = std::min(num_devices, kNumHashedDevices);
+  absl::InlinedVector<int64_t, kNumHashedDevices> devices;
+  devices.reserve(num_hashed_devices);
+  absl::MutexLock lock(&mu_);
+  absl::InlinedVector<int64_t, 6> index(array_ ? array_->num_dimensions()
+                                               : iota_->ndims());
+  for (int64_t i = 0; i < num_hashed_devices; ++i) {
+    int64_t linear_index =
+        num_hashed_devices == 1
+            ? 0
+            : i * (num_devices - 1) / (num_hashed_devices - 1);
+    if (array_) {
+      devices.push_back(array_->data()[linear_index]);
+      continue;
+    }
+    for (int64_t dim = index.size() - 1; dim >= 0; --dim) {
+      index[dim] = linear_index % iota_->dim(dim);
+      linear_index /= iota_->dim(dim);
+    }
+    devices.push_back(iota_->value_at(index));
+  }
+  return devices;
+}
+
+const Array<int64_t>* TileAssignment::MaybeMaterializedArray() const {
+  absl::MutexLock lock(&mu_);
+  return array_;
+}
+
 int64_t TileAssignment::operator()(absl::Span<const int64_t> indexes) const {
   absl::MutexLock lock(&mu_);
   return array_ ? (*array_)(indexes) : iota_->value_at(indexes);
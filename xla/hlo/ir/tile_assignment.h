@@ -28,6 +28,7 @@ limitations under the License.
 
 #include "absl/algorithm/container.h"
 #include "absl/base/thread_annotations.h"
+#include "absl/container/inlined_vector.h"
 #include "absl/functional/function_ref.h"
 #include "absl/log/check.h"
 #include "absl/status/status.h"
@@ -262,15 +263,24 @@ class TileAssignment {
 
   template <typename H>
   friend H AbslHashValue(H h, const TileAssignment& tile) {
-    // TODO(b/281892190): Ideally hashing a TileAssignment should not force iota
-    // -> full array conversion, but a requirement is that they should have
-    // equivalence. Consider providing a faster hash function for iota tile
-    // assignment.
-    return H::combine(std::move(h), tile.array());
+    // Equal tile assignments may be held in different formats, so only the
+    // dimensions and a bounded sample of the devices are hashed, which are
+    // cheap to compute from both formats without materializing the full array
+    // of an iota tile assignment.
+    return H::combine(std::move(h), tile.dimensions(), tile.HashedDevices());
   }
 
  private:
   friend class HloSharding;
+  static constexpr int64_t kNumHashedDevices = 16;
+
+  // Returns up to kNumHashedDevices devices evenly spaced in the tile
+  // assignment, including the first and the last one.
+  absl::InlinedVector<int64_t, kNumHashedDevices> HashedDevices() const;
+
+  // Returns the full array if it is materialized, or nullptr otherwise.
+  const Array<int64_t>* MaybeMaterializedArray() const;
+
   // TODO(b/281892190): Consider changing int64_t to int32_t since it's unlikely
   // to have so many devices to overflow int32_t in practice.
   explicit TileAssignment(IotaTileAssignment iota,
@@ -18,6 +18,7 @@ limitations under the License.
 
 #include <cstddef>
 #include <cstdint>
+#include <string>
 #include <type_traits>
 
 #include "absl/container/flat_hash_set.h"
@@ -28,8 +29,10 @@ limitations under the License.
 #include "absl/strings/string_view.h"
 #include "xla/hlo/ir/hlo_module.h"
 #include "xla/hlo/ir/hlo_module_group.h"
+#include "xla/hlo/ir/hlo_module_metadata.h"
 #include "xla/hlo/pass/hlo_pass_interface.h"
 #include "xla/tsl/platform/errors.h"
+#include "xla/tsl/platform/status.h"
 #include "xla/tsl/platform/statusor.h"
 
 namespace xla {
@@ -119,8 +122,18 @@ class HloPassFix : public Pass {
           hashes.insert(hash);
         }
       }
+      // Passes of a pipeline record their own metadata, so only iterations of
+      // a single pass need to be recorded here.
+      const bool record_iteration = !Pass::IsPassPipeline();
+      if (record_iteration) {
+        RecordIterationStart(*module, run_state->iteration);
+      }
       TF_RETURN_IF_ERROR(
           RunOnChangedComputationsOnce(module, run_state, execution_threads));
+      if (record_iteration) {
+        TF_RETURN_IF_ERROR(RecordIterationEnd(
+            *module, !run_state->changed_this_iteration.empty()));
+      }
       VLOG(3) << Pass::name() << " iteration " << run_state->iteration
               << " changed_this_iteration: "
               << !run_state->changed_this_iteration.empty();
@@ -145,6 +158,30 @@ class HloPassFix : public Pass {
     return absl::OkStatus();
   }
 
+  // Records every iteration of the fixed point loop as a pass nested in the
+  // HloPassFix pass itself, so that the per-pass metadata shows how the time
+  // and memory of the loop are distributed across iterations.
+  void RecordIterationStart(HloModule& module, int64_t iteration) {
+    HloModuleMetadata* metadata = module.metadata();
+    metadata->RecordPassStart();
+    TF_CHECK_OK(metadata->set_current_pass_name("fixed-point-iteration"));
+    TF_CHECK_OK(metadata->set_current_pass_pipeline_name(
+        std::string(Pass::name())));
+    TF_CHECK_OK(metadata->set_current_pass_instruction_count_before(
+        module.instruction_count()));
+    TF_CHECK_OK(metadata->set_key_value_metric("iteration", iteration));
+  }
+
+  absl::Status RecordIterationEnd(HloModule& module, bool changed) {
+    HloModuleMetadata* metadata = module.metadata();
+    TF_RETURN_IF_ERROR(
+        metadata->set_current_pass_module_id(module.unique_id()));
+    TF_RETURN_IF_ERROR(metadata->set_current_pass_module_changed(changed));
+    TF_RETURN_IF_ERROR(metadata->set_current_pass_instruction_count_after(
+        module.instruction_count()));
+    return metadata->RecordPassEnd();
+  }
+
   absl::Status RunOnChangedComputationsOnce(
       HloModule* module, RunState* run_state,
       const absl::flat_hash_set<absl::string_view>& execution_threads) {
@@ -33,6 +33,7 @@ limitations under the License.
 #include "xla/hlo/testlib/hlo_hardware_independent_test_base.h"
 #include "xla/literal_util.h"
 #include "xla/service/hlo.pb.h"
+#include "xla/service/metrics.pb.h"
 #include "xla/service/pattern_matcher.h"
 #include "xla/shape_util.h"
 #include "xla/tsl/platform/errors.h"
@@ -137,6 +138,39 @@ TEST_F(HloPassFixTest, RunModuleToFixedPoint) {
   EXPECT_EQ(root->literal().GetFirstElement<int32_t>(), 0);
 }
 
+TEST_F(HloPassFixTest, RecordsMetadataForEveryIteration) {
+  constexpr absl::string_view kModule = R"(
+    HloModule Converges
+
+    ENTRY main {
+      ROOT c = s32[] constant(2)
+    }
+  )";
+
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<VerifiedHloModule> module,
+                          ParseAndReturnVerifiedModule(kModule));
+
+  HloPassFix<DecrementPositiveConstants> pass;
+  TF_ASSERT_OK(pass.Run(module.get()).status());
+
+  // Two iterations decrement the constant and a third one finds nothing to do.
+  const HloModuleMetadataProto& metadata = module->metadata().proto();
+  ASSERT_EQ(metadata.pass_metadata_size(), 3);
+  for (int i = 0; i < metadata.pass_metadata_size(); ++i) {
+    const HloPassMetadata& pass_metadata = metadata.pass_metadata(i);
+    EXPECT_EQ(pass_metadata.pass_name(), "fixed-point-iteration");
+    EXPECT_EQ(pass_metadata.pipeline_name(), "decrement-constants");
+    EXPECT_EQ(pass_metadata.module_changed(), i < 2);
+    EXPECT_EQ(pass_metadata.instruction_count_before(), 1);
+    EXPECT_EQ(pass_metadata.instruction_count_after(), 1);
+    EXPECT_GE(pass_metadata.cpu_time_usec(), 0);
+    EXPECT_GE(pass_metadata.peak_rss_delta_bytes(), 0);
+    ASSERT_EQ(pass_metadata.kv_metrics_size(), 1);
+    EXPECT_EQ(pass_metadata.kv_metrics(0).key(), "iteration");
+    EXPECT_EQ(pass_metadata.kv_metrics(0).value(), i);
+  }
+}
+
 TEST_F(HloPassFixTest, RunModuleGroupToFixedPoint) {
   constexpr absl::string_view kModule0 = R"(
     HloModule First
@@ -124,6 +124,10 @@ class HloPassInterface {
 
   virtual bool IsPassPipeline() const { return false; }
 
+  // Returns true if the pass derives from HloComputationPass, i.e. it may be
+  // run independently on each non-fusion computation of a module.
+  virtual bool IsComputationLocal() const { return false; }
+
   // If an HloPassMetadata has previously been created, it adds a (key, value)
   // pair metric if none was already set or updates the existing value.
   // If an HloPassMetadata doesn't exist, it simply returns.
@@ -167,6 +171,43 @@ class HloModulePass : public HloPassInterface {
   }
 };
 
+// Base class for passes which transform each non-fusion computation of a
+// module independently of the others. When an HloPassPipeline has a thread
+// pool (see HloPassPipeline::set_thread_pool), it may call RunOnComputation
+// concurrently for different computations of the same module.
+//
+// To make that safe, RunOnComputation must be thread-safe with respect to the
+// pass object itself, and must only read and mutate the computation it is
+// given. In particular it must not add or remove computations from the
+// module. It may add and remove instructions in `computation`: name and id
+// uniquing as well as caller bookkeeping of called computations are
+// synchronized by the parent module.
+class HloComputationPass : public HloModulePass {
+ public:
+  // Runs the pass on a single computation. Returns whether it modified the
+  // computation.
+  virtual absl::StatusOr<bool> RunOnComputation(
+      HloComputation* computation) = 0;
+
+  // Runs the pass sequentially on every non-fusion computation of the module
+  // with the specified execution threads.
+  using HloPassInterface::Run;
+  absl::StatusOr<bool> Run(HloModule* module,
+                           const absl::flat_hash_set<absl::string_view>&
+                               execution_threads) override {
+    bool changed = false;
+    for (HloComputation* computation :
+         module->MakeNonfusionComputations(execution_threads)) {
+      TF_ASSIGN_OR_RETURN(bool computation_changed,
+                          RunOnComputation(computation));
+      changed |= computation_changed;
+    }
+    return changed;
+  }
+
+  bool IsComputationLocal() const final { return true; }
+};
+
 // Base class for passes which are module-group scoped. These passes cannot run
 // on an HLO module.
 class HloModuleGroupPass : public HloPassInterface {
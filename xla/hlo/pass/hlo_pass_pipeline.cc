@@ -27,6 +27,9 @@ limitations under the License.
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_join.h"
 #include "absl/strings/string_view.h"
+#include "absl/synchronization/blocking_counter.h"
+#include "xla/hlo/ir/hlo_computation.h"
+#include "xla/hlo/ir/hlo_module.h"
 #include "xla/hlo/ir/hlo_module_group.h"
 #include "xla/hlo/pass/hlo_pass_interface.h"
 #include "xla/service/dump.h"
@@ -35,6 +38,7 @@ limitations under the License.
 #include "xla/tsl/platform/logging.h"
 #include "xla/tsl/platform/status.h"
 #include "xla/tsl/platform/statusor.h"
+#include "xla/tsl/platform/threadpool.h"
 #include "xla/util.h"
 #include "xla/xla.pb.h"
 #include "tsl/profiler/lib/scoped_annotation.h"
@@ -50,6 +54,8 @@ void RecordPassStartMetadata(HloModule& module, const std::string& pass_name,
   // An HloPassMetadata was just created so absl::Status should always be OK.
   TF_CHECK_OK(module.metadata()->set_current_pass_name(pass_name));
   TF_CHECK_OK(module.metadata()->set_current_pass_pipeline_name(pipeline_name));
+  TF_CHECK_OK(module.metadata()->set_current_pass_instruction_count_before(
+      module.instruction_count()));
 }
 
 void RecordPassStartMetadata(HloModuleGroup& module_group,
@@ -69,6 +75,9 @@ absl::Status AttemptRecordPassEndMetadata(HloModule& module,
       module.metadata()->set_current_pass_module_id(module.unique_id()));
   TF_RETURN_IF_ERROR(
       module.metadata()->set_current_pass_module_changed(module_changed));
+  TF_RETURN_IF_ERROR(
+      module.metadata()->set_current_pass_instruction_count_after(
+          module.instruction_count()));
   TF_RETURN_IF_ERROR(module.metadata()->RecordPassEnd());
   return absl::OkStatus();
 }
@@ -106,8 +115,60 @@ void RecordPassEndMetadata(HloModuleGroup& module_group,
   }
 }
 
+// Runs `pass` on every non-fusion computation of `module` with the specified
+// execution threads, sharding the computations across `thread_pool`. Returns
+// the first error in computation order, if any.
+absl::StatusOr<bool> RunOnComputationsInParallel(
+    HloComputationPass* pass, HloModule* module,
+    const absl::flat_hash_set<absl::string_view>& execution_threads,
+    tsl::thread::ThreadPool* thread_pool) {
+  std::vector<HloComputation*> computations =
+      module->MakeNonfusionComputations(execution_threads);
+  std::vector<absl::StatusOr<bool>> results(computations.size(), false);
+  {
+    absl::BlockingCounter counter(computations.size());
+    for (size_t i = 0; i < computations.size(); ++i) {
+      thread_pool->Schedule([&, i] {
+        results[i] = pass->RunOnComputation(computations[i]);
+        counter.DecrementCount();
+      });
+    }
+    counter.Wait();
+  }
+
+  bool changed = false;
+  for (absl::StatusOr<bool>& result : results) {
+    TF_RETURN_IF_ERROR(result.status());
+    changed |= *result;
+  }
+  return changed;
+}
+
 }  // namespace
 
+absl::StatusOr<bool> HloPassPipeline::RunHelper(
+    HloPassInterface* pass, HloModule* module,
+    const absl::flat_hash_set<absl::string_view>& execution_threads) {
+  bool changed;
+  if (thread_pool_ != nullptr && pass->IsComputationLocal()) {
+    TF_ASSIGN_OR_RETURN(
+        changed, RunOnComputationsInParallel(
+                     static_cast<HloComputationPass*>(pass), module,
+                     execution_threads, thread_pool_));
+  } else {
+    TF_ASSIGN_OR_RETURN(changed, pass->Run(module, execution_threads));
+  }
+  module->Cleanup();
+  if (changed) {
+    // Passes may change instruction attributes in place, which does not clear
+    // the cached fingerprints of the computations.
+    for (HloComputation* computation : module->computations()) {
+      computation->ClearCachedFingerprint();
+    }
+  }
+  return changed;
+}
+
 template <typename HloT>
 absl::Status HloPassPipeline::RunInvariantCheckers(
     HloT* hlo, absl::string_view after_pass_name,
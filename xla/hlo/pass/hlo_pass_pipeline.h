@@ -30,6 +30,7 @@ limitations under the License.
 #include "xla/hlo/ir/hlo_module.h"
 #include "xla/hlo/pass/hlo_pass_interface.h"
 #include "xla/service/compilation_stats.h"
+#include "xla/tsl/platform/threadpool.h"
 #include "xla/types.h"
 #include "xla/xla.pb.h"
 
@@ -98,6 +99,20 @@ class HloPassPipeline : public HloPassInterface {
 
   bool IsPassPipeline() const override { return true; }
 
+  // Sets the thread pool used to run computation-local passes (see
+  // HloComputationPass) concurrently on the non-fusion computations of a
+  // module. By default, or if `thread_pool` is nullptr, all passes run
+  // sequentially. Only applies to passes added directly to this pipeline, and
+  // not to module groups. The pipeline must not itself be run on a thread of
+  // `thread_pool`, as it blocks until all scheduled computations are done.
+  //
+  // Names and ids of instructions created by a pass running in parallel depend
+  // on the order in which computations are processed, so they are not
+  // deterministic across compilations.
+  void set_thread_pool(tsl::thread::ThreadPool* thread_pool) {
+    thread_pool_ = thread_pool;
+  }
+
   // Return size of passes_.
   int PassesSize() { return passes_.size(); }
   // Return reference to pass specified by index.
@@ -144,13 +159,9 @@ class HloPassPipeline : public HloPassInterface {
   // empty thread list means all `execution_threads` are considered. These
   // helpers enable templating of the core of the pipeline logic by providing
   // HloModule and HloModuleGroup specific methods with the same name.
-  static absl::StatusOr<bool> RunHelper(
+  absl::StatusOr<bool> RunHelper(
       HloPassInterface* pass, HloModule* module,
-      const absl::flat_hash_set<absl::string_view>& execution_threads) {
-    TF_ASSIGN_OR_RETURN(bool changed, pass->Run(module, execution_threads));
-    module->Cleanup();
-    return changed;
-  }
+      const absl::flat_hash_set<absl::string_view>& execution_threads);
   static absl::StatusOr<bool> RunHelper(
       HloPassInterface* pass, HloModuleGroup* module_group,
       const absl::flat_hash_set<absl::string_view>& execution_threads) {
@@ -165,6 +176,9 @@ class HloPassPipeline : public HloPassInterface {
   std::vector<std::unique_ptr<HloPassInterface>> invariant_checkers_;
   bool run_called_ = false;
 
+  // Runs computation-local passes concurrently if set. Not owned.
+  tsl::thread::ThreadPool* thread_pool_ = nullptr;
+
   CompilationStats* compilation_stats_;
   // Default stats instance for when one is not passed in the constructor.
   // Use via compilation_stats_, not directly.
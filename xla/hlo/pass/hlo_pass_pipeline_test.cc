@@ -16,6 +16,7 @@ limitations under the License.
 #include "xla/hlo/pass/hlo_pass_pipeline.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <utility>
@@ -26,19 +27,24 @@ limitations under the License.
 #include "absl/container/flat_hash_set.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/span.h"
 #include "xla/hlo/ir/hlo_computation.h"
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_module.h"
 #include "xla/hlo/ir/hlo_module_group.h"
+#include "xla/hlo/ir/hlo_opcode.h"
 #include "xla/hlo/parser/hlo_parser.h"
 #include "xla/hlo/pass/hlo_pass_interface.h"
 #include "xla/hlo/testlib/hlo_hardware_independent_test_base.h"
 #include "xla/hlo/testlib/test_helpers.h"
 #include "xla/service/hlo.pb.h"
 #include "xla/tsl/lib/core/status_test_util.h"
+#include "xla/tsl/platform/env.h"
 #include "xla/tsl/platform/statusor.h"
+#include "xla/tsl/platform/threadpool.h"
 #include "xla/util.h"
 
 namespace xla {
@@ -419,5 +425,63 @@ TEST_F(HloPassPipelineTest, SetHloModuleMetadata) {
   }
 }
 
+// A computation-local pass which negates the root of every computation that
+// has an array-shaped root.
+class NegateRootComputationPass : public HloComputationPass {
+  absl::string_view name() const override { return "negate-root"; }
+
+  absl::StatusOr<bool> RunOnComputation(HloComputation* computation) override {
+    HloInstruction* root = computation->root_instruction();
+    if (!root->shape().IsArray()) {
+      return false;
+    }
+    computation->set_root_instruction(computation->AddInstruction(
+        HloInstruction::CreateUnary(root->shape(), HloOpcode::kNegate, root)));
+    return true;
+  }
+};
+
+TEST_F(HloPassPipelineTest, ComputationPassOnThreadPool) {
+  constexpr int kNumComputations = 32;
+  std::string hlo_string = "HloModule m\n\n";
+  std::vector<std::string> operands;
+  for (int i = 0; i < kNumComputations; ++i) {
+    absl::StrAppend(&hlo_string, "c", i, " {\n  p = f32[8] parameter(0)\n",
+                    "  ROOT add = f32[8] add(p, p)\n}\n\n");
+    operands.push_back(absl::StrCat("call", i));
+  }
+  absl::StrAppend(&hlo_string, "ENTRY e {\n  p = f32[8] parameter(0)\n");
+  for (int i = 0; i < kNumComputations; ++i) {
+    absl::StrAppend(&hlo_string, "  call", i, " = f32[8] call(p), to_apply=c",
+                    i, "\n");
+  }
+  absl::StrAppend(&hlo_string, "  ROOT concat = f32[", 8 * kNumComputations,
+                  "] concatenate(", absl::StrJoin(operands, ", "),
+                  "), dimensions={0}\n}\n");
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<VerifiedHloModule> module,
+                          ParseAndReturnVerifiedModule(hlo_string));
+
+  tsl::thread::ThreadPool thread_pool(tsl::Env::Default(), TestName(), 4);
+  HloPassPipeline pipeline(TestName());
+  pipeline.set_thread_pool(&thread_pool);
+  pipeline.AddPass<NegateRootComputationPass>();
+  TF_ASSERT_OK_AND_ASSIGN(bool changed, pipeline.Run(module.get()));
+  EXPECT_TRUE(changed);
+
+  absl::flat_hash_set<std::string> names;
+  absl::flat_hash_set<int> ids;
+  int64_t instruction_count = 0;
+  for (HloComputation* computation : module->computations()) {
+    EXPECT_EQ(computation->root_instruction()->opcode(), HloOpcode::kNegate);
+    for (HloInstruction* instruction : computation->instructions()) {
+      names.insert(instruction->name());
+      ids.insert(instruction->unique_id());
+      ++instruction_count;
+    }
+  }
+  EXPECT_EQ(names.size(), instruction_count);
+  EXPECT_EQ(ids.size(), instruction_count);
+}
+
 }  // namespace
 }  // namespace xla
@@ -0,0 +1,154 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/hlo/transforms/collectives/while_loop_all_gather_code_motion.h"
+
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <vector>
+
+#include "absl/algorithm/container.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/log/log.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "xla/hlo/analysis/while_loop_analysis.h"
+#include "xla/hlo/ir/hlo_computation.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/hlo/transforms/simplifiers/hlo_dce.h"
+#include "xla/hlo/transforms/simplifiers/tuple_simplifier.h"
+#include "xla/map_util.h"
+#include "xla/service/hlo_creation_utils.h"
+#include "xla/service/while_util.h"
+#include "xla/shape_util.h"
+#include "xla/tsl/platform/errors.h"
+#include "xla/tsl/platform/statusor.h"
+
+namespace xla {
+namespace {
+
+// Returns the all-gathers in the body of `while_instr` whose operand is a loop
+// invariant element of the loop state.
+std::vector<HloInstruction*> FindInvariantAllGathers(
+    const HloInstruction* while_instr) {
+  std::vector<HloInstruction*> all_gathers;
+  for (HloInstruction* gte :
+       WhileUtil::GetInvariantGTEsForWhileBody(*while_instr->while_body())) {
+    for (HloInstruction* user : gte->users()) {
+      if (user->opcode() == HloOpcode::kAllGather &&
+          user->operand_count() == 1 && !user->HasSideEffect() &&
+          user->control_predecessors().empty() &&
+          user->control_successors().empty()) {
+        all_gathers.push_back(user);
+      }
+    }
+  }
+  return all_gathers;
+}
+
+// Hoists the loop invariant all-gathers out of `while_instr`, up to
+// `memory_limit_bytes` in total. Returns whether any was hoisted.
+absl::StatusOr<bool> HoistInvariantAllGathers(HloInstruction* while_instr,
+                                              int64_t memory_limit_bytes) {
+  if (!while_instr->shape().IsTuple()) {
+    return false;
+  }
+  std::optional<int64_t> trip_count =
+      ComputeWhileLoopTripCountUpperBound(while_instr);
+  if (trip_count.has_value() && *trip_count <= 1) {
+    return false;
+  }
+
+  HloComputation* computation = while_instr->parent();
+  HloInstruction* init = while_instr->mutable_operand(0);
+  std::vector<HloInstruction*> to_hoist;
+  std::vector<HloInstruction*> hoisted;
+  int64_t hoisted_bytes = 0;
+  for (HloInstruction* all_gather : FindInvariantAllGathers(while_instr)) {
+    const int64_t bytes = ShapeUtil::ByteSizeOf(all_gather->shape());
+    if (hoisted_bytes + bytes > memory_limit_bytes) {
+      VLOG(2) << "Not hoisting " << all_gather->name() << " out of "
+              << while_instr->name() << ", it exceeds the memory limit.";
+      continue;
+    }
+    hoisted_bytes += bytes;
+
+    const int64_t index = all_gather->operand(0)->tuple_index();
+    HloInstruction* operand;
+    if (init->opcode() == HloOpcode::kTuple) {
+      operand = init->mutable_operand(index);
+    } else {
+      TF_ASSIGN_OR_RETURN(operand, MakeGetTupleElementHlo(init, index));
+    }
+    to_hoist.push_back(all_gather);
+    hoisted.push_back(computation->AddInstruction(
+        all_gather->CloneWithNewOperands(all_gather->shape(), {operand})));
+  }
+  if (to_hoist.empty()) {
+    return false;
+  }
+
+  TF_ASSIGN_OR_RETURN(
+      WhileUtil::MakeInstructionsLiveInResult live_in_result,
+      WhileUtil::MakeInstructionsLiveIn(while_instr, hoisted));
+  HloComputation* new_while_body =
+      live_in_result.new_while_instr->while_body();
+  for (int64_t i = 0; i < to_hoist.size(); ++i) {
+    TF_RETURN_IF_ERROR(new_while_body->ReplaceInstruction(
+        FindOrDie(live_in_result.while_body_instruction_map, to_hoist[i]),
+        live_in_result.while_body_live_in_values[i]));
+  }
+  VLOG(1) << "Hoisted " << to_hoist.size() << " all-gathers ("
+          << hoisted_bytes << " bytes) out of "
+          << live_in_result.new_while_instr->name();
+  return true;
+}
+
+}  // namespace
+
+absl::StatusOr<bool> WhileLoopAllGatherCodeMotion::Run(
+    HloModule* module,
+    const absl::flat_hash_set<absl::string_view>& execution_threads) {
+  // Collecting the loops in computation post order visits inner loops first,
+  // so that what is hoisted out of them can be hoisted out of the outer ones.
+  std::vector<HloInstruction*> while_instrs;
+  for (HloComputation* computation :
+       module->MakeComputationPostOrder(execution_threads)) {
+    absl::c_copy_if(computation->instructions(),
+                    std::back_inserter(while_instrs),
+                    HloPredicateIsOp<HloOpcode::kWhile>);
+  }
+
+  bool changed = false;
+  for (HloInstruction* while_instr : while_instrs) {
+    TF_ASSIGN_OR_RETURN(
+        bool hoisted,
+        HoistInvariantAllGathers(while_instr, memory_limit_bytes_));
+    changed |= hoisted;
+  }
+
+  if (changed) {
+    // Remove the old loops and their bodies, which still contain the
+    // all-gathers with the same channel ids as the hoisted ones.
+    TF_RETURN_IF_ERROR(HloDCE().Run(module).status());
+    TF_RETURN_IF_ERROR(TupleSimplifier().Run(module).status());
+  }
+  return changed;
+}
+
+}  // namespace xla
@@ -0,0 +1,69 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_HLO_TRANSFORMS_COLLECTIVES_WHILE_LOOP_ALL_GATHER_CODE_MOTION_H_
+#define XLA_HLO_TRANSFORMS_COLLECTIVES_WHILE_LOOP_ALL_GATHER_CODE_MOTION_H_
+
+#include <cstdint>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/pass/hlo_pass_interface.h"
+
+namespace xla {
+
+// HLO pass that hoists all-gathers of loop invariant values out of while
+// loops, so that they run once instead of on every iteration. This is the
+// case of the weights in an FSDP decode loop, which are sharded across
+// devices and gathered again in every step although they never change.
+//
+// Pattern before this pass:
+// w = ...
+// while:
+//   w_full = all-gather(w)
+//   use(w_full)
+// Pattern after this pass:
+// w = ...
+// w_full = all-gather(w)
+// while:
+//   use(w_full)
+//
+// The gathered values stay live for the whole loop, so the total size of the
+// all-gathers hoisted out of one loop is bounded by `memory_limit_bytes`.
+// Loops are visited from the innermost, so nested loops are hoisted out of
+// as far as the operand stays invariant.
+class WhileLoopAllGatherCodeMotion : public HloModulePass {
+ public:
+  explicit WhileLoopAllGatherCodeMotion(int64_t memory_limit_bytes)
+      : memory_limit_bytes_(memory_limit_bytes) {}
+
+  static constexpr absl::string_view kName =
+      "while-loop-all-gather-code-motion";
+  absl::string_view name() const override { return kName; }
+
+  using HloPassInterface::Run;
+  absl::StatusOr<bool> Run(
+      HloModule* module,
+      const absl::flat_hash_set<absl::string_view>& execution_threads) override;
+
+ private:
+  const int64_t memory_limit_bytes_;
+};
+
+}  // namespace xla
+
+#endif  // XLA_HLO_TRANSFORMS_COLLECTIVES_WHILE_LOOP_ALL_GATHER_CODE_MOTION_H_
@@ -0,0 +1,150 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/hlo/transforms/collectives/while_loop_all_gather_code_motion.h"
+
+#include <cstdint>
+#include <memory>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/algorithm/container.h"
+#include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_computation.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/hlo/testlib/hlo_hardware_independent_test_base.h"
+#include "xla/hlo/utils/hlo_matchers.h"
+#include "xla/hlo/utils/hlo_query.h"
+#include "xla/tsl/platform/statusor.h"
+
+namespace xla {
+namespace {
+
+namespace op = xla::testing::opcode_matchers;
+
+class WhileLoopAllGatherCodeMotionTest
+    : public HloHardwareIndependentTestBase {
+ protected:
+  static int64_t CountAllGathers(const HloComputation* computation) {
+    return absl::c_count_if(computation->instructions(),
+                            HloPredicateIsOp<HloOpcode::kAllGather>);
+  }
+};
+
+constexpr absl::string_view kInvariantWeightsHlo = R"(
+HloModule module, replica_count=2
+
+body {
+  p = (s32[], f32[4,8], f32[8,8]) parameter(0)
+  i = s32[] get-tuple-element(p), index=0
+  one = s32[] constant(1)
+  next_i = s32[] add(i, one)
+  w = f32[4,8] get-tuple-element(p), index=1
+  x = f32[8,8] get-tuple-element(p), index=2
+  w_full = f32[8,8] all-gather(w), replica_groups={{0,1}}, dimensions={0}
+  next_x = f32[8,8] add(x, w_full)
+  ROOT t = (s32[], f32[4,8], f32[8,8]) tuple(next_i, w, next_x)
+}
+
+cond {
+  p = (s32[], f32[4,8], f32[8,8]) parameter(0)
+  i = s32[] get-tuple-element(p), index=0
+  n = s32[] constant(10)
+  ROOT lt = pred[] compare(i, n), direction=LT
+}
+
+ENTRY main {
+  w = f32[4,8] parameter(0)
+  x = f32[8,8] parameter(1)
+  zero = s32[] constant(0)
+  init = (s32[], f32[4,8], f32[8,8]) tuple(zero, w, x)
+  loop = (s32[], f32[4,8], f32[8,8]) while(init), condition=cond, body=body
+  ROOT out = f32[8,8] get-tuple-element(loop), index=2
+}
+)";
+
+TEST_F(WhileLoopAllGatherCodeMotionTest, HoistsAllGatherOfInvariantValue) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(kInvariantWeightsHlo));
+  TF_ASSERT_OK_AND_ASSIGN(
+      bool changed,
+      WhileLoopAllGatherCodeMotion(/*memory_limit_bytes=*/1 << 20)
+          .Run(module.get()));
+  EXPECT_TRUE(changed);
+
+  const HloInstruction* loop = hlo_query::FindInstruction(
+      module->entry_computation(), HloOpcode::kWhile);
+  ASSERT_NE(loop, nullptr);
+  EXPECT_EQ(CountAllGathers(loop->while_body()), 0);
+  EXPECT_EQ(CountAllGathers(module->entry_computation()), 1);
+  EXPECT_THAT(loop->while_body()->root_instruction(),
+              op::Tuple(op::Add(), op::GetTupleElement(),
+                        op::Add(op::GetTupleElement(), op::GetTupleElement()),
+                        op::GetTupleElement()));
+}
+
+TEST_F(WhileLoopAllGatherCodeMotionTest, RespectsMemoryLimit) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(kInvariantWeightsHlo));
+  // The gathered weights take 8 * 8 * 4 bytes.
+  TF_ASSERT_OK_AND_ASSIGN(
+      bool changed,
+      WhileLoopAllGatherCodeMotion(/*memory_limit_bytes=*/128)
+          .Run(module.get()));
+  EXPECT_FALSE(changed);
+}
+
+TEST_F(WhileLoopAllGatherCodeMotionTest, DoesNotHoistAllGatherOfVariant) {
+  constexpr absl::string_view kHlo = R"(
+HloModule module, replica_count=2
+
+body {
+  p = (s32[], f32[4,8]) parameter(0)
+  i = s32[] get-tuple-element(p), index=0
+  one = s32[] constant(1)
+  next_i = s32[] add(i, one)
+  w = f32[4,8] get-tuple-element(p), index=1
+  w_full = f32[8,8] all-gather(w), replica_groups={{0,1}}, dimensions={0}
+  next_w = f32[4,8] slice(w_full), slice={[0:4], [0:8]}
+  ROOT t = (s32[], f32[4,8]) tuple(next_i, next_w)
+}
+
+cond {
+  p = (s32[], f32[4,8]) parameter(0)
+  i = s32[] get-tuple-element(p), index=0
+  n = s32[] constant(10)
+  ROOT lt = pred[] compare(i, n), direction=LT
+}
+
+ENTRY main {
+  w = f32[4,8] parameter(0)
+  zero = s32[] constant(0)
+  init = (s32[], f32[4,8]) tuple(zero, w)
+  ROOT loop = (s32[], f32[4,8]) while(init), condition=cond, body=body
+}
+)";
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(kHlo));
+  TF_ASSERT_OK_AND_ASSIGN(
+      bool changed,
+      WhileLoopAllGatherCodeMotion(/*memory_limit_bytes=*/1 << 20)
+          .Run(module.get()));
+  EXPECT_FALSE(changed);
+}
+
+}  // namespace
+}  // namespace xla
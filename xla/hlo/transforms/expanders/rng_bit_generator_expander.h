@@ -16,6 +16,8 @@ limitations under the License.
 #ifndef XLA_HLO_TRANSFORMS_EXPANDERS_RNG_BIT_GENERATOR_EXPANDER_H_
 #define XLA_HLO_TRANSFORMS_EXPANDERS_RNG_BIT_GENERATOR_EXPANDER_H_
 
+#include <utility>
+
 #include "absl/container/flat_hash_map.h"
 #include "absl/log/check.h"
 #include "absl/status/statusor.h"
@@ -30,8 +32,12 @@ namespace xla {
 
 class RngBitGeneratorExpander : public OpExpanderPass {
  public:
-  explicit RngBitGeneratorExpander(RandomAlgorithm default_algorithm)
-      : default_algorithm_(default_algorithm) {
+  // If `extra_filter` is set, only the generators it returns true for are
+  // expanded, e.g. to keep the ones the backend implements natively.
+  explicit RngBitGeneratorExpander(RandomAlgorithm default_algorithm,
+                                   HloPredicate extra_filter = nullptr)
+      : OpExpanderPass(std::move(extra_filter)),
+        default_algorithm_(default_algorithm) {
     CHECK_NE(default_algorithm_, RandomAlgorithm::RNG_DEFAULT);
   }
 
@@ -0,0 +1,237 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/hlo/transforms/expanders/sparse_dot_expander.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "absl/algorithm/container.h"
+#include "absl/status/statusor.h"
+#include "absl/types/span.h"
+#include "xla/comparison_util.h"
+#include "xla/hlo/ir/hlo_casting_utils.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_instructions.h"
+#include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/primitive_util.h"
+#include "xla/service/hlo_creation_utils.h"
+#include "xla/shape.h"
+#include "xla/shape_util.h"
+#include "xla/tsl/platform/errors.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/util.h"
+#include "xla/xla_data.pb.h"
+
+namespace xla {
+namespace {
+
+// Each group of four dense values stores two of them, and the metadata holds
+// the two 2-bit positions of the stored values, lowest bits first.
+constexpr int64_t kValuesPerGroup = 2;
+constexpr int64_t kGroupSize = 4;
+constexpr int64_t kBitsPerGroup = 4;
+
+bool IsSupportedSparsity(const SparsityDescriptor& descriptor) {
+  return descriptor.type() == SPARSITY_STRUCTURED_N_M &&
+         descriptor.n() == kValuesPerGroup && descriptor.m() == kGroupSize;
+}
+
+// Returns `dims` with `dims[dim]` replaced by the two dimensions `major` and
+// `minor`.
+std::vector<int64_t> SplitDim(absl::Span<const int64_t> dims, int64_t dim,
+                              int64_t major, int64_t minor) {
+  std::vector<int64_t> result(dims.begin(), dims.end());
+  result[dim] = major;
+  result.insert(result.begin() + dim + 1, minor);
+  return result;
+}
+
+// Returns the dimensions of a rank `rank` array other than `dim`.
+std::vector<int64_t> AllDimsExcept(int64_t rank, int64_t dim) {
+  std::vector<int64_t> result;
+  for (int64_t i = 0; i < rank; ++i) {
+    if (i != dim) result.push_back(i);
+  }
+  return result;
+}
+
+absl::StatusOr<HloInstruction*> ShiftRightAndMask(HloInstruction* hlo,
+                                                  HloInstruction* shift,
+                                                  int64_t mask) {
+  TF_ASSIGN_OR_RETURN(
+      HloInstruction * shifted,
+      MakeBinaryHlo(HloOpcode::kShiftRightLogical, hlo, shift));
+  return MakeBinaryHlo(HloOpcode::kAnd, shifted,
+                       MakeScalarLike(shifted, mask));
+}
+
+// Decompresses the 2:4 sparse `values` along `sparse_dim` using `meta`, whose
+// dimensions are those of `values` without `batch_dims`.
+absl::StatusOr<HloInstruction*> Decompress(
+    HloInstruction* values, HloInstruction* meta, int64_t sparse_dim,
+    absl::Span<const int64_t> batch_dims) {
+  const Shape& shape = values->shape();
+  const int64_t rank = shape.dimensions().size();
+  const PrimitiveType meta_type = meta->shape().element_type();
+  const int64_t groups_per_meta =
+      primitive_util::BitWidth(meta_type) / kBitsPerGroup;
+  const int64_t values_per_meta = groups_per_meta * kValuesPerGroup;
+
+  // Pad the stored values so that every metadata element is fully used.
+  const int64_t size = shape.dimensions(sparse_dim);
+  const int64_t padded_size = RoundUpTo(size, values_per_meta);
+  if (padded_size != size) {
+    PaddingConfig padding_config = MakeNoPaddingConfig(rank);
+    padding_config.mutable_dimensions(sparse_dim)
+        ->set_edge_padding_high(padded_size - size);
+    TF_ASSIGN_OR_RETURN(values, MakePadHlo(values, MakeScalarLike(values, 0),
+                                           padding_config));
+  }
+  std::vector<int64_t> dims(shape.dimensions().begin(),
+                            shape.dimensions().end());
+  dims[sparse_dim] = padded_size;
+  const int64_t num_groups = padded_size / kValuesPerGroup;
+  std::vector<int64_t> group_dims = dims;
+  group_dims[sparse_dim] = num_groups;
+  const std::vector<int64_t> dense_group_dims =
+      SplitDim(dims, sparse_dim, num_groups, kGroupSize);
+  const std::vector<int64_t> broadcast_dims =
+      AllDimsExcept(rank + 1, sparse_dim + 1);
+
+  // The first and second stored value of every group.
+  TF_ASSIGN_OR_RETURN(
+      HloInstruction * pairs,
+      MakeReshapeHlo(SplitDim(dims, sparse_dim, num_groups, kValuesPerGroup),
+                     values));
+  std::array<HloInstruction*, kValuesPerGroup> stored_values;
+  for (int64_t i = 0; i < kValuesPerGroup; ++i) {
+    std::vector<int64_t> start(rank + 1, 0);
+    std::vector<int64_t> limit(pairs->shape().dimensions().begin(),
+                               pairs->shape().dimensions().end());
+    start[sparse_dim + 1] = i;
+    limit[sparse_dim + 1] = i + 1;
+    TF_ASSIGN_OR_RETURN(
+        HloInstruction * slice,
+        MakeSliceHlo(pairs, start, limit, std::vector<int64_t>(rank + 1, 1)));
+    TF_ASSIGN_OR_RETURN(slice, MakeReshapeHlo(group_dims, slice));
+    stored_values[i] =
+        MakeBroadcastHlo(slice, broadcast_dims, dense_group_dims);
+  }
+
+  // Extract the metadata nibble of every group.
+  std::vector<int64_t> meta_dims = dims;
+  meta_dims[sparse_dim] = padded_size / values_per_meta;
+  std::vector<int64_t> meta_broadcast_dims;
+  for (int64_t i = 0; i < rank; ++i) {
+    if (!absl::c_linear_search(batch_dims, i)) {
+      meta_broadcast_dims.push_back(i);
+    }
+  }
+  TF_RET_CHECK(ShapeUtil::SameDimensions(
+      meta->shape(),
+      ShapeUtil::FilterDimensions(
+          [&](int64_t dim) {
+            return absl::c_linear_search(meta_broadcast_dims, dim);
+          },
+          ShapeUtil::MakeShape(meta_type, meta_dims))))
+      << "Unexpected sparsity metadata shape " << meta->shape().ToString();
+  const Shape split_meta_shape = ShapeUtil::MakeShape(
+      meta_type, SplitDim(meta_dims, sparse_dim, meta_dims[sparse_dim],
+                          groups_per_meta));
+  std::vector<int64_t> split_meta_broadcast_dims;
+  for (int64_t dim : meta_broadcast_dims) {
+    split_meta_broadcast_dims.push_back(dim > sparse_dim ? dim + 1 : dim);
+  }
+  HloInstruction* split_meta =
+      MakeBroadcastHlo(meta, split_meta_broadcast_dims, split_meta_shape);
+  HloInstruction* group_index = MakeIotaHlo(
+      values->parent(), split_meta_shape, /*iota_dimension=*/sparse_dim + 1);
+  TF_ASSIGN_OR_RETURN(
+      HloInstruction * shift,
+      MakeBinaryHlo(HloOpcode::kMultiply, group_index,
+                    MakeScalarLike(group_index, kBitsPerGroup)));
+  TF_ASSIGN_OR_RETURN(
+      HloInstruction * nibbles,
+      ShiftRightAndMask(split_meta, shift, (1 << kBitsPerGroup) - 1));
+  TF_ASSIGN_OR_RETURN(nibbles, MakeReshapeHlo(group_dims, nibbles));
+
+  // Place the stored values at their positions and zeros everywhere else.
+  const Shape dense_group_shape =
+      ShapeUtil::MakeShape(meta_type, dense_group_dims);
+  HloInstruction* position = MakeIotaHlo(values->parent(), dense_group_shape,
+                                         /*iota_dimension=*/sparse_dim + 1);
+  HloInstruction* dense = MakeScalarLike(stored_values[0], 0);
+  constexpr int64_t kBitsPerPosition = kBitsPerGroup / kValuesPerGroup;
+  for (int64_t i = kValuesPerGroup - 1; i >= 0; --i) {
+    TF_ASSIGN_OR_RETURN(
+        HloInstruction * stored_position,
+        ShiftRightAndMask(nibbles,
+                          MakeScalarLike(nibbles, i * kBitsPerPosition),
+                          (1 << kBitsPerPosition) - 1));
+    stored_position =
+        MakeBroadcastHlo(stored_position, broadcast_dims, dense_group_shape);
+    TF_ASSIGN_OR_RETURN(HloInstruction * is_stored,
+                        MakeCompareHlo(ComparisonDirection::kEq, position,
+                                       stored_position));
+    TF_ASSIGN_OR_RETURN(dense,
+                        MakeSelectHlo(is_stored, stored_values[i], dense));
+  }
+
+  std::vector<int64_t> dense_dims = dims;
+  dense_dims[sparse_dim] = num_groups * kGroupSize;
+  TF_ASSIGN_OR_RETURN(dense, MakeReshapeHlo(dense_dims, dense));
+  if (padded_size != size) {
+    std::vector<int64_t> limit = dense_dims;
+    limit[sparse_dim] = size * kGroupSize / kValuesPerGroup;
+    TF_ASSIGN_OR_RETURN(dense,
+                        MakeSliceHlo(dense, std::vector<int64_t>(rank, 0),
+                                     limit, std::vector<int64_t>(rank, 1)));
+  }
+  return dense;
+}
+
+}  // namespace
+
+bool SparseDotExpander::InstructionMatchesPattern(HloInstruction* instruction) {
+  auto* dot = DynCast<HloDotInstruction>(instruction);
+  return dot != nullptr && dot->sparse_operands() > 0 &&
+         absl::c_all_of(dot->sparsity(), IsSupportedSparsity);
+}
+
+absl::StatusOr<HloInstruction*> SparseDotExpander::ExpandInstruction(
+    HloInstruction* instruction) {
+  auto* dot = Cast<HloDotInstruction>(instruction);
+  const DotDimensionNumbers& dnums = dot->dot_dimension_numbers();
+  std::array<HloInstruction*, 2> operands = {dot->mutable_operand(0),
+                                             dot->mutable_operand(1)};
+  for (int64_t i = 0; i < dot->sparse_operands(); ++i) {
+    const SparsityDescriptor& descriptor = dot->sparsity()[i];
+    const bool is_lhs = descriptor.index() == 0;
+    TF_ASSIGN_OR_RETURN(
+        operands[descriptor.index()],
+        Decompress(operands[descriptor.index()],
+                   dot->mutable_operand(HloDotInstruction::kOperands + i),
+                   descriptor.dimension(),
+                   is_lhs ? dnums.lhs_batch_dimensions()
+                          : dnums.rhs_batch_dimensions()));
+  }
+  return dot->AddInstruction(HloInstruction::CreateDot(
+      dot->shape(), operands[0], operands[1], dnums,
+      dot->precision_config()));
+}
+
+}  // namespace xla
@@ -0,0 +1,46 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_HLO_TRANSFORMS_EXPANDERS_SPARSE_DOT_EXPANDER_H_
+#define XLA_HLO_TRANSFORMS_EXPANDERS_SPARSE_DOT_EXPANDER_H_
+
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/transforms/expanders/op_expander_pass.h"
+
+namespace xla {
+
+// Expands dots with 2:4 structured sparse operands into dense dots.
+//
+// Every compressed operand is decompressed with elementwise HLO: each group
+// of two stored values is scattered to the two positions out of four that
+// its metadata nibble selects, and the other two positions are zero. The
+// decompression is regular HLO that constant folding removes for static
+// weights and that the backend fuses like any other operand producer.
+class SparseDotExpander : public OpExpanderPass {
+ public:
+  absl::string_view name() const override { return "sparse_dot_expander"; }
+
+ protected:
+  bool InstructionMatchesPattern(HloInstruction* instruction) override;
+
+  absl::StatusOr<HloInstruction*> ExpandInstruction(
+      HloInstruction* instruction) override;
+};
+
+}  // namespace xla
+
+#endif  // XLA_HLO_TRANSFORMS_EXPANDERS_SPARSE_DOT_EXPANDER_H_
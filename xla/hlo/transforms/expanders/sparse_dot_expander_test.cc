@@ -0,0 +1,134 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/hlo/transforms/expanders/sparse_dot_expander.h"
+
+#include <cstdint>
+#include <memory>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/strings/string_view.h"
+#include "xla/hlo/evaluator/hlo_evaluator.h"
+#include "xla/hlo/ir/hlo_casting_utils.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_instructions.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/testlib/hlo_hardware_independent_test_base.h"
+#include "xla/hlo/testlib/pattern_matcher_gmock.h"
+#include "xla/literal.h"
+#include "xla/literal_util.h"
+#include "xla/service/pattern_matcher.h"
+#include "xla/tsl/platform/statusor.h"
+
+namespace xla {
+namespace {
+
+namespace m = ::xla::match;
+
+using SparseDotExpanderTest = HloHardwareIndependentTestBase;
+
+TEST_F(SparseDotExpanderTest, DecompressesLhs) {
+  constexpr absl::string_view kHlo = R"(
+  HloModule module
+
+  ENTRY main {
+    lhs = f32[2,8] parameter(0)
+    rhs = f32[16,16] parameter(1)
+    meta = u16[2,1] parameter(2)
+    ROOT dot = f32[2,16] dot(lhs, rhs, meta), lhs_contracting_dims={1},
+        rhs_contracting_dims={0}, sparsity=L.1@2:4
+  })";
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(kHlo));
+  TF_ASSERT_OK_AND_ASSIGN(bool changed, SparseDotExpander().Run(module.get()));
+  EXPECT_TRUE(changed);
+  const HloInstruction* root = module->entry_computation()->root_instruction();
+  EXPECT_THAT(root, GmockMatch(m::Dot(m::Op().WithShape(F32, {2, 16}),
+                                      m::Parameter(1))));
+  EXPECT_EQ(Cast<HloDotInstruction>(root)->sparse_operands(), 0);
+
+  // Every metadata nibble holds the positions of the two stored values of a
+  // group of four, lowest bits first: row 0 uses (0,1), (1,3), (0,2) and
+  // (2,3), row 1 uses (0,3) everywhere.
+  Literal lhs = LiteralUtil::CreateR2<float>(
+      {{1, 2, 3, 4, 5, 6, 7, 8}, {9, 10, 11, 12, 13, 14, 15, 16}});
+  Literal rhs = LiteralUtil::MakeIdentityR2<float>(16);
+  Literal meta = LiteralUtil::CreateR2<uint16_t>({{0xE8D4}, {0xCCCC}});
+  TF_ASSERT_OK_AND_ASSIGN(
+      Literal result, HloEvaluator().Evaluate(*module, {&lhs, &rhs, &meta}));
+  EXPECT_EQ(result, LiteralUtil::CreateR2<float>(
+                        {{1, 2, 0, 0, 0, 3, 0, 4, 5, 0, 6, 0, 0, 0, 7, 8},
+                         {9, 0, 0, 10, 11, 0, 0, 12, 13, 0, 0, 14, 15, 0, 0,
+                          16}}));
+}
+
+TEST_F(SparseDotExpanderTest, DecompressesBatchedRhsWithPadding) {
+  constexpr absl::string_view kHlo = R"(
+  HloModule module
+
+  ENTRY main {
+    lhs = f32[2,3,4] parameter(0)
+    rhs = f32[2,2,5] parameter(1)
+    meta = u16[1,5] parameter(2)
+    ROOT dot = f32[2,3,5] dot(lhs, rhs, meta), lhs_batch_dims={0},
+        lhs_contracting_dims={2}, rhs_batch_dims={0},
+        rhs_contracting_dims={1}, sparsity=R.1@2:4
+  })";
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(kHlo));
+  TF_ASSERT_OK_AND_ASSIGN(bool changed, SparseDotExpander().Run(module.get()));
+  EXPECT_TRUE(changed);
+  EXPECT_THAT(module->entry_computation()->root_instruction(),
+              GmockMatch(m::Dot(m::Parameter(0),
+                                m::Slice().WithShape(F32, {2, 4, 5}))));
+
+  // A single group per column, storing positions (1,2) in both batches.
+  Literal lhs = LiteralUtil::CreateR3<float>(
+      {{{1, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 1, 0}},
+       {{0, 0, 0, 1}, {0, 1, 0, 0}, {1, 1, 1, 1}}});
+  Literal rhs = LiteralUtil::CreateR3<float>(
+      {{{1, 2, 3, 4, 5}, {6, 7, 8, 9, 10}},
+       {{11, 12, 13, 14, 15}, {16, 17, 18, 19, 20}}});
+  Literal meta = LiteralUtil::CreateR2<uint16_t>({{9, 9, 9, 9, 9}});
+  TF_ASSERT_OK_AND_ASSIGN(
+      Literal result, HloEvaluator().Evaluate(*module, {&lhs, &rhs, &meta}));
+  EXPECT_EQ(result, LiteralUtil::CreateR3<float>(
+                        {{{0, 0, 0, 0, 0},
+                          {1, 2, 3, 4, 5},
+                          {6, 7, 8, 9, 10}},
+                         {{0, 0, 0, 0, 0},
+                          {11, 12, 13, 14, 15},
+                          {27, 29, 31, 33, 35}}}));
+}
+
+TEST_F(SparseDotExpanderTest, KeepsDenseDots) {
+  constexpr absl::string_view kHlo = R"(
+  HloModule module
+
+  ENTRY main {
+    lhs = f32[2,16] parameter(0)
+    rhs = f32[16,16] parameter(1)
+    ROOT dot = f32[2,16] dot(lhs, rhs), lhs_contracting_dims={1},
+        rhs_contracting_dims={0}
+  })";
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(kHlo));
+  TF_ASSERT_OK_AND_ASSIGN(bool changed, SparseDotExpander().Run(module.get()));
+  EXPECT_FALSE(changed);
+}
+
+}  // namespace
+}  // namespace xla
@@ -0,0 +1,336 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ ==============================================================================*/
+
+#include "xla/hlo/transforms/host_offload_streaming.h"
+
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "absl/algorithm/container.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/log/log.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "xla/hlo/analysis/hlo_reachability.h"
+#include "xla/hlo/ir/hlo_computation.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/literal_util.h"
+#include "xla/service/hlo_creation_utils.h"
+#include "xla/service/memory_annotations.h"
+#include "xla/service/while_util.h"
+#include "xla/shape.h"
+#include "xla/tsl/platform/errors.h"
+#include "xla/tsl/platform/statusor.h"
+
+namespace xla {
+namespace {
+
+using memory_annotations::kMoveToDeviceCustomCallTarget;
+using memory_annotations::kMoveToHostCustomCallTarget;
+
+// The updates of a computation that are streamed by a single loop.
+struct StreamedUpdates {
+  // The dimensions of the updated states.
+  std::vector<int64_t> dimensions;
+  // The MoveToHost instructions storing the updated states.
+  std::vector<HloInstruction*> roots;
+  // The elementwise instructions computing the updated states, in post order.
+  std::vector<HloInstruction*> body;
+  // The operands of `body` computed outside of the loop.
+  std::vector<HloInstruction*> leaves;
+};
+
+bool HasDimensions(const HloInstruction* instr,
+                   absl::Span<const int64_t> dimensions) {
+  return instr->shape().IsArray() &&
+         absl::c_equal(instr->shape().dimensions(), dimensions);
+}
+
+// Returns true if `instr` can be computed chunk by chunk inside the loop.
+bool IsStreamable(const HloInstruction* instr,
+                  absl::Span<const int64_t> dimensions) {
+  return HasDimensions(instr, dimensions) && instr->IsElementwise() &&
+         instr->opcode() != HloOpcode::kConstant && !instr->HasSideEffect();
+}
+
+bool IsMoveToDevice(const HloInstruction* instr,
+                    absl::Span<const int64_t> dimensions) {
+  return instr->IsCustomCall(kMoveToDeviceCustomCallTarget) &&
+         HasDimensions(instr, dimensions);
+}
+
+bool IsScalarBroadcast(const HloInstruction* instr) {
+  return instr->opcode() == HloOpcode::kBroadcast &&
+         instr->operand(0)->shape().dimensions().empty();
+}
+
+// Finds the updates of `roots`, which all have the same dimensions. Returns
+// std::nullopt if there is nothing to stream.
+std::optional<StreamedUpdates> FindStreamedUpdates(
+    HloComputation* computation, absl::Span<HloInstruction* const> roots,
+    absl::Span<HloInstruction* const> post_order) {
+  StreamedUpdates updates;
+  absl::Span<const int64_t> dimensions =
+      roots.front()->operand(0)->shape().dimensions();
+  updates.dimensions.assign(dimensions.begin(), dimensions.end());
+
+  absl::flat_hash_set<HloInstruction*> body;
+  std::vector<HloInstruction*> worklist;
+  for (HloInstruction* root : roots) {
+    worklist.push_back(root->mutable_operand(0));
+  }
+  while (!worklist.empty()) {
+    HloInstruction* instr = worklist.back();
+    worklist.pop_back();
+    if (!IsStreamable(instr, dimensions) || !body.insert(instr).second) {
+      continue;
+    }
+    absl::c_copy(instr->operands(), std::back_inserter(worklist));
+  }
+
+  // Values used outside of the loop must be computed outside of it. Removing
+  // an instruction from the loop may make its operands used outside of it, so
+  // iterate until there is nothing left to remove.
+  absl::flat_hash_set<HloInstruction*> root_set(roots.begin(), roots.end());
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (HloInstruction* instr : post_order) {
+      if (body.contains(instr) &&
+          !absl::c_all_of(instr->users(), [&](HloInstruction* user) {
+            return body.contains(user) || root_set.contains(user);
+          })) {
+        body.erase(instr);
+        changed = true;
+      }
+    }
+  }
+
+  for (HloInstruction* root : roots) {
+    if (body.contains(root->operand(0))) {
+      updates.roots.push_back(root);
+    }
+  }
+  absl::flat_hash_set<HloInstruction*> leaves;
+  for (HloInstruction* instr : post_order) {
+    if (!body.contains(instr)) {
+      continue;
+    }
+    updates.body.push_back(instr);
+    for (HloInstruction* operand : instr->operands()) {
+      if (!body.contains(operand) && leaves.insert(operand).second) {
+        updates.leaves.push_back(operand);
+      }
+    }
+  }
+
+  // Only streaming states brought back from host memory saves memory.
+  if (updates.roots.empty() ||
+      !absl::c_any_of(updates.leaves, [&](const HloInstruction* leaf) {
+        return IsMoveToDevice(leaf, dimensions);
+      })) {
+    return std::nullopt;
+  }
+
+  // A leaf computed from an updated state would make the loop depend on
+  // itself.
+  std::unique_ptr<HloReachabilityMap> reachability =
+      HloReachabilityMap::Build(computation);
+  for (const HloInstruction* root : updates.roots) {
+    for (const HloInstruction* leaf : updates.leaves) {
+      if (reachability->IsReachable(root, leaf)) {
+        VLOG(2) << "Not streaming updates: " << leaf->name()
+                << " depends on the updated state " << root->name();
+        return std::nullopt;
+      }
+    }
+  }
+  return updates;
+}
+
+// Returns the smallest number of chunks that evenly divides `size` and is at
+// least `min_chunks`.
+std::optional<int64_t> NumChunks(int64_t size, int64_t min_chunks) {
+  for (int64_t num_chunks = min_chunks; num_chunks <= size; ++num_chunks) {
+    if (size % num_chunks == 0) {
+      return num_chunks;
+    }
+  }
+  return std::nullopt;
+}
+
+absl::Status StreamUpdates(HloComputation* computation,
+                           const StreamedUpdates& updates, int64_t num_chunks) {
+  int64_t rows = updates.dimensions.front() / num_chunks;
+  auto chunk_shape = [&](const HloInstruction* instr) {
+    Shape shape = instr->shape();
+    shape.set_dimensions(0, rows);
+    return shape;
+  };
+  std::vector<int64_t> chunk_dimensions = updates.dimensions;
+  chunk_dimensions.front() = rows;
+
+  // The loop state is made of the leaves, with the host buffers in place of
+  // the states moved to device and the scalars in place of their broadcasts,
+  // followed by the host buffers for the updated states.
+  int64_t num_leaves = updates.leaves.size();
+  WhileUtil::LoopStateTy init_values;
+  for (HloInstruction* leaf : updates.leaves) {
+    bool replaced_by_operand = IsMoveToDevice(leaf, updates.dimensions) ||
+                               IsScalarBroadcast(leaf);
+    init_values.push_back(replaced_by_operand ? leaf->mutable_operand(0)
+                                              : leaf);
+  }
+  for (HloInstruction* root : updates.roots) {
+    HloInstruction* zero = computation->AddInstruction(
+        HloInstruction::CreateConstant(
+            LiteralUtil::Zero(root->shape().element_type())));
+    init_values.push_back(MakeBroadcastHlo(zero, {}, root->shape()));
+  }
+
+  auto loop_body_generator = [&](HloInstruction* indvar,
+                                 const WhileUtil::LoopStateTy& state)
+      -> absl::StatusOr<WhileUtil::LoopStateTy> {
+    HloComputation* loop_body = indvar->parent();
+    TF_ASSIGN_OR_RETURN(
+        HloInstruction * offset,
+        MakeBinaryHlo(HloOpcode::kMultiply, indvar,
+                      MakeR0ConstantHlo<int32_t>(loop_body, rows)));
+    std::vector<HloInstruction*> start_indices(
+        updates.dimensions.size(), MakeR0ConstantHlo<int32_t>(loop_body, 0));
+    start_indices.front() = offset;
+
+    absl::flat_hash_map<const HloInstruction*, HloInstruction*> chunks;
+    for (int64_t i = 0; i < num_leaves; ++i) {
+      HloInstruction* leaf = updates.leaves[i];
+      if (IsScalarBroadcast(leaf)) {
+        chunks[leaf] = loop_body->AddInstruction(
+            leaf->CloneWithNewOperands(chunk_shape(leaf), {state[i]}));
+      } else if (leaf->shape().dimensions().empty()) {
+        chunks[leaf] = state[i];
+      } else {
+        TF_ASSIGN_OR_RETURN(
+            HloInstruction * slice,
+            MakeDynamicSliceHlo(state[i], start_indices, chunk_dimensions));
+        if (IsMoveToDevice(leaf, updates.dimensions)) {
+          slice = loop_body->AddInstruction(
+              leaf->CloneWithNewOperands(chunk_shape(leaf), {slice}));
+        }
+        chunks[leaf] = slice;
+      }
+    }
+    for (const HloInstruction* instr : updates.body) {
+      std::vector<HloInstruction*> operands;
+      for (const HloInstruction* operand : instr->operands()) {
+        operands.push_back(chunks.at(operand));
+      }
+      chunks[instr] = loop_body->AddInstruction(
+          instr->CloneWithNewOperands(chunk_shape(instr), operands));
+    }
+
+    WhileUtil::LoopStateTy next_state = state;
+    for (int64_t i = 0; i < updates.roots.size(); ++i) {
+      const HloInstruction* root = updates.roots[i];
+      HloInstruction* update = loop_body->AddInstruction(
+          root->CloneWithNewOperands(chunk_shape(root),
+                                     {chunks.at(root->operand(0))}));
+      TF_ASSIGN_OR_RETURN(next_state[num_leaves + i],
+                          MakeDynamicUpdateSliceHlo(state[num_leaves + i],
+                                                    update, start_indices));
+    }
+    return next_state;
+  };
+
+  TF_ASSIGN_OR_RETURN(
+      WhileUtil::LoopStateTy results,
+      WhileUtil::MakeCountedLoop(computation, num_chunks, init_values,
+                                 loop_body_generator,
+                                 updates.roots.front()->metadata()));
+  for (int64_t i = 0; i < updates.roots.size(); ++i) {
+    HloInstruction* root = updates.roots[i];
+    VLOG(2) << "Streaming " << root->name() << " in " << num_chunks
+            << " chunks";
+    TF_RETURN_IF_ERROR(root->ReplaceAllUsesWith(results[num_leaves + i]));
+    TF_RETURN_IF_ERROR(computation->RemoveInstructionAndUnusedOperands(root));
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace
+
+absl::StatusOr<bool> HostOffloadStreaming::Run(
+    HloModule* module,
+    const absl::flat_hash_set<absl::string_view>& execution_threads) {
+  if (num_chunks_ < 2) {
+    return false;
+  }
+
+  bool changed = false;
+  for (HloComputation* computation :
+       module->MakeNonfusionComputations(execution_threads)) {
+    // Group the updates by dimensions, so that updates reading the same states,
+    // e.g. the moments and the parameters of an optimizer, share a loop.
+    std::vector<HloInstruction*> post_order =
+        computation->MakeInstructionPostOrder();
+    std::vector<std::vector<HloInstruction*>> root_groups;
+    for (HloInstruction* instr : post_order) {
+      if (!instr->IsCustomCall(kMoveToHostCustomCallTarget) ||
+          !instr->operand(0)->shape().IsArray() ||
+          instr->operand(0)->shape().dimensions().empty()) {
+        continue;
+      }
+      absl::Span<const int64_t> dimensions =
+          instr->operand(0)->shape().dimensions();
+      auto group = absl::c_find_if(
+          root_groups, [&](const std::vector<HloInstruction*>& group) {
+            return HasDimensions(group.front()->operand(0), dimensions);
+          });
+      if (group == root_groups.end()) {
+        root_groups.push_back({instr});
+      } else {
+        group->push_back(instr);
+      }
+    }
+
+    for (const std::vector<HloInstruction*>& roots : root_groups) {
+      std::optional<int64_t> num_chunks =
+          NumChunks(roots.front()->operand(0)->shape().dimensions(0),
+                    num_chunks_);
+      if (!num_chunks.has_value()) {
+        continue;
+      }
+      std::optional<StreamedUpdates> updates =
+          FindStreamedUpdates(computation, roots, post_order);
+      if (!updates.has_value()) {
+        continue;
+      }
+      TF_RETURN_IF_ERROR(StreamUpdates(computation, *updates, *num_chunks));
+      // The loop invalidates the post order of the remaining groups.
+      post_order = computation->MakeInstructionPostOrder();
+      changed = true;
+    }
+  }
+  return changed;
+}
+
+}  // namespace xla
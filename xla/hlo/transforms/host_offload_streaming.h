@@ -0,0 +1,77 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ ==============================================================================*/
+
+#ifndef XLA_HLO_TRANSFORMS_HOST_OFFLOAD_STREAMING_H_
+#define XLA_HLO_TRANSFORMS_HOST_OFFLOAD_STREAMING_H_
+
+#include <cstdint>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/pass/hlo_pass_interface.h"
+
+namespace xla {
+
+// Streams elementwise updates of host offloaded tensors, e.g. optimizer states
+// kept in host memory, through device memory chunk by chunk.
+//
+// An update looks like this:
+//
+//   state = MoveToDevice(host_state)
+//   new_state = elementwise(state, gradient, broadcast(scalar), ...)
+//   new_host_state = MoveToHost(new_state)
+//
+// Without this pass the whole state is brought back to device memory, which
+// defeats the memory savings of offloading it. This pass rewrites all the
+// updates of a computation with the same dimensions into a single while loop
+// over chunks of the major-most dimension, which moves a chunk of every host
+// state to device, computes the update of the chunk and moves it back into a
+// host buffer with a dynamic-update-slice:
+//
+//   while (i < num_chunks) {
+//     state_chunk = MoveToDevice(dynamic-slice(host_state, i * rows))
+//     new_state_chunk = elementwise(state_chunk,
+//                                   dynamic-slice(gradient, i * rows), ...)
+//     new_host_state = dynamic-update-slice(new_host_state,
+//                                           MoveToHost(new_state_chunk),
+//                                           i * rows)
+//   }
+//
+// so that device memory only holds a few chunks at a time, and the transfers
+// of a chunk can overlap with the update of another one once the loop is
+// scheduled. The dynamic-slices and dynamic-update-slices are later moved to
+// host memory by HostOffloader, so this pass must run before it.
+class HostOffloadStreaming : public HloModulePass {
+ public:
+  // Updates are streamed in at least `num_chunks` chunks, the smallest number
+  // of chunks that evenly divides the major-most dimension.
+  explicit HostOffloadStreaming(int64_t num_chunks) : num_chunks_(num_chunks) {}
+
+  absl::string_view name() const override { return "host-offload-streaming"; }
+
+  using HloPassInterface::Run;
+  absl::StatusOr<bool> Run(
+      HloModule* module,
+      const absl::flat_hash_set<absl::string_view>& execution_threads) override;
+
+ private:
+  int64_t num_chunks_;
+};
+
+}  // namespace xla
+
+#endif  // XLA_HLO_TRANSFORMS_HOST_OFFLOAD_STREAMING_H_
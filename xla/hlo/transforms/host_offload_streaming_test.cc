@@ -0,0 +1,185 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/hlo/transforms/host_offload_streaming.h"
+
+#include <cstdint>
+#include <memory>
+
+#include <gtest/gtest.h>
+#include "absl/algorithm/container.h"
+#include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_computation.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/hlo/testlib/hlo_hardware_independent_test_base.h"
+#include "xla/service/memory_annotations.h"
+#include "xla/shape_util.h"
+#include "xla/tsl/lib/core/status_test_util.h"
+#include "xla/tsl/platform/statusor.h"
+
+namespace xla {
+namespace {
+
+using memory_annotations::kMoveToDeviceCustomCallTarget;
+using memory_annotations::kMoveToHostCustomCallTarget;
+
+class HostOffloadStreamingTest : public HloHardwareIndependentTestBase {
+ protected:
+  // Returns the number of `target` custom calls in `computation` moving arrays
+  // of `shape`.
+  static int64_t CountCustomCalls(const HloComputation* computation,
+                                  absl::string_view target,
+                                  absl::string_view shape) {
+    return absl::c_count_if(
+        computation->instructions(), [&](const HloInstruction* instr) {
+          return instr->IsCustomCall(target) &&
+                 ShapeUtil::HumanString(instr->shape()) == shape;
+        });
+  }
+
+  static int64_t CountWhileLoops(const HloModule* module) {
+    return absl::c_count_if(module->entry_computation()->instructions(),
+                            [](const HloInstruction* instr) {
+                              return instr->opcode() == HloOpcode::kWhile;
+                            });
+  }
+};
+
+TEST_F(HostOffloadStreamingTest, StreamsUpdateOfHostState) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(R"(
+HloModule m
+
+ENTRY main {
+  m_host = f32[64,128] parameter(0)
+  g = f32[64,128] parameter(1)
+  beta = f32[] parameter(2)
+  m = f32[64,128] custom-call(m_host), custom_call_target="MoveToDevice"
+  beta_b = f32[64,128] broadcast(beta), dimensions={}
+  scaled = f32[64,128] multiply(m, beta_b)
+  new_m = f32[64,128] add(scaled, g)
+  ROOT new_m_host = f32[64,128] custom-call(new_m),
+      custom_call_target="MoveToHost"
+})"));
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      bool changed, HostOffloadStreaming(/*num_chunks=*/4).Run(module.get()));
+  EXPECT_TRUE(changed);
+  TF_ASSERT_OK(verifier().Run(module.get()).status());
+
+  const HloComputation* entry = module->entry_computation();
+  ASSERT_EQ(entry->root_instruction()->opcode(), HloOpcode::kGetTupleElement);
+  const HloInstruction* loop = entry->root_instruction()->operand(0);
+  ASSERT_EQ(loop->opcode(), HloOpcode::kWhile);
+  EXPECT_EQ(CountCustomCalls(entry, kMoveToDeviceCustomCallTarget,
+                             "f32[64,128]"),
+            0);
+
+  // Every iteration moves a quarter of the state in and out of the device.
+  const HloComputation* body = loop->while_body();
+  EXPECT_EQ(
+      CountCustomCalls(body, kMoveToDeviceCustomCallTarget, "f32[16,128]"), 1);
+  EXPECT_EQ(CountCustomCalls(body, kMoveToHostCustomCallTarget, "f32[16,128]"),
+            1);
+  EXPECT_TRUE(absl::c_any_of(body->instructions(),
+                             [](const HloInstruction* instr) {
+                               return instr->opcode() ==
+                                      HloOpcode::kDynamicUpdateSlice;
+                             }));
+}
+
+TEST_F(HostOffloadStreamingTest, UpdatesReadingTheSameStatesShareALoop) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(R"(
+HloModule m
+
+ENTRY main {
+  p_host = f32[30,8] parameter(0)
+  m_host = f32[30,8] parameter(1)
+  g = f32[30,8] parameter(2)
+  p = f32[30,8] custom-call(p_host), custom_call_target="MoveToDevice"
+  m = f32[30,8] custom-call(m_host), custom_call_target="MoveToDevice"
+  new_m = f32[30,8] add(m, g)
+  new_p = f32[30,8] subtract(p, new_m)
+  new_m_host = f32[30,8] custom-call(new_m), custom_call_target="MoveToHost"
+  new_p_host = f32[30,8] custom-call(new_p), custom_call_target="MoveToHost"
+  ROOT t = (f32[30,8], f32[30,8]) tuple(new_p_host, new_m_host)
+})"));
+
+  // 30 rows are not divisible by 4, so the update is streamed in 5 chunks.
+  TF_ASSERT_OK_AND_ASSIGN(
+      bool changed, HostOffloadStreaming(/*num_chunks=*/4).Run(module.get()));
+  EXPECT_TRUE(changed);
+  TF_ASSERT_OK(verifier().Run(module.get()).status());
+  EXPECT_EQ(CountWhileLoops(module.get()), 1);
+
+  const HloInstruction* root = module->entry_computation()->root_instruction();
+  ASSERT_EQ(root->operand(0)->opcode(), HloOpcode::kGetTupleElement);
+  const HloComputation* body = root->operand(0)->operand(0)->while_body();
+  EXPECT_EQ(CountCustomCalls(body, kMoveToDeviceCustomCallTarget, "f32[6,8]"),
+            2);
+  EXPECT_EQ(CountCustomCalls(body, kMoveToHostCustomCallTarget, "f32[6,8]"),
+            2);
+}
+
+TEST_F(HostOffloadStreamingTest, DoesNotStreamUpdatesNeededOnDevice) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(R"(
+HloModule m
+
+add {
+  a = f32[] parameter(0)
+  b = f32[] parameter(1)
+  ROOT r = f32[] add(a, b)
+}
+
+ENTRY main {
+  m_host = f32[64,128] parameter(0)
+  g = f32[64,128] parameter(1)
+  m = f32[64,128] custom-call(m_host), custom_call_target="MoveToDevice"
+  new_m = f32[64,128] add(m, g)
+  new_m_host = f32[64,128] custom-call(new_m), custom_call_target="MoveToHost"
+  zero = f32[] constant(0)
+  norm = f32[] reduce(new_m, zero), dimensions={0,1}, to_apply=add
+  ROOT t = (f32[64,128], f32[]) tuple(new_m_host, norm)
+})"));
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      bool changed, HostOffloadStreaming(/*num_chunks=*/4).Run(module.get()));
+  EXPECT_FALSE(changed);
+}
+
+TEST_F(HostOffloadStreamingTest, DoesNotStreamDeviceStates) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(R"(
+HloModule m
+
+ENTRY main {
+  m = f32[64,128] parameter(0)
+  g = f32[64,128] parameter(1)
+  new_m = f32[64,128] add(m, g)
+  ROOT new_m_host = f32[64,128] custom-call(new_m),
+      custom_call_target="MoveToHost"
+})"));
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      bool changed, HostOffloadStreaming(/*num_chunks=*/4).Run(module.get()));
+  EXPECT_FALSE(changed);
+}
+
+}  // namespace
+}  // namespace xla
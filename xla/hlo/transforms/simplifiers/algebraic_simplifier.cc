@@ -584,6 +584,93 @@ bool AlgebraicSimplifierVisitor::Run(HloComputation* computation,
   return changed();
 }
 
+bool AlgebraicSimplifierVisitor::RunWithWorklist(HloComputation* computation,
+                                                 int64_t max_runs,
+                                                 int64_t& num_runs) {
+  track_worklist_ = true;
+  bool computation_changed = false;
+  num_runs = 0;
+  while (num_runs < max_runs) {
+    ResetState(computation);
+    worklist_.clear();
+    worklist_watermark_ = -1;
+    for (const HloInstruction* instruction : computation->instructions()) {
+      worklist_watermark_ =
+          std::max(worklist_watermark_, instruction->unique_id_64_bits());
+    }
+    TF_CHECK_OK(computation->Accept(this));
+    if (!changed()) {
+      break;
+    }
+    computation_changed = true;
+    ++num_runs;
+    while (num_runs < max_runs && RunWorklistRound(computation)) {
+      ++num_runs;
+    }
+  }
+  track_worklist_ = false;
+  worklist_.clear();
+  return computation_changed;
+}
+
+bool AlgebraicSimplifierVisitor::RunWorklistRound(
+    HloComputation* computation) {
+  std::vector<HloInstruction*> post_order =
+      computation->MakeInstructionPostOrder();
+  const int64_t watermark = worklist_watermark_;
+  for (HloInstruction* instruction : post_order) {
+    if (instruction->unique_id_64_bits() > watermark) {
+      AddToWorklist(instruction);
+      worklist_watermark_ =
+          std::max(worklist_watermark_, instruction->unique_id_64_bits());
+    }
+  }
+  absl::flat_hash_set<HloInstruction*> worklist = std::move(worklist_);
+  worklist_.clear();
+  MarkAsUnchanged();
+  for (HloInstruction* instruction : post_order) {
+    // Instructions removed earlier in this round stay allocated until the
+    // pass finishes, so it is safe to check whether they are dead.
+    if (!worklist.contains(instruction) || instruction->IsMarkedAsDead()) {
+      continue;
+    }
+    TF_CHECK_OK(Preprocess(instruction));
+    TF_CHECK_OK(instruction->Visit(this));
+    TF_CHECK_OK(Postprocess(instruction));
+  }
+  return changed();
+}
+
+void AlgebraicSimplifierVisitor::AddToWorklist(HloInstruction* hlo) {
+  worklist_.insert(hlo);
+  worklist_.insert(hlo->operands().begin(), hlo->operands().end());
+  worklist_.insert(hlo->users().begin(), hlo->users().end());
+}
+
+absl::Status AlgebraicSimplifierVisitor::Preprocess(HloInstruction* hlo) {
+  if (track_worklist_) {
+    changed_before_visit_ = changed();
+    MarkAsUnchanged();
+    visit_neighbors_.assign(hlo->operands().begin(), hlo->operands().end());
+    visit_neighbors_.insert(visit_neighbors_.end(), hlo->users().begin(),
+                            hlo->users().end());
+  }
+  return DfsHloRewriteVisitor::Preprocess(hlo);
+}
+
+absl::Status AlgebraicSimplifierVisitor::Postprocess(HloInstruction* hlo) {
+  if (track_worklist_) {
+    if (changed()) {
+      worklist_.insert(visit_neighbors_.begin(), visit_neighbors_.end());
+      if (!hlo->IsMarkedAsDead()) {
+        AddToWorklist(hlo);
+      }
+    }
+    MarkAsMaybeChanged(changed_before_visit_);
+  }
+  return DfsHloRewriteVisitor::Postprocess(hlo);
+}
+
 bool AlgebraicSimplifierVisitor::SameShape(const HloInstruction* lhs,
                                            const HloInstruction* rhs) const {
   return SameShape(lhs->shape(), rhs->shape());
@@ -9914,17 +10001,23 @@ absl::StatusOr<bool> AlgebraicSimplifier::Run(
   for (auto* comp : module->MakeNonfusionComputations(execution_threads)) {
     bool computation_changed_per_run = false;
     int64_t run_count = 0;
-    // Repeatedly run simplification on each computation until it is stable.
-    do {
-      computation_changed_per_run = false;
-      if (visitor.Run(comp, options_, this)) {
+    if (options_.run_to_fixed_point() && options_.use_worklist()) {
+      if (visitor.RunWithWorklist(comp, kAlgSimpRerunLimit, run_count)) {
         changed = true;
-        if (options_.run_to_fixed_point()) {
-          ++run_count;
-          computation_changed_per_run = true;
-        }
       }
-    } while (computation_changed_per_run && run_count < kAlgSimpRerunLimit);
+    } else {
+      // Repeatedly run simplification on each computation until it is stable.
+      do {
+        computation_changed_per_run = false;
+        if (visitor.Run(comp, options_, this)) {
+          changed = true;
+          if (options_.run_to_fixed_point()) {
+            ++run_count;
+            computation_changed_per_run = true;
+          }
+        }
+      } while (computation_changed_per_run && run_count < kAlgSimpRerunLimit);
+    }
     if (run_count >= kAlgSimpRerunLimit) {
       LOG(ERROR) << "Algebraic simplifier is likely stuck in a circular "
                     "simplification loop and ran for "
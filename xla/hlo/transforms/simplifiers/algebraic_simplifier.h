@@ -355,6 +355,14 @@ class AlgebraicSimplifierOptions {
 
   void set_run_to_fixed_point(bool value) { run_to_fixed_point_ = value; }
 
+  // If enabled (and run_to_fixed_point is set), reruns after the first
+  // traversal of a computation only revisit the instructions next to the ones
+  // that were rewritten, instead of the whole computation. A full traversal
+  // still confirms the fixed point before a computation is considered done.
+  bool use_worklist() const { return use_worklist_; }
+
+  void set_use_worklist(bool value) { use_worklist_ = value; }
+
  private:
   // Metadata struct can be used to store any metadata information encapsulated
   // with the AlgebraicSimplifierOptions that can be later used in an
@@ -412,6 +420,7 @@ class AlgebraicSimplifierOptions {
   };
   bool rewrite_reshape_transpose_as_slice_concatenate_{true};
   bool run_to_fixed_point_{true};
+  bool use_worklist_{false};
   Metadata metadata_;
 };
 
@@ -565,6 +574,18 @@ class AlgebraicSimplifierVisitor : public DfsHloRewriteVisitor {
            const AlgebraicSimplifierOptions& options,
            AlgebraicSimplifier* simplifier);
 
+  // Runs the visitor on a computation until it reaches a fixed point or
+  // `max_runs` runs changed it. After a full traversal, only instructions
+  // whose operands or users were rewritten are revisited, until a full
+  // traversal finds nothing left to simplify. Sets `num_runs` to the number of
+  // runs that changed the computation, and returns whether it changed.
+  bool RunWithWorklist(HloComputation* computation, int64_t max_runs,
+                       int64_t& num_runs);
+
+  absl::Status Preprocess(HloInstruction* hlo) override;
+
+  absl::Status Postprocess(HloInstruction* hlo) override;
+
   // Compute a function that maps from bitcasted dimensions to the resulting
   // ones. Returns the function as a vector if successful; std::optional
   // otherwise.
@@ -822,6 +843,14 @@ class AlgebraicSimplifierVisitor : public DfsHloRewriteVisitor {
   // Useful when we want to use the same visitor over multiple computations.
   void ResetState(HloComputation* computation);
 
+  // Visits the instructions in the worklist, plus the ones created since the
+  // last round and their operands and users, in post order. Returns whether
+  // any of them was rewritten.
+  bool RunWorklistRound(HloComputation* computation);
+
+  // Adds `hlo` and its operands and users to the worklist.
+  void AddToWorklist(HloInstruction* hlo);
+
   // For cases where the stride won't end up being used, we update the limit
   // and reset the stride to 1. Returns true if the stride is redundant (and the
   // slice instruction is replaced).
@@ -863,6 +892,20 @@ class AlgebraicSimplifierVisitor : public DfsHloRewriteVisitor {
   absl::flat_hash_map<PrimitiveType, HloComputation*> scalar_add_computations_;
 
   AlgebraicSimplifier* simplifier_ = nullptr;
+
+  // Whether rewrites are being recorded in `worklist_`, see RunWithWorklist.
+  bool track_worklist_ = false;
+  // Instructions to revisit in the next worklist round.
+  absl::flat_hash_set<HloInstruction*> worklist_;
+  // Largest unique id of an instruction that existed at the start of the
+  // current worklist round; instructions with larger ids were created since.
+  int64_t worklist_watermark_ = -1;
+  // Operands and users of the instruction being visited, captured before it
+  // is handled since a rewrite may detach them from it.
+  std::vector<HloInstruction*> visit_neighbors_;
+  // Whether the computation had changed before the current instruction was
+  // visited.
+  bool changed_before_visit_ = false;
 };
 
 }  // namespace xla
@@ -13049,5 +13049,42 @@ ENTRY main {
                                /*allow_mixed_precision=*/true));
 }
 
+TEST_F(AlgebraicSimplifierTest, WorklistReachesSameFixedPoint) {
+  const char* kModuleStr = R"(
+    HloModule m
+    test {
+      p0 = f32[8,16] parameter(0)
+      zero = f32[] constant(0)
+      bzero = f32[8,16] broadcast(zero), dimensions={}
+      add = f32[8,16] add(p0, bzero)
+      t0 = f32[16,8] transpose(add), dimensions={1,0}
+      t1 = f32[8,16] transpose(t0), dimensions={1,0}
+      neg0 = f32[8,16] negate(t1)
+      neg1 = f32[8,16] negate(neg0)
+      r0 = f32[1,8,16] reshape(neg1)
+      ROOT r1 = f32[8,16] reshape(r0)
+    }
+  )";
+  AlgebraicSimplifierOptions options = default_options_;
+  options.set_run_to_fixed_point(true);
+  TF_ASSERT_OK_AND_ASSIGN(auto expected,
+                          ParseAndReturnVerifiedModule(kModuleStr));
+  ASSERT_THAT(AlgebraicSimplifier(options).Run(expected.get()),
+              IsOkAndHolds(true));
+
+  options.set_use_worklist(true);
+  TF_ASSERT_OK_AND_ASSIGN(auto module,
+                          ParseAndReturnVerifiedModule(kModuleStr));
+  ASSERT_THAT(AlgebraicSimplifier(options).Run(module.get()),
+              IsOkAndHolds(true));
+  EXPECT_THAT(module->entry_computation()->root_instruction(),
+              GmockMatch(m::Parameter(0)));
+  EXPECT_EQ(module->entry_computation()->instruction_count(),
+            expected->entry_computation()->instruction_count());
+  // The fixed point is confirmed, so running again changes nothing.
+  EXPECT_THAT(AlgebraicSimplifier(options).Run(module.get()),
+              IsOkAndHolds(false));
+}
+
 }  // namespace
 }  // namespace xla
@@ -29,7 +29,9 @@ limitations under the License.
 #include "absl/log/check.h"
 #include "absl/log/log.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "xla/hlo/ir/hlo_casting_utils.h"
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_instructions.h"
@@ -463,10 +465,116 @@ absl::StatusOr<HloInstruction*> TryMergeOperand(HloInstruction* a,
   return TryMergeLHSWithRHSOperand(b, a);
 }
 
+// Returns a key that is equal for dots that can be stacked into one batched
+// dot: the shapes of the operands and the result, the dimension numbers and
+// the precision config all have to match.
+std::string BatchingKey(const HloInstruction* dot) {
+  return absl::StrCat(dot->operand(0)->shape().ToString(/*print_layout=*/true),
+                      ";", dot->operand(1)->shape().ToString(true), ";",
+                      dot->shape().ToString(true), ";",
+                      dot->dot_dimension_numbers().SerializeAsString(), ";",
+                      dot->precision_config().SerializeAsString());
+}
+
+// Stacks independent dots with equal keys (see `BatchingKey`) into a single
+// dot with a new major batch dimension. Example:
+//
+//   x = f32[2,4] dot(f32[2,3] a, f32[3,4] b),
+//     lhs_contracting_dims={1}, rhs_contracting_dims={0}
+//   y = f32[2,4] dot(f32[2,3] c, f32[3,4] d),
+//     lhs_contracting_dims={1}, rhs_contracting_dims={0}
+//
+// is rewritten to
+//
+//   lhs = f32[2,2,3] concat(reshape(a), reshape(c)), dimensions={0}
+//   rhs = f32[2,3,4] concat(reshape(b), reshape(d)), dimensions={0}
+//   z = f32[2,2,4] dot(lhs, rhs), lhs_batch_dims={0}, rhs_batch_dims={0},
+//     lhs_contracting_dims={2}, rhs_contracting_dims={1}
+//   x = f32[2,4] reshape(slice(z), slice={[0:1], [0:2], [0:4]})
+//   y = f32[2,4] reshape(slice(z), slice={[1:2], [0:2], [0:4]})
+//
+// Preconditions:
+//  - `dots` are at least two non-sparse dots with equal keys.
+//  - No dot in `dots` transitively depends on the value of another one.
+absl::StatusOr<HloInstruction*> BatchDots(
+    absl::Span<HloInstruction* const> dots) {
+  HloInstruction* first = dots.front();
+  const int64_t num_dots = dots.size();
+  VLOG(2) << "Batching " << num_dots << " independent dots like:\n"
+          << "\t" << first->ToString();
+
+  auto stack_operands = [&](int64_t operand_no) {
+    const Shape& shape = first->operand(operand_no)->shape();
+    const Shape part_shape = ShapeUtil::PrependMajorDimension(1, shape);
+    std::vector<HloInstruction*> parts;
+    parts.reserve(num_dots);
+    for (HloInstruction* dot : dots) {
+      parts.push_back(dot->AddInstruction(HloInstruction::CreateReshape(
+          part_shape, dot->mutable_operand(operand_no))));
+    }
+    return first->AddInstruction(HloInstruction::CreateConcatenate(
+        ShapeUtil::PrependMajorDimension(num_dots, shape), parts,
+        /*dimension=*/0));
+  };
+  HloInstruction* lhs = stack_operands(0);
+  HloInstruction* rhs = stack_operands(1);
+
+  auto shifted = [](absl::Span<const int64_t> dims) {
+    std::vector<int64_t> result;
+    result.reserve(dims.size());
+    for (int64_t dim : dims) result.push_back(dim + 1);
+    return result;
+  };
+  const DotDimensionNumbers& dnums = first->dot_dimension_numbers();
+  DotDimensionNumbers new_dnums;
+  new_dnums.add_lhs_batch_dimensions(0);
+  new_dnums.add_rhs_batch_dimensions(0);
+  for (int64_t dim : shifted(dnums.lhs_batch_dimensions())) {
+    new_dnums.add_lhs_batch_dimensions(dim);
+  }
+  for (int64_t dim : shifted(dnums.rhs_batch_dimensions())) {
+    new_dnums.add_rhs_batch_dimensions(dim);
+  }
+  for (int64_t dim : shifted(dnums.lhs_contracting_dimensions())) {
+    new_dnums.add_lhs_contracting_dimensions(dim);
+  }
+  for (int64_t dim : shifted(dnums.rhs_contracting_dimensions())) {
+    new_dnums.add_rhs_contracting_dimensions(dim);
+  }
+
+  // The new batch dimension comes first in the result, followed by the
+  // dimensions of the original dots.
+  const Shape new_dot_shape =
+      ShapeUtil::PrependMajorDimension(num_dots, first->shape());
+  HloInstruction* new_dot = first->AddInstruction(HloInstruction::CreateDot(
+      new_dot_shape, lhs, rhs, new_dnums, first->precision_config()));
+  new_dot->set_metadata(first->metadata());
+
+  const Shape slice_shape =
+      ShapeUtil::PrependMajorDimension(1, first->shape());
+  DimensionVector start_indices(new_dot_shape.dimensions().size(), 0);
+  DimensionVector limit_indices(new_dot_shape.dimensions().begin(),
+                                new_dot_shape.dimensions().end());
+  DimensionVector strides(new_dot_shape.dimensions().size(), 1);
+  for (int64_t i = 0; i < num_dots; ++i) {
+    start_indices[0] = i;
+    limit_indices[0] = i + 1;
+    HloInstruction* slice = new_dot->AddInstruction(HloInstruction::CreateSlice(
+        slice_shape, new_dot, start_indices, limit_indices, strides));
+    HloInstruction* result = slice->AddInstruction(
+        HloInstruction::CreateReshape(dots[i]->shape(), slice));
+    // Important: We do RAUW, not ReplaceInstruction, because the old
+    // instruction must live until the end of the pass.
+    TF_RETURN_IF_ERROR(dots[i]->ReplaceAllUsesWith(result));
+  }
+  return new_dot;
+}
+
 absl::StatusOr<bool> MergeDots(HloComputation* comp, int64_t max_size_to_merge,
                                std::function<bool(const HloInstruction* dot_a,
                                                   const HloInstruction* dot_b)>
-                                   can_merge) {
+                                   can_merge,
+                               bool batch_independent_dots) {
   auto is_merge_candidate = [&](HloInstruction* instr) {
     int64_t bytes = ShapeUtil::ByteSizeOfElements(instr->shape());
     for (const HloInstruction* operand : instr->operands()) {
@@ -516,8 +624,32 @@ absl::StatusOr<bool> MergeDots(HloComputation* comp, int64_t max_size_to_merge,
         return v.size() < 2 || absl::c_none_of(v, is_merge_candidate);
       });
 
+  // Collect the dots that could be stacked into a batched dot, keyed by
+  // `BatchingKey`. Unlike above, every one of them has to be small.
+  absl::flat_hash_map<std::string, std::vector<HloInstruction*>>
+      batching_classes;
+  if (batch_independent_dots) {
+    for (HloInstruction* instr : comp->instructions()) {
+      if (instr->opcode() != HloOpcode::kDot ||
+          !instr->control_predecessors().empty() ||
+          !instr->control_successors().empty() ||
+          !Cast<HloDotInstruction>(instr)->sparsity().empty() ||
+          !instr->shape().is_static() ||
+          !instr->operand(0)->shape().is_static() ||
+          !instr->operand(1)->shape().is_static() ||
+          !is_merge_candidate(instr)) {
+        continue;
+      }
+      batching_classes[BatchingKey(instr)].push_back(instr);
+    }
+    absl::erase_if(
+        batching_classes,
+        [](const std::pair<const std::string, std::vector<HloInstruction*>>&
+               kv) { return kv.second.size() < 2; });
+  }
+
   // Are there any possible optimization opportunities?
-  if (equivalence_classes.empty()) {
+  if (equivalence_classes.empty() && batching_classes.empty()) {
     return false;
   }
 
@@ -612,6 +744,50 @@ absl::StatusOr<bool> MergeDots(HloComputation* comp, int64_t max_size_to_merge,
     }
   }
 
+  // Stack the remaining independent dots of every batching class.
+  std::vector<std::string> batching_keys;
+  batching_keys.reserve(batching_classes.size());
+  for (const auto& kv : batching_classes) {
+    batching_keys.push_back(kv.first);
+  }
+  absl::c_sort(batching_keys);
+  for (const std::string& key : batching_keys) {
+    std::vector<HloInstruction*> candidates;
+    for (HloInstruction* dot : batching_classes[key]) {
+      if (!dead_instrs.contains(dot)) candidates.push_back(dot);
+    }
+    while (candidates.size() >= 2) {
+      // Greedily pick a set of mutually independent dots, leaving the others
+      // for the next round.
+      std::vector<HloInstruction*> batch;
+      std::vector<HloInstruction*> rest;
+      for (HloInstruction* dot : candidates) {
+        const int32_t id = graph_id(dot);
+        const bool independent = absl::c_all_of(
+            batch, [&](HloInstruction* other) {
+              const int32_t other_id = graph_id(other);
+              return can_merge(other, dot) &&
+                     !graph.IsReachableNonConst(id, other_id) &&
+                     !graph.IsReachableNonConst(other_id, id);
+            });
+        (independent ? batch : rest).push_back(dot);
+      }
+      if (batch.size() >= 2) {
+        TF_ASSIGN_OR_RETURN(HloInstruction * merged, BatchDots(batch));
+        const int32_t merged_id = graph_id(merged);
+        for (HloInstruction* dot : batch) {
+          const int32_t id = graph_id(dot);
+          graph.InsertEdge(id, merged_id);
+          for (int32_t succ : graph.SuccessorsCopy(id)) {
+            graph.InsertEdge(merged_id, succ);
+          }
+          dead_instrs.insert(dot);
+        }
+      }
+      candidates = std::move(rest);
+    }
+  }
+
   // Now it's finally safe to delete the old instructions from the graph.
   for (HloInstruction* instr : dead_instrs) {
     TF_RETURN_IF_ERROR(comp->RemoveInstruction(instr));
@@ -629,7 +805,8 @@ absl::StatusOr<bool> DotMerger::Run(
   for (HloComputation* comp :
        module->MakeNonfusionComputations(execution_threads)) {
     TF_ASSIGN_OR_RETURN(bool changed_computation,
-                        MergeDots(comp, max_size_to_merge_, can_merge_));
+                        MergeDots(comp, max_size_to_merge_, can_merge_,
+                                  batch_independent_dots_));
     changed |= changed_computation;
   }
   return changed;
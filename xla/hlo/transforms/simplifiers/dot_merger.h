@@ -55,14 +55,35 @@ namespace xla {
 //
 // Will skip gemms with more than one non-contracting dimension in the dot
 // operands to be concatenated.
+//
+// If `batch_independent_dots` is set, independent dots that don't share an
+// operand but have identical shapes, dimension numbers and precision are
+// stacked into a single batched dot instead:
+//
+//   x = dot(a, b)
+//   y = dot(c, d)
+//
+// becomes
+//
+//   z = dot(concat(reshape(a), reshape(c)), concat(reshape(b), reshape(d))),
+//       with a new leading batch dimension
+//   x = reshape(slice(z))
+//   y = reshape(slice(z)).
+//
+// This runs many small gemms, e.g. per-expert or per-head projections with
+// different weights, as one launch that can occupy the whole device. As for
+// the shared operand case, every stacked dot must be below the threshold.
 class DotMerger : public HloModulePass {
  public:
   explicit DotMerger(
       int64_t max_size_to_merge,
       std::function<bool(const HloInstruction* a, const HloInstruction* b)>
           can_merge = [](const HloInstruction* dot_a,
-                         const HloInstruction* dot_b) -> bool { return true; })
-      : max_size_to_merge_(max_size_to_merge), can_merge_(can_merge) {}
+                         const HloInstruction* dot_b) -> bool { return true; },
+      bool batch_independent_dots = false)
+      : max_size_to_merge_(max_size_to_merge),
+        can_merge_(can_merge),
+        batch_independent_dots_(batch_independent_dots) {}
 
   absl::string_view name() const override { return "dot-merger"; }
   using HloPassInterface::Run;
@@ -75,6 +96,7 @@ class DotMerger : public HloModulePass {
   // Predicate function for backend-specific compatibility check.
   std::function<bool(const HloInstruction* dot_a, const HloInstruction* dot_b)>
       can_merge_;
+  bool batch_independent_dots_;
 };
 
 }  // namespace xla
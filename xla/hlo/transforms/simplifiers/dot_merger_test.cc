@@ -976,5 +976,114 @@ ENTRY main {
   EXPECT_FALSE(changed);
 }
 
+TEST_F(DotMergerTest, BatchIndependentDots) {
+  absl::string_view module_string = R"(
+  HloModule module
+
+  ENTRY main {
+    a = f32[20,30] parameter(0)
+    b = f32[30,40] parameter(1)
+    c = f32[20,30] parameter(2)
+    d = f32[30,40] parameter(3)
+    e = f32[20,30] parameter(4)
+    f = f32[30,40] parameter(5)
+    dot0 = f32[20,40] dot(a, b), lhs_contracting_dims={1}, rhs_contracting_dims={0}
+    dot1 = f32[20,40] dot(c, d), lhs_contracting_dims={1}, rhs_contracting_dims={0}
+    dot2 = f32[20,40] dot(e, f), lhs_contracting_dims={1}, rhs_contracting_dims={0}
+    ROOT tuple = (f32[20,40], f32[20,40], f32[20,40]) tuple(dot0, dot1, dot2)
+  })";
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(module_string));
+  DotMerger pass(
+      /*max_size_to_merge=*/std::numeric_limits<int64_t>::max(),
+      [](const HloInstruction*, const HloInstruction*) { return true; },
+      /*batch_independent_dots=*/true);
+  TF_ASSERT_OK_AND_ASSIGN(bool changed, this->RunHloPass(&pass, module.get()));
+  EXPECT_TRUE(changed);
+  const HloInstruction* dot0 = nullptr;
+  const HloInstruction* dot1 = nullptr;
+  const HloInstruction* dot2 = nullptr;
+  EXPECT_THAT(module->entry_computation()->root_instruction(),
+              GmockMatch(m::Tuple(m::Reshape(m::Slice(m::Op(&dot0))),
+                                  m::Reshape(m::Slice(m::Op(&dot1))),
+                                  m::Reshape(m::Slice(m::Op(&dot2))))));
+  EXPECT_EQ(dot0, dot1);
+  EXPECT_EQ(dot0, dot2);
+  EXPECT_THAT(
+      dot0,
+      GmockMatch(m::Dot(m::Concatenate().WithShape(F32, {3, 20, 30}),
+                        m::Concatenate().WithShape(F32, {3, 30, 40}))
+                     .WithShape(F32, {3, 20, 40})));
+  const DotDimensionNumbers& dnums = dot0->dot_dimension_numbers();
+  EXPECT_THAT(dnums.lhs_batch_dimensions(), ::testing::ElementsAre(0));
+  EXPECT_THAT(dnums.rhs_batch_dimensions(), ::testing::ElementsAre(0));
+  EXPECT_THAT(dnums.lhs_contracting_dimensions(), ::testing::ElementsAre(2));
+  EXPECT_THAT(dnums.rhs_contracting_dimensions(), ::testing::ElementsAre(1));
+}
+
+TEST_F(DotMergerTest, NoBatchIndependentDotsByDefault) {
+  absl::string_view module_string = R"(
+  HloModule module
+
+  ENTRY main {
+    a = f32[20,30] parameter(0)
+    b = f32[30,40] parameter(1)
+    c = f32[20,30] parameter(2)
+    d = f32[30,40] parameter(3)
+    dot0 = f32[20,40] dot(a, b), lhs_contracting_dims={1}, rhs_contracting_dims={0}
+    dot1 = f32[20,40] dot(c, d), lhs_contracting_dims={1}, rhs_contracting_dims={0}
+    ROOT tuple = (f32[20,40], f32[20,40]) tuple(dot0, dot1)
+  })";
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(module_string));
+  DotMerger pass(/*max_size_to_merge=*/std::numeric_limits<int64_t>::max());
+  TF_ASSERT_OK_AND_ASSIGN(bool changed, this->RunHloPass(&pass, module.get()));
+  EXPECT_FALSE(changed);
+}
+
+TEST_F(DotMergerTest, NoBatchDependentDots) {
+  absl::string_view module_string = R"(
+  HloModule module
+
+  ENTRY main {
+    a = f32[20,20] parameter(0)
+    b = f32[20,20] parameter(1)
+    c = f32[20,20] parameter(2)
+    dot0 = f32[20,20] dot(a, b), lhs_contracting_dims={1}, rhs_contracting_dims={0}
+    ROOT dot1 = f32[20,20] dot(dot0, c), lhs_contracting_dims={1}, rhs_contracting_dims={0}
+  })";
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(module_string));
+  DotMerger pass(
+      /*max_size_to_merge=*/std::numeric_limits<int64_t>::max(),
+      [](const HloInstruction*, const HloInstruction*) { return true; },
+      /*batch_independent_dots=*/true);
+  TF_ASSERT_OK_AND_ASSIGN(bool changed, this->RunHloPass(&pass, module.get()));
+  EXPECT_FALSE(changed);
+}
+
+TEST_F(DotMergerTest, NoBatchLargeDots) {
+  absl::string_view module_string = R"(
+  HloModule module
+
+  ENTRY main {
+    a = f32[20,30] parameter(0)
+    b = f32[30,40] parameter(1)
+    c = f32[20,30] parameter(2)
+    d = f32[30,40] parameter(3)
+    dot0 = f32[20,40] dot(a, b), lhs_contracting_dims={1}, rhs_contracting_dims={0}
+    dot1 = f32[20,40] dot(c, d), lhs_contracting_dims={1}, rhs_contracting_dims={0}
+    ROOT tuple = (f32[20,40], f32[20,40]) tuple(dot0, dot1)
+  })";
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(module_string));
+  DotMerger pass(
+      /*max_size_to_merge=*/1024,
+      [](const HloInstruction*, const HloInstruction*) { return true; },
+      /*batch_independent_dots=*/true);
+  TF_ASSERT_OK_AND_ASSIGN(bool changed, this->RunHloPass(&pass, module.get()));
+  EXPECT_FALSE(changed);
+}
+
 }  // namespace
 }  // namespace xla
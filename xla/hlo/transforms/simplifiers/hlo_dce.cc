@@ -17,7 +17,6 @@ limitations under the License.
 
 #include <cstdint>
 #include <iterator>
-#include <memory>
 #include <optional>
 #include <set>
 #include <stack>
@@ -27,6 +26,8 @@ limitations under the License.
 
 #include "absl/algorithm/container.h"
 #include "absl/container/flat_hash_set.h"
+#include "absl/container/inlined_vector.h"
+#include "absl/functional/function_ref.h"
 #include "absl/log/check.h"
 #include "absl/log/log.h"
 #include "absl/status/statusor.h"
@@ -164,25 +165,18 @@ absl::StatusOr<bool> RemoveMultiOutputFusionsUnusedOutputs(
   return true;
 }
 
-}  // namespace
-
-/*static*/ absl::StatusOr<bool> HloDCE::RunOnComputation(
+// Removes the dead instructions of `computation`. `computation_callers`
+// returns the instructions calling a computation, which is needed to remove
+// dead parameters.
+absl::StatusOr<bool> RemoveDeadInstructions(
     HloComputation* computation, bool remove_cross_partition_collective_ops,
-    CallGraph* call_graph) {
+    absl::FunctionRef<std::vector<HloInstruction*>(const HloComputation*)>
+        computation_callers) {
   // We do this first, because it may create dead roots which we can clean up
   // next.
   TF_ASSIGN_OR_RETURN(bool changed,
                       RemoveMultiOutputFusionsUnusedOutputs(computation));
 
-  auto computation_callers =
-      [call_graph](
-          const HloComputation* computation) -> std::vector<HloInstruction*> {
-    if (call_graph == nullptr) {
-      return {};
-    }
-    return call_graph->GetComputationCallers(computation);
-  };
-
   // Remove any dead roots and their dead transitive operands. Collect
   // them into a separate list first to avoid problems with iterating through
   // the computation's instruction while simultaneously removing instructions.
@@ -256,6 +250,22 @@ absl::StatusOr<bool> RemoveMultiOutputFusionsUnusedOutputs(
   return changed;
 }
 
+}  // namespace
+
+/*static*/ absl::StatusOr<bool> HloDCE::RunOnComputation(
+    HloComputation* computation, bool remove_cross_partition_collective_ops,
+    CallGraph* call_graph) {
+  return RemoveDeadInstructions(
+      computation, remove_cross_partition_collective_ops,
+      [call_graph](
+          const HloComputation* computation) -> std::vector<HloInstruction*> {
+        if (call_graph == nullptr) {
+          return {};
+        }
+        return call_graph->GetComputationCallers(computation);
+      });
+}
+
 absl::StatusOr<bool> HloDCE::Run(
     HloModule* module,
     const absl::flat_hash_set<absl::string_view>& execution_threads) {
@@ -264,10 +274,19 @@ absl::StatusOr<bool> HloDCE::Run(
   VLOG(2) << "Before dce; threads: " << absl::StrJoin(execution_threads, ",");
   XLA_VLOG_LINES(2, module->ToString());
 
-  std::unique_ptr<CallGraph> call_graph;
-  if (use_call_analysis_) {
-    call_graph = CallGraph::Build(module);
-  }
+  // Computations keep track of their callers and callees as instructions are
+  // added and removed, so neither finding the callers of a computation nor the
+  // reachable computations needs a call graph.
+  auto computation_callers =
+      [this](
+          const HloComputation* computation) -> std::vector<HloInstruction*> {
+    if (!use_call_analysis_) {
+      return {};
+    }
+    absl::InlinedVector<HloInstruction*, 1> callers =
+        computation->caller_instructions();
+    return std::vector<HloInstruction*>(callers.begin(), callers.end());
+  };
 
   // Run DCE on each computation. Visit callers before callees so that we
   // cleanup dead get-tuple-element users of MultiOutput fusions before cleaning
@@ -292,28 +311,25 @@ absl::StatusOr<bool> HloDCE::Run(
         execution_threads.contains(computation->execution_thread())) {
       TF_ASSIGN_OR_RETURN(
           bool computation_changed,
-          RunOnComputation(computation, remove_cross_partition_collective_ops_,
-                           call_graph.get()));
+          RemoveDeadInstructions(computation,
+                                 remove_cross_partition_collective_ops_,
+                                 computation_callers));
       changed |= computation_changed;
     }
 
-    for (auto* instruction : computation->instructions()) {
-      for (HloComputation* called_computation :
-           instruction->called_computations()) {
-        if (to_remove.erase(called_computation) > 0) {
-          agenda.push(called_computation);
-        }
+    for (const auto& [callee, count] : computation->callee_computations()) {
+      if (to_remove.erase(callee) > 0) {
+        agenda.push(callee);
       }
     }
   }
   // Some computations might have been left dangling due to being detached
-  // indirectly. We need to rebuild the call graph to find these.
+  // indirectly, e.g. when only called from a dead computation.
   if (use_call_analysis_) {
-    call_graph = CallGraph::Build(module);
     for (HloComputation* computation :
          module->computations(execution_threads)) {
       if (!computation->IsEntryComputation() &&
-          call_graph->GetComputationCallers(computation).empty()) {
+          computation->caller_instructions().empty()) {
         to_remove.insert(computation);
       }
     }
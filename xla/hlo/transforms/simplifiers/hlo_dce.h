@@ -35,8 +35,10 @@ namespace xla {
 // from the entry computation.
 //
 // This pass does not remove dead parameter instructions, unless call analysis
-// is enabled. Using this will slow down compilation. This is only beneficial
-// to do so if the graph is not inlined.
+// is enabled. This is only beneficial to do so if the graph is not inlined.
+// The callers of each computation are tracked by the computations themselves,
+// so neither the call analysis nor finding dead computations needs to build a
+// call graph.
 class HloDCE : public HloModulePass {
  public:
   explicit HloDCE(bool remove_cross_partition_collective_ops = false,
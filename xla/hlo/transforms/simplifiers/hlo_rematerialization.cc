@@ -554,7 +554,21 @@ class MemoryUsageTracker {
 
     CHECK_GT(memory_reduced, 0);
     // Return the inverse of the benefit of rematerialization.
-    return memory_limit_bytes / memory_reduced;
+    if (!options_.weight_recompute_by_compute_cost) {
+      return memory_limit_bytes / memory_reduced;
+    }
+
+    // Scale the cost by one plus the recompute time in microseconds, so that
+    // free recomputations cost the same as moves and offloads.
+    float recompute_seconds = 0.0f;
+    for (auto* item : items) {
+      recompute_seconds += std::max(
+          0.0f, options_.hlo_cost_analysis.optimal_seconds(*item->instruction));
+    }
+    const double cost = static_cast<double>(memory_limit_bytes) /
+                        memory_reduced * (1.0 + recompute_seconds * 1e6);
+    constexpr int64_t kMaxCost = std::numeric_limits<int64_t>::max() / 2;
+    return cost >= kMaxCost ? kMaxCost : static_cast<int64_t>(cost);
   }
 
   // Finishes the placement of the current instruction. This frees any dead
@@ -154,6 +154,13 @@ class HloRematerialization : public HloModulePass {
     // Collection of async entry computations and their number of parallel
     // invocations.
     absl::flat_hash_map<HloComputation*, int64_t> async_computation_parallelism;
+
+    // If true, the cost of recomputing a block is scaled by the time it takes
+    // to recompute, as estimated by `hlo_cost_analysis`. This prefers blocks
+    // which are cheap to recompute, and host offloads, which are only picked
+    // when their copies are hidden, over blocks freeing the same memory with
+    // more compute.
+    bool weight_recompute_by_compute_cost = false;
   };
 
   explicit HloRematerialization(Options options, RematerializationSizes& sizes)
@@ -1544,6 +1544,65 @@ ENTRY MyModule {
               op::Tanh(res_10_matcher));
 }
 
+class ComputeAwareRematerializationTest : public RematerializationTestBase {
+ protected:
+  absl::StatusOr<bool> RunHloRematerialization(int64_t memory_limit_bytes,
+                                               HloModule* module) {
+    TF_EXPECT_OK(verifier().Run(module).status());
+    HloCostAnalysis::Options hlo_cost_analysis_options;
+    hlo_cost_analysis_options.shape_size = [](const Shape& shape) {
+      return ByteSizeOf(shape);
+    };
+    hlo_cost_analysis_options.set_flops_per_second(1e9);
+    HloCostAnalysis cost_analysis(hlo_cost_analysis_options);
+    HloRematerialization::RematerializationModeConfig config(
+        /*recompute=*/true, /*compress=*/false, /*host_offload=*/false);
+    HloRematerialization::Options options(
+        cost_analysis, config, memory_limit_bytes,
+        /*block_size_limit=*/1, /*block_rematerialization_factor=*/1,
+        /*min_remat_size=*/0, /*compact_shape_function=*/nullptr,
+        /*host_memory_offload_config=*/std::nullopt,
+        /*async_computation_parallelism=*/{});
+    options.weight_recompute_by_compute_cost = true;
+    HloRematerialization::RematerializationSizes sizes;
+    HloRematerialization remat(options, sizes);
+    return remat.Run(module);
+  }
+};
+
+TEST_F(ComputeAwareRematerializationTest, PrefersCheapRecomputation) {
+  // Rematerializing either `dot` or `bcast` after `big` frees the same
+  // memory, but `bcast` needs no flops.
+  const std::string& hlo_string = R"(
+HloModule m, is_scheduled=true
+
+ENTRY e {
+  p0 = f32[] parameter(0)
+  p1 = f32[32,32] parameter(1)
+  dot = f32[32,32] dot(p1, p1), lhs_contracting_dims={1},
+      rhs_contracting_dims={0}
+  bcast = f32[32,32] broadcast(p0), dimensions={}
+  big = f32[128,32] broadcast(p0), dimensions={}
+  r = f32[1,32] slice(big), slice={[0:1], [0:32]}
+  ROOT concat = f32[65,32] concatenate(dot, bcast, r), dimensions={0}
+}
+)";
+  TF_ASSERT_OK_AND_ASSIGN(auto module,
+                          ParseAndReturnVerifiedModule(hlo_string));
+  const HloInstruction* dot = FindInstruction(module.get(), "dot");
+  const HloInstruction* bcast = FindInstruction(module.get(), "bcast");
+
+  TF_ASSERT_OK_AND_ASSIGN(bool changed,
+                          RunHloRematerialization(
+                              /*memory_limit_bytes=*/34 * 1024, module.get()));
+  EXPECT_TRUE(changed);
+  const HloInstruction* concat =
+      module->entry_computation()->root_instruction();
+  EXPECT_EQ(concat->operand(0), dot);
+  EXPECT_THAT(concat->operand(1), op::Broadcast(op::Parameter(0)));
+  EXPECT_NE(concat->operand(1), bcast);
+}
+
 class IndirectUseTest : public RecomputeAndCompressHloRematerializationTest,
                         public ::testing::WithParamInterface<bool> {};
 
@@ -15,6 +15,10 @@ limitations under the License.
 
 #include "xla/hlo/translate/mhlo_to_hlo/literal_exporter.h"
 
+#include <cstring>
+#include <optional>
+#include <utility>
+
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
@@ -25,6 +29,7 @@ limitations under the License.
 #include "xla/array.h"
 #include "xla/hlo/translate/mhlo_to_hlo/type_to_shape.h"
 #include "xla/layout.h"
+#include "xla/layout_util.h"
 #include "xla/literal.h"
 #include "xla/literal_util.h"
 #include "xla/primitive_util.h"
@@ -64,6 +69,42 @@ xla::Array<T> ArrayFromDenseElementsAttr(mlir::DenseElementsAttr dense_attr) {
   return array;
 }
 
+// Creates the literal by copying the raw data of `dense_attr` at once instead
+// of element by element through an xla::Array, which dominates the export of
+// large constants. Returns std::nullopt if the raw data is not stored in the
+// layout of the literal.
+template <typename T>
+std::optional<xla::Literal> LiteralFromRawData(
+    mlir::DenseElementsAttr dense_attr, const xla::Shape& shape,
+    const xla::Layout& layout) {
+  constexpr xla::PrimitiveType type =
+      xla::primitive_util::NativeToPrimitiveType<T>();
+  // Predicates and sub-byte types are bit packed in the attribute.
+  if constexpr (type == xla::PRED ||
+                xla::primitive_util::IsSubByteNonPredType(type)) {
+    return std::nullopt;
+  } else {
+    xla::Layout descending_layout =
+        xla::LayoutUtil::MakeDescendingLayout(shape.dimensions_size());
+    if (!layout.minor_to_major().empty() && layout != descending_layout) {
+      return std::nullopt;
+    }
+    xla::Shape literal_shape = shape;
+    *literal_shape.mutable_layout() = std::move(descending_layout);
+    xla::Literal literal(literal_shape);
+    if (dense_attr.isSplat()) {
+      literal.PopulateWithValue(dense_attr.getSplatValue<T>());
+      return literal;
+    }
+    llvm::ArrayRef<char> raw_data = dense_attr.getRawData();
+    if (raw_data.size() != literal.size_bytes()) {
+      return std::nullopt;
+    }
+    std::memcpy(literal.untyped_data(), raw_data.data(), raw_data.size());
+    return literal;
+  }
+}
+
 absl::StatusOr<xla::Literal> CreateLiteralFromAttribute(mlir::ElementsAttr attr,
                                                         xla::Layout layout) {
   auto dense_attr = mlir::dyn_cast<mlir::DenseElementsAttr>(attr);
@@ -78,6 +119,10 @@ absl::StatusOr<xla::Literal> CreateLiteralFromAttribute(mlir::ElementsAttr attr,
                           primitive_type_constant)) {
           using cpp_type =
               xla::primitive_util::NativeTypeOf<primitive_type_constant>;
+          if (std::optional<xla::Literal> literal =
+                  LiteralFromRawData<cpp_type>(dense_attr, shape, layout)) {
+            return *std::move(literal);
+          }
           xla::Array<cpp_type> source_data =
               ArrayFromDenseElementsAttr<cpp_type>(dense_attr);
           if (layout.minor_to_major().empty()) {
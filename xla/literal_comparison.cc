@@ -21,10 +21,13 @@ limitations under the License.
 #include <unistd.h>
 #endif
 
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <cstdint>
+#include <cstring>
 #include <limits>
+#include <memory>
 #include <optional>
 #include <set>
 #include <string>
@@ -45,11 +48,14 @@ limitations under the License.
 #include "xla/primitive_util.h"
 #include "xla/shape.h"
 #include "xla/shape_util.h"
+#include "xla/tsl/platform/env.h"
 #include "xla/tsl/platform/errors.h"
 #include "xla/tsl/platform/logging.h"  // IWYU pragma: keep
+#include "xla/tsl/platform/threadpool.h"
 #include "xla/types.h"
 #include "xla/util.h"
 #include "xla/xla_data.pb.h"
+#include "tsl/platform/cpu_info.h"
 
 using absl::StrAppend;
 using absl::StrAppendFormat;
@@ -173,6 +179,31 @@ absl::Status Equal(LiteralSlice expected, LiteralSlice actual,
   return result;
 }
 
+// Returns true if the array literals have the same static shape and layout and
+// their data is bytewise equal, which for the bitwise equality of Equal() is
+// the same as all their elements being equal. Sub-byte types are excluded as
+// the unused bits of their bytes are not significant.
+bool DataBytewiseEqual(const LiteralSlice& expected,
+                       const LiteralSlice& actual) {
+  const Shape& shape = expected.shape();
+  if (!shape.IsArray() || !shape.is_static() || !actual.shape().is_static() ||
+      primitive_util::IsSubByteNonPredType(shape.element_type()) ||
+      !LayoutUtil::Equal(shape.layout(), actual.shape().layout())) {
+    return false;
+  }
+  const int64_t size_bytes = expected.size_bytes();
+  return size_bytes == actual.size_bytes() &&
+         std::memcmp(expected.untyped_data(), actual.untyped_data(),
+                     size_bytes) == 0;
+}
+
+// Returns the thread pool used to compare large literals.
+tsl::thread::ThreadPool* GetComparisonThreadPool() {
+  static auto* const pool = new tsl::thread::ThreadPool(
+      tsl::Env::Default(), "literal_comparison", tsl::port::MaxParallelism());
+  return pool;
+}
+
 // Gets the total element count.  For tuples, this is not the count of tuple
 // elements, but the sum of elements of each tuple element.
 int64_t RecursiveElementCount(const Shape& shape) {
@@ -299,9 +330,14 @@ class NearComparator {
       return InvalidArgument("Expected array shape; got %s.",
                              ShapeUtil::HumanString(expected_.shape()));
     }
+    // Bitwise equal elements are always near.
+    if (DataBytewiseEqual(expected_, actual_)) {
+      return absl::OkStatus();
+    }
 
     mismatches_ = Literal(ShapeUtil::ChangeElementType(actual_.shape(), PRED));
     mismatches_.PopulateWithValue(false);
+    mismatches_data_ = mismatches_.data<bool>().data();
 
     CompareLiterals();
 
@@ -484,7 +520,7 @@ class NearComparator {
       }
     }
 
-    mismatches_.data<bool>()[linear_index] = true;
+    mismatches_data_[linear_index] = true;
   }
 
   // For complex types, we compare real and imaginary parts individually.
@@ -512,9 +548,13 @@ class NearComparator {
         expected_.shape().is_static() && actual_.shape().is_static()) {
       absl::Span<const NativeT> expected_data = expected_.data<NativeT>();
       absl::Span<const NativeT> actual_data = actual_.data<NativeT>();
-      const int64_t len = expected_data.size();
-      for (int64_t i = 0; i < len; ++i) {
-        CompareValues(expected_data[i], actual_data[i], i);
+      const int64_t num_shards = std::min<int64_t>(
+          tsl::port::MaxParallelism(),
+          expected_data.size() / kMinElementsPerShard);
+      if (num_shards > 1) {
+        CompareLiteralsInParallel(expected_data, actual_data, num_shards);
+      } else {
+        CompareRange(expected_data, actual_data, 0, expected_data.size());
       }
       return;
     }
@@ -522,6 +562,69 @@ class NearComparator {
     CompareLiteralsSlow(0, &multi_index);
   }
 
+  // Compares the elements in [begin, end) of the data of the literals.
+  void CompareRange(absl::Span<const NativeT> expected_data,
+                    absl::Span<const NativeT> actual_data, int64_t begin,
+                    int64_t end) {
+    for (int64_t i = begin; i < end; ++i) {
+      CompareValues(expected_data[i], actual_data[i], i);
+    }
+  }
+
+  // Splits the data of the literals into `num_shards` ranges compared in
+  // parallel, each by a comparator of its own whose statistics are then merged
+  // into this one. They all record mismatches in mismatches_, which is safe as
+  // the ranges are disjoint.
+  void CompareLiteralsInParallel(absl::Span<const NativeT> expected_data,
+                                 absl::Span<const NativeT> actual_data,
+                                 int64_t num_shards) {
+    std::vector<std::unique_ptr<NearComparator>> shards(num_shards);
+    for (auto& shard : shards) {
+      shard.reset(new NearComparator(expected_, actual_, shape_index_, error_,
+                                     detailed_message_,
+                                     /*miscompare_callback=*/nullptr));
+      shard->mismatches_data_ = mismatches_data_;
+    }
+    const int64_t len = expected_data.size();
+    GetComparisonThreadPool()->ParallelFor(
+        num_shards, tsl::thread::ThreadPool::SchedulingParams::Fixed(1),
+        [&](int64_t begin, int64_t end) {
+          for (int64_t i = begin; i < end; ++i) {
+            shards[i]->CompareRange(expected_data, actual_data,
+                                    i * len / num_shards,
+                                    (i + 1) * len / num_shards);
+          }
+        });
+    for (const auto& shard : shards) {
+      MergeStatistics(*shard);
+    }
+  }
+
+  // Adds the mismatch statistics of `other` to the ones of this comparator.
+  void MergeStatistics(const NearComparator& other) {
+    num_mismatches_ += other.num_mismatches_;
+    num_nan_mismatches_ += other.num_nan_mismatches_;
+    num_abs_mismatches_ += other.num_abs_mismatches_;
+    num_rel_mismatches_ += other.num_rel_mismatches_;
+    for (int i = 0; i < abs_value_buckets_.size(); ++i) {
+      abs_value_buckets_[i].first += other.abs_value_buckets_[i].first;
+      abs_value_buckets_[i].second += other.abs_value_buckets_[i].second;
+    }
+    for (int i = 0; i < kErrorBucketBounds.size(); ++i) {
+      abs_error_buckets_[i] += other.abs_error_buckets_[i];
+      rel_error_buckets_[i] += other.rel_error_buckets_[i];
+    }
+    for (const Mismatch& mismatch : other.top_rel_mismatches_) {
+      if (top_rel_mismatches_.size() < kTopRelativeErrorCount ||
+          mismatch.rel_error > top_rel_mismatches_.begin()->rel_error) {
+        top_rel_mismatches_.insert(mismatch);
+        if (top_rel_mismatches_.size() > kTopRelativeErrorCount) {
+          top_rel_mismatches_.erase(top_rel_mismatches_.begin());
+        }
+      }
+    }
+  }
+
   // Slow path for CompareLiterals when 'actual' and 'expected' literals are
   // dynamic or have different layouts. In this case, multidimensional indices
   // are constructed and indexed for each element.
@@ -650,6 +753,14 @@ class NearComparator {
   // the comparison literals.
   Literal mismatches_;
 
+  // The data of mismatches_, which comparators of shards of a parallel
+  // comparison share with the one that owns mismatches_.
+  bool* mismatches_data_ = nullptr;
+
+  // The minimum number of elements compared by each thread of a parallel
+  // comparison, so that the work outweighs the cost of scheduling it.
+  static constexpr int64_t kMinElementsPerShard = 1 << 16;
+
   // The number of mismatches to report in the output, sorted by relative error
   // magnitude.
   static constexpr int64_t kTopRelativeErrorCount = 5;
@@ -705,6 +816,10 @@ absl::Status EqualHelper(const LiteralSlice& expected,
       }
       next_index.pop_back();
     }
+  } else if (DataBytewiseEqual(expected, actual)) {
+    // Comparing the data bytewise is much faster than comparing the elements
+    // one by one, which is only needed to find the mismatches.
+    return absl::OkStatus();
   } else {
     std::vector<int64_t> multi_index(
         expected.shape().IsArray() ? expected.shape().dimensions().size() : 0,
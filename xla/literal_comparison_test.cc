@@ -15,10 +15,16 @@ limitations under the License.
 
 #include "xla/literal_comparison.h"
 
+#include <cstdint>
+
+#include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include "absl/status/status.h"
 #include "xla/error_spec.h"
 #include "xla/hlo/testlib/test_helpers.h"
+#include "xla/literal.h"
 #include "xla/literal_util.h"
+#include "xla/shape_util.h"
 #include "xla/tsl/lib/core/status_test_util.h"
 #include "xla/xla_data.pb.h"
 #include "tsl/platform/ml_dtypes.h"
@@ -120,5 +126,46 @@ TYPED_TEST(LiteralComparisonTest, FloatUsingCompareNear_NotEqual_4ulps) {
                                         /*miscompare_callback=*/nullptr));
 }
 
+TEST(LiteralComparisonLargeTest, EqualFindsSingleMismatch) {
+  constexpr int64_t kSize = 1 << 20;
+  Literal expected(ShapeUtil::MakeShape(F32, {kSize}));
+  expected.PopulateWithValue(1.0f);
+  Literal actual = expected.Clone();
+  TF_EXPECT_OK(literal_comparison::Equal(expected, actual));
+
+  actual.Set<float>({kSize - 1}, 2.0f);
+  EXPECT_IS_NOT_OK(literal_comparison::Equal(expected, actual));
+}
+
+TEST(LiteralComparisonLargeTest, NearCountsMismatchesOfAllShards) {
+  constexpr int64_t kSize = 1 << 22;
+  Literal expected(ShapeUtil::MakeShape(F32, {kSize}));
+  expected.PopulateWithValue(1.0f);
+  Literal actual(ShapeUtil::MakeShape(F32, {kSize}));
+  actual.PopulateWithValue(1.001f);
+  actual.Set<float>({0}, 2.0f);
+  actual.Set<float>({kSize / 2}, 3.0f);
+  actual.Set<float>({kSize - 1}, 4.0f);
+
+  int64_t num_mismatches = 0;
+  auto miscompare_callback = [&](const LiteralSlice&, const LiteralSlice&,
+                                 const LiteralSlice& mismatches,
+                                 const ShapeIndex&,
+                                 const literal_comparison::ErrorBuckets&) {
+    for (bool mismatch : mismatches.data<bool>()) {
+      num_mismatches += mismatch;
+    }
+    EXPECT_TRUE(mismatches.Get<bool>({0}));
+    EXPECT_TRUE(mismatches.Get<bool>({kSize / 2}));
+    EXPECT_TRUE(mismatches.Get<bool>({kSize - 1}));
+  };
+  absl::Status status = literal_comparison::Near(
+      expected, actual, ErrorSpec(0.01, 0.01), /*detailed_message=*/true,
+      miscompare_callback);
+  EXPECT_IS_NOT_OK(status);
+  EXPECT_EQ(num_mismatches, 3);
+  EXPECT_THAT(status.message(), ::testing::HasSubstr("Mismatch count 3 "));
+}
+
 }  // namespace
 }  // namespace xla
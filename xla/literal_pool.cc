@@ -19,6 +19,7 @@ limitations under the License.
 #include <cstddef>
 #include <iterator>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "absl/synchronization/mutex.h"
@@ -98,6 +99,19 @@ std::shared_ptr<Literal> LiteralPool::GetCanonicalLiteral(
   return new_literal;
 }
 
+std::shared_ptr<Literal> LiteralPool::GetCanonicalLiteral(Literal&& literal) {
+  absl::MutexLock lock(&mu_);
+
+  auto& literals = literals_[literal.shape()];
+  if (auto ptr = FindCanonicalLiteral(literals, literal)) {
+    return ptr;
+  }
+
+  auto new_literal = std::make_shared<Literal>(std::move(literal));
+  literals.push_back(new_literal);
+  return new_literal;
+}
+
 std::shared_ptr<Literal> LiteralPool::GetCanonicalLiteral(
     std::shared_ptr<Literal> literal) {
   absl::MutexLock lock(&mu_);
@@ -40,6 +40,10 @@ class LiteralPool {
   // pool, it is added to the pool and returned back.
   std::shared_ptr<Literal> GetCanonicalLiteral(const Literal& literal);
 
+  // Returns a canonical literal from the pool. If the literal is not in the
+  // pool, it is moved into the pool without copying its buffers.
+  std::shared_ptr<Literal> GetCanonicalLiteral(Literal&& literal);
+
   // Returns a canonical literal from the pool. If the literal is not in the
   // pool, it is added to the pool and returned back.
   std::shared_ptr<Literal> GetCanonicalLiteral(
@@ -15,6 +15,8 @@ limitations under the License.
 
 #include "xla/literal_pool.h"
 
+#include <utility>
+
 #include "xla/literal_util.h"
 #include "xla/tsl/platform/test.h"
 
@@ -41,5 +43,20 @@ TEST(LiteralPoolTest, GetCanonicalLiteral) {
   ASSERT_EQ(pool.GarbageCollect(), 2);
 }
 
+TEST(LiteralPoolTest, GetCanonicalLiteralByMove) {
+  LiteralPool pool;
+
+  auto l0 = LiteralUtil::CreateR2({{1., 2.}, {3., 4.}});
+  const void* l0_data = l0.untyped_data();
+
+  // Moving a new literal into the pool must not copy its buffers.
+  auto cl0_0 = pool.GetCanonicalLiteral(std::move(l0));
+  ASSERT_EQ(cl0_0->untyped_data(), l0_data);
+
+  auto cl0_1 =
+      pool.GetCanonicalLiteral(LiteralUtil::CreateR2({{1., 2.}, {3., 4.}}));
+  ASSERT_EQ(cl0_0, cl0_1);
+}
+
 }  // namespace
 }  // namespace xla
@@ -41,6 +41,11 @@ CommonPjRtBuffer::~CommonPjRtBuffer() {
   }
 }
 
+bool CommonPjRtBuffer::HasExternalReference() const {
+  absl::MutexLock lock(&mu_);
+  return holds_[ScopedHold::kExternalReference] > 0;
+}
+
 void CommonPjRtBuffer::WaitForOutstandingUsageHolds() {
   auto not_in_usage_hold = [&]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
     return holds_[ScopedHold::kUsage] == 0;
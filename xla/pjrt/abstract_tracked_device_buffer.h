@@ -166,6 +166,10 @@ class CommonPjRtBuffer : public PjRtBuffer {
 
   bool IsDeleted() override;
 
+  // Returns true if an external framework holds a reference to the buffer,
+  // in which case the buffer can't be donated.
+  bool HasExternalReference() const;
+
  protected:
   explicit CommonPjRtBuffer(
       std::unique_ptr<AbstractTrackedDeviceBuffer> device_buffer);
@@ -0,0 +1,159 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/pjrt/buffer_streaming.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "absl/log/log.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "xla/pjrt/pjrt_client.h"
+#include "xla/pjrt/pjrt_future.h"
+#include "xla/tsl/platform/file_system.h"
+#include "xla/util.h"
+#include "tsl/platform/mem.h"
+
+namespace xla {
+namespace {
+
+// A host chunk, registered for fast transfers with the client if possible.
+class HostChunk {
+ public:
+  HostChunk(PjRtClient* client, int64_t size, int64_t alignment)
+      : client_(client),
+        data_(static_cast<char*>(tsl::port::AlignedMalloc(size, alignment))) {
+    dma_mapped_ = client_->DmaMap(data_, size).ok();
+  }
+  ~HostChunk() {
+    if (dma_mapped_) {
+      client_->DmaUnmap(data_).IgnoreError();
+    }
+    tsl::port::AlignedFree(data_);
+  }
+
+  HostChunk(const HostChunk&) = delete;
+  HostChunk& operator=(const HostChunk&) = delete;
+
+  char* data() const { return data_; }
+
+ private:
+  PjRtClient* client_;
+  char* data_;
+  bool dma_mapped_;
+};
+
+// A device to host transfer of the `size` bytes at `stream_offset` in the
+// concatenation of the buffers into a host chunk.
+struct ChunkTransfer {
+  HostChunk* chunk;
+  int64_t stream_offset;
+  int64_t size;
+  PjRtFuture<> done;
+};
+
+}  // namespace
+
+absl::Status StreamBuffersToSink(absl::Span<PjRtBuffer* const> buffers,
+                                 BufferChunkSink& sink,
+                                 const BufferStreamingOptions& options) {
+  if (options.chunk_size <= 0 || options.num_chunks <= 0) {
+    return InvalidArgument("Invalid chunk size %d or number of chunks %d.",
+                           options.chunk_size, options.num_chunks);
+  }
+  if (buffers.empty()) {
+    return absl::OkStatus();
+  }
+
+  std::vector<std::unique_ptr<HostChunk>> chunks;
+  chunks.reserve(options.num_chunks);
+  for (int i = 0; i < options.num_chunks; ++i) {
+    chunks.push_back(std::make_unique<HostChunk>(
+        buffers.front()->client(), options.chunk_size,
+        options.chunk_alignment));
+  }
+  std::vector<HostChunk*> free_chunks;
+  for (const auto& chunk : chunks) {
+    free_chunks.push_back(chunk.get());
+  }
+
+  // Transfers are consumed by the sink in the order they are started. Every
+  // started transfer is awaited before the chunks are freed, even on error.
+  std::deque<ChunkTransfer> in_flight;
+  absl::Status status;
+  auto consume_oldest = [&]() {
+    ChunkTransfer transfer = std::move(in_flight.front());
+    in_flight.pop_front();
+    absl::Status transfer_status = transfer.done.Await();
+    if (status.ok()) {
+      status = transfer_status;
+    }
+    if (status.ok()) {
+      status = sink(transfer.stream_offset,
+                    absl::MakeConstSpan(transfer.chunk->data(), transfer.size));
+    }
+    free_chunks.push_back(transfer.chunk);
+  };
+
+  int64_t stream_offset = 0;
+  for (PjRtBuffer* buffer : buffers) {
+    absl::StatusOr<size_t> buffer_size = buffer->GetOnDeviceSizeInBytes();
+    if (!buffer_size.ok()) {
+      status.Update(buffer_size.status());
+      break;
+    }
+    for (int64_t offset = 0; offset < *buffer_size;
+         offset += options.chunk_size) {
+      if (free_chunks.empty()) {
+        consume_oldest();
+        if (!status.ok()) {
+          break;
+        }
+      }
+      HostChunk* chunk = free_chunks.back();
+      free_chunks.pop_back();
+      int64_t size = std::min<int64_t>(options.chunk_size,
+                                       *buffer_size - offset);
+      in_flight.push_back(
+          ChunkTransfer{chunk, stream_offset + offset, size,
+                        buffer->CopyRawToHost(chunk->data(), offset, size)});
+    }
+    if (!status.ok()) {
+      break;
+    }
+    stream_offset += *buffer_size;
+  }
+  while (!in_flight.empty()) {
+    consume_oldest();
+  }
+  VLOG(2) << "Streamed " << stream_offset << " bytes of " << buffers.size()
+          << " buffers: " << status;
+  return status;
+}
+
+BufferChunkSink MakeWritableFileSink(tsl::WritableFile* file) {
+  return [file](int64_t offset, absl::Span<const char> data) {
+    return file->Append(absl::string_view(data.data(), data.size()));
+  };
+}
+
+}  // namespace xla
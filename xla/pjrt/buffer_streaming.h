@@ -0,0 +1,64 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_PJRT_BUFFER_STREAMING_H_
+#define XLA_PJRT_BUFFER_STREAMING_H_
+
+#include <cstdint>
+
+#include "absl/functional/any_invocable.h"
+#include "absl/status/status.h"
+#include "absl/types/span.h"
+#include "xla/pjrt/pjrt_client.h"
+#include "xla/tsl/platform/file_system.h"
+
+namespace xla {
+
+// Receives the on-device bytes of the streamed buffers, concatenated in the
+// order of the buffers. `offset` is the position of `data` in the
+// concatenation. Chunks are received in order, on the thread that streams the
+// buffers, and `data` is only valid during the call.
+using BufferChunkSink = absl::AnyInvocable<absl::Status(
+    int64_t offset, absl::Span<const char> data)>;
+
+struct BufferStreamingOptions {
+  // The size of the host chunks the buffers are copied through. Every chunk
+  // but the last one of each buffer is that large.
+  int64_t chunk_size = 64 << 20;
+  // The number of host chunks, i.e. of device to host transfers in flight
+  // while a chunk is consumed by the sink.
+  int num_chunks = 4;
+  // The alignment of the host chunks, e.g. for files opened with O_DIRECT.
+  int64_t chunk_alignment = 4096;
+};
+
+// Streams the on-device bytes of `buffers` to `sink` through a pool of pinned
+// host chunks, e.g. to write a checkpoint without ever holding a full host copy
+// of the buffers. Device to host transfers of the next chunks overlap with the
+// consumption of the current one by the sink.
+//
+// The chunks are registered with PjRtClient::DmaMap when the client supports
+// it, and are copied into with PjRtBuffer::CopyRawToHost. Blocks until every
+// chunk was consumed or until the first error, which is returned.
+absl::Status StreamBuffersToSink(absl::Span<PjRtBuffer* const> buffers,
+                                 BufferChunkSink& sink,
+                                 const BufferStreamingOptions& options = {});
+
+// Returns a sink appending the chunks to `file`, which must outlive the sink.
+BufferChunkSink MakeWritableFileSink(tsl::WritableFile* file);
+
+}  // namespace xla
+
+#endif  // XLA_PJRT_BUFFER_STREAMING_H_
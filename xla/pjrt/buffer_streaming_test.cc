@@ -0,0 +1,131 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/pjrt/buffer_streaming.h"
+
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/types/span.h"
+#include "xla/pjrt/pjrt_client.h"
+#include "xla/pjrt/plugin/xla_cpu/cpu_client_options.h"
+#include "xla/pjrt/plugin/xla_cpu/xla_cpu_pjrt_client.h"
+#include "xla/tsl/lib/core/status_test_util.h"
+#include "xla/tsl/platform/env.h"
+#include "xla/tsl/platform/file_system.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/xla_data.pb.h"
+#include "tsl/platform/path.h"
+#include "tsl/platform/test.h"
+
+namespace xla {
+namespace {
+
+class BufferStreamingTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    TF_ASSERT_OK_AND_ASSIGN(client_, GetXlaPjrtCpuClient(CpuClientOptions()));
+  }
+
+  absl::StatusOr<std::unique_ptr<PjRtBuffer>> MakeBuffer(
+      const std::vector<int32_t>& data) {
+    return client_->BufferFromHostBuffer(
+        data.data(), S32, {static_cast<int64_t>(data.size())},
+        /*byte_strides=*/std::nullopt,
+        PjRtClient::HostBufferSemantics::kImmutableOnlyDuringCall, nullptr,
+        client_->memory_spaces()[0], /*device_layout=*/nullptr);
+  }
+
+  std::unique_ptr<PjRtClient> client_;
+};
+
+TEST_F(BufferStreamingTest, StreamsBuffersInChunks) {
+  std::vector<int32_t> a(37);
+  std::iota(a.begin(), a.end(), 0);
+  std::vector<int32_t> b(5);
+  std::iota(b.begin(), b.end(), 100);
+  TF_ASSERT_OK_AND_ASSIGN(auto a_buffer, MakeBuffer(a));
+  TF_ASSERT_OK_AND_ASSIGN(auto b_buffer, MakeBuffer(b));
+
+  std::string streamed;
+  int num_chunks = 0;
+  BufferChunkSink sink = [&](int64_t offset, absl::Span<const char> data) {
+    EXPECT_EQ(offset, streamed.size());
+    streamed.append(data.data(), data.size());
+    ++num_chunks;
+    return absl::OkStatus();
+  };
+  BufferStreamingOptions options;
+  options.chunk_size = 64;
+  options.num_chunks = 2;
+  TF_ASSERT_OK(
+      StreamBuffersToSink({a_buffer.get(), b_buffer.get()}, sink, options));
+
+  std::string expected(reinterpret_cast<const char*>(a.data()),
+                       a.size() * sizeof(int32_t));
+  expected.append(reinterpret_cast<const char*>(b.data()),
+                  b.size() * sizeof(int32_t));
+  EXPECT_EQ(streamed, expected);
+  // 148 bytes in chunks of 64 bytes, then 20 bytes.
+  EXPECT_EQ(num_chunks, 4);
+}
+
+TEST_F(BufferStreamingTest, ReturnsSinkError) {
+  std::vector<int32_t> a(64);
+  TF_ASSERT_OK_AND_ASSIGN(auto a_buffer, MakeBuffer(a));
+
+  int num_chunks = 0;
+  BufferChunkSink sink = [&](int64_t offset, absl::Span<const char> data) {
+    ++num_chunks;
+    return absl::DataLossError("disk full");
+  };
+  BufferStreamingOptions options;
+  options.chunk_size = 16;
+  options.num_chunks = 2;
+  EXPECT_EQ(StreamBuffersToSink({a_buffer.get()}, sink, options),
+            absl::DataLossError("disk full"));
+  EXPECT_EQ(num_chunks, 1);
+}
+
+TEST_F(BufferStreamingTest, WritesToFile) {
+  std::vector<int32_t> a(100);
+  std::iota(a.begin(), a.end(), 0);
+  TF_ASSERT_OK_AND_ASSIGN(auto a_buffer, MakeBuffer(a));
+
+  std::string path =
+      tsl::io::JoinPath(tsl::testing::TmpDir(), "streamed_buffer");
+  std::unique_ptr<tsl::WritableFile> file;
+  TF_ASSERT_OK(tsl::Env::Default()->NewWritableFile(path, &file));
+  BufferChunkSink sink = MakeWritableFileSink(file.get());
+  BufferStreamingOptions options;
+  options.chunk_size = 128;
+  TF_ASSERT_OK(StreamBuffersToSink({a_buffer.get()}, sink, options));
+  TF_ASSERT_OK(file->Close());
+
+  std::string contents;
+  TF_ASSERT_OK(tsl::ReadFileToString(tsl::Env::Default(), path, &contents));
+  EXPECT_EQ(contents, std::string(reinterpret_cast<const char*>(a.data()),
+                                  a.size() * sizeof(int32_t)));
+}
+
+}  // namespace
+}  // namespace xla
@@ -80,6 +80,7 @@ PJRT_Error* PJRT_Client_Create(PJRT_Client_Create_Args* args) {
           {"allocator", PJRT_NamedValue_Type::PJRT_NamedValue_kString},
           {"memory_fraction", PJRT_NamedValue_Type::PJRT_NamedValue_kFloat},
           {"preallocate", PJRT_NamedValue_Type::PJRT_NamedValue_kBool},
+          {"release_threshold", PJRT_NamedValue_Type::PJRT_NamedValue_kInt64},
           {"collective_memory_size",
            PJRT_NamedValue_Type::PJRT_NamedValue_kInt64},
           {"visible_devices", PJRT_NamedValue_Type::PJRT_NamedValue_kInt64List},
@@ -126,6 +127,10 @@ PJRT_Error* PJRT_Client_Create(PJRT_Client_Create_Args* args) {
       it != create_options.end()) {
     allocator_config.preallocate = std::get<bool>(it->second);
   }
+  if (auto it = create_options.find("release_threshold");
+      it != create_options.end()) {
+    allocator_config.release_threshold = std::get<int64_t>(it->second);
+  }
   if (auto it = create_options.find("collective_memory_size");
       it != create_options.end()) {
     allocator_config.collective_memory_size = std::get<int64_t>(it->second);
@@ -0,0 +1,57 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/pjrt/compile_cache.h"
+
+#include <optional>
+#include <string>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/time/clock.h"
+#include "xla/tsl/platform/env.h"
+#include "xla/tsl/platform/errors.h"
+#include "tsl/platform/path.h"
+
+namespace xla {
+
+absl::StatusOr<std::optional<std::string>> FileSystemPjRtCompileCache::Get(
+    absl::string_view key) {
+  tsl::Env* env = tsl::Env::Default();
+  std::string file_path = tsl::io::JoinPath(directory_, key);
+  if (!env->FileExists(file_path).ok()) {
+    return std::nullopt;
+  }
+  std::string value;
+  TF_RETURN_IF_ERROR(tsl::ReadFileToString(env, file_path, &value));
+  return value;
+}
+
+absl::Status FileSystemPjRtCompileCache::Put(absl::string_view key,
+                                             absl::string_view value) {
+  tsl::Env* env = tsl::Env::Default();
+  // Write to a temporary file first and rename it, so that concurrent readers
+  // never see a partially written executable.
+  std::string tmp_dir = tsl::io::JoinPath(directory_, "tmp");
+  TF_RETURN_IF_ERROR(env->RecursivelyCreateDir(tmp_dir));
+  std::string tmp_file_path = tsl::io::JoinPath(
+      tmp_dir, absl::StrCat(key, "_", absl::GetCurrentTimeNanos()));
+  TF_RETURN_IF_ERROR(tsl::WriteStringToFile(env, tmp_file_path, value));
+  return env->RenameFile(tmp_file_path, tsl::io::JoinPath(directory_, key));
+}
+
+}  // namespace xla
@@ -0,0 +1,70 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_PJRT_COMPILE_CACHE_H_
+#define XLA_PJRT_COMPILE_CACHE_H_
+
+#include <optional>
+#include <string>
+#include <utility>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+
+namespace xla {
+
+// Cache of serialized executables in front of the compilation of a PjRtClient,
+// so that a program compiled once is loaded from the cache by every later
+// process using the same cache instead of being compiled again.
+//
+// Keys are computed by the client from the program, the compile options and
+// the platform. Implementations only store and return opaque values, e.g. in
+// files or in a remote blob store.
+//
+// All methods must be thread safe. Errors are not fatal: the client logs them
+// and compiles the program.
+class PjRtCompileCache {
+ public:
+  virtual ~PjRtCompileCache() = default;
+
+  // Returns the serialized executable stored under `key`, or std::nullopt if
+  // there is none.
+  virtual absl::StatusOr<std::optional<std::string>> Get(
+      absl::string_view key) = 0;
+
+  // Stores the serialized executable `value` under `key`.
+  virtual absl::Status Put(absl::string_view key, absl::string_view value) = 0;
+};
+
+// Stores every executable in a file named after its key in a directory. Any
+// file system supported by tsl::Env can be used, e.g. a local directory or a
+// GCS bucket.
+class FileSystemPjRtCompileCache : public PjRtCompileCache {
+ public:
+  explicit FileSystemPjRtCompileCache(std::string directory)
+      : directory_(std::move(directory)) {}
+
+  absl::StatusOr<std::optional<std::string>> Get(
+      absl::string_view key) override;
+  absl::Status Put(absl::string_view key, absl::string_view value) override;
+
+ private:
+  std::string directory_;
+};
+
+}  // namespace xla
+
+#endif  // XLA_PJRT_COMPILE_CACHE_H_
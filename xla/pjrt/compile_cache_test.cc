@@ -0,0 +1,50 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/pjrt/compile_cache.h"
+
+#include <optional>
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "xla/tsl/lib/core/status_test_util.h"
+#include "xla/tsl/platform/statusor.h"
+#include "tsl/platform/path.h"
+#include "tsl/platform/test.h"
+
+namespace xla {
+namespace {
+
+using ::testing::Optional;
+
+TEST(FileSystemPjRtCompileCacheTest, PutAndGet) {
+  FileSystemPjRtCompileCache cache(
+      tsl::io::JoinPath(tsl::testing::TmpDir(), "compile_cache"));
+  TF_ASSERT_OK_AND_ASSIGN(std::optional<std::string> value, cache.Get("key"));
+  EXPECT_EQ(value, std::nullopt);
+
+  TF_ASSERT_OK(cache.Put("key", "executable"));
+  TF_ASSERT_OK_AND_ASSIGN(value, cache.Get("key"));
+  EXPECT_THAT(value, Optional(std::string("executable")));
+
+  // A later executable replaces the stored one.
+  TF_ASSERT_OK(cache.Put("key", "other executable"));
+  TF_ASSERT_OK_AND_ASSIGN(value, cache.Get("key"));
+  EXPECT_THAT(value, Optional(std::string("other executable")));
+}
+
+}  // namespace
+}  // namespace xla
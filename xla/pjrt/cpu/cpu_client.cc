@@ -131,6 +131,7 @@ limitations under the License.
 #include "tsl/platform/casts.h"
 #include "tsl/platform/denormal.h"
 #include "tsl/platform/fingerprint.h"
+#include "tsl/platform/numa.h"
 #include "tsl/platform/setround.h"
 #include "tsl/profiler/lib/connected_traceme.h"
 #include "tsl/profiler/lib/context_types.h"
@@ -211,11 +212,18 @@ absl::StatusOr<std::unique_ptr<PjRtClient>> GetPjRtCpuClient(
   int cpu_device_count = options.cpu_device_count.value_or(CpuDeviceCount());
   size_t num_threads = std::max(DefaultThreadPoolSize(), cpu_device_count);
 
+  // Assign devices to NUMA nodes in a round-robin fashion.
+  int num_numa_nodes = options.numa_aware && tsl::port::NUMAEnabled()
+                           ? tsl::port::NUMANumNodes()
+                           : 0;
+
   std::vector<std::unique_ptr<PjRtCpuDevice>> devices;
   for (int i = 0; i < cpu_device_count; ++i) {
+    int numa_node =
+        num_numa_nodes > 0 ? i % num_numa_nodes : tsl::port::kNUMANoAffinity;
     auto device = std::make_unique<PjRtCpuDevice>(
         options.process_id, /*local_device_id=*/i,
-        options.max_inflight_computations_per_device);
+        options.max_inflight_computations_per_device, numa_node);
     devices.push_back(std::move(device));
   }
 
@@ -230,13 +238,15 @@ absl::StatusOr<std::unique_ptr<PjRtClient>> GetPjRtCpuClient(
 // intensive operations that are supposed to run inside the intra-op threadpool.
 static const size_t kMaxIntraOpThreads = 256;
 
-static tsl::ThreadOptions GetThreadOptions() {
+static tsl::ThreadOptions GetThreadOptions(
+    int numa_node = tsl::port::kNUMANoAffinity) {
   tsl::ThreadOptions thread_options;
   // On Mac OS the default stack size is 512KiB, which is too small for some
   // BLAS and LAPACK functions (https://github.com/google/jax/issues/20428).
   // On Linux we also observed that 2MB wasn't enough to run some OpenBLAS
   // functions.
   thread_options.stack_size = 8 * 1024 * 1024;
+  thread_options.numa_node = numa_node;
   return thread_options;
 }
 
@@ -280,6 +290,24 @@ PjRtCpuClient::PjRtCpuClient(
                 GetCpuDevices(owned_devices_), cpu::DetectMachineAttributes()),
       asynchronous_(asynchronous),
       customize_hlo_module_config_(std::move(customize_hlo_module_config)) {
+  // Create intra-op thread pools pinned to NUMA nodes. We split the intra-op
+  // threads evenly between NUMA nodes, so that the total number of threads
+  // doesn't exceed the number of threads in the default intra-op pool.
+  int num_numa_nodes = 0;
+  for (const std::unique_ptr<PjRtCpuDevice>& device : owned_devices_) {
+    num_numa_nodes = std::max(num_numa_nodes, device->numa_node() + 1);
+  }
+  for (int node = 0; node < num_numa_nodes; ++node) {
+    size_t num_node_threads = std::max<size_t>(
+        1, eigen_intraop_pool_->NumThreads() / num_numa_nodes);
+    numa_intraop_pools_.push_back(std::make_unique<tsl::thread::ThreadPool>(
+        tsl::Env::Default(), GetThreadOptions(node),
+        absl::StrCat("XLAEigenNuma", node), num_node_threads));
+    numa_intraop_devices_.push_back(std::make_unique<Eigen::ThreadPoolDevice>(
+        numa_intraop_pools_.back()->AsEigenThreadPool(),
+        numa_intraop_pools_.back()->NumThreads()));
+  }
+
   for (const std::unique_ptr<PjRtCpuDevice>& device : owned_devices_) {
     devices_.push_back(device.get());
     CHECK(
@@ -336,6 +364,24 @@ PjRtCpuClient::PjRtCpuClient(
 
 PjRtCpuClient::~PjRtCpuClient() { VLOG(1) << "PjRtCpuClient destroyed."; }
 
+tsl::thread::ThreadPool* PjRtCpuClient::eigen_intraop_pool(
+    const PjRtCpuDevice* device) const {
+  int numa_node = device->numa_node();
+  if (numa_node == tsl::port::kNUMANoAffinity) {
+    return eigen_intraop_pool_.get();
+  }
+  return numa_intraop_pools_[numa_node].get();
+}
+
+Eigen::ThreadPoolDevice* PjRtCpuClient::eigen_intraop_device(
+    const PjRtCpuDevice* device) const {
+  int numa_node = device->numa_node();
+  if (numa_node == tsl::port::kNUMANoAffinity) {
+    return eigen_intraop_device_.get();
+  }
+  return numa_intraop_devices_[numa_node].get();
+}
+
 absl::StatusOr<PjRtDevice*> PjRtCpuClient::LookupDevice(
     xla::PjRtGlobalDeviceId global_device_id) const {
   auto it = id_to_device_.find(global_device_id);
@@ -956,11 +1002,20 @@ PjRtCpuClient::LinearizeHostBufferInto(
     absl::AnyInvocable<void() &&> on_done_with_host_buffer,
     const xla::Shape& device_shape,
     tsl::RCReference<CommonPjRtRawBuffer> raw_buffer) {
+  // For devices bound to a NUMA node run transposes on the node-local intra-op
+  // thread pool, so that the destination buffer is written from its own node.
+  auto* device = tsl::down_cast<PjRtCpuDevice*>(
+      raw_buffer->memory_space()->devices()[0]);
+  tsl::thread::ThreadPool* transpose_pool =
+      device->numa_node() != tsl::port::kNUMANoAffinity
+          ? eigen_intraop_pool(device)
+          : nullptr;
   return tsl::down_cast<CpuRawBuffer*>(raw_buffer.get())
       ->CopyFromHostBuffer(
           data, type, dims, byte_strides, host_buffer_semantics,
           std::move(on_done_with_host_buffer), device_shape,
-          async_work_runner(), &transpose_mu_, &transpose_cache_);
+          async_work_runner(), &transpose_mu_, &transpose_cache_,
+          transpose_pool);
 }
 
 absl::StatusOr<tsl::RCReference<PjRtDeviceEvent>> PjRtCpuClient::LinearizeInto(
@@ -1010,7 +1065,9 @@ PjRtCpuClient::AllocateRawBuffer(PjRtMemorySpace* memory_space,
                                  tsl::AsyncValueRef<bool> allocate_after) {
   CHECK(allocate_after == nullptr) << "allocate_after is not supported for "
                                       "PjRtCpuClient.";
-  return xla::CpuRawBuffer::Allocate(memory_space, on_device_bytes_count);
+  auto* device = tsl::down_cast<PjRtCpuDevice*>(memory_space->devices()[0]);
+  return xla::CpuRawBuffer::Allocate(memory_space, on_device_bytes_count,
+                                     device->numa_node());
 }
 
 absl::StatusOr<int64_t> PjRtCpuClient::GetOnDeviceBytesCount(
@@ -1122,6 +1179,17 @@ PjRtCpuExecutable::PjRtCpuExecutable(
 
   const auto& computation_layout =
       cpu_executable_->module().entry_computation_layout();
+  // Cache properties of the module that do not change between executions, to
+  // keep them off the execute critical path. Checking whether dumping is
+  // enabled canonicalizes the debug options, which is expensive relative to the
+  // launch of a small computation.
+  result_is_tuple_ = computation_layout.result_shape().IsTuple();
+  dump_hlo_snapshots_ =
+      cpu_executable_->module()
+          .config()
+          .debug_options()
+          .xla_dump_hlo_snapshots() &&
+      DumpingEnabledForHloModule(cpu_executable_->module());
   if (computation_layout.parameter_count() == 0) {
     return;
   }
@@ -1177,11 +1245,13 @@ struct BufferAlloc {
   // All data members should have the same size.
   absl::InlinedVector<tsl::AsyncValueRef<CpuDeviceMemory>, 4> buffers;
   absl::InlinedVector<size_t, 4> allocation_sizes;
+  // NUMA node to allocate buffers on.
+  int numa_node = tsl::port::kNUMANoAffinity;
 
   void Allocate() {
     for (int i = 0; i < buffers.size(); ++i) {
-      auto status = CpuDeviceMemory::AllocateInto(allocation_sizes[i],
-                                                  buffers[i].AsPtr());
+      auto status = CpuDeviceMemory::AllocateInto(
+          allocation_sizes[i], buffers[i].AsPtr(), numa_node);
       if (!status.ok()) {
         buffers[i].SetError(status);
         return;
@@ -1197,11 +1267,13 @@ struct BufferAllocAndCopy {
   absl::InlinedVector<tsl::AsyncValueRef<CpuDeviceMemory>, 4> src_buffers;
   absl::InlinedVector<tsl::AsyncValueRef<CpuDeviceMemory>, 4> dst_buffers;
   absl::InlinedVector<size_t, 4> allocation_sizes;
+  // NUMA node to allocate destination buffers on.
+  int numa_node = tsl::port::kNUMANoAffinity;
 
   void AllocateAndCopy() {
     for (int i = 0; i < src_buffers.size(); ++i) {
-      auto status = CpuDeviceMemory::AllocateInto(allocation_sizes[i],
-                                                  dst_buffers[i].AsPtr());
+      auto status = CpuDeviceMemory::AllocateInto(
+          allocation_sizes[i], dst_buffers[i].AsPtr(), numa_node);
       if (!status.ok()) {
         dst_buffers[i].SetError(status);
         return;
@@ -1419,9 +1491,13 @@ absl::StatusOr<PjRtLoadedExecutable::Result> PjRtCpuExecutable::ExecuteHelper(
 
   auto donate_it = parameters_that_must_be_donated_.begin();
 
-  // State for `TestBufferDonationClashes`.
+  // State for `TestBufferDonationClashes`. If the executable has no parameters
+  // that must be donated there can be no clashes, and we skip building the map.
+  const bool check_donation_clashes = !parameters_that_must_be_donated_.empty();
   absl::flat_hash_map<const void*, std::pair<bool, int>> donation_clashes;
-  donation_clashes.reserve(argument_handles.size());
+  if (check_donation_clashes) {
+    donation_clashes.reserve(argument_handles.size());
+  }
   for (int i = 0; i < argument_handles.size(); ++i) {
     PjRtBuffer* handle = argument_handles[i];
     auto* cpu_buffer = tsl::down_cast<PjRtCpuBuffer*>(handle);
@@ -1437,8 +1513,10 @@ absl::StatusOr<PjRtLoadedExecutable::Result> PjRtCpuExecutable::ExecuteHelper(
     auto get_buffer = [&](int i) -> absl::Status {
       bool must_donate = donate_it != parameters_that_must_be_donated_.end() &&
                          *donate_it == i;
-      TF_RETURN_IF_ERROR(TestBufferDonationClashes(
-          cpu_buffer, donation_clashes, must_donate, i, replica, partition));
+      if (check_donation_clashes) {
+        TF_RETURN_IF_ERROR(TestBufferDonationClashes(
+            cpu_buffer, donation_clashes, must_donate, i, replica, partition));
+      }
       if (must_donate) {
         ++donate_it;
         PjRtCpuBuffer::ScopedHold donation_transaction =
@@ -1517,6 +1595,8 @@ absl::StatusOr<PjRtLoadedExecutable::Result> PjRtCpuExecutable::ExecuteHelper(
   // allocation and copy work.
   BufferAlloc buffer_alloc;
   BufferAllocAndCopy buffer_alloc_and_copy;
+  buffer_alloc.numa_node = device->numa_node();
+  buffer_alloc_and_copy.numa_node = device->numa_node();
   TF_ASSIGN_OR_RETURN(
       std::vector<BufferInfo> buffer_table,
       CreateBufferTable(cpu_executable->buffer_assignment(),
@@ -1538,7 +1618,18 @@ absl::StatusOr<PjRtLoadedExecutable::Result> PjRtCpuExecutable::ExecuteHelper(
   run_options.set_run_id(run_id);
   // Need to keep device_assignment alive until execution completes.
   run_options.set_device_assignment(device_assignment.get());
-  run_options.set_intra_op_thread_pool(client_->eigen_intraop_device());
+  // Run on a device with a smaller thread budget over the same intra-op pool
+  // if the execution asks for a limited parallelism.
+  Eigen::ThreadPoolDevice* intra_op_device =
+      client_->eigen_intraop_device(device);
+  std::shared_ptr<Eigen::ThreadPoolDevice> limited_intra_op_device;
+  if (options.max_intra_op_parallelism > 0 &&
+      options.max_intra_op_parallelism < intra_op_device->numThreads()) {
+    limited_intra_op_device = std::make_shared<Eigen::ThreadPoolDevice>(
+        intra_op_device->getPool(), options.max_intra_op_parallelism);
+    intra_op_device = limited_intra_op_device.get();
+  }
+  run_options.set_intra_op_thread_pool(intra_op_device);
 
   auto cpu_run_options = std::make_shared<cpu::CpuExecutableRunOptions>();
   run_options.set_cpu_executable_run_options(cpu_run_options.get());
@@ -1723,7 +1814,8 @@ absl::StatusOr<PjRtLoadedExecutable::Result> PjRtCpuExecutable::ExecuteHelper(
          donation_transactions = std::move(donation_transactions),
          scoped_async_execution = std::move(scoped_async_execution),
          input_deps_avs = std::move(input_deps_avs_copy),
-         eigen_device = client()->eigen_intraop_device()]() mutable {
+         limited_intra_op_device = std::move(limited_intra_op_device),
+         eigen_device = client()->eigen_intraop_device(device)]() mutable {
           // Because `input_deps` contains the definition events of all inputs,
           // when it is ready, all input buffers must have been allocated. So,
           // we are safe to allocate and copy memory here. Since `execute_event`
@@ -1887,16 +1979,10 @@ absl::StatusOr<PjRtLoadedExecutable::Result> PjRtCpuExecutable::ExecuteHelper(
   return Result({/*future=*/std::move(future), /*buffers=*/std::move(res)});
 }
 
-static void MaybeDumpHloSnapshot(
+static void DumpHloSnapshot(
     const HloModule& module, RunId run_id,
     const std::vector<PjRtBuffer*>& arguments,
     const std::vector<std::unique_ptr<PjRtBuffer>>& results) {
-  if (!DumpingEnabledForHloModule(module)) {
-    return;
-  }
-  if (!module.config().debug_options().xla_dump_hlo_snapshots()) {
-    return;
-  }
   xla::HloSnapshot hlo_snapshot;
   *hlo_snapshot.mutable_hlo()->mutable_hlo_module() = module.ToProto();
 
@@ -1930,11 +2016,7 @@ PjRtCpuExecutable::Execute(
   tsl::profiler::TraceMeProducer activity("PjRtCpuExecutable::Execute",
                                           tsl::profiler::ContextType::kPjRt,
                                           run_id.ToInt());
-  if (!options.untuple_result && cpu_executable_->module()
-                                     .config()
-                                     .entry_computation_layout()
-                                     .result_shape()
-                                     .IsTuple()) {
+  if (!options.untuple_result && result_is_tuple_) {
     return InvalidArgument(
         "Tuple results must be untupled using ExecuteOptions::untuple_result.");
   }
@@ -1968,8 +2050,10 @@ PjRtCpuExecutable::Execute(
     const int partition = addressable_device_logical_ids_[0].partition;
 
     // Dump once before running, in case there's a crash.
-    MaybeDumpHloSnapshot(cpu_executable_->module(), run_id, argument_handles[0],
-                         {});
+    if (dump_hlo_snapshots_) {
+      DumpHloSnapshot(cpu_executable_->module(), run_id, argument_handles[0],
+                      {});
+    }
     auto statusor = ExecuteHelper(
         argument_handles[0], replica, partition, run_id, options,
         /*last_collective_launch_event=*/{}, returned_futures.has_value());
@@ -1983,8 +2067,10 @@ PjRtCpuExecutable::Execute(
       (*returned_futures)[0] = std::move(*statusor->future);
     }
 
-    MaybeDumpHloSnapshot(cpu_executable_->module(), run_id, argument_handles[0],
-                         wrapped_results[0]);
+    if (dump_hlo_snapshots_) {
+      DumpHloSnapshot(cpu_executable_->module(), run_id, argument_handles[0],
+                      wrapped_results[0]);
+    }
   } else {
     // Gang schedule collectives to ensure that collectives with the same RunId
     // are run at the same time. We conservatively run only one collective at a
@@ -2059,11 +2145,7 @@ PjRtCpuExecutable::ExecuteSharded(
   if (device_assignment_ == nullptr) {
     return InvalidArgument("ExecuteShard expects a non-null device_assignment");
   }
-  if (!options.untuple_result && cpu_executable_->module()
-                                     .config()
-                                     .entry_computation_layout()
-                                     .result_shape()
-                                     .IsTuple()) {
+  if (!options.untuple_result && result_is_tuple_) {
     return InvalidArgument(
         "Tuple results must be untupled using ExecuteOptions::untuple_result.");
   }
@@ -174,6 +174,14 @@ class PjRtCpuClient final : public CommonPjRtClient {
     return eigen_intraop_device_.get();
   }
 
+  // Returns the intra-op thread pool (and the corresponding Eigen device) for
+  // running computations on `device`. If the device is bound to a NUMA node,
+  // returns a thread pool pinned to that node.
+  tsl::thread::ThreadPool* eigen_intraop_pool(
+      const PjRtCpuDevice* device) const;
+  Eigen::ThreadPoolDevice* eigen_intraop_device(
+      const PjRtCpuDevice* device) const;
+
   // Returns a pair of async events:
   // - async event that signals the completion of the last collective launch
   // - count down event that must be signalled when each rank completes
@@ -283,6 +291,11 @@ class PjRtCpuClient final : public CommonPjRtClient {
   std::unique_ptr<tsl::thread::ThreadPool> eigen_intraop_pool_;
   std::unique_ptr<Eigen::ThreadPoolDevice> eigen_intraop_device_;
 
+  // Intra-op thread pools pinned to NUMA nodes, indexed by NUMA node. Empty if
+  // none of the devices is bound to a NUMA node.
+  std::vector<std::unique_ptr<tsl::thread::ThreadPool>> numa_intraop_pools_;
+  std::vector<std::unique_ptr<Eigen::ThreadPoolDevice>> numa_intraop_devices_;
+
   // Thread pool for running PjRtClient tasks.
   std::unique_ptr<tsl::thread::ThreadPool> pjrt_client_thread_pool_;
   std::unique_ptr<AsyncWorkRunner> async_work_runner_;
@@ -527,6 +540,10 @@ class PjRtCpuExecutable final : public PjRtLoadedExecutable {
   // critical path.
   bool cheap_computation_;
 
+  // Cached properties of the entry computation for execute critical path.
+  bool result_is_tuple_ = false;
+  bool dump_hlo_snapshots_ = false;
+
   std::string fingerprint_;
 };
 
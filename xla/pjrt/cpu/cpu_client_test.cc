@@ -39,6 +39,7 @@ limitations under the License.
 #include "xla/literal.h"
 #include "xla/literal_util.h"
 #include "xla/pjrt/cpu/cpu_client.h"
+#include "xla/pjrt/cpu/cpu_device.h"
 #include "xla/pjrt/host_memory_spaces.h"
 #include "xla/pjrt/pjrt_client.h"
 #include "xla/pjrt/pjrt_executable.h"
@@ -60,6 +61,11 @@ limitations under the License.
 #include "xla/types.h"
 #include "xla/util.h"
 #include "xla/xla_data.pb.h"
+#include "tsl/platform/casts.h"
+#include "tsl/platform/numa.h"
+
+#define EIGEN_USE_THREADS
+#include "unsupported/Eigen/CXX11/Tensor"
 
 namespace xla {
 namespace {
@@ -135,6 +141,43 @@ TEST(PjRtCpuClientTest, LegacyMemorySpace) {
   }
 }
 
+TEST(PjRtCpuClientTest, NumaAware) {
+  CpuClientOptions options;
+  options.cpu_device_count = 4;
+  options.numa_aware = true;
+  TF_ASSERT_OK_AND_ASSIGN(auto client, GetPjRtCpuClient(std::move(options)));
+  ASSERT_EQ(client->devices().size(), 4);
+
+  for (auto* device : client->devices()) {
+    int numa_node = tsl::down_cast<PjRtCpuDevice*>(device)->numa_node();
+    if (tsl::port::NUMAEnabled()) {
+      EXPECT_EQ(numa_node, device->local_hardware_id().value() %
+                               tsl::port::NUMANumNodes());
+    } else {
+      EXPECT_EQ(numa_node, tsl::port::kNUMANoAffinity);
+    }
+  }
+
+  // Transfer a column-major array to every device to exercise the transpose
+  // on a (potentially) NUMA-local thread pool.
+  std::vector<int32_t> data = {1, 4, 2, 5, 3, 6};
+  std::vector<int64_t> byte_strides = {sizeof(int32_t), 2 * sizeof(int32_t)};
+  Shape shape = ShapeUtil::MakeShape(S32, {2, 3});
+  for (auto* device : client->addressable_devices()) {
+    TF_ASSERT_OK_AND_ASSIGN(auto* memory_space, device->default_memory_space());
+    TF_ASSERT_OK_AND_ASSIGN(
+        auto buffer,
+        client->BufferFromHostBuffer(
+            data.data(), shape.element_type(), shape.dimensions(),
+            byte_strides,
+            PjRtClient::HostBufferSemantics::kImmutableOnlyDuringCall, nullptr,
+            memory_space, /*device_layout=*/nullptr));
+    TF_ASSERT_OK_AND_ASSIGN(auto literal, buffer->ToLiteralSync());
+    EXPECT_TRUE(LiteralTestUtil::Equal(
+        LiteralUtil::CreateR2<int32_t>({{1, 2, 3}, {4, 5, 6}}), *literal));
+  }
+}
+
 TEST(PjRtCpuClientTest, DonationWithExecutionError) {
   static constexpr char kProgram[] =
       R"(
@@ -273,6 +316,40 @@ TEST(PjRtCpuClientTest, AsyncTransferRawData) {
   EXPECT_THAT(literal->data<uint32_t>(), Each(0x42424242));
 }
 
+TEST(PjRtCpuClientTest, AsyncTransferRawDataInChunks) {
+  TF_ASSERT_OK_AND_ASSIGN(auto client, GetPjRtCpuClient(CpuClientOptions()));
+  xla::Shape shape = ShapeUtil::MakeShape(U32, {4, 256});
+  TF_ASSERT_OK_AND_ASSIGN(auto transfer_manager,
+                          client->CreateBuffersForAsyncHostToDevice(
+                              {shape}, client->memory_spaces()[0]));
+  auto buffer = transfer_manager->RetrieveBuffer(0);
+  TF_ASSERT_OK_AND_ASSIGN(std::uintptr_t buffer_ptr,
+                          client->UnsafeBufferPointer(buffer.get()));
+  auto ready_future = buffer->GetReadyFuture();
+
+  // Stream one row at a time. The buffer must stay unavailable until the last
+  // chunk arrives, and chunks must land in the memory backing the buffer.
+  constexpr int64_t kChunkSize = 256 * sizeof(uint32_t);
+  std::vector<uint32_t> row(256);
+  for (int64_t i = 0; i < 4; ++i) {
+    std::fill(row.begin(), row.end(), i);
+    EXPECT_THAT(ready_future.IsReady(), IsFalse());
+    TF_ASSERT_OK(transfer_manager->TransferRawDataToSubBuffer(
+        0, row.data(), i * kChunkSize, kChunkSize,
+        /*is_last_transfer=*/i == 3, []() {}));
+    EXPECT_EQ(reinterpret_cast<const uint32_t*>(buffer_ptr)[i * 256],
+              static_cast<uint32_t>(i));
+  }
+  TF_ASSERT_OK(ready_future.Await());
+
+  TF_ASSERT_OK_AND_ASSIGN(auto literal, buffer->ToLiteralSync());
+  for (int64_t i = 0; i < 4; ++i) {
+    for (int64_t j = 0; j < 256; ++j) {
+      EXPECT_EQ((literal->Get<uint32_t>({i, j})), static_cast<uint32_t>(i));
+    }
+  }
+}
+
 TEST(PjRtCpuClientTest, AsyncTransferWithSpecs) {
   TF_ASSERT_OK_AND_ASSIGN(auto client, GetPjRtCpuClient(CpuClientOptions()));
   PjRtClient::ShapeSpec shape_spec{U32, {3, 2}};
@@ -769,6 +846,49 @@ TEST(PjRtCpuClientTest, PassAttrToFfiHandler) {
       LiteralUtil::CreateR1<float>({3.0f, 3.0f, 3.0f, 3.0f}), *result_literal));
 }
 
+static absl::Status IntraOpNumThreads(
+    const Eigen::ThreadPoolDevice* device,
+    ffi::Result<ffi::BufferR0<PrimitiveType::S32>> result) {
+  *result->typed_data() = device->numThreads();
+  return absl::OkStatus();
+}
+
+XLA_FFI_DEFINE_HANDLER(kIntraOpNumThreads, IntraOpNumThreads,
+                       ffi::Ffi::Bind()
+                           .Ctx<ffi::IntraOpThreadPool>()
+                           .Ret<ffi::BufferR0<PrimitiveType::S32>>());
+
+XLA_FFI_REGISTER_HANDLER(ffi::GetXlaFfiApi(), "IntraOpNumThreads", "HOST",
+                         kIntraOpNumThreads);
+
+TEST(PjRtCpuClientTest, MaxIntraOpParallelism) {
+  static constexpr char const* kProgram = R"(
+    HloModule ffi_handler
+    ENTRY main {
+      ROOT %custom-call = s32[] custom-call(),
+                          custom_call_target="IntraOpNumThreads",
+                          api_version=API_VERSION_TYPED_FFI
+    })";
+
+  TF_ASSERT_OK_AND_ASSIGN(auto client, GetPjRtCpuClient(CpuClientOptions()));
+
+  TF_ASSERT_OK_AND_ASSIGN(auto hlo_module,
+                          ParseAndReturnUnverifiedModule(kProgram, {}));
+  XlaComputation xla_computation(hlo_module->ToProto());
+  TF_ASSERT_OK_AND_ASSIGN(auto executable,
+                          client->CompileAndLoad(xla_computation, {}));
+
+  ExecuteOptions opts;
+  opts.max_intra_op_parallelism = 1;
+  TF_ASSERT_OK_AND_ASSIGN(auto result,
+                          executable->Execute(/*argument_handles=*/{{}}, opts));
+
+  TF_ASSERT_OK_AND_ASSIGN(std::shared_ptr<xla::Literal> result_literal,
+                          result.at(0).at(0)->ToLiteralSync());
+  EXPECT_TRUE(LiteralTestUtil::Equal(LiteralUtil::CreateR0<int32_t>(1),
+                                     *result_literal));
+}
+
 TEST(PjRtCpuClientTest, CopyRawToHost) {
   TF_ASSERT_OK_AND_ASSIGN(auto client, GetPjRtCpuClient(CpuClientOptions()));
   xla::Shape shape = ShapeUtil::MakeShape(U32, {3, 2});
@@ -36,11 +36,12 @@ limitations under the License.
 namespace xla {
 
 PjRtCpuDevice::PjRtCpuDevice(int process_id, int local_device_id,
-                             int max_inflight_computations)
+                             int max_inflight_computations, int numa_node)
     : description_(process_id, local_device_id),
       max_inflight_computations_semaphore_(
           /*capacity=*/max_inflight_computations),
-      async_execution_tracker_(std::make_unique<CpuAsyncExecutionTracker>()) {}
+      async_execution_tracker_(std::make_unique<CpuAsyncExecutionTracker>()),
+      numa_node_(numa_node) {}
 
 absl::Status PjRtCpuDevice::TransferToInfeed(const LiteralSlice& literal) {
   return TransferLiteralToInfeedOnCpu(local_hardware_id().value(), literal);
@@ -33,13 +33,15 @@ limitations under the License.
 #include "xla/pjrt/pjrt_future.h"
 #include "xla/pjrt/plugin/xla_cpu/cpu_device_description.h"
 #include "xla/pjrt/semaphore.h"
+#include "tsl/platform/numa.h"
 
 namespace xla {
 
 class PjRtCpuDevice final : public PjRtDevice {
  public:
   explicit PjRtCpuDevice(int process_id, int local_device_id,
-                         int max_inflight_computations = 32);
+                         int max_inflight_computations = 32,
+                         int numa_node = tsl::port::kNUMANoAffinity);
 
   const CpuDeviceDescription& description() const override {
     return description_;
@@ -96,6 +98,11 @@ class PjRtCpuDevice final : public PjRtDevice {
     return async_execution_tracker_.get();
   }
 
+  // NUMA node this device is bound to, or `kNUMANoAffinity` if the device is
+  // not bound to any particular node. Computations run on a node-local
+  // intra-op thread pool, and device buffers are allocated on this node.
+  int numa_node() const { return numa_node_; }
+
  private:
   PjRtClient* client_ = nullptr;
   CpuDeviceDescription description_;
@@ -108,6 +115,8 @@ class PjRtCpuDevice final : public PjRtDevice {
   Semaphore max_inflight_computations_semaphore_;
 
   std::unique_ptr<CpuAsyncExecutionTracker> async_execution_tracker_;
+
+  int numa_node_;
 };
 
 }  // namespace xla
@@ -18,6 +18,7 @@ limitations under the License.
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <utility>
@@ -26,6 +27,7 @@ limitations under the License.
 #include "absl/base/casts.h"
 #include "absl/container/inlined_vector.h"
 #include "absl/functional/any_invocable.h"
+#include "absl/functional/function_ref.h"
 #include "absl/log/check.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -102,8 +104,10 @@ void CpuTrackedDeviceEvent::AndThen(absl::AnyInvocable<void() &&> cb) {
 }
 
 /*static*/ absl::StatusOr<tsl::RCReference<CpuRawBuffer>>
-CpuRawBuffer::Allocate(PjRtMemorySpace* memory_space, size_t size_bytes) {
-  TF_ASSIGN_OR_RETURN(auto memory, CpuDeviceMemory::Allocate(size_bytes));
+CpuRawBuffer::Allocate(PjRtMemorySpace* memory_space, size_t size_bytes,
+                       int numa_node) {
+  TF_ASSIGN_OR_RETURN(auto memory,
+                      CpuDeviceMemory::Allocate(size_bytes, numa_node));
   return tsl::MakeRef<CpuRawBuffer>(memory_space, std::move(memory));
 }
 
@@ -199,7 +203,8 @@ CpuRawBuffer::CopyFromHostBuffer(
     PjRtClient::HostBufferSemantics host_buffer_semantics,
     absl::AnyInvocable<void() &&> on_done_with_host_buffer, const Shape& shape,
     AsyncWorkRunner* async_work_runner, absl::Mutex* transpose_mu,
-    TransposePlanCache* transpose_cache) {
+    TransposePlanCache* transpose_cache,
+    tsl::thread::ThreadPool* transpose_pool) {
   tsl::AsyncValueRef<CpuDeviceMemory> device_buffer = buffer_;
   bool has_default_layout =
       !byte_strides || HasMajorToMinorLayout(type, dims, *byte_strides);
@@ -213,12 +218,21 @@ CpuRawBuffer::CopyFromHostBuffer(
     byte_size *= 8 / bit_width;
   }
   auto dst_data_ptr = device_buffer->untyped_data();
-  if (!has_default_layout || is_packed) {
+  if (has_default_layout && is_packed) {
+    // The data is already in major-to-minor order, so pack it straight into
+    // the device buffer instead of copying it through an identity transpose.
+    PackIntN(bit_width,
+             absl::MakeConstSpan(static_cast<const char*>(data), byte_size),
+             absl::MakeSpan(static_cast<char*>(dst_data_ptr), dst_byte_size));
+    if (on_done_with_host_buffer) {
+      std::move(on_done_with_host_buffer)();
+      on_done_with_host_buffer = nullptr;
+    }
+  } else if (!has_default_layout) {
     // If the input array does not have a major-to-minor layout, transpose it
     // into major-to-minor layout. Currently we choose to always do this
     // synchronously.
     // TODO(phawkins): consider performing the transpose asynchronously.
-    // TODO(phawkins): parallelize the transpose.
     std::shared_ptr<TransposePlan> transpose;
     {
       absl::InlinedVector<int64_t, 4> permutation(dims.size());
@@ -230,18 +244,31 @@ CpuRawBuffer::CopyFromHostBuffer(
       if (byte_strides) {
         options.input_layout = TransposePlan::Striding{*byte_strides};
       }
+      if (transpose_pool) {
+        options.num_threads = transpose_pool->NumThreads();
+      }
       absl::MutexLock lock(transpose_mu);
       TF_ASSIGN_OR_RETURN(transpose, transpose_cache->GetOrCreate(options));
     }
+    // Parallel transposes run on `transpose_pool` threads, which for NUMA
+    // bound devices are pinned to the node that owns the destination buffer.
+    auto schedule_work = [&](std::function<void()> fn) {
+      transpose_pool->Schedule(std::move(fn));
+    };
+    std::optional<absl::FunctionRef<void(std::function<void()>)>>
+        transpose_schedule_work;
+    if (transpose_pool) {
+      transpose_schedule_work = schedule_work;
+    }
     if (!is_packed) {
-      transpose->Execute(data, dst_data_ptr);
+      transpose->Execute(data, dst_data_ptr, transpose_schedule_work);
     } else {
       // First transpose the unpacked data into a new temporary buffer, then
       // pack the data.
       // TODO(reedwm): Fuse the transpose and packing by having TransposePlan
       // support packing.
       auto data_transposed = std::make_unique<char[]>(byte_size);
-      transpose->Execute(data, data_transposed.get());
+      transpose->Execute(data, data_transposed.get(), transpose_schedule_work);
       absl::Span<const char> src_data_span(data_transposed.get(), byte_size);
       absl::Span<char> dst_data_span(static_cast<char*>(dst_data_ptr),
                                      dst_byte_size);
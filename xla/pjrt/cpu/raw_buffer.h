@@ -37,7 +37,9 @@ limitations under the License.
 #include "xla/tsl/concurrency/async_value.h"
 #include "xla/tsl/concurrency/async_value_ref.h"
 #include "xla/tsl/concurrency/ref_count.h"
+#include "xla/tsl/platform/threadpool.h"
 #include "xla/xla_data.pb.h"
+#include "tsl/platform/numa.h"
 
 namespace xla {
 
@@ -104,9 +106,11 @@ class CpuRawBuffer : public CommonPjRtRawBuffer {
 
   absl::Status ValidateSlice(int64_t offset, int64_t slice_size);
 
-  // Allocates owning memory.
+  // Allocates owning memory. If `numa_node` is not `kNUMANoAffinity`, memory
+  // is bound to the given NUMA node.
   static absl::StatusOr<tsl::RCReference<CpuRawBuffer>> Allocate(
-      PjRtMemorySpace* memory_space, size_t size_bytes);
+      PjRtMemorySpace* memory_space, size_t size_bytes,
+      int numa_node = tsl::port::kNUMANoAffinity);
 
   // Imports foreign memory.
   static absl::StatusOr<tsl::RCReference<CpuRawBuffer>> ImportForeignMemory(
@@ -135,13 +139,17 @@ class CpuRawBuffer : public CommonPjRtRawBuffer {
   absl::StatusOr<tsl::RCReference<PjRtDeviceEvent>> MakeAllocationReadyEvent()
       override;
 
+  // Copies a host buffer into this buffer. If the host buffer doesn't have a
+  // major-to-minor layout it is transposed synchronously; if `transpose_pool`
+  // is not null, the transpose runs in parallel on its threads.
   absl::StatusOr<tsl::RCReference<PjRtDeviceEvent>> CopyFromHostBuffer(
       const void* data, PrimitiveType type, absl::Span<int64_t const> dims,
       std::optional<absl::Span<int64_t const>> byte_strides,
       PjRtClient::HostBufferSemantics host_buffer_semantics,
       absl::AnyInvocable<void() &&> on_done_with_host_buffer,
       const Shape& shape, AsyncWorkRunner* async_work_runner,
-      absl::Mutex* transpose_mu, TransposePlanCache* transpose_cache);
+      absl::Mutex* transpose_mu, TransposePlanCache* transpose_cache,
+      tsl::thread::ThreadPool* transpose_pool = nullptr);
 
  private:
   PjRtMemorySpace* const memory_space_;
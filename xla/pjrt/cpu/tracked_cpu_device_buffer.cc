@@ -28,6 +28,7 @@ limitations under the License.
 #include "xla/tsl/concurrency/async_value_ref.h"
 #include "xla/util.h"
 #include "tsl/platform/mem.h"
+#include "tsl/platform/numa.h"
 
 namespace xla {
 namespace {
@@ -57,12 +58,22 @@ tsl::AsyncValueRef<CpuEvent> AfterAll(
 
 class CpuDeviceMemoryOwned final : public CpuDeviceMemory {
  public:
-  CpuDeviceMemoryOwned(void* base, size_t size) : CpuDeviceMemory(base, size) {}
+  CpuDeviceMemoryOwned(void* base, size_t size,
+                       int numa_node = tsl::port::kNUMANoAffinity)
+      : CpuDeviceMemory(base, size), numa_node_(numa_node) {}
 
   ~CpuDeviceMemoryOwned() final {
     CHECK_NE(untyped_data(), nullptr);
-    tsl::port::AlignedSizedFree(untyped_data(), cpu::MinAlign(), size_bytes());
+    if (numa_node_ != tsl::port::kNUMANoAffinity) {
+      tsl::port::NUMAFree(untyped_data(), size_bytes());
+    } else {
+      tsl::port::AlignedSizedFree(untyped_data(), cpu::MinAlign(),
+                                  size_bytes());
+    }
   }
+
+ private:
+  int numa_node_;
 };
 
 class CpuDeviceMemoryForeign final : public CpuDeviceMemory {
@@ -103,24 +114,34 @@ tsl::AsyncValueRef<CpuDeviceMemory> CpuDeviceMemory::CreateConstantMemory(
   return tsl::MakeAvailableAsyncValueRef<CpuDeviceMemoryConstant>(base, size);
 }
 
+// Allocates memory with XLA:CPU alignment requirements, optionally bound to the
+// given NUMA node.
+static void* AllocateAligned(size_t size_bytes, int numa_node) {
+  if (numa_node != tsl::port::kNUMANoAffinity) {
+    return tsl::port::NUMAMalloc(numa_node, size_bytes, cpu::MinAlign());
+  }
+  return tsl::port::AlignedMalloc(size_bytes, cpu::MinAlign());
+}
+
 // Allocates owning memory wrapped in an available `AsyncValueRef`.
 absl::StatusOr<tsl::AsyncValueRef<CpuDeviceMemory>> CpuDeviceMemory::Allocate(
-    size_t size_bytes) {
-  if (void* data = tsl::port::AlignedMalloc(size_bytes, cpu::MinAlign())) {
-    return tsl::MakeAvailableAsyncValueRef<CpuDeviceMemoryOwned>(data,
-                                                                 size_bytes);
+    size_t size_bytes, int numa_node) {
+  if (void* data = AllocateAligned(size_bytes, numa_node)) {
+    return tsl::MakeAvailableAsyncValueRef<CpuDeviceMemoryOwned>(
+        data, size_bytes, numa_node);
   }
   return ResourceExhausted("Out of memory allocating %d bytes.", size_bytes);
 }
 
 absl::Status CpuDeviceMemory::AllocateInto(
-    size_t size_bytes, tsl::AsyncValuePtr<CpuDeviceMemory> delayed_memory) {
+    size_t size_bytes, tsl::AsyncValuePtr<CpuDeviceMemory> delayed_memory,
+    int numa_node) {
   auto owned_memory = delayed_memory.DynCast<CpuDeviceMemoryOwned>();
   if (!owned_memory) {
     return Internal("Delayed memory is not a CpuDeviceMemoryOwned");
   }
-  if (void* data = tsl::port::AlignedMalloc(size_bytes, cpu::MinAlign())) {
-    owned_memory.emplace(data, size_bytes);
+  if (void* data = AllocateAligned(size_bytes, numa_node)) {
+    owned_memory.emplace(data, size_bytes, numa_node);
     return absl::OkStatus();
   }
   return ResourceExhausted("Out of memory allocating %d bytes.", size_bytes);
@@ -27,6 +27,7 @@ limitations under the License.
 #include "xla/pjrt/abstract_tracked_device_buffer.h"
 #include "xla/pjrt/cpu/cpu_event.h"
 #include "xla/tsl/concurrency/async_value_ref.h"
+#include "tsl/platform/numa.h"
 
 namespace xla {
 
@@ -57,14 +58,17 @@ class CpuDeviceMemory {
   static tsl::AsyncValueRef<CpuDeviceMemory> CreateConstantMemory(void* base,
                                                                   size_t size);
 
-  // Allocates owning memory wrapped in an available `AsyncValueRef`.
+  // Allocates owning memory wrapped in an available `AsyncValueRef`. If
+  // `numa_node` is not `kNUMANoAffinity`, memory is bound to the given NUMA
+  // node.
   static absl::StatusOr<tsl::AsyncValueRef<CpuDeviceMemory>> Allocate(
-      size_t size_bytes);
+      size_t size_bytes, int numa_node = tsl::port::kNUMANoAffinity);
 
   // Allocates owning memory into the previously created delayed memory
   // placeholder (see `CreateDelayedMemory` above).
   static absl::Status AllocateInto(
-      size_t size_bytes, tsl::AsyncValuePtr<CpuDeviceMemory> delayed_memory);
+      size_t size_bytes, tsl::AsyncValuePtr<CpuDeviceMemory> delayed_memory,
+      int numa_node = tsl::port::kNUMANoAffinity);
 
  protected:
   CpuDeviceMemory(void* base, size_t size) : base_(base), size_bytes_(size) {}
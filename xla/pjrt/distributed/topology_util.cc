@@ -20,6 +20,7 @@ limitations under the License.
 #include <map>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
@@ -33,7 +34,6 @@ limitations under the License.
 #include "absl/strings/string_view.h"
 #include "absl/strings/substitute.h"
 #include "absl/synchronization/blocking_counter.h"
-#include "absl/synchronization/mutex.h"
 #include "absl/time/time.h"
 #include "absl/types/span.h"
 #include "xla/pjrt/distributed/key_value_store_interface.h"
@@ -125,21 +125,27 @@ static std::string GetGlobalTopologyKey(absl::string_view platform) {
 static absl::StatusOr<std::vector<LocalTopologyProto>> GetAllLocalTopologies(
     absl::string_view platform, int num_nodes, KeyValueStoreInterface* kv_store,
     absl::Duration timeout) {
-  std::vector<absl::StatusOr<std::string>> local_topology_strs(num_nodes);
+  std::vector<absl::StatusOr<LocalTopologyProto>> local_topology_protos(
+      num_nodes);
 
   // TODO(ezhulenev): Should a thread pool become a function argument?
   tsl::thread::ThreadPool thread_pool(
       tsl::Env::Default(), "GetAllLocalTopologies", DefaultThreadPoolSize());
 
+  // Local topologies are also parsed in the thread pool, so that the leader
+  // doesn't parse thousands of them one after another.
   absl::BlockingCounter blocking_counter(num_nodes);
-  absl::Mutex mu;
   for (int i = 0; i < num_nodes; i++) {
     thread_pool.Schedule([&, i] {
       absl::StatusOr<std::string> local_topology_str =
           kv_store->Get(GetLocalTopologyKey(platform, i), timeout);
-      {
-        absl::MutexLock lock(&mu);
-        local_topology_strs[i] = local_topology_str;
+      absl::StatusOr<LocalTopologyProto>& local_topology =
+          local_topology_protos[i];
+      if (!local_topology_str.ok()) {
+        local_topology = local_topology_str.status();
+      } else if (!local_topology->ParseFromString(*local_topology_str)) {
+        local_topology = absl::DataLossError(
+            absl::StrCat("Failed to parse the local topology of node ", i));
       }
       blocking_counter.DecrementCount();
     });
@@ -148,16 +154,15 @@ static absl::StatusOr<std::vector<LocalTopologyProto>> GetAllLocalTopologies(
 
   std::vector<std::string> error_messages;
   std::vector<LocalTopologyProto> local_topologies;
+  local_topologies.reserve(num_nodes);
   int max_num_failed_message = 10;
   int failed_count = 0;
-  for (const absl::StatusOr<std::string>& str : local_topology_strs) {
-    if (str.ok()) {
-      LocalTopologyProto local;
-      local.ParseFromString(*str);
-      local_topologies.push_back(local);
+  for (absl::StatusOr<LocalTopologyProto>& local : local_topology_protos) {
+    if (local.ok()) {
+      local_topologies.push_back(*std::move(local));
     } else {
-      error_messages.push_back(
-          absl::StrCat("Error ", ++failed_count, ": ", str.status().message()));
+      error_messages.push_back(absl::StrCat("Error ", ++failed_count, ": ",
+                                            local.status().message()));
       if (failed_count > max_num_failed_message) {
         break;
       }
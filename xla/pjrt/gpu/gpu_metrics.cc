@@ -15,7 +15,9 @@ limitations under the License.
 
 #include "xla/pjrt/gpu/gpu_metrics.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <string>
 
 #include "absl/strings/str_cat.h"
 #include "xla/tsl/lib/monitoring/gauge.h"
@@ -25,6 +27,18 @@ namespace {
 auto* free_gpu_system_memory = tsl::monitoring::Gauge<int64_t, 1>::New(
     gpu_metrics::freeGpuSystemMemoryMetricName,
     "Record the free GPU system memory.", "gpu_id");
+
+auto* gpu_allocator_peak_bytes_in_use = tsl::monitoring::Gauge<int64_t, 1>::New(
+    gpu_metrics::gpuAllocatorPeakBytesInUseMetricName,
+    "Record the peak bytes in use of the GPU allocator.", "gpu_id");
+
+auto* gpu_allocator_pool_bytes = tsl::monitoring::Gauge<int64_t, 1>::New(
+    gpu_metrics::gpuAllocatorPoolBytesMetricName,
+    "Record the bytes held by the GPU allocator pool.", "gpu_id");
+
+auto* gpu_allocator_fragmentation = tsl::monitoring::Gauge<int64_t, 1>::New(
+    gpu_metrics::gpuAllocatorFragmentationMetricName,
+    "Record the percentage of GPU allocator pool bytes not in use.", "gpu_id");
 }  // namespace
 
 namespace gpu_metrics {
@@ -39,5 +53,32 @@ int64_t GetFreeGpuSystemMemory(int gpu_id) {
   return free_gpu_system_memory->GetCell(absl::StrCat(gpu_id))->value();
 }
 
+void RecordGpuAllocatorStats(const int device_ordinal,
+                             const int64_t bytes_in_use,
+                             const int64_t peak_bytes_in_use,
+                             const int64_t pool_bytes) {
+  std::string gpu_id = absl::StrCat(device_ordinal);
+  gpu_allocator_peak_bytes_in_use->GetCell(gpu_id)->Set(peak_bytes_in_use);
+  gpu_allocator_pool_bytes->GetCell(gpu_id)->Set(pool_bytes);
+  int64_t fragmentation =
+      pool_bytes > 0
+          ? std::max<int64_t>(0, pool_bytes - bytes_in_use) * 100 / pool_bytes
+          : 0;
+  gpu_allocator_fragmentation->GetCell(gpu_id)->Set(fragmentation);
+}
+
+int64_t GetGpuAllocatorPeakBytesInUse(int gpu_id) {
+  return gpu_allocator_peak_bytes_in_use->GetCell(absl::StrCat(gpu_id))
+      ->value();
+}
+
+int64_t GetGpuAllocatorPoolBytes(int gpu_id) {
+  return gpu_allocator_pool_bytes->GetCell(absl::StrCat(gpu_id))->value();
+}
+
+int64_t GetGpuAllocatorFragmentationPercent(int gpu_id) {
+  return gpu_allocator_fragmentation->GetCell(absl::StrCat(gpu_id))->value();
+}
+
 }  // namespace gpu_metrics
 }  // namespace xla
@@ -30,6 +30,23 @@ void RecordFreeGpuSystemMemory(int device_ordinal, int64_t free_memory);
 
 int64_t GetFreeGpuSystemMemory(int gpu_id);
 
+inline constexpr absl::string_view gpuAllocatorPeakBytesInUseMetricName =
+    "/pjrt/gpu/allocator_peak_bytes_in_use";
+inline constexpr absl::string_view gpuAllocatorPoolBytesMetricName =
+    "/pjrt/gpu/allocator_pool_bytes";
+inline constexpr absl::string_view gpuAllocatorFragmentationMetricName =
+    "/pjrt/gpu/allocator_fragmentation_percent";
+
+// Records GPU allocator statistics of a device: the peak number of bytes in
+// use, the number of bytes held by the allocator pool, and the fragmentation,
+// i.e. the percentage of pool bytes that are not in use.
+void RecordGpuAllocatorStats(int device_ordinal, int64_t bytes_in_use,
+                             int64_t peak_bytes_in_use, int64_t pool_bytes);
+
+int64_t GetGpuAllocatorPeakBytesInUse(int gpu_id);
+int64_t GetGpuAllocatorPoolBytes(int gpu_id);
+int64_t GetGpuAllocatorFragmentationPercent(int gpu_id);
+
 }  // namespace gpu_metrics
 }  // namespace xla
 
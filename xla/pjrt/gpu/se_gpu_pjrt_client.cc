@@ -54,6 +54,10 @@ limitations under the License.
 #include "xla/core/collectives/collectives_registry.h"
 #include "xla/executable_run_options.h"
 #include "xla/hlo/builder/xla_computation.h"
+#include "xla/hlo/ir/hlo_computation.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/ir/hlo_opcode.h"
 #include "xla/layout.h"
 #include "xla/layout_util.h"
 #include "xla/literal.h"
@@ -97,6 +101,7 @@ limitations under the License.
 #include "xla/tsl/concurrency/ref_count.h"
 #include "xla/tsl/distributed_runtime/coordination/coordination_service_agent.h"
 #include "xla/tsl/framework/allocator.h"
+#include "xla/tsl/framework/bfc_allocator.h"
 #include "xla/tsl/lib/strings/proto_serialization.h"
 #include "xla/tsl/protobuf/coordination_service.pb.h"
 #include "tsl/platform/casts.h"
@@ -119,6 +124,8 @@ limitations under the License.
 #include "xla/service/gpu/gpu_constants.h"
 #include "xla/service/gpu/gpu_executable.h"
 #include "xla/service/gpu/gpu_memory_space_assignment.h"
+#include "xla/service/gpu/model/gpu_hlo_cost_analysis.h"
+#include "xla/service/gpu/model/gpu_performance_model.h"
 #include "xla/service/gpu/stream_executor_util.h"
 #include "xla/xla.pb.h"
 #endif  // GOOGLE_CUDA || TENSORFLOW_USE_ROCM
@@ -940,13 +947,47 @@ absl::StatusOr<Layout> StreamExecutorGpuClient::GetDefaultLayout(
   return topology_.GetDefaultLayout(element_type, dims);
 }
 
-absl::StatusOr<std::unique_ptr<PjRtLoadedExecutable>>
-StreamExecutorGpuClient::CompileAndLoad(mlir::ModuleOp module,
-                                        CompileOptions options) {
-  auto executable = PjRtStreamExecutorClient::CompileAndLoad(module, options);
+std::optional<absl::Duration> StreamExecutorGpuClient::EstimateRunTime(
+    const HloModule& module) const {
+#if defined(GOOGLE_CUDA) || defined(TENSORFLOW_USE_ROCM)
+  const se::DeviceDescription& device_info =
+      client()->backend().default_stream_executor()->GetDeviceDescription();
+  gpu::GpuHloCostAnalysis cost_analysis(
+      gpu::GpuHloCostAnalysis::Options{
+          client()->backend().compiler()->ShapeSizeBytesFunction(),
+          /*per_second_rates=*/{},
+          /*min_latencies_seconds=*/{},
+          /*count_multiple_input_accesses=*/true},
+      device_info);
+  if (absl::Status status = module.entry_computation()->Accept(&cost_analysis);
+      !status.ok()) {
+    VLOG(1) << "Failed to run cost analysis on " << module.name() << ": "
+            << status;
+    return std::nullopt;
+  }
 
+  // Only fusions of the entry computation are modeled; control flow and
+  // library calls are not accounted for, so this is a lower bound.
+  gpu::GpuPerformanceModelOwning performance_model(device_info);
+  absl::Duration run_time = absl::ZeroDuration();
+  for (const HloInstruction* instr :
+       module.entry_computation()->instructions()) {
+    if (instr->opcode() == HloOpcode::kFusion) {
+      run_time += performance_model
+                      .EstimateRunTimeForInstruction(instr, &cost_analysis)
+                      .exec_time;
+    }
+  }
+  return run_time;
+#else
+  return std::nullopt;
+#endif  // GOOGLE_CUDA || TENSORFLOW_USE_ROCM
+}
+
+// Records free GPU memory and allocator statistics of all `devices`.
+static void RecordGpuMemoryMetrics(absl::Span<PjRtDevice* const> devices) {
 #if defined(GOOGLE_CUDA) || defined(TENSORFLOW_USE_ROCM)
-  for (const PjRtDevice* device : addressable_devices()) {
+  for (const PjRtDevice* device : devices) {
     LocalDeviceState* local_device_state =
         tensorflow::down_cast<const PjRtStreamExecutorDevice*>(device)
             ->local_device_state();
@@ -960,9 +1001,25 @@ StreamExecutorGpuClient::CompileAndLoad(mlir::ModuleOp module,
         LOG(ERROR) << "Failed to query available memory for GPU "
                    << device_ordinal;
       }
+      // Allocator stats are not available with the platform allocator.
+      if (absl::StatusOr<tsl::AllocatorStats> stats =
+              device->GetAllocatorStats();
+          stats.ok()) {
+        gpu_metrics::RecordGpuAllocatorStats(
+            device_ordinal, stats->bytes_in_use, stats->peak_bytes_in_use,
+            stats->pool_bytes.value_or(stats->bytes_in_use));
+      }
     }
   }
 #endif  // GOOGLE_CUDA || TENSORFLOW_USE_ROCM
+}
+
+absl::StatusOr<std::unique_ptr<PjRtLoadedExecutable>>
+StreamExecutorGpuClient::CompileAndLoad(mlir::ModuleOp module,
+                                        CompileOptions options) {
+  auto executable = PjRtStreamExecutorClient::CompileAndLoad(module, options);
+
+  RecordGpuMemoryMetrics(addressable_devices());
   return executable;
 }
 
@@ -972,24 +1029,7 @@ StreamExecutorGpuClient::CompileAndLoad(const XlaComputation& computation,
   auto executable =
       PjRtStreamExecutorClient::CompileAndLoad(computation, options);
 
-#if defined(GOOGLE_CUDA) || defined(TENSORFLOW_USE_ROCM)
-  for (const PjRtDevice* device : addressable_devices()) {
-    LocalDeviceState* local_device_state =
-        tensorflow::down_cast<const PjRtStreamExecutorDevice*>(device)
-            ->local_device_state();
-    int64_t free_memory, total_memory;
-    if (local_device_state != nullptr) {
-      se::StreamExecutor* executor = local_device_state->executor();
-      int device_ordinal = executor->device_ordinal();
-      if (executor->DeviceMemoryUsage(&free_memory, &total_memory)) {
-        gpu_metrics::RecordFreeGpuSystemMemory(device_ordinal, free_memory);
-      } else {
-        LOG(ERROR) << "Failed to query available memory for GPU "
-                   << device_ordinal;
-      }
-    }
-  }
-#endif  // GOOGLE_CUDA || TENSORFLOW_USE_ROCM
+  RecordGpuMemoryMetrics(addressable_devices());
   return executable;
 }
 
@@ -1006,9 +1046,10 @@ namespace {
 #if defined(GOOGLE_CUDA) && CUDA_VERSION >= 11020
 
 absl::StatusOr<std::unique_ptr<se::GpuCudaMallocAsyncAllocator>>
-CreateCudaAsyncAllocator(const LocalDeviceState& device, double memory_fraction,
-                         bool reserve_memory, bool create_new_pool,
-                         bool sync_mode, bool compute_stats = true) {
+CreateCudaAsyncAllocator(
+    const LocalDeviceState& device, double memory_fraction, bool reserve_memory,
+    bool create_new_pool, bool sync_mode, bool compute_stats = true,
+    std::optional<int64_t> release_threshold = std::nullopt) {
   se::StreamExecutor* executor = device.executor();
   int device_ordinal = executor->device_ordinal();
 
@@ -1033,12 +1074,22 @@ CreateCudaAsyncAllocator(const LocalDeviceState& device, double memory_fraction,
               << " for CudaAsyncAllocator.";
   }
 
+  // The pool keeps up to `reserve_memory_size` bytes reserved at
+  // synchronization points instead of releasing them to the driver.
+  size_t reserve_memory_size = release_threshold.value_or(
+      reserve_memory ? allocator_memory : 0);
+  if (release_threshold.has_value()) {
+    LOG(INFO) << "CudaAsyncAllocator on device " << device_ordinal
+              << " keeps up to " << reserve_memory_size
+              << " bytes reserved in its memory pool.";
+  }
+
   auto allocator = std::make_unique<se::GpuCudaMallocAsyncAllocator>(
       /*platform_device_id*/ tsl::PlatformDeviceId(device_ordinal),
       /*create_new_pool*/ create_new_pool,
       /*new_pool_size*/ allocator_memory,
       /*reserve_memory*/ reserve_memory,
-      /*reserve_memory_size*/ reserve_memory ? allocator_memory : 0,
+      /*reserve_memory_size*/ reserve_memory_size,
       /*sync_mode*/ sync_mode,
       /*compute_stats*/ compute_stats);
 
@@ -1051,24 +1102,54 @@ CreateCudaAsyncAllocator(const LocalDeviceState& device, double memory_fraction,
 #else  // defined(GOOGLE_CUDA) && CUDA_VERSION >= 11020
 absl::StatusOr<std::unique_ptr<tsl::Allocator>> CreateCudaAsyncAllocator(
     const LocalDeviceState& device, double memory_fraction, bool reserve_memory,
-    bool create_new_pool, bool sync_mode, bool compute_stats = true) {
+    bool create_new_pool, bool sync_mode, bool compute_stats = true,
+    std::optional<int64_t> release_threshold = std::nullopt) {
   return FailedPrecondition("CUDA async allocator requires CUDA >= 11.2");
 }
 
 #endif  // defined(GOOGLE_CUDA) && CUDA_VERSION >= 11020
 
-// Builds a LocalDeviceState for each GPU present.
+// Builds a LocalDeviceState for each GPU present, whose streams have
+// `options.stream_priority` and whose host threads are configured by the
+// host thread options of `options`.
 absl::StatusOr<std::map<int, std::unique_ptr<LocalDeviceState>>>
-BuildLocalDeviceStates(LocalClient* xla_client) {
+BuildLocalDeviceStates(LocalClient* xla_client,
+                       const GpuClientOptions& options) {
+  std::optional<LocalDeviceState::StreamOptions> stream_options;
+  if (options.stream_priority.has_value()) {
+    stream_options.emplace();
+    stream_options->priority = *options.stream_priority;
+  }
+  absl::Span<se::StreamExecutor* const> executors =
+      xla_client->backend().stream_executors();
+  for (const auto& cpu_cores : {options.execute_thread_cpu_cores,
+                                options.callback_thread_cpu_cores}) {
+    if (cpu_cores.has_value() && cpu_cores->size() < executors.size()) {
+      return InvalidArgument(
+          "Expected a CPU core for the host threads of each of the %d local "
+          "devices, got %d",
+          executors.size(), cpu_cores->size());
+    }
+  }
   std::map<int, std::unique_ptr<LocalDeviceState>> addressable_devices;
-  for (se::StreamExecutor* executor :
-       xla_client->backend().stream_executors()) {
+  for (int i = 0; i < executors.size(); ++i) {
+    LocalDeviceState::HostThreadOptions host_thread_options;
+    if (options.execute_thread_cpu_cores.has_value()) {
+      host_thread_options.execute_thread_cpu_core =
+          (*options.execute_thread_cpu_cores)[i];
+    }
+    if (options.callback_thread_cpu_cores.has_value()) {
+      host_thread_options.callback_thread_cpu_core =
+          (*options.callback_thread_cpu_cores)[i];
+    }
+    host_thread_options.busy_poll = options.busy_poll_host_threads;
     addressable_devices.emplace(
-        executor->device_ordinal(),
+        executors[i]->device_ordinal(),
         std::make_unique<LocalDeviceState>(
-            executor, xla_client, LocalDeviceState::kComputeSynchronized,
+            executors[i], xla_client, LocalDeviceState::kComputeSynchronized,
             /*max_inflight_computations=*/32,
-            /*allow_event_reuse=*/true, /*use_callback_stream=*/true));
+            /*allow_event_reuse=*/true, /*use_callback_stream=*/true,
+            /*device_ordinal=*/-1, stream_options, host_thread_options));
   }
   return std::move(addressable_devices);
 }
@@ -1088,7 +1169,9 @@ GetStreamExecutorGpuDeviceAllocator(
             auto async_allocator,
             CreateCudaAsyncAllocator(
                 *(ordinal_and_device.second), allocator_config.memory_fraction,
-                allocator_config.preallocate, false, false, true));
+                allocator_config.preallocate, /*create_new_pool=*/false,
+                /*sync_mode=*/false, /*compute_stats=*/true,
+                allocator_config.release_threshold));
         allocators.emplace_back(std::move(async_allocator),
                                 ordinal_and_device.second->compute_stream(),
                                 /*memory_space=*/0);
@@ -1404,6 +1487,46 @@ absl::StatusOr<tsl::AllocatorStats> StreamExecutorGpuDevice::GetAllocatorStats()
   return stats.value();
 }
 
+absl::StatusOr<tsl::BFCAllocator*> StreamExecutorGpuDevice::GetBFCAllocator()
+    const {
+  if (!IsAddressable()) {
+    return FailedPrecondition(
+        "Allocation traces are only available for addressable devices");
+  }
+
+  auto* allocator_adapter = dynamic_cast<se::MultiDeviceAdapter*>(
+      tensorflow::down_cast<PjRtStreamExecutorClient*>(client())->allocator());
+  if (!allocator_adapter) {
+    return Unimplemented(
+        "Allocation traces are only implemented with MultiDeviceAdapter "
+        "allocator");
+  }
+
+  TF_ASSIGN_OR_RETURN(tsl::Allocator * allocator,
+                      allocator_adapter->GetAllocator(
+                          local_device_id().value()));
+  auto* bfc_allocator = dynamic_cast<tsl::BFCAllocator*>(allocator);
+  if (bfc_allocator == nullptr) {
+    return Unimplemented(absl::StrCat(
+        "Allocation traces are only implemented for the BFC allocator, got ",
+        allocator->Name()));
+  }
+  return bfc_allocator;
+}
+
+absl::Status StreamExecutorGpuDevice::SetAllocationTraceCapacity(
+    size_t capacity) {
+  TF_ASSIGN_OR_RETURN(tsl::BFCAllocator * allocator, GetBFCAllocator());
+  allocator->SetAllocationTraceCapacity(capacity);
+  return absl::OkStatus();
+}
+
+absl::StatusOr<std::vector<tsl::BFCAllocator::AllocationEvent>>
+StreamExecutorGpuDevice::GetAllocationTrace() const {
+  TF_ASSIGN_OR_RETURN(tsl::BFCAllocator * allocator, GetBFCAllocator());
+  return allocator->GetAllocationTrace();
+}
+
 absl::Span<int const> StreamExecutorGpuDevice::coords() const {
   return description().coords();
 }
@@ -1436,7 +1559,8 @@ absl::StatusOr<std::unique_ptr<PjRtClient>> GetStreamExecutorGpuClient(
       LocalClient * xla_client,
       GetGpuXlaClient(options.platform_name, options.allowed_devices));
   std::map<int, std::unique_ptr<LocalDeviceState>> local_device_states;
-  TF_ASSIGN_OR_RETURN(local_device_states, BuildLocalDeviceStates(xla_client));
+  TF_ASSIGN_OR_RETURN(local_device_states,
+                      BuildLocalDeviceStates(xla_client, options));
   EnablePeerAccess(xla_client->backend().stream_executors());
   TF_ASSIGN_OR_RETURN(auto allocator,
                       GetStreamExecutorGpuDeviceAllocator(
@@ -1473,12 +1597,14 @@ absl::StatusOr<std::unique_ptr<PjRtClient>> GetStreamExecutorGpuClient(
   auto gpu_topology = std::shared_ptr<const GpuTopology>(
       GpuTopology::FromProto(device_topology_pair.second));
 
-  return std::unique_ptr<PjRtClient>(std::make_unique<StreamExecutorGpuClient>(
+  auto client = std::make_unique<StreamExecutorGpuClient>(
       pjrt_platform_name, xla_client, std::move(device_topology_pair.first),
       options.node_id, std::move(allocator), std::move(host_memory_allocator),
       options.should_stage_host_to_device_transfers, std::move(gpu_run_options),
       std::move(kv_store), std::move(options.distributed_runtime_client),
-      options.abort_collectives_on_failure, std::move(gpu_topology)));
+      options.abort_collectives_on_failure, std::move(gpu_topology));
+  client->set_compile_cache(options.compile_cache);
+  return std::unique_ptr<PjRtClient>(std::move(client));
 }
 
 std::vector<std::unique_ptr<PjRtStreamExecutorDevice>> BuildLocalDevices(
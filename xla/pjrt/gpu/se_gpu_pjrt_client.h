@@ -27,6 +27,7 @@ limitations under the License.
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/memory/memory.h"
+#include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
 #include "absl/time/time.h"
@@ -34,6 +35,7 @@ limitations under the License.
 #include "mlir/IR/BuiltinOps.h"
 #include "xla/client/local_client.h"
 #include "xla/hlo/builder/xla_computation.h"
+#include "xla/hlo/ir/hlo_module.h"
 #include "xla/layout.h"
 #include "xla/pjrt/distributed/key_value_store_interface.h"
 #include "xla/pjrt/gpu/gpu_topology.h"
@@ -52,6 +54,7 @@ limitations under the License.
 #include "xla/shape.h"
 #include "xla/stream_executor/device_memory_allocator.h"
 #include "xla/tsl/framework/allocator.h"
+#include "xla/tsl/framework/bfc_allocator.h"
 #include "tsl/platform/casts.h"
 
 namespace xla {
@@ -73,11 +76,25 @@ class StreamExecutorGpuDevice : public PjRtStreamExecutorDevice {
 
   absl::StatusOr<tsl::AllocatorStats> GetAllocatorStats() const override;
 
+  // Starts recording the last `capacity` allocations and deallocations of the
+  // device memory allocator, or stops recording if `capacity` is zero. Only
+  // implemented for the BFC allocator.
+  absl::Status SetAllocationTraceCapacity(size_t capacity);
+
+  // Returns the allocations and deallocations recorded since the last call to
+  // SetAllocationTraceCapacity, oldest first. Use
+  // tsl::BFCAllocator::AllocationTraceToJson and SummarizeAllocationTrace to
+  // export them.
+  absl::StatusOr<std::vector<tsl::BFCAllocator::AllocationEvent>>
+  GetAllocationTrace() const;
+
   absl::Span<int const> coords() const;
 
   absl::StatusOr<PjRtMemorySpace*> default_memory_space() const override;
 
  private:
+  absl::StatusOr<tsl::BFCAllocator*> GetBFCAllocator() const;
+
   std::string device_vendor_;
   int slice_index_;
 };
@@ -146,6 +163,10 @@ class StreamExecutorGpuClient : public xla::PjRtStreamExecutorClient {
   absl::StatusOr<Layout> GetDefaultLayout(
       PrimitiveType element_type, absl::Span<const int64_t> dims) override;
 
+  // Sums the GpuPerformanceModel estimates of the entry computation fusions.
+  std::optional<absl::Duration> EstimateRunTime(
+      const HloModule& module) const override;
+
   absl::StatusOr<std::unique_ptr<PjRtLoadedExecutable>> LoadSerialized(
       absl::string_view serialized, std::optional<CompileOptions> options,
       const LoadOptions& load_options);
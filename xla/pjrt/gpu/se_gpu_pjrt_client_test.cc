@@ -55,6 +55,7 @@ limitations under the License.
 #include "xla/layout.h"
 #include "xla/literal.h"
 #include "xla/literal_util.h"
+#include "xla/pjrt/compile_cache.h"
 #include "xla/pjrt/distributed/client.h"
 #include "xla/pjrt/distributed/distributed.h"
 #include "xla/pjrt/distributed/in_memory_key_value_store.h"
@@ -84,6 +85,7 @@ limitations under the License.
 #include "xla/stream_executor/device_memory.h"
 #include "xla/stream_executor/stream.h"
 #include "xla/tests/literal_test_util.h"
+#include "xla/tsl/framework/bfc_allocator.h"
 #include "xla/tsl/lib/core/status_test_util.h"
 #include "xla/tsl/platform/env.h"
 #include "xla/tsl/platform/status.h"
@@ -110,6 +112,8 @@ using ::testing::FloatEq;
 using ::testing::Ge;
 using ::testing::Gt;
 using ::testing::HasSubstr;
+using ::testing::IsEmpty;
+using ::testing::Not;
 using ::testing::SizeIs;
 using ::tsl::testing::IsOkAndHolds;
 using ::tsl::testing::StatusIs;
@@ -601,6 +605,29 @@ TEST(StreamExecutorGpuClientTest, ToLiteralAsync) {
             literal->Relayout(src_literal.shape().layout()).data<float>());
 }
 
+TEST(StreamExecutorGpuClientTest, ToLiteralWithBusyPolling) {
+  GpuClientOptions options = DefaultOptions();
+  options.execute_thread_cpu_cores = std::vector<int>({0, 0});
+  options.callback_thread_cpu_cores = std::vector<int>({0, 0});
+  options.busy_poll_host_threads = true;
+  TF_ASSERT_OK_AND_ASSIGN(auto client, GetStreamExecutorGpuClient(options));
+  auto literal = LiteralUtil::CreateR1<float>({41.0f, 42.0f, 43.0f, 44.0f});
+  TF_ASSERT_OK_AND_ASSIGN(
+      std::unique_ptr<PjRtBuffer> buffer,
+      client->BufferFromHostLiteral(literal, client->memory_spaces()[0]));
+
+  TF_ASSERT_OK_AND_ASSIGN(std::shared_ptr<Literal> result,
+                          buffer->ToLiteralSync());
+  EXPECT_EQ(*result, literal);
+}
+
+TEST(StreamExecutorGpuClientTest, RejectsTooFewHostThreadCpuCores) {
+  GpuClientOptions options = DefaultOptions();
+  options.execute_thread_cpu_cores = std::vector<int>();
+  EXPECT_THAT(GetStreamExecutorGpuClient(options),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
 TEST(StreamExecutorGpuClientTest, ToLiteralAsyncWithNonCompactLayout) {
   TF_ASSERT_OK_AND_ASSIGN(auto client,
                           GetStreamExecutorGpuClient(DefaultOptions()));
@@ -1102,6 +1129,42 @@ TEST(StreamExecutorGpuClientTest, AsyncCopyToDevice) {
             literal->Relayout(src_literal.shape().layout()).data<float>());
 }
 
+TEST(StreamExecutorGpuClientTest, CopyBatchToMemorySpace) {
+  TF_ASSERT_OK_AND_ASSIGN(auto client,
+                          GetStreamExecutorGpuClient(DefaultOptions()));
+  ASSERT_GE(client->addressable_devices().size(), 2);
+  auto* d0 = client->addressable_devices()[0];
+  auto* d1 = client->addressable_devices()[1];
+
+  std::vector<Literal> src_literals;
+  std::vector<std::unique_ptr<PjRtBuffer>> src_buffers;
+  std::vector<PjRtStreamExecutorBuffer*> se_src_buffers;
+  for (int i = 0; i < 4; ++i) {
+    src_literals.push_back(LiteralUtil::CreateR1<float>(
+        {1.0f * i, 2.0f * i, 3.0f * i, 4.0f * i}));
+    TF_ASSERT_OK_AND_ASSIGN(
+        src_buffers.emplace_back(),
+        client->BufferFromHostLiteral(src_literals.back(),
+                                      *d0->default_memory_space()));
+    se_src_buffers.push_back(
+        tensorflow::down_cast<PjRtStreamExecutorBuffer*>(
+            src_buffers.back().get()));
+  }
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      std::vector<std::unique_ptr<PjRtBuffer>> dst_buffers,
+      PjRtStreamExecutorBuffer::CopyBatchToMemorySpace(
+          se_src_buffers, *d1->default_memory_space()));
+  ASSERT_EQ(dst_buffers.size(), src_literals.size());
+
+  for (int i = 0; i < dst_buffers.size(); ++i) {
+    EXPECT_EQ(dst_buffers[i]->device(), d1);
+    TF_ASSERT_OK_AND_ASSIGN(std::shared_ptr<Literal> literal,
+                            dst_buffers[i]->ToLiteralSync());
+    EXPECT_TRUE(LiteralTestUtil::Equal(src_literals[i], *literal));
+  }
+}
+
 TEST(StreamExecutorGpuClientTest, CreateMixOfErrorBuffers) {
   TF_ASSERT_OK_AND_ASSIGN(auto client,
                           GetStreamExecutorGpuClient(DefaultOptions()));
@@ -1156,6 +1219,66 @@ TEST(StreamExecutorGpuClientTest, CreateMixOfErrorBuffers) {
   }
 }
 
+// Keeps the executables in memory and counts the cache hits.
+class InMemoryCompileCache : public PjRtCompileCache {
+ public:
+  absl::StatusOr<std::optional<std::string>> Get(
+      absl::string_view key) override {
+    absl::MutexLock lock(&mu_);
+    auto it = executables_.find(key);
+    if (it == executables_.end()) {
+      return std::nullopt;
+    }
+    ++hits_;
+    return it->second;
+  }
+
+  absl::Status Put(absl::string_view key, absl::string_view value) override {
+    absl::MutexLock lock(&mu_);
+    executables_[key] = std::string(value);
+    return absl::OkStatus();
+  }
+
+  int hits() {
+    absl::MutexLock lock(&mu_);
+    return hits_;
+  }
+
+ private:
+  absl::Mutex mu_;
+  absl::flat_hash_map<std::string, std::string> executables_
+      ABSL_GUARDED_BY(mu_);
+  int hits_ ABSL_GUARDED_BY(mu_) = 0;
+};
+
+TEST(StreamExecutorGpuClientTest, CompileCache) {
+  static constexpr char const* kConstantProgram = R"(
+HloModule Constant
+
+ENTRY main {
+  ROOT constant = f32[2] constant({2, 3})
+}
+)";
+  auto compile_cache = std::make_shared<InMemoryCompileCache>();
+  GpuClientOptions options = DefaultOptions();
+  options.compile_cache = compile_cache;
+  TF_ASSERT_OK_AND_ASSIGN(auto client, GetStreamExecutorGpuClient(options));
+
+  TF_ASSERT_OK(CompileExecutable(kConstantProgram, *client).status());
+  EXPECT_EQ(compile_cache->hits(), 0);
+
+  // The second compilation loads the executable stored by the first one.
+  TF_ASSERT_OK_AND_ASSIGN(auto executable,
+                          CompileExecutable(kConstantProgram, *client));
+  EXPECT_EQ(compile_cache->hits(), 1);
+
+  auto result = executable->Execute({{}}, /*options=*/{});
+  TF_ASSERT_OK_AND_ASSIGN(std::shared_ptr<xla::Literal> literal,
+                          ExtractSingleResult(result));
+  EXPECT_TRUE(LiteralTestUtil::Equal(LiteralUtil::CreateR1<float>({2, 3}),
+                                     *literal));
+}
+
 TEST(GpuTopology, FromProto) {
   GpuTopologyProto msg;
   ASSERT_TRUE(tsl::protobuf::TextFormat::ParseFromString(
@@ -1267,6 +1390,83 @@ TEST(StreamExecutorGpuClientTest, GetAllocatorStatsTest) {
   }
 }
 
+TEST(StreamExecutorGpuClientTest, AllocationTraceTest) {
+  TF_ASSERT_OK_AND_ASSIGN(auto client,
+                          GetStreamExecutorGpuClient(DefaultOptions()));
+  auto* device = tensorflow::down_cast<StreamExecutorGpuDevice*>(
+      client->addressable_devices()[0]);
+  TF_ASSERT_OK(device->SetAllocationTraceCapacity(16));
+
+  TF_ASSERT_OK_AND_ASSIGN(auto* memory_space, device->default_memory_space());
+  const xla::Literal literal = xla::LiteralUtil::CreateR1<float>({1, 2, 3});
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<PjRtBuffer> buffer,
+                          client->BufferFromHostLiteral(literal, memory_space));
+  TF_ASSERT_OK(buffer->GetReadyFuture().Await());
+
+  TF_ASSERT_OK_AND_ASSIGN(auto trace, device->GetAllocationTrace());
+  ASSERT_THAT(trace, Not(IsEmpty()));
+  EXPECT_EQ(trace[0].kind,
+            tsl::BFCAllocator::AllocationEvent::Kind::kAllocation);
+  EXPECT_GT(trace[0].bytes_in_use, 0);
+  EXPECT_THAT(tsl::BFCAllocator::AllocationTraceToJson("gpu", trace),
+              HasSubstr(R"("name":"fragmentation")"));
+  EXPECT_THAT(tsl::BFCAllocator::SummarizeAllocationTrace(trace),
+              HasSubstr("Peak fragmentation"));
+
+  TF_ASSERT_OK(device->SetAllocationTraceCapacity(0));
+  TF_ASSERT_OK_AND_ASSIGN(trace, device->GetAllocationTrace());
+  EXPECT_THAT(trace, SizeIs(0));
+}
+
+TEST(StreamExecutorGpuClientTest, ExecutableStatsTest) {
+  static constexpr char const* kAddProgram =
+      R"(
+HloModule Add.6, entry_computation_layout={(f32[], f32[])->(f32[], f32[])}
+
+ENTRY %Add.6 (a.1: f32[], b.2: f32[]) -> (f32[], f32[]) {
+  %a.1 = f32[] parameter(0)
+  %b.2 = f32[] parameter(1)
+  %add.3 = f32[] add(f32[] %a.1, f32[] %b.2)
+  %add.4 = f32[] add(f32[] %add.3, f32[] %add.3)
+  ROOT %tuple.5 = (f32[], f32[]) tuple(f32[] %add.3, f32[] %add.4)
+}
+)";
+  TF_ASSERT_OK_AND_ASSIGN(auto client,
+                          GetStreamExecutorGpuClient(DefaultOptions()));
+  TF_ASSERT_OK_AND_ASSIGN(auto executable,
+                          CompileExecutable(kAddProgram, *client));
+
+  TF_ASSERT_OK_AND_ASSIGN(ExecutableStats stats,
+                          executable->GetExecutableStats());
+  EXPECT_EQ(stats.num_executions, 0);
+  EXPECT_GT(stats.flops, 0);
+  EXPECT_GT(stats.peak_memory_in_bytes, 0);
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto* memory_space,
+      client->addressable_devices()[0]->default_memory_space());
+  TF_ASSERT_OK_AND_ASSIGN(
+      std::unique_ptr<PjRtBuffer> buffer,
+      client->BufferFromHostLiteral(xla::LiteralUtil::CreateR0<float>(1),
+                                    memory_space));
+  constexpr int kNumExecutions = 3;
+  for (int i = 0; i < kNumExecutions; ++i) {
+    std::optional<std::vector<PjRtFuture<>>> futures;
+    TF_ASSERT_OK(executable
+                     ->Execute({{buffer.get(), buffer.get()}},
+                               /*options=*/{}, futures)
+                     .status());
+    ASSERT_TRUE(futures.has_value());
+    TF_ASSERT_OK((*futures)[0].Await());
+  }
+
+  TF_ASSERT_OK_AND_ASSIGN(stats, executable->GetExecutableStats());
+  EXPECT_EQ(stats.num_executions, kNumExecutions);
+  EXPECT_GT(stats.latency_p50, absl::ZeroDuration());
+  EXPECT_LE(stats.latency_p50, stats.latency_p99);
+  EXPECT_THAT(stats.DebugString(), HasSubstr("num_executions=3"));
+}
+
 TEST(StreamExecutorGpuClientTest, GpuDeviceDescriptionTest) {
   TF_ASSERT_OK_AND_ASSIGN(auto client,
                           GetStreamExecutorGpuClient(DefaultOptions()));
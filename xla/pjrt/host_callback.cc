@@ -16,14 +16,18 @@ limitations under the License.
 #include "xla/pjrt/host_callback.h"
 
 #include <cstddef>
+#include <deque>
 #include <memory>
 #include <utility>
 #include <vector>
 
 #include "absl/log/check.h"
+#include "absl/log/log.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
 #include "xla/ffi/ffi_api.h"
+#include "xla/pjrt/async_work_runner.h"
 #include "xla/pjrt/pjrt_client.h"
 #include "xla/pjrt/pjrt_executable.h"
 #include "xla/shape_util.h"
@@ -73,9 +77,22 @@ absl::Status HostCallbackContext::OnSend(int arg_num,
   // supposed to be invoked sequentially.
   ready_count_.store(args_.size());
 
+  // Take the arguments for this invocation. This won't race with next
+  // invocation as send callbacks are supposed to be invoked sequentially.
+  std::vector<PjRtChunk> args(args_.size());
+  args.swap(args_);
+
+  if (callback_runner_ != nullptr) {
+    InvokeAsync(std::move(args));
+    return absl::OkStatus();
+  }
+  return Invoke(std::move(args));
+}
+
+absl::Status HostCallbackContext::Invoke(std::vector<PjRtChunk> args) {
   std::vector<void*> arg_ptrs;
-  arg_ptrs.reserve(args_.size());
-  for (auto& arg : args_) {
+  arg_ptrs.reserve(args.size());
+  for (auto& arg : args) {
     arg_ptrs.push_back(arg.data());
   }
 
@@ -96,12 +113,6 @@ absl::Status HostCallbackContext::OnSend(int arg_num,
 
   // TODO(chky): Consider populating garbage data in results upon errors.
 
-  // Clear the arguments for this invocation. This won't race with next
-  // invocation as send callbacks are supposed to be invoked sequentially.
-  for (auto& arg : args_) {
-    arg = PjRtChunk{};
-  }
-
   // Sending the results to recv callbacks if there is any. Note that after
   // this point, this callback can be invoked again (e.g. in a loop) anytime.
   for (int i = 0; i < result_channels_.size(); ++i) {
@@ -112,6 +123,44 @@ absl::Status HostCallbackContext::OnSend(int arg_num,
   return status;
 }
 
+void HostCallbackContext::InvokeAsync(std::vector<PjRtChunk> args) {
+  {
+    absl::MutexLock lock(&pending_mu_);
+    pending_args_.push_back(std::move(args));
+    // The invocations scheduled before this one run it when they are done.
+    if (pending_args_.size() > 1) {
+      return;
+    }
+  }
+
+  callback_runner_->Schedule([this] {
+    while (true) {
+      std::vector<PjRtChunk> args;
+      {
+        absl::MutexLock lock(&pending_mu_);
+        args = std::move(pending_args_.front());
+      }
+      absl::Status status = Invoke(std::move(args));
+      LOG_IF(ERROR, !status.ok()) << "Host callback failed: " << status;
+
+      absl::MutexLock lock(&pending_mu_);
+      pending_args_.pop_front();
+      if (pending_args_.empty()) {
+        return;
+      }
+    }
+  });
+}
+
+HostCallbackContext::~HostCallbackContext() {
+  absl::MutexLock lock(&pending_mu_);
+  pending_mu_.Await(absl::Condition(
+      +[](std::deque<std::vector<PjRtChunk>>* pending_args) {
+        return pending_args->empty();
+      },
+      &pending_args_));
+}
+
 void HostCallbackContext::Receive(int res_num,
                                   const PjRtTransferMetadata& metadata,
                                   std::unique_ptr<CopyToDeviceStream> stream) {
@@ -142,10 +191,11 @@ CreateHostCallbackStateAndAppendSendRecvCallbacks(
     PjRtHostMemoryForDeviceManager* host_memory_for_device_manager,
     std::vector<SendCallback>& send_callbacks,
     std::vector<RecvCallback>& recv_callbacks,
-    bool use_major_to_minor_data_layout_for_callbacks) {
+    bool use_major_to_minor_data_layout_for_callbacks,
+    AsyncWorkRunner* callback_runner) {
   auto context = std::make_unique<HostCallbackContext>(
       std::move(host_callback), use_major_to_minor_data_layout_for_callbacks,
-      host_memory_for_device_manager);
+      host_memory_for_device_manager, callback_runner);
 
   const auto& hb = context->host_callback();
   for (int arg_num = 0; arg_num < hb.operands.size(); ++arg_num) {
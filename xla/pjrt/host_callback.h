@@ -30,6 +30,7 @@ limitations under the License.
 #include "absl/status/statusor.h"
 #include "absl/synchronization/mutex.h"
 #include "xla/ffi/api/ffi.h"
+#include "xla/pjrt/async_work_runner.h"
 #include "xla/pjrt/pjrt_client.h"
 #include "xla/pjrt/pjrt_executable.h"
 #include "xla/pjrt/pjrt_future.h"
@@ -109,16 +110,25 @@ struct HostCallback {
 };
 
 // A helper class that maintains the send/recv states for a host callback.
+//
+// If `callback_runner` is not null, the callback is invoked asynchronously on
+// it instead of on the thread that delivers the last operand, so that sends
+// don't wait for the callback. Invocations still run one at a time and in
+// order, and recvs wait for the results as usual, so only the consumers of
+// the results wait for the callback. Errors returned by asynchronous
+// invocations can't fail the execution and are logged instead.
 class HostCallbackContext {
  public:
   HostCallbackContext(
       HostCallback host_callback,
       bool use_major_to_minor_data_layout_for_callbacks,
-      PjRtHostMemoryForDeviceManager* host_memory_for_device_manager)
+      PjRtHostMemoryForDeviceManager* host_memory_for_device_manager,
+      AsyncWorkRunner* callback_runner = nullptr)
       : host_callback_(std::move(host_callback)),
         use_major_to_minor_data_layout_for_callbacks_(
             use_major_to_minor_data_layout_for_callbacks),
         host_memory_for_device_manager_(host_memory_for_device_manager),
+        callback_runner_(callback_runner),
         args_(host_callback_.operands.size()),
         result_channels_(host_callback_.results.size()),
         ready_count_(args_.size()) {
@@ -130,6 +140,9 @@ class HostCallbackContext {
     }
   }
 
+  // Waits for the pending asynchronous invocations of the callback.
+  ~HostCallbackContext();
+
   absl::Status OnSend(int arg_num, const PjRtTransferMetadata& metadata,
                       PjRtChunk data);
 
@@ -139,9 +152,24 @@ class HostCallbackContext {
   const HostCallback& host_callback() const { return host_callback_; }
 
  private:
+  // Invokes the callback with `args` and sends the results to the recvs.
+  absl::Status Invoke(std::vector<PjRtChunk> args);
+
+  // Schedules an invocation of the callback on `callback_runner_` after the
+  // pending ones.
+  void InvokeAsync(std::vector<PjRtChunk> args);
+
   HostCallback host_callback_;
   bool use_major_to_minor_data_layout_for_callbacks_;
   PjRtHostMemoryForDeviceManager* host_memory_for_device_manager_ = nullptr;
+  AsyncWorkRunner* callback_runner_ = nullptr;
+
+  absl::Mutex pending_mu_;
+  // Arguments of the asynchronous invocations that have not finished yet. The
+  // front one is running or about to run on `callback_runner_`.
+  std::deque<std::vector<PjRtChunk>> pending_args_
+      ABSL_GUARDED_BY(pending_mu_);
+
   std::vector<PjRtChunk> args_;
   std::vector<std::unique_ptr<ThreadSafePjRtChunkQueue>> result_channels_;
   std::atomic<int> ready_count_;
@@ -163,14 +191,17 @@ struct HostCallbackStates {
 // `use_major_to_minor_data_layout_for_callbacks` should match the value set in
 // the corresponding ExecuteOptions; see the comment there for more
 // info. `host_memory_for_device_manager` may be nullptr if
-// `use_major_to_minor_data_layout_for_callbacks` is true.
+// `use_major_to_minor_data_layout_for_callbacks` is true. If `callback_runner`
+// is not null, the callback is invoked asynchronously on it, see
+// HostCallbackContext.
 std::unique_ptr<HostCallbackContext>
 CreateHostCallbackStateAndAppendSendRecvCallbacks(
     HostCallback host_callback,
     PjRtHostMemoryForDeviceManager* host_memory_for_device_manager,
     std::vector<SendCallback>& send_callbacks,
     std::vector<RecvCallback>& recv_callbacks,
-    bool use_major_to_minor_data_layout_for_callbacks);
+    bool use_major_to_minor_data_layout_for_callbacks,
+    AsyncWorkRunner* callback_runner = nullptr);
 
 struct FfiLoadedHostCallbacks {
   static ffi::TypeId id;
@@ -19,14 +19,21 @@ limitations under the License.
 #include <cstring>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include <gtest/gtest.h>
+#include "absl/functional/any_invocable.h"
 #include "absl/log/check.h"
+#include "absl/log/log.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/synchronization/notification.h"
+#include "absl/types/span.h"
+#include "xla/pjrt/async_work_runner.h"
 #include "xla/pjrt/pjrt_client.h"
 #include "xla/tests/literal_test_util.h"
+#include "xla/tsl/concurrency/async_value.h"
+#include "xla/tsl/concurrency/ref_count.h"
 #include "xla/tsl/lib/core/status_test_util.h"
 #include "xla/xla_data.pb.h"
 
@@ -76,6 +83,31 @@ class TestStream : public CopyToDeviceStream {
   absl::Notification& done_;
 };
 
+// Defers the scheduled work until RunAll() is called.
+class DeferredWorkRunner : public AsyncWorkRunner {
+ public:
+  void Schedule(absl::AnyInvocable<void() &&> work) override {
+    work_.push_back(std::move(work));
+  }
+
+  void ScheduleWhenReady(
+      absl::Span<const tsl::RCReference<tsl::AsyncValue>> values,
+      absl::AnyInvocable<void() &&> work) override {
+    LOG(FATAL) << "Not implemented";
+  }
+
+  void RunAll() {
+    std::vector<absl::AnyInvocable<void() &&>> work;
+    work.swap(work_);
+    for (auto& w : work) {
+      std::move(w)();
+    }
+  }
+
+ private:
+  std::vector<absl::AnyInvocable<void() &&>> work_;
+};
+
 TEST(HostCallbackTest, Basic) {
   HostCallback host_callback;
 
@@ -175,5 +207,78 @@ TEST(HostCallbackTest, NonBlockingRecv) {
   EXPECT_TRUE(LiteralTestUtil::Equal(literal, borrowing_literal));
 }
 
+TEST(HostCallbackTest, AsyncCallback) {
+  HostCallback host_callback;
+
+  Shape shape = ShapeUtil::MakeShape(F32, {2, 2});
+  size_t byte_size = ShapeUtil::ByteSizeOf(shape);
+
+  int num_calls = 0;
+  host_callback.operands = {HostCallbackArgInfo{/*channel_id=*/1, shape}};
+  host_callback.results = {HostCallbackArgInfo{/*channel_id=*/2, shape}};
+  host_callback.callback = [byte_size, &num_calls](void** outputs,
+                                                   void** inputs) {
+    ++num_calls;
+    std::memcpy(outputs[0], inputs[0], byte_size);
+    return absl::OkStatus();
+  };
+
+  HostCallbackStates states;
+
+  auto& send_callbacks = states.send_callbacks.emplace_back();
+  auto& recv_callbacks = states.recv_callbacks.emplace_back();
+
+  TestPjRtHostMemoryForDeviceManager test_host_memory_for_device_manager;
+  DeferredWorkRunner callback_runner;
+
+  auto context = CreateHostCallbackStateAndAppendSendRecvCallbacks(
+      std::move(host_callback), &test_host_memory_for_device_manager,
+      send_callbacks, recv_callbacks,
+      /*use_major_to_minor_data_layout_for_callbacks=*/false,
+      &callback_runner);
+
+  PjRtTransferMetadata metadata;
+  metadata.device_shape = shape;
+
+  auto literal0 = LiteralUtil::CreateR2({{1.0f, 2.0f}, {3.0f, 4.0f}});
+  auto literal1 = LiteralUtil::CreateR2({{5.0f, 6.0f}, {7.0f, 8.0f}});
+  for (const Literal* literal : {&literal0, &literal1}) {
+    auto chunk = PjRtChunk::AllocateDefault(/*size=*/byte_size);
+    std::memcpy(chunk.data(), literal->untyped_data(), literal->size_bytes());
+    TF_ASSERT_OK(context->OnSend(/*arg_num=*/0, metadata, std::move(chunk)));
+  }
+
+  // Sends return without waiting for the callback.
+  EXPECT_EQ(num_calls, 0);
+
+  PjRtChunk received_chunk0;
+  absl::Notification done0;
+  context->Receive(/*res_num=*/0, metadata,
+                   std::make_unique<TestStream>(byte_size, /*granule_bytes=*/8,
+                                                received_chunk0, done0));
+  EXPECT_FALSE(done0.HasBeenNotified());
+
+  // Both invocations run in order as a single piece of work.
+  callback_runner.RunAll();
+  EXPECT_EQ(num_calls, 2);
+  done0.WaitForNotification();
+
+  PjRtChunk received_chunk1;
+  absl::Notification done1;
+  context->Receive(/*res_num=*/0, metadata,
+                   std::make_unique<TestStream>(byte_size, /*granule_bytes=*/8,
+                                                received_chunk1, done1));
+  done1.WaitForNotification();
+
+  EXPECT_TRUE(LiteralTestUtil::Equal(
+      literal0, BorrowingLiteral(
+                    reinterpret_cast<const char*>(received_chunk0.data()),
+                    shape)));
+  EXPECT_TRUE(LiteralTestUtil::Equal(
+      literal1, BorrowingLiteral(
+                    reinterpret_cast<const char*>(received_chunk1.data()),
+                    shape)));
+}
+
 }  // namespace
 }  // namespace xla
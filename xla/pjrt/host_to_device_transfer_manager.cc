@@ -334,16 +334,8 @@ class CommonAsyncHostToDeviceTransferManager
           buffer_index);
     }
     CHECK(definition_events_[buffer_index]);
-    std::string op_name = "TransferRawDataToSubBuffer";
-    std::string region_type = "";
-    if (debug_info_.has_value()) {
-      std::vector<std::string> debug_info =
-          absl::StrSplit(debug_info_.value(), ';');
-      op_name = debug_info.empty() ? "" : debug_info.front();
-      region_type = debug_info.size() > 1 ? debug_info.back() : "";
-    }
-    tsl::profiler::ScopedMemoryDebugAnnotation anno(op_name, region_type, 0,
-                                                    []() { return ""; });
+    tsl::profiler::ScopedMemoryDebugAnnotation anno(
+        transfer_op_name_, transfer_region_type_, 0, []() { return ""; });
     // Unblock allocating the underlying memory.
     allocation_events_[buffer_index].reset();
 
@@ -498,9 +490,21 @@ class CommonAsyncHostToDeviceTransferManager
         memory_space_(memory_space) {
     DCHECK_EQ(memory_space_->devices().size(), 1);
     buffer_transfers_in_flight_.resize(undispatched_buffer_refs_.size(), 0);
+    // Raw data is often streamed in many small chunks, so split the debug info
+    // into the memory annotation once rather than for every chunk.
+    transfer_op_name_ = "TransferRawDataToSubBuffer";
+    if (debug_info_.has_value()) {
+      std::vector<std::string> debug_info =
+          absl::StrSplit(debug_info_.value(), ';');
+      transfer_op_name_ = debug_info.empty() ? "" : debug_info.front();
+      transfer_region_type_ = debug_info.size() > 1 ? debug_info.back() : "";
+    }
   }
 
   std::optional<std::string> debug_info_;
+  // Memory debug annotation for raw data transfers, derived from debug_info_.
+  std::string transfer_op_name_;
+  std::string transfer_region_type_;
 
   absl::Mutex mu_;
   // The newly created buffers, which will be returned to the caller via
@@ -31,8 +31,10 @@ limitations under the License.
 #include "absl/strings/str_format.h"
 #include "absl/synchronization/mutex.h"
 #include "xla/client/local_client.h"
+#include "xla/pjrt/event_pool.h"
 #include "xla/pjrt/worker_thread.h"
 #include "xla/stream_executor/device_memory.h"
+#include "xla/stream_executor/event.h"
 #include "xla/stream_executor/stream.h"
 #include "xla/tsl/platform/env.h"
 #include "xla/tsl/platform/errors.h"
@@ -50,7 +52,9 @@ LocalDeviceState::LocalDeviceState(se::StreamExecutor* executor,
                                    int max_inflight_computations,
                                    bool allow_event_reuse,
                                    bool use_callback_stream, int device_ordinal,
-                                   std::optional<StreamOptions> stream_options)
+                                   std::optional<StreamOptions> stream_options,
+                                   std::optional<HostThreadOptions>
+                                       host_thread_options)
     : allocation_model_(allocation_model),
       event_pool_(allow_event_reuse),
       compute_semaphore_(
@@ -122,10 +126,21 @@ LocalDeviceState::LocalDeviceState(se::StreamExecutor* executor,
     external_ready_event_streams_.emplace_back(
         create_stream(absl::StrFormat("External ready event #%d", i)));
   }
-  execute_thread_ =
-      std::make_unique<WorkerThread>(tsl::Env::Default(), "py_xla_execute");
-  callback_thread_ =
-      std::make_unique<WorkerThread>(tsl::Env::Default(), "py_xla_callback");
+  WorkerThread::Options execute_thread_options;
+  WorkerThread::Options callback_thread_options;
+  if (host_thread_options.has_value()) {
+    busy_poll_ = host_thread_options->busy_poll;
+    execute_thread_options.cpu_core =
+        host_thread_options->execute_thread_cpu_core;
+    execute_thread_options.busy_poll = busy_poll_;
+    callback_thread_options.cpu_core =
+        host_thread_options->callback_thread_cpu_core;
+    callback_thread_options.busy_poll = busy_poll_;
+  }
+  execute_thread_ = std::make_unique<WorkerThread>(
+      tsl::Env::Default(), "py_xla_execute", execute_thread_options);
+  callback_thread_ = std::make_unique<WorkerThread>(
+      tsl::Env::Default(), "py_xla_callback", callback_thread_options);
   cleanup_thread_ =
       std::make_unique<WorkerThread>(tsl::Env::Default(), "py_xla_cleanup");
 }
@@ -197,6 +212,26 @@ absl::Status LocalDeviceState::ThenExecuteCallback(
     TF_RETURN_IF_ERROR(callback_stream->second->WaitFor(stream));
     stream = callback_stream->second.get();
   }
+  if (busy_poll_) {
+    // The callback thread spins on the event, so it runs the callback as soon
+    // as the stream reaches it, without waiting for the device runtime to
+    // call back and for the callback thread to wake up. Callbacks still run in
+    // the order in which they were enqueued.
+    TF_ASSIGN_OR_RETURN(EventPool::Handle event,
+                        event_pool_.ThenAllocateAndRecordEvent(stream));
+    callback_thread_->Schedule([event{std::move(event)},
+                                callback{std::move(callback)}]() mutable {
+      se::Event::Status status = event.event()->PollForStatus();
+      while (status == se::Event::Status::kPending) {
+        status = event.event()->PollForStatus();
+      }
+      if (status != se::Event::Status::kComplete) {
+        LOG(ERROR) << "Failed to poll the event of a stream callback";
+      }
+      std::move(callback)();
+    });
+    return absl::OkStatus();
+  }
   return stream->DoHostCallback(
       [this, callback{std::move(callback)}]() mutable {
         callback_thread_->Schedule(std::move(callback));
@@ -1736,6 +1736,22 @@ static void CppRecvCallbackListsToC(
   }
 }
 
+absl::StatusOr<size_t> PjRtCApiLoadedExecutable::GetNumOutputs() {
+  absl::MutexLock lock(&num_outputs_mu_);
+  if (num_outputs_.has_value()) {
+    return *num_outputs_;
+  }
+
+  PJRT_Executable_NumOutputs_Args args;
+  args.struct_size = PJRT_Executable_NumOutputs_Args_STRUCT_SIZE;
+  args.extension_start = nullptr;
+  args.executable = c_executable();
+  RETURN_STATUS_IF_PJRT_ERROR(pjrt_c_api()->PJRT_Executable_NumOutputs(&args),
+                              pjrt_c_api());
+  num_outputs_ = args.num_outputs;
+  return *num_outputs_;
+}
+
 absl::StatusOr<PJRT_LoadedExecutable_Execute_Args>
 PjRtCApiLoadedExecutable::GetCommonExecuteArgs(
     absl::Span<const std::vector<PjRtBuffer*>> argument_handles,
@@ -1792,14 +1808,9 @@ PjRtCApiLoadedExecutable::GetCommonExecuteArgs(
   // Allocates memory for output. `c_buffer_lists_storage` and `c_buffer_lists`
   // needs to stay alive during the call of `PJRT_LoadedExecutable_Execute`.
 
-  PJRT_Executable_NumOutputs_Args numoutputs_args;
-  numoutputs_args.struct_size = PJRT_Executable_NumOutputs_Args_STRUCT_SIZE;
-  numoutputs_args.extension_start = nullptr;
-  numoutputs_args.executable = c_executable();
-  RETURN_STATUS_IF_PJRT_ERROR(
-      pjrt_c_api()->PJRT_Executable_NumOutputs(&numoutputs_args), pjrt_c_api());
+  TF_ASSIGN_OR_RETURN(size_t num_outputs, GetNumOutputs());
   size_t outer_size = args.num_devices;
-  size_t inner_size = numoutputs_args.num_outputs;
+  size_t inner_size = num_outputs;
   c_output_lists_storage.resize(outer_size);
   c_output_lists.resize(outer_size);
   for (int i = 0; i < outer_size; ++i) {
@@ -26,6 +26,7 @@ limitations under the License.
 #include <variant>
 #include <vector>
 
+#include "absl/base/thread_annotations.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/inlined_vector.h"
 #include "absl/functional/any_invocable.h"
@@ -720,12 +721,20 @@ class PjRtCApiLoadedExecutable : public PjRtLoadedExecutable {
                           std::optional<PjRtFuture<>>& returned_future,
                           bool fill_future);
 
+  // Returns the number of outputs of the executable. The plugin computes it
+  // from the output shapes, which is too expensive to repeat on every Execute,
+  // so the first successful result is cached.
+  absl::StatusOr<size_t> GetNumOutputs();
+
   PjRtCApiClient* client_;
   std::unique_ptr<PJRT_LoadedExecutable, ::pjrt::PJRT_LoadedExecutableDeleter>
       loaded_executable_;
   std::unique_ptr<PjRtCApiExecutable> executable_;
   std::vector<PjRtDevice*> addressable_devices_;
 
+  absl::Mutex num_outputs_mu_;
+  std::optional<size_t> num_outputs_ ABSL_GUARDED_BY(num_outputs_mu_);
+
   void InitDevices();
 };
 
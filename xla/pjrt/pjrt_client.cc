@@ -15,17 +15,21 @@ limitations under the License.
 
 #include "xla/pjrt/pjrt_client.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <memory>
 #include <string>
 #include <utility>
+#include <variant>
 
 #include "absl/base/casts.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/log/log.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
 #include "absl/strings/substitute.h"
+#include "absl/time/time.h"
 #include "xla/hlo/ir/hlo_module.h"
 #include "xla/pjrt/pjrt_common.h"
 #include "xla/pjrt/pjrt_executable.h"
@@ -81,6 +85,22 @@ std::string CompiledMemoryStats::DebugString() const {
       host_temp_size_in_bytes);
 }
 
+std::string ExecutableStats::DebugString() const {
+  return absl::Substitute(
+      "ExecutableStats("
+      "flops=$0, "
+      "bytes_accessed=$1, "
+      "estimated_run_time=$2, "
+      "peak_memory_in_bytes=$3, "
+      "num_executions=$4, "
+      "latency_p50=$5, "
+      "latency_p90=$6, "
+      "latency_p99=$7)",
+      flops, bytes_accessed, absl::FormatDuration(estimated_run_time),
+      peak_memory_in_bytes, num_executions, absl::FormatDuration(latency_p50),
+      absl::FormatDuration(latency_p90), absl::FormatDuration(latency_p99));
+}
+
 // Defining the first virtual non-pure method, which is usually the virtual
 // destructor, makes it a key function. This reduces the program size and takes
 // fewer linker resources.
@@ -96,6 +116,38 @@ PjRtLoadedExecutable::GetCostAnalysis() const {
                                                 hlo_cost_analysis.get());
 }
 
+absl::StatusOr<ExecutableStats> PjRtLoadedExecutable::GetExecutableStats()
+    const {
+  TF_ASSIGN_OR_RETURN(auto cost_analysis, GetCostAnalysis());
+  auto get_cost = [&](absl::string_view key) -> double {
+    auto it = cost_analysis.find(key);
+    if (it == cost_analysis.end()) {
+      return 0;
+    }
+    if (const float* value = std::get_if<float>(&it->second)) {
+      return *value;
+    }
+    if (const int64_t* value = std::get_if<int64_t>(&it->second)) {
+      return *value;
+    }
+    return 0;
+  };
+  ExecutableStats stats;
+  stats.flops = get_cost(HloCostAnalysis::kFlopsKey);
+  stats.bytes_accessed = get_cost(HloCostAnalysis::kBytesAccessedKey);
+  // The optimal seconds are negative if some instruction has no estimate.
+  stats.estimated_run_time = absl::Seconds(
+      std::max(0.0, get_cost(HloCostAnalysis::kOptimalSecondsKey)));
+
+  TF_ASSIGN_OR_RETURN(CompiledMemoryStats memory_stats,
+                      GetCompiledMemoryStats());
+  stats.peak_memory_in_bytes =
+      memory_stats.generated_code_size_in_bytes +
+      memory_stats.argument_size_in_bytes + memory_stats.output_size_in_bytes -
+      memory_stats.alias_size_in_bytes + memory_stats.temp_size_in_bytes;
+  return stats;
+}
+
 PjRtExecutable* PjRtLoadedExecutable::GetExecutable() const {
   return executable_forwarder_.get();
 }
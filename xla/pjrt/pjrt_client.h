@@ -1285,6 +1285,11 @@ class PjRtLoadedExecutable {
   virtual absl::StatusOr<absl::flat_hash_map<std::string, PjRtValueType>>
   GetCostAnalysis() const;
 
+  // Returns compile-time estimates and runtime statistics of this executable.
+  // The default implementation only fills in the estimates, from
+  // GetCostAnalysis and GetCompiledMemoryStats.
+  virtual absl::StatusOr<ExecutableStats> GetExecutableStats() const;
+
   // The replica and partition indices of device_assignment to be run by this
   // client. On single-host platforms without partitioning, this is all replicas
   // (i.e. addressable_device_logical_ids_[i] = (i, 0)), but this may not be the
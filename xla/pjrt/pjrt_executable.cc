@@ -171,6 +171,8 @@ absl::StatusOr<ExecuteOptionsProto> ExecuteOptions::ToProto() const {
 
   proto.mutable_non_donatable_input_indices()->Add(
       non_donatable_input_indices.begin(), non_donatable_input_indices.end());
+  proto.set_infer_non_donatable_inputs(infer_non_donatable_inputs);
+  proto.set_max_intra_op_parallelism(max_intra_op_parallelism);
 
   if (execution_profile != nullptr) {
     return absl::UnimplementedError(
@@ -210,6 +212,8 @@ absl::StatusOr<ExecuteOptions> ExecuteOptions::FromProto(
   options.non_donatable_input_indices.insert(
       proto.non_donatable_input_indices().begin(),
       proto.non_donatable_input_indices().end());
+  options.infer_non_donatable_inputs = proto.infer_non_donatable_inputs();
+  options.max_intra_op_parallelism = proto.max_intra_op_parallelism();
 
   return options;
 }
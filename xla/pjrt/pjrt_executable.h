@@ -29,6 +29,7 @@ limitations under the License.
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
+#include "absl/time/time.h"
 #include "absl/types/span.h"
 #include "xla/client/executable_build_options.h"
 #include "xla/ffi/execution_context.h"
@@ -270,6 +271,19 @@ struct ExecuteOptions {
   // specific input buffers.
   absl::flat_hash_set<int> non_donatable_input_indices;
 
+  // If true, PjRt infers additional non-donatable inputs from the liveness of
+  // the buffers: an input of a `may-alias` parameter is not donated if its
+  // buffer is also passed as another input or is referenced by an external
+  // framework. Otherwise, such donations fail the execution. Inputs of
+  // `must-alias` parameters are always donated.
+  bool infer_non_donatable_inputs = false;
+
+  // If positive, the maximum number of intra-op threads that the execution
+  // uses for parallel work, so that concurrent executions share the intra-op
+  // thread pool instead of each of them using all of it. Currently it is only
+  // applied to CPU implementations.
+  int32_t max_intra_op_parallelism = 0;
+
   absl::StatusOr<ExecuteOptionsProto> ToProto() const;
   static absl::StatusOr<ExecuteOptions> FromProto(
       const ExecuteOptionsProto& proto);
@@ -308,6 +322,30 @@ struct CompiledMemoryStats {
       absl::Span<const BufferAllocation> allocs);
 };
 
+// Compile-time estimates and runtime statistics of a loaded executable, e.g.
+// for admission control or for packing executables onto devices.
+struct ExecutableStats {
+  // Estimates from the cost analysis of the optimized program.
+  double flops = 0;
+  double bytes_accessed = 0;
+  // Zero if the platform has no performance model.
+  absl::Duration estimated_run_time;
+  // Lower bound of the device memory needed to run the executable, see
+  // CompiledMemoryStats.
+  int64_t peak_memory_in_bytes = 0;
+
+  // Executions observed since the executable was loaded, counting every device
+  // the executable ran on. The latency spans from enqueueing an execution
+  // until it completes on the device. Zero if the platform does not record
+  // executions.
+  int64_t num_executions = 0;
+  absl::Duration latency_p50;
+  absl::Duration latency_p90;
+  absl::Duration latency_p99;
+
+  std::string DebugString() const;
+};
+
 class PjRtExecutable {
  public:
   virtual ~PjRtExecutable() = default;
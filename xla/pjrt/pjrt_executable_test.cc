@@ -72,6 +72,8 @@ TEST(ExecuteOptionsTest, Serialization) {
   src.strict_shape_checking = true;
   src.execution_mode = ExecuteOptions::ExecutionMode::kAsynchronous;
   src.non_donatable_input_indices = {2, 3};
+  src.infer_non_donatable_inputs = true;
+  src.max_intra_op_parallelism = 4;
 
   TF_ASSERT_OK_AND_ASSIGN(ExecuteOptionsProto proto, src.ToProto());
   TF_ASSERT_OK_AND_ASSIGN(ExecuteOptions output,
@@ -65,6 +65,8 @@ limitations under the License.
 #include "xla/pjrt/pjrt_stream_executor_client.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
@@ -145,6 +147,8 @@ limitations under the License.
 #include "xla/stream_executor/stream.h"
 #include "xla/tsl/concurrency/ref_count.h"
 #include "xla/tsl/framework/allocator.h"
+#include "xla/tsl/lib/histogram/histogram.h"
+#include "xla/tsl/lib/strings/proto_serialization.h"
 #include "xla/util.h"
 #include "xla/xla_data.pb.h"
 #include "tsl/platform/casts.h"
@@ -152,6 +156,7 @@ limitations under the License.
 #include "tsl/platform/mem.h"
 #include "tsl/profiler/lib/connected_traceme.h"
 #include "tsl/profiler/lib/context_types.h"
+#include "tsl/profiler/lib/scoped_memory_debug_annotation.h"
 #include "tsl/profiler/lib/traceme.h"
 
 namespace xla {
@@ -388,6 +393,35 @@ void RecordUsage(PjRtStreamExecutorBuffer::ScopedHold device_buffer,
                                  retain_buffer_until_completion);
 }
 
+// Batched version of RecordUsage for the arguments of an execution, which are
+// all allocated on the device that manages `usage_stream`. Holds that are not
+// usage holds are skipped.
+void RecordUsages(
+    absl::Span<PjRtStreamExecutorBuffer::ScopedHold> device_buffers,
+    LocalDeviceState* local_device,
+    const std::shared_ptr<BufferSequencingEvent>& event,
+    se::Stream* usage_stream,
+    std::vector<tsl::RCReference<RawSEDeviceMemory>>* buffers_to_release) {
+  tsl::profiler::TraceMe traceme("RecordUsages");
+  // In the synchronous allocation model, always retain a reference.
+  bool retain_buffer_until_completion =
+      local_device->allocation_model() == LocalDeviceState::kSynchronous;
+  if (retain_buffer_until_completion) {
+    buffers_to_release->reserve(buffers_to_release->size() +
+                                device_buffers.size());
+  }
+  for (PjRtStreamExecutorBuffer::ScopedHold& device_buffer : device_buffers) {
+    if (device_buffer.type() != PjRtStreamExecutorBuffer::ScopedHold::kUsage) {
+      continue;
+    }
+    if (retain_buffer_until_completion) {
+      buffers_to_release->push_back(device_buffer->device_memory());
+    }
+    device_buffer.ConvertUsageHold(usage_stream, event,
+                                   retain_buffer_until_completion);
+  }
+}
+
 // Adds necessary synchronization after a copy has been enqueued to a buffer.
 // definition_event was added when the buffer was allocated, but has not yet
 // had an event recorded.
@@ -709,6 +743,71 @@ PjRtStreamExecutorBuffer::DonateWithControlDependency(PjRtFuture<> dependency) {
   return new_buffer;
 }
 
+// Host to device transfers of at least this many bytes that must be staged
+// before returning to the caller are pipelined through pinned staging chunks.
+static constexpr int64_t kDoubleBufferedTransferMinBytes = int64_t{64} << 20;
+static constexpr int64_t kDoubleBufferedTransferChunkBytes = int64_t{16} << 20;
+
+// Copies `size` bytes from `data` to `device_memory` on `stream` through two
+// pinned staging chunks, so that the copy of a chunk into pinned memory
+// overlaps with the DMA of the previous chunk. Returns after `data` was fully
+// copied to pinned memory, the DMAs of the last chunks may still be pending.
+static absl::Status TransferToDeviceDoubleBuffered(
+    se::Stream* stream, tsl::Allocator* host_memory_allocator,
+    const void* data, int64_t size, se::DeviceMemoryBase device_memory) {
+  tsl::profiler::TraceMe traceme("TransferToDeviceDoubleBuffered");
+
+  // Staging chunks and the number of chunks transferred to the device, shared
+  // with host callbacks that may run after this function returns.
+  struct State {
+    std::array<std::shared_ptr<void>, 2> chunks;
+    absl::Mutex mu;
+    int64_t num_transferred_chunks ABSL_GUARDED_BY(mu) = 0;
+  };
+  auto state = std::make_shared<State>();
+
+  for (std::shared_ptr<void>& chunk : state->chunks) {
+    void* ptr = host_memory_allocator->AllocateRaw(
+        tsl::Allocator::kAllocatorAlignment, kDoubleBufferedTransferChunkBytes);
+    if (ptr == nullptr) {
+      return ResourceExhausted(
+          "Failed to allocate %d bytes of pinned host memory for staging a "
+          "host to device transfer",
+          kDoubleBufferedTransferChunkBytes);
+    }
+    chunk = std::shared_ptr<void>(ptr, [host_memory_allocator](void* ptr) {
+      host_memory_allocator->DeallocateRaw(ptr);
+    });
+  }
+
+  const char* src = static_cast<const char*>(data);
+  int64_t num_chunks = CeilOfRatio(size, kDoubleBufferedTransferChunkBytes);
+  for (int64_t i = 0; i < num_chunks; ++i) {
+    int64_t offset = i * kDoubleBufferedTransferChunkBytes;
+    int64_t chunk_size =
+        std::min(kDoubleBufferedTransferChunkBytes, size - offset);
+    void* chunk = state->chunks[i % 2].get();
+
+    // Wait for the DMA from the same staging chunk two iterations ago.
+    {
+      absl::MutexLock lock(&state->mu);
+      auto chunk_is_free = [&]() ABSL_SHARED_LOCKS_REQUIRED(state->mu) {
+        return state->num_transferred_chunks >= i - 1;
+      };
+      state->mu.Await(absl::Condition(&chunk_is_free));
+    }
+
+    std::memcpy(chunk, src + offset, chunk_size);
+    se::DeviceMemoryBase dst = device_memory.GetByteSlice(offset, chunk_size);
+    TF_RETURN_IF_ERROR(stream->Memcpy(&dst, chunk, chunk_size));
+    TF_RETURN_IF_ERROR(stream->DoHostCallback([state]() {
+      absl::MutexLock lock(&state->mu);
+      ++state->num_transferred_chunks;
+    }));
+  }
+  return absl::OkStatus();
+}
+
 // BufferFromHostBuffer() is used to create a buffer either for a device, or
 // for a host memory, depending on `memory_space`. The memory copy is needed
 // for both cases, either from the unpinned host memory to device, or from
@@ -774,6 +873,12 @@ PjRtStreamExecutorClient::BufferFromHostBufferInternal(
     options.dims = dims;
     options.permutation = permutation;
     options.input_layout = TransposePlan::Striding{*byte_strides};
+    // Buffers that are only valid during the call are transposed on the
+    // calling thread, parallelize the transpose over the client thread pool.
+    if (host_buffer_semantics ==
+        HostBufferSemantics::kImmutableOnlyDuringCall) {
+      options.num_threads = thread_pool()->NumThreads();
+    }
     absl::MutexLock lock(&transpose_mu_);
     TF_ASSIGN_OR_RETURN(transpose, transpose_cache_.GetOrCreate(options));
   }
@@ -788,6 +893,35 @@ PjRtStreamExecutorClient::BufferFromHostBufferInternal(
     packed_size = size;
   }
 
+  std::shared_ptr<BufferSequencingEvent> event =
+      device_buffer->definition_events()[0];
+
+  // Large buffers that are only valid during the call are copied to the device
+  // through double-buffered staging chunks, instead of copying the whole buffer
+  // into pinned memory before starting the DMA.
+  if (host_buffer_semantics == HostBufferSemantics::kImmutableOnlyDuringCall &&
+      !transpose && !should_pack && size >= kDoubleBufferedTransferMinBytes) {
+    se::Stream* stream = local_device->host_to_device_stream();
+    auto device_memory_owned = device_buffer->device_memory();
+    absl::Status status =
+        TransferToDeviceDoubleBuffered(stream, host_memory_allocator(), data,
+                                       size, device_memory_owned->mem());
+    if (on_done_with_host_buffer) {
+      std::move(on_done_with_host_buffer)();
+    }
+    if (status.ok()) {
+      status = AddDestinationBufferSynchronization(local_device, event, stream);
+    }
+    if (!status.ok()) {
+      event->SetDefinedStatus(status);
+      return status;
+    }
+    local_device->ThenRelease(stream, device_memory_owned).IgnoreError();
+    RecordUsage(std::move(device_buffer), local_device, local_device, event,
+                stream);
+    return std::unique_ptr<PjRtBuffer>(std::move(py_buffer));
+  }
+
   // If necessary, allocate a host-side buffer for staging host-to-device
   // transfers. On GPU this is a buffer in pinned memory.
   std::shared_ptr<void> staging_buffer;
@@ -814,7 +948,10 @@ PjRtStreamExecutorClient::BufferFromHostBufferInternal(
   // thread.
   if (host_buffer_semantics == HostBufferSemantics::kImmutableOnlyDuringCall) {
     if (transpose) {
-      transpose->Execute(data, staging_buffer.get());
+      auto schedule_work = [this](std::function<void()> fn) {
+        thread_pool()->Schedule(std::move(fn));
+      };
+      transpose->Execute(data, staging_buffer.get(), schedule_work);
       if (should_pack) {
         primitive_util::PackIntN(
             type,
@@ -839,9 +976,6 @@ PjRtStreamExecutorClient::BufferFromHostBufferInternal(
     }
   }
 
-  std::shared_ptr<BufferSequencingEvent> event =
-      device_buffer->definition_events()[0];
-
   // The host to device transfer is performed on a thread pool, mostly because
   // it includes linearization that may be slow. It is OK to capture the
   // py_buffer pointer because the py_buffer can't be deleted until all the
@@ -1817,6 +1951,190 @@ PjRtStreamExecutorBuffer::CopyToMemorySpace(PjRtMemorySpace* dst_memory_space) {
   return Unimplemented("CopyToMemorySpace is not supported");
 }
 
+/*static*/ absl::StatusOr<std::vector<std::unique_ptr<PjRtBuffer>>>
+PjRtStreamExecutorBuffer::CopyBatchToMemorySpace(
+    absl::Span<PjRtStreamExecutorBuffer* const> buffers,
+    PjRtMemorySpace* dst_memory_space) {
+  tsl::profiler::TraceMe traceme(
+      "PjRtStreamExecutorBuffer::CopyBatchToMemorySpace");
+  std::vector<std::unique_ptr<PjRtBuffer>> results;
+  results.reserve(buffers.size());
+  if (buffers.empty()) {
+    return results;
+  }
+
+  PjRtStreamExecutorBuffer* first = buffers.front();
+  bool can_batch =
+      dst_memory_space->client() == first->client_ &&
+      dst_memory_space->devices().size() == 1 &&
+      absl::c_all_of(buffers, [&](PjRtStreamExecutorBuffer* buffer) {
+        return buffer->client_ == first->client_ &&
+               buffer->device_ == first->device_;
+      });
+  if (!can_batch) {
+    for (PjRtStreamExecutorBuffer* buffer : buffers) {
+      TF_ASSIGN_OR_RETURN(std::unique_ptr<PjRtBuffer> result,
+                          buffer->CopyToMemorySpace(dst_memory_space));
+      results.push_back(std::move(result));
+    }
+    return results;
+  }
+
+  PjRtStreamExecutorClient* client = first->client_;
+  PjRtDevice* dst_device = dst_memory_space->devices()[0];
+  TF_ASSIGN_OR_RETURN(
+      LocalDeviceState * dst_local_device,
+      tensorflow::down_cast<PjRtStreamExecutorDevice*>(dst_device)
+          ->GetLocalDeviceState());
+  LocalDeviceState* src_local_device = first->device_->local_device_state();
+  LocalDeviceState* transfer_local_device =
+      client->EnqueueD2DTransfersOnSrcStream() ? src_local_device
+                                               : dst_local_device;
+  CHECK_EQ(dst_local_device->allocation_model(),
+           transfer_local_device->allocation_model());
+
+  se::Stream* transfer_stream =
+      transfer_local_device->GetDeviceToDeviceStream();
+
+  // Acquire all source holds before allocating destination buffers, so that
+  // no destination buffer is left without a definition event on error.
+  std::vector<ScopedHold> src_device_buffers;
+  src_device_buffers.reserve(buffers.size());
+  for (PjRtStreamExecutorBuffer* buffer : buffers) {
+    src_device_buffers.push_back(buffer->GetBufferWithUsageHold());
+    if (!src_device_buffers.back().ok()) {
+      return InvalidArgument(
+          "CopyToDevice() called on deleted or donated buffer: %s",
+          src_device_buffers.back().status().ToString());
+    }
+  }
+
+  // All destination buffers of the batch share a single definition event.
+  auto copy_event =
+      std::make_shared<BufferSequencingEvent>(client->thread_pool());
+
+  std::vector<ScopedHold> dst_device_buffers;
+  dst_device_buffers.reserve(buffers.size());
+  for (PjRtStreamExecutorBuffer* buffer : buffers) {
+    absl::StatusOr<std::unique_ptr<PjRtStreamExecutorBuffer>> dst_buffer =
+        AllocateDestinationBuffer(
+            ShapeUtil::DeviceShapeToHostShape(buffer->on_device_shape_),
+            dst_device, dst_local_device, transfer_stream,
+            /*is_uninitialized_create=*/false, client, copy_event,
+            dst_memory_space);
+    if (!dst_buffer.ok()) {
+      copy_event->SetDefinedStatus(dst_buffer.status());
+      return dst_buffer.status();
+    }
+    dst_device_buffers.push_back((*dst_buffer)->GetBufferWithUsageHold());
+    CHECK(dst_device_buffers.back().ok());
+    results.push_back(*std::move(dst_buffer));
+  }
+
+  std::vector<tsl::RCReference<RawSEDeviceMemory>> src_memories;
+  std::vector<tsl::RCReference<RawSEDeviceMemory>> dst_memories;
+  std::vector<std::shared_ptr<BufferSequencingEvent>> src_definition_events;
+  absl::flat_hash_set<BufferSequencingEvent*> unique_src_definition_events;
+  for (int64_t i = 0; i < buffers.size(); ++i) {
+    src_memories.push_back(src_device_buffers[i]->device_memory());
+    dst_memories.push_back(dst_device_buffers[i]->device_memory());
+    for (const auto& event : src_device_buffers[i]->definition_events()) {
+      if (unique_src_definition_events.insert(event.get()).second) {
+        src_definition_events.push_back(event);
+      }
+    }
+  }
+
+  auto batch_copy_to_device = [src_memories = std::move(src_memories),
+                               dst_memories = std::move(dst_memories),
+                               src_definition_events, transfer_stream,
+                               copy_event, src_local_device,
+                               transfer_local_device,
+                               dst_local_device]() mutable {
+    tsl::profiler::TraceMe traceme(
+        "PjRtStreamExecutorBuffer::CopyBatchToMemorySpace::batch_copy");
+
+    for (const auto& event : src_definition_events) {
+      absl::Status defined_status = event->GetDefinedStatus();
+      // Only proceeds to transfer when no source buffer holds an error.
+      if (!defined_status.ok()) {
+        copy_event->SetDefinedStatus(defined_status);
+        return;
+      }
+    }
+
+    WaitForBufferDefinitionEventsOnStream(src_definition_events,
+                                          transfer_stream);
+
+    for (int64_t i = 0; i < src_memories.size(); ++i) {
+      const se::DeviceMemoryBase& input_buffer = src_memories[i]->mem();
+      const se::DeviceMemoryBase& output_buffer = dst_memories[i]->mem();
+      CHECK_EQ(input_buffer.size(), output_buffer.size());
+      if (input_buffer.size() == 0) {
+        continue;
+      }
+      auto status = transfer_local_device->ThenMemcpyDeviceToDevice(
+          transfer_stream, dst_local_device->compute_stream(), input_buffer,
+          output_buffer);
+      if (!status.ok()) {
+        LOG(ERROR) << "D2D memory copy failed due to: " << status;
+        StallStreamOnError(transfer_local_device, transfer_stream);
+        // Some copies may have been enqueued before the error was returned,
+        // make sure that the src buffers remain valid until after any
+        // transfers have completed.
+        auto release_status = src_local_device->ThenRelease(
+            transfer_stream, std::move(src_memories));
+        if (!release_status.ok()) {
+          LOG(ERROR) << "ThenRelease failed due to: " << release_status;
+        }
+        return;
+      }
+    }
+
+    absl::StatusOr<EventPool::Handle> event_or =
+        transfer_local_device->event_pool().ThenAllocateAndRecordEvent(
+            transfer_stream);
+    if (!event_or.ok()) {
+      StallStreamOnError(transfer_local_device, transfer_stream);
+      LOG(ERROR) << event_or.status();
+      return;
+    }
+    copy_event->SetSequencingEvent(std::move(event_or).value(),
+                                   transfer_stream);
+
+    auto status =
+        src_local_device->ThenRelease(transfer_stream, std::move(src_memories));
+    if (!status.ok()) {
+      LOG(ERROR) << "ThenRelease failed due to: " << status;
+    }
+  };
+
+  // Run the batch copy once all source definition events are defined.
+  auto pending_events =
+      std::make_shared<std::atomic<int64_t>>(src_definition_events.size());
+  auto batch_copy = std::make_shared<decltype(batch_copy_to_device)>(
+      std::move(batch_copy_to_device));
+  for (const auto& event : src_definition_events) {
+    event->ExecuteOrAddToFutureTasks(
+        absl::StrFormat("batch_copy_to_device_%p", copy_event.get()),
+        [pending_events, batch_copy]() {
+          if (pending_events->fetch_sub(1) == 1) {
+            (*batch_copy)();
+          }
+        });
+  }
+
+  for (ScopedHold& dst_device_buffer : dst_device_buffers) {
+    RecordUsage(std::move(dst_device_buffer), transfer_local_device,
+                transfer_local_device, copy_event, transfer_stream);
+  }
+  for (ScopedHold& src_device_buffer : src_device_buffers) {
+    src_device_buffer.ConvertUsageHold(transfer_stream, copy_event,
+                                       /*reference_held=*/true);
+  }
+  return results;
+}
+
 void PjRtStreamExecutorBuffer::CopyToRemoteDevice(
     PjRtFuture<std::string> serialized_descriptor, RemoteSendCallback on_done) {
   VLOG(3) << "PjRtStreamExecutorBuffer::CopyToRemoteDevice";
@@ -2192,12 +2510,19 @@ PjRtStreamExecutorLoadedExecutable::PjRtStreamExecutorLoadedExecutable(
 absl::Status PjRtStreamExecutorLoadedExecutable::SetUpDonation(
     bool tuple_inputs) {
   parameters_that_must_be_donated_.reserve(executables_.size());
+  parameters_that_may_be_donated_.reserve(executables_.size());
   for (auto& executable : executables_) {
     TF_ASSIGN_OR_RETURN(std::vector<int> parameters_to_donate,
                         ComputeParametersThatMustBeDonated(
                             executable->executable()->module(), tuple_inputs));
     parameters_that_must_be_donated_.emplace_back(
         std::move(parameters_to_donate));
+    TF_ASSIGN_OR_RETURN(std::vector<int> optional_parameters_to_donate,
+                        ComputeParametersThatMayBeDonated(
+                            executable->executable()->module(), tuple_inputs));
+    parameters_that_may_be_donated_.emplace_back(
+        optional_parameters_to_donate.begin(),
+        optional_parameters_to_donate.end());
   }
   return absl::OkStatus();
 }
@@ -2596,6 +2921,18 @@ PjRtStreamExecutorLoadedExecutable::EnqueueExecution(
   auto donate_it = donated_params.begin();
   absl::flat_hash_map<const void*, std::pair<bool, int>> donation_clashes;
   donation_clashes.reserve(argument_handles.size());
+  // Donating a may-alias parameter is optional, so if asked to, skip it
+  // instead of failing the execution when the buffer is used elsewhere.
+  const absl::flat_hash_set<int>& optional_donations =
+      parameters_that_may_be_donated_[executable_idx];
+  const bool infer_donations =
+      options.infer_non_donatable_inputs && !optional_donations.empty();
+  absl::flat_hash_map<const PjRtBuffer*, int> argument_uses;
+  if (infer_donations) {
+    for (PjRtBuffer* handle : argument_handles) {
+      ++argument_uses[handle];
+    }
+  }
   for (int i = 0; i < argument_handles.size(); ++i) {
     auto* handle =
         tensorflow::down_cast<PjRtStreamExecutorBuffer*>(argument_handles[i]);
@@ -2607,11 +2944,17 @@ PjRtStreamExecutorLoadedExecutable::EnqueueExecution(
     }
     bool donation_denied_at_runtime =
         options.non_donatable_input_indices.contains(i);
-    bool must_donate = donate_it != donated_params.end() && *donate_it == i &&
-                       !donation_denied_at_runtime;
+    bool must_donate = donate_it != donated_params.end() && *donate_it == i;
     if (must_donate) {
       ++donate_it;
     }
+    if (must_donate && infer_donations && optional_donations.contains(i) &&
+        (argument_uses[handle] > 1 || handle->HasExternalReference())) {
+      VLOG(2) << "Not donating argument " << i << " to replica " << replica
+              << ": the buffer is also used elsewhere.";
+      donation_denied_at_runtime = true;
+    }
+    must_donate = must_donate && !donation_denied_at_runtime;
     TF_RETURN_IF_ERROR(TestBufferDonationClashes(
         handle, donation_clashes, must_donate, i, replica, partition));
     device_buffers->emplace_back(handle->GetBufferWithHold(
@@ -2747,6 +3090,10 @@ PjRtStreamExecutorLoadedExecutable::EnqueueExecution(
     }
   }
 
+  // Tags the device allocations made by the execution with the executable,
+  // e.g. in the allocation trace of the BFC allocator.
+  tsl::profiler::ScopedMemoryDebugAnnotation memory_annotation(
+      executables_[executable_idx]->executable()->module().name());
   absl::StatusOr<PjRtStreamExecutorExecutionOutput> result_buffer_or_status =
       client_->RunAsync(*executables_[executable_idx], device,
                         std::move(execution_inputs), run_options);
@@ -2978,16 +3325,22 @@ PjRtStreamExecutorLoadedExecutable::ExecuteHelper(
                         definition_event, device, compute_callbacks,
                         buffers_to_release));
 
+  // All arguments share the definition event of the outputs as usage event.
+  RecordUsages(absl::MakeSpan(device_buffers), device_state, definition_event,
+               stream, &buffers_to_release);
   for (PjRtStreamExecutorBuffer::ScopedHold& b : device_buffers) {
-    if (b.type() == PjRtStreamExecutorBuffer::ScopedHold::kUsage) {
-      RecordUsage(std::move(b), device_state, device_state, definition_event,
-                  stream, &buffers_to_release);
-    } else {
-      CHECK(b.type() == PjRtStreamExecutorBuffer::ScopedHold::kDonation);
+    if (b.type() == PjRtStreamExecutorBuffer::ScopedHold::kDonation) {
       b.ConfirmDonation();
     }
   }
 
+  compute_callbacks.push_back(
+      [execution_latencies = execution_latencies_, start_time_usecs]() {
+        execution_latencies->latency_usecs.Add(
+            tsl::Env::Default()->NowMicros() - start_time_usecs);
+        execution_latencies->num_executions.fetch_add(1);
+      });
+
   std::optional<PjRtFuture<>> future;
   if (fill_future) {
     auto promise = PjRtFuture<>::CreatePromise();
@@ -3225,6 +3578,29 @@ PjRtStreamExecutorLoadedExecutable::ExecutePortable(
   return std::move(result.buffers);
 }
 
+absl::StatusOr<ExecutableStats>
+PjRtStreamExecutorLoadedExecutable::GetExecutableStats() const {
+  TF_ASSIGN_OR_RETURN(ExecutableStats stats,
+                      PjRtLoadedExecutable::GetExecutableStats());
+  if (executables_.size() == 1 && executables_[0]->executable()->has_module()) {
+    std::optional<absl::Duration> run_time =
+        client_->EstimateRunTime(executables_[0]->executable()->module());
+    if (run_time.has_value()) {
+      stats.estimated_run_time = *run_time;
+    }
+  }
+
+  stats.num_executions = execution_latencies_->num_executions.load();
+  if (stats.num_executions > 0) {
+    const tsl::histogram::ThreadSafeHistogram& latency_usecs =
+        execution_latencies_->latency_usecs;
+    stats.latency_p50 = absl::Microseconds(latency_usecs.Percentile(50));
+    stats.latency_p90 = absl::Microseconds(latency_usecs.Percentile(90));
+    stats.latency_p99 = absl::Microseconds(latency_usecs.Percentile(99));
+  }
+  return stats;
+}
+
 absl::StatusOr<std::vector<std::shared_ptr<HloModule>>>
 PjRtStreamExecutorLoadedExecutable::GetHloModules() const {
   std::vector<std::shared_ptr<HloModule>> modules;
@@ -3430,6 +3806,32 @@ absl::Status PjRtStreamExecutorClient::UpdateCompileOptionsInternal(
   return absl::OkStatus();
 }
 
+absl::StatusOr<std::string> PjRtStreamExecutorClient::CompileCacheKey(
+    const XlaComputation& computation,
+    const std::vector<const Shape*>& argument_layout_pointers,
+    const CompileOptions& options, bool lookup_addressable_devices) const {
+  std::string program;
+  if (!tsl::SerializeToStringDeterministic(computation.proto(), &program)) {
+    return Internal("Failed to serialize the computation.");
+  }
+  TF_ASSIGN_OR_RETURN(CompileOptionsProto options_proto, options.ToProto());
+  std::string serialized_options;
+  if (!tsl::SerializeToStringDeterministic(options_proto,
+                                           &serialized_options)) {
+    return Internal("Failed to serialize the compile options.");
+  }
+  std::string key = absl::StrCat(
+      platform_name(), "|", platform_version(), "|",
+      devices().empty() ? "" : devices().front()->device_kind(), "|",
+      lookup_addressable_devices ? "1" : "0", "|", serialized_options);
+  for (const Shape* argument_layout : argument_layout_pointers) {
+    absl::StrAppend(&key, "|", argument_layout->ToString(true));
+  }
+  tsl::Fprint128 fingerprint = tsl::FingerprintCat128(
+      tsl::Fingerprint128(program), tsl::Fingerprint128(key));
+  return absl::StrFormat("%016x%016x", fingerprint.high64, fingerprint.low64);
+}
+
 absl::StatusOr<std::unique_ptr<PjRtExecutable>>
 PjRtStreamExecutorClient::CompileInternal(
     const XlaComputation& computation,
@@ -3456,12 +3858,55 @@ PjRtStreamExecutorClient::CompileInternal(
         layout_canonicalization_callback);
   }
 
+  // Cache failures are not fatal, the computation is compiled instead.
+  absl::StatusOr<std::string> cache_key = absl::FailedPreconditionError(
+      "The client has no compile cache.");
+  if (compile_cache_ != nullptr) {
+    cache_key = CompileCacheKey(computation, argument_layout_pointers,
+                                input_options, lookup_addressable_devices);
+    if (!cache_key.ok()) {
+      LOG(WARNING) << "Failed to compute the compile cache key: "
+                   << cache_key.status();
+    }
+  }
+  if (cache_key.ok()) {
+    absl::StatusOr<std::optional<std::string>> serialized =
+        compile_cache_->Get(*cache_key);
+    if (!serialized.ok()) {
+      LOG(WARNING) << "Failed to look up " << *cache_key
+                   << " in the compile cache: " << serialized.status();
+    } else if (serialized->has_value()) {
+      absl::StatusOr<std::unique_ptr<PjRtExecutable>> executable =
+          DeserializeExecutable(**serialized, input_options);
+      if (executable.ok()) {
+        VLOG(1) << "Loaded " << *cache_key << " from the compile cache";
+        return executable;
+      }
+      LOG(WARNING) << "Failed to deserialize " << *cache_key
+                   << " from the compile cache: " << executable.status();
+    }
+  }
+
   TF_ASSIGN_OR_RETURN(
       std::vector<std::unique_ptr<LocalExecutable>> local_executables,
       client()->Compile(computation, argument_layout_pointers,
                         options.executable_build_options));
 
-  return BuildPjRtExecutable(std::move(local_executables), input_options);
+  TF_ASSIGN_OR_RETURN(
+      std::unique_ptr<PjRtExecutable> executable,
+      BuildPjRtExecutable(std::move(local_executables), input_options));
+  if (cache_key.ok()) {
+    absl::Status status = [&]() -> absl::Status {
+      TF_ASSIGN_OR_RETURN(std::string serialized,
+                          executable->SerializeExecutable());
+      return compile_cache_->Put(*cache_key, serialized);
+    }();
+    if (!status.ok()) {
+      LOG(WARNING) << "Failed to store " << *cache_key
+                   << " in the compile cache: " << status;
+    }
+  }
+  return executable;
 }
 
 absl::StatusOr<std::unique_ptr<PjRtExecutable>>
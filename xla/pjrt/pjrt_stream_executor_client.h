@@ -17,6 +17,7 @@ limitations under the License.
 #define XLA_PJRT_PJRT_STREAM_EXECUTOR_CLIENT_H_
 
 #include <array>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
@@ -39,6 +40,7 @@ limitations under the License.
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
 #include "absl/types/span.h"
 #include "mlir/IR/BuiltinOps.h"
 #include "xla/client/executable_build_options.h"
@@ -49,6 +51,7 @@ limitations under the License.
 #include "xla/layout.h"
 #include "xla/literal.h"
 #include "xla/pjrt/abstract_tracked_device_buffer.h"
+#include "xla/pjrt/compile_cache.h"
 #include "xla/pjrt/local_device_state.h"
 #include "xla/pjrt/pjrt_client.h"
 #include "xla/pjrt/pjrt_common.h"
@@ -70,6 +73,7 @@ limitations under the License.
 #include "xla/shape_tree.h"
 #include "xla/stream_executor/stream.h"
 #include "xla/tsl/framework/allocator.h"
+#include "xla/tsl/lib/histogram/histogram.h"
 #include "xla/tsl/platform/threadpool.h"
 #include "xla/util.h"
 #include "xla/xla.pb.h"
@@ -308,6 +312,19 @@ class PjRtStreamExecutorClient : public PjRtClient {
   absl::StatusOr<std::unique_ptr<HloCostAnalysis>> GetHloCostAnalysis()
       const override;
 
+  // Sets the cache of serialized executables that compilation looks up first
+  // and stores newly compiled executables in. Null disables caching.
+  void set_compile_cache(std::shared_ptr<PjRtCompileCache> compile_cache) {
+    compile_cache_ = std::move(compile_cache);
+  }
+
+  // Returns the estimated run time of the optimized `module` on this client's
+  // devices, or std::nullopt if the platform has no performance model.
+  virtual std::optional<absl::Duration> EstimateRunTime(
+      const HloModule& module) const {
+    return std::nullopt;
+  }
+
   // Creates a buffer on the device without initializing or copying any data.
   // An optional `definition_event` may be speficied that can be used to
   // ensure the buffer isn't referenced until some external mechanism has
@@ -454,6 +471,13 @@ class PjRtStreamExecutorClient : public PjRtClient {
       LayoutCanonicalizationCallback layout_canonicalization_callback,
       CompileOptions options, bool lookup_addressable_devices);
 
+  // Returns the key of `computation` in the compile cache. It covers
+  // everything the compilation depends on besides the XLA version.
+  absl::StatusOr<std::string> CompileCacheKey(
+      const XlaComputation& computation,
+      const std::vector<const Shape*>& argument_layout_pointers,
+      const CompileOptions& options, bool lookup_addressable_devices) const;
+
   absl::StatusOr<std::unique_ptr<PjRtExecutable>> BuildPjRtExecutable(
       std::vector<std::unique_ptr<LocalExecutable>> local_executables,
       CompileOptions compile_options);
@@ -509,6 +533,8 @@ class PjRtStreamExecutorClient : public PjRtClient {
 
   std::unique_ptr<gpu::GpuExecutableRunOptions> gpu_run_options_;
 
+  std::shared_ptr<PjRtCompileCache> compile_cache_;
+
   tsl::thread::ThreadPool thread_pool_;
 
   absl::Mutex transpose_mu_;
@@ -627,6 +653,17 @@ class PjRtStreamExecutorBuffer : public CommonPjRtBuffer {
   absl::StatusOr<std::unique_ptr<PjRtBuffer>> CopyToMemorySpace(
       PjRtMemorySpace* dst_memory_space) override;
 
+  // Copies a batch of buffers to `dst_memory_space`. If all buffers are on the
+  // same device of the destination client, copies of all buffers are enqueued
+  // on one device to device stream (peer-to-peer copies between local GPUs),
+  // and share a single definition event and a single host callback releasing
+  // the source buffers. This amortizes per-copy overheads when copying many
+  // small buffers. If a source buffer holds an error, all copies of the batch
+  // hold the error. Otherwise buffers are copied one by one.
+  static absl::StatusOr<std::vector<std::unique_ptr<PjRtBuffer>>>
+  CopyBatchToMemorySpace(absl::Span<PjRtStreamExecutorBuffer* const> buffers,
+                         PjRtMemorySpace* dst_memory_space);
+
   void CopyToRemoteDevice(PjRtFuture<std::string> serialized_descriptor,
                           RemoteSendCallback on_done) override;
 
@@ -760,6 +797,10 @@ class PjRtStreamExecutorLoadedExecutable : public PjRtLoadedExecutable {
     return memory_stats;
   }
 
+  // Adds the estimate of the client's performance model and the executions
+  // observed since the executable was loaded.
+  absl::StatusOr<ExecutableStats> GetExecutableStats() const override;
+
   const DeviceAssignment& device_assignment() const override {
     return *device_assignment_;
   }
@@ -890,6 +931,10 @@ class PjRtStreamExecutorLoadedExecutable : public PjRtLoadedExecutable {
   // Per-executable sorted vector of parameters that have any aliased buffers
   // and thus must be donated when executing the computation.
   std::vector<std::vector<int>> parameters_that_must_be_donated_;
+  // Per-executable set of the parameters above whose aliases are all
+  // may-alias. These are not donated when donating them is unsafe, e.g. if
+  // the buffer is passed more than once or has an external reference.
+  std::vector<absl::flat_hash_set<int>> parameters_that_may_be_donated_;
   std::shared_ptr<DeviceAssignment> device_assignment_;
   CompileOptions compile_options_;
 
@@ -910,6 +955,16 @@ class PjRtStreamExecutorLoadedExecutable : public PjRtLoadedExecutable {
   std::vector<PjRtDevice*> addressable_devices_;
   std::string fingerprint_;
 
+  // Latencies of the executions, from enqueueing until completion on the
+  // device. Shared with the completion callbacks, which may outlive the
+  // executable.
+  struct ExecutionLatencies {
+    std::atomic<int64_t> num_executions{0};
+    tsl::histogram::ThreadSafeHistogram latency_usecs;
+  };
+  std::shared_ptr<ExecutionLatencies> execution_latencies_ =
+      std::make_shared<ExecutionLatencies>();
+
   struct InputHloSnapshotBits {
     HloModuleProto hlo_module;
     DebugOptions debug_options;
@@ -29,6 +29,7 @@ limitations under the License.
 #include "xla/client/client_library.h"
 #include "xla/client/local_client.h"
 #include "xla/hlo/builder/xla_builder.h"
+#include "xla/hlo/ir/hlo_input_output_alias_config.h"
 #include "xla/hlo/testlib/test.h"
 #include "xla/literal.h"
 #include "xla/literal_comparison.h"
@@ -95,7 +96,8 @@ absl::StatusOr<std::unique_ptr<PjRtLoadedExecutable>> ToyExecutable(
 }
 
 absl::Status ExecuteWithSameInputBuffer(
-    absl::AnyInvocable<void(XlaBuilder&)> set_up_aliases) {
+    absl::AnyInvocable<void(XlaBuilder&)> set_up_aliases,
+    bool infer_non_donatable_inputs = false) {
   auto shape = xla::ShapeUtil::MakeScalarShape(xla::F32);
   TF_ASSIGN_OR_RETURN(auto client, GetClient());
   TF_RET_CHECK(!client->addressable_devices().empty());
@@ -107,6 +109,7 @@ absl::Status ExecuteWithSameInputBuffer(
                       ToyExecutable(*client, shape, std::move(set_up_aliases)));
   xla::ExecuteOptions options;
   options.untuple_result = true;
+  options.infer_non_donatable_inputs = infer_non_donatable_inputs;
   return executable->Execute({{buffer.get(), buffer.get()}}, options).status();
 }
 
@@ -137,6 +140,29 @@ TEST(PjRtStreamExecutorClientTest, DonateSameBufferTwice) {
               ::testing::HasSubstr("f(donate(a), donate(a))"));
 }
 
+TEST(PjRtStreamExecutorClientTest, InferNonDonatableInputs) {
+  // f(donate(a), a) runs without donating `a` for a may-alias parameter.
+  TF_EXPECT_OK(ExecuteWithSameInputBuffer(
+      [](XlaBuilder& builder) { builder.SetUpAlias({0}, 0, {}); },
+      /*infer_non_donatable_inputs=*/true));
+
+  // f(donate(a), donate(a))
+  TF_EXPECT_OK(ExecuteWithSameInputBuffer(
+      [](XlaBuilder& builder) {
+        builder.SetUpAlias({0}, 0, {});
+        builder.SetUpAlias({1}, 1, {});
+      },
+      /*infer_non_donatable_inputs=*/true));
+
+  // Must-alias parameters are still donated.
+  absl::Status status = ExecuteWithSameInputBuffer(
+      [](XlaBuilder& builder) {
+        builder.SetUpAlias({0}, 0, {}, HloInputOutputAliasConfig::kMustAlias);
+      },
+      /*infer_non_donatable_inputs=*/true);
+  EXPECT_FALSE(status.ok());
+}
+
 TEST(PjRtStreamExecutorClientTest, DonateWithControlDependency) {
   TF_ASSERT_OK_AND_ASSIGN(auto client, GetClient());
   auto literal = LiteralUtil::CreateR2({{1, 2, 3}, {4, 5, 6}});
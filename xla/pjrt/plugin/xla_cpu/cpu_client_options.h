@@ -44,6 +44,12 @@ struct CpuClientOptions {
 
   int max_inflight_computations_per_device = 32;
 
+  // If true and the host has more than one NUMA node, CPU devices are assigned
+  // to NUMA nodes in a round-robin fashion. Each device runs computations on
+  // an intra-op thread pool pinned to its node and allocates device buffers
+  // from node-local memory.
+  bool numa_aware = false;
+
   // My process ID.
   int process_id = 0;
 
@@ -51,6 +51,15 @@ struct GpuAllocatorConfig {
   // allocator will allocate more memory as allocations are requested.
   bool preallocate = true;
 
+  // Only used if kind == kCudaAsync. The number of bytes of memory the CUDA
+  // memory pool keeps reserved at synchronization points, instead of releasing
+  // it back to the driver. A higher threshold avoids repeatedly returning and
+  // re-acquiring memory from the driver.
+  //
+  // If null, the pool keeps the preallocated memory if `preallocate` is true,
+  // and releases all free memory otherwise.
+  std::optional<int64_t> release_threshold = std::nullopt;
+
   // Amount of collective memory (ncclMemAlloc) to preallocate. If this value is
   // 0, collective memory space will be grown as needed to fit the application's
   // usage, with the drawback of potentially higher fragmentation. If set,
@@ -20,10 +20,13 @@ limitations under the License.
 #include <optional>
 #include <set>
 #include <string>
+#include <vector>
 
+#include "xla/pjrt/compile_cache.h"
 #include "xla/pjrt/distributed/client.h"
 #include "xla/pjrt/distributed/key_value_store_interface.h"
 #include "xla/pjrt/plugin/xla_gpu/xla_gpu_allocator_config.h"
+#include "xla/stream_executor/platform.h"
 
 namespace xla {
 
@@ -41,6 +44,28 @@ struct GpuClientOptions {
 
   bool should_stage_host_to_device_transfers = true;
 
+  // Priority of the compute and transfer streams of every device. A high
+  // priority lets latency-sensitive work of this client preempt the work of
+  // other processes sharing the GPUs. The priority of the streams used for
+  // asynchronous collectives is set by
+  // --xla_gpu_enable_highest_priority_async_stream.
+  std::optional<stream_executor::StreamPriority> stream_priority =
+      std::nullopt;
+
+  // If set, the execute and callback threads of the i-th local device are
+  // pinned to the CPU cores `execute_thread_cpu_cores[i]` and
+  // `callback_thread_cpu_cores[i]`, so that they do not compete with other
+  // threads. Only supported on Linux.
+  std::optional<std::vector<int>> execute_thread_cpu_cores = std::nullopt;
+  std::optional<std::vector<int>> callback_thread_cpu_cores = std::nullopt;
+
+  // If true, the execute and callback threads of each device spin when idle,
+  // and the completion of device work is detected by polling events instead of
+  // through host callbacks. This lowers the latency of small computations at
+  // the cost of two busy CPU cores per device, which should then be dedicated
+  // to these threads with the options above.
+  bool busy_poll_host_threads = false;
+
   // kv_store must be non-null if num_nodes > 1.
   std::shared_ptr<KeyValueStoreInterface> kv_store = nullptr;
 
@@ -49,6 +74,10 @@ struct GpuClientOptions {
 
   bool abort_collectives_on_failure = false;
 
+  // If set, compiled executables are stored in and loaded from this cache, so
+  // that other clients using the same cache do not compile them again.
+  std::shared_ptr<PjRtCompileCache> compile_cache = nullptr;
+
   bool enable_mock_nccl = false;
 
   std::optional<std::string> mock_gpu_topology;
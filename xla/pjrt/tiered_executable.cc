@@ -0,0 +1,160 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/pjrt/tiered_executable.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/log/log.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
+#include "xla/hlo/builder/xla_computation.h"
+#include "xla/pjrt/pjrt_client.h"
+#include "xla/pjrt/pjrt_executable.h"
+#include "xla/pjrt/pjrt_layout.h"
+#include "xla/shape.h"
+#include "xla/tsl/platform/env.h"
+#include "xla/tsl/platform/errors.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/xla.pb.h"
+
+namespace xla {
+namespace {
+
+bool SameLayouts(
+    const std::vector<std::shared_ptr<const PjRtLayout>>& lhs,
+    const std::vector<std::shared_ptr<const PjRtLayout>>& rhs) {
+  if (lhs.size() != rhs.size()) {
+    return false;
+  }
+  for (int i = 0; i < lhs.size(); ++i) {
+    if (!(*lhs[i] == *rhs[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns an error if `optimized` can not replace `baseline` transparently,
+// i.e. if it takes or returns buffers of different shapes or layouts.
+absl::Status CheckInterchangeable(const PjRtLoadedExecutable& baseline,
+                                  const PjRtLoadedExecutable& optimized) {
+  TF_ASSIGN_OR_RETURN(std::vector<Shape> baseline_shapes,
+                      baseline.GetOutputShapes());
+  TF_ASSIGN_OR_RETURN(std::vector<Shape> optimized_shapes,
+                      optimized.GetOutputShapes());
+  if (baseline_shapes != optimized_shapes) {
+    return absl::FailedPreconditionError(
+        "The optimized executable has different output shapes than the "
+        "baseline executable.");
+  }
+  TF_ASSIGN_OR_RETURN(auto baseline_parameter_layouts,
+                      baseline.GetParameterLayouts());
+  TF_ASSIGN_OR_RETURN(auto optimized_parameter_layouts,
+                      optimized.GetParameterLayouts());
+  TF_ASSIGN_OR_RETURN(auto baseline_output_layouts,
+                      baseline.GetOutputLayouts());
+  TF_ASSIGN_OR_RETURN(auto optimized_output_layouts,
+                      optimized.GetOutputLayouts());
+  if (!SameLayouts(baseline_parameter_layouts, optimized_parameter_layouts) ||
+      !SameLayouts(baseline_output_layouts, optimized_output_layouts)) {
+    return absl::FailedPreconditionError(
+        "The optimized executable has different parameter or output layouts "
+        "than the baseline executable.");
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace
+
+CompileOptions GetBaselineCompileOptions(CompileOptions options) {
+  ExecutableBuildOptions& build_options = options.executable_build_options;
+  build_options.set_optimization_level(ExecutionOptions::EFFORT_O0);
+  DebugOptions* debug_options = build_options.mutable_debug_options();
+  debug_options->set_xla_backend_optimization_level(1);
+  debug_options->set_xla_llvm_disable_expensive_passes(true);
+  debug_options->set_xla_gpu_autotune_level(0);
+  return options;
+}
+
+TieredPjRtLoadedExecutable::TieredPjRtLoadedExecutable(
+    std::unique_ptr<PjRtLoadedExecutable> baseline, CompileFn compile_optimized)
+    : baseline_(std::move(baseline)),
+      current_(baseline_.get()),
+      compile_optimized_(std::move(compile_optimized)) {
+  compile_thread_.reset(tsl::Env::Default()->StartThread(
+      tsl::ThreadOptions(), "xla_tiered_compile",
+      [this] { SetOptimized(std::move(compile_optimized_)()); }));
+}
+
+TieredPjRtLoadedExecutable::~TieredPjRtLoadedExecutable() {
+  // Joins the compilation thread.
+  compile_thread_.reset();
+}
+
+absl::Status TieredPjRtLoadedExecutable::AwaitOptimized() {
+  optimized_done_.WaitForNotification();
+  absl::MutexLock lock(&mu_);
+  return optimized_status_;
+}
+
+void TieredPjRtLoadedExecutable::SetOptimized(
+    absl::StatusOr<std::unique_ptr<PjRtLoadedExecutable>> optimized) {
+  absl::Status status = optimized.status();
+  if (status.ok()) {
+    status = CheckInterchangeable(*baseline_, **optimized);
+  }
+
+  absl::MutexLock lock(&mu_);
+  if (!status.ok()) {
+    LOG(WARNING) << "Keeping the baseline executable of " << baseline_->name()
+                 << ": " << status;
+  } else if (deleted_) {
+    (*optimized)->Delete();
+  } else {
+    optimized_ = *std::move(optimized);
+    current_.store(optimized_.get(), std::memory_order_release);
+    VLOG(1) << "Swapped in the optimized executable of " << baseline_->name();
+  }
+  optimized_status_ = std::move(status);
+  optimized_done_.Notify();
+}
+
+void TieredPjRtLoadedExecutable::Delete() {
+  absl::MutexLock lock(&mu_);
+  deleted_ = true;
+  baseline_->Delete();
+  if (optimized_ != nullptr) {
+    optimized_->Delete();
+  }
+}
+
+absl::StatusOr<std::unique_ptr<TieredPjRtLoadedExecutable>>
+CompileAndLoadTiered(PjRtClient* client, const XlaComputation& computation,
+                     CompileOptions options) {
+  TF_ASSIGN_OR_RETURN(
+      std::unique_ptr<PjRtLoadedExecutable> baseline,
+      client->CompileAndLoad(computation, GetBaselineCompileOptions(options)));
+  return std::make_unique<TieredPjRtLoadedExecutable>(
+      std::move(baseline),
+      [client, computation, options = std::move(options)]() {
+        return client->CompileAndLoad(computation, options);
+      });
+}
+
+}  // namespace xla
@@ -0,0 +1,152 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_PJRT_TIERED_EXECUTABLE_H_
+#define XLA_PJRT_TIERED_EXECUTABLE_H_
+
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/functional/any_invocable.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/synchronization/notification.h"
+#include "absl/types/span.h"
+#include "xla/hlo/builder/xla_computation.h"
+#include "xla/pjrt/pjrt_client.h"
+#include "xla/pjrt/pjrt_executable.h"
+#include "xla/pjrt/pjrt_future.h"
+#include "xla/service/computation_placer.h"
+#include "xla/tsl/platform/env.h"
+
+namespace xla {
+
+// Returns `options` changed to compile a baseline executable as fast as
+// possible: minimal optimization effort, no autotuning and no expensive LLVM
+// passes.
+CompileOptions GetBaselineCompileOptions(CompileOptions options);
+
+// PjRtLoadedExecutable that runs a quickly compiled baseline executable until
+// the fully optimized executable, compiled on a background thread, is ready
+// and atomically replaces it. Executions that already started on the baseline
+// executable run to completion on it.
+//
+// If the optimized compilation fails, or produces an executable with different
+// parameter or output layouts, the baseline executable keeps being used.
+class TieredPjRtLoadedExecutable : public PjRtLoadedExecutable {
+ public:
+  using CompileFn = absl::AnyInvocable<
+      absl::StatusOr<std::unique_ptr<PjRtLoadedExecutable>>() &&>;
+
+  // Starts `compile_optimized` on a background thread. The destructor waits for
+  // it to finish, so everything it uses must outlive this executable.
+  TieredPjRtLoadedExecutable(std::unique_ptr<PjRtLoadedExecutable> baseline,
+                             CompileFn compile_optimized);
+  ~TieredPjRtLoadedExecutable() override;
+
+  // Blocks until the optimized compilation finished and returns an error if
+  // the optimized executable could not replace the baseline one.
+  absl::Status AwaitOptimized();
+
+  // Returns true if executions run on the optimized executable.
+  bool is_optimized() const {
+    return current_.load(std::memory_order_acquire) != baseline_.get();
+  }
+
+  PjRtClient* client() const override { return baseline_->client(); }
+  const DeviceAssignment& device_assignment() const override {
+    return baseline_->device_assignment();
+  }
+  absl::Span<const LogicalDeviceIds> addressable_device_logical_ids()
+      const override {
+    return baseline_->addressable_device_logical_ids();
+  }
+  absl::Span<PjRtDevice* const> addressable_devices() const override {
+    return baseline_->addressable_devices();
+  }
+
+  // Everything else about the executable, e.g. its HLO modules, cost analysis
+  // or serialization, is the one of the executable currently in use.
+  PjRtExecutable* GetExecutable() const override {
+    return current()->GetExecutable();
+  }
+
+  using PjRtLoadedExecutable::Execute;
+  absl::StatusOr<std::vector<std::vector<std::unique_ptr<PjRtBuffer>>>> Execute(
+      absl::Span<const std::vector<PjRtBuffer*>> argument_handles,
+      const ExecuteOptions& options,
+      std::optional<std::vector<PjRtFuture<>>>& returned_futures) override {
+    return current()->Execute(argument_handles, options, returned_futures);
+  }
+  using PjRtLoadedExecutable::ExecuteSharded;
+  absl::StatusOr<std::vector<std::unique_ptr<PjRtBuffer>>> ExecuteSharded(
+      absl::Span<PjRtBuffer* const> argument_handles, PjRtDevice* device,
+      const ExecuteOptions& options,
+      std::optional<PjRtFuture<>>& returned_future, bool fill_future) override {
+    return current()->ExecuteSharded(argument_handles, device, options,
+                                     returned_future, fill_future);
+  }
+  using PjRtLoadedExecutable::ExecutePortable;
+  absl::StatusOr<std::vector<std::unique_ptr<PjRtBuffer>>> ExecutePortable(
+      absl::Span<PjRtBuffer* const> argument_handles, PjRtDevice* device,
+      const ExecuteOptions& options,
+      std::optional<PjRtFuture<>>& returned_future, bool fill_future) override {
+    return current()->ExecutePortable(argument_handles, device, options,
+                                      returned_future, fill_future);
+  }
+
+  void Delete() override;
+  bool IsDeleted() override { return baseline_->IsDeleted(); }
+
+ private:
+  PjRtLoadedExecutable* current() const {
+    return current_.load(std::memory_order_acquire);
+  }
+
+  // Installs the result of the optimized compilation.
+  void SetOptimized(
+      absl::StatusOr<std::unique_ptr<PjRtLoadedExecutable>> optimized);
+
+  const std::unique_ptr<PjRtLoadedExecutable> baseline_;
+
+  absl::Mutex mu_;
+  // Never reset once set, so that `current_` stays valid.
+  std::unique_ptr<PjRtLoadedExecutable> optimized_ ABSL_GUARDED_BY(mu_);
+  absl::Status optimized_status_ ABSL_GUARDED_BY(mu_);
+  bool deleted_ ABSL_GUARDED_BY(mu_) = false;
+  absl::Notification optimized_done_;
+
+  // The executable new executions run on.
+  std::atomic<PjRtLoadedExecutable*> current_;
+
+  CompileFn compile_optimized_;
+  std::unique_ptr<tsl::Thread> compile_thread_;
+};
+
+// Compiles and loads `computation` in tiers: returns an executable compiled
+// with GetBaselineCompileOptions(options) as soon as it is ready, and swaps in
+// the executable compiled with `options` once its compilation, started in the
+// background, finishes. `client` must outlive the returned executable.
+absl::StatusOr<std::unique_ptr<TieredPjRtLoadedExecutable>>
+CompileAndLoadTiered(PjRtClient* client, const XlaComputation& computation,
+                     CompileOptions options);
+
+}  // namespace xla
+
+#endif  // XLA_PJRT_TIERED_EXECUTABLE_H_
@@ -0,0 +1,115 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/pjrt/tiered_executable.h"
+
+#include <memory>
+#include <utility>
+
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "xla/hlo/builder/xla_computation.h"
+#include "xla/hlo/parser/hlo_parser.h"
+#include "xla/literal.h"
+#include "xla/literal_util.h"
+#include "xla/pjrt/pjrt_client.h"
+#include "xla/pjrt/pjrt_executable.h"
+#include "xla/pjrt/plugin/xla_cpu/cpu_client_options.h"
+#include "xla/pjrt/plugin/xla_cpu/xla_cpu_pjrt_client.h"
+#include "xla/tests/literal_test_util.h"
+#include "xla/tsl/lib/core/status_test_util.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/xla.pb.h"
+
+namespace xla {
+namespace {
+
+constexpr char kProgram[] = R"(
+  HloModule add
+  ENTRY add {
+    x = f32[3,2] parameter(0)
+    y = f32[3,2] parameter(1)
+    ROOT add = f32[3,2] add(x, y)
+  })";
+
+TEST(TieredExecutableTest, BaselineCompileOptions) {
+  CompileOptions options = GetBaselineCompileOptions(CompileOptions());
+  EXPECT_EQ(options.executable_build_options.optimization_level(),
+            ExecutionOptions::EFFORT_O0);
+  const DebugOptions& debug_options =
+      options.executable_build_options.debug_options();
+  EXPECT_TRUE(debug_options.xla_llvm_disable_expensive_passes());
+  EXPECT_EQ(debug_options.xla_gpu_autotune_level(), 0);
+}
+
+TEST(TieredExecutableTest, ExecutesBeforeAndAfterSwap) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<PjRtClient> client,
+                          GetXlaPjrtCpuClient(CpuClientOptions()));
+  TF_ASSERT_OK_AND_ASSIGN(auto hlo_module,
+                          ParseAndReturnUnverifiedModule(kProgram, {}));
+  XlaComputation computation(hlo_module->ToProto());
+  TF_ASSERT_OK_AND_ASSIGN(
+      std::unique_ptr<TieredPjRtLoadedExecutable> executable,
+      CompileAndLoadTiered(client.get(), computation, CompileOptions()));
+
+  Literal x =
+      LiteralUtil::CreateR2<float>({{1.0, 2.0}, {3.0, 4.0}, {5.0, 6.0}});
+  Literal y = LiteralUtil::CreateR2<float>(
+      {{10.0, 20.0}, {30.0, 40.0}, {50.0, 60.0}});
+  Literal expected = LiteralUtil::CreateR2<float>(
+      {{11.0, 22.0}, {33.0, 44.0}, {55.0, 66.0}});
+  PjRtMemorySpace* memory_space =
+      *client->addressable_devices()[0]->default_memory_space();
+  TF_ASSERT_OK_AND_ASSIGN(auto x_buffer,
+                          client->BufferFromHostLiteral(x, memory_space));
+  TF_ASSERT_OK_AND_ASSIGN(auto y_buffer,
+                          client->BufferFromHostLiteral(y, memory_space));
+
+  auto execute_and_check = [&] {
+    TF_ASSERT_OK_AND_ASSIGN(
+        auto result,
+        executable->Execute({{x_buffer.get(), y_buffer.get()}}, {}));
+    TF_ASSERT_OK_AND_ASSIGN(auto literal, result[0][0]->ToLiteralSync());
+    EXPECT_TRUE(LiteralTestUtil::Equal(expected, *literal));
+  };
+
+  // Runs on whichever executable is in use while the optimized one compiles.
+  execute_and_check();
+
+  TF_ASSERT_OK(executable->AwaitOptimized());
+  EXPECT_TRUE(executable->is_optimized());
+  execute_and_check();
+}
+
+TEST(TieredExecutableTest, KeepsBaselineIfOptimizedCompilationFails) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<PjRtClient> client,
+                          GetXlaPjrtCpuClient(CpuClientOptions()));
+  TF_ASSERT_OK_AND_ASSIGN(auto hlo_module,
+                          ParseAndReturnUnverifiedModule(kProgram, {}));
+  XlaComputation computation(hlo_module->ToProto());
+  TF_ASSERT_OK_AND_ASSIGN(
+      std::unique_ptr<PjRtLoadedExecutable> baseline,
+      client->CompileAndLoad(computation,
+                             GetBaselineCompileOptions(CompileOptions())));
+
+  TieredPjRtLoadedExecutable executable(
+      std::move(baseline),
+      [] { return absl::InternalError("optimized compilation failed"); });
+  EXPECT_FALSE(executable.AwaitOptimized().ok());
+  EXPECT_FALSE(executable.is_optimized());
+}
+
+}  // namespace
+}  // namespace xla
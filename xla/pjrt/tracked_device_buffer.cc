@@ -265,6 +265,14 @@ void TrackedDeviceBuffer::AddUsageEvent(
     bool reference_held) {
   CHECK(in_use_);
 
+  // A buffer passed several times to the same execution is used with the same
+  // event each time, which only has to be recorded once.
+  for (const auto& existing : usage_events_) {
+    if (existing.event == event && existing.stream == usage_stream) {
+      return;
+    }
+  }
+
   // If the event is 0, it means that the event is not recorded yet and the task
   // related to this event is deferred, so just add it.
   if (*event == 0) {
@@ -145,5 +145,26 @@ TEST(TrackedDeviceBufferTest, AsShapedBuffer) {
   EXPECT_TRUE(expected_it == expected_buffer_sequence.end());
 }
 
+TEST(TrackedDeviceBufferTest, AddUsageEventCoalescesSameEvent) {
+  LocalClient* client = ClientLibrary::LocalClientOrDie();
+  TestDevice device;
+
+  Shape shape = ShapeUtil::MakeShape(F32, {8});
+  TF_ASSERT_OK_AND_ASSIGN(auto buffer, MakeArray(shape, client, &device));
+  auto event = std::make_shared<BufferSequencingEvent>(nullptr);
+  auto other_event = std::make_shared<BufferSequencingEvent>(nullptr);
+
+  // The events are not recorded yet, so neither replaces the other.
+  buffer->AddUsageEvent(/*usage_stream=*/nullptr, event,
+                        /*reference_held=*/false);
+  buffer->AddUsageEvent(/*usage_stream=*/nullptr, event,
+                        /*reference_held=*/false);
+  buffer->AddUsageEvent(/*usage_stream=*/nullptr, other_event,
+                        /*reference_held=*/false);
+  ASSERT_EQ(buffer->usage_events().size(), 2);
+  EXPECT_EQ(buffer->usage_events()[0].event, event);
+  EXPECT_EQ(buffer->usage_events()[1].event, other_event);
+}
+
 }  // namespace
 }  // namespace xla
@@ -106,7 +106,9 @@ limitations under the License.
 namespace xla {
 
 namespace {
-#ifdef __AVX__
+#ifdef __AVX512F__
+static constexpr int kMaxInnerBlockSizeBytes = sizeof(__m512i);
+#elif defined(__AVX__)
 static constexpr int kMaxInnerBlockSizeBytes = sizeof(__m256i);
 #elif defined(XLA_HAS_VEC128)
 static constexpr int kMaxInnerBlockSizeBytes = sizeof(Vec128);
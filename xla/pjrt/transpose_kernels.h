@@ -203,6 +203,31 @@ inline __m256i Unpack<8, Extract::kHi>(__m256i a, __m256i b) {
 #endif
 #endif
 
+#ifdef __AVX512F__
+// Like the AVX unpacks above, AVX-512 unpacks operate independently on each of
+// the four 128-bit lanes of the vector.
+template <size_t element_size, Extract>
+inline __m512i Unpack(__m512i a, __m512i b);
+
+template <>
+inline __m512i Unpack<4, Extract::kLo>(__m512i a, __m512i b) {
+  return _mm512_unpacklo_epi32(a, b);
+}
+template <>
+inline __m512i Unpack<4, Extract::kHi>(__m512i a, __m512i b) {
+  return _mm512_unpackhi_epi32(a, b);
+}
+
+template <>
+inline __m512i Unpack<8, Extract::kLo>(__m512i a, __m512i b) {
+  return _mm512_unpacklo_epi64(a, b);
+}
+template <>
+inline __m512i Unpack<8, Extract::kHi>(__m512i a, __m512i b) {
+  return _mm512_unpackhi_epi64(a, b);
+}
+#endif
+
 #ifdef XLA_HAS_SSE2
 template <size_t element_size, Extract>
 __m128i Unpack(__m128i a, __m128i b);
@@ -606,6 +631,52 @@ struct AvxSquareTransposeMicroKernelImpl {
 };
 #endif
 
+#ifdef __AVX512F__
+// Transposes a `bs x bs` matrix with 64-byte rows. We view the matrix as a 4x4
+// grid of blocks with `bs / 4` rows and 16 bytes per row, and load the blocks
+// of one column of the grid into the four 128-bit lanes of `bs / 4` vectors.
+// In-lane unpacks then transpose every block in place, and each resulting
+// vector is exactly one row of the transposed matrix.
+template <typename T, int bs>
+struct Avx512SquareTransposeMicroKernelImpl {
+  XLA_FLATTEN static void Apply(const char* __restrict a, int64_t lda,
+                                char* __restrict b, int64_t ldb) {
+    constexpr size_t element_size = sizeof(T);
+    static_assert(element_size <= sizeof(__m128i));
+    static_assert(sizeof(__m128i) % element_size == 0);
+    static_assert(bs % 4 == 0);
+    static_assert(element_size * bs == sizeof(__m512i));
+    constexpr int kBlockRows = bs / 4;
+    std::array<__m512i, bs> last_transpose;
+    XLA_UNROLL
+    for (int col = 0; col < 4; ++col) {
+      XLA_UNROLL
+      for (int i = 0; i < kBlockRows; ++i) {
+        auto load = [&](int row_block) {
+          return _mm_loadu_si128(reinterpret_cast<const __m128i*>(
+              a + lda * (i + row_block * kBlockRows)) + col);
+        };
+        __m512i v = _mm512_castsi128_si512(load(0));
+        v = _mm512_inserti32x4(v, load(1), 1);
+        v = _mm512_inserti32x4(v, load(2), 2);
+        v = _mm512_inserti32x4(v, load(3), 3);
+        last_transpose[col * kBlockRows + i] = v;
+      }
+    }
+
+    last_transpose =
+        UnpackSequence<element_size, /*step_size=*/1,
+                       /*unpack_limit=*/sizeof(__m128i)>(last_transpose);
+
+    XLA_UNROLL
+    for (int i = 0; i < bs; ++i) {
+      _mm512_storeu_si512(reinterpret_cast<void*>(b + ldb * i),
+                          last_transpose[i]);
+    }
+  }
+};
+#endif
+
 #ifdef __AVX__
 template <typename T, int bs>
 struct AvxRectangularTransposeMicroKernelImpl {
@@ -667,6 +738,12 @@ struct TransposeMicroKernel {
   static void Apply(const char* __restrict a, int64_t lda, char* __restrict b,
                     int64_t ldb) {
     if constexpr (bs % 2 == 0) {
+#ifdef __AVX512F__
+      if constexpr (sizeof(T) * bs == sizeof(__m512i)) {
+        return Avx512SquareTransposeMicroKernelImpl<T, bs>::Apply(a, lda, b,
+                                                                  ldb);
+      }
+#endif
 #ifdef __AVX__
       if constexpr (sizeof(T) * bs == sizeof(__m256i)) {
         return AvxSquareTransposeMicroKernelImpl<T, bs>::Apply(a, lda, b, ldb);
@@ -430,6 +430,7 @@ TEST_P(TransposeTest, TransposeInt128) { TestTranspose<absl::int128>(1); }
 
 TEST_P(TransposeTest, ParallelTransposeInt8) { TestTranspose<int8_t>(16); }
 TEST_P(TransposeTest, ParallelTransposeInt32) { TestTranspose<int32_t>(16); }
+TEST_P(TransposeTest, ParallelTransposeInt64) { TestTranspose<int64_t>(16); }
 
 INSTANTIATE_TEST_SUITE_P(TransposeTestInstance, TransposeTest,
                          ::testing::ValuesIn(GetTransposeTestCases()));
@@ -538,6 +539,10 @@ static void BM_Eigen_float(const TransposeTestCase& bm, int parallelism,
                            ::testing::benchmark::State& state) {
   BM_Eigen<float>(bm, parallelism, state);
 }
+static void BM_Eigen_double(const TransposeTestCase& bm, int parallelism,
+                            ::testing::benchmark::State& state) {
+  BM_Eigen<double>(bm, parallelism, state);
+}
 
 template <typename T>
 void BM_Transpose(const TransposeTestCase& bm, int parallelism,
@@ -572,6 +577,10 @@ static void BM_Transpose_float(const TransposeTestCase& bm, int parallelism,
                                ::testing::benchmark::State& state) {
   BM_Transpose<float>(bm, parallelism, state);
 }
+static void BM_Transpose_double(const TransposeTestCase& bm, int parallelism,
+                                ::testing::benchmark::State& state) {
+  BM_Transpose<double>(bm, parallelism, state);
+}
 
 static void* benchmarks = []() {
   using BenchmarkFn =
@@ -582,6 +591,8 @@ static void* benchmarks = []() {
           {"BM_Transpose_uint8", BM_Transpose_uint8, {1, 4, 8}},  //
           {"BM_Eigen_float", BM_Eigen_float, {1}},
           {"BM_Transpose_float", BM_Transpose_float, {1, 4, 8}},  //
+          {"BM_Eigen_double", BM_Eigen_double, {1}},
+          {"BM_Transpose_double", BM_Transpose_double, {1, 4, 8}},  //
   };
   auto benchmark_cases = BenchmarkCases();
   for (const auto& benchmark_case : benchmark_cases) {
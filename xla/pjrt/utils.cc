@@ -28,6 +28,7 @@ limitations under the License.
 
 #include "absl/algorithm/container.h"
 #include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
 #include "absl/log/check.h"
 #include "absl/log/log.h"
 #include "absl/status/status.h"
@@ -812,6 +813,33 @@ absl::StatusOr<std::vector<int>> ComputeParametersThatMustBeDonated(
   return parameters_to_donate;
 }
 
+absl::StatusOr<std::vector<int>> ComputeParametersThatMayBeDonated(
+    const HloModule& module, bool tuple_inputs) {
+  TF_ASSIGN_OR_RETURN(std::vector<int> parameters_to_donate,
+                      ComputeParametersThatMustBeDonated(module, tuple_inputs));
+  absl::flat_hash_set<int> must_alias_parameters;
+  module.input_output_alias_config().ForEachAlias(
+      [&](const ShapeIndex& output_index,
+          const HloInputOutputAliasConfig::Alias& alias) {
+        if (!alias.must_alias()) {
+          return;
+        }
+        if (!tuple_inputs) {
+          must_alias_parameters.insert(alias.parameter_number);
+        } else if (!alias.parameter_index.empty()) {
+          must_alias_parameters.insert(alias.parameter_index.data()[0]);
+        }
+      });
+  std::vector<int> parameters;
+  for (int parameter : parameters_to_donate) {
+    if (!must_alias_parameters.contains(parameter) &&
+        (parameters.empty() || parameters.back() != parameter)) {
+      parameters.push_back(parameter);
+    }
+  }
+  return parameters;
+}
+
 int DefaultThreadPoolSize() {
   // Google's CI system exposes an environment variable NPROC that describes
   // a CPU reservation for tests.
@@ -138,6 +138,12 @@ absl::Status DetermineArgumentLayoutsFromCompileOptions(
 absl::StatusOr<std::vector<int>> ComputeParametersThatMustBeDonated(
     const HloModule& hlo_module, bool tuple_inputs);
 
+// Returns the sorted subset of ComputeParametersThatMustBeDonated whose
+// aliases are all may-alias. The executable can also run without donating
+// these parameters, at the cost of copying them to the aliased outputs.
+absl::StatusOr<std::vector<int>> ComputeParametersThatMayBeDonated(
+    const HloModule& hlo_module, bool tuple_inputs);
+
 // Return max parallelism level.
 int DefaultThreadPoolSize();
 
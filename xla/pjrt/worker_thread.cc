@@ -16,15 +16,46 @@ limitations under the License.
 #include "xla/pjrt/worker_thread.h"
 
 #include <string>
+#include <thread>  // NOLINT
 #include <utility>
 
 #include "absl/functional/any_invocable.h"
 #include "absl/log/check.h"
+#include "absl/log/log.h"
 #include "absl/synchronization/mutex.h"
 
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
 namespace xla {
+namespace {
+
+void PinCurrentThreadToCore(int cpu_core) {
+#if defined(__linux__)
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  CPU_SET(cpu_core, &cpus);
+  int error = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+  if (error != 0) {
+    LOG(WARNING) << "Failed to pin worker thread to CPU core " << cpu_core
+                 << ": error " << error;
+  }
+#else
+  LOG(WARNING) << "Pinning worker threads to CPU cores is not supported on "
+                  "this platform";
+#endif
+}
 
-WorkerThread::WorkerThread(tsl::Env* env, const std::string& name) {
+}  // namespace
+
+WorkerThread::WorkerThread(tsl::Env* env, const std::string& name)
+    : WorkerThread(env, name, Options()) {}
+
+WorkerThread::WorkerThread(tsl::Env* env, const std::string& name,
+                           Options options)
+    : options_(std::move(options)) {
   thread_.reset(
       env->StartThread(tsl::ThreadOptions(), name, [this]() { WorkLoop(); }));
 }
@@ -32,24 +63,35 @@ WorkerThread::WorkerThread(tsl::Env* env, const std::string& name) {
 WorkerThread::~WorkerThread() {
   absl::MutexLock lock(&mu_);
   work_queue_.push(nullptr);
+  work_queue_size_.fetch_add(1, std::memory_order_release);
 }
 
 void WorkerThread::Schedule(absl::AnyInvocable<void() &&> fn) {
   CHECK(fn != nullptr);
   absl::MutexLock lock(&mu_);
   work_queue_.push(std::move(fn));
+  work_queue_size_.fetch_add(1, std::memory_order_release);
 }
 
 bool WorkerThread::WorkAvailable() { return !work_queue_.empty(); }
 
 void WorkerThread::WorkLoop() {
+  if (options_.cpu_core.has_value()) {
+    PinCurrentThreadToCore(*options_.cpu_core);
+  }
   while (true) {
     absl::AnyInvocable<void() &&> fn;
     {
+      if (options_.busy_poll) {
+        while (work_queue_size_.load(std::memory_order_acquire) == 0) {
+          std::this_thread::yield();
+        }
+      }
       absl::MutexLock lock(&mu_);
       mu_.Await(absl::Condition(this, &WorkerThread::WorkAvailable));
       fn = std::move(work_queue_.front());
       work_queue_.pop();
+      work_queue_size_.fetch_sub(1, std::memory_order_relaxed);
     }
     if (!fn) {
       return;
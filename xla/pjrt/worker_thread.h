@@ -16,7 +16,10 @@ limitations under the License.
 #ifndef XLA_PJRT_WORKER_THREAD_H_
 #define XLA_PJRT_WORKER_THREAD_H_
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <queue>
 #include <string>
 
@@ -31,8 +34,19 @@ namespace xla {
 // pool of size 1.
 class WorkerThread {
  public:
+  struct Options {
+    // If set, the thread is pinned to this CPU core. Only supported on Linux.
+    std::optional<int> cpu_core;
+
+    // If true, the thread spins while its queue is empty instead of sleeping
+    // until a closure is scheduled. This saves the wake-up latency at the cost
+    // of keeping a CPU core busy, so it is best combined with `cpu_core`.
+    bool busy_poll = false;
+  };
+
   // 'name' is a name for the thread for debugging purposes.
   WorkerThread(tsl::Env* env, const std::string& name);
+  WorkerThread(tsl::Env* env, const std::string& name, Options options);
 
   // Blocks until all enqueued closures have completed.
   ~WorkerThread();
@@ -44,8 +58,13 @@ class WorkerThread {
   bool WorkAvailable() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
   void WorkLoop();
 
+  const Options options_;
+
   absl::Mutex mu_;
   std::queue<absl::AnyInvocable<void() &&>> work_queue_ ABSL_GUARDED_BY(mu_);
+  // Size of `work_queue_`, which is polled without holding `mu_` in the
+  // busy-poll mode.
+  std::atomic<int64_t> work_queue_size_{0};
 
   std::unique_ptr<tsl::Thread> thread_;
 };
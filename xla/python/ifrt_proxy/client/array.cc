@@ -459,6 +459,12 @@ Future<> Array::GetReadyFuture() const {
   return ready_future_;
 }
 
+bool Array::IsKnownReady() const {
+  absl::MutexLock lock(&mu_);
+  return ready_future_.IsValid() && ready_future_.IsKnownReady() &&
+         ready_future_.Await().ok();
+}
+
 Future<> Array::Delete() {
   {
     absl::MutexLock lock(&mu_);
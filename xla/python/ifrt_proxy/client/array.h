@@ -145,6 +145,11 @@ class Array final : public llvm::RTTIExtends<Array, xla::ifrt::Array> {
     return custom_layout_;
   }
 
+  // Returns true if a previous `GetReadyFuture()` call already observed the
+  // array becoming ready on the server, so readiness can be reported without
+  // another round trip.
+  bool IsKnownReady() const;
+
   xla::ifrt::Client* client() const override;
   Future<> GetReadyFuture() const override;
   Future<> Delete() override;
@@ -156,6 +156,32 @@ TEST_F(ArrayTest, FullyReplicatedShard) {
   EXPECT_EQ(req.result_handle(), 1);
 }
 
+TEST_F(ArrayTest, GetReadyFutureIsKnownReadyAfterFirstCheck) {
+  IfrtResponse response;
+  TestQueue<IfrtRequest> requests_queue(/*pop_timeout=*/absl::Minutes(1));
+  ASSERT_TRUE(TextFormat::ParseFromString(
+      R"pb(response_metadata {}
+           check_value_ready_response {})pb",
+      &response));
+  EXPECT_CALL(*session_,
+              Enqueue(IfrtRequestOfType(IfrtRequest::kCheckValueReadyRequest)))
+      .WillOnce(MockClientCaptureAndReturn(&requests_queue, response));
+  ON_CALL(*mock_client_, GetDefaultLayout).WillByDefault(Return(kLayout1));
+
+  auto array = tsl::MakeRef<Array>(
+      mock_client_.get(), rpc_helper_, DType(DType::Kind::kBF16), Shape({}),
+      sharding_, ArrayHandle{1234}, /*layout=*/nullptr);
+
+  EXPECT_FALSE(array->IsKnownReady());
+  TF_EXPECT_OK(array->GetReadyFuture().Await());
+  EXPECT_THAT(requests_queue.Pop().check_value_ready_request().value_handles(),
+              ElementsAre(1234));
+  EXPECT_TRUE(array->IsKnownReady());
+
+  // The second call must not send another request.
+  TF_EXPECT_OK(array->GetReadyFuture().Await());
+}
+
 TEST_F(ArrayTest, GetDefaultLayoutSuccess) {
   ON_CALL(*mock_client_, GetDefaultLayout).WillByDefault(Return(kLayout1));
 
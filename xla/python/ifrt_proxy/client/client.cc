@@ -397,7 +397,8 @@ xla::ifrt::Future<> Client::GetReadyFuture(
           proxy_array->GetHandle(ArrayCopySemantics::kAlwaysCopy);
       if (!handle.ok()) {
         futures.push_back(Future<>(handle.status()));
-      } else {
+      } else if (!proxy_array->IsKnownReady()) {
+        // Arrays already known to be ready don't need to be checked again.
         req->add_value_handles(handle->handle);
       }
     } else {
@@ -405,12 +406,15 @@ xla::ifrt::Future<> Client::GetReadyFuture(
     }
   }
 
-  auto promise = Future<>::CreatePromise();
-  rpc_helper_->CheckValueReady(std::move(req))
-      .OnReady(
-          [promise](absl::StatusOr<std::shared_ptr<CheckValueReadyResponse>>
-                        resp) mutable { promise.Set(resp.status()); });
-  futures.push_back(Future<>(std::move(promise)));
+  // Skip the round trip to the server if there is nothing left to check.
+  if (req->value_handles_size() > 0) {
+    auto promise = Future<>::CreatePromise();
+    rpc_helper_->CheckValueReady(std::move(req))
+        .OnReady(
+            [promise](absl::StatusOr<std::shared_ptr<CheckValueReadyResponse>>
+                          resp) mutable { promise.Set(resp.status()); });
+    futures.push_back(Future<>(std::move(promise)));
+  }
 
   return JoinFutures(futures);
 }
@@ -54,6 +54,17 @@ static void SetDataFromStringView(GrpcHostBufferStoreRequest& req,
 #endif
 }
 
+static void AppendDataToCord(absl::Cord& cord,
+                             GrpcHostBufferLookupResponse& response) {
+#if defined(PLATFORM_GOOGLE)
+  cord.Append(response.data());
+#else
+  // Hand the chunk over to the cord instead of copying it; `response` is
+  // overwritten by the next read anyway.
+  cord.Append(std::move(*response.mutable_data()));
+#endif
+}
+
 GrpcClientHostBufferStore::GrpcClientHostBufferStore(
     std::shared_ptr<grpc::GrpcIfrtService::StubInterface> stub,
     IfrtProxyVersion version, uint64_t session_id)
@@ -188,7 +199,7 @@ Future<absl::Cord> GrpcClientHostBufferStore::Lookup(uint64_t handle) {
     absl::Cord data;
     GrpcHostBufferLookupResponse response;
     while (stream->Read(&response)) {
-      data.Append(response.data());
+      AppendDataToCord(data, response);
     }
 
     absl::Status status = xla::FromGrpcStatus(stream->Finish());
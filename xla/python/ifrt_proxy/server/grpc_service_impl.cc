@@ -175,10 +175,20 @@ namespace proxy {
   VLOG(3) << "HostBufferStore starting to receive data "
           << metadata.ShortDebugString();
   std::string data;
-  data.reserve(metadata.buffer_size());
 
   GrpcHostBufferStoreRequest request;
   while (stream->Read(&request)) {
+#if !defined(PLATFORM_GOOGLE)
+    if (data.empty() && request.data().size() == metadata.buffer_size()) {
+      // The whole buffer arrived in a single chunk, take ownership of it
+      // instead of copying.
+      data = std::move(*request.mutable_data());
+      continue;
+    }
+#endif
+    if (data.capacity() < metadata.buffer_size()) {
+      data.reserve(metadata.buffer_size());
+    }
     data.append(request.data());
   }
   VLOG(3) << "HostBufferStore received all data "
@@ -16,6 +16,7 @@ limitations under the License.
 #include "xla/python/pjrt_ifrt/pjrt_array.h"
 
 #include <cstdint>
+#include <cstring>
 #include <memory>
 #include <optional>
 #include <string>
@@ -23,6 +24,7 @@ limitations under the License.
 #include <variant>
 #include <vector>
 
+#include "absl/algorithm/container.h"
 #include "absl/log/check.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -43,6 +45,7 @@ limitations under the License.
 #include "xla/python/ifrt/device_list.h"
 #include "xla/python/ifrt/dtype.h"
 #include "xla/python/ifrt/future.h"
+#include "xla/python/ifrt/index_domain.h"
 #include "xla/python/ifrt/memory.h"
 #include "xla/python/ifrt/shape.h"
 #include "xla/python/ifrt/sharding.h"
@@ -137,6 +140,119 @@ absl::StatusOr<MemoryKind> GetMemoryKindFromPjRtBuffers(
   return first_memory_kind;
 }
 
+// Copies the dense major-to-minor array `src` with dimensions `dims` to `dst`,
+// which has the byte strides `dst_byte_strides`.
+void CopyToStridedBuffer(const char* src, absl::Span<const int64_t> dims,
+                         int64_t elem_size, char* dst,
+                         absl::Span<const int64_t> dst_byte_strides) {
+  if (dims.empty()) {
+    std::memcpy(dst, src, elem_size);
+    return;
+  }
+  if (dims.size() == 1) {
+    if (dst_byte_strides[0] == elem_size) {
+      std::memcpy(dst, src, dims[0] * elem_size);
+      return;
+    }
+    for (int64_t i = 0; i < dims[0]; ++i) {
+      std::memcpy(dst + i * dst_byte_strides[0], src + i * elem_size,
+                  elem_size);
+    }
+    return;
+  }
+  int64_t src_stride = elem_size;
+  for (int64_t dim : dims.subspan(1)) {
+    src_stride *= dim;
+  }
+  for (int64_t i = 0; i < dims[0]; ++i) {
+    CopyToStridedBuffer(src + i * src_stride, dims.subspan(1), elem_size,
+                        dst + i * dst_byte_strides[0],
+                        dst_byte_strides.subspan(1));
+  }
+}
+
+// Copies the shards of a fully addressable array with a static shape to
+// `data`. The transfers of all shards are issued at once, and each shard is
+// copied into its slice of `data` as soon as it arrives on host. Replicated
+// shards are transferred only once.
+Future<> CopyShardsToHostBuffer(
+    PrimitiveType dtype, const Shape& shape, const Sharding& sharding,
+    const PjRtArray::PjRtBuffers& pjrt_buffers, void* data,
+    std::optional<absl::Span<const int64_t>> byte_strides) {
+  if (!sharding.devices()->IsFullyAddressable()) {
+    return Future<>(InvalidArgument(
+        "Copying an array with non-addressable shards to host is not "
+        "supported"));
+  }
+  auto index_domains = sharding.IndexDomains(
+      shape, SingleDeviceShardSemantics::kAddressableShards);
+  if (!index_domains.ok()) {
+    return Future<>(std::move(index_domains).status());
+  }
+  if (index_domains->size() != pjrt_buffers.size()) {
+    return Future<>(InvalidArgument(
+        "Number of shards %d does not match the number of buffers %d",
+        index_domains->size(), pjrt_buffers.size()));
+  }
+
+  const int64_t elem_size = ShapeUtil::ByteSizeOfPrimitiveType(dtype);
+  std::vector<int64_t> dst_byte_strides(shape.dims().size());
+  if (byte_strides.has_value()) {
+    if (byte_strides->size() != dst_byte_strides.size()) {
+      return Future<>(InvalidArgument(
+          "Expected %d byte strides, got %d", dst_byte_strides.size(),
+          byte_strides->size()));
+    }
+    absl::c_copy(*byte_strides, dst_byte_strides.begin());
+  } else {
+    int64_t stride = elem_size;
+    for (int64_t i = dst_byte_strides.size() - 1; i >= 0; --i) {
+      dst_byte_strides[i] = stride;
+      stride *= shape.dims()[i];
+    }
+  }
+
+  std::vector<IndexDomain> copied_domains;
+  std::vector<Future<>> futures;
+  for (int i = 0; i < pjrt_buffers.size(); ++i) {
+    const IndexDomain& domain = (*index_domains)[i];
+    if (absl::c_linear_search(copied_domains, domain)) {
+      continue;
+    }
+    copied_domains.push_back(domain);
+    if (pjrt_buffers[i]->has_dynamic_dimensions()) {
+      return Future<>(InvalidArgument(
+          "Copying a sharded array with dynamic dimensions to host is not "
+          "supported"));
+    }
+
+    char* dst = static_cast<char*>(data);
+    for (int64_t d = 0; d < dst_byte_strides.size(); ++d) {
+      dst += domain.origin().elements()[d] * dst_byte_strides[d];
+    }
+    std::vector<int64_t> dims(domain.shape().dims().begin(),
+                              domain.shape().dims().end());
+    auto literal = std::make_unique<Literal>(
+        ShapeUtil::MakeShapeWithDescendingLayout(dtype, dims));
+    auto* literal_ptr = literal.get();
+    auto promise = Future<>::CreatePromise();
+    futures.push_back(Future<>(promise));
+    pjrt_buffers[i]
+        ->ToLiteral(literal_ptr)
+        .OnReady([literal = std::move(literal), dims = std::move(dims),
+                  elem_size, dst, dst_byte_strides,
+                  promise = std::move(promise)](absl::Status s) mutable {
+          if (s.ok()) {
+            CopyToStridedBuffer(
+                static_cast<const char*>(literal->untyped_data()), dims,
+                elem_size, dst, dst_byte_strides);
+          }
+          promise.Set(std::move(s));
+        });
+  }
+  return JoinFutures(absl::MakeSpan(futures));
+}
+
 }  // namespace
 
 char PjRtCompatibleArray::ID = 0;
@@ -340,17 +456,22 @@ Future<> PjRtArray::CopyToHostBuffer(
     void* data, std::optional<absl::Span<const int64_t>> byte_strides,
     ArrayCopySemantics semantics) {
   DCHECK(this);
-  if (sharding_->devices()->size() != 1) {
-    return Future<>(
-        InvalidArgument("Only single-shard is implemented, but got %d",
-                        sharding_->devices()->size()));
-  }
-
   auto dtype = ToPrimitiveType(dtype_);
   if (!dtype.ok()) {
     return Future<>(std::move(dtype).status());
   }
 
+  if (sharding_->devices()->size() != 1) {
+    if (!has_static_shape()) {
+      return Future<>(InvalidArgument(
+          "Copying a sharded array with a dynamic shape to host is not "
+          "supported"));
+    }
+    // TODO(hyeontaek): Handle semantics == kDonateInput.
+    return CopyShardsToHostBuffer(*dtype, shape(), *sharding_, pjrt_buffers_,
+                                  data, byte_strides);
+  }
+
   PjRtBuffer* pjrt_buffer = pjrt_buffers_.front().get();
   absl::Span<const int64_t> dims;
   absl::StatusOr<std::vector<int64_t>> logical_dims;
@@ -13,9 +13,98 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#include <cstdint>
+#include <numeric>
+#include <optional>
+#include <vector>
+
+#include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "xla/python/ifrt/array.h"
+#include "xla/python/ifrt/client.h"
+#include "xla/python/ifrt/device.h"
+#include "xla/python/ifrt/dtype.h"
+#include "xla/python/ifrt/ir/sharding_param.h"
+#include "xla/python/ifrt/memory.h"
+#include "xla/python/ifrt/shape.h"
+#include "xla/python/ifrt/sharding.h"
 #include "xla/python/ifrt/test_util.h"
+#include "xla/tsl/lib/core/status_test_util.h"
+#include "xla/tsl/platform/statusor.h"
+
+namespace xla {
+namespace ifrt {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::SizeIs;
+
+TEST(PjRtArrayImplTest, CopyShardedArrayToHostBuffer) {
+  TF_ASSERT_OK_AND_ASSIGN(auto client, test_util::GetClient());
+  if (client->addressable_devices().size() < 2) {
+    GTEST_SKIP() << "This test requires at least 2 addressable devices";
+  }
+
+  DType dtype(DType::kF32);
+  Shape shape({2, 3});
+  Shape shard_shape({1, 3});
+  std::vector<float> data0(3);
+  std::iota(data0.begin(), data0.end(), 0);
+  std::vector<float> data1(3);
+  std::iota(data1.begin(), data1.end(), 3);
+  absl::Span<Device* const> devices =
+      client->addressable_devices().subspan(0, 2);
+  TF_ASSERT_OK_AND_ASSIGN(
+      ShardingRef sharding,
+      ShardingParamSharding::Create(
+          ShardingParam(
+              /*dim_shards=*/{2, 1},
+              {/*permutation=*/{0, 1}, /*axis_sizes=*/{2, 1}}),
+          client->MakeDeviceList(devices), MemoryKind()));
+
+  std::vector<Client::MakeArraysFromHostBufferShardsSpec> specs;
+  specs.push_back({
+      /*buffers=*/{
+          {{0},
+           {data0.data(), dtype, shard_shape, /*byte_strides=*/std::nullopt,
+            /*on_done_with_host_buffer=*/nullptr}},
+          {{1},
+           {data1.data(), dtype, shard_shape, /*byte_strides=*/std::nullopt,
+            /*on_done_with_host_buffer=*/nullptr}}},
+      /*array_spec=*/{dtype, shape, sharding, /*layout=*/nullptr},
+  });
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto arrays, client->MakeArraysFromHostBufferShards(
+                       absl::MakeSpan(specs),
+                       Client::HostBufferSemantics::kImmutableOnlyDuringCall,
+                       client->CreateUserContext()));
+  ASSERT_THAT(arrays, SizeIs(1));
+
+  std::vector<float> out_data(6);
+  TF_ASSERT_OK(arrays[0]
+                   ->CopyToHostBuffer(out_data.data(),
+                                      /*byte_strides=*/std::nullopt,
+                                      ArrayCopySemantics::kAlwaysCopy)
+                   .Await());
+  EXPECT_THAT(out_data, ElementsAre(0, 1, 2, 3, 4, 5));
+
+  // Each shard is written with the strides of the destination, here in
+  // column-major order.
+  std::vector<int64_t> byte_strides = {4, 8};
+  std::vector<float> out_data_transposed(6);
+  TF_ASSERT_OK(arrays[0]
+                   ->CopyToHostBuffer(out_data_transposed.data(),
+                                      byte_strides,
+                                      ArrayCopySemantics::kAlwaysCopy)
+                   .Await());
+  EXPECT_THAT(out_data_transposed, ElementsAre(0, 3, 1, 4, 2, 5));
+}
+
+}  // namespace
+}  // namespace ifrt
+}  // namespace xla
 
 int main(int argc, char** argv) {
   // CpuBuffer::ToLiteral() currently does not respect the layout of the
@@ -0,0 +1,158 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+
+#include "xla/python/pjrt_ifrt/pjrt_reshard.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/status/statusor.h"
+#include "absl/types/span.h"
+#include "llvm/Support/Casting.h"
+#include "xla/pjrt/pjrt_client.h"
+#include "xla/pjrt/pjrt_layout.h"
+#include "xla/python/ifrt/array.h"
+#include "xla/python/ifrt/device.h"
+#include "xla/python/ifrt/index_domain.h"
+#include "xla/python/ifrt/memory.h"
+#include "xla/python/ifrt/shape.h"
+#include "xla/python/ifrt/sharding.h"
+#include "xla/python/pjrt_ifrt/pjrt_array.h"
+#include "xla/python/pjrt_ifrt/pjrt_device.h"
+#include "xla/python/pjrt_ifrt/pjrt_memory.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/util.h"
+
+namespace xla {
+namespace ifrt {
+namespace {
+
+// Returns the memory space of `device` that holds the shards of `sharding`.
+absl::StatusOr<PjRtMemorySpace*> GetPjRtMemorySpace(const Sharding& sharding,
+                                                    Device* device) {
+  auto* pjrt_device = llvm::dyn_cast<PjRtCompatibleDevice>(device);
+  if (pjrt_device == nullptr) {
+    return InvalidArgument("Device %s is not a PjRt-compatible device",
+                           device->DebugString());
+  }
+  if (!sharding.memory_kind().memory_kind().has_value()) {
+    return pjrt_device->pjrt_device()->default_memory_space();
+  }
+  for (Memory* memory : device->Memories()) {
+    if (memory->Kind() == sharding.memory_kind()) {
+      return llvm::cast<PjRtMemory>(memory)->pjrt_memory();
+    }
+  }
+  return InvalidArgument("Device %s has no memory of kind %v",
+                         device->DebugString(), sharding.memory_kind());
+}
+
+}  // namespace
+
+absl::StatusOr<std::vector<int>> PlanReshard(const Shape& shape,
+                                             const Sharding& src_sharding,
+                                             const Sharding& dst_sharding) {
+  TF_ASSIGN_OR_RETURN(
+      std::vector<IndexDomain> src_domains,
+      src_sharding.IndexDomains(
+          shape, SingleDeviceShardSemantics::kAddressableShards));
+  TF_ASSIGN_OR_RETURN(
+      std::vector<IndexDomain> dst_domains,
+      dst_sharding.IndexDomains(
+          shape, SingleDeviceShardSemantics::kAddressableShards));
+  absl::Span<Device* const> src_devices =
+      src_sharding.devices()->AddressableDeviceList()->devices();
+  absl::Span<Device* const> dst_devices =
+      dst_sharding.devices()->AddressableDeviceList()->devices();
+
+  // Number of transfers from each source shard.
+  std::vector<int> num_transfers(src_domains.size(), 0);
+  std::vector<int> plan;
+  plan.reserve(dst_domains.size());
+  for (int j = 0; j < dst_domains.size(); ++j) {
+    int src = -1;
+    for (int i = 0; i < src_domains.size(); ++i) {
+      if (src_domains[i] != dst_domains[j]) {
+        continue;
+      }
+      if (src_devices[i] == dst_devices[j]) {
+        src = i;
+        break;
+      }
+      if (src == -1 || num_transfers[i] < num_transfers[src]) {
+        src = i;
+      }
+    }
+    if (src == -1) {
+      return Unimplemented(
+          "Resharding from %v to %v needs to slice or concatenate shards: "
+          "destination shard %v is not a shard of the source",
+          src_sharding, dst_sharding, dst_domains[j]);
+    }
+    if (src_devices[src] != dst_devices[j]) {
+      ++num_transfers[src];
+    }
+    plan.push_back(src);
+  }
+  return plan;
+}
+
+absl::StatusOr<ArrayRef> PjRtCompatibleClientReshardArray(
+    PjRtCompatibleClient* client, ArrayRef array, ShardingRef sharding,
+    ArrayCopySemantics semantics) {
+  auto* pjrt_array = llvm::dyn_cast<PjRtCompatibleArray>(array.get());
+  if (pjrt_array == nullptr) {
+    return InvalidArgument("Only PjRtCompatibleArray is supported, but got %s",
+                           array->DebugString());
+  }
+  TF_ASSIGN_OR_RETURN(
+      std::vector<int> plan,
+      PlanReshard(array->shape(), array->sharding(), *sharding));
+
+  absl::Span<const std::shared_ptr<PjRtBuffer>> src_buffers =
+      pjrt_array->pjrt_buffers();
+  absl::Span<Device* const> dst_devices =
+      sharding->devices()->AddressableDeviceList()->devices();
+  PjRtArray::PjRtBuffers dst_buffers;
+  dst_buffers.reserve(plan.size());
+  for (int j = 0; j < plan.size(); ++j) {
+    const std::shared_ptr<PjRtBuffer>& src_buffer = src_buffers[plan[j]];
+    TF_ASSIGN_OR_RETURN(PjRtMemorySpace * memory_space,
+                        GetPjRtMemorySpace(*sharding, dst_devices[j]));
+    if (src_buffer->memory_space() == memory_space &&
+        semantics != ArrayCopySemantics::kAlwaysCopy) {
+      dst_buffers.push_back(src_buffer);
+      continue;
+    }
+    TF_ASSIGN_OR_RETURN(std::unique_ptr<PjRtBuffer> copied_buffer,
+                        src_buffer->CopyToMemorySpace(memory_space));
+    dst_buffers.push_back(std::move(copied_buffer));
+  }
+  if (dst_buffers.empty()) {
+    return InvalidArgument("Cannot reshard to %v without addressable devices",
+                           *sharding);
+  }
+
+  std::shared_ptr<const xla::PjRtLayout> layout =
+      dst_buffers.front()->layout();
+  return PjRtArray::Create(client, array->dtype(), array->shape(),
+                           std::move(sharding), std::move(dst_buffers),
+                           std::move(layout));
+}
+
+}  // namespace ifrt
+}  // namespace xla
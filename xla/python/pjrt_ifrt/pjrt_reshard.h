@@ -0,0 +1,57 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+
+#ifndef XLA_PYTHON_PJRT_IFRT_PJRT_RESHARD_H_
+#define XLA_PYTHON_PJRT_IFRT_PJRT_RESHARD_H_
+
+#include <vector>
+
+#include "absl/status/statusor.h"
+#include "xla/python/ifrt/array.h"
+#include "xla/python/ifrt/shape.h"
+#include "xla/python/ifrt/sharding.h"
+
+namespace xla {
+namespace ifrt {
+
+class PjRtCompatibleClient;
+
+// Plans a reshard of an array of `shape` from `src_sharding` to
+// `dst_sharding` that only moves whole shards. Returns, for every addressable
+// shard of `dst_sharding`, the index of the addressable shard of
+// `src_sharding` that holds the same elements. A source shard on the same
+// device is preferred, which needs no transfer. Otherwise the transfers are
+// spread over the source shards holding the elements.
+//
+// Returns `UNIMPLEMENTED` if a destination shard is not equal to any source
+// shard, i.e., if the reshard needs to slice or concatenate shards.
+absl::StatusOr<std::vector<int>> PlanReshard(const Shape& shape,
+                                             const Sharding& src_sharding,
+                                             const Sharding& dst_sharding);
+
+// Reshards `array` to `sharding` with device-to-device copies of whole shards
+// as planned by `PlanReshard`, without going through the host. The copies are
+// asynchronous and the returned array becomes ready once they are done.
+// Shards that are already on their destination device and memory are reused
+// unless `semantics` is `kAlwaysCopy`.
+absl::StatusOr<ArrayRef> PjRtCompatibleClientReshardArray(
+    PjRtCompatibleClient* client, ArrayRef array, ShardingRef sharding,
+    ArrayCopySemantics semantics);
+
+}  // namespace ifrt
+}  // namespace xla
+
+#endif  // XLA_PYTHON_PJRT_IFRT_PJRT_RESHARD_H_
@@ -0,0 +1,134 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+
+#include "xla/python/pjrt_ifrt/pjrt_reshard.h"
+
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/types/span.h"
+#include "llvm/Support/Casting.h"
+#include "xla/pjrt/plugin/xla_cpu/cpu_client_options.h"
+#include "xla/pjrt/plugin/xla_cpu/xla_cpu_pjrt_client.h"
+#include "xla/python/ifrt/array.h"
+#include "xla/python/ifrt/client.h"
+#include "xla/python/ifrt/device.h"
+#include "xla/python/ifrt/dtype.h"
+#include "xla/python/ifrt/ir/sharding_param.h"
+#include "xla/python/ifrt/memory.h"
+#include "xla/python/ifrt/shape.h"
+#include "xla/python/ifrt/sharding.h"
+#include "xla/python/pjrt_ifrt/pjrt_array.h"
+#include "xla/python/pjrt_ifrt/pjrt_client.h"
+#include "xla/tsl/lib/core/status_test_util.h"
+#include "xla/tsl/platform/status_matchers.h"
+#include "xla/tsl/platform/statusor.h"
+
+namespace xla {
+namespace ifrt {
+namespace {
+
+using ::testing::ElementsAre;
+using ::tsl::testing::StatusIs;
+
+class PjRtReshardTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    CpuClientOptions options;
+    options.cpu_device_count = 4;
+    TF_ASSERT_OK_AND_ASSIGN(auto pjrt_client,
+                            GetXlaPjrtCpuClient(std::move(options)));
+    client_ = PjRtClient::Create(std::move(pjrt_client));
+  }
+
+  // Returns a sharding of a [2, 3] array with `dim_shards` over `devices`.
+  ShardingRef MakeSharding(std::vector<int64_t> dim_shards,
+                           std::vector<int> devices) {
+    std::vector<Device*> sharding_devices;
+    for (int device : devices) {
+      sharding_devices.push_back(client_->addressable_devices()[device]);
+    }
+    const int num_shards = dim_shards[0] * dim_shards[1];
+    ShardingParam param(
+        std::move(dim_shards),
+        {/*permutation=*/{0, 1},
+         /*axis_sizes=*/{num_shards, static_cast<int>(devices.size()) /
+                                         num_shards}});
+    return *ShardingParamSharding::Create(
+        std::move(param), client_->MakeDeviceList(sharding_devices),
+        MemoryKind());
+  }
+
+  std::unique_ptr<PjRtClient> client_;
+  Shape shape_ = Shape({2, 3});
+};
+
+TEST_F(PjRtReshardTest, PlanPrefersShardsOnTheSameDevice) {
+  TF_ASSERT_OK_AND_ASSIGN(
+      std::vector<int> plan,
+      PlanReshard(shape_, *MakeSharding({1, 1}, {0, 1}),
+                  *MakeSharding({1, 1}, {1, 2})));
+  EXPECT_THAT(plan, ElementsAre(1, 0));
+}
+
+TEST_F(PjRtReshardTest, PlanRejectsSlicing) {
+  EXPECT_THAT(PlanReshard(shape_, *MakeSharding({2, 1}, {0, 1}),
+                          *MakeSharding({1, 1}, {0, 1})),
+              StatusIs(absl::StatusCode::kUnimplemented));
+}
+
+TEST_F(PjRtReshardTest, ReshardToOtherDevices) {
+  DType dtype(DType::kF32);
+  std::vector<float> data(6);
+  std::iota(data.begin(), data.end(), 0);
+  TF_ASSERT_OK_AND_ASSIGN(
+      ArrayRef array,
+      client_->MakeArrayFromHostBuffer(
+          data.data(), dtype, shape_, /*byte_strides=*/std::nullopt,
+          MakeSharding({1, 1}, {0, 1}),
+          Client::HostBufferSemantics::kImmutableOnlyDuringCall,
+          /*on_done_with_host_buffer=*/nullptr));
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      ArrayRef resharded,
+      PjRtCompatibleClientReshardArray(client_.get(), array,
+                                       MakeSharding({1, 1}, {1, 2}),
+                                       ArrayCopySemantics::kReuseInput));
+  EXPECT_THAT(resharded->sharding().devices()->devices(),
+              ElementsAre(client_->addressable_devices()[1],
+                          client_->addressable_devices()[2]));
+  // The shard on device 1 is reused, only the one on device 2 is copied.
+  EXPECT_EQ(llvm::cast<PjRtArray>(resharded.get())->pjrt_buffers()[0],
+            llvm::cast<PjRtArray>(array.get())->pjrt_buffers()[1]);
+
+  std::vector<float> out_data(6);
+  TF_ASSERT_OK(resharded
+                   ->CopyToHostBuffer(out_data.data(),
+                                      /*byte_strides=*/std::nullopt,
+                                      ArrayCopySemantics::kAlwaysCopy)
+                   .Await());
+  EXPECT_THAT(out_data, ElementsAre(0, 1, 2, 3, 4, 5));
+}
+
+}  // namespace
+}  // namespace ifrt
+}  // namespace xla
@@ -0,0 +1,150 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/python/polymorphic_executable_cache.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/log/log.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "llvm/ADT/SmallVector.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/BuiltinTypes.h"
+#include "mlir/IR/DialectRegistry.h"
+#include "mlir/IR/MLIRContext.h"
+#include "mlir/IR/OwningOpRef.h"
+#include "mlir/IR/Types.h"
+#include "xla/pjrt/mlir_to_hlo.h"
+#include "xla/pjrt/pjrt_client.h"
+#include "xla/pjrt/pjrt_executable.h"
+#include "xla/python/refine_polymorphic_shapes.h"
+#include "xla/shape.h"
+#include "xla/tsl/platform/errors.h"
+#include "xla/tsl/platform/statusor.h"
+
+namespace xla {
+
+/*static*/ absl::StatusOr<std::unique_ptr<PolymorphicExecutableCache>>
+PolymorphicExecutableCache::Create(PjRtClient* client,
+                                   absl::string_view module_str,
+                                   CompileOptions compile_options,
+                                   int capacity) {
+  auto context = std::make_unique<mlir::MLIRContext>();
+  mlir::DialectRegistry registry;
+  RegisterAllHloDialects(registry);
+  context->appendDialectRegistry(registry);
+  TF_ASSIGN_OR_RETURN(mlir::OwningOpRef<mlir::ModuleOp> module,
+                      ParseMlirModuleString(module_str, *context));
+  if (!module->lookupSymbol<mlir::func::FuncOp>("main")) {
+    return absl::InvalidArgumentError("Module has no main function.");
+  }
+  return std::unique_ptr<PolymorphicExecutableCache>(
+      new PolymorphicExecutableCache(client, std::move(context),
+                                     std::move(module),
+                                     std::move(compile_options), capacity));
+}
+
+PolymorphicExecutableCache::PolymorphicExecutableCache(
+    PjRtClient* client, std::unique_ptr<mlir::MLIRContext> context,
+    mlir::OwningOpRef<mlir::ModuleOp> module, CompileOptions compile_options,
+    int capacity)
+    : client_(client),
+      context_(std::move(context)),
+      module_(std::move(module)),
+      compile_options_(std::move(compile_options)),
+      lru_list_(capacity),
+      cache_(&lru_list_) {}
+
+PolymorphicExecutableCache::~PolymorphicExecutableCache() = default;
+
+absl::StatusOr<std::shared_ptr<PjRtLoadedExecutable>>
+PolymorphicExecutableCache::GetOrCompile(
+    absl::Span<const Shape> argument_shapes) {
+  Key key;
+  key.reserve(argument_shapes.size());
+  for (const Shape& shape : argument_shapes) {
+    if (!shape.IsArray()) {
+      return absl::InvalidArgumentError(
+          absl::StrCat("Expected array arguments, got ", shape.ToString()));
+    }
+    key.emplace_back(shape.dimensions().begin(), shape.dimensions().end());
+  }
+  return cache_.GetOrCreateIfAbsent(
+      key, [this](const Key& key) { return Specialize(key); });
+}
+
+PolymorphicExecutableCache::Value PolymorphicExecutableCache::Specialize(
+    const Key& argument_dims) {
+  VLOG(1) << "Specializing polymorphic module for argument dimensions "
+          << absl::StrJoin(argument_dims, ", ",
+                           [](std::string* out, const auto& dims) {
+                             absl::StrAppend(out, "[", absl::StrJoin(dims, ","),
+                                             "]");
+                           });
+  mlir::OwningOpRef<mlir::ModuleOp> module = module_->clone();
+  auto main = module->lookupSymbol<mlir::func::FuncOp>("main");
+  mlir::FunctionType type = main.getFunctionType();
+  if (argument_dims.size() != type.getNumInputs()) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("Expected ", type.getNumInputs(), " arguments, got ",
+                     argument_dims.size()));
+  }
+
+  // Give main static argument types, and let shape refinement propagate them
+  // through the module.
+  llvm::SmallVector<mlir::Type> refined_inputs;
+  for (int64_t i = 0; i < argument_dims.size(); ++i) {
+    auto input = mlir::dyn_cast<mlir::RankedTensorType>(type.getInput(i));
+    if (!input || input.getRank() != argument_dims[i].size()) {
+      return absl::InvalidArgumentError(
+          absl::StrCat("Argument ", i, " does not match the rank of the "
+                       "module's argument"));
+    }
+    for (int64_t d = 0; d < input.getRank(); ++d) {
+      if (!input.isDynamicDim(d) &&
+          input.getDimSize(d) != argument_dims[i][d]) {
+        return absl::InvalidArgumentError(
+            absl::StrCat("Argument ", i, " has size ", argument_dims[i][d],
+                         " in static dimension ", d, " of size ",
+                         input.getDimSize(d)));
+      }
+    }
+    auto refined =
+        mlir::RankedTensorType::get(argument_dims[i], input.getElementType());
+    main.getArgument(i).setType(refined);
+    refined_inputs.push_back(refined);
+  }
+  main.setType(mlir::FunctionType::get(context_.get(), refined_inputs,
+                                       type.getResults()));
+
+  TF_RETURN_IF_ERROR(
+      RefinePolymorphicShapes(*module, /*enable_shape_assertions=*/true));
+  TF_RETURN_IF_ERROR(ValidateStaticShapes(*module));
+  TF_ASSIGN_OR_RETURN(std::unique_ptr<PjRtLoadedExecutable> executable,
+                      client_->CompileAndLoad(*module, compile_options_));
+  return std::shared_ptr<PjRtLoadedExecutable>(std::move(executable));
+}
+
+}  // namespace xla
@@ -0,0 +1,84 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_PYTHON_POLYMORPHIC_EXECUTABLE_CACHE_H_
+#define XLA_PYTHON_POLYMORPHIC_EXECUTABLE_CACHE_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/MLIRContext.h"
+#include "mlir/IR/OwningOpRef.h"
+#include "xla/pjrt/lru_cache.h"
+#include "xla/pjrt/pjrt_client.h"
+#include "xla/pjrt/pjrt_executable.h"
+#include "xla/shape.h"
+
+namespace xla {
+
+// An LRU cache of executables specialized from one shape polymorphic StableHLO
+// module, i.e. a module whose "main" has dynamic argument dimensions. Each
+// distinct set of concrete argument dimensions is refined with
+// RefinePolymorphicShapes and compiled once, so callers only pay for parsing
+// and tracing the module once, and the number of live executables is bounded
+// by `capacity`. Not thread-safe.
+class PolymorphicExecutableCache {
+ public:
+  // Parses `module_str`, which may be text or bytecode.
+  static absl::StatusOr<std::unique_ptr<PolymorphicExecutableCache>> Create(
+      PjRtClient* client, absl::string_view module_str,
+      CompileOptions compile_options, int capacity);
+
+  ~PolymorphicExecutableCache();
+
+  PolymorphicExecutableCache(const PolymorphicExecutableCache&) = delete;
+  PolymorphicExecutableCache& operator=(const PolymorphicExecutableCache&) =
+      delete;
+
+  // Returns the executable specialized for arguments of `argument_shapes`,
+  // compiling it if it is not cached. Only the dimensions of the shapes are
+  // used; element types are given by the module.
+  absl::StatusOr<std::shared_ptr<PjRtLoadedExecutable>> GetOrCompile(
+      absl::Span<const Shape> argument_shapes);
+
+  int Size() const { return cache_.Size(); }
+
+ private:
+  using Key = std::vector<std::vector<int64_t>>;
+  using Value = absl::StatusOr<std::shared_ptr<PjRtLoadedExecutable>>;
+
+  PolymorphicExecutableCache(PjRtClient* client,
+                             std::unique_ptr<mlir::MLIRContext> context,
+                             mlir::OwningOpRef<mlir::ModuleOp> module,
+                             CompileOptions compile_options, int capacity);
+
+  Value Specialize(const Key& argument_dims);
+
+  PjRtClient* client_;
+  std::unique_ptr<mlir::MLIRContext> context_;
+  mlir::OwningOpRef<mlir::ModuleOp> module_;
+  CompileOptions compile_options_;
+  LRUCache<Key, Value>::LRUList lru_list_;
+  LRUCache<Key, Value> cache_;
+};
+
+}  // namespace xla
+
+#endif  // XLA_PYTHON_POLYMORPHIC_EXECUTABLE_CACHE_H_
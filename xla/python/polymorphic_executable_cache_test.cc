@@ -0,0 +1,123 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/python/polymorphic_executable_cache.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/log/check.h"
+#include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/pjrt/pjrt_client.h"
+#include "xla/pjrt/pjrt_executable.h"
+#include "xla/pjrt/plugin/xla_cpu/cpu_client_options.h"
+#include "xla/pjrt/plugin/xla_cpu/xla_cpu_pjrt_client.h"
+#include "xla/shape.h"
+#include "xla/shape_util.h"
+#include "xla/tsl/platform/status_matchers.h"
+#include "xla/tsl/platform/statusor.h"
+
+namespace xla {
+namespace {
+
+using ::tsl::testing::StatusIs;
+
+constexpr absl::string_view kPolymorphicModule = R"(
+  func.func @main(%arg0: tensor<?x4xf32>) -> tensor<?x4xf32> {
+    %0 = stablehlo.add %arg0, %arg0 : tensor<?x4xf32>
+    return %0 : tensor<?x4xf32>
+  })";
+
+class PolymorphicExecutableCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    CpuClientOptions options;
+    options.cpu_device_count = 1;
+    TF_ASSERT_OK_AND_ASSIGN(client_, GetXlaPjrtCpuClient(std::move(options)));
+  }
+
+  // Returns the shape of the first parameter of the executable's module.
+  static Shape ParameterShape(PjRtLoadedExecutable& executable) {
+    auto modules = executable.GetHloModules();
+    CHECK_OK(modules.status());
+    return modules->front()
+        ->entry_computation()
+        ->parameter_instruction(0)
+        ->shape();
+  }
+
+  std::unique_ptr<PjRtClient> client_;
+};
+
+TEST_F(PolymorphicExecutableCacheTest, SpecializesPerShape) {
+  TF_ASSERT_OK_AND_ASSIGN(
+      std::unique_ptr<PolymorphicExecutableCache> cache,
+      PolymorphicExecutableCache::Create(client_.get(), kPolymorphicModule,
+                                         CompileOptions(), /*capacity=*/2));
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      std::shared_ptr<PjRtLoadedExecutable> two,
+      cache->GetOrCompile({ShapeUtil::MakeShape(F32, {2, 4})}));
+  EXPECT_TRUE(ShapeUtil::SameDimensions(ParameterShape(*two),
+                                        ShapeUtil::MakeShape(F32, {2, 4})));
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      std::shared_ptr<PjRtLoadedExecutable> three,
+      cache->GetOrCompile({ShapeUtil::MakeShape(F32, {3, 4})}));
+  EXPECT_TRUE(ShapeUtil::SameDimensions(ParameterShape(*three),
+                                        ShapeUtil::MakeShape(F32, {3, 4})));
+  EXPECT_EQ(cache->Size(), 2);
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      std::shared_ptr<PjRtLoadedExecutable> two_again,
+      cache->GetOrCompile({ShapeUtil::MakeShape(F32, {2, 4})}));
+  EXPECT_EQ(two_again, two);
+}
+
+TEST_F(PolymorphicExecutableCacheTest, EvictsLeastRecentlyUsed) {
+  TF_ASSERT_OK_AND_ASSIGN(
+      std::unique_ptr<PolymorphicExecutableCache> cache,
+      PolymorphicExecutableCache::Create(client_.get(), kPolymorphicModule,
+                                         CompileOptions(), /*capacity=*/1));
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      std::shared_ptr<PjRtLoadedExecutable> two,
+      cache->GetOrCompile({ShapeUtil::MakeShape(F32, {2, 4})}));
+  TF_ASSERT_OK(cache->GetOrCompile({ShapeUtil::MakeShape(F32, {3, 4})})
+                   .status());
+  EXPECT_EQ(cache->Size(), 1);
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      std::shared_ptr<PjRtLoadedExecutable> two_again,
+      cache->GetOrCompile({ShapeUtil::MakeShape(F32, {2, 4})}));
+  EXPECT_NE(two_again, two);
+}
+
+TEST_F(PolymorphicExecutableCacheTest, RejectsMismatchedStaticDimension) {
+  TF_ASSERT_OK_AND_ASSIGN(
+      std::unique_ptr<PolymorphicExecutableCache> cache,
+      PolymorphicExecutableCache::Create(client_.get(), kPolymorphicModule,
+                                         CompileOptions(), /*capacity=*/2));
+  EXPECT_THAT(cache->GetOrCompile({ShapeUtil::MakeShape(F32, {2, 5})}),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+}  // namespace
+}  // namespace xla
@@ -756,7 +756,22 @@ class SocketBulkTransportFactory : public BulkTransportFactory {
 absl::StatusOr<std::shared_ptr<BulkTransportFactory>>
 CreateSocketBulkTransportFactory(std::vector<SocketAddress> addrs,
                                  std::optional<SlabAllocator> allocator,
-                                 SlabAllocator unpinned_allocator) {
+                                 SlabAllocator unpinned_allocator,
+                                 size_t connections_per_addr) {
+  if (connections_per_addr == 0) {
+    return absl::InvalidArgumentError(
+        "connections_per_addr must be at least 1.");
+  }
+  if (connections_per_addr > 1) {
+    std::vector<SocketAddress> striped_addrs;
+    striped_addrs.reserve(addrs.size() * connections_per_addr);
+    for (const SocketAddress& addr : addrs) {
+      for (size_t i = 0; i < connections_per_addr; ++i) {
+        striped_addrs.push_back(addr);
+      }
+    }
+    addrs = std::move(striped_addrs);
+  }
   size_t num_connections = addrs.size();
 
   std::vector<std::shared_ptr<RecvThreadState>> thread_states;
@@ -19,6 +19,7 @@ limitations under the License.
 #include <sys/socket.h>
 
 #include <atomic>
+#include <cstddef>
 #include <deque>
 #include <limits>
 #include <memory>
@@ -182,10 +183,15 @@ class RecvThreadState {
 
 // Create a socket transport factory that allocates out of allocator and
 // unpinned_allocator and communicates over all addrs in parallel.
+// connections_per_addr opens that many connections (each with its own send
+// and recv thread) per address so that a single link can be striped across
+// several TCP streams. Both peers must use the same value and addrs should
+// use an ephemeral port when connections_per_addr > 1.
 absl::StatusOr<std::shared_ptr<BulkTransportFactory>>
 CreateSocketBulkTransportFactory(std::vector<SocketAddress> addrs,
                                  std::optional<SlabAllocator> allocator,
-                                 SlabAllocator unpinned_allocator);
+                                 SlabAllocator unpinned_allocator,
+                                 size_t connections_per_addr = 1);
 
 }  // namespace aux
 
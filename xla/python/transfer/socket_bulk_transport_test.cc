@@ -155,7 +155,7 @@ TEST(SendQueue, SendAndRecvQueuesArtificialLimit) {
   }
 }
 
-TEST(SocketBulkTransportFactoryTest, SendAndRecvWithFactory) {
+void SendAndRecvWithFactory(size_t connections_per_addr) {
   size_t packet_size = 1024 * 8;
   SlabAllocator allocator(AllocateNetworkPinnedMemory(packet_size * 4).value(),
                           packet_size);
@@ -165,11 +165,13 @@ TEST(SocketBulkTransportFactoryTest, SendAndRecvWithFactory) {
   SocketAddress addr;
   SocketAddress addrv4 = SocketAddress::Parse("0.0.0.0:0").value();
   auto status_or =
-      CreateSocketBulkTransportFactory({addr, addrv4}, allocator, uallocator);
+      CreateSocketBulkTransportFactory({addr, addrv4}, allocator, uallocator,
+                                       connections_per_addr);
   ASSERT_TRUE(status_or.ok()) << status_or.status();
   auto factory = status_or.value();
   status_or =
-      CreateSocketBulkTransportFactory({addr, addrv4}, allocator, uallocator);
+      CreateSocketBulkTransportFactory({addr, addrv4}, allocator, uallocator,
+                                       connections_per_addr);
   ASSERT_TRUE(status_or.ok()) << status_or.status();
   auto factory2 = status_or.value();
 
@@ -247,6 +249,14 @@ TEST(SocketBulkTransportFactoryTest, SendAndRecvWithFactory) {
   }
 }
 
+TEST(SocketBulkTransportFactoryTest, SendAndRecvWithFactory) {
+  SendAndRecvWithFactory(/*connections_per_addr=*/1);
+}
+
+TEST(SocketBulkTransportFactoryTest, SendAndRecvWithStripedConnections) {
+  SendAndRecvWithFactory(/*connections_per_addr=*/3);
+}
+
 void HandleAckAndExpectDone(ZeroCopySendAckTable& table, uint32_t ack_id,
                             size_t exp_seal_id, std::vector<size_t>& ack_list) {
   EXPECT_EQ(ack_list.size(), 0);
@@ -280,6 +280,18 @@ bool RawBufferEntry::Handle(tsl::RCReference<ConnectionState> state,
             state->SendError(req_id, 0, buf_size, true, s);
             return;
           }
+          // Host-addressable device memory can go straight to the wire
+          // without being staged through the premapped scratch buffers.
+          if (auto* host_ptr =
+                  static_cast<const char*>(buffer->GetHostPointer())) {
+            for (size_t offset = 0; offset < buf_size; offset += xfer_size) {
+              size_t size = std::min(xfer_size, buf_size - offset);
+              bool is_largest = size + offset == buf_size;
+              state->Send(req_id, host_ptr + offset, offset, size, is_largest,
+                          [buffer]() {});
+            }
+            return;
+          }
           for (size_t i = 0; i * xfer_size < buf_size; ++i) {
             DmaCopyChunk blob;
             blob.copy_fn = [buffer](
@@ -38,6 +38,7 @@ limitations under the License.
 #include "xla/layout.h"
 #include "xla/literal.h"
 #include "xla/pjrt/exceptions.h"
+#include "xla/pjrt/utils.h"
 #include "xla/python/ifrt/dtype.h"
 #include "xla/python/nb_numpy.h"
 #include "xla/python/pjrt_ifrt/pjrt_dtype.h"
@@ -625,8 +626,7 @@ nb::tuple MutableSpanToNbTuple(absl::Span<nb::object> xs) {
 }
 
 std::optional<CastToArrayResult> CastToArray(nb::handle h) {
-  auto array =
-      nb_numpy_ndarray::ensure(h, NPY_ARRAY_C_CONTIGUOUS | NPY_ARRAY_ALIGNED);
+  auto array = nb_numpy_ndarray::ensure(h, NPY_ARRAY_ALIGNED);
   auto type_or_status = DtypeToPrimitiveType(array.dtype());
   if (!type_or_status.ok()) {
     throw xla::XlaRuntimeError(type_or_status.status());
@@ -634,10 +634,24 @@ std::optional<CastToArrayResult> CastToArray(nb::handle h) {
   PrimitiveType type = type_or_status.value();
 
   absl::InlinedVector<int64_t, 4> dims(array.ndim());
+  absl::InlinedVector<int64_t, 4> byte_strides(array.ndim());
   for (int i = 0; i < array.ndim(); ++i) {
     dims[i] = array.shape(i);
+    byte_strides[i] = array.strides(i);
+  }
+  // Arrays whose strides are a transposition of a dense buffer, e.g. arrays in
+  // Fortran order, are borrowed with the matching layout. Only other strided
+  // arrays are copied to C order.
+  absl::StatusOr<Shape> strided_shape =
+      MakeShapeWithTrivialByteStrides(type, dims, byte_strides);
+  Shape shape;
+  if (strided_shape.ok()) {
+    shape = *std::move(strided_shape);
+  } else {
+    array = nb_numpy_ndarray::ensure(array,
+                                     NPY_ARRAY_C_CONTIGUOUS | NPY_ARRAY_ALIGNED);
+    shape = ShapeUtil::MakeShape(type, dims);
   }
-  Shape shape = ShapeUtil::MakeShape(type, dims);
   if (array.size() * array.itemsize() != ShapeUtil::ByteSizeOf(shape)) {
     throw xla::XlaRuntimeError(absl::StrCat(
         "Size mismatch for buffer: ", array.size() * array.itemsize(), " vs. ",
@@ -26,7 +26,11 @@ limitations under the License.
 #include "absl/status/status.h"
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
+#include "xla/hlo/ir/hlo_computation.h"
+#include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/service/measured_fusion_runtimes.h"
 #include "xla/service/hlo.pb.h"
 #include "xla/tsl/platform/env.h"
 #include "xla/tsl/platform/types.h"
@@ -134,13 +138,8 @@ std::unique_ptr<xla::HloModule> CreateModuleFromProto(
 }
 
 std::optional<std::string> GetHloModuleFingerprint(
-    const xla::HloModuleProto& hlo_module_proto) {
-  std::unique_ptr<xla::HloModule> hlo_module =
-      CreateModuleFromProto(hlo_module_proto);
-  if (hlo_module == nullptr) {
-    return std::nullopt;
-  }
-  const auto& map = hlo_module->entry_computation()
+    const xla::HloModule& hlo_module) {
+  const auto& map = hlo_module.entry_computation()
                         ->root_instruction()
                         ->frontend_attributes()
                         .map();
@@ -151,9 +150,15 @@ std::optional<std::string> GetHloModuleFingerprint(
   return std::nullopt;
 }
 
+// Optimized HLO modules of the profile, with the fingerprint that prefixes the
+// cost names of their instructions.
+using FingerprintedHloModules =
+    std::vector<std::pair<std::string, std::unique_ptr<xla::HloModule>>>;
+
 void GetXPlaneHloModuleInfo(
     const XPlaneVisitor& xplane,
-    absl::flat_hash_map<std::string, std::string>* hlo_module_info) {
+    absl::flat_hash_map<std::string, std::string>* hlo_module_info,
+    FingerprintedHloModules* hlo_modules) {
   // Iterate events.
   xplane.ForEachEventMetadata([&](const XEventMetadataVisitor& event_metadata) {
     event_metadata.ForEachStat([&](const XStatVisitor& stat) {
@@ -162,12 +167,18 @@ void GetXPlaneHloModuleInfo(
                                    stat.BytesValue().size())) {
         const xla::HloModuleProto& hlo_module_proto = hlo_proto.hlo_module();
 
+        std::unique_ptr<xla::HloModule> hlo_module =
+            CreateModuleFromProto(hlo_module_proto);
+        if (hlo_module == nullptr) {
+          return;
+        }
         std::optional<std::string> fingerprint =
-            GetHloModuleFingerprint(hlo_module_proto);
+            GetHloModuleFingerprint(*hlo_module);
         if (fingerprint.has_value()) {
           std::string key_with_id = tsl::profiler::HloModuleNameWithProgramId(
               hlo_module_proto.name(), hlo_module_proto.id());
           (*hlo_module_info)[key_with_id] = fingerprint.value();
+          hlo_modules->push_back({*fingerprint, std::move(hlo_module)});
         }
       }
     });
@@ -207,13 +218,14 @@ absl::Status ConvertXplaneToProfiledInstructionsProto(
         profiled_instructions_proto) {
   absl::flat_hash_map<std::string, HloLatencyInfo> hlo_latency_info;
   absl::flat_hash_map<std::string, std::string> hlo_module_info;
+  FingerprintedHloModules hlo_modules;
   // Iterate through each host.
   for (const XSpace& xspace : xspaces) {
     const XPlane* metadata_plane =
         FindPlaneWithName(xspace, tsl::profiler::kMetadataPlaneName);
     if (metadata_plane != nullptr) {
       XPlaneVisitor xplane = CreateTfXPlaneVisitor(metadata_plane);
-      GetXPlaneHloModuleInfo(xplane, &hlo_module_info);
+      GetXPlaneHloModuleInfo(xplane, &hlo_module_info, &hlo_modules);
     }
     std::vector<const XPlane*> device_planes =
         FindPlanesWithPrefix(xspace, tsl::profiler::kGpuPlanePrefix);
@@ -234,6 +246,31 @@ absl::Status ConvertXplaneToProfiledInstructionsProto(
     }
   }
 
+  // Also key the durations of fusions by their fingerprint, which identifies
+  // them in later compilations regardless of the instruction names.
+  absl::flat_hash_map<std::string, HloLatencyInfo> fusion_latency_info;
+  for (const auto& [fingerprint, hlo_module] : hlo_modules) {
+    for (const HloComputation* computation :
+         hlo_module->MakeNonfusionComputations()) {
+      for (const HloInstruction* instr : computation->instructions()) {
+        if (instr->opcode() != HloOpcode::kFusion) {
+          continue;
+        }
+        auto it = hlo_latency_info.find(
+            absl::StrCat(fingerprint, kCostNameSep, instr->name()));
+        if (it == hlo_latency_info.end()) {
+          continue;
+        }
+        std::vector<double>& durations =
+            fusion_latency_info[GetFusionCostName(*instr)].durations;
+        durations.insert(durations.end(), it->second.durations.begin(),
+                         it->second.durations.end());
+      }
+    }
+  }
+  hlo_latency_info.insert(fusion_latency_info.begin(),
+                          fusion_latency_info.end());
+
   // Get the mean duration for each hlo and store into the proto.
   for (const auto& iter : hlo_latency_info) {
     auto* cost = profiled_instructions_proto->add_costs();
@@ -35,7 +35,9 @@ struct HloLatencyInfo {
 };
 
 // Convert XSpace to ProfiledInstructionsProto. This function will aggregate
-// all the xplane.pb info into ProfiledInstructionsProto.
+// all the xplane.pb info into ProfiledInstructionsProto. The runtimes of
+// fusions are additionally stored under their fusion cost name, see
+// `GetFusionCostName`.
 absl::Status ConvertXplaneToProfiledInstructionsProto(
     std::vector<tensorflow::profiler::XSpace> xspaces,
     tensorflow::profiler::ProfiledInstructionsProto*
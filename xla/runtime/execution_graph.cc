@@ -17,6 +17,7 @@ limitations under the License.
 
 #include <sys/stat.h>
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <limits>
@@ -30,6 +31,7 @@ limitations under the License.
 #include "absl/base/thread_annotations.h"
 #include "absl/log/check.h"
 #include "absl/log/log.h"
+#include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_format.h"
 #include "absl/synchronization/mutex.h"
@@ -374,6 +376,37 @@ int64_t ExecutionGraph::RunTransitiveReductionAndUpdatePriorities(
   return num_erased_edges;
 }
 
+absl::Status ExecutionGraph::UpdatePrioritiesFromCosts(
+    absl::Span<const int64_t> costs) {
+  if (costs.size() != nodes_defs_.size()) {
+    return InvalidArgument(
+        "Number of costs (%d) must match the number of nodes (%d)",
+        costs.size(), nodes_defs_.size());
+  }
+
+  if (absl::c_any_of(costs, [](int64_t cost) { return cost < 0; })) {
+    return InvalidArgument("Node costs must be non-negative");
+  }
+
+  // Nodes are ordered consistently with the original operations sequence and
+  // all edges point from nodes with smaller id to nodes with larger id, so a
+  // single pass in reverse order visits all out nodes before the node itself.
+  for (int64_t i = nodes_defs_.size() - 1; i >= 0; --i) {
+    NodeDef& node_def = nodes_defs_[i];
+
+    int64_t max_out_priority = 0;
+    for (const NodeEdge& out_edge : node_def.out_edges) {
+      DCHECK_GT(out_edge.id, i) << "Out edges must point to larger node ids";
+      max_out_priority =
+          std::max(max_out_priority, nodes_defs_[out_edge.id].priority);
+    }
+
+    node_def.priority = costs[i] + max_out_priority;
+  }
+
+  return absl::OkStatus();
+}
+
 // Execution graph renderer registration logic
 
 absl::Mutex renderer_mu(absl::kConstInit);
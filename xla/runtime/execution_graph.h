@@ -29,6 +29,7 @@ limitations under the License.
 #include "absl/algorithm/container.h"
 #include "absl/container/inlined_vector.h"
 #include "absl/log/check.h"
+#include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/span.h"
@@ -249,6 +250,18 @@ class ExecutionGraph {
 
   bool is_sequential() const { return is_sequential_; }
 
+  // Replaces node priorities with the cost of the longest (critical) path from
+  // the node to any of the sink nodes, where the cost of a path is the sum of
+  // `costs` of all nodes on the path, including the node itself. Costs are
+  // indexed by node id and can be in arbitrary units (i.e. estimated flops or
+  // measured nanoseconds), as long as they are consistent across all nodes.
+  //
+  // When there are more ready nodes than available workers, executing nodes
+  // on the critical path first minimizes the overall execution time, because
+  // expensive operations do not wait behind cheap operations that do not
+  // unlock any more work.
+  absl::Status UpdatePrioritiesFromCosts(absl::Span<const int64_t> costs);
+
  private:
   // We store all `in_edges` and `out_edges` referenced by the `NodeDef` inside
   // large vectors to optimize for data locality on a hot path.
@@ -15,15 +15,18 @@ limitations under the License.
 
 #include "xla/runtime/execution_graph.h"
 
+#include <cstdint>
 #include <memory>
 #include <utility>
 #include <vector>
 
+#include "absl/status/status.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/span.h"
 #include "xla/runtime/buffer_use.h"
 #include "xla/runtime/resource_use.h"
 #include "xla/service/buffer_assignment.h"
+#include "xla/tsl/lib/core/status_test_util.h"
 #include "xla/tsl/platform/statusor.h"
 #include "xla/tsl/platform/test.h"
 
@@ -97,6 +100,47 @@ TEST(ExecutionGraphTest, DependencyOrdering) {
   EXPECT_EQ(execution_graph.priority(2), 0);
 }
 
+TEST(ExecutionGraphTest, CriticalPathPriorities) {
+  BufferAllocation alloc(/*index=*/0, /*size=*/80, /*color=*/0);
+
+  BufferAllocation::Slice slice0(&alloc, /*offset=*/0, /*size=*/40);
+  BufferAllocation::Slice slice1(&alloc, /*offset=*/40, /*size=*/40);
+  BufferAllocation::Slice slice2(&alloc, /*offset=*/20, /*size=*/40);
+
+  // Two independent operations followed by an operation that depends on both.
+  std::vector<Operation> operations;
+  operations.push_back(
+      Operation({BufferUse::Read(slice0), BufferUse::Write(slice0)}));
+  operations.push_back(
+      Operation({BufferUse::Read(slice1), BufferUse::Write(slice1)}));
+  operations.push_back(
+      Operation({BufferUse::Read(slice2), BufferUse::Write(slice2)}));
+
+  TF_ASSERT_OK_AND_ASSIGN(ExecutionGraph execution_graph,
+                          ExecutionGraph::Create<Operation>(operations));
+
+  // Both source nodes unlock the same number of nodes.
+  EXPECT_EQ(execution_graph.priority(0), 1);
+  EXPECT_EQ(execution_graph.priority(1), 1);
+
+  // With costs, the expensive source node is on the critical path.
+  std::vector<int64_t> costs = {10, 100, 5};
+  TF_ASSERT_OK(execution_graph.UpdatePrioritiesFromCosts(costs));
+
+  EXPECT_EQ(execution_graph.priority(0), 15);
+  EXPECT_EQ(execution_graph.priority(1), 105);
+  EXPECT_EQ(execution_graph.priority(2), 5);
+
+  // Costs must match the number of nodes and must be non-negative.
+  std::vector<int64_t> too_few_costs = {1, 2};
+  EXPECT_EQ(execution_graph.UpdatePrioritiesFromCosts(too_few_costs).code(),
+            absl::StatusCode::kInvalidArgument);
+
+  std::vector<int64_t> negative_costs = {1, -2, 3};
+  EXPECT_EQ(execution_graph.UpdatePrioritiesFromCosts(negative_costs).code(),
+            absl::StatusCode::kInvalidArgument);
+}
+
 TEST(ExecutionGraphTest, SequentialOrdering) {
   BufferAllocation alloc(/*index=*/0, /*size=*/80, /*color=*/0);
   BufferAllocation::Slice slice(&alloc, /*offset=*/0, /*size=*/40);
@@ -71,8 +71,10 @@ absl::Status SerializeHloUnoptimizedSnapshot(
   return absl::OkStatus();
 }
 
-absl::StatusOr<HloUnoptimizedSnapshot> DeserializeHloUnoptimizedSnapshot(
-    tsl::protobuf::io::ZeroCopyInputStream* zero_copy_input_stream) {
+absl::StatusOr<HloUnoptimizedSnapshot>
+DeserializeHloUnoptimizedSnapshotStreaming(
+    tsl::protobuf::io::ZeroCopyInputStream* zero_copy_input_stream,
+    HloSnapshotArgumentCallback argument_callback) {
   HloUnoptimizedSnapshot metadata;
   {
     tsl::protobuf::io::CodedInputStream input_stream(zero_copy_input_stream);
@@ -85,20 +87,20 @@ absl::StatusOr<HloUnoptimizedSnapshot> DeserializeHloUnoptimizedSnapshot(
     }
   }
 
-  HloUnoptimizedSnapshot snapshot_with_args;
   if (metadata.version() > kMaxSupportedSnapshotVersion) {
     return absl::InternalError(
         absl::StrCat("Unsupported snapshot version: ", metadata.version()));
   }
 
-  *snapshot_with_args.mutable_hlo_module() =
-      std::move(*metadata.mutable_hlo_module());
-
-  // Deserialize literals
+  // Deserialize literals one at a time and hand them over to the callback.
   CodedStreamInputIterator input_it_end;
-  for (const auto& partition : metadata.partitions()) {
-    HloInputs* partition_metadata = snapshot_with_args.add_partitions();
-    for (const auto& descriptor : partition.arguments_descriptors()) {
+  for (int partition_index = 0; partition_index < metadata.partitions_size();
+       ++partition_index) {
+    const HloInputs& partition = metadata.partitions(partition_index);
+    for (int argument_index = 0;
+         argument_index < partition.arguments_descriptors_size();
+         ++argument_index) {
+      const auto& descriptor = partition.arguments_descriptors(argument_index);
       tsl::protobuf::io::CodedInputStream input_stream(zero_copy_input_stream);
 
       if (descriptor.version() > kMaxSupportedLiteralVersion) {
@@ -115,8 +117,8 @@ absl::StatusOr<HloUnoptimizedSnapshot> DeserializeHloUnoptimizedSnapshot(
             "Failed to deserialize argument with size ", argument_size, ": ",
             literal_or_status.status().message()));
       }
-      *partition_metadata->add_arguments() =
-          literal_or_status.value().ToProto();
+      TF_RETURN_IF_ERROR(argument_callback(partition_index, argument_index,
+                                           *std::move(literal_or_status)));
     }
   }
   tsl::protobuf::io::CodedInputStream input_stream(zero_copy_input_stream);
@@ -124,6 +126,32 @@ absl::StatusOr<HloUnoptimizedSnapshot> DeserializeHloUnoptimizedSnapshot(
     return absl::InternalError("Unexpected extra data in the stream");
   }
 
+  return metadata;
+}
+
+absl::StatusOr<HloUnoptimizedSnapshot> DeserializeHloUnoptimizedSnapshot(
+    tsl::protobuf::io::ZeroCopyInputStream* zero_copy_input_stream) {
+  HloUnoptimizedSnapshot snapshot_with_args;
+  TF_ASSIGN_OR_RETURN(
+      HloUnoptimizedSnapshot metadata,
+      DeserializeHloUnoptimizedSnapshotStreaming(
+          zero_copy_input_stream,
+          [&](int partition_index, int argument_index,
+              Literal argument) -> absl::Status {
+            while (snapshot_with_args.partitions_size() <= partition_index) {
+              snapshot_with_args.add_partitions();
+            }
+            *snapshot_with_args.mutable_partitions(partition_index)
+                 ->add_arguments() = argument.ToProto();
+            return absl::OkStatus();
+          }));
+
+  *snapshot_with_args.mutable_hlo_module() =
+      std::move(*metadata.mutable_hlo_module());
+  // Partitions without arguments never reach the callback.
+  while (snapshot_with_args.partitions_size() < metadata.partitions_size()) {
+    snapshot_with_args.add_partitions();
+  }
   return snapshot_with_args;
 }
 
@@ -16,8 +16,10 @@ limitations under the License.
 #ifndef XLA_RUNTIME_LARGE_HLO_SNAPSHOT_SERIALIZATION_SERIALIZATION_H_
 #define XLA_RUNTIME_LARGE_HLO_SNAPSHOT_SERIALIZATION_SERIALIZATION_H_
 
+#include "absl/functional/function_ref.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "xla/literal.h"
 #include "xla/service/hlo.pb.h"
 #include "tsl/platform/protobuf.h"
 
@@ -40,6 +42,26 @@ absl::Status SerializeHloUnoptimizedSnapshot(
 // be in the format produced by `SerializeHloUnoptimizedSnapshot`.
 absl::StatusOr<HloUnoptimizedSnapshot> DeserializeHloUnoptimizedSnapshot(
     tsl::protobuf::io::ZeroCopyInputStream* zero_copy_input_stream);
+
+// Callback invoked for every argument of a snapshot in the order in which the
+// arguments are stored in the stream.
+using HloSnapshotArgumentCallback = absl::FunctionRef<absl::Status(
+    int partition_index, int argument_index, Literal argument)>;
+
+// Streaming deserialization of the HLO unoptimized snapshot. Unlike
+// `DeserializeHloUnoptimizedSnapshot`, arguments are not accumulated in the
+// returned proto: each argument is deserialized directly from the stream and
+// handed over to `argument_callback` before the next one is read, so that the
+// deserializer itself never holds more than one argument in memory. Callers
+// can transfer the argument to a device buffer and drop the literal to keep
+// peak host memory close to the size of the largest argument.
+//
+// Returns the snapshot metadata: the HLO module and the argument descriptors
+// of every partition.
+absl::StatusOr<HloUnoptimizedSnapshot>
+DeserializeHloUnoptimizedSnapshotStreaming(
+    tsl::protobuf::io::ZeroCopyInputStream* zero_copy_input_stream,
+    HloSnapshotArgumentCallback argument_callback);
 }  // namespace xla
 
 #endif  // XLA_RUNTIME_LARGE_HLO_SNAPSHOT_SERIALIZATION_SERIALIZATION_H_
@@ -16,10 +16,12 @@ limitations under the License.
 #include "xla/runtime/large_hlo_snapshot_serialization/serialization.h"
 
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/types/span.h"
 #include "xla/literal.h"
@@ -159,5 +161,59 @@ TEST(LargeHloSnapshotSerializationTest,
   EXPECT_THAT(deserialized_snapshot, EqualsProto(snapshot));
 }
 
+TEST(LargeHloSnapshotSerializationTest, DeserializeStreaming) {
+  HloUnoptimizedSnapshot snapshot = CreateSnapshot();
+
+  std::string serialized_snapshot;
+  tsl::protobuf::io::StringOutputStream output_stream(&serialized_snapshot);
+  TF_ASSERT_OK(SerializeHloUnoptimizedSnapshot(snapshot, &output_stream));
+
+  std::vector<std::vector<Literal>> arguments(snapshot.partitions_size());
+  tsl::protobuf::io::ArrayInputStream input_stream(serialized_snapshot.data(),
+                                                   serialized_snapshot.size());
+  TF_ASSERT_OK_AND_ASSIGN(
+      HloUnoptimizedSnapshot metadata,
+      DeserializeHloUnoptimizedSnapshotStreaming(
+          &input_stream,
+          [&](int partition_index, int argument_index,
+              Literal argument) -> absl::Status {
+            EXPECT_EQ(arguments[partition_index].size(), argument_index);
+            arguments[partition_index].push_back(std::move(argument));
+            return absl::OkStatus();
+          }));
+
+  EXPECT_THAT(metadata.hlo_module(), EqualsProto(snapshot.hlo_module()));
+  ASSERT_EQ(metadata.partitions_size(), snapshot.partitions_size());
+  for (int i = 0; i < snapshot.partitions_size(); ++i) {
+    EXPECT_EQ(metadata.partitions(i).arguments_size(), 0);
+    ASSERT_EQ(arguments[i].size(), snapshot.partitions(i).arguments_size());
+    for (int j = 0; j < snapshot.partitions(i).arguments_size(); ++j) {
+      EXPECT_THAT(arguments[i][j].ToProto(),
+                  EqualsProto(snapshot.partitions(i).arguments(j)));
+    }
+  }
+}
+
+TEST(LargeHloSnapshotSerializationTest, DeserializeStreamingCallbackError) {
+  HloUnoptimizedSnapshot snapshot = CreateSnapshot();
+
+  std::string serialized_snapshot;
+  tsl::protobuf::io::StringOutputStream output_stream(&serialized_snapshot);
+  TF_ASSERT_OK(SerializeHloUnoptimizedSnapshot(snapshot, &output_stream));
+
+  int num_calls = 0;
+  tsl::protobuf::io::ArrayInputStream input_stream(serialized_snapshot.data(),
+                                                   serialized_snapshot.size());
+  auto status = DeserializeHloUnoptimizedSnapshotStreaming(
+                    &input_stream,
+                    [&](int, int, Literal) -> absl::Status {
+                      ++num_calls;
+                      return absl::InternalError("Callback failed");
+                    })
+                    .status();
+  EXPECT_THAT(status.message(), "Callback failed");
+  EXPECT_EQ(num_calls, 1);
+}
+
 }  // namespace
 }  // namespace xla
@@ -27,6 +27,7 @@ limitations under the License.
 #include <ostream>
 #include <set>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -63,10 +64,13 @@ limitations under the License.
 #include "xla/shape.h"
 #include "xla/shape_util.h"
 #include "xla/status_macros.h"
+#include "xla/tsl/platform/env.h"
 #include "xla/tsl/platform/errors.h"
 #include "xla/tsl/platform/logging.h"
 #include "xla/tsl/platform/statusor.h"
+#include "xla/tsl/platform/threadpool.h"
 #include "xla/util.h"
+#include "xla/xla_data.pb.h"
 #include "tsl/platform/numbers.h"
 
 namespace xla {
@@ -1111,6 +1115,104 @@ std::string BufferAssignment::ToVerboseString(
   return output;
 }
 
+buffer_assignment::PeakMemoryReportProto BufferAssignment::PeakMemoryReport(
+    size_t max_buffers_to_show) const {
+  const auto& buffer_live_ranges = hlo_live_range().buffer_live_ranges();
+
+  // A slice of an allocation, live over the union of the live ranges of the
+  // values assigned to it. `value` is the earliest of them.
+  struct LiveSlice {
+    const HloValue* value;
+    BufferAllocation::Index allocation_index;
+    int64_t offset;
+    int64_t size;
+    int64_t start;
+    int64_t end;
+  };
+  std::vector<LiveSlice> slices;
+  absl::flat_hash_map<std::tuple<BufferAllocation::Index, int64_t, int64_t>,
+                      size_t>
+      slice_indices;
+  int64_t end_time = hlo_live_range().schedule_end_time();
+  for (const BufferAllocation& allocation : allocations_) {
+    if (allocation.is_thread_local()) {
+      continue;
+    }
+    for (const auto& [value, offset_size] : allocation.assigned_buffers()) {
+      auto live_range = buffer_live_ranges.find(value);
+      if (live_range == buffer_live_ranges.end()) {
+        continue;
+      }
+      const HloLiveRange::TimeBound& bound = live_range->second;
+      end_time = std::max(end_time, bound.end);
+      auto [it, inserted] = slice_indices.try_emplace(
+          std::make_tuple(allocation.index(), offset_size.offset,
+                          offset_size.size),
+          slices.size());
+      if (inserted) {
+        slices.push_back({value, allocation.index(), offset_size.offset,
+                          offset_size.size, bound.start, bound.end});
+        continue;
+      }
+      LiveSlice& slice = slices[it->second];
+      if (std::make_pair(bound.start, value->id()) <
+          std::make_pair(slice.start, slice.value->id())) {
+        slice.value = value;
+        slice.start = bound.start;
+      }
+      slice.end = std::max(slice.end, bound.end);
+    }
+  }
+
+  buffer_assignment::PeakMemoryReportProto report;
+  std::vector<int64_t> deltas(end_time + 2, 0);
+  for (const LiveSlice& slice : slices) {
+    deltas[slice.start] += slice.size;
+    deltas[slice.end + 1] -= slice.size;
+  }
+  int64_t live_bytes = 0;
+  for (int64_t time = 0; time <= end_time; ++time) {
+    live_bytes += deltas[time];
+    report.add_live_bytes(live_bytes);
+    if (live_bytes > report.peak_bytes()) {
+      report.set_peak_bytes(live_bytes);
+      report.set_peak_time(time);
+    }
+  }
+
+  std::vector<const LiveSlice*> peak_slices;
+  for (const LiveSlice& slice : slices) {
+    if (slice.start <= report.peak_time() && report.peak_time() <= slice.end) {
+      peak_slices.push_back(&slice);
+    }
+  }
+  absl::c_sort(peak_slices, [](const LiveSlice* a, const LiveSlice* b) {
+    return std::make_tuple(-a->size, a->allocation_index, a->offset) <
+           std::make_tuple(-b->size, b->allocation_index, b->offset);
+  });
+  if (peak_slices.size() > max_buffers_to_show) {
+    peak_slices.resize(max_buffers_to_show);
+  }
+  for (const LiveSlice* slice : peak_slices) {
+    const HloInstruction* instruction = slice->value->instruction();
+    const OpMetadata& metadata = instruction->metadata();
+    buffer_assignment::PeakMemoryReportProto::Buffer* buffer =
+        report.add_peak_buffers();
+    buffer->set_instruction_name(instruction->name());
+    buffer->set_shape(slice->value->shape().ToString(/*print_layout=*/true));
+    buffer->set_size_bytes(slice->size);
+    buffer->set_allocation_index(slice->allocation_index);
+    buffer->set_offset(slice->offset);
+    buffer->set_start_time(slice->start);
+    buffer->set_end_time(slice->end);
+    buffer->set_op_type(metadata.op_type());
+    buffer->set_op_name(metadata.op_name());
+    buffer->set_source_file(metadata.source_file());
+    buffer->set_source_line(metadata.source_line());
+  }
+  return report;
+}
+
 std::string BufferAssignment::BufferInfoString() const {
   std::string binfo;
   // Columns in buffer information:
@@ -1880,8 +1982,14 @@ absl::Status BufferAssigner::AssignBuffersWithSequentialOrdering(
         std::make_unique<ConstrainedGlobalDecreasingSizeBestFitHeap>(
             assignment->multiheap_size_constraint_per_heap(), alignment,
             GlobalDecreasingSizeBestFitHeap<HloValue>::kTemporal));
+    // The spatial and temporal orderings are independent, so let them run
+    // concurrently: for large modules each one takes a significant amount of
+    // compile time.
+    static auto* thread_pool = new tsl::thread::ThreadPool(
+        tsl::Env::Default(), "buffer_assignment_heap_simulation",
+        algorithms->size());
     return std::make_unique<ChooseBestHeapAlgorithm<HloValue>>(
-        std::move(algorithms));
+        std::move(algorithms), thread_pool);
   };
 
   if (run_whole_module_heap_simulation) {
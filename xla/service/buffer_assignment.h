@@ -516,6 +516,13 @@ class BufferAssignment {
   // every buffer associated with each allocation.
   std::string ToVerboseString(size_t max_buffers_to_show) const;
 
+  // Returns the bytes live at each logical time of the flattened schedule and
+  // the `max_buffers_to_show` largest buffers live at the peak, with their op
+  // metadata. Values assigned to the same slice are counted once, over the
+  // union of their live ranges. Thread-local allocations are skipped.
+  buffer_assignment::PeakMemoryReportProto PeakMemoryReport(
+      size_t max_buffers_to_show = 20) const;
+
   // Is in use by tpu compiler to dump the buffer info.
   std::string BufferInfoString() const;
 
@@ -3308,6 +3308,44 @@ ENTRY %test_module {
   EXPECT_EQ(buffer_info_str, reference_str);
 }
 
+TEST_F(BufferAssignmentTest, PeakMemoryReport) {
+  absl::string_view module_str = R"(
+HloModule test_module
+
+ENTRY %test_module {
+  %param.0 = s32[1024]{0} parameter(0)
+  %param.1 = s32[1024]{0} parameter(1)
+  %mul = s32[1024]{0} multiply(%param.0, %param.1)
+  %add = s32[1024]{0} add(%mul, %param.0)
+  ROOT %bcast = s32[1024,1024]{1,0} broadcast(s32[1024] %add), dimensions={0}
+})";
+
+  TF_ASSERT_OK_AND_ASSIGN(auto m, ParseAndReturnVerifiedModule(module_str));
+  HloInstruction* const param0 = FindInstruction(m.get(), "param.0");
+  HloInstruction* const param1 = FindInstruction(m.get(), "param.1");
+  HloInstruction* const mul = FindInstruction(m.get(), "mul");
+  HloInstruction* const add = FindInstruction(m.get(), "add");
+  HloInstruction* const bcast = FindInstruction(m.get(), "bcast");
+  auto assignment = RunBufferAssignmentWithInstructionSequence(
+      m.get(), {param0, param1, mul, add, bcast});
+  buffer_assignment::PeakMemoryReportProto report =
+      assignment->PeakMemoryReport(/*max_buffers_to_show=*/2);
+
+  ASSERT_EQ(report.live_bytes_size(), 6);
+  EXPECT_EQ(report.live_bytes(0), 4096);
+  EXPECT_EQ(report.live_bytes(1), 2 * 4096);
+  EXPECT_EQ(report.live_bytes(5), 2 * 4096 + 4194304);
+  // Both parameters, `add` and `bcast` are live while `bcast` runs.
+  EXPECT_EQ(report.peak_time(), 4);
+  EXPECT_EQ(report.peak_bytes(), 3 * 4096 + 4194304);
+  ASSERT_EQ(report.peak_buffers_size(), 2);
+  EXPECT_EQ(report.peak_buffers(0).instruction_name(), "bcast");
+  EXPECT_EQ(report.peak_buffers(0).size_bytes(), 4194304);
+  EXPECT_EQ(report.peak_buffers(0).start_time(), 4);
+  EXPECT_EQ(report.peak_buffers(0).end_time(), 5);
+  EXPECT_EQ(report.peak_buffers(1).size_bytes(), 4096);
+}
+
 TEST_F(WhileBufferAssignmentTest, WhileLoopsInterferingResultRange) {
   auto module = CreateNewVerifiedModule();
   auto builder = HloComputation::Builder(TestName());
@@ -1443,6 +1443,11 @@ absl::Status CopyInsertion::RemoveUnnecessaryCopies(
   VLOG(6) << "Copy removal analyzing module (" << module->name()
           << ") with instruction count = " << module->instruction_count();
   BoundNonLinearCompilerAnalysis allowance(module, name(), 10);
+  // The number of elided copies when each copy last failed to be elided. Later
+  // iterations only retry a copy if one of its value lists changed since, as
+  // retrying it otherwise redoes the same, possibly quadratic, live range
+  // analysis with the same result.
+  absl::flat_hash_map<const HloInstruction*, int64_t> failed_at;
   while (changed) {
     CHECK_LE(++num_iterations, num_existing_copies);
     changed = false;
@@ -1455,6 +1460,12 @@ absl::Status CopyInsertion::RemoveUnnecessaryCopies(
         if (instruction->opcode() != HloOpcode::kCopy) {
           continue;
         }
+        auto failed = failed_at.find(instruction);
+        if (failed != failed_at.end() &&
+            !copy_remover.ValueListsChangedSince(instruction,
+                                                 failed->second)) {
+          continue;
+        }
 
         // The region_analysis_cost_now is always set to
         // use_region_based_live_range_analysis_ if it is < 0, in which case the
@@ -1474,6 +1485,8 @@ absl::Status CopyInsertion::RemoveUnnecessaryCopies(
           VLOG(3) << "Copy removed successfully: " << instruction->ToString();
           XLA_VLOG_LINES(
               6, absl::StrCat("   Resulting Module: ", module->ToString()));
+        } else {
+          failed_at[instruction] = copy_remover.num_elided_copies();
         }
         if (allowance.ContinueAnalysis() && region_analysis_cost_now > 0) {
           VLOG(6) << "Copy Insertion analyzing module cost: "
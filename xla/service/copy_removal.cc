@@ -1169,14 +1169,34 @@ bool CopyRemover::TryElideCopy(
     return false;
   }
 
+  // RemoveCopyValue deletes the copy's entry in copy_map_, so keep a node of
+  // the merged list to mark it as changed.
+  ValueNode* merged = copy_node.src;
   RemoveCopyValue(copy_node.dest);
 
+  ++num_elided_copies_;
+  ValueNode* node = merged;
+  do {
+    node->last_changed = num_elided_copies_;
+    node = node->next;
+  } while (node != merged);
+
   XLA_VLOG_LINES(4, ToString());
   TF_DCHECK_OK(Verify());
   VLOG(3) << "TryElideCopy succeeded for: " << copy->name();
   return true;
 }
 
+bool CopyRemover::ValueListsChangedSince(const HloInstruction* copy,
+                                         int64_t num_elided_copies) const {
+  auto it = copy_map_.find(copy);
+  if (it == copy_map_.end()) {
+    return false;
+  }
+  return it->second.src->last_changed > num_elided_copies ||
+         it->second.dest->last_changed > num_elided_copies;
+}
+
 // Delete the given ValueNode associated with a elided kCopy
 // instruction. This should be called after splicing the value lists of the
 // source and destination buffers together.
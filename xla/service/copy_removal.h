@@ -396,6 +396,10 @@ class CopyRemover {
     // these values are never null for elements in the list.
     ValueNode* prev = nullptr;
     ValueNode* next = nullptr;
+
+    // The value of num_elided_copies() right after the last copy elision
+    // that changed the list holding this node, or 0 if it never changed.
+    int64_t last_changed = 0;
   };
 
   CopyRemover(const HloModule& module, const HloAliasAnalysis& alias_analysis,
@@ -437,6 +441,16 @@ class CopyRemover {
   bool TryElideCopy(const HloInstruction* copy, int64_t* region_analysis_limit,
                     bool insert_post_scheduling_control_dependencies);
 
+  // Returns the number of copies elided so far.
+  int64_t num_elided_copies() const { return num_elided_copies_; }
+
+  // Returns whether the value lists of the source or destination buffer of
+  // 'copy' changed after 'num_elided_copies' copies were elided. TryElideCopy
+  // only depends on these lists, so a copy that could not be elided at that
+  // point can not be elided now either unless this returns true.
+  bool ValueListsChangedSince(const HloInstruction* copy,
+                              int64_t num_elided_copies) const;
+
   // Delete the given ValueNode associated with a elided kCopy
   // instruction. This should be called after splicing the value lists of the
   // source and destination buffers together.
@@ -526,6 +540,8 @@ class CopyRemover {
     ValueNode* dest = nullptr;
   };
   absl::flat_hash_map<const HloInstruction*, CopyNodes> copy_map_;
+
+  int64_t num_elided_copies_ = 0;
 };
 };  // namespace xla
 
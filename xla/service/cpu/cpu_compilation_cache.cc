@@ -0,0 +1,114 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/service/cpu/cpu_compilation_cache.h"
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/escaping.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/time/clock.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/SHA256.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/tsl/platform/env.h"
+#include "xla/tsl/platform/errors.h"
+#include "xla/tsl/platform/logging.h"
+#include "xla/xla.pb.h"
+#include "tsl/platform/path.h"
+#include "tsl/platform/protobuf.h"
+
+namespace xla::cpu {
+
+// Bump this version when the serialized executable format changes in a way
+// that makes old cache entries unusable.
+static constexpr absl::string_view kCacheVersion = "xla_cpu_cache_v1";
+
+CpuCompilationCache::CpuCompilationCache(std::string cache_dir)
+    : cache_dir_(std::move(cache_dir)) {}
+
+// Serializes a protobuf message deterministically, so that the same message
+// always produces the same cache key.
+static std::string SerializeDeterministic(const tsl::protobuf::Message& msg) {
+  std::string serialized;
+  tsl::protobuf::io::StringOutputStream stream(&serialized);
+  tsl::protobuf::io::CodedOutputStream output(&stream);
+  output.SetSerializationDeterministic(true);
+  msg.SerializeToCodedStream(&output);
+  output.Trim();
+  return serialized;
+}
+
+std::string CpuCompilationCache::Key(const HloModule& module,
+                                     absl::string_view target) {
+  // Cache directory doesn't affect the compiled executable.
+  DebugOptions debug_options = module.config().debug_options();
+  debug_options.clear_xla_cpu_persistent_cache_dir();
+
+  llvm::SHA256 sha256;
+  sha256.update(llvm::StringRef(kCacheVersion.data(), kCacheVersion.size()));
+  sha256.update(llvm::StringRef(target.data(), target.size()));
+  sha256.update(SerializeDeterministic(module.ToProto()));
+  sha256.update(SerializeDeterministic(debug_options));
+  std::array<uint8_t, 32> hash = sha256.final();
+
+  return absl::BytesToHexString(absl::string_view(
+      reinterpret_cast<const char*>(hash.data()), hash.size()));
+}
+
+std::string CpuCompilationCache::FilePath(absl::string_view key) const {
+  return tsl::io::JoinPath(cache_dir_, absl::StrCat(key, ".xla_cpu"));
+}
+
+absl::StatusOr<std::optional<std::string>> CpuCompilationCache::Lookup(
+    absl::string_view key) const {
+  tsl::Env* env = tsl::Env::Default();
+
+  std::string file_path = FilePath(key);
+  if (!env->FileExists(file_path).ok()) {
+    VLOG(1) << "XLA:CPU compilation cache miss: " << file_path;
+    return std::nullopt;
+  }
+
+  VLOG(1) << "XLA:CPU compilation cache hit: " << file_path;
+  std::string serialized;
+  TF_RETURN_IF_ERROR(tsl::ReadFileToString(env, file_path, &serialized));
+  return serialized;
+}
+
+absl::Status CpuCompilationCache::Insert(absl::string_view key,
+                                         absl::string_view serialized) const {
+  tsl::Env* env = tsl::Env::Default();
+  TF_RETURN_IF_ERROR(env->RecursivelyCreateDir(cache_dir_));
+
+  // Rename trick: write to a temporary file, then rename it to the final file
+  // to avoid reading incomplete files from concurrent compilations.
+  std::string tmp_file_path = tsl::io::JoinPath(
+      cache_dir_, absl::StrCat("tmp_", key, "_", absl::GetCurrentTimeNanos(),
+                               "_", env->GetCurrentThreadId()));
+
+  VLOG(1) << "Write XLA:CPU compilation cache entry: " << FilePath(key);
+  TF_RETURN_IF_ERROR(tsl::WriteStringToFile(env, tmp_file_path, serialized));
+  return env->RenameFile(tmp_file_path, FilePath(key));
+}
+
+}  // namespace xla::cpu
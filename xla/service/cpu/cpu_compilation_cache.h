@@ -0,0 +1,64 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_SERVICE_CPU_CPU_COMPILATION_CACHE_H_
+#define XLA_SERVICE_CPU_CPU_COMPILATION_CACHE_H_
+
+#include <optional>
+#include <string>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_module.h"
+
+namespace xla::cpu {
+
+// A persistent content-addressed cache of serialized XLA:CPU executables. Each
+// entry is a serialized AOT compilation result (thunk sequence proto together
+// with the object files) stored in a separate file in the cache directory, and
+// keyed by the hash of the optimized HLO module, its debug options and the
+// target host CPU. Cache directory can be shared between processes, and can
+// be pre-populated to warm up serving containers.
+class CpuCompilationCache {
+ public:
+  explicit CpuCompilationCache(std::string cache_dir);
+
+  // Returns a cache key for the optimized `module` compiled for the `target`
+  // (i.e. host CPU name). Cache key is safe to use as a file name.
+  static std::string Key(const HloModule& module, absl::string_view target);
+
+  // Returns a serialized executable for the given `key`, or std::nullopt if
+  // the cache doesn't have an entry for it.
+  absl::StatusOr<std::optional<std::string>> Lookup(
+      absl::string_view key) const;
+
+  // Inserts a serialized executable for the given `key` into the cache. Cache
+  // entries are written to a temporary file first and then renamed, so that
+  // concurrent readers never observe partially written entries.
+  absl::Status Insert(absl::string_view key,
+                      absl::string_view serialized) const;
+
+  absl::string_view cache_dir() const { return cache_dir_; }
+
+ private:
+  std::string FilePath(absl::string_view key) const;
+
+  std::string cache_dir_;
+};
+
+}  // namespace xla::cpu
+
+#endif  // XLA_SERVICE_CPU_CPU_COMPILATION_CACHE_H_
@@ -0,0 +1,102 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/service/cpu/cpu_compilation_cache.h"
+
+#include <memory>
+#include <optional>
+#include <string>
+
+#include <gtest/gtest.h>
+#include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/parser/hlo_parser.h"
+#include "xla/tsl/lib/core/status_test_util.h"
+#include "xla/tsl/platform/env.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/tsl/platform/test.h"
+#include "tsl/platform/path.h"
+
+namespace xla::cpu {
+namespace {
+
+constexpr absl::string_view kHlo = R"(
+  HloModule m
+  ENTRY e {
+    p0 = f32[4] parameter(0)
+    c0 = f32[4] constant({1, 2, 3, 4})
+    ROOT add = f32[4] add(p0, c0)
+  }
+)";
+
+constexpr absl::string_view kHloOtherConstant = R"(
+  HloModule m
+  ENTRY e {
+    p0 = f32[4] parameter(0)
+    c0 = f32[4] constant({4, 3, 2, 1})
+    ROOT add = f32[4] add(p0, c0)
+  }
+)";
+
+TEST(CpuCompilationCacheTest, Key) {
+  TF_ASSERT_OK_AND_ASSIGN(auto m0, ParseAndReturnUnverifiedModule(kHlo));
+  TF_ASSERT_OK_AND_ASSIGN(auto m1, ParseAndReturnUnverifiedModule(kHlo));
+  TF_ASSERT_OK_AND_ASSIGN(auto m2,
+                          ParseAndReturnUnverifiedModule(kHloOtherConstant));
+
+  std::string key = CpuCompilationCache::Key(*m0, "skylake");
+  EXPECT_EQ(key, CpuCompilationCache::Key(*m1, "skylake"));
+
+  // Constant values, target and debug options are part of the key.
+  EXPECT_NE(key, CpuCompilationCache::Key(*m2, "skylake"));
+  EXPECT_NE(key, CpuCompilationCache::Key(*m0, "znver4"));
+
+  DebugOptions debug_options = m1->config().debug_options();
+  debug_options.set_xla_cpu_enable_fast_math(
+      !debug_options.xla_cpu_enable_fast_math());
+  m1->mutable_config().set_debug_options(debug_options);
+  EXPECT_NE(key, CpuCompilationCache::Key(*m1, "skylake"));
+
+  // Cache directory is not a part of the key.
+  debug_options = m0->config().debug_options();
+  debug_options.set_xla_cpu_persistent_cache_dir("/tmp/xla_cpu_cache");
+  m0->mutable_config().set_debug_options(debug_options);
+  EXPECT_EQ(key, CpuCompilationCache::Key(*m0, "skylake"));
+}
+
+TEST(CpuCompilationCacheTest, InsertAndLookup) {
+  std::string cache_dir;
+  ASSERT_TRUE(tsl::Env::Default()->LocalTempFilename(&cache_dir));
+  CpuCompilationCache cache(cache_dir);
+
+  TF_ASSERT_OK_AND_ASSIGN(std::optional<std::string> miss,
+                          cache.Lookup("key"));
+  EXPECT_FALSE(miss.has_value());
+
+  TF_ASSERT_OK(cache.Insert("key", "serialized executable"));
+
+  TF_ASSERT_OK_AND_ASSIGN(std::optional<std::string> hit, cache.Lookup("key"));
+  ASSERT_TRUE(hit.has_value());
+  EXPECT_EQ(*hit, "serialized executable");
+
+  // Inserting the same key again overwrites the entry.
+  TF_ASSERT_OK(cache.Insert("key", "updated executable"));
+  TF_ASSERT_OK_AND_ASSIGN(hit, cache.Lookup("key"));
+  ASSERT_TRUE(hit.has_value());
+  EXPECT_EQ(*hit, "updated executable");
+}
+
+}  // namespace
+}  // namespace xla::cpu
@@ -91,6 +91,7 @@ limitations under the License.
 #include "xla/backends/cpu/codegen/target_machine_features.h"
 #include "xla/backends/cpu/constant_allocation.h"
 #include "xla/backends/cpu/runtime/function_library.h"
+#include "xla/backends/cpu/runtime/rng_bit_generator_thunk.h"
 #include "xla/backends/cpu/runtime/thunk.h"
 #include "xla/backends/cpu/runtime/thunk.pb.h"
 #include "xla/backends/cpu/runtime/thunk_proto_serdes.h"
@@ -167,6 +168,7 @@ limitations under the License.
 #include "xla/service/cpu/buffer_info_util.h"
 #include "xla/service/cpu/conv_canonicalization.h"
 #include "xla/service/cpu/cpu_aot_compilation_result.h"
+#include "xla/service/cpu/cpu_compilation_cache.h"
 #include "xla/service/cpu/cpu_executable.h"
 #include "xla/service/cpu/cpu_float_support.h"
 #include "xla/service/cpu/cpu_instruction_fusion.h"
@@ -606,7 +608,17 @@ absl::Status CpuCompiler::RunHloPassesThroughLayoutAssn(
 
   // Expand random number generation.
   pipeline.AddPass<RngExpander>();
-  pipeline.AddPass<RngBitGeneratorExpander>(RandomAlgorithm::RNG_PHILOX);
+  // The thunk runtime generates Philox random bits natively, without the
+  // intermediate arrays of the expanded HLO computation.
+  HloPredicate rng_bit_generator_filter =
+      [is_thunk_runtime](const HloInstruction* instr) {
+        return !is_thunk_runtime ||
+               !RngBitGeneratorThunk::IsSupported(
+                   Cast<HloRngBitGeneratorInstruction>(instr)->algorithm(),
+                   instr->operand(0)->shape(), instr->shape().tuple_shapes(1));
+      };
+  pipeline.AddPass<RngBitGeneratorExpander>(RandomAlgorithm::RNG_PHILOX,
+                                            rng_bit_generator_filter);
 
   // Remove zero-sized HLO from the input so that other passes don't have to
   // handle it.
@@ -912,8 +924,13 @@ absl::Status CpuCompiler::RunHloPassesAfterLayoutAssn(
     // and thread synchronization dependencies which would likely increase
     // binary size (and most AOT applications are single-threaded).
     // TODO(b/29630486) Support multi-threaded AOT.
+    //
+    // Thunk runtime launches kernel work groups with work stealing on the
+    // threads that are actually available, so we split large compute bound
+    // instructions into multiple tasks per thread for better load balancing.
     pipeline.AddPass<ParallelTaskAssigner>(
-        max_parallelism, ShapeSizeBytesFunction(), target_machine_features);
+        max_parallelism, ShapeSizeBytesFunction(), target_machine_features,
+        /*max_tasks_per_thread=*/is_thunk_runtime ? 4 : 1);
   }
   // Copy insertion should be performed immediately before IR emission to
   // avoid inserting unnecessary copies (later pass adds an instruction which
@@ -1514,8 +1531,12 @@ CpuCompiler::CompileCpuExecutable(std::unique_ptr<HloModule> module) {
     // Thunk emitter is responsible for building a Thunk sequence that will
     // resolved kernels in the compiled LLVM module and execute them together
     // with Thunks implemented as library calls (e.g. oneDNN or Eigen).
+    ThunkEmitter::Options thunk_emitter_options = {
+        /*compile_copy_as_llvm_kernel=*/false,
+        /*thread_pool=*/GetCompilationThreadPool()};
     ThunkEmitter thunk_emitter(ir_emitter2, *assignment,
-                               target_machine_features, *module);
+                               target_machine_features, *module,
+                               thunk_emitter_options);
     TF_ASSIGN_OR_RETURN(ThunkSequence thunks,
                         thunk_emitter.EmitEntryComputation(*module));
 
@@ -1824,16 +1845,77 @@ absl::StatusOr<std::unique_ptr<Executable>> CpuCompiler::RunBackend(
       module->config().debug_options().xla_backend_extra_options());
   llvm_ir::LLVMCommandLineOptionsLock llvm_lock(llvm_options);
 
+  // Try to load a previously compiled executable from the persistent cache.
+  // We cache only thunk-based executables, as legacy runtime is deprecated.
+  const DebugOptions& debug_options = module->config().debug_options();
+  std::optional<CpuCompilationCache> cache;
+  std::string cache_key;
+
+  if (!debug_options.xla_cpu_persistent_cache_dir().empty() &&
+      debug_options.xla_cpu_use_thunk_runtime()) {
+    cache.emplace(debug_options.xla_cpu_persistent_cache_dir());
+    cache_key = CpuCompilationCache::Key(
+        *module, absl::StrCat(llvm::sys::getHostCPUName().str(), ":",
+                              debug_options.xla_cpu_max_isa()));
+
+    absl::StatusOr<std::unique_ptr<Executable>> cached =
+        LoadFromCompilationCache(*cache, cache_key, stream_exec);
+    if (cached.ok() && *cached != nullptr) {
+      VLOG(1) << "Loaded executable from compilation cache: " << cache_key;
+      return std::move(*cached);
+    }
+    if (!cached.ok()) {
+      LOG(WARNING) << "Failed to load executable from compilation cache: "
+                   << cached.status();
+    }
+  }
+
   std::unique_ptr<CpuExecutable> cpu_executable;
   TF_ASSIGN_OR_RETURN(cpu_executable, CompileCpuExecutable(std::move(module)));
 
   cpu_executable->set_debug_info(
       cpu_executable->buffer_assignment().StatsString(
           /*report_total_fragmentation=*/true));
+
+  // Failing to update the cache is not an error, as we have a valid
+  // executable and can continue without the cache.
+  if (cache.has_value() && cpu_executable->has_thunks()) {
+    if (absl::Status status = InsertIntoCompilationCache(
+            *cache, cache_key, cpu_executable.get());
+        !status.ok()) {
+      LOG(WARNING) << "Failed to insert executable into compilation cache: "
+                   << status;
+    }
+  }
+
   VLOG(1) << "Compilation finished";
   return std::unique_ptr<Executable>(std::move(cpu_executable));
 }
 
+absl::StatusOr<std::unique_ptr<Executable>>
+CpuCompiler::LoadFromCompilationCache(const CpuCompilationCache& cache,
+                                      absl::string_view key,
+                                      const se::StreamExecutor* stream_exec) {
+  TF_ASSIGN_OR_RETURN(std::optional<std::string> serialized,
+                      cache.Lookup(key));
+  if (!serialized.has_value()) {
+    return nullptr;
+  }
+
+  TF_ASSIGN_OR_RETURN(std::unique_ptr<AotCompilationResult> aot_result,
+                      LoadAotCompilationResult(*serialized));
+  return std::move(*aot_result).LoadExecutable(this, stream_exec);
+}
+
+absl::Status CpuCompiler::InsertIntoCompilationCache(
+    const CpuCompilationCache& cache, absl::string_view key,
+    Executable* executable) const {
+  TF_ASSIGN_OR_RETURN(std::unique_ptr<AotCompilationResult> aot_result,
+                      Export(executable));
+  TF_ASSIGN_OR_RETURN(std::string serialized, aot_result->SerializeAsString());
+  return cache.Insert(key, serialized);
+}
+
 absl::StatusOr<std::vector<std::unique_ptr<AotCompilationResult>>>
 CpuCompiler::CompileAheadOfTime(std::unique_ptr<HloModuleGroup> module_group,
                                 const AotCompilationOptions& aot_options) {
@@ -2206,7 +2288,8 @@ CpuCompiler::CompileAheadOfTimeThunks(
 
   ThunkEmitter::Options thunk_emitter_options = {
       /*compile_copy_as_llvm_kernel=*/aot_options
-          .compile_copy_as_llvm_kernel()};
+          .compile_copy_as_llvm_kernel(),
+      /*thread_pool=*/GetCompilationThreadPool()};
   // Thunk emitter is responsible for building a Thunk sequence that will
   // resolved kernels in the compiled LLVM module and execute them together
   // with Thunks implemented as library calls (e.g. oneDNN or Eigen).
@@ -22,6 +22,7 @@ limitations under the License.
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
 #include "llvm/Support/CodeGen.h"
 #include "llvm/Target/TargetMachine.h"
 #include "llvm/TargetParser/Triple.h"
@@ -33,6 +34,7 @@ limitations under the License.
 #include "xla/service/buffer_assignment.h"
 #include "xla/service/compiler.h"
 #include "xla/service/cpu/cpu_aot_compilation_result.h"
+#include "xla/service/cpu/cpu_compilation_cache.h"
 #include "xla/service/cpu/executable.pb.h"
 #include "xla/service/executable.h"
 #include "xla/service/hlo.pb.h"
@@ -119,6 +121,17 @@ class CpuCompiler : public LLVMCompiler {
   absl::StatusOr<std::unique_ptr<CpuExecutable>> CompileCpuExecutable(
       std::unique_ptr<HloModule> module);
 
+  // Loads an executable from the persistent compilation cache. Returns nullptr
+  // if the cache doesn't have an executable for the given key.
+  absl::StatusOr<std::unique_ptr<Executable>> LoadFromCompilationCache(
+      const CpuCompilationCache& cache, absl::string_view key,
+      const se::StreamExecutor* stream_exec);
+
+  // Exports the executable and stores it in the persistent compilation cache.
+  absl::Status InsertIntoCompilationCache(const CpuCompilationCache& cache,
+                                          absl::string_view key,
+                                          Executable* executable) const;
+
   absl::StatusOr<std::unique_ptr<AotCompilationResult>>
   CompileAheadOfTimeLegacy(
       std::unique_ptr<HloModule> module,
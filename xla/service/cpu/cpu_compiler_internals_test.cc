@@ -22,6 +22,7 @@ limitations under the License.
 
 #include "absl/base/nullability.h"
 #include "absl/strings/string_view.h"
+#include "absl/strings/substitute.h"
 #include "llvm/IR/Constants.h"
 #include "llvm/IR/Metadata.h"
 #include "llvm/IR/Module.h"
@@ -29,8 +30,14 @@ limitations under the License.
 #include "xla/backends/cpu/codegen/emitters/cpu_fusion_emitter_config.h"
 #include "xla/hlo/ir/hlo_module.h"
 #include "xla/hlo/testlib/verified_hlo_module.h"
+#include "xla/literal.h"
+#include "xla/literal_util.h"
+#include "xla/service/cpu/cpu_executable.h"
+#include "xla/service/executable.h"
 #include "xla/service/llvm_compiler.h"
 #include "xla/tests/hlo_test_base.h"
+#include "xla/tests/literal_test_util.h"
+#include "xla/tsl/lib/core/status_test_util.h"
 #include "xla/tsl/platform/statusor.h"
 #include "xla/tsl/platform/test.h"
 
@@ -164,6 +171,80 @@ TEST_F(CpuCompilerInternalsTest, JustOneDylibWithThunks) {
                          << "one dylib is allowed.";
 }
 
+static constexpr absl::string_view kWeightsHlo = R"(
+  HloModule weights
+  ENTRY main {
+    p = f32[4] parameter(0)
+    w = f32[4] constant({$0})
+    ROOT add = f32[4] add(p, w)
+  }
+)";
+
+TEST_F(CpuCompilerInternalsTest, UpdateConstants) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<VerifiedHloModule> original,
+                          ParseAndReturnVerifiedModule(absl::Substitute(
+                              kWeightsHlo, "1.5,2.5,3.5,4.5")));
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<VerifiedHloModule> updated,
+                          ParseAndReturnVerifiedModule(absl::Substitute(
+                              kWeightsHlo, "5.5,6.5,7.5,8.5")));
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<VerifiedHloModule> module,
+                          ParseAndReturnVerifiedModule(absl::Substitute(
+                              kWeightsHlo, "1.5,2.5,3.5,4.5")));
+
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<OpaqueExecutable> executable,
+                          CreateExecutable(std::move(module),
+                                           /*run_hlo_passes=*/true));
+  TF_ASSERT_OK_AND_ASSIGN(
+      Executable * wrapped,
+      test_runner_as_hlo_runner().ExecutableFromWrapped(executable.get()));
+  auto* cpu_executable = static_cast<CpuExecutable*>(wrapped);
+  if (!cpu_executable->has_thunks()) {
+    GTEST_SKIP() << "Constants can only be updated with thunks";
+  }
+  TF_ASSERT_OK(cpu_executable->UpdateConstants(*original, *updated));
+
+  Literal arg = LiteralUtil::CreateR1<float>({1.0, 1.0, 1.0, 1.0});
+  TF_ASSERT_OK_AND_ASSIGN(
+      Literal result,
+      test_runner().ExecuteWithExecutable(executable.get(), {&arg}));
+  EXPECT_TRUE(LiteralTestUtil::Equal(
+      LiteralUtil::CreateR1<float>({6.5, 7.5, 8.5, 9.5}), result));
+}
+
+TEST_F(CpuCompilerInternalsTest, UpdateConstantsRejectsFoldedConstants) {
+  static constexpr absl::string_view kHlo = R"(
+    HloModule weights
+    ENTRY main {
+      p = f32[2,2] parameter(0)
+      w = f32[2,2] constant({$0})
+      t = f32[2,2] transpose(w), dimensions={1,0}
+      ROOT add = f32[2,2] add(p, t)
+    }
+  )";
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<VerifiedHloModule> original,
+                          ParseAndReturnVerifiedModule(
+                              absl::Substitute(kHlo, "{1.5,2.5},{3.5,4.5}")));
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<VerifiedHloModule> updated,
+                          ParseAndReturnVerifiedModule(
+                              absl::Substitute(kHlo, "{5.5,6.5},{7.5,8.5}")));
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<VerifiedHloModule> module,
+                          ParseAndReturnVerifiedModule(
+                              absl::Substitute(kHlo, "{1.5,2.5},{3.5,4.5}")));
+
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<OpaqueExecutable> executable,
+                          CreateExecutable(std::move(module),
+                                           /*run_hlo_passes=*/true));
+  TF_ASSERT_OK_AND_ASSIGN(
+      Executable * wrapped,
+      test_runner_as_hlo_runner().ExecutableFromWrapped(executable.get()));
+  auto* cpu_executable = static_cast<CpuExecutable*>(wrapped);
+  if (!cpu_executable->has_thunks()) {
+    GTEST_SKIP() << "Constants can only be updated with thunks";
+  }
+  // The transpose of the weights is folded into a new constant.
+  EXPECT_FALSE(cpu_executable->UpdateConstants(*original, *updated).ok());
+}
+
 }  // namespace
 }  // namespace cpu
 }  // namespace xla
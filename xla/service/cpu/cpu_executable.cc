@@ -20,6 +20,7 @@ limitations under the License.
 #include <stdint.h>
 
 #include <algorithm>
+#include <cstddef>
 #include <cstring>
 #include <memory>
 #include <optional>
@@ -31,6 +32,7 @@ limitations under the License.
 
 #include "absl/base/dynamic_annotations.h"
 #include "absl/base/optimization.h"
+#include "absl/container/flat_hash_map.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
@@ -39,6 +41,7 @@ limitations under the License.
 #include "absl/strings/string_view.h"
 #include "absl/types/span.h"
 #include "unsupported/Eigen/CXX11/Tensor"
+#include "xla/backends/cpu/alignment.h"
 #include "xla/backends/cpu/runtime/buffer_allocations.h"
 #include "xla/backends/cpu/runtime/function_library.h"
 #include "xla/backends/cpu/runtime/thread_pool_task_runner.h"
@@ -47,13 +50,17 @@ limitations under the License.
 #include "xla/executable_run_options.h"
 #include "xla/hlo/ir/hlo_computation.h"
 #include "xla/hlo/ir/hlo_input_output_alias_config.h"
+#include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/ir/hlo_opcode.h"
 #include "xla/literal.h"
+#include "xla/runtime/object_pool.h"
 #include "xla/service/buffer_assignment.h"
 #include "xla/service/cpu/cpu_runtime.h"
 #include "xla/service/custom_call_status.h"
 #include "xla/service/custom_call_status_internal.h"
 #include "xla/service/executable.h"
+#include "xla/service/hlo_cost_analysis.h"
 #include "xla/service/hlo_execution_profile.h"
 #include "xla/service/hlo_profile_printer_data.pb.h"
 #include "xla/service/hlo_value.h"
@@ -68,12 +75,53 @@ limitations under the License.
 #include "xla/stream_executor/device_memory_allocator.h"
 #include "xla/stream_executor/host/host_stream.h"
 #include "xla/tsl/concurrency/async_value_ref.h"
+#include "xla/tsl/platform/errors.h"
+#include "xla/tsl/platform/statusor.h"
 #include "xla/util.h"
+#include "xla/xla.pb.h"
 #include "xla/xla_data.pb.h"
+#include "tsl/platform/mem.h"
 
 namespace xla {
 namespace cpu {
 
+// Estimates costs of top-level thunks from the HLO cost analysis of the
+// instructions they were emitted for. We use a crude roofline estimate that
+// assumes a machine balance of one flop per byte, which is good enough to rank
+// compute-bound dots and convolutions above cheap memory-bound elementwise
+// kernels. Thunks without a matching instruction get a zero cost.
+static std::vector<int64_t> EstimateThunkCosts(const HloModule& module,
+                                               const ThunkSequence& thunks) {
+  std::vector<int64_t> thunk_costs(thunks.size(), 0);
+
+  HloCostAnalysis cost_analysis([](const Shape& shape) {
+    // On the cpu, opaques are pointers.
+    if (shape.IsOpaque()) {
+      return static_cast<int64_t>(sizeof(void*));
+    }
+    return ShapeUtil::ByteSizeOf(shape, sizeof(void*));
+  });
+
+  HloComputation* entry = module.entry_computation();
+  if (absl::Status status = entry->Accept(&cost_analysis); !status.ok()) {
+    LOG(WARNING) << "Failed to estimate thunk costs: " << status;
+    return thunk_costs;
+  }
+
+  for (size_t i = 0; i < thunks.size(); ++i) {
+    const HloInstruction* instr =
+        entry->GetInstructionWithName(thunks[i]->info().op_name);
+    if (instr == nullptr) continue;
+
+    int64_t flops = cost_analysis.flop_count(*instr) +
+                    cost_analysis.transcendental_count(*instr);
+    int64_t bytes = cost_analysis.bytes_accessed(*instr);
+    thunk_costs[i] = std::max<int64_t>(0, std::max(flops, bytes));
+  }
+
+  return thunk_costs;
+}
+
 absl::StatusOr<std::unique_ptr<CpuExecutable>> CpuExecutable::Create(
     std::unique_ptr<FunctionLibrary> function_library,
     std::unique_ptr<const BufferAssignment> assignment,
@@ -99,6 +147,13 @@ absl::StatusOr<std::unique_ptr<CpuExecutable>> CpuExecutable::Create(
   VLOG(1) << "compute_function_ at address "
           << reinterpret_cast<void*>(executable->compute_function_);
 
+  if (executable->module()
+          .config()
+          .debug_options()
+          .xla_cpu_enable_temp_buffer_arena()) {
+    executable->InitializeTempArenas();
+  }
+
   return executable;
 }
 
@@ -119,9 +174,24 @@ absl::StatusOr<std::unique_ptr<CpuExecutable>> CpuExecutable::Create(
 
   ThunkExecutor::Options thunk_executor_options;
   thunk_executor_options.is_nested_executor = false;
-  TF_ASSIGN_OR_RETURN(
-      executable->thunks_,
-      ThunkExecutor::Create(std::move(thunks), thunk_executor_options));
+
+  const DebugOptions& debug_options =
+      executable->module().config().debug_options();
+
+  if (debug_options.xla_cpu_enable_critical_path_scheduling()) {
+    std::vector<int64_t> thunk_costs =
+        EstimateThunkCosts(executable->module(), thunks);
+    thunk_executor_options.ready_queue_type =
+        ThunkExecutor::Options::ReadyQueueType::kPriority;
+    TF_ASSIGN_OR_RETURN(executable->thunks_,
+                        ThunkExecutor::Create(std::move(thunks),
+                                              thunk_executor_options,
+                                              thunk_costs));
+  } else {
+    TF_ASSIGN_OR_RETURN(
+        executable->thunks_,
+        ThunkExecutor::Create(std::move(thunks), thunk_executor_options));
+  }
 
   // Re-index constants by their allocation index to allow efficient lookup.
   for (auto& constant : constants) {
@@ -131,6 +201,10 @@ absl::StatusOr<std::unique_ptr<CpuExecutable>> CpuExecutable::Create(
     executable->constants_[constant.index] = std::move(constant);
   }
 
+  if (debug_options.xla_cpu_enable_temp_buffer_arena()) {
+    executable->InitializeTempArenas();
+  }
+
   return executable;
 }
 
@@ -154,6 +228,40 @@ CpuExecutable::~CpuExecutable() {
   }
 }
 
+void CpuExecutable::InitializeTempArenas() {
+  temp_arena_offsets_.resize(assignment_->Allocations().size());
+
+  for (const BufferAllocation& allocation : assignment_->Allocations()) {
+    if (allocation.is_entry_computation_parameter() ||
+        allocation.is_constant() || allocation.is_thread_local() ||
+        allocation.maybe_live_out() || allocation.size() == 0) {
+      continue;
+    }
+    temp_arena_offsets_[allocation.index()] = temp_arena_size_;
+    temp_arena_size_ += RoundUpTo<size_t>(allocation.size(), Align());
+  }
+
+  if (temp_arena_size_ == 0) {
+    return;
+  }
+
+  VLOG(2) << "Use temp arena of " << temp_arena_size_
+          << " bytes for module " << module().name();
+
+  auto create_arena = [size = temp_arena_size_]() -> absl::StatusOr<TempArena> {
+    void* data = tsl::port::AlignedMalloc(size, Align());
+    if (data == nullptr) {
+      return ResourceExhausted("Out of memory allocating %d bytes temp arena",
+                               size);
+    }
+    // See comment in MemoryForAllocation for why we mark memory initialized.
+    ABSL_ANNOTATE_MEMORY_IS_INITIALIZED(data, size);
+    return TempArena{std::unique_ptr<std::byte, TempArena::Deleter>(
+        static_cast<std::byte*>(data))};
+  };
+  temp_arenas_.emplace(std::move(create_arena));
+}
+
 static absl::StatusOr<MaybeOwningDeviceMemory> MemoryForAllocation(
     const BufferAllocation& allocation,
     absl::Span<const ExecutionInput> arguments,
@@ -198,7 +306,8 @@ static absl::StatusOr<MaybeOwningDeviceMemory> MemoryForAllocation(
 absl::StatusOr<std::vector<MaybeOwningDeviceMemory>>
 CpuExecutable::CreateBufferTable(se::DeviceMemoryAllocator* memory_allocator,
                                  int device_ordinal,
-                                 absl::Span<ExecutionInput const> arguments) {
+                                 absl::Span<ExecutionInput const> arguments,
+                                 std::byte* temp_arena) {
   std::vector<MaybeOwningDeviceMemory> buffers(
       assignment_->Allocations().size());
   VLOG(3) << "Allocating " << assignment_->Allocations().size()
@@ -206,6 +315,11 @@ CpuExecutable::CreateBufferTable(se::DeviceMemoryAllocator* memory_allocator,
   for (BufferAllocation::Index i = 0; i < assignment_->Allocations().size();
        ++i) {
     const BufferAllocation& allocation = assignment_->GetAllocation(i);
+    if (temp_arena && temp_arena_offsets_[i].has_value()) {
+      buffers[i] = MaybeOwningDeviceMemory{se::DeviceMemoryBase(
+          temp_arena + *temp_arena_offsets_[i], allocation.size())};
+      continue;
+    }
     TF_ASSIGN_OR_RETURN(buffers[i],
                         MemoryForAllocation(allocation, arguments, constants_,
                                             memory_allocator, device_ordinal));
@@ -459,10 +573,21 @@ absl::StatusOr<ExecutionOutput> CpuExecutable::ExecuteAsyncOnStream(
       dynamic_cast<se::host::HostStream*>(run_options->stream());
   se::Stream* stream = run_options->stream();
   se::DeviceMemoryAllocator* memory_allocator = run_options->allocator();
+
+  // Borrow a temp arena for this execution. It is returned to the pool when
+  // the last reference to it is destroyed after the execution completes.
+  std::shared_ptr<ObjectPool<TempArena>::BorrowedObject> temp_arena;
+  if (temp_arenas_.has_value()) {
+    TF_ASSIGN_OR_RETURN(auto borrowed, temp_arenas_->GetOrCreate());
+    temp_arena = std::make_shared<ObjectPool<TempArena>::BorrowedObject>(
+        std::move(borrowed));
+  }
+
   TF_ASSIGN_OR_RETURN(
       std::vector<MaybeOwningDeviceMemory> buffers,
       CreateBufferTable(memory_allocator, stream->parent()->device_ordinal(),
-                        arguments));
+                        arguments,
+                        temp_arena ? (*temp_arena)->data.get() : nullptr));
 
   TF_ASSIGN_OR_RETURN(
       ExecutionOutput result,
@@ -482,6 +607,7 @@ absl::StatusOr<ExecutionOutput> CpuExecutable::ExecuteAsyncOnStream(
     CpuExecutable* executable;
     ServiceExecutableRunOptions run_options;
     std::shared_ptr<std::vector<MaybeOwningDeviceMemory>> task_buffers;
+    std::shared_ptr<ObjectPool<TempArena>::BorrowedObject> temp_arena;
 
     absl::Status operator()() {
       if (executable->has_compute_function()) {
@@ -498,7 +624,8 @@ absl::StatusOr<ExecutionOutput> CpuExecutable::ExecuteAsyncOnStream(
   host_stream->EnqueueTaskWithStatus(
       AsyncRunTask{this, *run_options,
                    std::make_shared<std::vector<MaybeOwningDeviceMemory>>(
-                       std::move(buffers))});
+                       std::move(buffers)),
+                   std::move(temp_arena)});
 
   MarkToBeReleasedArguments(absl::MakeSpan(arguments), result);
   return std::move(result);
@@ -522,6 +649,123 @@ const InstructionValueSet& CpuExecutable::GetRootValueSet() const {
       module().entry_computation()->root_instruction());
 }
 
+// Returns true if the value of `constant` is part of the module fingerprint,
+// and therefore known to be the same in modules with the same fingerprint.
+static bool IsEssentialConstant(const HloInstruction* constant) {
+  return constant->shape().AreAllLeavesIntegers() ||
+         constant->literal().IsAll(0) || constant->literal().IsAll(1);
+}
+
+absl::Status CpuExecutable::UpdateConstants(const HloModule& original,
+                                            const HloModule& updated) {
+  if (!has_thunks()) {
+    return absl::UnimplementedError(
+        "Constants can only be updated in executables using thunks");
+  }
+
+  // The module fingerprint leaves out the values of floating point constants
+  // that are not all zeros or ones, which is what the weights usually are.
+  if (original.GetFingerprint128() != updated.GetFingerprint128()) {
+    return absl::FailedPreconditionError(absl::StrCat(
+        "Module ", updated.name(),
+        " differs from the compiled module in more than constant values"));
+  }
+
+  // Collects the constants whose values changed, by name.
+  absl::flat_hash_map<absl::string_view, const HloInstruction*> changed;
+  for (const HloComputation* computation : original.computations()) {
+    HloComputation* updated_computation =
+        updated.GetComputationWithName(computation->name());
+    for (const HloInstruction* instr : computation->instructions()) {
+      if (instr->opcode() != HloOpcode::kConstant) {
+        continue;
+      }
+      const HloInstruction* updated_instr =
+          updated_computation == nullptr
+              ? nullptr
+              : updated_computation->GetInstructionWithName(instr->name());
+      if (updated_instr == nullptr ||
+          updated_instr->opcode() != HloOpcode::kConstant) {
+        return absl::FailedPreconditionError(
+            absl::StrCat("Constant ", instr->name(), " is not in module ",
+                         updated.name()));
+      }
+      if (instr->literal() == updated_instr->literal()) {
+        continue;
+      }
+      // Optimizations may depend on the values of scalar constants.
+      if (ShapeUtil::IsEffectiveScalar(instr->shape())) {
+        return absl::FailedPreconditionError(absl::StrCat(
+            "Value of scalar constant ", instr->name(), " changed"));
+      }
+      changed[instr->name()] = updated_instr;
+    }
+  }
+  if (changed.empty()) {
+    return absl::OkStatus();
+  }
+
+  // Constants created by the compiler, e.g. by constant folding, may have been
+  // computed from the changed constants, unless their value is known to be the
+  // same. Constants kept from `original` must not have been rewritten.
+  for (const HloComputation* computation : module().computations()) {
+    for (const HloInstruction* instr : computation->instructions()) {
+      if (instr->opcode() != HloOpcode::kConstant ||
+          IsEssentialConstant(instr)) {
+        continue;
+      }
+      HloComputation* original_computation =
+          original.GetComputationWithName(computation->name());
+      const HloInstruction* original_instr =
+          original_computation == nullptr
+              ? nullptr
+              : original_computation->GetInstructionWithName(instr->name());
+      if (original_instr == nullptr ||
+          original_instr->opcode() != HloOpcode::kConstant ||
+          original_instr->literal() != instr->literal()) {
+        return absl::FailedPreconditionError(absl::StrCat(
+            "Constant ", instr->name(), " was created or rewritten by the "
+            "compiler and may depend on the changed constants"));
+      }
+    }
+  }
+
+  // Replaces the constant allocations defined by the changed constants, which
+  // all must be in constant allocations and not, e.g., fused into kernels.
+  std::vector<ConstantAllocation> updated_constants;
+  for (const BufferAllocation& allocation : assignment_->Allocations()) {
+    if (!allocation.is_constant()) {
+      continue;
+    }
+    for (const auto& [value, _] : allocation.assigned_buffers()) {
+      const HloInstruction* instr = value->instruction();
+      auto it = instr->opcode() == HloOpcode::kConstant
+                    ? changed.find(instr->name())
+                    : changed.end();
+      if (it == changed.end()) {
+        continue;
+      }
+      TF_ASSIGN_OR_RETURN(
+          updated_constants.emplace_back(),
+          CreateOwnedConstantAllocation(
+              allocation.index(),
+              it->second->literal().Relayout(instr->shape())));
+      changed.erase(it);
+      break;
+    }
+  }
+  if (!changed.empty()) {
+    return absl::FailedPreconditionError(absl::StrCat(
+        "Constant ", changed.begin()->first,
+        " is not in a constant allocation of the compiled module"));
+  }
+
+  for (ConstantAllocation& constant : updated_constants) {
+    constants_[constant.index] = std::move(constant);
+  }
+  return absl::OkStatus();
+}
+
 int64_t CpuExecutable::SizeOfGeneratedCodeInBytes() const {
   // TODO(ezhulenev): Delete this function, it's not really used anywhere.
   return 0;
@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef XLA_SERVICE_CPU_CPU_EXECUTABLE_H_
 #define XLA_SERVICE_CPU_CPU_EXECUTABLE_H_
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <optional>
@@ -36,6 +37,7 @@ limitations under the License.
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_module.h"
 #include "xla/literal.h"
+#include "xla/runtime/object_pool.h"
 #include "xla/service/buffer_assignment.h"
 #include "xla/service/cpu/executable.pb.h"
 #include "xla/service/custom_call_status.h"
@@ -47,6 +49,7 @@ limitations under the License.
 #include "xla/service/service_executable_run_options.h"
 #include "xla/stream_executor/device_memory.h"
 #include "xla/stream_executor/device_memory_allocator.h"
+#include "tsl/platform/mem.h"
 
 namespace xla {
 namespace cpu {
@@ -157,6 +160,17 @@ class CpuExecutable : public Executable {
   const BufferAssignment& buffer_assignment() const { return *assignment_; }
   absl::Span<const ConstantAllocation> constants() const { return constants_; }
 
+  // Replaces the values of the constants of this executable, compiled from
+  // `original`, with the values of the constants of `updated`, so that a module
+  // that differs from `original` only in its weights does not have to be
+  // compiled again. Only the values of non-scalar floating point constants may
+  // differ, and only if the compiler kept them unchanged in constant
+  // allocations. Otherwise returns an error and leaves the executable
+  // unchanged, and `updated` must be compiled. Must not be called concurrently
+  // with executions.
+  absl::Status UpdateConstants(const HloModule& original,
+                               const HloModule& updated);
+
   int64_t SizeOfGeneratedCodeInBytes() const override;
 
   absl::Span<const BufferAllocation> GetAllocations() const override {
@@ -187,9 +201,16 @@ class CpuExecutable : public Executable {
   //
   //  - buffers_to_free: buffers whose ownership was donated by the caller that
   //    are to be freed by the caller.
+  //
+  // If `temp_arena` is not null, temporary allocations are not allocated, and
+  // instead point into the arena at `temp_arena_offsets_`.
   absl::StatusOr<std::vector<MaybeOwningDeviceMemory>> CreateBufferTable(
       se::DeviceMemoryAllocator* memory_allocator, int device_ordinal,
-      absl::Span<ExecutionInput const> arguments);
+      absl::Span<ExecutionInput const> arguments, std::byte* temp_arena);
+
+  // Assigns offsets in the temp arena to all non-live-out temporary
+  // allocations and creates a pool of temp arenas.
+  void InitializeTempArenas();
 
   // Creates an Execution output holding ScopedShapedBuffer for holding the
   // result of the computation, moving buffers out of allocated_buffers and into
@@ -252,6 +273,24 @@ class CpuExecutable : public Executable {
   // Entry function name for the computation.
   const std::string entry_function_name_;
 
+  // A block of memory backing all temporary allocations of one execution.
+  struct TempArena {
+    struct Deleter {
+      void operator()(std::byte* ptr) { tsl::port::AlignedFree(ptr); }
+    };
+    std::unique_ptr<std::byte, Deleter> data;
+  };
+
+  // Offsets into the temp arena indexed by BufferAllocation::Index, or nullopt
+  // if the allocation doesn't live in the arena.
+  std::vector<std::optional<size_t>> temp_arena_offsets_;
+  size_t temp_arena_size_ = 0;
+
+  // Temp arenas recycled across executions. Each concurrent execution borrows
+  // its own arena from the pool, so the number of arenas matches the peak
+  // number of concurrent executions.
+  std::optional<ObjectPool<TempArena>> temp_arenas_;
+
   CpuExecutable(std::unique_ptr<HloModule> hlo_module,
                 std::unique_ptr<HloProfilePrinterData> hlo_profile_printer_data,
                 std::unique_ptr<HloProfileIndexMap> hlo_profile_index_map,
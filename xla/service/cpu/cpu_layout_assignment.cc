@@ -119,6 +119,10 @@ static bool OperandsAndResultMustHaveRowMajorLayout(
         instr, target_machine_features, /*allow_runtime_calls=*/true);
   } else if (instr.opcode() == HloOpcode::kCustomCall) {
     return instr.custom_call_target() == "TopK";
+  } else if (instr.opcode() == HloOpcode::kRngBitGenerator) {
+    // RngBitGeneratorThunk generates random bits in the logical order of the
+    // output elements.
+    return true;
   }
   return false;
 }
@@ -124,22 +124,21 @@ bool CanEmitTiledLlvmIrGemm(
     const TargetMachineFeatures& target_machine_features) {
   CHECK(IsAlignedGemm(dot_info, target_machine_features));
 
-  if (ShouldUseMultiThreadedEigen(config)) {
-    return false;
-  }
-
   int m = dot_info.result_shape.dimensions(0);
   int k = dot_info.lhs_shape.dimensions(
       dot_info.dim_nums.lhs_contracting_dimensions(0));
   int n = dot_info.result_shape.dimensions(1);
 
-  if (!options::ForceEnableExperimentalLlvmIrGemm(config)) {
-    // TODO(sanjoy):  We should make these numbers micro-arch specific.
-    bool small_gemm =
-        k <= 128 && ((m <= 32 && n <= 128) || (m <= 128 && n <= 32));
-    if (!small_gemm) {
-      return false;
-    }
+  // TODO(sanjoy):  We should make these numbers micro-arch specific.
+  bool small_gemm =
+      k <= 128 && ((m <= 32 && n <= 128) || (m <= 128 && n <= 32));
+
+  // Small and skinny GEMMs are dominated by the overhead of dispatching work
+  // into the multi-threaded Eigen runtime, and a single-threaded tiled kernel
+  // specialized for the dot shape is faster than that.
+  if (!small_gemm && (ShouldUseMultiThreadedEigen(config) ||
+                      !options::ForceEnableExperimentalLlvmIrGemm(config))) {
+    return false;
   }
 
   bool lhs_canonical = dot_info.dim_nums.lhs_contracting_dimensions(0) == 1;
@@ -301,8 +300,21 @@ class DotOpEmitter {
     // information in one place.
     const std::tuple<int64_t, int64_t, int64_t> kDefaultTileSize =
         std::tuple<int64_t, int64_t, int64_t>(11, 9, 1);
-    return options::LlvmIrGemmTileSize(hlo_module_config_)
-        .value_or(kDefaultTileSize);
+
+    // Targets with 32 vector registers (AVX-512, NEON, SVE) can keep two
+    // vectors of each result row in registers: 8x2 accumulators, 4x2 rhs
+    // vectors and the lhs broadcasts fit without spilling.
+    const std::tuple<int64_t, int64_t, int64_t> kWideTileSize =
+        std::tuple<int64_t, int64_t, int64_t>(8, 4, 2);
+
+    if (auto tile_size = options::LlvmIrGemmTileSize(hlo_module_config_)) {
+      return *tile_size;
+    }
+
+    int64_t vector_register_count =
+        target_machine_features_.vector_register_count(
+            *b_->GetInsertBlock()->getParent());
+    return vector_register_count >= 32 ? kWideTileSize : kDefaultTileSize;
   }
 
   DotInfo dot_info_;
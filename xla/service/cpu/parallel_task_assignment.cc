@@ -72,9 +72,11 @@ class SimpleCostModel : public ParallelCostModel {
 class DefaultCostModel : public ParallelCostModel {
  public:
   DefaultCostModel(const int64_t max_parallelism,
+                   const int64_t max_tasks_per_thread,
                    const HloCostAnalysis::ShapeSizeFunction& shape_size,
                    std::unique_ptr<HloCostAnalysis> cost_analysis)
       : max_parallelism_(max_parallelism),
+        max_tasks_per_thread_(max_tasks_per_thread),
         shape_size_(shape_size),
         cost_analysis_(std::move(cost_analysis)) {}
   ~DefaultCostModel() override {}
@@ -101,8 +103,9 @@ class DefaultCostModel : public ParallelCostModel {
       instruction_cost = bytes_accessed;
       min_cost_per_thread = 256LL << 10;  // 256KB L2 Cache size.
     } else {
-      // Use max parallelism for compute bound instructions.
-      max_parallelism = max_parallelism_;
+      // Use max parallelism for compute bound instructions, and allow
+      // splitting them into multiple tasks per thread for load balancing.
+      max_parallelism = max_parallelism_ * max_tasks_per_thread_;
       // Calculate the instruction cost in cycles.
       // TODO(b/29630486) Improve on this linear cost model.
       // Consider making 'min_cost_per_thread' be a function of the target
@@ -122,6 +125,7 @@ class DefaultCostModel : public ParallelCostModel {
 
  private:
   const int64_t max_parallelism_;
+  const int64_t max_tasks_per_thread_;
   const HloCostAnalysis::ShapeSizeFunction shape_size_;
   const std::unique_ptr<HloCostAnalysis> cost_analysis_;
 };
@@ -129,7 +133,8 @@ class DefaultCostModel : public ParallelCostModel {
 ParallelTaskAssignment::ParallelTaskAssignment(
     const int64_t max_parallelism,
     const HloCostAnalysis::ShapeSizeFunction& shape_size, HloModule* module,
-    const TargetMachineFeatures* target_machine_features)
+    const TargetMachineFeatures* target_machine_features,
+    const int64_t max_tasks_per_thread)
     : target_machine_features_(*target_machine_features) {
   VLOG(1) << "ParallelTaskAssignment max_parallelism: " << max_parallelism;
   // Run cost analysis on 'module'.
@@ -140,7 +145,8 @@ ParallelTaskAssignment::ParallelTaskAssignment(
   if (status.ok()) {
     // Set default cost model based on 'cost_analysis'.
     cost_model_ = std::make_unique<DefaultCostModel>(
-        max_parallelism, shape_size, std::move(cost_analysis));
+        max_parallelism, max_tasks_per_thread, shape_size,
+        std::move(cost_analysis));
   } else {
     // Fall back to a simple cost model based on hlo size and L2 cache size.
     // Note that HloCostAnalysis can returns an error status (likely because
@@ -299,9 +305,9 @@ bool ParallelTaskAssigner::AssignParallelTasksHelper(
 
 void ParallelTaskAssigner::ComputeTargetParallelTasks(
     HloModule* module, HloToParallelTasks* hlo_to_parallel_tasks) {
-  ParallelTaskAssignment parallel_task_assignment(max_parallelism_,
-                                                  shape_size_function_, module,
-                                                  &target_machine_features_);
+  ParallelTaskAssignment parallel_task_assignment(
+      max_parallelism_, shape_size_function_, module,
+      &target_machine_features_, max_tasks_per_thread_);
 
   // Compute parallel task counts for all instructions in 'module'.
   for (auto* computation : module->MakeNonfusionComputations()) {
@@ -48,10 +48,13 @@ class ParallelTaskAssignment {
   // 'shape_size': shape size function used by HloCostAnalysis during parallel
   //               task assignment.
   // 'module': the containing HloModule.
+  // 'max_tasks_per_thread': the maximum number of parallel tasks per thread
+  //                         for compute bound instructions (see below).
   ParallelTaskAssignment(int64_t max_parallelism,
                          const HloCostAnalysis::ShapeSizeFunction& shape_size,
                          HloModule* module,
-                         const TargetMachineFeatures* target_machine_features);
+                         const TargetMachineFeatures* target_machine_features,
+                         int64_t max_tasks_per_thread = 1);
   ~ParallelTaskAssignment() {}
 
   // Computes and returns the target parallel task count for 'instruction'.
@@ -75,10 +78,20 @@ class ParallelTaskAssigner : public HloModulePass {
   // 'max_parallelism': the maximum parallel task count per instruction.
   // 'shape_size': shape size function used by HloCostAnalysis during parallel
   //               task assignment.
+  // 'max_tasks_per_thread': the maximum number of parallel tasks per thread
+  //                         for compute bound instructions. Values larger than
+  //                         one split large instructions into more tasks than
+  //                         threads, which the runtime that schedules tasks
+  //                         with work stealing (thunk runtime) can balance
+  //                         between threads that are actually available.
+  //                         The per-task minimum cost is unchanged, so small
+  //                         instructions are not split further.
   ParallelTaskAssigner(const int64_t max_parallelism,
                        const HloCostAnalysis::ShapeSizeFunction& shape_size,
-                       const TargetMachineFeatures* target_machine_features)
+                       const TargetMachineFeatures* target_machine_features,
+                       const int64_t max_tasks_per_thread = 1)
       : max_parallelism_(max_parallelism),
+        max_tasks_per_thread_(max_tasks_per_thread),
         shape_size_function_(shape_size),
         target_machine_features_(*target_machine_features) {}
   ~ParallelTaskAssigner() override {}
@@ -114,6 +127,7 @@ class ParallelTaskAssigner : public HloModulePass {
                                   HloToParallelTasks* hlo_to_parallel_tasks);
 
   int64_t max_parallelism_;
+  int64_t max_tasks_per_thread_;
   HloCostAnalysis::ShapeSizeFunction shape_size_function_;
   const TargetMachineFeatures& target_machine_features_;
 };
@@ -47,9 +47,11 @@ class ParallelTaskAssignmentTest : public HloHardwareIndependentTestBase {
           return cpu::TargetMachineFeatures::kEigenExpectedTensorAlignment;
         }) {}
 
-  absl::StatusOr<bool> RunParallelTaskAssigner(HloModule* module) {
+  absl::StatusOr<bool> RunParallelTaskAssigner(
+      HloModule* module, int64_t max_tasks_per_thread = 1) {
     return cpu::ParallelTaskAssigner(max_parallelism_, shape_size_func_,
-                                     &target_machine_features_)
+                                     &target_machine_features_,
+                                     max_tasks_per_thread)
         .Run(module);
   }
 
@@ -86,6 +88,53 @@ TEST_F(ParallelTaskAssignmentTest, ReduceWindowParallelized) {
   EXPECT_EQ(backend_config.outer_dimension_partitions(0), 2);
 }
 
+TEST_F(ParallelTaskAssignmentTest, ComputeBoundOpSplitIntoTasksPerThread) {
+  // A reduce-window with overlapping windows has enough flops per byte to be
+  // considered compute bound.
+  constexpr char hlo_string[] = R"(
+  HloModule m
+    add {
+      lhs = f32[] parameter(0)
+      rhs = f32[] parameter(1)
+      ROOT add = f32[] add(lhs, rhs)
+    }
+
+    ENTRY e {
+      p0 = f32[1024,1024] parameter(0)
+      p1 = f32[] parameter(1)
+      ROOT reduce-window = f32[993,1024] reduce-window(p0, p1),
+          window={size=32x1 stride=1x1}, to_apply=add
+    }
+  )";
+
+  auto total_partition_count = [&](int64_t max_tasks_per_thread)
+      -> absl::StatusOr<int64_t> {
+    TF_ASSIGN_OR_RETURN(std::unique_ptr<HloModule> m,
+                        ParseAndReturnVerifiedModule(hlo_string));
+    TF_ASSIGN_OR_RETURN(bool changed,
+                        RunParallelTaskAssigner(m.get(), max_tasks_per_thread));
+    EXPECT_TRUE(changed);
+
+    auto* reduce_window = FindInstruction(m.get(), HloOpcode::kReduceWindow);
+    TF_ASSIGN_OR_RETURN(auto backend_config,
+                        reduce_window->backend_config<cpu::BackendConfig>());
+    int64_t count = 1;
+    for (int64_t partitions : backend_config.outer_dimension_partitions()) {
+      count *= partitions;
+    }
+    return count;
+  };
+
+  TF_ASSERT_OK_AND_ASSIGN(int64_t one_task_per_thread,
+                          total_partition_count(/*max_tasks_per_thread=*/1));
+  TF_ASSERT_OK_AND_ASSIGN(int64_t four_tasks_per_thread,
+                          total_partition_count(/*max_tasks_per_thread=*/4));
+
+  EXPECT_LE(one_task_per_thread, max_parallelism_);
+  EXPECT_GT(four_tasks_per_thread, max_parallelism_);
+  EXPECT_LE(four_tasks_per_thread, 4 * max_parallelism_);
+}
+
 TEST_F(ParallelTaskAssignmentTest, DotOperationNotParallelized) {
   const std::string hlo_string = R"(
     HloModule TestTaskParallel_Dot
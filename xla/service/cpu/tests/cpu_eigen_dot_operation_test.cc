@@ -106,6 +106,29 @@ TEST_P(CpuEigenDotOperationTest, DotTransposeOp) {
   CompileAndCheck(builder.Build(), spec.filecheck_lines);
 }
 
+TEST_F(CpuEigenDotOperationTest, SmallDotOpIsNotEigenCall) {
+#if defined(INTEL_MKL)
+  GTEST_SKIP() << "OneDNN rewrites dot instruction to custom-call.";
+#endif  // INTEL_MKL
+  HloComputation::Builder builder(TestName());
+
+  auto lhs_shape = ShapeUtil::MakeShape(F32, {16, 64});
+  auto rhs_shape = ShapeUtil::MakeShape(F32, {64, 64});
+
+  HloInstruction* lhs = builder.AddInstruction(
+      HloInstruction::CreateParameter(0, lhs_shape, "input"));
+  HloInstruction* rhs = builder.AddInstruction(
+      HloInstruction::CreateParameter(1, rhs_shape, "input"));
+
+  // Small dots are emitted as tiled LLVM IR kernels even when multi-threaded
+  // Eigen is enabled.
+  builder.AddInstruction(CreateCanonicalDot(lhs_shape, lhs, rhs));
+  CompileAndCheck(builder.Build(), R"(
+CHECK-NOT: call void @__xla_cpu_runtime_EigenMatMulF32
+CHECK-NOT: call void @__xla_cpu_runtime_EigenSingleThreadedMatMulF32
+)");
+}
+
 std::vector<DotTestSpec> GetDotTestCases() {
   std::vector<DotTestSpec> result;
   // The fp16 test runs a 32-bit matmul because we promote fp16 gemms to fp32
@@ -0,0 +1,110 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "absl/strings/string_view.h"
+#include "xla/array2d.h"
+#include "xla/literal.h"
+#include "xla/literal_util.h"
+#include "xla/service/cpu/tests/cpu_codegen_test.h"
+#include "xla/tests/literal_test_util.h"
+#include "xla/tsl/platform/env.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/tsl/platform/threadpool.h"
+#include "xla/xla.pb.h"
+
+namespace xla {
+namespace cpu {
+namespace {
+
+class CpuTempArenaTest : public CpuCodegenTest {
+ protected:
+  DebugOptions GetDebugOptionsForTest() const override {
+    DebugOptions debug_options = CpuCodegenTest::GetDebugOptionsForTest();
+    debug_options.set_xla_cpu_enable_temp_buffer_arena(true);
+    return debug_options;
+  }
+};
+
+// Intermediate results of dots are temporary buffers that live in the arena.
+constexpr absl::string_view kHlo = R"(
+  HloModule m
+
+  ENTRY e {
+    p0 = f32[8,8] parameter(0)
+    dot0 = f32[8,8] dot(p0, p0), lhs_contracting_dims={1},
+                                 rhs_contracting_dims={0}
+    neg = f32[8,8] negate(dot0)
+    ROOT dot1 = f32[8,8] dot(neg, p0), lhs_contracting_dims={1},
+                                       rhs_contracting_dims={0}
+  }
+)";
+
+TEST_F(CpuTempArenaTest, ReuseArenaAcrossExecutions) {
+  TF_ASSERT_OK_AND_ASSIGN(auto module, ParseAndReturnVerifiedModule(kHlo));
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto executable,
+      CreateExecutable(std::move(module), /*run_hlo_passes=*/true));
+
+  for (float value : {1.0f, 2.0f, 3.0f}) {
+    Literal input =
+        LiteralUtil::CreateR2FromArray2D(Array2D<float>(8, 8, value));
+    TF_ASSERT_OK_AND_ASSIGN(
+        Literal result,
+        test_runner().ExecuteWithExecutable(executable.get(), {&input}));
+
+    float expected = -64.0f * value * value * value;
+    EXPECT_TRUE(LiteralTestUtil::Equal(
+        LiteralUtil::CreateR2FromArray2D(Array2D<float>(8, 8, expected)),
+        result));
+  }
+}
+
+TEST_F(CpuTempArenaTest, ConcurrentExecutions) {
+  TF_ASSERT_OK_AND_ASSIGN(auto module, ParseAndReturnVerifiedModule(kHlo));
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto executable,
+      CreateExecutable(std::move(module), /*run_hlo_passes=*/true));
+
+  constexpr int kNumThreads = 8;
+  std::vector<Literal> results(kNumThreads);
+  {
+    tsl::thread::ThreadPool thread_pool(tsl::Env::Default(), "temp_arena_test",
+                                        kNumThreads);
+    for (int i = 0; i < kNumThreads; ++i) {
+      thread_pool.Schedule([&, i] {
+        Literal input = LiteralUtil::CreateR2FromArray2D(
+            Array2D<float>(8, 8, static_cast<float>(i)));
+        TF_ASSERT_OK_AND_ASSIGN(
+            results[i],
+            test_runner().ExecuteWithExecutable(executable.get(), {&input}));
+      });
+    }
+  }
+
+  for (int i = 0; i < kNumThreads; ++i) {
+    float expected = -64.0f * i * i * i;
+    EXPECT_TRUE(LiteralTestUtil::Equal(
+        LiteralUtil::CreateR2FromArray2D(Array2D<float>(8, 8, expected)),
+        results[i]));
+  }
+}
+
+}  // namespace
+}  // namespace cpu
+}  // namespace xla
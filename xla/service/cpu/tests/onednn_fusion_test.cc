@@ -18,6 +18,7 @@ limitations under the License.
 #include "xla/error_spec.h"
 #include "xla/tests/hlo_test_base.h"
 #include "xla/tsl/platform/test.h"
+#include "tsl/platform/cpu_info.h"
 
 namespace xla::cpu {
 namespace {
@@ -128,5 +129,36 @@ TEST_F(OneDnnFusionTest, MatMul) {
   EXPECT_TRUE(RunAndCompare(kModuleStr, ErrorSpec{1e-5}));
 }
 
+TEST_F(OneDnnFusionTest, MatMulBF16) {
+  constexpr absl::string_view kModuleStr = R"(
+    HloModule mul
+
+    onednn_fusion {
+      %p0 = bf16[16,64] parameter(0)
+      %p1 = bf16[64,64] parameter(1)
+      ROOT %mul = bf16[16,64] dot(%p0, %p1),
+        lhs_contracting_dims={1}, rhs_contracting_dims={0}
+    }
+
+    ENTRY entry {
+      %p0 = bf16[16,64] parameter(0)
+      %p1 = bf16[64,64] parameter(1)
+      ROOT %fusion = bf16[16,64] fusion(%p0, %p1), kind=kCustom,
+        calls=onednn_fusion,
+        backend_config={"fusion_config": {kind: "__onednn_fusion"}}
+    })";
+
+  if (!IsOneDnnGraphEnabled()) {
+    GTEST_SKIP() << "oneDNN fusion is not supported";
+  }
+
+  if (!tsl::port::TestCPUFeature(tsl::port::AMX_BF16) &&
+      !tsl::port::TestCPUFeature(tsl::port::AVX512_BF16)) {
+    GTEST_SKIP() << "CPU needs AMX_BF16 or AVX512_BF16 for this test.";
+  }
+
+  EXPECT_TRUE(RunAndCompare(kModuleStr, ErrorSpec{1e-2, 1e-2}));
+}
+
 }  // namespace
 }  // namespace xla::cpu
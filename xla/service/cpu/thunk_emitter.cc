@@ -29,6 +29,7 @@ limitations under the License.
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/string_view.h"
+#include "absl/synchronization/blocking_counter.h"
 #include "absl/types/span.h"
 #include "llvm/ADT/StringRef.h"
 #include "mlir/IR/BuiltinOps.h"
@@ -55,11 +56,13 @@ limitations under the License.
 #include "xla/backends/cpu/runtime/custom_call_thunk.h"
 #include "xla/backends/cpu/runtime/dot_thunk.h"
 #include "xla/backends/cpu/runtime/fft_thunk.h"
+#include "xla/backends/cpu/runtime/gather_thunk.h"
 #include "xla/backends/cpu/runtime/infeed_thunk.h"
 #include "xla/backends/cpu/runtime/kernel_thunk.h"
 #include "xla/backends/cpu/runtime/logical_id_thunk.h"
 #include "xla/backends/cpu/runtime/outfeed_thunk.h"
 #include "xla/backends/cpu/runtime/reduce_scatter_thunk.h"
+#include "xla/backends/cpu/runtime/rng_bit_generator_thunk.h"
 #include "xla/backends/cpu/runtime/rng_state_thunk.h"
 #include "xla/backends/cpu/runtime/sort_thunk.h"
 #include "xla/backends/cpu/runtime/thunk.h"
@@ -85,6 +88,7 @@ limitations under the License.
 #include "xla/hlo/ir/hlo_opcode.h"
 #include "xla/hlo/ir/hlo_schedule.h"
 #include "xla/layout_util.h"
+#include "xla/primitive_util.h"
 #include "xla/runtime/resource_use.h"
 #include "xla/runtime/work_group.h"
 #include "xla/service/buffer_assignment.h"
@@ -169,7 +173,57 @@ absl::StatusOr<ThunkSequence> ThunkEmitter::EmitEntryComputation(
     return absl::InternalError("HLO module must be scheduled to emit thunks");
   }
   tsl::profiler::TraceMe trace("ThunkEmitter::EmitEntryComputation");
-  return EmitHloComputation(module.entry_computation());
+  TF_ASSIGN_OR_RETURN(ThunkSequence thunks,
+                      EmitHloComputation(module.entry_computation()));
+  TF_RETURN_IF_ERROR(CompilePendingFusionKernels());
+  return thunks;
+}
+
+absl::Status ThunkEmitter::AddFusionKernel(
+    std::string kernel_name, std::unique_ptr<mlir::MLIRContext> context,
+    MlirKernelSource source) {
+  if (options_.thread_pool != nullptr) {
+    pending_fusion_kernels_.push_back(
+        {std::move(kernel_name), std::move(context), std::move(source)});
+    return absl::OkStatus();
+  }
+
+  TF_ASSIGN_OR_RETURN(LlvmIrKernelSource llvm_ir_kernel_source,
+                      fusion_compiler_.Compile(std::move(source)));
+  kernels_.push_back({std::move(kernel_name),
+                      std::move(llvm_ir_kernel_source).thread_safe_module()});
+  return absl::OkStatus();
+}
+
+absl::Status ThunkEmitter::CompilePendingFusionKernels() {
+  if (pending_fusion_kernels_.empty()) {
+    return absl::OkStatus();
+  }
+  tsl::profiler::TraceMe trace("ThunkEmitter::CompilePendingFusionKernels");
+
+  // Every kernel has its own MLIR and LLVM contexts, so the kernels can be
+  // lowered independently of each other.
+  std::vector<absl::StatusOr<LlvmIrKernelSource>> compiled(
+      pending_fusion_kernels_.size());
+  absl::BlockingCounter counter(pending_fusion_kernels_.size());
+  for (size_t i = 0; i < pending_fusion_kernels_.size(); ++i) {
+    options_.thread_pool->Schedule([&, i] {
+      compiled[i] = fusion_compiler_.Compile(
+          std::move(pending_fusion_kernels_[i].source));
+      counter.DecrementCount();
+    });
+  }
+  counter.Wait();
+
+  // Add the kernels in emission order to keep the output deterministic.
+  for (size_t i = 0; i < pending_fusion_kernels_.size(); ++i) {
+    TF_ASSIGN_OR_RETURN(LlvmIrKernelSource llvm_ir_kernel_source,
+                        std::move(compiled[i]));
+    kernels_.push_back({std::move(pending_fusion_kernels_[i].kernel_name),
+                        std::move(llvm_ir_kernel_source).thread_safe_module()});
+  }
+  pending_fusion_kernels_.clear();
+  return absl::OkStatus();
 }
 
 absl::StatusOr<BufferAllocation::Slice> ThunkEmitter::GetAllocationSlice(
@@ -277,7 +331,6 @@ absl::StatusOr<ThunkSequence> ThunkEmitter::EmitHloInstruction(
     case HloOpcode::kExp:
     case HloOpcode::kExpm1:
     case HloOpcode::kFloor:
-    case HloOpcode::kGather:
     case HloOpcode::kImag:
     case HloOpcode::kIota:
     case HloOpcode::kIsFinite:
@@ -408,6 +461,9 @@ absl::StatusOr<ThunkSequence> ThunkEmitter::EmitHloInstruction(
     case HloOpcode::kFft:
       return EmitFftThunk(instruction);
 
+    case HloOpcode::kGather:
+      return EmitGatherThunk(instruction);
+
     case HloOpcode::kTopK:
       return Unimplemented("TopK is not yet supported by XLA:CPU ThunkEmitter");
 
@@ -443,6 +499,10 @@ static absl::StatusOr<CollectiveThunk::OpParams> GetCollectiveOpParams(
       /*has_channel_id=*/instruction->channel_id().has_value(),
       /*use_global_device_ids=*/instruction->use_global_device_ids(),
       /*replica_groups=*/instruction->replica_groups(),
+      /*is_async=*/instruction->GetModule()
+          ->config()
+          .debug_options()
+          .xla_cpu_enable_async_collectives(),
   };
 }
 
@@ -458,6 +518,10 @@ static absl::StatusOr<CollectiveThunk::OpParams> GetCollectiveOpParams(
       /*has_channel_id=*/instruction->channel_id().has_value(),
       /*use_global_device_ids=*/std::nullopt,
       /*replica_groups=*/instruction->replica_groups(),
+      /*is_async=*/instruction->GetModule()
+          ->config()
+          .debug_options()
+          .xla_cpu_enable_async_collectives(),
   };
 }
 
@@ -473,6 +537,10 @@ static absl::StatusOr<CollectiveThunk::OpParams> GetCollectiveOpParams(
       /*has_channel_id=*/instruction->channel_id().has_value(),
       /*use_global_device_ids=*/std::nullopt,
       /*replica_groups=*/{},  // CollectivePermute does not have replica groups
+      /*is_async=*/instruction->GetModule()
+          ->config()
+          .debug_options()
+          .xla_cpu_enable_async_collectives(),
   };
 }
 
@@ -772,11 +840,8 @@ absl::StatusOr<ThunkSequence> ThunkEmitter::EmitFusionKernelThunk(
     auto [kernel_spec, kernel_source] =
         std::move(kernel_definition).ReleaseStorage();
 
-    TF_ASSIGN_OR_RETURN(LlvmIrKernelSource llvm_ir_kernel_source,
-                        fusion_compiler_.Compile(std::move(kernel_source)));
-
-    kernels_.push_back({kernel_spec.name(),
-                        std::move(llvm_ir_kernel_source).thread_safe_module()});
+    TF_RETURN_IF_ERROR(AddFusionKernel(kernel_spec.name(), /*context=*/nullptr,
+                                       std::move(kernel_source)));
 
     return MakeKernelThunkSequence(
         instruction, std::move(kernel_spec),
@@ -794,11 +859,8 @@ absl::StatusOr<ThunkSequence> ThunkEmitter::EmitFusionKernelThunk(
     auto [kernel_spec, kernel_source] =
         std::move(kernel_definition).ReleaseStorage();
 
-    TF_ASSIGN_OR_RETURN(LlvmIrKernelSource llvm_ir_kernel_source,
-                        fusion_compiler_.Compile(std::move(kernel_source)));
-
-    kernels_.push_back({kernel_spec.name(),
-                        std::move(llvm_ir_kernel_source).thread_safe_module()});
+    TF_RETURN_IF_ERROR(AddFusionKernel(kernel_spec.name(), std::move(context),
+                                       std::move(kernel_source)));
 
     return MakeKernelThunkSequence(
         instruction, std::move(kernel_spec),
@@ -826,7 +888,26 @@ absl::StatusOr<ThunkSequence> ThunkEmitter::EmitRngThunk(
 
 absl::StatusOr<ThunkSequence> ThunkEmitter::EmitRngBitGeneratorThunk(
     const HloInstruction* instruction) {
-  return Unimplemented("RngBitGenerator should be expanded for CPU.");
+  auto* rng = Cast<HloRngBitGeneratorInstruction>(instruction);
+  const HloInstruction* state = rng->operand(0);
+  const Shape& output_shape = rng->shape().tuple_shapes(1);
+
+  // RngBitGeneratorExpander leaves only the generators supported by the
+  // Philox thunk in the module.
+  if (!RngBitGeneratorThunk::IsSupported(rng->algorithm(), state->shape(),
+                                         output_shape)) {
+    return Unimplemented("RngBitGenerator should be expanded for CPU.");
+  }
+
+  TF_ASSIGN_OR_RETURN(BufferAllocation::Slice state_slice,
+                      GetAllocationSlice(state));
+  TF_ASSIGN_OR_RETURN(BufferAllocation::Slice output_state_slice,
+                      GetAllocationSlice(rng, {0}));
+  TF_ASSIGN_OR_RETURN(BufferAllocation::Slice output_slice,
+                      GetAllocationSlice(rng, {1}));
+  return ThunkSequence::Of<RngBitGeneratorThunk>(
+      ThunkInfo(rng), rng->algorithm(), state_slice, state->shape(),
+      output_state_slice, output_slice, output_shape);
 }
 
 absl::StatusOr<ThunkSequence> ThunkEmitter::EmitRngGetAndUpdateStateThunk(
@@ -1087,6 +1168,83 @@ absl::StatusOr<ThunkSequence> ThunkEmitter::EmitFftThunk(
       /*output_shape=*/instruction->shape());
 }
 
+// Returns true if `gather` copies whole rows of its operand, i.e. it gathers
+// operand[indices[i], ...] for every index and can be emitted as GatherThunk.
+static bool IsRowGather(const HloGatherInstruction* gather) {
+  const Shape& operand_shape = gather->operand(0)->shape();
+  const Shape& indices_shape = gather->operand(1)->shape();
+  const Shape& output_shape = gather->shape();
+  const GatherDimensionNumbers& dnums = gather->gather_dimension_numbers();
+
+  int64_t operand_rank = operand_shape.dimensions().size();
+  int64_t indices_rank = indices_shape.dimensions().size();
+  int64_t output_rank = output_shape.dimensions().size();
+
+  if (operand_rank == 0 || !dnums.operand_batching_dims().empty() ||
+      dnums.start_index_map_size() != 1 || dnums.start_index_map(0) != 0 ||
+      dnums.collapsed_slice_dims_size() != 1 ||
+      dnums.collapsed_slice_dims(0) != 0) {
+    return false;
+  }
+
+  // Slices must be single full rows of the operand.
+  absl::Span<const int64_t> slice_sizes = gather->gather_slice_sizes();
+  if (slice_sizes[0] != 1) return false;
+  for (int64_t d = 1; d < operand_rank; ++d) {
+    if (slice_sizes[d] != operand_shape.dimensions(d)) return false;
+  }
+
+  // Indices must be scalars, and the rows must be the minor output dimensions.
+  int64_t index_vector_dim = dnums.index_vector_dim();
+  if (index_vector_dim != indices_rank &&
+      (index_vector_dim != indices_rank - 1 ||
+       indices_shape.dimensions(index_vector_dim) != 1)) {
+    return false;
+  }
+  if (dnums.offset_dims_size() != operand_rank - 1) return false;
+  for (int64_t i = 0; i < dnums.offset_dims_size(); ++i) {
+    if (dnums.offset_dims(i) != output_rank - operand_rank + 1 + i) {
+      return false;
+    }
+  }
+
+  PrimitiveType index_type = indices_shape.element_type();
+  if (index_type != S32 && index_type != S64 && index_type != U32 &&
+      index_type != U64) {
+    return false;
+  }
+  if (primitive_util::IsSubByteNonPredType(operand_shape.element_type())) {
+    return false;
+  }
+
+  return LayoutUtil::IsMonotonicWithDim0Major(operand_shape.layout()) &&
+         LayoutUtil::IsMonotonicWithDim0Major(indices_shape.layout()) &&
+         LayoutUtil::IsMonotonicWithDim0Major(output_shape.layout());
+}
+
+absl::StatusOr<ThunkSequence> ThunkEmitter::EmitGatherThunk(
+    const HloInstruction* instruction) {
+  auto* gather = Cast<HloGatherInstruction>(instruction);
+
+  // All other gathers are emitted as elemental loops.
+  if (!IsRowGather(gather)) {
+    return EmitElementalKernelThunk(instruction);
+  }
+
+  const HloInstruction* operand = gather->operand(0);
+  const HloInstruction* indices = gather->operand(1);
+
+  TF_ASSIGN_OR_RETURN(BufferAllocation::Slice operand_slice,
+                      GetAllocationSlice(operand));
+  TF_ASSIGN_OR_RETURN(BufferAllocation::Slice indices_slice,
+                      GetAllocationSlice(indices));
+  TF_ASSIGN_OR_RETURN(BufferAllocation::Slice output_slice,
+                      GetAllocationSlice(gather));
+  return ThunkSequence::Of<GatherThunk>(
+      ThunkInfo(gather), operand_slice, operand->shape(), indices_slice,
+      indices->shape(), output_slice, gather->shape());
+}
+
 static absl::StatusOr<CustomCallThunk::OpBuffers> GetCustomCallOpBuffers(
     const HloInstruction* instruction,
     const BufferAssignment& buffer_assignment) {
@@ -28,11 +28,13 @@ limitations under the License.
 #include "absl/strings/string_view.h"
 #include "absl/types/span.h"
 #include "llvm/ExecutionEngine/Orc/ThreadSafeModule.h"
+#include "mlir/IR/MLIRContext.h"
 #include "xla/backends/cpu/codegen/fusion_compiler.h"
 #include "xla/backends/cpu/codegen/target_machine_features.h"
 #include "xla/backends/cpu/runtime/sort_thunk.h"
 #include "xla/backends/cpu/runtime/thunk.h"
 #include "xla/codegen/kernel_spec.h"
+#include "xla/codegen/mlir_kernel_source.h"
 #include "xla/hlo/ir/hlo_computation.h"
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_instructions.h"
@@ -42,6 +44,7 @@ limitations under the License.
 #include "xla/service/cpu/ir_emitter2.h"
 #include "xla/service/hlo_module_config.h"
 #include "xla/shape_util.h"
+#include "xla/tsl/platform/threadpool.h"
 #include "xla/xla_data.pb.h"
 
 namespace xla::cpu {
@@ -59,6 +62,11 @@ class ThunkEmitter {
     // Whether to compile copy as LLVM kernel. This is used to avoid
     // dependencies on pjrt/transpose for tfcompiled models.
     bool compile_copy_as_llvm_kernel;
+
+    // If set, fusions emitted to MLIR are lowered to LLVM IR concurrently in
+    // this thread pool once all thunks are emitted, instead of one by one as
+    // they are emitted.
+    tsl::thread::ThreadPool* thread_pool = nullptr;
   };
 
   struct EmittedKernel {
@@ -84,6 +92,24 @@ class ThunkEmitter {
     std::vector<BufferAllocation::Slice> results;
   };
 
+  // A fusion kernel emitted to MLIR that is not lowered to LLVM IR yet.
+  struct PendingFusionKernel {
+    std::string kernel_name;
+    // The MLIR context of `source`, if the source doesn't own it.
+    std::unique_ptr<mlir::MLIRContext> context;
+    MlirKernelSource source;
+  };
+
+  // Lowers the fusion kernel `source` to LLVM IR and adds it to the emitted
+  // kernels. With a thread pool the lowering is deferred to
+  // CompilePendingFusionKernels.
+  absl::Status AddFusionKernel(std::string kernel_name,
+                               std::unique_ptr<mlir::MLIRContext> context,
+                               MlirKernelSource source);
+
+  // Lowers all deferred fusion kernels in parallel.
+  absl::Status CompilePendingFusionKernels();
+
   std::optional<SortThunk::SortDirection> MatchSortDirection(
       const HloComputation* hlo_comparator) const;
 
@@ -134,6 +160,9 @@ class ThunkEmitter {
 
   absl::StatusOr<ThunkSequence> EmitFftThunk(const HloInstruction* instruction);
 
+  absl::StatusOr<ThunkSequence> EmitGatherThunk(
+      const HloInstruction* instruction);
+
   absl::StatusOr<ThunkSequence> EmitFusionKernelThunk(
       const HloInstruction* instruction);
 
@@ -254,6 +283,7 @@ class ThunkEmitter {
       token_resources_;
 
   std::vector<EmittedKernel> kernels_;
+  std::vector<PendingFusionKernel> pending_fusion_kernels_;
 
   FusionCompiler fusion_compiler_;
 };
@@ -39,6 +39,8 @@ limitations under the License.
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
+#include "absl/strings/str_join.h"
+#include "absl/strings/str_replace.h"
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
 #include "llvm/Support/raw_ostream.h"
@@ -50,6 +52,8 @@ limitations under the License.
 #include "xla/hlo/ir/hlo_module.h"
 #include "xla/hlo/ir/hlo_opcode.h"
 #include "xla/runtime/large_hlo_snapshot_serialization/serialization.h"
+#include "xla/service/buffer_assignment.h"
+#include "xla/service/buffer_assignment.pb.h"
 #include "xla/service/hlo.pb.h"
 #include "xla/service/hlo_graph_dumper.h"
 #include "xla/service/hlo_proto_util.h"
@@ -60,6 +64,7 @@ limitations under the License.
 #include "xla/tsl/platform/errors.h"
 #include "xla/tsl/platform/file_system.h"
 #include "xla/tsl/platform/file_system_helper.h"
+#include "xla/tsl/platform/threadpool.h"
 #include "xla/util.h"
 #include "tsl/platform/path.h"
 #include "tsl/platform/platform.h"
@@ -130,7 +135,10 @@ struct CanonicalDebugOptions {
         dump_max_hlo_modules(opts.xla_dump_max_hlo_modules()),
         dump_compress_protos(opts.xla_dump_compress_protos()),
         dump_fdo_profiles(opts.xla_gpu_experimental_dump_fdo_profiles()),
-        dump_mlir_pretty_form(opts.xla_dump_enable_mlir_pretty_form()) {
+        dump_mlir_pretty_form(opts.xla_dump_enable_mlir_pretty_form()),
+        dump_async_threads(opts.xla_dump_async_threads()),
+        dump_async_max_pending_modules(
+            opts.xla_dump_async_max_pending_modules()) {
     // This constructor examines the values in `opts` and turns on other flags
     // based on what we think is the user's intent.  To reduce confusion about
     // what was a user-specified value versus an extrapolated value, within this
@@ -255,6 +263,8 @@ struct CanonicalDebugOptions {
   bool dump_compress_protos;
   bool dump_fdo_profiles;
   bool dump_mlir_pretty_form;
+  int64_t dump_async_threads;
+  int64_t dump_async_max_pending_modules;
 };
 
 // Helper class to hold a list of functions that produces data to be written to
@@ -452,15 +462,34 @@ static bool IsTrivial(const HloComputation& computation) {
          root->opcode() != HloOpcode::kFusion;
 }
 
+// Returns the live bytes of `report` as a counter track in the Chrome trace
+// event format, which Perfetto can load. Logical times are shown as
+// microseconds.
+static std::string PeakMemoryTraceJson(
+    const buffer_assignment::PeakMemoryReportProto& report) {
+  std::string json = "{\"traceEvents\":[";
+  for (int64_t time = 0; time < report.live_bytes_size(); ++time) {
+    absl::StrAppend(&json, time == 0 ? "" : ",",
+                    "{\"name\":\"live bytes\",\"ph\":\"C\",\"pid\":0,"
+                    "\"ts\":",
+                    time, ",\"args\":{\"bytes\":", report.live_bytes(time),
+                    "}}");
+  }
+  absl::StrAppend(&json, "]}");
+  return json;
+}
+
 // Returns full file paths of all dumps of the module.
+// `module_id` is the unique id of the module used in the file names, which
+// differs from `module.unique_id()` when `module` is a snapshot.
 static std::vector<std::string> DumpHloModuleImpl(
-    const HloModule& module, const BufferAssignment* buffer_assn,
+    const HloModule& module, int module_id, const BufferAssignment* buffer_assn,
     string_view prefix, string_view suffix, const CanonicalDebugOptions& opts) {
   tsl::profiler::ScopedAnnotation annotation([&] {
     return absl::StrFormat("XlaDumpHloModule:#module=%s,program_id=%d#",
-                           module.name(), module.unique_id());
+                           module.name(), module_id);
   });
-  std::string filename = FilenameFor(module, prefix, suffix);
+  std::string filename = FilenameFor(module_id, module.name(), prefix, suffix);
 
   std::vector<std::optional<std::string>> file_paths;
 
@@ -479,6 +508,19 @@ static std::vector<std::string> DumpHloModuleImpl(
       summary_report.Append([&] { return buffer_assn->MemoryUsageReport(); });
       file_paths.push_back(DumpToFileInDirOrStdoutImpl(
           StrCat(filename, "-memory-usage-report.txt"), summary_report, opts));
+      buffer_assignment::PeakMemoryReportProto peak_memory_report =
+          buffer_assn->PeakMemoryReport();
+      std::string peak_memory_report_json;
+      if (tsl::protobuf::util::MessageToJsonString(peak_memory_report,
+                                                   &peak_memory_report_json)
+              .ok()) {
+        file_paths.push_back(DumpToFileInDirImpl(
+            StrCat(filename, "-peak-memory-report.json"),
+            peak_memory_report_json, opts));
+      }
+      file_paths.push_back(DumpToFileInDirImpl(
+          StrCat(filename, "-peak-memory-trace.json"),
+          PeakMemoryTraceJson(peak_memory_report), opts));
     }
   }
 
@@ -530,7 +572,8 @@ static std::vector<std::string> DumpHloModuleImpl(
         continue;
       }
       file_paths.push_back(DumpToFileInDirImpl(
-          FilenameFor(module, computation->name(), "_fusion.html"),
+          FilenameFor(module_id, module.name(), computation->name(),
+                      "_fusion.html"),
           *rendered_graph, opts));
     }
   }
@@ -565,6 +608,128 @@ static std::vector<std::string> DumpHloModuleImpl(
   return dumped_file_paths;
 }
 
+// Dumps snapshots of modules on background threads, so that dumping between
+// and during passes does not stall compilation. See --xla_dump_async_threads.
+class AsyncHloModuleDumper {
+ public:
+  // Returns the dumper, which is created with `num_threads` threads by the
+  // first call.
+  static AsyncHloModuleDumper& GetOrCreate(int64_t num_threads) {
+    absl::MutexLock lock(&instance_mu_);
+    if (instance_ == nullptr) {
+      instance_ = new AsyncHloModuleDumper(num_threads);
+    }
+    return *instance_;
+  }
+
+  // Returns the dumper, or nullptr if no module was dumped asynchronously.
+  static AsyncHloModuleDumper* Get() {
+    absl::MutexLock lock(&instance_mu_);
+    return instance_;
+  }
+
+  // Dumps `snapshot` on a background thread, once there are fewer than
+  // `opts.dump_async_max_pending_modules` snapshots waiting to be dumped.
+  void Schedule(std::unique_ptr<HloModule> snapshot, int module_id,
+                std::string prefix, std::string suffix,
+                const CanonicalDebugOptions& opts) {
+    {
+      absl::MutexLock lock(&mu_);
+      if (opts.dump_async_max_pending_modules > 0) {
+        auto has_capacity = [&]() ABSL_SHARED_LOCKS_REQUIRED(mu_) {
+          return num_pending_ < opts.dump_async_max_pending_modules;
+        };
+        mu_.Await(absl::Condition(&has_capacity));
+      }
+      ++num_pending_;
+    }
+    pool_.Schedule([this, snapshot = std::shared_ptr<HloModule>(
+                              std::move(snapshot)),
+                    module_id, prefix = std::move(prefix),
+                    suffix = std::move(suffix), opts] {
+      DumpHloModuleImpl(*snapshot, module_id, /*buffer_assn=*/nullptr, prefix,
+                        suffix, opts);
+      absl::MutexLock lock(&mu_);
+      --num_pending_;
+    });
+  }
+
+  // Blocks until all scheduled snapshots are dumped.
+  void WaitForPendingDumps() {
+    absl::MutexLock lock(&mu_);
+    auto idle = [&]() ABSL_SHARED_LOCKS_REQUIRED(mu_) {
+      return num_pending_ == 0;
+    };
+    mu_.Await(absl::Condition(&idle));
+  }
+
+ private:
+  explicit AsyncHloModuleDumper(int64_t num_threads)
+      : pool_(tsl::Env::Default(), "xla_dump", num_threads) {}
+
+  static absl::Mutex instance_mu_;
+  static AsyncHloModuleDumper* instance_ ABSL_GUARDED_BY(instance_mu_);
+
+  absl::Mutex mu_;
+  int64_t num_pending_ ABSL_GUARDED_BY(mu_) = 0;
+  tsl::thread::ThreadPool pool_;
+};
+
+ABSL_CONST_INIT absl::Mutex AsyncHloModuleDumper::instance_mu_(
+    absl::kConstInit);
+AsyncHloModuleDumper* AsyncHloModuleDumper::instance_ = nullptr;
+
+// Dumps `module` between or during passes, on a background thread if
+// --xla_dump_async_threads is set. Asynchronous dumps return no file paths, as
+// they are only known once the dump is written.
+static std::vector<std::string> DumpHloModuleForPassImpl(
+    const HloModule& module, std::string prefix, std::string suffix,
+    const CanonicalDebugOptions& opts) {
+  // Dumps to stdout stay synchronous to keep them in order with other output.
+  if (opts.dump_async_threads <= 0 || opts.dumping_to_stdout() ||
+      !module.has_entry_computation()) {
+    return DumpHloModuleImpl(module, module.unique_id(),
+                             /*buffer_assn=*/nullptr, prefix, suffix, opts);
+  }
+  // Cloning shares constants and backend configs with `module`, and is cheaper
+  // than printing or serializing it. The clone keeps the names and ids of the
+  // module's computations and instructions.
+  std::unique_ptr<HloModule> snapshot = module.Clone(/*suffix=*/"");
+  AsyncHloModuleDumper::GetOrCreate(opts.dump_async_threads)
+      .Schedule(std::move(snapshot), module.unique_id(), std::move(prefix),
+                std::move(suffix), opts);
+  return {};
+}
+
+// Converts per-pass metadata into a trace in the Chrome trace event format,
+// which can be opened in Perfetto (ui.perfetto.dev). Every pass becomes a
+// complete event; nested passes (e.g. fixed point iterations) are nested in
+// the timeline because they share a track with the enclosing pass.
+static std::string HloModuleMetadataToTraceJson(
+    const HloModuleMetadataProto& metadata) {
+  auto escape = [](absl::string_view s) {
+    return absl::StrReplaceAll(s, {{"\\", "\\\\"}, {"\"", "\\\""}});
+  };
+  std::vector<std::string> events;
+  events.reserve(metadata.pass_metadata_size());
+  for (const HloPassMetadata& pass : metadata.pass_metadata()) {
+    events.push_back(absl::StrFormat(
+        "{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":%d,"
+        "\"tid\":0,\"ts\":%d,\"dur\":%d,\"args\":{\"pass_id\":%d,"
+        "\"module_changed\":%s,\"cpu_time_usec\":%d,"
+        "\"peak_rss_delta_bytes\":%d,\"instruction_count_before\":%d,"
+        "\"instruction_count_after\":%d}}",
+        escape(pass.pass_name()), escape(pass.pipeline_name()),
+        metadata.canonical_module_id(), pass.start_timestamp_usec(),
+        pass.end_timestamp_usec() - pass.start_timestamp_usec(),
+        pass.pass_id(), pass.module_changed() ? "true" : "false",
+        pass.cpu_time_usec(), pass.peak_rss_delta_bytes(),
+        pass.instruction_count_before(), pass.instruction_count_after()));
+  }
+  return absl::StrCat("{\"traceEvents\":[\n", absl::StrJoin(events, ",\n"),
+                      "\n]}\n");
+}
+
 static void DumpHloModuleMetadata(
     const HloModuleMetadataProto& metadata, const CanonicalDebugOptions& opts,
     absl::flat_hash_set<int64_t>* dumped_module_ids) {
@@ -580,6 +745,9 @@ static void DumpHloModuleMetadata(
   } else {
     LOG(ERROR) << "Failed to convert HloModuleMetadataProto to text.";
   }
+  DumpToFileInDirImpl(absl::StrFormat("module_%04d.passes.trace.json",
+                                      metadata.canonical_module_id()),
+                      HloModuleMetadataToTraceJson(metadata), opts);
 }
 
 static absl::Mutex mu(absl::kConstInit);
@@ -616,8 +784,9 @@ std::vector<std::string> DumpHloModuleIfEnabledImpl(
     string_view name) {
   CanonicalDebugOptions opts(module.config().debug_options());
   if (opts.should_dump_module(module.name())) {
-    std::vector<std::string> filepaths = DumpHloModuleImpl(
-        module, /*buffer_assn=*/buffer_assn, TimestampFor(module), name, opts);
+    std::vector<std::string> filepaths =
+        DumpHloModuleImpl(module, module.unique_id(), buffer_assn,
+                          TimestampFor(module), name, opts);
     std::optional<std::string> maybe_debug_options_filepath =
         DumpNonDefaultDebugOptions(module, kNonDefaultDebugOptionsDumpSuffix);
     if (maybe_debug_options_filepath.has_value()) {
@@ -941,8 +1110,9 @@ std::vector<std::string> DumpHloModuleProtoIfEnabled(
 
   CanonicalDebugOptions opts(module->config().debug_options());
   if (opts.should_dump_module(module->name())) {
-    return DumpHloModuleImpl(*module, /*buffer_assn=*/nullptr,
-                             TimestampFor(*module), name, opts);
+    return DumpHloModuleImpl(*module, module->unique_id(),
+                             /*buffer_assn=*/nullptr, TimestampFor(*module),
+                             name, opts);
   }
   return {};
 }
@@ -1006,8 +1176,8 @@ std::vector<std::string> DumpHloModuleBetweenPassesIfEnabled(
   std::string filename_suffix =
       StrFormat("%04d.%s.after_%s.before_%s", step_number, pipeline_name,
                 after_pass_name, before_pass_name);
-  return DumpHloModuleImpl(module, /*buffer_assn=*/nullptr, timestamp,
-                           filename_suffix, opts);
+  return DumpHloModuleForPassImpl(module, std::move(timestamp),
+                                  std::move(filename_suffix), opts);
 }
 
 void DumpHloModuleDuringPassIfEnabled(string_view pass_name,
@@ -1024,8 +1194,14 @@ void DumpHloModuleDuringPassIfEnabled(string_view pass_name,
 
   std::string filename_suffix =
       StrFormat("%04d.%s.%s", step_number, pass_name, step_name);
-  DumpHloModuleImpl(module, /*buffer_assn=*/nullptr, timestamp, filename_suffix,
-                    opts);
+  DumpHloModuleForPassImpl(module, std::move(timestamp),
+                           std::move(filename_suffix), opts);
+}
+
+void WaitForPendingHloDumps() {
+  if (AsyncHloModuleDumper* dumper = AsyncHloModuleDumper::Get()) {
+    dumper->WaitForPendingDumps();
+  }
 }
 
 void DumpHloSnapshotIfEnabled(const HloModule& module,
@@ -134,7 +134,8 @@ std::vector<std::string> DumpHloModuleProtoIfEnabled(
 
 // Dumps the given HLO module after running one HLO pass and before running
 // another, if that's enabled. Returns the full file paths of all dumps of the
-// module, or an empty vector if nothing was dumped.
+// module, or an empty vector if nothing was dumped or the module is dumped in
+// the background (see --xla_dump_async_threads).
 std::vector<std::string> DumpHloModuleBetweenPassesIfEnabled(
     absl::string_view pipeline_name, absl::string_view before_pass_name,
     absl::string_view after_pass_name, const HloModule& module);
@@ -147,6 +148,10 @@ void DumpHloModuleDuringPassIfEnabled(absl::string_view pass_name,
                                       absl::string_view step,
                                       const HloModule& module);
 
+// Blocks until the dumps written in the background because of
+// --xla_dump_async_threads are done.
+void WaitForPendingHloDumps();
+
 // Dumps the given HloSnapshot to the module's xla_dump_dir, if this is enabled.
 //
 // Prefer the first overload below, as this will give filenames that are
@@ -155,6 +155,44 @@ TEST(DumpHloModule, WithBufferAssignment) {
   EXPECT_TRUE(ReadFileToString(env, paths[3], &data).ok());
 }
 
+TEST(DumpHloModuleBetweenPasses, DumpsAsynchronously) {
+  HloModuleConfig config;
+  DebugOptions options = config.debug_options();
+  auto env = tsl::Env::Default();
+  std::string dump_dir;
+  ASSERT_TRUE(env->LocalTempFilename(&dump_dir));
+  options.set_xla_dump_to(dump_dir);
+  options.set_xla_dump_hlo_as_text(true);
+  options.set_xla_dump_hlo_pass_re(".*");
+  options.set_xla_dump_async_threads(2);
+  options.set_xla_dump_async_max_pending_modules(1);
+  config.set_debug_options(options);
+  const char* kModuleStr = R"(
+    HloModule m
+    test {
+      p0 = s32[11] parameter(0)
+      ROOT x = s32[11] multiply(p0, p0)
+    }
+  )";
+  TF_ASSERT_OK_AND_ASSIGN(auto m,
+                          ParseAndReturnUnverifiedModule(kModuleStr, config));
+  EXPECT_THAT(DumpHloModuleBetweenPassesIfEnabled("pipeline", "second_pass",
+                                                  "first_pass", *m),
+              IsEmpty());
+  // The dump is written from a snapshot of the module.
+  m.reset();
+  WaitForPendingHloDumps();
+
+  std::vector<std::string> paths;
+  TF_ASSERT_OK(env->GetMatchingPaths(
+      tsl::io::JoinPath(dump_dir, "*after_first_pass.before_second_pass.txt"),
+      &paths));
+  ASSERT_EQ(paths.size(), 1);
+  std::string data;
+  TF_ASSERT_OK(tsl::ReadFileToString(env, paths[0], &data));
+  EXPECT_TRUE(absl::StrContains(data, "multiply(p0, p0)"));
+}
+
 TEST(DumpTest, NoDumpingToFileWhenNotEnabled) {
   std::string filename =
       tsl::io::JoinPath(tsl::testing::TmpDir(), "disable_override");
@@ -19,10 +19,12 @@ limitations under the License.
 #include <array>
 #include <cmath>
 #include <cstdint>
+#include <memory>
 #include <optional>
 #include <string>
 #include <utility>
 #include <variant>
+#include <vector>
 
 #include "absl/base/const_init.h"
 #include "absl/base/thread_annotations.h"
@@ -36,6 +38,8 @@ limitations under the License.
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
 #include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "absl/types/span.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/SHA256.h"
 #include "xla/autotune_results.pb.h"
@@ -76,6 +80,12 @@ static auto& autotune_cache ABSL_GUARDED_BY(autotune_cache_mu) =
 static AutotunerUtil::CacheStats autotune_cache_stats
     ABSL_GUARDED_BY(autotune_cache_mu);
 
+static absl::Mutex remote_cache_mu(absl::kConstInit);
+static auto& remote_cache ABSL_GUARDED_BY(remote_cache_mu) =
+    *new std::shared_ptr<RemoteAutotuneCache>();
+static absl::Duration remote_cache_lease_duration
+    ABSL_GUARDED_BY(remote_cache_mu) = absl::Minutes(5);
+
 absl::StatusOr<std::string> GetBase64EncodedSha256Hash(absl::string_view s) {
   llvm::SHA256 sha256;
   sha256.update(llvm::StringRef(s));
@@ -118,6 +128,29 @@ ResultAndInserted AddResultToInMemoryCache(const AutotuneCacheKey& key,
   return {it->second, inserted};
 }
 
+std::pair<std::shared_ptr<RemoteAutotuneCache>, absl::Duration>
+GetRemoteCache() ABSL_LOCKS_EXCLUDED(remote_cache_mu) {
+  absl::MutexLock lock(&remote_cache_mu);
+  return {remote_cache, remote_cache_lease_duration};
+}
+
+// Stores `result` in the remote cache if it is set, and returns the result
+// that ended up in the remote cache. Remote cache errors are not fatal.
+std::optional<AutotuneResult> AddResultToRemoteCacheIfEnabled(
+    const AutotuneCacheKey& key, const AutotuneResult& result) {
+  std::shared_ptr<RemoteAutotuneCache> cache = GetRemoteCache().first;
+  if (cache == nullptr) {
+    return std::nullopt;
+  }
+  absl::StatusOr<AutotuneResult> stored = cache->PutIfAbsent(key, result);
+  if (!stored.ok()) {
+    LOG(WARNING) << "Failed to add autotune result to the remote cache: "
+                 << stored.status();
+    return std::nullopt;
+  }
+  return *std::move(stored);
+}
+
 absl::Status AddResultToFileBasedCacheIfEnabled(
     const AutotuneCacheKey& key, AutotuneResult result,
     absl::string_view cache_dir,
@@ -168,6 +201,14 @@ absl::StatusOr<ResultAndInserted> AddResultToCaches(
     ABSL_LOCKS_EXCLUDED(autotune_cache_mu) {
   ResultAndInserted result_and_inserted = AddResultToInMemoryCache(key, result);
   if (result_and_inserted.inserted) {
+    // If another process was first to add a result to the remote cache, use
+    // its result instead, so that all processes compile the same code.
+    if (std::optional<AutotuneResult> remote_result =
+            AddResultToRemoteCacheIfEnabled(key, result_and_inserted.result)) {
+      absl::MutexLock lock(&autotune_cache_mu);
+      autotune_cache[key] = *remote_result;
+      result_and_inserted.result = *std::move(remote_result);
+    }
     TF_RETURN_IF_ERROR(AddResultToFileBasedCacheIfEnabled(
         key, result_and_inserted.result, cache_dir, autotune_cache_mode));
   }
@@ -214,6 +255,65 @@ TryToFindInFileBasedCacheIfEnabled(const AutotuneCacheKey& key,
   return result;
 }
 
+std::optional<AutotuneResult> TryToFindInRemoteCacheIfEnabled(
+    const AutotuneCacheKey& key) {
+  std::shared_ptr<RemoteAutotuneCache> cache = GetRemoteCache().first;
+  if (cache == nullptr) {
+    return std::nullopt;
+  }
+  absl::StatusOr<std::vector<std::optional<AutotuneResult>>> results =
+      cache->Get({key});
+  if (!results.ok()) {
+    LOG(WARNING) << "Failed to look up autotune result in the remote cache: "
+                 << results.status();
+    return std::nullopt;
+  }
+  if (results->size() != 1) {
+    LOG(WARNING) << "Remote autotune cache returned " << results->size()
+                 << " results for a single key";
+    return std::nullopt;
+  }
+  return std::move(results->front());
+}
+
+// If another process holds the remote cache lease for `key`, waits until it
+// publishes its result or the lease expires. Returns std::nullopt if this
+// process has to autotune `key` itself.
+std::optional<AutotuneResult> WaitForLeasedResultInRemoteCache(
+    const AutotuneCacheKey& key) {
+  auto [cache, lease_duration] = GetRemoteCache();
+  if (cache == nullptr) {
+    return std::nullopt;
+  }
+
+  absl::StatusOr<bool> acquired = cache->TryAcquireLease(key, lease_duration);
+  if (!acquired.ok()) {
+    LOG(WARNING) << "Failed to acquire autotune lease in the remote cache: "
+                 << acquired.status();
+    return std::nullopt;
+  }
+  if (*acquired) {
+    return std::nullopt;
+  }
+
+  VLOG(1) << "Waiting for another process to autotune: " << key.ToString();
+  absl::Time deadline = absl::Now() + lease_duration;
+  absl::Duration poll_interval = absl::Milliseconds(100);
+  while (absl::Now() < deadline) {
+    absl::SleepFor(std::min(poll_interval, deadline - absl::Now()));
+    poll_interval = std::min(2 * poll_interval, absl::Seconds(5));
+    if (std::optional<AutotuneResult> result =
+            TryToFindInRemoteCacheIfEnabled(key)) {
+      return result;
+    }
+  }
+
+  LOG(WARNING) << "Autotune lease expired without a result, autotuning "
+                  "locally: "
+               << key.ToString();
+  return std::nullopt;
+}
+
 // Sort the results so that they're deterministic.
 void SortAutotuneResults(AutotuneResults* results) {
   std::sort(results->mutable_results()->pointer_begin(),
@@ -363,7 +463,7 @@ AutotuneCacheKey::AutotuneCacheKey(absl::string_view model_str,
 }
 
 namespace {
-enum class CacheType { kNone, kInMemory, kOnDisk };
+enum class CacheType { kNone, kInMemory, kOnDisk, kRemote };
 
 absl::StatusOr<std::pair<CacheType, std::optional<AutotuneResult>>>
 TryFindInAllCacheTypes(const AutotuneCacheKey& key, absl::string_view cache_dir)
@@ -380,6 +480,12 @@ TryFindInAllCacheTypes(const AutotuneCacheKey& key, absl::string_view cache_dir)
     return std::make_pair(CacheType::kOnDisk, opt_result);
   }
 
+  opt_result = TryToFindInRemoteCacheIfEnabled(key);
+  if (opt_result.has_value()) {
+    AddResultToInMemoryCache(key, opt_result.value());
+    return std::make_pair(CacheType::kRemote, opt_result);
+  }
+
   return std::make_pair(CacheType::kNone, std::nullopt);
 }
 
@@ -401,6 +507,9 @@ absl::StatusOr<std::optional<AutotuneResult>> TryFindInCache(
       case CacheType::kOnDisk:
         LOG(INFO) << "File-based autotune cache hit" << logged_key;
         break;
+      case CacheType::kRemote:
+        LOG(INFO) << "Remote autotune cache hit" << logged_key;
+        break;
     }
   }
 
@@ -422,6 +531,7 @@ AutotuneConfig AutotuneConfig::FromDebugOptions(
   bool should_reinit_output_buffer = autotune_level >= 3;
   bool should_check_correctness = autotune_level >= 4;
   bool should_skip_wrong_results = autotune_level >= 5;
+  bool should_check_winner_only = opts.xla_gpu_autotune_check_winner_only();
 
   bool should_crash_on_check_failure =
       opts.xla_gpu_crash_on_verification_failures();
@@ -439,7 +549,8 @@ AutotuneConfig AutotuneConfig::FromDebugOptions(
                         should_skip_wrong_results,
                         should_crash_on_check_failure, exhaustive_tiling_search,
                         should_require_complete_aot_autotune_results,
-                        autotune_cache_dir, autotune_cache_mode);
+                        autotune_cache_dir, autotune_cache_mode,
+                        should_check_winner_only);
 }
 
 /*static*/ AutotuneCacheKey AutotunerUtil::GetKey(
@@ -454,6 +565,12 @@ AutotuneConfig AutotuneConfig::FromDebugOptions(
   return opt_res.has_value();
 }
 
+/*static*/ absl::StatusOr<std::optional<AutotuneResult>>
+AutotunerUtil::FindInCache(const AutotuneCacheKey& key,
+                           const AutotuneConfig& config) {
+  return TryFindInCache(key, config.autotune_cache_dir());
+}
+
 /*static*/ absl::StatusOr<bool> AutotunerUtil::AddResult(
     const AutotuneCacheKey& key, AutotuneResult result,
     const AutotuneConfig& config) {
@@ -464,6 +581,55 @@ AutotuneConfig AutotuneConfig::FromDebugOptions(
   return result_and_inserted.inserted;
 }
 
+/*static*/ void AutotunerUtil::SetRemoteCache(
+    std::shared_ptr<RemoteAutotuneCache> cache, absl::Duration lease_duration) {
+  absl::MutexLock lock(&remote_cache_mu);
+  remote_cache = std::move(cache);
+  remote_cache_lease_duration = lease_duration;
+}
+
+/*static*/ absl::Status AutotunerUtil::PrefetchFromRemoteCache(
+    absl::Span<const AutotuneCacheKey> keys) {
+  std::shared_ptr<RemoteAutotuneCache> cache = GetRemoteCache().first;
+  if (cache == nullptr) {
+    return absl::OkStatus();
+  }
+
+  std::vector<AutotuneCacheKey> missing_keys;
+  {
+    absl::MutexLock lock(&autotune_cache_mu);
+    for (const AutotuneCacheKey& key : keys) {
+      if (!autotune_cache.contains(key)) {
+        missing_keys.push_back(key);
+      }
+    }
+  }
+  if (missing_keys.empty()) {
+    return absl::OkStatus();
+  }
+
+  absl::StatusOr<std::vector<std::optional<AutotuneResult>>> results =
+      cache->Get(missing_keys);
+  if (!results.ok()) {
+    LOG(WARNING) << "Failed to prefetch autotune results from the remote "
+                    "cache: "
+                 << results.status();
+    return absl::OkStatus();
+  }
+  TF_RET_CHECK(results->size() == missing_keys.size());
+
+  int64_t num_found = 0;
+  for (int64_t i = 0; i < missing_keys.size(); ++i) {
+    if ((*results)[i].has_value()) {
+      AddResultToInMemoryCache(missing_keys[i], *std::move((*results)[i]));
+      ++num_found;
+    }
+  }
+  VLOG(1) << "Prefetched " << num_found << " of " << missing_keys.size()
+          << " autotune results from the remote cache";
+  return absl::OkStatus();
+}
+
 /*static*/ absl::StatusOr<AutotuneResult> AutotunerUtil::Autotune(
     const HloInstruction* instr, const AutotuneConfig& config,
     const AutotuneNoCacheFn& autotune_fn) {
@@ -485,6 +651,13 @@ AutotuneConfig AutotuneConfig::FromDebugOptions(
     return s;
   }
 
+  // Wait for the result instead of autotuning if another process is already
+  // autotuning the same key.
+  if (std::optional<AutotuneResult> leased_result =
+          WaitForLeasedResultInRemoteCache(key)) {
+    return AddResultToInMemoryCache(key, *std::move(leased_result)).result;
+  }
+
   TF_ASSIGN_OR_RETURN(AutotuneResult autotune_result, autotune_fn());
 
   TF_ASSIGN_OR_RETURN(ResultAndInserted result_and_inserted,
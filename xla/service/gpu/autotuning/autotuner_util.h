@@ -23,6 +23,7 @@ limitations under the License.
 #include <string>
 #include <utility>
 #include <variant>
+#include <vector>
 
 #include "absl/container/flat_hash_set.h"
 #include "absl/log/check.h"
@@ -30,6 +31,8 @@ limitations under the License.
 #include "absl/status/statusor.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/string_view.h"
+#include "absl/time/time.h"
+#include "absl/types/span.h"
 #include "xla/autotune_results.pb.h"
 #include "xla/autotuning.pb.h"
 #include "xla/hlo/ir/hlo_instruction.h"
@@ -172,6 +175,9 @@ class AutotuneConfig {
   }
   bool should_check_correctness() const { return should_check_correctness_; }
   bool should_skip_wrong_results() const { return should_skip_wrong_results_; }
+  // Whether correctness checks are only run for the reference and the best
+  // candidate instead of for every candidate.
+  bool should_check_winner_only() const { return should_check_winner_only_; }
   bool should_crash_on_check_failure() const {
     return should_crash_on_check_failure_;
   }
@@ -191,7 +197,8 @@ class AutotuneConfig {
                  bool exhaustive_tiling_search,
                  bool should_require_complete_aot_autotune_results,
                  absl::string_view autotune_cache_dir,
-                 DebugOptions::AutotuneCacheMode autotune_cache_mode)
+                 DebugOptions::AutotuneCacheMode autotune_cache_mode,
+                 bool should_check_winner_only = false)
       : config_(config),
         should_init_buffers_(should_init_buffers),
         should_reinit_output_buffer_(should_reinit_output_buffer),
@@ -202,7 +209,8 @@ class AutotuneConfig {
         should_require_complete_aot_autotune_results_(
             should_require_complete_aot_autotune_results),
         autotune_cache_dir_(autotune_cache_dir),
-        autotune_cache_mode_(autotune_cache_mode) {}
+        autotune_cache_mode_(autotune_cache_mode),
+        should_check_winner_only_(should_check_winner_only) {}
 
   // Derives the autotune config parameters from the DebugOptions `opts`.
   static AutotuneConfig FromDebugOptions(const DeviceOrDevicelessConfig& config,
@@ -246,10 +254,40 @@ class AutotuneConfig {
   bool should_require_complete_aot_autotune_results_;
   std::string autotune_cache_dir_;
   DebugOptions::AutotuneCacheMode autotune_cache_mode_;
+  bool should_check_winner_only_;
 };
 
 using AutotuneNoCacheFn = std::function<absl::StatusOr<AutotuneResult>()>;
 
+// Autotune cache shared by many XLA processes, e.g. a key-value service that
+// all jobs of a fleet can reach. A result autotuned by one process is then
+// reused by every other process compiling the same fusion for the same device.
+//
+// All methods must be thread safe. Errors returned by a remote cache are not
+// fatal: XLA logs them and falls back to autotuning locally.
+class RemoteAutotuneCache {
+ public:
+  virtual ~RemoteAutotuneCache() = default;
+
+  // Looks up the results of all `keys` in a single request. Returns a vector
+  // with an entry for every key, which is `std::nullopt` on a cache miss.
+  virtual absl::StatusOr<std::vector<std::optional<AutotuneResult>>> Get(
+      absl::Span<const AutotuneCacheKey> keys) = 0;
+
+  // Atomically stores `result` for `key`, unless the cache already has a
+  // result for `key`. Returns the result stored in the cache, so that all
+  // processes agree on the result of the first tuner.
+  virtual absl::StatusOr<AutotuneResult> PutIfAbsent(
+      const AutotuneCacheKey& key, const AutotuneResult& result) = 0;
+
+  // Tries to acquire a lease for autotuning `key` that expires after
+  // `duration`. Returns true if the caller holds the lease and should autotune
+  // `key`, and false if another process holds it and the result should appear
+  // in the cache soon.
+  virtual absl::StatusOr<bool> TryAcquireLease(const AutotuneCacheKey& key,
+                                               absl::Duration duration) = 0;
+};
+
 struct AutotunerUtil {
   static absl::StatusOr<AutotuneResult> Autotune(
       const HloInstruction* instr, const AutotuneConfig& config,
@@ -267,6 +305,12 @@ struct AutotunerUtil {
   static absl::StatusOr<bool> IsInCache(const AutotuneCacheKey& key,
                                         const AutotuneConfig& config);
 
+  // Returns the cached result for the key, if any.
+  //
+  // Normally, we don't have to use this low level method.
+  static absl::StatusOr<std::optional<AutotuneResult>> FindInCache(
+      const AutotuneCacheKey& key, const AutotuneConfig& config);
+
   // Adds the result to the autotune cache.
   //
   // Returns true if the entry is inserted.
@@ -276,6 +320,20 @@ struct AutotunerUtil {
                                         AutotuneResult result,
                                         const AutotuneConfig& config);
 
+  // Sets the remote cache that is consulted after the in-memory and the file
+  // based caches, and that receives every newly autotuned result. If another
+  // process holds the lease for a key, Autotune() waits up to
+  // `lease_duration` for its result before autotuning locally. Passing
+  // nullptr disables the remote cache.
+  static void SetRemoteCache(std::shared_ptr<RemoteAutotuneCache> cache,
+                             absl::Duration lease_duration = absl::Minutes(5));
+
+  // Loads the results of `keys` that are missing from the in-memory cache
+  // from the remote cache, with a single batched lookup. Does nothing if no
+  // remote cache is set.
+  static absl::Status PrefetchFromRemoteCache(
+      absl::Span<const AutotuneCacheKey> keys);
+
   // Functions to save/load XLA's autotuning results.
   //
   // This is used for ahead-of-time autotuning.  Specifically:
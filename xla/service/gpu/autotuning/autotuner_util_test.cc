@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "xla/service/gpu/autotuning/autotuner_util.h"
 
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <string>
@@ -22,6 +23,8 @@ limitations under the License.
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/hash/hash_testing.h"
 #include "absl/log/check.h"
@@ -29,6 +32,9 @@ limitations under the License.
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "absl/types/span.h"
 #include "xla/autotune_results.pb.h"
 #include "xla/autotuning.pb.h"
 #include "xla/hlo/ir/hlo_computation.h"
@@ -569,6 +575,152 @@ TEST_F(FileBasedCacheTest, AddResultDoesNotWriteTheFileInReadMode) {
             0);  // wasn't dumped to file based cache.
 }
 
+// Remote cache backed by in-memory maps, that can simulate a lease held by
+// another process.
+class FakeRemoteAutotuneCache : public RemoteAutotuneCache {
+ public:
+  absl::StatusOr<std::vector<std::optional<AutotuneResult>>> Get(
+      absl::Span<const AutotuneCacheKey> keys) override {
+    absl::MutexLock lock(&mu_);
+    ++num_gets_;
+    std::vector<std::optional<AutotuneResult>> results;
+    for (const AutotuneCacheKey& key : keys) {
+      auto it = results_.find(key);
+      results.push_back(it == results_.end()
+                            ? std::nullopt
+                            : std::make_optional(it->second));
+    }
+    return results;
+  }
+
+  absl::StatusOr<AutotuneResult> PutIfAbsent(
+      const AutotuneCacheKey& key, const AutotuneResult& result) override {
+    absl::MutexLock lock(&mu_);
+    return results_.emplace(key, result).first->second;
+  }
+
+  absl::StatusOr<bool> TryAcquireLease(const AutotuneCacheKey& key,
+                                       absl::Duration duration) override {
+    absl::MutexLock lock(&mu_);
+    if (leased_result_.has_value()) {
+      // The lease holder publishes its result right after the lease request.
+      results_.emplace(key, *leased_result_);
+      return false;
+    }
+    return true;
+  }
+
+  void Put(const AutotuneCacheKey& key, const AutotuneResult& result) {
+    absl::MutexLock lock(&mu_);
+    results_[key] = result;
+  }
+
+  std::optional<AutotuneResult> Find(const AutotuneCacheKey& key) {
+    absl::MutexLock lock(&mu_);
+    auto it = results_.find(key);
+    if (it == results_.end()) return std::nullopt;
+    return it->second;
+  }
+
+  // Simulates another process that holds the lease for every key and
+  // eventually autotunes it to `result`.
+  void SetLeasedResult(const AutotuneResult& result) {
+    absl::MutexLock lock(&mu_);
+    leased_result_ = result;
+  }
+
+  int64_t num_gets() {
+    absl::MutexLock lock(&mu_);
+    return num_gets_;
+  }
+
+ private:
+  absl::Mutex mu_;
+  absl::flat_hash_map<AutotuneCacheKey, AutotuneResult> results_
+      ABSL_GUARDED_BY(mu_);
+  std::optional<AutotuneResult> leased_result_ ABSL_GUARDED_BY(mu_);
+  int64_t num_gets_ ABSL_GUARDED_BY(mu_) = 0;
+};
+
+class RemoteCacheTest : public FileBasedCacheTest {
+ public:
+  void SetUp() override {
+    FileBasedCacheTest::SetUp();
+    AutotunerUtil::SetRemoteCache(remote_cache_);
+  }
+
+  void TearDown() override { AutotunerUtil::SetRemoteCache(nullptr); }
+
+  std::shared_ptr<FakeRemoteAutotuneCache> remote_cache_ =
+      std::make_shared<FakeRemoteAutotuneCache>();
+};
+
+TEST_F(RemoteCacheTest, AutotuneReadsResultFromTheRemoteCache) {
+  remote_cache_->Put(GetCacheKey(), result1_);
+
+  bool cache_hit = true;
+  TF_ASSERT_OK_AND_ASSIGN(AutotuneResult result,
+                          AutotunerUtil::Autotune(dot_, GetConfig(), [&] {
+                            cache_hit = false;
+                            return result2_;
+                          }));
+
+  EXPECT_TRUE(cache_hit);
+  EXPECT_EQ(AutotunerUtil::GetCacheStats().cache_hits, 1);
+  EXPECT_EQ(ToString(result), ToString(result1_));
+}
+
+TEST_F(RemoteCacheTest, AutotuneWritesResultToTheRemoteCache) {
+  TF_ASSERT_OK_AND_ASSIGN(
+      AutotuneResult result,
+      AutotunerUtil::Autotune(dot_, GetConfig(), [&] { return result1_; }));
+
+  EXPECT_EQ(ToString(result), ToString(result1_));
+  std::optional<AutotuneResult> remote_result =
+      remote_cache_->Find(GetCacheKey());
+  ASSERT_TRUE(remote_result.has_value());
+  EXPECT_EQ(ToString(*remote_result), ToString(result1_));
+}
+
+TEST_F(RemoteCacheTest, FirstResultInTheRemoteCacheWins) {
+  // Another process added its result to the remote cache first.
+  remote_cache_->Put(GetCacheKey(), result1_);
+  TF_ASSERT_OK(AutotunerUtil::AddResult(GetCacheKey(), result2_, GetConfig())
+                   .status());
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      AutotuneResult result,
+      AutotunerUtil::Autotune(dot_, GetConfig(), [&] { return result2_; }));
+  EXPECT_EQ(ToString(result), ToString(result1_));
+  EXPECT_EQ(Read(GetCacheFilePath()), ToString(result1_));
+}
+
+TEST_F(RemoteCacheTest, AutotuneWaitsForTheLeaseHolder) {
+  remote_cache_->SetLeasedResult(result1_);
+
+  bool autotuned = false;
+  TF_ASSERT_OK_AND_ASSIGN(AutotuneResult result,
+                          AutotunerUtil::Autotune(dot_, GetConfig(), [&] {
+                            autotuned = true;
+                            return result2_;
+                          }));
+
+  EXPECT_FALSE(autotuned);
+  EXPECT_EQ(ToString(result), ToString(result1_));
+}
+
+TEST_F(RemoteCacheTest, PrefetchUsesASingleBatchedLookup) {
+  remote_cache_->Put(GetCacheKey(), result1_);
+
+  TF_ASSERT_OK(AutotunerUtil::PrefetchFromRemoteCache({GetCacheKey()}));
+  EXPECT_EQ(remote_cache_->num_gets(), 1);
+
+  // The prefetched result is served from the in-memory cache.
+  EXPECT_THAT(AutotunerUtil::IsInCache(GetCacheKey(), GetConfig()),
+              IsOkAndHolds(true));
+  EXPECT_EQ(remote_cache_->num_gets(), 1);
+}
+
 }  // namespace
 }  // namespace gpu
 }  // namespace xla
@@ -21,20 +21,28 @@ limitations under the License.
 #include <optional>
 #include <string>
 #include <utility>
+#include <variant>
 #include <vector>
 
+#include "absl/algorithm/container.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/log/check.h"
 #include "absl/log/log.h"
+#include "absl/status/statusor.h"
 #include "absl/strings/str_format.h"
+#include "absl/time/time.h"
+#include "absl/types/span.h"
 #include "llvm/ADT/STLExtras.h"
 #include "xla/hlo/ir/hlo_instructions.h"
 #include "xla/hlo/ir/hlo_opcode.h"
 #include "xla/hlo/utils/hlo_traversal.h"
 #include "xla/primitive_util.h"
 #include "xla/service/gpu/matmul_utils.h"
+#include "xla/service/gpu/model/gpu_dot_fusion_cost_model.h"
+#include "xla/service/gpu/model/tiled_hlo_computation.h"
 #include "xla/shape.h"
 #include "xla/shape_util.h"
+#include "xla/stream_executor/cuda/cuda_compute_capability.h"
 #include "xla/stream_executor/device_description.h"
 #include "xla/tsl/lib/core/bits.h"
 #include "xla/util.h"
@@ -77,6 +85,53 @@ int64_t PreviousPowerOfTwo(int64_t x) {
   return tsl::NextPowerOfTwoS64(x + 1) / 2;
 }
 
+// Returns the number of consecutive elements that share a scaling factor, if
+// `instr` merges a dimension of block-scaled data (e.g. MXFP8 or
+// group-quantized int4 weights) with the dimension along which the scales
+// were broadcast to the blocks:
+//   [m,k/b] scales -> [m,k/b,b] broadcast -> (multiply) -> [m,k] bitcast.
+std::optional<int64_t> GetScaleBlockSize(const HloInstruction& instr) {
+  if (instr.opcode() != HloOpcode::kBitcast &&
+      instr.opcode() != HloOpcode::kReshape) {
+    return std::nullopt;
+  }
+  const Shape& shape = instr.operand(0)->shape();
+  absl::Span<const int64_t> dims = shape.dimensions();
+  absl::Span<const int64_t> merged_dims = instr.shape().dimensions();
+  if (dims.size() != merged_dims.size() + 1) {
+    return std::nullopt;
+  }
+  // The block dimension `block_dim` is merged into the one before it.
+  int64_t block_dim = 1;
+  while (block_dim < dims.size() &&
+         dims[block_dim - 1] == merged_dims[block_dim - 1]) {
+    ++block_dim;
+  }
+  if (block_dim == dims.size() || dims[block_dim] == 1 ||
+      merged_dims[block_dim - 1] != dims[block_dim - 1] * dims[block_dim] ||
+      dims.subspan(block_dim + 1) != merged_dims.subspan(block_dim)) {
+    return std::nullopt;
+  }
+  // The merged data has to be scaled by a broadcast along `block_dim` only,
+  // possibly through elementwise operations (e.g. the dequantizing multiply).
+  std::vector<const HloInstruction*> worklist = {instr.operand(0)};
+  while (!worklist.empty()) {
+    const HloInstruction* producer = worklist.back();
+    worklist.pop_back();
+    if (producer->opcode() == HloOpcode::kBroadcast &&
+        ShapeUtil::SameDimensions(producer->shape(), shape) &&
+        producer->dimensions().size() == dims.size() - 1 &&
+        !absl::c_linear_search(producer->dimensions(), block_dim)) {
+      return dims[block_dim];
+    }
+    if (producer->IsElementwise()) {
+      worklist.insert(worklist.end(), producer->operands().begin(),
+                      producer->operands().end());
+    }
+  }
+  return std::nullopt;
+}
+
 }  // namespace
 
 TritonDotFusionSearchSpace::TritonDotFusionSearchSpace(
@@ -84,6 +139,7 @@ TritonDotFusionSearchSpace::TritonDotFusionSearchSpace(
     const HloDotInstruction* dot)
     :  // Set up basic information about the hardware and the problem.
       device_description_(device_description),
+      dot_(dot),
       contracting_size_(GetSizeInDimensions(
           dot->operand(0)->shape(),
           dot->dot_dimension_numbers().lhs_contracting_dimensions())),
@@ -106,7 +162,8 @@ TritonDotFusionSearchSpace::TritonDotFusionSearchSpace(
       min_out_tile_(GetMinOutputTile()),
       min_warps_per_cta_(GetMinWarpsPerCta()),
       min_contracting_tile_size_(GetMinContractingTileSize()),
-      max_contracting_split_(GetMaxContractingSplit(max_out_tile_)) {
+      max_contracting_split_(GetMaxContractingSplit(max_out_tile_)),
+      scale_block_size_(GetMinScaleBlockSize()) {
   // Make sure that the range of output tile sizes is not empty
   // (min_output_tile_ is a hard limit, while max_output_tile_ is a soft one).
   max_out_tile_.lhs_dim =
@@ -206,6 +263,61 @@ std::vector<TritonGemmConfig> TritonDotFusionSearchSpace::OptimizeConfigSet(
   return result_configs;
 }
 
+std::optional<absl::Duration> TritonDotFusionSearchSpace::EstimateRunTime(
+    const TritonGemmConfig& config) const {
+  // The cost model is calibrated for NVIDIA GPUs only.
+  if (!std::holds_alternative<se::CudaComputeCapability>(
+          device_description_.gpu_compute_capability())) {
+    return std::nullopt;
+  }
+  BlockLevelParameters block_params;
+  block_params.output_tile_sizes = {{config.block_m, config.block_n}};
+  block_params.num_warps = config.num_warps;
+  block_params.num_ctas = config.num_ctas;
+  block_params.num_stages = config.num_stages;
+  absl::StatusOr<absl::Duration> run_time =
+      GpuDotFusionCostModel::EstimateRunTimeForDotOpWithBlockParameters(
+          dot_, block_params, device_description_);
+  if (!run_time.ok()) {
+    VLOG(5) << "Cannot estimate run time of " << config.ToString() << ": "
+            << run_time.status();
+    return std::nullopt;
+  }
+  return *run_time;
+}
+
+std::vector<TritonGemmConfig>
+TritonDotFusionSearchSpace::PruneConfigsWithCostModel(
+    const std::vector<TritonGemmConfig>& configs,
+    int64_t max_num_configs) const {
+  if (static_cast<int64_t>(configs.size()) <= max_num_configs) {
+    return configs;
+  }
+
+  std::vector<std::pair<absl::Duration, TritonGemmConfig>> ranked_configs;
+  ranked_configs.reserve(configs.size());
+  for (const TritonGemmConfig& config : configs) {
+    std::optional<absl::Duration> run_time = EstimateRunTime(config);
+    if (!run_time.has_value()) {
+      return configs;
+    }
+    ranked_configs.push_back({*run_time, config});
+  }
+  std::stable_sort(
+      ranked_configs.begin(), ranked_configs.end(),
+      [](const auto& a, const auto& b) { return a.first < b.first; });
+
+  std::vector<TritonGemmConfig> result_configs;
+  result_configs.reserve(max_num_configs);
+  for (int64_t i = 0; i < max_num_configs; ++i) {
+    VLOG(10) << "Keeping config ranked by cost model: "
+             << ranked_configs[i].second.ToString()
+             << " estimated run time: " << ranked_configs[i].first;
+    result_configs.push_back(ranked_configs[i].second);
+  }
+  return result_configs;
+}
+
 std::string TritonDotFusionSearchSpace::ToString() const {
   return absl::StrFormat(
       "problem_size_BxMxNxKxE: %dx%dx%dx%dx(%d->%d) "
@@ -235,6 +347,23 @@ bool TritonDotFusionSearchSpace::HasExpensiveTransitiveParent(
   });
 }
 
+std::optional<int64_t> TritonDotFusionSearchSpace::GetMinScaleBlockSize()
+    const {
+  std::optional<int64_t> min_block_size;
+  HloBfsAnyOf({dot_->operand(0), dot_->operand(1)},
+              [&](const HloInstruction* instr) {
+                std::optional<int64_t> block_size = GetScaleBlockSize(*instr);
+                if (block_size.has_value() &&
+                    (!min_block_size.has_value() ||
+                     *block_size < *min_block_size)) {
+                  min_block_size = block_size;
+                }
+                return false;
+              });
+  VLOG(5) << "Computing scale_block_size: " << min_block_size.value_or(0);
+  return min_block_size;
+}
+
 int TritonDotFusionSearchSpace::GetDesiredTotalWarps() const {
   constexpr int kSchedulersPerCore = 4;
   constexpr int kDesiredWarpsPerCore =
@@ -561,6 +690,13 @@ void TritonDotFusionSearchSpace::AddContractingTiling(
   int max_tile_size =
       std::max(GetMaxContractingTileSize({tile_rows, tile_cols}, split),
                min_contracting_tile_size_);
+  if (scale_block_size_.has_value()) {
+    // The emitter loads one scale per block and broadcasts it across the
+    // contracting tile, so the tile cannot span more than one block.
+    max_tile_size = std::max<int64_t>(
+        std::min<int64_t>(max_tile_size, *scale_block_size_),
+        min_contracting_tile_size_);
+  }
   ConfigWithNotes new_config = config;
   for (int k = min_contracting_tile_size_; k <= max_tile_size; k *= 2) {
     new_config.config.block_k = k;
@@ -21,6 +21,7 @@ limitations under the License.
 #include <string>
 #include <vector>
 
+#include "absl/time/time.h"
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_instructions.h"
 #include "xla/service/gpu/matmul_utils.h"
@@ -58,6 +59,20 @@ class TritonDotFusionSearchSpace {
       const std::vector<TritonGemmConfig>& configs,
       const std::vector<TritonGemmConfig>& hints) const;
 
+  // Estimates the run time of `config` with the analytical dot fusion cost
+  // model. Returns std::nullopt if the cost model does not support the dot or
+  // the hardware. The estimate only takes the output tiling into account.
+  std::optional<absl::Duration> EstimateRunTime(
+      const TritonGemmConfig& config) const;
+
+  // Ranks `configs` by their estimated run time and keeps the
+  // `max_num_configs` most promising ones. Configs with equal estimates keep
+  // their relative order. Returns `configs` unchanged if the cost model cannot
+  // estimate them.
+  std::vector<TritonGemmConfig> PruneConfigsWithCostModel(
+      const std::vector<TritonGemmConfig>& configs,
+      int64_t max_num_configs) const;
+
   // Serializes the search space to a human-readable string.
   std::string ToString() const;
 
@@ -111,6 +126,11 @@ class TritonDotFusionSearchSpace {
 
   bool HasExpensiveTransitiveParent(const HloInstruction* operand) const;
 
+  // Finds the smallest number of consecutive elements of the contracting
+  // dimension that share a scaling factor in the block-scaled operands of the
+  // dot, if any.
+  std::optional<int64_t> GetMinScaleBlockSize() const;
+
   // Computes the maximum number of total warps we should have to sufficiently
   // saturate the GPU.
   //
@@ -210,6 +230,7 @@ class TritonDotFusionSearchSpace {
   // The order of these fields is important: the values of those defined earlier
   // are used to compute the values of later ones.
   se::DeviceDescription device_description_;
+  const HloDotInstruction* dot_;
   int64_t contracting_size_;
   int64_t batch_size_;
   int64_t lhs_parallel_size_;
@@ -225,6 +246,7 @@ class TritonDotFusionSearchSpace {
   int min_warps_per_cta_;
   int min_contracting_tile_size_;
   int max_contracting_split_;
+  std::optional<int64_t> scale_block_size_;
 };
 
 }  // namespace xla::gpu
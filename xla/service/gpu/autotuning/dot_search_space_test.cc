@@ -27,6 +27,7 @@ limitations under the License.
 #include "xla/hlo/ir/hlo_instructions.h"
 #include "xla/hlo/testlib/hlo_hardware_independent_test_base.h"
 #include "xla/hlo/testlib/verified_hlo_module.h"
+#include "xla/service/gpu/gpu_device_info_for_tests.h"
 #include "xla/service/gpu/matmul_utils.h"
 #include "xla/stream_executor/cuda/cuda_compute_capability.h"
 #include "xla/stream_executor/device_description.h"
@@ -415,6 +416,28 @@ TEST_F(DotSearchSpaceTest, EnsuresContractingTileSizeFitsInstructonShape) {
               AllOf(Not(IsEmpty()), Each(BlockKIs(Ge(8)))));
 }
 
+TEST_F(DotSearchSpaceTest, LimitsContractingTileSizeToScaleBlockSize) {
+  constexpr const char* kModuleText = R"(
+ENTRY e {
+  p0 = f8e4m3fn[1024,1024] parameter(0)
+  c0 = f32[1024,1024] convert(p0)
+  s0 = f8e8m0fnu[1024,32] parameter(1)
+  c1 = f32[1024,32] convert(s0)
+  b0 = f32[1024,32,32] broadcast(c1), dimensions={0,1}
+  r0 = f32[1024,1024] reshape(b0)
+  m0 = f32[1024,1024] multiply(c0, r0)
+  p1 = f32[1024,1024] parameter(2)
+  ROOT r = f32[1024,1024] dot(m0, p1),
+    lhs_contracting_dims={1}, rhs_contracting_dims={0}
+})";
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<VerifiedHloModule> module,
+                          ParseAndReturnVerifiedModule(kModuleText));
+  TritonDotFusionSearchSpace search_space = MakeSearchSpace(module.get());
+
+  EXPECT_THAT(search_space.GenerateConfigs(),
+              AllOf(Not(IsEmpty()), Each(BlockKIs(Le(32)))));
+}
+
 TEST_F(DotSearchSpaceTest, FindReasonablePipeliningStageCount) {
   TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<VerifiedHloModule> module,
                           GetDefaultDotModule());
@@ -549,5 +572,53 @@ TEST_F(DotSearchSpaceTest, ReturnsNonEmptySetForUnusualHints) {
       Not(IsEmpty()));
 }
 
+class CostModelDotSearchSpaceTest : public DefaultDeviceDotSearchSpaceTest {
+ protected:
+  CostModelDotSearchSpaceTest() {
+    device_description_ = TestGpuDeviceInfo::RTXH100SXMDeviceInfo();
+  }
+};
+
+TEST_F(CostModelDotSearchSpaceTest, PrunesConfigsWithHighEstimatedRunTime) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<VerifiedHloModule> module,
+                          GetDefaultDotModule());
+  TritonDotFusionSearchSpace search_space = MakeSearchSpace(module.get());
+  TritonGemmConfig large_tile = {
+      /*block_m=*/64, /*block_n=*/64,   /*block_k=*/32,
+      /*split_k=*/1,  /*num_stages=*/1, /*num_warps=*/4,
+      /*num_ctas=*/1};
+  TritonGemmConfig small_tile = {
+      /*block_m=*/16, /*block_n=*/16,   /*block_k=*/32,
+      /*split_k=*/1,  /*num_stages=*/1, /*num_warps=*/4,
+      /*num_ctas=*/1};
+  TritonGemmConfig large_tile_deep_k = {
+      /*block_m=*/64, /*block_n=*/64,   /*block_k=*/64,
+      /*split_k=*/1,  /*num_stages=*/1, /*num_warps=*/4,
+      /*num_ctas=*/1};
+
+  ASSERT_TRUE(search_space.EstimateRunTime(small_tile).has_value());
+  EXPECT_GT(*search_space.EstimateRunTime(small_tile),
+            *search_space.EstimateRunTime(large_tile));
+  // Configs with equal estimates keep their relative order.
+  EXPECT_THAT(search_space.PruneConfigsWithCostModel(
+                  {large_tile, small_tile, large_tile_deep_k},
+                  /*max_num_configs=*/2),
+              ElementsAre(large_tile, large_tile_deep_k));
+}
+
+TEST_F(CostModelDotSearchSpaceTest, KeepsConfigsWhenCostModelIsUnavailable) {
+  device_description_ = TestGpuDeviceInfo::AMDMI210DeviceInfo();
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<VerifiedHloModule> module,
+                          GetDefaultDotModule());
+  TritonDotFusionSearchSpace search_space = MakeSearchSpace(module.get());
+  std::vector<TritonGemmConfig> configs = search_space.GenerateConfigs();
+  ASSERT_THAT(configs, SizeIs(Ge(2)));
+
+  EXPECT_FALSE(search_space.EstimateRunTime(configs.front()).has_value());
+  EXPECT_THAT(
+      search_space.PruneConfigsWithCostModel(configs, /*max_num_configs=*/1),
+      ElementsAreArray(configs));
+}
+
 }  // namespace
 }  // namespace xla::gpu
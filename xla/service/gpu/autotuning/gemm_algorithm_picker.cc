@@ -24,6 +24,7 @@ limitations under the License.
 #include <variant>
 #include <vector>
 
+#include "absl/algorithm/container.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -347,6 +348,12 @@ class GemmAutotuner {
         num_algorithms_left_++;
         continue;
       }
+      // Only the reference algorithm is checked here, the others are checked
+      // if they turn out to be the fastest.
+      if (autotune_config_.should_check_winner_only() && reference_algorithm) {
+        num_algorithms_left_++;
+        continue;
+      }
       TF_ASSIGN_OR_RETURN(
           se::RedzoneAllocator::RedzoneCheckStatus rz_check_status,
           rz_buffers_.RedzoneAllocator().CheckRedzones());
@@ -394,6 +401,24 @@ class GemmAutotuner {
 
     absl::StatusOr<AutotuneResult> best =
         PickBestResult(results, gemm->ToString(), hlo_module_config);
+    while (best.ok() && autotune_config_.should_check_correctness() &&
+           autotune_config_.should_check_winner_only()) {
+      auto it = absl::c_find_if(results, [&](const AutotuneResult& r) {
+        return r.gemm().algorithm() == best->gemm().algorithm();
+      });
+      TF_RET_CHECK(it != results.end() && reference_algorithm.has_value());
+      AutotuneResult& result = *it;
+      TF_ASSIGN_OR_RETURN(
+          bool verified,
+          CheckWinner(algorithms[it - results.begin()], output_shape, beta,
+                      comparator, reference_buffer, *reference_algorithm,
+                      result, run_benchmark));
+      if (verified) {
+        best = result;
+        break;
+      }
+      best = PickBestResult(results, gemm->ToString(), hlo_module_config);
+    }
     if (best.ok()) {
       // Note that, cublas-lt returns an opaque object as an algorithm ID,
       // therefore we need to convert it to the index from the algorithms list
@@ -416,6 +441,74 @@ class GemmAutotuner {
                  << best.status();
     return AutotuneResult{};
   }  // GetBestAlgorithm
+
+  // Runs `algorithm` of the fastest candidate `result` again and checks its
+  // redzones and its output against the reference algorithm. Records a
+  // failure in `result`. Returns whether it can still be used.
+  template <typename AlgoT, typename TunedFunc>
+  absl::StatusOr<bool> CheckWinner(const AlgoT& algorithm,
+                                   const Shape& output_shape, double beta,
+                                   const BufferComparator& comparator,
+                                   se::DeviceMemoryBase reference_buffer,
+                                   int64_t reference_algorithm,
+                                   AutotuneResult& result,
+                                   TunedFunc&& run_benchmark) {
+    if (result.gemm().algorithm() == reference_algorithm) {
+      return true;  // Already checked.
+    }
+    // Reset the redzones, which a slower candidate may have written to.
+    TF_ASSIGN_OR_RETURN(
+        se::RedzoneAllocator::RedzoneCheckStatus rz_check_status,
+        rz_buffers_.RedzoneAllocator().CheckRedzones());
+    if (!rz_check_status.ok()) {
+      LOG(ERROR) << "Detected out-of-bounds write in gemm buffer by an "
+                    "unchecked algorithm";
+    }
+    if (autotune_config_.should_reinit_output_buffer() && beta != 0) {
+      int64_t rng_state = 0;
+      InitializeBuffer(stream_, output_shape.element_type(), &rng_state,
+                       OutputBuffer());
+    }
+    TF_ASSIGN_OR_RETURN(auto profile_result, run_benchmark(algorithm));
+    if (!profile_result.is_valid()) {
+      result.mutable_failure()->set_kind(AutotuneResult::DISQUALIFIED);
+      num_algorithms_left_--;
+      return false;
+    }
+
+    TF_ASSIGN_OR_RETURN(rz_check_status,
+                        rz_buffers_.RedzoneAllocator().CheckRedzones());
+    if (!rz_check_status.ok()) {
+      result.mutable_failure()->set_kind(AutotuneResult::REDZONE_MODIFIED);
+      *result.mutable_failure()->mutable_msg() =
+          rz_check_status.RedzoneFailureMsg();
+      LOG(ERROR) << "Detected out-of-bounds write in gemm buffer";
+      CHECK(!autotune_config_.should_crash_on_check_failure());
+      num_algorithms_left_--;
+      return false;
+    }
+
+    TF_ASSIGN_OR_RETURN(
+        bool outputs_match,
+        comparator.CompareEqual(stream_, /*current=*/OutputBuffer(),
+                                /*expected=*/reference_buffer));
+    if (!outputs_match) {
+      LOG(ERROR) << "Results mismatch between different GEMM algorithms. "
+                 << "This is likely a bug/unexpected loss of precision.";
+      CHECK(!autotune_config_.should_crash_on_check_failure());
+      // As above, the result is only disqualified when
+      // should_skip_wrong_results() is set.
+      result.mutable_failure()->mutable_reference_gemm()->set_algorithm(
+          reference_algorithm);
+      if (autotune_config_.should_skip_wrong_results()) {
+        result.mutable_failure()->set_kind(AutotuneResult::DISQUALIFIED);
+        num_algorithms_left_--;
+        return false;
+      }
+      result.mutable_failure()->set_kind(AutotuneResult::WRONG_RESULT);
+    }
+    return true;
+  }
 };  // class GemmAutotuner
 
 // Do Gemm Autotune without stream executor. Use results from autotune cache
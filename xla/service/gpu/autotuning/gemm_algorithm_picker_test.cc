@@ -188,6 +188,41 @@ ENTRY main {
   ASSERT_TRUE(num_left1 > num_left2);
 }
 
+TEST_P(GemmAlgorithmPickerTest, CheckWinnerOnly) {
+  constexpr absl::string_view kHlo = R"(
+HloModule module
+
+ENTRY main {
+  %arg0 = f32[100,100]{1,0} parameter(0)
+  %arg1 = f32[100,100]{1,0} parameter(1)
+  ROOT %dot = f32[100,100]{1,0} dot(arg0, arg1), lhs_contracting_dims={1}, rhs_contracting_dims={0}
+})";
+
+  auto module_cfg = GetModuleConfigForTest();
+  auto debug_opts = module_cfg.debug_options();
+  debug_opts.set_xla_gpu_autotune_check_winner_only(true);
+  module_cfg.set_debug_options(debug_opts);
+  TF_ASSERT_OK_AND_ASSIGN(auto module,
+                          ParseAndReturnVerifiedModule(kHlo, module_cfg));
+  TF_ASSERT_OK_AND_ASSIGN(
+      bool changed,
+      RunHloPass(
+          GemmRewriter(
+              gpu_comp(),
+              /*toolkit_version=*/stream_executor::SemanticVersion{12, 4, 0}),
+          module.get()));
+  ASSERT_TRUE(changed);
+
+  AutotuneConfig cfg = AutotuneConfig::FromDebugOptions(
+      DeviceOrDevicelessConfig{DeviceConfig{stream_exec(), nullptr}},
+      debug_opts);
+  ASSERT_TRUE(cfg.should_check_winner_only());
+  GemmAlgorithmPicker gpicker(cfg);
+  TF_ASSERT_OK(RunHloPass(gpicker, module.get()).status());
+  // The fastest algorithm passed the checks or was replaced by one that did.
+  EXPECT_GT(gpicker.num_algorithms_left(), 0);
+}
+
 TEST_P(GemmAlgorithmPickerTest, SetAlgorithm) {
   constexpr absl::string_view kHlo = R"(
 HloModule module
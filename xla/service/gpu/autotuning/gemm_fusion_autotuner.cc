@@ -18,6 +18,7 @@ limitations under the License.
 #include <algorithm>
 #include <array>
 #include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <optional>
@@ -31,6 +32,7 @@ limitations under the License.
 #include "absl/container/flat_hash_set.h"
 #include "absl/log/check.h"
 #include "absl/log/log.h"
+#include "absl/strings/ascii.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
@@ -95,8 +97,10 @@ limitations under the License.
 #include "xla/stream_executor/device_memory_allocator.h"
 #include "xla/stream_executor/gpu/redzone_allocator.h"
 #include "xla/stream_executor/integrations/tf_allocator_adapter.h"
+#include "xla/stream_executor/platform.h"
 #include "xla/stream_executor/semantic_version.h"
 #include "xla/stream_executor/stream.h"
+#include "xla/stream_executor/stream_executor.h"
 #include "xla/tools/hlo_decomposer.h"
 #include "xla/tsl/lib/core/bits.h"
 #include "xla/tsl/platform/env.h"
@@ -169,6 +173,9 @@ class GemmFusionCollector : public ConstDfsHloVisitorWithDefault {
         module.config()
             .debug_options()
             .xla_gpu_require_complete_aot_autotune_results();
+    reuse_m_buckets_ = module.config()
+                           .debug_options()
+                           .xla_gpu_autotune_gemm_fusion_m_buckets();
     result_ = {};
     handled_fusions_.clear();
     for (HloComputation* computation :
@@ -213,6 +220,14 @@ class GemmFusionCollector : public ConstDfsHloVisitorWithDefault {
 
   absl::StatusOr<KeysAndInstructions> RemoveCached(
       const KeysAndInstructions& entries) const {
+    // Look up all fusions in the remote cache with a single request.
+    std::vector<AutotuneCacheKey> keys;
+    keys.reserve(entries.size());
+    for (const auto& [key, fusion] : entries) {
+      keys.push_back(key);
+    }
+    TF_RETURN_IF_ERROR(AutotunerUtil::PrefetchFromRemoteCache(keys));
+
     KeysAndInstructions result;
     for (const auto& [key, fusion] : entries) {
       TF_ASSIGN_OR_RETURN(bool is_in_cache,
@@ -220,6 +235,12 @@ class GemmFusionCollector : public ConstDfsHloVisitorWithDefault {
       if (is_in_cache) {
         continue;
       }
+      if (reuse_m_buckets_) {
+        TF_ASSIGN_OR_RETURN(bool reused, ReuseMBucketResult(key, *fusion));
+        if (reused) {
+          continue;
+        }
+      }
       if (error_out_on_cache_miss_) {
         return absl::NotFoundError(absl::StrCat(
             "Complete autotuning results are required, but no cache result "
@@ -264,7 +285,30 @@ class GemmFusionCollector : public ConstDfsHloVisitorWithDefault {
   }
 
  private:
+  // Stores the result of a fusion in the same M bucket under `key`, if there
+  // is one.
+  absl::StatusOr<bool> ReuseMBucketResult(
+      const AutotuneCacheKey& key, const HloFusionInstruction& fusion) const {
+    const AutotuneConfig& config = impl_->GetConfig();
+    std::optional<AutotuneCacheKey> bucket_key =
+        GetMBucketAutotuneCacheKey(fusion, config.GetModelStr());
+    if (!bucket_key.has_value()) {
+      return false;
+    }
+    TF_ASSIGN_OR_RETURN(std::optional<AutotuneResult> result,
+                        AutotunerUtil::FindInCache(*bucket_key, config));
+    if (!result.has_value()) {
+      return false;
+    }
+    VLOG(2) << "Reusing the autotuning result of the M bucket of "
+            << fusion.name();
+    TF_RETURN_IF_ERROR(
+        AutotunerUtil::AddResult(key, *std::move(result), config).status());
+    return true;
+  }
+
   bool error_out_on_cache_miss_;
+  bool reuse_m_buckets_;
   GemmFusionAutotunerImpl* impl_;
   GemmFusionCollectorResult result_;
   AutotuneCacheKeySet handled_fusions_;
@@ -934,6 +978,13 @@ GemmFusionAutotunerImpl::GenerateTritonConfigs(const HloDotInstruction& dot) {
       configs = search_space.OptimizeConfigSet(
           configs, /*hints=*/GetDefaultTritonConfigs());
     }
+    if (int64_t top_k =
+            debug_options_.xla_gpu_experimental_autotune_cost_model_top_k();
+        top_k > 0) {
+      VLOG(1) << "Restricting configs to the " << top_k
+              << " best ranked by the cost model.";
+      configs = search_space.PruneConfigsWithCostModel(configs, top_k);
+    }
     if (!IsAutotuningEnabled()) {
       // Keep the first config, which likely does not spill registers.
       configs.resize(1);
@@ -1182,14 +1233,14 @@ GemmFusionAutotunerImpl::CompileAll(AutotunerCompileUtil& compile_util,
 }
 
 absl::Status GemmFusionAutotunerImpl::CompareBuffers(
-    const HloFusionInstruction& fusion,
+    const DeviceOrDevicelessConfig& device, const HloFusionInstruction& fusion,
     const ScopedShapedBuffer& reference_buffer,
     const ScopedShapedBuffer& buffer, AutotuneResult& res) {
   tsl::profiler::TraceMe traceme("CompareBuffers");
   const HloInstruction& root = *fusion.called_computation_root();
   BufferComparator comparator(root.shape(),
                               debug_options_.xla_gpu_autotune_gemm_rtol());
-  TF_ASSIGN_OR_RETURN(se::Stream* const stream, config_.GetStream());
+  TF_ASSIGN_OR_RETURN(se::Stream* const stream, device.GetStream());
 
   TF_ASSIGN_OR_RETURN(
       bool outputs_match,
@@ -1224,11 +1275,11 @@ absl::StatusOr<bool> GemmFusionAutotunerImpl::CheckRedZones(
 }
 
 absl::StatusOr<AutotuneResult> GemmFusionAutotunerImpl::MeasurePerformance(
-    AutotunerCompileUtil& compile_util, const HloFusionInstruction& fusion,
-    const ExecutableCandidate& candidate,
+    AutotunerCompileUtil& compile_util, const DeviceOrDevicelessConfig& device,
+    const HloFusionInstruction& fusion, const ExecutableCandidate& candidate,
     std::optional<ScopedShapedBuffer>& reference_buffer) {
   tsl::profiler::TraceMe traceme("MeasurePerformance");
-  se::StreamExecutor* stream_exec = config_.GetExecutor();
+  se::StreamExecutor* stream_exec = device.GetExecutor();
   {
     tsl::profiler::TraceMe traceme("SynchronizeAllActivity");
     if (!stream_exec->SynchronizeAllActivity()) {
@@ -1247,12 +1298,12 @@ absl::StatusOr<AutotuneResult> GemmFusionAutotunerImpl::MeasurePerformance(
   se::Stream* stream = nullptr;
   {
     tsl::profiler::TraceMe traceme("GetStream");
-    TF_ASSIGN_OR_RETURN(stream, config_.GetStream());
+    TF_ASSIGN_OR_RETURN(stream, device.GetStream());
   }
   TF_ASSIGN_OR_RETURN(
       auto rz_buffers,
       RedzoneBuffers::FromInstruction(
-          *fusion_computation->FusionInstruction(), config_.GetAllocator(),
+          *fusion_computation->FusionInstruction(), device.GetAllocator(),
           stream, RedzoneBuffers::kAllInputs, should_init_buffers,
           should_check_correctness, redzone_padding_bytes));
 
@@ -1286,14 +1337,15 @@ absl::StatusOr<AutotuneResult> GemmFusionAutotunerImpl::MeasurePerformance(
     TF_ASSIGN_OR_RETURN(bool rz_ok, CheckRedZones(rz_buffers, res));
     if (!rz_ok) return res;
 
-    TF_RETURN_IF_ERROR(CompareBuffers(fusion, *reference_buffer,
+    TF_RETURN_IF_ERROR(CompareBuffers(device, fusion, *reference_buffer,
                                       profiling_output.output, res));
   }
   return res;
 }
 
 absl::StatusOr<std::vector<AutotuneResult>> GemmFusionAutotunerImpl::Profile(
-    AutotunerCompileUtil& compile_util, const HloFusionInstruction& fusion,
+    AutotunerCompileUtil& compile_util, const DeviceOrDevicelessConfig& device,
+    const HloFusionInstruction& fusion,
     absl::Span<const ExecutableCandidate> candidates) {
   tsl::profiler::TraceMe traceme("Profile");
   tsl::profiler::ScopedAnnotation annotation([&] {
@@ -1305,7 +1357,7 @@ absl::StatusOr<std::vector<AutotuneResult>> GemmFusionAutotunerImpl::Profile(
   std::optional<ScopedShapedBuffer> reference_buffer;
   for (int i = 0; i < candidates.size(); ++i) {
     absl::StatusOr<AutotuneResult> result = MeasurePerformance(
-        compile_util, fusion, candidates[i], reference_buffer);
+        compile_util, device, fusion, candidates[i], reference_buffer);
     // Treat register allocation error gracefully. If the compilation happens
     // with the driver during execution then the error could surface here.
     // It's enough to check this once here.
@@ -1402,6 +1454,76 @@ static absl::Status DumpAutotuningLogs(const DebugOptions& debug_opts,
   return absl::OkStatus();
 }
 
+// Returns the local devices used to profile candidates compiled for
+// `stream_exec`: the device itself followed by up to `num_devices - 1` other
+// local devices of the same model, or all of them if `num_devices` is 0.
+static std::vector<se::StreamExecutor*> GetProfilingDevices(
+    se::StreamExecutor* stream_exec, size_t num_devices) {
+  std::vector<se::StreamExecutor*> devices = {stream_exec};
+  se::Platform* platform = stream_exec->GetPlatform();
+  std::string model_str = AutotuneCacheKey::DeviceDescriptionToCacheKey(
+      stream_exec->GetDeviceDescription());
+  for (int i = 0; i < platform->VisibleDeviceCount(); ++i) {
+    if (num_devices > 0 && devices.size() >= num_devices) break;
+    if (i == stream_exec->device_ordinal()) continue;
+    absl::StatusOr<se::StreamExecutor*> executor =
+        platform->ExecutorForDevice(i);
+    if (!executor.ok()) {
+      VLOG(2) << "Device " << i << " is not available for autotuning: "
+              << executor.status();
+      continue;
+    }
+    if (AutotuneCacheKey::DeviceDescriptionToCacheKey(
+            (*executor)->GetDeviceDescription()) != model_str) {
+      continue;
+    }
+    devices.push_back(*executor);
+  }
+  return devices;
+}
+
+// Returns the position of `best` among the profiled Triton configs in
+// `results` when ranked by the analytical cost model, or std::nullopt if the
+// cost model cannot estimate the configs. A position of 0 means that the cost
+// model would have picked the best config.
+static std::optional<int64_t> GetCostModelRank(
+    const HloFusionInstruction& fusion,
+    absl::Span<const AutotuneResult> results, const AutotuneResult& best,
+    const se::DeviceDescription& device_description) {
+  const HloInstruction* dot = hlo_query::GetFirstInstructionWithOpcode(
+      *fusion.called_computation(), HloOpcode::kDot);
+  if (dot == nullptr) {
+    return std::nullopt;
+  }
+  TritonDotFusionSearchSpace search_space(device_description,
+                                          Cast<HloDotInstruction>(dot));
+  auto estimate_run_time =
+      [&](const AutotuneResult& result) -> std::optional<absl::Duration> {
+    absl::StatusOr<TritonGemmConfig> config =
+        TritonGemmConfig::FromProto(result.triton());
+    if (!config.ok()) {
+      return std::nullopt;
+    }
+    return search_space.EstimateRunTime(*config);
+  };
+
+  std::optional<absl::Duration> best_run_time = estimate_run_time(best);
+  if (!best_run_time.has_value()) {
+    return std::nullopt;
+  }
+  int64_t rank = 0;
+  for (const AutotuneResult& result : results) {
+    if (!result.has_triton() || result.has_failure()) {
+      continue;
+    }
+    std::optional<absl::Duration> run_time = estimate_run_time(result);
+    if (run_time.has_value() && *run_time < *best_run_time) {
+      ++rank;
+    }
+  }
+  return rank;
+}
+
 absl::Status GemmFusionAutotunerImpl::Autotune(
     AutotunerCompileUtil& compile_util, const BackendConfigs& gemm_config_sets,
     AutoTuneCacheKeyCount fusion_count_map) {
@@ -1417,15 +1539,79 @@ absl::Status GemmFusionAutotunerImpl::Autotune(
     });
   }
 
+  std::vector<const HloFusionInstruction*> fusions;
+  std::vector<absl::Span<const ExecutableCandidate>> fusion_candidates;
+  fusions.reserve(executable_sets.size());
+  fusion_candidates.reserve(executable_sets.size());
+  for (const auto& [fusion, candidates] : executable_sets) {
+    fusions.push_back(fusion);
+    fusion_candidates.push_back(candidates);
+  }
+
+  // Candidates are compiled once and can be executed on any device of the same
+  // model, so fusions are sharded over the profiling devices. Each device uses
+  // its own stream and allocator, and hence its own redzone buffers.
+  std::vector<se::StreamExecutor*> devices = {config_.GetExecutor()};
+  if (fusions.size() > 1) {
+    devices = GetProfilingDevices(
+        config_.GetExecutor(),
+        debug_options_.xla_gpu_autotune_num_profiling_devices());
+  }
+
+  std::vector<absl::StatusOr<std::vector<AutotuneResult>>> profiles(
+      fusions.size());
+  if (devices.size() == 1) {
+    for (int i = 0; i < fusions.size(); ++i) {
+      profiles[i] = Profile(compile_util, config_.DeviceConfig(), *fusions[i],
+                            fusion_candidates[i]);
+    }
+  } else {
+    VLOG(1) << "Profiling " << fusions.size() << " fusions on "
+            << devices.size() << " devices.";
+    std::vector<std::unique_ptr<DeviceOrDevicelessConfig>> device_configs;
+    std::vector<AutotunerCompileUtil> compile_utils;
+    compile_utils.reserve(devices.size() - 1);
+    for (int d = 1; d < devices.size(); ++d) {
+      device_configs.push_back(std::make_unique<DeviceOrDevicelessConfig>(
+          DeviceConfig{devices[d]}));
+      TF_ASSIGN_OR_RETURN(
+          AutotunerCompileUtil device_compile_util,
+          AutotunerCompileUtil::Create(*device_configs.back(), debug_options_));
+      compile_utils.push_back(std::move(device_compile_util));
+    }
+
+    tsl::thread::ThreadPool profiling_pool(
+        tsl::Env::Default(), "gemm_fusion_profiling", devices.size());
+    absl::BlockingCounter counter(devices.size());
+    for (int d = 0; d < devices.size(); ++d) {
+      profiling_pool.Schedule([&, d] {
+        AutotunerCompileUtil& device_compile_util =
+            d == 0 ? compile_util : compile_utils[d - 1];
+        const DeviceOrDevicelessConfig& device =
+            d == 0 ? config_.DeviceConfig() : *device_configs[d - 1];
+        for (int i = d; i < fusions.size(); i += devices.size()) {
+          profiles[i] = Profile(device_compile_util, device, *fusions[i],
+                                fusion_candidates[i]);
+        }
+        counter.DecrementCount();
+      });
+    }
+    counter.Wait();
+  }
+
+  // Results are added to the cache sequentially, independently of the device
+  // that profiled them.
   AutotuningLogs autotuning_logs;
+  std::vector<int64_t> cost_model_ranks;
   int fusion_id = 0;
-  for (const auto& [fusion, candidates] : executable_sets) {
+  for (int i = 0; i < fusions.size(); ++i) {
+    const HloFusionInstruction* fusion = fusions[i];
     if (debug_options_.xla_gpu_dump_autotuned_gemm_fusions()) {
       TF_RETURN_IF_ERROR(DumpOriginalFusion(compile_util, *fusion, fusion_id));
     }
 
     TF_ASSIGN_OR_RETURN(std::vector<AutotuneResult> results,
-                        Profile(compile_util, *fusion, candidates));
+                        std::move(profiles[i]));
 
     // The reference config (if it exists) will be the first in the results,
     // due to how sorting the variants work.
@@ -1441,11 +1627,28 @@ absl::Status GemmFusionAutotunerImpl::Autotune(
     VLOG(2) << "Best time: "
             << tsl::proto_utils::FromDurationProto(best.run_time());
 
+    if (VLOG_IS_ON(1) && best.has_triton()) {
+      if (std::optional<int64_t> rank = GetCostModelRank(
+              *fusion, results, best, config_.GetDeviceDescription())) {
+        VLOG(1) << "Cost model ranked the best config of " << fusion->name()
+                << " at position " << *rank << ".";
+        cost_model_ranks.push_back(*rank);
+      }
+    }
+
     if (debug_options_.xla_gpu_dump_autotuned_gemm_fusions()) {
       TF_RETURN_IF_ERROR(DumpAutotunedFusion(
           config_, toolkit_version_, compile_util, best, fusion, fusion_id++));
     }
 
+    if (debug_options_.xla_gpu_autotune_gemm_fusion_m_buckets()) {
+      if (std::optional<AutotuneCacheKey> bucket_key =
+              GetMBucketAutotuneCacheKey(*fusion, config_.GetModelStr())) {
+        TF_RETURN_IF_ERROR(
+            AutotunerUtil::AddResult(*bucket_key, best, config_).status());
+      }
+    }
+
     const AutotuneCacheKey key = AutotunerUtil::GetKey(fusion, config_);
     TF_ASSIGN_OR_RETURN(
         bool added, AutotunerUtil::AddResult(key, std::move(best), config_));
@@ -1474,6 +1677,18 @@ absl::Status GemmFusionAutotunerImpl::Autotune(
     }
   }
 
+  // Reports how often the best config is among the top-k configs ranked by the
+  // cost model. This helps with picking a value for
+  // --xla_gpu_experimental_autotune_cost_model_top_k.
+  if (!cost_model_ranks.empty()) {
+    for (int64_t top_k : {1, 4, 16}) {
+      VLOG(1) << "Cost model recall@" << top_k << ": "
+              << absl::c_count_if(cost_model_ranks,
+                                  [&](int64_t rank) { return rank < top_k; })
+              << " / " << cost_model_ranks.size() << " fusions.";
+    }
+  }
+
   return DumpAutotuningLogs(debug_options_, autotuning_logs);
 }
 
@@ -1662,5 +1877,62 @@ absl::StatusOr<bool> GemmFusionAutotuner::Run(
       module, execution_threads);
 }
 
+std::optional<AutotuneCacheKey> GetMBucketAutotuneCacheKey(
+    const HloFusionInstruction& fusion, absl::string_view model_str) {
+  const HloInstruction* dot = hlo_query::GetFirstInstructionWithOpcode(
+      *fusion.fused_instructions_computation(), HloOpcode::kDot);
+  if (dot == nullptr) {
+    return std::nullopt;
+  }
+  const DotDimensionNumbers& dims = dot->dot_dimension_numbers();
+  const Shape& lhs_shape = dot->operand(0)->shape();
+  absl::StatusOr<std::vector<int64_t>> lhs_non_contracting_dims =
+      GetNonContractingDims(lhs_shape, dims.lhs_batch_dimensions(),
+                            dims.lhs_contracting_dimensions());
+  if (!lhs_non_contracting_dims.ok() ||
+      lhs_non_contracting_dims->size() != 1) {
+    return std::nullopt;
+  }
+  const int64_t m_dim = lhs_non_contracting_dims->front();
+  const int64_t m = lhs_shape.dimensions(m_dim);
+
+  // M is recognized by its size in the printed shapes, so it must not be
+  // confused with any other dimension of the dot.
+  for (int64_t operand = 0; operand < dot->operand_count(); ++operand) {
+    const Shape& shape = dot->operand(operand)->shape();
+    for (int64_t dim = 0; dim < shape.dimensions_size(); ++dim) {
+      if ((operand != 0 || dim != m_dim) && shape.dimensions(dim) == m) {
+        return std::nullopt;
+      }
+    }
+  }
+
+  const std::string m_str = absl::StrCat(m);
+  const std::string bucket_str = absl::StrCat(tsl::NextPowerOfTwoS64(m));
+  const std::string hlo = ToCanonicalString(&fusion);
+  std::string bucketed_hlo;
+  bucketed_hlo.reserve(hlo.size());
+  // Replace M with the bucket in shape dimensions, e.g. `f32[<m>,1024]`.
+  for (size_t i = 0; i < hlo.size();) {
+    size_t end = i;
+    while (end < hlo.size() && absl::ascii_isdigit(hlo[end])) {
+      ++end;
+    }
+    if (end == i) {
+      bucketed_hlo.push_back(hlo[i++]);
+      continue;
+    }
+    absl::string_view number(hlo.data() + i, end - i);
+    bool is_dimension = i > 0 && (hlo[i - 1] == '[' || hlo[i - 1] == ',') &&
+                        end < hlo.size() &&
+                        (hlo[end] == ']' || hlo[end] == ',');
+    absl::StrAppend(&bucketed_hlo,
+                    is_dimension && number == m_str ? bucket_str : number);
+    i = end;
+  }
+  return AutotuneCacheKey(
+      model_str, absl::StrCat("m_bucket=", bucket_str, "\n", bucketed_hlo));
+}
+
 }  // namespace gpu
 }  // namespace xla
@@ -142,9 +142,12 @@ class GemmFusionAutotunerImpl {
                                      std::vector<ExecutableCandidate>>>
   CompileAll(AutotunerCompileUtil& compile_util, const BackendConfigs& task);
 
-  // Profile all executables for a fusion.
+  // Profile all executables for a fusion on the device of `compile_util`,
+  // which is described by `device`.
   absl::StatusOr<std::vector<AutotuneResult>> Profile(
-      AutotunerCompileUtil& compile_util, const HloFusionInstruction& fusion,
+      AutotunerCompileUtil& compile_util,
+      const DeviceOrDevicelessConfig& device,
+      const HloFusionInstruction& fusion,
       absl::Span<const ExecutableCandidate> candidates);
 
   // Autotune and save the results to the autotuning cache.
@@ -168,8 +171,9 @@ class GemmFusionAutotunerImpl {
   // If the candidate is not cuBLAS, this will check the redzones and compare
   // the outputs with the reference buffer.
   absl::StatusOr<AutotuneResult> MeasurePerformance(
-      AutotunerCompileUtil& compile_util, const HloFusionInstruction& fusion,
-      const ExecutableCandidate& candidate,
+      AutotunerCompileUtil& compile_util,
+      const DeviceOrDevicelessConfig& device,
+      const HloFusionInstruction& fusion, const ExecutableCandidate& candidate,
       std::optional<ScopedShapedBuffer>& reference_buffer);
 
   // Checks that the redzone buffers are correct, updates `res` otherwise.
@@ -179,7 +183,8 @@ class GemmFusionAutotunerImpl {
 
   // Compares the outputs of the fusion with the reference buffer.
   // Updates `res` if the outputs do not match.
-  absl::Status CompareBuffers(const HloFusionInstruction& fusion,
+  absl::Status CompareBuffers(const DeviceOrDevicelessConfig& device,
+                              const HloFusionInstruction& fusion,
                               const ScopedShapedBuffer& reference_buffer,
                               const ScopedShapedBuffer& buffer,
                               AutotuneResult& res);
@@ -209,6 +214,13 @@ class GemmFusionAutotunerImpl {
   std::vector<TritonGemmConfig> triton_configs_;
 };
 
+// Returns the autotuning cache key shared by `fusion` and the GEMM fusions
+// that only differ from it in the size of their M dimension, as long as it
+// rounds up to the same power of two. Returns nullopt if M can't be told apart
+// from the other dimensions of the dot.
+std::optional<AutotuneCacheKey> GetMBucketAutotuneCacheKey(
+    const HloFusionInstruction& fusion, absl::string_view model_str);
+
 }  // namespace gpu
 }  // namespace xla
 
@@ -16,6 +16,7 @@ limitations under the License.
 
 #include <algorithm>
 #include <memory>
+#include <optional>
 #include <set>
 #include <string>
 #include <utility>
@@ -164,6 +165,65 @@ ENTRY entry {
                                /*allow_mixed_precision=*/false));
 }
 
+using MBucketAutotuneCacheKeyTest = HloTestBase;
+
+constexpr absl::string_view kMBucketHlo = R"(
+HloModule module
+
+triton_gemm_dot {
+  p0 = f16[$0,1024] parameter(0)
+  p1 = f16[1024,$1] parameter(1)
+  ROOT dot = f16[$0,$1] dot(p0, p1),
+    lhs_contracting_dims={1}, rhs_contracting_dims={0}
+}
+
+ENTRY entry {
+  p0 = f16[$0,1024] parameter(0)
+  p1 = f16[1024,$1] parameter(1)
+  ROOT fusion = f16[$0,$1] fusion(p0, p1),
+    kind=kCustom, calls=triton_gemm_dot,
+    backend_config={"fusion_backend_config":{"kind":"__triton_gemm"}}
+})";
+
+std::optional<AutotuneCacheKey> GetMBucketKey(const HloModule& module) {
+  return GetMBucketAutotuneCacheKey(
+      *Cast<HloFusionInstruction>(
+          module.entry_computation()->root_instruction()),
+      "model");
+}
+
+TEST_F(MBucketAutotuneCacheKeyTest, FusionsInTheSameBucketShareTheKey) {
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto m96, ParseAndReturnVerifiedModule(absl::Substitute(kMBucketHlo,
+                                                              96, 512)));
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto m100, ParseAndReturnVerifiedModule(absl::Substitute(kMBucketHlo,
+                                                               100, 512)));
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto m200, ParseAndReturnVerifiedModule(absl::Substitute(kMBucketHlo,
+                                                               200, 512)));
+
+  std::optional<AutotuneCacheKey> key96 = GetMBucketKey(*m96);
+  std::optional<AutotuneCacheKey> key100 = GetMBucketKey(*m100);
+  std::optional<AutotuneCacheKey> key200 = GetMBucketKey(*m200);
+  ASSERT_TRUE(key96.has_value());
+  ASSERT_TRUE(key100.has_value());
+  ASSERT_TRUE(key200.has_value());
+  EXPECT_EQ(*key96, *key100);
+  EXPECT_NE(*key96, *key200);
+  // Exact cache lookups are not affected by the bucketing.
+  EXPECT_NE(*key96,
+            AutotuneCacheKey("model",
+                             *m96->entry_computation()->root_instruction()));
+}
+
+TEST_F(MBucketAutotuneCacheKeyTest, AmbiguousMHasNoKey) {
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto module, ParseAndReturnVerifiedModule(absl::Substitute(kMBucketHlo,
+                                                                 512, 512)));
+  EXPECT_FALSE(GetMBucketKey(*module).has_value());
+}
+
 class StatelessAutotunerTest : public HloTestBase {
  public:
   StatelessAutotunerTest()
@@ -588,6 +648,39 @@ ENTRY e {
   EXPECT_TRUE(RunAndCompare(kHloText, ErrorSpec{/*aabs=*/1e-2, /*arel=*/1e-3}));
 }
 
+class GemmFusionAutotunerAllDevicesTest : public GemmFusionAutotunerTest {
+ public:
+  DebugOptions GetDebugOptionsForTest() const override {
+    DebugOptions debug_options =
+        GemmFusionAutotunerTest::GetDebugOptionsForTest();
+    debug_options.set_xla_gpu_autotune_num_profiling_devices(0);
+    return debug_options;
+  }
+};
+
+TEST_F(GemmFusionAutotunerAllDevicesTest, ShardsProfilingOverLocalDevices) {
+  constexpr absl::string_view kHloText = R"(
+HloModule t
+
+ENTRY e {
+  p0 = f16[64,128] parameter(0)
+  p1 = f16[128,32] parameter(1)
+  p2 = f16[32,256] parameter(2)
+  dot.0 = f16[64,32] dot(p0, p1),
+    lhs_contracting_dims={1}, rhs_contracting_dims={0}
+  ROOT dot.1 = f16[64,256] dot(dot.0, p2),
+    lhs_contracting_dims={1}, rhs_contracting_dims={0}
+})";
+
+  MatchOptimizedHlo(kHloText, R"(
+; CHECK: ENTRY
+; CHECK: kCustom
+; CHECK: kCustom
+)");
+
+  EXPECT_TRUE(RunAndCompare(kHloText, ErrorSpec{/*aabs=*/1e-2, /*arel=*/1e-3}));
+}
+
 TEST_F(GemmFusionAutotunerTest, ApplySplitKWithoutAlteringTiling) {
   const std::string kHloText = R"(
 triton_dot {
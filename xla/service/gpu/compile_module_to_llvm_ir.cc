@@ -46,6 +46,8 @@ limitations under the License.
 #include "mlir/Pass/PassManager.h"
 #include "mlir/Support/LLVM.h"
 #include "mlir/Support/LogicalResult.h"
+#include "xla/backends/gpu/runtime/command_buffer_cmd.h"
+#include "xla/backends/gpu/runtime/kernel_thunk_batching.h"
 #include "xla/backends/gpu/runtime/sequential_thunk.h"
 #include "xla/hlo/analysis/hlo_dataflow_analysis.h"
 #include "xla/hlo/analysis/hlo_ordering.h"
@@ -60,6 +62,7 @@ limitations under the License.
 #include "xla/service/gpu/gpu_memory_space_assignment.h"
 #include "xla/service/gpu/ir_emitter_context.h"
 #include "xla/service/gpu/ir_emitter_unnested.h"
+#include "xla/service/gpu/kernel_reuse_cache.h"
 #include "xla/service/gpu/metrics.h"
 #include "xla/service/logical_buffer.h"
 #include "xla/shape.h"
@@ -139,8 +142,19 @@ CompileModuleResults InitializeResults(const HloModule* hlo_module,
   }
 
   results.use_original_allocations = true;
+  ExecutionStreamAssignmentOptions stream_assignment_options;
+  int32_t num_concurrent_fusion_streams =
+      hlo_module->config()
+          .debug_options()
+          .xla_gpu_num_concurrent_fusion_streams();
+  if (num_concurrent_fusion_streams > 1) {
+    // Async fusions run on all streams but the default one.
+    stream_assignment_options.number_of_execution_streams =
+        num_concurrent_fusion_streams - 1;
+  }
   results.execution_stream_assignment =
-      std::make_unique<ExecutionStreamAssignment>(hlo_module);
+      std::make_unique<ExecutionStreamAssignment>(hlo_module,
+                                                  stream_assignment_options);
   return results;
 }
 
@@ -176,7 +190,8 @@ std::string Phase(absl::string_view phase_name, const HloModule* module) {
 bool UseCache(const DebugOptions& options, bool split_constants_module) {
   return split_constants_module &&
          options.xla_gpu_enable_llvm_module_compilation_parallelism() &&
-         !options.xla_gpu_kernel_cache_file().empty();
+         (!options.xla_gpu_kernel_cache_file().empty() ||
+          !options.xla_gpu_kernel_cache_dir().empty());
 }
 
 absl::StatusOr<std::unique_ptr<SequentialThunk>> LowerHlo(
@@ -187,9 +202,12 @@ absl::StatusOr<std::unique_ptr<SequentialThunk>> LowerHlo(
   ScopedAnnotation annotation(Phase("XlaEmitLlvmIr", hlo_module));
   uint64_t start_usecs = tsl::Env::Default()->NowMicros();
 
-  if (use_cache) {
+  if (use_cache && !options.xla_gpu_kernel_cache_file().empty()) {
     TF_RETURN_IF_ERROR(
         LoadCache(ir_emitter_context, options.xla_gpu_kernel_cache_file()));
+  } else if (use_cache) {
+    TF_RETURN_IF_ERROR(
+        LoadCacheDir(ir_emitter_context, options.xla_gpu_kernel_cache_dir()));
   }
   std::unique_ptr<IrEmitterUnnested> ir_emitter =
       IrEmitterUnnested::Create(&ir_emitter_context);
@@ -214,6 +232,20 @@ absl::StatusOr<std::unique_ptr<SequentialThunk>> LowerHlo(
 
 }  // namespace
 
+// Registers cached kernel names with the name uniquer and loads cached kernels
+// into the kernel reuse cache.
+static absl::Status LoadCacheProto(IrEmitterContext& ir_emitter_context,
+                                   const CompilationCacheProto& proto) {
+  // Register all cached kernel names with the name uniquer to avoid
+  // naming conflicts.
+  for (const auto& [name, _] : proto.entries()) {
+    TF_RET_CHECK(ir_emitter_context.name_uniquer()->GetUniqueName(name) ==
+                 name)
+        << "Failed registering " << name << "in NameUniquer.";
+  }
+  return ir_emitter_context.kernel_cache().Load(proto);
+}
+
 absl::Status LoadCache(IrEmitterContext& ir_emitter_context,
                        absl::string_view cache_file_path) {
   tsl::profiler::TraceMe traceme("LoadCache");
@@ -231,20 +263,29 @@ absl::Status LoadCache(IrEmitterContext& ir_emitter_context,
     if (!proto.ParseFromString(serialized)) {
       return Internal("Failed to parse serialized CompilationCacheProto.");
     }
-    // Register all cached kernel names with the name uniquer to avoid
-    // naming conflicts.
-    for (const auto& [name, _] : proto.entries()) {
-      TF_RET_CHECK(ir_emitter_context.name_uniquer()->GetUniqueName(name) ==
-                   name)
-          << "Failed registering " << name << "in NameUniquer.";
-    }
-    TF_RETURN_IF_ERROR(ir_emitter_context.kernel_cache().Load(proto));
+    TF_RETURN_IF_ERROR(LoadCacheProto(ir_emitter_context, proto));
   } else {
     VLOG(1) << "Compilation cache file does not exist: " << resolved_path;
   }
   return absl::OkStatus();
 }
 
+absl::Status LoadCacheDir(IrEmitterContext& ir_emitter_context,
+                          absl::string_view cache_dir) {
+  tsl::profiler::TraceMe traceme("LoadCacheDir");
+  CHECK(!cache_dir.empty());
+  std::string resolved_path;
+  if (!tsl::io::ResolveTestPrefixes(cache_dir, resolved_path)) {
+    return FailedPrecondition("Directory path can not be resolved: %s",
+                              cache_dir);
+  }
+  TF_ASSIGN_OR_RETURN(
+      CompilationCacheProto proto,
+      LoadKernelCacheDir(GetKernelCacheDeviceDir(
+          resolved_path, ir_emitter_context.gpu_device_info())));
+  return LoadCacheProto(ir_emitter_context, proto);
+}
+
 absl::StatusOr<std::unique_ptr<BufferAssignment>> RunBufferAssignment(
     const HloModule* module,
     const HloDataflowAnalysis::CanShareBuffer& can_share_buffer_function,
@@ -328,6 +369,24 @@ absl::StatusOr<CompileModuleResults> CompileModuleToLlvmIr(
       LowerHlo(hlo_module, ir_emitter_context,
                results.llvm_module_constants.get(), platform->id(), use_cache));
 
+  const DebugOptions& debug_options = hlo_module->config().debug_options();
+  if (debug_options.xla_gpu_kernel_launch_batch_min_size() > 1) {
+    KernelThunkBatchingOptions batching_options;
+    batching_options.min_batch_size =
+        debug_options.xla_gpu_kernel_launch_batch_min_size();
+    batching_options.max_num_blocks = device_desc.core_count();
+    batching_options.synchronization_mode =
+        debug_options.xla_gpu_graph_enable_concurrent_region()
+            ? CommandBufferCmdExecutor::SynchronizationMode::kAutomatic
+            : CommandBufferCmdExecutor::SynchronizationMode::kSerialize;
+    batching_options.enable_command_buffers_during_profiling =
+        debug_options.xla_enable_command_buffers_during_profiling();
+    TF_ASSIGN_OR_RETURN(
+        results.executable->thunks(),
+        BatchSmallKernelThunks(std::move(results.executable->thunks()),
+                               batching_options));
+  }
+
   results.constants = std::move(ir_emitter_context.constants());
   if (use_cache) {
     results.kernel_compilation_cache =
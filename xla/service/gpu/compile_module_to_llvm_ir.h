@@ -67,6 +67,11 @@ struct CompileModuleResults {
 absl::Status LoadCache(IrEmitterContext& ir_emitter_context,
                        absl::string_view cache_file_path);
 
+// Loads kernels compiled for the device of `ir_emitter_context` from the
+// persistent kernel cache directory.
+absl::Status LoadCacheDir(IrEmitterContext& ir_emitter_context,
+                          absl::string_view cache_dir);
+
 absl::StatusOr<CompileModuleResults> CompileModuleToLlvmIr(
     const HloModule* hlo_module, llvm::LLVMContext* llvm_context,
     const std::string& target_triple, const std::string& data_layout,
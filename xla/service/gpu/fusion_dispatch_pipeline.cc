@@ -35,6 +35,7 @@ limitations under the License.
 #include "xla/service/pattern_matcher.h"
 #include "xla/stream_executor/device_description.h"
 #include "xla/xla.pb.h"
+#include "tsl/platform/threadpool.h"
 
 namespace xla {
 namespace gpu {
@@ -111,7 +112,8 @@ bool FusionWillBeHandledBetterByTriton(
 
 HloPassPipeline FusionDispatchPipeline(
     const se::DeviceDescription& device_description,
-    HloCostAnalysis::ShapeSizeFunction shape_size_fn) {
+    HloCostAnalysis::ShapeSizeFunction shape_size_fn,
+    tsl::thread::ThreadPool* thread_pool) {
   std::function<absl::StatusOr<bool>(const HloFusionInstruction*)>
       try_rewrite_fusion_if =
           [&device_description](
@@ -133,7 +135,8 @@ HloPassPipeline FusionDispatchPipeline(
   HloPassPipeline pipeline("fusion-dispatch-pipeline");
   pipeline.AddPass<HloDCE>();
   pipeline.AddPass<FusionBlockLevelRewriter>(device_description, shape_size_fn,
-                                             std::move(try_rewrite_fusion_if));
+                                             std::move(try_rewrite_fusion_if),
+                                             thread_pool);
   pipeline.AddPass<FusionDynamicMemcpyRewriter>();
   return pipeline;
 }
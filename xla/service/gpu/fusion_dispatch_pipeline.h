@@ -20,15 +20,18 @@ limitations under the License.
 #include "xla/service/hlo_cost_analysis.h"
 #include "xla/stream_executor/device_description.h"
 #include "xla/xla.pb.h"
+#include "tsl/platform/threadpool.h"
 
 namespace xla {
 namespace gpu {
 
 // Returns a pipeline that attempts to redirect fusions to the most efficient
-// emitter possible.
+// emitter possible. If `thread_pool` is not null, it is used to search the
+// tilings of block-level fusions in parallel.
 HloPassPipeline FusionDispatchPipeline(
     const se::DeviceDescription& device_description,
-    HloCostAnalysis::ShapeSizeFunction shape_size_fn);
+    HloCostAnalysis::ShapeSizeFunction shape_size_fn,
+    tsl::thread::ThreadPool* thread_pool = nullptr);
 
 }  // namespace gpu
 }  // namespace xla
@@ -26,6 +26,7 @@ limitations under the License.
 #include <variant>
 #include <vector>
 
+#include "absl/algorithm/container.h"
 #include "absl/base/call_once.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
@@ -36,6 +37,8 @@ limitations under the License.
 #include "absl/strings/str_format.h"
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/blocking_counter.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
 #include "absl/types/span.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/SmallString.h"
@@ -78,6 +81,7 @@ limitations under the License.
 #include "xla/hlo/transforms/collectives/collective_permute_combiner.h"
 #include "xla/hlo/transforms/collectives/collective_quantizer.h"
 #include "xla/hlo/transforms/collectives/collectives_schedule_linearizer.h"
+#include "xla/hlo/transforms/collectives/while_loop_all_gather_code_motion.h"
 #include "xla/hlo/transforms/convert_memory_placement_to_internal_annotations.h"
 #include "xla/hlo/transforms/expanders/bitcast_dtypes_expander.h"
 #include "xla/hlo/transforms/expanders/comparison_expander.h"
@@ -94,9 +98,11 @@ limitations under the License.
 #include "xla/hlo/transforms/expanders/reshape_decomposer.h"
 #include "xla/hlo/transforms/expanders/rng_bit_generator_expander.h"
 #include "xla/hlo/transforms/expanders/rng_expander.h"
+#include "xla/hlo/transforms/expanders/sparse_dot_expander.h"
 #include "xla/hlo/transforms/expanders/stable_sort_expander.h"
 #include "xla/hlo/transforms/expanders/stochastic_convert_decomposer.h"
 #include "xla/hlo/transforms/host_offload_legalize.h"
+#include "xla/hlo/transforms/host_offload_streaming.h"
 #include "xla/hlo/transforms/host_offloader.h"
 #include "xla/hlo/transforms/operand_upcaster.h"
 #include "xla/hlo/transforms/simplifiers/algebraic_simplifier.h"
@@ -189,6 +195,7 @@ limitations under the License.
 #include "xla/service/gpu/transforms/collectives/all_gather_optimizer.h"
 #include "xla/service/gpu/transforms/collectives/all_reduce_blueconnect.h"
 #include "xla/service/gpu/transforms/collectives/all_reduce_combiner.h"
+#include "xla/service/gpu/transforms/collectives/all_reduce_compressor.h"
 #include "xla/service/gpu/transforms/collectives/all_reduce_decomposer.h"
 #include "xla/service/gpu/transforms/collectives/all_reduce_splitter.h"
 #include "xla/service/gpu/transforms/collectives/collective_backend_assigner.h"
@@ -198,6 +205,7 @@ limitations under the License.
 #include "xla/service/gpu/transforms/collectives/gpu_collective_combiner_utils.h"
 #include "xla/service/gpu/transforms/collectives/reduce_scatter_combiner.h"
 #include "xla/service/gpu/transforms/command_buffer_scheduling.h"
+#include "xla/service/gpu/transforms/concurrent_fusion_annotator.h"
 #include "xla/service/gpu/transforms/conv_rewriter.h"
 #include "xla/service/gpu/transforms/cudnn_custom_call_converter.h"
 #include "xla/service/gpu/transforms/custom_kernel_fusion_rewriter.h"
@@ -215,9 +223,11 @@ limitations under the License.
 #include "xla/service/gpu/transforms/gemm_fusion_swap_operands.h"
 #include "xla/service/gpu/transforms/gemm_rewriter.h"
 #include "xla/service/gpu/transforms/gemv_rewriter.h"
+#include "xla/service/gpu/transforms/in_place_concatenate_rewriter.h"
 #include "xla/service/gpu/transforms/layout_assignment.h"
 #include "xla/service/gpu/transforms/move_copy_to_users.h"
 #include "xla/service/gpu/transforms/nest_gemm_fusion.h"
+#include "xla/service/gpu/transforms/normalization_fusion_rewriter.h"
 #include "xla/service/gpu/transforms/ragged_all_to_all_canonicalizer.h"
 #include "xla/service/gpu/transforms/ragged_all_to_all_decomposer.h"
 #include "xla/service/gpu/transforms/reduce_scatter_creator.h"
@@ -254,6 +264,7 @@ limitations under the License.
 #include "xla/service/scatter_determinism_expander.h"
 #include "xla/service/scatter_expander.h"
 #include "xla/service/scatter_simplifier.h"
+#include "xla/service/scatter_utils.h"
 #include "xla/service/select_and_scatter_expander.h"
 #include "xla/service/sharding_remover.h"
 #include "xla/service/slow_operation_alarm.h"
@@ -470,13 +481,15 @@ GpuThunkAotCompilationResult::LoadExecutable(
       /*llvm_module_constants=*/nullptr,
       /*emit_kernels=*/false);
 
-  absl::string_view cache_file_path =
-      hlo_module->config().debug_options().xla_gpu_kernel_cache_file();
-  if (!cache_file_path.empty() &&
-      hlo_module->config()
-          .debug_options()
-          .xla_gpu_enable_llvm_module_compilation_parallelism()) {
-    TF_RETURN_IF_ERROR(LoadCache(ir_emitter_context, cache_file_path));
+  const DebugOptions& debug_options = hlo_module->config().debug_options();
+  if (debug_options.xla_gpu_enable_llvm_module_compilation_parallelism()) {
+    if (!debug_options.xla_gpu_kernel_cache_file().empty()) {
+      TF_RETURN_IF_ERROR(LoadCache(ir_emitter_context,
+                                   debug_options.xla_gpu_kernel_cache_file()));
+    } else if (!debug_options.xla_gpu_kernel_cache_dir().empty()) {
+      TF_RETURN_IF_ERROR(LoadCacheDir(
+          ir_emitter_context, debug_options.xla_gpu_kernel_cache_dir()));
+    }
   }
 
   auto ir_emitter = IrEmitterUnnested::Create(&ir_emitter_context);
@@ -706,6 +719,9 @@ absl::Status RunOptimizationPasses(
   pipeline.AddPass<SplitkRewriter>(gpu_target_config.device_description);
   pipeline.AddPass<DotDimensionSorter>();
   pipeline.AddPass<DotDecomposer>();
+  // No GPU gemm backend consumes 2:4 sparse dots, so run them as dense dots
+  // over the decompressed operand.
+  pipeline.AddPass<SparseDotExpander>();
 
   HloPredicate upcaster_filter = [&](const HloInstruction* instr) {
     const auto* cuda_cc = std::get_if<se::CudaComputeCapability>(
@@ -757,12 +773,21 @@ absl::Status RunOptimizationPasses(
 
   if (RequireDeterminism(hlo_module->config())) {
     // Scatter can be indeterministic if indices are not unique or a non
-    // associative combiner function is used. Eliminate these Scatter ops.
+    // associative combiner function is used. Eliminate these Scatter ops,
+    // except for sorted scatters with disjoint update windows, which the
+    // scatter emitter reduces deterministically without atomics.
+    HloPredicate not_sorted_with_disjoint_windows =
+        [](const HloInstruction* instr) {
+          return !IsSortedScatterWithDisjointWindows(
+              Cast<HloScatterInstruction>(instr));
+        };
     if (debug_options.xla_gpu_enable_scatter_determinism_expander()) {
-      pipeline.AddPass<ScatterDeterminismExpander>();
+      pipeline.AddPass<ScatterDeterminismExpander>(
+          not_sorted_with_disjoint_windows);
     }
     pipeline.AddPass<ScatterExpander>(
-        ScatterExpander::kEliminateIndeterministicScatters);
+        ScatterExpander::kEliminateIndeterministicScatters,
+        not_sorted_with_disjoint_windows);
   }
   // Scatters unsupported on XLA:GPU are eliminated.
   pipeline.AddPass<GpuScatterExpander>();
@@ -875,7 +900,8 @@ absl::Status RunOptimizationPasses(
         /*max_size_to_merge=*/int64_t{debug_options
                                           .xla_gpu_dot_merger_threshold_mb()}
             << 20,
-        can_merge);
+        can_merge,
+        debug_options.xla_gpu_dot_merger_batch_independent_dots());
     pipeline.AddPass<SortSimplifier>();
     pipeline.AddPass<TupleSimplifier>();
     pipeline.AddPass<WhileLoopConstantSinking>();
@@ -944,6 +970,12 @@ absl::Status RunCollectiveOptimizationPasses(
   collectives_pipeline.AddPass<WhileLoopAllReduceCodeMotion>(
       /*enable_reduce_scatter=*/debug_options
           .xla_gpu_enable_while_loop_reduce_scatter_code_motion());
+  if (debug_options
+          .xla_gpu_while_loop_all_gather_code_motion_memory_limit_bytes() > 0) {
+    collectives_pipeline.AddPass<WhileLoopAllGatherCodeMotion>(
+        debug_options
+            .xla_gpu_while_loop_all_gather_code_motion_memory_limit_bytes());
+  }
 
   // Moves collectives' subsequent quantization before the collective to
   // minimize data transfers.
@@ -1021,6 +1053,13 @@ absl::Status RunCollectiveOptimizationPasses(
     collectives_pipeline.AddPass<CollectivePipeliner>(config);
   }
 
+  if (int64_t min_size_bytes =
+          debug_options
+              .xla_gpu_experimental_all_reduce_compression_min_size_bytes();
+      min_size_bytes > 0) {
+    collectives_pipeline.AddPass<AllReduceCompressor>(min_size_bytes);
+  }
+
   collectives_pipeline.AddPass<ReduceScatterCreator>();
 
   DebugOptions::PipelineParallelismOptLevel pipeline_parallelism_opt_level =
@@ -1086,6 +1125,13 @@ absl::Status RunLayoutAssignmentPasses(
   // run, meaning, the pipeline that contains layout assignment cannot contain
   // a layout-sensitive verifier!
   HloPassPipeline pipeline("layout assignment");
+  // Stream updates of host offloaded tensors before their layouts are fixed,
+  // so that the chunks get their own layouts.
+  const DebugOptions& debug_options = hlo_module->config().debug_options();
+  if (debug_options.xla_gpu_experimental_host_offload_streaming_chunks() > 1) {
+    pipeline.AddPass<HostOffloadStreaming>(
+        debug_options.xla_gpu_experimental_host_offload_streaming_chunks());
+  }
   // Layout assignment uses alias analysis, which requires the call graph to
   // be flattened.
   pipeline.AddPass<FlattenCallGraph>();
@@ -1163,6 +1209,11 @@ void AddDoubleBufferingPasses(const HloModule& module,
       !opts.xla_gpu_enable_while_loop_double_buffering()) {
     unroll_strategy = DoubleBufferLoopUnrolling::UnrollStrategy::kAuto;
   }
+  if (opts.xla_gpu_enable_while_loop_unrolling() ==
+          DebugOptions::WHILE_LOOP_UNROLLING_COST_MODEL &&
+      !opts.xla_gpu_enable_while_loop_double_buffering()) {
+    unroll_strategy = DoubleBufferLoopUnrolling::UnrollStrategy::kCostModel;
+  }
   if (unroll_strategy != std::nullopt) {
     pipeline.AddPass<WhileLoopSimplifier>();
     pipeline.AddPass<DoubleBufferLoopUnrolling>(*unroll_strategy);
@@ -1218,7 +1269,11 @@ absl::Status RunPostFusionPasses(
           .debug_options()
           .xla_gpu_all_reduce_blueconnect_num_devices_per_host();
   if (blueconnect_num_devices_per_host > 0) {
-    pipeline.AddPass<AllReduceBlueConnect>(blueconnect_num_devices_per_host);
+    pipeline.AddPass<AllReduceBlueConnect>(
+        blueconnect_num_devices_per_host,
+        hlo_module->config()
+            .debug_options()
+            .xla_gpu_all_reduce_blueconnect_min_size_bytes());
   }
 
   AddDoubleBufferingPasses(*hlo_module, pipeline);
@@ -1242,9 +1297,14 @@ absl::Status RunPostFusionSimplificationPasses(
   pipeline.AddPass<HloComputationDeduplicator>(
       /*mark_fusion_duplications=*/true);
 
-  if (hlo_module->config()
-          .debug_options()
-          .xla_gpu_multi_streamed_windowed_einsum()) {
+  const DebugOptions& debug_options = hlo_module->config().debug_options();
+  int32_t num_concurrent_fusion_streams =
+      debug_options.xla_gpu_num_concurrent_fusion_streams();
+  if (num_concurrent_fusion_streams > 1) {
+    pipeline.AddPass<ConcurrentFusionAnnotator>(num_concurrent_fusion_streams);
+  }
+  if (debug_options.xla_gpu_multi_streamed_windowed_einsum() ||
+      num_concurrent_fusion_streams > 1) {
     pipeline.AddPass<StreamAttributeAnnotator>(
         gpu_target_config.device_description);
     pipeline.AddPass<StreamAttributeAsyncWrapper>();
@@ -1342,7 +1402,9 @@ absl::Status RunDynamicSliceFusionPasses(
         opts.xla_gpu_reduce_scatter_combine_threshold_bytes(),
         kCombineThresholdCount,
         opts.xla_gpu_enable_reduce_scatter_combine_by_dim(), pointer_size);
-    pipeline.AddPass<DynamicSliceFusionRewriter>(platform->Name());
+    pipeline.AddPass<InPlaceConcatenateRewriter>();
+    pipeline.AddPass<DynamicSliceFusionRewriter>(
+        platform->Name(), opts.xla_gpu_dynamic_slice_fusion_runtime_offsets());
     pipeline.AddPass<AsyncWrapper>([](const HloInstruction* instr) {
       if (!IsDynamicSliceFusion(instr)) {
         return false;
@@ -1534,7 +1596,9 @@ absl::Status GpuCompiler::OptimizeHloPostLayoutAssignment(
   AutotuneConfig autotune_config =
       AutotuneConfig::FromDebugOptions(device_config, debug_options);
   // Lambdas and related constants:
-  const GpuFloatSupport bf16_support(gpu_version, BF16);
+  const GpuFloatSupport bf16_support(
+      gpu_version, BF16, F32,
+      debug_options.xla_gpu_accumulate_bf16_reductions_in_f32());
   const GpuFloatSupport f8e5m2_support(gpu_version, F8E5M2, F16);
   const GpuFloatSupport f8e4m3_support(gpu_version, F8E4M3, F16);
   const GpuFloatSupport f8e4m3fn_support(gpu_version, F8E4M3FN, F16);
@@ -1667,7 +1731,12 @@ absl::Status GpuCompiler::OptimizeHloPostLayoutAssignment(
       pipeline.AddPass<HloDCE>();
       pipeline.AddPass<SoftmaxRewriterTriton>(
           gpu_target_config.device_description, ShapeSizeBytesFunction(),
-          /*only_fuse_if_profitable=*/true);
+          /*only_fuse_if_profitable=*/true, thread_pool);
+    }
+    // Fuse the remaining row normalizations into native normalization fusions.
+    // This also has to run before ReductionDimensionGrouper.
+    if (debug_options.xla_gpu_experimental_enable_normalization_fusion()) {
+      pipeline.AddPass<NormalizationFusionRewriter>();
     }
 
     pipeline.AddPass<ReductionDimensionGrouper>();
@@ -1806,10 +1875,10 @@ absl::Status GpuCompiler::OptimizeHloPostLayoutAssignment(
 /*static*/ absl::StatusOr<Compiler::TargetConfig> GpuCompiler::GetTargetConfig(
     const Compiler::CompileOptions& options, const DebugOptions& debug_opts,
     se::StreamExecutor* executor) {
+  std::optional<Compiler::TargetConfig> target_config;
   if (options.target_config.has_value()) {
-    return *options.target_config;
-  }
-  if (!debug_opts.xla_gpu_target_config_filename().empty()) {
+    target_config = *options.target_config;
+  } else if (!debug_opts.xla_gpu_target_config_filename().empty()) {
     std::string gpu_target_config_string;
     TF_RETURN_IF_ERROR(tsl::ReadFileToString(
         tsl::Env::Default(), debug_opts.xla_gpu_target_config_filename(),
@@ -1820,13 +1889,11 @@ absl::Status GpuCompiler::OptimizeHloPostLayoutAssignment(
       return absl::FailedPreconditionError(
           "Failed to parse GpuTargetConfigProto");
     }
-
-    return Compiler::TargetConfig{gpu_target_config_proto};
-  }
-  if (executor) {
-    Compiler::TargetConfig target_config = Compiler::TargetConfig{executor};
+    target_config.emplace(gpu_target_config_proto);
+  } else if (executor) {
+    target_config.emplace(executor);
     int64_t device_memory_size =
-        target_config.device_description.device_memory_size();
+        target_config->device_description.device_memory_size();
     // Checking for device_memory_size == -1 is how we detect that we are
     // running on Nvidia's software simulator. When running on simulation,
     // the config from StreamExecutor is inaccurate, so we must load the
@@ -1837,11 +1904,24 @@ absl::Status GpuCompiler::OptimizeHloPostLayoutAssignment(
           "--xla_gpu_target_config_filename to pass in target information. "
           "The target config from StreamExecutor is inaccurate.");
     }
-    return target_config;
-  }
-  return absl::InternalError(
-      "Either GPU has to be attached, or --xla_gpu_target_config_filename "
-      "has to be specified to specify the target to compile for.");
+  } else {
+    return absl::InternalError(
+        "Either GPU has to be attached, or --xla_gpu_target_config_filename "
+        "has to be specified to specify the target to compile for.");
+  }
+
+  // Compile for a share of the device if only some of its SMs are available
+  // to us, so that the cost models and launch dimensions do not assume the
+  // whole device.
+  se::DeviceDescription& device_description =
+      target_config->device_description;
+  int64_t sm_budget = debug_opts.xla_gpu_sm_budget();
+  if (sm_budget > 0 && sm_budget < device_description.core_count()) {
+    VLOG(1) << "Compiling for " << sm_budget << " of "
+            << device_description.core_count() << " SMs.";
+    device_description.set_core_count(sm_budget);
+  }
+  return *std::move(target_config);
 }
 
 absl::StatusOr<std::unique_ptr<HloModule>> GpuCompiler::RunHloPasses(
@@ -2070,6 +2150,19 @@ int CountFunctions(const llvm::Module& module) {
   return num_functions;
 }
 
+// Returns whether the LLVM modules of a module compiled with `module_config`
+// and `options` can be compiled on more than one thread.
+bool HasCompilationParallelism(const HloModuleConfig& module_config,
+                               const Compiler::CompileOptions& options) {
+  const int parallelism =
+      module_config.debug_options().xla_gpu_force_compilation_parallelism();
+  if (parallelism > 0) {
+    return parallelism > 1;
+  }
+  return options.thread_pool != nullptr &&
+         options.thread_pool->NumThreads() > 1;
+}
+
 // Returns the name of the single function in the module or empty string if it's
 // not a single-function module.
 std::string SingleFunctionName(const llvm::Module& module) {
@@ -2155,7 +2248,9 @@ absl::StatusOr<GpuCompiler::BackendCompileResult> GpuCompiler::CompileAndLink(
 
   absl::string_view cache_path =
       module_config.debug_options().xla_gpu_kernel_cache_file();
-  const bool use_cache = !cache_path.empty();
+  absl::string_view cache_dir =
+      module_config.debug_options().xla_gpu_kernel_cache_dir();
+  const bool use_cache = !cache_path.empty() || !cache_dir.empty();
 
   struct NamedModule {
     // The string is the function name for single-function modules (used to
@@ -2171,10 +2266,17 @@ absl::StatusOr<GpuCompiler::BackendCompileResult> GpuCompiler::CompileAndLink(
       /*default_parallelism=*/1);
   // Only single-function module are cacheable -> for caching try to get 1
   // function per module. If caching is not used limit the number of modules to
-  // the number of threads.
+  // a small multiple of the number of threads: more modules than threads keep
+  // all threads busy with LLVM codegen and PTX compilation of the remaining
+  // modules while the largest ones are being compiled.
   int num_modules = CountFunctions(*llvm_module);
   if (thread_pool.get() != nullptr && !use_cache) {
-    num_modules = std::max(1, std::min(thread_pool->NumThreads(), num_modules));
+    int modules_per_thread = std::max(
+        1, module_config.debug_options()
+               .xla_gpu_llvm_module_compilation_splits_per_thread());
+    num_modules = std::max(
+        1, std::min(thread_pool->NumThreads() * modules_per_thread,
+                    num_modules));
   }
   if (compile_module_results.llvm_module_constants != nullptr) {
     llvm_modules.reserve(num_modules + 1);
@@ -2209,14 +2311,31 @@ absl::StatusOr<GpuCompiler::BackendCompileResult> GpuCompiler::CompileAndLink(
     // Single function name or empty just like for llvm_modules.
     std::string name;
     absl::StatusOr<BackendCompileResult> result;
+    // Wall time spent compiling the module, excluding the time spent waiting
+    // in the thread pool queue.
+    absl::Duration duration;
   };
   std::vector<NamedCompileResult> compile_results(llvm_modules.size());
+  absl::Time compile_start = absl::Now();
   if (thread_pool.get() != nullptr) {
-    absl::BlockingCounter counter(llvm_modules.size());
+    // Schedule the largest modules first, so that they don't end up being the
+    // last ones compiled while other threads are idle.
+    std::vector<int> schedule(llvm_modules.size());
+    absl::c_iota(schedule, 0);
+    std::vector<unsigned> instruction_counts(llvm_modules.size());
     for (int i = 0; i < llvm_modules.size(); ++i) {
+      instruction_counts[i] = llvm_modules[i].module->getInstructionCount();
+    }
+    absl::c_stable_sort(schedule, [&](int a, int b) {
+      return instruction_counts[a] > instruction_counts[b];
+    });
+
+    absl::BlockingCounter counter(llvm_modules.size());
+    for (int i : schedule) {
       thread_pool.get_mutable()->Schedule(
           [&compile_results, i, &llvm_modules, &counter, this, &module_config,
            &device_description, &debug_module, &options] {
+            absl::Time start = absl::Now();
             // Each thread has its own context to avoid race conditions.
             llvm::LLVMContext new_context;
             std::unique_ptr<llvm::Module> new_module =
@@ -2226,28 +2345,32 @@ absl::StatusOr<GpuCompiler::BackendCompileResult> GpuCompiler::CompileAndLink(
                 CompileSingleModule(module_config, device_description,
                                     debug_module, new_module.get(),
                                     /*relocatable=*/true, options,
-                                    /*shard_number=*/i)};
+                                    /*shard_number=*/i),
+                absl::Now() - start};
             counter.DecrementCount();
           });
     }
     counter.Wait();
   } else {
     for (int i = 0; i < llvm_modules.size(); ++i) {
+      absl::Time start = absl::Now();
       compile_results.at(i) = {
           llvm_modules.at(i).name,
           CompileSingleModule(module_config, device_description, debug_module,
                               &*llvm_modules.at(i).module,
                               /*relocatable=*/true, options,
-                              /*shard_number=*/i)};
+                              /*shard_number=*/i),
+          absl::Now() - start};
     }
   }
+  absl::Duration compile_duration = absl::Now() - compile_start;
 
   std::string ptx_snippets;
   std::vector<std::vector<uint8_t>> binaries_to_link;
   binaries_to_link.reserve(compile_results.size());
   std::vector<KernelReuseCache::NamedBinary> binaries_to_cache;
   binaries_to_cache.reserve(single_function_module_count);
-  for (const auto& [name, maybe_result] : compile_results) {
+  for (const auto& [name, maybe_result, duration] : compile_results) {
     TF_ASSIGN_OR_RETURN(auto result, maybe_result);
     if (result.binary.empty()) {
       continue;
@@ -2261,19 +2384,22 @@ absl::StatusOr<GpuCompiler::BackendCompileResult> GpuCompiler::CompileAndLink(
   }
 
   if (use_cache) {
+    // The cache file takes precedence over the cache directory.
+    const bool use_cache_dir = cache_path.empty();
     std::string resolved_path;
-    if (!tsl::io::ResolveTestPrefixes(cache_path, resolved_path)) {
+    if (!tsl::io::ResolveTestPrefixes(use_cache_dir ? cache_dir : cache_path,
+                                      resolved_path)) {
       return FailedPrecondition("File path can not be resolved: %s",
-                                cache_path);
+                                use_cache_dir ? cache_dir : cache_path);
     }
     // current_cache contains new kernels from the current compilation and
     // kernels to reuse from previous compilations if some were loaded from the
-    // cache file.
+    // cache file or directory.
     const CompilationCacheProto& current_cache =
         compile_module_results.kernel_compilation_cache;
     const bool cache_file_exists =
-        tsl::Env::Default()->FileExists(resolved_path).ok();
-    if (cache_file_exists) {
+        !use_cache_dir && tsl::Env::Default()->FileExists(resolved_path).ok();
+    if (use_cache_dir || cache_file_exists) {
       // Pick reused binaries from previous compilations needed to link the
       // current executable.
       int loaded_kernel_count = 0;
@@ -2296,16 +2422,42 @@ absl::StatusOr<GpuCompiler::BackendCompileResult> GpuCompiler::CompileAndLink(
       VLOG(2) << "Using " << loaded_kernel_count << " / "
               << current_cache.entries_size() << " cached kernels.";
     }
-    if (!binaries_to_cache.empty()) {
+    if (!binaries_to_cache.empty() && use_cache_dir) {
+      TF_RETURN_IF_ERROR(UpdateKernelCacheDir(
+          GetKernelCacheDeviceDir(resolved_path, device_description),
+          current_cache, binaries_to_cache));
+    } else if (!binaries_to_cache.empty()) {
       TF_RETURN_IF_ERROR(
           UpdateDiskKernelCache(resolved_path, /*do_append=*/cache_file_exists,
                                 current_cache, binaries_to_cache));
     }
   }
 
+  absl::Time link_start = absl::Now();
   auto maybe_backend_result =
       LinkModules(device_description, stream_exec, std::move(binaries_to_link),
                   module_config.debug_options());
+  absl::Duration link_duration = absl::Now() - link_start;
+  if (debug_module != nullptr && DumpingEnabledForHloModule(*debug_module)) {
+    std::string phases;
+    for (int i = 0; i < compile_results.size(); ++i) {
+      const NamedCompileResult& compile_result = compile_results[i];
+      absl::StrAppendFormat(
+          &phases, "module %d%s: total=%s llvm_to_asm=%s asm_to_binary=%s\n",
+          i,
+          compile_result.name.empty()
+              ? ""
+              : absl::StrCat(" (", compile_result.name, ")"),
+          absl::FormatDuration(compile_result.duration),
+          absl::FormatDuration(compile_result.result->llvm_to_asm_duration),
+          absl::FormatDuration(compile_result.result->asm_to_binary_duration));
+    }
+    absl::StrAppendFormat(&phases, "compile: %s\nlink: %s\n",
+                          absl::FormatDuration(compile_duration),
+                          absl::FormatDuration(link_duration));
+    DumpToFileInDirOrStdout(*debug_module, "", "compilation_phases.txt",
+                            phases);
+  }
   if (!maybe_backend_result.ok()) {
     LOG(ERROR) << "The CUDA linking API did not work. Please use XLA_FLAGS="
                   "--xla_gpu_enable_llvm_module_compilation_parallelism=false "
@@ -2330,7 +2482,8 @@ GpuCompiler::CompileToBackendResult(
       ScheduleMetadata schedule_metadata,
       ScheduleGpuModule(module, pointer_size_, gpu_device_info));
   TF_RETURN_IF_ERROR(RunPostSchedulingPipelines(
-      module, schedule_metadata.scheduler_mem_limit, gpu_device_info));
+      module, schedule_metadata.scheduler_mem_limit, gpu_device_info,
+      options.thread_pool));
 
   absl::StatusOr<se::Platform*> platform =
       se::PlatformManager::PlatformWithId(PlatformId());
@@ -2355,7 +2508,8 @@ GpuCompiler::CompileToBackendResult(
           .xla_gpu_enable_llvm_module_compilation_parallelism();
   const bool use_cache =
       split_modules &&
-      !module->config().debug_options().xla_gpu_kernel_cache_file().empty();
+      (!module->config().debug_options().xla_gpu_kernel_cache_file().empty() ||
+       !module->config().debug_options().xla_gpu_kernel_cache_dir().empty());
 
   CompileModuleResults compile_module_results;
 
@@ -2388,11 +2542,31 @@ GpuCompiler::CompileToBackendResult(
                              /*optimized=*/false, "constants");
   }
 
+  // Large modules are split automatically when there are threads to compile
+  // the parts on, since a single LLVM thread dominates their compile time.
+  const int64_t auto_split_min_instructions =
+      module->config()
+          .debug_options()
+          .xla_gpu_llvm_module_compilation_auto_split_min_instructions();
+  const bool auto_split_modules =
+      !split_modules && can_use_link_modules &&
+      auto_split_min_instructions > 0 &&
+      module->config().debug_options().xla_gpu_kernel_cache_file().empty() &&
+      module->config().debug_options().xla_gpu_kernel_cache_dir().empty() &&
+      HasCompilationParallelism(module->config(), options) &&
+      compile_module_results.llvm_module->getInstructionCount() >=
+          auto_split_min_instructions;
+  if (auto_split_modules) {
+    VLOG(1) << "Splitting LLVM module of " << module->name() << " with "
+            << compile_module_results.llvm_module->getInstructionCount()
+            << " instructions for parallel compilation.";
+  }
+
   BackendCompileResult backend_result;
   // Disable multi-threading during deviceless AOT compilation.
   // TODO(anlunx): Enable multi-threading once deviceless AOT compilation is
   // enabled.
-  if (split_modules) {
+  if (split_modules || auto_split_modules) {
     TF_ASSIGN_OR_RETURN(
         backend_result,
         CompileAndLink(module->config(), compile_module_results,
@@ -2686,9 +2860,11 @@ HloCostAnalysis::Options CreateHloAnalysisOpts(
   tsl::profiler::TraceMe traceme("CreateHloAnalysisOpts");
   HloCostAnalysis::Options hlo_cost_analysis_options;
   hlo_cost_analysis_options.shape_size = shape_size_fn;
-  std::optional<HloRematerialization::HostMemoryOffloadConfig>
-      offloading_config = std::nullopt;
-  if (module.config().debug_options().xla_gpu_enable_host_memory_offloading()) {
+  const DebugOptions& debug_options = module.config().debug_options();
+  const bool compute_aware_remat =
+      debug_options.xla_gpu_experimental_compute_aware_rematerialization();
+  if (debug_options.xla_gpu_enable_host_memory_offloading() ||
+      compute_aware_remat) {
     constexpr float kGiga = 1e+9;
     // Fused multiply-add means that these two instructions are computed as
     // one, so for this case the maximum flops is doubled.
@@ -2696,21 +2872,40 @@ HloCostAnalysis::Options CreateHloAnalysisOpts(
     float flops_per_sec = gpu_device_info.core_count() *
                           gpu_device_info.fpus_per_core() *
                           gpu_device_info.clock_rate_ghz() * kGiga * kFma;
-    int64_t host_memory_space_color =
-        static_cast<int64_t>(se::MemoryType::kHost);
     hlo_cost_analysis_options.set_flops_per_second(flops_per_sec);
     hlo_cost_analysis_options.set_transcendentals_per_second(flops_per_sec);
-    offloading_config =
-        std::make_optional<HloRematerialization::HostMemoryOffloadConfig>(
-            /*host_memory_space=*/host_memory_space_color,
-            /*bandwidth_to_host_bytes_per_second=*/
-            gpu_device_info.memory_bandwidth(),
-            /*bandwidth_from_host_bytes_per_second=*/
-            gpu_device_info.memory_bandwidth());
+  }
+  if (compute_aware_remat) {
+    // Most recomputed instructions are memory bound.
+    hlo_cost_analysis_options.set_bytes_per_second(
+        gpu_device_info.memory_bandwidth());
   }
   return hlo_cost_analysis_options;
 }
 
+// Returns the bandwidth between device and host memory in bytes per second.
+// Transfers to and from the host go over PCIe, which is much slower than the
+// device memory, so we estimate it from the PCIe generation that usually comes
+// with the GPU generation.
+int64_t GetHostMemoryOffloadBandwidth(
+    const HloModule& module, const se::DeviceDescription& gpu_device_info) {
+  int64_t bandwidth =
+      module.config().debug_options().xla_gpu_host_memory_offload_bandwidth();
+  if (bandwidth > 0) {
+    return bandwidth;
+  }
+  constexpr int64_t kGiga = 1000 * 1000 * 1000;
+  const auto* cuda_cc = std::get_if<se::CudaComputeCapability>(
+      &gpu_device_info.gpu_compute_capability());
+  if (cuda_cc != nullptr && cuda_cc->IsAtLeastHopper()) {
+    return 50 * kGiga;  // PCIe Gen5 x16
+  }
+  if (cuda_cc != nullptr && cuda_cc->IsAtLeastAmpere()) {
+    return 25 * kGiga;  // PCIe Gen4 x16
+  }
+  return 12 * kGiga;  // PCIe Gen3 x16
+}
+
 HloRematerialization::Options CreateRematOpts(
     const HloModule& module, const se::DeviceDescription& gpu_device_info,
     HloCostAnalysis& hlo_cost_analysis, int64_t scheduler_mem_limit) {
@@ -2722,13 +2917,13 @@ HloRematerialization::Options CreateRematOpts(
   if (enable_offloading) {
     int64_t host_memory_space_color =
         static_cast<int64_t>(se::MemoryType::kHost);
+    int64_t host_bandwidth =
+        GetHostMemoryOffloadBandwidth(module, gpu_device_info);
     offloading_config =
         std::make_optional<HloRematerialization::HostMemoryOffloadConfig>(
             /*host_memory_space=*/host_memory_space_color,
-            /*bandwidth_to_host_bytes_per_second=*/
-            gpu_device_info.memory_bandwidth(),
-            /*bandwidth_from_host_bytes_per_second=*/
-            gpu_device_info.memory_bandwidth());
+            /*bandwidth_to_host_bytes_per_second=*/host_bandwidth,
+            /*bandwidth_from_host_bytes_per_second=*/host_bandwidth);
   }
   HloRematerialization::RematerializationModeConfig
       rematerialization_mode_config(/*recompute=*/true, /*compress=*/true,
@@ -2740,12 +2935,17 @@ HloRematerialization::Options CreateRematOpts(
       /*block_size_limit=*/1, /*block_rematerialization_factor=*/1,
       /*min_remat_size=*/0, /*compact_shape_function=*/nullptr,
       /*host_memory_offload_config=*/offloading_config);
+  options.weight_recompute_by_compute_cost =
+      module.config()
+          .debug_options()
+          .xla_gpu_experimental_compute_aware_rematerialization();
   return options;
 }
 
 absl::Status GpuCompiler::RunPostSchedulingPipelines(
     HloModule* module, int64_t scheduler_mem_limit,
-    const se::DeviceDescription& gpu_device_info) const {
+    const se::DeviceDescription& gpu_device_info,
+    tsl::thread::ThreadPool* thread_pool) const {
   tsl::profiler::TraceMe traceme("RunPostSchedulingPipelines");
   TF_RETURN_IF_ERROR(RunPostSchedulingCopyInsertion(
       module, GetCanShareBuffer(gpu_device_info)));
@@ -2791,7 +2991,8 @@ absl::Status GpuCompiler::RunPostSchedulingPipelines(
     // This needs to run after every pass affecting fusions. The last passes
     // that create new fusions are FusionWrapper and StreamAttributeAnnotator.
     main_pipeline.AddPass<HloPassPipeline>(
-        FusionDispatchPipeline(gpu_device_info, ShapeSizeBytesFunction()));
+        FusionDispatchPipeline(gpu_device_info, ShapeSizeBytesFunction(),
+                               thread_pool));
   }
 
   // Pipeline with passes which wrap a scheduled module into command buffers.
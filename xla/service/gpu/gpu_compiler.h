@@ -24,6 +24,7 @@ limitations under the License.
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/time/time.h"
 #include "llvm/IR/Module.h"
 #include "xla/autotune_results.pb.h"
 #include "xla/hlo/analysis/hlo_dataflow_analysis.h"
@@ -94,7 +95,8 @@ class GpuCompiler : public LLVMCompiler {
 
   absl::Status RunPostSchedulingPipelines(
       HloModule* module, int64_t scheduler_mem_limit,
-      const se::DeviceDescription& gpu_device_info) const;
+      const se::DeviceDescription& gpu_device_info,
+      tsl::thread::ThreadPool* thread_pool = nullptr) const;
 
   std::string target_triple() const { return target_triple_; }
   std::string data_layout() const { return data_layout_; }
@@ -132,6 +134,11 @@ class GpuCompiler : public LLVMCompiler {
     std::string asm_text;
     std::vector<uint8_t> binary;
     BinaryMap dnn_compiled_graphs;
+
+    // Time spent in compiling LLVM IR to the target assembly (e.g. PTX) and
+    // the target assembly to the binary. Zero if not reported by the backend.
+    absl::Duration llvm_to_asm_duration = absl::ZeroDuration();
+    absl::Duration asm_to_binary_duration = absl::ZeroDuration();
   };
 
   // During compilation with device, stream_exec != null and autotune_results
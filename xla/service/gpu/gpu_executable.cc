@@ -16,6 +16,7 @@ limitations under the License.
 #include "xla/service/gpu/gpu_executable.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <memory>
 #include <optional>
@@ -25,11 +26,13 @@ limitations under the License.
 #include <variant>
 #include <vector>
 
+#include "absl/base/thread_annotations.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/container/inlined_vector.h"
 #include "absl/log/check.h"
 #include "absl/log/log.h"
+#include "absl/numeric/int128.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
@@ -52,6 +55,7 @@ limitations under the License.
 #include "xla/service/gpu/buffer_allocations.h"
 #include "xla/service/gpu/gpu_constants.h"
 #include "xla/service/gpu/gpu_executable_run_options.h"
+#include "xla/service/gpu/metrics.h"
 #include "xla/service/gpu/resource_requests.h"
 #include "xla/service/gpu/stream_executor_util.h"
 #include "xla/service/hlo_value.h"
@@ -84,6 +88,7 @@ limitations under the License.
 #include "xla/tsl/platform/status.h"
 #include "xla/tsl/platform/statusor.h"
 #include "xla/util.h"
+#include "tsl/platform/fingerprint.h"
 #include "tsl/platform/random.h"
 #include "tsl/profiler/lib/scoped_annotation.h"
 #include "tsl/profiler/lib/traceme.h"
@@ -116,8 +121,6 @@ absl::StatusOr<std::unique_ptr<GpuExecutable>> GpuExecutable::Create(
 // since we can use timers around thunks.
 GpuExecutable::GpuExecutable(GpuExecutable::Params params)
     : Executable(std::move(params.debug_module)),
-      text_(std::move(params.asm_text)),
-      binary_(std::move(params.binary)),
       dnn_compiled_graphs_(std::move(params.dnn_compiled_graphs)),
       gpu_version_(params.gpu_version),
       thunks_(std::move(params.executable)),
@@ -135,9 +138,15 @@ GpuExecutable::GpuExecutable(GpuExecutable::Params params)
           gpu_version_)) {
     // ROCm uses hsaco hashes to distinguish between modules.
     // Bad things happen if multiple modules with identical code are loaded.
-    binary_.resize(binary_.size() + 16);
-    *(uint64_t*)(&binary_[binary_.size() - 16]) = tsl::EnvTime::NowNanos();
-    *(uint64_t*)(&binary_[binary_.size() - 8]) = tsl::random::New64();
+    std::vector<uint8_t> binary = std::move(params.binary);
+    binary.resize(binary.size() + 16);
+    *(uint64_t*)(&binary[binary.size() - 16]) = tsl::EnvTime::NowNanos();
+    *(uint64_t*)(&binary[binary.size() - 8]) = tsl::random::New64();
+    code_ = std::make_shared<const Code>(
+        Code{std::move(params.asm_text), std::move(binary)});
+  } else {
+    code_ = InternCode(std::move(params.asm_text), std::move(params.binary),
+                       constants_);
   }
   if (has_module() && enable_debug_info_manager_) {
     XlaDebugInfoManager::Get()->RegisterModule(shared_module(),
@@ -145,6 +154,57 @@ GpuExecutable::GpuExecutable(GpuExecutable::Params params)
   }
 }
 
+std::shared_ptr<const GpuExecutable::Code> GpuExecutable::InternCode(
+    std::string text, std::vector<uint8_t> binary,
+    absl::Span<const ConstantInfo> constants) {
+  struct CodeCache {
+    absl::Mutex mutex;
+    absl::flat_hash_map<absl::uint128, std::weak_ptr<const Code>> codes
+        ABSL_GUARDED_BY(mutex);
+  };
+  static auto* const cache = new CodeCache();
+
+  auto as_string_view = [](absl::Span<const uint8_t> bytes) {
+    return absl::string_view(reinterpret_cast<const char*>(bytes.data()),
+                             bytes.size());
+  };
+  tsl::Fprint128 fingerprint = tsl::FingerprintCat128(
+      tsl::Fingerprint128(text), tsl::Fingerprint128(as_string_view(binary)));
+  for (const ConstantInfo& info : constants) {
+    fingerprint = tsl::FingerprintCat128(
+        tsl::FingerprintCat128(fingerprint,
+                               tsl::Fingerprint128(info.symbol_name)),
+        tsl::Fingerprint128(as_string_view(info.content.span())));
+    fingerprint = tsl::FingerprintCat128(
+        fingerprint, static_cast<uint64_t>(info.allocation_index));
+  }
+  const absl::uint128 key =
+      absl::MakeUint128(fingerprint.high64, fingerprint.low64);
+
+  absl::MutexLock lock(&cache->mutex);
+  std::weak_ptr<const Code>& cached = cache->codes[key];
+  if (std::shared_ptr<const Code> code = cached.lock()) {
+    VLOG(3) << "Sharing " << code->binary.size() << " bytes of binary and "
+            << code->text.size() << " bytes of text with another executable";
+    return code;
+  }
+  // The entry is erased with the last executable that uses the code, unless
+  // it has been replaced with the code of a new executable in the meantime.
+  std::shared_ptr<const Code> code(
+      new Code{std::move(text), std::move(binary)}, [key](const Code* code) {
+        {
+          absl::MutexLock lock(&cache->mutex);
+          auto it = cache->codes.find(key);
+          if (it != cache->codes.end() && it->second.expired()) {
+            cache->codes.erase(it);
+          }
+        }
+        delete code;
+      });
+  cached = code;
+  return code;
+}
+
 GpuExecutable::~GpuExecutable() {
   if (has_module() && enable_debug_info_manager_) {
     XlaDebugInfoManager::Get()->UnregisterModule(module().unique_id());
@@ -192,13 +252,69 @@ absl::Status RendezvousAfterInitialization(
     const ServiceExecutableRunOptions* run_options,
     const DebugOptions* debug_options);
 
+// Collects resource requests from `thunk_sequence` and acquires the requested
+// collective cliques. Cliques are created on first acquisition and cached by
+// the process, later acquisitions of the same cliques are cheap.
+absl::StatusOr<Thunk::CollectiveCliques> PrepareAndAcquireCollectiveCliques(
+    const DebugOptions* debug_options, SequentialThunk& thunk_sequence,
+    const Thunk::CollectiveExecuteParams& collective_params,
+    bool mock_collectives) {
+  ResourceRequests resource_requests;
+
+  {  // Collect resource requirements from thunks.
+    Thunk::PrepareParams prepare_params{&collective_params};
+
+    tsl::profiler::TraceMe trace_prepare("Thunks::Prepare");
+    TF_RETURN_IF_ERROR(
+        thunk_sequence.Prepare(prepare_params, resource_requests));
+  }
+
+  // Acquire collective cliques requested by thunks.
+  if (mock_collectives) {
+    return Thunk::CollectiveCliques();
+  }
+  return resource_requests.AcquireCollectiveCliques(
+      collective_params,
+      debug_options
+          ? debug_options->xla_gpu_collectives_use_persistent_cliques()
+          : false);
+}
+
+// Executes top-level thunks of `thunk_sequence` one by one, bracketing each of
+// them with host callbacks on the main stream that record the elapsed device
+// time into the thunk device time histogram. Host callbacks serialize the main
+// stream with the host, so this is only used for sampled executions.
+absl::Status ExecuteThunksWithDeviceTimeSampling(
+    SequentialThunk& thunk_sequence, const Thunk::ExecuteParams& params) {
+  for (const std::unique_ptr<Thunk>& thunk : thunk_sequence.thunks()) {
+    if (params.mock_collectives && thunk->IsCollective()) {
+      continue;
+    }
+
+    auto start_time_ns = std::make_shared<uint64_t>();
+    TF_RETURN_IF_ERROR(params.stream->DoHostCallback([start_time_ns] {
+      *start_time_ns = tsl::EnvTime::NowNanos();
+    }));
+
+    TF_RETURN_IF_ERROR(thunk->ExecuteOnStream(params));
+
+    TF_RETURN_IF_ERROR(params.stream->DoHostCallback(
+        [start_time_ns, name = thunk->profile_annotation()] {
+          uint64_t elapsed_ns = tsl::EnvTime::NowNanos() - *start_time_ns;
+          RecordThunkDeviceTime(name, elapsed_ns / 1000);
+        }));
+  }
+  return absl::OkStatus();
+}
+
 absl::Status ExecuteThunksImpl(
     const DebugOptions* debug_options, const std::string& module_name,
     ModuleIdentifier module_id, SequentialThunk& thunk_sequence,
     Thunk::ExecutableSource executable_source,
     const ServiceExecutableRunOptions* run_options,
     const BufferAllocations& buffer_allocations, bool block_host_until_done,
-    const absl::flat_hash_set<ExecutionStreamId>& execution_stream_ids) {
+    const absl::flat_hash_set<ExecutionStreamId>& execution_stream_ids,
+    bool sample_thunk_device_time) {
   bool mock_collectives =
       run_options->run_options().gpu_executable_run_options()
           ? run_options->run_options()
@@ -280,27 +396,10 @@ absl::Status ExecuteThunksImpl(
                           main_stream->parent()->device_ordinal(),
                           collective_max_nchannels, p2p_max_nchannels));
 
-  ResourceRequests resource_requests;
-
-  {  // Collect resource requirements from thunks.
-    Thunk::PrepareParams prepare_params{&collective_params};
-
-    tsl::profiler::TraceMe trace_prepare("Thunks::Prepare");
-    TF_RETURN_IF_ERROR(
-        thunk_sequence.Prepare(prepare_params, resource_requests));
-  }
-
-  // Acquire collective cliques requested by thunks.
-  Thunk::CollectiveCliques collective_cliques;
-  if (!mock_collectives) {
-    TF_ASSIGN_OR_RETURN(
-        collective_cliques,
-        resource_requests.AcquireCollectiveCliques(
-            collective_params,
-            debug_options
-                ? debug_options->xla_gpu_collectives_use_persistent_cliques()
-                : false));
-  }
+  TF_ASSIGN_OR_RETURN(
+      Thunk::CollectiveCliques collective_cliques,
+      PrepareAndAcquireCollectiveCliques(debug_options, thunk_sequence,
+                                         collective_params, mock_collectives));
 
   {  // Initialize thunks using prepared resources before execution.
     Thunk::InitializeParams initialize_params{
@@ -336,7 +435,12 @@ absl::Status ExecuteThunksImpl(
 
   VLOG(1) << "[" << run_options->device_ordinal() << "] "
           << "Start GpuExecutable::ExecuteOnStream module: " << module_name;
-  TF_RETURN_IF_ERROR(thunk_sequence.ExecuteOnStream(execute_params));
+  if (sample_thunk_device_time) {
+    TF_RETURN_IF_ERROR(
+        ExecuteThunksWithDeviceTimeSampling(thunk_sequence, execute_params));
+  } else {
+    TF_RETURN_IF_ERROR(thunk_sequence.ExecuteOnStream(execute_params));
+  }
   VLOG(1) << "[" << run_options->device_ordinal() << "] "
           << "End GpuExecutable::ExecuteOnStream module: " << module_name;
 
@@ -882,20 +986,80 @@ absl::Status GpuExecutable::ExecuteThunks(
   ScopedModuleAnnotations module_annotations(&module_annotations_);
 
   ModuleIdentifier unique_id = has_module() ? module().unique_id() : -1;
-  Thunk::ExecutableSource executable_source = {text_, binary_,
+  Thunk::ExecutableSource executable_source = {text(), binary(),
                                                dnn_compiled_graphs_};
 
+  const DebugOptions* debug_options =
+      has_module() ? &module_config().debug_options() : nullptr;
+
+  // Sample device time of thunks for every N-th execution if requested.
+  int64_t sampling_period = 0;
+  if (debug_options) {
+    sampling_period =
+        debug_options->xla_gpu_executable_thunk_device_time_sampling_period();
+  }
+  bool sample_thunk_device_time =
+      sampling_period > 0 &&
+      num_executions_.fetch_add(1, std::memory_order_relaxed) %
+              sampling_period ==
+          0;
+
   TF_RETURN_IF_ERROR(ExecuteThunksImpl(
-      has_module() ? &module_config().debug_options() : nullptr, module_name_,
-      unique_id, *thunks_, executable_source, run_options, buffer_allocations,
-      block_host_until_done, execution_stream_ids_));
+      debug_options, module_name_, unique_id, *thunks_, executable_source,
+      run_options, buffer_allocations, block_host_until_done,
+      execution_stream_ids_, sample_thunk_device_time));
+  return absl::OkStatus();
+}
+
+absl::Status GpuExecutable::WarmUpCollectiveCliques(
+    const ServiceExecutableRunOptions* run_options) {
+  tsl::profiler::TraceMe trace([&] {
+    return tsl::profiler::TraceMeEncode(
+        "GpuExecutable::WarmUpCollectiveCliques",
+        {{"module_name", module_name_}});
+  });
+
+  TF_RETURN_IF_ERROR(
+      CheckCompatibilityWithServiceExecutableRunOptions(run_options));
+
+  const DebugOptions* debug_options =
+      has_module() ? &module_config().debug_options() : nullptr;
+  bool mock_collectives =
+      run_options->run_options().gpu_executable_run_options()
+          ? run_options->run_options()
+                .gpu_executable_run_options()
+                ->enable_mock_collectives()
+          : false;
+
+  // Cliques are created with the same number of channels as in executions.
+  int64_t collective_max_nchannels =
+      debug_options ? debug_options->xla_gpu_nccl_collective_max_nchannels()
+                    : 0;
+  int64_t p2p_max_nchannels =
+      debug_options ? debug_options->xla_gpu_nccl_p2p_max_nchannels() : 0;
+
+  // Acquiring cliques doesn't launch any work, so there is no need to borrow
+  // async streams for collectives.
+  absl::InlinedVector<se::Stream*, kAsyncStreamTotal> async_comms_streams(
+      kAsyncStreamTotal, nullptr);
+  TF_ASSIGN_OR_RETURN(Thunk::CollectiveExecuteParams collective_params,
+                      Thunk::CollectiveExecuteParams::Create(
+                          *run_options, async_comms_streams,
+                          run_options->stream()->parent()->device_ordinal(),
+                          collective_max_nchannels, p2p_max_nchannels));
+
+  TF_RETURN_IF_ERROR(
+      PrepareAndAcquireCollectiveCliques(debug_options, *thunks_,
+                                         collective_params, mock_collectives)
+          .status());
+  VLOG(2) << "Warmed up collective cliques for module " << module_name_;
   return absl::OkStatus();
 }
 
 int64_t GpuExecutable::SizeOfGeneratedCodeInBytes() const {
   // Non-empty PTX but empty cubin: compilation must have failed, return
   // "unknown".
-  if (binary().empty() && !text_.empty()) {
+  if (binary().empty() && !text().empty()) {
     return -1;
   }
   int64_t size = binary().size();
@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef XLA_SERVICE_GPU_GPU_EXECUTABLE_H_
 #define XLA_SERVICE_GPU_GPU_EXECUTABLE_H_
 
+#include <atomic>
 #include <cstdint>
 #include <memory>
 #include <optional>
@@ -136,7 +137,7 @@ class GpuExecutable : public Executable {
   // This may be left empty for saving memory if we have a non-empty binary.
   // If both text() and binary() are empty, that means the HLO required no
   // custom kernels to be compiled.
-  const std::string& text() const { return text_; }
+  const std::string& text() const { return code_->text; }
 
   // Returns the binary stored in this GpuExecutable.
   //
@@ -144,7 +145,10 @@ class GpuExecutable : public Executable {
   // in which case compilation is left up to the GPU driver. If both text() and
   // binary() are empty, that means the HLO required no custom kernels to be
   // compiled.
-  const std::vector<uint8_t>& binary() const { return binary_; }
+  //
+  // Executables with identical code and constants share the same text() and
+  // binary() storage.
+  const std::vector<uint8_t>& binary() const { return code_->binary; }
 
   const BinaryMap& dnn_compiled_graphs() const { return dnn_compiled_graphs_; }
 
@@ -191,6 +195,16 @@ class GpuExecutable : public Executable {
   absl::Status ExecuteThunks(const BufferAllocations& buffer_allocations,
                              const ServiceExecutableRunOptions* run_options);
 
+  // Acquires all collective cliques required to execute this executable with
+  // `run_options` without executing it. Cliques are created on first use and
+  // cached by the process, so calling this ahead of the first execution (e.g.
+  // concurrently with loading inputs) takes the clique creation latency off
+  // the first execution. Clique creation is a collective operation: like an
+  // execution, this must be called for all participating devices with the same
+  // run id.
+  absl::Status WarmUpCollectiveCliques(
+      const ServiceExecutableRunOptions* run_options);
+
   using BufferAllocToDeviceMemoryMap =
       absl::flat_hash_map<BufferAllocation::Index, se::DeviceMemoryBase>;
 
@@ -213,6 +227,24 @@ class GpuExecutable : public Executable {
   // Use GpuExecutable::Create() to create an instance.
   explicit GpuExecutable(Params params);
 
+  // The compiled code for the computation, see text() and binary().
+  struct Code {
+    std::string text;
+    std::vector<uint8_t> binary;
+  };
+
+  // Returns the code shared by all live executables with the same `text`,
+  // `binary` and `constants`, or a new one if there is none.
+  //
+  // StreamExecutor caches loaded modules by the address of their code, so
+  // executables compiled from common subgraphs, e.g. fine-tuned variants of
+  // one model, load their kernels and constant globals onto a device once.
+  // Constants that are initialized by XLA are written to the module globals,
+  // which is why they are part of the key.
+  static std::shared_ptr<const Code> InternCode(
+      std::string text, std::vector<uint8_t> binary,
+      absl::Span<const ConstantInfo> constants);
+
   // GpuExecutable check with either AMD's ISA version, or Nvidia's major minor
   // version for compute capability, depending on the hardware.
   absl::Status CheckCompatibilityWithServiceExecutableRunOptions(
@@ -238,14 +270,10 @@ class GpuExecutable : public Executable {
   // This string should be modified only before ExecuteOnStream.
   std::string ir_module_string_;
 
-  // The compiled code for the computation.
-  const std::string text_;
-
-  // The GPU machine code for the computation, targeting GPUs at
-  // compute_capability_.
-  //
-  // May be empty, in which case we leave compilation up to the GPU driver.
-  std::vector<uint8_t> binary_;
+  // The compiled code for the computation: the PTX and the GPU machine code
+  // targeting GPUs at compute_capability_. The machine code may be empty, in
+  // which case we leave compilation up to the GPU driver.
+  std::shared_ptr<const Code> code_;
 
   BinaryMap dnn_compiled_graphs_;
 
@@ -284,6 +312,9 @@ class GpuExecutable : public Executable {
 
   int64_t debug_buffer_assignment_show_max_;
 
+  // Number of executions, used to sample thunk device times.
+  std::atomic<int64_t> num_executions_{0};
+
   absl::Mutex module_handle_mutex_;
   // Cache of module handles. Required to keep loaded modules alive until this
   // executable is destroyed.
@@ -15,13 +15,22 @@ limitations under the License.
 
 #include "xla/service/gpu/gpu_executable.h"
 
+#include <cstdint>
+#include <memory>
 #include <optional>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include "xla/backends/gpu/runtime/sequential_thunk.h"
+#include "xla/backends/gpu/runtime/thunk.h"
 #include "xla/hlo/ir/hlo_input_output_alias_config.h"
+#include "xla/service/gpu/ir_emission_utils.h"
 #include "xla/shape_util.h"
 #include "xla/tsl/platform/status_matchers.h"
+#include "xla/tsl/platform/statusor.h"
 #include "xla/tsl/util/proto/proto_matchers.h"
 
 namespace xla::gpu {
@@ -74,5 +83,40 @@ TEST(GpuExecutableTest, OuputInfoToAndFromProto) {
               IsOkAndHolds(output_info2));
 }
 
+GpuExecutable::Params MakeParams(std::vector<uint8_t> constant) {
+  GpuExecutable::Params params;
+  params.asm_text = "ptx";
+  params.binary = {1, 2, 3, 4};
+  params.executable =
+      std::make_unique<SequentialThunk>(Thunk::ThunkInfo(), ThunkSequence());
+  params.constants.push_back(GpuExecutable::ConstantInfo{
+      "constant", DenseDataIntermediate::Own(std::move(constant)),
+      /*allocation_index=*/0});
+  params.module_name = "module";
+  params.enable_debug_info_manager = false;
+  return params;
+}
+
+TEST(GpuExecutableTest, ExecutablesWithIdenticalCodeAndConstantsShareCode) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<GpuExecutable> executable0,
+                          GpuExecutable::Create(MakeParams({5, 6})));
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<GpuExecutable> executable1,
+                          GpuExecutable::Create(MakeParams({5, 6})));
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<GpuExecutable> executable2,
+                          GpuExecutable::Create(MakeParams({7, 8})));
+
+  EXPECT_EQ(executable0->binary(), executable2->binary());
+  EXPECT_EQ(executable0->binary().data(), executable1->binary().data());
+  EXPECT_EQ(executable0->text().data(), executable1->text().data());
+  // Constants initialized by XLA are written to the module globals, so the
+  // module can't be shared by executables with different constants.
+  EXPECT_NE(executable0->binary().data(), executable2->binary().data());
+
+  const uint8_t* binary = executable1->binary().data();
+  executable0.reset();
+  EXPECT_EQ(executable1->binary().data(), binary);
+  EXPECT_EQ(executable1->binary(), std::vector<uint8_t>({1, 2, 3, 4}));
+}
+
 }  // namespace
 }  // namespace xla::gpu
@@ -140,6 +140,18 @@ bool GpuFloatSupport::IsSupported(const HloInstruction& hlo) const {
     }
     // Reduction.
     case HloOpcode::kReduce:
+      // Rounding the accumulator after every step loses accuracy quickly.
+      // Normalizing the reduction makes it accumulate in high precision,
+      // while the inserted converts are fused into it.
+      if (accumulate_reductions_in_high_precision_ &&
+          absl::c_any_of(hlo.called_computations().front()->instructions(),
+                         [](const HloInstruction* hlo) {
+                           return HloPredicateIsOp<HloOpcode::kAdd,
+                                                   HloOpcode::kMultiply,
+                                                   HloOpcode::kSubtract>(hlo);
+                         })) {
+        return false;
+      }
       return absl::c_all_of(hlo.called_computations().front()->instructions(),
                             [this](const HloInstruction* hlo) {
                               return hlo->opcode() == HloOpcode::kParameter ||
@@ -28,11 +28,17 @@ namespace gpu {
 
 class GpuFloatSupport : public FloatSupport {
  public:
+  // If `accumulate_reductions_in_high_precision` is set, reductions whose
+  // reducer adds, multiplies or subtracts are never kept in the low precision
+  // type, so that they accumulate in the high precision type.
   explicit GpuFloatSupport(se::GpuComputeCapability cc,
                            PrimitiveType low_precision_type,
-                           PrimitiveType high_precision_type = F32)
+                           PrimitiveType high_precision_type = F32,
+                           bool accumulate_reductions_in_high_precision = false)
       : FloatSupport(low_precision_type, high_precision_type),
-        compute_capability_(cc) {}
+        compute_capability_(cc),
+        accumulate_reductions_in_high_precision_(
+            accumulate_reductions_in_high_precision) {}
 
   bool SupportsLowPrecisionOperand(const HloInstruction& hlo,
                                    int64_t operand_index) const override {
@@ -50,6 +56,7 @@ class GpuFloatSupport : public FloatSupport {
   bool IsSupported(const HloInstruction& hlo) const;
 
   const se::GpuComputeCapability compute_capability_;
+  const bool accumulate_reductions_in_high_precision_;
 };
 
 }  // namespace gpu
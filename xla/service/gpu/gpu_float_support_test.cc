@@ -409,6 +409,49 @@ ENTRY main {
   EXPECT_TRUE(Normalize(module_with_unsupported_reducer.get(), cc, BF16, F32));
 }
 
+TEST_F(FloatSupportTest, BF16ReductionOnHopperCanAccumulateInF32) {
+  auto cc = se::CudaComputeCapability::Hopper();
+  constexpr absl::string_view kHloModuleTemplate = R"(
+HloModule m
+
+reducer {
+  p0 = bf16[] parameter(0)
+  p1 = bf16[] parameter(1)
+  ROOT reducer = bf16[] $0(p0, p1)
+}
+
+ENTRY main {
+  p0 = bf16[1024] parameter(0)
+  init = bf16[] constant(0)
+  ROOT r = bf16[] reduce(p0, init), dimensions={0}, to_apply=reducer
+})";
+  GpuFloatSupport float_support(cc, BF16, F32,
+                                /*accumulate_reductions_in_high_precision=*/
+                                true);
+  FloatNormalization normalization(&float_support);
+
+  TF_ASSERT_OK_AND_ASSIGN(auto module_with_add,
+                          ParseAndReturnVerifiedModule(
+                              absl::Substitute(kHloModuleTemplate, "add")));
+  TF_ASSERT_OK_AND_ASSIGN(bool changed,
+                          normalization.Run(module_with_add.get()));
+  EXPECT_TRUE(changed);
+  const HloInstruction* root =
+      module_with_add->entry_computation()->root_instruction();
+  EXPECT_EQ(root->opcode(), HloOpcode::kConvert);
+  EXPECT_EQ(root->operand(0)->opcode(), HloOpcode::kReduce);
+  EXPECT_EQ(root->operand(0)->shape().element_type(), F32);
+  EXPECT_EQ(root->operand(0)->operand(0)->opcode(), HloOpcode::kConvert);
+
+  // Maximum does not round, so it is kept in bf16.
+  TF_ASSERT_OK_AND_ASSIGN(auto module_with_maximum,
+                          ParseAndReturnVerifiedModule(absl::Substitute(
+                              kHloModuleTemplate, "maximum")));
+  TF_ASSERT_OK_AND_ASSIGN(changed,
+                          normalization.Run(module_with_maximum.get()));
+  EXPECT_FALSE(changed);
+}
+
 TEST_F(FloatSupportTest, BF16LogAndExpOnRocmIsNormalized) {
   auto cc = se::RocmComputeCapability();
   constexpr absl::string_view kHloModule = R"(
@@ -571,7 +571,8 @@ absl::Status RunLatencyHidingSchedulerPasses(
         dynamic_cast<ProfileGuidedLatencyEstimator&>(*estimator));
   }
 
-  auto async_tracker = std::make_unique<GpuAsyncTracker>(config);
+  auto async_tracker = std::make_unique<GpuAsyncTracker>(
+      config, options.xla_gpu_experimental_scheduler_num_devices_per_host());
   auto scheduler_core = std::make_unique<DefaultSchedulerCore>(
       shape_size_in_bytes, async_tracker.get(), estimator.get(), config,
       /*target_scheduling_rule=*/nullptr,
@@ -698,8 +699,12 @@ absl::StatusOr<ScheduleMetadata> ScheduleGpuModule(
   // Run Latency Hiding Scheduler (LHS). It maximizes the compute-communication
   // overlap, potentially at the cost of memory usage.
   if (enable_latency_hiding_scheduler) {
+    // HLO rematerialization uses `memory_limit` from the returned metadata,
+    // so any headroom LHS uses for extra overlap is rematerialized away.
     TF_RETURN_IF_ERROR(RunLatencyHidingSchedulerPasses(
-        module, pointer_size, fingerprint, memory_limit, gpu_device_info));
+        module, pointer_size, fingerprint,
+        GetLatencyHidingSchedulerMemoryLimit(*module, memory_limit),
+        gpu_device_info));
   }
 
   return ScheduleMetadata{memory_limit};
@@ -785,6 +790,18 @@ uint64_t GetSchedulerMemoryLimit(const HloModule& module,
          100;
 }
 
+uint64_t GetLatencyHidingSchedulerMemoryLimit(const HloModule& module,
+                                              uint64_t memory_limit) {
+  int32_t headroom_percent =
+      module.config()
+          .debug_options()
+          .xla_gpu_experimental_lhs_rematerialization_headroom_percent();
+  if (headroom_percent <= 0) {
+    return memory_limit;
+  }
+  return memory_limit + memory_limit / 100 * headroom_percent;
+}
+
 SchedulerConfig MakeGPUSchedulerConfig(uint64_t memory_limit,
                                        int64_t overlap_limit) {
   SchedulerConfig config;
@@ -48,6 +48,12 @@ uint64_t GetSchedulerMemoryLimit(const HloModule& module,
                                  const se::DeviceDescription& gpu_device_info,
                                  int pointer_size);
 
+// Returns the memory limit for the latency hiding scheduler, which exceeds the
+// scheduler `memory_limit` by the headroom requested in the module debug
+// options. The excess is removed by HLO rematerialization after scheduling.
+uint64_t GetLatencyHidingSchedulerMemoryLimit(const HloModule& module,
+                                              uint64_t memory_limit);
+
 // Determines the schedule of HLO instructions for a module run on the GPU.
 absl::StatusOr<ScheduleMetadata> ScheduleGpuModule(
     HloModule* module, int64_t pointer_size,
@@ -292,6 +292,17 @@ TEST_F(GpuHloScheduleTest, AsyncCollectivePermute) {
   EXPECT_TRUE(HasValidFingerprint(module.get()));
 }
 
+TEST_F(GpuHloScheduleTest, LHSMemoryLimitIncludesRematerializationHeadroom) {
+  std::unique_ptr<HloModule> module = CreateNewVerifiedModule();
+  EXPECT_EQ(GetLatencyHidingSchedulerMemoryLimit(*module, 1000), 1000);
+
+  DebugOptions debug_options = module->config().debug_options();
+  debug_options.set_xla_gpu_experimental_lhs_rematerialization_headroom_percent(
+      20);
+  module->mutable_config().set_debug_options(debug_options);
+  EXPECT_EQ(GetLatencyHidingSchedulerMemoryLimit(*module, 1000), 1200);
+}
+
 TEST_F(GpuHloScheduleTest, LHSCostModel) {
   const char* hlo_text = R"(
   HloModule AsyncAR
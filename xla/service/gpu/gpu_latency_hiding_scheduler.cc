@@ -22,11 +22,15 @@ limitations under the License.
 #include <utility>
 #include <vector>
 
+#include "absl/algorithm/container.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/log/check.h"
 #include "absl/log/log.h"
+#include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_casting_utils.h"
 #include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_instructions.h"
 #include "xla/hlo/ir/hlo_opcode.h"
 #include "xla/hlo/utils/hlo_query.h"
 #include "xla/service/collective_ops_utils.h"
@@ -219,13 +223,29 @@ bool GpuScheduleCrossesOverlapLimit(
     return false;
   }
   auto resource_type = node->GetResources().at(0).first;
+  const int64_t kCollectiveResources[] = {
+      xla::ResourceTypeToIndex(GpuResourceType::kGpuAsyncStreamCollectives),
+      xla::ResourceTypeToIndex(
+          GpuResourceType::kGpuAsyncStreamCollectivesCrossHost)};
+  if (!absl::c_linear_search(kCollectiveResources, resource_type)) {
+    return false;
+  }
+
+  // In-flight collectives on both the single host and cross host resources.
+  std::vector<const HloInstruction*> in_flight_collectives;
+  for (int64_t collective_resource : kCollectiveResources) {
+    auto it = sched_state.resource_occupiers_in_flight.find(
+        collective_resource);
+    if (it != sched_state.resource_occupiers_in_flight.end()) {
+      in_flight_collectives.insert(in_flight_collectives.end(),
+                                   it->second.begin(), it->second.end());
+    }
+  }
+
   // If the candidate collective has more than 1 overlapping ranks with
   // in-flight collectives, they can form cyclic dependency and cannot be
   // overlapped
-  if (resource_type == xla::ResourceTypeToIndex(
-                           GpuResourceType::kGpuAsyncStreamCollectives) &&
-      sched_state.resource_occupiers_in_flight.contains(resource_type) &&
-      !sched_state.resource_occupiers_in_flight.at(resource_type).empty()) {
+  if (!in_flight_collectives.empty()) {
     const HloInstruction& curr_hlo_inst = node->GetInstr();
     if (sched_state.async_tracker->IsSupportedAsyncDone(curr_hlo_inst)) {
       CHECK(
@@ -237,8 +257,7 @@ bool GpuScheduleCrossesOverlapLimit(
 
       // If candidate can be overlapped with in-flight collectives
       bool can_overlap = true;
-      for (const auto async_occupier :
-           sched_state.resource_occupiers_in_flight.at(resource_type)) {
+      for (const auto async_occupier : in_flight_collectives) {
         if (sched_state.async_tracker->IsSupportedAsyncStart(*async_occupier)) {
           const HloInstruction* occupier =
               async_occupier->opcode() == HloOpcode::kAsyncStart
@@ -356,8 +375,32 @@ void GpuAsyncTrackerBase::PostProcessScheduleGraph(
 //===----------------------------------------------------------------------===//
 // GpuAsyncTracker
 //===----------------------------------------------------------------------===//
-GpuAsyncTracker::GpuAsyncTracker(const SchedulerConfig& config)
-    : GpuAsyncTrackerBase(config) {}
+GpuAsyncTracker::GpuAsyncTracker(const SchedulerConfig& config,
+                                 int num_devices_per_host)
+    : GpuAsyncTrackerBase(config),
+      num_devices_per_host_(num_devices_per_host) {}
+
+bool GpuAsyncTracker::IsCrossHostCollective(const HloInstruction& instr) const {
+  if (num_devices_per_host_ <= 0) {
+    return false;
+  }
+  const HloInstruction* start =
+      GetCanonicalAsyncOp(instr).outer == HloOpcode::kAsyncDone
+          ? instr.operand(0)
+          : &instr;
+  if (start->opcode() == HloOpcode::kAsyncStart) {
+    start = start->async_wrapped_instruction();
+  }
+  auto* channel_instr = DynCast<HloChannelInstruction>(start);
+  if (channel_instr == nullptr) {
+    return false;
+  }
+  absl::StatusOr<bool> single_host =
+      IsSingleHostCollective(num_devices_per_host_, *channel_instr);
+  // Collectives with non homogeneous replica groups keep using the default
+  // collectives resource.
+  return single_host.ok() && !*single_host;
+}
 
 static bool IsAnnotatedForGpuAsyncStreamCollectivesP2P(
     const HloInstruction& instr) {
@@ -389,9 +432,13 @@ ResourcesVector GpuAsyncTracker::GetResourcesFromInstructionImpl(
       usage = op.outer == HloOpcode::kAsyncStart
                   ? ResourceUsageType::kResourceRelease
                   : ResourceUsageType::kResourceOccupy;
-      resource = hlo_query::IsCollectiveCommunicationOp(op.inner)
-                     ? GpuResourceType::kGpuAsyncStreamCollectives
-                     : GpuResourceType::kGpuAsyncStreamComputes;
+      if (!hlo_query::IsCollectiveCommunicationOp(op.inner)) {
+        resource = GpuResourceType::kGpuAsyncStreamComputes;
+      } else if (IsCrossHostCollective(instr)) {
+        resource = GpuResourceType::kGpuAsyncStreamCollectivesCrossHost;
+      } else {
+        resource = GpuResourceType::kGpuAsyncStreamCollectives;
+      }
     }
     return {std::make_pair(ResourceTypeToIndex(resource), usage)};
   }
@@ -431,7 +478,10 @@ int64_t GpuAsyncTracker::GetNumAvailableResources(int64_t resource_type) const {
   }
 
   if (resource_type ==
-      ResourceTypeToIndex(GpuResourceType::kGpuAsyncStreamCollectives)) {
+          ResourceTypeToIndex(GpuResourceType::kGpuAsyncStreamCollectives) ||
+      resource_type ==
+          ResourceTypeToIndex(
+              GpuResourceType::kGpuAsyncStreamCollectivesCrossHost)) {
     return config_.parallel_collective_overlap_limit;
   }
 
@@ -473,6 +523,8 @@ absl::string_view GpuAsyncTracker::GetResourceName(
       return "kGpuAsyncStreamCollectives";
     case GpuResourceType::kGpuAsyncStreamComputes:
       return "kGpuAsyncStreamComputes";
+    case GpuResourceType::kGpuAsyncStreamCollectivesCrossHost:
+      return "kGpuAsyncStreamCollectivesCrossHost";
     default:
       return "kUnsupportedResource";
   }
@@ -52,6 +52,10 @@ bool GpuScheduleCrossesOverlapLimit(
 // collective operations and P2P Send and Recv operations. This corresponds to
 // the fact that the runtime use a stream to run asynchronous collective
 // operations and two other streams to run P2P Send and Recv operations.
+//
+// If the number of devices per host is known, collectives that communicate
+// across hosts use a separate resource from collectives within a host, so that
+// a network bound collective can be in flight together with an NVLink one.
 enum class GpuResourceType {
   kGpuAsyncStreamCollectivesP2P = ResourceTypeToIndex(
       ResourceType::kTargetDefinedResourceTypeBegin),  // Resource for P2P
@@ -64,6 +68,8 @@ enum class GpuResourceType {
   kGpuAsyncStreamRecv1,        // Another resource for P2P Recv operation.
   kGpuAsyncStreamCollectives,  // The resource for collective operations.
   kGpuAsyncStreamComputes,     // The resource for async compute operations.
+  kGpuAsyncStreamCollectivesCrossHost,  // The resource for collective
+                                        // operations across hosts.
   kGpuResourceTypeEnd,
 };
 
@@ -92,7 +98,10 @@ class GpuAsyncTrackerBase : public AsyncTracker {
 // GPU async tracker maps all collectives onto an async stream resource.
 class GpuAsyncTracker : public GpuAsyncTrackerBase {
  public:
-  explicit GpuAsyncTracker(const SchedulerConfig& config);
+  // If `num_devices_per_host` is positive, collectives spanning multiple
+  // hosts are mapped onto a separate resource.
+  explicit GpuAsyncTracker(const SchedulerConfig& config,
+                           int num_devices_per_host = 0);
 
   // Returns resources used (occupied or released) by `instr`.
   ResourcesVector GetResourcesFromInstructionImpl(
@@ -117,6 +126,12 @@ class GpuAsyncTracker : public GpuAsyncTrackerBase {
   // this instruction.
   int64_t GetNumResourcesPerInstruction(
       int64_t resource_type, const HloInstruction& instr) const override;
+
+ private:
+  // Returns true if the collective `instr` communicates across hosts.
+  bool IsCrossHostCollective(const HloInstruction& instr) const;
+
+  int num_devices_per_host_;
 };
 
 // GPU approximate latency estimator. It is a set of hardcoded heuristics
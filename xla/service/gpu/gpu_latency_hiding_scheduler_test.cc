@@ -31,6 +31,7 @@ limitations under the License.
 #include "xla/hlo/ir/hlo_opcode.h"
 #include "xla/service/gpu/gpu_hlo_schedule.h"
 #include "xla/service/hlo_module_config.h"
+#include "xla/service/latency_hiding_scheduler.h"
 #include "xla/service/profile_guided_latency_estimator.h"
 #include "xla/tests/hlo_test_base.h"
 #include "xla/tsl/lib/core/status_test_util.h"
@@ -912,5 +913,54 @@ ENTRY main {
             GetIndexByName(main_instructions, "all-reduce-done"));
 }
 
+TEST_F(GpuLatencyHidingSchedulerBaseTest,
+       CrossHostCollectivesUseSeparateResource) {
+  absl::string_view kHloModule = R"(
+    HloModule m, replica_count=4
+
+    add {
+      x = f32[] parameter(0)
+      y = f32[] parameter(1)
+      ROOT add = f32[] add(x, y)
+    }
+
+    ENTRY main {
+      p = f32[1024] parameter(0)
+      intra_start = f32[1024] all-reduce-start(p), to_apply=add,
+        replica_groups={{0,1},{2,3}}
+      intra_done = f32[1024] all-reduce-done(intra_start)
+      inter_start = f32[1024] all-reduce-start(p), to_apply=add,
+        replica_groups={{0,2},{1,3}}
+      inter_done = f32[1024] all-reduce-done(inter_start)
+      ROOT tuple = (f32[1024], f32[1024]) tuple(intra_done, inter_done)
+    }
+  )";
+
+  TF_ASSERT_OK_AND_ASSIGN(auto module,
+                          ParseAndReturnVerifiedModule(kHloModule));
+  auto resource_of = [&](const GpuAsyncTracker& tracker,
+                         absl::string_view name) {
+    HloInstruction* instr = FindInstruction(module.get(), name);
+    ResourcesVector resources = tracker.GetResourcesFromInstructionImpl(*instr);
+    CHECK_EQ(resources.size(), 1);
+    return resources[0].first;
+  };
+  const int64_t kCollectives =
+      ResourceTypeToIndex(GpuResourceType::kGpuAsyncStreamCollectives);
+  const int64_t kCrossHost = ResourceTypeToIndex(
+      GpuResourceType::kGpuAsyncStreamCollectivesCrossHost);
+
+  SchedulerConfig config;
+  GpuAsyncTracker topology_aware_tracker(config, /*num_devices_per_host=*/2);
+  EXPECT_EQ(resource_of(topology_aware_tracker, "intra_start"), kCollectives);
+  EXPECT_EQ(resource_of(topology_aware_tracker, "intra_done"), kCollectives);
+  EXPECT_EQ(resource_of(topology_aware_tracker, "inter_start"), kCrossHost);
+  EXPECT_EQ(resource_of(topology_aware_tracker, "inter_done"), kCrossHost);
+
+  GpuAsyncTracker default_tracker(config);
+  EXPECT_EQ(resource_of(default_tracker, "inter_start"), kCollectives);
+  EXPECT_EQ(resource_of(default_tracker, "inter_done"), kCollectives);
+}
+
 }  // namespace
 }  // namespace xla::gpu
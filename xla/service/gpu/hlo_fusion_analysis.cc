@@ -245,6 +245,10 @@ HloFusionAnalysis::EmitterFusionKind HloFusionAnalysis::GetEmitterFusionKind()
     return EmitterFusionKind::kCuDnn;
   }
 
+  if (fusion_backend_config_.kind() == kNormalizationFusionKind) {
+    return EmitterFusionKind::kNormalization;
+  }
+
   std::optional<HloInstructionAdaptor> first_reduce_hero;
   for (auto [root, hero] : llvm::zip(fusion_roots(), fusion_heroes())) {
     if (IsRealReductionHero(root.instruction(), hero.instruction(),
@@ -46,6 +46,7 @@ class HloFusionAnalysis {
     kScatter,
     kCuDnn,
     kDynamicMemcpy,
+    kNormalization,
   };
 
   // Precomputed information about inputs (arguments) and outputs (roots) of the
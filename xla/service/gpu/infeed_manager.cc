@@ -15,21 +15,27 @@ limitations under the License.
 
 #include "xla/service/gpu/infeed_manager.h"
 
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <limits>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "absl/log/check.h"
 #include "absl/log/log.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/types/span.h"
+#include "xla/backends/gpu/runtime/host_memory_pool.h"
 #include "xla/literal.h"
 #include "xla/service/gpu/xfeed_queue.h"
 #include "xla/shape.h"
 #include "xla/shape_tree.h"
 #include "xla/shape_util.h"
 #include "xla/stream_executor/device_memory_handle.h"
+#include "xla/stream_executor/memory_allocation.h"
 #include "xla/util.h"
 #include "tsl/platform/errors.h"
 #include "tsl/platform/statusor.h"
@@ -45,8 +51,12 @@ InfeedManager::InfeedManager(se::StreamExecutor* executor)
   stream_->SetName("Infeed manager");
 }
 
+// Copies `size` bytes from `source` to a new device buffer. The data is staged
+// through pinned host memory, so the copy is a DMA transfer; staging buffers
+// are appended to `staging` and must be kept alive until the copy completes.
 static absl::StatusOr<se::DeviceMemoryHandle> CopyBufferToDevice(
-    se::Stream* stream, int64_t size, const void* source) {
+    se::Stream* stream, int64_t size, const void* source,
+    std::vector<std::unique_ptr<se::MemoryAllocation>>& staging) {
   if (size > std::numeric_limits<int32_t>::max()) {
     return InvalidArgument("GPU infeed of %d bytes exceeds maximum of %d bytes",
                            size, std::numeric_limits<int32_t>::max());
@@ -59,19 +69,26 @@ static absl::StatusOr<se::DeviceMemoryHandle> CopyBufferToDevice(
   se::StreamExecutor* executor = stream->parent();
   se::DeviceMemoryHandle buffer(executor,
                                 executor->AllocateArray<uint8_t>(size));
-  TF_RETURN_IF_ERROR(stream->Memcpy(buffer.memory_ptr(), source, size));
+
+  TF_ASSIGN_OR_RETURN(std::unique_ptr<se::MemoryAllocation> pinned,
+                      HostMemoryAllocator::Get(executor)->Allocate(size));
+  std::memcpy(pinned->opaque(), source, size);
+  TF_RETURN_IF_ERROR(
+      stream->Memcpy(buffer.memory_ptr(), pinned->opaque(), size));
+  staging.push_back(std::move(pinned));
 
   return std::move(buffer);
 }
 
-absl::Status InfeedManager::TransferLiteralToInfeed(
-    se::StreamExecutor* executor, const LiteralSlice& literal) {
+// Copies the arrays of `literal` to new device buffers, see
+// CopyBufferToDevice.
+static absl::StatusOr<ShapeTree<se::DeviceMemoryHandle>> CopyLiteralToDevice(
+    se::Stream* stream, const LiteralSlice& literal,
+    std::vector<std::unique_ptr<se::MemoryAllocation>>& staging) {
   const Shape& literal_shape = literal.shape();
   VLOG(2) << "Transferring literal to infeed with shape: "
           << ShapeUtil::HumanString(literal_shape);
 
-  BlockUntilEnqueueSlotAvailable();
-
   // For a tuple, we transfer each of its elements to the device and enqueue the
   // resulting destination device addresses with the infeed manager.
   ShapeTree<se::DeviceMemoryHandle> buffer_tree(literal_shape);
@@ -80,20 +97,49 @@ absl::Status InfeedManager::TransferLiteralToInfeed(
     CHECK(sub_shape.IsArray()) << ShapeUtil::HumanStringWithLayout(sub_shape);
     TF_ASSIGN_OR_RETURN(
         leaf.second,
-        CopyBufferToDevice(stream(), ShapeUtil::ByteSizeOf(sub_shape),
-                           literal.untyped_data(leaf.first)));
+        CopyBufferToDevice(stream, ShapeUtil::ByteSizeOf(sub_shape),
+                           literal.untyped_data(leaf.first), staging));
   }
+  return buffer_tree;
+}
 
-  // TODO(b/30467474): Since this stream is shared across different infeed
-  // requests, blocking on the stream might be heavy-handed. Figure out if
-  // finer-grained acknowledgement is possible.
-  absl::Status block_status = stream()->BlockHostUntilDone();
-  if (!block_status.ok()) {
-    return Internal("Failed to complete data transfer on stream %p: %s",
-                    stream(), block_status.message());
-  }
+absl::Status InfeedManager::TransferLiteralToInfeed(
+    se::StreamExecutor* executor, const LiteralSlice& literal) {
+  return TransferLiteralsToInfeed(executor, absl::MakeConstSpan(&literal, 1));
+}
 
-  EnqueueDestination(std::move(buffer_tree));
+absl::Status InfeedManager::TransferLiteralsToInfeed(
+    se::StreamExecutor* executor, absl::Span<const LiteralSlice> literals) {
+  // Each group reserves at most all enqueue slots, so that it never waits for
+  // a slot that only its own enqueue would free.
+  for (size_t begin = 0; begin < literals.size();
+       begin += kMaxInfeedsInFlight) {
+    absl::Span<const LiteralSlice> group =
+        literals.subspan(begin, kMaxInfeedsInFlight);
+
+    std::vector<ShapeTree<se::DeviceMemoryHandle>> buffer_trees;
+    std::vector<std::unique_ptr<se::MemoryAllocation>> staging;
+    buffer_trees.reserve(group.size());
+    for (const LiteralSlice& literal : group) {
+      BlockUntilEnqueueSlotAvailable();
+      TF_ASSIGN_OR_RETURN(ShapeTree<se::DeviceMemoryHandle> buffer_tree,
+                          CopyLiteralToDevice(stream(), literal, staging));
+      buffer_trees.push_back(std::move(buffer_tree));
+    }
+
+    // TODO(b/30467474): Since this stream is shared across different infeed
+    // requests, blocking on the stream might be heavy-handed. Figure out if
+    // finer-grained acknowledgement is possible.
+    absl::Status block_status = stream()->BlockHostUntilDone();
+    if (!block_status.ok()) {
+      return Internal("Failed to complete data transfer on stream %p: %s",
+                      stream(), block_status.message());
+    }
+
+    for (ShapeTree<se::DeviceMemoryHandle>& buffer_tree : buffer_trees) {
+      EnqueueDestination(std::move(buffer_tree));
+    }
+  }
   return absl::OkStatus();
 }
 
@@ -23,6 +23,7 @@ limitations under the License.
 #include <memory>
 
 #include "absl/status/status.h"
+#include "absl/types/span.h"
 #include "xla/literal.h"
 #include "xla/service/gpu/xfeed_queue.h"
 #include "xla/shape_tree.h"
@@ -53,6 +54,12 @@ class InfeedManager
   absl::Status TransferLiteralToInfeed(se::StreamExecutor* executor,
                                        const LiteralSlice& literal);
 
+  // Transfers a batch of literals to the infeed, in order. Up to the maximum
+  // number of pending infeeds are copied to the device at once and waited for
+  // together, instead of synchronizing the stream after every literal.
+  absl::Status TransferLiteralsToInfeed(
+      se::StreamExecutor* executor, absl::Span<const LiteralSlice> literals);
+
  private:
   se::Stream* stream() const { return stream_.get(); }
 
@@ -99,6 +99,10 @@ inline constexpr absl::string_view kCuDnnFusionKind = "__cudnn$fusion";
 inline constexpr absl::string_view kDynamicMemcpyFusionKind =
     "__dynamic_memcpy";
 
+// Row normalizations (e.g. RMSNorm or LayerNorm) that are emitted by the native
+// normalization emitter, one block per row.
+inline constexpr absl::string_view kNormalizationFusionKind = "__normalization";
+
 inline constexpr absl::string_view kUncompilableFusion =
     "__uncompilable_fusion";
 
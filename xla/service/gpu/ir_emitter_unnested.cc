@@ -2323,6 +2323,36 @@ IrEmitterUnnested::BuildKernelThunkForNonFusionOp(
   return {{inputs, outputs}};
 }
 
+// Returns the index of the largest array element of the state of `loop` that
+// the loop body passes through unchanged and that fits in the L2 cache. Such
+// elements, e.g. the weights of a scan loop, are re-read by every iteration.
+static std::optional<ShapeIndex> FindL2PersistingLoopInvariant(
+    const HloInstruction* loop, int64_t l2_cache_size) {
+  const HloComputation* body = loop->while_body();
+  const HloInstruction* root = body->root_instruction();
+  const HloInstruction* param = body->parameter_instruction(0);
+  if (root->opcode() != HloOpcode::kTuple) {
+    return std::nullopt;
+  }
+
+  std::optional<ShapeIndex> largest;
+  int64_t largest_size = 0;
+  for (int64_t i = 0; i < root->operand_count(); ++i) {
+    const HloInstruction* operand = root->operand(i);
+    if (operand->opcode() != HloOpcode::kGetTupleElement ||
+        operand->operand(0) != param || operand->tuple_index() != i ||
+        !operand->shape().IsArray()) {
+      continue;
+    }
+    int64_t size = ShapeUtil::ByteSizeOf(operand->shape());
+    if (size > largest_size && size <= l2_cache_size) {
+      largest = ShapeIndex({i});
+      largest_size = size;
+    }
+  }
+  return largest;
+}
+
 absl::StatusOr<std::unique_ptr<Thunk>> IrEmitterUnnested::BuildWhileThunk(
     const HloInstruction* instr, const Thunk::ThunkInfo& thunk_info,
     std::optional<int64_t> trip_count) {
@@ -2348,10 +2378,24 @@ absl::StatusOr<std::unique_ptr<Thunk>> IrEmitterUnnested::BuildWhileThunk(
       Thunk::ThunkInfo::WithProfileAnnotation(instr);
   body_thunk_info.profile_annotation += "_body";
 
-  return std::unique_ptr<Thunk>(new WhileThunk(
+  auto while_thunk = std::make_unique<WhileThunk>(
       thunk_info, instr, pred,
       ir_emitter_condition->ConsumeThunkSequence(cond_thunk_info),
-      ir_emitter_body->ConsumeThunkSequence(body_thunk_info), trip_count));
+      ir_emitter_body->ConsumeThunkSequence(body_thunk_info), trip_count);
+
+  if (ir_emitter_context_->debug_options()
+          .xla_gpu_experimental_l2_persist_loop_invariants()) {
+    std::optional<ShapeIndex> invariant = FindL2PersistingLoopInvariant(
+        instr, ir_emitter_context_->gpu_device_info().l2_cache_size());
+    if (invariant.has_value()) {
+      TF_ASSIGN_OR_RETURN(BufferAllocation::Slice slice,
+                          GetAllocationSliceForHlo(instr, *invariant));
+      VLOG(2) << "Persisting " << slice.ToString() << " in L2 for "
+              << instr->name();
+      while_thunk->set_l2_persisting_buffer(slice);
+    }
+  }
+  return while_thunk;
 }
 
 absl::Status IrEmitterUnnested::EmitTargetElementLoop(
@@ -14,28 +14,39 @@ limitations under the License.
 ==============================================================================*/
 #include "xla/service/gpu/kernel_reuse_cache.h"
 
+#include <array>
+#include <cstdint>
 #include <functional>
 #include <string>
 #include <utility>
+#include <vector>
 
+#include "absl/algorithm/container.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/escaping.h"
+#include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_join.h"
 #include "absl/strings/string_view.h"
+#include "absl/time/clock.h"
 #include "absl/types/span.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/SHA256.h"
 #include "xla/codegen/emitters/kernel_arguments.h"
 #include "xla/hlo/ir/hlo_computation.h"
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/service/gpu/executable.pb.h"
 #include "xla/service/gpu/launch_dimensions.h"
 #include "xla/status_macros.h"
+#include "xla/stream_executor/device_description.h"
 #include "xla/stream_executor/launch_dim.h"
 #include "xla/util.h"
 #include "tsl/platform/env.h"
 #include "tsl/platform/errors.h"
 #include "tsl/platform/logging.h"
+#include "tsl/platform/path.h"
 
 namespace xla {
 namespace gpu {
@@ -72,6 +83,22 @@ std::string GetArgumentFingerprint(
                        });
 }
 
+// Bump this version when the format of the kernel cache directory changes in
+// a way that makes old entries unusable.
+constexpr absl::string_view kKernelCacheDirVersion = "xla_gpu_kernel_cache_v1";
+
+// Extension of kernel cache directory entries. Temporary files written by
+// concurrent compilations don't have it.
+constexpr absl::string_view kKernelCacheFileExtension = ".kernel";
+
+std::string Sha256HexString(absl::string_view s) {
+  llvm::SHA256 sha256;
+  sha256.update(llvm::StringRef(s.data(), s.size()));
+  std::array<uint8_t, 32> hash = sha256.final();
+  return absl::BytesToHexString(absl::string_view(
+      reinterpret_cast<const char*>(hash.data()), hash.size()));
+}
+
 }  // namespace
 
 std::string GetComputationFingerprint(
@@ -182,6 +209,88 @@ absl::Status UpdateDiskKernelCache(
   return absl::OkStatus();
 }
 
+std::string GetKernelCacheDeviceDir(
+    absl::string_view cache_dir,
+    const se::DeviceDescription& device_description) {
+  std::string device_key = Sha256HexString(
+      absl::StrCat(kKernelCacheDirVersion,
+                   device_description.ToGpuProto().SerializeAsString()));
+  return tsl::io::JoinPath(cache_dir, device_key);
+}
+
+absl::StatusOr<CompilationCacheProto> LoadKernelCacheDir(
+    absl::string_view device_dir) {
+  tsl::Env* env = tsl::Env::Default();
+  CompilationCacheProto proto;
+  if (!env->IsDirectory(std::string(device_dir)).ok()) {
+    VLOG(1) << "Kernel cache directory does not exist: " << device_dir;
+    return proto;
+  }
+
+  std::vector<std::string> files;
+  TF_RETURN_IF_ERROR(env->GetChildren(std::string(device_dir), &files));
+  // Sort files to load the same kernels for the same directory content.
+  absl::c_sort(files);
+
+  for (const std::string& file : files) {
+    if (!absl::EndsWith(file, kKernelCacheFileExtension)) {
+      continue;
+    }
+    std::string serialized;
+    TF_RETURN_IF_ERROR(tsl::ReadFileToString(
+        env, tsl::io::JoinPath(device_dir, file), &serialized));
+    CompilationCacheProto kernel;
+    if (!kernel.ParseFromString(serialized)) {
+      return Internal("Failed to parse kernel cache file %s.", file);
+    }
+    for (const auto& [name, entry] : kernel.entries()) {
+      if (!proto.mutable_entries()->insert({name, entry}).second) {
+        VLOG(5) << "Skipping cached kernel with a duplicate name: " << name;
+      }
+    }
+  }
+
+  VLOG(2) << "Loaded " << proto.entries_size() << " / " << files.size()
+          << " kernels from the cache directory " << device_dir;
+  return proto;
+}
+
+absl::Status UpdateKernelCacheDir(
+    absl::string_view device_dir, const CompilationCacheProto& current_cache,
+    absl::Span<const KernelReuseCache::NamedBinary> binaries_to_cache) {
+  tsl::Env* env = tsl::Env::Default();
+  TF_RETURN_IF_ERROR(env->RecursivelyCreateDir(std::string(device_dir)));
+
+  for (const auto& [name, binary] : binaries_to_cache) {
+    auto it_current = current_cache.entries().find(name);
+    TF_RET_CHECK(it_current != current_cache.entries().end());
+    TF_RET_CHECK(!binary.empty());
+
+    CompilationCacheProto kernel;
+    CompilationCacheEntryProto& entry = (*kernel.mutable_entries())[name];
+    entry = it_current->second;
+    entry.set_binary(reinterpret_cast<const char*>(binary.data()),
+                     binary.size());
+
+    // Rename trick: write to a temporary file, then rename it to the final
+    // file to avoid reading incomplete files from concurrent compilations.
+    std::string key = Sha256HexString(entry.fingerprint());
+    std::string file_path = tsl::io::JoinPath(
+        device_dir, absl::StrCat(key, kKernelCacheFileExtension));
+    std::string tmp_file_path = tsl::io::JoinPath(
+        device_dir, absl::StrCat("tmp_", key, "_", absl::GetCurrentTimeNanos(),
+                                 "_", env->GetCurrentThreadId()));
+    TF_RETURN_IF_ERROR(tsl::WriteStringToFile(env, tmp_file_path,
+                                              kernel.SerializeAsString()));
+    TF_RETURN_IF_ERROR(env->RenameFile(tmp_file_path, file_path));
+    VLOG(5) << "Cached kernel: " << name << ": " << binary.size();
+  }
+
+  VLOG(2) << "Stored " << binaries_to_cache.size()
+          << " kernels in the cache directory " << device_dir;
+  return absl::OkStatus();
+}
+
 std::pair<absl::StatusOr<const KernelReuseCache::Entry*>, bool>
 KernelReuseCache::GetWithStatus(
     const HloComputation* fused_computation,
@@ -31,6 +31,7 @@ limitations under the License.
 #include "xla/hlo/ir/hlo_computation.h"
 #include "xla/service/gpu/executable.pb.h"
 #include "xla/service/gpu/launch_dimensions.h"
+#include "xla/stream_executor/device_description.h"
 #include "xla/stream_executor/gpu/tma_metadata.h"
 #include "xla/stream_executor/launch_dim.h"
 
@@ -104,6 +105,30 @@ absl::Status UpdateDiskKernelCache(
     const CompilationCacheProto& current_cache,
     absl::Span<const KernelReuseCache::NamedBinary> binaries_to_cache);
 
+// Persistent kernel cache directory is a sharded alternative to a single cache
+// file: every kernel is stored in a separate file named after the hash of its
+// computation fingerprint, in a subdirectory specific to the target device.
+// Files are written with the rename trick, so the cache directory can be shared
+// by concurrently running compilations in different processes.
+
+// Returns the subdirectory of `cache_dir` that holds kernels compiled for the
+// given device.
+std::string GetKernelCacheDeviceDir(
+    absl::string_view cache_dir,
+    const se::DeviceDescription& device_description);
+
+// Loads all kernels stored in `device_dir`. Kernels compiled by different
+// processes can have the same name, only the first kernel with a given name is
+// loaded, others will be recompiled if needed.
+absl::StatusOr<CompilationCacheProto> LoadKernelCacheDir(
+    absl::string_view device_dir);
+
+// Adds kernels to `device_dir`. Binaries are taken from binaries_to_cache,
+// all other kernel properties are taken from current_cache.
+absl::Status UpdateKernelCacheDir(
+    absl::string_view device_dir, const CompilationCacheProto& current_cache,
+    absl::Span<const KernelReuseCache::NamedBinary> binaries_to_cache);
+
 // Calculates the fingerprint of a (fused_computation, kernel_arguments,
 // discriminator) tuple.
 //
@@ -14,10 +14,14 @@ limitations under the License.
 ==============================================================================*/
 #include "xla/service/gpu/kernel_reuse_cache.h"
 
+#include <string>
+
 #include <gtest/gtest.h>
 #include "absl/log/check.h"
 #include "xla/service/gpu/executable.pb.h"
+#include "xla/service/gpu/gpu_device_info_for_tests.h"
 #include "xla/tsl/lib/core/status_test_util.h"
+#include "xla/tsl/platform/statusor.h"
 #include "tsl/platform/env.h"
 
 namespace xla {
@@ -77,6 +81,45 @@ TEST_F(KernelReuseTest, UpdatingDiskKernelCacheWorks) {
   EXPECT_EQ(proto.entries_size(), 2);
 }
 
+TEST_F(KernelReuseTest, UpdatingKernelCacheDirWorks) {
+  std::string cache_dir;
+  CHECK(tsl::Env::Default()->LocalTempFilename(&cache_dir));
+  const std::string device_dir = GetKernelCacheDeviceDir(
+      cache_dir, TestGpuDeviceInfo::RTXA6000DeviceInfo());
+  EXPECT_NE(device_dir, GetKernelCacheDeviceDir(
+                            cache_dir, TestGpuDeviceInfo::AMDMI210DeviceInfo()));
+
+  auto store = [&](std::string fingerprint, std::string kernel_name) {
+    KernelReuseCache cache;
+    auto [result, was_cached] = cache.GetWithStatus(fingerprint, [&]() {
+      return KernelReuseCache::Entry{.kernel_name = kernel_name};
+    });
+    TF_EXPECT_OK(UpdateKernelCacheDir(device_dir, cache.Export(),
+                                      {{.name = kernel_name, .binary = {1}}}));
+  };
+
+  // Kernels compiled by different processes can have the same name.
+  store("fingerprint1", "k1");
+  store("fingerprint2", "k1");
+  store("fingerprint3", "k2");
+
+  TF_ASSERT_OK_AND_ASSIGN(CompilationCacheProto proto,
+                          LoadKernelCacheDir(device_dir));
+  EXPECT_EQ(proto.entries_size(), 2);
+
+  KernelReuseCache cache;
+  TF_EXPECT_OK(cache.Load(proto));
+  EXPECT_FALSE(cache.IsEmpty());
+}
+
+TEST_F(KernelReuseTest, LoadingMissingKernelCacheDirReturnsEmptyCache) {
+  std::string cache_dir;
+  CHECK(tsl::Env::Default()->LocalTempFilename(&cache_dir));
+  TF_ASSERT_OK_AND_ASSIGN(CompilationCacheProto proto,
+                          LoadKernelCacheDir(cache_dir));
+  EXPECT_EQ(proto.entries_size(), 0);
+}
+
 }  // namespace
 }  // namespace gpu
 }  // namespace xla
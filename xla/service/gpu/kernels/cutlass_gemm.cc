@@ -136,6 +136,8 @@ int32_t Adaptor<DlOpenedKernel>::SharedMemoryBytes() const {
 }
 
 bool Adaptor<DlOpenedKernel>::CanImplement(const Arguments& args) const {
+  // Kernels loaded from shared libraries do not get a source operand.
+  if (args.source != nullptr) return false;
   return reinterpret_cast<CanImplementFn>(can_implement_fn_)(args.m, args.n,
                                                              args.k);
 }
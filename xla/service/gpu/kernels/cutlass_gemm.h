@@ -88,6 +88,10 @@ struct ArgsIndices {
   // Workspace parameter is a special case, as it's always passed as a last
   // parameter at run time (only if requested).
   bool has_workspace;
+
+  // Optional source operand added to the gemm result in the epilogue, i.e.
+  // `out = lhs * rhs + source` for a gemm with a residual add.
+  std::optional<int64_t> source;
 };
 
 // Custom CUTLASS gemm kernels support on-device address arithmetics for input
@@ -159,6 +163,9 @@ struct Arguments {
   void* out;
   void* workspace;
 
+  // Optional source buffer added to the gemm result (nullptr if not added).
+  void* source;
+
   DynamicSliceArguments slices;
 };
 
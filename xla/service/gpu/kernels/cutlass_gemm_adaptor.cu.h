@@ -136,6 +136,10 @@ static Dim3 ThreadDim() {
 
 template <typename Tag>
 static bool CanImplement(const Arguments &args) {
+  // Dynamic slice offsets are applied to both C and D pointers in the kernel
+  // entry point, so they can't be combined with a separate source operand.
+  if (args.source != nullptr && args.slices.out != nullptr) return false;
+
   cutlass::gemm::GemmCoord problem_size(args.m, args.n, args.k);
   return Traits<Tag>::Kernel::can_implement(problem_size) ==
          cutlass::Status::kSuccess;
@@ -173,17 +177,20 @@ static typename Traits<Tag>::Arguments OpArguments(const Arguments &args) {
   // epilogue, however `Gemm` template can be compiled with arbitrary
   // epilogues. We have to support custom epilogues in a way that does not
   // leak cutlass types via the public API function signature.
+  //
+  // With a source operand the epilogue computes `D = A * B + C`.
   using Accumulator = typename Traits<Tag>::Operation::ElementAccumulator;
   Accumulator alpha{1.0};
-  Accumulator beta{0.0};
-
-  return typename Traits<Tag>::Arguments(      // CUTLASS Operation arguments
-      mode, problem_size,                      //
-      args.batch_count,                        // batch or k-split slices
-      {alpha, beta},                           // epilogue
-      args.lhs, args.rhs, args.out, args.out,  // pointers
-      0, 0, 0, 0,                              // batch strides
-      lda, ldb, ldc, ldc                       // strides
+  Accumulator beta{args.source != nullptr ? 1.0 : 0.0};
+  void *source = args.source != nullptr ? args.source : args.out;
+
+  return typename Traits<Tag>::Arguments(    // CUTLASS Operation arguments
+      mode, problem_size,                    //
+      args.batch_count,                      // batch or k-split slices
+      {alpha, beta},                         // epilogue
+      args.lhs, args.rhs, source, args.out,  // pointers
+      0, 0, 0, 0,                            // batch strides
+      lda, ldb, ldc, ldc                     // strides
   );
 }
 
@@ -266,9 +273,12 @@ static typename Traits<Tag>::Arguments OpArguments(const Arguments &args) {
   // epilogue, however `Gemm` template can be compiled with arbitrary
   // epilogues. We have to support custom epilogues in a way that does not
   // leak cutlass types via the public API function signature.
+  //
+  // With a source operand the epilogue computes `D = A * B + C`.
   using Accumulator = typename Traits<Tag>::Operation::ElementAccumulator;
   Accumulator alpha{1.0};
-  Accumulator beta{0.0};
+  Accumulator beta{args.source != nullptr ? 1.0 : 0.0};
+  void *source = args.source != nullptr ? args.source : args.out;
 
   typename Kernel::MainloopArguments mainloop_args{
       reinterpret_cast<typename Operation::ElementA *>(args.lhs), stride_a,
@@ -276,7 +286,7 @@ static typename Traits<Tag>::Arguments OpArguments(const Arguments &args) {
 
   typename Kernel::EpilogueArguments epilogue_args{
       {alpha, beta},
-      reinterpret_cast<typename Operation::ElementC *>(args.out),
+      reinterpret_cast<typename Operation::ElementC *>(source),
       stride_c,
       reinterpret_cast<typename Operation::ElementC *>(args.out),
       stride_d,
@@ -290,6 +300,8 @@ static typename Traits<Tag>::Arguments OpArguments(const Arguments &args) {
 
 template <typename Tag>
 static bool CanImplement(const Arguments &args) {
+  // Dynamic slice offsets are applied to both C and D pointers.
+  if (args.source != nullptr && args.slices.out != nullptr) return false;
   return Traits<Tag>::Kernel::can_implement(OpArguments<Tag>(args));
 }
 
@@ -127,6 +127,12 @@ KernelArgsPacking ArgsPacking(GemmMode mode, int32_t batch_count, int32_t m,
       arguments.workspace = nullptr;
     }
 
+    // Set up a source operand of a gemm with a residual add.
+    if (indices.source.has_value()) {
+      arguments.source =
+          const_cast<void*>(mem_args->device_memory_ptr(*indices.source));
+    }
+
     // Set up dynamic slices if they are available.
     if (slices.out.has_value()) {
       arguments.slices.out = SlicePtr(mem_args, *slices.out);
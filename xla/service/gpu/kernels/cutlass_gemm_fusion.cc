@@ -35,6 +35,7 @@ limitations under the License.
 #include "xla/hlo/ir/hlo_computation.h"
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_instructions.h"
+#include "xla/hlo/ir/hlo_opcode.h"
 #include "xla/service/gpu/backend_configs.pb.h"
 #include "xla/service/gpu/kernels/custom_kernel.h"
 #include "xla/service/gpu/kernels/custom_kernel_fusion.h"
@@ -43,6 +44,7 @@ limitations under the License.
 #include "xla/service/gpu/kernels/cutlass_gemm_custom_kernel.h"
 #include "xla/service/pattern_matcher.h"
 #include "xla/shape.h"
+#include "xla/shape_util.h"
 #include "xla/stream_executor/device_description.h"
 #include "xla/tsl/platform/errors.h"
 #include "xla/tsl/platform/statusor.h"
@@ -102,6 +104,15 @@ struct GemmWithDynamicSlice {
   HloInstruction* update_slice = nullptr;  // update result slice
 };
 
+// Pattern for matching GEMM with a residual add fused into the epilogue.
+struct GemmWithResidualAdd {
+  explicit GemmWithResidualAdd(HloInstruction* add) : add(add) {}
+
+  HloInstruction* dot = nullptr;
+  HloInstruction* residual = nullptr;  // added to the dot result
+  HloInstruction* add = nullptr;
+};
+
 // Returns OK if dot instruction is a simple 2D row-major gemm.
 absl::Status MatchRowMajorGemm(HloDotInstruction* dot) {
   if (dot->operand(0)->shape().dimensions().size() != 2 ||
@@ -211,6 +222,37 @@ static absl::StatusOr<GemmWithDynamicSlice> MatchGemmWithDynamicUpdateSlice(
   return match;
 }
 
+// Returns matched GEMM with a residual tensor added to the result.
+static absl::StatusOr<GemmWithResidualAdd> MatchGemmWithResidualAdd(
+    HloInstruction* add) {
+  GemmWithResidualAdd match(add);
+
+  if (!Match(add, match::AddAnyOrder(match::Dot(&match.dot, match::Op(),
+                                                match::Op()),
+                                     match::Op(&match.residual)))) {
+    return absl::InternalError("failed to match add of a dot result");
+  }
+
+  if (match.residual == match.dot) {
+    return absl::InternalError("residual must be different from the dot");
+  }
+
+  if (match.dot->user_count() != 1) {
+    return absl::InternalError("dot result must be used only by the add");
+  }
+
+  // The residual is read with the same layout as the gemm result.
+  if (!ShapeUtil::Equal(match.residual->shape(), match.dot->shape())) {
+    return absl::InternalError("residual must have the dot result shape");
+  }
+
+  TF_RETURN_IF_ERROR(
+      MatchSimpleGemm(Cast<HloDotInstruction>(match.dot),
+                      {PrimitiveType::F32, PrimitiveType::BF16}));
+
+  return match;
+}
+
 static bool AreInstructionsOnTheSameStream(
     absl::Span<const HloInstruction* const> instructions) {
   absl::flat_hash_set<int64_t> stream_set;
@@ -285,6 +327,28 @@ CutlassGemmWithDynamicUpdateSlicePattern::TryMatch(
   return match;
 }
 
+std::optional<CustomKernelFusionPattern::Match>
+CutlassGemmWithResidualAddPattern::TryMatch(const se::DeviceDescription& device,
+                                            HloInstruction* instr) const {
+  if (instr->opcode() != HloOpcode::kAdd) return std::nullopt;
+
+  absl::StatusOr<GemmWithResidualAdd> matched =
+      MatchGemmWithResidualAdd(instr);
+  if (!matched.ok()) {
+    VLOG(3) << "No match due to unsupported gemm with residual add: "
+            << matched.status();
+    return std::nullopt;
+  }
+
+  if (!AreInstructionsOnTheSameStream({matched->dot, matched->add})) {
+    return std::nullopt;
+  }
+
+  CustomFusionConfig config;
+  config.set_name("cutlass_gemm_with_residual_add");
+  return Match{config, {matched->dot, matched->add}};
+}
+
 namespace {
 bool IsSupportedKernel(PrimitiveType lhs, PrimitiveType rhs,
                        PrimitiveType dot) {
@@ -484,14 +548,60 @@ class CutlassGemmWithDynamicUpdateSliceFusion : public CustomKernelFusion {
   }
 };
 
+class CutlassGemmWithResidualAddFusion : public CustomKernelFusion {
+ public:
+  absl::StatusOr<std::vector<CustomKernel>> LoadKernels(
+      const se::DeviceDescription& device,
+      const HloComputation* computation) const final {
+    HloInstruction* root = computation->root_instruction();
+    if (root->opcode() != HloOpcode::kAdd) {
+      return absl::InternalError(
+          "cutlass_gemm_with_residual_add requires ROOT operation to be an "
+          "add");
+    }
+
+    TF_ASSIGN_OR_RETURN(GemmWithResidualAdd matched,
+                        MatchGemmWithResidualAdd(root));
+
+    auto* lhs = Cast<HloParameterInstruction>(matched.dot->operand(0));
+    auto* rhs = Cast<HloParameterInstruction>(matched.dot->operand(1));
+    auto* residual = Cast<HloParameterInstruction>(matched.residual);
+
+    // Mapping from fusion arguments to gemm kernel arguments.
+    kernel::gemm_universal::ArgsIndices args_indices = {
+        lhs->parameter_number(), rhs->parameter_number(),
+        computation->num_parameters()};
+    args_indices.source = residual->parameter_number();
+
+    const Shape& lhs_shape = lhs->shape();
+    const Shape& rhs_shape = rhs->shape();
+
+    size_t m = lhs_shape.dimensions(0);
+    size_t k = lhs_shape.dimensions(1);
+    size_t n = rhs_shape.dimensions(1);
+
+    PrimitiveType dot_type = matched.dot->shape().element_type();
+    PrimitiveType lhs_type = lhs_shape.element_type();
+    PrimitiveType rhs_type = rhs_shape.element_type();
+
+    return GetCutlassGemmKernels("cutlass_gemm_with_residual_add", dot_type,
+                                 lhs_type, rhs_type, m, n, k, args_indices,
+                                 /*slices=*/{}, device);
+  }
+};
+
 }  // namespace xla::gpu
 
 XLA_REGISTER_CUSTOM_FUSION_PATTERN(::xla::gpu::CutlassGemmWithUpcastPattern);
 XLA_REGISTER_CUSTOM_FUSION_PATTERN(
     ::xla::gpu::CutlassGemmWithDynamicUpdateSlicePattern);
+XLA_REGISTER_CUSTOM_FUSION_PATTERN(
+    ::xla::gpu::CutlassGemmWithResidualAddPattern);
 
 XLA_REGISTER_CUSTOM_FUSION("cutlass_gemm", ::xla::gpu::CutlassGemmFusion);
 XLA_REGISTER_CUSTOM_FUSION("cutlass_gemm_with_upcast",
                            ::xla::gpu::CutlassGemmWithUpcastFusion);
 XLA_REGISTER_CUSTOM_FUSION("cutlass_gemm_with_dynamic_update_slice",
                            ::xla::gpu::CutlassGemmWithDynamicUpdateSliceFusion);
+XLA_REGISTER_CUSTOM_FUSION("cutlass_gemm_with_residual_add",
+                           ::xla::gpu::CutlassGemmWithResidualAddFusion);
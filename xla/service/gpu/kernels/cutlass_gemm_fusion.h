@@ -39,6 +39,14 @@ class CutlassGemmWithDynamicUpdateSlicePattern
                                 HloInstruction* instr) const override;
 };
 
+// Pattern matches simple row-major gemms with a residual add of a tensor of the
+// same shape as the gemm result, which is fused into the gemm epilogue.
+class CutlassGemmWithResidualAddPattern : public CustomKernelFusionPattern {
+ public:
+  std::optional<Match> TryMatch(const se::DeviceDescription& device,
+                                HloInstruction* instr) const override;
+};
+
 // Pattern matches mixed dtype gemms when one of the operands is upcasted to an
 // accumulator (output) dtype, i.e. BF16 <= BF16 x S8.
 class CutlassGemmWithUpcastPattern : public CustomKernelFusionPattern {
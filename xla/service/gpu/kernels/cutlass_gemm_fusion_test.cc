@@ -403,6 +403,74 @@ TEST_F(CutlassFusionTest, RowMajorGemmWithDynamicUpdateSliceWithoutBitcast) {
   RunAndFilecheckHloRewrite(hlo, std::move(pass), expected);
 }
 
+TEST_F(CutlassFusionTest, RowMajorGemmWithResidualAdd) {
+  const char* hlo = R"(
+    HloModule test
+
+    ENTRY %main (p0: f32[15,19], p1: f32[19,17], p2: f32[15,17])
+        -> f32[15,17] {
+      %p0 = f32[15,19]{1,0} parameter(0)
+      %p1 = f32[19,17]{1,0} parameter(1)
+      %p2 = f32[15,17]{1,0} parameter(2)
+      %dot = f32[15,17]{1,0} dot(%p0, %p1),
+        lhs_contracting_dims={1}, rhs_contracting_dims={0}
+      ROOT %r = f32[15,17]{1,0} add(%p2, %dot)
+    }
+  )";
+
+  const char* expected = R"(
+    ; CHECK: %cutlass_gemm_with_residual_add {{.*}} {
+    ; CHECK-DAG: [[P0:%[^ ]+]] = f32[15,19]{1,0} parameter
+    ; CHECK-DAG: [[P1:%[^ ]+]] = f32[19,17]{1,0} parameter
+    ; CHECK-DAG: [[P2:%[^ ]+]] = f32[15,17]{1,0} parameter
+    ; CHECK-DAG: [[DOT:%[^ ]+]] = f32[15,17]{1,0} dot([[P0]], [[P1]])
+    ; CHECK:     ROOT [[ADD:%[^ ]+]] = f32[15,17]{1,0} add([[P2]], [[DOT]])
+    ; CHECK: }
+
+    ; CHECK: ENTRY %main {{.*}} {
+    ; CHECK:   ROOT [[FUSION:%[^ ]+]] = f32[15,17]{1,0} fusion
+    ; CHECK:     kind=kCustom, calls=%cutlass_gemm_with_residual_add,
+    ; CHECK:     backend_config={
+    ; CHECK:       "kind":"__custom_fusion",
+    ; CHECK:       "custom_fusion_config":{
+    ; CHECK:         "name":"cutlass_gemm_with_residual_add","kernel_index":0
+    ; CHECK:       }
+    ; CHECK:     }
+    ; CHECK: }
+  )";
+
+  CustomKernelFusionPatternRegistry patterns;
+  patterns.Emplace<CutlassGemmWithResidualAddPattern>();
+
+  auto device = TestGpuDeviceInfo::RTXA6000DeviceInfo();
+  CustomKernelFusionRewriter pass(&device, /*kernel_index=*/0, &patterns);
+  RunAndFilecheckHloRewrite(hlo, std::move(pass), expected);
+}
+
+TEST_F(CutlassFusionTest, DoNotFuseResidualAddIntoGemmWithMultipleUses) {
+  const char* hlo = R"(
+    HloModule test
+
+    ENTRY %main (p0: f32[15,19], p1: f32[19,17], p2: f32[15,17])
+        -> (f32[15,17], f32[15,17]) {
+      %p0 = f32[15,19]{1,0} parameter(0)
+      %p1 = f32[19,17]{1,0} parameter(1)
+      %p2 = f32[15,17]{1,0} parameter(2)
+      %dot = f32[15,17]{1,0} dot(%p0, %p1),
+        lhs_contracting_dims={1}, rhs_contracting_dims={0}
+      %add = f32[15,17]{1,0} add(%dot, %p2)
+      ROOT %r = (f32[15,17]{1,0}, f32[15,17]{1,0}) tuple(%add, %dot)
+    }
+  )";
+
+  CustomKernelFusionPatternRegistry patterns;
+  patterns.Emplace<CutlassGemmWithResidualAddPattern>();
+
+  auto device = TestGpuDeviceInfo::RTXA6000DeviceInfo();
+  CustomKernelFusionRewriter pass(&device, /*kernel_index=*/0, &patterns);
+  RunAndFilecheckHloRewrite(hlo, std::move(pass), std::nullopt);
+}
+
 //===----------------------------------------------------------------------===//
 // Run And Compare Tests
 //===----------------------------------------------------------------------===//
@@ -755,6 +823,47 @@ TEST_F(CutlassFusionTest,
                                       /*run_hlo_passes=*/false));
 }
 
+TEST_F(CutlassFusionTest, RowMajorGemmWithResidualAddKernel) {
+  ErrorSpec error_spec{/*aabs=*/1e-3, /*arel=*/1e-3};
+
+  const char* hlo_text_cublas = R"(
+  HloModule cublas
+
+  ENTRY e {
+    arg0 = f32[100,784]{1,0} parameter(0)
+    arg1 = f32[784,10]{1,0} parameter(1)
+    arg2 = f32[100,10]{1,0} parameter(2)
+    gemm = (f32[100,10]{1,0}, s8[0]{0}) custom-call(arg0, arg1),
+      custom_call_target="__cublas$gemm",
+      backend_config={"gemm_backend_config":{"alpha_real":1,"beta":0,"dot_dimension_numbers":{"lhs_contracting_dimensions":[1],"rhs_contracting_dimensions":[0],"lhs_batch_dimensions":[],"rhs_batch_dimensions":[]},"alpha_imag":0,"precision_config":{"operand_precision":["DEFAULT","DEFAULT"]},"epilogue":"DEFAULT"}}
+    get-tuple-element = f32[100,10]{1,0} get-tuple-element((f32[100,10]{1,0}, s8[0]{0}) gemm), index=0
+    ROOT add = f32[100,10]{1,0} add(get-tuple-element, arg2)
+  })";
+
+  const char* hlo_text_custom_fusion = R"(
+  HloModule cutlass
+
+  cutlass_gemm {
+    arg0 = f32[100,784]{1,0} parameter(0)
+    arg1 = f32[784,10]{1,0} parameter(1)
+    arg2 = f32[100,10]{1,0} parameter(2)
+    dot = f32[100,10]{1,0} dot(arg0, arg1),
+      lhs_contracting_dims={1}, rhs_contracting_dims={0}
+    ROOT add = f32[100,10]{1,0} add(dot, arg2)
+  }
+
+  ENTRY e {
+    arg0 = f32[100,784]{1,0} parameter(0)
+    arg1 = f32[784,10]{1,0} parameter(1)
+    arg2 = f32[100,10]{1,0} parameter(2)
+    ROOT _ = f32[100,10]{1,0} fusion(arg0, arg1, arg2), kind=kCustom, calls=cutlass_gemm,
+      backend_config={"fusion_backend_config":{kind: "__custom_fusion", custom_fusion_config: {"name":"cutlass_gemm_with_residual_add", "kernel_index":0}}}
+  })";
+
+  EXPECT_TRUE(RunAndCompareTwoModules(hlo_text_cublas, hlo_text_custom_fusion,
+                                      error_spec, /*run_hlo_passes=*/false));
+}
+
 TEST_F(CutlassFusionTest, GemmWithUpcastShouldBeFused) {
   const char* hlo = R"(
   ENTRY e {
@@ -26,6 +26,7 @@ limitations under the License.
 #include "xla/tsl/lib/monitoring/counter.h"
 #include "xla/tsl/lib/monitoring/gauge.h"
 #include "xla/tsl/lib/monitoring/sampler.h"
+#include "xla/tsl/protobuf/histogram.pb.h"
 #include "tsl/platform/stacktrace.h"
 
 namespace xla {
@@ -40,6 +41,15 @@ auto* compile_time_usecs_histogram = tsl::monitoring::Sampler<1>::New(
     // Maximum: 1 ms * 2 ^ 24 == ~4.66 hours
     {tsl::monitoring::Buckets::Exponential(1000, 2, 25)});
 
+auto* thunk_device_time_usecs_histogram = tsl::monitoring::Sampler<1>::New(
+    {"/xla/service/gpu/thunk_device_time_usecs",
+     "Sampled device time of GPU executable thunks in microseconds.",
+     "thunk"},
+    // These exponential buckets cover the following range:
+    // Minimum: 1 us
+    // Maximum: 1 us * 2 ^ 31 == ~36 minutes
+    {tsl::monitoring::Buckets::Exponential(1, 2, 32)});
+
 auto* compiled_programs_count = tsl::monitoring::Counter<0>::New(
     "/xla/service/gpu/compiled_programs_count", "Number of compiled programs.");
 
@@ -100,6 +110,18 @@ void RecordXlaDeviceBinarySize(const int64_t size) {
   xla_device_binary_size->GetCell()->Set(size);
 }
 
+void RecordThunkDeviceTime(absl::string_view thunk_name,
+                           const uint64_t time_usecs) {
+  thunk_device_time_usecs_histogram->GetCell(std::string(thunk_name))
+      ->Add(time_usecs);
+}
+
+tensorflow::HistogramProto GetThunkDeviceTimeHistogram(
+    absl::string_view thunk_name) {
+  return thunk_device_time_usecs_histogram->GetCell(std::string(thunk_name))
+      ->value();
+}
+
 void RecordGpuCompilerStacktrace() {
   std::string tsl_stacktrace = tsl::CurrentStackTrace();
 
@@ -19,6 +19,7 @@ limitations under the License.
 #include <cstdint>
 
 #include "absl/strings/string_view.h"
+#include "xla/tsl/protobuf/histogram.pb.h"
 
 namespace xla {
 
@@ -50,6 +51,13 @@ int64_t GetCompiledProgramsCount();
 // Records the size of the XLA device binary in bytes.
 void RecordXlaDeviceBinarySize(int64_t size);
 
+// Records the device time of a thunk execution sampled by GpuExecutable.
+void RecordThunkDeviceTime(absl::string_view thunk_name, uint64_t time_usecs);
+
+// Returns the histogram of sampled device times of the given thunk.
+tensorflow::HistogramProto GetThunkDeviceTimeHistogram(
+    absl::string_view thunk_name);
+
 // Records the stacktrace of the GPU compiler.
 void RecordGpuCompilerStacktrace();
 
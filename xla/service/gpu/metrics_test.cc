@@ -22,6 +22,7 @@ limitations under the License.
 #include <gtest/gtest.h>
 #include "xla/tsl/lib/monitoring/collected_metrics.h"
 #include "xla/tsl/lib/monitoring/collection_registry.h"
+#include "xla/tsl/protobuf/histogram.pb.h"
 #include "tsl/platform/test.h"
 
 namespace xla {
@@ -45,6 +46,18 @@ TEST(MetricsTest, RecordsGpuCompilerStacktrace) {
       1);
 }
 
+TEST(MetricsTest, RecordsThunkDeviceTime) {
+  RecordThunkDeviceTime("fusion.1", 10);
+  RecordThunkDeviceTime("fusion.1", 30);
+  RecordThunkDeviceTime("fusion.2", 5);
+
+  tensorflow::HistogramProto histogram =
+      GetThunkDeviceTimeHistogram("fusion.1");
+  EXPECT_EQ(histogram.num(), 2);
+  EXPECT_EQ(histogram.sum(), 40);
+  EXPECT_EQ(GetThunkDeviceTimeHistogram("fusion.2").num(), 1);
+}
+
 }  // namespace
 }  // namespace gpu
 }  // namespace xla
@@ -0,0 +1,131 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/service/gpu/model/fusion_runtime_memo.h"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include "absl/algorithm/container.h"
+#include "absl/strings/str_cat.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/hlo/ir/hlo_print_options.h"
+#include "xla/service/gpu/model/gpu_performance_model_base.h"
+#include "xla/stream_executor/device_description.h"
+#include "tsl/platform/fingerprint.h"
+
+namespace xla::gpu {
+
+FusionRuntimeMemo& FusionRuntimeMemo::Global() {
+  static auto* memo = new FusionRuntimeMemo();
+  return *memo;
+}
+
+uint64_t FusionRuntimeMemo::DeviceKey(
+    const se::DeviceDescription& device_info) {
+  return tsl::Fingerprint64(device_info.ToString());
+}
+
+uint64_t FusionRuntimeMemo::InstructionKey(const HloInstruction& instruction) {
+  std::string key = instruction.ToString(
+      HloPrintOptions::Fingerprint().set_print_backend_config(true));
+
+  // Operand names are not printed, so record which operands are the same
+  // instruction as an earlier operand: such operands are read only once.
+  for (const HloInstruction* operand : instruction.operands()) {
+    absl::StrAppend(&key, ",", instruction.operand_index(operand));
+  }
+  return tsl::Fingerprint64(key);
+}
+
+uint64_t FusionRuntimeMemo::FusionKey(const HloInstruction& producer,
+                                      uint64_t producer_key,
+                                      const HloInstruction& consumer,
+                                      uint64_t consumer_key,
+                                      bool producer_writes_side_output) {
+  std::string key = absl::StrCat(producer_key, ":", consumer_key, ":",
+                                 producer_writes_side_output, ":");
+
+  // Describe each consumer operand as either the producer, an element of the
+  // producer's tuple or one of the producer's operands, since these decide
+  // which operands the fused instruction reads and how often.
+  for (const HloInstruction* operand : consumer.operands()) {
+    if (operand == &producer) {
+      absl::StrAppend(&key, "p,");
+      continue;
+    }
+    if (operand->opcode() == HloOpcode::kGetTupleElement &&
+        operand->operand(0) == &producer) {
+      absl::StrAppend(&key, "t", operand->tuple_index(), ",");
+      continue;
+    }
+    auto it = absl::c_find(producer.operands(), operand);
+    absl::StrAppend(&key, it - producer.operands().begin(), ",");
+  }
+  return tsl::Fingerprint64(key);
+}
+
+std::optional<EstimateRunTimeData> FusionRuntimeMemo::GetInstructionRunTime(
+    uint64_t device_key, uint64_t instruction_key) {
+  absl::MutexLock lock(&mutex_);
+  auto it = instruction_runtime_data_.find({device_key, instruction_key});
+  if (it != instruction_runtime_data_.end()) {
+    return it->second;
+  }
+  return std::nullopt;
+}
+
+void FusionRuntimeMemo::SetInstructionRunTime(
+    uint64_t device_key, uint64_t instruction_key,
+    const EstimateRunTimeData& runtime_data) {
+  absl::MutexLock lock(&mutex_);
+  if (static_cast<int64_t>(instruction_runtime_data_.size()) >=
+      max_entries_) {
+    instruction_runtime_data_.clear();
+  }
+  instruction_runtime_data_[{device_key, instruction_key}] = runtime_data;
+}
+
+std::optional<absl::Duration> FusionRuntimeMemo::GetFusionRunTime(
+    uint64_t device_key, uint64_t fusion_key) {
+  absl::MutexLock lock(&mutex_);
+  auto it = fusion_runtime_data_.find({device_key, fusion_key});
+  if (it != fusion_runtime_data_.end()) {
+    return it->second;
+  }
+  return std::nullopt;
+}
+
+void FusionRuntimeMemo::SetFusionRunTime(uint64_t device_key,
+                                         uint64_t fusion_key,
+                                         absl::Duration runtime) {
+  absl::MutexLock lock(&mutex_);
+  if (static_cast<int64_t>(fusion_runtime_data_.size()) >= max_entries_) {
+    fusion_runtime_data_.clear();
+  }
+  fusion_runtime_data_[{device_key, fusion_key}] = runtime;
+}
+
+void FusionRuntimeMemo::Clear() {
+  absl::MutexLock lock(&mutex_);
+  instruction_runtime_data_.clear();
+  fusion_runtime_data_.clear();
+}
+
+}  // namespace xla::gpu
@@ -0,0 +1,94 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_SERVICE_GPU_MODEL_FUSION_RUNTIME_MEMO_H_
+#define XLA_SERVICE_GPU_MODEL_FUSION_RUNTIME_MEMO_H_
+
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/service/gpu/model/gpu_performance_model_base.h"
+#include "xla/stream_executor/device_description.h"
+
+namespace xla::gpu {
+
+// Memoizes performance model estimates by the structure of the estimated
+// instructions instead of their identity. Unlike `GpuPerformanceModelCache`,
+// entries stay valid after the instructions are deleted, so estimates are
+// shared between identical layers of a module and between compilations in the
+// same process. All methods can be called concurrently.
+class FusionRuntimeMemo {
+ public:
+  // Default number of entries of each kind kept by the memo. The memo is
+  // cleared when it grows beyond this size.
+  static constexpr int64_t kDefaultMaxEntries = 1 << 18;
+
+  explicit FusionRuntimeMemo(int64_t max_entries = kDefaultMaxEntries)
+      : max_entries_(max_entries) {}
+
+  // Returns the process-wide memo.
+  static FusionRuntimeMemo& Global();
+
+  // Returns a key of the device the estimates are computed for.
+  static uint64_t DeviceKey(const se::DeviceDescription& device_info);
+
+  // Returns a key of the instruction that only depends on its structure: the
+  // instruction with its fused computation, backend config, operand shapes and
+  // which of the operands are the same instruction.
+  static uint64_t InstructionKey(const HloInstruction& instruction);
+
+  // Returns a key of the fusion of `producer` into `consumer`, given their
+  // instruction keys. Besides the keys, the fusion depends on how the
+  // consumer's operands relate to the producer and to the producer's operands.
+  static uint64_t FusionKey(const HloInstruction& producer,
+                            uint64_t producer_key,
+                            const HloInstruction& consumer,
+                            uint64_t consumer_key,
+                            bool producer_writes_side_output);
+
+  std::optional<EstimateRunTimeData> GetInstructionRunTime(
+      uint64_t device_key, uint64_t instruction_key);
+  void SetInstructionRunTime(uint64_t device_key, uint64_t instruction_key,
+                             const EstimateRunTimeData& runtime_data);
+
+  std::optional<absl::Duration> GetFusionRunTime(uint64_t device_key,
+                                                 uint64_t fusion_key);
+  void SetFusionRunTime(uint64_t device_key, uint64_t fusion_key,
+                        absl::Duration runtime);
+
+  // Deletes all entries.
+  void Clear();
+
+ private:
+  using Key = std::pair<uint64_t, uint64_t>;
+
+  const int64_t max_entries_;
+
+  absl::Mutex mutex_;
+  absl::flat_hash_map<Key, EstimateRunTimeData> instruction_runtime_data_
+      ABSL_GUARDED_BY(mutex_);
+  absl::flat_hash_map<Key, absl::Duration> fusion_runtime_data_
+      ABSL_GUARDED_BY(mutex_);
+};
+
+}  // namespace xla::gpu
+
+#endif  // XLA_SERVICE_GPU_MODEL_FUSION_RUNTIME_MEMO_H_
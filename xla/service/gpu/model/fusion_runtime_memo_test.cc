@@ -0,0 +1,126 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/service/gpu/model/fusion_runtime_memo.h"
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+#include <gtest/gtest.h>
+#include "absl/strings/string_view.h"
+#include "absl/time/time.h"
+#include "xla/hlo/ir/hlo_computation.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/testlib/hlo_hardware_independent_test_base.h"
+#include "xla/service/gpu/gpu_device_info_for_tests.h"
+#include "xla/service/gpu/model/gpu_performance_model_base.h"
+#include "xla/tsl/platform/statusor.h"
+
+namespace xla::gpu {
+namespace {
+
+using FusionRuntimeMemoTest = HloHardwareIndependentTestBase;
+
+constexpr absl::string_view kHloString = R"(
+  HloModule m
+
+  ENTRY e {
+    p0 = f32[1024] parameter(0)
+    p1 = f32[1024] parameter(1)
+    n0 = f32[1024] negate(p0)
+    a0 = f32[1024] add(n0, p1)
+    n1 = f32[1024] negate(a0)
+    a1 = f32[1024] add(n1, p1)
+    n2 = f32[1024] negate(a1)
+    ROOT a2 = f32[1024] add(n2, n2)
+  })";
+
+uint64_t FusionKeyOf(const HloComputation& computation,
+                     absl::string_view producer_name,
+                     absl::string_view consumer_name) {
+  const HloInstruction* producer =
+      computation.GetInstructionWithName(producer_name);
+  const HloInstruction* consumer =
+      computation.GetInstructionWithName(consumer_name);
+  return FusionRuntimeMemo::FusionKey(
+      *producer, FusionRuntimeMemo::InstructionKey(*producer), *consumer,
+      FusionRuntimeMemo::InstructionKey(*consumer),
+      /*producer_writes_side_output=*/false);
+}
+
+TEST_F(FusionRuntimeMemoTest, IdenticalLayersHaveTheSameKeys) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(kHloString));
+  const HloComputation& computation = *module->entry_computation();
+
+  EXPECT_EQ(FusionKeyOf(computation, "n0", "a0"),
+            FusionKeyOf(computation, "n1", "a1"));
+  EXPECT_NE(FusionKeyOf(computation, "n1", "a1"),
+            FusionKeyOf(computation, "n2", "a2"));
+  EXPECT_NE(FusionKeyOf(computation, "n0", "a0"),
+            FusionKeyOf(computation, "a0", "n1"));
+}
+
+TEST_F(FusionRuntimeMemoTest, KeysDistinguishRepeatedOperands) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(kHloString));
+  const HloComputation& computation = *module->entry_computation();
+
+  EXPECT_NE(FusionRuntimeMemo::InstructionKey(
+                *computation.GetInstructionWithName("a1")),
+            FusionRuntimeMemo::InstructionKey(
+                *computation.GetInstructionWithName("a2")));
+}
+
+TEST_F(FusionRuntimeMemoTest, EntriesAreKeyedByDevice) {
+  FusionRuntimeMemo memo;
+  uint64_t a6000 =
+      FusionRuntimeMemo::DeviceKey(TestGpuDeviceInfo::RTXA6000DeviceInfo());
+  uint64_t h100 =
+      FusionRuntimeMemo::DeviceKey(TestGpuDeviceInfo::RTXH100SXMDeviceInfo());
+  ASSERT_NE(a6000, h100);
+
+  memo.SetFusionRunTime(a6000, /*fusion_key=*/42, absl::Microseconds(3));
+  EXPECT_EQ(memo.GetFusionRunTime(a6000, /*fusion_key=*/42),
+            absl::Microseconds(3));
+  EXPECT_EQ(memo.GetFusionRunTime(h100, /*fusion_key=*/42), std::nullopt);
+  EXPECT_EQ(memo.GetInstructionRunTime(a6000, /*instruction_key=*/42),
+            std::nullopt);
+
+  memo.Clear();
+  EXPECT_EQ(memo.GetFusionRunTime(a6000, /*fusion_key=*/42), std::nullopt);
+}
+
+TEST_F(FusionRuntimeMemoTest, ClearsWhenFull) {
+  FusionRuntimeMemo memo(/*max_entries=*/2);
+  memo.SetInstructionRunTime(/*device_key=*/0, /*instruction_key=*/1,
+                             EstimateRunTimeData::Zero());
+  memo.SetInstructionRunTime(/*device_key=*/0, /*instruction_key=*/2,
+                             EstimateRunTimeData::Zero());
+  memo.SetInstructionRunTime(/*device_key=*/0, /*instruction_key=*/3,
+                             EstimateRunTimeData::Zero());
+
+  EXPECT_FALSE(memo.GetInstructionRunTime(/*device_key=*/0,
+                                          /*instruction_key=*/1)
+                   .has_value());
+  EXPECT_TRUE(memo.GetInstructionRunTime(/*device_key=*/0,
+                                         /*instruction_key=*/3)
+                  .has_value());
+}
+
+}  // namespace
+}  // namespace xla::gpu
@@ -26,6 +26,7 @@ limitations under the License.
 #include "absl/log/check.h"
 #include "absl/log/log.h"
 #include "absl/status/status.h"
+#include "absl/status/statusor.h"
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
 #include "absl/time/time.h"
@@ -54,6 +55,7 @@ limitations under the License.
 #include "xla/tsl/platform/status.h"
 #include "xla/tsl/platform/statusor.h"
 #include "xla/util.h"
+#include "tsl/platform/threadpool.h"
 
 namespace xla {
 namespace gpu {
@@ -610,9 +612,9 @@ GpuPerformanceModelWithIndexingAnalysis::TryFindBestTilingForFusion(
 
   TF_ASSIGN_OR_RETURN(auto tilings, analysis.GetGoodTilings());
 
-  std::optional<TiledRunTimeData> best_tiled_run_time_data;
-
-  for (const auto& tiling : tilings) {
+  // Returns std::nullopt if the tiling is not supported.
+  auto evaluate_tiling = [&](const SymbolicTileAnalysis::Tiling& tiling)
+      -> absl::StatusOr<std::optional<TiledRunTimeData>> {
     // TODO(b/372454662): This needs to be adjusted if we want to support more
     // than one "real root" (i.e. a root without users).
     // Currently ComputeTiledHloInstructions() may fail and return an
@@ -625,7 +627,7 @@ GpuPerformanceModelWithIndexingAnalysis::TryFindBestTilingForFusion(
               absl::StatusCode::kUnimplemented &&
           absl::StrContains(maybe_tiled_hlo_computation.status().message(),
                             "multi-output fusion")) {
-        continue;
+        return std::nullopt;
       }
       return maybe_tiled_hlo_computation.status();
     }
@@ -639,22 +641,66 @@ GpuPerformanceModelWithIndexingAnalysis::TryFindBestTilingForFusion(
         EstimateRunTimeForTiledHloComputation(
             fusion_adaptor, tiled_hlo_computation, launch_dimensions));
 
-    if (!best_tiled_run_time_data.has_value() ||
-        estimate_run_time_data.exec_time <
-            best_tiled_run_time_data->runtime_data.exec_time) {
-      BlockLevelParameters block_level_parameters;
-      auto tiled_roots = tiled_hlo_computation.GetRoots();
-      block_level_parameters.output_tile_sizes.reserve(tiled_roots.size());
-      for (auto tiled_root : tiled_roots) {
-        block_level_parameters.output_tile_sizes.emplace_back(
-            tiled_root->tile_sizes().begin(), tiled_root->tile_sizes().end());
-      }
-      block_level_parameters.num_warps =
-          launch_dimensions.num_threads_per_block() / WarpSize(*device_info_);
+    BlockLevelParameters block_level_parameters;
+    auto tiled_roots = tiled_hlo_computation.GetRoots();
+    block_level_parameters.output_tile_sizes.reserve(tiled_roots.size());
+    for (auto tiled_root : tiled_roots) {
+      block_level_parameters.output_tile_sizes.emplace_back(
+          tiled_root->tile_sizes().begin(), tiled_root->tile_sizes().end());
+    }
+    block_level_parameters.num_warps =
+        launch_dimensions.num_threads_per_block() / WarpSize(*device_info_);
+    return TiledRunTimeData{estimate_run_time_data, block_level_parameters};
+  };
+
+  // The output tile is one of the tiles of the computation, so a tiling whose
+  // output tile does not fit in registers has an infinite estimated run time
+  // and can't be better than any other tiling. These tilings are only
+  // evaluated if no other tiling is supported.
+  std::vector<int64_t> candidates;
+  std::vector<int64_t> spilling_candidates;
+  for (int64_t i = 0; i < tilings.size(); ++i) {
+    if (DoesTileFitsInRegisters(GetPaddedTileSize(tilings[i]),
+                                *device_info_)) {
+      candidates.push_back(i);
+    } else {
+      spilling_candidates.push_back(i);
+    }
+  }
+
+  std::vector<absl::StatusOr<std::optional<TiledRunTimeData>>> results(
+      candidates.size(), std::nullopt);
+  if (thread_pool_ != nullptr && candidates.size() > 1) {
+    thread_pool_->ParallelFor(
+        candidates.size(), tsl::thread::ThreadPool::SchedulingParams::Fixed(1),
+        [&](int64_t begin, int64_t end) {
+          for (int64_t i = begin; i < end; ++i) {
+            results[i] = evaluate_tiling(tilings[candidates[i]]);
+          }
+        });
+  } else {
+    for (int64_t i = 0; i < candidates.size(); ++i) {
+      results[i] = evaluate_tiling(tilings[candidates[i]]);
+    }
+  }
 
-      best_tiled_run_time_data =
-          TiledRunTimeData{estimate_run_time_data, block_level_parameters};
+  // Tilings are compared in their original order, so that the earliest of
+  // equally fast tilings is chosen.
+  std::optional<TiledRunTimeData> best_tiled_run_time_data;
+  for (absl::StatusOr<std::optional<TiledRunTimeData>>& result : results) {
+    TF_RETURN_IF_ERROR(result.status());
+    if (result->has_value() &&
+        (!best_tiled_run_time_data.has_value() ||
+         (*result)->runtime_data.exec_time <
+             best_tiled_run_time_data->runtime_data.exec_time)) {
+      best_tiled_run_time_data = std::move(**result);
+    }
+  }
+  for (int64_t i : spilling_candidates) {
+    if (best_tiled_run_time_data.has_value()) {
+      break;
     }
+    TF_ASSIGN_OR_RETURN(best_tiled_run_time_data, evaluate_tiling(tilings[i]));
   }
 
   if (!best_tiled_run_time_data.has_value()) {
@@ -36,6 +36,7 @@ limitations under the License.
 #include "xla/service/instruction_fusion.h"
 #include "xla/shape.h"
 #include "xla/stream_executor/device_description.h"
+#include "tsl/platform/threadpool.h"
 
 namespace xla {
 namespace gpu {
@@ -56,7 +57,8 @@ class GpuPerformanceModelWithIndexingAnalysis : public GpuPerformanceModelBase {
       const se::DeviceDescription* device_info,
       HloFusionAnalysisCache* fusion_analysis_cache,
       HloCostAnalysis::ShapeSizeFunction shape_size,
-      mlir::MLIRContext* mlir_context)
+      mlir::MLIRContext* mlir_context,
+      tsl::thread::ThreadPool* thread_pool = nullptr)
       : hlo_op_profile_(&HloOpProfiles::Singleton().GetProfile(*device_info)),
         device_info_(device_info),
         fusion_analysis_cache_(fusion_analysis_cache),
@@ -67,7 +69,8 @@ class GpuPerformanceModelWithIndexingAnalysis : public GpuPerformanceModelBase {
                                         /*min_latencies_seconds=*/{},
                                         /*count_multiple_input_accesses=*/true},
             *device_info_),
-        mlir_context_(mlir_context) {}
+        mlir_context_(mlir_context),
+        thread_pool_(thread_pool) {}
 
   // Returns the launch dimensions for the given tiled HLO computation.
   static LaunchDimensions GetLaunchDimensionsForTiledFusion(
@@ -111,7 +114,8 @@ class GpuPerformanceModelWithIndexingAnalysis : public GpuPerformanceModelBase {
 
   // Estimates the best tile sizes for the given fusion. Iterates over all the
   // good tile sizes provided by SymbolicTileAnalysis, estimates the run time
-  // for each of them.
+  // for each of them. The estimates are computed in parallel if the model was
+  // given a thread pool.
   //
   // Returns status if there is an error that we can't recover from.
   // Returns FusionDecision if the fusion can't be tiled or there are no valid
@@ -133,6 +137,10 @@ class GpuPerformanceModelWithIndexingAnalysis : public GpuPerformanceModelBase {
   HloCostAnalysis::ShapeSizeFunction shape_size_;
   GpuHloCostAnalysis cost_analysis_;
   mlir::MLIRContext* mlir_context_;
+  // If not null, used to evaluate the tilings of a fusion in parallel. Must
+  // not be a pool whose threads call into this model, as the calling thread
+  // blocks until all tilings are evaluated.
+  tsl::thread::ThreadPool* thread_pool_;
 };
 
 }  // namespace gpu
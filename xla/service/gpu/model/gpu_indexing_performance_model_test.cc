@@ -45,8 +45,10 @@ limitations under the License.
 #include "xla/shape_util.h"
 #include "xla/stream_executor/device_description.h"
 #include "xla/tsl/lib/core/status_test_util.h"
+#include "xla/tsl/platform/env.h"
 #include "tsl/platform/status_matchers.h"
 #include "tsl/platform/statusor.h"
+#include "tsl/platform/threadpool.h"
 
 namespace xla {
 namespace gpu {
@@ -497,6 +499,61 @@ ENTRY main {
       1);
 }
 
+TEST_F(GpuIndexingPerformanceModelTest,
+       EstimateBestTiling_InParallel_FindsSameTiling) {
+  TF_ASSERT_OK_AND_ASSIGN(auto module, ParseAndReturnVerifiedModule(R"(
+HloModule m
+
+add {
+  Arg_0 = f32[] parameter(0)
+  Arg_1 = f32[] parameter(1)
+  ROOT add = f32[] add(Arg_0, Arg_1)
+}
+
+triton_softmax_computation {
+  param_0 = f32[512,911]{1,0} parameter(0)
+  constant_0 = f32[] constant(0)
+  reduce_0 = f32[512]{0} reduce(param_0, constant_0), dimensions={1}, to_apply=add
+  broadcast_4 = f32[512,911]{1,0} broadcast(reduce_0), dimensions={0}
+  ROOT multiply = f32[512,911]{1,0} multiply(param_0, broadcast_4)
+}
+
+ENTRY main {
+  param_0 = f32[512,911]{1,0} parameter(0)
+  ROOT triton_softmax = f32[512,911]{1,0} fusion(param_0), kind=kCustom, calls=triton_softmax_computation, backend_config={"fusion_backend_config": {"kind":"__triton"}}
+}
+)"));
+  auto fusion_adaptor = HloFusionAdaptor::ForInstruction(
+      module->entry_computation()->root_instruction());
+
+  tsl::thread::ThreadPool thread_pool(tsl::Env::Default(), "test", 4);
+  GpuPerformanceModelWithIndexingAnalysis parallel_indexing_cost_model(
+      &device_info_, &fusion_analysis_cache_, HloCostAnalysis::DefaultShapeSize,
+      &mlir_context_, &thread_pool);
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto tiling_result,
+      indexing_cost_model_.TryFindBestTilingForFusion(*fusion_adaptor));
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto parallel_tiling_result,
+      parallel_indexing_cost_model.TryFindBestTilingForFusion(*fusion_adaptor));
+
+  ASSERT_TRUE(std::holds_alternative<TiledRunTimeData>(tiling_result));
+  ASSERT_TRUE(std::holds_alternative<TiledRunTimeData>(parallel_tiling_result));
+  auto tiled_runtime_data = std::get<TiledRunTimeData>(tiling_result);
+  auto parallel_tiled_runtime_data =
+      std::get<TiledRunTimeData>(parallel_tiling_result);
+  const BlockLevelParameters& parameters =
+      tiled_runtime_data.block_level_parameters;
+  const BlockLevelParameters& parallel_parameters =
+      parallel_tiled_runtime_data.block_level_parameters;
+  EXPECT_EQ(parallel_parameters.output_tile_sizes,
+            parameters.output_tile_sizes);
+  EXPECT_EQ(parallel_parameters.num_warps, parameters.num_warps);
+  EXPECT_EQ(parallel_tiled_runtime_data.runtime_data.exec_time,
+            tiled_runtime_data.runtime_data.exec_time);
+}
+
 // This test means to catch integer overflow errors when run with ASan build.
 // The checks below are just sanity checks for values.
 TEST_F(
@@ -33,6 +33,7 @@ limitations under the License.
 #include "xla/service/gpu/launch_dimensions.h"
 #include "xla/service/gpu/model/coalescing_analysis.h"
 #include "xla/service/gpu/model/fusion_analysis_cache.h"
+#include "xla/service/gpu/model/fusion_runtime_memo.h"
 #include "xla/service/gpu/model/gpu_hlo_cost_analysis.h"
 #include "xla/service/gpu/model/gpu_performance_model_base.h"
 #include "xla/stream_executor/device_description.h"
@@ -46,10 +47,27 @@ namespace gpu {
 GpuPerformanceModel::GpuPerformanceModel(
     const se::DeviceDescription& device_info,
     HloFusionAnalysisCache& fusion_analysis_cache,
-    GpuPerformanceModelCache& gpu_performance_model_cache)
+    GpuPerformanceModelCache& gpu_performance_model_cache,
+    FusionRuntimeMemo* fusion_runtime_memo)
     : device_info_(device_info),
       fusion_analysis_cache_(fusion_analysis_cache),
-      gpu_performance_model_cache_(gpu_performance_model_cache) {};
+      gpu_performance_model_cache_(gpu_performance_model_cache),
+      fusion_runtime_memo_(fusion_runtime_memo) {
+  if (fusion_runtime_memo_ != nullptr) {
+    device_key_ = FusionRuntimeMemo::DeviceKey(device_info_);
+  }
+}
+
+uint64_t GpuPerformanceModel::GetStructuralKey(
+    const HloInstruction& instruction) {
+  if (auto cached_key =
+          gpu_performance_model_cache_.GetStructuralKey(instruction)) {
+    return *cached_key;
+  }
+  uint64_t key = FusionRuntimeMemo::InstructionKey(instruction);
+  gpu_performance_model_cache_.SetStructuralKey(instruction, key);
+  return key;
+}
 
 EstimateRunTimeData GpuPerformanceModel::EstimateRunTimeForInstructionImpl(
     const HloInstruction* instr, const GpuHloCostAnalysis* cost_analysis) {
@@ -109,9 +127,23 @@ EstimateRunTimeData GpuPerformanceModel::EstimateRunTimeForInstruction(
     return *cached_result_opt;
   }
 
+  uint64_t instruction_key = 0;
+  if (fusion_runtime_memo_ != nullptr) {
+    instruction_key = GetStructuralKey(*instr);
+    if (auto memo_result = fusion_runtime_memo_->GetInstructionRunTime(
+            device_key_, instruction_key)) {
+      gpu_performance_model_cache_.Set(*instr, *memo_result);
+      return *memo_result;
+    }
+  }
+
   auto runtime_data = EstimateRunTimeForInstructionImpl(instr, cost_analysis);
 
   gpu_performance_model_cache_.Set(*instr, runtime_data);
+  if (fusion_runtime_memo_ != nullptr) {
+    fusion_runtime_memo_->SetInstructionRunTime(device_key_, instruction_key,
+                                                runtime_data);
+  }
 
   return runtime_data;
 }
@@ -212,11 +244,27 @@ absl::Duration GpuPerformanceModel::EstimateRunTimeForFusion(
     return *fusion_runtime_opt;
   }
 
+  uint64_t fusion_key = 0;
+  if (fusion_runtime_memo_ != nullptr) {
+    fusion_key = FusionRuntimeMemo::FusionKey(
+        *producer, GetStructuralKey(*producer), *consumer,
+        GetStructuralKey(*consumer), producer_writes_side_output);
+    if (auto memo_result =
+            fusion_runtime_memo_->GetFusionRunTime(device_key_, fusion_key)) {
+      gpu_performance_model_cache_.Set(*producer, *consumer, *memo_result);
+      return *memo_result;
+    }
+  }
+
   auto fusion_runtime = EstimateRunTimeForFusionImpl(
       producer, consumer, producer_runtime, consumer_runtime, cost_analysis,
       producer_writes_side_output);
 
   gpu_performance_model_cache_.Set(*producer, *consumer, fusion_runtime);
+  if (fusion_runtime_memo_ != nullptr) {
+    fusion_runtime_memo_->SetFusionRunTime(device_key_, fusion_key,
+                                           fusion_runtime);
+  }
   return fusion_runtime;
 }
 
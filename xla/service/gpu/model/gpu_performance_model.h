@@ -16,12 +16,14 @@ limitations under the License.
 #ifndef XLA_SERVICE_GPU_MODEL_GPU_PERFORMANCE_MODEL_H_
 #define XLA_SERVICE_GPU_MODEL_GPU_PERFORMANCE_MODEL_H_
 
+#include <cstdint>
 #include <memory>
 
 #include "absl/time/time.h"
 #include "absl/types/span.h"
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/service/gpu/model/fusion_analysis_cache.h"
+#include "xla/service/gpu/model/fusion_runtime_memo.h"
 #include "xla/service/gpu/model/gpu_hlo_cost_analysis.h"
 #include "xla/service/gpu/model/gpu_performance_model_base.h"
 #include "xla/stream_executor/device_description.h"
@@ -32,9 +34,12 @@ namespace gpu {
 class GpuPerformanceModel : public GpuPerformanceModelBase {
  public:
   // Lifetime to all references to this constructor must live at least as long
+  // If `fusion_runtime_memo` is not null, estimates are also looked up in and
+  // stored to it, so they are shared by structurally identical instructions.
   GpuPerformanceModel(const se::DeviceDescription& device_info,
                       HloFusionAnalysisCache& fusion_analysis_cache,
-                      GpuPerformanceModelCache& gpu_performance_model_cache);
+                      GpuPerformanceModelCache& gpu_performance_model_cache,
+                      FusionRuntimeMemo* fusion_runtime_memo = nullptr);
 
   EstimateRunTimeData EstimateRunTimeForInstruction(
       const HloInstruction* instr, const GpuHloCostAnalysis* cost_analysis);
@@ -70,12 +75,17 @@ class GpuPerformanceModel : public GpuPerformanceModelBase {
       const GpuHloCostAnalysis* cost_analysis,
       bool producer_writes_side_output);
 
+  // Returns the structural key of the instruction for `fusion_runtime_memo_`.
+  uint64_t GetStructuralKey(const HloInstruction& instruction);
+
   const se::DeviceDescription& device_info_;
   HloFusionAnalysisCache& fusion_analysis_cache_;
   // TODO(sohaibiftikhar) Make this an owning member of this class. Currently
   // this is not possible because the cache is used directly by
   // xla::gpu::PriorityFusionQueue
   GpuPerformanceModelCache& gpu_performance_model_cache_;
+  FusionRuntimeMemo* fusion_runtime_memo_;
+  uint64_t device_key_ = 0;
 };
 
 // An owning wrapper around GpuPerformanceModel that also owns the caches.
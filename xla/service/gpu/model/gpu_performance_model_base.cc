@@ -119,9 +119,26 @@ void GpuPerformanceModelCache::Set(const HloInstruction& producer,
   fusion_runtime_data_[&producer][&consumer] = runtime;
 }
 
+std::optional<uint64_t> GpuPerformanceModelCache::GetStructuralKey(
+    const HloInstruction& instruction) {
+  absl::MutexLock lock(&mutex_);
+  auto it = structural_keys_.find(&instruction);
+  if (it != structural_keys_.end()) {
+    return it->second;
+  }
+  return std::nullopt;
+}
+
+void GpuPerformanceModelCache::SetStructuralKey(
+    const HloInstruction& instruction, uint64_t key) {
+  absl::MutexLock lock(&mutex_);
+  structural_keys_[&instruction] = key;
+}
+
 void GpuPerformanceModelCache::Invalidate(const HloInstruction& instruction) {
   // Remove runtime data for the instruction.
   instruction_runtime_data_.erase(&instruction);
+  structural_keys_.erase(&instruction);
 
   // Remove cache for all producer-consumer pairs where the instruction is
   // producer.
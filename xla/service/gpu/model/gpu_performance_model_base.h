@@ -107,6 +107,12 @@ class GpuPerformanceModelCache {
   void Set(const HloInstruction& producer, const HloInstruction& consumer,
            absl::Duration runtime);
 
+  // Returns the cached structural key of the instruction, see
+  // `FusionRuntimeMemo::InstructionKey`. Returns nullopt if there is no key in
+  // cache.
+  std::optional<uint64_t> GetStructuralKey(const HloInstruction& instruction);
+  void SetStructuralKey(const HloInstruction& instruction, uint64_t key);
+
   // Removes all cache entries for this instruction. The cache contains entries
   // for individual instructions in instruction_runtime_data_ and for
   // producer-consumer pairs in fusion_runtime_data_.
@@ -124,6 +130,10 @@ class GpuPerformanceModelCache {
       const HloInstruction*,
       absl::flat_hash_map<const HloInstruction*, absl::Duration>>
       fusion_runtime_data_;
+
+  // Stores structural keys of instructions, which are expensive to compute
+  // for large fusions.
+  absl::flat_hash_map<const HloInstruction*, uint64_t> structural_keys_;
 };
 
 class GpuPerformanceModelBase {
@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "xla/service/gpu/model/gpu_performance_model.h"
 
+#include <cstdint>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -33,6 +34,7 @@ limitations under the License.
 #include "xla/service/gpu/backend_configs.pb.h"
 #include "xla/service/gpu/gpu_device_info_for_tests.h"
 #include "xla/service/gpu/model/fusion_analysis_cache.h"
+#include "xla/service/gpu/model/fusion_runtime_memo.h"
 #include "xla/service/gpu/model/gpu_hlo_cost_analysis.h"
 #include "xla/service/gpu/model/gpu_indexing_performance_model.h"
 #include "xla/service/gpu/model/gpu_performance_model_base.h"
@@ -762,6 +764,75 @@ ENTRY entry_computation.1 {
   EXPECT_NEAR(absl::ToInt64Milliseconds(t.time_fused), 145, 1);
 }
 
+TEST_F(GpuPerformanceModelTest, FusionRuntimeMemoIsSharedAcrossModels) {
+  absl::string_view hlo_string = R"(
+HloModule m
+
+f {
+  p0 = f32[1000] parameter(0)
+  ROOT n0 = f32[1000] negate(p0)
+}
+
+g {
+  p0 = f32[1000] parameter(0)
+  p1 = f32[1000] parameter(1)
+  ROOT a0 = f32[1000] add(p0, p1)
+}
+
+ENTRY e {
+  p0 = f32[1000] parameter(0)
+  p1 = f32[1000] parameter(1)
+  producer = f32[1000] fusion(p0), kind=kLoop, calls=f
+  ROOT consumer = f32[1000] fusion(producer, p1), kind=kLoop, calls=g
+}
+)";
+  FusionRuntimeMemo memo;
+  auto estimate = [&](GpuPerformanceModel& model,
+                      HloModule& module) -> GpuPerformanceModel::RunTimes {
+    HloInstruction* producer =
+        module.entry_computation()->GetInstructionWithName("producer");
+    HloInstruction* consumer = module.entry_computation()->root_instruction();
+    model.EstimateRunTimeForInstruction(producer, &analysis_);
+    model.EstimateRunTimeForInstruction(consumer, &analysis_);
+    return model.EstimateRunTimes(producer, &analysis_, {consumer});
+  };
+
+  TF_ASSERT_OK_AND_ASSIGN(auto module,
+                          ParseAndReturnVerifiedModule(hlo_string));
+  ASSERT_IS_OK(module->entry_computation()->Accept(&analysis_));
+  GpuPerformanceModelCache cache;
+  GpuPerformanceModel model(device_info_, fusion_analysis_cache_, cache,
+                            &memo);
+  GpuPerformanceModel::RunTimes t = estimate(model, *module);
+
+  const HloInstruction* producer =
+      module->entry_computation()->GetInstructionWithName("producer");
+  const HloInstruction* consumer =
+      module->entry_computation()->root_instruction();
+  uint64_t device_key = FusionRuntimeMemo::DeviceKey(device_info_);
+  EXPECT_TRUE(memo.GetInstructionRunTime(
+                      device_key, FusionRuntimeMemo::InstructionKey(*producer))
+                  .has_value());
+  EXPECT_EQ(memo.GetFusionRunTime(
+                device_key,
+                FusionRuntimeMemo::FusionKey(
+                    *producer, FusionRuntimeMemo::InstructionKey(*producer),
+                    *consumer, FusionRuntimeMemo::InstructionKey(*consumer),
+                    /*producer_writes_side_output=*/false)),
+            t.time_fused - GpuPerformanceModel::kKernelLaunchOverhead);
+
+  TF_ASSERT_OK_AND_ASSIGN(auto other_module,
+                          ParseAndReturnVerifiedModule(hlo_string));
+  ASSERT_IS_OK(other_module->entry_computation()->Accept(&analysis_));
+  HloFusionAnalysisCache other_fusion_analysis_cache(device_info_);
+  GpuPerformanceModelCache other_cache;
+  GpuPerformanceModel other_model(device_info_, other_fusion_analysis_cache,
+                                  other_cache, &memo);
+  GpuPerformanceModel::RunTimes other_t = estimate(other_model, *other_module);
+  EXPECT_EQ(other_t.time_unfused, t.time_unfused);
+  EXPECT_EQ(other_t.time_fused, t.time_fused);
+}
+
 }  // namespace
 }  // namespace gpu
 }  // namespace xla
@@ -40,6 +40,10 @@ class HloOpProfiles {
       absl::flat_hash_map<std::string,  // compute capability.
                           HloOpProfile>;
 
+  // Latest `DeviceHloInstructionProfiles::version` written by the perf table
+  // generators. Readers reject tables with a newer version.
+  static constexpr int64_t kProfilesVersion = 1;
+
   // Returns singleton with profiler data.
   static const HloOpProfiles& Singleton();
 
@@ -65,6 +65,12 @@ absl::StatusOr<HloInstructionProfileList> ReadProfiles(
   TF_RETURN_IF_ERROR(tsl::Env::Default()->FileExists(perf_table_path));
   TF_RETURN_IF_ERROR(tsl::ReadTextOrBinaryProto(tsl::Env::Default(),
                                                 perf_table_path, &profile));
+  if (profile.version() > HloOpProfiles::kProfilesVersion) {
+    return absl::FailedPreconditionError(absl::StrCat(
+        "Unsupported perf table version ", profile.version(), " in ",
+        perf_table_path, ", expected at most ",
+        HloOpProfiles::kProfilesVersion));
+  }
   std::string key = HloOpProfiles::GetProfileName(device_info);
 
   if (!profile.entries().contains(key)) {
@@ -166,6 +172,18 @@ std::optional<absl::Duration> DispatchEstimation(
     return std::nullopt;
   }
 
+  // Prefer measurements of multi-host collectives from the perf table, if
+  // there are any, over the analytical model.
+  if (collective_interpolator != nullptr &&
+      (comm == GPUCommunicationType::RAIL_ALIGNED ||
+       comm == GPUCommunicationType::NON_RAIL_ALIGNED)) {
+    if (std::optional<absl::Duration> runtime =
+            collective_interpolator->EstimatedRuntime(instr);
+        runtime.has_value()) {
+      return runtime;
+    }
+  }
+
   switch (comm) {
     case GPUCommunicationType::RAIL_ALIGNED: {
       return DCNCollectiveDuration(
@@ -195,16 +213,21 @@ absl::StatusOr<std::unique_ptr<CollectiveInterpolator>>
 CreateCollectiveInterpolator(int num_devices_per_host, const HloModule& module,
                              const se::DeviceDescription& device_info,
                              const GpuHloCostAnalysis& analysis) {
+  const std::string& perf_table_path =
+      module.config()
+          .debug_options()
+          .xla_gpu_experimental_collective_perf_table_path();
   absl::StatusOr<HloInstructionProfileList> collective_profiles =
-      ReadProfiles(module.config()
-                       .debug_options()
-                       .xla_gpu_experimental_collective_perf_table_path(),
-                   device_info);
-  std::unique_ptr<CollectiveInterpolator> collective_interpolator;
+      ReadProfiles(perf_table_path, device_info);
   if (collective_profiles.ok()) {
     return CollectiveInterpolator::Create(
         num_devices_per_host, *collective_profiles, device_info, &analysis);
   }
+  if (!perf_table_path.empty()) {
+    LOG(WARNING) << "Cannot load collective perf table, falling back to the "
+                    "default one: "
+                 << collective_profiles.status();
+  }
   return CollectiveInterpolator::Create(num_devices_per_host, device_info,
                                         &analysis);
 }
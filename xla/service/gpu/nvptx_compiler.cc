@@ -36,6 +36,7 @@ limitations under the License.
 #include "absl/strings/str_format.h"
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
 #include "absl/types/span.h"
 #include "llvm/IRReader/IRReader.h"
 #include "llvm/Support/SourceMgr.h"
@@ -552,6 +553,7 @@ NVPTXCompiler::CompileTargetBinary(
   }
 
   std::string ptx;
+  absl::Duration llvm_to_ptx_duration = absl::ZeroDuration();
   if (!(debug_module &&
         MaybeLoadPtxFromFile(module_config, debug_module, &ptx))) {
     // This may print multiple lines per HLO compilation because of the
@@ -571,6 +573,7 @@ NVPTXCompiler::CompileTargetBinary(
     // This won't record values for calls that error out (because if they error
     // out we have no way of telling how far through the process we got).
     RecordLlvmPassesAndLlvmToPtxDuration(end_usecs - start_usecs);
+    llvm_to_ptx_duration = absl::Microseconds(end_usecs - start_usecs);
 
     if (DumpingEnabledForHloModule(debug_module ? debug_module->name() : "",
                                    module_config.debug_options())) {
@@ -625,22 +628,25 @@ NVPTXCompiler::CompileTargetBinary(
     // error out we have no way of telling how far through the process we
     // got).
     RecordPtxToCubinDuration(end_usecs - start_usecs);
+    return absl::Microseconds(end_usecs - start_usecs);
   };
 
+  BackendCompileResult result;
   if (relocatable) {
     TF_ASSIGN_OR_RETURN(se::cuda::RelocatableModule relocatable_module,
                         compilation_provider->CompileToRelocatableModule(
                             cc, ptx, compilation_options));
-    record_ptx_to_cubin_metric();
-    return BackendCompileResult{std::move(ptx),
-                                std::move(relocatable_module.cubin)};
+    result.binary = std::move(relocatable_module.cubin);
+  } else {
+    TF_ASSIGN_OR_RETURN(
+        se::cuda::Assembly assembly,
+        compilation_provider->Compile(cc, ptx, compilation_options));
+    result.binary = std::move(assembly.cubin);
   }
-
-  TF_ASSIGN_OR_RETURN(
-      se::cuda::Assembly assembly,
-      compilation_provider->Compile(cc, ptx, compilation_options));
-  record_ptx_to_cubin_metric();
-  return BackendCompileResult{std::move(ptx), std::move(assembly.cubin)};
+  result.asm_to_binary_duration = record_ptx_to_cubin_metric();
+  result.llvm_to_asm_duration = llvm_to_ptx_duration;
+  result.asm_text = std::move(ptx);
+  return result;
 }
 
 absl::StatusOr<bool> NVPTXCompiler::CanUseLinkModules(
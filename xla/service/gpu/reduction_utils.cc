@@ -18,10 +18,13 @@ limitations under the License.
 #include <algorithm>
 #include <cstdint>
 #include <ostream>
+#include <variant>
 
 #include "absl/algorithm/container.h"
 #include "absl/log/check.h"
+#include "absl/numeric/bits.h"
 #include "absl/strings/str_join.h"
+#include "absl/time/time.h"
 #include "absl/types/span.h"
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_opcode.h"
@@ -150,12 +153,66 @@ bool IsReductionFromOrToContiguousDimensions(
              device_description);
 }
 
+int64_t RowReductionClusterSize(
+    const ReductionDimensions& reduction_dimensions,
+    const se::DeviceDescription& device_description) {
+  // Rough costs of the two options that the model compares: the second kernel
+  // launch of a split reduction and one round trip through a cluster barrier.
+  constexpr absl::Duration kKernelLaunchOverhead = absl::Microseconds(2);
+  constexpr absl::Duration kClusterSyncOverhead = absl::Nanoseconds(500);
+  // Each thread reduces at most this many elements in cluster mode.
+  constexpr int64_t kMaxElementsPerThread = 64;
+  // Most reductions accumulate in 32 bits.
+  constexpr int64_t kPartialResultBytes = 4;
+
+  if (!reduction_dimensions.is_row_reduction ||
+      reduction_dimensions.dimensions[0] > BatchedReductionRaceFreeBound() ||
+      !std::holds_alternative<se::CudaComputeCapability>(
+          device_description.gpu_compute_capability()) ||
+      !device_description.cuda_compute_capability().IsAtLeastHopper()) {
+    return 1;
+  }
+  const int64_t row_size = reduction_dimensions.dimensions[2];
+  const int64_t block_bound =
+      ReductionDimensionRaceFreeBound(reduction_dimensions, device_description);
+  if (row_size <= block_bound ||
+      row_size > MaxRowReductionClusterSize() * MinThreadsXRowReduction() *
+                     kMaxElementsPerThread) {
+    return 1;
+  }
+  const int64_t cluster_size =
+      std::min(MaxRowReductionClusterSize(),
+               static_cast<int64_t>(
+                   absl::bit_ceil(static_cast<uint64_t>(
+                       CeilOfRatio(row_size, block_bound)))));
+
+  // The split reduction writes and reads one partial result per block and
+  // launches a second kernel. The cluster reduction synchronizes once per
+  // wave of clusters.
+  const int64_t num_rows = reduction_dimensions.dimensions[1];
+  const int64_t num_partials = num_rows * CeilOfRatio(row_size, block_bound);
+  const absl::Duration split_overhead =
+      kKernelLaunchOverhead +
+      absl::Seconds(2.0 * num_partials * kPartialResultBytes /
+                    device_description.memory_bandwidth());
+  const int64_t blocks_per_wave =
+      device_description.core_count() *
+      std::max<int64_t>(1, device_description.threads_per_core_limit() /
+                               MinThreadsXRowReduction());
+  const absl::Duration cluster_overhead =
+      kClusterSyncOverhead *
+      CeilOfRatio(num_rows * cluster_size, blocks_per_wave);
+  return cluster_overhead < split_overhead ? cluster_size : 1;
+}
+
 bool ReductionIsRaceFree(const ReductionDimensions& reduction_dimensions,
                          const se::DeviceDescription& device_description) {
   if (reduction_dimensions.is_row_reduction) {
-    return reduction_dimensions.dimensions[2] <=
-               ReductionDimensionRaceFreeBound(reduction_dimensions,
-                                               device_description) &&
+    return (reduction_dimensions.dimensions[2] <=
+                ReductionDimensionRaceFreeBound(reduction_dimensions,
+                                                device_description) ||
+            RowReductionClusterSize(reduction_dimensions, device_description) >
+                1) &&
            reduction_dimensions.dimensions[0] <=
                BatchedReductionRaceFreeBound();
   }
@@ -34,6 +34,10 @@ inline constexpr int64_t MinThreadsXRowReduction() { return 1024; }
 // When doing batched row reduction, how big the batch dimension could be.
 inline constexpr int64_t BatchedReductionRaceFreeBound() { return 8; }
 
+// The largest thread block cluster that a row reduction may be spread over.
+// This is the largest portable cluster size.
+inline constexpr int64_t MaxRowReductionClusterSize() { return 8; }
+
 struct ReductionDimensions {
   // The reduction dimension indices used below.
   constexpr static int kRowMajorReducedDimension = 0;
@@ -105,6 +109,15 @@ int64_t ReductionDimensionRaceFreeBound(
     const ReductionDimensions& reduction_dimensions,
     const se::DeviceDescription& device_description);
 
+// Returns the number of blocks of a thread block cluster that cooperate on
+// each row of the given reduction, or 1 if the reduction does not use
+// clusters. Clusters are used for rows that do not fit into a single block on
+// devices that support distributed shared memory, if a simple cost model
+// expects them to be faster than splitting the reduction into two kernels.
+int64_t RowReductionClusterSize(
+    const ReductionDimensions& reduction_dimensions,
+    const se::DeviceDescription& device_description);
+
 // Returns whether the given reduction can be safely generated without atomics :
 // that is, at most one block will write to every output element.
 bool ReductionIsRaceFree(const ReductionDimensions& reduction_dimensions,
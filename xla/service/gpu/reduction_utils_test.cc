@@ -21,6 +21,8 @@ limitations under the License.
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/parser/hlo_parser.h"
 #include "xla/hlo/testlib/hlo_hardware_independent_test_base.h"
+#include "xla/service/gpu/gpu_device_info_for_tests.h"
+#include "xla/stream_executor/device_description.h"
 
 namespace xla {
 namespace gpu {
@@ -197,6 +199,26 @@ TEST(ReductionDimensionsTest, GetOutputShape) {
   EXPECT_THAT(col_reduction.GetOutputShape(), ElementsAre(1, 3));
 }
 
+TEST(ReductionDimensionsTest, LongRowsUseClustersOnHopper) {
+  ReductionDimensions long_rows{/*is_row_reduction=*/true, {1, 16, 262144}};
+  se::DeviceDescription h100 = TestGpuDeviceInfo::RTXH100SXMDeviceInfo();
+  se::DeviceDescription a6000 = TestGpuDeviceInfo::RTXA6000DeviceInfo();
+
+  EXPECT_EQ(RowReductionClusterSize(long_rows, h100), 8);
+  EXPECT_TRUE(ReductionIsRaceFree(long_rows, h100));
+  EXPECT_EQ(RowReductionClusterSize(long_rows, a6000), 1);
+  EXPECT_FALSE(ReductionIsRaceFree(long_rows, a6000));
+}
+
+TEST(ReductionDimensionsTest, ShortOrHugeRowsDoNotUseClusters) {
+  se::DeviceDescription h100 = TestGpuDeviceInfo::RTXH100SXMDeviceInfo();
+  ReductionDimensions short_rows{/*is_row_reduction=*/true, {1, 16, 4096}};
+  ReductionDimensions huge_rows{/*is_row_reduction=*/true, {1, 16, 1 << 24}};
+
+  EXPECT_EQ(RowReductionClusterSize(short_rows, h100), 1);
+  EXPECT_EQ(RowReductionClusterSize(huge_rows, h100), 1);
+}
+
 }  // namespace
 }  // namespace gpu
 }  // namespace xla
@@ -109,9 +109,15 @@ absl::StatusOr<bool> GpuAllGatherCombiner::Run(
     changed |= combined;
   }
 
-  // Use default combiner thresholds after we combine pipelined collectives.
-  // The rest is combined by the parent pass code.
-  combine_threshold_in_bytes_ = default_combine_threshold_in_bytes_;
+  // Use default or adaptive combiner thresholds after we combine pipelined
+  // collectives. The rest is combined by the parent pass code.
+  combine_threshold_in_bytes_ =
+      module->config()
+              .debug_options()
+              .xla_gpu_experimental_adaptive_combine_threshold()
+          ? ComputeAdaptiveCombinerThreshold(*module, device_info_,
+                                             HloOpcode::kAllGather)
+          : default_combine_threshold_in_bytes_;
   TF_ASSIGN_OR_RETURN(
       bool combined,
       RunWithKeyCombiner(module, execution_threads, DefaultCombinerKey));
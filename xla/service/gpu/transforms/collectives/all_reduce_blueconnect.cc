@@ -364,6 +364,17 @@ absl::StatusOr<bool> AllReduceBlueConnect::Run(
 
   bool changed = false;
   for (HloAllReduceInstruction* all_reduce : all_reduces) {
+    int64_t size_bytes = 0;
+    for (const HloInstruction* operand : all_reduce->operands()) {
+      size_bytes += ShapeUtil::ByteSizeOf(operand->shape());
+    }
+    if (size_bytes < min_all_reduce_size_bytes_) {
+      VLOG(2) << "Skip decomposing " << all_reduce->name() << " of "
+              << size_bytes << " bytes; min_all_reduce_size_bytes="
+              << min_all_reduce_size_bytes_;
+      continue;
+    }
+
     TF_ASSIGN_OR_RETURN(
         bool all_reduce_changed,
         TryDecomposeAllReduce(all_reduce, num_devices_per_host_));
@@ -17,6 +17,7 @@ limitations under the License.
 #define XLA_SERVICE_GPU_TRANSFORMS_COLLECTIVES_ALL_REDUCE_BLUECONNECT_H_
 
 #include <cstddef>
+#include <cstdint>
 
 #include "absl/container/flat_hash_set.h"
 #include "absl/status/statusor.h"
@@ -35,10 +36,16 @@ namespace xla {
 // This algorithm attempts to minimize the number of levels of network hierarchy
 // traversed for as much data transfer as possible. This implementation assumes
 // that host IDs are ordered corresponding to network hierarchy.
+//
+// All-reduces smaller than `min_all_reduce_size_bytes` are not decomposed, as
+// they are latency bound and replacing them with three collectives only adds
+// launch and synchronization overheads.
 class AllReduceBlueConnect : public HloModulePass {
  public:
-  explicit AllReduceBlueConnect(const size_t num_devices_per_host)
-      : num_devices_per_host_(num_devices_per_host) {}
+  explicit AllReduceBlueConnect(const size_t num_devices_per_host,
+                                const int64_t min_all_reduce_size_bytes = 0)
+      : num_devices_per_host_(num_devices_per_host),
+        min_all_reduce_size_bytes_(min_all_reduce_size_bytes) {}
 
   absl::string_view name() const override { return "all-reduce-blueconnect"; }
 
@@ -49,6 +56,7 @@ class AllReduceBlueConnect : public HloModulePass {
 
  private:
   const size_t num_devices_per_host_;
+  const int64_t min_all_reduce_size_bytes_;
 };
 
 }  // namespace xla
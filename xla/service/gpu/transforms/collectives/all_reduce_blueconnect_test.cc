@@ -113,6 +113,29 @@ ENTRY %comp {
               GmockMatch(m::Bitcast(all_gather).WithShape(F32, {4, 4})));
 }
 
+TEST_F(AllReduceBlueConnectTest, SmallAllReduceUnchanged) {
+  constexpr absl::string_view hlo_string = R"(
+HloModule module
+
+%add {
+  lhs = f32[] parameter(0)
+  rhs = f32[] parameter(1)
+  ROOT add = f32[] add(lhs, rhs)
+}
+
+ENTRY %comp {
+  p0 = f32[4,4] parameter(0)
+  ROOT crs = f32[4,4] all-reduce(p0), to_apply=add
+})";
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(hlo_string));
+  SetModuleConfig(*module, /*replica_count=*/8);
+
+  AllReduceBlueConnect pass(/*num_devices_per_host=*/4,
+                            /*min_all_reduce_size_bytes=*/1024);
+  EXPECT_THAT(pass.Run(module.get()), IsOkAndHolds(false));
+}
+
 TEST_F(AllReduceBlueConnectTest, TwoStage) {
   constexpr absl::string_view hlo_string = R"(
 HloModule module
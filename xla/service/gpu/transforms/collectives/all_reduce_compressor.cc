@@ -0,0 +1,171 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/service/gpu/transforms/collectives/all_reduce_compressor.h"
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/log/log.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_casting_utils.h"
+#include "xla/hlo/ir/hlo_computation.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_instructions.h"
+#include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/hlo/utils/hlo_query.h"
+#include "xla/literal_util.h"
+#include "xla/primitive_util.h"
+#include "xla/service/collective_ops_utils.h"
+#include "xla/shape.h"
+#include "xla/shape_util.h"
+#include "xla/tsl/platform/errors.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/xla_data.pb.h"
+
+namespace xla {
+namespace gpu {
+
+// Returns true if all-to-all and all-gather created with the same replica
+// groups and channel id as `all_reduce` have the same participants. All-to-all
+// has no `use_global_device_ids` attribute, and with a channel id it always
+// forms groups of partitions.
+static bool HasCompatibleGroupMode(const HloAllReduceInstruction* all_reduce) {
+  if (!all_reduce->channel_id().has_value()) {
+    return true;
+  }
+  return all_reduce->use_global_device_ids() &&
+         all_reduce->GetModule()->config().replica_count() == 1;
+}
+
+static absl::StatusOr<bool> TryCompressAllReduce(
+    HloAllReduceInstruction* all_reduce, int64_t min_size_bytes,
+    PrimitiveType wire_type) {
+  if (all_reduce->operand_count() != 1 || !all_reduce->shape().IsArray() ||
+      all_reduce->shape().element_type() != F32 ||
+      all_reduce->constrain_layout() ||
+      ShapeUtil::ByteSizeOf(all_reduce->shape()) < min_size_bytes) {
+    return false;
+  }
+
+  if (MatchReductionComputation(all_reduce->to_apply()) !=
+      ReductionKind::SUM) {
+    return false;
+  }
+
+  if (!HasCompatibleGroupMode(all_reduce)) {
+    VLOG(2) << "Skip compressing " << all_reduce->name()
+            << " because of unsupported collective group mode";
+    return false;
+  }
+
+  TF_ASSIGN_OR_RETURN(auto replica_group_count_and_size,
+                      GetReplicaGroupCountAndSize(all_reduce));
+  if (!replica_group_count_and_size.has_value()) {
+    return false;
+  }
+  int64_t num_participants = replica_group_count_and_size->second;
+  int64_t num_elements = ShapeUtil::ElementsIn(all_reduce->shape());
+  if (num_participants < 2 || num_elements % num_participants != 0) {
+    return false;
+  }
+  int64_t shard_size = num_elements / num_participants;
+
+  HloComputation* computation = all_reduce->parent();
+  HloModule* module = computation->parent();
+  int64_t next_channel_id = hlo_query::NextChannelId(*module);
+  auto get_channel_id = [&]() -> std::optional<int64_t> {
+    if (all_reduce->channel_id().has_value()) {
+      return next_channel_id++;
+    }
+    return std::nullopt;
+  };
+
+  auto add = [&](std::unique_ptr<HloInstruction> instr) {
+    return computation->AddInstruction(std::move(instr));
+  };
+
+  // Row `i` of the exchanged data is the shard reduced by participant `i`.
+  Shape f32_rows = ShapeUtil::MakeShape(F32, {num_participants, shard_size});
+  Shape wire_rows = ShapeUtil::ChangeElementType(f32_rows, wire_type);
+  HloInstruction* rows = add(HloInstruction::CreateReshape(
+      f32_rows, all_reduce->mutable_operand(0)));
+  HloInstruction* compressed =
+      add(HloInstruction::CreateConvert(wire_rows, rows));
+  HloInstruction* all_to_all = add(HloInstruction::CreateAllToAll(
+      wire_rows, {compressed}, all_reduce->device_list(),
+      /*constrain_layout=*/false, get_channel_id(), /*split_dimension=*/0));
+
+  // Accumulate received shards in f32.
+  Shape f32_shard = ShapeUtil::MakeShape(F32, {shard_size});
+  HloInstruction* decompressed =
+      add(HloInstruction::CreateConvert(f32_rows, all_to_all));
+  HloInstruction* zero =
+      add(HloInstruction::CreateConstant(LiteralUtil::Zero(F32)));
+  HloInstruction* reduce = add(HloInstruction::CreateReduce(
+      f32_shard, decompressed, zero, /*dimensions_to_reduce=*/{0},
+      all_reduce->to_apply()));
+
+  Shape wire_shard = ShapeUtil::ChangeElementType(f32_shard, wire_type);
+  Shape wire_flat = ShapeUtil::MakeShape(wire_type, {num_elements});
+  HloInstruction* compressed_shard =
+      add(HloInstruction::CreateConvert(wire_shard, reduce));
+  HloInstruction* all_gather = add(HloInstruction::CreateAllGather(
+      wire_flat, {compressed_shard}, /*all_gather_dimension=*/0,
+      all_reduce->device_list(), /*constrain_layout=*/false, get_channel_id(),
+      all_reduce->use_global_device_ids()));
+
+  HloInstruction* result = add(HloInstruction::CreateConvert(
+      ShapeUtil::ChangeElementType(wire_flat, F32), all_gather));
+  result = add(HloInstruction::CreateReshape(all_reduce->shape(), result));
+
+  VLOG(2) << "Compressed " << all_reduce->name() << " to "
+          << primitive_util::LowercasePrimitiveTypeName(wire_type);
+  TF_RETURN_IF_ERROR(all_reduce->CopyAllControlDepsTo(compressed, result));
+  TF_RETURN_IF_ERROR(all_reduce->DropAllControlDeps());
+  TF_RETURN_IF_ERROR(computation->ReplaceInstruction(all_reduce, result));
+  return true;
+}
+
+absl::StatusOr<bool> AllReduceCompressor::Run(
+    HloModule* module,
+    const absl::flat_hash_set<absl::string_view>& execution_threads) {
+  std::vector<HloAllReduceInstruction*> all_reduces;
+  for (HloComputation* computation :
+       module->MakeNonfusionComputations(execution_threads)) {
+    for (HloInstruction* instruction : computation->instructions()) {
+      if (HloPredicateIsOp<HloOpcode::kAllReduce>(instruction)) {
+        all_reduces.push_back(Cast<HloAllReduceInstruction>(instruction));
+      }
+    }
+  }
+
+  bool changed = false;
+  for (HloAllReduceInstruction* all_reduce : all_reduces) {
+    TF_ASSIGN_OR_RETURN(
+        bool compressed,
+        TryCompressAllReduce(all_reduce, min_size_bytes_, wire_type_));
+    changed |= compressed;
+  }
+  return changed;
+}
+
+}  // namespace gpu
+}  // namespace xla
@@ -0,0 +1,62 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_SERVICE_GPU_TRANSFORMS_COLLECTIVES_ALL_REDUCE_COMPRESSOR_H_
+#define XLA_SERVICE_GPU_TRANSFORMS_COLLECTIVES_ALL_REDUCE_COMPRESSOR_H_
+
+#include <cstdint>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/pass/hlo_pass_interface.h"
+#include "xla/xla_data.pb.h"
+
+namespace xla {
+namespace gpu {
+
+// Rewrites large f32 sum `all-reduce`s to send data over the wire in a lower
+// precision type, while accumulating in f32:
+//
+//   convert(f32 -> bf16) -> all-to-all -> convert(bf16 -> f32) -> reduce
+//   -> convert(f32 -> bf16) -> all-gather -> convert(bf16 -> f32)
+//
+// The all-to-all and all-gather send the same number of elements as the
+// reduce-scatter and all-gather phases of a ring all-reduce, so this halves
+// the number of bytes on the wire. The result is not bit-exact with an f32
+// all-reduce, so the pass is opt-in.
+class AllReduceCompressor : public HloModulePass {
+ public:
+  explicit AllReduceCompressor(int64_t min_size_bytes,
+                               PrimitiveType wire_type = BF16)
+      : min_size_bytes_(min_size_bytes), wire_type_(wire_type) {}
+
+  absl::string_view name() const override { return "all-reduce-compressor"; }
+
+  using HloPassInterface::Run;
+  absl::StatusOr<bool> Run(
+      HloModule* module,
+      const absl::flat_hash_set<absl::string_view>& execution_threads) override;
+
+ private:
+  int64_t min_size_bytes_;
+  PrimitiveType wire_type_;
+};
+
+}  // namespace gpu
+}  // namespace xla
+
+#endif  // XLA_SERVICE_GPU_TRANSFORMS_COLLECTIVES_ALL_REDUCE_COMPRESSOR_H_
@@ -0,0 +1,108 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/service/gpu/transforms/collectives/all_reduce_compressor.h"
+
+#include <memory>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/testlib/hlo_hardware_independent_test_base.h"
+#include "xla/hlo/testlib/pattern_matcher_gmock.h"
+#include "xla/service/pattern_matcher.h"
+#include "xla/tsl/platform/status_matchers.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/xla_data.pb.h"
+
+namespace xla::gpu {
+namespace {
+
+using ::tsl::testing::IsOkAndHolds;
+namespace m = ::xla::match;
+
+using AllReduceCompressorTest = HloHardwareIndependentTestBase;
+
+constexpr absl::string_view kHloString = R"(
+HloModule module, replica_count=4
+
+add {
+  lhs = f32[] parameter(0)
+  rhs = f32[] parameter(1)
+  ROOT add = f32[] add(lhs, rhs)
+}
+
+ENTRY main {
+  p0 = f32[64,16] parameter(0)
+  ROOT ar = f32[64,16] all-reduce(p0), replica_groups={{0,1,2,3}},
+    to_apply=add
+})";
+
+TEST_F(AllReduceCompressorTest, CompressesLargeAllReduce) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(kHloString));
+
+  AllReduceCompressor pass(/*min_size_bytes=*/1024);
+  EXPECT_THAT(pass.Run(module.get()), IsOkAndHolds(true));
+
+  auto all_to_all =
+      m::AllToAll(m::Convert(m::Reshape(m::Parameter(0)))
+                      .WithShape(BF16, {4, 256}))
+          .WithShape(BF16, {4, 256});
+  auto reduce = m::Reduce(m::Convert(all_to_all).WithShape(F32, {4, 256}),
+                          m::Constant())
+                    .WithShape(F32, {256});
+  auto all_gather =
+      m::AllGather(m::Convert(reduce).WithShape(BF16, {256}))
+          .WithShape(BF16, {1024});
+  EXPECT_THAT(
+      module->entry_computation()->root_instruction(),
+      GmockMatch(m::Reshape(m::Convert(all_gather).WithShape(F32, {1024}))
+                     .WithShape(F32, {64, 16})));
+}
+
+TEST_F(AllReduceCompressorTest, SmallAllReduceUnchanged) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(kHloString));
+
+  AllReduceCompressor pass(/*min_size_bytes=*/1024 * 1024);
+  EXPECT_THAT(pass.Run(module.get()), IsOkAndHolds(false));
+}
+
+TEST_F(AllReduceCompressorTest, NonSumAllReduceUnchanged) {
+  constexpr absl::string_view kHlo = R"(
+HloModule module, replica_count=4
+
+max {
+  lhs = f32[] parameter(0)
+  rhs = f32[] parameter(1)
+  ROOT max = f32[] maximum(lhs, rhs)
+}
+
+ENTRY main {
+  p0 = f32[1024] parameter(0)
+  ROOT ar = f32[1024] all-reduce(p0), replica_groups={{0,1,2,3}},
+    to_apply=max
+})";
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(kHlo));
+
+  AllReduceCompressor pass(/*min_size_bytes=*/0);
+  EXPECT_THAT(pass.Run(module.get()), IsOkAndHolds(false));
+}
+
+}  // namespace
+}  // namespace xla::gpu
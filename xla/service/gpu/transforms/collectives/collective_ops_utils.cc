@@ -162,6 +162,13 @@ absl::StatusOr<GPUCommunicationType> CommunicationType(
   return GPUCommunicationType::UNDEFINED;
 }
 
+absl::StatusOr<bool> IsSingleHostCollective(
+    int num_devices_per_host, const HloChannelInstruction& instr) {
+  TF_ASSIGN_OR_RETURN(CommunicationMetadata comm,
+                      CommunicationContext(instr, num_devices_per_host));
+  return IsSingleHost(comm);
+}
+
 std::optional<bool> IsMultiHostTopology(
     const HloModuleConfig& config,
     const se::DeviceDescription& device_description) {
@@ -39,6 +39,11 @@ absl::StatusOr<GPUCommunicationType> CommunicationType(
     int num_devices_per_host, const HloChannelInstruction& instr,
     const se::GpuComputeCapability& gpu_version);
 
+// Returns true if all participants of every replica group (or source-target
+// pair) of the channel instruction are on the same host.
+absl::StatusOr<bool> IsSingleHostCollective(int num_devices_per_host,
+                                            const HloChannelInstruction& instr);
+
 // Returns true if instruction is a synchronous collective op.
 bool IsGPUSyncCollective(const HloInstruction& instr);
 
@@ -13,10 +13,12 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#include <algorithm>
 #include <cstdint>
 
 #include "absl/log/log.h"
 #include "absl/status/status.h"
+#include "absl/time/time.h"
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_module.h"
 #include "xla/hlo/ir/hlo_opcode.h"
@@ -25,6 +27,7 @@ limitations under the License.
 #include "xla/service/collective_utils.h"
 #include "xla/service/gpu/backend_configs.pb.h"
 #include "xla/service/gpu/gpu_hlo_schedule.h"
+#include "xla/service/gpu/model/sol_gpu_cost_model.h"
 #include "xla/stream_executor/device_description.h"
 #include "xla/util.h"
 
@@ -68,6 +71,49 @@ int64_t ComputeSuggestedCombinerThreshold(
   return MaxAvailableMemory(module, device_info) - peak_memory_bytes;
 }
 
+int64_t ComputeAdaptiveCombinerThreshold(
+    const HloModule& module, const se::DeviceDescription& device_info,
+    HloOpcode collective_opcode) {
+  // The smallest threshold considered, and the share of the runtime of two
+  // collectives that combining them must save.
+  constexpr int64_t kMinThreshold = 1 << 20;
+  constexpr double kMinSavings = 0.1;
+
+  SolGPUCostModel::CollectiveType collective_type;
+  if (collective_opcode == HloOpcode::kAllGather) {
+    collective_type = SolGPUCostModel::CollectiveType::kAllGather;
+  } else if (collective_opcode == HloOpcode::kAllReduce) {
+    collective_type = SolGPUCostModel::CollectiveType::kAllReduce;
+  } else if (collective_opcode == HloOpcode::kReduceScatter) {
+    collective_type = SolGPUCostModel::CollectiveType::kReduceScatter;
+  } else {
+    LOG(FATAL) << "Expected collective op. Got: " << collective_opcode;
+  }
+
+  SolGPUCostModel::Config config =
+      SolGPUCostModel::GetConfig(&module, device_info);
+  SolGPUCostModel cost_model(config);
+  int64_t num_devices =
+      module.config().replica_count() * module.config().num_partitions();
+  int num_nodes = std::max<int64_t>(
+      1, CeilOfRatio<int64_t>(num_devices, config.gpus_per_node));
+
+  int64_t max_threshold = MaxAvailableMemory(module, device_info);
+  for (int64_t threshold = kMinThreshold; threshold < max_threshold;
+       threshold *= 2) {
+    absl::Duration latency =
+        cost_model.RingLatency(threshold, num_nodes, collective_type);
+    absl::Duration combined_latency =
+        cost_model.RingLatency(2 * threshold, num_nodes, collective_type);
+    if (combined_latency >= 2 * (1 - kMinSavings) * latency) {
+      VLOG(1) << "Adaptive " << collective_opcode
+              << " combiner threshold: " << threshold << " bytes";
+      return threshold;
+    }
+  }
+  return max_threshold;
+}
+
 absl::Status AppendPipelinedInstruction(HloInstruction* instr,
                                         HloInstruction* new_while_instr) {
   if (!IsCollective(instr)) {
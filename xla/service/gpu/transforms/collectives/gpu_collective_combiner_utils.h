@@ -40,6 +40,15 @@ int64_t ComputeSuggestedCombinerThreshold(
     const HloModule& module, const se::DeviceDescription& device_info,
     HloOpcode collective_opcode, int64_t pointer_size);
 
+// Returns a combiner threshold for `collective_opcode` picked with the SoL
+// collective cost model: the smallest size from which combining two collectives
+// of that size saves less than 10% of their runtime. Larger combined
+// collectives barely amortize the per-collective latency any further, but are
+// harder to overlap with compute.
+int64_t ComputeAdaptiveCombinerThreshold(
+    const HloModule& module, const se::DeviceDescription& device_info,
+    HloOpcode collective_opcode);
+
 // Adds information that `instr` has been pipelined to the
 // `CollectiveBackendInfo`. It is up to the caller to decide when to invoke
 // this.
@@ -513,5 +513,35 @@ TEST_F(CollectiveCombinerUtilsTest,
   EXPECT_FALSE(ContainsPipelinedInstruction(*module));
 }
 
+TEST_F(CollectiveCombinerUtilsTest,
+       ComputeAdaptiveCombinerThresholdGrowsWithCollectiveLatency) {
+  constexpr absl::string_view kHloText = R"(
+    HloModule module, replica_count=16
+
+    ENTRY entry {
+      ROOT p0 = f32[8] parameter(0)
+    }
+  )";
+
+  TF_ASSERT_OK_AND_ASSIGN(auto module, ParseAndReturnVerifiedModule(kHloText));
+  stream_executor::DeviceDescription device_info;
+  device_info.set_device_memory_size(int64_t{80} << 30);
+
+  int64_t threshold = ComputeAdaptiveCombinerThreshold(*module, device_info,
+                                                       HloOpcode::kAllReduce);
+  EXPECT_GE(threshold, 1 << 20);
+  EXPECT_LT(threshold, MaxAvailableMemory(*module, device_info));
+
+  // Collectives with a higher fixed latency are worth combining into larger
+  // ones.
+  (*module->mutable_config()
+        .mutable_debug_options()
+        .mutable_xla_gpu_analytical_latency_estimator_options())["rtt_us"] =
+      "10000";
+  EXPECT_GT(ComputeAdaptiveCombinerThreshold(*module, device_info,
+                                             HloOpcode::kAllReduce),
+            threshold);
+}
+
 }  // namespace
 }  // namespace xla::gpu
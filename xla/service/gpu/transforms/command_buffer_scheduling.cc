@@ -131,7 +131,8 @@ static bool AsyncStartOrDoneCommandIsSupported(
   }
 
   if (hlo->async_wrapped_opcode() == HloOpcode::kReduceScatter ||
-      hlo->async_wrapped_opcode() == HloOpcode::kAllToAll) {
+      hlo->async_wrapped_opcode() == HloOpcode::kAllToAll ||
+      hlo->async_wrapped_opcode() == HloOpcode::kCollectiveBroadcast) {
     return config.enabled_commands.contains(DebugOptions::COLLECTIVES);
   }
 
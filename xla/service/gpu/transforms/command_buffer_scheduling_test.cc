@@ -1123,6 +1123,107 @@ TEST_F(CommandBufferSchedulingTest, AsyncAlltoAll) {
                             });
 }
 
+TEST_F(CommandBufferSchedulingTest, AsyncCollectiveBroadcast) {
+  const char* hlo = R"(
+    HloModule m, is_scheduled=true
+
+    async_computation.1 {
+    param.1 = f32[4,8,128]{2,1,0} parameter(0)
+    ROOT collective-broadcast.1 = f32[4,8,128]{2,1,0} collective-broadcast(param.1), channel_id=1, replica_groups={{0,1}}
+    }
+
+    ENTRY main {
+    param.0 = f32[4,8,128]{2,1,0} parameter(0)
+    collective-broadcast-start = ((f32[4,8,128]{2,1,0}), f32[4,8,128]{2,1,0}) async-start(param.0), calls=async_computation.1
+    ROOT collective-broadcast-done = f32[4,8,128]{2,1,0} async-done(collective-broadcast-start)
+    })";
+
+  const char* expected = R"(
+    CHECK: %command_buffer ([[P:.+]]: f32[4,8,128]) -> f32[4,8,128] {
+    CHECK:   %[[P]] = f32[4,8,128]{2,1,0} parameter(0)
+    CHECK:   %[[S1:.+]] = ((f32[4,8,128]{2,1,0}), f32[4,8,128]{2,1,0}) collective-broadcast-start(%[[P]])
+    CHECK:   ROOT {{.*}} = f32[4,8,128]{2,1,0} collective-broadcast-done(%[[S1]])
+    CHECK: })";
+
+  RunAndFilecheckHloRewrite(hlo, CommandBufferScheduling(device_desc()),
+                            expected, [](HloModule* module) {
+                              EXPECT_TRUE(module->has_schedule());
+                              TF_CHECK_OK(module->schedule().Verify());
+                            });
+}
+
+TEST_F(CommandBufferSchedulingTest, WhileWithCollectiveBroadcast) {
+  const auto& gpu_desc = GetGpuComputeCapability();
+  if (std::holds_alternative<se::RocmComputeCapability>(gpu_desc)) {
+    GTEST_SKIP() << "Not supported for ROCm!";
+  }
+  const char* hlo = R"(
+    HloModule TestModule, is_scheduled=true
+
+    %fused_computation (param_0: f32[1]) -> f32[1] {
+      %param_0 = f32[1]{0} parameter(0)
+      ROOT %copy.5 = f32[1]{0} copy(f32[1]{0} %param_0)
+    }
+
+    %fused_computation.1 (param_0.1: f32[1], param_1: f32[1]) -> f32[1] {
+      %param_0.1 = f32[1]{0} parameter(0)
+      %param_1 = f32[1]{0} parameter(1)
+      ROOT %add.2 = f32[1]{0} add(f32[1]{0} %param_0.1, f32[1]{0} %param_1)
+    }
+
+    %fused_computation.2 (param_0.2: f32[1], param_1.1: f32[1]) -> pred[1] {
+      %param_0.2 = f32[1]{0} parameter(0)
+      %param_1.1 = f32[1]{0} parameter(1)
+      ROOT %compare.3 = pred[1]{0} compare(f32[1]{0} %param_0.2, f32[1]{0} %param_1.1), direction=LT
+    }
+
+    %async_computation (param.1: f32[1]) -> f32[1] {
+      %param.1 = f32[1]{0} parameter(0)
+      ROOT %collective-broadcast.1 = f32[1]{0} collective-broadcast(f32[1]{0} %param.1), channel_id=1, replica_groups={{0,1}}
+    }
+
+    %body (Arg_.3: f32[1]) -> f32[1] {
+      %constant_4 = f32[1]{0} constant({1})
+      %Arg_.3 = f32[1]{0} parameter(0)
+      %collective-broadcast-start = ((f32[1]{0}), f32[1]{0}) async-start(f32[1]{0} %Arg_.3), calls=%async_computation
+      %collective-broadcast-done = f32[1]{0} async-done(((f32[1]{0}), f32[1]{0}) %collective-broadcast-start)
+      ROOT %wrapped_add.1 = f32[1]{0} fusion(f32[1]{0} %collective-broadcast-done, f32[1]{0} %constant_4), kind=kLoop, calls=%fused_computation.1
+    }
+
+    %cond (Arg_.11: f32[1]) -> pred[] {
+      %constant = f32[1]{0} constant({100})
+      %Arg_.11 = f32[1]{0} parameter(0)
+      %wrapped_compare.2 = pred[1]{0} fusion(f32[1]{0} %Arg_.11, f32[1]{0} %constant), kind=kLoop, calls=%fused_computation.2
+      ROOT %bitcast = pred[] bitcast(pred[1]{0} %wrapped_compare.2)
+    }
+
+    ENTRY %main.18 (Arg_0.1: f32[1]) -> f32[] {
+      %Arg_0.1 = f32[1]{0} parameter(0), sharding={replicated}
+      %wrapped_copy.4 = f32[1]{0} fusion(f32[1]{0} %Arg_0.1), kind=kLoop, calls=%fused_computation
+      %while.16 = f32[1]{0} while(f32[1]{0} %wrapped_copy.4), condition=%cond, body=%body
+      ROOT %bitcast.1 = f32[] bitcast(f32[1]{0} %while.16)
+    })";
+
+  const char* expected = R"(
+    CHECK: %command_buffer ([[P0:.+]]: f32[1]) -> f32[1] {
+    CHECK:   %[[P0]] = f32[1]{0} parameter(0)
+    CHECK:   %[[COPY:.*]] = f32[1]{0} fusion(%[[P0]]), kind=kLoop
+    CHECK:   ROOT {{.*}} = f32[1]{0} while(%[[COPY]]), condition=%[[COND:[a-z_0-9.]+]], body=%[[BODY:[a-z_0-9.]+]]
+    CHECK: }
+
+    CHECK: ENTRY %[[MAIN:.+]] ([[ARG0:.+]]: f32[1]) -> f32[] {
+    CHECK:   %[[ARG0]] = f32[1]{0} parameter(0)
+    CHECK:   %call = f32[1]{0} call(%[[ARG0]]), to_apply=%command_buffer
+    CHECK:   ROOT %[[BC:.+]] = f32[] bitcast(%call)
+    CHECK: })";
+
+  RunAndFilecheckHloRewrite(hlo, CommandBufferScheduling(device_desc()),
+                            expected, [](HloModule* module) {
+                              EXPECT_TRUE(module->has_schedule());
+                              TF_CHECK_OK(module->schedule().Verify());
+                            });
+}
+
 TEST_F(CommandBufferSchedulingTest, DynamicSliceFusionStaticSlicing) {
   if (backend().platform()->Name() == "Host" || backend().device_count() < 2) {
     GTEST_SKIP() << "Atleast two GPUs required for this test";
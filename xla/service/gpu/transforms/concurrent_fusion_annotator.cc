@@ -0,0 +1,115 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/service/gpu/transforms/concurrent_fusion_annotator.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "absl/container/btree_map.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "xla/backends/gpu/runtime/thunk.h"
+#include "xla/hlo/ir/hlo_casting_utils.h"
+#include "xla/hlo/ir/hlo_computation.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_instructions.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/service/gpu/backend_configs.pb.h"
+#include "xla/util.h"
+#include "tsl/platform/errors.h"
+#include "tsl/platform/logging.h"
+#include "tsl/platform/statusor.h"
+
+namespace xla::gpu {
+namespace {
+
+// Returns true if `instr` is a kernel fusion that is not yet assigned to any
+// operation queue, and can be moved to a non-default one.
+bool IsConcurrentFusionCandidate(const HloInstruction* instr) {
+  auto* fusion = DynCast<HloFusionInstruction>(instr);
+  if (fusion == nullptr ||
+      fusion->fusion_kind() == HloInstruction::FusionKind::kCustom) {
+    return false;
+  }
+  auto gpu_config = fusion->backend_config<GpuBackendConfig>();
+  return gpu_config.ok() &&
+         gpu_config->operation_queue_id() ==
+             Thunk::kDefaultExecutionStreamId.value() &&
+         gpu_config->wait_on_operation_queues().empty();
+}
+
+absl::StatusOr<bool> AnnotateComputation(HloComputation* computation,
+                                         int64_t num_streams) {
+  // Depth of every instruction in the dependency DAG of the computation. If
+  // there is a path from `a` to `b` then depth(a) < depth(b), so instructions
+  // at the same depth are independent.
+  absl::flat_hash_map<const HloInstruction*, int64_t> depth;
+  absl::btree_map<int64_t, std::vector<HloInstruction*>> fusions_by_depth;
+
+  for (HloInstruction* instr : computation->MakeInstructionPostOrder()) {
+    int64_t instr_depth = 0;
+    for (const HloInstruction* operand : instr->operands()) {
+      instr_depth = std::max(instr_depth, depth[operand] + 1);
+    }
+    for (const HloInstruction* predecessor : instr->control_predecessors()) {
+      instr_depth = std::max(instr_depth, depth[predecessor] + 1);
+    }
+    depth[instr] = instr_depth;
+
+    if (IsConcurrentFusionCandidate(instr)) {
+      fusions_by_depth[instr_depth].push_back(instr);
+    }
+  }
+
+  bool changed = false;
+  for (auto& [instr_depth, fusions] : fusions_by_depth) {
+    // The first fusion stays on the default stream.
+    for (int64_t i = 1; i < fusions.size(); ++i) {
+      TF_ASSIGN_OR_RETURN(GpuBackendConfig gpu_config,
+                          fusions[i]->backend_config<GpuBackendConfig>());
+      gpu_config.set_operation_queue_id(1 + (i - 1) % (num_streams - 1));
+      TF_RETURN_IF_ERROR(fusions[i]->set_backend_config(gpu_config));
+      VLOG(2) << "Assigned operation queue " << gpu_config.operation_queue_id()
+              << " to " << fusions[i]->name() << " at depth " << instr_depth;
+      changed = true;
+    }
+  }
+  return changed;
+}
+
+}  // namespace
+
+absl::StatusOr<bool> ConcurrentFusionAnnotator::Run(
+    HloModule* module,
+    const absl::flat_hash_set<absl::string_view>& execution_threads) {
+  if (num_streams_ < 2) {
+    return false;
+  }
+
+  bool changed = false;
+  for (HloComputation* computation :
+       module->MakeNonfusionComputations(execution_threads)) {
+    TF_ASSIGN_OR_RETURN(bool computation_changed,
+                        AnnotateComputation(computation, num_streams_));
+    changed |= computation_changed;
+  }
+  return changed;
+}
+
+}  // namespace xla::gpu
@@ -0,0 +1,63 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_SERVICE_GPU_TRANSFORMS_CONCURRENT_FUSION_ANNOTATOR_H_
+#define XLA_SERVICE_GPU_TRANSFORMS_CONCURRENT_FUSION_ANNOTATOR_H_
+
+#include <cstdint>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/pass/hlo_pass_interface.h"
+
+namespace xla::gpu {
+
+// Annotates independent fusions with non-default operation queues, so that
+// they run concurrently on different compute streams.
+//
+// Fusions are grouped by their depth in the dependency DAG (operands and
+// control predecessors) of a computation. Fusions at the same depth can't
+// reach each other, so they are independent. In every group with more than one
+// fusion, the first fusion stays on the default stream and the others are
+// distributed round-robin over `num_streams - 1` non-default operation queues.
+//
+// StreamAttributeAnnotator and StreamAttributeAsyncWrapper must run after this
+// pass: they make consumers of annotated fusions wait on the producer queues
+// and wrap annotated fusions into async-start/async-done pairs. The execution
+// stream assignment then maps them onto compute streams for thunk execution,
+// and command buffer scheduling captures them as concurrent graph nodes.
+class ConcurrentFusionAnnotator : public HloModulePass {
+ public:
+  explicit ConcurrentFusionAnnotator(int64_t num_streams)
+      : num_streams_(num_streams) {}
+
+  absl::string_view name() const override {
+    return "concurrent-fusion-annotator";
+  }
+
+  using HloPassInterface::Run;
+  absl::StatusOr<bool> Run(
+      HloModule* module,
+      const absl::flat_hash_set<absl::string_view>& execution_threads) override;
+
+ private:
+  int64_t num_streams_;
+};
+
+}  // namespace xla::gpu
+
+#endif  // XLA_SERVICE_GPU_TRANSFORMS_CONCURRENT_FUSION_ANNOTATOR_H_
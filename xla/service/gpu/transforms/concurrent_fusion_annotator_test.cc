@@ -0,0 +1,90 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/service/gpu/transforms/concurrent_fusion_annotator.h"
+
+#include <cstdint>
+#include <memory>
+
+#include <gtest/gtest.h>
+#include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_computation.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/testlib/hlo_hardware_independent_test_base.h"
+#include "xla/service/gpu/backend_configs.pb.h"
+#include "tsl/platform/statusor.h"
+
+namespace xla::gpu {
+namespace {
+
+using ConcurrentFusionAnnotatorTest = HloHardwareIndependentTestBase;
+
+constexpr absl::string_view kHloString = R"(
+  HloModule m
+
+  fused_negate {
+    p0 = f32[1024] parameter(0)
+    ROOT neg = f32[1024] negate(p0)
+  }
+
+  fused_exp {
+    p0 = f32[1024] parameter(0)
+    ROOT exp = f32[1024] exponential(p0)
+  }
+
+  fused_add {
+    p0 = f32[1024] parameter(0)
+    p1 = f32[1024] parameter(1)
+    ROOT add = f32[1024] add(p0, p1)
+  }
+
+  ENTRY e {
+    p0 = f32[1024] parameter(0)
+    f0 = f32[1024] fusion(p0), kind=kLoop, calls=fused_negate
+    f1 = f32[1024] fusion(p0), kind=kLoop, calls=fused_exp
+    ROOT f2 = f32[1024] fusion(f0, f1), kind=kLoop, calls=fused_add
+  })";
+
+int64_t OperationQueueId(HloModule& module, absl::string_view name) {
+  const HloInstruction* instr =
+      module.entry_computation()->GetInstructionWithName(name);
+  return instr->backend_config<GpuBackendConfig>()->operation_queue_id();
+}
+
+TEST_F(ConcurrentFusionAnnotatorTest, IndependentFusionsGetDifferentQueues) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(kHloString));
+
+  ConcurrentFusionAnnotator annotator(/*num_streams=*/2);
+  TF_ASSERT_OK_AND_ASSIGN(bool changed, annotator.Run(module.get()));
+  EXPECT_TRUE(changed);
+
+  EXPECT_EQ(OperationQueueId(*module, "f0"), 0);
+  EXPECT_EQ(OperationQueueId(*module, "f1"), 1);
+  EXPECT_EQ(OperationQueueId(*module, "f2"), 0);
+}
+
+TEST_F(ConcurrentFusionAnnotatorTest, SingleStreamIsNoOp) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(kHloString));
+
+  ConcurrentFusionAnnotator annotator(/*num_streams=*/1);
+  TF_ASSERT_OK_AND_ASSIGN(bool changed, annotator.Run(module.get()));
+  EXPECT_FALSE(changed);
+}
+
+}  // namespace
+}  // namespace xla::gpu
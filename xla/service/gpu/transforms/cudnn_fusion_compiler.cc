@@ -26,11 +26,14 @@ limitations under the License.
 #include "absl/algorithm/container.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
+#include "absl/functional/function_ref.h"
 #include "absl/log/check.h"
 #include "absl/log/log.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
 #include "third_party/gpus/cudnn/cudnn_version.h"
 #include "xla/comparison_util.h"
 #include "xla/hlo/ir/dfs_hlo_visitor_with_default.h"
@@ -54,6 +57,7 @@ limitations under the License.
 #include "xla/shape_util.h"
 #include "xla/stream_executor/cuda/cuda_dnn.h"
 #include "xla/stream_executor/cuda/cudnn_frontend_helpers.h"
+#include "xla/stream_executor/device_description.h"
 #include "xla/stream_executor/dnn.h"
 #include "xla/stream_executor/stream_executor.h"
 #include "xla/util.h"
@@ -659,11 +663,53 @@ absl::StatusOr<HloInstruction*> AddWorkspace(HloInstruction& fusion,
   return new_fusion;
 }
 
+// A cuDNN graph compiled for a fusion.
+struct CompiledGraph {
+  std::string serialized;
+  int64_t workspace_size;
+  int64_t plan_id;
+};
+
+// Returns the graph compiled by `compile` for `key` from a cache shared by all
+// modules compiled in the process, so that identical fusions of different
+// executables are only built once.
+absl::StatusOr<CompiledGraph> GetOrCompileGraph(
+    const std::string& key,
+    absl::FunctionRef<absl::StatusOr<CompiledGraph>()> compile) {
+  static absl::Mutex mu(absl::kConstInit);
+  static auto* compiled_graphs =
+      new absl::flat_hash_map<std::string, CompiledGraph>();
+  {
+    absl::MutexLock lock(&mu);
+    if (auto it = compiled_graphs->find(key); it != compiled_graphs->end()) {
+      VLOG(4) << "Cache hit.";
+      return it->second;
+    }
+  }
+  // Compile without holding the lock, so that different graphs are built
+  // concurrently by concurrent compilations.
+  TF_ASSIGN_OR_RETURN(CompiledGraph graph, compile());
+  absl::MutexLock lock(&mu);
+  return compiled_graphs->try_emplace(key, std::move(graph)).first->second;
+}
+
+std::string DeviceKey(se::StreamExecutor& stream_exec) {
+  const se::DeviceDescription& device = stream_exec.GetDeviceDescription();
+  const se::dnn::VersionInfo cudnn_version =
+      stream_exec.AsDnn()->GetVersion().value_or(se::dnn::VersionInfo());
+  return absl::StrCat(device.model_str(), "|",
+                      device.cuda_compute_capability().ToString(), "|",
+                      cudnn_version.ToString());
+}
+
 class CuDnnFusionVisitor : public DfsHloRewriteVisitor {
  public:
-  explicit CuDnnFusionVisitor(se::dnn::DnnSupport& dnn_support,
-                              BinaryMap& compilation_results)
-      : dnn_support_(dnn_support), compilation_results_(compilation_results) {}
+  CuDnnFusionVisitor(se::dnn::DnnSupport& dnn_support,
+                     BinaryMap& compilation_results,
+                     absl::string_view device_key)
+      : dnn_support_(dnn_support),
+        compilation_results_(compilation_results),
+        device_key_(device_key) {}
 
   absl::Status HandleFusion(HloInstruction* hlo) override {
     TF_ASSIGN_OR_RETURN(auto gpu_config,
@@ -675,15 +721,20 @@ class CuDnnFusionVisitor : public DfsHloRewriteVisitor {
     }
     VLOG(4) << "Processing " << hlo->ToString();
 
-    auto compile_graph = [&]() -> absl::StatusOr<se::gpu::CudnnGraph> {
+    const bool has_plan_id =
+        fusion_backend_config.has_cudnn_fusion_config() &&
+        fusion_backend_config.cudnn_fusion_config().plan_id() >= 0;
+    const int64_t requested_plan_id =
+        has_plan_id ? fusion_backend_config.cudnn_fusion_config().plan_id()
+                    : -1;
+
+    auto compile_graph = [&]() -> absl::StatusOr<CompiledGraph> {
       TF_ASSIGN_OR_RETURN(
           se::gpu::CudnnGraph graph,
           PrepareGraph(dnn_support_, *DynCast<HloFusionInstruction>(hlo)));
 
-      if (fusion_backend_config.has_cudnn_fusion_config() &&
-          fusion_backend_config.cudnn_fusion_config().plan_id() >= 0) {
-        const int64_t plan_id =
-            fusion_backend_config.cudnn_fusion_config().plan_id();
+      int64_t plan_id = requested_plan_id;
+      if (has_plan_id) {
         VLOG(4) << "Plan ID: " << plan_id;
         // Build single plan with given ID.
         if (plan_id >= graph.Graph().get_execution_plan_count()) {
@@ -693,7 +744,7 @@ class CuDnnFusionVisitor : public DfsHloRewriteVisitor {
       } else {
         // Build plans one by one till first successful when no plan_id was
         // provided.
-        int64_t plan_id = 0;
+        plan_id = 0;
         for (; plan_id < graph.Graph().get_execution_plan_count(); ++plan_id) {
           VLOG(7) << "Trying plan ID " << plan_id;
           if (graph.Build(dnn_support_, plan_id).ok()) {
@@ -704,63 +755,47 @@ class CuDnnFusionVisitor : public DfsHloRewriteVisitor {
         if (plan_id == graph.Graph().get_execution_plan_count()) {
           return absl::InternalError("No cuDNN plans can be built.");
         }
-        CuDnnFusionConfig* cudnn_config =
-            gpu_config.mutable_fusion_backend_config()
-                ->mutable_cudnn_fusion_config();
-        cudnn_config->set_plan_id(plan_id);
-        TF_RETURN_IF_ERROR(hlo->set_backend_config(gpu_config));
       }
-      return graph;
-    };
-
-    auto serialize_graph =
-        [](const se::gpu::CudnnGraph& graph) -> absl::StatusOr<std::string> {
       std::vector<uint8_t> serialized_graph;
       RETURN_IF_CUDNN_FRONTEND_ERROR(graph.Graph().serialize(serialized_graph));
-      return std::string(reinterpret_cast<char*>(serialized_graph.data()),
-                         serialized_graph.size());
+      return CompiledGraph{
+          std::string(reinterpret_cast<char*>(serialized_graph.data()),
+                      serialized_graph.size()),
+          graph.Graph().get_workspace_size(), plan_id};
     };
 
+    // The graph depends on the device, the cuDNN version, the numerics
+    // options and the plan besides the fused computation.
+    const std::string fingerprint =
+        GetComputationFingerprint(hlo->fused_instructions_computation(), {});
+    TF_ASSIGN_OR_RETURN(
+        const CompiledGraph graph,
+        GetOrCompileGraph(
+            absl::StrCat(device_key_, "|",
+                         RequireDeterminism(hlo->GetModule()->config()), "|",
+                         requested_plan_id, "|", fingerprint),
+            compile_graph));
+
+    if (!has_plan_id) {
+      CuDnnFusionConfig* cudnn_config =
+          gpu_config.mutable_fusion_backend_config()
+              ->mutable_cudnn_fusion_config();
+      cudnn_config->set_plan_id(graph.plan_id);
+      TF_RETURN_IF_ERROR(hlo->set_backend_config(gpu_config));
+    }
+
     if (IsWorkspaceAllocationRoot(*hlo->fused_expression_root())) {
       // The graph already has a workspace.
-      const std::string fingerprint =
-          GetComputationFingerprint(hlo->fused_instructions_computation(), {});
-      if (auto it = compilation_results_.find(fingerprint);
-          it == compilation_results_.cend()) {
-        TF_ASSIGN_OR_RETURN(const se::gpu::CudnnGraph graph, compile_graph());
-        TF_ASSIGN_OR_RETURN(const std::string serialized,
-                            serialize_graph(graph));
-        compilation_results_.insert(it, {fingerprint, serialized});
-      }
+      compilation_results_.try_emplace(fingerprint, graph.serialized);
       return absl::OkStatus();
     }
 
-    auto add_workspace = [&](const int64_t workspace_size) {
-      if (workspace_size > 0) {
-        TF_ASSIGN_OR_RETURN(hlo, AddWorkspace(*hlo, workspace_size));
-        SetVisited(*hlo);
-      }
-      return absl::OkStatus();
-    };
-
-    const std::string fingerprint_without_workspace =
-        GetComputationFingerprint(hlo->fused_instructions_computation(), {});
-
-    auto workspace_size_it =
-        workspace_sizes_.find(fingerprint_without_workspace);
-    if (workspace_size_it == workspace_sizes_.cend()) {
-      TF_ASSIGN_OR_RETURN(const se::gpu::CudnnGraph graph, compile_graph());
-      const int64_t workspace_size = graph.Graph().get_workspace_size();
-      workspace_sizes_.insert(workspace_size_it,
-                              {fingerprint_without_workspace, workspace_size});
-      TF_RETURN_IF_ERROR(add_workspace(workspace_size));
-      TF_ASSIGN_OR_RETURN(const std::string serialized, serialize_graph(graph));
-      compilation_results_[GetComputationFingerprint(
-          hlo->fused_instructions_computation(), {})] = serialized;
-    } else {
-      VLOG(4) << "Cache hit.";
-      TF_RETURN_IF_ERROR(add_workspace(workspace_size_it->second));
+    if (graph.workspace_size > 0) {
+      TF_ASSIGN_OR_RETURN(hlo, AddWorkspace(*hlo, graph.workspace_size));
+      SetVisited(*hlo);
     }
+    compilation_results_[GetComputationFingerprint(
+        hlo->fused_instructions_computation(), {})] = graph.serialized;
 
     MarkAsChanged();
     return absl::OkStatus();
@@ -770,16 +805,22 @@ class CuDnnFusionVisitor : public DfsHloRewriteVisitor {
   se::dnn::DnnSupport& dnn_support_;
   // <HLO computation fingerprint, serialized compiled cuDNN graph>.
   BinaryMap& compilation_results_;
-  absl::flat_hash_map<std::string, int64_t> workspace_sizes_;
+  absl::string_view device_key_;
 };
 
 }  // namespace
 
+CuDnnFusionCompiler::CuDnnFusionCompiler(se::StreamExecutor& stream_exec,
+                                         BinaryMap& compilation_results)
+    : dnn_support_(*stream_exec.AsDnn()),
+      compilation_results_(compilation_results),
+      device_key_(DeviceKey(stream_exec)) {}
+
 absl::StatusOr<bool> CuDnnFusionCompiler::Run(
     HloModule* module,
     const absl::flat_hash_set<absl::string_view>& execution_threads) {
   XLA_SCOPED_LOGGING_TIMER("cuDNN fusion compiler");
-  return CuDnnFusionVisitor(dnn_support_, compilation_results_)
+  return CuDnnFusionVisitor(dnn_support_, compilation_results_, device_key_)
       .RunOnModule(module, execution_threads);
 }
 
@@ -16,6 +16,8 @@ limitations under the License.
 #ifndef XLA_SERVICE_GPU_TRANSFORMS_CUDNN_FUSION_COMPILER_H_
 #define XLA_SERVICE_GPU_TRANSFORMS_CUDNN_FUSION_COMPILER_H_
 
+#include <string>
+
 #include "absl/container/flat_hash_set.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
@@ -34,9 +36,7 @@ namespace gpu {
 class CuDnnFusionCompiler : public HloModulePass {
  public:
   explicit CuDnnFusionCompiler(se::StreamExecutor& stream_exec,
-                               BinaryMap& compilation_results)
-      : dnn_support_(*stream_exec.AsDnn()),
-        compilation_results_(compilation_results) {}
+                               BinaryMap& compilation_results);
 
   absl::string_view name() const override { return "cudnn-fusion-compiler"; }
 
@@ -51,6 +51,9 @@ class CuDnnFusionCompiler : public HloModulePass {
  private:
   se::dnn::DnnSupport& dnn_support_;
   BinaryMap& compilation_results_;
+  // Identifies the device and cuDNN version in the process-wide cache of
+  // compiled graphs.
+  const std::string device_key_;
 };
 
 }  // namespace gpu
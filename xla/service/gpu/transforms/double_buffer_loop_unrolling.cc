@@ -42,6 +42,8 @@ limitations under the License.
 #include "xla/hlo/transforms/simplifiers/flatten_call_graph.h"
 #include "xla/hlo/utils/hlo_query.h"
 #include "xla/service/collective_ops_utils.h"
+#include "xla/shape.h"
+#include "xla/shape_util.h"
 #include "xla/status_macros.h"
 #include "xla/util.h"
 #include "xla/xla_data.pb.h"
@@ -553,6 +555,86 @@ absl::StatusOr<bool> AutoUnroll(HloInstruction* while_instr,
   return false;  // IR not changed.
 }
 
+// Loops whose bodies produce less than this many bytes per instruction on
+// average are assumed to be bound by kernel launches and loop control (every
+// iteration reads the loop predicate back to the host) rather than by the
+// work done in the body.
+constexpr int64_t kLaunchBoundBytesPerInstruction = 1 << 20;
+
+// Upper bound on the size of a fully unrolled loop body, to keep compile time
+// and code size in check.
+constexpr int64_t kMaxFullyUnrolledInstructions = 2000;
+
+// Returns true if `instr` does no work on the device by itself.
+bool IsFree(const HloInstruction* instr) {
+  switch (instr->opcode()) {
+    case HloOpcode::kAfterAll:
+    case HloOpcode::kBitcast:
+    case HloOpcode::kConstant:
+    case HloOpcode::kGetTupleElement:
+    case HloOpcode::kParameter:
+    case HloOpcode::kTuple:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Function picks the unrolling strategy for a loop from a cost estimate of
+// its body: launch bound loops that stay small enough are fully unrolled to
+// remove per-iteration overhead, other loops with collectives are double
+// buffered to overlap communication with compute, and the rest are kept.
+absl::StatusOr<bool> CostModelUnroll(HloInstruction* while_instr,
+                                     HloModule* module) {
+  TF_ASSIGN_OR_RETURN(auto config,
+                      while_instr->backend_config<WhileLoopBackendConfig>());
+  const int64_t trip_count = config.known_trip_count().n();
+  HloComputation* while_body = while_instr->while_body();
+
+  int64_t num_instructions = 0;
+  int64_t bytes_produced = 0;
+  bool any_collective_present = false;
+  bool any_control_flow_present = false;
+  for (const HloInstruction* instr : while_body->instructions()) {
+    if (IsFree(instr)) {
+      continue;
+    }
+    ++num_instructions;
+    ShapeUtil::ForEachSubshape(
+        instr->shape(), [&](const Shape& subshape, const ShapeIndex& index) {
+          if (subshape.IsArray()) {
+            bytes_produced += ShapeUtil::ByteSizeOfElements(subshape);
+          }
+        });
+    any_collective_present |=
+        hlo_query::IsCollectiveCommunicationOp(instr->opcode());
+    // The size of called computations is not accounted for, so don't fully
+    // unroll loops with nested control flow.
+    any_control_flow_present |= HloPredicateIsOp<
+        HloOpcode::kWhile, HloOpcode::kConditional, HloOpcode::kCall>(instr);
+  }
+
+  const bool launch_bound =
+      bytes_produced < num_instructions * kLaunchBoundBytesPerInstruction;
+  const int64_t unrolled_instructions =
+      trip_count * while_body->instruction_count();
+  std::string summary = absl::StrCat(
+      while_instr->name(), ": trip count ", trip_count, ", ", num_instructions,
+      " instructions producing ", bytes_produced, " bytes per iteration");
+
+  if (launch_bound && !any_control_flow_present &&
+      unrolled_instructions <= kMaxFullyUnrolledInstructions) {
+    VLOG(1) << "Fully unrolling launch bound loop " << summary;
+    return FullyUnroll(while_instr, module);
+  }
+  if (any_collective_present) {
+    VLOG(1) << "Double buffering loop with collectives " << summary;
+    return DoubleBufferingUnroll(while_instr, module);
+  }
+  VLOG(1) << "Not unrolling loop " << summary;
+  return false;  // IR not changed.
+}
+
 }  // namespace
 
 absl::StatusOr<bool> DoubleBufferLoopUnrolling::Run(
@@ -581,16 +663,20 @@ absl::StatusOr<bool> DoubleBufferLoopUnrolling::Run(
       continue;
     }
 
+    bool unrolled = false;
     if (unroll_strategy_ == UnrollStrategy::kFullUnroll) {
-      TF_ASSIGN_OR_RETURN(changed, FullyUnroll(while_instr, module));
+      TF_ASSIGN_OR_RETURN(unrolled, FullyUnroll(while_instr, module));
     } else if (unroll_strategy_ == UnrollStrategy::kDoubleBuffer) {
-      TF_ASSIGN_OR_RETURN(changed, DoubleBufferingUnroll(while_instr, module));
+      TF_ASSIGN_OR_RETURN(unrolled, DoubleBufferingUnroll(while_instr, module));
     } else if (unroll_strategy_ == UnrollStrategy::kAuto) {
-      TF_ASSIGN_OR_RETURN(changed, AutoUnroll(while_instr, module));
+      TF_ASSIGN_OR_RETURN(unrolled, AutoUnroll(while_instr, module));
+    } else if (unroll_strategy_ == UnrollStrategy::kCostModel) {
+      TF_ASSIGN_OR_RETURN(unrolled, CostModelUnroll(while_instr, module));
     } else {
       LOG(FATAL) << absl::StrCat("Unhandled unrolling strategy: ",
                                  unroll_strategy_);
     }
+    changed |= unrolled;
   }
 
   VLOG(2) << "LoopDoubleBufferTransformer output: " << module->ToString();
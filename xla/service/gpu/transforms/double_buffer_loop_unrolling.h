@@ -43,11 +43,24 @@ namespace gpu {
 //   passes (like `WhileLoopSimplifier`) to simplify/get rid of the while loop
 //   eventually.
 //
+// With `kCostModel` strategy:
+//   This pass picks a strategy per loop from a cost estimate of its body.
+//   Loops whose bodies only produce little data per instruction are bound by
+//   launch and loop control overhead, and are fully unrolled as long as the
+//   unrolled body stays small. Other loops with collectives are double
+//   buffered, and the remaining loops are left alone. The decision for each
+//   loop is logged with VLOG(1).
+//
 // Note that this pass will flatten the call graph if any loop has been
 // unrolled.
 class DoubleBufferLoopUnrolling : public HloModulePass {
  public:
-  enum class UnrollStrategy { kDoubleBuffer, kFullUnroll, kAuto };
+  enum class UnrollStrategy {
+    kDoubleBuffer,
+    kFullUnroll,
+    kAuto,
+    kCostModel
+  };
 
   explicit DoubleBufferLoopUnrolling(
       UnrollStrategy unroll_strategy = UnrollStrategy::kDoubleBuffer)
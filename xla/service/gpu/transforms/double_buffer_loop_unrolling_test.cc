@@ -1488,6 +1488,141 @@ TEST_F(GpuLoopDoubleBufferTransformerTest, UpdateInitStepEvenTripCount) {
   EXPECT_EQ(config.known_init_step().step(), 4);
 }
 
+TEST_F(GpuLoopDoubleBufferTransformerTest,
+       CostModelFullyUnrollsLaunchBoundLoop) {
+  absl::string_view kModuleString = R"(
+HloModule m
+condition {
+  input_tuple = (f32[16], s32[]) parameter(0)
+  cond = s32[] get-tuple-element(input_tuple), index=1
+  trip_count = s32[] constant(10)
+  ROOT done = pred[] compare(cond, trip_count), direction=LT
+}
+
+body {
+  input_tuple = (f32[16], s32[]) parameter(0)
+  param_0 = f32[16] get-tuple-element(input_tuple), index=0
+  cond = s32[] get-tuple-element(input_tuple), index=1
+  exp = f32[16] exponential(param_0)
+  one = s32[] constant(1)
+  cond_plus_1 = s32[] add(cond, one)
+  ROOT output_tuple = (f32[16], s32[]) tuple(exp, cond_plus_1)
+}
+
+ENTRY main {
+  param_0 = f32[16] parameter(0)
+  param_1 = s32[] constant(0)
+  tuple = (f32[16], s32[]) tuple(param_0, param_1)
+  ROOT while = (f32[16], s32[]) while(tuple), condition=condition, body=body,
+      backend_config={"known_trip_count":{"n":"10"}}
+})";
+
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<xla::HloModule> module,
+                          ParseAndReturnVerifiedModule(kModuleString));
+  DoubleBufferLoopUnrolling unroller(
+      DoubleBufferLoopUnrolling::UnrollStrategy::kCostModel);
+  EXPECT_THAT(unroller.Run(module.get()), IsOkAndHolds(true));
+
+  HloInstruction* while_instruction = hlo_query::GetFirstInstructionWithOpcode(
+      *module->entry_computation(), HloOpcode::kWhile);
+  TF_ASSERT_OK_AND_ASSIGN(
+      WhileLoopBackendConfig config,
+      while_instruction->backend_config<WhileLoopBackendConfig>());
+  EXPECT_EQ(config.known_trip_count().n(), 1);
+  EXPECT_EQ(CountInstructions(*while_instruction->while_body(),
+                              HloOpcode::kExp),
+            10);
+}
+
+TEST_F(GpuLoopDoubleBufferTransformerTest,
+       CostModelDoubleBuffersLargeLoopWithCollectives) {
+  absl::string_view kModuleString = R"(
+HloModule m
+condition {
+  input_tuple = (f32[1024,1024], s32[]) parameter(0)
+  cond = s32[] get-tuple-element(input_tuple), index=1
+  trip_count = s32[] constant(10)
+  ROOT done = pred[] compare(cond, trip_count), direction=LT
+}
+
+ar_add {
+  Arg_1 = f32[] parameter(1)
+  Arg_0 = f32[] parameter(0)
+  ROOT add_ar = f32[] add(Arg_1, Arg_0)
+}
+
+body {
+  input_tuple = (f32[1024,1024], s32[]) parameter(0)
+  param_0 = f32[1024,1024] get-tuple-element(input_tuple), index=0
+  cond = s32[] get-tuple-element(input_tuple), index=1
+  all-reduce-start = f32[1024,1024] all-reduce-start(param_0), channel_id=8, replica_groups={{0}}, to_apply=ar_add, backend_config={"collective_backend_config": {"is_sync": false}}
+  one = s32[] constant(1)
+  all-reduce-done = f32[1024,1024] all-reduce-done(all-reduce-start)
+  cond_plus_1 = s32[] add(cond, one)
+  ROOT output_tuple = (f32[1024,1024], s32[]) tuple(all-reduce-done, cond_plus_1)
+}
+
+ENTRY main {
+  param_0 = f32[1024,1024] parameter(0)
+  param_1 = s32[] constant(0)
+  tuple = (f32[1024,1024], s32[]) tuple(param_0, param_1)
+  ROOT while = (f32[1024,1024], s32[]) while(tuple), condition=condition,
+      body=body, backend_config={"known_trip_count":{"n":"10"}}
+})";
+
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<xla::HloModule> module,
+                          ParseAndReturnVerifiedModule(kModuleString));
+  DoubleBufferLoopUnrolling unroller(
+      DoubleBufferLoopUnrolling::UnrollStrategy::kCostModel);
+  EXPECT_THAT(unroller.Run(module.get()), IsOkAndHolds(true));
+
+  HloInstruction* while_instruction = hlo_query::GetFirstInstructionWithOpcode(
+      *module->entry_computation(), HloOpcode::kWhile);
+  TF_ASSERT_OK_AND_ASSIGN(
+      WhileLoopBackendConfig config,
+      while_instruction->backend_config<WhileLoopBackendConfig>());
+  EXPECT_EQ(config.known_trip_count().n(), 5);
+  EXPECT_EQ(CountInstructions(*while_instruction->while_body(),
+                              HloOpcode::kAllReduceStart),
+            2);
+}
+
+TEST_F(GpuLoopDoubleBufferTransformerTest,
+       CostModelKeepsLargeLoopWithoutCollectives) {
+  absl::string_view kModuleString = R"(
+HloModule m
+condition {
+  input_tuple = (f32[1024,1024], s32[]) parameter(0)
+  cond = s32[] get-tuple-element(input_tuple), index=1
+  trip_count = s32[] constant(10)
+  ROOT done = pred[] compare(cond, trip_count), direction=LT
+}
+
+body {
+  input_tuple = (f32[1024,1024], s32[]) parameter(0)
+  param_0 = f32[1024,1024] get-tuple-element(input_tuple), index=0
+  cond = s32[] get-tuple-element(input_tuple), index=1
+  exp = f32[1024,1024] exponential(param_0)
+  one = s32[] constant(1)
+  cond_plus_1 = s32[] add(cond, one)
+  ROOT output_tuple = (f32[1024,1024], s32[]) tuple(exp, cond_plus_1)
+}
+
+ENTRY main {
+  param_0 = f32[1024,1024] parameter(0)
+  param_1 = s32[] constant(0)
+  tuple = (f32[1024,1024], s32[]) tuple(param_0, param_1)
+  ROOT while = (f32[1024,1024], s32[]) while(tuple), condition=condition,
+      body=body, backend_config={"known_trip_count":{"n":"10"}}
+})";
+
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<xla::HloModule> module,
+                          ParseAndReturnVerifiedModule(kModuleString));
+  DoubleBufferLoopUnrolling unroller(
+      DoubleBufferLoopUnrolling::UnrollStrategy::kCostModel);
+  EXPECT_THAT(unroller.Run(module.get()), IsOkAndHolds(false));
+}
+
 }  // namespace
 }  // namespace gpu
 }  // namespace xla
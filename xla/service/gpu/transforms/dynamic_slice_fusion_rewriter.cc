@@ -333,8 +333,11 @@ UseDefDataflowPaths GetSlicedOperandPaths(const HloInstruction* instr,
 // vector.
 // Each entry contains the sliced paths for that user, i.e. the sequence of ops
 // following the dataflow from the user itself to the DUS (included).
+// If `allow_runtime_offsets` is false, only DUSes with constant or loop
+// iteration offsets are matched.
 DefUseDataflowPaths GetSlicedUserPaths(const HloInstruction* instr,
-                                       CallGraph* call_graph) {
+                                       CallGraph* call_graph,
+                                       bool allow_runtime_offsets) {
   DefUseDataflowPaths sliced_user_paths;
   // This set is used to avoid duplicates in the matched results. It contains
   // the matched instructions that we have seen so far.
@@ -365,7 +368,9 @@ DefUseDataflowPaths GetSlicedUserPaths(const HloInstruction* instr,
         DynCast<HloDynamicIndexInstruction>(maybe_dus_instr.value());
     bool valid_dus_found =
         dus_found && dynamic_index_operation &&
-        HasConstantOrLoopIterationOffsets(*dynamic_index_operation, call_graph);
+        (allow_runtime_offsets ||
+         HasConstantOrLoopIterationOffsets(*dynamic_index_operation,
+                                           call_graph));
     if (valid_dus_found || processed_instrs.contains(maybe_dus_instr.value())) {
       // Even in the case of stopping at a match that has been processed, we
       // still need to add instructions encountered in the sliced user path
@@ -545,7 +550,8 @@ absl::StatusOr<bool> DynamicSliceFusionRewriter::Run(
             GetSlicedOperandPaths(instr, call_graph.get());
         bool has_sliced_operand_paths = sliced_operand_paths.size() > 1;
         DefUseDataflowPaths sliced_user_paths =
-            GetSlicedUserPaths(instr, call_graph.get());
+            GetSlicedUserPaths(instr, call_graph.get(),
+                               allow_runtime_update_offsets_);
         bool has_sliced_user_paths = absl::c_any_of(
             sliced_user_paths,
             [&](auto& sliced_user_path) { return !sliced_user_path.empty(); });
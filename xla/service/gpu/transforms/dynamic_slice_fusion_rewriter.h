@@ -73,8 +73,15 @@ class DynamicSliceFusionRewriter : public HloModulePass {
     return "dynamic-slice-fusion-rewriter";
   }
 
-  explicit DynamicSliceFusionRewriter(std::string platform_name)
-      : platform_name_(std::move(platform_name)) {}
+  // If `allow_runtime_update_offsets` is true, results are also written
+  // directly into dynamic-update-slices whose offsets are neither constants
+  // nor functions of a loop induction variable. Such offsets are copied to
+  // the host at run time, which is cheaper than a separate update kernel but
+  // prevents capturing the fusion in a command buffer.
+  explicit DynamicSliceFusionRewriter(std::string platform_name,
+                                      bool allow_runtime_update_offsets = false)
+      : platform_name_(std::move(platform_name)),
+        allow_runtime_update_offsets_(allow_runtime_update_offsets) {}
 
   using HloPassInterface::Run;
   absl::StatusOr<bool> Run(
@@ -83,6 +90,7 @@ class DynamicSliceFusionRewriter : public HloModulePass {
 
  private:
   std::string platform_name_;
+  bool allow_runtime_update_offsets_;
 };
 
 }  // namespace gpu
@@ -43,6 +43,7 @@ limitations under the License.
 #include "xla/stream_executor/device_description.h"
 #include "tsl/platform/errors.h"
 #include "tsl/platform/statusor.h"
+#include "tsl/platform/threadpool.h"
 
 namespace xla {
 namespace gpu {
@@ -54,7 +55,8 @@ using ::mlir::MLIRContext;
 absl::StatusOr<bool> ProcessFusionInstruction(
     HloFusionInstruction* fusion_instruction,
     const se::DeviceDescription& device_info,
-    HloCostAnalysis::ShapeSizeFunction shape_size, MLIRContext* ctx) {
+    HloCostAnalysis::ShapeSizeFunction shape_size, MLIRContext* ctx,
+    tsl::thread::ThreadPool* thread_pool) {
   const HloComputation* fusion_computation =
       fusion_instruction->fused_instructions_computation();
   if (CodegenDecision can_codegen = IsTritonSupportedComputation(
@@ -77,7 +79,7 @@ absl::StatusOr<bool> ProcessFusionInstruction(
 
   HloFusionAnalysisCache fusion_analysis_cache(device_info);
   GpuPerformanceModelWithIndexingAnalysis indexing_performance_model(
-      &device_info, &fusion_analysis_cache, shape_size, ctx);
+      &device_info, &fusion_analysis_cache, shape_size, ctx, thread_pool);
 
   auto fusion_adaptor = HloFusionAdaptor::ForInstruction(
       Cast<HloFusionInstruction>(fusion_instruction));
@@ -145,8 +147,9 @@ absl::StatusOr<bool> FusionBlockLevelRewriter::Run(
     }
 
     TF_ASSIGN_OR_RETURN(
-        bool changed, ProcessFusionInstruction(fusion_instruction, device_info_,
-                                               shape_size_, &ctx));
+        bool changed,
+        ProcessFusionInstruction(fusion_instruction, device_info_, shape_size_,
+                                 &ctx, thread_pool_));
 
     has_changed |= changed;
   }
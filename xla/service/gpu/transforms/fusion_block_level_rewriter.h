@@ -27,6 +27,7 @@ limitations under the License.
 #include "xla/hlo/pass/hlo_pass_interface.h"
 #include "xla/service/hlo_cost_analysis.h"
 #include "xla/stream_executor/device_description.h"
+#include "tsl/platform/threadpool.h"
 
 namespace xla {
 namespace gpu {
@@ -37,10 +38,12 @@ class FusionBlockLevelRewriter : public HloModulePass {
       const se::DeviceDescription& device_info,
       HloCostAnalysis::ShapeSizeFunction shape_size,
       absl::AnyInvocable<absl::StatusOr<bool>(const HloFusionInstruction*)>
-          should_try_rewrite_if)
+          should_try_rewrite_if,
+      tsl::thread::ThreadPool* thread_pool = nullptr)
       : device_info_(device_info),
         shape_size_(shape_size),
-        should_try_rewrite_if_(std::move(should_try_rewrite_if)) {}
+        should_try_rewrite_if_(std::move(should_try_rewrite_if)),
+        thread_pool_(thread_pool) {}
 
   absl::string_view name() const override {
     return "fusion-block-level-rewriter";
@@ -56,6 +59,8 @@ class FusionBlockLevelRewriter : public HloModulePass {
   HloCostAnalysis::ShapeSizeFunction shape_size_;
   absl::AnyInvocable<absl::StatusOr<bool>(const HloFusionInstruction*)>
       should_try_rewrite_if_;
+  // If not null, the tilings of each fusion are evaluated in parallel on it.
+  tsl::thread::ThreadPool* thread_pool_;
 };
 
 }  // namespace gpu
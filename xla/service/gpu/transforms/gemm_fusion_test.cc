@@ -317,6 +317,54 @@ ENTRY e {
                             m::Parameter(), m::Parameter()))));
 }
 
+TEST_F(GemmFusionTest, PagedGatherOfNonContractingDimIsFused) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<VerifiedHloModule> module,
+                          ParseAndReturnVerifiedModule(R"(
+ENTRY e {
+  q = f16[64,128] parameter(0)
+  cache = f16[32,16,128] parameter(1)
+  block_table = s32[8] parameter(2)
+  gather = f16[8,16,128] gather(cache, block_table),
+    offset_dims={1,2}, collapsed_slice_dims={0}, start_index_map={0},
+    index_vector_dim=1, slice_sizes={1,16,128}
+  k = f16[128,128] reshape(gather)
+  ROOT d = f16[64,128] dot(q, k),
+    lhs_contracting_dims={1}, rhs_contracting_dims={1}
+})"));
+
+  EXPECT_TRUE(GemmFusion(se::CudaComputeCapability{
+                             se::CudaComputeCapability::kAmpere, 0})
+                  .Run(module.get())
+                  .value());
+  EXPECT_THAT(module->entry_computation()->root_instruction(),
+              GmockMatch((m::Fusion(m::Parameter(), m::Parameter(),
+                                    m::Parameter()))));
+}
+
+TEST_F(GemmFusionTest, DoNotFusePagedGatherOfContractingDim) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<VerifiedHloModule> module,
+                          ParseAndReturnVerifiedModule(R"(
+ENTRY e {
+  p = f16[64,128] parameter(0)
+  cache = f16[32,16,128] parameter(1)
+  block_table = s32[8] parameter(2)
+  gather = f16[8,16,128] gather(cache, block_table),
+    offset_dims={1,2}, collapsed_slice_dims={0}, start_index_map={0},
+    index_vector_dim=1, slice_sizes={1,16,128}
+  v = f16[128,128] reshape(gather)
+  ROOT d = f16[64,128] dot(p, v),
+    lhs_contracting_dims={1}, rhs_contracting_dims={0}
+})"));
+
+  EXPECT_TRUE(GemmFusion(se::CudaComputeCapability{
+                             se::CudaComputeCapability::kAmpere, 0})
+                  .Run(module.get())
+                  .value());
+  // FusionDecision "Gather outside of the non-contracting dimension."
+  EXPECT_THAT(module->entry_computation()->root_instruction(),
+              GmockMatch((m::Fusion(m::Parameter(), m::Gather()))));
+}
+
 TEST_F(GemmFusionTest, DoNotFuseDynamicSliceOfNonMajorFragments) {
   TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<VerifiedHloModule> module,
                           ParseAndReturnVerifiedModule(R"(
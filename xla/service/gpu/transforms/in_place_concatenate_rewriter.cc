@@ -0,0 +1,149 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "xla/service/gpu/transforms/in_place_concatenate_rewriter.h"
+
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include "absl/algorithm/container.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/log/log.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_casting_utils.h"
+#include "xla/hlo/ir/hlo_computation.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_instructions.h"
+#include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/layout_util.h"
+#include "xla/literal_util.h"
+#include "xla/service/collective_ops_utils.h"
+#include "xla/service/gpu/cublas_cudnn.h"
+#include "xla/service/gpu/gpu_constants.h"
+#include "xla/shape.h"
+#include "xla/shape_util.h"
+#include "xla/tsl/platform/errors.h"
+
+namespace xla {
+namespace gpu {
+namespace {
+
+// Returns true if `operand` is the result of a gemm that has no other users,
+// and the gemm does not update one of its operands in place.
+bool IsUniquelyUsedGemmResult(const HloInstruction* operand) {
+  if (operand->user_count() != 1) {
+    return false;
+  }
+  const HloInstruction* gemm = operand;
+  if (operand->opcode() == HloOpcode::kGetTupleElement &&
+      operand->tuple_index() == 0) {
+    gemm = operand->operand(0);
+  }
+  return IsLegacyCublasMatmul(*gemm) &&
+         gemm->shape().IsTuple() == (gemm != operand) &&
+         Cast<HloCustomCallInstruction>(gemm)
+             ->output_to_operand_aliasing()
+             .empty();
+}
+
+// Returns true if the gemm results can be written into the concatenation in
+// place: every slice has to be contiguous and start at an address aligned as
+// DynamicSliceFusionRewriter requires.
+bool CanConcatenateInPlace(const HloInstruction* concat) {
+  const Shape& shape = concat->shape();
+  const int64_t concat_dim = concat->concatenate_dimension();
+  if (!shape.has_layout() || concat->operand_count() < 2) {
+    return false;
+  }
+  // All dimensions more major than the concatenated one must be degenerate
+  // for the slices to be contiguous.
+  const auto& minor_to_major = shape.layout().minor_to_major();
+  auto concat_it = absl::c_find(minor_to_major, concat_dim);
+  for (auto it = concat_it + 1; it != minor_to_major.end(); ++it) {
+    if (shape.dimensions(*it) != 1) {
+      return false;
+    }
+  }
+  std::optional<std::vector<int64_t>> strides =
+      ShapeUtil::ByteStrides(shape);
+  if (!strides.has_value() ||
+      (*strides)[concat_dim] % kXlaAllocatedBufferAlignBytes != 0) {
+    return false;
+  }
+  return absl::c_all_of(concat->operands(), [&](const HloInstruction* op) {
+    return LayoutUtil::Equal(op->shape().layout(), shape.layout()) &&
+           absl::c_count(concat->operands(), op) == 1 &&
+           IsUniquelyUsedGemmResult(op);
+  });
+}
+
+absl::Status RewriteConcatenate(HloInstruction* concat) {
+  HloComputation* computation = concat->parent();
+  const Shape& shape = concat->shape();
+  const int64_t concat_dim = concat->concatenate_dimension();
+
+  HloInstruction* buffer =
+      computation->AddInstruction(HloInstruction::CreateCustomCall(
+          shape, /*operands=*/{}, kNopCustomCallTarget));
+  HloInstruction* zero = computation->AddInstruction(
+      HloInstruction::CreateConstant(LiteralUtil::CreateR0<int32_t>(0)));
+  int64_t offset = 0;
+  for (HloInstruction* operand : concat->operands()) {
+    std::vector<HloInstruction*> start_indices(shape.dimensions().size(),
+                                               zero);
+    if (offset != 0) {
+      start_indices[concat_dim] =
+          computation->AddInstruction(HloInstruction::CreateConstant(
+              LiteralUtil::CreateR0<int32_t>(offset)));
+    }
+    buffer = computation->AddInstruction(
+        HloInstruction::CreateDynamicUpdateSlice(shape, buffer, operand,
+                                                 start_indices));
+    offset += operand->shape().dimensions(concat_dim);
+  }
+  return computation->ReplaceInstruction(concat, buffer);
+}
+
+}  // namespace
+
+absl::StatusOr<bool> InPlaceConcatenateRewriter::Run(
+    HloModule* module,
+    const absl::flat_hash_set<absl::string_view>& execution_threads) {
+  bool changed = false;
+  for (HloComputation* computation :
+       module->MakeNonfusionComputations(execution_threads)) {
+    std::vector<HloInstruction*> concats;
+    for (HloInstruction* instr : computation->instructions()) {
+      if (instr->opcode() == HloOpcode::kConcatenate &&
+          instr->shape().dimensions(instr->concatenate_dimension()) <=
+              std::numeric_limits<int32_t>::max() &&
+          CanConcatenateInPlace(instr)) {
+        concats.push_back(instr);
+      }
+    }
+    for (HloInstruction* concat : concats) {
+      VLOG(2) << "Concatenating gemm results in place: " << concat->ToString();
+      TF_RETURN_IF_ERROR(RewriteConcatenate(concat));
+      changed = true;
+    }
+  }
+  return changed;
+}
+
+}  // namespace gpu
+}  // namespace xla
@@ -0,0 +1,71 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef XLA_SERVICE_GPU_TRANSFORMS_IN_PLACE_CONCATENATE_REWRITER_H_
+#define XLA_SERVICE_GPU_TRANSFORMS_IN_PLACE_CONCATENATE_REWRITER_H_
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/pass/hlo_pass_interface.h"
+
+namespace xla {
+namespace gpu {
+
+// Rewrites concatenations of cuBLAS gemm results into chains of
+// dynamic-update-slices into an uninitialized buffer, so that
+// DynamicSliceFusionRewriter lets every gemm write its result directly into
+// its slice of the concatenation instead of copying it there afterwards.
+//
+// Example:
+//
+//  ENTRY %main {
+//    %gemm0 = f16[8,64]{1,0} custom-call(%a, %b),
+//      custom_call_target="__cublas$gemm"
+//    %gemm1 = f16[8,64]{1,0} custom-call(%c, %d),
+//      custom_call_target="__cublas$gemm"
+//    ROOT %concat = f16[16,64]{1,0} concatenate(%gemm0, %gemm1),
+//      dimensions={0}
+//  }
+//
+// After the pass:
+//
+//  ENTRY %main {
+//    ...
+//    %buffer = f16[16,64]{1,0} custom-call(),
+//      custom_call_target="AllocateBuffer"
+//    %dus0 = f16[16,64]{1,0} dynamic-update-slice(%buffer, %gemm0, 0, 0)
+//    ROOT %dus1 = f16[16,64]{1,0} dynamic-update-slice(%dus0, %gemm1, 8, 0)
+//  }
+//
+// Only concatenations where every operand is the only use of a gemm result,
+// and every slice is contiguous and aligned as DynamicSliceFusionRewriter
+// requires, are rewritten, so no copy is left behind.
+class InPlaceConcatenateRewriter : public HloModulePass {
+ public:
+  absl::string_view name() const override {
+    return "in-place-concatenate-rewriter";
+  }
+
+  using HloPassInterface::Run;
+  absl::StatusOr<bool> Run(
+      HloModule* module,
+      const absl::flat_hash_set<absl::string_view>& execution_threads) override;
+};
+
+}  // namespace gpu
+}  // namespace xla
+
+#endif  // XLA_SERVICE_GPU_TRANSFORMS_IN_PLACE_CONCATENATE_REWRITER_H_
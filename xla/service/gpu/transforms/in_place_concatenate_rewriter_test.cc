@@ -0,0 +1,107 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/service/gpu/transforms/in_place_concatenate_rewriter.h"
+
+#include <optional>
+#include <string>
+
+#include <gtest/gtest.h>
+#include "absl/strings/str_replace.h"
+#include "absl/strings/string_view.h"
+#include "xla/hlo/testlib/hlo_hardware_independent_test_base.h"
+
+namespace xla::gpu {
+namespace {
+
+class InPlaceConcatenateRewriterTest : public HloHardwareIndependentTestBase {
+ protected:
+  // Returns a module concatenating the results of two f16[8,64] gemms along
+  // `dim` into `concat_shape`.
+  static std::string GemmConcatenate(absl::string_view concat_shape,
+                                     absl::string_view dim) {
+    return absl::StrReplaceAll(R"(
+      HloModule test
+
+      ENTRY %main {
+        %p0 = f16[8,8]{1,0} parameter(0)
+        %p1 = f16[8,64]{1,0} parameter(1)
+        %p2 = f16[8,64]{1,0} parameter(2)
+        %gemm0 = (f16[8,64]{1,0}, s8[256]{0}) custom-call(%p0, %p1),
+          custom_call_target="__cublas$gemm",
+          backend_config={"gemm_backend_config":{
+            "alpha_real":1, "beta":0, "alpha_imag":0,
+            "dot_dimension_numbers":{
+              "lhs_contracting_dimensions":["1"],
+              "rhs_contracting_dimensions":["0"],
+              "lhs_batch_dimensions":[], "rhs_batch_dimensions":[]},
+            "precision_config":{"operand_precision":["DEFAULT","DEFAULT"]},
+            "epilogue":"DEFAULT"}}
+        %gte0 = f16[8,64]{1,0} get-tuple-element(%gemm0), index=0
+        %gemm1 = f16[8,64]{1,0} custom-call(%p0, %p2),
+          custom_call_target="__cublas$gemm",
+          backend_config={"gemm_backend_config":{
+            "alpha_real":1, "beta":0, "alpha_imag":0,
+            "dot_dimension_numbers":{
+              "lhs_contracting_dimensions":["1"],
+              "rhs_contracting_dimensions":["0"],
+              "lhs_batch_dimensions":[], "rhs_batch_dimensions":[]},
+            "precision_config":{"operand_precision":["DEFAULT","DEFAULT"]},
+            "epilogue":"DEFAULT"}}
+        ROOT %concat = $concat_shape concatenate(%gte0, %gemm1),
+          dimensions={$dim}
+      }
+    )",
+                               {{"$concat_shape", concat_shape},
+                                {"$dim", dim}});
+  }
+};
+
+TEST_F(InPlaceConcatenateRewriterTest, ConcatenatesGemmResultsInPlace) {
+  RunAndFilecheckHloRewrite(GemmConcatenate("f16[16,64]{1,0}", "0"),
+                            InPlaceConcatenateRewriter(), R"(
+    ; CHECK:     %[[GEMM0:.+]] = {{.*}} custom-call({{.*}}), custom_call_target="__cublas$gemm"
+    ; CHECK:     %[[GTE0:.+]] = f16[8,64]{1,0} get-tuple-element(%[[GEMM0]]), index=0
+    ; CHECK:     %[[GEMM1:.+]] = f16[8,64]{1,0} custom-call({{.*}}), custom_call_target="__cublas$gemm"
+    ; CHECK-DAG: %[[BUFFER:.+]] = f16[16,64]{1,0} custom-call(), custom_call_target="AllocateBuffer"
+    ; CHECK-DAG: %[[ZERO:.+]] = s32[] constant(0)
+    ; CHECK-DAG: %[[EIGHT:.+]] = s32[] constant(8)
+    ; CHECK:     %[[DUS0:.+]] = f16[16,64]{1,0} dynamic-update-slice(%[[BUFFER]], %[[GTE0]], %[[ZERO]], %[[ZERO]])
+    ; CHECK:     ROOT {{.*}} = f16[16,64]{1,0} dynamic-update-slice(%[[DUS0]], %[[GEMM1]], %[[EIGHT]], %[[ZERO]])
+  )");
+}
+
+TEST_F(InPlaceConcatenateRewriterTest, DoesNotRewriteNonContiguousSlices) {
+  RunAndFilecheckHloRewrite(GemmConcatenate("f16[8,128]{1,0}", "1"),
+                            InPlaceConcatenateRewriter(),
+                            /*expected=*/std::nullopt);
+}
+
+TEST_F(InPlaceConcatenateRewriterTest, DoesNotRewriteNonGemmOperands) {
+  const char* hlo = R"(
+    HloModule test
+
+    ENTRY %main {
+      %p0 = f16[8,64]{1,0} parameter(0)
+      %p1 = f16[8,64]{1,0} parameter(1)
+      ROOT %concat = f16[16,64]{1,0} concatenate(%p0, %p1), dimensions={0}
+    }
+  )";
+  RunAndFilecheckHloRewrite(hlo, InPlaceConcatenateRewriter(),
+                            /*expected=*/std::nullopt);
+}
+
+}  // namespace
+}  // namespace xla::gpu
@@ -302,6 +302,41 @@ void SetFortranLayout(Shape* shape) {
             shape->mutable_layout()->mutable_minor_to_major()->at(1));
 }
 
+// Returns the most minor dimension of `shape` with a size other than one, or
+// -1 if there is none.
+int64_t MinorNonDegenerateDim(const Shape& shape) {
+  for (int64_t dim : shape.layout().minor_to_major()) {
+    if (shape.dimensions(dim) != 1) return dim;
+  }
+  return -1;
+}
+
+// Estimates the cost of the copy that converts an array from the layout of
+// `from` to the layout of `to`: nothing if the copy is a bitcast, the size of
+// the array if it keeps the minor dimension and can be done with coalesced
+// reads and writes, and twice that for a transpose.
+int64_t LayoutChangeCost(const Shape& from, const Shape& to) {
+  if (ShapeUtil::ReshapeIsBitcast(from, to)) {
+    return 0;
+  }
+  const int64_t bytes = ShapeUtil::ByteSizeOfElements(from);
+  return MinorNonDegenerateDim(from) == MinorNonDegenerateDim(to) ? bytes
+                                                                  : 2 * bytes;
+}
+
+// dim_groups are ordered from major to minor dimensions.
+Layout MakeMajorToMinorLayout(
+    std::initializer_list<absl::Span<const int64_t>> dim_groups) {
+  size_t size = 0;
+  for (auto group : dim_groups) size += group.size();
+  std::vector<int64_t> major_to_minor;
+  major_to_minor.reserve(size);
+  for (const auto& group : dim_groups) {
+    major_to_minor.insert(major_to_minor.end(), group.begin(), group.end());
+  }
+  return LayoutUtil::MakeLayoutFromMajorToMinor(major_to_minor);
+}
+
 bool DotCanSupportShapeWithLayout(const HloInstruction* dot,
                                   const Shape& shape) {
   const DotDimensionNumbers& dot_dims = dot->dot_dimension_numbers();
@@ -648,12 +683,30 @@ absl::Status GpuLayoutAssignment::SetDotOperandLayout(
   }
 
   // Next, try the default layout (for the sake of everybody's sanity).
+  const Shape producer_shape =
+      shape.has_layout() ? shape : LayoutUtil::GetWithDefaultLayout(shape);
   LayoutUtil::SetToDefaultLayout(&shape);
   if (MatrixLayout::For(shape, batch_dims, row_dims, col_dims).ok()) {
     return SetOperandLayout(shape, instruction, operand, mandatory);
   }
 
-  // Otherwise, fallback to forcing (batch, rows, cols) layout.
+  // Otherwise, force either a (batch, rows, cols) or a (batch, cols, rows)
+  // layout, whichever is cheaper to convert the producer's layout to.
+  // Keeping the minor dimension turns the copy that layout assignment
+  // inserts into a coalesced copy instead of a transpose.
+  Shape rows_major = shape;
+  *rows_major.mutable_layout() =
+      MakeMajorToMinorLayout({batch_dims, row_dims, col_dims});
+  Shape cols_major = shape;
+  *cols_major.mutable_layout() =
+      MakeMajorToMinorLayout({batch_dims, col_dims, row_dims});
+  if (MatrixLayout::For(cols_major, batch_dims, row_dims, col_dims).ok() &&
+      LayoutChangeCost(producer_shape, cols_major) <
+          LayoutChangeCost(producer_shape, rows_major)) {
+    return SetOperandMajorToMinorLayout(
+        instruction, operand,
+        /*dim_groups=*/{batch_dims, col_dims, row_dims}, mandatory);
+  }
   return SetOperandMajorToMinorLayout(
       instruction, operand,
       /*dim_groups=*/{batch_dims, row_dims, col_dims}, mandatory);
@@ -699,17 +752,8 @@ absl::Status GpuLayoutAssignment::SetOperandMajorToMinorLayout(
     const HloInstruction* instruction, int64_t operand,
     std::initializer_list<absl::Span<const int64_t>> dim_groups,
     bool mandatory) {
-  size_t size = 0;
-  for (auto group : dim_groups) size += group.size();
-  std::vector<int64_t> major_to_minor;
-  major_to_minor.reserve(size);
-  for (const auto& group : dim_groups) {
-    major_to_minor.insert(major_to_minor.end(), group.begin(), group.end());
-  }
-
   Shape shape = instruction->operand(operand)->shape();
-  *shape.mutable_layout() =
-      LayoutUtil::MakeLayoutFromMajorToMinor(major_to_minor);
+  *shape.mutable_layout() = MakeMajorToMinorLayout(dim_groups);
   return SetOperandLayout(shape, instruction, operand, mandatory,
                           /*dfs=*/mandatory);
 }
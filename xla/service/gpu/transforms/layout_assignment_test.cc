@@ -235,6 +235,34 @@ TEST_F(LayoutAssignmentTest, DotOperandInconsistentDimLayouts) {
                         m::Op().WithShape(F32, {6, 5, 3, 4}, {3, 2, 0, 1}))));
 }
 
+TEST_F(LayoutAssignmentTest, DotOperandLayoutKeepsMinorDimIfPossible) {
+  const char* hlo_text = R"(
+  HloModule DotLayout
+  ENTRY dot {
+    p0 = f32[3,4,5]{2,1,0} parameter(0)
+    p1 = f32[3,6,5]{2,1,0} parameter(1)
+    ROOT dot = f32[4,6] dot(p0, p1),
+      lhs_contracting_dims={0,2}, rhs_contracting_dims={0,2}
+  })";
+
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(hlo_text));
+
+  ComputationLayout computation_layout(
+      module->entry_computation()->ComputeProgramShape(),
+      /*ignore_layouts=*/false);
+  GpuLayoutAssignment layout_assignment(
+      &computation_layout, GetGpuComputeCapability(), GetDnnVersion(),
+      GetDeviceDescription());
+
+  EXPECT_THAT(layout_assignment.Run(module.get()), IsOkAndHolds(true));
+  // Making the non-contracting dimension major keeps dimension 2 minor, so the
+  // operands only need a coalesced copy instead of a transpose.
+  EXPECT_THAT(module->entry_computation()->root_instruction(),
+              GmockMatch(m::Dot(m::Op().WithShape(F32, {3, 4, 5}, {2, 0, 1}),
+                                m::Op().WithShape(F32, {3, 6, 5}, {2, 0, 1}))));
+}
+
 TEST_F(LayoutAssignmentTest, TransposedDotLayout) {
   const char* hlo_text = R"(
   HloModule DotLayout
@@ -0,0 +1,255 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/service/gpu/transforms/normalization_fusion_rewriter.h"
+
+#include <cstdint>
+#include <queue>
+#include <string>
+#include <vector>
+
+#include "absl/algorithm/container.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/log/log.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "xla/hlo/ir/hlo_computation.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/layout_util.h"
+#include "xla/service/gpu/backend_configs.pb.h"
+#include "xla/service/gpu/ir_emission_utils.h"
+#include "xla/shape.h"
+#include "xla/shape_util.h"
+#include "xla/tsl/platform/errors.h"
+#include "xla/tsl/platform/statusor.h"
+
+namespace xla {
+namespace gpu {
+namespace {
+
+bool HasDefaultLayout(const Shape& shape) {
+  return shape.IsArray() &&
+         (!shape.has_layout() ||
+          LayoutUtil::IsMonotonicWithDim0Major(shape.layout()));
+}
+
+// Returns whether `instr` can be computed by a normalization fusion of rows
+// with the shape `dims`.
+bool IsFusible(const HloInstruction* instr, absl::Span<const int64_t> dims) {
+  const Shape& shape = instr->shape();
+  if (!HasDefaultLayout(shape)) {
+    return false;
+  }
+  absl::Span<const int64_t> row_dims = dims.first(dims.size() - 1);
+  bool has_element_shape = shape.dimensions() == dims;
+  bool has_row_shape = shape.dimensions() == row_dims;
+
+  switch (instr->opcode()) {
+    case HloOpcode::kConstant:
+      return ShapeUtil::IsScalar(shape);
+    case HloOpcode::kBroadcast: {
+      const Shape& operand_shape = instr->operand(0)->shape();
+      if (ShapeUtil::IsScalar(operand_shape)) {
+        return has_element_shape || has_row_shape;
+      }
+      if (!has_element_shape || !HasDefaultLayout(operand_shape)) {
+        return false;
+      }
+      // Broadcast of the rows, e.g. of the mean.
+      std::vector<int64_t> row_broadcast_dims(row_dims.size());
+      absl::c_iota(row_broadcast_dims, 0);
+      if (instr->dimensions() == row_broadcast_dims) {
+        return true;
+      }
+      // Broadcast of a vector to all rows, e.g. of the scale.
+      return instr->dimensions().size() == 1 &&
+             instr->dimensions(0) == static_cast<int64_t>(row_dims.size());
+    }
+    case HloOpcode::kReduce:
+      return instr->operand_count() == 2 && has_row_shape &&
+             instr->dimensions().size() == 1 &&
+             instr->dimensions(0) == static_cast<int64_t>(row_dims.size()) &&
+             instr->operand(0)->shape().dimensions() == dims &&
+             HasDefaultLayout(instr->operand(0)->shape());
+    default:
+      return instr->IsElementwise() && !instr->HasSideEffect() &&
+             (has_element_shape || has_row_shape);
+  }
+}
+
+bool IsNormalizationRoot(const HloInstruction* instr) {
+  absl::Span<const int64_t> dims = instr->shape().dimensions();
+  return instr->IsElementwise() && instr->opcode() != HloOpcode::kConstant &&
+         dims.size() >= 2 && dims.back() > 1 && IsFusible(instr, dims);
+}
+
+// Returns the instructions of the normalization fusion with the given root, in
+// reverse post order, or an empty vector if the fusion would not contain a
+// reduction that is broadcast back to the rows.
+std::vector<HloInstruction*> CollectNormalization(
+    HloInstruction* root,
+    const absl::flat_hash_map<const HloInstruction*, int64_t>&
+        post_order_index) {
+  absl::Span<const int64_t> dims = root->shape().dimensions();
+
+  // Visit users before their operands, so that an instruction is only visited
+  // once all of its users in the fusion are known.
+  auto visit_later = [&](const HloInstruction* a, const HloInstruction* b) {
+    return post_order_index.at(a) < post_order_index.at(b);
+  };
+  std::priority_queue<HloInstruction*, std::vector<HloInstruction*>,
+                      decltype(visit_later)>
+      queue(visit_later);
+  absl::flat_hash_set<const HloInstruction*> queued;
+  auto enqueue_operands = [&](HloInstruction* instr) {
+    for (HloInstruction* operand : instr->operands()) {
+      if (queued.insert(operand).second) {
+        queue.push(operand);
+      }
+    }
+  };
+
+  absl::flat_hash_set<const HloInstruction*> in_fusion{root};
+  std::vector<HloInstruction*> instructions{root};
+  enqueue_operands(root);
+  while (!queue.empty()) {
+    HloInstruction* instr = queue.top();
+    queue.pop();
+    bool only_used_in_fusion =
+        absl::c_all_of(instr->users(), [&](const HloInstruction* user) {
+          return in_fusion.contains(user);
+        });
+    if (!only_used_in_fusion || !IsFusible(instr, dims)) {
+      continue;
+    }
+    in_fusion.insert(instr);
+    instructions.push_back(instr);
+    enqueue_operands(instr);
+  }
+
+  // Find the values in the fusion that depend on a reduction, and check that
+  // one of them is broadcast back to the rows.
+  absl::flat_hash_set<const HloInstruction*> depends_on_reduction;
+  for (auto it = instructions.rbegin(); it != instructions.rend(); ++it) {
+    const HloInstruction* instr = *it;
+    if (instr->opcode() == HloOpcode::kBroadcast &&
+        depends_on_reduction.contains(instr->operand(0))) {
+      return instructions;
+    }
+    if (instr->opcode() == HloOpcode::kReduce ||
+        absl::c_any_of(instr->operands(), [&](const HloInstruction* operand) {
+          return depends_on_reduction.contains(operand);
+        })) {
+      depends_on_reduction.insert(instr);
+    }
+  }
+  return {};
+}
+
+// Replaces the instructions by a normalization fusion. The instructions must
+// be given in reverse post order, starting with the root.
+absl::Status FuseNormalization(absl::Span<HloInstruction* const> instructions) {
+  HloInstruction* root = instructions.front();
+  HloComputation::Builder builder("normalization_computation");
+  // Original instruction -> fused one.
+  absl::flat_hash_map<const HloInstruction*, HloInstruction*>
+      old_to_new_mapping;
+  std::vector<HloInstruction*> parameters;
+
+  for (auto it = instructions.rbegin(); it != instructions.rend(); ++it) {
+    HloInstruction* instr = *it;
+    std::vector<HloInstruction*> new_operands;
+    for (HloInstruction* operand : instr->operands()) {
+      auto [mapping, inserted] =
+          old_to_new_mapping.try_emplace(operand, nullptr);
+      if (inserted) {
+        mapping->second =
+            builder.AddInstruction(HloInstruction::CreateParameter(
+                parameters.size(), operand->shape(),
+                absl::StrCat("parameter_", parameters.size())));
+        parameters.push_back(operand);
+      }
+      new_operands.push_back(mapping->second);
+    }
+    old_to_new_mapping[instr] = builder.AddInstruction(
+        instr->CloneWithNewOperands(instr->shape(), new_operands));
+  }
+
+  HloComputation* computation =
+      root->GetModule()->AddComputationAndUnifyNamesAndIds(builder.Build(),
+                                                           /*is_entry=*/false);
+  HloInstruction* fusion =
+      root->parent()->AddInstruction(HloInstruction::CreateFusion(
+          root->shape(), HloInstruction::FusionKind::kCustom, parameters,
+          computation));
+  fusion->GetModule()->SetAndUniquifyInstrName(fusion, "normalization_fusion");
+  TF_ASSIGN_OR_RETURN(auto gpu_config,
+                      fusion->backend_config<GpuBackendConfig>());
+  gpu_config.mutable_fusion_backend_config()->set_kind(
+      std::string(kNormalizationFusionKind));
+  TF_RETURN_IF_ERROR(fusion->set_backend_config(gpu_config));
+  VLOG(2) << "Created normalization fusion: " << fusion->ToString();
+
+  if (root->IsRoot()) {
+    root->parent()->set_root_instruction(fusion);
+    return root->parent()->RemoveInstructionAndUnusedOperands(root);
+  }
+  return root->parent()->ReplaceInstruction(root, fusion);
+}
+
+}  // namespace
+
+absl::StatusOr<bool> NormalizationFusionRewriter::Run(
+    HloModule* module,
+    const absl::flat_hash_set<absl::string_view>& execution_threads) {
+  bool changed = false;
+  for (HloComputation* computation :
+       module->MakeNonfusionComputations(execution_threads)) {
+    std::vector<HloInstruction*> post_order =
+        computation->MakeInstructionPostOrder();
+    absl::flat_hash_map<const HloInstruction*, int64_t> post_order_index;
+    for (int64_t i = 0; i < post_order.size(); ++i) {
+      post_order_index[post_order[i]] = i;
+    }
+
+    // Visit the users first, so that each fusion is as large as possible. The
+    // fused instructions are deleted, so they are only compared by address.
+    absl::flat_hash_set<const HloInstruction*> fused;
+    for (auto it = post_order.rbegin(); it != post_order.rend(); ++it) {
+      HloInstruction* instr = *it;
+      if (fused.contains(instr) || !IsNormalizationRoot(instr)) {
+        continue;
+      }
+      std::vector<HloInstruction*> instructions =
+          CollectNormalization(instr, post_order_index);
+      if (instructions.empty()) {
+        continue;
+      }
+      fused.insert(instructions.begin(), instructions.end());
+      TF_RETURN_IF_ERROR(FuseNormalization(instructions));
+      changed = true;
+    }
+  }
+  return changed;
+}
+
+}  // namespace gpu
+}  // namespace xla
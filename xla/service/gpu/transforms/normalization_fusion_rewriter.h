@@ -0,0 +1,56 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_SERVICE_GPU_TRANSFORMS_NORMALIZATION_FUSION_REWRITER_H_
+#define XLA_SERVICE_GPU_TRANSFORMS_NORMALIZATION_FUSION_REWRITER_H_
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/pass/hlo_pass_interface.h"
+
+namespace xla {
+namespace gpu {
+
+// Fuses row normalizations, e.g. RMSNorm and LayerNorm, into custom fusions
+// that are emitted by NormalizationFusion, one block per row.
+//
+// Starting from an elementwise instruction with a row-major shape [..., n], the
+// pass collects the producers that are only used inside the fusion and are
+// either elementwise, broadcasts of rows, of scalars or of [n] vectors, or
+// reductions over the minor dimension. A fusion is created if it contains a
+// reduction whose result is broadcast back to the rows, i.e. if it would
+// otherwise be emitted as a reduction fusion followed by a loop fusion that
+// reads the input once more.
+//
+// The pass expects a normalized layout, and should run before the reductions
+// are split or regrouped.
+class NormalizationFusionRewriter : public HloModulePass {
+ public:
+  absl::string_view name() const override {
+    return "normalization-fusion-rewriter";
+  }
+
+  using HloPassInterface::Run;
+  absl::StatusOr<bool> Run(
+      HloModule* module,
+      const absl::flat_hash_set<absl::string_view>& execution_threads) override;
+};
+
+}  // namespace gpu
+}  // namespace xla
+
+#endif  // XLA_SERVICE_GPU_TRANSFORMS_NORMALIZATION_FUSION_REWRITER_H_
@@ -0,0 +1,168 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/service/gpu/transforms/normalization_fusion_rewriter.h"
+
+#include <memory>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/hlo/testlib/hlo_hardware_independent_test_base.h"
+#include "xla/service/gpu/backend_configs.pb.h"
+#include "xla/service/gpu/ir_emission_utils.h"
+#include "xla/tsl/platform/status_matchers.h"
+#include "xla/tsl/platform/statusor.h"
+
+namespace xla {
+namespace gpu {
+namespace {
+
+using ::tsl::testing::IsOkAndHolds;
+
+using NormalizationFusionRewriterTest = HloHardwareIndependentTestBase;
+
+TEST_F(NormalizationFusionRewriterTest, FusesRmsNorm) {
+  constexpr char kHlo[] = R"(
+add {
+  lhs = f32[] parameter(0)
+  rhs = f32[] parameter(1)
+  ROOT add = f32[] add(lhs, rhs)
+}
+
+ENTRY main {
+  x = bf16[32,4096] parameter(0)
+  scale = bf16[4096] parameter(1)
+  x_f32 = f32[32,4096] convert(x)
+  squared = f32[32,4096] multiply(x_f32, x_f32)
+  zero = f32[] constant(0)
+  sum = f32[32] reduce(squared, zero), dimensions={1}, to_apply=add
+  inv_n = f32[] constant(0.000244140625)
+  inv_n_rows = f32[32] broadcast(inv_n), dimensions={}
+  mean = f32[32] multiply(sum, inv_n_rows)
+  rsqrt = f32[32] rsqrt(mean)
+  rsqrt_bcast = f32[32,4096] broadcast(rsqrt), dimensions={0}
+  normalized = f32[32,4096] multiply(x_f32, rsqrt_bcast)
+  scale_f32 = f32[4096] convert(scale)
+  scale_bcast = f32[32,4096] broadcast(scale_f32), dimensions={1}
+  scaled = f32[32,4096] multiply(normalized, scale_bcast)
+  ROOT result = bf16[32,4096] convert(scaled)
+})";
+
+  RunAndFilecheckHloRewrite(kHlo, NormalizationFusionRewriter(), R"(
+// CHECK:      %[[COMPUTATION:.*]] ({{.*}}) -> bf16[32,4096] {
+// CHECK:        reduce
+// CHECK:        rsqrt
+// CHECK:        ROOT {{.*}} convert
+// CHECK:      ENTRY
+// CHECK-NEXT:   %[[X:.*]] = bf16[32,4096]{1,0} parameter(0)
+// CHECK-NEXT:   %[[SCALE:.*]] = bf16[4096]{0} parameter(1)
+// CHECK:        ROOT {{.*}} fusion({{.*}}), kind=kCustom
+// CHECK-SAME:     calls=%[[COMPUTATION]]
+// CHECK-SAME:     "kind":"__normalization"
+)");
+}
+
+TEST_F(NormalizationFusionRewriterTest, FusesLayerNormWithDependentReductions) {
+  constexpr char kHlo[] = R"(
+add {
+  lhs = f32[] parameter(0)
+  rhs = f32[] parameter(1)
+  ROOT add = f32[] add(lhs, rhs)
+}
+
+ENTRY main {
+  x = f32[2,16,1024] parameter(0)
+  zero = f32[] constant(0)
+  inv_n = f32[] constant(0.0009765625)
+  inv_n_rows = f32[2,16] broadcast(inv_n), dimensions={}
+  sum = f32[2,16] reduce(x, zero), dimensions={2}, to_apply=add
+  mean = f32[2,16] multiply(sum, inv_n_rows)
+  mean_bcast = f32[2,16,1024] broadcast(mean), dimensions={0,1}
+  centered = f32[2,16,1024] subtract(x, mean_bcast)
+  squared = f32[2,16,1024] multiply(centered, centered)
+  sum_squared = f32[2,16] reduce(squared, zero), dimensions={2}, to_apply=add
+  variance = f32[2,16] multiply(sum_squared, inv_n_rows)
+  rsqrt = f32[2,16] rsqrt(variance)
+  rsqrt_bcast = f32[2,16,1024] broadcast(rsqrt), dimensions={0,1}
+  ROOT normalized = f32[2,16,1024] multiply(centered, rsqrt_bcast)
+})";
+
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(kHlo));
+  EXPECT_THAT(NormalizationFusionRewriter().Run(module.get()),
+              IsOkAndHolds(true));
+
+  const HloInstruction* root = module->entry_computation()->root_instruction();
+  ASSERT_EQ(root->opcode(), HloOpcode::kFusion);
+  EXPECT_EQ(root->operand_count(), 1);
+  TF_ASSERT_OK_AND_ASSIGN(auto gpu_config,
+                          root->backend_config<GpuBackendConfig>());
+  EXPECT_EQ(gpu_config.fusion_backend_config().kind(),
+            kNormalizationFusionKind);
+  EXPECT_EQ(module->entry_computation()->instruction_count(), 2);
+}
+
+TEST_F(NormalizationFusionRewriterTest, DoesNotFuseReductionUsedOutside) {
+  constexpr char kHlo[] = R"(
+add {
+  lhs = f32[] parameter(0)
+  rhs = f32[] parameter(1)
+  ROOT add = f32[] add(lhs, rhs)
+}
+
+ENTRY main {
+  x = f32[32,1024] parameter(0)
+  zero = f32[] constant(0)
+  sum = f32[32] reduce(x, zero), dimensions={1}, to_apply=add
+  sum_bcast = f32[32,1024] broadcast(sum), dimensions={0}
+  divided = f32[32,1024] divide(x, sum_bcast)
+  ROOT tuple = (f32[32,1024], f32[32]) tuple(divided, sum)
+})";
+
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(kHlo));
+  EXPECT_THAT(NormalizationFusionRewriter().Run(module.get()),
+              IsOkAndHolds(false));
+}
+
+TEST_F(NormalizationFusionRewriterTest, DoesNotFuseReductionWithoutBroadcast) {
+  constexpr char kHlo[] = R"(
+add {
+  lhs = f32[] parameter(0)
+  rhs = f32[] parameter(1)
+  ROOT add = f32[] add(lhs, rhs)
+}
+
+ENTRY main {
+  x = f32[32,1024] parameter(0)
+  y = f32[32,1024] parameter(1)
+  zero = f32[] constant(0)
+  sum = f32[32] reduce(x, zero), dimensions={1}, to_apply=add
+  exp = f32[32] exponential(sum)
+  ROOT tuple = (f32[32,1024], f32[32]) tuple(y, exp)
+})";
+
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(kHlo));
+  EXPECT_THAT(NormalizationFusionRewriter().Run(module.get()),
+              IsOkAndHolds(false));
+}
+
+}  // namespace
+}  // namespace gpu
+}  // namespace xla
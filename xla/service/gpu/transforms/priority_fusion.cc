@@ -58,6 +58,7 @@ limitations under the License.
 #include "xla/service/gpu/hlo_fusion_analysis.h"
 #include "xla/service/gpu/ir_emission_utils.h"
 #include "xla/service/gpu/model/fusion_analysis_cache.h"
+#include "xla/service/gpu/model/fusion_runtime_memo.h"
 #include "xla/service/gpu/model/gpu_hlo_cost_analysis.h"
 #include "xla/service/gpu/model/gpu_indexing_performance_model.h"
 #include "xla/service/gpu/model/gpu_performance_model.h"
@@ -66,6 +67,7 @@ limitations under the License.
 #include "xla/service/gpu/model/triton_emitter_constraints.h"
 #include "xla/service/hlo_graph_dumper.h"
 #include "xla/service/instruction_fusion.h"
+#include "xla/service/measured_fusion_runtimes.h"
 #include "xla/shape.h"
 #include "xla/shape_util.h"
 #include "xla/stream_executor/device_description.h"
@@ -152,6 +154,8 @@ class PriorityFusionQueue {
                       mlir::MLIRContext* mlir_context,
                       HloFusionAnalysisCache& fusion_analysis_cache,
                       FusionDeduplicationCache& fusion_deduplication_cache,
+                      const MeasuredFusionRuntimes* measured_fusion_runtimes,
+                      FusionRuntimeMemo* fusion_runtime_memo,
                       bool triton_heroless_fusion_enabled)
       : computation_(computation),
         device_info_(device_info),
@@ -163,8 +167,10 @@ class PriorityFusionQueue {
         thread_pool_(thread_pool),
         fusion_analysis_cache_(fusion_analysis_cache),
         gpu_performance_model_(*device_info, fusion_analysis_cache,
-                               gpu_performance_model_cache_),
+                               gpu_performance_model_cache_,
+                               fusion_runtime_memo),
         fusion_deduplication_cache_(fusion_deduplication_cache),
+        measured_fusion_runtimes_(measured_fusion_runtimes),
         fusion_info_cache_(*device_info_),
         reachability_(HloDfsReachability::Build(computation)),
         triton_heroless_fusion_enabled_(triton_heroless_fusion_enabled) {
@@ -304,6 +310,15 @@ class PriorityFusionQueue {
           producer, &cost_analysis_);
     }
 
+    // Prefer the runtime measured in a previous execution of the same fusion.
+    if (measured_fusion_runtimes_ != nullptr) {
+      if (std::optional<absl::Duration> measured_runtime =
+              measured_fusion_runtimes_->Get(*producer)) {
+        VLOG(5) << "Using measured runtime for " << producer->name();
+        runtime_data.exec_time = *measured_runtime;
+      }
+    }
+
     gpu_performance_model_cache_.Set(*producer, runtime_data);
 
     return absl::OkStatus();
@@ -778,6 +793,38 @@ class PriorityFusionQueue {
       return can_fuse;
     }
 
+    if (auto can_fuse = CanFuseWithEmitterCached(producer, consumer);
+        !can_fuse) {
+      return can_fuse;
+    }
+
+    // Avoid cases where we'd create a fusion that hit limitations in ptxas.
+    // Would be nice to model this with cost instead.
+    if (auto fits_budget = FusionFitsInBudget(
+            *consumer, *producer, *device_info_,
+            /*is_consumer_producer_fusion=*/true, &fusion_info_cache_);
+        !fits_budget) {
+      return fits_budget;
+    }
+
+    // Also check that our emitter can handle the fusion node. We currently can
+    // have exponential time/memory requirements for emitting certain fusion
+    // kernels, in which case we don't want to fuse.
+    // TODO(b/119692968): Remove this once we have fixed our fusion emitter.
+    if (cost_analysis_.ProducerConsumerMergedTooLarge(*producer, *consumer)) {
+      return FusionDecision::Forbid(
+          "the fusion would result in an overly large code duplication");
+    }
+
+    return InstructionFusion::ShouldFuseInPlaceOp(producer, consumer,
+                                                  std::nullopt);
+  }
+
+  // Checks whether the emitters can handle the fusion of `producer` into
+  // `consumer` well. The result only depends on the structure of the producer
+  // and the consumer.
+  FusionDecision CanFuseWithEmitter(const HloInstruction* producer,
+                                    const HloInstruction* consumer) {
     // Avoid fusing reduce into reduce. Our cost model doesn't currently
     // understand this case due to a lack of tiling analysis.
     // TODO(b/312200883): Remove this.
@@ -818,26 +865,31 @@ class PriorityFusionQueue {
       }
     }
 
-    // Avoid cases where we'd create a fusion that hit limitations in ptxas.
-    // Would be nice to model this with cost instead.
-    if (auto fits_budget = FusionFitsInBudget(
-            *consumer, *producer, *device_info_,
-            /*is_consumer_producer_fusion=*/true, &fusion_info_cache_);
-        !fits_budget) {
-      return fits_budget;
-    }
+    return FusionDecision::Allow();
+  }
 
-    // Also check that our emitter can handle the fusion node. We currently can
-    // have exponential time/memory requirements for emitting certain fusion
-    // kernels, in which case we don't want to fuse.
-    // TODO(b/119692968): Remove this once we have fixed our fusion emitter.
-    if (cost_analysis_.ProducerConsumerMergedTooLarge(*producer, *consumer)) {
-      return FusionDecision::Forbid(
-          "the fusion would result in an overly large code duplication");
+  // Same as `CanFuseWithEmitter`, but the result is shared between identical
+  // producer-consumer pairs, e.g. from repeated layers of a model.
+  FusionDecision CanFuseWithEmitterCached(const HloInstruction* producer,
+                                          const HloInstruction* consumer) {
+    FusionDeduplicationCache::FusionId fusion_id = [&]() {
+      absl::MutexLock lock(&fusion_deduplication_cache_mutex_);
+      return fusion_deduplication_cache_.GetFusionId(producer, consumer);
+    }();
+
+    {
+      absl::MutexLock lock(&emitter_fusion_decision_cache_mutex_);
+      auto it = emitter_fusion_decision_cache_.find(fusion_id);
+      if (it != emitter_fusion_decision_cache_.end()) {
+        return it->second;
+      }
     }
 
-    return InstructionFusion::ShouldFuseInPlaceOp(producer, consumer,
-                                                  std::nullopt);
+    FusionDecision fusion_decision = CanFuseWithEmitter(producer, consumer);
+
+    absl::MutexLock lock(&emitter_fusion_decision_cache_mutex_);
+    emitter_fusion_decision_cache_.emplace(fusion_id, fusion_decision);
+    return fusion_decision;
   }
 
   FusionDecision CanFuseCached(HloInstruction* producer,
@@ -1012,6 +1064,9 @@ class PriorityFusionQueue {
   FusionDeduplicationCache& fusion_deduplication_cache_;
   absl::Mutex fusion_deduplication_cache_mutex_;
 
+  // Measured fusion runtimes from a profile, may be null.
+  const MeasuredFusionRuntimes* measured_fusion_runtimes_;
+
   // Caches result of can_fuse for a (producer, consumer) pair. A cache entry is
   // invalidated if producer or consumer is modified.
   absl::flat_hash_map<
@@ -1033,6 +1088,12 @@ class PriorityFusionQueue {
       tiled_run_time_data_cache_;
   absl::Mutex tiled_run_time_data_cache_mutex_;
 
+  // Caches the result of `CanFuseWithEmitter` for fusions of identical
+  // producers and consumers.
+  absl::flat_hash_map<FusionDeduplicationCache::FusionId, FusionDecision>
+      emitter_fusion_decision_cache_;
+  absl::Mutex emitter_fusion_decision_cache_mutex_;
+
   // Cache for `FusionFitsInBudget` to avoid recomputing expensive properties
   // like shared memory usage or number of unnested reductions of fusion nodes.
   FusionInfoCache fusion_info_cache_;
@@ -1128,6 +1189,23 @@ absl::StatusOr<bool> PriorityFusion::Run(
   FusionDeduplicationCache fusion_deduplication_cache =
       FusionDeduplicationCache::Create(*module, IsFusible);
 
+  std::optional<MeasuredFusionRuntimes> measured_fusion_runtimes;
+  const std::string& fusion_profile_path =
+      module->config()
+          .debug_options()
+          .xla_gpu_experimental_fusion_profile_path();
+  if (!fusion_profile_path.empty()) {
+    TF_ASSIGN_OR_RETURN(measured_fusion_runtimes,
+                        MeasuredFusionRuntimes::Load(fusion_profile_path));
+  }
+
+  FusionRuntimeMemo* fusion_runtime_memo =
+      module->config()
+              .debug_options()
+              .xla_gpu_experimental_enable_fusion_runtime_memo()
+          ? &FusionRuntimeMemo::Global()
+          : nullptr;
+
   bool changed = false;
   for (auto* computation : fusible_computations) {
     CHECK(!computation->IsFusionComputation());
@@ -1136,7 +1214,9 @@ absl::StatusOr<bool> PriorityFusion::Run(
         computation, cost_analysis_options_, &device_info_,
         fusion_process_dump_.get(), thread_pool_, &mlir_context_,
         fusion_analysis_cache_, fusion_deduplication_cache,
-        triton_heroless_fusion_enabled);
+        measured_fusion_runtimes.has_value() ? &*measured_fusion_runtimes
+                                             : nullptr,
+        fusion_runtime_memo, triton_heroless_fusion_enabled);
 
     while (fusion_queue->DequeueNextProducer()) {
       auto producer = fusion_queue->current_producer();
@@ -1252,6 +1332,7 @@ HloInstruction::FusionKind PriorityFusion::ChooseKind(
     case HloFusionAnalysis::EmitterFusionKind::kTriton:
     case HloFusionAnalysis::EmitterFusionKind::kCustomFusion:
     case HloFusionAnalysis::EmitterFusionKind::kCuDnn:
+    case HloFusionAnalysis::EmitterFusionKind::kNormalization:
       return HloInstruction::FusionKind::kCustom;
     case HloFusionAnalysis::EmitterFusionKind::kConcatenate:
     case HloFusionAnalysis::EmitterFusionKind::kReduction:
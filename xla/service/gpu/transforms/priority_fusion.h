@@ -23,6 +23,7 @@ limitations under the License.
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
 #include "mlir/IR/MLIRContext.h"
+#include "xla/hlo/analysis/indexing_map.h"
 #include "xla/hlo/ir/hlo_computation.h"
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_module.h"
@@ -85,6 +86,9 @@ class PriorityFusion : public HloModulePass {
   HloFusionAnalysisCache fusion_analysis_cache_;
 
   mlir::MLIRContext mlir_context_;
+
+  // Declared after `mlir_context_` so that it is destroyed first.
+  IndexingMapCache indexing_map_cache_{&mlir_context_};
 };
 
 }  // namespace gpu
@@ -29,6 +29,7 @@ limitations under the License.
 #include "xla/service/hlo_cost_analysis.h"
 #include "xla/service/instruction_fusion.h"
 #include "xla/stream_executor/device_description.h"
+#include "tsl/platform/threadpool.h"
 
 namespace xla {
 namespace gpu {
@@ -47,14 +48,19 @@ using DiamondMatchingDecision = std::variant<FusionDecision, HloInstruction*>;
 // Model to the estimate the run time of the fused and unfused versions of the
 // normalization diamond. If the fused version is slower, the diamond will not
 // be fused.
+//
+// If `thread_pool` is not null, the tilings of each fusion are evaluated in
+// parallel on it.
 class SoftmaxRewriterTriton : public HloModulePass {
  public:
   explicit SoftmaxRewriterTriton(const se::DeviceDescription& device_info,
                                  HloCostAnalysis::ShapeSizeFunction shape_size,
-                                 bool only_fuse_if_profitable = false)
+                                 bool only_fuse_if_profitable = false,
+                                 tsl::thread::ThreadPool* thread_pool = nullptr)
       : device_info_(device_info),
         shape_size_(shape_size),
-        use_cost_model_to_evaluate_fusions_(only_fuse_if_profitable) {}
+        use_cost_model_to_evaluate_fusions_(only_fuse_if_profitable),
+        thread_pool_(thread_pool) {}
 
   absl::string_view name() const override { return "triton-softmax-rewriter"; }
 
@@ -104,6 +110,7 @@ class SoftmaxRewriterTriton : public HloModulePass {
   const se::DeviceDescription& device_info_;
   const HloCostAnalysis::ShapeSizeFunction shape_size_;
   bool use_cost_model_to_evaluate_fusions_;
+  tsl::thread::ThreadPool* thread_pool_;
   mlir::MLIRContext mlir_context_;
 };
 
@@ -24,6 +24,7 @@ limitations under the License.
 #include <variant>
 #include <vector>
 
+#include "absl/algorithm/container.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/log/log.h"
 #include "absl/status/statusor.h"
@@ -185,6 +186,19 @@ std::optional<SortComputationAnalysis> AnalyzeCompareOp(
                                  sort_order};
 }
 
+// Returns whether the only results of `sort_op` that are used are the sorted
+// values of operand `value_index`, e.g. the indices computed by an argsort.
+bool OnlySortedValuesAreUsed(const HloSortInstruction& sort_op,
+                             int value_index) {
+  if (sort_op.IsRoot() || sort_op.user_count() == 0) {
+    return false;
+  }
+  return absl::c_all_of(sort_op.users(), [&](const HloInstruction* user) {
+    return user->opcode() == HloOpcode::kGetTupleElement &&
+           user->tuple_index() == value_index;
+  });
+}
+
 std::optional<SortComputationAnalysis> AnalyzeSortOp(
     const HloSortInstruction& sort_op) {
   auto computation = sort_op.called_computations().front();
@@ -211,14 +225,19 @@ std::optional<SortComputationAnalysis> AnalyzeSortOp(
         sort_key_type != F64) {
       return std::nullopt;
     }
-    // Sorting a pair of input tensors is not supported. The keys to sort on
-    // will be generated synthetically.
-    if (sort_op.operand_count() != 1) {
-      return std::nullopt;
+    // The keys to sort on will be generated synthetically, and the original
+    // keys can not be recovered from them (-0 and -NaN are canonicalized).
+    // Hence a pair of tensors can only be sorted if the sorted keys are
+    // unused, which is the case for argsort-like sorts with an index payload.
+    if (sort_op.operand_count() == 2) {
+      if (!OnlySortedValuesAreUsed(sort_op, 1 - sort_analysis->key_operand)) {
+        return std::nullopt;
+      }
+    } else {
+      // Cub cannot sort the original keys directly, hence treat them as values
+      // in a key-value pair sort.
+      sort_value_type = sort_key_type;
     }
-    // Cub cannot sort the original keys directly, hence treat them as values in
-    // a key-value pair sort.
-    sort_value_type = sort_key_type;
     // The synthetic keys used for sorting are unsigned integers.
     sort_key_type = primitive_util::UnsignedIntegralTypeForBitWidth(
         primitive_util::BitWidth(sort_key_type));
@@ -503,14 +522,19 @@ absl::StatusOr<bool> SortRewriter::RunOnInstruction(
   if (sorting_pairs) {
     values = sort_op->mutable_operand(value_index);
   }
-  // For sorting in Numpy order, materialize synthetic keys and treat the
-  // original input as values.
+  // For sorting in Numpy order, materialize synthetic keys. Unless a pair of
+  // tensors is sorted, treat the original input as values.
+  bool numpy_order_pairs = false;
   if (sort_analysis.sort_order == SortOrderType::kNumpyOrder) {
-    sorting_pairs = true;
-    keys = AddNumpySortKey(sort_op->mutable_operand(sort_analysis.key_operand),
-                           sort_analysis.key_type,
-                           sort_analysis.value_type.value());
-    values = sort_op->mutable_operand(sort_analysis.key_operand);
+    HloInstruction* original_keys =
+        sort_op->mutable_operand(sort_analysis.key_operand);
+    keys = AddNumpySortKey(original_keys, sort_analysis.key_type,
+                           original_keys->shape().element_type());
+    numpy_order_pairs = sorting_pairs;
+    if (!sorting_pairs) {
+      sorting_pairs = true;
+      values = original_keys;
+    }
   }
 
   // Build the resulting shape for the custom call.
@@ -532,6 +556,20 @@ absl::StatusOr<bool> SortRewriter::RunOnInstruction(
   backend_config.set_descending(sort_analysis.descending);
   TF_RETURN_IF_ERROR(custom_call->set_backend_config(backend_config));
 
+  // Only the sorted values of a pair of tensors sorted in Numpy order are used,
+  // so the users of the sort op are redirected to them.
+  if (numpy_order_pairs) {
+    HloInstruction* sorted_values = sort_op->AddInstruction(
+        HloInstruction::CreateGetTupleElement(values->shape(), custom_call, 1));
+    std::vector<HloInstruction*> users = sort_op->users();
+    for (HloInstruction* user : users) {
+      // Replacing the last user also removes the sort op.
+      TF_RETURN_IF_ERROR(
+          sort_op->parent()->ReplaceInstruction(user, sorted_values));
+    }
+    return true;
+  }
+
   // Build the replacement instruction.
   HloInstruction* replacement;
   if (!sorting_pairs) {
@@ -590,6 +590,55 @@ INSTANTIATE_TEST_SUITE_P(
           std::get<1>(info.param) ? "_asc" : "_desc");
     });
 
+constexpr char kNumpyOrderArgsortHlo[] = R"(
+numpy_order_comparator {
+  lhs = f32[] parameter(0)
+  lhs_is_nan = pred[] compare(lhs, lhs), direction=NE
+  c_nan = f32[] constant(nan)
+  c_zero = f32[] constant(0)
+  lhs_is_zero = pred[] compare(lhs, c_zero), direction=EQ
+  lhs_no_neg_zero = f32[] select(lhs_is_zero, c_zero, lhs)
+  lhs_no_neg_zero_or_nan = f32[] select(lhs_is_nan, c_nan, lhs_no_neg_zero)
+  rhs = f32[] parameter(1)
+  rhs_is_nan = pred[] compare(rhs, rhs), direction=NE
+  rhs_is_zero = pred[] compare(rhs, c_zero), direction=EQ
+  rhs_no_neg_zero = f32[] select(rhs_is_zero, c_zero, rhs)
+  rhs_no_neg_zero_or_nan = f32[] select(rhs_is_nan, c_nan, rhs_no_neg_zero)
+  idx_lhs = s32[] parameter(2)
+  idx_rhs = s32[] parameter(3)
+  ROOT compare = pred[] compare(lhs_no_neg_zero_or_nan, rhs_no_neg_zero_or_nan), direction=LT, type=TOTALORDER
+}
+
+ENTRY main {
+  p = f32[16,128] parameter(0)
+  iota = s32[16,128] iota(), iota_dimension=1
+  sort = (f32[16,128], s32[16,128]) sort(p, iota), dimensions={1}, is_stable=true, to_apply=numpy_order_comparator
+  ROOT $0
+})";
+
+TEST_F(SortRewriterTest, SortNumpyOrderPairsWithUnusedKeys) {
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto module,
+      ParseAndReturnVerifiedModule(absl::Substitute(
+          kNumpyOrderArgsortHlo,
+          "indices = s32[16,128] get-tuple-element(sort), index=1")));
+  EXPECT_TRUE(RunModuleAndPass(module.get()));
+  EXPECT_THAT(module->entry_computation()->root_instruction(),
+              GmockMatch(m::GetTupleElement(
+                  m::CustomCall({kCubDeviceRadixSortTarget}, m::Op(),
+                                m::Iota()),
+                  1)));
+}
+
+TEST_F(SortRewriterTest, NoRewriteNumpyOrderPairsWithUsedKeys) {
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto module,
+      ParseAndReturnVerifiedModule(absl::Substitute(
+          kNumpyOrderArgsortHlo,
+          "values = f32[16,128] get-tuple-element(sort), index=0")));
+  EXPECT_FALSE(RunModuleAndPass(module.get()));
+}
+
 TEST_F(SortRewriterTest, AlwaysUsesCubSort) {
   EXPECT_EQ(SortRewriter::SortMode(), SortRewriter::Mode::kAlways);
 }
@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "xla/service/gpu/transforms/windowed_einsum_handler.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <string>
 #include <utility>
@@ -524,6 +525,27 @@ absl::Status ProcessWindowedEinsumLoopForActivationCaching(
   return absl::OkStatus();
 }
 
+// Returns the number of partial all-to-alls to split an all-to-all moving
+// `all_to_all_bytes` into, along a contracting dimension of size
+// `contracting_dim_size`, or 1 if it should not be split. Splitting into as
+// many all-to-alls as there are devices in a group overlaps the most
+// communication with the partial gemms, but every split adds the latency of an
+// all-to-all, so no split moves fewer than `min_split_bytes` unless that is 0.
+int64_t NumAllToAllSplits(int64_t contracting_dim_size, int64_t group_size,
+                          int64_t all_to_all_bytes, int64_t min_split_bytes) {
+  int64_t max_num_splits = group_size;
+  if (min_split_bytes > 0) {
+    max_num_splits =
+        std::min(max_num_splits, all_to_all_bytes / min_split_bytes);
+  }
+  for (int64_t num_splits = max_num_splits; num_splits > 1; --num_splits) {
+    if (contracting_dim_size % num_splits == 0) {
+      return num_splits;
+    }
+  }
+  return 1;
+}
+
 bool HasReplicaGroups(const HloInstruction* inst) {
   return inst->replica_groups().size() > 0;
 }
@@ -1029,13 +1051,20 @@ class WindowedEinsumVisitor : public DfsHloRewriteVisitor {
                   LiteralUtil::Zero(dot->shape().element_type()))),
               {}));
       HloInstruction* a2a_operand = a2a->mutable_operand(0);
-      if (contracting_dim_value % group_size) {
+      int64_t num_splits = NumAllToAllSplits(
+          contracting_dim_value, group_size,
+          ShapeUtil::ByteSizeOf(a2a->shape()),
+          dot->GetModule()
+              ->config()
+              .debug_options()
+              .xla_gpu_experimental_alltoall_windowed_einsum_min_split_bytes());
+      if (num_splits < 2) {
         VLOG(5) << absl::StrFormat(
-            "Contracting dimension %d needs to be divisible by group_size %d",
+            "Contracting dimension %d cannot be split for group_size %d",
             contracting_dim_value, group_size);
         return absl::OkStatus();
       }
-      int64_t size_per_split = contracting_dim_value / group_size;
+      int64_t size_per_split = contracting_dim_value / num_splits;
 
       // Each split is sliced out of the input buffer, we need to determine the
       // slice sizes and increments.
@@ -1061,7 +1090,7 @@ class WindowedEinsumVisitor : public DfsHloRewriteVisitor {
               partial_all_to_all_shape, rhs_slice_shape, original_dot_dnums,
               /*preferred_element_type=*/std::nullopt));
       int64_t stream_id = hlo_query::NextChannelId(*a2a->GetModule());
-      for (int64_t i = 0; i < group_size; ++i) {
+      for (int64_t i = 0; i < num_splits; ++i) {
         lhs_slice = comp->AddInstruction(HloInstruction::CreateSlice(
             lhs_slice_shape, a2a_operand, lhs_slice_sizes, lhs_slice_max_range,
             lhs_slice_increments));
@@ -1270,14 +1299,21 @@ class WindowedEinsumVisitor : public DfsHloRewriteVisitor {
               comp->AddInstruction(HloInstruction::CreateConstant(
                   LiteralUtil::Zero(all_to_all->shape().element_type()))),
               {}));
-      if (contracting_dim_value % group_size) {
+      int64_t num_splits = NumAllToAllSplits(
+          contracting_dim_value, group_size,
+          ShapeUtil::ByteSizeOf(all_to_all->shape()),
+          inst->GetModule()
+              ->config()
+              .debug_options()
+              .xla_gpu_experimental_alltoall_windowed_einsum_min_split_bytes());
+      if (num_splits < 2) {
         VLOG(5) << absl::StrFormat(
-            "Contracting dimension %d needs to be divisible by group_size %d",
+            "Contracting dimension %d cannot be split for group_size %d",
             contracting_dim_value, group_size);
         return absl::OkStatus();
       }
 
-      int64_t size_per_split = contracting_dim_value / group_size;
+      int64_t size_per_split = contracting_dim_value / num_splits;
       // Each split is sliced out of the input buffer, we need to determine the
       // slice sizes and increments.
       lhs_slice_max_range[lhs_contracting_dim] = size_per_split;
@@ -1301,7 +1337,7 @@ class WindowedEinsumVisitor : public DfsHloRewriteVisitor {
               lhs_slice_shape, rhs_slice_shape, original_dot_dnums,
               /*preferred_element_type=*/std::nullopt));
       int64_t stream_id = hlo_query::NextChannelId(*all_to_all->GetModule());
-      for (int64_t i = 0; i < group_size; ++i) {
+      for (int64_t i = 0; i < num_splits; ++i) {
         lhs_slice = comp->AddInstruction(HloInstruction::CreateSlice(
             lhs_slice_shape, matched_result.lhs, lhs_slice_sizes,
             lhs_slice_max_range, lhs_slice_increments));
@@ -30,6 +30,7 @@ limitations under the License.
 #include "xla/hlo/testlib/pattern_matcher_gmock.h"
 #include "xla/service/gpu/backend_configs.pb.h"
 #include "xla/service/pattern_matcher.h"
+#include "xla/xla.pb.h"
 #include "tsl/platform/statusor.h"
 
 namespace xla::gpu {
@@ -396,6 +397,43 @@ CHECK: ROOT {{.*}} = bf16[1,4,2048,32768]{3,2,1,0} add(%[[DOT3:.*]], %[[ADD2:.*]
   EXPECT_TRUE(filecheck_matched);
 }
 
+TEST_F(WindowedEinsumHandlerTest, A2aGemmSplitsAreAtLeastMinSplitBytes) {
+  constexpr absl::string_view kHloString = R"(
+HloModule pjit__unnamed_wrapped_function_, entry_computation_layout={(bf16[1,8192,32768]{2,1,0}, bf16[1,4,2048,8192]{3,2,1,0})->bf16[1,4,2048,32768]{3,2,1,0}}, num_partitions=8
+
+ENTRY main.9_spmd {
+  param0 = bf16[1,8192,32768]{2,1,0} parameter(0)
+  param1 = bf16[1,4,2048,8192]{3,2,1,0} parameter(1)
+  all-to-all = bf16[1,4,2048,8192]{3,2,1,0} all-to-all(param1), channel_id=4, replica_groups={{0,1,2,3},{4,5,6,7}}, dimensions={1}
+  ROOT dot.12 = bf16[1,4,2048,32768]{3,2,1,0} dot(all-to-all, param0), lhs_batch_dims={0}, lhs_contracting_dims={3}, rhs_batch_dims={0}, rhs_contracting_dims={1}
+}
+)";
+
+  // The all-to-all moves 128MiB, so at most 2 splits move at least 64MiB.
+  const char* kExpected = R"(
+CHECK: ENTRY
+CHECK-COUNT-2: bf16[1,4,2048,4096]{3,2,1,0} all-to-all(
+CHECK-NOT: all-to-all(
+CHECK: ROOT {{.*}} = bf16[1,4,2048,32768]{3,2,1,0} add(
+)";
+
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(kHloString));
+
+  WindowedEinsumHandler gpu_handler;
+  DebugOptions& debug_options =
+      module->mutable_config().mutable_debug_options();
+  debug_options.set_xla_gpu_experimental_enable_alltoall_windowed_einsum(true);
+  debug_options
+      .set_xla_gpu_experimental_alltoall_windowed_einsum_min_split_bytes(
+          64 * 1024 * 1024);
+  TF_ASSERT_OK_AND_ASSIGN(bool changed, gpu_handler.Run(module.get()));
+  EXPECT_TRUE(changed);
+  TF_ASSERT_OK_AND_ASSIGN(bool filecheck_matched,
+                          RunFileCheck(module->ToString(), kExpected));
+  EXPECT_TRUE(filecheck_matched);
+}
+
 TEST_F(WindowedEinsumHandlerTest, GemmA2aHaveStreamIds) {
   constexpr absl::string_view kHloString = R"(
 HloModule pjit__unnamed_wrapped_function_, entry_computation_layout={(bf16[1,8192,32768]{2,1,0}, bf16[1,4,2048,32768]{3,2,1,0})->bf16[1,4,2048,8192]{3,2,1,0}}, num_partitions=4
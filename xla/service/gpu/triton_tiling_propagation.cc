@@ -789,6 +789,32 @@ DimOrderMapOrError GetPropagatedDimOrdersForDimAlteringOp(
                               dst->shape().dimensions(dim));
         }
       }
+    } else if (hlo.opcode() == HloOpcode::kGather) {
+      // The indices are loaded by the emitter one at a time, they do not get
+      // a dim order.
+      if (dst != &hlo && hlo.operand_index(dst) >= 1) {
+        continue;
+      }
+      // Gathered rows are only supported in the non-contracting dimension,
+      // the emitter resolves the index of the gathered slice per tile of it.
+      if (!absl::c_all_of(src_logical[0], [&](const Fragment* fragment) {
+            return fragment->dst_dim_number() ==
+                   properties.noncontracting_dimension;
+          })) {
+        return FusionDecision::Forbid(
+            "Gather outside of the non-contracting dimension.");
+      }
+      dst_logical = src_logical;
+      if (dst->shape().dimensions(0) != hlo.shape().dimensions(0)) {
+        if (dst_logical[0].size() > 1) {
+          return FusionDecision::Forbid("Gather of fragmented dimension.");
+        }
+        // Like for dynamic slices, the whole input is retained.
+        Fragment* fragment = dst_logical[0].front();
+        fragment->set_count(dst->shape().dimensions(0));
+        fragment->set_slice(fragment->slice_start(),
+                            dst->shape().dimensions(0));
+      }
     } else {
       return FusionDecision::Forbid("Function called on a wrong instruction.");
     }
@@ -870,10 +896,11 @@ DimOrderMapOrError GetPropagatedDimOrders(const HloInstruction& hlo,
       direction == TransformDirection::kOutputToInput &&
       absl::c_any_of(hlo.users(), [](const HloInstruction* user) {
         return (user->opcode() == HloOpcode::kConcatenate ||
-                user->opcode() == HloOpcode::kDynamicSlice);
+                user->opcode() == HloOpcode::kDynamicSlice ||
+                user->opcode() == HloOpcode::kGather);
       })) {
     return FusionDecision::Forbid(
-        "No fusion into concatenations or dynamic slice.");
+        "No fusion into concatenations, dynamic slice or gather.");
   }
   if (hlo.opcode() == HloOpcode::kParameter ||
       hlo_query::IsScalarConstant(&hlo)) {
@@ -921,6 +948,15 @@ DimOrderMapOrError GetPropagatedDimOrders(const HloInstruction& hlo,
       return decision;
     }
 
+    return GetPropagatedDimOrdersForDimAlteringOp(hlo, direction, src_dim_order,
+                                                  properties);
+  } else if (hlo.opcode() == HloOpcode::kGather &&
+             direction == TransformDirection::kOutputToInput) {
+    if (CodegenDecision decision = legacy_triton::IsTritonSupportedGather(
+            *Cast<HloGatherInstruction>(&hlo));
+        !decision.CanFuse()) {
+      return decision;
+    }
     return GetPropagatedDimOrdersForDimAlteringOp(hlo, direction, src_dim_order,
                                                   properties);
   } else if (hlo.opcode() == HloOpcode::kReshape) {
@@ -1007,7 +1043,9 @@ bool IsInputWorthFusing(const HloInstruction& hlo) {
   if (hlo.user_count() > 1) {
     return false;
   }
-  if (hlo.opcode() == HloOpcode::kSlice &&
+  // Gathers only read the gathered slices of their input.
+  if ((hlo.opcode() == HloOpcode::kSlice ||
+       hlo.opcode() == HloOpcode::kGather) &&
       hlo_query::AllOperandsAreParametersOrConstants(hlo)) {
     return true;
   }
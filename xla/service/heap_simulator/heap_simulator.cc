@@ -42,6 +42,7 @@ limitations under the License.
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_join.h"
+#include "absl/synchronization/blocking_counter.h"
 #include "absl/types/span.h"
 #include "xla/comparison_util.h"
 #include "xla/hlo/analysis/hlo_alias_analysis.h"
@@ -2604,19 +2605,35 @@ template <typename BufferType>
 absl::StatusOr<HeapSimulator::Result<BufferType>>
 ChooseBestHeapAlgorithm<BufferType>::Finish() {
   DCHECK(!algorithms_.empty());
-  std::vector<Result> results(algorithms_.size());
+  std::vector<absl::StatusOr<Result>> results(algorithms_.size());
+  if (thread_pool_ != nullptr && algorithms_.size() > 1) {
+    // The algorithms only share the buffers, which they don't modify.
+    absl::BlockingCounter counter(algorithms_.size());
+    for (int i = 0; i < algorithms_.size(); ++i) {
+      thread_pool_->Schedule([this, i, &results, &counter] {
+        results[i] = algorithms_[i]->Finish();
+        counter.DecrementCount();
+      });
+    }
+    counter.Wait();
+  } else {
+    for (int i = 0; i < algorithms_.size(); ++i) {
+      results[i] = algorithms_[i]->Finish();
+    }
+  }
+
   int64_t min_size = INT64_MAX;
   int min_size_index = -1;
   for (int i = 0; i < algorithms_.size(); ++i) {
-    TF_ASSIGN_OR_RETURN(results[i], algorithms_[i]->Finish());
-    if (results[i].heap_size < min_size) {
-      min_size = results[i].heap_size;
+    TF_RETURN_IF_ERROR(results[i].status());
+    if (results[i]->heap_size < min_size) {
+      min_size = results[i]->heap_size;
       min_size_index = i;
     }
   }
 
   DCHECK_GE(min_size_index, 0);
-  return results[min_size_index];
+  return *std::move(results[min_size_index]);
 }
 
 BreadthFirstMidpointIterator::BreadthFirstMidpointIterator(int start, int end)
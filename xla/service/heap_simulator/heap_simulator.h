@@ -49,6 +49,7 @@ limitations under the License.
 #include "xla/service/hlo.pb.h"
 #include "xla/service/hlo_value.h"
 #include "xla/service/logical_buffer.h"
+#include "xla/tsl/platform/threadpool.h"
 
 namespace xla {
 
@@ -1011,10 +1012,12 @@ class ChooseBestHeapAlgorithm : public HeapAlgorithm<BufferType> {
  public:
   using Result = HeapSimulator::Result<BufferType>;
 
+  // If `thread_pool` is not null, the algorithms finish concurrently on it.
   ChooseBestHeapAlgorithm(
       std::unique_ptr<std::vector<std::unique_ptr<HeapAlgorithm<BufferType>>>>
-          algorithms)
-      : algorithms_(std::move(*algorithms)) {}
+          algorithms,
+      tsl::thread::ThreadPool* thread_pool = nullptr)
+      : algorithms_(std::move(*algorithms)), thread_pool_(thread_pool) {}
   ~ChooseBestHeapAlgorithm() override {}
 
   void Alloc(const BufferType* buffer, int64_t size) override {
@@ -1040,6 +1043,7 @@ class ChooseBestHeapAlgorithm : public HeapAlgorithm<BufferType> {
 
  private:
   std::vector<std::unique_ptr<HeapAlgorithm<BufferType>>> algorithms_;
+  tsl::thread::ThreadPool* thread_pool_;
 };
 
 // An iterator that produces every integer in [start, end], starting with the
@@ -26,6 +26,7 @@ limitations under the License.
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/inlined_vector.h"
+#include "absl/status/statusor.h"
 #include "absl/strings/str_format.h"
 #include "absl/types/span.h"
 #include "xla/comparison_util.h"
@@ -46,9 +47,11 @@ limitations under the License.
 #include "xla/shape.h"
 #include "xla/shape_util.h"
 #include "xla/tsl/lib/core/status_test_util.h"
+#include "xla/tsl/platform/env.h"
 #include "xla/tsl/platform/logging.h"
 #include "xla/tsl/platform/statusor.h"
 #include "xla/tsl/platform/test.h"
+#include "xla/tsl/platform/threadpool.h"
 #include "xla/xla_data.pb.h"
 
 namespace xla {
@@ -1391,6 +1394,51 @@ TEST_F(GlobalDecreasingSizeBestFitHeapTest, ColocatedDifferentSize2) {
   EXPECT_EQ(0, result.chunk_map.at(buffer_c_).offset);
 }
 
+class ChooseBestHeapAlgorithmTest : public HeapAlgorithmTestBase {
+ protected:
+  absl::StatusOr<HeapSimulator::Result<HloValue>> Run(
+      tsl::thread::ThreadPool* thread_pool) {
+    auto algorithms = std::make_unique<
+        std::vector<std::unique_ptr<HeapAlgorithm<HloValue>>>>();
+    algorithms->push_back(
+        std::make_unique<GlobalDecreasingSizeBestFitHeap<HloValue>>(
+            /*alignment=*/1,
+            GlobalDecreasingSizeBestFitHeap<HloValue>::kSpatial));
+    algorithms->push_back(
+        std::make_unique<GlobalDecreasingSizeBestFitHeap<HloValue>>(
+            /*alignment=*/1,
+            GlobalDecreasingSizeBestFitHeap<HloValue>::kTemporal));
+    ChooseBestHeapAlgorithm<HloValue> heap(std::move(algorithms),
+                                           thread_pool);
+    heap.Alloc(buffer_a_, 10);
+    heap.Alloc(buffer_b_, 30);
+    heap.Free(buffer_a_, 10);
+    heap.Alloc(buffer_c_, 20);
+    heap.Free(buffer_b_, 30);
+    heap.Alloc(buffer_d_, 40);
+    heap.Free(buffer_c_, 20);
+    heap.Free(buffer_d_, 40);
+    return heap.Finish();
+  }
+};
+
+TEST_F(ChooseBestHeapAlgorithmTest, ThreadPoolGivesTheSameResult) {
+  TF_ASSERT_OK_AND_ASSIGN(const HeapSimulator::Result<HloValue> sequential,
+                          Run(/*thread_pool=*/nullptr));
+  tsl::thread::ThreadPool thread_pool(tsl::Env::Default(), "test",
+                                      /*num_threads=*/2);
+  TF_ASSERT_OK_AND_ASSIGN(const HeapSimulator::Result<HloValue> parallel,
+                          Run(&thread_pool));
+
+  EXPECT_EQ(sequential.heap_size, parallel.heap_size);
+  ASSERT_EQ(parallel.heap_results.size(), 1);
+  for (const HloValue* buffer :
+       {buffer_a_, buffer_b_, buffer_c_, buffer_d_}) {
+    EXPECT_EQ(sequential.heap_results[0].chunk_map.at(buffer),
+              parallel.heap_results[0].chunk_map.at(buffer));
+  }
+}
+
 class FindGlobalDecreasingSizeBestFitTest : public HeapAlgorithmTestBase {
  protected:
   class InheritedGlobalDecreasingSizeBestFitHeap
@@ -36,6 +36,7 @@ limitations under the License.
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_opcode.h"
 #include "xla/hlo/ir/hlo_original_value.h"
+#include "xla/hlo/ir/hlo_sharding.h"
 #include "xla/hlo/testlib/hlo_hardware_independent_test_base.h"
 #include "xla/hlo/testlib/test.h"
 #include "xla/hlo/testlib/verified_hlo_module.h"
@@ -50,7 +51,9 @@ limitations under the License.
 #include "xla/shape_util.h"
 #include "xla/tsl/lib/core/status_test_util.h"
 #include "xla/tsl/lib/strings/proto_serialization.h"
+#include "xla/tsl/platform/env.h"
 #include "xla/tsl/platform/statusor.h"
+#include "xla/tsl/platform/threadpool.h"
 #include "xla/xla.pb.h"
 #include "xla/xla_data.pb.h"
 #include "tsl/platform/casts.h"
@@ -369,6 +372,46 @@ TEST_F(HloModuleTest, UniqueModuleId) {
   EXPECT_NE(module_a->unique_id(), module_b->unique_id());
 }
 
+TEST_F(HloModuleTest, CachedFingerprint) {
+  const std::string text = R"(
+HloModule m
+
+add {
+  a = f32[] parameter(0)
+  b = f32[] parameter(1)
+  ROOT r = f32[] add(a, b)
+}
+
+ENTRY main {
+  x = f32[8] parameter(0)
+  y = f32[8] parameter(1)
+  z = f32[] constant(0)
+  r = f32[] reduce(x, z), dimensions={0}, to_apply=add
+  ROOT s = f32[] reduce(y, z), dimensions={0}, to_apply=add
+}
+)";
+  TF_ASSERT_OK_AND_ASSIGN(auto module_a, ParseAndReturnVerifiedModule(text));
+  TF_ASSERT_OK_AND_ASSIGN(auto module_b, ParseAndReturnVerifiedModule(text));
+  EXPECT_EQ(module_a->ToCachedFingerprint(), module_b->ToCachedFingerprint());
+
+  HloComputation* entry = module_b->entry_computation();
+  HloComputation* add = FindComputation(module_b.get(), "add");
+  const uint64_t entry_fingerprint = entry->fingerprint();
+  const uint64_t add_fingerprint = add->fingerprint();
+  HloInstruction* root = entry->root_instruction();
+  TF_ASSERT_OK(root->ReplaceOperandWith(0, entry->parameter_instruction(0)));
+  EXPECT_NE(entry->fingerprint(), entry_fingerprint);
+  EXPECT_EQ(add->fingerprint(), add_fingerprint);
+  EXPECT_NE(module_a->ToCachedFingerprint(), module_b->ToCachedFingerprint());
+
+  TF_ASSERT_OK(root->ReplaceOperandWith(0, entry->parameter_instruction(1)));
+  EXPECT_EQ(entry->fingerprint(), entry_fingerprint);
+  EXPECT_EQ(module_a->ToCachedFingerprint(), module_b->ToCachedFingerprint());
+
+  root->set_sharding(HloSharding::Replicate());
+  EXPECT_NE(entry->fingerprint(), entry_fingerprint);
+}
+
 TEST_F(HloModuleTest, ProtoSerializationWithoutSchedule) {
   const std::string text = R"(
 HloModule axpy_module
@@ -390,6 +433,63 @@ ENTRY %axpy.v5 (alpha: f32[], x: f32[2,4], y: f32[2,4]) -> f32[2,4] {
   ASSERT_FALSE(module_copy->has_schedule());
 }
 
+TEST_F(HloModuleTest, ProtoSerializationWithThreadPool) {
+  const std::string text = R"(
+HloModule m
+
+add {
+  a = f32[] parameter(0)
+  b = f32[] parameter(1)
+  ROOT r = f32[] add(a, b)
+}
+
+fused_reduce {
+  p = f32[8] parameter(0)
+  zero = f32[] constant(0)
+  ROOT r = f32[] reduce(p, zero), dimensions={0}, to_apply=add
+}
+
+cond {
+  t = (s32[], f32[8]) parameter(0)
+  i = s32[] get-tuple-element(t), index=0
+  n = s32[] constant(4)
+  ROOT lt = pred[] compare(i, n), direction=LT
+}
+
+body {
+  t = (s32[], f32[8]) parameter(0)
+  i = s32[] get-tuple-element(t), index=0
+  one = s32[] constant(1)
+  next = s32[] add(i, one)
+  x = f32[8] get-tuple-element(t), index=1
+  y = f32[8] negate(x)
+  ROOT r = (s32[], f32[8]) tuple(next, y)
+}
+
+ENTRY main {
+  x = f32[8] parameter(0)
+  zero = s32[] constant(0)
+  init = (s32[], f32[8]) tuple(zero, x)
+  loop = (s32[], f32[8]) while(init), condition=cond, body=body
+  y = f32[8] get-tuple-element(loop), index=1
+  s = f32[] fusion(y), kind=kLoop, calls=fused_reduce
+  z = f32[] constant(0)
+  t = f32[] reduce(x, z), dimensions={0}, to_apply=add
+  ROOT sum = f32[] add(s, t)
+}
+)";
+  TF_ASSERT_OK_AND_ASSIGN(auto module, ParseAndReturnVerifiedModule(text));
+  tsl::thread::ThreadPool thread_pool(tsl::Env::Default(), "test",
+                                      /*num_threads=*/4);
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto module_copy,
+      HloModule::CreateFromProto(module->ToProto(), module->config(),
+                                 /*prohibit_empty_literal=*/true,
+                                 /*comp_envs=*/nullptr, &thread_pool));
+  EXPECT_EQ(module_copy->ToString(), module->ToString());
+  TF_ASSERT_OK(verifier().Run(module_copy.get()).status());
+}
+
 TEST_F(HloModuleTest, ProtoSerializationWithSchedule) {
   const std::string text = R"(
 HloModule axpy_module, is_scheduled=true
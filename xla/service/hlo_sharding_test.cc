@@ -15,6 +15,7 @@ limitations under the License.
 
 #include <algorithm>
 #include <cstdint>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <tuple>
@@ -475,6 +476,36 @@ TEST_F(HloShardingTest, Hash) {
   }
 }
 
+TEST_F(HloShardingTest, InternerSharesEqualShardings) {
+  HloShardingInterner interner;
+  std::shared_ptr<const HloSharding> sharding =
+      interner.Intern(std::make_shared<const HloSharding>(
+          HloSharding::IotaTile({4, 2}, {2, 4}, {1, 0})));
+  std::shared_ptr<const HloSharding> equal_sharding =
+      interner.Intern(std::make_shared<const HloSharding>(HloSharding::Tile(
+          MakeArray({4, 2}, {0, 4, 1, 5, 2, 6, 3, 7}))));
+  std::shared_ptr<const HloSharding> other_sharding =
+      interner.Intern(std::make_shared<const HloSharding>(
+          HloSharding::IotaTile({4, 2})));
+  EXPECT_EQ(sharding, equal_sharding);
+  EXPECT_NE(sharding, other_sharding);
+  EXPECT_EQ(interner.size(), 2);
+}
+
+TEST_F(HloShardingTest, InternerKeepsMetadata) {
+  HloShardingInterner interner;
+  std::shared_ptr<const HloSharding> sharding =
+      interner.Intern(std::make_shared<const HloSharding>(
+          HloSharding::Replicate({GetMetadata("a")})));
+  std::shared_ptr<const HloSharding> other_sharding =
+      interner.Intern(std::make_shared<const HloSharding>(
+          HloSharding::Replicate({GetMetadata("b")})));
+  EXPECT_EQ(*sharding, *other_sharding);
+  EXPECT_NE(sharding, other_sharding);
+  ASSERT_EQ(other_sharding->metadata().size(), 1);
+  EXPECT_EQ(other_sharding->metadata()[0].op_name(), "b");
+}
+
 using ShardingWithMetadataParamType =
     std::tuple<std::vector<OpMetadata>, std::string>;
 
@@ -156,6 +156,13 @@ void HloValue::SetPositions(absl::Span<const HloPosition> positions) {
       IsRootOf(defining_instruction()->GetModule()->entry_computation());
 }
 
+void HloValue::ResetPositions(absl::Span<const HloPosition> positions) {
+  positions_.resize(1);
+  uses_ = Lazy<Uses>([this] { return ComputeUses(); });
+  live_out_of_module_ = false;
+  SetPositions(positions);
+}
+
 HloValue::Uses HloValue::ComputeUses() const {
   // Gather the computation roots at which this value appears.
   absl::flat_hash_set<HloInstruction*> root_positions;
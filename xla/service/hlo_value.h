@@ -129,6 +129,11 @@ class HloValue : public BufferValue {
   // 'positions' as this is set at construction time.
   void SetPositions(absl::Span<const HloPosition> positions);
 
+  // Replaces all non-defining positions of the HloValue and invalidates the
+  // lazily computed uses. Used when the dataflow analysis is updated after
+  // the module changed.
+  void ResetPositions(absl::Span<const HloPosition> positions);
+
   // Returns whether this value is a phi value.
   bool is_phi() const { return is_phi_; }
 
@@ -902,24 +902,35 @@ DefaultSchedulerCore::ScheduleCandidate InitializeCandidate(
 
 namespace {
 
-// Find the num hops to the closest selective resource overlap in ready set that
-// provided node can be scheduled in between.
-int64_t GetNumHopsToClosestSelectiveOverlap(
-    const DefaultSchedulerCore::ReadyQueueSet& ready_set,
-    const HloGraphNode* node) {
-  int64_t num_hops_to_closest_selective_resource_occupier =
-      std::numeric_limits<int64_t>::max();
-  for (const HloGraphNode* n : ready_set) {
-    // Skip the node itself.
-    if (n == node) {
-      continue;
+// The two smallest numbers of hops to the closest selective resource occupier
+// over the nodes of a ready set. Allows to find the closest selective overlap
+// in the ready set excluding any given node in constant time.
+struct ClosestSelectiveOverlaps {
+  explicit ClosestSelectiveOverlaps(
+      const DefaultSchedulerCore::ReadyQueueSet& ready_set) {
+    for (const HloGraphNode* n : ready_set) {
+      int64_t num_hops = n->GetNumHopsToClosestSelectiveResourceOccupier();
+      if (num_hops < closest) {
+        second_closest = closest;
+        closest = num_hops;
+        closest_node = n;
+      } else if (num_hops < second_closest) {
+        second_closest = num_hops;
+      }
     }
-    num_hops_to_closest_selective_resource_occupier =
-        std::min(num_hops_to_closest_selective_resource_occupier,
-                 n->GetNumHopsToClosestSelectiveResourceOccupier());
   }
-  return num_hops_to_closest_selective_resource_occupier;
-}
+
+  // Find the num hops to the closest selective resource overlap in ready set
+  // that provided node can be scheduled in between.
+  int64_t GetNumHopsToClosestSelectiveOverlap(const HloGraphNode* node) const {
+    // Skip the node itself.
+    return node == closest_node ? second_closest : closest;
+  }
+
+  int64_t closest = std::numeric_limits<int64_t>::max();
+  int64_t second_closest = std::numeric_limits<int64_t>::max();
+  const HloGraphNode* closest_node = nullptr;
+};
 
 // Comparator for the ready set. This class represents the priority policies
 // for the nodes in the ready set. The policy can be whatever is appropriate to
@@ -1087,10 +1098,18 @@ class ReadySetLt {
   IsValuableForSelectiveOverlap(
       DefaultSchedulerCore::ScheduleCandidate& a,
       DefaultSchedulerCore::ScheduleCandidate& b) const {
+    // The ready set doesn't change while the comparator is alive, so compute
+    // the closest selective overlaps once instead of scanning the ready set
+    // for every comparison.
+    if (!closest_selective_overlaps_.has_value()) {
+      closest_selective_overlaps_.emplace(sched_state_.ready_set);
+    }
     int64_t distance_to_selective_overlap_for_a =
-        GetNumHopsToClosestSelectiveOverlap(sched_state_.ready_set, a.node);
+        closest_selective_overlaps_->GetNumHopsToClosestSelectiveOverlap(
+            a.node);
     int64_t distance_to_selective_overlap_for_b =
-        GetNumHopsToClosestSelectiveOverlap(sched_state_.ready_set, b.node);
+        closest_selective_overlaps_->GetNumHopsToClosestSelectiveOverlap(
+            b.node);
     // If a is valuable for selective overlap and there is a selective
     // overlap in the near future a can be scheduled inside, hold off
     // scheduling a and schedule b instead. Same logic applies in reverse.
@@ -1316,6 +1335,7 @@ class ReadySetLt {
   DefaultSchedulerCore::TargetSchedulingRule early_target_scheduling_rule_;
   DefaultSchedulerCore::OverlapLimitRule
       scheduling_instruction_crosses_overlap_limit_;
+  mutable std::optional<ClosestSelectiveOverlaps> closest_selective_overlaps_;
 
   static bool IsNop(const HloGraphNode& gn) {
     return IsNopInstruction(gn.GetInstr());
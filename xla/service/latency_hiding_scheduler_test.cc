@@ -33,11 +33,15 @@ limitations under the License.
 #include "absl/log/check.h"
 #include "absl/log/log.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/str_join.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/span.h"
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_opcode.h"
 #include "xla/hlo/ir/hlo_schedule.h"
+#include "xla/hlo/parser/hlo_parser.h"
 #include "xla/hlo/testlib/hlo_hardware_independent_test_base.h"
 #include "xla/hlo/testlib/test_helpers.h"
 #include "xla/hlo/transforms/collectives/async_collective_creator.h"
@@ -48,6 +52,7 @@ limitations under the License.
 #include "xla/tsl/lib/core/status_test_util.h"
 #include "xla/tsl/platform/statusor.h"
 #include "xla/util.h"
+#include "tsl/platform/test_benchmark.h"
 
 namespace xla {
 
@@ -4500,4 +4505,36 @@ ENTRY entry {
             GetIndex(new_instruction_sequence, "cp2d"));
 }
 
+// Schedules a wide module with `num_chains` independent chains of an
+// all-gather followed by an elementwise op, which keeps the ready set large.
+void BM_ScheduleWideModule(::testing::benchmark::State& state) {
+  const int num_chains = state.range(0);
+
+  std::string hlo_string = "HloModule module, is_scheduled=true\n\n";
+  absl::StrAppend(&hlo_string, "ENTRY %module {\n",
+                  "  p0 = f32[8,256]{1,0} parameter(0)\n");
+  std::vector<std::string> results;
+  for (int i = 0; i < num_chains; ++i) {
+    absl::StrAppendFormat(&hlo_string,
+                          "  ag%d = f32[16,256]{1,0} all-gather(p0), "
+                          "replica_groups={{0,1}}, dimensions={0}\n"
+                          "  n%d = f32[16,256]{1,0} negate(ag%d)\n",
+                          i, i, i);
+    results.push_back(absl::StrCat("n", i));
+  }
+  std::vector<std::string> shapes(num_chains, "f32[16,256]{1,0}");
+  absl::StrAppend(&hlo_string, "  ROOT t = (", absl::StrJoin(shapes, ", "),
+                  ") tuple(", absl::StrJoin(results, ", "), ")\n}\n");
+
+  for (auto s : state) {
+    state.PauseTiming();
+    auto hlo_module = ParseAndReturnUnverifiedModule(hlo_string);
+    CHECK_OK(hlo_module.status());
+    state.ResumeTiming();
+    CHECK_OK(RunScheduler(hlo_module->get()).status());
+  }
+}
+
+BENCHMARK(BM_ScheduleWideModule)->Arg(256)->Arg(1024)->Arg(4096);
+
 }  // namespace xla
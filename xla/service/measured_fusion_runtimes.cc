@@ -0,0 +1,90 @@
+/* Copyright 2023 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+
+#include "xla/service/measured_fusion_runtimes.h"
+
+#include <optional>
+#include <string>
+
+#include "absl/log/check.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/time/time.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/hlo/ir/hlo_print_options.h"
+#include "xla/tsl/platform/env.h"
+#include "xla/tsl/platform/errors.h"
+#include "tsl/platform/fingerprint.h"
+#include "tsl/platform/path.h"
+#include "tsl/profiler/protobuf/profiled_instructions.pb.h"
+
+namespace xla {
+
+std::string GetFusionCostName(const HloInstruction& fusion) {
+  CHECK_EQ(fusion.opcode(), HloOpcode::kFusion);
+  std::string fingerprint = absl::StrCat(
+      ToString(fusion.fusion_kind()), ":",
+      fusion.fused_instructions_computation()->ToString(
+          HloPrintOptions::Fingerprint()));
+  return absl::StrCat(kFusionCostNamePrefix,
+                      absl::Hex(tsl::Fingerprint64(fingerprint),
+                                absl::kZeroPad16));
+}
+
+MeasuredFusionRuntimes::MeasuredFusionRuntimes(
+    const tensorflow::profiler::ProfiledInstructionsProto& profile) {
+  for (const auto& cost : profile.costs()) {
+    if (absl::StartsWith(cost.name(), kFusionCostNamePrefix)) {
+      runtimes_[cost.name()] = absl::Microseconds(cost.cost_us());
+    }
+  }
+}
+
+absl::StatusOr<MeasuredFusionRuntimes> MeasuredFusionRuntimes::Load(
+    absl::string_view path) {
+  tensorflow::profiler::ProfiledInstructionsProto profile;
+  std::string file_name(path);
+  absl::string_view extension = tsl::io::Extension(path);
+  if (extension == "pbtxt") {
+    TF_RETURN_IF_ERROR(
+        tsl::ReadTextProto(tsl::Env::Default(), file_name, &profile));
+  } else if (extension == "pb") {
+    TF_RETURN_IF_ERROR(
+        tsl::ReadBinaryProto(tsl::Env::Default(), file_name, &profile));
+  } else {
+    return absl::InvalidArgumentError(absl::StrCat(
+        "Expected a .pb or .pbtxt fusion profile, got: ", path));
+  }
+  return MeasuredFusionRuntimes(profile);
+}
+
+std::optional<absl::Duration> MeasuredFusionRuntimes::Get(
+    const HloInstruction& fusion) const {
+  if (runtimes_.empty() || fusion.opcode() != HloOpcode::kFusion) {
+    return std::nullopt;
+  }
+  if (auto it = runtimes_.find(GetFusionCostName(fusion));
+      it != runtimes_.end()) {
+    return it->second;
+  }
+  return std::nullopt;
+}
+
+}  // namespace xla
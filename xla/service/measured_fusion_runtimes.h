@@ -0,0 +1,66 @@
+/* Copyright 2023 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+
+#ifndef XLA_SERVICE_MEASURED_FUSION_RUNTIMES_H_
+#define XLA_SERVICE_MEASURED_FUSION_RUNTIMES_H_
+
+#include <optional>
+#include <string>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/time/time.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "tsl/profiler/protobuf/profiled_instructions.pb.h"
+
+namespace xla {
+
+// Prefix of the cost names of measured fusion runtimes in a
+// `ProfiledInstructionsProto`.
+inline constexpr absl::string_view kFusionCostNamePrefix =
+    "fusion_fingerprint:";
+
+// Returns the cost name under which the measured runtime of `fusion` is stored
+// in a `ProfiledInstructionsProto`. Unlike instruction names, it only depends
+// on the fused computation and the fusion kind, so it identifies the same
+// fusion across compilations and across modules.
+std::string GetFusionCostName(const HloInstruction& fusion);
+
+// Measured runtimes of fusions, looked up by the fusion cost names of a
+// `ProfiledInstructionsProto`.
+class MeasuredFusionRuntimes {
+ public:
+  // Keeps the costs of `profile` that are keyed by fusion cost names, other
+  // costs are ignored.
+  explicit MeasuredFusionRuntimes(
+      const tensorflow::profiler::ProfiledInstructionsProto& profile);
+
+  // Reads the profile from a text (.pbtxt) or binary (.pb) proto file.
+  static absl::StatusOr<MeasuredFusionRuntimes> Load(absl::string_view path);
+
+  // Returns the measured runtime of `fusion`, if it is in the profile.
+  std::optional<absl::Duration> Get(const HloInstruction& fusion) const;
+
+  bool empty() const { return runtimes_.empty(); }
+
+ private:
+  absl::flat_hash_map<std::string, absl::Duration> runtimes_;
+};
+
+}  // namespace xla
+
+#endif  // XLA_SERVICE_MEASURED_FUSION_RUNTIMES_H_
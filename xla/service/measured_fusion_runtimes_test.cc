@@ -0,0 +1,98 @@
+/* Copyright 2023 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+
+#include "xla/service/measured_fusion_runtimes.h"
+
+#include <memory>
+#include <optional>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/strings/string_view.h"
+#include "absl/time/time.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/testlib/hlo_hardware_independent_test_base.h"
+#include "xla/tsl/platform/statusor.h"
+#include "tsl/profiler/protobuf/profiled_instructions.pb.h"
+
+namespace xla {
+namespace {
+
+using ::testing::Optional;
+using MeasuredFusionRuntimesTest = HloHardwareIndependentTestBase;
+
+constexpr absl::string_view kHlo = R"(
+HloModule m
+
+fused_exp {
+  p0 = f32[1024] parameter(0)
+  ROOT exp = f32[1024] exponential(p0)
+}
+
+exp_computation {
+  p0 = f32[1024] parameter(0)
+  ROOT exp = f32[1024] exponential(p0)
+}
+
+fused_negate {
+  p0 = f32[1024] parameter(0)
+  ROOT neg = f32[1024] negate(p0)
+}
+
+ENTRY e {
+  p0 = f32[1024] parameter(0)
+  a = f32[1024] fusion(p0), kind=kLoop, calls=fused_exp
+  b = f32[1024] fusion(a), kind=kLoop, calls=exp_computation
+  ROOT c = f32[1024] fusion(b), kind=kLoop, calls=fused_negate
+})";
+
+TEST_F(MeasuredFusionRuntimesTest, CostNameOnlyDependsOnTheFusedComputation) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(kHlo));
+  const HloInstruction* a = FindInstruction(module.get(), "a");
+  const HloInstruction* b = FindInstruction(module.get(), "b");
+  const HloInstruction* c = FindInstruction(module.get(), "c");
+
+  EXPECT_EQ(GetFusionCostName(*a), GetFusionCostName(*b));
+  EXPECT_NE(GetFusionCostName(*a), GetFusionCostName(*c));
+}
+
+TEST_F(MeasuredFusionRuntimesTest, GetsMeasuredRuntimeOfFusions) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(kHlo));
+  const HloInstruction* a = FindInstruction(module.get(), "a");
+  const HloInstruction* c = FindInstruction(module.get(), "c");
+
+  tensorflow::profiler::ProfiledInstructionsProto profile;
+  auto* cost = profile.add_costs();
+  cost->set_name(GetFusionCostName(*a));
+  cost->set_cost_us(10.0);
+  // Costs keyed by instruction name are ignored.
+  cost = profile.add_costs();
+  cost->set_name("c");
+  cost->set_cost_us(20.0);
+
+  MeasuredFusionRuntimes runtimes(profile);
+  EXPECT_THAT(runtimes.Get(*a), Optional(absl::Microseconds(10)));
+  EXPECT_EQ(runtimes.Get(*c), std::nullopt);
+  EXPECT_EQ(runtimes.Get(*module->entry_computation()->parameter_instruction(
+                0)),
+            std::nullopt);
+}
+
+}  // namespace
+}  // namespace xla
@@ -356,6 +356,17 @@ CrossProgramPrefetches FindCrossProgramPrefetches(
   absl::c_sort(cross_program_prefetches.candidates,
                comparator->GetComparisonFunctor());
 
+  // With a byte budget, prefer the candidates that save the most reads per
+  // byte of the alternate memory, which is their number of uses.
+  if (options.max_cross_program_prefetch_bytes >= 0) {
+    absl::c_stable_sort(cross_program_prefetches.candidates,
+                        [](const MsaBufferInterval& a,
+                           const MsaBufferInterval& b) {
+                          return a.buffer->GetUses().size() >
+                                 b.buffer->GetUses().size();
+                        });
+  }
+
   VLOG(3) << "Cross-program prefetch candidates: "
           << cross_program_prefetches.candidates.size()
           << ". Sorting criteria: " << comparator->DescribeComparisonCriteria();
@@ -2006,6 +2017,7 @@ absl::StatusOr<HeapSimulator::Result<HloValue>> MsaAlgorithm::Finish() {
     AllocateCrossProgramPrefetchBuffer(module, prefetch);
   }
   if (options_.enable_cross_program_prefetch) {
+    int64_t cross_program_prefetch_bytes = 0;
     for (auto& prefetch_candidate : cross_program_prefetches.candidates) {
       HloModule* module = prefetch_candidate.buffer->instruction()->GetModule();
       if (0 <= options().max_cross_program_prefetches &&
@@ -2013,7 +2025,19 @@ absl::StatusOr<HeapSimulator::Result<HloValue>> MsaAlgorithm::Finish() {
               module->CrossProgramPrefetches().size()) {
         break;
       }
+      if (0 <= options().max_cross_program_prefetch_bytes &&
+          options().max_cross_program_prefetch_bytes <
+              cross_program_prefetch_bytes + prefetch_candidate.size) {
+        VLOG(3) << "Skipping cross-program prefetch candidate exceeding the "
+                   "byte budget: "
+                << prefetch_candidate.buffer->ToShortString();
+        continue;
+      }
+      int64_t num_prefetches = module->CrossProgramPrefetches().size();
       AllocateCrossProgramPrefetchBuffer(module, prefetch_candidate);
+      if (module->CrossProgramPrefetches().size() > num_prefetches) {
+        cross_program_prefetch_bytes += prefetch_candidate.size;
+      }
     }
   }
 
@@ -10805,6 +10805,62 @@ TEST_F(MemorySpaceAssignmentTest, MultiCrossProgramPrefetchTest) {
                             op::Parameter(2))));
 }
 
+TEST_F(MemorySpaceAssignmentTest, MultiCrossProgramPrefetchByteBudgetTest) {
+  HloComputation::Builder builder(TestName());
+
+  constexpr int kBatch = 8;
+  constexpr int kFeature = 8;
+  constexpr int kFirstOutput = 4;
+  constexpr int kSecondOutput = 2;
+
+  auto lhs_shape = ShapeUtil::MakeShape(F32, {kBatch, kFeature});
+  auto first_weight_shape = ShapeUtil::MakeShape(F32, {kFeature, kFirstOutput});
+  auto second_weight_shape =
+      ShapeUtil::MakeShape(F32, {kFirstOutput, kSecondOutput});
+  auto intermediate_shape = ShapeUtil::MakeShape(F32, {kBatch, kFirstOutput});
+  auto result_shape = ShapeUtil::MakeShape(F32, {kBatch, kSecondOutput});
+  HloInstruction* lhs = builder.AddInstruction(
+      HloInstruction::CreateParameter(0, lhs_shape, "lhs"));
+  HloInstruction* first_weight = builder.AddInstruction(
+      HloInstruction::CreateParameter(1, first_weight_shape, "first_weight"));
+  HloInstruction* second_weight = builder.AddInstruction(
+      HloInstruction::CreateParameter(2, second_weight_shape, "second_weight"));
+
+  DotDimensionNumbers dot_dnums;
+  dot_dnums.add_lhs_contracting_dimensions(1);
+  dot_dnums.add_rhs_contracting_dimensions(0);
+  auto first_dot = builder.AddInstruction(
+      HloInstruction::CreateDot(intermediate_shape, lhs, first_weight,
+                                dot_dnums, DefaultPrecisionConfig(2)));
+
+  auto second_dot = builder.AddInstruction(
+      HloInstruction::CreateDot(result_shape, first_dot, second_weight,
+                                dot_dnums, DefaultPrecisionConfig(2)));
+
+  auto module = CreateNewVerifiedModule();
+  HloComputation* computation = module->AddEntryComputation(builder.Build());
+
+  HloSchedule schedule(module.get());
+  schedule.set_sequence(
+      computation, {lhs, first_weight, second_weight, first_dot, second_dot});
+  TF_CHECK_OK(module->set_schedule(schedule));
+
+  // The first weight (128 bytes) doesn't fit in the budget, so the second
+  // weight (32 bytes) is prefetched instead.
+  Options options = DefaultMemorySpaceOptions();
+  options.max_cross_program_prefetches = -1;
+  options.max_cross_program_prefetch_bytes = 64;
+  options.max_size_in_bytes = 256;
+  options.alignment_in_bytes = 8;
+  options.verify = true;
+  AssignMemorySpace(module.get(), options);
+
+  auto cross_program_prefetches = module->CrossProgramPrefetches();
+  ASSERT_EQ(cross_program_prefetches.size(), 1);
+  EXPECT_EQ(cross_program_prefetches[0].parameter, 2);
+  EXPECT_EQ(cross_program_prefetches[0].index, ShapeIndex({}));
+}
+
 TEST_F(MemorySpaceAssignmentTest, CrossProgramPrefetchTupleTest) {
   HloComputation::Builder builder(TestName());
 
@@ -299,6 +299,13 @@ struct Options {
   // TODO(tjablin): Use a heuristic to determine this automatically.
   int max_cross_program_prefetches = 1;
 
+  // If non-negative, the maximum total size in bytes of the cross-program
+  // prefetch candidates picked automatically (user annotated prefetches are not
+  // counted). Candidates are then picked greedily as in a knapsack problem, by
+  // decreasing number of uses, i.e. reads from the alternate memory saved per
+  // byte, skipping candidates that don't fit in the remaining bytes.
+  int64_t max_cross_program_prefetch_bytes = -1;
+
   // If false, we assume tensors that we couldn't explicitly determine to be
   // activations are activations. If true, we assume these aren't activations,
   // so they may be cross-program-prefetch candidates.
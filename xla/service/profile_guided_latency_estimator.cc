@@ -28,6 +28,7 @@ limitations under the License.
 #include "xla/hlo/ir/hlo_opcode.h"
 #include "xla/hlo/utils/hlo_query.h"
 #include "xla/service/latency_hiding_scheduler.h"
+#include "xla/service/measured_fusion_runtimes.h"
 #include "tsl/profiler/protobuf/profiled_instructions.pb.h"
 
 namespace xla {
@@ -147,6 +148,16 @@ LatencyEstimator::TimeCost ProfileGuidedLatencyEstimator::NodeCost(
     HandleFoundInstructionCost(aggregator_.get(), instr);
     return *it->second.cost;
   }
+  // Fall back to the measured runtime of the same fusion, which may have been
+  // profiled under a different name or in a different module.
+  if (instr->opcode() == HloOpcode::kFusion) {
+    if (auto it = instr_map_.find(GetFusionCostName(*instr));
+        it != instr_map_.end() && it->second.cost.has_value()) {
+      VLOG(2) << "PGLE found fusion cost for: " << instr->name();
+      HandleFoundInstructionCost(aggregator_.get(), instr);
+      return *it->second.cost;
+    }
+  }
   VLOG(1) << "PGLE missed cost for: " << instr->name();
   HandleMissingInstructionCost(aggregator_.get(), instr);
   return latency_estimator_->NodeCost(instr);
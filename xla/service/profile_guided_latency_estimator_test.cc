@@ -31,6 +31,7 @@ limitations under the License.
 #include "xla/hlo/ir/hlo_schedule.h"
 #include "xla/hlo/testlib/hlo_hardware_independent_test_base.h"
 #include "xla/service/latency_hiding_scheduler.h"
+#include "xla/service/measured_fusion_runtimes.h"
 #include "xla/tsl/lib/core/status_test_util.h"
 #include "tsl/platform/protobuf.h"
 #include "tsl/platform/statusor.h"
@@ -297,4 +298,37 @@ TEST_F(ProfileGuidedLatencyEstimatorTest,
               StatusIs(absl::StatusCode::kFailedPrecondition));
 }
 
+TEST_F(ProfileGuidedLatencyEstimatorTest,
+       ProfileGuidedLatencyEstimatorFallsBackToFusionCost) {
+  absl::string_view kHloModule = R"(
+    HloModule module
+
+    fused_negate {
+      p0 = f32[1024] parameter(0)
+      ROOT neg = f32[1024] negate(p0)
+    }
+
+    ENTRY main {
+      p0 = f32[1024] parameter(0)
+      ROOT fusion.renamed = f32[1024] fusion(p0), kind=kLoop,
+        calls=fused_negate
+    }
+)";
+
+  TF_ASSERT_OK_AND_ASSIGN(auto hlo_module,
+                          ParseAndReturnVerifiedModule(kHloModule));
+  const HloInstruction* fusion =
+      hlo_module->entry_computation()->root_instruction();
+  tensorflow::profiler::ProfiledInstructionsProto fdo_profile;
+  auto* cost = fdo_profile.add_costs();
+  cost->set_name(GetFusionCostName(*fusion));
+  cost->set_cost_us(42.0);
+
+  auto sched_config = GetDefaultSchedConfig();
+  auto latency_estimator = std::make_unique<ProfileGuidedLatencyEstimator>(
+      sched_config, std::make_unique<ApproximateLatencyEstimator>(),
+      fdo_profile);
+  EXPECT_EQ(latency_estimator->NodeCost(fusion), 42.0);
+}
+
 }  // namespace xla
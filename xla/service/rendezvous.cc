@@ -19,6 +19,7 @@ limitations under the License.
 #include <cstddef>
 #include <cstdint>
 #include <limits>
+#include <thread>  // NOLINT
 
 #include "absl/strings/str_format.h"
 #include "absl/strings/string_view.h"
@@ -30,10 +31,35 @@ limitations under the License.
 namespace xla {
 namespace internal {
 
+// How long a participant spins waiting for the rendezvous to be ready before
+// parking on a condition variable. Small rendezvous usually complete within a
+// few microseconds once the last participant arrives, which is less than it
+// takes to wake up a parked thread.
+static constexpr absl::Duration kSpinTimeout = absl::Microseconds(20);
+
+// Spins for up to `kSpinTimeout` waiting for the rendezvous to be ready.
+// Returns true if the rendezvous is ready.
+static bool SpinUntilReady(RendezvousStateSynchronization& state) {
+  absl::Time deadline = absl::Now() + kSpinTimeout;
+  do {
+    for (int i = 0; i < 64; ++i) {
+      if (state.ready.load(std::memory_order_acquire)) {
+        return true;
+      }
+    }
+    std::this_thread::yield();
+  } while (absl::Now() < deadline);
+  return state.ready.load(std::memory_order_acquire);
+}
+
 // Waits for the rendezvous to be ready with a timeout. Returns true if the
 // rendezvous is ready, false if the timeout is exceeded.
 static bool WaitForReadyWithTimeout(RendezvousStateSynchronization& state,
                                     absl::Duration timeout) {
+  if (SpinUntilReady(state)) {
+    return true;
+  }
+
   absl::MutexLock lock(&state.mutex);
 
   // Keep checking if the rendezvous is ready inside a loop and update TraceMe
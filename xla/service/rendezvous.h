@@ -192,8 +192,9 @@ struct RendezvousStateSynchronization {
   absl::Mutex mutex;
   absl::CondVar cv;
 
-  // Signals availability of `result`.
-  bool ready ABSL_GUARDED_BY(mutex);
+  // Signals availability of `result`. Waiting participants first spin on this
+  // flag and only then park on `cv`, so it is written with `mutex` held.
+  std::atomic<bool> ready;
 };
 
 // A state for a single round of rendezvous. We expect exactly `num_treads` to
@@ -322,8 +323,12 @@ absl::StatusOr<std::shared_ptr<R>> Rendezvous(
         {{"num_threads", num_threads}, {"name", name}, {"id", id}});
   });
 
-  // Signal all waiting threads that new participant has arrived.
-  state->cv.SignalAll();
+  // Signal all waiting threads that new participant has arrived. This only
+  // updates the trace annotations of the waiting threads, so we skip waking
+  // them up when tracing is off.
+  if (tsl::profiler::TraceMe::Active()) {
+    state->cv.SignalAll();
+  }
 
   // std::vector::operator[] creates data races, so we rely on data pointer
   // here and when we create an absl::Span below.
@@ -347,8 +352,8 @@ absl::StatusOr<std::shared_ptr<R>> Rendezvous(
     // Last thread to arrive executes the function and completes rendezvous by
     // making result available to all participants. All other participants will
     // be notified via `state->ready` flag when result is ready, and we rely on
-    // the mutex to create a memory barrier that makes access to `state->result`
-    // safe without any extra synchronization.
+    // its release store to make access to `state->result` safe without any
+    // extra synchronization.
     tsl::profiler::TraceMe trace("InvokeRendezvous");
     absl::Span<const V*> values(state->values.data(), num_threads);
 
@@ -362,7 +367,7 @@ absl::StatusOr<std::shared_ptr<R>> Rendezvous(
     // Switch `ready` flag to signal all participants that result is ready.
     {
       absl::MutexLock lock(&state->mutex);
-      state->ready = true;
+      state->ready.store(true, std::memory_order_release);
     }
 
     // Notify awaiting participants that result is ready.
@@ -347,7 +347,8 @@ BENCHMARK(BM_Rendezvous)
     ->Arg(4)
     ->Arg(8)
     ->Arg(16)
-    ->Arg(32);
+    ->Arg(32)
+    ->Arg(64);
 
 BENCHMARK(BM_RendezvousWithValues)
     ->MeasureProcessCPUTime()
@@ -355,7 +356,8 @@ BENCHMARK(BM_RendezvousWithValues)
     ->Arg(4)
     ->Arg(8)
     ->Arg(16)
-    ->Arg(32);
+    ->Arg(32)
+    ->Arg(64);
 
 BENCHMARK(BM_GroupedRendezvous)
     ->MeasureProcessCPUTime()
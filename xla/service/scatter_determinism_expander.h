@@ -16,7 +16,10 @@ limitations under the License.
 #ifndef XLA_SERVICE_SCATTER_DETERMINISM_EXPANDER_H_
 #define XLA_SERVICE_SCATTER_DETERMINISM_EXPANDER_H_
 
+#include <utility>
+
 #include "xla/hlo/transforms/expanders/op_expander_pass.h"
+#include "xla/util.h"
 
 namespace xla {
 
@@ -26,7 +29,10 @@ namespace xla {
 // duplicated indices and hence the results are guaranteed to be deterministic.
 class ScatterDeterminismExpander : public OpExpanderPass {
  public:
-  explicit ScatterDeterminismExpander() = default;
+  // extra_filter: Optional predicate restricting the scatters that are
+  // expanded, see OpExpanderPass.
+  explicit ScatterDeterminismExpander(HloPredicate extra_filter = nullptr)
+      : OpExpanderPass(std::move(extra_filter)) {}
 
   absl::string_view name() const override {
     return "scatter_determinism_expander";
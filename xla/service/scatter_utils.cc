@@ -243,4 +243,33 @@ bool IsScatterDeterministic(const HloScatterInstruction* scatter) {
   }
   return false;
 }
+
+bool IsSortedScatterWithDisjointWindows(const HloScatterInstruction* scatter) {
+  if (scatter->scatter_operand_count() != 1 || !scatter->indices_are_sorted()) {
+    return false;
+  }
+  const ScatterDimensionNumbers& dim_numbers =
+      scatter->scatter_dimension_numbers();
+  if (!dim_numbers.input_batching_dims().empty()) {
+    return false;
+  }
+  const Shape& updates_shape = scatter->scatter_updates().front()->shape();
+  int64_t operand_rank =
+      scatter->scatter_operands().front()->shape().dimensions().size();
+  int64_t window_dim = 0;
+  for (int64_t operand_dim = 0; operand_dim < operand_rank; ++operand_dim) {
+    if (absl::c_linear_search(dim_numbers.inserted_window_dims(),
+                              operand_dim)) {
+      continue;
+    }
+    int64_t window_size = updates_shape.dimensions(
+        dim_numbers.update_window_dims(window_dim++));
+    if (window_size != 1 &&
+        absl::c_linear_search(dim_numbers.scatter_dims_to_operand_dims(),
+                              operand_dim)) {
+      return false;
+    }
+  }
+  return true;
+}
 }  // namespace xla
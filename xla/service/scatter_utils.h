@@ -56,6 +56,12 @@ bool IsScatterCombinerAssociative(const HloComputation* combiner);
 // Checks if the scatter operation is deterministic.
 bool IsScatterDeterministic(const HloScatterInstruction* scatter);
 
+// Checks if the scatter has a single operand, sorted indices and update
+// windows of size 1 in all the operand dimensions that are indexed, so that
+// the windows of different indices never overlap and equal indices are
+// adjacent.
+bool IsSortedScatterWithDisjointWindows(const HloScatterInstruction* scatter);
+
 }  // namespace xla
 
 #endif  // XLA_SERVICE_SCATTER_UTILS_H_
@@ -2849,6 +2849,30 @@ absl::StatusOr<bool> ShardingPropagation::RunToFixPoint(
   absl::flat_hash_set<const HloInstruction*> already_inferred_from_users;
   bool changed_last_iter = true;
   const bool may_merge_partial = is_spmd_ && aggressiveness > 0;
+  // The instructions are not changed while propagating shardings, so their
+  // post orders are computed once.
+  std::vector<std::pair<const HloComputation*, std::vector<HloInstruction*>>>
+      computations;
+  for (const HloComputation* computation :
+       module->computations(execution_threads)) {
+    computations.emplace_back(computation,
+                              computation->MakeInstructionPostOrder());
+  }
+  // Computations to visit in the next iteration: the ones with an instruction
+  // removed from the caches above, or with an instruction retried on every
+  // visit. Visiting any other computation infers nothing new, since all its
+  // instructions are either cached or skipped, so these computations are the
+  // worklist of the fixed point.
+  absl::flat_hash_set<const HloComputation*> dirty_computations;
+  for (const auto& [computation, instructions] : computations) {
+    dirty_computations.insert(computation);
+  }
+  auto invalidate = [&](absl::flat_hash_set<const HloInstruction*>& cache,
+                        const HloInstruction* hlo) {
+    if (cache.erase(hlo) > 0) {
+      dirty_computations.insert(hlo->parent());
+    }
+  };
   while (changed_last_iter) {
     changed_last_iter = false;
     int64_t inferred_from_shard_group_counter = 0;
@@ -2856,32 +2880,39 @@ absl::StatusOr<bool> ShardingPropagation::RunToFixPoint(
     int64_t inferred_from_user_counter = 0;
     int64_t instruction_counter = 0;
     int64_t already_sharded_counter = 0;
-    for (const HloComputation* computation :
-         module->computations(execution_threads)) {
+    int64_t visited_computation_counter = 0;
+    for (const auto& [computation, instructions] : computations) {
+      if (VLOG_IS_ON(1)) {
+        instruction_counter += instructions.size();
+        already_sharded_counter += absl::c_count_if(
+            instructions,
+            [](const HloInstruction* inst) { return inst->has_sharding(); });
+      }
+      if (!dirty_computations.erase(computation)) {
+        continue;
+      }
+      ++visited_computation_counter;
       VLOG(2) << "Consider computation: " << computation->name();
-      std::vector<HloInstruction*> instructions =
-          computation->MakeInstructionPostOrder();
+      // Whether an instruction failed to refine its partial sharding, and is
+      // thus retried in the next visit.
+      bool retry = false;
 
-      instruction_counter += instructions.size();
-      already_sharded_counter += absl::c_count_if(
-          instructions,
-          [](const HloInstruction* inst) { return inst->has_sharding(); });
       auto clear_cache = [&](HloInstruction* hlo,
                              HloInstruction* hlo_for_users = nullptr) {
         for (auto operand : hlo->operands()) {
-          already_inferred_from_users.erase(operand);
+          invalidate(already_inferred_from_users, operand);
         }
         if (hlo_for_users == nullptr) {
           hlo_for_users = hlo;
         }
         for (auto user : hlo_for_users->users()) {
-          already_inferred_from_operands.erase(user);
+          invalidate(already_inferred_from_operands, user);
           // If the user has called computations, then the parameter
           // instructions of these called computations are also removed from
           // already_inferred_from_operands.
           for (auto c : user->called_computations()) {
             for (auto parameter : c->parameter_instructions()) {
-              already_inferred_from_operands.erase(parameter);
+              invalidate(already_inferred_from_operands, parameter);
             }
           }
         }
@@ -2893,7 +2924,7 @@ absl::StatusOr<bool> ShardingPropagation::RunToFixPoint(
                   : shard_group_id_to_shard_like_group.at(shard_group_id);
           for (HloInstruction* member : shard_group) {
             if (member != hlo) {
-              already_inferred_from_shard_group.erase(member);
+              invalidate(already_inferred_from_shard_group, member);
             }
           }
         }
@@ -2919,8 +2950,10 @@ absl::StatusOr<bool> ShardingPropagation::RunToFixPoint(
               continue;
             }
             auto it = unspecified_dims.find(instruction);
-            if (it != unspecified_dims.end() &&
-                InferUnspecifiedDimsFromShardGroup(instruction, it->second,
+            if (it == unspecified_dims.end()) {
+              continue;
+            }
+            if (InferUnspecifiedDimsFromShardGroup(instruction, it->second,
                                                    shard_group)) {
               ++inferred_from_shard_group_counter;
               VLOG(2) << "Refined partial sharding (shard group): "
@@ -2928,6 +2961,8 @@ absl::StatusOr<bool> ShardingPropagation::RunToFixPoint(
               clear_cache(instruction);
               already_inferred_from_shard_group.insert(instruction);
               changed_last_iter = true;
+            } else {
+              retry = true;
             }
             continue;
           }
@@ -2960,9 +2995,11 @@ absl::StatusOr<bool> ShardingPropagation::RunToFixPoint(
             continue;
           }
           auto it = unspecified_dims.find(instruction);
+          if (it == unspecified_dims.end()) {
+            continue;
+          }
           HloInstruction* man_conversion_op_after;
-          if (it != unspecified_dims.end() &&
-              InferUnspecifiedDimsFromOperand(instruction, it->second,
+          if (InferUnspecifiedDimsFromOperand(instruction, it->second,
                                               &man_conversion_op_after)) {
             ++inferred_from_operand_counter;
             VLOG(2) << "Refined partial sharding (forward-pass): "
@@ -2970,6 +3007,8 @@ absl::StatusOr<bool> ShardingPropagation::RunToFixPoint(
             clear_cache(instruction, man_conversion_op_after);
             already_inferred_from_operands.insert(instruction);
             changed_last_iter = true;
+          } else {
+            retry = true;
           }
           continue;
         }
@@ -2999,7 +3038,7 @@ absl::StatusOr<bool> ShardingPropagation::RunToFixPoint(
           // op before it. If the conversion op is removed from cache, the
           // sharding op should also be removed.
           if (!already_inferred_from_users.contains(*it)) {
-            already_inferred_from_users.erase((*it)->operand(0));
+            invalidate(already_inferred_from_users, (*it)->operand(0));
           }
         }
         if (already_inferred_from_users.contains(*it)) {
@@ -3010,9 +3049,11 @@ absl::StatusOr<bool> ShardingPropagation::RunToFixPoint(
             continue;
           }
           auto uit = unspecified_dims.find(*it);
+          if (uit == unspecified_dims.end()) {
+            continue;
+          }
           HloInstruction* man_conversion_op_after;
-          if (uit != unspecified_dims.end() &&
-              InferUnspecifiedDimsFromUsers(*it, uit->second, aggressiveness,
+          if (InferUnspecifiedDimsFromUsers(*it, uit->second, aggressiveness,
                                             is_spmd_, &man_conversion_op_after,
                                             call_graph)) {
             ++inferred_from_user_counter;
@@ -3024,6 +3065,8 @@ absl::StatusOr<bool> ShardingPropagation::RunToFixPoint(
               already_inferred_from_users.insert(man_conversion_op_after);
             }
             changed_last_iter = true;
+          } else {
+            retry = true;
           }
           continue;
         }
@@ -3044,8 +3087,12 @@ absl::StatusOr<bool> ShardingPropagation::RunToFixPoint(
           changed_last_iter = true;
         }
       }
+      if (retry) {
+        dirty_computations.insert(computation);
+      }
     }
     VLOG(1) << "Sharding propagation iteration " << iterations << ";"
+            << "\n  visited computations: " << visited_computation_counter
             << "\n  total instructions: " << instruction_counter
             << "\n  instructions already sharded: " << already_sharded_counter
             << "\n  shardings inferred from shard group: "
@@ -3604,6 +3651,18 @@ absl::StatusOr<bool> ShardingPropagation::Run(
     }
   }
 
+  // Many instructions are given equal shardings, so let them share the same
+  // storage.
+  HloShardingInterner sharding_interner;
+  for (HloComputation* computation : module->computations(execution_threads)) {
+    for (HloInstruction* instruction : computation->instructions()) {
+      if (instruction->has_sharding()) {
+        instruction->set_sharding(
+            sharding_interner.Intern(instruction->sharding_ptr()));
+      }
+    }
+  }
+
   TF_RETURN_IF_ERROR(
       hlo_sharding_util::CanonicalizeLayoutAfterShardingPropagation(
           module, allow_spmd_sharding_propagation_to_output_vector_,
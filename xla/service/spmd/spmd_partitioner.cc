@@ -615,6 +615,14 @@ PartitionedHlo PartitionedHlo::ReshardNoCache(
           return PartitionedHlo(resharded, base_shape_, state_)
               .ReshardNoCache(target);
         }
+        if (state_.partitioner->options()
+                .reshard_through_partial_replication) {
+          if (std::optional<HloSharding> intermediate =
+                  FindPartiallyReplicatedReshardIntermediate(
+                      base_shape_, sharding(), target)) {
+            return Reshard(*intermediate).ReshardNoCache(target);
+          }
+        }
       }
       if (!allow_full_replication) {
         return *this;
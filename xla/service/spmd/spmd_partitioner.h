@@ -123,6 +123,11 @@ struct SpmdPartitionerOptions {
           GatherScatterPartitioningMethod::kExplicitBatch,
           GatherScatterPartitioningMethod::kIndexParallel};
 
+  // Whether to reshard through a partially replicated sharding, which only
+  // all-gathers along some mesh axes, when a reshard would otherwise fully
+  // replicate the tensor.
+  bool reshard_through_partial_replication = false;
+
   // The minimum size to enable windowed einsum in total bytes.
   // This combines sizes in bytes of both operands.
   // When it's set, it will override threshold_for_windowed_einsum_mib.
@@ -567,6 +567,54 @@ std::optional<HloSharding> PartialReplicateReshardCompatibleSharding(
              : HloSharding::Tile(transpose_tile_assignment);
 }
 
+std::optional<HloSharding> FindPartiallyReplicatedReshardIntermediate(
+    const Shape& base_shape, const HloSharding& source,
+    const HloSharding& target) {
+  // Bounds the number of candidates, which is exponential in the number of
+  // tiled dimensions.
+  constexpr int64_t kMaxTiledDims = 8;
+  if (!source.IsTiled() || !target.IsTiled() || source.IsManualSubgroup() ||
+      target.IsManualSubgroup()) {
+    return std::nullopt;
+  }
+  std::vector<int64_t> tiled_dims;
+  for (int64_t dim = 0; dim < source.TiledDataRank(); ++dim) {
+    if (source.tile_assignment().dim(dim) > 1) {
+      tiled_dims.push_back(dim);
+    }
+  }
+  if (static_cast<int64_t>(tiled_dims.size()) > kMaxTiledDims) {
+    return std::nullopt;
+  }
+
+  std::optional<HloSharding> best_intermediate;
+  int64_t best_shard_bytes = std::numeric_limits<int64_t>::max();
+  for (int64_t subset = 1; subset < (int64_t{1} << tiled_dims.size());
+       ++subset) {
+    std::vector<int64_t> dims_to_replicate;
+    for (int64_t i = 0; i < tiled_dims.size(); ++i) {
+      if (subset & (int64_t{1} << i)) {
+        dims_to_replicate.push_back(tiled_dims[i]);
+      }
+    }
+    HloSharding intermediate =
+        hlo_sharding_util::PartiallyReplicateTiledShardingOnDims(
+            source, dims_to_replicate);
+    if (intermediate.IsReplicated() || !intermediate.ReplicateOnLastTileDim() ||
+        !PartialReplicateReshardCompatibleSharding(intermediate, source) ||
+        !PartialReplicateReshardCompatibleSharding(intermediate, target)) {
+      continue;
+    }
+    int64_t shard_bytes =
+        ShapeUtil::ByteSizeOf(MakePartitionedShape(base_shape, intermediate));
+    if (shard_bytes < best_shard_bytes) {
+      best_intermediate = std::move(intermediate);
+      best_shard_bytes = shard_bytes;
+    }
+  }
+  return best_intermediate;
+}
+
 std::optional<HloInstruction*> TileToPartialReplicateHaloExchange(
     HloInstruction* hlo, const Shape& base_shape,
     const HloSharding& src_sharding, const HloSharding& dst_sharding,
@@ -507,6 +507,17 @@ std::optional<HloInstruction*> PadFromPartialReplicateShape(
 std::optional<HloSharding> PartialReplicateReshardCompatibleSharding(
     const HloSharding& partial_sharding, const HloSharding& target_sharding);
 
+// Returns the sharding to go through when resharding a tensor of `base_shape`
+// from `source` to `target` would otherwise replicate the whole tensor, or
+// std::nullopt if there is none. The candidates partially replicate `source`
+// along subsets of its tiled dimensions, so that `source` is only all-gathered
+// along the mesh axes of those dimensions, and must then be resharded to
+// `target` by dynamic slicing. Among those, the candidate with the smallest
+// shards is returned, i.e. the one that gathers the least data per device.
+std::optional<HloSharding> FindPartiallyReplicatedReshardIntermediate(
+    const Shape& base_shape, const HloSharding& source,
+    const HloSharding& target);
+
 // Do left halo exchange if all-reduce directly from tile sharding to partial
 // replicate sharding will remove useful data from the source.
 std::optional<HloInstruction*> TileToPartialReplicateHaloExchange(
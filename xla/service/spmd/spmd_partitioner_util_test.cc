@@ -24,6 +24,9 @@ limitations under the License.
 #include "xla/hlo/ir/collective_device_list.h"
 #include "xla/hlo/ir/hlo_sharding.h"
 #include "xla/hlo/ir/tile_assignment.h"
+#include "xla/shape.h"
+#include "xla/shape_util.h"
+#include "xla/xla_data.pb.h"
 
 namespace xla {
 namespace spmd {
@@ -73,6 +76,26 @@ TEST(SPMDPartitionerUtilTest, PartialReplicateReshardCompatibleSharding2) {
   }
 }
 
+TEST(SPMDPartitionerUtilTest, FindPartiallyReplicatedReshardIntermediate) {
+  Shape shape = ShapeUtil::MakeShape(F32, {16, 16});
+  std::optional<HloSharding> intermediate =
+      FindPartiallyReplicatedReshardIntermediate(
+          shape, HloSharding::IotaTile({4, 2}), HloSharding::IotaTile({1, 8}));
+  ASSERT_TRUE(intermediate.has_value());
+  EXPECT_TRUE(intermediate->ReplicateOnLastTileDim());
+  EXPECT_THAT(intermediate->tile_assignment().dimensions(),
+              ::testing::ElementsAre(1, 2, 4));
+}
+
+TEST(SPMDPartitionerUtilTest,
+     FindPartiallyReplicatedReshardIntermediateSkipsFullReplication) {
+  Shape shape = ShapeUtil::MakeShape(F32, {16, 16});
+  EXPECT_FALSE(FindPartiallyReplicatedReshardIntermediate(
+                   shape, HloSharding::IotaTile({2, 1}),
+                   HloSharding::IotaTile({1, 2}))
+                   .has_value());
+}
+
 TEST(SPMDPartitionerUtilTest, GetPartitionGroupsForReplication) {
   HloSharding sharding = HloSharding::IotaTile({2, 2, 2});
   std::vector<std::vector<int64_t>> actual_partition_groups =
@@ -30,21 +30,33 @@ limitations under the License.
 // __VA_ARGS__ to get around this.
 #define SINGLE_ARG(...) __VA_ARGS__
 
-#define REGISTER_ALL_REDUCE_KERNEL(SUFFIX, XLA_TYPE, NV_TYPE, REDUCTION_KIND) \
+#define REGISTER_ALL_REDUCE_KERNEL_WITH_STRATEGY(SUFFIX, XLA_TYPE, NV_TYPE, \
+                                                 REDUCTION_KIND, STRATEGY,   \
+                                                 KERNEL_NAME)                \
   GPU_KERNEL_REGISTRY_REGISTER_KERNEL_STATICALLY(                             \
       AllReduceKernelCuda##SUFFIX,                                            \
       SINGLE_ARG(stream_executor::gpu::AllReduceKernel<                       \
-                 XLA_TYPE, xla::ReductionKind::REDUCTION_KIND>),              \
+                 XLA_TYPE, xla::ReductionKind::REDUCTION_KIND,                \
+                 stream_executor::gpu::AllReduceStrategy::STRATEGY>),         \
       stream_executor::cuda::kCudaPlatformId, ([](size_t arity) {             \
         stream_executor::MultiKernelLoaderSpec spec(arity);                   \
         spec.AddInProcessSymbol(                                              \
             absl::bit_cast<void*>(                                            \
                 &stream_executor::gpu::AllReduceKernelImpl<                   \
-                    NV_TYPE, xla::ReductionKind::REDUCTION_KIND>),            \
-            "one_shot_all_reduce_" #SUFFIX);                                  \
+                    NV_TYPE, xla::ReductionKind::REDUCTION_KIND,              \
+                    stream_executor::gpu::AllReduceStrategy::STRATEGY>),      \
+            KERNEL_NAME);                                                     \
         return spec;                                                          \
       }));
 
+#define REGISTER_ALL_REDUCE_KERNEL(SUFFIX, XLA_TYPE, NV_TYPE, REDUCTION_KIND) \
+  REGISTER_ALL_REDUCE_KERNEL_WITH_STRATEGY(                                   \
+      OneShot##SUFFIX, XLA_TYPE, NV_TYPE, REDUCTION_KIND, kOneShot,           \
+      "one_shot_all_reduce_" #SUFFIX);                                        \
+  REGISTER_ALL_REDUCE_KERNEL_WITH_STRATEGY(                                   \
+      TwoShot##SUFFIX, XLA_TYPE, NV_TYPE, REDUCTION_KIND, kTwoShot,           \
+      "two_shot_all_reduce_" #SUFFIX)
+
 // Register the kernel for different types using the macro
 REGISTER_ALL_REDUCE_KERNEL(AddBF16, xla::bfloat16, __nv_bfloat16, SUM);
 REGISTER_ALL_REDUCE_KERNEL(AddF32, float, float, SUM);
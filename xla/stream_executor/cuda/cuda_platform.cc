@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "xla/stream_executor/cuda/cuda_platform.h"
 
+#include <cstdlib>
 #include <memory>
 #include <string>
 #include <utility>
@@ -42,6 +43,15 @@ namespace {
 // Actually performs the work of CUDA initialization. Wrapped up in one-time
 // execution guard.
 static absl::Status InternalInit() {
+  // Ask the driver to defer loading of individual kernels until they are
+  // looked up (cuModuleGetFunction) or first launched, instead of loading every
+  // kernel of a module (and of the CUDA libraries) eagerly. For executables
+  // with thousands of kernels this considerably reduces start up time and
+  // device memory usage. XLA resolves kernel handles during thunk
+  // initialization, so kernel loading still happens before execution starts.
+  // Respect an explicit user setting.
+  setenv("CUDA_MODULE_LOADING", "LAZY", /*overwrite=*/0);
+
   absl::Status status =
       cuda::ToStatus(cuInit(0 /* = flags */), "Failed call to cuInit");
   if (status.ok()) {
@@ -17,7 +17,9 @@ limitations under the License.
 
 #include <stdalign.h>
 
+#include <algorithm>
 #include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <memory>
@@ -294,6 +296,71 @@ absl::Status CudaStream::MemZero(DeviceMemoryBase* location, uint64_t size) {
   }
 }
 
+absl::Status CudaStream::SetL2PersistingWindow(
+    const DeviceMemoryBase& window) {
+  std::unique_ptr<ActivateContext> activation = executor_->Activate();
+  CUstreamAttrValue value;
+  std::memset(&value, 0, sizeof(value));
+
+  if (window.is_null() || window.size() == 0) {
+    // Demote the lines persisted so far, so that they don't occupy the L2
+    // carve-out for the rest of the program.
+    TF_RETURN_IF_ERROR(cuda::ToStatus(cuCtxResetPersistingL2Cache(),
+                                      "Failed to reset persisting L2 lines"));
+  } else {
+    CUdevice device;
+    TF_RETURN_IF_ERROR(
+        cuda::ToStatus(cuCtxGetDevice(&device), "Failed to get the device"));
+    int max_window_size = 0;
+    int max_persisting_size = 0;
+    TF_RETURN_IF_ERROR(cuda::ToStatus(
+        cuDeviceGetAttribute(&max_window_size,
+                             CU_DEVICE_ATTRIBUTE_MAX_ACCESS_POLICY_WINDOW_SIZE,
+                             device),
+        "Failed to get the maximum access policy window size"));
+    TF_RETURN_IF_ERROR(cuda::ToStatus(
+        cuDeviceGetAttribute(&max_persisting_size,
+                             CU_DEVICE_ATTRIBUTE_MAX_PERSISTING_L2_CACHE_SIZE,
+                             device),
+        "Failed to get the maximum persisting L2 cache size"));
+    if (max_window_size <= 0 || max_persisting_size <= 0) {
+      return absl::UnimplementedError(
+          "The device does not support persisting L2 accesses.");
+    }
+
+    // Persisting lines live in a carve-out of the L2 cache, which is empty
+    // unless it is grown explicitly.
+    size_t persisting_size =
+        std::min<size_t>(window.size(), max_persisting_size);
+    size_t current_persisting_size = 0;
+    TF_RETURN_IF_ERROR(cuda::ToStatus(
+        cuCtxGetLimit(&current_persisting_size,
+                      CU_LIMIT_PERSISTING_L2_CACHE_SIZE),
+        "Failed to get the persisting L2 cache size"));
+    if (current_persisting_size < persisting_size) {
+      TF_RETURN_IF_ERROR(cuda::ToStatus(
+          cuCtxSetLimit(CU_LIMIT_PERSISTING_L2_CACHE_SIZE, persisting_size),
+          "Failed to set the persisting L2 cache size"));
+    }
+
+    // If the window doesn't fit in the carve-out, persist a random subset of
+    // its lines instead of thrashing the carve-out.
+    size_t window_size = std::min<size_t>(window.size(), max_window_size);
+    value.accessPolicyWindow.base_ptr = window.opaque();
+    value.accessPolicyWindow.num_bytes = window_size;
+    value.accessPolicyWindow.hitRatio = std::min(
+        1.0f,
+        static_cast<float>(persisting_size) / static_cast<float>(window_size));
+    value.accessPolicyWindow.hitProp = CU_ACCESS_PROPERTY_PERSISTING;
+    value.accessPolicyWindow.missProp = CU_ACCESS_PROPERTY_STREAMING;
+  }
+
+  return cuda::ToStatus(
+      cuStreamSetAttribute(stream_handle_,
+                           CU_STREAM_ATTRIBUTE_ACCESS_POLICY_WINDOW, &value),
+      "Failed to set the L2 access policy window");
+}
+
 absl::Status CudaStream::Memcpy(DeviceMemoryBase* gpu_dst,
                                 const DeviceMemoryBase& gpu_src,
                                 uint64_t size) {
@@ -29,9 +29,23 @@ namespace stream_executor::gpu {
 // kernel.
 inline constexpr int64_t kMaxNumAllReduceInputPtrs = 8;
 
+// The algorithm used by the all-reduce kernel.
+enum class AllReduceStrategy {
+  // Every rank reads the inputs of all other ranks and reduces the whole
+  // buffer. Needs a single round of synchronization, and has the lowest
+  // latency for small inputs.
+  kOneShot,
+  // Every rank reduces a 1/num_ranks slice of the inputs (reduce-scatter), and
+  // then gathers the reduced slices from all other ranks (all-gather). Reads
+  // 2x the buffer size from peers regardless of the number of ranks, at the
+  // cost of an extra round of synchronization.
+  kTwoShot,
+};
+
 // Defines a trait for the AllReduce kernel that can be used to register
 // and look up the kernel in the GPU kernel registry.
-template <typename ElementT, xla::ReductionKind ReductionKindT>
+template <typename ElementT, xla::ReductionKind ReductionKindT,
+          AllReduceStrategy kAllReduceStrategy = AllReduceStrategy::kOneShot>
 struct AllReduceKernel {
   using KernelType = stream_executor::TypedKernel<
       /*remove_input_ptrs=*/std::array<ElementT*, kMaxNumAllReduceInputPtrs>,
@@ -130,7 +130,24 @@ __device__ __forceinline__ void SyncRemoteBlocks(
 }
 
 template <typename T, xla::ReductionKind ReductionKindT>
-__global__ void AllReduceKernelImpl(
+__device__ __forceinline__ Vec<T> ReduceRemoteInputs(
+    std::array<T* __restrict__, kMaxNumAllReduceInputPtrs> remote_input_ptrs,
+    int64_t num_ranks, int64_t i) {
+  Vec<T> acc = VecLoad(remote_input_ptrs[0] + i);
+
+  // Since `remote_input_ptrs` are provided in rank order, we get stable
+  // reduction results on all devices.
+#pragma unroll
+  for (int j = 1; j < kMaxNumAllReduceInputPtrs; ++j) {
+    if (j < num_ranks) {
+      VecOp<T, ReductionKindT>(acc, VecLoad(remote_input_ptrs[j] + i));
+    }
+  }
+  return acc;
+}
+
+template <typename T, xla::ReductionKind ReductionKindT>
+__device__ __forceinline__ void OneShotAllReduce(
     std::array<T* __restrict__, kMaxNumAllReduceInputPtrs> remote_input_ptrs,
     T* __restrict__ local_input_ptr, T* __restrict__ output_ptr, int64_t rank,
     int64_t num_ranks, int64_t num_elements,
@@ -149,22 +166,100 @@ __global__ void AllReduceKernelImpl(
   __syncthreads();
 
   for (int i = offset; i < num_elements; i += stride) {
-    Vec<T> acc = VecLoad(remote_input_ptrs[0] + i);
+    VecStore(output_ptr + i,
+             ReduceRemoteInputs<T, ReductionKindT>(remote_input_ptrs,
+                                                   num_ranks, i));
+  }
 
-    // Since `remote_input_ptrs` are provided in rank order, we get stable
-    // reduction results on all devices.
-#pragma unroll
-    for (int j = 1; j < kMaxNumAllReduceInputPtrs; ++j) {
-      if (j < num_ranks) {
-        VecOp<T, ReductionKindT>(acc, VecLoad(remote_input_ptrs[j] + i));
+  __syncthreads();
+  SyncRemoteBlocks(signal_flags_ptrs, rank, num_ranks);
+}
+
+template <typename T, xla::ReductionKind ReductionKindT>
+__device__ __forceinline__ void TwoShotAllReduce(
+    std::array<T* __restrict__, kMaxNumAllReduceInputPtrs> remote_input_ptrs,
+    T* __restrict__ local_input_ptr, T* __restrict__ output_ptr, int64_t rank,
+    int64_t num_ranks, int64_t num_elements,
+    std::array<uint32_t* __restrict__, kMaxNumAllReduceInputPtrs>
+        signal_flags_ptrs) {
+  // Rank `r` owns elements [r * slice_size, (r + 1) * slice_size). Slices are
+  // rounded up to the vector size, so the last slices might be partial or
+  // empty.
+  int64_t num_vectors = num_elements / kNumElementsPerThread;
+  int64_t slice_size =
+      kNumElementsPerThread * ((num_vectors + num_ranks - 1) / num_ranks);
+
+  // All three phases use the same mapping from a position within a slice to a
+  // thread, so that every element is only ever accessed by blocks with the
+  // same id on all devices. This is required because we only synchronize
+  // blocks with the same id across devices.
+  int64_t offset =
+      kNumElementsPerThread * (blockIdx.x * blockDim.x + threadIdx.x);
+  int64_t stride = kNumElementsPerThread * blockDim.x * gridDim.x;
+
+  // Copy data from local input buffer to remote input buffer.
+  for (int64_t i = offset; i < slice_size; i += stride) {
+    for (int64_t r = 0; r < num_ranks; ++r) {
+      int64_t index = r * slice_size + i;
+      if (index < num_elements) {
+        VecStore(remote_input_ptrs[rank] + index,
+                 VecLoad(local_input_ptr + index));
       }
     }
+  }
 
-    VecStore(output_ptr + i, acc);
+  __syncthreads();
+  SyncRemoteBlocks(signal_flags_ptrs, rank, num_ranks);
+  __syncthreads();
+
+  // Reduce the slice owned by the current rank from all ranks and store it in
+  // place. Other ranks never read this slice from their own buffers, so there
+  // is no race with the reduction happening on other devices.
+  for (int64_t i = offset; i < slice_size; i += stride) {
+    int64_t index = rank * slice_size + i;
+    if (index < num_elements) {
+      VecStore(remote_input_ptrs[rank] + index,
+               ReduceRemoteInputs<T, ReductionKindT>(remote_input_ptrs,
+                                                     num_ranks, index));
+    }
   }
 
   __syncthreads();
   SyncRemoteBlocks(signal_flags_ptrs, rank, num_ranks);
+  __syncthreads();
+
+  // Gather reduced slices from all ranks.
+  for (int64_t i = offset; i < slice_size; i += stride) {
+#pragma unroll
+    for (int r = 0; r < kMaxNumAllReduceInputPtrs; ++r) {
+      int64_t index = r * slice_size + i;
+      if (r < num_ranks && index < num_elements) {
+        VecStore(output_ptr + index, VecLoad(remote_input_ptrs[r] + index));
+      }
+    }
+  }
+
+  __syncthreads();
+  SyncRemoteBlocks(signal_flags_ptrs, rank, num_ranks);
+}
+
+template <typename T, xla::ReductionKind ReductionKindT,
+          AllReduceStrategy kAllReduceStrategy = AllReduceStrategy::kOneShot>
+__global__ void AllReduceKernelImpl(
+    std::array<T* __restrict__, kMaxNumAllReduceInputPtrs> remote_input_ptrs,
+    T* __restrict__ local_input_ptr, T* __restrict__ output_ptr, int64_t rank,
+    int64_t num_ranks, int64_t num_elements,
+    std::array<uint32_t* __restrict__, kMaxNumAllReduceInputPtrs>
+        signal_flags_ptrs) {
+  if constexpr (kAllReduceStrategy == AllReduceStrategy::kOneShot) {
+    OneShotAllReduce<T, ReductionKindT>(remote_input_ptrs, local_input_ptr,
+                                        output_ptr, rank, num_ranks,
+                                        num_elements, signal_flags_ptrs);
+  } else {
+    TwoShotAllReduce<T, ReductionKindT>(remote_input_ptrs, local_input_ptr,
+                                        output_ptr, rank, num_ranks,
+                                        num_elements, signal_flags_ptrs);
+  }
 }
 
 }  // namespace stream_executor::gpu
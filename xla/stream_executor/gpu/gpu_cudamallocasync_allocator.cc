@@ -456,7 +456,22 @@ size_t GpuCudaMallocAsyncAllocator::AllocatedSize(const void* ptr) const {
 std::optional<tsl::AllocatorStats> GpuCudaMallocAsyncAllocator::GetStats() {
   if (!stats_) return std::nullopt;
   absl::MutexLock l(&mutex_);
-  return *stats_;
+  tsl::AllocatorStats stats = *stats_;
+
+  // Memory reserved by the pool, including free memory kept for reuse.
+  cuuint64_t mem_reserved_current;
+  if (cuMemPoolGetAttribute(cuda_state_->pool,
+                            CU_MEMPOOL_ATTR_RESERVED_MEM_CURRENT,
+                            &mem_reserved_current) == CUDA_SUCCESS) {
+    stats.pool_bytes = static_cast<int64_t>(mem_reserved_current);
+  }
+  cuuint64_t mem_reserved_high;
+  if (cuMemPoolGetAttribute(cuda_state_->pool,
+                            CU_MEMPOOL_ATTR_RESERVED_MEM_HIGH,
+                            &mem_reserved_high) == CUDA_SUCCESS) {
+    stats.peak_pool_bytes = static_cast<int64_t>(mem_reserved_high);
+  }
+  return stats;
 }
 
 bool GpuCudaMallocAsyncAllocator::ClearStats() {
@@ -195,6 +195,16 @@ class Stream {
         "Memset32 is not supported on this stream.");
   }
 
+  // Hints that the accesses of kernels subsequently enqueued onto the stream to
+  // `window` should persist in the L2 cache, i.e. that the lines of `window`
+  // are evicted after all other lines. This is useful for buffers that are
+  // re-read by every iteration of a loop. A null window resets the stream to
+  // normal caching. Devices may persist only a part of a large window.
+  virtual absl::Status SetL2PersistingWindow(const DeviceMemoryBase &window) {
+    return absl::UnimplementedError(
+        "L2 persisting windows are not supported on this stream.");
+  }
+
   // (Synchronously) block the host code waiting for the operations
   // entrained on the stream (enqueued to this point in program
   // execution) to complete.
@@ -663,6 +663,44 @@ TEST_F(CollectiveOpsTest, AsyncAllReduceTwoOperands) {
   }
 }
 
+TEST_F(CollectiveOpsTest, AllReduceWithAsyncCpuCollectives) {
+  const absl::string_view kModuleStr = R"(
+      HloModule test
+
+      apply_op {
+        x = u32[] parameter(0)
+        y = u32[] parameter(1)
+        ROOT apply_op = u32[] add(x, y)
+      }
+
+      ENTRY test_computation {
+        id = u32[] replica-id()
+        all-reduce = u32[] all-reduce(id), to_apply=apply_op
+        ROOT add = u32[] add(all-reduce, id)
+      }
+    )";
+
+  HloModuleConfig config =
+      GetModuleConfigForTest(/*replica_count=*/num_devices());
+  DebugOptions debug_options = config.debug_options();
+  debug_options.set_xla_cpu_enable_async_collectives(true);
+  config.set_debug_options(debug_options);
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(kModuleStr, config));
+  TF_ASSERT_OK_AND_ASSIGN(
+      std::vector<Literal> results,
+      ExecuteReplicated(std::move(module), absl::Span<Literal* const>{},
+                        num_devices(),
+                        /*use_threads=*/true, /*run_hlo_passes=*/true));
+
+  ASSERT_EQ(results.size(), num_devices());
+  // sum [0, num_devices) plus replica id
+  uint32_t expected = num_devices() * (num_devices() - 1) / 2;
+  for (int i = 0; i < num_devices(); ++i) {
+    LiteralTestUtil::ExpectR0Equal<uint32_t>(expected + i, results[i]);
+  }
+}
+
 TEST_F(CollectiveOpsTest, ReplicaId) {
   const char* const kModuleStr = R"(
   HloModule test
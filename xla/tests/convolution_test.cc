@@ -1713,6 +1713,21 @@ ENTRY Test {
   EXPECT_TRUE(RunAndCompare(kHlo, ErrorSpec{0.001}));
 }
 
+// 3x3 convolution with enough channels for the CPU runtime to use Winograd
+// convolutions, and an odd output size to cover partial tiles.
+TEST_F(ConvolutionHloTest, ConvolveF32Forward3x3ManyChannels) {
+  constexpr char kHlo[] = R"(
+HloModule TestModule
+
+ENTRY Test {
+  %arg0 = f32[2,13,9,24] parameter(0)
+  %arg1 = f32[3,3,24,32] parameter(1)
+  ROOT %conv = f32[2,13,9,32] convolution(%arg0, %arg1),
+    window={size=3x3 pad=1_1x1_1}, dim_labels=b01f_01io->b01f
+})";
+  EXPECT_TRUE(RunAndCompare(kHlo, ErrorSpec{0.001}));
+}
+
 TEST_F(ConvolutionHloTest, DISABLED_ON_TPU(ConvolveF64BackwardFilter)) {
   if (IsRocm()) {
     GTEST_SKIP() << "double datatype is not yet supported in ROCm";
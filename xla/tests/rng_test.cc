@@ -25,9 +25,11 @@ limitations under the License.
 #include "xla/literal.h"
 #include "xla/literal_util.h"
 #include "xla/tests/hlo_pjrt_test_base.h"
+#include "xla/tests/literal_test_util.h"
 #include "xla/tests/test_macros.h"
 #include "xla/tsl/platform/statusor.h"
 #include "xla/tsl/platform/test.h"
+#include "xla/xla_data.pb.h"
 
 namespace xla {
 namespace {
@@ -77,15 +79,36 @@ TEST_F(RngTest, ReturnsErrorWhenExpanderPassDisabled) {
               ::testing::HasSubstr("Rng should be expanded for CPU"));
 }
 
-using RngBitGeneratorTest = HloPjRtTestBase;
+class RngBitGeneratorTest : public HloPjRtTestBase {
+ protected:
+  // Philox generators are executed natively by the XLA:CPU thunk runtime, and
+  // must generate exactly the bits of the HLO computation they are otherwise
+  // expanded into.
+  void ExpectSameBitsAsExpandedGenerator(absl::string_view hlo,
+                                         const Literal& state) {
+    TF_ASSERT_OK_AND_ASSIGN(auto module, ParseAndReturnVerifiedModule(hlo));
+    TF_ASSERT_OK_AND_ASSIGN(auto expanded_module,
+                            ParseAndReturnVerifiedModule(hlo));
+    RngBitGeneratorExpander expander(RandomAlgorithm::RNG_PHILOX);
+    TF_ASSERT_OK_AND_ASSIGN(bool changed,
+                            RunHloPass(&expander, expanded_module.get()));
+    ASSERT_TRUE(changed);
+
+    TF_ASSERT_OK_AND_ASSIGN(Literal result,
+                            Execute(std::move(module), {&state}));
+    TF_ASSERT_OK_AND_ASSIGN(Literal expected,
+                            Execute(std::move(expanded_module), {&state}));
+    EXPECT_TRUE(LiteralTestUtil::Equal(expected, result));
+  }
+};
 
-TEST_F(RngBitGeneratorTest, ReturnsErrorWhenExpanderPassDisabled_Default) {
+TEST_F(RngBitGeneratorTest, ReturnsErrorWhenExpanderPassDisabled_ThreeFry) {
   const char* const kModuleStr = R"(
     HloModule m
 
     ENTRY test {
-      p0 = u64[3]{0} parameter(0)
-      ROOT result = (u64[3]{0}, u32[11,17]{1,0}) rng-bit-generator(p0), algorithm=rng_default
+      p0 = u64[2]{0} parameter(0)
+      ROOT result = (u64[2]{0}, u32[11,17]{1,0}) rng-bit-generator(p0), algorithm=rng_three_fry
     })";
 
   TF_ASSERT_OK_AND_ASSIGN(auto module,
@@ -93,7 +116,7 @@ TEST_F(RngBitGeneratorTest, ReturnsErrorWhenExpanderPassDisabled_Default) {
 
   DisableRngBitGeneratorExpanderPass(*module);
 
-  Literal arg0 = LiteralUtil::CreateR1<uint64_t>({7, 42, 43});
+  Literal arg0 = LiteralUtil::CreateR1<uint64_t>({7, 42});
 
   auto status_or_result = Execute(std::move(module), {&arg0});
   EXPECT_EQ(status_or_result.status().code(), absl::StatusCode::kUnimplemented);
@@ -102,50 +125,56 @@ TEST_F(RngBitGeneratorTest, ReturnsErrorWhenExpanderPassDisabled_Default) {
       ::testing::HasSubstr("RngBitGenerator should be expanded for CPU"));
 }
 
-TEST_F(RngBitGeneratorTest, ReturnsErrorWhenExpanderPassDisabled_ThreeFry) {
+TEST_F(RngBitGeneratorTest, PhiloxMatchesExpandedGenerator_Default) {
   const char* const kModuleStr = R"(
     HloModule m
 
     ENTRY test {
-      p0 = u64[2]{0} parameter(0)
-      ROOT result = (u64[2]{0}, u32[11,17]{1,0}) rng-bit-generator(p0), algorithm=rng_three_fry
+      p0 = u64[3]{0} parameter(0)
+      ROOT result = (u64[3]{0}, u32[11,17]{1,0}) rng-bit-generator(p0), algorithm=rng_default
     })";
 
-  TF_ASSERT_OK_AND_ASSIGN(auto module,
-                          ParseAndReturnVerifiedModule(kModuleStr));
+  ExpectSameBitsAsExpandedGenerator(
+      kModuleStr, LiteralUtil::CreateR1<uint64_t>({7, 42, 43}));
+}
 
-  DisableRngBitGeneratorExpanderPass(*module);
+TEST_F(RngBitGeneratorTest, PhiloxMatchesExpandedGenerator_U64) {
+  const char* const kModuleStr = R"(
+    HloModule m
 
-  Literal arg0 = LiteralUtil::CreateR1<uint64_t>({7, 42});
+    ENTRY test {
+      p0 = u64[2]{0} parameter(0)
+      ROOT result = (u64[2]{0}, u64[5,7]{1,0}) rng-bit-generator(p0), algorithm=rng_philox
+    })";
 
-  auto status_or_result = Execute(std::move(module), {&arg0});
-  EXPECT_EQ(status_or_result.status().code(), absl::StatusCode::kUnimplemented);
-  EXPECT_THAT(
-      status_or_result.status().message(),
-      ::testing::HasSubstr("RngBitGenerator should be expanded for CPU"));
+  ExpectSameBitsAsExpandedGenerator(
+      kModuleStr, LiteralUtil::CreateR1<uint64_t>({7, 0xFFFFFFFFFFFFFFF0}));
 }
 
-TEST_F(RngBitGeneratorTest, ReturnsErrorWhenExpanderPassDisabled_Philox) {
+TEST_F(RngBitGeneratorTest, PhiloxMatchesExpandedGenerator_U16) {
   const char* const kModuleStr = R"(
     HloModule m
 
     ENTRY test {
       p0 = u64[3]{0} parameter(0)
-      ROOT result = (u64[3]{0}, u32[11,17]{1,0}) rng-bit-generator(p0), algorithm=rng_philox
+      ROOT result = (u64[3]{0}, u16[1001]{0}) rng-bit-generator(p0), algorithm=rng_philox
     })";
 
-  TF_ASSERT_OK_AND_ASSIGN(auto module,
-                          ParseAndReturnVerifiedModule(kModuleStr));
+  ExpectSameBitsAsExpandedGenerator(
+      kModuleStr, LiteralUtil::CreateR1<uint64_t>({7, 0xFFFFFFFFFFFFFFFF, 43}));
+}
 
-  DisableRngBitGeneratorExpanderPass(*module);
+TEST_F(RngBitGeneratorTest, PhiloxMatchesExpandedGenerator_Large) {
+  const char* const kModuleStr = R"(
+    HloModule m
 
-  Literal arg0 = LiteralUtil::CreateR1<uint64_t>({7, 42, 43});
+    ENTRY test {
+      p0 = u64[3]{0} parameter(0)
+      ROOT result = (u64[3]{0}, u32[1000,301]{1,0}) rng-bit-generator(p0), algorithm=rng_philox
+    })";
 
-  auto status_or_result = Execute(std::move(module), {&arg0});
-  EXPECT_EQ(status_or_result.status().code(), absl::StatusCode::kUnimplemented);
-  EXPECT_THAT(
-      status_or_result.status().message(),
-      ::testing::HasSubstr("RngBitGenerator should be expanded for CPU"));
+  ExpectSameBitsAsExpandedGenerator(
+      kModuleStr, LiteralUtil::CreateR1<uint64_t>({7, 42, 43}));
 }
 
 }  // namespace
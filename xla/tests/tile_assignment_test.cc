@@ -72,6 +72,17 @@ TEST(TileAssignmentTest, V1V2Equivalence) {
   EXPECT_EQ(absl::HashOf(v1), absl::HashOf(v2));
 }
 
+TEST(TileAssignmentTest, V1V2HashEquivalenceWithManyDevices) {
+  TileAssignment v1(std::make_shared<const Array<int64_t>>(
+      TileAssignment({16, 32}, {32, 16}, {1, 0}).array()));
+  TileAssignment v2({16, 32}, {32, 16}, {1, 0});
+  TileAssignment other({16, 32});
+  EXPECT_EQ(v1, v2);
+  EXPECT_EQ(absl::HashOf(v1), absl::HashOf(v2));
+  EXPECT_NE(v2, other);
+  EXPECT_NE(absl::HashOf(v2), absl::HashOf(other));
+}
+
 TEST(TileAssignmentTest, CopyConstruction) {
   TileAssignment tile({2, 2, 4}, {2, 2, 4}, {2, 1, 0});
   TileAssignment copied(tile);
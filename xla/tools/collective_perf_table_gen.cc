@@ -291,6 +291,45 @@ CollectivePerfTableGen::Create(CollectivePerfTableGen::Config config) {
       new CollectivePerfTableGen(config, std::move(*pjrt_env)));
 }
 
+/*static*/ std::vector<std::string> CollectivePerfTableGen::ReplicaGroupsSweep(
+    int num_nodes, int num_devices_per_host) {
+  CHECK_GT(num_nodes, 0);
+  CHECK_GT(num_devices_per_host, 0);
+  // Power of two divisors of `n` greater than one, and `n` itself, largest
+  // first.
+  auto group_sizes = [](int n) {
+    std::vector<int> sizes;
+    if (n > 1 && (n & (n - 1)) != 0) {
+      sizes.push_back(n);
+    }
+    for (int size = 1 << 30; size > 1; size >>= 1) {
+      if (size <= n && n % size == 0) {
+        sizes.push_back(size);
+      }
+    }
+    return sizes;
+  };
+
+  int num_devices = num_nodes * num_devices_per_host;
+  std::vector<std::string> replica_groups;
+  // Intra-host groups.
+  for (int size : group_sizes(num_devices_per_host)) {
+    replica_groups.push_back(
+        absl::Substitute("[$0,$1]<=[$2]", num_devices / size, size,
+                         num_devices));
+  }
+  // Inter-host groups.
+  for (int hosts : group_sizes(num_nodes)) {
+    replica_groups.push_back(
+        absl::Substitute("[$0,$1]<=[$2]", num_nodes / hosts,
+                         hosts * num_devices_per_host, num_devices));
+    replica_groups.push_back(absl::Substitute(
+        "[$0,$1]<=[$2,$3]T(1,0)", num_devices / hosts, hosts, num_nodes,
+        num_devices_per_host));
+  }
+  return replica_groups;
+}
+
 std::unique_ptr<PjRtLoadedExecutable> CollectivePerfTableGen::Compile(
     std::unique_ptr<HloModule> module) {
   DebugOptions debug_opts;
@@ -407,6 +446,7 @@ DeviceHloInstructionProfiles CollectivePerfTableGen::ComputeTable() {
   if (profile_list.entries_size() == 0) {
     return profiles;
   }
+  profiles.set_version(HloOpProfiles::kProfilesVersion);
 
   std::string device_key = HloOpProfiles::GetProfileName(
       /*device_info=*/backend_->stream_executors()[0]->GetDeviceDescription());
@@ -429,6 +469,12 @@ absl::Status CollectivePerfTableGen::Dump(
     TF_RETURN_IF_ERROR(
         tsl::ReadTextOrBinaryProto(tsl::Env::Default(), config_.output, &file));
   }
+  if (file.version() > HloOpProfiles::kProfilesVersion) {
+    return absl::FailedPreconditionError(absl::StrCat(
+        "Cannot merge into ", config_.output, " with newer table version ",
+        file.version(), "."));
+  }
+  file.set_version(HloOpProfiles::kProfilesVersion);
 
   for (const auto& [sm_ver, entries] : table.entries()) {
     if (file.entries().contains(sm_ver)) {
@@ -504,6 +550,7 @@ DeviceHloInstructionProfiles CollectivePerfTableGen::Merge(
             << profiling_results_counter << ", after "
             << profiling_results.size() << ".";
 
+  result.set_version(HloOpProfiles::kProfilesVersion);
   for (const ProfilingResult& profiling_result : profiling_results) {
     std::string device_descriptor = profiling_result.device_info;
     if (!result.mutable_entries()->contains(device_descriptor)) {
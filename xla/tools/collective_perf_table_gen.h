@@ -85,13 +85,24 @@ class CollectivePerfTableGen {
   // Factory method to create the perf table gen.
   static std::unique_ptr<CollectivePerfTableGen> Create(Config config);
 
+  // Returns replica groups (in `IotaReplicaGroupList` printing format) which
+  // sweep over power of two group sizes of a `num_nodes` x
+  // `num_devices_per_host` topology. Groups of at most `num_devices_per_host`
+  // devices stay within a host (NVLink). Larger groups span power of two number
+  // of hosts, both with whole hosts and with one device per host (rail
+  // aligned), and go over the network.
+  static std::vector<std::string> ReplicaGroupsSweep(int num_nodes,
+                                                     int num_devices_per_host);
+
   // Computes performance table for a given `config`.
   DeviceHloInstructionProfiles ComputeTable();
 
   // Dumps `table` to `config_`s `output`. If the output is set to "stdout" it
   // just prints the content to output stream. If it's a filepath ending with
   // .pbtx or .pb it will dump a proto to that file, merging the previous
-  // content (but not deduplicating).
+  // content (but not deduplicating). The file is stamped with
+  // `HloOpProfiles::kProfilesVersion` and can be loaded by the compiler with
+  // --xla_gpu_experimental_collective_perf_table_path.
   absl::Status Dump(const DeviceHloInstructionProfiles& table);
 
   // Merges all of the profiled files under `merge_path`, deduplicates them
@@ -29,7 +29,6 @@ limitations under the License.
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_split.h"
 #include "absl/strings/string_view.h"
-#include "absl/strings/substitute.h"
 #include "xla/service/gpu/model/hlo_op_profile.pb.h"
 #include "xla/tools/collective_perf_table_gen.h"
 #include "xla/tsl/util/command_line_flags.h"
@@ -71,6 +70,11 @@ to 4 GPUs.
   (--tensor_size_bytes_spec)
 * AllReduce will run across all 8 devices.
   (--collective_devices_spec, HloShardingV2 format)
+
+Without --collective_devices_spec the tool sweeps over power of two group sizes,
+both within a host (NVLink) and across hosts (network). Writing to a .pb or
+.pbtxt --output produces a versioned table which the compiler picks up with
+--xla_gpu_experimental_collective_perf_table_path, without rebuilding.
 )";
 
 constexpr absl::string_view kDefaultCoordinatorAddress = "127.0.0.1:1234";
@@ -144,17 +148,6 @@ std::vector<std::string> CollectiveDeviceLists(
   return result;
 }
 
-std::string DefaultCollectiveDevicesIfEmpty(
-    const std::string& collective_devices_spec_unparsed, int32_t num_nodes,
-    int32_t num_devices_per_host) {
-  if (collective_devices_spec_unparsed.empty()) {
-    return absl::Substitute("[1,$0]<=[$0];[$2,$1]<=[$1,$2]T(1,0)",
-                            num_devices_per_host * num_nodes, num_nodes,
-                            num_devices_per_host);
-  }
-  return collective_devices_spec_unparsed;
-}
-
 }  // namespace
 
 // TODO(b/390097558): Add an option to generate perf table for collective which
@@ -168,8 +161,7 @@ int main(int argc, char* argv[]) {
       "ALL_REDUCE,ALL_GATHER,REDUCE_SCATTER,ALL_TO_ALL";
   std::string tensor_size_bytes_spec_unparsed =
       "start=1024,stop=2147483648,factor=2";
-  std::string collective_devices_spec_unparsed =
-      "[1,8]<=[8];[2,4]<=[8];[4,2]<=[8]";
+  std::string collective_devices_spec_unparsed;
   std::string coordinator_address = std::string(kDefaultCoordinatorAddress);
   std::string output = std::string(CollectivePerfTableGen::Config::kStdout);
   std::string merge_path;
@@ -192,7 +184,9 @@ int main(int argc, char* argv[]) {
                 "start=1,stop=8,factor=2 generates {1,2,4,8}."),
       tsl::Flag("collective_devices_spec", &collective_devices_spec_unparsed,
                 "';' separated list of replica groups specification. It "
-                "follows `IotaReplicaGroupList` printing format."),
+                "follows `IotaReplicaGroupList` printing format. If empty, "
+                "sweeps over power of two group sizes within a host and "
+                "across hosts."),
       tsl::Flag("coordinator_address", &coordinator_address,
                 "Coordinator address in host:port format. For example: "
                 "127.0.0.1:1234."),
@@ -220,10 +214,11 @@ int main(int argc, char* argv[]) {
   cfg.task_id = task_id;
   cfg.collective_types = ParseCollectives(collectives_unparsed);
   cfg.tensor_size_bytes_spec = ParseStepSpec(tensor_size_bytes_spec_unparsed);
-  collective_devices_spec_unparsed = DefaultCollectiveDevicesIfEmpty(
-      collective_devices_spec_unparsed, num_nodes, num_devices_per_host);
   cfg.replica_groups_list =
-      CollectiveDeviceLists(collective_devices_spec_unparsed);
+      collective_devices_spec_unparsed.empty()
+          ? CollectivePerfTableGen::ReplicaGroupsSweep(num_nodes,
+                                                       num_devices_per_host)
+          : CollectiveDeviceLists(collective_devices_spec_unparsed);
   cfg.output = output;
 
   std::unique_ptr<CollectivePerfTableGen> gen =
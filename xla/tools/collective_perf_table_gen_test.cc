@@ -16,7 +16,9 @@ limitations under the License.
 #include "xla/tools/collective_perf_table_gen.h"
 
 #include <memory>
+#include <string>
 #include <variant>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -28,6 +30,7 @@ namespace xla::gpu {
 namespace {
 
 using ::testing::Each;
+using ::testing::ElementsAre;
 using ::testing::Gt;
 using ::testing::Property;
 
@@ -129,5 +132,21 @@ TEST_F(CollectivePerfTableGenTest, HappyPathWorks) {
                     Gt(0))));
 }
 
+TEST(ReplicaGroupsSweepTest, SweepsSingleHost) {
+  EXPECT_THAT(CollectivePerfTableGen::ReplicaGroupsSweep(
+                  /*num_nodes=*/1, /*num_devices_per_host=*/8),
+              ElementsAre("[1,8]<=[8]", "[2,4]<=[8]", "[4,2]<=[8]"));
+}
+
+TEST(ReplicaGroupsSweepTest, SweepsWithinAndAcrossHosts) {
+  std::vector<std::string> replica_groups =
+      CollectivePerfTableGen::ReplicaGroupsSweep(/*num_nodes=*/4,
+                                                 /*num_devices_per_host=*/4);
+  EXPECT_THAT(replica_groups,
+              ElementsAre("[4,4]<=[16]", "[8,2]<=[16]", "[1,16]<=[16]",
+                          "[4,4]<=[4,4]T(1,0)", "[2,8]<=[16]",
+                          "[8,2]<=[4,4]T(1,0)"));
+}
+
 }  // namespace
 }  // namespace xla::gpu
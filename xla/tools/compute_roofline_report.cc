@@ -0,0 +1,221 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/tools/compute_roofline_report.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/match.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "xla/hlo/ir/hlo_computation.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/service/gpu/model/gpu_hlo_cost_analysis.h"
+#include "xla/service/gpu/model/gpu_performance_model_base.h"
+#include "xla/service/hlo_cost_analysis.h"
+#include "xla/shape.h"
+#include "xla/shape_util.h"
+#include "xla/stream_executor/device_description.h"
+#include "xla/stream_executor/device_description.pb.h"
+#include "xla/tools/hlo_module_loader.h"
+#include "xla/tsl/platform/env.h"
+#include "xla/tsl/platform/errors.h"
+#include "xla/tsl/platform/statusor.h"
+#include "tsl/profiler/protobuf/xplane.pb.h"
+
+namespace xla::gpu {
+namespace {
+
+// Returns the name of the HLO instruction an XEvent was produced by. Kernel
+// events carry it in the `hlo_op` stat; fall back to the event (kernel) name,
+// which XLA derives from the fusion name.
+std::string GetHloOpName(const tensorflow::profiler::XPlane& plane,
+                         const tensorflow::profiler::XEvent& event,
+                         int64_t hlo_op_stat_id) {
+  for (const auto& stat : event.stats()) {
+    if (stat.metadata_id() != hlo_op_stat_id) {
+      continue;
+    }
+    if (stat.value_case() == tensorflow::profiler::XStat::kStrValue) {
+      return stat.str_value();
+    }
+    if (stat.value_case() == tensorflow::profiler::XStat::kRefValue) {
+      if (auto it = plane.stat_metadata().find(stat.ref_value());
+          it != plane.stat_metadata().end()) {
+        return it->second.name();
+      }
+    }
+  }
+  if (auto it = plane.event_metadata().find(event.metadata_id());
+      it != plane.event_metadata().end()) {
+    return it->second.name();
+  }
+  return "";
+}
+
+}  // namespace
+
+absl::flat_hash_map<std::string, MeasuredTime> CollectMeasuredTimes(
+    const tensorflow::profiler::XSpace& xspace) {
+  absl::flat_hash_map<std::string, MeasuredTime> measured_times;
+  for (const tensorflow::profiler::XPlane& plane : xspace.planes()) {
+    if (!absl::StartsWith(plane.name(), "/device:GPU:")) {
+      continue;
+    }
+
+    int64_t hlo_op_stat_id = -1;
+    for (const auto& [id, stat_metadata] : plane.stat_metadata()) {
+      if (stat_metadata.name() == "hlo_op") {
+        hlo_op_stat_id = id;
+      }
+    }
+
+    for (const auto& line : plane.lines()) {
+      for (const auto& event : line.events()) {
+        std::string name = GetHloOpName(plane, event, hlo_op_stat_id);
+        if (name.empty()) {
+          continue;
+        }
+        MeasuredTime& measured_time = measured_times[name];
+        ++measured_time.num_executions;
+        measured_time.time_ps += event.duration_ps();
+      }
+    }
+  }
+  return measured_times;
+}
+
+absl::StatusOr<std::vector<RooflineStats>> ComputeRooflineStats(
+    const tensorflow::profiler::XSpace& xspace, const HloModule& module,
+    const se::DeviceDescription& device_info) {
+  GpuHloCostAnalysis analysis(
+      GpuHloCostAnalysis::Options{
+          [](const Shape& shape) {
+            return ShapeUtil::ByteSizeOf(shape, /*pointer_size=*/8);
+          },
+          /*per_second_rates=*/{},
+          /*min_latencies_seconds=*/{},
+          /*count_multiple_input_accesses=*/true},
+      device_info);
+
+  absl::flat_hash_map<absl::string_view, const HloInstruction*> instructions;
+  for (const HloComputation* computation :
+       module.MakeNonfusionComputations()) {
+    TF_RETURN_IF_ERROR(computation->Accept(&analysis));
+    for (const HloInstruction* instr : computation->instructions()) {
+      instructions[instr->name()] = instr;
+    }
+  }
+
+  double peak_flops_per_second =
+      1e9 * GpuPerformanceModelBase::CalculateEffectiveFlopsPerNs(
+                device_info, device_info.core_count(),
+                device_info.fpus_per_core());
+  double peak_bytes_per_second = device_info.memory_bandwidth();
+  if (peak_flops_per_second <= 0 || peak_bytes_per_second <= 0) {
+    return absl::InvalidArgumentError(
+        "Device description must specify compute and memory bandwidth peaks.");
+  }
+
+  std::vector<RooflineStats> result;
+  for (const auto& [name, measured_time] : CollectMeasuredTimes(xspace)) {
+    auto it = instructions.find(name);
+    if (it == instructions.end() || measured_time.time_ps == 0) {
+      continue;
+    }
+    const HloInstruction* instr = it->second;
+
+    RooflineStats& stats = result.emplace_back();
+    stats.name = name;
+    stats.num_executions = measured_time.num_executions;
+    stats.time_us = measured_time.time_ps / 1e6;
+    stats.flops = analysis.flop_count(*instr);
+    stats.bytes_accessed = analysis.bytes_accessed(*instr);
+
+    double time_s = measured_time.time_ps / 1e12;
+    double total_flops = 1.0 * stats.flops * stats.num_executions;
+    double total_bytes = 1.0 * stats.bytes_accessed * stats.num_executions;
+    stats.achieved_flops_per_second = total_flops / time_s;
+    stats.achieved_bytes_per_second = total_bytes / time_s;
+
+    double sol_time_s = std::max(total_flops / peak_flops_per_second,
+                                 total_bytes / peak_bytes_per_second);
+    stats.sol_time_us = sol_time_s * 1e6;
+    stats.sol_fraction = stats.sol_time_us / stats.time_us;
+    stats.time_lost_us = std::max(0.0, stats.time_us - stats.sol_time_us);
+  }
+
+  std::sort(result.begin(), result.end(),
+            [](const RooflineStats& a, const RooflineStats& b) {
+              if (a.time_lost_us != b.time_lost_us) {
+                return a.time_lost_us > b.time_lost_us;
+              }
+              return a.name < b.name;
+            });
+  return result;
+}
+
+std::string FormatRooflineReport(absl::Span<const RooflineStats> stats) {
+  std::string report = absl::StrFormat(
+      "%-40s %8s %12s %12s %12s %12s %8s %12s\n", "name", "count", "time_us",
+      "GFLOP/s", "GB/s", "sol_us", "sol_%", "lost_us");
+  for (const RooflineStats& s : stats) {
+    absl::StrAppendFormat(
+        &report, "%-40s %8d %12.2f %12.2f %12.2f %12.2f %7.1f%% %12.2f\n",
+        s.name, s.num_executions, s.time_us, s.achieved_flops_per_second / 1e9,
+        s.achieved_bytes_per_second / 1e9, s.sol_time_us,
+        s.sol_fraction * 100.0, s.time_lost_us);
+  }
+  return report;
+}
+
+absl::Status RunRooflineReport(absl::string_view xspace_file,
+                               absl::string_view hlo_file,
+                               absl::string_view device_spec_file) {
+  if (xspace_file.empty() || hlo_file.empty() || device_spec_file.empty()) {
+    return absl::InvalidArgumentError(
+        "XSpace, HLO and device spec files must be specified.");
+  }
+
+  tsl::Env* env = tsl::Env::Default();
+  tensorflow::profiler::XSpace xspace;
+  TF_RETURN_IF_ERROR(
+      tsl::ReadBinaryProto(env, std::string(xspace_file), &xspace));
+
+  TF_ASSIGN_OR_RETURN(std::unique_ptr<HloModule> module,
+                      LoadModuleFromFile(std::string(hlo_file)));
+
+  stream_executor::GpuTargetConfigProto device_spec;
+  TF_RETURN_IF_ERROR(
+      tsl::ReadTextProto(env, std::string(device_spec_file), &device_spec));
+  se::DeviceDescription device_info(device_spec.gpu_device_info());
+
+  TF_ASSIGN_OR_RETURN(std::vector<RooflineStats> stats,
+                      ComputeRooflineStats(xspace, *module, device_info));
+  std::cout << FormatRooflineReport(stats);
+  return absl::OkStatus();
+}
+
+}  // namespace xla::gpu
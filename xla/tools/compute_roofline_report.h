@@ -0,0 +1,95 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// A library for joining measured GPU kernel times from an XSpace protobuf with
+// HLO cost analysis of the optimized HLO module into a roofline report.
+
+#ifndef XLA_TOOLS_COMPUTE_ROOFLINE_REPORT_H_
+#define XLA_TOOLS_COMPUTE_ROOFLINE_REPORT_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/stream_executor/device_description.h"
+#include "tsl/profiler/protobuf/xplane.pb.h"
+
+namespace xla::gpu {
+
+// Measured and modeled performance of a single HLO instruction (usually a
+// fusion) executed on a GPU.
+struct RooflineStats {
+  std::string name;
+
+  // Number of kernel executions and their total measured device time.
+  int64_t num_executions = 0;
+  double time_us = 0.0;
+
+  // Cost of a single execution according to GpuHloCostAnalysis.
+  int64_t flops = 0;
+  int64_t bytes_accessed = 0;
+
+  // Achieved throughput over all executions.
+  double achieved_flops_per_second = 0.0;
+  double achieved_bytes_per_second = 0.0;
+
+  // Speed-of-light time of all executions, i.e. the time the executions would
+  // take when limited only by the device's peak compute or memory bandwidth.
+  double sol_time_us = 0.0;
+
+  // `sol_time_us / time_us`, 1.0 means the instruction runs at the roofline.
+  double sol_fraction = 0.0;
+
+  // `time_us - sol_time_us`.
+  double time_lost_us = 0.0;
+};
+
+// Total measured device time of an HLO instruction.
+struct MeasuredTime {
+  int64_t num_executions = 0;
+  int64_t time_ps = 0;
+};
+
+// Returns the measured device time of every HLO instruction found in GPU device
+// planes of `xspace`, keyed by instruction name.
+absl::flat_hash_map<std::string, MeasuredTime> CollectMeasuredTimes(
+    const tensorflow::profiler::XSpace& xspace);
+
+// Joins measured times from `xspace` with the cost analysis of `module` and
+// returns roofline stats for every measured instruction of `module`, sorted by
+// time lost relative to the speed of light of `device_info`.
+absl::StatusOr<std::vector<RooflineStats>> ComputeRooflineStats(
+    const tensorflow::profiler::XSpace& xspace, const HloModule& module,
+    const se::DeviceDescription& device_info);
+
+// Formats roofline stats as a human readable table.
+std::string FormatRooflineReport(absl::Span<const RooflineStats> stats);
+
+// Reads an XSpace protobuf, an optimized HLO module and a device spec
+// (GpuTargetConfigProto in text format) from files and prints the roofline
+// report to stdout.
+absl::Status RunRooflineReport(absl::string_view xspace_file,
+                               absl::string_view hlo_file,
+                               absl::string_view device_spec_file);
+
+}  // namespace xla::gpu
+
+#endif  // XLA_TOOLS_COMPUTE_ROOFLINE_REPORT_H_
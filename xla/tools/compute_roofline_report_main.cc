@@ -0,0 +1,67 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// A tool for computing a per-fusion roofline report from an XSpace protobuf and
+// the optimized HLO module it was captured from.
+
+#include <string>
+#include <vector>
+
+#include "absl/log/log.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "xla/tools/compute_roofline_report.h"
+#include "xla/tsl/util/command_line_flags.h"
+#include "tsl/platform/init_main.h"
+
+namespace {
+
+const char* const kUsage = R"(
+    This tool joins measured GPU kernel times from an XSpace protobuf with the
+    cost analysis of the optimized HLO module and reports achieved FLOP/s,
+    achieved bandwidth and the fraction of speed of light of every fusion,
+    sorted by time lost.
+
+    Usage:
+
+      bazel run compute_roofline_report_main -- --xspace=path/to/xspace.pb \
+        --hlo=path/to/module.hlo \
+        --device_spec=xla/tools/hlo_opt/gpu_specs/h100_sxm.txtpb
+    )";
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::string xspace, hlo, device_spec;
+  std::vector<tsl::Flag> flag_list = {
+      tsl::Flag("xspace", &xspace, "XSpace protobuf file"),
+      tsl::Flag("hlo", &hlo, "Optimized HLO module file"),
+      tsl::Flag("device_spec", &device_spec,
+                "GpuTargetConfigProto text proto file")};
+  const std::string kUsageString =
+      absl::StrCat(kUsage, "\n\n", tsl::Flags::Usage(argv[0], flag_list));
+  bool parse_ok = tsl::Flags::Parse(&argc, argv, flag_list);
+  tsl::port::InitMain(kUsageString.c_str(), &argc, &argv);
+  if (!parse_ok) {
+    LOG(QFATAL) << kUsageString;
+  }
+
+  absl::Status status = xla::gpu::RunRooflineReport(xspace, hlo, device_spec);
+  if (!status.ok()) {
+    LOG(ERROR) << status;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,94 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/tools/compute_roofline_report.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/parser/hlo_parser.h"
+#include "xla/service/gpu/gpu_device_info_for_tests.h"
+#include "xla/stream_executor/device_description.h"
+#include "xla/tsl/platform/statusor.h"
+#include "tsl/profiler/protobuf/xplane.pb.h"
+
+namespace xla::gpu {
+namespace {
+
+constexpr absl::string_view kHlo = R"(
+HloModule m
+
+fused_add {
+  p0 = f32[1024] parameter(0)
+  p1 = f32[1024] parameter(1)
+  ROOT add = f32[1024] add(p0, p1)
+}
+
+ENTRY e {
+  p0 = f32[1024] parameter(0)
+  p1 = f32[1024] parameter(1)
+  ROOT fusion = f32[1024] fusion(p0, p1), kind=kLoop, calls=fused_add
+})";
+
+// Adds a kernel event for `hlo_op` lasting `duration_ps` to `line`.
+void AddKernelEvent(tensorflow::profiler::XLine* line, int64_t hlo_op_stat_id,
+                    absl::string_view hlo_op, int64_t duration_ps) {
+  tensorflow::profiler::XEvent* event = line->add_events();
+  event->set_duration_ps(duration_ps);
+  tensorflow::profiler::XStat* stat = event->add_stats();
+  stat->set_metadata_id(hlo_op_stat_id);
+  stat->set_str_value(std::string(hlo_op));
+}
+
+TEST(ComputeRooflineReportTest, ComputeRooflineStats) {
+  tensorflow::profiler::XSpace xspace;
+  tensorflow::profiler::XPlane* plane = xspace.add_planes();
+  plane->set_name("/device:GPU:0");
+  tensorflow::profiler::XStatMetadata* stat_metadata =
+      &(*plane->mutable_stat_metadata())[1];
+  stat_metadata->set_id(1);
+  stat_metadata->set_name("hlo_op");
+  tensorflow::profiler::XLine* line = plane->add_lines();
+  AddKernelEvent(line, 1, "fusion", 2000000);
+  AddKernelEvent(line, 1, "fusion", 2000000);
+  AddKernelEvent(line, 1, "unknown", 1000000);
+
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnUnverifiedModule(kHlo));
+  se::DeviceDescription device_info = TestGpuDeviceInfo::RTXA6000DeviceInfo();
+
+  TF_ASSERT_OK_AND_ASSIGN(std::vector<RooflineStats> stats,
+                          ComputeRooflineStats(xspace, *module, device_info));
+  ASSERT_EQ(stats.size(), 1);
+  EXPECT_EQ(stats[0].name, "fusion");
+  EXPECT_EQ(stats[0].num_executions, 2);
+  EXPECT_DOUBLE_EQ(stats[0].time_us, 4.0);
+  EXPECT_GT(stats[0].flops, 0);
+  // Two f32[1024] operands and one f32[1024] result.
+  EXPECT_EQ(stats[0].bytes_accessed, 3 * 4096);
+  EXPECT_DOUBLE_EQ(stats[0].achieved_bytes_per_second, 2 * 3 * 4096 / 4e-6);
+  EXPECT_GT(stats[0].sol_fraction, 0.0);
+  EXPECT_LT(stats[0].sol_fraction, 1.0);
+  EXPECT_DOUBLE_EQ(stats[0].time_lost_us,
+                   stats[0].time_us - stats[0].sol_time_us);
+}
+
+}  // namespace
+}  // namespace xla::gpu
@@ -0,0 +1,155 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/tools/cpu_jit_computation_handler.h"
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include "absl/algorithm/container.h"
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/log/log.h"
+#include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
+#include "xla/hlo/evaluator/hlo_evaluator.h"
+#include "xla/hlo/ir/hlo_computation.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/literal.h"
+#include "xla/pjrt/pjrt_client.h"
+#include "xla/pjrt/plugin/xla_cpu/cpu_client_options.h"
+#include "xla/pjrt/plugin/xla_cpu/xla_cpu_pjrt_client.h"
+#include "xla/service/hlo_runner_interface.h"
+#include "xla/service/hlo_runner_pjrt.h"
+#include "xla/shape.h"
+#include "xla/shape_util.h"
+#include "xla/tools/hlo_decomposer.h"
+#include "xla/tsl/platform/statusor.h"
+
+namespace xla {
+namespace {
+
+int64_t ArrayBytes(const Shape& shape) {
+  int64_t bytes = 0;
+  ShapeUtil::ForEachSubshape(
+      shape, [&](const Shape& subshape, const ShapeIndex& /*index*/) {
+        if (subshape.IsArray()) {
+          bytes += ShapeUtil::ByteSizeOfElements(subshape);
+        }
+      });
+  return bytes;
+}
+
+// Returns true if running `computation` natively gives the same result as
+// evaluating it.
+bool CanCompile(const HloComputation& computation) {
+  auto is_unsupported = [](const HloInstruction* instr) {
+    return instr->HasSideEffect() ||
+           instr->opcode() == HloOpcode::kCustomCall ||
+           instr->shape().is_dynamic();
+  };
+  if (absl::c_any_of(computation.instructions(), is_unsupported)) {
+    return false;
+  }
+  for (const HloComputation* called :
+       computation.MakeEmbeddedComputationsList()) {
+    if (absl::c_any_of(called->instructions(), is_unsupported)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+class CpuJitComputationCache {
+ public:
+  CpuJitComputationCache(std::unique_ptr<HloRunnerPjRt> runner,
+                         int64_t min_bytes)
+      : runner_(std::move(runner)), min_bytes_(min_bytes) {}
+
+  absl::StatusOr<std::optional<Literal>> Evaluate(
+      const HloComputation& computation,
+      absl::Span<const Literal* const> args) {
+    // Checked first because the handler is offered every computation, down
+    // to the scalar reducers applied per element.
+    int64_t bytes = ArrayBytes(computation.root_instruction()->shape());
+    for (const Literal* arg : args) {
+      bytes += ArrayBytes(arg->shape());
+    }
+    if (bytes < min_bytes_ || !CanCompile(computation)) {
+      return std::nullopt;
+    }
+
+    std::unique_ptr<HloModule> module =
+        ExtractComputationIntoNewModule(computation);
+    std::string fingerprint = module->GetFingerprint128();
+
+    absl::MutexLock lock(&mu_);
+    auto it = executables_.find(fingerprint);
+    if (it == executables_.end()) {
+      VLOG(1) << "Compiling " << computation.name() << " (" << bytes
+              << " bytes) with XLA:CPU";
+      TF_ASSIGN_OR_RETURN(
+          std::unique_ptr<OpaqueExecutable> executable,
+          runner_->CreateExecutable(std::move(module),
+                                    /*run_hlo_passes=*/true));
+      it = executables_.emplace(fingerprint, std::move(executable)).first;
+    }
+    TF_ASSIGN_OR_RETURN(Literal result,
+                        runner_->ExecuteWithExecutable(it->second.get(), args,
+                                                       /*profile=*/nullptr));
+
+    const Shape& root_shape = computation.root_instruction()->shape();
+    if (root_shape.IsArray() && root_shape.has_layout()) {
+      return result.Relayout(root_shape);
+    }
+    return result;
+  }
+
+ private:
+  absl::Mutex mu_;
+  std::unique_ptr<HloRunnerPjRt> runner_ ABSL_GUARDED_BY(mu_);
+  absl::flat_hash_map<std::string, std::unique_ptr<OpaqueExecutable>>
+      executables_ ABSL_GUARDED_BY(mu_);
+  const int64_t min_bytes_;
+};
+
+}  // namespace
+
+absl::StatusOr<HloEvaluator::ComputationHandler> CreateCpuJitComputationHandler(
+    const CpuJitComputationHandlerOptions& options) {
+  CpuClientOptions client_options;
+  client_options.cpu_device_count = 1;
+  TF_ASSIGN_OR_RETURN(std::unique_ptr<PjRtClient> client,
+                      GetXlaPjrtCpuClient(std::move(client_options)));
+  auto runner = std::make_unique<HloRunnerPjRt>(
+      std::move(client), [](const Shape& shape) { return shape; },
+      [](const Shape& shape) {
+        return ShapeUtil::ByteSizeOf(shape, sizeof(void*));
+      });
+  auto cache = std::make_shared<CpuJitComputationCache>(std::move(runner),
+                                                        options.min_bytes);
+  return [cache](const HloComputation& computation,
+                 absl::Span<const Literal* const> args) {
+    return cache->Evaluate(computation, args);
+  };
+}
+
+}  // namespace xla
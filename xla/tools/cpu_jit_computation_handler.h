@@ -0,0 +1,47 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_TOOLS_CPU_JIT_COMPUTATION_HANDLER_H_
+#define XLA_TOOLS_CPU_JIT_COMPUTATION_HANDLER_H_
+
+#include <cstdint>
+
+#include "absl/status/statusor.h"
+#include "xla/hlo/evaluator/hlo_evaluator.h"
+
+namespace xla {
+
+struct CpuJitComputationHandlerOptions {
+  // Computations whose arguments and result together are smaller than this
+  // are left to the evaluator, since compiling them costs more than
+  // interpreting them.
+  int64_t min_bytes = 1 << 20;
+};
+
+// Returns an HloEvaluator::ComputationHandler that compiles large enough
+// computations with the XLA:CPU backend and runs them natively. Executables
+// are cached by the fingerprint of the computation, so e.g. a while body is
+// only compiled once. Computations with side effects or custom calls are left
+// to the evaluator. The handler is thread-safe.
+//
+// Usage:
+//   TF_ASSIGN_OR_RETURN(auto handler, CreateCpuJitComputationHandler());
+//   evaluator.set_computation_handler(std::move(handler));
+absl::StatusOr<HloEvaluator::ComputationHandler> CreateCpuJitComputationHandler(
+    const CpuJitComputationHandlerOptions& options = {});
+
+}  // namespace xla
+
+#endif  // XLA_TOOLS_CPU_JIT_COMPUTATION_HANDLER_H_
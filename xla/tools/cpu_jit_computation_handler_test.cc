@@ -0,0 +1,89 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/tools/cpu_jit_computation_handler.h"
+
+#include <memory>
+#include <optional>
+
+#include <gtest/gtest.h>
+#include "absl/strings/string_view.h"
+#include "xla/hlo/evaluator/hlo_evaluator.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/testlib/hlo_hardware_independent_test_base.h"
+#include "xla/literal.h"
+#include "xla/literal_util.h"
+#include "xla/tsl/platform/statusor.h"
+
+namespace xla {
+namespace {
+
+using CpuJitComputationHandlerTest = HloHardwareIndependentTestBase;
+
+constexpr absl::string_view kHloModule = R"(
+  HloModule module
+
+  add {
+    p0 = f32[] parameter(0)
+    p1 = f32[] parameter(1)
+    ROOT add = f32[] add(p0, p1)
+  }
+
+  ENTRY main {
+    p0 = f32[256,256] parameter(0)
+    iota = f32[256,256] iota(), iota_dimension=1
+    mul = f32[256,256] multiply(p0, iota)
+    zero = f32[] constant(0)
+    ROOT reduce = f32[256] reduce(mul, zero), dimensions={1}, to_apply=add
+  })";
+
+TEST_F(CpuJitComputationHandlerTest, MatchesEvaluator) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(kHloModule));
+  Literal arg = LiteralUtil::CreateFullWithDescendingLayout<float>(
+      {256, 256}, 0.5f);
+
+  TF_ASSERT_OK_AND_ASSIGN(Literal expected,
+                          HloEvaluator().Evaluate(*module, {&arg}));
+
+  TF_ASSERT_OK_AND_ASSIGN(HloEvaluator::ComputationHandler handler,
+                          CreateCpuJitComputationHandler({/*min_bytes=*/0}));
+  TF_ASSERT_OK_AND_ASSIGN(std::optional<Literal> compiled,
+                          handler(*module->entry_computation(), {&arg}));
+  ASSERT_TRUE(compiled.has_value());
+  EXPECT_EQ(*compiled, expected);
+
+  HloEvaluator evaluator;
+  evaluator.set_computation_handler(handler);
+  TF_ASSERT_OK_AND_ASSIGN(Literal actual, evaluator.Evaluate(*module, {&arg}));
+  EXPECT_EQ(actual, expected);
+}
+
+TEST_F(CpuJitComputationHandlerTest, LeavesSmallComputationsToEvaluator) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(kHloModule));
+  Literal arg = LiteralUtil::CreateFullWithDescendingLayout<float>(
+      {256, 256}, 0.5f);
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      HloEvaluator::ComputationHandler handler,
+      CreateCpuJitComputationHandler({/*min_bytes=*/1 << 30}));
+  TF_ASSERT_OK_AND_ASSIGN(std::optional<Literal> compiled,
+                          handler(*module->entry_computation(), {&arg}));
+  EXPECT_FALSE(compiled.has_value());
+}
+
+}  // namespace
+}  // namespace xla
@@ -0,0 +1,237 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/tools/fusion_benchmark.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/log/log.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/string_view.h"
+#include "absl/time/time.h"
+#include "absl/types/span.h"
+#include "xla/backends/autotuner/codegen_backend.h"
+#include "xla/backends/autotuner/profiler.h"
+#include "xla/hlo/ir/hlo_computation.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/service/executable.h"
+#include "xla/stream_executor/stream_executor.h"
+#include "xla/tools/hlo_decomposer.h"
+#include "xla/tsl/platform/env.h"
+#include "xla/tsl/platform/errors.h"
+#include "tsl/platform/path.h"
+
+namespace xla {
+namespace {
+
+// Returns the fastest time of `backend` for the root instruction of `module`,
+// or std::nullopt if the backend cannot run it.
+std::optional<absl::Duration> BenchmarkWithBackend(
+    const HloModule& module, CodegenBackend& backend, Profiler& profiler,
+    stream_executor::StreamExecutor* stream_executor) {
+  const HloInstruction& fusion =
+      *module.entry_computation()->root_instruction();
+  absl::StatusOr<std::vector<std::unique_ptr<BackendConfig>>> configs =
+      backend.GetSupportedConfigs(fusion, stream_executor);
+  if (!configs.ok()) {
+    VLOG(1) << backend.name() << " does not support " << module.name() << ": "
+            << configs.status();
+    return std::nullopt;
+  }
+
+  std::vector<std::unique_ptr<Executable>> executables;
+  for (const std::unique_ptr<BackendConfig>& config : *configs) {
+    absl::StatusOr<std::unique_ptr<Executable>> executable =
+        backend.Compile(fusion, *config);
+    if (!executable.ok()) {
+      VLOG(1) << "Failed to compile " << module.name() << " with "
+              << backend.name() << ": " << executable.status();
+      continue;
+    }
+    executables.push_back(*std::move(executable));
+  }
+  if (executables.empty()) {
+    return std::nullopt;
+  }
+
+  absl::StatusOr<std::vector<ProfileResult>> results =
+      profiler.ProfileWithSharedBuffers(std::move(executables));
+  if (!results.ok()) {
+    LOG(WARNING) << "Failed to profile " << module.name() << " with "
+                 << backend.name() << ": " << results.status();
+    return std::nullopt;
+  }
+  std::optional<absl::Duration> fastest;
+  for (const ProfileResult& result : *results) {
+    if (!fastest.has_value() || result.duration < *fastest) {
+      fastest = result.duration;
+    }
+  }
+  return fastest;
+}
+
+std::optional<absl::Duration> FastestDuration(
+    const FusionBenchmark& benchmark) {
+  std::optional<absl::Duration> fastest;
+  for (const std::optional<absl::Duration>& duration : benchmark.durations) {
+    if (duration.has_value() &&
+        (!fastest.has_value() || *duration < *fastest)) {
+      fastest = duration;
+    }
+  }
+  return fastest;
+}
+
+std::string FormatDuration(std::optional<absl::Duration> duration) {
+  if (!duration.has_value()) {
+    return "-";
+  }
+  return absl::StrFormat("%.2fus", absl::ToDoubleMicroseconds(*duration));
+}
+
+}  // namespace
+
+std::vector<FusionBenchmark> ExtractFusionBenchmarks(const HloModule& module) {
+  std::vector<FusionBenchmark> benchmarks;
+  absl::flat_hash_map<std::string, size_t> fingerprint_to_index;
+  for (const HloComputation* computation :
+       module.MakeNonfusionComputations()) {
+    for (const HloInstruction* instruction : computation->instructions()) {
+      if (instruction->opcode() != HloOpcode::kFusion) {
+        continue;
+      }
+      std::unique_ptr<HloModule> extracted =
+          ExtractInstructionIntoNewModule(*instruction);
+      auto [it, inserted] = fingerprint_to_index.try_emplace(
+          extracted->GetFingerprint128(), benchmarks.size());
+      if (!inserted) {
+        ++benchmarks[it->second].num_occurrences;
+        continue;
+      }
+      FusionBenchmark& benchmark = benchmarks.emplace_back();
+      benchmark.fusion_name = instruction->name();
+      benchmark.num_occurrences = 1;
+      benchmark.module = std::move(extracted);
+    }
+  }
+  return benchmarks;
+}
+
+absl::Status RunFusionBenchmarks(
+    absl::Span<FusionBenchmark> benchmarks,
+    absl::Span<CodegenBackend* const> backends, Profiler& profiler,
+    stream_executor::StreamExecutor* stream_executor) {
+  for (FusionBenchmark& benchmark : benchmarks) {
+    if (benchmark.module == nullptr) {
+      return absl::InvalidArgumentError(
+          absl::StrCat("Benchmark ", benchmark.fusion_name, " has no module"));
+    }
+    benchmark.durations.clear();
+    for (CodegenBackend* backend : backends) {
+      benchmark.durations.push_back(BenchmarkWithBackend(
+          *benchmark.module, *backend, profiler, stream_executor));
+    }
+    VLOG(1) << "Benchmarked " << benchmark.fusion_name;
+  }
+  return absl::OkStatus();
+}
+
+std::string FormatFusionBenchmarkTable(
+    absl::Span<const FusionBenchmark> benchmarks,
+    absl::Span<CodegenBackend* const> backends) {
+  std::vector<std::vector<std::string>> rows;
+  std::vector<std::string>& header = rows.emplace_back();
+  header.push_back("fusion");
+  header.push_back("count");
+  for (const CodegenBackend* backend : backends) {
+    header.push_back(std::string(backend->name()));
+  }
+  header.push_back("best");
+
+  // Fusions that take the most time in total come first.
+  std::vector<const FusionBenchmark*> sorted;
+  sorted.reserve(benchmarks.size());
+  for (const FusionBenchmark& benchmark : benchmarks) {
+    sorted.push_back(&benchmark);
+  }
+  auto total_time = [](const FusionBenchmark* benchmark) {
+    return FastestDuration(*benchmark).value_or(absl::ZeroDuration()) *
+           benchmark->num_occurrences;
+  };
+  std::stable_sort(sorted.begin(), sorted.end(),
+                   [&](const FusionBenchmark* a, const FusionBenchmark* b) {
+                     return total_time(a) > total_time(b);
+                   });
+
+  for (const FusionBenchmark* benchmark : sorted) {
+    std::vector<std::string>& row = rows.emplace_back();
+    row.push_back(benchmark->fusion_name);
+    row.push_back(absl::StrCat(benchmark->num_occurrences));
+    std::optional<absl::Duration> fastest = FastestDuration(*benchmark);
+    std::string best = "-";
+    for (size_t i = 0; i < backends.size(); ++i) {
+      std::optional<absl::Duration> duration =
+          i < benchmark->durations.size() ? benchmark->durations[i]
+                                          : std::nullopt;
+      row.push_back(FormatDuration(duration));
+      if (duration.has_value() && duration == fastest && best == "-") {
+        best = std::string(backends[i]->name());
+      }
+    }
+    row.push_back(best);
+  }
+
+  std::vector<size_t> widths(rows.front().size(), 0);
+  for (const std::vector<std::string>& row : rows) {
+    for (size_t i = 0; i < row.size(); ++i) {
+      widths[i] = std::max(widths[i], row[i].size());
+    }
+  }
+  std::string table;
+  for (const std::vector<std::string>& row : rows) {
+    for (size_t i = 0; i < row.size(); ++i) {
+      absl::StrAppendFormat(&table, "%-*s%s", static_cast<int>(widths[i]),
+                            row[i], i + 1 < row.size() ? "  " : "\n");
+    }
+  }
+  return table;
+}
+
+absl::Status WriteFusionBenchmarkModules(
+    absl::Span<const FusionBenchmark> benchmarks, absl::string_view directory) {
+  tsl::Env* env = tsl::Env::Default();
+  TF_RETURN_IF_ERROR(env->RecursivelyCreateDir(std::string(directory)));
+  for (const FusionBenchmark& benchmark : benchmarks) {
+    std::string path = tsl::io::JoinPath(
+        directory, absl::StrCat(benchmark.fusion_name, ".hlo"));
+    TF_RETURN_IF_ERROR(
+        tsl::WriteStringToFile(env, path, benchmark.module->ToString()));
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace xla
@@ -0,0 +1,78 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_TOOLS_FUSION_BENCHMARK_H_
+#define XLA_TOOLS_FUSION_BENCHMARK_H_
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+#include "absl/time/time.h"
+#include "absl/types/span.h"
+#include "xla/backends/autotuner/codegen_backend.h"
+#include "xla/backends/autotuner/profiler.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/stream_executor/stream_executor.h"
+
+namespace xla {
+
+// A fusion of an optimized module extracted into a standalone module, and the
+// time it takes with each codegen backend.
+struct FusionBenchmark {
+  // Name of the first fusion that extracts to `module`.
+  std::string fusion_name;
+  // Number of fusions in the original module that extract to `module`.
+  int64_t num_occurrences = 0;
+  // Standalone module whose root instruction is the fusion.
+  std::unique_ptr<HloModule> module;
+  // Fastest time over all supported configs of each backend, in the order of
+  // the backends passed to RunFusionBenchmarks. std::nullopt if the backend
+  // does not support the fusion or none of its configs could be run.
+  std::vector<std::optional<absl::Duration>> durations;
+};
+
+// Extracts every fusion called from a non-fusion computation of `module` into
+// a standalone module. Fusions that extract to identical modules are returned
+// once.
+std::vector<FusionBenchmark> ExtractFusionBenchmarks(const HloModule& module);
+
+// Compiles every benchmark with every supported config of every backend and
+// records the fastest time of each backend. Backends that fail for a fusion
+// are recorded as std::nullopt rather than failing the whole run.
+absl::Status RunFusionBenchmarks(
+    absl::Span<FusionBenchmark> benchmarks,
+    absl::Span<CodegenBackend* const> backends, Profiler& profiler,
+    stream_executor::StreamExecutor* stream_executor);
+
+// Formats the results as a table with one row per fusion and one column per
+// backend, sorted by the time of the fastest backend times the number of
+// occurrences.
+std::string FormatFusionBenchmarkTable(
+    absl::Span<const FusionBenchmark> benchmarks,
+    absl::Span<CodegenBackend* const> backends);
+
+// Writes the module of every benchmark to `<directory>/<fusion_name>.hlo`, so
+// that each fusion can be reproduced in isolation, e.g. with run_hlo_module.
+absl::Status WriteFusionBenchmarkModules(
+    absl::Span<const FusionBenchmark> benchmarks, absl::string_view directory);
+
+}  // namespace xla
+
+#endif  // XLA_TOOLS_FUSION_BENCHMARK_H_
@@ -0,0 +1,143 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// A tool for benchmarking every fusion of an optimized HLO module in isolation
+// with each GPU codegen backend.
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/log/log.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/types/span.h"
+#include "xla/backends/autotuner/codegen_backend.h"
+#include "xla/backends/autotuner/profiler.h"
+#include "xla/backends/gpu/autotuner/cublas.h"
+#include "xla/backends/gpu/autotuner/cudnn.h"
+#include "xla/backends/gpu/autotuner/gpu_profiler.h"
+#include "xla/backends/gpu/autotuner/native_emitter.h"
+#include "xla/backends/gpu/autotuner/triton.h"
+#include "xla/debug_options_flags.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/service/compiler.h"
+#include "xla/service/platform_util.h"
+#include "xla/stream_executor/platform.h"
+#include "xla/stream_executor/stream_executor.h"
+#include "xla/tools/fusion_benchmark.h"
+#include "xla/tools/hlo_module_loader.h"
+#include "xla/tsl/platform/errors.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/tsl/util/command_line_flags.h"
+#include "xla/xla.pb.h"
+#include "tsl/platform/init_main.h"
+
+namespace {
+
+const char* const kUsage = R"(
+    This tool extracts every fusion of an optimized HLO module into a standalone
+    module, runs it on the GPU with every supported config of the Triton,
+    native emitter, cuDNN and cuBLAS backends, and prints a table with the
+    fastest time of each backend per fusion. Inputs are initialized with random
+    data and the L2 cache is flushed before every measured run.
+
+    With --output_dir, every extracted fusion is also written to
+    <output_dir>/<fusion_name>.hlo, so that it can be reproduced with e.g.
+    run_hlo_module.
+
+    Usage:
+
+      bazel run fusion_benchmark_main -- --input=path/to/module.hlo \
+        --format=hlo --output_dir=/tmp/fusions
+    )";
+
+}  // namespace
+
+namespace xla {
+namespace {
+
+absl::Status Run(const std::string& input, const std::string& format,
+                 const std::string& output_dir, bool flush_caches) {
+  TF_ASSIGN_OR_RETURN(std::unique_ptr<HloModule> module,
+                      LoadModuleFromFile(input, format, {}));
+  std::vector<FusionBenchmark> benchmarks = ExtractFusionBenchmarks(*module);
+  LOG(INFO) << "Extracted " << benchmarks.size() << " unique fusions.";
+  if (!output_dir.empty()) {
+    TF_RETURN_IF_ERROR(WriteFusionBenchmarkModules(benchmarks, output_dir));
+  }
+
+  TF_ASSIGN_OR_RETURN(se::Platform * platform,
+                      PlatformUtil::GetPlatform("gpu"));
+  TF_ASSIGN_OR_RETURN(se::StreamExecutor * stream_executor,
+                      platform->ExecutorForDevice(0));
+  TF_ASSIGN_OR_RETURN(std::unique_ptr<Compiler> compiler,
+                      Compiler::GetForPlatform(platform));
+  Compiler::TargetConfig target_config(stream_executor);
+  DebugOptions debug_options = GetDebugOptionsFromFlags();
+
+  gpu::TritonBackend triton(&target_config, &debug_options, compiler.get());
+  gpu::NativeEmitterBackend native(&target_config, &debug_options,
+                                   compiler.get());
+  gpu::CudnnBackend cudnn(&target_config, &debug_options, compiler.get());
+  gpu::CublasBackend cublas(&target_config, &debug_options, compiler.get());
+  std::vector<CodegenBackend*> backends = {&triton, &native, &cudnn, &cublas};
+
+  ProfileOptions profile_options;
+  profile_options.redzone_padding_bytes = 0;
+  profile_options.should_init_buffers = true;
+  profile_options.should_flush_caches = flush_caches;
+  std::unique_ptr<gpu::GpuProfiler> profiler =
+      gpu::GpuProfiler::Create(stream_executor, profile_options);
+  if (profiler == nullptr) {
+    return absl::InternalError("Failed to create the GPU profiler.");
+  }
+
+  TF_RETURN_IF_ERROR(RunFusionBenchmarks(absl::MakeSpan(benchmarks), backends,
+                                         *profiler, stream_executor));
+  std::cout << FormatFusionBenchmarkTable(benchmarks, backends);
+  return absl::OkStatus();
+}
+
+}  // namespace
+}  // namespace xla
+
+int main(int argc, char** argv) {
+  std::string input, format = "hlo", output_dir;
+  bool flush_caches = true;
+  std::vector<tsl::Flag> flag_list = {
+      tsl::Flag("input", &input, "Optimized HLO module file"),
+      tsl::Flag("format", &format, "hlo|pb|pbtxt"),
+      tsl::Flag("output_dir", &output_dir,
+                "Directory to write the extracted fusions to"),
+      tsl::Flag("flush_caches", &flush_caches,
+                "Flush the L2 cache before every measured run")};
+  xla::AppendDebugOptionsFlags(&flag_list);
+  const std::string kUsageString =
+      absl::StrCat(kUsage, "\n\n", tsl::Flags::Usage(argv[0], flag_list));
+  bool parse_ok = tsl::Flags::Parse(&argc, argv, flag_list);
+  tsl::port::InitMain(kUsageString.c_str(), &argc, &argv);
+  if (!parse_ok) {
+    LOG(QFATAL) << kUsageString;
+  }
+
+  absl::Status status = xla::Run(input, format, output_dir, flush_caches);
+  if (!status.ok()) {
+    LOG(ERROR) << status;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,178 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/tools/fusion_benchmark.h"
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/time/time.h"
+#include "absl/types/span.h"
+#include "xla/backends/autotuner/codegen_backend.h"
+#include "xla/backends/autotuner/profiler.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/hlo/testlib/hlo_hardware_independent_test_base.h"
+#include "xla/service/executable.h"
+#include "xla/service/gpu/backend_configs.pb.h"
+#include "xla/stream_executor/stream_executor.h"
+#include "xla/tsl/platform/status_matchers.h"
+#include "xla/tsl/platform/statusor.h"
+
+namespace xla {
+namespace {
+
+using ::testing::_;
+using ::testing::ElementsAre;
+using ::testing::HasSubstr;
+using ::testing::Optional;
+using ::testing::Return;
+using ::tsl::testing::IsOk;
+
+class MockCodegenBackend : public CodegenBackend {
+ public:
+  MOCK_METHOD(absl::string_view, name, (), (const, override));
+  MOCK_METHOD(absl::StatusOr<std::vector<std::unique_ptr<BackendConfig>>>,
+              GetSupportedConfigs,
+              (const HloInstruction& instr,
+               stream_executor::StreamExecutor* stream_executor),
+              (override));
+  MOCK_METHOD(absl::StatusOr<std::unique_ptr<Executable>>, Compile,
+              (const HloInstruction& instr, const BackendConfig& config),
+              (override));
+  MOCK_METHOD(absl::Status, ApplyConfig,
+              (HloInstruction & instr, const BackendConfig& config),
+              (override));
+};
+
+class MockProfiler : public Profiler {
+ public:
+  MOCK_METHOD(absl::StatusOr<std::vector<ProfileResult>>,
+              ProfileWithSharedBuffers,
+              (std::vector<std::unique_ptr<Executable>> executables),
+              (override));
+};
+
+// Use one of existing gpu backend config protos as a test config.
+std::vector<std::unique_ptr<BackendConfig>> GetTestConfigs(int num_configs) {
+  std::vector<std::unique_ptr<BackendConfig>> configs;
+  for (int i = 0; i < num_configs; ++i) {
+    configs.push_back(std::make_unique<gpu::CustomFusionConfig>());
+  }
+  return configs;
+}
+
+constexpr absl::string_view kHloModule = R"(
+  HloModule module
+
+  negate {
+    p0 = f32[1024] parameter(0)
+    ROOT negate = f32[1024] negate(p0)
+  }
+
+  exponential {
+    p0 = f32[1024] parameter(0)
+    ROOT exponential = f32[1024] exponential(p0)
+  }
+
+  ENTRY main {
+    p0 = f32[1024] parameter(0)
+    negate.1 = f32[1024] fusion(p0), kind=kLoop, calls=negate
+    negate.2 = f32[1024] fusion(negate.1), kind=kLoop, calls=negate
+    ROOT exponential = f32[1024] fusion(negate.2), kind=kLoop,
+        calls=exponential
+  })";
+
+class FusionBenchmarkTest : public HloHardwareIndependentTestBase {};
+
+TEST_F(FusionBenchmarkTest, ExtractsUniqueFusions) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(kHloModule));
+  std::vector<FusionBenchmark> benchmarks = ExtractFusionBenchmarks(*module);
+
+  ASSERT_EQ(benchmarks.size(), 2);
+  EXPECT_EQ(benchmarks[0].fusion_name, "negate.1");
+  EXPECT_EQ(benchmarks[0].num_occurrences, 2);
+  EXPECT_EQ(benchmarks[0].module->entry_computation()
+                ->root_instruction()
+                ->opcode(),
+            HloOpcode::kFusion);
+  EXPECT_EQ(benchmarks[1].fusion_name, "exponential");
+  EXPECT_EQ(benchmarks[1].num_occurrences, 1);
+}
+
+TEST_F(FusionBenchmarkTest, RecordsFastestConfigOfEveryBackend) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(kHloModule));
+  std::vector<FusionBenchmark> benchmarks = ExtractFusionBenchmarks(*module);
+  ASSERT_EQ(benchmarks.size(), 2);
+
+  MockCodegenBackend fast_backend;
+  EXPECT_CALL(fast_backend, name()).WillRepeatedly(Return("fast"));
+  EXPECT_CALL(fast_backend, GetSupportedConfigs)
+      .WillOnce(Return(GetTestConfigs(2)))
+      .WillOnce(Return(GetTestConfigs(2)));
+  EXPECT_CALL(fast_backend, Compile(_, _))
+      .Times(4)
+      .WillRepeatedly([](const HloInstruction&, const BackendConfig&)
+                          -> absl::StatusOr<std::unique_ptr<Executable>> {
+        return std::unique_ptr<Executable>();
+      });
+
+  MockCodegenBackend unsupported_backend;
+  EXPECT_CALL(unsupported_backend, name())
+      .WillRepeatedly(Return("unsupported"));
+  EXPECT_CALL(unsupported_backend, GetSupportedConfigs)
+      .WillRepeatedly(Return(absl::InvalidArgumentError("unsupported")));
+
+  MockProfiler profiler;
+  std::vector<ProfileResult> negate_results = {{absl::Microseconds(3)},
+                                               {absl::Microseconds(2)}};
+  std::vector<ProfileResult> exponential_results = {{absl::Microseconds(5)},
+                                                    {absl::Microseconds(7)}};
+  EXPECT_CALL(profiler, ProfileWithSharedBuffers)
+      .WillOnce(Return(negate_results))
+      .WillOnce(Return(exponential_results));
+
+  std::vector<CodegenBackend*> backends = {&fast_backend,
+                                           &unsupported_backend};
+  EXPECT_THAT(RunFusionBenchmarks(absl::MakeSpan(benchmarks), backends,
+                                  profiler, /*stream_executor=*/nullptr),
+              IsOk());
+
+  EXPECT_THAT(benchmarks[0].durations,
+              ElementsAre(Optional(absl::Microseconds(2)), std::nullopt));
+  EXPECT_THAT(benchmarks[1].durations,
+              ElementsAre(Optional(absl::Microseconds(5)), std::nullopt));
+
+  // The exponential fusion takes 5us in total, the two negate fusions 4us.
+  std::string table = FormatFusionBenchmarkTable(benchmarks, backends);
+  EXPECT_THAT(table, HasSubstr("fast"));
+  EXPECT_THAT(table, HasSubstr("unsupported"));
+  EXPECT_LT(table.find("exponential"), table.find("negate.1"));
+  EXPECT_THAT(table, HasSubstr("2.00us"));
+}
+
+}  // namespace
+}  // namespace xla
@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "xla/tools/multihost_hlo_runner/functional_hlo_runner.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
@@ -248,22 +249,27 @@ ReadModuleFromUnoptimizedSnapshotBinaryProtoFile(absl::string_view hlo_file) {
   tsl::RandomAccessFileCopyingInputStream input_stream(file.get());
   tsl::protobuf::io::CopyingInputStreamAdaptor adaptor(&input_stream);
 
-  TF_ASSIGN_OR_RETURN(HloUnoptimizedSnapshot proto,
-                      DeserializeHloUnoptimizedSnapshot(&adaptor));
+  // Stream the arguments straight into literals to avoid materializing an
+  // intermediate LiteralProto copy of every argument.
+  std::vector<std::vector<Literal>>& arguments =
+      hlo_module_and_arguments.arguments;
+  TF_ASSIGN_OR_RETURN(
+      HloUnoptimizedSnapshot metadata,
+      DeserializeHloUnoptimizedSnapshotStreaming(
+          &adaptor,
+          [&](int partition_index, int argument_index,
+              Literal argument) -> absl::Status {
+            if (arguments.size() <= static_cast<size_t>(partition_index)) {
+              arguments.resize(partition_index + 1);
+            }
+            arguments[partition_index].push_back(std::move(argument));
+            return absl::OkStatus();
+          }));
+  arguments.resize(std::max<size_t>(arguments.size(),
+                                    metadata.partitions_size()));
 
   TF_ASSIGN_OR_RETURN(hlo_module_and_arguments.hlo_module,
-                      CreateModuleFromProto(proto.hlo_module()));
-
-  for (const auto& arguments : proto.partitions()) {
-    hlo_module_and_arguments.arguments.emplace_back();
-    hlo_module_and_arguments.arguments.back().reserve(
-        arguments.arguments_size());
-    for (const auto& argument : arguments.arguments()) {
-      TF_ASSIGN_OR_RETURN(
-          hlo_module_and_arguments.arguments.back().emplace_back(),
-          Literal::CreateFromProto(argument));
-    }
-  }
+                      CreateModuleFromProto(metadata.hlo_module()));
   return hlo_module_and_arguments;
 }
 
@@ -0,0 +1,221 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/tools/perf_bisect.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/log/log.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/str_join.h"
+#include "absl/strings/string_view.h"
+#include "absl/time/time.h"
+#include "absl/types/span.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/service/hlo.pb.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/xla.pb.h"
+
+namespace xla {
+namespace {
+
+// Name HloPassFix records for each iteration of a fixed-point loop; it is not
+// a pass that can be disabled.
+constexpr absl::string_view kFixedPointIterationName = "fixed-point-iteration";
+
+std::vector<std::string> Concat(absl::Span<const std::string> a,
+                                absl::Span<const std::string> b) {
+  std::vector<std::string> result(a.begin(), a.end());
+  result.insert(result.end(), b.begin(), b.end());
+  return result;
+}
+
+class PerfBisector {
+ public:
+  PerfBisector(const DebugOptions& candidate, absl::Duration limit,
+               PerfMeasureFn& measure, int64_t& num_measurements)
+      : candidate_(candidate),
+        limit_(limit),
+        measure_(measure),
+        num_measurements_(num_measurements) {}
+
+  // Compiles the candidate with `disabled` passes disabled and returns the
+  // measurement if the run time is within the limit.
+  std::optional<PerfMeasurement> TryDisable(
+      absl::Span<const std::string> disabled) {
+    DebugOptions debug_options = candidate_;
+    for (const std::string& pass : disabled) {
+      debug_options.add_xla_disable_hlo_passes(pass);
+    }
+    ++num_measurements_;
+    absl::StatusOr<PerfMeasurement> measurement = measure_(debug_options);
+    if (!measurement.ok()) {
+      VLOG(1) << "Failed to measure with " << absl::StrJoin(disabled, ",")
+              << " disabled: " << measurement.status();
+      return std::nullopt;
+    }
+    VLOG(1) << "Run time with " << absl::StrJoin(disabled, ",")
+            << " disabled: " << measurement->run_time;
+    if (measurement->run_time > limit_) {
+      return std::nullopt;
+    }
+    return *std::move(measurement);
+  }
+
+  // Returns a small subset of `passes` such that disabling it together with
+  // `fixed` recovers the baseline. Disabling `fixed` and all of `passes` must
+  // recover the baseline.
+  std::vector<std::string> Minimize(absl::Span<const std::string> fixed,
+                                    absl::Span<const std::string> passes) {
+    if (passes.size() <= 1) {
+      return std::vector<std::string>(passes.begin(), passes.end());
+    }
+    const size_t half = passes.size() / 2;
+    absl::Span<const std::string> first = passes.subspan(0, half);
+    absl::Span<const std::string> second = passes.subspan(half);
+    if (TryDisable(Concat(fixed, first)).has_value()) {
+      return Minimize(fixed, first);
+    }
+    if (TryDisable(Concat(fixed, second)).has_value()) {
+      return Minimize(fixed, second);
+    }
+    // Both halves contribute to the slowdown, minimize each of them while
+    // keeping the other one disabled.
+    std::vector<std::string> first_culprits =
+        Minimize(Concat(fixed, second), first);
+    std::vector<std::string> second_culprits =
+        Minimize(Concat(fixed, first_culprits), second);
+    return Concat(first_culprits, second_culprits);
+  }
+
+ private:
+  const DebugOptions& candidate_;
+  absl::Duration limit_;
+  PerfMeasureFn& measure_;
+  int64_t& num_measurements_;
+};
+
+std::string FormatRunTime(absl::Duration run_time) {
+  return absl::StrFormat("%.3fms", absl::ToDoubleMilliseconds(run_time));
+}
+
+}  // namespace
+
+std::vector<std::string> PassesFromMetadata(const HloModule& module) {
+  std::vector<std::string> passes;
+  absl::flat_hash_set<std::string> seen;
+  for (const HloPassMetadata& pass_metadata :
+       module.metadata().proto().pass_metadata()) {
+    const std::string& name = pass_metadata.pass_name();
+    if (name.empty() || name == kFixedPointIterationName) {
+      continue;
+    }
+    if (seen.insert(name).second) {
+      passes.push_back(name);
+    }
+  }
+  return passes;
+}
+
+absl::StatusOr<PerfBisectResult> BisectPerformance(
+    const DebugOptions& baseline, const DebugOptions& candidate,
+    const PerfBisectOptions& options, PerfMeasureFn measure) {
+  if (!candidate.xla_enable_hlo_passes_only().empty()) {
+    return absl::InvalidArgumentError(
+        "Cannot bisect passes when xla_enable_hlo_passes_only is set.");
+  }
+
+  PerfBisectResult result;
+  TF_ASSIGN_OR_RETURN(PerfMeasurement baseline_measurement,
+                      measure(baseline));
+  TF_ASSIGN_OR_RETURN(PerfMeasurement candidate_measurement,
+                      measure(candidate));
+  result.num_measurements = 2;
+  result.baseline_run_time = baseline_measurement.run_time;
+  result.candidate_run_time = candidate_measurement.run_time;
+
+  const absl::Duration limit =
+      result.baseline_run_time * (1.0 + options.threshold);
+  if (result.candidate_run_time <= limit) {
+    LOG(INFO) << "The candidate is not slower than the baseline.";
+    return result;
+  }
+
+  std::vector<std::string> passes = options.passes;
+  if (passes.empty() && candidate_measurement.optimized_module != nullptr) {
+    passes = PassesFromMetadata(*candidate_measurement.optimized_module);
+  }
+  if (passes.empty()) {
+    return absl::FailedPreconditionError(
+        "No passes to bisect: the optimized module has no pass metadata and "
+        "no passes were given.");
+  }
+
+  PerfBisector bisector(candidate, limit, measure, result.num_measurements);
+  if (!bisector.TryDisable(passes).has_value()) {
+    return absl::FailedPreconditionError(absl::StrCat(
+        "Disabling all ", passes.size(),
+        " passes does not recover the baseline run time, so the regression "
+        "cannot be attributed to a pass."));
+  }
+  result.culprit_passes = bisector.Minimize({}, passes);
+
+  // Measure once more so that the reported module and run time belong to
+  // exactly the culprit set.
+  ++result.num_measurements;
+  DebugOptions without_culprits = candidate;
+  for (const std::string& pass : result.culprit_passes) {
+    without_culprits.add_xla_disable_hlo_passes(pass);
+  }
+  TF_ASSIGN_OR_RETURN(PerfMeasurement recovered, measure(without_culprits));
+  result.recovered_run_time = recovered.run_time;
+  result.with_culprits = std::move(candidate_measurement.optimized_module);
+  result.without_culprits = std::move(recovered.optimized_module);
+  return result;
+}
+
+std::string FormatPerfBisectResult(const PerfBisectResult& result) {
+  std::string report;
+  absl::StrAppend(&report, "Baseline run time:  ",
+                  FormatRunTime(result.baseline_run_time), "\n");
+  absl::StrAppendFormat(
+      &report, "Candidate run time: %s (%+.1f%%)\n",
+      FormatRunTime(result.candidate_run_time),
+      100.0 * (absl::FDivDuration(result.candidate_run_time,
+                                  result.baseline_run_time) -
+               1.0));
+  if (result.culprit_passes.empty()) {
+    absl::StrAppend(&report, "No regression found.\n");
+  } else {
+    absl::StrAppend(&report, "Culprit passes:     ",
+                    absl::StrJoin(result.culprit_passes, ", "), "\n");
+    absl::StrAppend(&report, "Without culprits:   ",
+                    FormatRunTime(result.recovered_run_time), "\n");
+  }
+  absl::StrAppend(&report, "Measurements:       ", result.num_measurements,
+                  "\n");
+  return report;
+}
+
+}  // namespace xla
@@ -0,0 +1,93 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_TOOLS_PERF_BISECT_H_
+#define XLA_TOOLS_PERF_BISECT_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/functional/any_invocable.h"
+#include "absl/status/statusor.h"
+#include "absl/time/time.h"
+#include "absl/types/span.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/xla.pb.h"
+
+namespace xla {
+
+// The optimized module produced by one compilation and its measured run time.
+struct PerfMeasurement {
+  std::shared_ptr<const HloModule> optimized_module;
+  absl::Duration run_time;
+};
+
+// Compiles the module under test with the given debug options and measures
+// its run time. Must be deterministic enough for the bisection to make sense,
+// e.g. by taking the minimum over several runs.
+using PerfMeasureFn =
+    absl::AnyInvocable<absl::StatusOr<PerfMeasurement>(const DebugOptions&)>;
+
+struct PerfBisectOptions {
+  // The candidate run time is considered a regression if it is more than
+  // `threshold` (relative) slower than the baseline, and disabling a set of
+  // passes is considered to recover the baseline if the run time is within
+  // `threshold` of it.
+  double threshold = 0.05;
+  // Passes to bisect over. If empty, all passes recorded in the metadata of
+  // the candidate's optimized module are used.
+  std::vector<std::string> passes;
+};
+
+struct PerfBisectResult {
+  absl::Duration baseline_run_time;
+  absl::Duration candidate_run_time;
+  // Smallest set of passes found whose disabling under the candidate options
+  // brings the run time back to the baseline. Usually a single pass; more
+  // than one if the slowdown only disappears when several are disabled
+  // together. Empty if there is no regression.
+  std::vector<std::string> culprit_passes;
+  // Run time of the candidate with `culprit_passes` disabled.
+  absl::Duration recovered_run_time;
+  // Optimized modules of the candidate with and without `culprit_passes`,
+  // e.g. for diffing. Null if there is no regression.
+  std::shared_ptr<const HloModule> with_culprits;
+  std::shared_ptr<const HloModule> without_culprits;
+  // Number of compilations and measurements done.
+  int64_t num_measurements = 0;
+};
+
+// Returns the unique names of the passes that ran on `module`, in the order
+// they first ran, as recorded in its metadata.
+std::vector<std::string> PassesFromMetadata(const HloModule& module);
+
+// Finds the passes responsible for `candidate` being slower than `baseline`.
+// `baseline` and `candidate` are typically the same options with one set of
+// flags changed. The passes are bisected by compiling with `candidate` plus
+// a subset of them in xla_disable_hlo_passes, until the smallest subset that
+// recovers the baseline run time is found. Compilations that fail because a
+// required pass is disabled are treated as not recovering.
+absl::StatusOr<PerfBisectResult> BisectPerformance(
+    const DebugOptions& baseline, const DebugOptions& candidate,
+    const PerfBisectOptions& options, PerfMeasureFn measure);
+
+// Formats `result` as a human readable report.
+std::string FormatPerfBisectResult(const PerfBisectResult& result);
+
+}  // namespace xla
+
+#endif  // XLA_TOOLS_PERF_BISECT_H_
@@ -0,0 +1,305 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// A tool for finding the HLO pass responsible for a performance difference
+// between two sets of XLA flags.
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/log/log.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/string_view.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "absl/types/span.h"
+#include "xla/backends/autotuner/codegen_backend.h"
+#include "xla/backends/autotuner/profiler.h"
+#include "xla/backends/gpu/autotuner/gpu_profiler.h"
+#include "xla/backends/gpu/autotuner/native_emitter.h"
+#include "xla/backends/gpu/autotuner/triton.h"
+#include "xla/debug_options_flags.h"
+#include "xla/hlo/builder/xla_computation.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/tools/hlo_diff/hlo_gumgraph_diff.h"
+#include "xla/hlo/tools/hlo_diff/render/hlo_gumgraph_text_renderer.h"
+#include "xla/literal.h"
+#include "xla/pjrt/pjrt_client.h"
+#include "xla/pjrt/pjrt_executable.h"
+#include "xla/pjrt/pjrt_future.h"
+#include "xla/pjrt/plugin/xla_gpu/xla_gpu_client_options.h"
+#include "xla/pjrt/plugin/xla_gpu/xla_gpu_pjrt_client.h"
+#include "xla/service/compiler.h"
+#include "xla/service/platform_util.h"
+#include "xla/stream_executor/platform.h"
+#include "xla/stream_executor/stream_executor.h"
+#include "xla/tests/test_utils.h"
+#include "xla/tools/fusion_benchmark.h"
+#include "xla/tools/hlo_module_loader.h"
+#include "xla/tools/perf_bisect.h"
+#include "xla/tsl/platform/env.h"
+#include "xla/tsl/platform/errors.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/tsl/util/command_line_flags.h"
+#include "xla/xla.pb.h"
+#include "tsl/platform/init_main.h"
+
+namespace {
+
+const char* const kUsage = R"(
+    This tool finds the HLO passes responsible for a module running slower with
+    one set of XLA flags (the candidate) than with another (the baseline).
+
+    The module is compiled and run on the GPU with both sets of flags. If the
+    candidate is slower by more than --threshold, the passes that ran on the
+    candidate are bisected with --xla_disable_hlo_passes until the smallest set
+    of passes whose disabling brings the run time back to the baseline is
+    found. The optimized modules with and without these passes are then
+    compared with hlo_diff, and with --time_fusions the fusions of both are
+    timed in isolation with the fusion benchmark harness.
+
+    Usage:
+
+      bazel run perf_bisect_main -- --input=path/to/module.hlo \
+        --candidate_flags="--xla_gpu_enable_foo=true"
+    )";
+
+}  // namespace
+
+namespace xla {
+namespace {
+
+// Returns `base` with the XLA flags in `flags` applied on top of it.
+absl::StatusOr<DebugOptions> ApplyFlags(const DebugOptions& base,
+                                        const std::string& flags) {
+  DebugOptions debug_options = base;
+  std::vector<tsl::Flag> flag_list;
+  MakeDebugOptionsFlags(&flag_list, &debug_options);
+  std::vector<std::string> args = {"perf_bisect"};
+  for (absl::string_view flag :
+       absl::StrSplit(flags, ' ', absl::SkipWhitespace())) {
+    args.push_back(std::string(flag));
+  }
+  std::vector<char*> argv;
+  for (std::string& arg : args) {
+    argv.push_back(arg.data());
+  }
+  int argc = argv.size();
+  if (!tsl::Flags::Parse(&argc, argv.data(), flag_list) || argc != 1) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("Failed to parse XLA flags: ", flags));
+  }
+  return debug_options;
+}
+
+// Compiles `module` with `debug_options` and returns the fastest of
+// `num_runs` executions, after one warmup run.
+absl::StatusOr<PerfMeasurement> Measure(PjRtClient& client,
+                                        const HloModule& module,
+                                        absl::Span<const Literal> arguments,
+                                        const DebugOptions& debug_options,
+                                        int num_runs) {
+  CompileOptions compile_options;
+  *compile_options.executable_build_options.mutable_debug_options() =
+      debug_options;
+  TF_ASSIGN_OR_RETURN(std::unique_ptr<PjRtLoadedExecutable> executable,
+                      client.CompileAndLoad(XlaComputation(module.ToProto()),
+                                            compile_options));
+  TF_ASSIGN_OR_RETURN(std::vector<std::shared_ptr<HloModule>> modules,
+                      executable->GetHloModules());
+
+  PjRtDevice* device = client.addressable_devices()[0];
+  TF_ASSIGN_OR_RETURN(PjRtMemorySpace * memory_space,
+                      device->default_memory_space());
+  std::vector<std::unique_ptr<PjRtBuffer>> buffers;
+  std::vector<PjRtBuffer*> argument_handles;
+  for (const Literal& argument : arguments) {
+    TF_ASSIGN_OR_RETURN(std::unique_ptr<PjRtBuffer> buffer,
+                        client.BufferFromHostLiteral(argument, memory_space));
+    argument_handles.push_back(buffer.get());
+    buffers.push_back(std::move(buffer));
+  }
+
+  absl::Duration fastest = absl::InfiniteDuration();
+  for (int i = 0; i <= num_runs; ++i) {
+    absl::Time start = absl::Now();
+    std::optional<std::vector<PjRtFuture<>>> futures;
+    TF_ASSIGN_OR_RETURN(
+        std::vector<std::vector<std::unique_ptr<PjRtBuffer>>> outputs,
+        executable->Execute({argument_handles}, ExecuteOptions(), futures));
+    TF_RETURN_IF_ERROR(futures->at(0).Await());
+    if (i > 0) {
+      fastest = std::min(fastest, absl::Now() - start);
+    }
+  }
+  return PerfMeasurement{modules.at(0), fastest};
+}
+
+absl::Status PrintDiff(const HloModule& with_culprits,
+                       const HloModule& without_culprits,
+                       const std::string& diff_output) {
+  TF_ASSIGN_OR_RETURN(
+      hlo_diff::HloGumgraphDiffResults diff,
+      hlo_diff::ComputeDiff(without_culprits, with_culprits));
+  std::ostringstream summary;
+  hlo_diff::RenderTextSummary(*diff.diff_result, summary);
+  std::cout << "\nDiff of the optimized modules without and with the culprit "
+               "passes:\n"
+            << summary.str() << "\n";
+  if (!diff_output.empty()) {
+    std::ostringstream text;
+    hlo_diff::RenderText(*diff.diff_result, text);
+    TF_RETURN_IF_ERROR(
+        tsl::WriteStringToFile(tsl::Env::Default(), diff_output, text.str()));
+  }
+  return absl::OkStatus();
+}
+
+absl::Status PrintFusionTimes(const HloModule& with_culprits,
+                              const HloModule& without_culprits) {
+  TF_ASSIGN_OR_RETURN(se::Platform * platform,
+                      PlatformUtil::GetPlatform("gpu"));
+  TF_ASSIGN_OR_RETURN(se::StreamExecutor * stream_executor,
+                      platform->ExecutorForDevice(0));
+  TF_ASSIGN_OR_RETURN(std::unique_ptr<Compiler> compiler,
+                      Compiler::GetForPlatform(platform));
+  Compiler::TargetConfig target_config(stream_executor);
+  DebugOptions debug_options = GetDebugOptionsFromFlags();
+  gpu::TritonBackend triton(&target_config, &debug_options, compiler.get());
+  gpu::NativeEmitterBackend native(&target_config, &debug_options,
+                                   compiler.get());
+  std::vector<CodegenBackend*> backends = {&triton, &native};
+
+  ProfileOptions profile_options;
+  profile_options.redzone_padding_bytes = 0;
+  profile_options.should_init_buffers = true;
+  profile_options.should_flush_caches = true;
+  std::unique_ptr<gpu::GpuProfiler> profiler =
+      gpu::GpuProfiler::Create(stream_executor, profile_options);
+  if (profiler == nullptr) {
+    return absl::InternalError("Failed to create the GPU profiler.");
+  }
+
+  for (const auto& [label, module] :
+       {std::make_pair("without", &without_culprits),
+        std::make_pair("with", &with_culprits)}) {
+    std::vector<FusionBenchmark> benchmarks = ExtractFusionBenchmarks(*module);
+    TF_RETURN_IF_ERROR(RunFusionBenchmarks(absl::MakeSpan(benchmarks),
+                                           backends, *profiler,
+                                           stream_executor));
+    std::cout << "\nFusions " << label << " the culprit passes:\n"
+              << FormatFusionBenchmarkTable(benchmarks, backends);
+  }
+  return absl::OkStatus();
+}
+
+absl::Status Run(const std::string& input, const std::string& format,
+                 const std::string& baseline_flags,
+                 const std::string& candidate_flags,
+                 const PerfBisectOptions& options, int num_runs,
+                 const std::string& diff_output, bool time_fusions) {
+  TF_ASSIGN_OR_RETURN(std::unique_ptr<HloModule> module,
+                      LoadModuleFromFile(input, format, {}));
+  TF_ASSIGN_OR_RETURN(std::vector<Literal> arguments,
+                      MakeFakeArguments(module.get()));
+  TF_ASSIGN_OR_RETURN(std::unique_ptr<PjRtClient> client,
+                      GetXlaPjrtGpuClient(GpuClientOptions()));
+
+  DebugOptions debug_options = GetDebugOptionsFromFlags();
+  TF_ASSIGN_OR_RETURN(DebugOptions baseline,
+                      ApplyFlags(debug_options, baseline_flags));
+  TF_ASSIGN_OR_RETURN(DebugOptions candidate,
+                      ApplyFlags(debug_options, candidate_flags));
+
+  TF_ASSIGN_OR_RETURN(
+      PerfBisectResult result,
+      BisectPerformance(
+          baseline, candidate, options,
+          [&](const DebugOptions& measured_options) {
+            return Measure(*client, *module, arguments, measured_options,
+                           num_runs);
+          }));
+  std::cout << FormatPerfBisectResult(result);
+  if (result.culprit_passes.empty()) {
+    return absl::OkStatus();
+  }
+
+  TF_RETURN_IF_ERROR(PrintDiff(*result.with_culprits,
+                               *result.without_culprits, diff_output));
+  if (time_fusions) {
+    TF_RETURN_IF_ERROR(
+        PrintFusionTimes(*result.with_culprits, *result.without_culprits));
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace
+}  // namespace xla
+
+int main(int argc, char** argv) {
+  std::string input, format = "hlo", baseline_flags, candidate_flags, passes,
+                     diff_output;
+  float threshold = 0.05;
+  int num_runs = 10;
+  bool time_fusions = false;
+  std::vector<tsl::Flag> flag_list = {
+      tsl::Flag("input", &input, "Unoptimized HLO module file"),
+      tsl::Flag("format", &format, "hlo|pb|pbtxt"),
+      tsl::Flag("baseline_flags", &baseline_flags,
+                "XLA flags of the baseline, applied on top of XLA_FLAGS"),
+      tsl::Flag("candidate_flags", &candidate_flags,
+                "XLA flags of the candidate, applied on top of XLA_FLAGS"),
+      tsl::Flag("passes", &passes,
+                "Comma-separated passes to bisect over. Defaults to all "
+                "passes that ran on the candidate"),
+      tsl::Flag("threshold", &threshold,
+                "Relative slowdown considered a regression"),
+      tsl::Flag("num_runs", &num_runs,
+                "Number of measured runs per compilation, the fastest is "
+                "used"),
+      tsl::Flag("diff_output", &diff_output,
+                "File to write the full diff of the optimized modules to"),
+      tsl::Flag("time_fusions", &time_fusions,
+                "Time the fusions of the optimized modules in isolation")};
+  xla::AppendDebugOptionsFlags(&flag_list);
+  const std::string kUsageString =
+      absl::StrCat(kUsage, "\n\n", tsl::Flags::Usage(argv[0], flag_list));
+  bool parse_ok = tsl::Flags::Parse(&argc, argv, flag_list);
+  tsl::port::InitMain(kUsageString.c_str(), &argc, &argv);
+  if (!parse_ok) {
+    LOG(QFATAL) << kUsageString;
+  }
+
+  xla::PerfBisectOptions options;
+  options.threshold = threshold;
+  options.passes = absl::StrSplit(passes, ',', absl::SkipEmpty());
+  absl::Status status =
+      xla::Run(input, format, baseline_flags, candidate_flags, options,
+               num_runs, diff_output, time_fusions);
+  if (!status.ok()) {
+    LOG(ERROR) << status;
+    return 1;
+  }
+  return 0;
+}
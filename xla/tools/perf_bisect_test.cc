@@ -0,0 +1,145 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/tools/perf_bisect.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/algorithm/container.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/time/time.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/testlib/hlo_hardware_independent_test_base.h"
+#include "xla/tsl/platform/status_matchers.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/xla.pb.h"
+
+namespace xla {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::HasSubstr;
+using ::testing::IsEmpty;
+using ::tsl::testing::StatusIs;
+
+constexpr absl::string_view kHloModule = R"(
+  HloModule module
+
+  ENTRY main {
+    p0 = f32[1024] parameter(0)
+    ROOT negate = f32[1024] negate(p0)
+  })";
+
+class PerfBisectTest : public HloHardwareIndependentTestBase {
+ protected:
+  void SetUp() override {
+    TF_ASSERT_OK_AND_ASSIGN(module_, ParseAndReturnVerifiedModule(kHloModule));
+  }
+
+  // Returns a measurement that takes 1ms, plus 1ms for every pass of
+  // `slow_passes` that is not disabled in the candidate.
+  PerfMeasureFn MakeMeasureFn(std::vector<std::string> slow_passes) {
+    return [this, slow_passes](const DebugOptions& debug_options)
+               -> absl::StatusOr<PerfMeasurement> {
+      absl::Duration run_time = absl::Milliseconds(1);
+      if (debug_options.xla_gpu_exhaustive_tiling_search()) {
+        for (const std::string& pass : slow_passes) {
+          if (!absl::c_linear_search(debug_options.xla_disable_hlo_passes(),
+                                     pass)) {
+            run_time += absl::Milliseconds(1);
+          }
+        }
+      }
+      return PerfMeasurement{module_->Clone(), run_time};
+    };
+  }
+
+  DebugOptions Candidate() const {
+    DebugOptions debug_options;
+    debug_options.set_xla_gpu_exhaustive_tiling_search(true);
+    return debug_options;
+  }
+
+  std::unique_ptr<HloModule> module_;
+};
+
+TEST_F(PerfBisectTest, FindsSinglePass) {
+  PerfBisectOptions options;
+  options.passes = {"a", "b", "c", "d", "e"};
+  TF_ASSERT_OK_AND_ASSIGN(
+      PerfBisectResult result,
+      BisectPerformance(DebugOptions(), Candidate(), options,
+                        MakeMeasureFn({"d"})));
+
+  EXPECT_EQ(result.baseline_run_time, absl::Milliseconds(1));
+  EXPECT_EQ(result.candidate_run_time, absl::Milliseconds(2));
+  EXPECT_THAT(result.culprit_passes, ElementsAre("d"));
+  EXPECT_EQ(result.recovered_run_time, absl::Milliseconds(1));
+  EXPECT_NE(result.with_culprits, nullptr);
+  EXPECT_NE(result.without_culprits, nullptr);
+  EXPECT_THAT(FormatPerfBisectResult(result),
+              HasSubstr("Culprit passes:     d"));
+}
+
+TEST_F(PerfBisectTest, FindsInteractingPasses) {
+  PerfBisectOptions options;
+  options.passes = {"a", "b", "c", "d", "e", "f"};
+  TF_ASSERT_OK_AND_ASSIGN(
+      PerfBisectResult result,
+      BisectPerformance(DebugOptions(), Candidate(), options,
+                        MakeMeasureFn({"b", "e"})));
+
+  EXPECT_THAT(result.culprit_passes, ElementsAre("b", "e"));
+  EXPECT_EQ(result.recovered_run_time, absl::Milliseconds(1));
+}
+
+TEST_F(PerfBisectTest, NoRegression) {
+  PerfBisectOptions options;
+  options.passes = {"a", "b"};
+  TF_ASSERT_OK_AND_ASSIGN(
+      PerfBisectResult result,
+      BisectPerformance(DebugOptions(), DebugOptions(), options,
+                        MakeMeasureFn({"a"})));
+
+  EXPECT_THAT(result.culprit_passes, IsEmpty());
+  EXPECT_EQ(result.num_measurements, 2);
+  EXPECT_THAT(FormatPerfBisectResult(result), HasSubstr("No regression"));
+}
+
+TEST_F(PerfBisectTest, FailsIfNoPassExplainsTheRegression) {
+  PerfBisectOptions options;
+  options.passes = {"a", "b"};
+  EXPECT_THAT(BisectPerformance(DebugOptions(), Candidate(), options,
+                                MakeMeasureFn({"c"})),
+              StatusIs(absl::StatusCode::kFailedPrecondition));
+}
+
+TEST_F(PerfBisectTest, PassesFromMetadataSkipsDuplicates) {
+  for (absl::string_view pass : {"a", "fixed-point-iteration", "b", "a"}) {
+    module_->metadata()->RecordPassStart();
+    TF_ASSERT_OK(module_->metadata()->set_current_pass_name(std::string(pass)));
+    TF_ASSERT_OK(module_->metadata()->RecordPassEnd());
+  }
+  EXPECT_THAT(PassesFromMetadata(*module_), ElementsAre("a", "b"));
+}
+
+}  // namespace
+}  // namespace xla
@@ -15,12 +15,16 @@ limitations under the License.
 
 #include "xla/tsl/concurrency/async_value.h"
 
+#include <array>
 #include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <limits>
+#include <new>
 #include <utility>
 
+#include "absl/base/config.h"
 #include "absl/base/optimization.h"
 #include "absl/container/inlined_vector.h"
 #include "absl/functional/any_invocable.h"
@@ -31,6 +35,141 @@ limitations under the License.
 #include "xla/tsl/platform/logging.h"
 
 namespace tsl {
+namespace internal {
+namespace {
+
+// Concrete async values store the payload at `AsyncValue::kDataOffset`, and
+// are 64-byte aligned, so we cache blocks of this alignment in size classes
+// that are multiples of 64 bytes. Larger or over-aligned async values are
+// allocated directly from the global allocator.
+constexpr size_t kBlockAlignment = 64;
+constexpr size_t kNumSizeClasses = 8;
+constexpr size_t kMaxCachedSize = kBlockAlignment * kNumSizeClasses;
+
+// Maximum number of free blocks cached per size class per thread. Async values
+// are often created on one thread and destroyed on another, so this bounds the
+// memory held by threads that mostly release async values.
+constexpr size_t kMaxCachedBlocks = 32;
+
+// Caching hides use-after-free bugs from sanitizers, so we disable it there.
+#if defined(ABSL_HAVE_ADDRESS_SANITIZER) || \
+    defined(ABSL_HAVE_MEMORY_SANITIZER) || defined(ABSL_HAVE_THREAD_SANITIZER)
+constexpr bool kEnableBlockCache = false;
+#else
+constexpr bool kEnableBlockCache = true;
+#endif
+
+void* AllocateBlock(size_t size, std::align_val_t alignment) {
+  return ::operator new(size, alignment);
+}
+
+void DeallocateBlock(void* ptr, size_t size, std::align_val_t alignment) {
+#if defined(__cpp_sized_deallocation)
+  ::operator delete(ptr, size, alignment);
+#else   // defined(__cpp_sized_deallocation)
+  ::operator delete(ptr, alignment);
+#endif  // defined(__cpp_sized_deallocation)
+}
+
+// Per-thread cache of free async value blocks, kept as intrusive singly linked
+// lists, one per size class.
+class BlockCache {
+ public:
+  ~BlockCache() {
+    for (size_t i = 0; i < kNumSizeClasses; ++i) {
+      while (FreeBlock* block = free_lists_[i]) {
+        free_lists_[i] = block->next;
+        DeallocateBlock(block, BlockSize(i),
+                        std::align_val_t{kBlockAlignment});
+      }
+    }
+  }
+
+  static size_t BlockSize(size_t size_class) {
+    return (size_class + 1) * kBlockAlignment;
+  }
+
+  void* Pop(size_t size_class) {
+    FreeBlock* block = free_lists_[size_class];
+    if (block == nullptr) return nullptr;
+    free_lists_[size_class] = block->next;
+    --num_free_blocks_[size_class];
+    return block;
+  }
+
+  bool Push(size_t size_class, void* ptr) {
+    if (num_free_blocks_[size_class] == kMaxCachedBlocks) return false;
+    free_lists_[size_class] = new (ptr) FreeBlock{free_lists_[size_class]};
+    ++num_free_blocks_[size_class];
+    return true;
+  }
+
+ private:
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  std::array<FreeBlock*, kNumSizeClasses> free_lists_ = {};
+  std::array<size_t, kNumSizeClasses> num_free_blocks_ = {};
+};
+
+// Async values can be released by other thread local destructors after the
+// cache is destroyed at thread exit, so we access the cache through trivially
+// destructible thread locals, and fall back to the global allocator once the
+// cache is gone.
+thread_local BlockCache* block_cache = nullptr;
+thread_local bool block_cache_destroyed = false;
+
+// Owns the thread local block cache and destroys it when the thread exits.
+struct BlockCacheOwner {
+  ~BlockCacheOwner() {
+    delete block_cache;
+    block_cache = nullptr;
+    block_cache_destroyed = true;
+  }
+};
+
+BlockCache* GetBlockCache() {
+  if (ABSL_PREDICT_TRUE(block_cache != nullptr)) return block_cache;
+  if (block_cache_destroyed) return nullptr;
+  thread_local BlockCacheOwner owner;
+  return block_cache = new BlockCache();
+}
+
+// Returns the size class for the given allocation or -1 if it is not cached.
+int SizeClass(size_t size, std::align_val_t alignment) {
+  if (!kEnableBlockCache || size > kMaxCachedSize ||
+      static_cast<size_t>(alignment) > kBlockAlignment) {
+    return -1;
+  }
+  return (size - 1) / kBlockAlignment;
+}
+
+}  // namespace
+
+void* AllocateAsyncValue(size_t size, std::align_val_t alignment) {
+  int size_class = SizeClass(size, alignment);
+  if (size_class < 0) return AllocateBlock(size, alignment);
+
+  if (BlockCache* cache = GetBlockCache()) {
+    if (void* ptr = cache->Pop(size_class)) return ptr;
+  }
+  return AllocateBlock(BlockCache::BlockSize(size_class),
+                       std::align_val_t{kBlockAlignment});
+}
+
+void DeallocateAsyncValue(void* ptr, size_t size, std::align_val_t alignment) {
+  int size_class = SizeClass(size, alignment);
+  if (size_class < 0) return DeallocateBlock(ptr, size, alignment);
+
+  if (BlockCache* cache = GetBlockCache()) {
+    if (cache->Push(size_class, ptr)) return;
+  }
+  DeallocateBlock(ptr, BlockCache::BlockSize(size_class),
+                  std::align_val_t{kBlockAlignment});
+}
+
+}  // namespace internal
 
 uint16_t AsyncValue::CreateTypeInfoAndReturnTypeIdImpl(
     const TypeInfo& type_info) {
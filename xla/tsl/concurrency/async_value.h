@@ -44,6 +44,14 @@ class ConcreteAsyncValue;
 template <typename T>
 constexpr bool kMaybeBase = std::is_class<T>::value && !std::is_final<T>::value;
 
+// Allocates and deallocates storage for reference counted async values. Small
+// allocations are served from a per-thread cache of free blocks, so that
+// creating and destroying async values at a high rate does not contend on the
+// global allocator. `size` and `alignment` passed to deallocation must match
+// the ones passed to allocation.
+void* AllocateAsyncValue(size_t size, std::align_val_t alignment);
+void DeallocateAsyncValue(void* ptr, size_t size, std::align_val_t alignment);
+
 }  // namespace internal
 
 // This is a future of the specified value type. Arbitrary C++ types may be used
@@ -1053,23 +1061,16 @@ inline void AsyncValue::Destroy() {
     // GetTypeInfo().destructor case below.
     static_cast<IndirectAsyncValue*>(this)->~IndirectAsyncValue();
     if (was_ref_counted) {
-#if defined(__cpp_sized_deallocation)
-      ::operator delete(this, sizeof(IndirectAsyncValue),
-                        std::align_val_t{alignof(IndirectAsyncValue)});
-#else   // defined(__cpp_sized_deallocation)
-      ::operator delete(this, std::align_val_t{alignof(IndirectAsyncValue)});
-#endif  // defined(__cpp_sized_deallocation)
+      internal::DeallocateAsyncValue(
+          this, sizeof(IndirectAsyncValue),
+          std::align_val_t{alignof(IndirectAsyncValue)});
     }
     return;
   }
 
   auto [size, alignment] = GetTypeInfo().destructor(this);
   if (was_ref_counted) {
-#if defined(__cpp_sized_deallocation)
-    ::operator delete(this, size, alignment);
-#else   // defined(__cpp_sized_deallocation)
-    ::operator delete(this, alignment);
-#endif  // defined(__cpp_sized_deallocation)
+    internal::DeallocateAsyncValue(this, size, alignment);
   }
 }
 
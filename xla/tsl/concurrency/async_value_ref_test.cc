@@ -972,6 +972,27 @@ BENCHMARK(BM_MakeConstructed<64>);
 BENCHMARK(BM_MakeConstructed<128>);
 BENCHMARK(BM_MakeConstructed<256>);
 
+static void BM_MakeAvailable(benchmark::State& state) {
+  for (auto _ : state) {
+    auto ref = MakeAvailableAsyncValueRef<int32_t>(42);
+    benchmark::DoNotOptimize(ref);
+  }
+}
+
+BENCHMARK(BM_MakeAvailable)->ThreadRange(1, 8);
+
+static void BM_AndThen(benchmark::State& state) {
+  for (auto _ : state) {
+    auto ref = MakeConstructedAsyncValueRef<int32_t>(42);
+    auto done = MakeConstructedAsyncValueRef<int32_t>(0);
+    ref.AndThen([done] { done.SetStateConcrete(); });
+    ref.SetStateConcrete();
+    benchmark::DoNotOptimize(done);
+  }
+}
+
+BENCHMARK(BM_AndThen)->ThreadRange(1, 8);
+
 static void BM_CountDownSuccess(benchmark::State& state) {
   size_t n = state.range(0);
 
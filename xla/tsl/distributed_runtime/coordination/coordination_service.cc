@@ -837,47 +837,57 @@ absl::Status CoordinationService::RecordHeartbeat(const CoordinatedTask& task,
                                                   uint64_t incarnation) {
   const std::string task_name = GetTaskName(task);
   absl::Status s = absl::OkStatus();
-  absl::MutexLock l(&state_mu_);
-  if (ServiceHasStopped()) {
-    return MakeCoordinationError(absl::InternalError(absl::StrCat(
-        "Coordination service has stopped. RecordHeartbeat() from task: ",
-        task_name,
-        " failed. This usually implies an earlier error that caused "
-        "coordination service to shut down before the workers disconnect "
-        "gracefully. Check the task leader's logs for an earlier error or "
-        "scheduler events (e.g. preemption, eviction) to debug the root "
-        "cause.")));
-  } else if (!cluster_state_.contains(task_name)) {
-    return MakeCoordinationError(absl::InvalidArgumentError(
-        absl::StrCat("Unexpected heartbeat request from task: ", task_name,
-                     ". This usually implies a configuration error.")));
-  }
-  const std::unique_ptr<TaskState>& task_state = cluster_state_[task_name];
-  if (!task_state->GetStatus().ok()) {
-    return MakeCoordinationError(absl::AbortedError(absl::StrCat(
-        "Unexpected heartbeat request from an already-in-error task: ",
-        task_name,
-        " with existing error: ", task_state->GetStatus().ToString())));
-  } else if (task_state->IsDisconnectedBeyondGracePeriod()) {
-    // We accept heartbeats for a short grace period to account for the lag
-    // time between the service recording the state change and the agent
-    // stopping heartbeats.
-    return MakeCoordinationError(absl::InvalidArgumentError(
-        absl::StrCat("Task with task_name=", task_name,
-                     " must be registered before sending heartbeat messages. "
-                     "The service might have restarted, please restart / reset "
-                     "and register again.")));
+  {
+    // Heartbeats of healthy tasks only read the cluster state, so they take the
+    // lock in shared mode and don't serialize with each other on the leader.
+    absl::ReaderMutexLock l(&state_mu_);
+    if (ServiceHasStopped()) {
+      return MakeCoordinationError(absl::InternalError(absl::StrCat(
+          "Coordination service has stopped. RecordHeartbeat() from task: ",
+          task_name,
+          " failed. This usually implies an earlier error that caused "
+          "coordination service to shut down before the workers disconnect "
+          "gracefully. Check the task leader's logs for an earlier error or "
+          "scheduler events (e.g. preemption, eviction) to debug the root "
+          "cause.")));
+    }
+    auto it = cluster_state_.find(task_name);
+    if (it == cluster_state_.end()) {
+      return MakeCoordinationError(absl::InvalidArgumentError(
+          absl::StrCat("Unexpected heartbeat request from task: ", task_name,
+                       ". This usually implies a configuration error.")));
+    }
+    const std::unique_ptr<TaskState>& task_state = it->second;
+    if (!task_state->GetStatus().ok()) {
+      return MakeCoordinationError(absl::AbortedError(absl::StrCat(
+          "Unexpected heartbeat request from an already-in-error task: ",
+          task_name,
+          " with existing error: ", task_state->GetStatus().ToString())));
+    } else if (task_state->IsDisconnectedBeyondGracePeriod()) {
+      // We accept heartbeats for a short grace period to account for the lag
+      // time between the service recording the state change and the agent
+      // stopping heartbeats.
+      return MakeCoordinationError(absl::InvalidArgumentError(
+          absl::StrCat("Task with task_name=", task_name,
+                       " must be registered before sending heartbeat "
+                       "messages. The service might have restarted, please "
+                       "restart / reset and register again.")));
+    }
+    VLOG(10) << "Record heartbeat from task: " << task_name
+             << "at incarnation: " << incarnation << "at " << absl::Now();
+    s = task_state->RecordHeartbeat(incarnation);
+    if (s.ok()) {
+      return s;
+    }
   }
-  VLOG(10) << "Record heartbeat from task: " << task_name
-           << "at incarnation: " << incarnation << "at " << absl::Now();
-  s = task_state->RecordHeartbeat(incarnation);
 
-  // Set and propagate any heartbeat errors.
-  if (!s.ok()) {
+  // Set and propagate any heartbeat errors, unless another request has set an
+  // error for the task while the lock was released.
+  absl::MutexLock l(&state_mu_);
+  if (cluster_state_[task_name]->GetStatus().ok()) {
     SetTaskError(task_name, s);
     PropagateError(s, {task});
   }
-
   return s;
 }
 
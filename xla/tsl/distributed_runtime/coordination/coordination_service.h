@@ -322,7 +322,7 @@ class CoordinationService {
   // Starts a thread to check staleness.
   void StartCheckStaleness();
   void Stop() ABSL_EXCLUSIVE_LOCKS_REQUIRED(state_mu_);
-  bool ServiceHasStopped() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(state_mu_);
+  bool ServiceHasStopped() const ABSL_SHARED_LOCKS_REQUIRED(state_mu_);
   // Report error from a task to all other connected tasks if the task is not
   // recoverable.
   // Note: SetTaskError() must be called before propagating its error.
@@ -42,25 +42,28 @@ KeyValueStore::~KeyValueStore() {
 
 absl::Status KeyValueStore::Put(absl::string_view key, absl::string_view value,
                                 bool allow_overwrite) {
-  absl::MutexLock l(&mu_);
-
-  if (allow_overwrite) {
-    data_[key] = value;
-    NotifyCallbacksForKey(key, value);
-    return absl::OkStatus();
+  std::vector<Callback> callbacks;
+  {
+    absl::MutexLock l(&mu_);
+    if (allow_overwrite) {
+      data_[key] = value;
+    } else if (!data_.try_emplace(key, value).second) {
+      return absl::AlreadyExistsError(
+          absl::StrCat("key ", key, " already exists."));
+    }
+    callbacks = TakeCallbacksForKey(key);
   }
 
-  auto [it, inserted] = data_.try_emplace(key, value);
-  if (!inserted) {
-    return absl::AlreadyExistsError(
-        absl::StrCat("key ", key, " already exists."));
+  // Callbacks are called without holding the lock, so that a value waited for
+  // by many tasks doesn't block the store while all of them are notified.
+  for (Callback& callback : callbacks) {
+    callback(value);
   }
-  NotifyCallbacksForKey(key, value);
   return absl::OkStatus();
 }
 
 std::optional<std::string> KeyValueStore::Get(absl::string_view key) {
-  absl::MutexLock l(&mu_);
+  absl::ReaderMutexLock l(&mu_);
   auto it = data_.find(key);
   if (it == data_.end()) {
     return std::nullopt;
@@ -70,7 +73,7 @@ std::optional<std::string> KeyValueStore::Get(absl::string_view key) {
 
 std::vector<tensorflow::KeyValueEntry> KeyValueStore::GetPrefix(
     absl::string_view prefix) {
-  absl::MutexLock l(&mu_);
+  absl::ReaderMutexLock l(&mu_);
 
   std::vector<tensorflow::KeyValueEntry> entries;
   for (auto it = data_.lower_bound(prefix); it != data_.end(); ++it) {
@@ -107,23 +110,27 @@ void KeyValueStore::DeletePrefix(absl::string_view prefix) {
 
 void KeyValueStore::AddCallbackForKey(absl::string_view key,
                                       Callback callback) {
-  absl::MutexLock l(&mu_);
-
-  if (auto it = data_.find(key); it != data_.end()) {
-    callback(it->second);
-    return;
+  std::string value;
+  {
+    absl::MutexLock l(&mu_);
+    auto it = data_.find(key);
+    if (it == data_.end()) {
+      callbacks_[key].push_back(std::move(callback));
+      return;
+    }
+    value = it->second;
   }
-  callbacks_[key].push_back(std::move(callback));
+  callback(value);
 }
 
-void KeyValueStore::NotifyCallbacksForKey(
-    absl::string_view key, const absl::StatusOr<absl::string_view>& value) {
+std::vector<KeyValueStore::Callback> KeyValueStore::TakeCallbacksForKey(
+    absl::string_view key) {
+  std::vector<Callback> callbacks;
   if (auto it = callbacks_.find(key); it != callbacks_.end()) {
-    for (Callback& callback : it->second) {
-      callback(value);
-    }
+    callbacks = std::move(it->second);
     callbacks_.erase(it);
   }
+  return callbacks;
 }
 
 }  // namespace tsl
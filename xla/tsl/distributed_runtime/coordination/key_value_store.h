@@ -33,6 +33,9 @@ limitations under the License.
 namespace tsl {
 
 // A thread-safe in-memory key-value store.
+//
+// Lookups only take a shared lock, so that the many tasks of a large job can
+// read e.g. the topology or collective ids concurrently.
 class KeyValueStore {
  public:
   using Callback =
@@ -62,6 +65,9 @@ class KeyValueStore {
   std::vector<tensorflow::KeyValueEntry> GetPrefix(absl::string_view prefix);
 
   // Adds a callback that is called when the provided key exists in the map.
+  //
+  // Callbacks are called without holding the store's lock, so they may call
+  // back into the store.
   void AddCallbackForKey(absl::string_view key, Callback callback);
 
   // Deletes the provided key.
@@ -71,9 +77,8 @@ class KeyValueStore {
   void DeletePrefix(absl::string_view prefix);
 
  private:
-  // Notifies all callbacks registered for the provided key.
-  void NotifyCallbacksForKey(absl::string_view key,
-                             const absl::StatusOr<absl::string_view>& value)
+  // Removes and returns all callbacks registered for the provided key.
+  std::vector<Callback> TakeCallbacksForKey(absl::string_view key)
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
 
   absl::Mutex mu_;
@@ -144,6 +144,20 @@ TEST(KeyValueStore, AddKeyThenCallback) {
   EXPECT_TRUE(callback_called);
 }
 
+TEST(KeyValueStore, CallbackCanAccessStore) {
+  KeyValueStore store;
+  std::optional<std::string> other_value;
+  store.AddCallbackForKey("foo",
+                          [&](const absl::StatusOr<absl::string_view>& s) {
+                            ASSERT_OK(s);
+                            ASSERT_OK(store.Put("baz", *s,
+                                                /*allow_overwrite=*/false));
+                            other_value = store.Get("baz");
+                          });
+  ASSERT_OK(store.Put("foo", "bar", /*allow_overwrite=*/true));
+  EXPECT_THAT(other_value, Optional(Eq("bar")));
+}
+
 TEST(KeyValueStore, DeleteKey) {
   KeyValueStore store;
   ASSERT_OK(store.Put("a", "", /*allow_overwrite=*/true));
@@ -25,14 +25,19 @@ limitations under the License.
 #include <map>
 #include <memory>
 #include <optional>
+#include <string>
 #include <utility>
 #include <vector>
 
 #include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/str_replace.h"
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
 #include "xla/tsl/framework/allocator.h"
 #include "xla/tsl/framework/allocator_retry.h"
 #include "xla/tsl/platform/env.h"
@@ -533,6 +538,40 @@ double BFCAllocator::GetFragmentation() {
 void BFCAllocator::AddTraceMe(absl::string_view traceme_name, const void* ptr) {
   BFCAllocator::Chunk* chunk = ChunkFromHandle(region_manager_.get_handle(ptr));
   AddTraceMe(traceme_name, chunk->ptr, chunk->requested_size, chunk->size);
+  RecordAllocationEvent(AllocationEvent::Kind::kAllocation, chunk->ptr,
+                        chunk->requested_size, chunk->size);
+}
+
+void BFCAllocator::RecordAllocationEvent(AllocationEvent::Kind kind,
+                                         const void* chunk_ptr,
+                                         int64_t req_bytes,
+                                         int64_t alloc_bytes) {
+  if (allocation_trace_capacity_ == 0) {
+    return;
+  }
+  AllocationEvent event;
+  event.kind = kind;
+  event.time_us = Env::Default()->NowMicros();
+  event.address = reinterpret_cast<uint64>(chunk_ptr);
+  event.requested_bytes = req_bytes;
+  event.allocated_bytes = alloc_bytes;
+  event.bytes_in_use = stats_.bytes_in_use;
+  event.pool_bytes = stats_.pool_bytes.value_or(0);
+  event.largest_free_chunk_bytes = LargestFreeChunk();
+  const auto& annotation =
+      tsl::profiler::ScopedMemoryDebugAnnotation::CurrentAnnotation();
+  event.tag = std::string(annotation.pending_op_name);
+  if (!annotation.pending_region_type.empty()) {
+    absl::StrAppend(&event.tag, event.tag.empty() ? "" : ":",
+                    annotation.pending_region_type);
+  }
+
+  size_t index = allocation_trace_next_++ % allocation_trace_capacity_;
+  if (index < allocation_trace_.size()) {
+    allocation_trace_[index] = std::move(event);
+  } else {
+    allocation_trace_.push_back(std::move(event));
+  }
 }
 
 void BFCAllocator::AddTraceMe(absl::string_view traceme_name,
@@ -727,6 +766,8 @@ void BFCAllocator::DeallocateRawInternal(void* ptr) {
   // TraceMe needs to be added after MarkFree and InsertFreeChunkIntoBin for
   // correct aggregation stats (bytes_in_use, fragmentation).
   AddTraceMe("MemoryDeallocation", chunk_ptr, req_bytes, alloc_bytes);
+  RecordAllocationEvent(AllocationEvent::Kind::kDeallocation, chunk_ptr,
+                        req_bytes, alloc_bytes);
 
   if (VLOG_IS_ON(4)) {
     LOG(INFO) << "F: " << RenderOccupancy();
@@ -1259,4 +1300,153 @@ AllocatorMemoryType BFCAllocator::GetMemoryType() const {
   return sub_allocator_->GetMemoryType();
 }
 
+double BFCAllocator::AllocationEvent::fragmentation() const {
+  int64_t bytes_free = pool_bytes - bytes_in_use;
+  if (bytes_free <= 0) {
+    return 0;
+  }
+  return static_cast<double>(bytes_free - largest_free_chunk_bytes) /
+         bytes_free;
+}
+
+void BFCAllocator::SetAllocationTraceCapacity(size_t capacity) {
+  absl::MutexLock l(&mutex_);
+  allocation_trace_capacity_ = capacity;
+  allocation_trace_next_ = 0;
+  allocation_trace_.clear();
+  if (capacity == 0) {
+    allocation_trace_.shrink_to_fit();
+  }
+}
+
+std::vector<BFCAllocator::AllocationEvent> BFCAllocator::GetAllocationTrace() {
+  absl::MutexLock l(&mutex_);
+  if (allocation_trace_capacity_ == 0 ||
+      allocation_trace_.size() < allocation_trace_capacity_) {
+    return allocation_trace_;
+  }
+  // The ring buffer is full, the oldest event is the next one to overwrite.
+  size_t oldest = allocation_trace_next_ % allocation_trace_capacity_;
+  std::vector<AllocationEvent> events;
+  events.reserve(allocation_trace_.size());
+  events.insert(events.end(), allocation_trace_.begin() + oldest,
+                allocation_trace_.end());
+  events.insert(events.end(), allocation_trace_.begin(),
+                allocation_trace_.begin() + oldest);
+  return events;
+}
+
+namespace {
+
+std::string EscapeJson(absl::string_view s) {
+  return absl::StrReplaceAll(
+      s, {{"\\", "\\\\"}, {"\"", "\\\""}, {"\n", "\\n"}});
+}
+
+}  // namespace
+
+/*static*/ std::string BFCAllocator::AllocationTraceToJson(
+    absl::string_view allocator_name,
+    absl::Span<const AllocationEvent> events) {
+  std::string json = absl::StrCat(
+      R"({"displayTimeUnit":"ns","traceEvents":[)",
+      R"({"name":"process_name","ph":"M","pid":0,"args":{"name":")",
+      EscapeJson(allocator_name), R"("}})");
+  for (const AllocationEvent& event : events) {
+    bool is_allocation = event.kind == AllocationEvent::Kind::kAllocation;
+    absl::StrAppendFormat(
+        &json,
+        R"(,{"name":"%s","ph":"i","s":"t","ts":%d,"pid":0,"tid":0,)"
+        R"("args":{"address":"0x%x","requested_bytes":%d,)"
+        R"("allocated_bytes":%d,"tag":"%s"}})",
+        is_allocation ? "alloc" : "free", event.time_us, event.address,
+        event.requested_bytes, event.allocated_bytes, EscapeJson(event.tag));
+    absl::StrAppendFormat(
+        &json,
+        R"(,{"name":"memory","ph":"C","ts":%d,"pid":0,)"
+        R"("args":{"bytes_in_use":%d,"pool_bytes":%d}})",
+        event.time_us, event.bytes_in_use, event.pool_bytes);
+    absl::StrAppendFormat(
+        &json,
+        R"(,{"name":"fragmentation","ph":"C","ts":%d,"pid":0,)"
+        R"("args":{"fragmentation":%.4f}})",
+        event.time_us, event.fragmentation());
+  }
+  absl::StrAppend(&json, "]}");
+  return json;
+}
+
+/*static*/ std::string BFCAllocator::SummarizeAllocationTrace(
+    absl::Span<const AllocationEvent> events) {
+  if (events.empty()) {
+    return "Allocation trace is empty.\n";
+  }
+  size_t peak_usage_index = 0;
+  size_t peak_fragmentation_index = 0;
+  double fragmentation_sum = 0;
+  for (size_t i = 0; i < events.size(); ++i) {
+    if (events[i].bytes_in_use > events[peak_usage_index].bytes_in_use) {
+      peak_usage_index = i;
+    }
+    if (events[i].fragmentation() >
+        events[peak_fragmentation_index].fragmentation()) {
+      peak_fragmentation_index = i;
+    }
+    fragmentation_sum += events[i].fragmentation();
+  }
+
+  // Replays the trace up to the peak fragmentation to find the live
+  // allocations. Allocations made before the trace started are unknown.
+  absl::flat_hash_map<uint64, const AllocationEvent*> live;
+  for (size_t i = 0; i <= peak_fragmentation_index; ++i) {
+    if (events[i].kind == AllocationEvent::Kind::kAllocation) {
+      live[events[i].address] = &events[i];
+    } else {
+      live.erase(events[i].address);
+    }
+  }
+  std::vector<const AllocationEvent*> largest;
+  largest.reserve(live.size());
+  for (const auto& [address, event] : live) {
+    largest.push_back(event);
+  }
+  std::sort(largest.begin(), largest.end(),
+            [](const AllocationEvent* a, const AllocationEvent* b) {
+              return a->allocated_bytes > b->allocated_bytes;
+            });
+  constexpr size_t kMaxLiveAllocations = 10;
+  if (largest.size() > kMaxLiveAllocations) {
+    largest.resize(kMaxLiveAllocations);
+  }
+
+  uint64 start_us = events.front().time_us;
+  const AllocationEvent& peak_usage = events[peak_usage_index];
+  const AllocationEvent& peak_fragmentation = events[peak_fragmentation_index];
+  std::string summary = absl::StrFormat(
+      "Allocation trace of %d events over %.3f ms.\n"
+      "Peak bytes in use: %s of a %s pool at +%.3f ms.\n"
+      "Mean fragmentation: %.4f.\n"
+      "Peak fragmentation: %.4f at +%.3f ms, with %s free and a largest free "
+      "chunk of %s.\n",
+      events.size(), (events.back().time_us - start_us) / 1e3,
+      strings::HumanReadableNumBytes(peak_usage.bytes_in_use),
+      strings::HumanReadableNumBytes(peak_usage.pool_bytes),
+      (peak_usage.time_us - start_us) / 1e3,
+      fragmentation_sum / events.size(), peak_fragmentation.fragmentation(),
+      (peak_fragmentation.time_us - start_us) / 1e3,
+      strings::HumanReadableNumBytes(peak_fragmentation.pool_bytes -
+                                     peak_fragmentation.bytes_in_use),
+      strings::HumanReadableNumBytes(
+          peak_fragmentation.largest_free_chunk_bytes));
+  absl::StrAppend(&summary,
+                  "Largest traced allocations live at peak fragmentation:\n");
+  for (const AllocationEvent* event : largest) {
+    absl::StrAppendFormat(
+        &summary, "  %s at 0x%x: %s\n",
+        event->tag.empty() ? "<untagged>" : event->tag, event->address,
+        strings::HumanReadableNumBytes(event->allocated_bytes));
+  }
+  return summary;
+}
+
 }  // namespace tsl
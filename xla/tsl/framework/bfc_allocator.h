@@ -24,6 +24,7 @@ limitations under the License.
 #include <deque>
 #include <memory>
 #include <optional>
+#include <string>
 #include <vector>
 
 #include "absl/base/thread_annotations.h"
@@ -31,6 +32,7 @@ limitations under the License.
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
 #include "xla/tsl/framework/allocator.h"
 #include "xla/tsl/framework/allocator_retry.h"
 #include "xla/tsl/framework/shared_counter.h"
@@ -113,6 +115,51 @@ class BFCAllocator : public Allocator {
 
   MemoryDump RecordMemoryMap();
 
+  // An allocation or deallocation recorded by the allocation trace.
+  struct AllocationEvent {
+    enum class Kind { kAllocation, kDeallocation };
+
+    Kind kind = Kind::kAllocation;
+    uint64 time_us = 0;
+    uint64 address = 0;
+    int64_t requested_bytes = 0;
+    int64_t allocated_bytes = 0;
+
+    // State of the allocator right after the event.
+    int64_t bytes_in_use = 0;
+    int64_t pool_bytes = 0;
+    int64_t largest_free_chunk_bytes = 0;
+
+    // Op or buffer the memory belongs to, taken from the current
+    // ScopedMemoryDebugAnnotation. Empty if there is no annotation.
+    std::string tag;
+
+    // Fraction of the free memory in the pool that is not part of the largest
+    // free chunk, within [0, 1].
+    double fragmentation() const;
+  };
+
+  // Starts recording the last `capacity` allocations and deallocations in a
+  // ring buffer. A capacity of zero stops recording and drops the recorded
+  // events. Recording is off by default and costs a branch per allocation
+  // when off.
+  void SetAllocationTraceCapacity(size_t capacity);
+
+  // Returns the recorded allocations and deallocations, oldest first.
+  std::vector<AllocationEvent> GetAllocationTrace();
+
+  // Converts `events` to a Chrome trace JSON which can be opened in Perfetto.
+  // Every event becomes an instant event, and bytes in use, pool bytes and
+  // fragmentation become counter tracks.
+  static std::string AllocationTraceToJson(
+      absl::string_view allocator_name,
+      absl::Span<const AllocationEvent> events);
+
+  // Returns a human readable summary of the fragmentation over `events`,
+  // including the allocations which were live when fragmentation peaked.
+  static std::string SummarizeAllocationTrace(
+      absl::Span<const AllocationEvent> events);
+
  private:
   struct Bin;
 
@@ -149,7 +196,8 @@ class BFCAllocator : public Allocator {
 
   // Add TraceMe (in memory allocation and deallocation) for memory stats
   // profiling. The chunk_ptr is passed to get information such as address,
-  // chunk size and requested_size.
+  // chunk size and requested_size. Also records the allocation in the
+  // allocation trace.
   void AddTraceMe(absl::string_view traceme_name, const void* ptr)
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
 
@@ -158,6 +206,11 @@ class BFCAllocator : public Allocator {
                   int64_t req_bytes, int64_t alloc_bytes)
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
 
+  // Appends an event to the allocation trace if it is enabled.
+  void RecordAllocationEvent(AllocationEvent::Kind kind, const void* chunk_ptr,
+                             int64_t req_bytes, int64_t alloc_bytes)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
   // A ChunkHandle is an index into the chunks_ vector in BFCAllocator
   // kInvalidChunkHandle means an invalid chunk
   typedef size_t ChunkHandle;
@@ -595,6 +648,12 @@ class BFCAllocator : public Allocator {
   // Stats.
   AllocatorStats stats_ ABSL_GUARDED_BY(mutex_);
 
+  // Ring buffer of the last `allocation_trace_capacity_` allocation events.
+  // `allocation_trace_next_` counts all events recorded so far.
+  size_t allocation_trace_capacity_ ABSL_GUARDED_BY(mutex_) = 0;
+  uint64 allocation_trace_next_ ABSL_GUARDED_BY(mutex_) = 0;
+  std::vector<AllocationEvent> allocation_trace_ ABSL_GUARDED_BY(mutex_);
+
 #ifdef TENSORFLOW_MEM_DEBUG
   int64 action_counter_ ABSL_GUARDED_BY(mutex_);
 #define MEM_DEBUG_SIZE_HISTORY_SIZE 4096
@@ -24,6 +24,7 @@ limitations under the License.
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <functional>
 #include <initializer_list>
 #include <limits>
@@ -34,6 +35,7 @@ limitations under the License.
 #include <vector>
 
 #include "absl/algorithm/container.h"
+#include "absl/base/internal/endian.h"
 #include "absl/base/log_severity.h"
 #include "absl/base/macros.h"
 #include "absl/base/thread_annotations.h"
@@ -850,6 +852,42 @@ absl::Status EraseElementFromVector(std::vector<T>* container, const T& value) {
   return absl::OkStatus();
 }
 
+// Returns a mask with the `width` least significant bits of every `lane`-bit
+// lane set.
+constexpr inline uint64_t LaneLsbMask(int lane, int width) {
+  return LsbMask<uint64_t>(width) *
+         (std::numeric_limits<uint64_t>::max() / LsbMask<uint64_t>(lane));
+}
+
+// Packs the low-order kBitsPerElement bits of the eight bytes of `word` into
+// its kBitsPerElement low-order bytes. The fields are merged pairwise in lanes
+// of 16, 32 and 64 bits, so eight elements take a few shifts instead of eight
+// byte operations, and the loops below vectorize.
+template <size_t kBitsPerElement>
+constexpr inline uint64_t PackWordIntN(uint64_t word) {
+  static_assert(8 % kBitsPerElement == 0);
+  word &= LaneLsbMask(8, kBitsPerElement);
+  int width = kBitsPerElement;
+  for (int lane = 16; lane <= 64; lane *= 2) {
+    word = (word | (word >> (lane / 2 - width))) & LaneLsbMask(lane, 2 * width);
+    width *= 2;
+  }
+  return word;
+}
+
+// Inverse of PackWordIntN: spreads the 8 * kBitsPerElement low-order bits of
+// `word` to the low-order bits of its eight bytes.
+template <size_t kBitsPerElement>
+constexpr inline uint64_t UnpackWordIntN(uint64_t word) {
+  static_assert(8 % kBitsPerElement == 0);
+  int width = 8 * kBitsPerElement;
+  for (int lane = 64; lane >= 16; lane /= 2) {
+    width /= 2;
+    word = (word | (word << (lane / 2 - width))) & LaneLsbMask(lane / 2, width);
+  }
+  return word;
+}
+
 // Takes a sequence of unpacked kBitsPerElement-bit values (kBitsPerElement must
 // be between 1 and 7), such that every byte stores one value in the low-order
 // bits, and packs them so every byte stores as many which will fit. `output`
@@ -860,8 +898,20 @@ void PackIntN(absl::Span<const char> input, absl::Span<char> output) {
   static_assert(1 <= kBitsPerElement);
   static_assert(kBitsPerElement <= 7);
   constexpr auto kElementsPerByte = 8 / kBitsPerElement;
+  size_t begin = 0;
+  if constexpr (kElementsPerByte * kBitsPerElement == 8) {
+    // Packs eight elements into kBitsPerElement bytes at a time.
+    const size_t words = input.size() / 8;
+    for (size_t i = 0; i < words; ++i) {
+      const uint64_t word = absl::little_endian::FromHost64(
+          PackWordIntN<kBitsPerElement>(
+              absl::little_endian::Load64(input.data() + i * 8)));
+      std::memcpy(output.data() + i * kBitsPerElement, &word, kBitsPerElement);
+    }
+    begin = words * 8 / kElementsPerByte;
+  }
   const size_t aligned_inputs = input.size() / kElementsPerByte;
-  for (size_t i = 0; i < aligned_inputs; ++i) {
+  for (size_t i = begin; i < aligned_inputs; ++i) {
     char byte = 0;
     for (size_t j = 0; j < kElementsPerByte; ++j) {
       byte |=
@@ -912,14 +962,27 @@ inline std::unique_ptr<char[]> PackIntN(int bits_per_element, const char* data,
 // values, and unpacks them so every byte stores one value in the low-order
 // bits. `input` should have
 // ceil(output.size()*8.0/kBitsPerElement) bytes. kBitsPerElement must be
-// between 1 and 7. ßThe high-order bits in each output are zero.
+// between 1 and 7. The high-order bits in each output are zero.
 template <size_t kBitsPerElement>
 void UnpackIntN(absl::Span<const char> input, absl::Span<char> output) {
   static_assert(1 <= kBitsPerElement);
   static_assert(kBitsPerElement <= 7);
   constexpr auto kElementsPerByte = 8 / kBitsPerElement;
+  size_t begin = 0;
+  if constexpr (kElementsPerByte * kBitsPerElement == 8) {
+    // Unpacks kBitsPerElement bytes into eight elements at a time.
+    const size_t words = output.size() / 8;
+    for (size_t i = 0; i < words; ++i) {
+      uint64_t word = 0;
+      std::memcpy(&word, input.data() + i * kBitsPerElement, kBitsPerElement);
+      absl::little_endian::Store64(
+          output.data() + i * 8,
+          UnpackWordIntN<kBitsPerElement>(absl::little_endian::ToHost64(word)));
+    }
+    begin = words * 8 / kElementsPerByte;
+  }
   const size_t aligned_outputs = output.size() / kElementsPerByte;
-  for (size_t i = 0; i < aligned_outputs; ++i) {
+  for (size_t i = begin; i < aligned_outputs; ++i) {
     const char byte = input[i];
     for (int j = 0; j < kElementsPerByte; ++j) {
       output[i * kElementsPerByte + j] =
@@ -388,6 +388,37 @@ TEST(UtilTest, PackInt4) {
   }
 }
 
+TEST(UtilTest, PackAndUnpackIntNWords) {
+  // Covers whole 64-bit words as well as the trailing elements.
+  for (int bits_per_element : {2, 4}) {
+    const int64_t elements_per_byte = 8 / bits_per_element;
+    for (int64_t size : {8, 13, 64, 67}) {
+      std::vector<char> input(size);
+      for (int64_t i = 0; i < size; ++i) {
+        input[i] = static_cast<char>(i * 37 + 11);
+      }
+
+      std::vector<char> output_ref(CeilOfRatio(size, elements_per_byte));
+      for (int64_t i = 0; i < size; ++i) {
+        output_ref[i / elements_per_byte] |=
+            (input[i] & LsbMask<uint8_t>(bits_per_element))
+            << (bits_per_element * (i % elements_per_byte));
+      }
+
+      std::vector<char> packed(output_ref.size());
+      PackIntN(bits_per_element, input, absl::MakeSpan(packed));
+      EXPECT_EQ(packed, output_ref) << bits_per_element << " " << size;
+
+      std::vector<char> unpacked(size);
+      UnpackIntN(bits_per_element, packed, absl::MakeSpan(unpacked));
+      for (int64_t i = 0; i < size; ++i) {
+        EXPECT_EQ(unpacked[i], input[i] & LsbMask<uint8_t>(bits_per_element))
+            << bits_per_element << " " << i;
+      }
+    }
+  }
+}
+
 TEST(UtilTest, MaybeOwningTestNull) {
   MaybeOwning<char> m(nullptr);
   EXPECT_EQ(m.get(), nullptr);